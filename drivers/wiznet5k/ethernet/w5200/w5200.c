@@ -72,9 +72,8 @@ uint8_t WIZCHIP_READ(uint32_t AddrSel) {
         0x00,
         0x01,
     };
-    WIZCHIP.IF.SPI._write_bytes(spi_data, 4);
     uint8_t ret;
-    WIZCHIP.IF.SPI._read_bytes(&ret, 1);
+    wizchip_spi_read_frame(spi_data, 4, &ret, 1);
 
     WIZCHIP.CS._deselect();
     WIZCHIP_CRITICAL_EXIT();
@@ -109,8 +108,7 @@ void WIZCHIP_READ_BUF(uint32_t AddrSel, uint8_t* pBuf, uint16_t len) {
         0x00 | ((len >> 8) & 0x7f),
         len & 0xff,
     };
-    WIZCHIP.IF.SPI._write_bytes(spi_data, 4);
-    WIZCHIP.IF.SPI._read_bytes(pBuf, len);
+    wizchip_spi_read_frame(spi_data, 4, pBuf, len);
 
     WIZCHIP.CS._deselect();
     WIZCHIP_CRITICAL_EXIT();
@@ -126,19 +124,24 @@ void WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, uint16_t len) {
         0x80 | ((len >> 8) & 0x7f),
         len & 0xff,
     };
-    WIZCHIP.IF.SPI._write_bytes(spi_data, 4);
-    WIZCHIP.IF.SPI._write_bytes(pBuf, len);
+    wizchip_spi_write_frame(spi_data, 4, pBuf, len);
 
     WIZCHIP.CS._deselect();
     WIZCHIP_CRITICAL_EXIT();
 }
 
+static uint16_t read16(uint32_t AddrSel) {
+    uint8_t buf[2];
+    WIZCHIP_READ_BUF(AddrSel, buf, 2);
+    return (buf[0] << 8) | buf[1];
+}
+
 uint16_t getSn_TX_FSR(uint8_t sn) {
     uint16_t val = 0, val1 = 0;
     do {
-        val1 = (WIZCHIP_READ(Sn_TX_FSR(sn)) << 8) | WIZCHIP_READ(Sn_TX_FSR(sn) + 1);
+        val1 = read16(Sn_TX_FSR(sn));
         if (val1 != 0) {
-            val = (WIZCHIP_READ(Sn_TX_FSR(sn)) << 8) | WIZCHIP_READ(Sn_TX_FSR(sn) + 1);
+            val = read16(Sn_TX_FSR(sn));
         }
     } while (val != val1);
     return val;
@@ -147,9 +150,9 @@ uint16_t getSn_TX_FSR(uint8_t sn) {
 uint16_t getSn_RX_RSR(uint8_t sn) {
     uint16_t val = 0, val1 = 0;
     do {
-        val1 = (WIZCHIP_READ(Sn_RX_RSR(sn)) << 8) | WIZCHIP_READ(Sn_RX_RSR(sn) + 1);
+        val1 = read16(Sn_RX_RSR(sn));
         if (val1 != 0) {
-            val = (WIZCHIP_READ(Sn_RX_RSR(sn)) << 8) | WIZCHIP_READ(Sn_RX_RSR(sn) + 1);
+            val = read16(Sn_RX_RSR(sn));
         }
     } while (val != val1);
     return val;
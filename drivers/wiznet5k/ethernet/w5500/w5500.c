@@ -59,10 +59,6 @@
 
 #define LPC_SSP0 (0)
 
-static void Chip_SSP_ReadFrames_Blocking(int dummy, uint8_t *buf, uint32_t len) {
-    WIZCHIP.IF.SPI._read_bytes(buf, len);
-}
-
 static void Chip_SSP_WriteFrames_Blocking(int dummy, const uint8_t *buf, uint32_t len) {
     WIZCHIP.IF.SPI._write_bytes(buf, len);
 }
@@ -84,8 +80,7 @@ uint8_t  WIZCHIP_READ(uint32_t AddrSel)
    spi_data[0] = (AddrSel & 0x00FF0000) >> 16;
    spi_data[1] = (AddrSel & 0x0000FF00) >> 8;
    spi_data[2] = (AddrSel & 0x000000FF) >> 0;
-   Chip_SSP_WriteFrames_Blocking(LPC_SSP0, spi_data, 3);
-   Chip_SSP_ReadFrames_Blocking(LPC_SSP0, &ret, 1);
+   wizchip_spi_read_frame(spi_data, 3, &ret, 1);
 
    WIZCHIP.CS._deselect();
    WIZCHIP_CRITICAL_EXIT();
@@ -133,8 +128,7 @@ void     WIZCHIP_READ_BUF (uint32_t AddrSel, uint8_t* pBuf, uint16_t len)
    spi_data[0] = (AddrSel & 0x00FF0000) >> 16;
    spi_data[1] = (AddrSel & 0x0000FF00) >> 8;
    spi_data[2] = (AddrSel & 0x000000FF) >> 0;
-   Chip_SSP_WriteFrames_Blocking(LPC_SSP0, spi_data, 3);
-   Chip_SSP_ReadFrames_Blocking(LPC_SSP0, pBuf, len);
+   wizchip_spi_read_frame(spi_data, 3, pBuf, len);
 
    WIZCHIP.CS._deselect();
    WIZCHIP_CRITICAL_EXIT();
@@ -158,26 +152,36 @@ void     WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, uint16_t len)
    spi_data[0] = (AddrSel & 0x00FF0000) >> 16;
    spi_data[1] = (AddrSel & 0x0000FF00) >> 8;
    spi_data[2] = (AddrSel & 0x000000FF) >> 0;
-   Chip_SSP_WriteFrames_Blocking(LPC_SSP0, spi_data, 3);
-   Chip_SSP_WriteFrames_Blocking(LPC_SSP0, pBuf, len);
+   wizchip_spi_write_frame(spi_data, 3, pBuf, len);
 
    WIZCHIP.CS._deselect();
    WIZCHIP_CRITICAL_EXIT();
 }
 
 
+uint16_t WIZCHIP_READ16(uint32_t AddrSel)
+{
+   uint8_t buf[2];
+   WIZCHIP_READ_BUF(AddrSel, buf, 2);
+   return ((uint16_t)buf[0] << 8) | buf[1];
+}
+
+void     WIZCHIP_WRITE16(uint32_t AddrSel, uint16_t wb)
+{
+   uint8_t buf[2] = { (uint8_t)(wb >> 8), (uint8_t)wb };
+   WIZCHIP_WRITE_BUF(AddrSel, buf, 2);
+}
+
 uint16_t getSn_TX_FSR(uint8_t sn)
 {
    uint16_t val=0,val1=0;
 
    do
    {
-      val1 = WIZCHIP_READ(Sn_TX_FSR(sn));
-      val1 = (val1 << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(Sn_TX_FSR(sn),1));
+      val1 = WIZCHIP_READ16(Sn_TX_FSR(sn));
       if (val1 != 0)
       {
-        val = WIZCHIP_READ(Sn_TX_FSR(sn));
-        val = (val << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(Sn_TX_FSR(sn),1));
+        val = WIZCHIP_READ16(Sn_TX_FSR(sn));
       }
    }while (val != val1);
    return val;
@@ -190,12 +194,10 @@ uint16_t getSn_RX_RSR(uint8_t sn)
 
    do
    {
-      val1 = WIZCHIP_READ(Sn_RX_RSR(sn));
-      val1 = (val1 << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(Sn_RX_RSR(sn),1));
+      val1 = WIZCHIP_READ16(Sn_RX_RSR(sn));
       if (val1 != 0)
       {
-        val = WIZCHIP_READ(Sn_RX_RSR(sn));
-        val = (val << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(Sn_RX_RSR(sn),1));
+        val = WIZCHIP_READ16(Sn_RX_RSR(sn));
       }
    }while (val != val1);
    return val;
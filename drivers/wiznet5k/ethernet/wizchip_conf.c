@@ -189,6 +189,49 @@ void reg_wizchip_spi_cbfunc(void (*spi_rb)(uint8_t *, uint32_t), void (*spi_wb)(
    }
 }
 
+void reg_wizchip_spiburst_cbfunc(void (*spi_rburst)(const uint8_t *, uint32_t, uint8_t *, uint32_t),
+                                 void (*spi_wburst)(const uint8_t *, uint32_t, const uint8_t *, uint32_t))
+{
+   while(!(WIZCHIP.if_mode & _WIZCHIP_IO_MODE_SPI_));
+
+   if(!spi_rburst || !spi_wburst)
+   {
+      WIZCHIP.IF.SPI._read_burst   = NULL;
+      WIZCHIP.IF.SPI._write_burst  = NULL;
+   }
+   else
+   {
+      WIZCHIP.IF.SPI._read_burst   = spi_rburst;
+      WIZCHIP.IF.SPI._write_burst  = spi_wburst;
+   }
+}
+
+void wizchip_spi_read_frame(const uint8_t *hdr, uint32_t hdr_len, uint8_t *buf, uint32_t len)
+{
+   if(WIZCHIP.IF.SPI._read_burst)
+   {
+      WIZCHIP.IF.SPI._read_burst(hdr, hdr_len, buf, len);
+   }
+   else
+   {
+      WIZCHIP.IF.SPI._write_bytes(hdr, hdr_len);
+      WIZCHIP.IF.SPI._read_bytes(buf, len);
+   }
+}
+
+void wizchip_spi_write_frame(const uint8_t *hdr, uint32_t hdr_len, const uint8_t *buf, uint32_t len)
+{
+   if(WIZCHIP.IF.SPI._write_burst)
+   {
+      WIZCHIP.IF.SPI._write_burst(hdr, hdr_len, buf, len);
+   }
+   else
+   {
+      WIZCHIP.IF.SPI._write_bytes(hdr, hdr_len);
+      WIZCHIP.IF.SPI._write_bytes(buf, len);
+   }
+}
+
 int8_t ctlwizchip(ctlwizchip_type cwtype, void* arg)
 {
    uint8_t tmp = 0;
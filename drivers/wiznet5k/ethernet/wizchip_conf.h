@@ -190,6 +190,9 @@ typedef struct __WIZCHIP
       {
          void (*_read_bytes)  (uint8_t *buf, uint32_t len);
          void (*_write_bytes) (const uint8_t *buf, uint32_t len);
+         // Optional. Send the header and then read or write the data in one transfer.
+         void (*_read_burst)  (const uint8_t *hdr, uint32_t hdr_len, uint8_t *buf, uint32_t len);
+         void (*_write_burst) (const uint8_t *hdr, uint32_t hdr_len, const uint8_t *buf, uint32_t len);
       }SPI;
       // To be added
       //
@@ -397,6 +400,25 @@ void reg_wizchip_bus_cbfunc(uint8_t (*bus_rb)(uint32_t addr), void (*bus_wb)(uin
  */
 void reg_wizchip_spi_cbfunc(void (*spi_rb)(uint8_t *, uint32_t), void (*spi_wb)(const uint8_t *, uint32_t));
 
+/**
+ *@brief Registers call back function for SPI frames sent in one transfer.
+ *@param spi_rburst : callback function to write a frame header and then read its data
+ *@param spi_wburst : callback function to write a frame header and then its data
+ *@note If you do not register, the header and data are sent with the functions
+ *registered by @ref reg_wizchip_spi_cbfunc.
+ */
+void reg_wizchip_spiburst_cbfunc(void (*spi_rburst)(const uint8_t *, uint32_t, uint8_t *, uint32_t),
+                                 void (*spi_wburst)(const uint8_t *, uint32_t, const uint8_t *, uint32_t));
+
+/**
+ *@brief Writes a frame header and reads len bytes of data while the chip is selected.
+ */
+void wizchip_spi_read_frame(const uint8_t *hdr, uint32_t hdr_len, uint8_t *buf, uint32_t len);
+/**
+ *@brief Writes a frame header and len bytes of data while the chip is selected.
+ */
+void wizchip_spi_write_frame(const uint8_t *hdr, uint32_t hdr_len, const uint8_t *buf, uint32_t len);
+
 /**
  * @ingroup extra_functions
  * @brief Controls to the WIZCHIP.
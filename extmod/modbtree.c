@@ -37,9 +37,35 @@
 #include <db.h>
 #include <../../btree/btree.h>
 
+// A write-back cache of whole blocks of the database stream, used in place of
+// the stream when the database is opened with a blocksize. Pages written out
+// of the page cache land here, and a block is only written to the stream when
+// it is evicted or on flush() and close(). Each write is a whole block at a
+// block-aligned offset, so pages smaller than a flash erase block that change
+// together are written once.
+typedef struct _btree_block_t {
+    off_t offset; // -1 if the slot is empty
+    uint32_t last_used;
+    bool dirty;
+} btree_block_t;
+
+typedef struct _btree_blockcache_t {
+    mp_obj_t stream;
+    mp_obj_t buffer; // keeps a caller-supplied buffer alive
+    byte *data;
+    off_t pos;
+    // Size of the stream including blocks that haven't been written back yet.
+    off_t size;
+    size_t block_size;
+    size_t n_blocks;
+    uint32_t clock;
+    btree_block_t blocks[];
+} btree_blockcache_t;
+
 typedef struct _mp_obj_btree_t {
     mp_obj_base_t base;
     DB *db;
+    btree_blockcache_t *cache;
     mp_obj_t start_key;
     mp_obj_t end_key;
     #define FLAG_END_KEY_INCL 1
@@ -63,10 +89,178 @@ void __dbpanic(DB *db) {
     printf("__dbpanic(%p)\n", db);
 }
 
-STATIC mp_obj_btree_t *btree_new(DB *db) {
+STATIC int btree_block_write_back(btree_blockcache_t *cache, btree_block_t *block) {
+    if (!block->dirty) {
+        return 0;
+    }
+    // The last block is only written as far as the end of the data so the
+    // stream doesn't grow past it.
+    size_t len = cache->block_size;
+    if (cache->size - block->offset < (off_t)len) {
+        len = cache->size - block->offset;
+    }
+    byte *data = cache->data + (block - cache->blocks) * cache->block_size;
+    if (mp_stream_posix_lseek(cache->stream, block->offset, MP_SEEK_SET) < 0
+        || mp_stream_posix_write(cache->stream, data, len) != (ssize_t)len) {
+        return -1;
+    }
+    block->dirty = false;
+    return 0;
+}
+
+// Returns the slot holding the block at offset, loading it first unless the
+// caller is about to overwrite all of it.
+STATIC btree_block_t *btree_block_get(btree_blockcache_t *cache, off_t offset, bool overwrite) {
+    btree_block_t *block = NULL;
+    for (size_t i = 0; i < cache->n_blocks; i++) {
+        btree_block_t *b = &cache->blocks[i];
+        if (b->offset == offset) {
+            b->last_used = ++cache->clock;
+            return b;
+        }
+        if (block == NULL || b->offset < 0 || (block->offset >= 0 && b->last_used < block->last_used)) {
+            block = b;
+        }
+    }
+    if (block->offset >= 0 && btree_block_write_back(cache, block) < 0) {
+        return NULL;
+    }
+    block->offset = -1;
+    byte *data = cache->data + (block - cache->blocks) * cache->block_size;
+    size_t len = 0;
+    if (!overwrite && offset < cache->size) {
+        if (mp_stream_posix_lseek(cache->stream, offset, MP_SEEK_SET) < 0) {
+            return NULL;
+        }
+        ssize_t res = mp_stream_posix_read(cache->stream, data, cache->block_size);
+        if (res < 0) {
+            return NULL;
+        }
+        len = res;
+    }
+    memset(data + len, 0, cache->block_size - len);
+    block->offset = offset;
+    block->last_used = ++cache->clock;
+    block->dirty = false;
+    return block;
+}
+
+STATIC ssize_t btree_blockcache_read(mp_obj_t fd, void *buf, size_t len) {
+    btree_blockcache_t *cache = MP_OBJ_TO_PTR(fd);
+    byte *dest = buf;
+    size_t done = 0;
+    while (done < len && cache->pos < cache->size) {
+        size_t in_block = cache->pos % cache->block_size;
+        btree_block_t *block = btree_block_get(cache, cache->pos - in_block, false);
+        if (block == NULL) {
+            return -1;
+        }
+        size_t n = MIN(len - done, cache->block_size - in_block);
+        if ((off_t)n > cache->size - cache->pos) {
+            n = cache->size - cache->pos;
+        }
+        memcpy(dest + done, cache->data + (block - cache->blocks) * cache->block_size + in_block, n);
+        done += n;
+        cache->pos += n;
+    }
+    return done;
+}
+
+STATIC ssize_t btree_blockcache_write(mp_obj_t fd, const void *buf, size_t len) {
+    btree_blockcache_t *cache = MP_OBJ_TO_PTR(fd);
+    const byte *src = buf;
+    size_t done = 0;
+    while (done < len) {
+        size_t in_block = cache->pos % cache->block_size;
+        size_t n = MIN(len - done, cache->block_size - in_block);
+        btree_block_t *block = btree_block_get(cache, cache->pos - in_block, n == cache->block_size);
+        if (block == NULL) {
+            return -1;
+        }
+        memcpy(cache->data + (block - cache->blocks) * cache->block_size + in_block, src + done, n);
+        block->dirty = true;
+        done += n;
+        cache->pos += n;
+        if (cache->pos > cache->size) {
+            cache->size = cache->pos;
+        }
+    }
+    return done;
+}
+
+STATIC off_t btree_blockcache_lseek(mp_obj_t fd, off_t offset, int whence) {
+    btree_blockcache_t *cache = MP_OBJ_TO_PTR(fd);
+    if (whence == MP_SEEK_CUR) {
+        offset += cache->pos;
+    } else if (whence == MP_SEEK_END) {
+        offset += cache->size;
+    }
+    cache->pos = offset;
+    return offset;
+}
+
+// Writes back the dirty blocks in the order they appear in the stream.
+STATIC int btree_blockcache_sync(btree_blockcache_t *cache) {
+    while (true) {
+        btree_block_t *next = NULL;
+        for (size_t i = 0; i < cache->n_blocks; i++) {
+            btree_block_t *b = &cache->blocks[i];
+            if (b->dirty && (next == NULL || b->offset < next->offset)) {
+                next = b;
+            }
+        }
+        if (next == NULL) {
+            break;
+        }
+        if (btree_block_write_back(cache, next) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+STATIC int btree_blockcache_fsync(mp_obj_t fd) {
+    btree_blockcache_t *cache = MP_OBJ_TO_PTR(fd);
+    if (btree_blockcache_sync(cache) < 0) {
+        return -1;
+    }
+    return mp_stream_posix_fsync(cache->stream);
+}
+
+STATIC btree_blockcache_t *btree_blockcache_new(mp_obj_t stream, size_t block_size, size_t n_blocks, mp_obj_t buffer) {
+    btree_blockcache_t *cache = m_new_obj_var(btree_blockcache_t, btree_block_t, n_blocks);
+    cache->stream = stream;
+    cache->buffer = buffer;
+    if (buffer != mp_const_none) {
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(buffer, &bufinfo, MP_BUFFER_WRITE);
+        if (bufinfo.len < block_size * n_blocks) {
+            mp_raise_ValueError(translate("buffer too small"));
+        }
+        cache->data = bufinfo.buf;
+    } else {
+        cache->data = m_new(byte, block_size * n_blocks);
+    }
+    cache->pos = 0;
+    cache->size = mp_stream_posix_lseek(stream, 0, MP_SEEK_END);
+    if (cache->size < 0) {
+        mp_raise_OSError(errno);
+    }
+    cache->block_size = block_size;
+    cache->n_blocks = n_blocks;
+    cache->clock = 0;
+    for (size_t i = 0; i < n_blocks; i++) {
+        cache->blocks[i].offset = -1;
+        cache->blocks[i].dirty = false;
+    }
+    return cache;
+}
+
+STATIC mp_obj_btree_t *btree_new(DB *db, btree_blockcache_t *cache) {
     mp_obj_btree_t *o = m_new_obj(mp_obj_btree_t);
     o->base.type = &btree_type;
     o->db = db;
+    o->cache = cache;
     o->start_key = mp_const_none;
     o->end_key = mp_const_none;
     o->next_flags = 0;
@@ -87,7 +281,12 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(btree_flush_obj, btree_flush);
 
 STATIC mp_obj_t btree_close(mp_obj_t self_in) {
     mp_obj_btree_t *self = MP_OBJ_TO_PTR(self_in);
-    return MP_OBJ_NEW_SMALL_INT(__bt_close(self->db));
+    int res = __bt_close(self->db);
+    // Closing only syncs the stream if the tree changed since the last flush.
+    if (self->cache != NULL && btree_blockcache_sync(self->cache) < 0) {
+        res = RET_ERROR;
+    }
+    return MP_OBJ_NEW_SMALL_INT(res);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(btree_close_obj, btree_close);
 
@@ -327,12 +526,22 @@ STATIC FILEVTABLE btree_stream_fvtable = {
     mp_stream_posix_fsync
 };
 
+STATIC FILEVTABLE btree_blockcache_fvtable = {
+    btree_blockcache_read,
+    btree_blockcache_write,
+    btree_blockcache_lseek,
+    btree_blockcache_fsync
+};
+
 STATIC mp_obj_t mod_btree_open(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_flags, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
         { MP_QSTR_cachesize, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
         { MP_QSTR_pagesize, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
         { MP_QSTR_minkeypage, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_blocksize, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_blocks, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 4} },
+        { MP_QSTR_buffer, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
     };
 
     // Make sure we got a stream object
@@ -343,6 +552,9 @@ STATIC mp_obj_t mod_btree_open(size_t n_args, const mp_obj_t *pos_args, mp_map_t
         mp_arg_val_t cachesize;
         mp_arg_val_t pagesize;
         mp_arg_val_t minkeypage;
+        mp_arg_val_t blocksize;
+        mp_arg_val_t blocks;
+        mp_arg_val_t buffer;
     } args;
     mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args,
         MP_ARRAY_SIZE(allowed_args), allowed_args, (mp_arg_val_t*)&args);
@@ -352,11 +564,27 @@ STATIC mp_obj_t mod_btree_open(size_t n_args, const mp_obj_t *pos_args, mp_map_t
     openinfo.psize = args.pagesize.u_int;
     openinfo.minkeypage = args.minkeypage.u_int;
 
-    DB *db = __bt_open(pos_args[0], &btree_stream_fvtable, &openinfo, /*dflags*/0);
+    btree_blockcache_t *cache = NULL;
+    if (args.blocksize.u_int > 0) {
+        if (args.blocks.u_int < 1) {
+            mp_raise_ValueError(translate("blocks must be at least 1"));
+        }
+        if (openinfo.psize == 0) {
+            openinfo.psize = args.blocksize.u_int;
+        }
+        cache = btree_blockcache_new(pos_args[0], args.blocksize.u_int, args.blocks.u_int, args.buffer.u_obj);
+    }
+
+    DB *db;
+    if (cache != NULL) {
+        db = __bt_open(MP_OBJ_FROM_PTR(cache), &btree_blockcache_fvtable, &openinfo, /*dflags*/0);
+    } else {
+        db = __bt_open(pos_args[0], &btree_stream_fvtable, &openinfo, /*dflags*/0);
+    }
     if (db == NULL) {
         mp_raise_OSError(errno);
     }
-    return MP_OBJ_FROM_PTR(btree_new(db));
+    return MP_OBJ_FROM_PTR(btree_new(db, cache));
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(mod_btree_open_obj, 1, mod_btree_open);
 
@@ -34,6 +34,11 @@
 
 #include "font_petme128_8x8.h"
 
+#if CIRCUITPY_DISPLAYIO
+#include "shared-bindings/displayio/Bitmap.h"
+#include "shared-module/displayio/Bitmap.h"
+#endif
+
 typedef struct _mp_obj_framebuf_t {
     mp_obj_base_t base;
     mp_obj_t buf_obj; // need to store this to prevent GC from reclaiming buf
@@ -61,6 +66,7 @@ typedef struct _mp_framebuf_p_t {
 #define FRAMEBUF_GS8      (6)
 #define FRAMEBUF_MHLSB    (3)
 #define FRAMEBUF_MHMSB    (4)
+#define FRAMEBUF_BITMAP   (7)
 
 // Functions for MHLSB and MHMSB
 
@@ -228,6 +234,23 @@ STATIC void gs8_fill_rect(const mp_obj_framebuf_t *fb, int x, int y, int w, int
     }
 }
 
+#if CIRCUITPY_DISPLAYIO
+// Functions for BITMAP format, which draws into the storage of the displayio.Bitmap in buf_obj
+
+STATIC void bitmap_setpixel(const mp_obj_framebuf_t *fb, int x, int y, uint32_t col) {
+    displayio_bitmap_write_pixel(MP_OBJ_TO_PTR(fb->buf_obj), x, y, col);
+}
+
+STATIC uint32_t bitmap_getpixel(const mp_obj_framebuf_t *fb, int x, int y) {
+    return common_hal_displayio_bitmap_get_pixel(MP_OBJ_TO_PTR(fb->buf_obj), x, y);
+}
+
+STATIC void bitmap_fill_rect(const mp_obj_framebuf_t *fb, int x, int y, int w, int h, uint32_t col) {
+    // This marks the area dirty too.
+    common_hal_displayio_bitmap_fill_region(MP_OBJ_TO_PTR(fb->buf_obj), x, y, x + w, y + h, col);
+}
+#endif
+
 STATIC mp_framebuf_p_t formats[] = {
     [FRAMEBUF_MVLSB] = {MP_PROTO_IMPLEMENT(MP_QSTR_protocol_framebuf) mvlsb_setpixel, mvlsb_getpixel, mvlsb_fill_rect},
     [FRAMEBUF_RGB565] = {MP_PROTO_IMPLEMENT(MP_QSTR_protocol_framebuf) rgb565_setpixel, rgb565_getpixel, rgb565_fill_rect},
@@ -236,6 +259,9 @@ STATIC mp_framebuf_p_t formats[] = {
     [FRAMEBUF_GS8] = {MP_PROTO_IMPLEMENT(MP_QSTR_protocol_framebuf) gs8_setpixel, gs8_getpixel, gs8_fill_rect},
     [FRAMEBUF_MHLSB] = {MP_PROTO_IMPLEMENT(MP_QSTR_protocol_framebuf) mono_horiz_setpixel, mono_horiz_getpixel, mono_horiz_fill_rect},
     [FRAMEBUF_MHMSB] = {MP_PROTO_IMPLEMENT(MP_QSTR_protocol_framebuf) mono_horiz_setpixel, mono_horiz_getpixel, mono_horiz_fill_rect},
+    #if CIRCUITPY_DISPLAYIO
+    [FRAMEBUF_BITMAP] = {MP_PROTO_IMPLEMENT(MP_QSTR_protocol_framebuf) bitmap_setpixel, bitmap_getpixel, bitmap_fill_rect},
+    #endif
 };
 
 static inline void setpixel(const mp_obj_framebuf_t *fb, int x, int y, uint32_t col) {
@@ -246,6 +272,23 @@ static inline uint32_t getpixel(const mp_obj_framebuf_t *fb, int x, int y) {
     return formats[fb->format].getpixel(fb, x, y);
 }
 
+// setpixel doesn't tell a Bitmap that it's changed, so drawing calls that use it report the area
+// they drew in here once they're done.
+STATIC void mark_dirty(const mp_obj_framebuf_t *fb, int x1, int y1, int x2, int y2) {
+    #if CIRCUITPY_DISPLAYIO
+    if (fb->format == FRAMEBUF_BITMAP) {
+        displayio_bitmap_mark_dirty(MP_OBJ_TO_PTR(fb->buf_obj), MAX(x1, 0), MAX(y1, 0),
+            MIN(x2, fb->width), MIN(y2, fb->height));
+    }
+    #else
+    (void)fb;
+    (void)x1;
+    (void)y1;
+    (void)x2;
+    (void)y2;
+    #endif
+}
+
 STATIC void fill_rect(const mp_obj_framebuf_t *fb, int x, int y, int w, int h, uint32_t col) {
     if (h < 1 || w < 1 || x + w <= 0 || y + h <= 0 || y >= fb->height || x >= fb->width) {
         // No operation needed.
@@ -268,13 +311,32 @@ STATIC mp_obj_t framebuf_make_new(const mp_obj_type_t *type, size_t n_args, cons
     o->base.type = type;
     o->buf_obj = args[0];
 
+    o->width = mp_obj_get_int(args[1]);
+    o->height = mp_obj_get_int(args[2]);
+    o->format = mp_obj_get_int(args[3]);
+
+    #if CIRCUITPY_DISPLAYIO
+    // A Bitmap is drawn into in place, in its own layout, and knows what has changed.
+    if (MP_OBJ_IS_TYPE(args[0], &displayio_bitmap_type)) {
+        displayio_bitmap_t *bitmap = MP_OBJ_TO_PTR(args[0]);
+        if (o->format != FRAMEBUF_BITMAP) {
+            mp_raise_ValueError(translate("invalid format"));
+        }
+        if (bitmap->read_only) {
+            mp_raise_RuntimeError(translate("Read-only object"));
+        }
+        o->buf = bitmap->data;
+        o->width = MIN(o->width, bitmap->width);
+        o->height = MIN(o->height, bitmap->height);
+        o->stride = bitmap->stride;
+        return MP_OBJ_FROM_PTR(o);
+    }
+    #endif
+
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(args[0], &bufinfo, MP_BUFFER_WRITE);
     o->buf = bufinfo.buf;
 
-    o->width = mp_obj_get_int(args[1]);
-    o->height = mp_obj_get_int(args[2]);
-    o->format = mp_obj_get_int(args[3]);
     if (n_args >= 5) {
         o->stride = mp_obj_get_int(args[4]);
     } else {
@@ -308,6 +370,14 @@ STATIC mp_int_t framebuf_get_buffer(mp_obj_t self_in, mp_buffer_info_t *bufinfo,
     (void)flags;
     mp_obj_framebuf_t *self = MP_OBJ_TO_PTR(self_in);
     bufinfo->buf = self->buf;
+    #if CIRCUITPY_DISPLAYIO
+    if (self->format == FRAMEBUF_BITMAP) {
+        // Bitmap rows are a stride of words.
+        bufinfo->len = self->stride * self->height * sizeof(size_t);
+        bufinfo->typecode = 'B';
+        return 0;
+    }
+    #endif
     bufinfo->len = self->stride * self->height * (self->format == FRAMEBUF_RGB565 ? 2 : 1);
     bufinfo->typecode = 'B'; // view framebuf as bytes
     return 0;
@@ -348,6 +418,7 @@ STATIC mp_obj_t framebuf_pixel(size_t n_args, const mp_obj_t *args) {
         } else {
             // set
             setpixel(self, x, y, mp_obj_get_int(args[3]));
+            mark_dirty(self, x, y, x + 1, y + 1);
         }
     }
     return mp_const_none;
@@ -412,6 +483,8 @@ STATIC mp_obj_t framebuf_line(size_t n_args, const mp_obj_t *args) {
     mp_int_t x2 = mp_obj_get_int(args[3]);
     mp_int_t y2 = mp_obj_get_int(args[4]);
     mp_int_t col = mp_obj_get_int(args[5]);
+    mp_int_t x1_start = x1;
+    mp_int_t y1_start = y1;
 
     mp_int_t dx = x2 - x1;
     mp_int_t sx;
@@ -464,6 +537,7 @@ STATIC mp_obj_t framebuf_line(size_t n_args, const mp_obj_t *args) {
     if (0 <= x2 && x2 < self->width && 0 <= y2 && y2 < self->height) {
         setpixel(self, x2, y2, col);
     }
+    mark_dirty(self, MIN(x1_start, x2), MIN(y1_start, y2), MAX(x1_start, x2) + 1, MAX(y1_start, y2) + 1);
 
     return mp_const_none;
 }
@@ -496,6 +570,7 @@ STATIC mp_obj_t framebuf_blit(size_t n_args, const mp_obj_t *args) {
     int y1 = MAX(0, -y);
     int x0end = MIN(self->width, x + source->width);
     int y0end = MIN(self->height, y + source->height);
+    mark_dirty(self, x0, y0, x0end, y0end);
 
     for (; y0 < y0end; ++y0) {
         int cx1 = x1;
@@ -540,6 +615,7 @@ STATIC mp_obj_t framebuf_scroll(mp_obj_t self_in, mp_obj_t xstep_in, mp_obj_t ys
             setpixel(self, x, y, getpixel(self, x - xstep, y - ystep));
         }
     }
+    mark_dirty(self, 0, 0, self->width, self->height);
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_3(framebuf_scroll_obj, framebuf_scroll);
@@ -554,6 +630,7 @@ STATIC mp_obj_t framebuf_text(size_t n_args, const mp_obj_t *args) {
     if (n_args >= 5) {
         col = mp_obj_get_int(args[4]);
     }
+    mark_dirty(self, x0, y0, x0 + 8 * (mp_int_t)strlen(str), y0 + 8);
 
     // loop over chars
     for (; *str; ++str) {
@@ -638,6 +715,9 @@ STATIC const mp_rom_map_elem_t framebuf_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_GS8), MP_ROM_INT(FRAMEBUF_GS8) },
     { MP_ROM_QSTR(MP_QSTR_MONO_HLSB), MP_ROM_INT(FRAMEBUF_MHLSB) },
     { MP_ROM_QSTR(MP_QSTR_MONO_HMSB), MP_ROM_INT(FRAMEBUF_MHMSB) },
+    #if CIRCUITPY_DISPLAYIO
+    { MP_ROM_QSTR(MP_QSTR_BITMAP), MP_ROM_INT(FRAMEBUF_BITMAP) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(framebuf_module_globals, framebuf_module_globals_table);
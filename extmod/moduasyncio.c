@@ -0,0 +1,793 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "py/mphal.h"
+#include "py/objexcept.h"
+#include "py/runtime.h"
+#include "py/smallint.h"
+#include "py/stream.h"
+
+#include "supervisor/shared/translate.h"
+
+#if MICROPY_PY_UASYNCIO
+
+// The event loop runs coroutines (generators) wrapped in Task objects.  Tasks
+// that are ready to run and tasks that sleep are kept in a single heap, ordered
+// by the tick at which they are due, as in utimeq.  Tasks waiting for an event,
+// a flag, a stream or another task are kept out of that heap until they are
+// woken.  Awaitables are C iterators: the first call of iternext blocks the
+// current task and yields, and the call made when the task is resumed ends the
+// await.
+
+#define MODULO MICROPY_PY_UTIME_TICKS_PERIOD
+
+typedef struct _mp_task_queue_t {
+    size_t len;
+    size_t alloc;
+    struct _mp_obj_task_t **items;
+} mp_task_queue_t;
+
+enum {
+    TASK_RUNNING,
+    TASK_DONE,
+    TASK_FAILED,
+};
+
+typedef struct _mp_obj_task_t {
+    mp_obj_base_t base;
+    mp_obj_t coro;
+    // exception to throw into the coroutine when it's next resumed, or its
+    // return value or exception once it has finished
+    mp_obj_t data;
+    // the awaitable this task is blocked on, or MP_OBJ_NULL
+    mp_obj_t awaiting;
+    // the queue this task is in and its position there
+    mp_task_queue_t *queue;
+    size_t index;
+    mp_uint_t key;
+    mp_uint_t seq;
+    uint8_t state;
+    // tasks awaiting this one
+    mp_task_queue_t waiting;
+} mp_obj_task_t;
+
+typedef struct _mp_obj_event_t {
+    mp_obj_base_t base;
+    bool is_set;
+    mp_task_queue_t waiting;
+} mp_obj_event_t;
+
+typedef struct _mp_obj_flag_t {
+    mp_obj_base_t base;
+    volatile bool is_set;
+    mp_obj_task_t *waiter;
+    struct _mp_obj_flag_t *next;
+} mp_obj_flag_t;
+
+typedef struct _mp_obj_io_wait_t {
+    mp_obj_base_t base;
+    mp_obj_t stream;
+    mp_uint_t flags;
+    mp_obj_task_t *waiter;
+    struct _mp_obj_io_wait_t *next;
+} mp_obj_io_wait_t;
+
+typedef struct _mp_obj_sleep_t {
+    mp_obj_base_t base;
+    mp_uint_t ms;
+} mp_obj_sleep_t;
+
+typedef struct _mp_uasyncio_state_t {
+    mp_task_queue_t run_queue;
+    mp_obj_task_t *cur_task;
+    mp_uint_t seq;
+    // flags and streams with a task waiting on them
+    mp_obj_flag_t *flags;
+    mp_obj_io_wait_t *io_waits;
+} mp_uasyncio_state_t;
+
+STATIC const mp_obj_type_t task_type;
+STATIC const mp_obj_type_t event_type;
+STATIC const mp_obj_type_t flag_type;
+STATIC const mp_obj_type_t io_wait_type;
+STATIC const mp_obj_type_t sleep_type;
+
+MP_DEFINE_EXCEPTION(CancelledError, Exception)
+
+// Set by ThreadSafeFlag.set and Event.set, which may run in an interrupt or a
+// scheduled callback, to end the wait for the next task.
+STATIC volatile bool uasyncio_wake;
+
+// sleep_ms returns this object, so that sleeping doesn't allocate
+STATIC mp_obj_sleep_t uasyncio_sleep_singleton = {{&sleep_type}, 0};
+
+STATIC mp_uint_t ticks(void) {
+    return mp_hal_ticks_ms() & (MODULO - 1);
+}
+
+STATIC mp_int_t ticks_diff(mp_uint_t end, mp_uint_t start) {
+    return ((end - start + MODULO / 2) & (MODULO - 1)) - MODULO / 2;
+}
+
+STATIC mp_uasyncio_state_t *get_state(void) {
+    if (MP_STATE_VM(uasyncio_state) == NULL) {
+        MP_STATE_VM(uasyncio_state) = m_new0(mp_uasyncio_state_t, 1);
+    }
+    return MP_STATE_VM(uasyncio_state);
+}
+
+STATIC mp_obj_task_t *get_cur_task(void) {
+    mp_obj_task_t *task = get_state()->cur_task;
+    if (task == NULL) {
+        mp_raise_RuntimeError(translate("not in a task"));
+    }
+    return task;
+}
+
+/******************************************************************************/
+// task queue, a heap of tasks that know their position in it
+
+STATIC bool task_less_than(mp_obj_task_t *a, mp_obj_task_t *b) {
+    mp_int_t diff = ticks_diff(a->key, b->key);
+    if (diff != 0) {
+        return diff < 0;
+    }
+    return (mp_int_t)(a->seq - b->seq) < 0;
+}
+
+STATIC void queue_place(mp_task_queue_t *q, size_t pos, mp_obj_task_t *task) {
+    q->items[pos] = task;
+    task->index = pos;
+}
+
+STATIC void queue_siftdown(mp_task_queue_t *q, size_t pos) {
+    mp_obj_task_t *task = q->items[pos];
+    while (pos > 0) {
+        size_t parent_pos = (pos - 1) >> 1;
+        if (!task_less_than(task, q->items[parent_pos])) {
+            break;
+        }
+        queue_place(q, pos, q->items[parent_pos]);
+        pos = parent_pos;
+    }
+    queue_place(q, pos, task);
+}
+
+STATIC void queue_siftup(mp_task_queue_t *q, size_t pos) {
+    mp_obj_task_t *task = q->items[pos];
+    for (size_t child_pos = 2 * pos + 1; child_pos < q->len; child_pos = 2 * pos + 1) {
+        // choose the right child if it's earlier than the left one
+        if (child_pos + 1 < q->len && task_less_than(q->items[child_pos + 1], q->items[child_pos])) {
+            child_pos += 1;
+        }
+        if (!task_less_than(q->items[child_pos], task)) {
+            break;
+        }
+        queue_place(q, pos, q->items[child_pos]);
+        pos = child_pos;
+    }
+    queue_place(q, pos, task);
+}
+
+STATIC void queue_push(mp_task_queue_t *q, mp_obj_task_t *task, mp_uint_t key) {
+    assert(task->queue == NULL);
+    if (q->len == q->alloc) {
+        size_t alloc = q->alloc ? q->alloc * 2 : 4;
+        q->items = m_renew(mp_obj_task_t*, q->items, q->alloc, alloc);
+        q->alloc = alloc;
+    }
+    task->key = key;
+    task->seq = get_state()->seq++;
+    task->queue = q;
+    queue_place(q, q->len++, task);
+    queue_siftdown(q, task->index);
+}
+
+STATIC void queue_remove(mp_obj_task_t *task) {
+    mp_task_queue_t *q = task->queue;
+    size_t pos = task->index;
+    task->queue = NULL;
+    q->len -= 1;
+    mp_obj_task_t *last = q->items[q->len];
+    q->items[q->len] = NULL; // so we don't retain a pointer
+    if (pos < q->len) {
+        queue_place(q, pos, last);
+        if (pos > 0 && task_less_than(last, q->items[(pos - 1) >> 1])) {
+            queue_siftdown(q, pos);
+        } else {
+            queue_siftup(q, pos);
+        }
+    }
+}
+
+STATIC mp_obj_task_t *queue_pop(mp_task_queue_t *q) {
+    mp_obj_task_t *task = q->items[0];
+    queue_remove(task);
+    return task;
+}
+
+STATIC void run_soon(mp_obj_task_t *task) {
+    queue_push(&get_state()->run_queue, task, ticks());
+}
+
+// Wake every task in the queue.
+STATIC void queue_wake_all(mp_task_queue_t *q) {
+    while (q->len > 0) {
+        run_soon(queue_pop(q));
+    }
+}
+
+// Block the current task on the awaitable, to be woken by whatever that waits for.
+STATIC mp_obj_task_t *block_cur_task(mp_obj_t awaitable) {
+    mp_obj_task_t *task = get_cur_task();
+    task->awaiting = awaitable;
+    return task;
+}
+
+// Returns true if the current task was blocked on the awaitable and has now
+// been woken, so the await is over.
+STATIC bool cur_task_woken(mp_obj_t awaitable) {
+    mp_obj_task_t *task = get_cur_task();
+    if (task->awaiting == awaitable) {
+        task->awaiting = MP_OBJ_NULL;
+        return true;
+    }
+    return false;
+}
+
+/******************************************************************************/
+// waiting for the next task
+
+STATIC bool stream_ready(mp_obj_io_wait_t *io_wait) {
+    const mp_stream_p_t *stream_p = mp_get_stream(io_wait->stream);
+    int errcode;
+    mp_uint_t ret = stream_p->ioctl(io_wait->stream, MP_STREAM_POLL, io_wait->flags, &errcode);
+    // on an error let the task do its operation and see the error
+    return ret == MP_STREAM_ERROR || ret != 0;
+}
+
+STATIC bool poll_io_waits(mp_uasyncio_state_t *state) {
+    bool woken = false;
+    for (mp_obj_io_wait_t **p = &state->io_waits; *p != NULL;) {
+        mp_obj_io_wait_t *io_wait = *p;
+        if (stream_ready(io_wait)) {
+            *p = io_wait->next;
+            io_wait->next = NULL;
+            run_soon(io_wait->waiter);
+            io_wait->waiter = NULL;
+            woken = true;
+        } else {
+            p = &io_wait->next;
+        }
+    }
+    return woken;
+}
+
+STATIC void wake_flag_waiters(mp_uasyncio_state_t *state) {
+    uasyncio_wake = false;
+    for (mp_obj_flag_t **p = &state->flags; *p != NULL;) {
+        mp_obj_flag_t *flag = *p;
+        if (flag->is_set) {
+            flag->is_set = false;
+            *p = flag->next;
+            flag->next = NULL;
+            run_soon(flag->waiter);
+            flag->waiter = NULL;
+        } else {
+            p = &flag->next;
+        }
+    }
+}
+
+#if MICROPY_STREAMS_READY_EVENTS
+// Streams that all signal when they may have become ready needn't be polled
+// again until one does.
+STATIC bool io_waits_signal_ready(mp_uasyncio_state_t *state) {
+    for (mp_obj_io_wait_t *io_wait = state->io_waits; io_wait != NULL; io_wait = io_wait->next) {
+        if (!mp_get_stream(io_wait->stream)->signals_ready) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+// Wait until timeout_ms have passed, a task has been woken or a stream waited
+// on is ready.  A negative timeout waits until something happens.
+STATIC void wait_for_event(mp_uasyncio_state_t *state, mp_int_t timeout_ms) {
+    mp_uint_t start = ticks();
+    while (!uasyncio_wake) {
+        #if MICROPY_STREAMS_READY_EVENTS
+        uint32_t events = mp_stream_ready_events();
+        #endif
+        if (state->io_waits != NULL && poll_io_waits(state)) {
+            break;
+        }
+        if (timeout_ms >= 0 && ticks_diff(ticks(), start) >= timeout_ms) {
+            break;
+        }
+        MICROPY_EVENT_POLL_HOOK
+        #if MICROPY_STREAMS_READY_EVENTS
+        if (io_waits_signal_ready(state)) {
+            // only a stream, a flag or the timeout can end the wait now
+            while (!uasyncio_wake && mp_stream_ready_events() == events
+                   && (timeout_ms < 0 || ticks_diff(ticks(), start) < timeout_ms)) {
+                MICROPY_EVENT_WAIT_HOOK
+                MICROPY_EVENT_POLL_HOOK
+            }
+        }
+        #endif
+    }
+    if (uasyncio_wake) {
+        wake_flag_waiters(state);
+    }
+}
+
+/******************************************************************************/
+// running tasks
+
+STATIC mp_obj_task_t *task_new(mp_obj_t coro) {
+    mp_obj_task_t *task = m_new_obj(mp_obj_task_t);
+    memset(task, 0, sizeof(*task));
+    task->base.type = &task_type;
+    task->coro = coro;
+    task->data = mp_const_none;
+    task->awaiting = MP_OBJ_NULL;
+    task->state = TASK_RUNNING;
+    run_soon(task);
+    return task;
+}
+
+// The exception of a task that failed is reported unless report is false, or
+// other tasks are awaiting it and so will see it.
+STATIC void task_finish(mp_obj_task_t *task, mp_vm_return_kind_t ret_kind, mp_obj_t ret_val, bool report) {
+    task->state = ret_kind == MP_VM_RETURN_NORMAL ? TASK_DONE : TASK_FAILED;
+    if (task->state == TASK_FAILED) {
+        // awaiting tasks raise it again
+        mp_obj_exception_keep(ret_val);
+    }
+    task->data = ret_val;
+    task->coro = mp_const_none;
+    if (report && task->state == TASK_FAILED && task->waiting.len == 0
+        && !mp_obj_is_subclass_fast(MP_OBJ_FROM_PTR(mp_obj_get_type(ret_val)), MP_OBJ_FROM_PTR(&mp_type_CancelledError))) {
+        // nothing will see this exception, so report it
+        mp_printf(&mp_plat_print, "Task exception wasn't retrieved\n");
+        mp_obj_print_exception(&mp_plat_print, ret_val);
+    }
+    queue_wake_all(&task->waiting);
+}
+
+// Run tasks until the given one has finished.
+STATIC void run_until_complete(mp_obj_task_t *main_task) {
+    mp_uasyncio_state_t *state = get_state();
+    state->cur_task = NULL;
+    while (main_task->state == TASK_RUNNING) {
+        if (uasyncio_wake) {
+            wake_flag_waiters(state);
+        }
+        mp_task_queue_t *q = &state->run_queue;
+        mp_int_t wait_ms = -1;
+        if (q->len > 0) {
+            wait_ms = ticks_diff(q->items[0]->key, ticks());
+            if (wait_ms <= 0) {
+                wait_ms = 0;
+            }
+        }
+        if (wait_ms != 0) {
+            wait_for_event(state, wait_ms);
+            continue;
+        }
+        if (state->io_waits != NULL) {
+            // streams don't signal being ready, so check them between tasks too
+            poll_io_waits(state);
+        }
+
+        mp_obj_task_t *task = queue_pop(q);
+        mp_obj_t exc = task->data;
+        task->data = mp_const_none;
+        mp_obj_t ret_val;
+        state->cur_task = task;
+        mp_vm_return_kind_t ret_kind;
+        if (exc == mp_const_none) {
+            ret_kind = mp_resume(task->coro, mp_const_none, MP_OBJ_NULL, &ret_val);
+        } else {
+            ret_kind = mp_resume(task->coro, MP_OBJ_NULL, exc, &ret_val);
+        }
+        state->cur_task = NULL;
+
+        if (ret_kind == MP_VM_RETURN_YIELD) {
+            // a bare yield, or an awaitable that didn't block the task, runs it again soon
+            if (task->queue == NULL && task->awaiting == MP_OBJ_NULL) {
+                run_soon(task);
+            }
+        } else {
+            if (ret_kind == MP_VM_RETURN_EXCEPTION
+                && !mp_obj_is_subclass_fast(MP_OBJ_FROM_PTR(mp_obj_get_type(ret_val)), MP_OBJ_FROM_PTR(&mp_type_Exception))) {
+                // KeyboardInterrupt, SystemExit and the like stop the loop
+                task_finish(task, ret_kind, ret_val, false);
+                nlr_raise(ret_val);
+            }
+            // run() raises the exception of the main task
+            task_finish(task, ret_kind, ret_val == MP_OBJ_STOP_ITERATION ? mp_const_none : ret_val, task != main_task);
+        }
+    }
+}
+
+STATIC mp_obj_t uasyncio_run(mp_obj_t coro) {
+    mp_obj_task_t *task = task_new(coro);
+    run_until_complete(task);
+    if (task->state == TASK_FAILED) {
+        nlr_raise(task->data);
+    }
+    return task->data;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(uasyncio_run_obj, uasyncio_run);
+
+STATIC mp_obj_t uasyncio_create_task(mp_obj_t coro) {
+    return MP_OBJ_FROM_PTR(task_new(coro));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(uasyncio_create_task_obj, uasyncio_create_task);
+
+STATIC mp_obj_t uasyncio_current_task(void) {
+    return MP_OBJ_FROM_PTR(get_cur_task());
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(uasyncio_current_task_obj, uasyncio_current_task);
+
+/******************************************************************************/
+// Task
+
+STATIC void task_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    (void)kind;
+    mp_printf(print, "<Task %p>", MP_OBJ_TO_PTR(self_in));
+}
+
+STATIC mp_obj_t task_done(mp_obj_t self_in) {
+    mp_obj_task_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_bool(self->state != TASK_RUNNING);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(task_done_obj, task_done);
+
+STATIC mp_obj_t task_cancel(mp_obj_t self_in) {
+    mp_obj_task_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->state != TASK_RUNNING) {
+        return mp_const_false;
+    }
+    mp_uasyncio_state_t *state = get_state();
+    if (self == state->cur_task) {
+        mp_raise_RuntimeError(translate("can't cancel self"));
+    }
+    // take the task away from whatever it waits for
+    if (self->queue != NULL) {
+        queue_remove(self);
+    }
+    if (self->awaiting != MP_OBJ_NULL) {
+        if (MP_OBJ_IS_TYPE(self->awaiting, &flag_type)) {
+            mp_obj_flag_t *flag = MP_OBJ_TO_PTR(self->awaiting);
+            for (mp_obj_flag_t **p = &state->flags; *p != NULL; p = &(*p)->next) {
+                if (*p == flag) {
+                    *p = flag->next;
+                    break;
+                }
+            }
+            flag->next = NULL;
+            flag->waiter = NULL;
+        } else if (MP_OBJ_IS_TYPE(self->awaiting, &io_wait_type)) {
+            mp_obj_io_wait_t *io_wait = MP_OBJ_TO_PTR(self->awaiting);
+            for (mp_obj_io_wait_t **p = &state->io_waits; *p != NULL; p = &(*p)->next) {
+                if (*p == io_wait) {
+                    *p = io_wait->next;
+                    break;
+                }
+            }
+            io_wait->next = NULL;
+            io_wait->waiter = NULL;
+        }
+        self->awaiting = MP_OBJ_NULL;
+    }
+    self->data = mp_obj_new_exception(&mp_type_CancelledError);
+    run_soon(self);
+    return mp_const_true;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(task_cancel_obj, task_cancel);
+
+// Awaiting a task waits for it to finish, then returns its result or raises
+// its exception.
+STATIC mp_obj_t task_iternext(mp_obj_t self_in) {
+    mp_obj_task_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->state == TASK_RUNNING) {
+        if (get_cur_task() == self) {
+            mp_raise_RuntimeError(translate("can't await self"));
+        }
+        queue_push(&self->waiting, block_cur_task(self_in), ticks());
+        return mp_const_none;
+    }
+    get_cur_task()->awaiting = MP_OBJ_NULL;
+    if (self->state == TASK_FAILED) {
+        nlr_raise(self->data);
+    }
+    if (self->data == mp_const_none) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    nlr_raise(mp_obj_new_exception_arg1(&mp_type_StopIteration, self->data));
+}
+
+STATIC const mp_rom_map_elem_t task_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_done), MP_ROM_PTR(&task_done_obj) },
+    { MP_ROM_QSTR(MP_QSTR_cancel), MP_ROM_PTR(&task_cancel_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(task_locals_dict, task_locals_dict_table);
+
+STATIC const mp_obj_type_t task_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Task,
+    .print = task_print,
+    .getiter = mp_identity_getiter,
+    .iternext = task_iternext,
+    .locals_dict = (mp_obj_dict_t*)&task_locals_dict,
+};
+
+/******************************************************************************/
+// sleep
+
+STATIC mp_obj_t sleep_iternext(mp_obj_t self_in) {
+    mp_obj_sleep_t *self = MP_OBJ_TO_PTR(self_in);
+    if (cur_task_woken(self_in)) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    mp_obj_task_t *task = block_cur_task(self_in);
+    queue_push(&get_state()->run_queue, task, (ticks() + self->ms) & (MODULO - 1));
+    return mp_const_none;
+}
+
+STATIC const mp_obj_type_t sleep_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_sleep,
+    .getiter = mp_identity_getiter,
+    .iternext = sleep_iternext,
+};
+
+STATIC mp_obj_t uasyncio_sleep_ms_helper(mp_int_t ms) {
+    uasyncio_sleep_singleton.ms = ms > 0 ? (mp_uint_t)ms : 0;
+    return MP_OBJ_FROM_PTR(&uasyncio_sleep_singleton);
+}
+
+STATIC mp_obj_t uasyncio_sleep_ms(mp_obj_t ms_in) {
+    return uasyncio_sleep_ms_helper(mp_obj_get_int(ms_in));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(uasyncio_sleep_ms_obj, uasyncio_sleep_ms);
+
+STATIC mp_obj_t uasyncio_sleep(mp_obj_t s_in) {
+    #if MICROPY_PY_BUILTINS_FLOAT
+    return uasyncio_sleep_ms_helper(1000 * mp_obj_get_float(s_in));
+    #else
+    return uasyncio_sleep_ms_helper(1000 * mp_obj_get_int(s_in));
+    #endif
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(uasyncio_sleep_obj, uasyncio_sleep);
+
+/******************************************************************************/
+// Event
+
+STATIC mp_obj_t event_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    (void)args;
+    mp_arg_check_num(n_args, kw_args, 0, 0, false);
+    mp_obj_event_t *o = m_new_obj(mp_obj_event_t);
+    memset(o, 0, sizeof(*o));
+    o->base.type = type;
+    return MP_OBJ_FROM_PTR(o);
+}
+
+STATIC mp_obj_t event_is_set(mp_obj_t self_in) {
+    mp_obj_event_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_bool(self->is_set);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(event_is_set_obj, event_is_set);
+
+STATIC mp_obj_t event_set(mp_obj_t self_in) {
+    mp_obj_event_t *self = MP_OBJ_TO_PTR(self_in);
+    self->is_set = true;
+    if (self->waiting.len > 0) {
+        queue_wake_all(&self->waiting);
+        uasyncio_wake = true;
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(event_set_obj, event_set);
+
+STATIC mp_obj_t event_clear(mp_obj_t self_in) {
+    mp_obj_event_t *self = MP_OBJ_TO_PTR(self_in);
+    self->is_set = false;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(event_clear_obj, event_clear);
+
+STATIC mp_obj_t event_wait(mp_obj_t self_in) {
+    return self_in;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(event_wait_obj, event_wait);
+
+// The event itself is what wait() returns for awaiting.
+STATIC mp_obj_t event_iternext(mp_obj_t self_in) {
+    mp_obj_event_t *self = MP_OBJ_TO_PTR(self_in);
+    if (cur_task_woken(self_in) || self->is_set) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    queue_push(&self->waiting, block_cur_task(self_in), ticks());
+    return mp_const_none;
+}
+
+STATIC const mp_rom_map_elem_t event_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_is_set), MP_ROM_PTR(&event_is_set_obj) },
+    { MP_ROM_QSTR(MP_QSTR_set), MP_ROM_PTR(&event_set_obj) },
+    { MP_ROM_QSTR(MP_QSTR_clear), MP_ROM_PTR(&event_clear_obj) },
+    { MP_ROM_QSTR(MP_QSTR_wait), MP_ROM_PTR(&event_wait_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(event_locals_dict, event_locals_dict_table);
+
+STATIC const mp_obj_type_t event_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Event,
+    .make_new = event_make_new,
+    .getiter = mp_identity_getiter,
+    .iternext = event_iternext,
+    .locals_dict = (mp_obj_dict_t*)&event_locals_dict,
+};
+
+/******************************************************************************/
+// ThreadSafeFlag, which can be set from an interrupt handler
+
+STATIC mp_obj_t flag_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    (void)args;
+    mp_arg_check_num(n_args, kw_args, 0, 0, false);
+    mp_obj_flag_t *o = m_new_obj(mp_obj_flag_t);
+    memset(o, 0, sizeof(*o));
+    o->base.type = type;
+    return MP_OBJ_FROM_PTR(o);
+}
+
+// Doesn't allocate or touch the task queues, so it's safe to call from an
+// interrupt.  The loop wakes the waiting task.
+STATIC mp_obj_t flag_set(mp_obj_t self_in) {
+    mp_obj_flag_t *self = MP_OBJ_TO_PTR(self_in);
+    self->is_set = true;
+    uasyncio_wake = true;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(flag_set_obj, flag_set);
+
+STATIC mp_obj_t flag_clear(mp_obj_t self_in) {
+    mp_obj_flag_t *self = MP_OBJ_TO_PTR(self_in);
+    self->is_set = false;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(flag_clear_obj, flag_clear);
+
+STATIC mp_obj_t flag_iternext(mp_obj_t self_in) {
+    mp_obj_flag_t *self = MP_OBJ_TO_PTR(self_in);
+    if (cur_task_woken(self_in)) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    if (self->is_set) {
+        self->is_set = false;
+        return MP_OBJ_STOP_ITERATION;
+    }
+    if (self->waiter != NULL) {
+        mp_raise_RuntimeError(translate("flag already has a waiter"));
+    }
+    self->waiter = block_cur_task(self_in);
+    mp_uasyncio_state_t *state = get_state();
+    self->next = state->flags;
+    state->flags = self;
+    return mp_const_none;
+}
+
+STATIC const mp_rom_map_elem_t flag_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_set), MP_ROM_PTR(&flag_set_obj) },
+    { MP_ROM_QSTR(MP_QSTR_clear), MP_ROM_PTR(&flag_clear_obj) },
+    { MP_ROM_QSTR(MP_QSTR_wait), MP_ROM_PTR(&event_wait_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(flag_locals_dict, flag_locals_dict_table);
+
+STATIC const mp_obj_type_t flag_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_ThreadSafeFlag,
+    .make_new = flag_make_new,
+    .getiter = mp_identity_getiter,
+    .iternext = flag_iternext,
+    .locals_dict = (mp_obj_dict_t*)&flag_locals_dict,
+};
+
+/******************************************************************************/
+// waiting for streams
+
+STATIC mp_obj_t io_wait_iternext(mp_obj_t self_in) {
+    mp_obj_io_wait_t *self = MP_OBJ_TO_PTR(self_in);
+    if (cur_task_woken(self_in) || stream_ready(self)) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    self->waiter = block_cur_task(self_in);
+    mp_uasyncio_state_t *state = get_state();
+    self->next = state->io_waits;
+    state->io_waits = self;
+    return mp_const_none;
+}
+
+STATIC const mp_obj_type_t io_wait_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_wait_io,
+    .getiter = mp_identity_getiter,
+    .iternext = io_wait_iternext,
+};
+
+STATIC mp_obj_t io_wait_new(mp_obj_t stream, mp_uint_t flags) {
+    mp_get_stream_raise(stream, MP_STREAM_OP_IOCTL);
+    mp_obj_io_wait_t *o = m_new_obj(mp_obj_io_wait_t);
+    o->base.type = &io_wait_type;
+    o->stream = stream;
+    o->flags = flags;
+    o->waiter = NULL;
+    o->next = NULL;
+    return MP_OBJ_FROM_PTR(o);
+}
+
+STATIC mp_obj_t uasyncio_wait_read(mp_obj_t stream) {
+    return io_wait_new(stream, MP_STREAM_POLL_RD);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(uasyncio_wait_read_obj, uasyncio_wait_read);
+
+STATIC mp_obj_t uasyncio_wait_write(mp_obj_t stream) {
+    return io_wait_new(stream, MP_STREAM_POLL_WR);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(uasyncio_wait_write_obj, uasyncio_wait_write);
+
+/******************************************************************************/
+// module
+
+STATIC const mp_rom_map_elem_t mp_module_uasyncio_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_uasyncio) },
+    { MP_ROM_QSTR(MP_QSTR_run), MP_ROM_PTR(&uasyncio_run_obj) },
+    { MP_ROM_QSTR(MP_QSTR_create_task), MP_ROM_PTR(&uasyncio_create_task_obj) },
+    { MP_ROM_QSTR(MP_QSTR_current_task), MP_ROM_PTR(&uasyncio_current_task_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sleep), MP_ROM_PTR(&uasyncio_sleep_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sleep_ms), MP_ROM_PTR(&uasyncio_sleep_ms_obj) },
+    { MP_ROM_QSTR(MP_QSTR_wait_read), MP_ROM_PTR(&uasyncio_wait_read_obj) },
+    { MP_ROM_QSTR(MP_QSTR_wait_write), MP_ROM_PTR(&uasyncio_wait_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_Task), MP_ROM_PTR(&task_type) },
+    { MP_ROM_QSTR(MP_QSTR_Event), MP_ROM_PTR(&event_type) },
+    { MP_ROM_QSTR(MP_QSTR_ThreadSafeFlag), MP_ROM_PTR(&flag_type) },
+    { MP_ROM_QSTR(MP_QSTR_CancelledError), MP_ROM_PTR(&mp_type_CancelledError) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(mp_module_uasyncio_globals, mp_module_uasyncio_globals_table);
+
+const mp_obj_module_t mp_module_uasyncio = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t*)&mp_module_uasyncio_globals,
+};
+
+#endif // MICROPY_PY_UASYNCIO
@@ -38,4 +38,22 @@ MP_DECLARE_CONST_FUN_OBJ_1(mod_binascii_a2b_base64_obj);
 MP_DECLARE_CONST_FUN_OBJ_1(mod_binascii_b2a_base64_obj);
 MP_DECLARE_CONST_FUN_OBJ_VAR_BETWEEN(mod_binascii_crc32_obj);
 
+#if MICROPY_PY_UBINASCII_INTO
+extern mp_obj_t mod_binascii_hexlify_into(size_t n_args, const mp_obj_t *args);
+extern mp_obj_t mod_binascii_unhexlify_into(mp_obj_t buf_in, mp_obj_t data_in);
+extern mp_obj_t mod_binascii_a2b_base64_into(mp_obj_t buf_in, mp_obj_t data_in);
+extern mp_obj_t mod_binascii_b2a_base64_into(mp_obj_t buf_in, mp_obj_t data_in);
+
+MP_DECLARE_CONST_FUN_OBJ_VAR_BETWEEN(mod_binascii_hexlify_into_obj);
+MP_DECLARE_CONST_FUN_OBJ_2(mod_binascii_unhexlify_into_obj);
+MP_DECLARE_CONST_FUN_OBJ_2(mod_binascii_a2b_base64_into_obj);
+MP_DECLARE_CONST_FUN_OBJ_2(mod_binascii_b2a_base64_into_obj);
+#endif
+
+#if MICROPY_PY_UBINASCII_CRC32_HW
+// Provided by the port. Updates the CRC-32 register crc, which starts as
+// 0xffffffff and is complemented to give the result, with len bytes of data.
+uint32_t mp_hal_crc32(uint32_t crc, const uint8_t *data, size_t len);
+#endif
+
 #endif // MICROPY_INCLUDED_EXTMOD_MODUBINASCII_H
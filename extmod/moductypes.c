@@ -113,36 +113,82 @@ STATIC const mp_obj_type_t uctypes_struct_type;
 
 typedef struct _mp_obj_uctypes_struct_t {
     mp_obj_base_t base;
+    // The descriptor, or a cache holding it.
     mp_obj_t desc;
     byte *addr;
     uint32_t flags;
 } mp_obj_uctypes_struct_t;
 
+// Takes the place of a struct object's descriptor the first time the struct
+// hands out a view of an aggregate field, or is indexed as an array or pointer.
+// Struct objects stay small because most are only used for a scalar or two.
+typedef struct _mp_obj_uctypes_cache_t {
+    mp_obj_base_t base;
+    mp_obj_t desc;
+    // Views of aggregate fields by name. Their addresses are fixed relative to
+    // the struct so the same ones can be handed out again.
+    mp_obj_t views;
+    // Size of an element of an array or the target of a pointer, which takes
+    // a walk of the descriptor to work out.
+    mp_uint_t item_size;
+} mp_obj_uctypes_cache_t;
+
+STATIC const mp_obj_type_t uctypes_cache_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_struct,
+};
+
 STATIC NORETURN void syntax_error(void) {
     mp_raise_TypeError(translate("syntax error in uctypes descriptor"));
 }
 
-STATIC mp_obj_t uctypes_struct_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
-    mp_arg_check_num(n_args, kw_args, 2, 3, false);
+STATIC mp_obj_uctypes_struct_t *uctypes_struct_new(const mp_obj_type_t *type, mp_obj_t desc, byte *addr, uint32_t flags) {
     mp_obj_uctypes_struct_t *o = m_new_obj(mp_obj_uctypes_struct_t);
     o->base.type = type;
-    o->addr = (void*)(uintptr_t)mp_obj_int_get_truncated(args[0]);
-    o->desc = args[1];
-    o->flags = LAYOUT_NATIVE;
+    o->desc = desc;
+    o->addr = addr;
+    o->flags = flags;
+    return o;
+}
+
+STATIC mp_obj_t uctypes_struct_desc(mp_obj_uctypes_struct_t *self) {
+    if (MP_OBJ_IS_TYPE(self->desc, &uctypes_cache_type)) {
+        return ((mp_obj_uctypes_cache_t*)MP_OBJ_TO_PTR(self->desc))->desc;
+    }
+    return self->desc;
+}
+
+STATIC mp_obj_uctypes_cache_t *uctypes_struct_cache(mp_obj_uctypes_struct_t *self) {
+    if (!MP_OBJ_IS_TYPE(self->desc, &uctypes_cache_type)) {
+        mp_obj_uctypes_cache_t *cache = m_new_obj(mp_obj_uctypes_cache_t);
+        cache->base.type = &uctypes_cache_type;
+        cache->desc = self->desc;
+        cache->views = MP_OBJ_NULL;
+        cache->item_size = 0;
+        self->desc = MP_OBJ_FROM_PTR(cache);
+    }
+    return MP_OBJ_TO_PTR(self->desc);
+}
+
+STATIC mp_obj_t uctypes_struct_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    mp_arg_check_num(n_args, kw_args, 2, 3, false);
+    uint32_t flags = LAYOUT_NATIVE;
     if (n_args == 3) {
-        o->flags = mp_obj_get_int(args[2]);
+        flags = mp_obj_get_int(args[2]);
     }
-    return MP_OBJ_FROM_PTR(o);
+    byte *addr = (void*)(uintptr_t)mp_obj_int_get_truncated(args[0]);
+    return MP_OBJ_FROM_PTR(uctypes_struct_new(type, args[1], addr, flags));
 }
 
 STATIC void uctypes_struct_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
     (void)kind;
     mp_obj_uctypes_struct_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_t desc = uctypes_struct_desc(self);
     const char *typen = "unk";
-    if (MP_OBJ_IS_TYPE(self->desc, &mp_type_dict)) {
+    if (MP_OBJ_IS_TYPE(desc, &mp_type_dict)) {
         typen = "STRUCT";
-    } else if (MP_OBJ_IS_TYPE(self->desc, &mp_type_tuple)) {
-        mp_obj_tuple_t *t = MP_OBJ_TO_PTR(self->desc);
+    } else if (MP_OBJ_IS_TYPE(desc, &mp_type_tuple)) {
+        mp_obj_tuple_t *t = MP_OBJ_TO_PTR(desc);
         mp_int_t offset = MP_OBJ_SMALL_INT_VALUE(t->items[0]);
         uint agg_type = GET_TYPE(offset, AGG_TYPE_BITS);
         switch (agg_type) {
@@ -274,7 +320,7 @@ STATIC mp_obj_t uctypes_struct_sizeof(mp_obj_t obj_in) {
     if (MP_OBJ_IS_TYPE(obj_in, &uctypes_struct_type)) {
         // Extract structure definition
         mp_obj_uctypes_struct_t *obj = MP_OBJ_TO_PTR(obj_in);
-        obj_in = obj->desc;
+        obj_in = uctypes_struct_desc(obj);
         layout_type = obj->flags;
     }
     mp_uint_t size = uctypes_struct_size(obj_in, layout_type, &max_field_size);
@@ -392,12 +438,24 @@ STATIC void set_aligned(uint val_type, void *p, mp_int_t index, mp_obj_t val) {
 STATIC mp_obj_t uctypes_struct_attr_op(mp_obj_t self_in, qstr attr, mp_obj_t set_val) {
     mp_obj_uctypes_struct_t *self = MP_OBJ_TO_PTR(self_in);
 
+    mp_obj_t desc = self->desc;
+    if (MP_OBJ_IS_TYPE(desc, &uctypes_cache_type)) {
+        mp_obj_uctypes_cache_t *cache = MP_OBJ_TO_PTR(desc);
+        if (set_val == MP_OBJ_NULL && cache->views != MP_OBJ_NULL) {
+            mp_map_elem_t *elem = mp_map_lookup(mp_obj_dict_get_map(cache->views), MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
+            if (elem != NULL) {
+                return elem->value;
+            }
+        }
+        desc = cache->desc;
+    }
+
     // TODO: Support at least OrderedDict in addition
-    if (!MP_OBJ_IS_TYPE(self->desc, &mp_type_dict)) {
+    if (!MP_OBJ_IS_TYPE(desc, &mp_type_dict)) {
             mp_raise_TypeError(translate("struct: no fields"));
     }
 
-    mp_obj_t deref = mp_obj_dict_get(self->desc, MP_OBJ_NEW_QSTR(attr));
+    mp_obj_t deref = mp_obj_dict_get(desc, MP_OBJ_NEW_QSTR(attr));
     if (MP_OBJ_IS_SMALL_INT(deref)) {
         mp_int_t offset = MP_OBJ_SMALL_INT_VALUE(deref);
         mp_uint_t val_type = GET_TYPE(offset, VAL_TYPE_BITS);
@@ -474,35 +532,34 @@ STATIC mp_obj_t uctypes_struct_attr_op(mp_obj_t self_in, qstr attr, mp_obj_t set
     offset &= VALUE_MASK(AGG_TYPE_BITS);
 //printf("agg type=%d offset=%x\n", agg_type, offset);
 
+    mp_obj_t view;
     switch (agg_type) {
-        case STRUCT: {
-            mp_obj_uctypes_struct_t *o = m_new_obj(mp_obj_uctypes_struct_t);
-            o->base.type = &uctypes_struct_type;
-            o->desc = sub->items[1];
-            o->addr = self->addr + offset;
-            o->flags = self->flags;
-            return MP_OBJ_FROM_PTR(o);
-        }
+        case STRUCT:
+            view = MP_OBJ_FROM_PTR(uctypes_struct_new(&uctypes_struct_type, sub->items[1], self->addr + offset, self->flags));
+            break;
         case ARRAY: {
             mp_uint_t dummy;
             if (IS_SCALAR_ARRAY(sub) && IS_SCALAR_ARRAY_OF_BYTES(sub)) {
-                return mp_obj_new_bytearray_by_ref(uctypes_struct_agg_size(sub, self->flags, &dummy), self->addr + offset);
+                view = mp_obj_new_bytearray_by_ref(uctypes_struct_agg_size(sub, self->flags, &dummy), self->addr + offset);
+                break;
             }
             // Fall thru to return uctypes struct object
         }
-        case PTR: {
-            mp_obj_uctypes_struct_t *o = m_new_obj(mp_obj_uctypes_struct_t);
-            o->base.type = &uctypes_struct_type;
-            o->desc = MP_OBJ_FROM_PTR(sub);
-            o->addr = self->addr + offset;
-            o->flags = self->flags;
-//printf("PTR/ARR base addr=%p\n", o->addr);
-            return MP_OBJ_FROM_PTR(o);
-        }
+        case PTR:
+//printf("PTR/ARR base addr=%p\n", self->addr + offset);
+            view = MP_OBJ_FROM_PTR(uctypes_struct_new(&uctypes_struct_type, MP_OBJ_FROM_PTR(sub), self->addr + offset, self->flags));
+            break;
+        default:
+            // BITFIELD only makes sense in a scalar field, not in an aggregate's tuple.
+            syntax_error();
     }
 
-    // Should be unreachable once all cases are handled
-    return MP_OBJ_NULL;
+    mp_obj_uctypes_cache_t *cache = uctypes_struct_cache(self);
+    if (cache->views == MP_OBJ_NULL) {
+        cache->views = mp_obj_new_dict(1);
+    }
+    mp_obj_dict_store(cache->views, MP_OBJ_NEW_QSTR(attr), view);
+    return view;
 }
 
 STATIC void uctypes_struct_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
@@ -526,11 +583,12 @@ STATIC mp_obj_t uctypes_struct_subscr(mp_obj_t base_in, mp_obj_t index_in, mp_ob
         return MP_OBJ_NULL; // op not supported
     } else {
         // load / store
-        if (!MP_OBJ_IS_TYPE(self->desc, &mp_type_tuple)) {
+        mp_obj_t desc = uctypes_struct_desc(self);
+        if (!MP_OBJ_IS_TYPE(desc, &mp_type_tuple)) {
             mp_raise_TypeError(translate("struct: cannot index"));
         }
 
-        mp_obj_tuple_t *t = MP_OBJ_TO_PTR(self->desc);
+        mp_obj_tuple_t *t = MP_OBJ_TO_PTR(desc);
         mp_int_t offset = MP_OBJ_SMALL_INT_VALUE(t->items[0]);
         uint agg_type = GET_TYPE(offset, AGG_TYPE_BITS);
 
@@ -563,14 +621,12 @@ STATIC mp_obj_t uctypes_struct_subscr(mp_obj_t base_in, mp_obj_t index_in, mp_ob
                     }
                 }
             } else if (value == MP_OBJ_SENTINEL) {
-                mp_uint_t dummy = 0;
-                mp_uint_t size = uctypes_struct_size(t->items[2], self->flags, &dummy);
-                mp_obj_uctypes_struct_t *o = m_new_obj(mp_obj_uctypes_struct_t);
-                o->base.type = &uctypes_struct_type;
-                o->desc = t->items[2];
-                o->addr = self->addr + size * index;
-                o->flags = self->flags;
-                return MP_OBJ_FROM_PTR(o);
+                mp_obj_uctypes_cache_t *cache = uctypes_struct_cache(self);
+                if (cache->item_size == 0) {
+                    mp_uint_t dummy = 0;
+                    cache->item_size = uctypes_struct_size(t->items[2], self->flags, &dummy);
+                }
+                return MP_OBJ_FROM_PTR(uctypes_struct_new(&uctypes_struct_type, t->items[2], self->addr + cache->item_size * index, self->flags));
             } else {
                 return MP_OBJ_NULL; // op not supported
             }
@@ -581,14 +637,12 @@ STATIC mp_obj_t uctypes_struct_subscr(mp_obj_t base_in, mp_obj_t index_in, mp_ob
                 uint val_type = GET_TYPE(MP_OBJ_SMALL_INT_VALUE(t->items[1]), VAL_TYPE_BITS);
                 return get_aligned(val_type, p, index);
             } else {
-                mp_uint_t dummy = 0;
-                mp_uint_t size = uctypes_struct_size(t->items[1], self->flags, &dummy);
-                mp_obj_uctypes_struct_t *o = m_new_obj(mp_obj_uctypes_struct_t);
-                o->base.type = &uctypes_struct_type;
-                o->desc = t->items[1];
-                o->addr = p + size * index;
-                o->flags = self->flags;
-                return MP_OBJ_FROM_PTR(o);
+                mp_obj_uctypes_cache_t *cache = uctypes_struct_cache(self);
+                if (cache->item_size == 0) {
+                    mp_uint_t dummy = 0;
+                    cache->item_size = uctypes_struct_size(t->items[1], self->flags, &dummy);
+                }
+                return MP_OBJ_FROM_PTR(uctypes_struct_new(&uctypes_struct_type, t->items[1], p + cache->item_size * index, self->flags));
             }
         }
 
@@ -601,7 +655,7 @@ STATIC mp_int_t uctypes_get_buffer(mp_obj_t self_in, mp_buffer_info_t *bufinfo,
     (void)flags;
     mp_obj_uctypes_struct_t *self = MP_OBJ_TO_PTR(self_in);
     mp_uint_t max_field_size = 0;
-    mp_uint_t size = uctypes_struct_size(self->desc, self->flags, &max_field_size);
+    mp_uint_t size = uctypes_struct_size(uctypes_struct_desc(self), self->flags, &max_field_size);
 
     bufinfo->buf = self->addr;
     bufinfo->len = size;
@@ -28,6 +28,7 @@
 #include <string.h>
 
 #include "py/runtime.h"
+#include "extmod/moduhashlib.h"
 
 #include "supervisor/shared/translate.h"
 
@@ -35,7 +36,8 @@
 
 #if MICROPY_PY_UHASHLIB_SHA256
 
-#if MICROPY_SSL_MBEDTLS
+#if MICROPY_PY_UHASHLIB_HW
+#elif MICROPY_SSL_MBEDTLS
 #include "mbedtls/sha256.h"
 #else
 #include "crypto-algorithms/sha256.h"
@@ -43,7 +45,7 @@
 
 #endif
 
-#if MICROPY_PY_UHASHLIB_SHA1
+#if MICROPY_PY_UHASHLIB_SHA1 && !MICROPY_PY_UHASHLIB_HW
 
 #if MICROPY_SSL_AXTLS
 #include "lib/axtls/crypto/crypto.h"
@@ -61,10 +63,121 @@ typedef struct _mp_obj_hash_t {
     char state[0];
 } mp_obj_hash_t;
 
+#if MICROPY_PY_UHASHLIB_HW || !MICROPY_SSL_MBEDTLS
+static void check_not_unicode(const mp_obj_t arg) {
+#if MICROPY_CPYTHON_COMPAT
+    if (MP_OBJ_IS_STR(arg)) {
+        mp_raise_TypeError(translate("a bytes-like object is required"));
+    }
+#endif
+}
+#endif
+
+#if MICROPY_PY_UHASHLIB_HW
+
+// The port hashes whole blocks, straight from the caller's buffer where it
+// can, and the padding and buffering of partial blocks is done here.
+typedef struct _hash_hw_ctx_t {
+    uint32_t block[16];
+    uint8_t state[32];
+    uint64_t total; // bytes so far
+    uint8_t algo;
+} hash_hw_ctx_t;
+
+STATIC const uint32_t hash_hw_init[2][8] = {
+    { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 },
+    { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 },
+};
+
+STATIC mp_obj_t hash_hw_update(mp_obj_t self_in, mp_obj_t arg) {
+    check_not_unicode(arg);
+    mp_obj_hash_t *self = MP_OBJ_TO_PTR(self_in);
+    hash_hw_ctx_t *ctx = (hash_hw_ctx_t*)self->state;
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(arg, &bufinfo, MP_BUFFER_READ);
+    const uint8_t *data = bufinfo.buf;
+    size_t len = bufinfo.len;
+    size_t used = ctx->total % 64;
+    ctx->total += len;
+    if (used > 0) {
+        size_t n = MIN(64 - used, len);
+        memcpy((uint8_t*)ctx->block + used, data, n);
+        data += n;
+        len -= n;
+        if (used + n < 64) {
+            return mp_const_none;
+        }
+        mp_hal_sha_blocks(ctx->algo, ctx->state, (uint8_t*)ctx->block, 1);
+    }
+    if (len >= 64) {
+        mp_hal_sha_blocks(ctx->algo, ctx->state, data, len / 64);
+    }
+    memcpy(ctx->block, data + len / 64 * 64, len % 64);
+    return mp_const_none;
+}
+
+STATIC mp_obj_t hash_hw_make_new(const mp_obj_type_t *type, int algo, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    mp_arg_check_num(n_args, kw_args, 0, 1, false);
+    mp_obj_hash_t *o = m_new_obj_var(mp_obj_hash_t, char, sizeof(hash_hw_ctx_t));
+    o->base.type = type;
+    hash_hw_ctx_t *ctx = (hash_hw_ctx_t*)o->state;
+    ctx->algo = algo;
+    ctx->total = 0;
+    for (size_t i = 0; i < 8; i++) {
+        uint32_t h = hash_hw_init[algo][i];
+        ctx->state[i * 4] = h >> 24;
+        ctx->state[i * 4 + 1] = h >> 16;
+        ctx->state[i * 4 + 2] = h >> 8;
+        ctx->state[i * 4 + 3] = h;
+    }
+    if (n_args == 1) {
+        hash_hw_update(MP_OBJ_FROM_PTR(o), args[0]);
+    }
+    return MP_OBJ_FROM_PTR(o);
+}
+
+// Pads a copy of the context, so digest() can be called again or followed by
+// more updates, like CPython.
+STATIC mp_obj_t hash_hw_digest(mp_obj_t self_in) {
+    mp_obj_hash_t *self = MP_OBJ_TO_PTR(self_in);
+    hash_hw_ctx_t ctx = *(hash_hw_ctx_t*)self->state;
+    uint8_t *block = (uint8_t*)ctx.block;
+    size_t used = ctx.total % 64;
+    block[used++] = 0x80;
+    if (used > 56) {
+        memset(block + used, 0, 64 - used);
+        mp_hal_sha_blocks(ctx.algo, ctx.state, block, 1);
+        used = 0;
+    }
+    memset(block + used, 0, 56 - used);
+    uint64_t bits = ctx.total * 8;
+    for (size_t i = 0; i < 8; i++) {
+        block[63 - i] = bits >> (i * 8);
+    }
+    mp_hal_sha_blocks(ctx.algo, ctx.state, block, 1);
+    return mp_obj_new_bytes(ctx.state, ctx.algo == MP_HASH_SHA1 ? 20 : 32);
+}
+
+#endif
+
 #if MICROPY_PY_UHASHLIB_SHA256
 STATIC mp_obj_t uhashlib_sha256_update(mp_obj_t self_in, mp_obj_t arg);
 
-#if MICROPY_SSL_MBEDTLS
+#if MICROPY_PY_UHASHLIB_HW
+
+STATIC mp_obj_t uhashlib_sha256_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    return hash_hw_make_new(type, MP_HASH_SHA256, n_args, args, kw_args);
+}
+
+STATIC mp_obj_t uhashlib_sha256_update(mp_obj_t self_in, mp_obj_t arg) {
+    return hash_hw_update(self_in, arg);
+}
+
+STATIC mp_obj_t uhashlib_sha256_digest(mp_obj_t self_in) {
+    return hash_hw_digest(self_in);
+}
+
+#elif MICROPY_SSL_MBEDTLS
 
 STATIC mp_obj_t uhashlib_sha256_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     mp_arg_check_num(n_args, kw_args, 0, 1, false);
@@ -96,14 +209,6 @@ STATIC mp_obj_t uhashlib_sha256_digest(mp_obj_t self_in) {
 
 #else
 
-static void check_not_unicode(const mp_obj_t arg) {
-#if MICROPY_CPYTHON_COMPAT
-    if (MP_OBJ_IS_STR(arg)) {
-        mp_raise_TypeError(translate("a bytes-like object is required"));
-    }
-#endif
-}
-
 STATIC mp_obj_t uhashlib_sha256_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     mp_arg_check_num(n_args, kw_args, 0, 1, false);
     mp_obj_hash_t *o = m_new_obj_var(mp_obj_hash_t, char, sizeof(CRYAL_SHA256_CTX));
@@ -154,7 +259,21 @@ STATIC const mp_obj_type_t uhashlib_sha256_type = {
 #if MICROPY_PY_UHASHLIB_SHA1
 STATIC mp_obj_t uhashlib_sha1_update(mp_obj_t self_in, mp_obj_t arg);
 
-#if MICROPY_SSL_AXTLS
+#if MICROPY_PY_UHASHLIB_HW
+
+STATIC mp_obj_t uhashlib_sha1_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    return hash_hw_make_new(type, MP_HASH_SHA1, n_args, args, kw_args);
+}
+
+STATIC mp_obj_t uhashlib_sha1_update(mp_obj_t self_in, mp_obj_t arg) {
+    return hash_hw_update(self_in, arg);
+}
+
+STATIC mp_obj_t uhashlib_sha1_digest(mp_obj_t self_in) {
+    return hash_hw_digest(self_in);
+}
+
+#elif MICROPY_SSL_AXTLS
 STATIC mp_obj_t uhashlib_sha1_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     mp_arg_check_num(n_args, kw_args, 0, 1, false);
     mp_obj_hash_t *o = m_new_obj_var(mp_obj_hash_t, char, sizeof(SHA1_CTX));
@@ -184,7 +303,7 @@ STATIC mp_obj_t uhashlib_sha1_digest(mp_obj_t self_in) {
 }
 #endif
 
-#if MICROPY_SSL_MBEDTLS
+#if MICROPY_SSL_MBEDTLS && !MICROPY_PY_UHASHLIB_HW
 STATIC mp_obj_t uhashlib_sha1_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
     mp_arg_check_num(n_args, n_kw, 0, 1, false);
     mp_obj_hash_t *o = m_new_obj_var(mp_obj_hash_t, char, sizeof(mbedtls_sha1_context));
@@ -249,7 +368,7 @@ const mp_obj_module_t mp_module_uhashlib = {
     .globals = (mp_obj_dict_t*)&mp_module_uhashlib_globals,
 };
 
-#if MICROPY_PY_UHASHLIB_SHA256
+#if MICROPY_PY_UHASHLIB_SHA256 && !MICROPY_PY_UHASHLIB_HW
 #include "crypto-algorithms/sha256.c"
 #endif
 
@@ -0,0 +1,42 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Paul Sokolovsky
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MICROPY_INCLUDED_EXTMOD_MODUHASHLIB_H
+#define MICROPY_INCLUDED_EXTMOD_MODUHASHLIB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MP_HASH_SHA1 (0)
+#define MP_HASH_SHA256 (1)
+
+#if MICROPY_PY_UHASHLIB_HW
+// Provided by the port. Hashes n 64 byte blocks of data into state, which
+// holds the digest so far as it is output: the big endian words of the hash
+// state, 20 bytes for SHA1 and 32 for SHA256.
+void mp_hal_sha_blocks(int algo, uint8_t *state, const uint8_t *data, size_t n);
+#endif
+
+#endif // MICROPY_INCLUDED_EXTMOD_MODUHASHLIB_H
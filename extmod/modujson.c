@@ -25,9 +25,9 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "py/objlist.h"
-#include "py/objstringio.h"
 #include "py/parsenum.h"
 #include "py/runtime.h"
 #include "py/stream.h"
@@ -36,10 +36,46 @@
 
 #if MICROPY_PY_UJSON
 
+// Size of the buffers used to read from and write to streams
+#define UJSON_BUF_SIZE (256)
+
+// dump writes through a buffer, so the stream sees a few large writes
+// instead of one for each token
+
+typedef struct _ujson_dump_buf_t {
+    mp_obj_t stream_obj;
+    size_t len;
+    byte buf[UJSON_BUF_SIZE];
+} ujson_dump_buf_t;
+
+STATIC void ujson_dump_flush(ujson_dump_buf_t *d) {
+    if (d->len != 0) {
+        mp_stream_write(d->stream_obj, d->buf, d->len, MP_STREAM_RW_WRITE);
+        d->len = 0;
+    }
+}
+
+STATIC void ujson_dump_strn(void *data, const char *str, size_t len) {
+    ujson_dump_buf_t *d = data;
+    if (d->len + len > UJSON_BUF_SIZE) {
+        ujson_dump_flush(d);
+        if (len > UJSON_BUF_SIZE) {
+            mp_stream_write(d->stream_obj, str, len, MP_STREAM_RW_WRITE);
+            return;
+        }
+    }
+    memcpy(d->buf + d->len, str, len);
+    d->len += len;
+}
+
 STATIC mp_obj_t mod_ujson_dump(mp_obj_t obj, mp_obj_t stream) {
     mp_get_stream_raise(stream, MP_STREAM_OP_WRITE);
-    mp_print_t print = {MP_OBJ_TO_PTR(stream), mp_stream_write_adaptor};
+    ujson_dump_buf_t d;
+    d.stream_obj = stream;
+    d.len = 0;
+    mp_print_t print = {&d, ujson_dump_strn};
     mp_obj_print_helper(&print, obj, PRINT_JSON);
+    ujson_dump_flush(&d);
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_ujson_dump_obj, mod_ujson_dump);
@@ -53,7 +89,7 @@ STATIC mp_obj_t mod_ujson_dumps(mp_obj_t obj) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_ujson_dumps_obj, mod_ujson_dumps);
 
-// The function below implements a simple non-recursive JSON parser.
+// The functions below implement a simple non-recursive JSON parser.
 //
 // The JSON specification is at http://www.ietf.org/rfc/rfc4627.txt
 // The parser here will parse any valid JSON and return the correct
@@ -63,51 +99,75 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_ujson_dumps_obj, mod_ujson_dumps);
 // input is outside it's specs.
 //
 // Most of the work is parsing the primitives (null, false, true, numbers,
-// strings).  It does 1 pass over the input stream.  It tries to be fast and
-// small in code size, while not using more RAM than necessary.
+// strings).  It does 1 pass over the input stream, reading it a buffer at a
+// time.  It tries to be fast and small in code size, while not using more RAM
+// than necessary.
+//
+// ujson_next_token splits the input into primitives and brackets, and
+// ujson_build puts those together into a list or dict.  load() builds the
+// whole input, while iterparse() returns the outer levels as events and only
+// builds what is nested deeper.
 
 typedef struct _ujson_stream_t {
-    mp_obj_t stream_obj;
-    mp_uint_t (*read)(mp_obj_t obj, void *buf, mp_uint_t size, int *errcode);
-    int errcode;
+    mp_obj_t stream_obj; // MP_OBJ_NULL if the whole input is in memory
+    const byte *pos; // next byte to read
+    const byte *end;
+    byte *buf; // UJSON_BUF_SIZE bytes to read the stream into
     byte cur;
 } ujson_stream_t;
 
 #define S_EOF (0) // null is not allowed in json stream so is ok as EOF marker
-#define S_END(s) ((s).cur == S_EOF)
-#define S_CUR(s) ((s).cur)
-#define S_NEXT(s) (ujson_stream_next(&(s)))
-
-STATIC byte ujson_stream_next(ujson_stream_t *s) {
-    mp_uint_t ret = s->read(s->stream_obj, &s->cur, 1, &s->errcode);
-    if (s->errcode != 0) {
-        mp_raise_OSError(s->errcode);
-    }
-    if (ret == 0) {
-        s->cur = S_EOF;
+#define S_END(s) ((s)->cur == S_EOF)
+#define S_CUR(s) ((s)->cur)
+#define S_NEXT(s) ((s)->pos < (s)->end ? ((s)->cur = *(s)->pos++) : ujson_stream_fill(s))
+
+// Refill the buffer and return the next byte
+STATIC byte ujson_stream_fill(ujson_stream_t *s) {
+    s->cur = S_EOF;
+    if (s->stream_obj != MP_OBJ_NULL) {
+        int errcode;
+        mp_uint_t ret = mp_stream_rw(s->stream_obj, s->buf, UJSON_BUF_SIZE, &errcode,
+            MP_STREAM_RW_READ | MP_STREAM_RW_ONCE);
+        if (errcode != 0) {
+            mp_raise_OSError(errcode);
+        }
+        if (ret != 0) {
+            s->pos = s->buf + 1;
+            s->end = s->buf + ret;
+            s->cur = s->buf[0];
+        }
     }
     return s->cur;
 }
 
-STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
-    const mp_stream_p_t *stream_p = mp_get_stream_raise(stream_obj, MP_STREAM_OP_READ);
-    ujson_stream_t s = {stream_obj, stream_p->read, 0, 0};
-    vstr_t vstr;
-    vstr_init(&vstr, 8);
-    mp_obj_list_t stack; // we use a list as a simple stack for nested JSON
-    stack.len = 0;
-    stack.items = NULL;
-    mp_obj_t stack_top = MP_OBJ_NULL;
-    mp_obj_type_t *stack_top_type = NULL;
-    mp_obj_t stack_key = MP_OBJ_NULL;
+STATIC void ujson_stream_init(ujson_stream_t *s, mp_obj_t stream_obj, byte *buf) {
+    mp_get_stream_raise(stream_obj, MP_STREAM_OP_READ);
+    s->stream_obj = stream_obj;
+    s->pos = s->end = buf;
+    s->buf = buf;
     S_NEXT(s);
+}
+
+STATIC NORETURN void ujson_fail(void) {
+    mp_raise_ValueError(translate("syntax error in JSON"));
+}
+
+// Tokens returned by ujson_next_token
+enum {
+    UJSON_EOF,
+    UJSON_VALUE, // a primitive
+    UJSON_START_LIST,
+    UJSON_START_DICT,
+    UJSON_END, // ] or }
+};
+
+// Read the next token, storing a primitive in *value.  vstr is scratch space
+// for strings and numbers.
+STATIC int ujson_next_token(ujson_stream_t *s, vstr_t *vstr, mp_obj_t *value) {
     for (;;) {
-        cont:
         if (S_END(s)) {
-            break;
+            return UJSON_EOF;
         }
-        mp_obj_t next = MP_OBJ_NULL;
-        bool enter = false;
         byte cur = S_CUR(s);
         S_NEXT(s);
         switch (cur) {
@@ -117,33 +177,30 @@ STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
             case '\t':
             case '\n':
             case '\r':
-                goto cont;
+                continue;
             case 'n':
                 if (S_CUR(s) == 'u' && S_NEXT(s) == 'l' && S_NEXT(s) == 'l') {
                     S_NEXT(s);
-                    next = mp_const_none;
-                } else {
-                    goto fail;
+                    *value = mp_const_none;
+                    return UJSON_VALUE;
                 }
-                break;
+                ujson_fail();
             case 'f':
                 if (S_CUR(s) == 'a' && S_NEXT(s) == 'l' && S_NEXT(s) == 's' && S_NEXT(s) == 'e') {
                     S_NEXT(s);
-                    next = mp_const_false;
-                } else {
-                    goto fail;
+                    *value = mp_const_false;
+                    return UJSON_VALUE;
                 }
-                break;
+                ujson_fail();
             case 't':
                 if (S_CUR(s) == 'r' && S_NEXT(s) == 'u' && S_NEXT(s) == 'e') {
                     S_NEXT(s);
-                    next = mp_const_true;
-                } else {
-                    goto fail;
+                    *value = mp_const_true;
+                    return UJSON_VALUE;
                 }
-                break;
+                ujson_fail();
             case '"':
-                vstr_reset(&vstr);
+                vstr_reset(vstr);
                 for (; !S_END(s) && S_CUR(s) != '"';) {
                     byte c = S_CUR(s);
                     if (c == '\\') {
@@ -163,27 +220,27 @@ STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
                                     }
                                     num = (num << 4) | c;
                                 }
-                                vstr_add_char(&vstr, num);
+                                vstr_add_char(vstr, num);
                                 goto str_cont;
                             }
                         }
                     }
-                    vstr_add_byte(&vstr, c);
+                    vstr_add_byte(vstr, c);
                 str_cont:
                     S_NEXT(s);
                 }
                 if (S_END(s)) {
-                    goto fail;
+                    ujson_fail();
                 }
                 S_NEXT(s);
-                next = mp_obj_new_str(vstr.buf, vstr.len);
-                break;
+                *value = mp_obj_new_str(vstr->buf, vstr->len);
+                return UJSON_VALUE;
             case '-':
             case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9': {
                 bool flt = false;
-                vstr_reset(&vstr);
+                vstr_reset(vstr);
                 for (;;) {
-                    vstr_add_byte(&vstr, cur);
+                    vstr_add_byte(vstr, cur);
                     cur = S_CUR(s);
                     if (cur == '.' || cur == 'E' || cur == 'e') {
                         flt = true;
@@ -195,102 +252,216 @@ STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
                     S_NEXT(s);
                 }
                 if (flt) {
-                    next = mp_parse_num_decimal(vstr.buf, vstr.len, false, false, NULL);
+                    *value = mp_parse_num_decimal(vstr->buf, vstr->len, false, false, NULL);
                 } else {
-                    next = mp_parse_num_integer(vstr.buf, vstr.len, 10, NULL);
+                    *value = mp_parse_num_integer(vstr->buf, vstr->len, 10, NULL);
                 }
-                break;
+                return UJSON_VALUE;
             }
             case '[':
+                return UJSON_START_LIST;
+            case '{':
+                return UJSON_START_DICT;
+            case '}':
+            case ']':
+                return UJSON_END;
+            default:
+                ujson_fail();
+        }
+    }
+}
+
+// Return the value that starts with the given token, reading the rest of it if
+// it's a list or dict.
+STATIC mp_obj_t ujson_build(ujson_stream_t *s, vstr_t *vstr, int tok, mp_obj_t value) {
+    if (tok == UJSON_VALUE) {
+        return value;
+    }
+    if (tok != UJSON_START_LIST && tok != UJSON_START_DICT) {
+        ujson_fail();
+    }
+    mp_obj_list_t stack; // we use a list as a simple stack for nested JSON
+    stack.len = 0;
+    stack.items = NULL;
+    mp_obj_t stack_top = tok == UJSON_START_LIST ? mp_obj_new_list(0, NULL) : mp_obj_new_dict(0);
+    mp_obj_type_t *stack_top_type = mp_obj_get_type(stack_top);
+    mp_obj_t stack_key = MP_OBJ_NULL;
+    for (;;) {
+        mp_obj_t next = MP_OBJ_NULL;
+        bool enter = false;
+        switch (ujson_next_token(s, vstr, &next)) {
+            case UJSON_VALUE:
+                break;
+            case UJSON_START_LIST:
                 next = mp_obj_new_list(0, NULL);
                 enter = true;
                 break;
-            case '{':
+            case UJSON_START_DICT:
                 next = mp_obj_new_dict(0);
                 enter = true;
                 break;
-            case '}':
-            case ']': {
-                if (stack_top == MP_OBJ_NULL) {
-                    // no object at all
-                    goto fail;
-                }
+            case UJSON_END:
                 if (stack.len == 0) {
                     // finished; compound object
-                    goto success;
+                    if (stack.items != NULL) {
+                        m_del(mp_obj_t, stack.items, stack.alloc);
+                    }
+                    return stack_top;
                 }
                 stack.len -= 1;
                 stack_top = stack.items[stack.len];
                 stack_top_type = mp_obj_get_type(stack_top);
-                goto cont;
-            }
+                continue;
             default:
-                goto fail;
+                ujson_fail();
         }
-        if (stack_top == MP_OBJ_NULL) {
-            stack_top = next;
-            stack_top_type = mp_obj_get_type(stack_top);
-            if (!enter) {
-                // finished; single primitive only
-                goto success;
-            }
+        // append to list or dict
+        if (stack_top_type == &mp_type_list) {
+            mp_obj_list_append(stack_top, next);
         } else {
-            // append to list or dict
-            if (stack_top_type == &mp_type_list) {
-                mp_obj_list_append(stack_top, next);
-            } else {
-                if (stack_key == MP_OBJ_NULL) {
-                    stack_key = next;
-                    if (enter) {
-                        goto fail;
-                    }
-                } else {
-                    mp_obj_dict_store(stack_top, stack_key, next);
-                    stack_key = MP_OBJ_NULL;
+            if (stack_key == MP_OBJ_NULL) {
+                stack_key = next;
+                if (enter) {
+                    ujson_fail();
                 }
+            } else {
+                mp_obj_dict_store(stack_top, stack_key, next);
+                stack_key = MP_OBJ_NULL;
             }
-            if (enter) {
-                if (stack.items == NULL) {
-                    mp_obj_list_init(&stack, 1);
-                    stack.items[0] = stack_top;
-                } else {
-                    mp_obj_list_append(MP_OBJ_FROM_PTR(&stack), stack_top);
-                }
-                stack_top = next;
-                stack_top_type = mp_obj_get_type(stack_top);
+        }
+        if (enter) {
+            if (stack.items == NULL) {
+                mp_obj_list_init(&stack, 1);
+                stack.items[0] = stack_top;
+            } else {
+                mp_obj_list_append(MP_OBJ_FROM_PTR(&stack), stack_top);
             }
+            stack_top = next;
+            stack_top_type = mp_obj_get_type(stack_top);
         }
     }
-    success:
+}
+
+STATIC mp_obj_t ujson_load(ujson_stream_t *s) {
+    vstr_t vstr;
+    vstr_init(&vstr, 8);
+    mp_obj_t value = MP_OBJ_NULL;
+    int tok = ujson_next_token(s, &vstr, &value);
+    value = ujson_build(s, &vstr, tok, value);
     // eat trailing whitespace
     while (unichar_isspace(S_CUR(s))) {
         S_NEXT(s);
     }
     if (!S_END(s)) {
         // unexpected chars
-        goto fail;
-    }
-    if (stack_top == MP_OBJ_NULL || stack.len != 0) {
-        // not exactly 1 object
-        goto fail;
+        ujson_fail();
     }
     vstr_clear(&vstr);
-    return stack_top;
+    return value;
+}
 
-    fail:
-    mp_raise_ValueError(translate("syntax error in JSON"));
+STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
+    byte buf[UJSON_BUF_SIZE];
+    ujson_stream_t s;
+    ujson_stream_init(&s, stream_obj, buf);
+    return ujson_load(&s);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_ujson_load_obj, mod_ujson_load);
 
 STATIC mp_obj_t mod_ujson_loads(mp_obj_t obj) {
     size_t len;
     const char *buf = mp_obj_str_get_data(obj, &len);
-    vstr_t vstr = {len, len, (char*)buf, true};
-    mp_obj_stringio_t sio = {{&mp_type_stringio}, &vstr, 0, MP_OBJ_NULL};
-    return mod_ujson_load(MP_OBJ_FROM_PTR(&sio));
+    ujson_stream_t s = {MP_OBJ_NULL, (const byte*)buf, (const byte*)buf + len, NULL, 0};
+    S_NEXT(&s);
+    return ujson_load(&s);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_ujson_loads_obj, mod_ujson_loads);
 
+// iterparse(stream, depth=1) returns (event, value) pairs one at a time.  Lists
+// and dicts less than depth levels deep give a "start_array" or "start_map"
+// event, then events for their contents, then "end_array" or "end_map".  A
+// dict's keys give "map_key" events.  Anything else, including the lists and
+// dicts nested depth levels deep, is built in full and gives a "value" event.
+// Several JSON documents one after another give events for each in turn.
+
+// What each level being streamed expects next
+enum {
+    LEVEL_LIST,
+    LEVEL_DICT_KEY,
+    LEVEL_DICT_VALUE,
+};
+
+typedef struct _ujson_iterparse_t {
+    mp_obj_base_t base;
+    ujson_stream_t s;
+    vstr_t vstr;
+    vstr_t levels; // one LEVEL_xxx byte for each open list or dict
+    size_t depth;
+    byte buf[UJSON_BUF_SIZE];
+} ujson_iterparse_t;
+
+STATIC mp_obj_t ujson_event(qstr event, mp_obj_t value) {
+    mp_obj_t items[2] = {MP_OBJ_NEW_QSTR(event), value};
+    return mp_obj_new_tuple(2, items);
+}
+
+STATIC mp_obj_t ujson_iterparse_iternext(mp_obj_t self_in) {
+    ujson_iterparse_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_t value = MP_OBJ_NULL;
+    int tok = ujson_next_token(&self->s, &self->vstr, &value);
+    byte *level = self->levels.len == 0 ? NULL : (byte*)&self->levels.buf[self->levels.len - 1];
+    if (tok == UJSON_EOF) {
+        if (level != NULL) {
+            ujson_fail();
+        }
+        return MP_OBJ_STOP_ITERATION;
+    }
+    if (tok == UJSON_END) {
+        if (level == NULL) {
+            ujson_fail();
+        }
+        self->levels.len -= 1;
+        return ujson_event(*level == LEVEL_LIST ? MP_QSTR_end_array : MP_QSTR_end_map, mp_const_none);
+    }
+    if (level != NULL && *level != LEVEL_LIST) {
+        if (*level == LEVEL_DICT_KEY) {
+            if (tok != UJSON_VALUE) {
+                ujson_fail();
+            }
+            *level = LEVEL_DICT_VALUE;
+            return ujson_event(MP_QSTR_map_key, value);
+        }
+        *level = LEVEL_DICT_KEY;
+    }
+    if (tok != UJSON_VALUE && self->levels.len < self->depth) {
+        if (tok == UJSON_START_LIST) {
+            vstr_add_byte(&self->levels, LEVEL_LIST);
+            return ujson_event(MP_QSTR_start_array, mp_const_none);
+        }
+        vstr_add_byte(&self->levels, LEVEL_DICT_KEY);
+        return ujson_event(MP_QSTR_start_map, mp_const_none);
+    }
+    return ujson_event(MP_QSTR_value, ujson_build(&self->s, &self->vstr, tok, value));
+}
+
+STATIC const mp_obj_type_t ujson_iterparse_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_iterator,
+    .getiter = mp_identity_getiter,
+    .iternext = ujson_iterparse_iternext,
+};
+
+STATIC mp_obj_t mod_ujson_iterparse(size_t n_args, const mp_obj_t *args) {
+    ujson_iterparse_t *self = m_new_obj(ujson_iterparse_t);
+    self->base.type = &ujson_iterparse_type;
+    vstr_init(&self->vstr, 8);
+    vstr_init(&self->levels, 8);
+    self->depth = n_args > 1 ? mp_obj_get_int(args[1]) : 1;
+    ujson_stream_init(&self->s, args[0], self->buf);
+    return MP_OBJ_FROM_PTR(self);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_ujson_iterparse_obj, 1, 2, mod_ujson_iterparse);
+
 STATIC const mp_rom_map_elem_t mp_module_ujson_globals_table[] = {
 #if CIRCUITPY
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_json) },
@@ -299,6 +470,7 @@ STATIC const mp_rom_map_elem_t mp_module_ujson_globals_table[] = {
 #endif
     { MP_ROM_QSTR(MP_QSTR_dump), MP_ROM_PTR(&mod_ujson_dump_obj) },
     { MP_ROM_QSTR(MP_QSTR_dumps), MP_ROM_PTR(&mod_ujson_dumps_obj) },
+    { MP_ROM_QSTR(MP_QSTR_iterparse), MP_ROM_PTR(&mod_ujson_iterparse_obj) },
     { MP_ROM_QSTR(MP_QSTR_load), MP_ROM_PTR(&mod_ujson_load_obj) },
     { MP_ROM_QSTR(MP_QSTR_loads), MP_ROM_PTR(&mod_ujson_loads_obj) },
 };
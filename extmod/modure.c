@@ -41,8 +41,16 @@
 
 #define FLAG_DEBUG 0x1000
 
+// The literal characters a pattern starts with are Char instructions just after "Save 0"
+#define PREFIX_START (NON_ANCHORED_PREFIX + 2)
+
 typedef struct _mp_obj_re_t {
     mp_obj_base_t base;
+    #if MICROPY_PY_URE_CACHE_SIZE
+    mp_obj_t pattern;
+    #endif
+    uint8_t prefix_len; // number of literal characters the pattern starts with
+    bool is_literal; // whether the pattern is nothing but those characters
     ByteProg re;
 } mp_obj_re_t;
 
@@ -171,6 +179,53 @@ STATIC void re_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t
     mp_printf(print, "<re %p>", self);
 }
 
+// From re1.5/recursiveloop.c, #include'd below
+static int recursiveloop(char *pc, const char *sp, Subject *input, const char **subp, int nsubp);
+
+STATIC bool re_prefix_at(mp_obj_re_t *self, const char *sp) {
+    const char *pc = self->re.insts + PREFIX_START;
+    for (size_t i = 0; i < self->prefix_len; i++, pc += 2) {
+        if (sp[i] != pc[1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Run the pattern against subj.  When it starts with literal characters, only
+// the places where they appear are tried, and if that's all there is to the
+// pattern the bytecode isn't run at all.
+STATIC int re_exec_prog(mp_obj_re_t *self, Subject *subj, const char **caps, int caps_num, bool is_anchored) {
+    size_t len = self->prefix_len;
+    if (len == 0) {
+        return re1_5_recursiveloopprog(&self->re, subj, caps, caps_num, is_anchored);
+    }
+    const char *sp = subj->begin;
+    while ((size_t)(subj->end - sp) >= len) {
+        if (!is_anchored) {
+            sp = memchr(sp, self->re.insts[PREFIX_START + 1], subj->end - sp - len + 1);
+            if (sp == NULL) {
+                return 0;
+            }
+        }
+        if (re_prefix_at(self, sp)) {
+            if (self->is_literal) {
+                caps[0] = sp;
+                caps[1] = sp + len;
+                return 1;
+            }
+            if (recursiveloop(self->re.insts + NON_ANCHORED_PREFIX, sp, subj, caps, caps_num)) {
+                return 1;
+            }
+        }
+        if (is_anchored) {
+            break;
+        }
+        sp++;
+    }
+    return 0;
+}
+
 STATIC mp_obj_t ure_exec(bool is_anchored, uint n_args, const mp_obj_t *args) {
     (void)n_args;
     mp_obj_re_t *self = MP_OBJ_TO_PTR(args[0]);
@@ -211,7 +266,7 @@ STATIC mp_obj_t ure_exec(bool is_anchored, uint n_args, const mp_obj_t *args) {
     mp_obj_match_t *match = m_new_obj_var(mp_obj_match_t, char*, caps_num);
     // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
     memset((char*)match->caps, 0, caps_num * sizeof(char*));
-    int res = re1_5_recursiveloopprog(&self->re, &subj, match->caps, caps_num, is_anchored);
+    int res = re_exec_prog(self, &subj, match->caps, caps_num, is_anchored);
     if (res == 0) {
         m_del_var(mp_obj_match_t, char*, caps_num, match);
         return mp_const_none;
@@ -252,7 +307,7 @@ STATIC mp_obj_t re_split(size_t n_args, const mp_obj_t *args) {
     while (true) {
         // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
         memset((char**)caps, 0, caps_num * sizeof(char*));
-        int res = re1_5_recursiveloopprog(&self->re, &subj, caps, caps_num, false);
+        int res = re_exec_prog(self, &subj, caps, caps_num, false);
 
         // if we didn't have a match, or had an empty match, it's time to stop
         if (!res || caps[0] == caps[1]) {
@@ -307,7 +362,7 @@ STATIC mp_obj_t re_sub_helper(mp_obj_t self_in, size_t n_args, const mp_obj_t *a
     for (;;) {
         // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
         memset((char*)match->caps, 0, caps_num * sizeof(char*));
-        int res = re1_5_recursiveloopprog(&self->re, &subj, match->caps, caps_num, false);
+        int res = re_exec_prog(self, &subj, match->caps, caps_num, false);
 
         // If we didn't have a match, or had an empty match, it's time to stop
         if (!res || match->caps[0] == match->caps[1]) {
@@ -434,13 +489,55 @@ error:
     if (flags & FLAG_DEBUG) {
         re1_5_dumpcode(&o->re);
     }
+    #if MICROPY_PY_URE_CACHE_SIZE
+    o->pattern = args[0];
+    #endif
+    const char *pc = o->re.insts + PREFIX_START;
+    size_t prefix_len = 0;
+    while (*pc == Char && prefix_len < 255) {
+        pc += 2;
+        prefix_len++;
+    }
+    o->prefix_len = prefix_len;
+    o->is_literal = pc[0] == Save && pc[1] == 1 && pc[2] == Match;
     return MP_OBJ_FROM_PTR(o);
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_re_compile_obj, 1, 2, mod_re_compile);
 
+#if MICROPY_PY_URE_CACHE_SIZE
+// Compile the pattern for the module-level functions, reusing a recent
+// compilation of it if there is one
+STATIC mp_obj_t re_compile_cached(mp_obj_t pattern) {
+    mp_obj_t *cache = MP_STATE_VM(ure_cache);
+    mp_obj_t re = MP_OBJ_NULL;
+    size_t i;
+    for (i = 0; i < MICROPY_PY_URE_CACHE_SIZE && cache[i] != MP_OBJ_NULL; i++) {
+        mp_obj_re_t *o = MP_OBJ_TO_PTR(cache[i]);
+        // a str pattern never matches a bytes one
+        if (o->pattern == pattern || (mp_obj_get_type(o->pattern) == mp_obj_get_type(pattern)
+                                      && mp_obj_equal(o->pattern, pattern))) {
+            re = cache[i];
+            break;
+        }
+    }
+    if (re == MP_OBJ_NULL) {
+        re = mod_re_compile(1, &pattern);
+        if (i == MICROPY_PY_URE_CACHE_SIZE) {
+            // drop the least recently used
+            i--;
+        }
+    }
+    memmove(cache + 1, cache, i * sizeof(mp_obj_t));
+    cache[0] = re;
+    return re;
+}
+#else
+#define re_compile_cached(pattern) mod_re_compile(1, &(pattern))
+#endif
+
 STATIC mp_obj_t mod_re_exec(bool is_anchored, uint n_args, const mp_obj_t *args) {
     (void)n_args;
-    mp_obj_t self = mod_re_compile(1, args);
+    mp_obj_t self = re_compile_cached(args[0]);
 
     const mp_obj_t args2[] = {self, args[1]};
     mp_obj_t match = ure_exec(is_anchored, 2, args2);
@@ -459,7 +556,7 @@ MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_re_search_obj, 2, 4, mod_re_search);
 
 #if MICROPY_PY_URE_SUB
 STATIC mp_obj_t mod_re_sub(size_t n_args, const mp_obj_t *args) {
-    mp_obj_t self = mod_re_compile(1, args);
+    mp_obj_t self = re_compile_cached(args[0]);
     return re_sub_helper(self, n_args, args);
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_re_sub_obj, 3, 5, mod_re_sub);
@@ -49,6 +49,9 @@ typedef struct _poll_obj_t {
     mp_uint_t (*ioctl)(mp_obj_t obj, mp_uint_t request, mp_uint_t arg, int *errcode);
     mp_uint_t flags;
     mp_uint_t flags_ret;
+    #if MICROPY_STREAMS_READY_EVENTS
+    bool signals_ready;
+    #endif
 } poll_obj_t;
 
 STATIC void poll_map_add(mp_map_t *poll_map, const mp_obj_t *obj, mp_uint_t obj_len, mp_uint_t flags, bool or_flags) {
@@ -62,6 +65,9 @@ STATIC void poll_map_add(mp_map_t *poll_map, const mp_obj_t *obj, mp_uint_t obj_
             poll_obj->ioctl = stream_p->ioctl;
             poll_obj->flags = flags;
             poll_obj->flags_ret = 0;
+            #if MICROPY_STREAMS_READY_EVENTS
+            poll_obj->signals_ready = stream_p->signals_ready;
+            #endif
             elem->value = poll_obj;
         } else {
             // object exists; update its flags
@@ -111,6 +117,20 @@ STATIC mp_uint_t poll_map_poll(mp_map_t *poll_map, mp_uint_t *rwx_num) {
     return n_ready;
 }
 
+#if MICROPY_STREAMS_READY_EVENTS
+// Objects that all signal when they may have become ready needn't be polled
+// again until one does.
+STATIC bool poll_map_signals_ready(mp_map_t *poll_map) {
+    for (mp_uint_t i = 0; i < poll_map->alloc; ++i) {
+        if (MP_MAP_SLOT_IS_FILLED(poll_map, i)
+            && !((poll_obj_t*)poll_map->table[i].value)->signals_ready) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
 /// \function select(rlist, wlist, xlist[, timeout])
 STATIC mp_obj_t select_select(uint n_args, const mp_obj_t *args) {
     // get array data from tuple/list arguments
@@ -145,6 +165,9 @@ STATIC mp_obj_t select_select(uint n_args, const mp_obj_t *args) {
     mp_uint_t start_tick = mp_hal_ticks_ms();
     rwx_len[0] = rwx_len[1] = rwx_len[2] = 0;
     for (;;) {
+        #if MICROPY_STREAMS_READY_EVENTS
+        uint32_t events = mp_stream_ready_events();
+        #endif
         // poll the objects
         mp_uint_t n_ready = poll_map_poll(&poll_map, rwx_len);
 
@@ -174,6 +197,11 @@ STATIC mp_obj_t select_select(uint n_args, const mp_obj_t *args) {
             return mp_obj_new_tuple(3, list_array);
         }
         MICROPY_EVENT_POLL_HOOK
+        #if MICROPY_STREAMS_READY_EVENTS
+        if (poll_map_signals_ready(&poll_map)) {
+            mp_stream_wait_ready(events, start_tick, timeout);
+        }
+        #endif
     }
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_select_select_obj, 3, 4, select_select);
@@ -248,12 +276,20 @@ STATIC mp_uint_t poll_poll_internal(uint n_args, const mp_obj_t *args) {
     mp_uint_t start_tick = mp_hal_ticks_ms();
     mp_uint_t n_ready;
     for (;;) {
+        #if MICROPY_STREAMS_READY_EVENTS
+        uint32_t events = mp_stream_ready_events();
+        #endif
         // poll the objects
         n_ready = poll_map_poll(&self->poll_map, NULL);
         if (n_ready > 0 || (timeout != -1 && mp_hal_ticks_ms() - start_tick >= timeout)) {
             break;
         }
         MICROPY_EVENT_POLL_HOOK
+        #if MICROPY_STREAMS_READY_EVENTS
+        if (poll_map_signals_ready(&self->poll_map)) {
+            mp_stream_wait_ready(events, start_tick, timeout);
+        }
+        #endif
     }
 
     return n_ready;
@@ -102,7 +102,8 @@ header_error:
         dict_sz = 1 << -dict_opt;
     }
 
-    uzlib_uncompress_init(&o->decomp, m_new(byte, dict_sz), dict_sz);
+    // The window lives as long as the stream, so keep it out of the way of short-lived objects
+    uzlib_uncompress_init(&o->decomp, m_malloc(dict_sz, true), dict_sz);
     return MP_OBJ_FROM_PTR(o);
 }
 
@@ -146,6 +147,279 @@ STATIC const mp_obj_type_t decompio_type = {
     .locals_dict = (void*)&decompio_locals_dict,
 };
 
+// CompIO compresses what is written to it into a zlib stream written to another
+// stream.  The compressed data is a single block using the fixed Huffman codes,
+// with matches found through hash chains over a window of (1 << wbits) bytes.
+// It needs (4 << wbits) + (2 << hbits) bytes besides the object itself.
+
+#define COMPIO_MIN_MATCH (3)
+#define COMPIO_MAX_MATCH (258)
+// How many earlier positions with the same hash to try for each match
+#define COMPIO_MAX_CHAIN (32)
+// Position 0 is never used as a match so it marks the end of a hash chain
+#define COMPIO_NIL (0)
+
+typedef struct _mp_obj_compio_t {
+    mp_obj_base_t base;
+    mp_obj_t dest_stream;
+    byte *window; // 2 << wbits bytes of input, the older half for matches
+    uint16_t *prev; // 1 << wbits links to the previous position with the same hash
+    uint16_t *head; // 1 << hbits latest positions for each hash
+    size_t pos; // next position in window to compress
+    size_t end; // end of the input in window
+    uint32_t adler;
+    uint32_t bits; // output bits not yet in out
+    uint8_t nbits;
+    uint8_t wbits;
+    uint8_t hbits;
+    bool closed;
+    uint8_t out_len;
+    byte out[64];
+} mp_obj_compio_t;
+
+STATIC const uint16_t compio_len_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
+};
+
+STATIC const uint16_t compio_dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577,
+};
+
+STATIC void compio_flush_out(mp_obj_compio_t *o) {
+    mp_stream_write(o->dest_stream, o->out, o->out_len, MP_STREAM_RW_WRITE);
+    o->out_len = 0;
+}
+
+STATIC void compio_put_byte(mp_obj_compio_t *o, byte b) {
+    o->out[o->out_len++] = b;
+    if (o->out_len == sizeof(o->out)) {
+        compio_flush_out(o);
+    }
+}
+
+STATIC void compio_put_bits(mp_obj_compio_t *o, uint32_t bits, uint n) {
+    o->bits |= bits << o->nbits;
+    o->nbits += n;
+    while (o->nbits >= 8) {
+        compio_put_byte(o, o->bits);
+        o->bits >>= 8;
+        o->nbits -= 8;
+    }
+}
+
+// Huffman codes are packed starting from their most significant bit
+STATIC void compio_put_code(mp_obj_compio_t *o, uint code, uint n) {
+    uint rev = 0;
+    for (uint i = 0; i < n; i++) {
+        rev = (rev << 1) | (code & 1);
+        code >>= 1;
+    }
+    compio_put_bits(o, rev, n);
+}
+
+STATIC void compio_put_symbol(mp_obj_compio_t *o, uint sym) {
+    if (sym < 144) {
+        compio_put_code(o, 0x30 + sym, 8);
+    } else if (sym < 256) {
+        compio_put_code(o, 0x190 + sym - 144, 9);
+    } else if (sym < 280) {
+        compio_put_code(o, sym - 256, 7);
+    } else {
+        compio_put_code(o, 0xc0 + sym - 280, 8);
+    }
+}
+
+STATIC void compio_put_match(mp_obj_compio_t *o, uint len, uint dist) {
+    uint i = MP_ARRAY_SIZE(compio_len_base) - 1;
+    while (len < compio_len_base[i]) {
+        i--;
+    }
+    compio_put_symbol(o, 257 + i);
+    compio_put_bits(o, len - compio_len_base[i], i < 8 || i == 28 ? 0 : (i - 4) / 4);
+    i = MP_ARRAY_SIZE(compio_dist_base) - 1;
+    while (dist < compio_dist_base[i]) {
+        i--;
+    }
+    compio_put_code(o, i, 5);
+    compio_put_bits(o, dist - compio_dist_base[i], i < 4 ? 0 : (i - 2) / 2);
+}
+
+// Add pos to its hash chain and return the previous head of the chain
+STATIC uint compio_insert(mp_obj_compio_t *o, size_t pos) {
+    if (pos + COMPIO_MIN_MATCH > o->end) {
+        return COMPIO_NIL;
+    }
+    const byte *p = o->window + pos;
+    uint32_t h = (((uint32_t)p[0] << 16 | p[1] << 8 | p[2]) * 0x9e3779b1) >> (32 - o->hbits);
+    uint cand = o->head[h];
+    o->prev[pos & ((1 << o->wbits) - 1)] = cand;
+    o->head[h] = pos;
+    return cand;
+}
+
+// Compress the input in window, leaving enough for the longest match unless flushing
+STATIC void compio_deflate(mp_obj_compio_t *o, bool flush) {
+    size_t w = 1 << o->wbits;
+    while (o->pos < o->end && (flush || o->end - o->pos >= COMPIO_MAX_MATCH)) {
+        size_t pos = o->pos;
+        size_t avail = MIN(o->end - pos, COMPIO_MAX_MATCH);
+        const byte *p = o->window + pos;
+        size_t best_len = 0;
+        size_t best_dist = 0;
+        uint cand = compio_insert(o, pos);
+        for (uint chain = COMPIO_MAX_CHAIN; cand != COMPIO_NIL && pos - cand < w && chain > 0; chain--) {
+            const byte *q = o->window + cand;
+            if (q[best_len] == p[best_len]) {
+                size_t len = 0;
+                while (len < avail && q[len] == p[len]) {
+                    len++;
+                }
+                if (len > best_len) {
+                    best_len = len;
+                    best_dist = pos - cand;
+                    if (len == avail) {
+                        break;
+                    }
+                }
+            }
+            cand = o->prev[cand & (w - 1)];
+        }
+        if (best_len >= COMPIO_MIN_MATCH) {
+            compio_put_match(o, best_len, best_dist);
+            for (size_t i = 1; i < best_len; i++) {
+                compio_insert(o, pos + i);
+            }
+            o->pos += best_len;
+        } else {
+            compio_put_symbol(o, *p);
+            o->pos += 1;
+        }
+    }
+}
+
+// Move the newer half of the window down, forgetting positions that fall out of it
+STATIC void compio_slide(mp_obj_compio_t *o) {
+    size_t w = 1 << o->wbits;
+    memmove(o->window, o->window + w, w);
+    o->pos -= w;
+    o->end -= w;
+    for (size_t i = 0; i < w; i++) {
+        o->prev[i] = o->prev[i] >= w ? o->prev[i] - w : COMPIO_NIL;
+    }
+    for (size_t i = 0; i < (1u << o->hbits); i++) {
+        o->head[i] = o->head[i] >= w ? o->head[i] - w : COMPIO_NIL;
+    }
+}
+
+STATIC mp_obj_t compio_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    mp_arg_check_num(n_args, kw_args, 1, 3, false);
+    mp_get_stream_raise(args[0], MP_STREAM_OP_WRITE);
+    mp_int_t wbits = n_args > 1 ? mp_obj_get_int(args[1]) : 10;
+    mp_int_t hbits = n_args > 2 ? mp_obj_get_int(args[2]) : 8;
+    // The window has to hold more than the longest match
+    if (wbits < 9 || wbits > 15 || hbits < 4 || hbits > 16) {
+        mp_raise_ValueError(translate("invalid window or hash size"));
+    }
+    mp_obj_compio_t *o = m_new_obj(mp_obj_compio_t);
+    o->base.type = type;
+    o->dest_stream = args[0];
+    size_t w = 1 << wbits;
+    o->window = m_malloc(2 * w, true);
+    o->prev = m_malloc(w * sizeof(uint16_t), true);
+    o->head = m_malloc0((1 << hbits) * sizeof(uint16_t), true);
+    o->pos = 0;
+    o->end = 0;
+    o->adler = 1;
+    o->bits = 0;
+    o->nbits = 0;
+    o->wbits = wbits;
+    o->hbits = hbits;
+    o->closed = false;
+    o->out_len = 0;
+
+    // zlib header, then the start of the final block using fixed codes
+    uint cmf = (wbits - 8) << 4 | 8;
+    compio_put_byte(o, cmf);
+    compio_put_byte(o, 31 - (cmf << 8) % 31);
+    compio_put_bits(o, 1 | 1 << 1, 3);
+    return MP_OBJ_FROM_PTR(o);
+}
+
+STATIC mp_uint_t compio_write(mp_obj_t o_in, const void *buf_in, mp_uint_t size, int *errcode) {
+    mp_obj_compio_t *o = MP_OBJ_TO_PTR(o_in);
+    if (o->closed) {
+        *errcode = MP_EINVAL;
+        return MP_STREAM_ERROR;
+    }
+    o->adler = uzlib_adler32(buf_in, size, o->adler);
+    const byte *buf = buf_in;
+    size_t todo = size;
+    size_t window_size = 2 << o->wbits;
+    while (todo > 0) {
+        if (o->end == window_size) {
+            compio_slide(o);
+        }
+        size_t n = MIN(todo, window_size - o->end);
+        memcpy(o->window + o->end, buf, n);
+        o->end += n;
+        buf += n;
+        todo -= n;
+        compio_deflate(o, false);
+    }
+    return size;
+}
+
+// Compress the rest of the input and finish the zlib stream, leaving dest_stream open
+STATIC void compio_close(mp_obj_compio_t *o) {
+    if (o->closed) {
+        return;
+    }
+    o->closed = true;
+    compio_deflate(o, true);
+    compio_put_symbol(o, 256);
+    if (o->nbits > 0) {
+        compio_put_bits(o, 0, 8 - o->nbits);
+    }
+    for (int i = 24; i >= 0; i -= 8) {
+        compio_put_byte(o, o->adler >> i);
+    }
+    compio_flush_out(o);
+}
+
+STATIC mp_uint_t compio_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg, int *errcode) {
+    (void)arg;
+    mp_obj_compio_t *o = MP_OBJ_TO_PTR(o_in);
+    if (request == MP_STREAM_CLOSE) {
+        compio_close(o);
+        return 0;
+    }
+    *errcode = MP_EINVAL;
+    return MP_STREAM_ERROR;
+}
+
+STATIC const mp_rom_map_elem_t compio_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&mp_stream_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_close), MP_ROM_PTR(&mp_stream_close_obj) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(compio_locals_dict, compio_locals_dict_table);
+
+STATIC const mp_stream_p_t compio_stream_p = {
+    MP_PROTO_IMPLEMENT(MP_QSTR_protocol_stream)
+    .write = compio_write,
+    .ioctl = compio_ioctl,
+};
+
+STATIC const mp_obj_type_t compio_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_CompIO,
+    .make_new = compio_make_new,
+    .protocol = &compio_stream_p,
+    .locals_dict = (void*)&compio_locals_dict,
+};
+
 STATIC mp_obj_t mod_uzlib_decompress(size_t n_args, const mp_obj_t *args) {
     mp_obj_t data = args[0];
     mp_buffer_info_t bufinfo;
@@ -208,6 +482,7 @@ STATIC const mp_rom_map_elem_t mp_module_uzlib_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_uzlib) },
     { MP_ROM_QSTR(MP_QSTR_decompress), MP_ROM_PTR(&mod_uzlib_decompress_obj) },
     { MP_ROM_QSTR(MP_QSTR_DecompIO), MP_ROM_PTR(&decompio_type) },
+    { MP_ROM_QSTR(MP_QSTR_CompIO), MP_ROM_PTR(&compio_type) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(mp_module_uzlib_globals, mp_module_uzlib_globals_table);
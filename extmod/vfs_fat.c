@@ -50,10 +50,168 @@
 
 #define mp_obj_fat_vfs_t fs_user_mount_t
 
+#if MICROPY_VFS_FAT_IMPORT_STAT_CACHE
+// Resolving an import stats each name it tries in each sys.path directory,
+// and on FAT every miss is a search of the whole directory. Instead, the
+// first stat in a directory reads its listing into a heap buffer and later
+// stats in it are answered from there.
+//
+// The buffer holds one record per directory:
+//   uint16 record length, vfs pointer, complete flag, dir length, dir
+// followed by one entry per name (complete records only):
+//   mp_import_stat_t, name length, name
+// A listing too big for the space left is recorded as incomplete so that
+// stats in that directory go straight to the filesystem.
+
+#if MICROPY_VFS_FAT_IMPORT_STAT_CACHE_SIZE > 0xffff
+#error "MICROPY_VFS_FAT_IMPORT_STAT_CACHE_SIZE must fit in 16 bits"
+#endif
+
+#define STAT_CACHE_HEADER_LEN (2 + sizeof(void*) + 2)
+
+void fat_vfs_import_stat_cache_clear(void) {
+    MP_STATE_VM(fat_import_stat_cache_used) = 0;
+}
+
+// FAT names are case insensitive
+STATIC bool stat_cache_name_equal(const byte *name, const char *str, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (unichar_tolower(name[i]) != unichar_tolower(str[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+STATIC byte *stat_cache_find_dir(fs_user_mount_t *vfs, const char *dir, size_t dir_len) {
+    byte *rec = MP_STATE_VM(fat_import_stat_cache);
+    byte *end = rec + MP_STATE_VM(fat_import_stat_cache_used);
+    while (rec < end) {
+        void *rec_vfs;
+        memcpy(&rec_vfs, rec + 2, sizeof(void*));
+        if (rec_vfs == vfs && rec[STAT_CACHE_HEADER_LEN - 1] == dir_len
+            && memcmp(rec + STAT_CACHE_HEADER_LEN, dir, dir_len) == 0) {
+            return rec;
+        }
+        rec += rec[0] | rec[1] << 8;
+    }
+    return NULL;
+}
+
+// Append the listing of dir to the cache and return its record, or NULL if
+// it couldn't be recorded.
+STATIC byte *stat_cache_add_dir(fs_user_mount_t *vfs, const char *dir, size_t dir_len) {
+    if (MP_STATE_VM(fat_import_stat_cache) == NULL) {
+        MP_STATE_VM(fat_import_stat_cache) = m_new_maybe(byte, MICROPY_VFS_FAT_IMPORT_STAT_CACHE_SIZE);
+        if (MP_STATE_VM(fat_import_stat_cache) == NULL) {
+            return NULL;
+        }
+    }
+    size_t used = MP_STATE_VM(fat_import_stat_cache_used);
+    size_t avail = MICROPY_VFS_FAT_IMPORT_STAT_CACHE_SIZE - used;
+    if (avail < STAT_CACHE_HEADER_LEN + dir_len) {
+        return NULL;
+    }
+
+    VSTR_FIXED(dir_path, MICROPY_ALLOC_PATH_MAX)
+    vstr_add_strn(&dir_path, dir, dir_len);
+    FF_DIR dp;
+    FRESULT res = f_opendir(&vfs->fatfs, &dp, vstr_null_terminated_str(&dir_path));
+    if (res != FR_OK && res != FR_NO_PATH && res != FR_NO_FILE) {
+        return NULL;
+    }
+
+    byte *rec = MP_STATE_VM(fat_import_stat_cache) + used;
+    memcpy(rec + 2, &vfs, sizeof(void*));
+    rec[STAT_CACHE_HEADER_LEN - 1] = dir_len;
+    memcpy(rec + STAT_CACHE_HEADER_LEN, dir, dir_len);
+    size_t rec_len = STAT_CACHE_HEADER_LEN + dir_len;
+    bool complete = true;
+    // A missing directory is recorded as an empty one.
+    while (res == FR_OK) {
+        FILINFO fno;
+        res = f_readdir(&dp, &fno);
+        size_t name_len = strlen(fno.fname);
+        if (res != FR_OK || name_len == 0) {
+            complete = res == FR_OK;
+            f_closedir(&dp);
+            break;
+        }
+        if (rec_len + 2 + name_len > avail) {
+            complete = false;
+            f_closedir(&dp);
+            break;
+        }
+        rec[rec_len++] = (fno.fattrib & AM_DIR) ? MP_IMPORT_STAT_DIR : MP_IMPORT_STAT_FILE;
+        rec[rec_len++] = name_len;
+        memcpy(rec + rec_len, fno.fname, name_len);
+        rec_len += name_len;
+    }
+    if (!complete) {
+        rec_len = STAT_CACHE_HEADER_LEN + dir_len;
+    }
+    rec[0] = rec_len & 0xff;
+    rec[1] = rec_len >> 8;
+    rec[STAT_CACHE_HEADER_LEN - 2] = complete;
+    MP_STATE_VM(fat_import_stat_cache_used) = used + rec_len;
+    return rec;
+}
+
+STATIC bool stat_cache_lookup(fs_user_mount_t *vfs, const char *path, mp_import_stat_t *stat) {
+    const char *name = strrchr(path, '/');
+    name = name == NULL ? path : name + 1;
+    size_t dir_len = name - path;
+    if (dir_len > 1) {
+        // drop the separator, but keep "/" for the root
+        dir_len -= 1;
+    }
+    size_t name_len = strlen(name);
+    if (name_len == 0 || dir_len > 0xff) {
+        return false;
+    }
+    // Leave names the listing can't answer for to the filesystem: short
+    // name aliases of long names, and anything needing a code page.
+    for (size_t i = 0; i < name_len; i++) {
+        if (name[i] == '~' || (byte)name[i] >= 0x80) {
+            return false;
+        }
+    }
+
+    byte *rec = stat_cache_find_dir(vfs, path, dir_len);
+    if (rec == NULL) {
+        rec = stat_cache_add_dir(vfs, path, dir_len);
+        if (rec == NULL) {
+            return false;
+        }
+    }
+    if (!rec[STAT_CACHE_HEADER_LEN - 2]) {
+        return false;
+    }
+
+    const byte *entry = rec + STAT_CACHE_HEADER_LEN + dir_len;
+    const byte *end = rec + (rec[0] | rec[1] << 8);
+    *stat = MP_IMPORT_STAT_NO_EXIST;
+    while (entry < end) {
+        if (entry[1] == name_len && stat_cache_name_equal(entry + 2, name, name_len)) {
+            *stat = entry[0];
+            break;
+        }
+        entry += 2 + entry[1];
+    }
+    return true;
+}
+#endif
+
 mp_import_stat_t fat_vfs_import_stat(void *vfs_in, const char *path) {
     fs_user_mount_t *vfs = vfs_in;
     FILINFO fno;
     assert(vfs != NULL);
+    #if MICROPY_VFS_FAT_IMPORT_STAT_CACHE
+    mp_import_stat_t stat;
+    if (stat_cache_lookup(vfs, path, &stat)) {
+        return stat;
+    }
+    #endif
     FRESULT res = f_stat(&vfs->fatfs, path, &fno);
     if (res == FR_OK) {
         if ((fno.fattrib & AM_DIR) != 0) {
@@ -122,6 +280,7 @@ STATIC mp_obj_t fat_vfs_mkfs(mp_obj_t bdev_in) {
     // make the filesystem
     uint8_t working_buf[_MAX_SS];
     FRESULT res = f_mkfs(&vfs->fatfs, FM_FAT | FM_SFD, 0, working_buf, sizeof(working_buf));
+    fat_vfs_import_stat_cache_clear();
     if (res != FR_OK) {
         mp_raise_OSError(fresult_to_errno_table[res]);
     }
@@ -220,6 +379,7 @@ STATIC mp_obj_t fat_vfs_remove_internal(mp_obj_t vfs_in, mp_obj_t path_in, mp_in
     // check if path is a file or directory
     if ((fno.fattrib & AM_DIR) == attr) {
         res = f_unlink(&self->fatfs, path);
+        fat_vfs_import_stat_cache_clear();
 
         if (res != FR_OK) {
             mp_raise_OSError(fresult_to_errno_table[res]);
@@ -262,6 +422,7 @@ STATIC mp_obj_t fat_vfs_rename(mp_obj_t vfs_in, mp_obj_t path_in, mp_obj_t path_
     }
 
     res = f_rename(&self->fatfs, old_path, new_path);
+    fat_vfs_import_stat_cache_clear();
     if (res == FR_EXIST) {
         // if new_path exists then try removing it (but only if it's a file)
         fat_vfs_remove_internal(vfs_in, path_out, 0); // 0 == file attribute
@@ -282,6 +443,7 @@ STATIC mp_obj_t fat_vfs_mkdir(mp_obj_t vfs_in, mp_obj_t path_o) {
     verify_fs_writable(self);
     const char *path = mp_obj_str_get_str(path_o);
     FRESULT res = f_mkdir(&self->fatfs, path);
+    fat_vfs_import_stat_cache_clear();
     if (res == FR_OK) {
         return mp_const_none;
     } else {
@@ -297,6 +459,8 @@ STATIC mp_obj_t fat_vfs_chdir(mp_obj_t vfs_in, mp_obj_t path_in) {
     path = mp_obj_str_get_str(path_in);
 
     FRESULT res = f_chdir(&self->fatfs, path);
+    // cached directories may be relative to the old one
+    fat_vfs_import_stat_cache_clear();
 
     if (res != FR_OK) {
         mp_raise_OSError(fresult_to_errno_table[res]);
@@ -414,6 +578,7 @@ STATIC mp_obj_t vfs_fat_mount(mp_obj_t self_in, mp_obj_t readonly, mp_obj_t mkfs
         uint8_t working_buf[_MAX_SS];
         res = f_mkfs(&self->fatfs, FM_FAT | FM_SFD, 0, working_buf, sizeof(working_buf));
     }
+    fat_vfs_import_stat_cache_clear();
     if (res != FR_OK) {
         mp_raise_OSError(fresult_to_errno_table[res]);
     }
@@ -425,6 +590,7 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_3(vfs_fat_mount_obj, vfs_fat_mount);
 
 STATIC mp_obj_t vfs_fat_umount(mp_obj_t self_in) {
     (void)self_in;
+    fat_vfs_import_stat_cache_clear();
     // keep the FAT filesystem mounted internally so the VFS methods can still be used
     return mp_const_none;
 }
@@ -69,6 +69,15 @@ extern const mp_obj_type_t mp_type_vfs_fat_textio;
 
 mp_import_stat_t fat_vfs_import_stat(void *vfs, const char *path);
 
+// Forget the cached directory listings used by fat_vfs_import_stat. Must be
+// called whenever a FAT filesystem may have changed.
+#if MICROPY_VFS_FAT_IMPORT_STAT_CACHE
+void fat_vfs_import_stat_cache_clear(void);
+#else
+static inline void fat_vfs_import_stat_cache_clear(void) {
+}
+#endif
+
 MP_DECLARE_CONST_FUN_OBJ_3(fat_vfs_open_obj);
 
 mp_obj_t fat_vfs_ilistdir2(struct _fs_user_mount_t *vfs, const char *path, bool is_str_type);
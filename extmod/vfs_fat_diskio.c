@@ -41,6 +41,7 @@
 #include "lib/oofatfs/ff.h"
 #include "lib/oofatfs/diskio.h"
 #include "extmod/vfs_fat.h"
+#include "supervisor/usb.h"
 
 #if _MAX_SS == _MIN_SS
 #define SECSIZE(fs) (_MIN_SS)
@@ -71,7 +72,11 @@ DRESULT disk_read (
 
     if (vfs->flags & FSUSER_NATIVE) {
         mp_uint_t (*f)(uint8_t*, uint32_t, uint32_t) = (void*)(uintptr_t)vfs->readblocks[2];
-        if (f(buff, sector, count) != 0) {
+        // MSC may read the same blocks from the USB interrupt.
+        usb_lock();
+        mp_uint_t result = f(buff, sector, count);
+        usb_unlock();
+        if (result != 0) {
             return RES_ERROR;
         }
     } else {
@@ -117,7 +122,10 @@ DRESULT disk_write (
 
     if (vfs->flags & FSUSER_NATIVE) {
         mp_uint_t (*f)(const uint8_t*, uint32_t, uint32_t) = (void*)(uintptr_t)vfs->writeblocks[2];
-        if (f(buff, sector, count) != 0) {
+        usb_lock();
+        mp_uint_t result = f(buff, sector, count);
+        usb_unlock();
+        if (result != 0) {
             return RES_ERROR;
         }
     } else {
@@ -170,7 +178,15 @@ DRESULT disk_ioctl (
         if (bp_op != 0) {
             vfs->u.ioctl[2] = MP_OBJ_NEW_SMALL_INT(bp_op);
             vfs->u.ioctl[3] = MP_OBJ_NEW_SMALL_INT(0); // unused
-            ret = mp_call_method_n_kw(2, 0, vfs->u.ioctl);
+            if (vfs->flags & FSUSER_NATIVE) {
+                // Syncing a native device flushes the same cache MSC reads from. Its ioctl
+                // doesn't raise, so the lock is always released.
+                usb_lock();
+                ret = mp_call_method_n_kw(2, 0, vfs->u.ioctl);
+                usb_unlock();
+            } else {
+                ret = mp_call_method_n_kw(2, 0, vfs->u.ioctl);
+            }
         }
     } else {
         // old protocol with sync and count
@@ -28,6 +28,7 @@
 #if MICROPY_VFS && MICROPY_VFS_FAT
 
 #include <stdio.h>
+#include <string.h>
 
 #include "py/runtime.h"
 #include "py/stream.h"
@@ -36,6 +37,12 @@
 #include "extmod/vfs_fat.h"
 #include "supervisor/filesystem.h"
 
+#if _MAX_SS == _MIN_SS
+#define SECSIZE(fs) (_MIN_SS)
+#else
+#define SECSIZE(fs) ((fs)->ssize)
+#endif
+
 // this table converts from FRESULT to POSIX errno
 const byte fresult_to_errno_table[20] = {
     [FR_OK] = 0,
@@ -156,6 +163,42 @@ STATIC const mp_arg_t file_open_args[] = {
 };
 #define FILE_OPEN_NUM_ARGS MP_ARRAY_SIZE(file_open_args)
 
+// Map the cluster chain of a file open for reading, so that seeks don't follow
+// the chain from the start of the file. A file within one cluster has nothing
+// to map and is left alone.
+STATIC void file_obj_create_linkmap(fs_user_mount_t *vfs, FIL *fp) {
+    if (f_size(fp) <= (FSIZE_t)vfs->fatfs.csize * SECSIZE(&vfs->fatfs)) {
+        return;
+    }
+    // Most files are in a few fragments, so try a small table first. When it's
+    // too short, FatFs still tells us how many items are needed.
+    DWORD temp_table[8];
+    temp_table[0] = MP_ARRAY_SIZE(temp_table);
+    fp->cltbl = temp_table;
+    FRESULT res = f_lseek(fp, CREATE_LINKMAP);
+    fp->cltbl = NULL;
+    if (res != FR_OK && res != FR_NOT_ENOUGH_CORE) {
+        return;
+    }
+    DWORD size = temp_table[0];
+    DWORD *table = m_new_maybe(DWORD, size);
+    if (table == NULL) {
+        return;
+    }
+    if (res == FR_OK) {
+        memcpy(table, temp_table, size * sizeof(DWORD));
+    } else {
+        table[0] = size;
+        fp->cltbl = table;
+        if (f_lseek(fp, CREATE_LINKMAP) != FR_OK) {
+            fp->cltbl = NULL;
+            m_del(DWORD, table, size);
+            return;
+        }
+    }
+    fp->cltbl = table;
+}
+
 STATIC mp_obj_t file_open(fs_user_mount_t *vfs, const mp_obj_type_t *type, mp_arg_val_t *args) {
     int mode = 0;
     const char *mode_s = mp_obj_str_get_str(args[1].u_obj);
@@ -188,8 +231,11 @@ STATIC mp_obj_t file_open(fs_user_mount_t *vfs, const mp_obj_type_t *type, mp_ar
         }
     }
     assert(vfs != NULL);
-    if ((mode & FA_WRITE) != 0 && !filesystem_is_writable_by_python(vfs)) {
-        mp_raise_OSError(MP_EROFS);
+    if ((mode & FA_WRITE) != 0) {
+        if (!filesystem_is_writable_by_python(vfs)) {
+            mp_raise_OSError(MP_EROFS);
+        }
+        fat_vfs_import_stat_cache_clear();
     }
 
     pyb_file_obj_t *o = m_new_obj_with_finaliser(pyb_file_obj_t);
@@ -203,20 +249,7 @@ STATIC mp_obj_t file_open(fs_user_mount_t *vfs, const mp_obj_type_t *type, mp_ar
     }
     // If we're reading, turn on fast seek.
     if (mode == FA_READ) {
-        // one call to determine how much space we need.
-        DWORD temp_table[2];
-        temp_table[0] = 2;
-        o->fp.cltbl = temp_table;
-        f_lseek(&o->fp, CREATE_LINKMAP);
-        DWORD size = (temp_table[0] + 1) * 2;
-        o->fp.cltbl = m_malloc_maybe(size * sizeof(DWORD), false);
-        if (o->fp.cltbl != NULL) {
-            o->fp.cltbl[0] = size;
-            res = f_lseek(&o->fp, CREATE_LINKMAP);
-            if (res != FR_OK) {
-                o->fp.cltbl = NULL;
-            }
-        }
+        file_obj_create_linkmap(vfs, &o->fp);
     }
 
     // for 'a' mode, we must begin at the end of the file
@@ -241,6 +274,7 @@ STATIC const mp_rom_map_elem_t rawfile_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_readline), MP_ROM_PTR(&mp_stream_unbuffered_readline_obj) },
     { MP_ROM_QSTR(MP_QSTR_readlines), MP_ROM_PTR(&mp_stream_unbuffered_readlines_obj) },
     { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&mp_stream_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_writev), MP_ROM_PTR(&mp_stream_writev_obj) },
     { MP_ROM_QSTR(MP_QSTR_flush), MP_ROM_PTR(&mp_stream_flush_obj) },
     { MP_ROM_QSTR(MP_QSTR_close), MP_ROM_PTR(&mp_stream_close_obj) },
     { MP_ROM_QSTR(MP_QSTR_seek), MP_ROM_PTR(&mp_stream_seek_obj) },
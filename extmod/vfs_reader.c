@@ -34,22 +34,42 @@
 
 #if MICROPY_READER_VFS
 
+// Files are read a filesystem block or more at a time into a heap buffer, so that the filesystem
+// reads whole sectors straight into it. The buffer doubles, up to
+// MICROPY_READER_VFS_BLOCKS blocks, each time it is filled so that small files
+// take little memory and large ones take few reads. When the heap is too full for
+// a block, a small buffer in the reader is used instead.
 typedef struct _mp_reader_vfs_t {
     mp_obj_t file;
+    byte *buf;
+    uint16_t size;
     uint16_t len;
     uint16_t pos;
-    byte buf[24];
+    byte small_buf[24];
 } mp_reader_vfs_t;
 
+STATIC void mp_reader_vfs_fill(mp_reader_vfs_t *reader, int *errcode) {
+    reader->len = mp_stream_rw(reader->file, reader->buf, reader->size,
+        errcode, MP_STREAM_RW_READ | MP_STREAM_RW_ONCE);
+    reader->pos = 0;
+}
+
 STATIC mp_uint_t mp_reader_vfs_readbyte(void *data) {
     mp_reader_vfs_t *reader = (mp_reader_vfs_t*)data;
     if (reader->pos >= reader->len) {
-        if (reader->len < sizeof(reader->buf)) {
+        if (reader->len < reader->size) {
             return MP_READER_EOF;
         } else {
+            if (reader->buf != reader->small_buf &&
+                reader->size < MICROPY_READER_VFS_BLOCKS * MICROPY_READER_VFS_BLOCK_SIZE) {
+                byte *buf = m_renew_maybe(byte, reader->buf, reader->size, reader->size * 2, true);
+                if (buf != NULL) {
+                    reader->buf = buf;
+                    reader->size *= 2;
+                }
+            }
             int errcode;
-            reader->len = mp_stream_rw(reader->file, reader->buf, sizeof(reader->buf),
-                &errcode, MP_STREAM_RW_READ | MP_STREAM_RW_ONCE);
+            mp_reader_vfs_fill(reader, &errcode);
             if (errcode != 0) {
                 // TODO handle errors properly
                 return MP_READER_EOF;
@@ -57,7 +77,6 @@ STATIC mp_uint_t mp_reader_vfs_readbyte(void *data) {
             if (reader->len == 0) {
                 return MP_READER_EOF;
             }
-            reader->pos = 0;
         }
     }
     return reader->buf[reader->pos++];
@@ -66,6 +85,9 @@ STATIC mp_uint_t mp_reader_vfs_readbyte(void *data) {
 STATIC void mp_reader_vfs_close(void *data) {
     mp_reader_vfs_t *reader = (mp_reader_vfs_t*)data;
     mp_stream_close(reader->file);
+    if (reader->buf != reader->small_buf) {
+        m_del(byte, reader->buf, reader->size);
+    }
     m_del_obj(mp_reader_vfs_t, reader);
 }
 
@@ -73,12 +95,20 @@ void mp_reader_new_file(mp_reader_t *reader, const char *filename) {
     mp_reader_vfs_t *rf = m_new_obj(mp_reader_vfs_t);
     mp_obj_t arg = mp_obj_new_str(filename, strlen(filename));
     rf->file = mp_vfs_open(1, &arg, (mp_map_t*)&mp_const_empty_map);
+    rf->buf = NULL;
+    if (MICROPY_READER_VFS_BLOCKS > 0) {
+        rf->buf = m_new_maybe(byte, MICROPY_READER_VFS_BLOCK_SIZE);
+        rf->size = MICROPY_READER_VFS_BLOCK_SIZE;
+    }
+    if (rf->buf == NULL) {
+        rf->buf = rf->small_buf;
+        rf->size = sizeof(rf->small_buf);
+    }
     int errcode;
-    rf->len = mp_stream_rw(rf->file, rf->buf, sizeof(rf->buf), &errcode, MP_STREAM_RW_READ | MP_STREAM_RW_ONCE);
+    mp_reader_vfs_fill(rf, &errcode);
     if (errcode != 0) {
         mp_raise_OSError(errcode);
     }
-    rf->pos = 0;
     reader->data = rf;
     reader->readbyte = mp_reader_vfs_readbyte;
     reader->close = mp_reader_vfs_close;
@@ -0,0 +1,647 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "py/mpconfig.h"
+#if MICROPY_VFS && MICROPY_VFS_ROM
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "py/stream.h"
+#include "py/mperrno.h"
+#include "extmod/vfs.h"
+#include "extmod/vfs_rom.h"
+
+#if MICROPY_VFS_ROM_COMPRESSION
+#include "../../lib/uzlib/src/tinf.h"
+#endif
+
+typedef struct _mp_obj_vfs_rom_t {
+    mp_obj_base_t base;
+    // Keeps the image alive while it's mounted or files are open
+    mp_obj_t image_obj;
+    const byte *image;
+    uint16_t entry_count;
+    // Scratch space for resolving paths
+    vstr_t path;
+    // Current directory, with no leading or trailing /
+    vstr_t cwd;
+} mp_obj_vfs_rom_t;
+
+typedef struct _vfs_rom_file_obj_t {
+    mp_obj_base_t base;
+    mp_obj_vfs_rom_t *vfs;
+    const byte *data;
+    uint32_t size;
+    uint32_t stored_size;
+    uint32_t pos;
+    bool closed;
+    #if MICROPY_VFS_ROM_COMPRESSION
+    // NULL when the file is stored uncompressed
+    TINF_DATA *decomp;
+    byte *window;
+    size_t window_size;
+    #endif
+} vfs_rom_file_obj_t;
+
+STATIC void vfs_rom_get_entry(mp_obj_vfs_rom_t *self, size_t i, vfs_rom_entry_t *entry) {
+    // The image may not be aligned, so copy the entry out of it.
+    memcpy(entry, self->image + VFS_ROM_HEADER_SIZE + i * sizeof(vfs_rom_entry_t), sizeof(vfs_rom_entry_t));
+}
+
+STATIC uint32_t vfs_rom_hash(const char *path, size_t len) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ (byte)path[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// Resolve path against the current directory, dropping "." and ".." components, and leave it
+// in self->path without a leading or trailing /.
+STATIC void vfs_rom_resolve(mp_obj_vfs_rom_t *self, const char *path) {
+    vstr_t *out = &self->path;
+    vstr_reset(out);
+    if (*path != '/') {
+        vstr_add_strn(out, self->cwd.buf, self->cwd.len);
+    }
+    while (*path != '\0') {
+        while (*path == '/') {
+            path++;
+        }
+        const char *start = path;
+        while (*path != '\0' && *path != '/') {
+            path++;
+        }
+        size_t len = path - start;
+        if (len == 0 || (len == 1 && start[0] == '.')) {
+            continue;
+        }
+        if (len == 2 && start[0] == '.' && start[1] == '.') {
+            while (out->len > 0 && out->buf[out->len - 1] != '/') {
+                out->len--;
+            }
+            if (out->len > 0) {
+                out->len--;
+            }
+            continue;
+        }
+        if (out->len > 0) {
+            vstr_add_char(out, '/');
+        }
+        vstr_add_strn(out, start, len);
+    }
+}
+
+// Find the entry for the path in self->path. The root directory has no entry of its own.
+STATIC bool vfs_rom_find(mp_obj_vfs_rom_t *self, vfs_rom_entry_t *entry) {
+    const char *path = self->path.buf;
+    size_t len = self->path.len;
+    if (len == 0) {
+        memset(entry, 0, sizeof(*entry));
+        entry->kind = VFS_ROM_KIND_DIR;
+        return true;
+    }
+    uint32_t hash = vfs_rom_hash(path, len);
+    // Binary search for the first entry with this hash, then check the names of those that have it.
+    size_t lo = 0;
+    size_t hi = self->entry_count;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        vfs_rom_get_entry(self, mid, entry);
+        if (entry->hash < hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    for (; lo < self->entry_count; lo++) {
+        vfs_rom_get_entry(self, lo, entry);
+        if (entry->hash != hash) {
+            break;
+        }
+        if (entry->name_len == len && memcmp(self->image + entry->name_offset, path, len) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+STATIC void vfs_rom_lookup(mp_obj_vfs_rom_t *self, mp_obj_t path_in, vfs_rom_entry_t *entry) {
+    vfs_rom_resolve(self, mp_obj_str_get_str(path_in));
+    if (!vfs_rom_find(self, entry)) {
+        mp_raise_OSError(MP_ENOENT);
+    }
+}
+
+STATIC mp_import_stat_t vfs_rom_import_stat(void *self_in, const char *path) {
+    mp_obj_vfs_rom_t *self = self_in;
+    vfs_rom_resolve(self, path);
+    vfs_rom_entry_t entry;
+    if (!vfs_rom_find(self, &entry)) {
+        return MP_IMPORT_STAT_NO_EXIST;
+    }
+    return entry.kind == VFS_ROM_KIND_DIR ? MP_IMPORT_STAT_DIR : MP_IMPORT_STAT_FILE;
+}
+
+STATIC mp_obj_t vfs_rom_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    mp_arg_check_num(n_args, kw_args, 1, 1, false);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[0], &bufinfo, MP_BUFFER_READ);
+    const byte *image = bufinfo.buf;
+
+    uint16_t version;
+    uint16_t entry_count;
+    uint32_t image_size;
+    if (bufinfo.len < VFS_ROM_HEADER_SIZE || memcmp(image, VFS_ROM_MAGIC, 4) != 0) {
+        mp_raise_OSError(MP_ENODEV);
+    }
+    memcpy(&version, image + 4, sizeof(version));
+    memcpy(&entry_count, image + 6, sizeof(entry_count));
+    memcpy(&image_size, image + 8, sizeof(image_size));
+    if (version != VFS_ROM_VERSION || image_size > bufinfo.len ||
+        VFS_ROM_HEADER_SIZE + entry_count * sizeof(vfs_rom_entry_t) > image_size) {
+        mp_raise_OSError(MP_ENODEV);
+    }
+
+    mp_obj_vfs_rom_t *vfs = m_new_obj(mp_obj_vfs_rom_t);
+    vfs->base.type = type;
+    vfs->image_obj = args[0];
+    vfs->image = image;
+    vfs->entry_count = entry_count;
+    vstr_init(&vfs->path, 32);
+    vstr_init(&vfs->cwd, 0);
+
+    // Check every entry once here so that nothing after this has to.
+    for (size_t i = 0; i < entry_count; i++) {
+        vfs_rom_entry_t entry;
+        vfs_rom_get_entry(vfs, i, &entry);
+        bool ok = entry.name_offset <= image_size && entry.name_len <= image_size - entry.name_offset;
+        if (entry.kind == VFS_ROM_KIND_FILE) {
+            ok = ok && entry.data_offset <= image_size && entry.stored_size <= image_size - entry.data_offset;
+            if (entry.compression == VFS_ROM_COMPRESSION_NONE) {
+                ok = ok && entry.stored_size == entry.size;
+            }
+        } else {
+            ok = ok && entry.kind == VFS_ROM_KIND_DIR;
+        }
+        if (!ok) {
+            mp_raise_OSError(MP_ENODEV);
+        }
+    }
+
+    return MP_OBJ_FROM_PTR(vfs);
+}
+
+STATIC mp_obj_t vfs_rom_mount(mp_obj_t self_in, mp_obj_t readonly, mp_obj_t mkfs) {
+    (void)self_in;
+    (void)readonly;
+    if (mp_obj_is_true(mkfs)) {
+        mp_raise_OSError(MP_EPERM);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(vfs_rom_mount_obj, vfs_rom_mount);
+
+STATIC mp_obj_t vfs_rom_umount(mp_obj_t self_in) {
+    (void)self_in;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(vfs_rom_umount_obj, vfs_rom_umount);
+
+#if MICROPY_VFS_ROM_COMPRESSION
+// Start decompressing the file from its beginning. The window is allocated the first time.
+STATIC bool vfs_rom_file_rewind(vfs_rom_file_obj_t *self) {
+    TINF_DATA *decomp = self->decomp;
+    memset(decomp, 0, sizeof(*decomp));
+    decomp->source = self->data;
+    decomp->source_limit = self->data + self->stored_size;
+    int window_bits = uzlib_zlib_parse_header(decomp);
+    if (window_bits < 0) {
+        return false;
+    }
+    if (self->window == NULL) {
+        self->window_size = (size_t)1 << window_bits;
+        self->window = m_new(byte, self->window_size);
+    }
+    uzlib_uncompress_init(decomp, self->window, self->window_size);
+    self->pos = 0;
+    return true;
+}
+
+// Decompress the next size bytes of the file, which the caller has checked it has, into buf.
+STATIC bool vfs_rom_file_inflate(vfs_rom_file_obj_t *self, byte *buf, size_t size) {
+    TINF_DATA *decomp = self->decomp;
+    decomp->dest = buf;
+    decomp->dest_limit = buf + size;
+    while (decomp->dest < decomp->dest_limit) {
+        byte *before = decomp->dest;
+        int st = uzlib_uncompress_chksum(decomp);
+        if (st < 0 || (decomp->dest == before && decomp->dest < decomp->dest_limit)) {
+            return false;
+        }
+    }
+    self->pos += size;
+    return true;
+}
+#endif
+
+STATIC mp_obj_t vfs_rom_open(mp_obj_t self_in, mp_obj_t path_in, mp_obj_t mode_in) {
+    mp_obj_vfs_rom_t *self = MP_OBJ_TO_PTR(self_in);
+    const mp_obj_type_t *type = &mp_type_vfs_rom_textio;
+    const char *mode = mp_obj_str_get_str(mode_in);
+    while (*mode) {
+        switch (*mode++) {
+            case 'w':
+            case 'x':
+            case 'a':
+            case '+':
+                mp_raise_OSError(MP_EROFS);
+            #if MICROPY_PY_IO_FILEIO
+            case 'b':
+                type = &mp_type_vfs_rom_fileio;
+                break;
+            #endif
+        }
+    }
+
+    vfs_rom_entry_t entry;
+    vfs_rom_lookup(self, path_in, &entry);
+    if (entry.kind == VFS_ROM_KIND_DIR) {
+        mp_raise_OSError(MP_EISDIR);
+    }
+
+    vfs_rom_file_obj_t *o = m_new_obj(vfs_rom_file_obj_t);
+    o->base.type = type;
+    o->vfs = self;
+    o->data = self->image + entry.data_offset;
+    o->size = entry.size;
+    o->stored_size = entry.stored_size;
+    o->pos = 0;
+    o->closed = false;
+    #if MICROPY_VFS_ROM_COMPRESSION
+    o->decomp = NULL;
+    if (entry.compression == VFS_ROM_COMPRESSION_ZLIB) {
+        o->decomp = m_new_obj(TINF_DATA);
+        o->window = NULL;
+        if (!vfs_rom_file_rewind(o)) {
+            mp_raise_OSError(MP_EIO);
+        }
+        return MP_OBJ_FROM_PTR(o);
+    }
+    #endif
+    if (entry.compression != VFS_ROM_COMPRESSION_NONE) {
+        mp_raise_OSError(MP_EOPNOTSUPP);
+    }
+    return MP_OBJ_FROM_PTR(o);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(vfs_rom_open_obj, vfs_rom_open);
+
+STATIC mp_obj_t vfs_rom_chdir(mp_obj_t self_in, mp_obj_t path_in) {
+    mp_obj_vfs_rom_t *self = MP_OBJ_TO_PTR(self_in);
+    vfs_rom_entry_t entry;
+    vfs_rom_lookup(self, path_in, &entry);
+    if (entry.kind != VFS_ROM_KIND_DIR) {
+        mp_raise_OSError(MP_ENOTDIR);
+    }
+    vstr_reset(&self->cwd);
+    vstr_add_strn(&self->cwd, self->path.buf, self->path.len);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(vfs_rom_chdir_obj, vfs_rom_chdir);
+
+STATIC mp_obj_t vfs_rom_getcwd(mp_obj_t self_in) {
+    mp_obj_vfs_rom_t *self = MP_OBJ_TO_PTR(self_in);
+    vstr_t vstr;
+    vstr_init(&vstr, self->cwd.len + 1);
+    vstr_add_char(&vstr, '/');
+    vstr_add_strn(&vstr, self->cwd.buf, self->cwd.len);
+    return mp_obj_new_str_from_vstr(&mp_type_str, &vstr);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(vfs_rom_getcwd_obj, vfs_rom_getcwd);
+
+typedef struct _vfs_rom_ilistdir_it_t {
+    mp_obj_base_t base;
+    mp_fun_1_t iternext;
+    mp_obj_vfs_rom_t *vfs;
+    // The directory's name in the image, or "" for the root
+    const char *dir;
+    size_t dir_len;
+    size_t index;
+    bool is_str;
+} vfs_rom_ilistdir_it_t;
+
+STATIC mp_obj_t vfs_rom_ilistdir_it_iternext(mp_obj_t self_in) {
+    vfs_rom_ilistdir_it_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_vfs_rom_t *vfs = self->vfs;
+
+    while (self->index < vfs->entry_count) {
+        vfs_rom_entry_t entry;
+        vfs_rom_get_entry(vfs, self->index++, &entry);
+        const char *name = (const char*)vfs->image + entry.name_offset;
+        size_t len = entry.name_len;
+        if (self->dir_len > 0) {
+            if (len <= self->dir_len + 1 || name[self->dir_len] != '/' ||
+                memcmp(name, self->dir, self->dir_len) != 0) {
+                continue;
+            }
+            name += self->dir_len + 1;
+            len -= self->dir_len + 1;
+        }
+        if (memchr(name, '/', len) != NULL) {
+            // in a subdirectory
+            continue;
+        }
+
+        // make 4-tuple with info about this entry
+        mp_obj_tuple_t *t = MP_OBJ_TO_PTR(mp_obj_new_tuple(4, NULL));
+        if (self->is_str) {
+            t->items[0] = mp_obj_new_str(name, len);
+        } else {
+            t->items[0] = mp_obj_new_bytes((const byte*)name, len);
+        }
+        t->items[1] = MP_OBJ_NEW_SMALL_INT(entry.kind == VFS_ROM_KIND_DIR ? MP_S_IFDIR : MP_S_IFREG);
+        t->items[2] = MP_OBJ_NEW_SMALL_INT(0); // no inode number
+        t->items[3] = mp_obj_new_int_from_uint(entry.size);
+        return MP_OBJ_FROM_PTR(t);
+    }
+    return MP_OBJ_STOP_ITERATION;
+}
+
+STATIC mp_obj_t vfs_rom_ilistdir(mp_obj_t self_in, mp_obj_t path_in) {
+    mp_obj_vfs_rom_t *self = MP_OBJ_TO_PTR(self_in);
+    vfs_rom_entry_t entry;
+    vfs_rom_lookup(self, path_in, &entry);
+    if (entry.kind != VFS_ROM_KIND_DIR) {
+        mp_raise_OSError(MP_ENOTDIR);
+    }
+    vfs_rom_ilistdir_it_t *iter = m_new_obj(vfs_rom_ilistdir_it_t);
+    iter->base.type = &mp_type_polymorph_iter;
+    iter->iternext = vfs_rom_ilistdir_it_iternext;
+    iter->vfs = self;
+    iter->dir = (const char*)self->image + entry.name_offset;
+    iter->dir_len = entry.name_len;
+    iter->index = 0;
+    iter->is_str = mp_obj_get_type(path_in) == &mp_type_str;
+    return MP_OBJ_FROM_PTR(iter);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(vfs_rom_ilistdir_obj, vfs_rom_ilistdir);
+
+STATIC mp_obj_t vfs_rom_readonly(mp_obj_t self_in, mp_obj_t path_in) {
+    (void)self_in;
+    (void)path_in;
+    mp_raise_OSError(MP_EROFS);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(vfs_rom_readonly_obj, vfs_rom_readonly);
+
+STATIC mp_obj_t vfs_rom_rename(mp_obj_t self_in, mp_obj_t old_path_in, mp_obj_t new_path_in) {
+    (void)new_path_in;
+    return vfs_rom_readonly(self_in, old_path_in);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(vfs_rom_rename_obj, vfs_rom_rename);
+
+STATIC mp_obj_t vfs_rom_stat(mp_obj_t self_in, mp_obj_t path_in) {
+    mp_obj_vfs_rom_t *self = MP_OBJ_TO_PTR(self_in);
+    vfs_rom_entry_t entry;
+    vfs_rom_lookup(self, path_in, &entry);
+    mp_obj_tuple_t *t = MP_OBJ_TO_PTR(mp_obj_new_tuple(10, NULL));
+    for (size_t i = 0; i < 10; i++) {
+        t->items[i] = MP_OBJ_NEW_SMALL_INT(0);
+    }
+    t->items[0] = MP_OBJ_NEW_SMALL_INT(entry.kind == VFS_ROM_KIND_DIR ? MP_S_IFDIR : MP_S_IFREG); // st_mode
+    t->items[6] = mp_obj_new_int_from_uint(entry.size); // st_size
+    return MP_OBJ_FROM_PTR(t);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(vfs_rom_stat_obj, vfs_rom_stat);
+
+STATIC mp_obj_t vfs_rom_statvfs(mp_obj_t self_in, mp_obj_t path_in) {
+    mp_obj_vfs_rom_t *self = MP_OBJ_TO_PTR(self_in);
+    (void)path_in;
+    uint32_t image_size;
+    memcpy(&image_size, self->image + 8, sizeof(image_size));
+    mp_obj_tuple_t *t = MP_OBJ_TO_PTR(mp_obj_new_tuple(10, NULL));
+    t->items[0] = MP_OBJ_NEW_SMALL_INT(1); // f_bsize
+    t->items[1] = t->items[0]; // f_frsize
+    t->items[2] = mp_obj_new_int_from_uint(image_size); // f_blocks
+    t->items[3] = MP_OBJ_NEW_SMALL_INT(0); // f_bfree
+    t->items[4] = t->items[3]; // f_bavail
+    t->items[5] = MP_OBJ_NEW_SMALL_INT(self->entry_count); // f_files
+    t->items[6] = MP_OBJ_NEW_SMALL_INT(0); // f_ffree
+    t->items[7] = MP_OBJ_NEW_SMALL_INT(0); // f_favail
+    t->items[8] = MP_OBJ_NEW_SMALL_INT(1); // f_flags: read-only
+    t->items[9] = MP_OBJ_NEW_SMALL_INT(0xffff); // f_namemax
+    return MP_OBJ_FROM_PTR(t);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(vfs_rom_statvfs_obj, vfs_rom_statvfs);
+
+STATIC const mp_rom_map_elem_t vfs_rom_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_mount), MP_ROM_PTR(&vfs_rom_mount_obj) },
+    { MP_ROM_QSTR(MP_QSTR_umount), MP_ROM_PTR(&vfs_rom_umount_obj) },
+    { MP_ROM_QSTR(MP_QSTR_open), MP_ROM_PTR(&vfs_rom_open_obj) },
+
+    { MP_ROM_QSTR(MP_QSTR_chdir), MP_ROM_PTR(&vfs_rom_chdir_obj) },
+    { MP_ROM_QSTR(MP_QSTR_getcwd), MP_ROM_PTR(&vfs_rom_getcwd_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ilistdir), MP_ROM_PTR(&vfs_rom_ilistdir_obj) },
+    { MP_ROM_QSTR(MP_QSTR_mkdir), MP_ROM_PTR(&vfs_rom_readonly_obj) },
+    { MP_ROM_QSTR(MP_QSTR_remove), MP_ROM_PTR(&vfs_rom_readonly_obj) },
+    { MP_ROM_QSTR(MP_QSTR_rename), MP_ROM_PTR(&vfs_rom_rename_obj) },
+    { MP_ROM_QSTR(MP_QSTR_rmdir), MP_ROM_PTR(&vfs_rom_readonly_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stat), MP_ROM_PTR(&vfs_rom_stat_obj) },
+    { MP_ROM_QSTR(MP_QSTR_statvfs), MP_ROM_PTR(&vfs_rom_statvfs_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(vfs_rom_locals_dict, vfs_rom_locals_dict_table);
+
+STATIC const mp_vfs_proto_t vfs_rom_proto = {
+    MP_PROTO_IMPLEMENT(MP_QSTR_protocol_vfs)
+    .import_stat = vfs_rom_import_stat,
+};
+
+const mp_obj_type_t mp_type_vfs_rom = {
+    { &mp_type_type },
+    .name = MP_QSTR_VfsRom,
+    .make_new = vfs_rom_make_new,
+    .protocol = &vfs_rom_proto,
+    .locals_dict = (mp_obj_dict_t*)&vfs_rom_locals_dict,
+};
+
+STATIC void vfs_rom_file_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    (void)kind;
+    mp_printf(print, "<io.%s %p>", mp_obj_get_type_str(self_in), MP_OBJ_TO_PTR(self_in));
+}
+
+STATIC mp_uint_t vfs_rom_file_read(mp_obj_t self_in, void *buf, mp_uint_t size, int *errcode) {
+    vfs_rom_file_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->closed) {
+        *errcode = MP_EBADF;
+        return MP_STREAM_ERROR;
+    }
+    if (size > self->size - self->pos) {
+        size = self->size - self->pos;
+    }
+    #if MICROPY_VFS_ROM_COMPRESSION
+    if (self->decomp != NULL) {
+        if (!vfs_rom_file_inflate(self, buf, size)) {
+            *errcode = MP_EIO;
+            return MP_STREAM_ERROR;
+        }
+        return size;
+    }
+    #endif
+    memcpy(buf, self->data + self->pos, size);
+    self->pos += size;
+    return size;
+}
+
+STATIC mp_uint_t vfs_rom_file_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg, int *errcode) {
+    vfs_rom_file_obj_t *self = MP_OBJ_TO_PTR(o_in);
+
+    if (request == MP_STREAM_SEEK) {
+        struct mp_stream_seek_t *s = (struct mp_stream_seek_t*)(uintptr_t)arg;
+        mp_off_t offset = s->offset;
+        if (s->whence == 1) { // SEEK_CUR
+            offset += self->pos;
+        } else if (s->whence == 2) { // SEEK_END
+            offset += self->size;
+        }
+        if (self->closed || offset < 0) {
+            *errcode = self->closed ? MP_EBADF : MP_EINVAL;
+            return MP_STREAM_ERROR;
+        }
+        uint32_t pos = self->size;
+        if ((mp_uint_t)offset < pos) {
+            pos = offset;
+        }
+        #if MICROPY_VFS_ROM_COMPRESSION
+        if (self->decomp != NULL) {
+            // Only reading forward works, so start over to go back.
+            if (pos < self->pos && !vfs_rom_file_rewind(self)) {
+                *errcode = MP_EIO;
+                return MP_STREAM_ERROR;
+            }
+            byte skip[64];
+            while (self->pos < pos) {
+                size_t n = MIN(pos - self->pos, sizeof(skip));
+                if (!vfs_rom_file_inflate(self, skip, n)) {
+                    *errcode = MP_EIO;
+                    return MP_STREAM_ERROR;
+                }
+            }
+        }
+        #endif
+        self->pos = pos;
+        s->offset = pos;
+        return 0;
+    } else if (request == MP_STREAM_CLOSE) {
+        self->closed = true;
+        return 0;
+    } else {
+        *errcode = MP_EINVAL;
+        return MP_STREAM_ERROR;
+    }
+}
+
+// Files stored without compression can be used in place, as a memoryview, without reading
+// them into RAM.
+STATIC mp_int_t vfs_rom_file_get_buffer(mp_obj_t self_in, mp_buffer_info_t *bufinfo, mp_uint_t flags) {
+    vfs_rom_file_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->closed || (flags & MP_BUFFER_WRITE) != 0) {
+        return 1;
+    }
+    #if MICROPY_VFS_ROM_COMPRESSION
+    if (self->decomp != NULL) {
+        return 1;
+    }
+    #endif
+    bufinfo->buf = (void*)self->data;
+    bufinfo->len = self->size;
+    bufinfo->typecode = 'B';
+    return 0;
+}
+
+STATIC mp_obj_t vfs_rom_file___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    return mp_stream_close(args[0]);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(vfs_rom_file___exit___obj, 4, 4, vfs_rom_file___exit__);
+
+STATIC const mp_rom_map_elem_t vfs_rom_file_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_read), MP_ROM_PTR(&mp_stream_read_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&mp_stream_readinto_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readline), MP_ROM_PTR(&mp_stream_unbuffered_readline_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readlines), MP_ROM_PTR(&mp_stream_unbuffered_readlines_obj) },
+    { MP_ROM_QSTR(MP_QSTR_close), MP_ROM_PTR(&mp_stream_close_obj) },
+    { MP_ROM_QSTR(MP_QSTR_seek), MP_ROM_PTR(&mp_stream_seek_obj) },
+    { MP_ROM_QSTR(MP_QSTR_tell), MP_ROM_PTR(&mp_stream_tell_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&mp_identity_obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&vfs_rom_file___exit___obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(vfs_rom_file_locals_dict, vfs_rom_file_locals_dict_table);
+
+#if MICROPY_PY_IO_FILEIO
+STATIC const mp_stream_p_t vfs_rom_fileio_stream_p = {
+    MP_PROTO_IMPLEMENT(MP_QSTR_protocol_stream)
+    .read = vfs_rom_file_read,
+    .ioctl = vfs_rom_file_ioctl,
+};
+
+const mp_obj_type_t mp_type_vfs_rom_fileio = {
+    { &mp_type_type },
+    .name = MP_QSTR_FileIO,
+    .print = vfs_rom_file_print,
+    .getiter = mp_identity_getiter,
+    .iternext = mp_stream_unbuffered_iter,
+    .buffer_p = { .get_buffer = vfs_rom_file_get_buffer },
+    .protocol = &vfs_rom_fileio_stream_p,
+    .locals_dict = (mp_obj_dict_t*)&vfs_rom_file_locals_dict,
+};
+#endif
+
+STATIC const mp_stream_p_t vfs_rom_textio_stream_p = {
+    MP_PROTO_IMPLEMENT(MP_QSTR_protocol_stream)
+    .read = vfs_rom_file_read,
+    .ioctl = vfs_rom_file_ioctl,
+    .is_text = true,
+};
+
+const mp_obj_type_t mp_type_vfs_rom_textio = {
+    { &mp_type_type },
+    .name = MP_QSTR_TextIOWrapper,
+    .print = vfs_rom_file_print,
+    .getiter = mp_identity_getiter,
+    .iternext = mp_stream_unbuffered_iter,
+    .buffer_p = { .get_buffer = vfs_rom_file_get_buffer },
+    .protocol = &vfs_rom_textio_stream_p,
+    .locals_dict = (mp_obj_dict_t*)&vfs_rom_file_locals_dict,
+};
+
+#if MICROPY_VFS_ROM_COMPRESSION && !MICROPY_PY_UZLIB
+// uzlib isn't built for the uzlib module, so build the parts needed here.
+#include "../../lib/uzlib/src/tinflate.c"
+#include "../../lib/uzlib/src/tinfzlib.c"
+#include "../../lib/uzlib/src/adler32.c"
+#endif
+
+#endif // MICROPY_VFS && MICROPY_VFS_ROM
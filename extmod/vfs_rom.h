@@ -0,0 +1,67 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_EXTMOD_VFS_ROM_H
+#define MICROPY_INCLUDED_EXTMOD_VFS_ROM_H
+
+#include "py/obj.h"
+
+// A VfsRom image is read in place, so it can live in flash (for example as a frozen bytes
+// object). Everything is little-endian. tools/mkromfs.py builds images.
+//
+// header:  "ROMF", uint16 version, uint16 entry count, uint32 image size, uint32 reserved
+// entries: vfs_rom_entry_t, sorted by hash and then by name
+// then the names and the file data. Stored file data starts on a 4 byte boundary.
+#define VFS_ROM_MAGIC "ROMF"
+#define VFS_ROM_VERSION (1)
+#define VFS_ROM_HEADER_SIZE (16)
+
+#define VFS_ROM_KIND_FILE (1)
+#define VFS_ROM_KIND_DIR (2)
+
+#define VFS_ROM_COMPRESSION_NONE (0)
+// A zlib stream. Its header gives the window size needed to read it.
+#define VFS_ROM_COMPRESSION_ZLIB (1)
+
+typedef struct _vfs_rom_entry_t {
+    // FNV-1a of the path within the image, which has no leading or trailing /
+    uint32_t hash;
+    uint32_t name_offset;
+    uint32_t data_offset;
+    // Size of the file once it's read
+    uint32_t size;
+    // Bytes of the file in the image
+    uint32_t stored_size;
+    uint16_t name_len;
+    uint8_t kind;
+    uint8_t compression;
+} vfs_rom_entry_t;
+
+extern const mp_obj_type_t mp_type_vfs_rom;
+extern const mp_obj_type_t mp_type_vfs_rom_fileio;
+extern const mp_obj_type_t mp_type_vfs_rom_textio;
+
+#endif // MICROPY_INCLUDED_EXTMOD_VFS_ROM_H
@@ -838,6 +838,89 @@ void clear_lock (   /* Clear lock entries of the volume */
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Sector cache behind the disk access window                            */
+/*-----------------------------------------------------------------------*/
+#if _FS_WINCACHE
+static
+void wcache_clear (
+    FATFS* fs           /* File system object */
+)
+{
+    UINT i;
+
+
+    for (i = 0; i < _FS_WINCACHE; i++) {
+        fs->wcsect[i] = 0xFFFFFFFF;
+        fs->wcused[i] = 0;
+    }
+    fs->wcclock = 0;
+    fs->wcskip = 0;
+}
+
+
+#if !_FS_READONLY
+static
+void wcache_drop (      /* Forget sectors written to the disk bypassing the cache */
+    FATFS* fs,          /* File system object */
+    DWORD sect,         /* First sector written */
+    UINT count          /* Number of sectors written */
+)
+{
+    UINT i;
+
+
+    for (i = 0; i < _FS_WINCACHE; i++) {
+        if (fs->wcsect[i] - sect < count) {
+            fs->wcsect[i] = 0xFFFFFFFF;
+            fs->wcused[i] = 0;
+        }
+    }
+}
+#endif
+
+
+static
+int wcache_load (       /* 1:sector was loaded into win[] from the cache, 0:not cached */
+    FATFS* fs,          /* File system object with clean win[] */
+    DWORD sector        /* Sector number to load */
+)
+{
+    UINT i, n, lru = 0;
+    BYTE *p, b;
+    int keep = fs->winsect != 0xFFFFFFFF && !fs->wcskip;    /* Keep the sector in win[]? */
+
+
+    fs->wcskip = 0;
+    for (i = 0; i < _FS_WINCACHE && fs->wcsect[i] != sector; i++) {
+        if (fs->wcused[i] < fs->wcused[lru]) lru = i;
+    }
+    if (i < _FS_WINCACHE) {     /* Hit: exchange win[] with the entry */
+        p = fs->wcache[i];
+        if (keep) {
+            for (n = 0; n < SS(fs); n++) {
+                b = p[n]; p[n] = fs->win[n]; fs->win[n] = b;
+            }
+            fs->wcsect[i] = fs->winsect;
+            fs->wcused[i] = ++fs->wcclock;
+        } else {
+            mem_cpy(fs->win, p, SS(fs));
+            fs->wcsect[i] = 0xFFFFFFFF;
+            fs->wcused[i] = 0;
+        }
+        return 1;
+    }
+    if (keep) {                 /* Miss: keep win[] in place of the least recently used entry */
+        mem_cpy(fs->wcache[lru], fs->win, SS(fs));
+        fs->wcsect[lru] = fs->winsect;
+        fs->wcused[lru] = ++fs->wcclock;
+    }
+    return 0;
+}
+#endif
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Move/Flush disk access window in the file system object               */
 /*-----------------------------------------------------------------------*/
@@ -858,6 +941,9 @@ FRESULT sync_window (   /* Returns FR_OK or FR_DISK_ERROR */
             res = FR_DISK_ERR;
         } else {
             fs->wflag = 0;
+#if _FS_WINCACHE
+            wcache_drop(fs, wsect, 1);
+#endif
             if (wsect - fs->fatbase < fs->fsize) {      /* Is it in the FAT area? */
                 for (nf = fs->n_fats; nf >= 2; nf--) {  /* Reflect the change to all FAT copies */
                     wsect += fs->fsize;
@@ -885,6 +971,12 @@ FRESULT move_window (   /* Returns FR_OK or FR_DISK_ERROR */
         res = sync_window(fs);      /* Write-back changes */
 #endif
         if (res == FR_OK) {         /* Fill sector window with new data */
+#if _FS_WINCACHE
+            if (wcache_load(fs, sector)) {
+                fs->winsect = sector;
+                return FR_OK;
+            }
+#endif
             if (disk_read(fs->drv, fs->win, sector, 1) != RES_OK) {
                 sector = 0xFFFFFFFF;    /* Invalidate window if data is not reliable */
                 res = FR_DISK_ERR;
@@ -925,6 +1017,9 @@ FRESULT sync_fs (   /* FR_OK:succeeded, !=0:error */
             /* Write it into the FSInfo sector */
             fs->winsect = fs->volbase + 1;
             disk_write(fs->drv, fs->win, fs->winsect, 1);
+#if _FS_WINCACHE
+            wcache_drop(fs, fs->winsect, 1);
+#endif
             fs->fsi_flag = 0;
         }
         /* Make sure that no pending write process in the physical drive */
@@ -2834,6 +2929,9 @@ BYTE check_fs ( /* 0:FAT, 1:exFAT, 2:Valid BS but not FAT, 3:Not a BS, 4:Disk er
 )
 {
     fs->wflag = 0; fs->winsect = 0xFFFFFFFF;        /* Invaidate window */
+#if _FS_WINCACHE
+    wcache_clear(fs);
+#endif
     if (move_window(fs, sect) != FR_OK) return 4;   /* Load boot record */
 
     if (ld_word(fs->win + BS_55AA) != 0xAA55) return 3; /* Check boot record signature (always placed at offset 510 even if the sector size is >512) */
@@ -3422,6 +3520,9 @@ FRESULT f_read (
         if (rcnt > btr) rcnt = btr;                 /* Clip it by btr if needed */
 #if _FS_TINY
         if (move_window(fs, fp->sect) != FR_OK) ABORT(fs, FR_DISK_ERR); /* Move sector window */
+#if _FS_WINCACHE
+        fs->wcskip = 1;         /* File data is not kept in the cache */
+#endif
         mem_cpy(rbuff, fs->win + fp->fptr % SS(fs), rcnt);  /* Extract partial sector */
 #else
         mem_cpy(rbuff, fp->buf + fp->fptr % SS(fs), rcnt);  /* Extract partial sector */
@@ -3506,6 +3607,9 @@ FRESULT f_write (
                     cc = fs->csize - csect;
                 }
                 if (disk_write(fs->drv, wbuff, sect, cc) != RES_OK) ABORT(fs, FR_DISK_ERR);
+#if _FS_WINCACHE
+                wcache_drop(fs, sect, cc);
+#endif
 #if _FS_MINIMIZE <= 2
 #if _FS_TINY
                 if (fs->winsect - sect < cc) {  /* Refill sector cache if it gets invalidated by the direct write */
@@ -3526,6 +3630,9 @@ FRESULT f_write (
             if (fp->fptr >= fp->obj.objsize) {  /* Avoid silly cache filling on the growing edge */
                 if (sync_window(fs) != FR_OK) ABORT(fs, FR_DISK_ERR);
                 fs->winsect = sect;
+#if _FS_WINCACHE
+                fs->wcskip = 1;
+#endif
             }
 #else
             if (fp->sect != sect &&         /* Fill sector cache with file data */
@@ -3540,6 +3647,9 @@ FRESULT f_write (
         if (wcnt > btw) wcnt = btw;                 /* Clip it by btw if needed */
 #if _FS_TINY
         if (move_window(fs, fp->sect) != FR_OK) ABORT(fs, FR_DISK_ERR); /* Move sector window */
+#if _FS_WINCACHE
+        fs->wcskip = 1;         /* File data is not kept in the cache */
+#endif
         mem_cpy(fs->win + fp->fptr % SS(fs), wbuff, wcnt);  /* Fit data to the sector */
         fs->wflag = 1;
 #else
@@ -4470,6 +4580,9 @@ FRESULT f_mkdir (
                     if (res != FR_OK) break;
                     mem_set(dir, 0, SS(fs));
                 }
+#if _FS_WINCACHE
+                fs->wcskip = 1;     /* win[] was cleared after the last sector was written */
+#endif
             }
             if (res == FR_OK) res = dir_register(&dj);  /* Register the object to the directoy */
             if (res == FR_OK) {
@@ -5049,6 +5162,9 @@ FRESULT f_forward (
         sect += csect;
 #if _FS_TINY
         if (move_window(fs, sect) != FR_OK) ABORT(fs, FR_DISK_ERR); /* Move sector window to the file data */
+#if _FS_WINCACHE
+        fs->wcskip = 1;         /* File data is not kept in the cache */
+#endif
         dbuf = fs->win;
 #else
         if (fp->sect != sect) {     /* Fill sector cache with file data */
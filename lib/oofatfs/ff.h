@@ -148,6 +148,13 @@ typedef struct {
     DWORD   database;       /* Data base sector */
     DWORD   winsect;        /* Current sector appearing in the win[] */
     BYTE    win[_MAX_SS];   /* Disk access window for Directory, FAT (and file data at tiny cfg) */
+#if _FS_WINCACHE
+    BYTE    wcskip;         /* win[] holds file data that is not kept in wcache[] */
+    DWORD   wcclock;        /* Last use stamp given out */
+    DWORD   wcsect[_FS_WINCACHE];   /* Sector held in each wcache[] entry (0xFFFFFFFF:Empty) */
+    DWORD   wcused[_FS_WINCACHE];   /* Last use stamp of each wcache[] entry (0:Empty) */
+    BYTE    wcache[_FS_WINCACHE][_MAX_SS];  /* Clean sectors recently held in win[] */
+#endif
 } FATFS;
 
 
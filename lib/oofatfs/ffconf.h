@@ -268,6 +268,19 @@
 /  buffer in the file system object (FATFS) is used for the file data transfer. */
 
 
+#ifdef MICROPY_FATFS_WINCACHE
+#define _FS_WINCACHE    (MICROPY_FATFS_WINCACHE)
+#else
+#define _FS_WINCACHE    0
+#endif
+/* This option sets the number of extra sectors kept in the file system object
+/  (FATFS) besides win[]. When the window moves, the clean sector it held is kept
+/  and the least recently used one is dropped, so that FAT and directory sectors
+/  walked repeatedly are not read again from the disk. Each one costs _MAX_SS bytes.
+/  File data loaded into win[] at tiny configuration is not kept.
+/  0:Disable or 1-255:Number of sectors */
+
+
 #ifdef MICROPY_FATFS_EXFAT
 #define _FS_EXFAT   (MICROPY_FATFS_EXFAT)
 #else
@@ -92,26 +92,39 @@ STATIC int parse_compile_execute(const void *source, mp_parse_input_kind_t input
             if (input_kind == MP_PARSE_FILE_INPUT) {
                 mp_store_global(MP_QSTR___file__, MP_OBJ_NEW_QSTR(source_name));
             }
-            mp_parse_tree_t parse_tree = mp_parse(lex, input_kind);
-            module_fun = mp_compile(&parse_tree, source_name, MP_EMIT_OPT_NONE, exec_flags & EXEC_FLAG_IS_REPL);
-            // Clear the parse tree because it has a heap pointer we don't need anymore.
-            *((uint32_t volatile*) &parse_tree.chunk) = 0;
+            #if MICROPY_COMPILE_BY_STATEMENT
+            if (input_kind == MP_PARSE_FILE_INPUT) {
+                // Each statement runs as soon as it's compiled so there's no module function.
+                module_fun = MP_OBJ_NULL;
+                mp_hal_set_interrupt_char(CHAR_CTRL_C); // allow ctrl-C to interrupt us
+                start = mp_hal_ticks_ms();
+                mp_parse_compile_execute_by_statement(lex, mp_globals_get());
+            } else
+            #endif
+            {
+                mp_parse_tree_t parse_tree = mp_parse(lex, input_kind);
+                module_fun = mp_compile(&parse_tree, source_name, MP_EMIT_OPT_NONE, exec_flags & EXEC_FLAG_IS_REPL);
+                // Clear the parse tree because it has a heap pointer we don't need anymore.
+                *((uint32_t volatile*) &parse_tree.chunk) = 0;
+            }
             #else
             mp_raise_msg(&mp_type_RuntimeError, translate("script compilation not supported"));
             #endif
         }
 
-        // If the code was loaded from a file its likely to be running for a while so we'll long
-        // live it and collect any garbage before running.
-        if (input_kind == MP_PARSE_FILE_INPUT) {
-            module_fun = make_obj_long_lived(module_fun, 6);
-            gc_collect();
-        }
+        if (module_fun != MP_OBJ_NULL) {
+            // If the code was loaded from a file its likely to be running for a while so we'll long
+            // live it and collect any garbage before running.
+            if (input_kind == MP_PARSE_FILE_INPUT) {
+                module_fun = make_obj_long_lived(module_fun, 6);
+                gc_collect();
+            }
 
-        // execute code
-        mp_hal_set_interrupt_char(CHAR_CTRL_C); // allow ctrl-C to interrupt us
-        start = mp_hal_ticks_ms();
-        mp_call_function_0(module_fun);
+            // execute code
+            mp_hal_set_interrupt_char(CHAR_CTRL_C); // allow ctrl-C to interrupt us
+            start = mp_hal_ticks_ms();
+            mp_call_function_0(module_fun);
+        }
         mp_hal_set_interrupt_char(-1); // disable interrupt
         nlr_pop();
         ret = 0;
@@ -38,6 +38,7 @@
 #include "py/runtime.h"
 #include "py/repl.h"
 #include "py/gc.h"
+#include "py/reload.h"
 #include "py/stackctrl.h"
 
 #include "lib/mp-readline/readline.h"
@@ -54,9 +55,18 @@
 #include "supervisor/shared/rgb_led_status.h"
 #include "supervisor/shared/safe_mode.h"
 #include "supervisor/shared/status_leds.h"
+#include "supervisor/shared/tick.h"
 #include "supervisor/shared/stack.h"
 #include "supervisor/serial.h"
 
+#if CIRCUITPY_AUDIOCORE
+#include "shared-module/audiocore/WaveFile.h"
+#endif
+
+#if CIRCUITPY_AUDIOMP3
+#include "shared-module/audiomp3/MP3Decoder.h"
+#endif
+
 #if CIRCUITPY_DISPLAYIO
 #include "shared-module/displayio/__init__.h"
 #endif
@@ -74,6 +84,34 @@
 #include "supervisor/shared/bluetooth.h"
 #endif
 
+#if CIRCUITPY_PROFILER
+#include "supervisor/shared/profiler.h"
+#endif
+
+#if CIRCUITPY_UHEAP
+#include "shared-bindings/uheap/__init__.h"
+#endif
+
+#if CIRCUITPY_HEAP_IMAGE
+#include "supervisor/shared/heap_image.h"
+#endif
+
+#if CIRCUITPY_BACKGROUND_TRACE
+#include "supervisor/shared/background_trace.h"
+#endif
+
+#if CIRCUITPY_BOOT_TIMING
+#include "supervisor/shared/boot_timing.h"
+#endif
+
+#if CIRCUITPY_USB_AUDIO
+#include "shared-module/usb_audio/__init__.h"
+#endif
+
+#if CIRCUITPY_USB_CDC
+#include "shared-module/usb_cdc/__init__.h"
+#endif
+
 void do_str(const char *src, mp_parse_input_kind_t input_kind) {
     mp_lexer_t *lex = mp_lexer_new_from_str_len(MP_QSTR__lt_stdin_gt_, src, strlen(src), 0);
     if (lex == NULL) {
@@ -94,7 +132,7 @@ void do_str(const char *src, mp_parse_input_kind_t input_kind) {
     }
 }
 
-void start_mp(supervisor_allocation* heap) {
+void start_mp(supervisor_allocation* heap, bool use_heap_image) {
     reset_status_led();
     autoreload_stop();
 
@@ -105,12 +143,6 @@ void start_mp(supervisor_allocation* heap) {
     mp_stack_ctrl_init();
     mp_stack_set_limit(stack_alloc->length - 1024);
 
-#if MICROPY_MAX_STACK_USAGE
-    // _ezero (same as _ebss) is an int, so start 4 bytes above it.
-    mp_stack_set_bottom(stack_alloc->ptr);
-    mp_stack_fill_with_sentinel();
-#endif
-
     // Sync the file systems in case any used RAM from the GC to cache. As soon
     // as we re-init the GC all bets are off on the cache.
     filesystem_flush();
@@ -121,7 +153,29 @@ void start_mp(supervisor_allocation* heap) {
     #if MICROPY_ENABLE_GC
     gc_init(heap->ptr, heap->ptr + heap->length / 4);
     #endif
+
+    #if CIRCUITPY_HEAP_IMAGE
+    // Picks up the modules code.py imported on a previous run.
+    bool heap_image_loaded = use_heap_image && heap_image_load();
+    #else
+    (void)use_heap_image;
+    #endif
+
+    #if MICROPY_ENABLE_PYSTACK
+    static size_t PLACE_IN_DTCM_BSS(pystack)[CIRCUITPY_PYSTACK_SIZE / sizeof(size_t)];
+    mp_pystack_init(pystack, pystack + MP_ARRAY_SIZE(pystack));
+    #endif
+
+    #if MICROPY_MAX_STACK_USAGE
+    stack_paint();
+    #endif
+
     mp_init();
+    #if CIRCUITPY_HEAP_IMAGE
+    if (heap_image_loaded) {
+        heap_image_finish_load();
+    }
+    #endif
     mp_obj_list_init(mp_sys_path, 0);
     mp_obj_list_append(mp_sys_path, MP_OBJ_NEW_QSTR(MP_QSTR_)); // current dir (or base dir of the script)
     mp_obj_list_append(mp_sys_path, MP_OBJ_NEW_QSTR(MP_QSTR__slash_));
@@ -180,6 +234,10 @@ bool maybe_run_list(const char ** filenames, pyexec_result_t* exec_result) {
     char decompressed[compressed->length];
     decompress(compressed, decompressed);
     mp_hal_stdout_tx_str(decompressed);
+    #if MICROPY_RELOAD_MODULES
+    // Changes to the main file always restart the VM.
+    mp_reload_track_file(MP_OBJ_NULL, filename);
+    #endif
     pyexec_file(filename, exec_result);
     return true;
 }
@@ -189,7 +247,49 @@ void cleanup_after_vm(supervisor_allocation* heap) {
     #if CIRCUITPY_DISPLAYIO
     reset_displays();
     #endif
+    #if CIRCUITPY_AUDIOCORE
+    audioio_wavefile_reset();
+    #endif
+    #if CIRCUITPY_AUDIOMP3
+    audiomp3_mp3file_reset();
+    #endif
+    #if CIRCUITPY_PROFILER
+    supervisor_profiler_reset();
+    #endif
+    #if CIRCUITPY_UHEAP
+    shared_module_uheap_profiler_reset();
+    #endif
+    #if CIRCUITPY_HEAP_IMAGE
+    heap_image_reset();
+    #endif
+    #if CIRCUITPY_USB_AUDIO
+    usb_audio_reset();
+    #endif
+    #if CIRCUITPY_USB_CDC
+    usb_cdc_reset();
+    #endif
+    #if CIRCUITPY_BUSIO
+    // The buffers of SPI background transfers go away with the heap. The
+    // transfers themselves are stopped when the SERCOMs or SPIMs are reset.
+    MP_STATE_VM(busio_spi_transfers) = MP_OBJ_NULL;
+    #endif
+    #if CIRCUITPY_ANALOGIO
+    // Likewise for AnalogIn, whose sampling stops when the DMA channels are
+    // reset.
+    MP_STATE_VM(analogio_analogin_readings) = MP_OBJ_NULL;
+    #endif
+    #if CIRCUITPY_NEOPIXEL_WRITE
+    // And for background neopixel writes, stopped by reset_port().
+    MP_STATE_VM(neopixel_write_buffer) = NULL;
+    #endif
+    #if CIRCUITPY_I2CSLAVE
+    // The same goes for the registers of I2CSlaves, whose transfers stop when
+    // the SERCOMs are reset.
+    MP_STATE_VM(i2cslave_register_slaves) = NULL;
+    #endif
     filesystem_flush();
+    // The REPL and error messages must not lose output.
+    serial_set_write_blocking(true);
     stop_mp();
     free_memory(heap);
     supervisor_move_memory();
@@ -237,7 +337,10 @@ bool run_code_py(safe_mode_t safe_mode) {
         stack_resize();
         filesystem_flush();
         supervisor_allocation* heap = allocate_remaining_memory();
-        start_mp(heap);
+        start_mp(heap, true);
+        #if CIRCUITPY_BOOT_TIMING
+        boot_timing_mark(BOOT_PHASE_CODE_PY);
+        #endif
         found_main = maybe_run_list(supported_filenames, &result);
         if (!found_main){
             found_main = maybe_run_list(double_extension_filenames, &result);
@@ -288,6 +391,16 @@ bool run_code_py(safe_mode_t safe_mode) {
                 }
             }
             print_safe_mode_message(safe_mode);
+            #if CIRCUITPY_BACKGROUND_TRACE
+            if (safe_mode != NO_SAFE_MODE) {
+                background_trace_print_worst();
+            }
+            #endif
+            #if MICROPY_MAX_STACK_USAGE
+            if (safe_mode != NO_SAFE_MODE) {
+                print_safe_mode_stack_usage();
+            }
+            #endif
             serial_write("\n");
             serial_write_compressed(translate("Press any key to enter the REPL. Use CTRL-D to reload."));
         }
@@ -304,6 +417,7 @@ bool run_code_py(safe_mode_t safe_mode) {
         #endif
 
         tick_rgb_status_animation(&animation);
+        supervisor_idle();
     }
 }
 
@@ -367,7 +481,7 @@ void __attribute__ ((noinline)) run_boot_py(safe_mode_t safe_mode) {
         // TODO(tannewt): Allocate temporary space to hold custom usb descriptors.
         filesystem_flush();
         supervisor_allocation* heap = allocate_remaining_memory();
-        start_mp(heap);
+        start_mp(heap, false);
 
         // TODO(tannewt): Re-add support for flashing boot error output.
         bool found_boot = maybe_run_list(boot_py_filenames, NULL);
@@ -390,7 +504,7 @@ int run_repl(void) {
     stack_resize();
     filesystem_flush();
     supervisor_allocation* heap = allocate_remaining_memory();
-    start_mp(heap);
+    start_mp(heap, false);
     autoreload_suspend();
     new_status_color(REPL_RUNNING);
     if (pyexec_mode_kind == PYEXEC_MODE_RAW_REPL) {
@@ -408,6 +522,9 @@ int __attribute__((used)) main(void) {
 
     // initialise the cpu and peripherals
     safe_mode_t safe_mode = port_init();
+    #if CIRCUITPY_BOOT_TIMING
+    boot_timing_mark(BOOT_PHASE_PORT_INIT);
+    #endif
 
     // Turn on LEDs
     init_status_leds();
@@ -420,6 +537,12 @@ int __attribute__((used)) main(void) {
 
     stack_init();
 
+    #if CIRCUITPY_FAST_BOOT
+    // Start USB now so that the host enumerates it while the filesystem mounts.
+    // MSC reports no medium until the mount is done.
+    serial_init();
+    #endif
+
     // Create a new filesystem only if we're not in a safe mode.
     // A power brownout here could make it appear as if there's
     // no SPI flash filesystem, and we might erase the existing one.
@@ -438,9 +561,14 @@ int __attribute__((used)) main(void) {
     filesystem_set_internal_writable_by_usb(true);
 
     run_boot_py(safe_mode);
+    #if CIRCUITPY_BOOT_TIMING
+    boot_timing_mark(BOOT_PHASE_BOOT_PY);
+    #endif
 
+    #if !CIRCUITPY_FAST_BOOT
     // Start serial and HID after giving boot.py a chance to tweak behavior.
     serial_init();
+    #endif
 
     #if CIRCUITPY_BLEIO
     supervisor_start_bluetooth();
@@ -474,13 +602,14 @@ void gc_collect(void) {
     mp_uint_t regs[10];
     mp_uint_t sp = cpu_get_regs_and_sp(regs);
 
-    // This collects root pointers from the VFS mount table. Some of them may
-    // have lost their references in the VM even though they are mounted.
-    gc_collect_root((void**)&MP_STATE_VM(vfs_mount_table), sizeof(mp_vfs_mount_t) / sizeof(mp_uint_t));
-
-    #if CIRCUITPY_DISPLAYIO
-    displayio_gc_collect();
-    #endif
+    // The first mount is static so the GC won't follow it to the rest.
+    // Mounts may have lost their references in the VM even though they are
+    // mounted, so mark each one and what it holds.
+    for (mp_vfs_mount_t *vfs = MP_STATE_VM(vfs_mount_table); vfs != NULL; vfs = vfs->next) {
+        gc_collect_ptr(vfs);
+        gc_collect_ptr((void*)vfs->str);
+        gc_collect_ptr(vfs->obj);
+    }
 
     #if CIRCUITPY_BLEIO
     common_hal_bleio_gc_collect();
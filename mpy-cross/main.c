@@ -109,6 +109,8 @@ STATIC int usage(char **argv) {
 "-msmall-int-bits=number : set the maximum bits used to encode a small-int\n"
 "-mno-unicode : don't support unicode in compiled strings\n"
 "-mcache-lookup-bc : cache map lookups in the bytecode\n"
+"-msuperinstructions : fuse common bytecode sequences (target must enable them)\n"
+"-min-place : save qstrs so the target can run the bytecode from flash\n"
 "\n"
 "Implementation specific options:\n", argv[0]
 );
@@ -192,7 +194,9 @@ MP_NOINLINE int main_(int argc, char **argv) {
     // set default compiler configuration
     mp_dynamic_compiler.small_int_bits = 31;
     mp_dynamic_compiler.opt_cache_map_lookup_in_bytecode = 0;
+    mp_dynamic_compiler.opt_bytecode_superinstructions = 0;
     mp_dynamic_compiler.py_builtins_str_unicode = 1;
+    mp_dynamic_compiler.mpy_in_place = 0;
 
     const char *input_file = NULL;
     const char *output_file = NULL;
@@ -236,6 +240,14 @@ MP_NOINLINE int main_(int argc, char **argv) {
                 mp_dynamic_compiler.opt_cache_map_lookup_in_bytecode = 0;
             } else if (strcmp(argv[a], "-mcache-lookup-bc") == 0) {
                 mp_dynamic_compiler.opt_cache_map_lookup_in_bytecode = 1;
+            } else if (strcmp(argv[a], "-mno-superinstructions") == 0) {
+                mp_dynamic_compiler.opt_bytecode_superinstructions = 0;
+            } else if (strcmp(argv[a], "-msuperinstructions") == 0) {
+                mp_dynamic_compiler.opt_bytecode_superinstructions = 1;
+            } else if (strcmp(argv[a], "-mno-in-place") == 0) {
+                mp_dynamic_compiler.mpy_in_place = 0;
+            } else if (strcmp(argv[a], "-min-place") == 0) {
+                mp_dynamic_compiler.mpy_in_place = 1;
             } else if (strcmp(argv[a], "-mno-unicode") == 0) {
                 mp_dynamic_compiler.py_builtins_str_unicode = 0;
             } else if (strcmp(argv[a], "-municode") == 0) {
@@ -40,6 +40,7 @@
 
 #define MICROPY_DYNAMIC_COMPILER    (1)
 #define MICROPY_COMP_CONST_FOLDING  (1)
+#define MICROPY_COMP_CONST_FLOAT    (1)
 #define MICROPY_COMP_MODULE_CONST   (1)
 #define MICROPY_COMP_CONST          (1)
 #define MICROPY_COMP_DOUBLE_TUPLE_ASSIGN (1)
@@ -60,6 +61,8 @@
 #define MICROPY_WARNINGS            (1)
 
 #define MICROPY_FLOAT_IMPL          (MICROPY_FLOAT_IMPL_DOUBLE)
+// parse and save float constants exactly, so folded floats survive the .mpy
+#define MICROPY_FLOAT_FORMAT_SHORTEST (1)
 #define MICROPY_CPYTHON_COMPAT      (1)
 #define MICROPY_USE_INTERNAL_PRINTF (0)
 
@@ -74,54 +74,13 @@ void audio_dma_enable_channel(uint8_t channel) {
     dma_enable_channel(channel);
 }
 
-void audio_dma_convert_signed(audio_dma_t* dma, uint8_t* buffer, uint32_t buffer_length,
-                              uint8_t** output_buffer, uint32_t* output_buffer_length,
-                              uint8_t* output_spacing) {
-    if (dma->first_buffer_free) {
-        *output_buffer = dma->first_buffer;
-    } else {
-        *output_buffer = dma->second_buffer;
-    }
-    #pragma GCC diagnostic push
-    #pragma GCC diagnostic ignored "-Wcast-align"
-    if (dma->signed_to_unsigned || dma->unsigned_to_signed) {
-        *output_buffer_length = buffer_length / dma->spacing;
-        *output_spacing = 1;
-        uint32_t out_i = 0;
-        if (dma->bytes_per_sample == 1) {
-            for (uint32_t i = 0; i < buffer_length; i += dma->spacing) {
-                if (dma->signed_to_unsigned) {
-                    ((uint8_t*) *output_buffer)[out_i] = ((int8_t*) buffer)[i] + 0x80;
-                } else {
-                    ((int8_t*) *output_buffer)[out_i] = ((uint8_t*) buffer)[i] - 0x80;
-                }
-                out_i += 1;
-            }
-        } else if (dma->bytes_per_sample == 2) {
-            for (uint32_t i = 0; i < buffer_length / 2; i += dma->spacing) {
-                if (dma->signed_to_unsigned) {
-                    ((uint16_t*) *output_buffer)[out_i] = ((int16_t*) buffer)[i] + 0x8000;
-                } else {
-                    ((int16_t*) *output_buffer)[out_i] = ((uint16_t*) buffer)[i] - 0x8000;
-                }
-                out_i += 1;
-            }
-        }
-    } else {
-        *output_buffer = buffer;
-        *output_buffer_length = buffer_length;
-        *output_spacing = dma->spacing;
-    }
-    #pragma GCC diagnostic pop
-    dma->first_buffer_free = !dma->first_buffer_free;
-}
-
 void audio_dma_load_next_block(audio_dma_t* dma) {
-    uint8_t* buffer;
-    uint32_t buffer_length;
+    uint8_t* output_buffer;
+    uint32_t output_buffer_length;
+    uint8_t output_spacing;
     audioio_get_buffer_result_t get_buffer_result =
-        audiosample_get_buffer(dma->sample, dma->single_channel, dma->audio_channel,
-                               &buffer, &buffer_length);
+        audioio_playback_load_block(&dma->playback, &output_buffer, &output_buffer_length,
+                                    &output_spacing);
 
     DmacDescriptor* descriptor = dma->second_descriptor;
     if (dma->first_descriptor_free) {
@@ -134,20 +93,12 @@ void audio_dma_load_next_block(audio_dma_t* dma) {
         return;
     }
 
-    uint8_t* output_buffer;
-    uint32_t output_buffer_length;
-    uint8_t output_spacing;
-    audio_dma_convert_signed(dma, buffer, buffer_length, &output_buffer, &output_buffer_length,
-        &output_spacing);
-
-    descriptor->BTCNT.reg = output_buffer_length / dma->beat_size / output_spacing;
+    // Each beat is one frame because stereo frames are transferred in one beat.
+    descriptor->BTCNT.reg = audioio_playback_block_frames(&dma->playback, output_buffer_length,
+                                                          output_spacing);
     descriptor->SRCADDR.reg = ((uint32_t) output_buffer) + output_buffer_length;
     if (get_buffer_result == GET_BUFFER_DONE) {
-        if (dma->loop) {
-            audiosample_reset_buffer(dma->sample, dma->single_channel, dma->audio_channel);
-        } else {
-            descriptor->DESCADDR.reg = 0;
-        }
+        descriptor->DESCADDR.reg = 0;
     }
     descriptor->BTCTRL.bit.VALID = true;
 }
@@ -182,40 +133,17 @@ audio_dma_result audio_dma_setup_playback(audio_dma_t* dma,
         return AUDIO_DMA_DMA_BUSY;
     }
 
-    dma->sample = sample;
-    dma->loop = loop;
-    dma->single_channel = single_channel;
-    dma->audio_channel = audio_channel;
     dma->dma_channel = dma_channel;
-    dma->signed_to_unsigned = false;
-    dma->unsigned_to_signed = false;
     dma->second_descriptor = NULL;
-    dma->spacing = 1;
     dma->first_descriptor_free = true;
-    audiosample_reset_buffer(sample, single_channel, audio_channel);
-
-    bool single_buffer;
-    bool samples_signed;
-    uint32_t max_buffer_length;
-    audiosample_get_buffer_structure(sample, single_channel, &single_buffer, &samples_signed,
-                                     &max_buffer_length, &dma->spacing);
-    uint8_t output_spacing = dma->spacing;
-    if (output_signed != samples_signed) {
+    if (!audioio_playback_setup(&dma->playback, sample, loop, single_channel, audio_channel,
+                                output_signed)) {
+        return AUDIO_DMA_MEMORY_ERROR;
+    }
+    bool single_buffer = dma->playback.single_buffer;
+    uint8_t output_spacing = dma->playback.spacing;
+    if (dma->playback.first_buffer != NULL) {
         output_spacing = 1;
-        max_buffer_length /= dma->spacing;
-        dma->first_buffer = (uint8_t*) m_malloc(max_buffer_length, false);
-        if (dma->first_buffer == NULL) {
-            return AUDIO_DMA_MEMORY_ERROR;
-        }
-        dma->first_buffer_free = true;
-        if (!single_buffer) {
-            dma->second_buffer = (uint8_t*) m_malloc(max_buffer_length, false);
-            if (dma->second_buffer == NULL) {
-                return AUDIO_DMA_MEMORY_ERROR;
-            }
-        }
-        dma->signed_to_unsigned = !output_signed && samples_signed;
-        dma->unsigned_to_signed = output_signed && !samples_signed;
     }
 
     dma->event_channel = 0xff;
@@ -237,43 +165,41 @@ audio_dma_result audio_dma_setup_playback(audio_dma_t* dma,
         // We keep the audio_dma_t for internal use and the sample as a root pointer because it
         // contains the audiodma structure.
         audio_dma_state[dma->dma_channel] = dma;
-        MP_STATE_PORT(playing_audio)[dma->dma_channel] = dma->sample;
+        MP_STATE_PORT(playing_audio)[dma->dma_channel] = sample;
     }
 
 
-    if (audiosample_bits_per_sample(sample) == 16) {
-        dma->beat_size = 2;
-        dma->bytes_per_sample = 2;
-    } else {
-        dma->beat_size = 1;
-        dma->bytes_per_sample = 1;
-        if (single_channel) {
-            output_register_address += 1;
-        }
+    uint8_t beat_size = dma->playback.bytes_per_sample;
+    if (beat_size == 1 && single_channel) {
+        output_register_address += 1;
     }
     // Transfer both channels at once.
     if (!single_channel && audiosample_channel_count(sample) == 2) {
-        dma->beat_size *= 2;
+        beat_size *= 2;
     }
 
     DmacDescriptor* first_descriptor = dma_descriptor(dma_channel);
-    setup_audio_descriptor(first_descriptor, dma->beat_size, output_spacing, output_register_address);
+    setup_audio_descriptor(first_descriptor, beat_size, output_spacing, output_register_address);
     if (single_buffer) {
         first_descriptor->DESCADDR.reg = 0;
-        if (dma->loop) {
+        if (loop) {
             first_descriptor->DESCADDR.reg = (uint32_t) first_descriptor;
         }
     } else {
         first_descriptor->DESCADDR.reg = (uint32_t) dma->second_descriptor;
-        setup_audio_descriptor(dma->second_descriptor, dma->beat_size, output_spacing, output_register_address);
+        setup_audio_descriptor(dma->second_descriptor, beat_size, output_spacing, output_register_address);
         dma->second_descriptor->DESCADDR.reg = (uint32_t) first_descriptor;
     }
 
     // Load the first two blocks up front.
     audio_dma_load_next_block(dma);
+    uint32_t first_block_us = dma->playback.last_block_us;
+    uint32_t second_block_us = 0;
     if (!single_buffer) {
         audio_dma_load_next_block(dma);
+        second_block_us = dma->playback.last_block_us;
     }
+    audioio_playback_started(&dma->playback, first_block_us, second_block_us);
 
     dma_configure(dma_channel, dma_trigger_source, true);
     audio_dma_enable_channel(dma_channel);
@@ -310,8 +236,13 @@ bool audio_dma_get_paused(audio_dma_t* dma) {
     return (status & DMAC_CHINTFLAG_SUSP) != 0;
 }
 
+const audioio_playback_stats_t* audio_dma_get_stats(audio_dma_t* dma) {
+    return audioio_playback_get_stats(&dma->playback);
+}
+
 void audio_dma_init(audio_dma_t* dma) {
     dma->dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    audioio_playback_init(&dma->playback);
 }
 
 void audio_dma_reset(void) {
@@ -352,6 +283,7 @@ void audio_dma_background(void) {
 
         bool block_done = event_interrupt_active(dma->event_channel);
         if (!block_done) {
+            audioio_playback_idle(&dma->playback);
             continue;
         }
 
@@ -359,6 +291,7 @@ void audio_dma_background(void) {
         // recursively at the next background processing time. So disallow recursive calls to here.
         audio_dma_pending[i] = true;
         audio_dma_load_next_block(dma);
+        audioio_playback_refilled(&dma->playback);
         audio_dma_pending[i] = false;
     }
 }
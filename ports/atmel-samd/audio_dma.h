@@ -29,24 +29,15 @@
 
 #include "extmod/vfs_fat.h"
 #include "py/obj.h"
+#include "shared-module/audiocore/__init__.h"
+#include "shared-module/audiocore/playback.h"
 #include "shared-module/audiocore/RawSample.h"
 #include "shared-module/audiocore/WaveFile.h"
 
 typedef struct {
-    mp_obj_t sample;
+    audioio_playback_t playback;
     uint8_t dma_channel;
     uint8_t event_channel;
-    uint8_t audio_channel;
-    uint8_t bytes_per_sample;
-    uint8_t beat_size;
-    uint8_t spacing;
-    bool loop;
-    bool single_channel;
-    bool signed_to_unsigned;
-    bool unsigned_to_signed;
-    bool first_buffer_free;
-    uint8_t* first_buffer;
-    uint8_t* second_buffer;
     bool first_descriptor_free;
     DmacDescriptor* second_descriptor;
 } audio_dma_t;
@@ -92,6 +83,7 @@ bool audio_dma_get_playing(audio_dma_t* dma);
 void audio_dma_pause(audio_dma_t* dma);
 void audio_dma_resume(audio_dma_t* dma);
 bool audio_dma_get_paused(audio_dma_t* dma);
+const audioio_playback_stats_t* audio_dma_get_stats(audio_dma_t* dma);
 
 void audio_dma_background(void);
 
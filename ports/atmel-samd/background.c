@@ -27,9 +27,8 @@
 
 #include "audio_dma.h"
 #include "tick.h"
-#include "supervisor/filesystem.h"
+#include "supervisor/shared/background_task.h"
 #include "supervisor/shared/tick.h"
-#include "supervisor/usb.h"
 
 #include "py/runtime.h"
 #include "shared-module/network/__init__.h"
@@ -39,6 +38,34 @@
 #include "shared-module/displayio/__init__.h"
 #endif
 
+#if CIRCUITPY_AUDIOCORE
+#include "shared-module/audiocore/WaveFile.h"
+#endif
+
+#if CIRCUITPY_AUDIOMP3
+#include "shared-module/audiomp3/MP3Decoder.h"
+#endif
+
+#if CIRCUITPY_AUDIOBUSIO
+#include "common-hal/audiobusio/PDMIn.h"
+#endif
+
+#if CIRCUITPY_AUDIOBUSIO_I2SIN
+#include "common-hal/audiobusio/I2SIn.h"
+#endif
+
+#if CIRCUITPY_NEOPIXEL_WRITE
+#include "common-hal/neopixel_write/__init__.h"
+#endif
+
+#if CIRCUITPY_ROTARYIO
+#include "common-hal/rotaryio/IncrementalEncoder.h"
+#endif
+
+#if CIRCUITPY_PULSEIO
+#include "common-hal/pulseio/PulseIn.h"
+#endif
+
 volatile uint64_t last_finished_tick = 0;
 
 bool stack_ok_so_far = true;
@@ -62,8 +89,71 @@ STATIC void start_background_task(void) {}
 STATIC void finish_background_task(void) {}
 #endif
 
+#if CIRCUITPY_AUDIOIO || CIRCUITPY_AUDIOBUSIO
+static background_task_t audio_dma_task;
+#endif
+#if CIRCUITPY_AUDIOCORE
+static background_task_t wavefile_task;
+#endif
+#if CIRCUITPY_AUDIOMP3
+static background_task_t mp3file_task;
+#endif
+#if CIRCUITPY_AUDIOBUSIO
+static background_task_t pdmin_task;
+#endif
+#if CIRCUITPY_AUDIOBUSIO_I2SIN
+static background_task_t i2sin_task;
+#endif
+#if CIRCUITPY_DISPLAYIO
+static background_task_t displayio_task;
+#endif
+#if CIRCUITPY_NEOPIXEL_WRITE
+static background_task_t neopixel_write_task;
+#endif
+#if CIRCUITPY_ROTARYIO
+static background_task_t incrementalencoder_task;
+#endif
+#if CIRCUITPY_PULSEIO
+static background_task_t pulsein_task;
+#endif
+#if CIRCUITPY_NETWORK
+static background_task_t network_task;
+#endif
+
 void background_tasks_reset(void) {
     running_background_tasks = false;
+
+    // The filesystem, USB and BLE register their own tasks.
+    #if CIRCUITPY_AUDIOIO || CIRCUITPY_AUDIOBUSIO
+    background_task_add(&audio_dma_task, audio_dma_background, BACKGROUND_TASK_PRIORITY_AUDIO, 1);
+    #endif
+    #if CIRCUITPY_AUDIOCORE
+    background_task_add(&wavefile_task, audioio_wavefile_background, BACKGROUND_TASK_PRIORITY_AUDIO_DECODE, 1);
+    #endif
+    #if CIRCUITPY_AUDIOMP3
+    background_task_add(&mp3file_task, audiomp3_mp3file_background, BACKGROUND_TASK_PRIORITY_AUDIO_DECODE, 1);
+    #endif
+    #if CIRCUITPY_AUDIOBUSIO
+    background_task_add(&pdmin_task, pdmin_background, BACKGROUND_TASK_PRIORITY_AUDIO, 1);
+    #endif
+    #if CIRCUITPY_AUDIOBUSIO_I2SIN
+    background_task_add(&i2sin_task, i2sin_background, BACKGROUND_TASK_PRIORITY_AUDIO, 1);
+    #endif
+    #if CIRCUITPY_DISPLAYIO
+    background_task_add(&displayio_task, displayio_background, BACKGROUND_TASK_PRIORITY_DISPLAY, 1);
+    #endif
+    #if CIRCUITPY_NEOPIXEL_WRITE
+    background_task_add(&neopixel_write_task, neopixel_write_background, BACKGROUND_TASK_PRIORITY_DISPLAY, 1);
+    #endif
+    #if CIRCUITPY_ROTARYIO
+    background_task_add(&incrementalencoder_task, incrementalencoder_background, BACKGROUND_TASK_PRIORITY_DISPLAY, VELOCITY_SAMPLE_MS);
+    #endif
+    #if CIRCUITPY_PULSEIO
+    background_task_add(&pulsein_task, pulsein_background, BACKGROUND_TASK_PRIORITY_AUDIO_DECODE, 1);
+    #endif
+    #if CIRCUITPY_NETWORK
+    background_task_add(&network_task, network_module_background, BACKGROUND_TASK_PRIORITY_NETWORK, 1);
+    #endif
 }
 
 void run_background_tasks(void) {
@@ -76,19 +166,7 @@ void run_background_tasks(void) {
 
     assert_heap_ok();
     running_background_tasks = true;
-
-    #if CIRCUITPY_AUDIOIO || CIRCUITPY_AUDIOBUSIO
-    audio_dma_background();
-    #endif
-    #if CIRCUITPY_DISPLAYIO
-    displayio_background();
-    #endif
-
-    #if CIRCUITPY_NETWORK
-    network_module_background();
-    #endif
-    filesystem_background();
-    usb_background();
+    background_tasks_run();
     running_background_tasks = false;
     assert_heap_ok();
 
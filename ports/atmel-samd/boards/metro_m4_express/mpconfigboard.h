@@ -22,6 +22,10 @@
 
 #define BOARD_HAS_CRYSTAL 1
 
+// Python to Python calls don't recurse on the C stack. Their frames come from
+// a CIRCUITPY_PYSTACK_SIZE pystack, which is plenty for the SAMD51's RAM.
+#define MICROPY_ENABLE_PYSTACK (1)
+
 #define DEFAULT_I2C_BUS_SCL (&pin_PB03)
 #define DEFAULT_I2C_BUS_SDA (&pin_PB02)
 
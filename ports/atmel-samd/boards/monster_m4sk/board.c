@@ -80,6 +80,9 @@ void board_init(void) {
         MIPI_COMMAND_SET_PAGE_ADDRESS, // Set row command
         MIPI_COMMAND_WRITE_MEMORY_START, // Write memory command
         0x37, // set vertical scroll command
+        0, // vertical scroll lines
+        NO_COMMAND, // rotation command
+        NULL, // rotation values
         display_init_sequence,
         sizeof(display_init_sequence),
         &pin_PA23,  // backlight pin
@@ -35,6 +35,9 @@
 #include "py/mphal.h"
 
 #include "samd/adc.h"
+#include "samd/dma.h"
+#include "samd/events.h"
+#include "samd/timers.h"
 #include "shared-bindings/analogio/AnalogIn.h"
 #include "supervisor/shared/translate.h"
 
@@ -42,6 +45,9 @@
 #include "hal/include/hal_adc_sync.h"
 #include "hpl/gclk/hpl_gclk_base.h"
 
+#include "audio_dma.h"
+#include "timer_handler.h"
+
 #ifdef SAMD21
 #include "hpl/pm/hpl_pm_base.h"
 #endif
@@ -70,6 +76,7 @@ void common_hal_analogio_analogin_construct(analogio_analogin_obj_t* self,
     self->instance = adc_insts[adc_index];
     self->channel = adc_channel;
     self->pin = pin;
+    self->dma_channel = AUDIO_DMA_CHANNEL_COUNT;
 }
 
 bool common_hal_analogio_analogin_deinited(analogio_analogin_obj_t *self) {
@@ -80,6 +87,7 @@ void common_hal_analogio_analogin_deinit(analogio_analogin_obj_t *self) {
     if (common_hal_analogio_analogin_deinited(self)) {
         return;
     }
+    common_hal_analogio_analogin_stop_reading(self);
     reset_pin_number(self->pin->number);
     self->pin = mp_const_none;
 }
@@ -87,39 +95,56 @@ void common_hal_analogio_analogin_deinit(analogio_analogin_obj_t *self) {
 void analogin_reset() {
 }
 
-uint16_t common_hal_analogio_analogin_get_value(analogio_analogin_obj_t *self) {
-    // Something else might have used the ADC in a different way,
-    // so we completely re-initialize it.
-
-    struct adc_sync_descriptor adc;
-
-    samd_peripherals_adc_setup(&adc, self->instance);
+// Something else might have used the ADC in a different way, so this
+// completely re-initializes it. For background reads, the 12 bit result is put
+// at the top of the 16 bit result register and conversions start on an event.
+STATIC void adc_setup(analogio_analogin_obj_t *self, struct adc_sync_descriptor* adc, bool background) {
+    samd_peripherals_adc_setup(adc, self->instance);
 
     // Full scale is 3.3V (VDDANA) = 65535.
 
     // On SAMD21, INTVCC1 is 0.5*VDDANA. On SAMD51, INTVCC1 is 1*VDDANA.
     // So on SAMD21 only, divide the input by 2, so full scale will match 0.5*VDDANA.
-    adc_sync_set_reference(&adc, ADC_REFCTRL_REFSEL_INTVCC1_Val);
+    adc_sync_set_reference(adc, ADC_REFCTRL_REFSEL_INTVCC1_Val);
     #ifdef SAMD21
-    adc_sync_set_channel_gain(&adc, self->channel, ADC_INPUTCTRL_GAIN_DIV2_Val);
+    adc_sync_set_channel_gain(adc, self->channel, ADC_INPUTCTRL_GAIN_DIV2_Val);
     #endif
 
-    adc_sync_set_resolution(&adc, ADC_CTRLB_RESSEL_12BIT_Val);
+    adc_sync_set_resolution(adc, ADC_CTRLB_RESSEL_12BIT_Val);
+
+    Adc* instance = self->instance;
+    instance->CTRLB.bit.LEFTADJ = background;
+    #ifdef SAMD21
+    while (instance->STATUS.bit.SYNCBUSY == 1) {}
+    #endif
+    #ifdef SAMD51
+    while (instance->SYNCBUSY.bit.CTRLB == 1) {}
+    #endif
+    instance->EVCTRL.reg = background ? ADC_EVCTRL_STARTEI : 0;
 
-    adc_sync_enable_channel(&adc, self->channel);
+    adc_sync_enable_channel(adc, self->channel);
 
     // We need to set the inputs because the above channel enable only enables the ADC.
-    adc_sync_set_inputs(&adc, self->channel, ADC_INPUTCTRL_MUXNEG_GND_Val, self->channel);
+    adc_sync_set_inputs(adc, self->channel, ADC_INPUTCTRL_MUXNEG_GND_Val, self->channel);
 
-    // Read twice and discard first result, as recommended in section 14 of
+    // Read once and discard the result, as recommended in section 14 of
     // http://www.atmel.com/images/Atmel-42645-ADC-Configurations-with-Examples_ApplicationNote_AT11481.pdf
     // "Discard the first conversion result whenever there is a change in ADC configuration
     // like voltage reference / ADC channel change"
     // Empirical observation shows the first reading is quite different than subsequent ones.
+    uint16_t value;
+    adc_sync_read_channel(adc, self->channel, ((uint8_t*) &value), 2);
+}
+
+uint16_t common_hal_analogio_analogin_get_value(analogio_analogin_obj_t *self) {
+    // Background reads own the ADC until they stop.
+    common_hal_analogio_analogin_stop_reading(self);
+
+    struct adc_sync_descriptor adc;
+    adc_setup(self, &adc, false);
 
     uint16_t value;
     adc_sync_read_channel(&adc, self->channel, ((uint8_t*) &value), 2);
-    adc_sync_read_channel(&adc, self->channel, ((uint8_t*) &value), 2);
 
     adc_sync_deinit(&adc);
     // Shift the value to be 16 bit.
@@ -129,3 +154,136 @@ uint16_t common_hal_analogio_analogin_get_value(analogio_analogin_obj_t *self) {
 float common_hal_analogio_analogin_get_reference_voltage(analogio_analogin_obj_t *self) {
     return 3.3f;
 }
+
+// Fast enough for the ADC clock set up by samd_peripherals_adc_setup.
+#ifdef SAMD21
+#define MAX_SAMPLE_RATE 100000
+#define FIRST_TC_GEN_ID EVSYS_ID_GEN_TC3_OVF
+#endif
+#ifdef SAMD51
+#define MAX_SAMPLE_RATE 250000
+#define FIRST_TC_GEN_ID EVSYS_ID_GEN_TC0_OVF
+#endif
+
+STATIC void set_timer_frequency(Tc* timer, uint32_t frequency) {
+    uint32_t system_clock = 48000000;
+    uint32_t new_top;
+    uint8_t new_divisor;
+    for (new_divisor = 0; new_divisor < 8; new_divisor++) {
+        new_top = (system_clock / prescaler[new_divisor] / frequency) - 1;
+        if (new_top < (1u << 16)) {
+            break;
+        }
+    }
+    timer->COUNT16.CTRLA.bit.PRESCALER = new_divisor;
+    tc_wait_for_sync(timer);
+    timer->COUNT16.CC[0].reg = new_top;
+    tc_wait_for_sync(timer);
+}
+
+bool common_hal_analogio_analogin_start_reading(analogio_analogin_obj_t* self, uint16_t* buffer, size_t len, uint32_t rate, bool loop) {
+    common_hal_analogio_analogin_stop_reading(self);
+    if (rate > MAX_SAMPLE_RATE) {
+        mp_raise_ValueError_varg(translate("Sample rate too high. It must be less than %d"), MAX_SAMPLE_RATE);
+    }
+    if (len > 0xffff) {
+        mp_raise_ValueError_varg(translate("Buffer length %d too big. It must be less than %d"), len, 0x10000);
+    }
+
+    Tc* t = NULL;
+    uint8_t tc_index = TC_INST_NUM;
+    for (uint8_t i = TC_INST_NUM; i > 0; i--) {
+        if (tc_insts[i - 1]->COUNT16.CTRLA.bit.ENABLE == 0) {
+            t = tc_insts[i - 1];
+            tc_index = i - 1;
+            break;
+        }
+    }
+    if (t == NULL) {
+        mp_raise_RuntimeError(translate("All timers in use"));
+    }
+    turn_on_event_system();
+    uint8_t event_channel = find_async_event_channel();
+    if (event_channel >= EVSYS_CHANNELS) {
+        mp_raise_RuntimeError(translate("All event channels in use"));
+    }
+    uint8_t dma_channel = audio_dma_allocate_channel();
+    if (dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        mp_raise_RuntimeError(translate("No DMA channel found"));
+    }
+
+    adc_setup(self, &self->adc, true);
+
+    // Each conversion result is moved to the buffer as soon as it's ready.
+    Adc* instance = self->instance;
+    DmacDescriptor* descriptor = dma_descriptor(dma_channel);
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_HWORD | DMAC_BTCTRL_DSTINC;
+    descriptor->BTCNT.reg = len;
+    descriptor->SRCADDR.reg = (uint32_t) &instance->RESULT.reg;
+    descriptor->DSTADDR.reg = (uint32_t) (buffer + len);
+    descriptor->DESCADDR.reg = loop ? (uint32_t) descriptor : 0;
+    #ifdef SAMD21
+    uint8_t trigger = ADC_DMAC_ID_RESRDY;
+    uint8_t event_user = EVSYS_ID_USER_ADC_START;
+    #endif
+    #ifdef SAMD51
+    uint8_t trigger = instance == ADC0 ? ADC0_DMAC_ID_RESRDY : ADC1_DMAC_ID_RESRDY;
+    uint8_t event_user = instance == ADC0 ? EVSYS_ID_USER_ADC0_START : EVSYS_ID_USER_ADC1_START;
+    #endif
+    dma_configure(dma_channel, trigger, false);
+    dma_enable_channel(dma_channel);
+
+    // The timer overflows at the sample rate and each overflow starts a
+    // conversion.
+    uint8_t tc_gclk = 0;
+    #ifdef SAMD51
+    tc_gclk = 1;
+    #endif
+    set_timer_handler(true, tc_index, TC_HANDLER_NO_INTERRUPT);
+    turn_on_clocks(true, tc_index, tc_gclk);
+    tc_set_enable(t, false);
+    tc_reset(t);
+    #ifdef SAMD51
+    t->COUNT16.WAVE.reg = TC_WAVE_WAVEGEN_MFRQ;
+    #endif
+    #ifdef SAMD21
+    t->COUNT16.CTRLA.bit.WAVEGEN = TC_CTRLA_WAVEGEN_MFRQ_Val;
+    #endif
+    t->COUNT16.EVCTRL.reg = TC_EVCTRL_OVFEO;
+    set_timer_frequency(t, rate);
+
+    connect_event_user_to_channel(event_user, event_channel);
+    init_async_event_channel(event_channel, FIRST_TC_GEN_ID + 3 * tc_index);
+
+    self->dma_channel = dma_channel;
+    self->tc_index = tc_index;
+    self->event_channel = event_channel;
+    self->loop = loop;
+    tc_set_enable(t, true);
+    return true;
+}
+
+bool common_hal_analogio_analogin_get_reading(analogio_analogin_obj_t* self) {
+    if (self->dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        return false;
+    }
+    if (!self->loop &&
+        (dma_transfer_status(self->dma_channel) & (DMAC_CHINTFLAG_TCMPL | DMAC_CHINTFLAG_TERR)) != 0) {
+        common_hal_analogio_analogin_stop_reading(self);
+        return false;
+    }
+    return true;
+}
+
+void common_hal_analogio_analogin_stop_reading(analogio_analogin_obj_t* self) {
+    if (self->dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        return;
+    }
+    Tc* t = tc_insts[self->tc_index];
+    tc_set_enable(t, false);
+    tc_reset(t);
+    disable_event_channel(self->event_channel);
+    audio_dma_free_channel(self->dma_channel);
+    self->dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    adc_sync_deinit(&self->adc);
+}
@@ -29,6 +29,8 @@
 
 #include "common-hal/microcontroller/Pin.h"
 
+#include "hal/include/hal_adc_sync.h"
+
 #include "py/obj.h"
 
 typedef struct {
@@ -36,6 +38,13 @@ typedef struct {
     const mcu_pin_obj_t * pin;
     Adc* instance;
     uint8_t channel;
+    // Background reading, where a timer starts each conversion and DMA stores
+    // the result. dma_channel is AUDIO_DMA_CHANNEL_COUNT when not reading.
+    struct adc_sync_descriptor adc;
+    uint8_t dma_channel;
+    uint8_t tc_index;
+    uint8_t event_channel;
+    bool loop;
 } analogio_analogin_obj_t;
 
 void analogin_reset(void);
@@ -0,0 +1,462 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "py/gc.h"
+#include "py/mpstate.h"
+#include "py/runtime.h"
+#include "common-hal/audiobusio/I2SIn.h"
+#include "shared-bindings/audiobusio/I2SIn.h"
+#include "shared-bindings/microcontroller/Pin.h"
+#include "supervisor/shared/translate.h"
+
+#include "atmel_start_pins.h"
+#include "hal/include/hal_gpio.h"
+#include "hal/utils/include/utils.h"
+
+#include "samd/clocks.h"
+#include "samd/dma.h"
+#include "samd/events.h"
+#include "samd/i2s.h"
+#include "samd/pins.h"
+
+#include "audio_dma.h"
+
+// Samples per DMA block. Longer blocks let background tasks be later without losing data.
+#define SAMPLES_PER_BLOCK 256
+
+#ifdef SAMD21
+#define SERCTRL(name) I2S_SERCTRL_ ## name
+#endif
+
+#ifdef SAMD51
+#define SERCTRL(name) I2S_RXCTRL_ ## name
+#endif
+
+// DMA channel of the I2SIn recording in the background. The I2SIn is kept alive through the
+// playing_audio root pointer for the channel.
+static uint8_t background_channel = AUDIO_DMA_CHANNEL_COUNT;
+
+static bool clock_unit_enabled(uint8_t clock_unit) {
+    if (I2S->CTRLA.bit.ENABLE == 0) {
+        return false;
+    }
+    return (I2S->CTRLA.vec.CKEN & (1 << clock_unit)) != 0;
+}
+
+void common_hal_audiobusio_i2sin_construct(audiobusio_i2sin_obj_t* self,
+        const mcu_pin_obj_t* bit_clock, const mcu_pin_obj_t* word_select, const mcu_pin_obj_t* data,
+        uint32_t sample_rate, uint8_t bit_depth, bool left_justified) {
+    uint8_t serializer = 0xff;
+    uint8_t bc_clock_unit = 0xff;
+    uint8_t ws_clock_unit = 0xff;
+    #ifdef SAMD21
+    if (bit_clock == &pin_PA10
+        #ifdef PIN_PA20
+        || bit_clock == &pin_PA20
+        #endif
+        ) { // I2S SCK[0]
+        bc_clock_unit = 0;
+    }
+    #ifdef PIN_PB11
+    else if (bit_clock == &pin_PB11) { // I2S SCK[1]
+        bc_clock_unit = 1;
+    }
+    #endif
+    if (word_select == &pin_PA11
+        #ifdef PIN_PA21
+        || word_select == &pin_PA21
+        #endif
+        ) { // I2S FS[0]
+        ws_clock_unit = 0;
+    }
+    #ifdef PIN_PB12
+    else if (word_select == &pin_PB12) { // I2S FS[1]
+        ws_clock_unit = 1;
+    }
+    #endif
+
+    if (data == &pin_PA07 || data == &pin_PA19) { // I2S SD[0]
+        serializer = 0;
+    } else if (data == &pin_PA08
+    #ifdef PIN_PB16
+        || data == &pin_PB16
+    #endif
+    ) { // I2S SD[1]
+        serializer = 1;
+    }
+    #endif
+    #ifdef SAMD51
+    // Use clock unit 0 like I2SOut so both can share the bit clock and word select.
+    if (bit_clock == &pin_PA10 || bit_clock == &pin_PB16) { // I2S SCK[0]
+        bc_clock_unit = 0;
+    }
+    if (word_select == &pin_PA09 || word_select == &pin_PA20) { // I2S FS[0]
+        ws_clock_unit = 0;
+    }
+    if (data == &pin_PA22 || data == &pin_PB10) { // I2S SDI
+        serializer = 1;
+    }
+    #endif
+    if (bc_clock_unit == 0xff) {
+        mp_raise_ValueError_varg(translate("Invalid %q pin"), MP_QSTR_bit_clock);
+    }
+    if (ws_clock_unit == 0xff) {
+        mp_raise_ValueError_varg(translate("Invalid %q pin"), MP_QSTR_word_select);
+    }
+    if (bc_clock_unit != ws_clock_unit) {
+        mp_raise_ValueError(translate("Bit clock and word select must share a clock unit"));
+    }
+    if (serializer == 0xff) {
+        mp_raise_ValueError_varg(translate("Invalid %q pin"), MP_QSTR_data);
+    }
+    self->clock_unit = ws_clock_unit;
+    self->serializer = serializer;
+
+    // 24 bit samples are received in 32 bit slots.
+    uint8_t slot_bits = bit_depth == 16 ? 16 : 32;
+    uint32_t divisor = 48000000 / (2 * slot_bits * sample_rate);
+    if (divisor == 0 || divisor > 0xffff) {
+        mp_raise_ValueError(translate("sampling rate out of range"));
+    }
+
+    turn_on_i2s();
+
+    if (I2S->CTRLA.bit.ENABLE == 0) {
+        I2S->CTRLA.bit.SWRST = 1;
+        while (I2S->CTRLA.bit.SWRST == 1) {}
+    } else {
+        #ifdef SAMD21
+        if ((I2S->CTRLA.vec.SEREN & (1 << serializer)) != 0) {
+            mp_raise_RuntimeError(translate("Serializer in use"));
+        }
+        #endif
+        #ifdef SAMD51
+        if (I2S->CTRLA.bit.RXEN == 1) {
+            mp_raise_RuntimeError(translate("Serializer in use"));
+        }
+        #endif
+    }
+    if (clock_unit_enabled(self->clock_unit)) {
+        mp_raise_RuntimeError(translate("Clock unit in use"));
+    }
+
+    #ifdef SAMD51
+    #define GPIO_I2S_FUNCTION GPIO_PIN_FUNCTION_J
+    #endif
+    #ifdef SAMD21
+    #define GPIO_I2S_FUNCTION GPIO_PIN_FUNCTION_G
+    #endif
+    assert_pin_free(bit_clock);
+    assert_pin_free(word_select);
+    assert_pin_free(data);
+
+    // Find a free GCLK to generate the MCLK signal.
+    uint8_t gclk = find_free_gclk(divisor);
+    if (gclk > GCLK_GEN_NUM) {
+        mp_raise_RuntimeError(translate("Unable to find free GCLK"));
+    }
+    self->gclk = gclk;
+
+    uint32_t clkctrl = I2S_CLKCTRL_MCKSEL_GCLK |
+                       I2S_CLKCTRL_NBSLOTS(1) |
+                       I2S_CLKCTRL_FSWIDTH_HALF;
+    if (left_justified) {
+        clkctrl |= I2S_CLKCTRL_BITDELAY_LJ;
+    } else {
+        clkctrl |= I2S_CLKCTRL_FSOUTINV | I2S_CLKCTRL_BITDELAY_I2S;
+    }
+    #ifdef SAMD21
+    uint32_t serctrl = (self->clock_unit << I2S_SERCTRL_CLKSEL_Pos) | SERCTRL(SERMODE_RX) | SERCTRL(SLOTADJ_LEFT) | SERCTRL(MONO_STEREO);
+    #endif
+    #ifdef SAMD51
+    uint32_t serctrl = (self->clock_unit << I2S_RXCTRL_CLKSEL_Pos) | SERCTRL(SERMODE_RX) | SERCTRL(SLOTADJ_LEFT) | SERCTRL(MONO_STEREO);
+    #endif
+    if (slot_bits == 16) {
+        serctrl |= SERCTRL(DATASIZE_16);
+        clkctrl |= I2S_CLKCTRL_SLOTSIZE_16;
+    } else {
+        serctrl |= SERCTRL(DATASIZE_32);
+        clkctrl |= I2S_CLKCTRL_SLOTSIZE_32;
+    }
+
+    // Configure the I2S peripheral
+    i2s_set_enable(false);
+
+    I2S->CLKCTRL[self->clock_unit].reg = clkctrl;
+    #ifdef SAMD21
+    I2S->SERCTRL[self->serializer].reg = serctrl;
+    #endif
+    #ifdef SAMD51
+    I2S->RXCTRL.reg = serctrl;
+    #endif
+
+    // The DFLL is always a 48mhz clock
+    enable_clock_generator(self->gclk, CLOCK_48MHZ, divisor);
+    connect_gclk_to_peripheral(self->gclk, I2S_GCLK_ID_0 + self->clock_unit);
+
+    i2s_set_enable(true);
+
+    self->bit_clock = bit_clock;
+    self->word_select = word_select;
+    self->data = data;
+
+    claim_pin(bit_clock);
+    claim_pin(word_select);
+    claim_pin(data);
+
+    gpio_set_pin_function(self->bit_clock->number, GPIO_I2S_FUNCTION);
+    gpio_set_pin_function(self->word_select->number, GPIO_I2S_FUNCTION);
+    gpio_set_pin_function(self->data->number, GPIO_I2S_FUNCTION);
+
+    self->sample_rate = 48000000 / (2 * slot_bits * divisor);
+    self->bit_depth = bit_depth;
+    self->bytes_per_sample = slot_bits / 8;
+    self->left_justified = left_justified;
+    self->dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    self->ring = NULL;
+    self->ready_blocks = 0;
+}
+
+bool common_hal_audiobusio_i2sin_deinited(audiobusio_i2sin_obj_t* self) {
+    return self->bit_clock == mp_const_none;
+}
+
+void common_hal_audiobusio_i2sin_deinit(audiobusio_i2sin_obj_t* self) {
+    if (common_hal_audiobusio_i2sin_deinited(self)) {
+        return;
+    }
+
+    common_hal_audiobusio_i2sin_stop(self);
+
+    disconnect_gclk_from_peripheral(self->gclk, I2S_GCLK_ID_0 + self->clock_unit);
+    disable_clock_generator(self->gclk);
+
+    #ifdef SAMD51
+    connect_gclk_to_peripheral(5, I2S_GCLK_ID_0 + self->clock_unit);
+    #endif
+
+    reset_pin_number(self->bit_clock->number);
+    self->bit_clock = mp_const_none;
+    reset_pin_number(self->word_select->number);
+    self->word_select = mp_const_none;
+    reset_pin_number(self->data->number);
+    self->data = mp_const_none;
+    self->ring = NULL;
+}
+
+uint8_t common_hal_audiobusio_i2sin_get_bit_depth(audiobusio_i2sin_obj_t* self) {
+    return self->bit_depth;
+}
+
+uint32_t common_hal_audiobusio_i2sin_get_sample_rate(audiobusio_i2sin_obj_t* self) {
+    return self->sample_rate;
+}
+
+static DmacDescriptor* block_descriptor(audiobusio_i2sin_obj_t* self, uint8_t index) {
+    if (index == 0) {
+        return dma_descriptor(self->dma_channel);
+    }
+    return self->second_descriptor;
+}
+
+// Points the descriptor at a ring block. The DMA writes straight into the ring so no copy is
+// needed once the block is done.
+static void set_descriptor_block(audiobusio_i2sin_obj_t* self, uint8_t index, uint16_t block) {
+    self->dma_blocks[index] = block;
+    // DSTADDR is the end of the block when DSTINC is set.
+    block_descriptor(self, index)->DSTADDR.reg = (uint32_t) (self->ring + (block + 1) * self->block_length);
+}
+
+static void setup_descriptor(audiobusio_i2sin_obj_t* self, DmacDescriptor* descriptor,
+                             DmacDescriptor* next) {
+    uint32_t beatsize = DMAC_BTCTRL_BEATSIZE_HWORD;
+    if (self->bytes_per_sample == 4) {
+        beatsize = DMAC_BTCTRL_BEATSIZE_WORD;
+    }
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID |
+                             DMAC_BTCTRL_BLOCKACT_NOACT |
+                             DMAC_BTCTRL_EVOSEL_BLOCK |
+                             DMAC_BTCTRL_DSTINC |
+                             beatsize;
+    descriptor->BTCNT.reg = SAMPLES_PER_BLOCK;
+    descriptor->DESCADDR.reg = (uint32_t) next;
+    #ifdef SAMD21
+    descriptor->SRCADDR.reg = (uint32_t)&I2S->DATA[self->serializer];
+    #endif
+    #ifdef SAMD51
+    descriptor->SRCADDR.reg = (uint32_t)&I2S->RXDATA;
+    #endif
+}
+
+void common_hal_audiobusio_i2sin_start(audiobusio_i2sin_obj_t* self, uint32_t buffer_length) {
+    if (common_hal_audiobusio_i2sin_get_recording(self)) {
+        return;
+    }
+    if (background_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        mp_raise_RuntimeError(translate("Serializer in use"));
+    }
+    if (clock_unit_enabled(self->clock_unit)) {
+        mp_raise_RuntimeError(translate("Clock unit in use"));
+    }
+    // Two blocks belong to the DMA so keep at least one more to read from.
+    uint32_t ring_blocks = MAX(3, (buffer_length + SAMPLES_PER_BLOCK - 1) / SAMPLES_PER_BLOCK);
+    if (ring_blocks > 0xffff) {
+        mp_raise_ValueError(translate("Invalid buffer size"));
+    }
+    // Allocate before claiming any hardware so a MemoryError leaves nothing behind.
+    self->ready_blocks = 0;
+    self->block_length = SAMPLES_PER_BLOCK * self->bytes_per_sample;
+    self->ring = m_malloc(ring_blocks * self->block_length, false);
+    self->ring_blocks = ring_blocks;
+    self->read_block = 0;
+    self->read_offset = 0;
+    // The heap is 16 byte aligned like descriptors need to be.
+    self->second_descriptor = m_new_obj(DmacDescriptor);
+    self->blocks_done = 0;
+
+    uint8_t dma_channel = audio_dma_allocate_channel();
+    if (dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        mp_raise_RuntimeError(translate("No DMA channel found"));
+    }
+    uint8_t event_channel = find_sync_event_channel();
+    if (event_channel >= EVSYS_SYNCH_NUM) {
+        audio_dma_free_channel(dma_channel);
+        mp_raise_RuntimeError(translate("All sync event channels in use"));
+    }
+    self->dma_channel = dma_channel;
+    self->event_channel = event_channel;
+    background_channel = dma_channel;
+    MP_STATE_PORT(playing_audio)[dma_channel] = self;
+
+    DmacDescriptor* first_descriptor = dma_descriptor(dma_channel);
+    setup_descriptor(self, first_descriptor, self->second_descriptor);
+    setup_descriptor(self, self->second_descriptor, first_descriptor);
+    set_descriptor_block(self, 0, 0);
+    set_descriptor_block(self, 1, 1);
+
+    uint8_t trigger_source = I2S_DMAC_ID_RX_0;
+    #ifdef SAMD21
+    trigger_source += self->serializer;
+    #endif
+
+    turn_on_event_system();
+    dma_configure(dma_channel, trigger_source, true);
+    init_event_channel_interrupt(event_channel, CORE_GCLK, EVSYS_ID_GEN_DMAC_CH_0 + dma_channel);
+
+    I2S->INTFLAG.reg = I2S_INTFLAG_RXOR0 | I2S_INTFLAG_RXOR1;
+
+    i2s_set_clock_unit_enable(self->clock_unit, true);
+    // Init the serializer after the clock. Otherwise, it will never enable because its unclocked.
+    i2s_set_serializer_enable(self->serializer, true);
+    audio_dma_enable_channel(dma_channel);
+}
+
+void common_hal_audiobusio_i2sin_stop(audiobusio_i2sin_obj_t* self) {
+    if (!common_hal_audiobusio_i2sin_get_recording(self)) {
+        return;
+    }
+    disable_event_channel(self->event_channel);
+    audio_dma_free_channel(self->dma_channel);
+    i2s_set_serializer_enable(self->serializer, false);
+    i2s_set_clock_unit_enable(self->clock_unit, false);
+    MP_STATE_PORT(playing_audio)[self->dma_channel] = NULL;
+    background_channel = AUDIO_DMA_CHANNEL_COUNT;
+    self->dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    // Blocks already recorded can still be read. The ones the DMA was filling are dropped.
+    self->second_descriptor = NULL;
+}
+
+bool common_hal_audiobusio_i2sin_get_recording(audiobusio_i2sin_obj_t* self) {
+    return self->dma_channel < AUDIO_DMA_CHANNEL_COUNT;
+}
+
+uint32_t common_hal_audiobusio_i2sin_readinto(audiobusio_i2sin_obj_t* self,
+        uint8_t* buffer, uint32_t length) {
+    if (self->ring == NULL) {
+        return 0;
+    }
+    length -= length % self->bytes_per_sample;
+    uint32_t copied = 0;
+    while (copied < length && self->ready_blocks > 0) {
+        uint32_t count = min(length - copied, self->block_length - self->read_offset);
+        memcpy(buffer + copied,
+               self->ring + self->read_block * self->block_length + self->read_offset, count);
+        copied += count;
+        self->read_offset += count;
+        if (self->read_offset == self->block_length) {
+            self->read_offset = 0;
+            self->read_block++;
+            if (self->read_block == self->ring_blocks) {
+                self->read_block = 0;
+            }
+            self->ready_blocks--;
+        }
+    }
+    return copied;
+}
+
+// Hands blocks the DMA has finished to the reader and points their descriptors at the next free
+// block. When the ring is full the oldest block is dropped.
+void i2sin_background(void) {
+    if (background_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        return;
+    }
+    mp_obj_t obj = MP_STATE_PORT(playing_audio)[background_channel];
+    if (obj == NULL || !MP_OBJ_IS_TYPE(obj, &audiobusio_i2sin_type)) {
+        // The VM was reset and stopped the DMA.
+        background_channel = AUDIO_DMA_CHANNEL_COUNT;
+        return;
+    }
+    audiobusio_i2sin_obj_t* self = MP_OBJ_TO_PTR(obj);
+    if (!event_interrupt_active(self->event_channel)) {
+        return;
+    }
+    uint8_t index = self->blocks_done % 2;
+    if (event_interrupt_overflow(self->event_channel)) {
+        // Both blocks finished before the first was retargeted so the DMA is filling it again.
+        // Drop both and keep the descriptors where they are. They are still in ring order.
+        return;
+    }
+    self->blocks_done++;
+    self->ready_blocks++;
+    if (self->ready_blocks + 1 == self->ring_blocks) {
+        // The next free block is the oldest ready one.
+        self->read_block++;
+        if (self->read_block == self->ring_blocks) {
+            self->read_block = 0;
+        }
+        self->read_offset = 0;
+        self->ready_blocks--;
+    }
+    uint16_t next = self->dma_blocks[1 - index] + 1;
+    if (next == self->ring_blocks) {
+        next = 0;
+    }
+    set_descriptor_block(self, index, next);
+}
@@ -0,0 +1,64 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_ATMEL_SAMD_COMMON_HAL_AUDIOBUSIO_I2SIN_H
+#define MICROPY_INCLUDED_ATMEL_SAMD_COMMON_HAL_AUDIOBUSIO_I2SIN_H
+
+#include "common-hal/microcontroller/Pin.h"
+
+#include "audio_dma.h"
+#include "py/obj.h"
+
+typedef struct {
+    mp_obj_base_t base;
+    const mcu_pin_obj_t *bit_clock;
+    const mcu_pin_obj_t *word_select;
+    const mcu_pin_obj_t *data;
+    uint32_t sample_rate;
+    uint8_t clock_unit;
+    uint8_t serializer;
+    uint8_t gclk;
+    uint8_t bit_depth;
+    uint8_t bytes_per_sample; // 2 or 4. 24 bit samples are left aligned in 4 bytes.
+    bool left_justified;
+    // Recording state. The DMA writes straight into the ring, one block per descriptor. Each
+    // descriptor is pointed at the next free block once it finishes.
+    uint8_t dma_channel; // AUDIO_DMA_CHANNEL_COUNT when not recording.
+    uint8_t event_channel;
+    DmacDescriptor* second_descriptor;
+    uint32_t blocks_done;
+    uint8_t* ring;
+    uint32_t block_length; // In bytes.
+    uint16_t ring_blocks;
+    uint16_t dma_blocks[2]; // Ring block each descriptor fills.
+    uint16_t read_block;
+    uint16_t ready_blocks; // Blocks recorded starting at read_block.
+    uint32_t read_offset; // Bytes of read_block already read.
+} audiobusio_i2sin_obj_t;
+
+void i2sin_background(void);
+
+#endif // MICROPY_INCLUDED_ATMEL_SAMD_COMMON_HAL_AUDIOBUSIO_I2SIN_H
@@ -30,6 +30,7 @@
 
 #include "py/gc.h"
 #include "py/mperrno.h"
+#include "py/mpstate.h"
 #include "py/runtime.h"
 #include "common-hal/analogio/AnalogOut.h"
 #include "common-hal/audiobusio/PDMIn.h"
@@ -53,6 +54,8 @@
 
 #define OVERSAMPLING 64
 #define SAMPLES_PER_BUFFER 32
+// Background recording uses longer blocks so background tasks can be late without losing data.
+#define BACKGROUND_SAMPLES_PER_BUFFER 128
 
 // MEMS microphones must be clocked at at least 1MHz.
 #define MIN_MIC_CLOCK 1000000
@@ -65,6 +68,10 @@
 #define SERCTRL(name) I2S_RXCTRL_ ## name
 #endif
 
+// DMA channel of the PDMIn recording in the background. The PDMIn is kept alive through the
+// playing_audio root pointer for the channel.
+static uint8_t background_channel = AUDIO_DMA_CHANNEL_COUNT;
+
 void pdmin_reset(void) {
     while (I2S->SYNCBUSY.reg & I2S_SYNCBUSY_ENABLE) {}
     I2S->INTENCLR.reg = I2S_INTENCLR_MASK;
@@ -216,6 +223,8 @@ void common_hal_audiobusio_pdmin_construct(audiobusio_pdmin_obj_t* self,
 
     self->bytes_per_sample = oversample >> 3;
     self->bit_depth = bit_depth;
+    self->dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    self->ring = NULL;
 }
 
 bool common_hal_audiobusio_pdmin_deinited(audiobusio_pdmin_obj_t* self) {
@@ -227,6 +236,7 @@ void common_hal_audiobusio_pdmin_deinit(audiobusio_pdmin_obj_t* self) {
         return;
     }
 
+    common_hal_audiobusio_pdmin_stop(self);
     i2s_set_serializer_enable(self->serializer, false);
     i2s_set_clock_unit_enable(self->clock_unit, false);
 
@@ -355,6 +365,9 @@ static uint16_t filter_sample(uint32_t pdm_samples[4]) {
 // output_buffer_length is the number of slots, not the number of bytes.
 uint32_t common_hal_audiobusio_pdmin_record_to_buffer(audiobusio_pdmin_obj_t* self,
         uint16_t* output_buffer, uint32_t output_buffer_length) {
+    if (common_hal_audiobusio_pdmin_get_recording(self)) {
+        mp_raise_RuntimeError(translate("Serializer in use"));
+    }
     uint8_t dma_channel = audio_dma_allocate_channel();
     uint8_t event_channel = find_sync_event_channel();
     if (event_channel >= EVSYS_SYNCH_NUM) {
@@ -471,6 +484,159 @@ uint32_t common_hal_audiobusio_pdmin_record_to_buffer(audiobusio_pdmin_obj_t* se
     return values_output;
 }
 
+static void setup_background_descriptor(audiobusio_pdmin_obj_t* self, DmacDescriptor* descriptor,
+                                        uint32_t* buffer, uint32_t words_per_buffer,
+                                        DmacDescriptor* next) {
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID |
+                             DMAC_BTCTRL_BLOCKACT_NOACT |
+                             DMAC_BTCTRL_EVOSEL_BLOCK |
+                             DMAC_BTCTRL_DSTINC |
+                             DMAC_BTCTRL_BEATSIZE_WORD;
+    descriptor->BTCNT.reg = words_per_buffer;
+    descriptor->DSTADDR.reg = ((uint32_t) buffer + sizeof(uint32_t) * words_per_buffer);
+    descriptor->DESCADDR.reg = (uint32_t) next;
+    #ifdef SAMD21
+    descriptor->SRCADDR.reg = (uint32_t)&I2S->DATA[self->serializer];
+    #endif
+    #ifdef SAMD51
+    descriptor->SRCADDR.reg = (uint32_t)&I2S->RXDATA;
+    #endif
+}
+
+void common_hal_audiobusio_pdmin_start(audiobusio_pdmin_obj_t* self, uint32_t buffer_length) {
+    if (common_hal_audiobusio_pdmin_get_recording(self)) {
+        return;
+    }
+    if (background_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        mp_raise_RuntimeError(translate("Serializer in use"));
+    }
+    uint8_t words_per_sample = self->bytes_per_sample / 2;
+    uint32_t words_per_buffer = BACKGROUND_SAMPLES_PER_BUFFER * words_per_sample;
+    // Allocate before claiming any hardware so a MemoryError leaves nothing behind.
+    self->ring = m_new(uint16_t, buffer_length);
+    self->ring_length = buffer_length;
+    self->ring_start = 0;
+    self->ring_count = 0;
+    self->dma_buffers[0] = m_new(uint32_t, words_per_buffer);
+    self->dma_buffers[1] = m_new(uint32_t, words_per_buffer);
+    // The heap is 16 byte aligned like descriptors need to be.
+    self->second_descriptor = m_new_obj(DmacDescriptor);
+    self->blocks_done = 0;
+
+    uint8_t dma_channel = audio_dma_allocate_channel();
+    if (dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        mp_raise_RuntimeError(translate("No DMA channel found"));
+    }
+    uint8_t event_channel = find_sync_event_channel();
+    if (event_channel >= EVSYS_SYNCH_NUM) {
+        audio_dma_free_channel(dma_channel);
+        mp_raise_RuntimeError(translate("All sync event channels in use"));
+    }
+    self->dma_channel = dma_channel;
+    self->event_channel = event_channel;
+    background_channel = dma_channel;
+    MP_STATE_PORT(playing_audio)[dma_channel] = self;
+
+    DmacDescriptor* first_descriptor = dma_descriptor(dma_channel);
+    setup_background_descriptor(self, first_descriptor, self->dma_buffers[0], words_per_buffer,
+                                self->second_descriptor);
+    setup_background_descriptor(self, self->second_descriptor, self->dma_buffers[1],
+                                words_per_buffer, first_descriptor);
+
+    uint8_t trigger_source = I2S_DMAC_ID_RX_0;
+    #ifdef SAMD21
+    trigger_source += self->serializer;
+    #endif
+
+    turn_on_event_system();
+    dma_configure(dma_channel, trigger_source, true);
+    init_event_channel_interrupt(event_channel, CORE_GCLK, EVSYS_ID_GEN_DMAC_CH_0 + dma_channel);
+    // Turn on serializer now to get it in sync with DMA.
+    i2s_set_serializer_enable(self->serializer, true);
+    audio_dma_enable_channel(dma_channel);
+}
+
+void common_hal_audiobusio_pdmin_stop(audiobusio_pdmin_obj_t* self) {
+    if (!common_hal_audiobusio_pdmin_get_recording(self)) {
+        return;
+    }
+    disable_event_channel(self->event_channel);
+    audio_dma_free_channel(self->dma_channel);
+    // Turn off serializer, but leave clock on, to avoid mic startup delay.
+    i2s_set_serializer_enable(self->serializer, false);
+    MP_STATE_PORT(playing_audio)[self->dma_channel] = NULL;
+    background_channel = AUDIO_DMA_CHANNEL_COUNT;
+    self->dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    // Samples already recorded can still be read.
+    self->dma_buffers[0] = NULL;
+    self->dma_buffers[1] = NULL;
+    self->second_descriptor = NULL;
+}
+
+bool common_hal_audiobusio_pdmin_get_recording(audiobusio_pdmin_obj_t* self) {
+    return self->dma_channel < AUDIO_DMA_CHANNEL_COUNT;
+}
+
+uint32_t common_hal_audiobusio_pdmin_readinto(audiobusio_pdmin_obj_t* self,
+        uint16_t* output_buffer, uint32_t output_buffer_length) {
+    if (self->ring == NULL) {
+        return 0;
+    }
+    uint32_t count = min(output_buffer_length, self->ring_count);
+    for (uint32_t i = 0; i < count; i++) {
+        uint16_t value = self->ring[self->ring_start];
+        if (self->bit_depth == 8) {
+            // Truncate to 8 bits.
+            ((uint8_t*) output_buffer)[i] = value >> 8;
+        } else {
+            output_buffer[i] = value;
+        }
+        self->ring_start++;
+        if (self->ring_start == self->ring_length) {
+            self->ring_start = 0;
+        }
+    }
+    self->ring_count -= count;
+    return count;
+}
+
+// Filters blocks the DMA has finished into the ring. Samples that don't fit are dropped.
+void pdmin_background(void) {
+    if (background_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        return;
+    }
+    mp_obj_t obj = MP_STATE_PORT(playing_audio)[background_channel];
+    if (obj == NULL || !MP_OBJ_IS_TYPE(obj, &audiobusio_pdmin_type)) {
+        // The VM was reset and stopped the DMA.
+        background_channel = AUDIO_DMA_CHANNEL_COUNT;
+        return;
+    }
+    audiobusio_pdmin_obj_t* self = MP_OBJ_TO_PTR(obj);
+    if (!event_interrupt_active(self->event_channel)) {
+        return;
+    }
+    if (event_interrupt_overflow(self->event_channel)) {
+        // A block finished before the last one was processed. It has been overwritten since so
+        // skip it.
+        self->blocks_done++;
+    }
+    uint32_t* buffer = self->dma_buffers[self->blocks_done % 2];
+    self->blocks_done++;
+    uint8_t words_per_sample = self->bytes_per_sample / 2;
+    uint32_t end = self->ring_start + self->ring_count;
+    for (uint32_t i = 0; i < BACKGROUND_SAMPLES_PER_BUFFER; i++) {
+        if (self->ring_count == self->ring_length) {
+            break;
+        }
+        if (end >= self->ring_length) {
+            end -= self->ring_length;
+        }
+        self->ring[end] = filter_sample(buffer + i * words_per_sample);
+        end++;
+        self->ring_count++;
+    }
+}
+
 void common_hal_audiobusio_pdmin_record_to_file(audiobusio_pdmin_obj_t* self, uint8_t* buffer, uint32_t length) {
 
 }
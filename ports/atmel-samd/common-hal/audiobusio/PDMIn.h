@@ -29,6 +29,7 @@
 
 #include "common-hal/microcontroller/Pin.h"
 
+#include "audio_dma.h"
 #include "extmod/vfs_fat.h"
 #include "py/obj.h"
 
@@ -42,6 +43,16 @@ typedef struct {
     uint8_t bytes_per_sample;
     uint8_t bit_depth;
     uint8_t gclk;
+    // Background recording state. The DMA loops over two blocks that are filtered into the ring.
+    uint8_t dma_channel; // AUDIO_DMA_CHANNEL_COUNT when not recording in the background.
+    uint8_t event_channel;
+    uint32_t* dma_buffers[2];
+    DmacDescriptor* second_descriptor;
+    uint32_t blocks_done;
+    uint16_t* ring;
+    uint32_t ring_length; // In samples.
+    uint32_t ring_start;
+    uint32_t ring_count;
 } audiobusio_pdmin_obj_t;
 
 void pdmin_reset(void);
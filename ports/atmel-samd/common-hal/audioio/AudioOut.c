@@ -452,6 +452,11 @@ bool common_hal_audioio_audioout_get_paused(audioio_audioout_obj_t* self) {
     return audio_dma_get_paused(&self->left_dma);
 }
 
+// Both channels are refilled together so the left one speaks for them.
+const audioio_playback_stats_t* common_hal_audioio_audioout_get_stats(audioio_audioout_obj_t* self) {
+    return audio_dma_get_stats(&self->left_dma);
+}
+
 void common_hal_audioio_audioout_stop(audioio_audioout_obj_t* self) {
     Tc* timer = tc_insts[self->tc_index];
     timer->COUNT16.CTRLBSET.reg = TC_CTRLBSET_CMD_STOP;
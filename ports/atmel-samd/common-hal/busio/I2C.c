@@ -32,10 +32,14 @@
 #include "hal/include/hal_i2c_m_sync.h"
 #include "hal/include/hpl_i2c_m_sync.h"
 
+#include "samd/dma.h"
 #include "samd/sercom.h"
 #include "shared-bindings/microcontroller/__init__.h"
+#include "supervisor/shared/tick.h"
 #include "supervisor/shared/translate.h"
 
+#include "audio_dma.h"
+
 #include "common-hal/busio/SPI.h" // for never_reset_sercom
 
 // Number of times to try to send packet if failed.
@@ -232,6 +236,119 @@ uint8_t common_hal_busio_i2c_read(busio_i2c_obj_t *self, uint16_t addr,
     return MP_EIO;
 }
 
+STATIC uint8_t write_then_read(busio_i2c_obj_t *self, uint16_t addr,
+        const uint8_t *out_data, size_t out_len, uint8_t *in_data, size_t in_len) {
+    uint8_t status = common_hal_busio_i2c_write(self, addr, out_data, out_len, false);
+    if (status != 0) {
+        return status;
+    }
+    return common_hal_busio_i2c_read(self, addr, in_data, in_len);
+}
+
+// Longest a register read may take, including clock stretching.
+#define WRITE_READ_TIMEOUT_MS 100
+
+STATIC void send_stop(Sercom* sercom) {
+    sercom->I2CM.CTRLB.bit.CMD = 3;
+    while (sercom->I2CM.SYNCBUSY.bit.SYSOP) {}
+}
+
+// Waits for the address or byte just sent to be acknowledged.
+STATIC uint8_t wait_for_ack(Sercom* sercom, uint64_t deadline, bool address) {
+    while ((sercom->I2CM.INTFLAG.reg & (SERCOM_I2CM_INTFLAG_MB | SERCOM_I2CM_INTFLAG_SB)) == 0) {
+        if (supervisor_ticks_ms64() > deadline) {
+            send_stop(sercom);
+            return MP_ETIMEDOUT;
+        }
+    }
+    if (sercom->I2CM.STATUS.bit.BUSERR || sercom->I2CM.STATUS.bit.ARBLOST) {
+        return MP_EIO;
+    }
+    if (sercom->I2CM.STATUS.bit.RXNACK) {
+        send_stop(sercom);
+        return address ? MP_ENODEV : MP_EIO;
+    }
+    return 0;
+}
+
+// ASF sends each byte from its own interrupt flag poll and checks for errors
+// between them. Register reads are short writes followed by longer reads, so
+// the write is sent directly and the read is left to DMA with the SERCOM's
+// length counter, which NACKs the last byte and sends the stop on its own.
+uint8_t common_hal_busio_i2c_write_read(busio_i2c_obj_t *self, uint16_t addr,
+        const uint8_t *out_data, size_t out_len, uint8_t *in_data, size_t in_len) {
+    // The length counter is 8 bits.
+    if (out_len == 0 || in_len == 0 || in_len > 255) {
+        return write_then_read(self, addr, out_data, out_len, in_data, in_len);
+    }
+    uint8_t channel = audio_dma_allocate_channel();
+    if (channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        return write_then_read(self, addr, out_data, out_len, in_data, in_len);
+    }
+    Sercom* sercom = self->i2c_desc.device.hw;
+    uint64_t deadline = supervisor_ticks_ms64() + WRITE_READ_TIMEOUT_MS;
+
+    sercom->I2CM.ADDR.reg = SERCOM_I2CM_ADDR_ADDR(addr << 1);
+    while (sercom->I2CM.SYNCBUSY.bit.SYSOP) {}
+    uint8_t status = wait_for_ack(sercom, deadline, true);
+    for (size_t i = 0; i < out_len && status == 0; i++) {
+        sercom->I2CM.DATA.reg = out_data[i];
+        while (sercom->I2CM.SYNCBUSY.bit.SYSOP) {}
+        status = wait_for_ack(sercom, deadline, false);
+    }
+    if (status != 0) {
+        audio_dma_free_channel(channel);
+        return status;
+    }
+
+    uint8_t sercom_index = 0;
+    while (sercom_insts[sercom_index] != sercom) {
+        sercom_index++;
+    }
+    DmacDescriptor* descriptor = dma_descriptor(channel);
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_DSTINC;
+    descriptor->BTCNT.reg = in_len;
+    descriptor->SRCADDR.reg = (uint32_t) &sercom->I2CM.DATA.reg;
+    descriptor->DSTADDR.reg = (uint32_t) (in_data + in_len);
+    descriptor->DESCADDR.reg = 0;
+    dma_configure(channel, SERCOM0_DMAC_ID_RX + 2 * sercom_index, false);
+    dma_enable_channel(channel);
+
+    // DMA reads need smart mode to acknowledge each byte as it's read. ASF
+    // acknowledges bytes itself so it's turned back off afterwards.
+    sercom->I2CM.CTRLB.bit.SMEN = 1;
+    sercom->I2CM.CTRLB.bit.ACKACT = 0;
+    // Writing the address again while the bus is held sends a repeated start.
+    sercom->I2CM.ADDR.reg = SERCOM_I2CM_ADDR_ADDR((addr << 1) | 1) |
+                            SERCOM_I2CM_ADDR_LENEN |
+                            SERCOM_I2CM_ADDR_LEN(in_len);
+    while (sercom->I2CM.SYNCBUSY.bit.SYSOP) {}
+
+    while ((dma_transfer_status(channel) & (DMAC_CHINTFLAG_TCMPL | DMAC_CHINTFLAG_TERR)) == 0) {
+        // Master on bus is only set during a read when the address isn't
+        // acknowledged or the bus is lost.
+        if (sercom->I2CM.INTFLAG.bit.MB || sercom->I2CM.INTFLAG.bit.ERROR) {
+            status = sercom->I2CM.STATUS.bit.RXNACK ? MP_ENODEV : MP_EIO;
+            send_stop(sercom);
+            break;
+        }
+        if (supervisor_ticks_ms64() > deadline) {
+            status = MP_ETIMEDOUT;
+            send_stop(sercom);
+            break;
+        }
+    }
+    if (status == 0 && (dma_transfer_status(channel) & DMAC_CHINTFLAG_TERR) != 0) {
+        status = MP_EIO;
+    }
+    audio_dma_free_channel(channel);
+
+    // Wait for the stop to go out before ASF gets the bus back.
+    while (sercom->I2CM.STATUS.bit.BUSSTATE != 1 && supervisor_ticks_ms64() <= deadline) {}
+    sercom->I2CM.CTRLB.bit.SMEN = 0;
+    return status;
+}
+
 void common_hal_busio_i2c_never_reset(busio_i2c_obj_t *self) {
     never_reset_sercom(self->i2c_desc.device.hw);
 
@@ -41,6 +41,8 @@
 #include "samd/dma.h"
 #include "samd/sercom.h"
 
+#include "audio_dma.h"
+
 bool never_reset_sercoms[SERCOM_INST_NUM];
 
 void never_reset_sercom(Sercom* sercom) {
@@ -229,6 +231,9 @@ void common_hal_busio_spi_construct(busio_spi_obj_t *self,
         claim_pin(miso);
     }
 
+    self->tx_channel = AUDIO_DMA_CHANNEL_COUNT;
+    self->rx_channel = AUDIO_DMA_CHANNEL_COUNT;
+
     spi_m_sync_enable(&self->spi_desc);
 }
 
@@ -240,6 +245,123 @@ void common_hal_busio_spi_never_reset(busio_spi_obj_t *self) {
     never_reset_pin_number(self->MISO_pin);
 }
 
+// Background transfers borrow audio DMA channels rather than the shared SERCOM
+// channels, which other buses use for blocking transfers while this one runs.
+STATIC void spi_dma_descriptor(DmacDescriptor* descriptor, uint32_t src, bool src_inc, uint32_t dst, bool dst_inc, size_t len) {
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID |
+                             DMAC_BTCTRL_BEATSIZE_BYTE |
+                             (src_inc ? DMAC_BTCTRL_SRCINC : 0) |
+                             (dst_inc ? DMAC_BTCTRL_DSTINC : 0);
+    descriptor->BTCNT.reg = len;
+    // Incrementing addresses point at the end of the block.
+    descriptor->SRCADDR.reg = src + (src_inc ? len : 0);
+    descriptor->DSTADDR.reg = dst + (dst_inc ? len : 0);
+    descriptor->DESCADDR.reg = 0;
+}
+
+// SERCOMn's DMA triggers follow SERCOM0's.
+STATIC uint8_t sercom_dma_index(Sercom* sercom) {
+    Sercom* sercom_insts[SERCOM_INST_NUM] = SERCOM_INSTS;
+    uint8_t sercom_index = 0;
+    while (sercom_insts[sercom_index] != sercom) {
+        sercom_index++;
+    }
+    return sercom_index;
+}
+
+// Starts a DMA transfer that carries on after returning. data_out may be NULL
+// to send write_value instead and data_in may be NULL to ignore what's read.
+// Returns false if the transfer can't run in the background.
+STATIC bool start_dma(busio_spi_obj_t *self, const uint8_t *data_out, uint8_t *data_in, size_t len, uint8_t write_value) {
+    // Short transfers aren't worth it and the block count is 16 bits.
+    if (len < 16 || len > 0xffff) {
+        return false;
+    }
+    uint8_t tx_channel = audio_dma_allocate_channel();
+    if (tx_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        return false;
+    }
+    uint8_t rx_channel = AUDIO_DMA_CHANNEL_COUNT;
+    if (data_in != NULL) {
+        rx_channel = audio_dma_allocate_channel();
+        if (rx_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+            audio_dma_free_channel(tx_channel);
+            return false;
+        }
+    }
+
+    Sercom* sercom = self->spi_desc.dev.prvt;
+    uint8_t sercom_index = sercom_dma_index(sercom);
+    uint32_t data_reg = (uint32_t) &sercom->SPI.DATA.reg;
+
+    // Throw away anything left over so it doesn't end up in data_in.
+    while (sercom->SPI.INTFLAG.bit.RXC == 1) {
+        (void) sercom->SPI.DATA.reg;
+    }
+
+    // Set up RX first so it doesn't miss the first byte. TX clocks the bus.
+    if (data_in != NULL) {
+        spi_dma_descriptor(dma_descriptor(rx_channel), data_reg, false, (uint32_t) data_in, true, len);
+        dma_configure(rx_channel, SERCOM0_DMAC_ID_RX + 2 * sercom_index, false);
+    }
+    self->write_value = write_value;
+    if (data_out != NULL) {
+        spi_dma_descriptor(dma_descriptor(tx_channel), (uint32_t) data_out, true, data_reg, false, len);
+    } else {
+        spi_dma_descriptor(dma_descriptor(tx_channel), (uint32_t) &self->write_value, false, data_reg, false, len);
+    }
+    dma_configure(tx_channel, SERCOM0_DMAC_ID_TX + 2 * sercom_index, false);
+
+    self->tx_channel = tx_channel;
+    self->rx_channel = rx_channel;
+    if (data_in != NULL) {
+        dma_enable_channel(rx_channel);
+    }
+    dma_enable_channel(tx_channel);
+    return true;
+}
+
+// Returns true while a background transfer is running and cleans up after it
+// once it's done.
+STATIC bool transfer_in_progress(busio_spi_obj_t *self) {
+    if (self->tx_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        return false;
+    }
+    Sercom* sercom = self->spi_desc.dev.prvt;
+    // Channels go through suspended, pending and busy until the transfer
+    // completes or fails.
+    if ((dma_transfer_status(self->tx_channel) & (DMAC_CHINTFLAG_TCMPL | DMAC_CHINTFLAG_TERR)) == 0) {
+        return true;
+    }
+    if (self->rx_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        if ((dma_transfer_status(self->rx_channel) & (DMAC_CHINTFLAG_TCMPL | DMAC_CHINTFLAG_TERR)) == 0) {
+            return true;
+        }
+        audio_dma_free_channel(self->rx_channel);
+        self->rx_channel = AUDIO_DMA_CHANNEL_COUNT;
+    } else {
+        // Wait for the last byte to go out.
+        if (sercom->SPI.INTFLAG.bit.TXC == 0) {
+            return true;
+        }
+        // Nothing read the received bytes so throw them away and clear the
+        // overflow.
+        while (sercom->SPI.INTFLAG.bit.RXC == 1) {
+            (void) sercom->SPI.DATA.reg;
+        }
+        sercom->SPI.STATUS.bit.BUFOVF = 1;
+        sercom->SPI.INTFLAG.reg = SERCOM_SPI_INTFLAG_ERROR;
+    }
+    audio_dma_free_channel(self->tx_channel);
+    self->tx_channel = AUDIO_DMA_CHANNEL_COUNT;
+    return false;
+}
+
+STATIC void wait_for_transfer(busio_spi_obj_t *self) {
+    while (transfer_in_progress(self)) {
+    }
+}
+
 bool common_hal_busio_spi_deinited(busio_spi_obj_t *self) {
     return self->clock_pin == NO_PIN;
 }
@@ -248,6 +370,7 @@ void common_hal_busio_spi_deinit(busio_spi_obj_t *self) {
     if (common_hal_busio_spi_deinited(self)) {
         return;
     }
+    wait_for_transfer(self);
     allow_reset_sercom(self->spi_desc.dev.prvt);
 
     spi_m_sync_disable(&self->spi_desc);
@@ -261,6 +384,7 @@ void common_hal_busio_spi_deinit(busio_spi_obj_t *self) {
 bool common_hal_busio_spi_configure(busio_spi_obj_t *self,
         uint32_t baudrate, uint8_t polarity, uint8_t phase, uint8_t bits) {
     uint8_t baud_reg_value = samd_peripherals_spi_baudrate_to_baud_reg_value(baudrate);
+    wait_for_transfer(self);
 
     void * hw = self->spi_desc.dev.prvt;
     // If the settings are already what we want then don't reset them.
@@ -311,6 +435,7 @@ bool common_hal_busio_spi_write(busio_spi_obj_t *self,
     if (len == 0) {
         return true;
     }
+    wait_for_transfer(self);
     int32_t status;
     if (len >= 16) {
         status = sercom_dma_write(self->spi_desc.dev.prvt, data, len);
@@ -322,11 +447,32 @@ bool common_hal_busio_spi_write(busio_spi_obj_t *self,
     return status >= 0; // Status is number of chars read or an error code < 0.
 }
 
+bool common_hal_busio_spi_start_write(busio_spi_obj_t *self, const uint8_t *data, size_t len) {
+    wait_for_transfer(self);
+    if (start_dma(self, data, NULL, len, 0)) {
+        return true;
+    }
+    return common_hal_busio_spi_write(self, data, len);
+}
+
+bool common_hal_busio_spi_start_read(busio_spi_obj_t *self, uint8_t *data, size_t len, uint8_t write_value) {
+    wait_for_transfer(self);
+    if (start_dma(self, NULL, data, len, write_value)) {
+        return true;
+    }
+    return common_hal_busio_spi_read(self, data, len, write_value);
+}
+
+bool common_hal_busio_spi_transfer_in_progress(busio_spi_obj_t *self) {
+    return transfer_in_progress(self);
+}
+
 bool common_hal_busio_spi_read(busio_spi_obj_t *self,
         uint8_t *data, size_t len, uint8_t write_value) {
     if (len == 0) {
         return true;
     }
+    wait_for_transfer(self);
     int32_t status;
     if (len >= 16) {
         status = sercom_dma_read(self->spi_desc.dev.prvt, data, len, write_value);
@@ -345,6 +491,7 @@ bool common_hal_busio_spi_transfer(busio_spi_obj_t *self, uint8_t *data_out, uin
     if (len == 0) {
         return true;
     }
+    wait_for_transfer(self);
     int32_t status;
     if (len >= 16) {
         status = sercom_dma_transfer(self->spi_desc.dev.prvt, data_out, data_in, len);
@@ -358,6 +505,115 @@ bool common_hal_busio_spi_transfer(busio_spi_obj_t *self, uint8_t *data_out, uin
     return status >= 0; // Status is number of chars read or an error code < 0.
 }
 
+STATIC bool transaction_one_by_one(busio_spi_obj_t *self, const busio_spi_segment_t *segments, size_t count, uint8_t write_value) {
+    for (size_t i = 0; i < count; i++) {
+        const busio_spi_segment_t *segment = &segments[i];
+        bool ok;
+        if (segment->in == NULL) {
+            ok = common_hal_busio_spi_write(self, segment->out, segment->len);
+        } else if (segment->out == NULL) {
+            ok = common_hal_busio_spi_read(self, segment->in, segment->len, write_value);
+        } else {
+            ok = common_hal_busio_spi_transfer(self, (uint8_t*) segment->out, segment->in, segment->len);
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Read segments with nothing to keep are received here.
+STATIC uint8_t dma_discard;
+
+bool common_hal_busio_spi_transaction(busio_spi_obj_t *self, const busio_spi_segment_t *segments, size_t count, uint8_t write_value) {
+    wait_for_transfer(self);
+    size_t blocks = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (segments[i].len > 0xffff) {
+            return transaction_one_by_one(self, segments, count, write_value);
+        }
+        if (segments[i].len > 0) {
+            blocks++;
+        }
+    }
+    if (blocks <= 1) {
+        return transaction_one_by_one(self, segments, count, write_value);
+    }
+
+    // The first descriptor of each channel lives in the DMAC's table and the
+    // rest are linked from it. Both channels run for every segment so that the
+    // received bytes stay in step with the sent ones.
+    DmacDescriptor* chain = m_malloc_maybe(2 * (blocks - 1) * sizeof(DmacDescriptor), false);
+    if (chain == NULL) {
+        return transaction_one_by_one(self, segments, count, write_value);
+    }
+    uint8_t tx_channel = audio_dma_allocate_channel();
+    uint8_t rx_channel = audio_dma_allocate_channel();
+    if (rx_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        if (tx_channel < AUDIO_DMA_CHANNEL_COUNT) {
+            audio_dma_free_channel(tx_channel);
+        }
+        m_free(chain);
+        return transaction_one_by_one(self, segments, count, write_value);
+    }
+
+    Sercom* sercom = self->spi_desc.dev.prvt;
+    uint32_t data_reg = (uint32_t) &sercom->SPI.DATA.reg;
+    self->write_value = write_value;
+    DmacDescriptor* tx = dma_descriptor(tx_channel);
+    DmacDescriptor* rx = dma_descriptor(rx_channel);
+    size_t block = 0;
+    for (size_t i = 0; i < count; i++) {
+        const busio_spi_segment_t *segment = &segments[i];
+        if (segment->len == 0) {
+            continue;
+        }
+        if (segment->out != NULL) {
+            spi_dma_descriptor(tx, (uint32_t) segment->out, true, data_reg, false, segment->len);
+        } else {
+            spi_dma_descriptor(tx, (uint32_t) &self->write_value, false, data_reg, false, segment->len);
+        }
+        if (segment->in != NULL) {
+            spi_dma_descriptor(rx, data_reg, false, (uint32_t) segment->in, true, segment->len);
+        } else {
+            spi_dma_descriptor(rx, data_reg, false, (uint32_t) &dma_discard, false, segment->len);
+        }
+        block++;
+        if (block < blocks) {
+            DmacDescriptor* next_tx = &chain[2 * (block - 1)];
+            DmacDescriptor* next_rx = &chain[2 * (block - 1) + 1];
+            tx->DESCADDR.reg = (uint32_t) next_tx;
+            rx->DESCADDR.reg = (uint32_t) next_rx;
+            tx = next_tx;
+            rx = next_rx;
+        }
+    }
+
+    while (sercom->SPI.INTFLAG.bit.RXC == 1) {
+        (void) sercom->SPI.DATA.reg;
+    }
+    uint8_t sercom_index = sercom_dma_index(sercom);
+    dma_configure(rx_channel, SERCOM0_DMAC_ID_RX + 2 * sercom_index, false);
+    dma_configure(tx_channel, SERCOM0_DMAC_ID_TX + 2 * sercom_index, false);
+    self->tx_channel = tx_channel;
+    self->rx_channel = rx_channel;
+    dma_enable_channel(rx_channel);
+    dma_enable_channel(tx_channel);
+
+    // Only the last descriptor of each channel reports completion. An error
+    // stops the channel wherever it is in the chain.
+    uint8_t done = DMAC_CHINTFLAG_TCMPL | DMAC_CHINTFLAG_TERR;
+    while ((dma_transfer_status(tx_channel) & done) == 0 ||
+           (dma_transfer_status(rx_channel) & done) == 0) {
+        RUN_BACKGROUND_TASKS;
+    }
+    bool failed = ((dma_transfer_status(tx_channel) | dma_transfer_status(rx_channel)) & DMAC_CHINTFLAG_TERR) != 0;
+    wait_for_transfer(self);
+    m_free(chain);
+    return !failed;
+}
+
 uint32_t common_hal_busio_spi_get_frequency(busio_spi_obj_t* self) {
     return samd_peripherals_spi_baud_reg_value_to_baudrate(hri_sercomspi_read_BAUD_reg(self->spi_desc.dev.prvt));
 }
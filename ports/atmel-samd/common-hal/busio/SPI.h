@@ -40,6 +40,12 @@ typedef struct {
     uint8_t clock_pin;
     uint8_t MOSI_pin;
     uint8_t MISO_pin;
+    // Audio DMA channels of a background transfer, AUDIO_DMA_CHANNEL_COUNT
+    // when not in use.
+    uint8_t tx_channel;
+    uint8_t rx_channel;
+    // Sent for every byte of a background read.
+    uint8_t write_value;
 } busio_spi_obj_t;
 
 void reset_sercoms(void);
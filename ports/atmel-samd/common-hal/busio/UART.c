@@ -24,6 +24,8 @@
  * THE SOFTWARE.
  */
 
+#include <string.h>
+
 #include "shared-bindings/microcontroller/__init__.h"
 #include "shared-bindings/busio/UART.h"
 
@@ -43,14 +45,116 @@
 #include "hal/include/hal_usart_async.h"
 #include "hal/include/hpl_usart_async.h"
 
+#include "samd/dma.h"
 #include "samd/sercom.h"
 
+#include "audio_dma.h"
+
 // Do-nothing callback needed so that usart_async code will enable rx interrupts.
 // See comment below re usart_async_register_callback()
 static void usart_async_rxc_callback(const struct usart_async_descriptor *const descr) {
     // Nothing needs to be done by us.
 }
 
+STATIC uint8_t sercom_dma_index(Sercom* sercom) {
+    uint8_t sercom_index = 0;
+    while (sercom_insts[sercom_index] != sercom) {
+        sercom_index++;
+    }
+    return sercom_index;
+}
+
+// Receives into buffer forever by pointing the descriptor back at itself.
+STATIC void start_rx_dma(busio_uart_obj_t *self) {
+    Sercom* sercom = self->usart_desc.device.hw;
+    DmacDescriptor* descriptor = dma_descriptor(self->rx_dma_channel);
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_DSTINC;
+    descriptor->BTCNT.reg = self->buffer_length;
+    descriptor->SRCADDR.reg = (uint32_t) &sercom->USART.DATA.reg;
+    descriptor->DSTADDR.reg = (uint32_t) (self->buffer + self->buffer_length);
+    descriptor->DESCADDR.reg = (uint32_t) descriptor;
+    dma_configure(self->rx_dma_channel, SERCOM0_DMAC_ID_RX + 2 * sercom_dma_index(sercom), false);
+    self->rx_read_index = 0;
+    self->rx_write_index = 0;
+    self->rx_count = 0;
+    dma_enable_channel(self->rx_dma_channel);
+}
+
+// Where DMA will write the next received byte.
+STATIC uint32_t rx_dma_position(busio_uart_obj_t *self) {
+    uint32_t remaining;
+    // The running channel's count is only in ACTIVE. Others are written back
+    // to memory between beats.
+    if (DMAC->ACTIVE.bit.ABUSY && DMAC->ACTIVE.bit.ID == self->rx_dma_channel) {
+        remaining = DMAC->ACTIVE.bit.BTCNT;
+    } else {
+        DmacDescriptor* write_back = (DmacDescriptor*) DMAC->WRBADDR.reg;
+        remaining = write_back[self->rx_dma_channel].BTCNT.reg;
+    }
+    if (remaining == 0 || remaining > self->buffer_length) {
+        return 0;
+    }
+    return self->buffer_length - remaining;
+}
+
+// Catches up with what DMA has received since last time. More than a buffer's
+// worth between calls is only noticed as a single buffer's worth, so the count
+// of overruns is a lower bound.
+STATIC void rx_dma_update(busio_uart_obj_t *self) {
+    Sercom* sercom = self->usart_desc.device.hw;
+    if (sercom->USART.STATUS.bit.BUFOVF) {
+        sercom->USART.STATUS.reg = SERCOM_USART_STATUS_BUFOVF;
+        self->rx_overruns++;
+    }
+    uint32_t write_index = rx_dma_position(self);
+    uint32_t received = (write_index + self->buffer_length - self->rx_write_index) % self->buffer_length;
+    self->rx_write_index = write_index;
+    self->rx_count += received;
+    if (self->rx_count >= self->buffer_length) {
+        // The oldest unread bytes have been written over. Keep the newest.
+        self->rx_overruns++;
+        self->rx_count = self->buffer_length - 1;
+        self->rx_read_index = (write_index + 1) % self->buffer_length;
+    }
+}
+
+STATIC size_t rx_dma_read(busio_uart_obj_t *self, uint8_t *data, size_t len) {
+    rx_dma_update(self);
+    size_t count = MIN(len, self->rx_count);
+    size_t first = MIN(count, self->buffer_length - self->rx_read_index);
+    memcpy(data, self->buffer + self->rx_read_index, first);
+    memcpy(data + first, self->buffer, count - first);
+    self->rx_read_index = (self->rx_read_index + count) % self->buffer_length;
+    self->rx_count -= count;
+    return count;
+}
+
+// Sends data straight from the caller's buffer. Returns false if there's no DMA
+// channel free.
+STATIC bool tx_dma_write(busio_uart_obj_t *self, const uint8_t *data, size_t len) {
+    if (len > 0xffff) {
+        return false;
+    }
+    uint8_t channel = audio_dma_allocate_channel();
+    if (channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        return false;
+    }
+    Sercom* sercom = self->usart_desc.device.hw;
+    DmacDescriptor* descriptor = dma_descriptor(channel);
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_SRCINC;
+    descriptor->BTCNT.reg = len;
+    descriptor->SRCADDR.reg = (uint32_t) (data + len);
+    descriptor->DSTADDR.reg = (uint32_t) &sercom->USART.DATA.reg;
+    descriptor->DESCADDR.reg = 0;
+    dma_configure(channel, SERCOM0_DMAC_ID_TX + 2 * sercom_dma_index(sercom), false);
+    dma_enable_channel(channel);
+    while ((dma_transfer_status(channel) & (DMAC_CHINTFLAG_TCMPL | DMAC_CHINTFLAG_TERR)) == 0) {
+        RUN_BACKGROUND_TASKS;
+    }
+    audio_dma_free_channel(channel);
+    return true;
+}
+
 void common_hal_busio_uart_construct(busio_uart_obj_t *self,
         const mcu_pin_obj_t * tx, const mcu_pin_obj_t * rx, uint32_t baudrate,
         uint8_t bits, uart_parity_t parity, uint8_t stop, mp_float_t timeout,
@@ -75,6 +179,8 @@ void common_hal_busio_uart_construct(busio_uart_obj_t *self,
     self->baudrate = baudrate;
     self->character_bits = bits;
     self->timeout_ms = timeout * 1000;
+    self->rx_dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    self->rx_overruns = 0;
 
     // This assignment is only here because the usart_async routines take a *const argument.
     struct usart_async_descriptor * const usart_desc_p = (struct usart_async_descriptor * const) &self->usart_desc;
@@ -202,6 +308,11 @@ void common_hal_busio_uart_construct(busio_uart_obj_t *self,
     // Set baud rate
     common_hal_busio_uart_set_baudrate(self, baudrate);
 
+    // Receiving by DMA doesn't lose bytes while interrupts are held off.
+    if (have_rx && self->buffer != NULL) {
+        self->rx_dma_channel = audio_dma_allocate_channel();
+    }
+
     // Turn on rx interrupt handling. The UART async driver has its own set of internal callbacks,
     // which are set up by uart_async_init(). These in turn can call user-specified callbacks.
     // In fact, the actual interrupts are not enabled unless we set up a user-specified callback.
@@ -209,8 +320,9 @@ void common_hal_busio_uart_construct(busio_uart_obj_t *self,
     // Different read function behavior in some asynchronous drivers. As of this writing:
     // http://start.atmel.com/static/help/index.html?GUID-79201A5A-226F-4FBB-B0B8-AB0BE0554836
     // Look at the ASFv4 code example for async USART.
-    usart_async_register_callback(usart_desc_p, USART_ASYNC_RXC_CB, usart_async_rxc_callback);
-
+    if (self->rx_dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        usart_async_register_callback(usart_desc_p, USART_ASYNC_RXC_CB, usart_async_rxc_callback);
+    }
 
     if (have_tx) {
         gpio_set_pin_direction(tx->number, GPIO_DIRECTION_OUT);
@@ -233,6 +345,10 @@ void common_hal_busio_uart_construct(busio_uart_obj_t *self,
     }
 
     usart_async_enable(usart_desc_p);
+
+    if (self->rx_dma_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        start_rx_dma(self);
+    }
 }
 
 bool common_hal_busio_uart_deinited(busio_uart_obj_t *self) {
@@ -245,6 +361,10 @@ void common_hal_busio_uart_deinit(busio_uart_obj_t *self) {
     }
     // This assignment is only here because the usart_async routines take a *const argument.
     struct usart_async_descriptor * const usart_desc_p = (struct usart_async_descriptor * const) &self->usart_desc;
+    if (self->rx_dma_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        audio_dma_free_channel(self->rx_dma_channel);
+        self->rx_dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    }
     usart_async_disable(usart_desc_p);
     usart_async_deinit(usart_desc_p);
     reset_pin_number(self->rx_pin);
@@ -276,7 +396,12 @@ size_t common_hal_busio_uart_read(busio_uart_obj_t *self, uint8_t *data, size_t
     // Busy-wait until timeout or until we've read enough chars.
     while (supervisor_ticks_ms64() - start_ticks <= self->timeout_ms) {
         // Read as many chars as we can right now, up to len.
-        size_t num_read = io_read(io, data, len);
+        size_t num_read;
+        if (self->rx_dma_channel < AUDIO_DMA_CHANNEL_COUNT) {
+            num_read = rx_dma_read(self, data, len);
+        } else {
+            num_read = io_read(io, data, len);
+        }
 
         // Advance pointer in data buffer, and decrease how many chars left to read.
         data += num_read;
@@ -319,6 +444,10 @@ size_t common_hal_busio_uart_write(busio_uart_obj_t *self, const uint8_t *data,
     // This assignment is only here because the usart_async routines take a *const argument.
     struct usart_async_descriptor * const usart_desc_p = (struct usart_async_descriptor * const) &self->usart_desc;
 
+    if (len == 0 || tx_dma_write(self, data, len)) {
+        return len;
+    }
+
     struct io_descriptor *io;
     usart_async_get_io_descriptor(usart_desc_p, &io);
 
@@ -370,6 +499,10 @@ void common_hal_busio_uart_set_timeout(busio_uart_obj_t *self, mp_float_t timeou
 }
 
 uint32_t common_hal_busio_uart_rx_characters_available(busio_uart_obj_t *self) {
+    if (self->rx_dma_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        rx_dma_update(self);
+        return self->rx_count;
+    }
     // This assignment is only here because the usart_async routines take a *const argument.
     struct usart_async_descriptor * const usart_desc_p = (struct usart_async_descriptor * const) &self->usart_desc;
     struct usart_async_status async_status;
@@ -378,6 +511,12 @@ uint32_t common_hal_busio_uart_rx_characters_available(busio_uart_obj_t *self) {
 }
 
 void common_hal_busio_uart_clear_rx_buffer(busio_uart_obj_t *self) {
+    if (self->rx_dma_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        rx_dma_update(self);
+        self->rx_read_index = self->rx_write_index;
+        self->rx_count = 0;
+        return;
+    }
     // This assignment is only here because the usart_async routines take a *const argument.
     struct usart_async_descriptor * const usart_desc_p = (struct usart_async_descriptor * const) &self->usart_desc;
     usart_async_flush_rx_buffer(usart_desc_p);
@@ -395,3 +534,10 @@ bool common_hal_busio_uart_ready_to_tx(busio_uart_obj_t *self) {
     usart_async_get_status(usart_desc_p, &async_status);
     return !(async_status.flags & USART_ASYNC_STATUS_BUSY);
 }
+
+uint32_t common_hal_busio_uart_get_rx_overruns(busio_uart_obj_t *self) {
+    if (self->rx_dma_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        rx_dma_update(self);
+    }
+    return self->rx_overruns;
+}
@@ -44,6 +44,13 @@ typedef struct {
     uint32_t timeout_ms;
     uint32_t buffer_length;
     uint8_t* buffer;
+    // DMA writes received bytes around buffer unless rx_dma_channel is
+    // AUDIO_DMA_CHANNEL_COUNT, when ASF receives them by interrupt instead.
+    uint8_t rx_dma_channel;
+    uint32_t rx_read_index;
+    uint32_t rx_write_index;
+    uint32_t rx_count;
+    uint32_t rx_overruns;
 } busio_uart_obj_t;
 
 #endif // MICROPY_INCLUDED_ATMEL_SAMD_COMMON_HAL_BUSIO_UART_H
@@ -0,0 +1,206 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "common-hal/countio/Counter.h"
+
+#include <stdint.h>
+
+#include "atmel_start_pins.h"
+#include "hal/include/hal_gpio.h"
+
+#include "mpconfigport.h"
+#include "py/runtime.h"
+#include "samd/events.h"
+#include "samd/external_interrupts.h"
+#include "samd/pins.h"
+#include "samd/timers.h"
+#include "shared-bindings/countio/Counter.h"
+#include "shared-bindings/microcontroller/__init__.h"
+#include "supervisor/shared/translate.h"
+
+#include "timer_handler.h"
+
+static countio_counter_obj_t* active_counters[TC_INST_NUM];
+
+void counter_interrupt_handler(uint8_t index) {
+    countio_counter_obj_t* self = active_counters[index];
+    Tc* tc = tc_insts[index];
+    if (self == NULL || !tc->COUNT16.INTFLAG.bit.OVF) {
+        return;
+    }
+    tc->COUNT16.INTFLAG.reg = TC_INTFLAG_OVF;
+    self->overflows++;
+}
+
+void counter_reset(void) {
+    for (uint8_t i = 0; i < TC_INST_NUM; i++) {
+        active_counters[i] = NULL;
+    }
+}
+
+STATIC void set_eic_event_output(uint8_t channel, bool enable) {
+    eic_set_enable(false);
+    #ifdef SAMD21
+    uint32_t masked_value = EIC->EVCTRL.vec.EXTINTEO & ~(1 << channel);
+    EIC->EVCTRL.vec.EXTINTEO = masked_value | (enable ? 1 << channel : 0);
+    #endif
+    #ifdef SAMD51
+    uint32_t masked_value = EIC->EVCTRL.bit.EXTINTEO & ~(1 << channel);
+    EIC->EVCTRL.bit.EXTINTEO = masked_value | (enable ? 1 << channel : 0);
+    #endif
+    eic_set_enable(true);
+}
+
+STATIC uint16_t read_count(Tc* tc) {
+    #ifdef SAMD21
+    tc->COUNT16.READREQ.reg = TC_READREQ_RREQ | TC_READREQ_ADDR(TC_COUNT16_COUNT_OFFSET);
+    while (tc->COUNT16.STATUS.bit.SYNCBUSY == 1) {
+    }
+    #endif
+    #ifdef SAMD51
+    tc->COUNT16.CTRLBSET.bit.CMD = TC_CTRLBSET_CMD_READSYNC_Val;
+    while ((tc->COUNT16.SYNCBUSY.bit.COUNT == 1) ||
+           (tc->COUNT16.CTRLBSET.bit.CMD == TC_CTRLBSET_CMD_READSYNC_Val)) {
+    }
+    #endif
+    return tc->COUNT16.COUNT.reg;
+}
+
+// Edges since the counter started, mod 2**32. The TC keeps counting
+// throughout, so nothing is missed between reads.
+STATIC uint32_t total_count(countio_counter_obj_t* self) {
+    Tc* tc = tc_insts[self->tc_index];
+    common_hal_mcu_disable_interrupts();
+    uint16_t count = read_count(tc);
+    uint32_t overflows = self->overflows;
+    if (tc->COUNT16.INTFLAG.bit.OVF) {
+        // The count wrapped but the interrupt hasn't run yet. Read it again
+        // so that it's certainly from after the wrap.
+        overflows++;
+        count = read_count(tc);
+    }
+    common_hal_mcu_enable_interrupts();
+    return (overflows << 16) | count;
+}
+
+void common_hal_countio_counter_construct(countio_counter_obj_t* self, const mcu_pin_obj_t* pin) {
+    if (!pin->has_extint) {
+        mp_raise_RuntimeError(translate("No hardware support on pin"));
+    }
+    if (eic_get_enable() && !eic_channel_free(pin->extint_channel)) {
+        mp_raise_RuntimeError(translate("EXTINT channel already in use"));
+    }
+    uint8_t tc_index = find_free_timer();
+    if (tc_index == 0xff) {
+        mp_raise_RuntimeError(translate("All timers in use"));
+    }
+    turn_on_event_system();
+    uint8_t event_channel = find_async_event_channel();
+    if (event_channel >= EVSYS_CHANNELS) {
+        mp_raise_RuntimeError(translate("All event channels in use"));
+    }
+
+    self->pin = pin->number;
+    self->channel = pin->extint_channel;
+    self->tc_index = tc_index;
+    self->event_channel = event_channel;
+    self->overflows = 0;
+    self->reset_total = 0;
+    active_counters[tc_index] = self;
+
+    gpio_set_pin_function(pin->number, GPIO_PIN_FUNCTION_A);
+    claim_pin(pin);
+
+    uint8_t tc_gclk = 0;
+    #ifdef SAMD51
+    tc_gclk = 1;
+    #endif
+    set_timer_handler(true, tc_index, TC_HANDLER_COUNTER);
+    turn_on_clocks(true, tc_index, tc_gclk);
+    Tc* tc = tc_insts[tc_index];
+    tc_set_enable(tc, false);
+    tc_reset(tc);
+    // Each event increments the count instead of the clock.
+    tc->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 | TC_CTRLA_PRESCALER_DIV1;
+    #ifdef SAMD21
+    tc->COUNT16.EVCTRL.reg = TC_EVCTRL_EVACT_COUNT | TC_EVCTRL_TCEI;
+    connect_event_user_to_channel(EVSYS_ID_USER_TC3_EVU + tc_index, event_channel);
+    #endif
+    #ifdef SAMD51
+    tc->COUNT16.EVCTRL.reg = TC_EVCTRL_EVACT(TC_EVCTRL_EVACT_COUNT_Val) | TC_EVCTRL_TCEI;
+    connect_event_user_to_channel(EVSYS_ID_USER_TC0_EVU + tc_index, event_channel);
+    #endif
+    init_async_event_channel(event_channel, EVSYS_ID_GEN_EIC_EXTINT_0 + self->channel);
+    tc->COUNT16.INTENSET.reg = TC_INTENSET_OVF;
+    tc_enable_interrupts(tc_index);
+
+    // Rising edges generate an event but no interrupt.
+    if (eic_get_enable() == 0) {
+        turn_on_external_interrupt_controller();
+    }
+    configure_eic_channel(self->channel, EIC_CONFIG_SENSE0_RISE_Val);
+    set_eic_event_output(self->channel, true);
+    tc_set_enable(tc, true);
+}
+
+bool common_hal_countio_counter_deinited(countio_counter_obj_t* self) {
+    return self->pin == NO_PIN;
+}
+
+void common_hal_countio_counter_deinit(countio_counter_obj_t* self) {
+    if (common_hal_countio_counter_deinited(self)) {
+        return;
+    }
+    set_eic_event_output(self->channel, false);
+    turn_off_eic_channel(self->channel);
+    disable_event_channel(self->event_channel);
+    #ifdef SAMD21
+    disable_event_user(EVSYS_ID_USER_TC3_EVU + self->tc_index);
+    #endif
+    #ifdef SAMD51
+    disable_event_user(EVSYS_ID_USER_TC0_EVU + self->tc_index);
+    #endif
+    tc_disable_interrupts(self->tc_index);
+    Tc* tc = tc_insts[self->tc_index];
+    tc_set_enable(tc, false);
+    tc_reset(tc);
+    set_timer_handler(true, self->tc_index, TC_HANDLER_NO_INTERRUPT);
+    active_counters[self->tc_index] = NULL;
+
+    reset_pin_number(self->pin);
+    self->pin = NO_PIN;
+}
+
+uint32_t common_hal_countio_counter_get_count(countio_counter_obj_t* self) {
+    return total_count(self) - self->reset_total;
+}
+
+uint32_t common_hal_countio_counter_reset(countio_counter_obj_t* self) {
+    uint32_t total = total_count(self);
+    uint32_t count = total - self->reset_total;
+    self->reset_total = total;
+    return count;
+}
@@ -0,0 +1,91 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/digitalio/PortIn.h"
+
+#include "hal/include/hal_gpio.h"
+#include "py/runtime.h"
+#include "supervisor/shared/translate.h"
+
+void digitalio_port_construct(digitalio_port_obj_t* self, const mcu_pin_obj_t** pins, size_t num_pins) {
+    uint8_t group = GPIO_PORT(pins[0]->number);
+    uint8_t first = GPIO_PIN(pins[0]->number);
+    for (size_t i = 0; i < num_pins; i++) {
+        if (GPIO_PORT(pins[i]->number) != group) {
+            mp_raise_ValueError(translate("Pins must be on the same port"));
+        }
+    }
+
+    self->group = group;
+    self->num_pins = num_pins;
+    self->mask = 0;
+    self->shift = first;
+    for (size_t i = 0; i < num_pins; i++) {
+        uint8_t pin = pins[i]->number;
+        self->pins[i] = pin;
+        self->mask |= 1u << GPIO_PIN(pin);
+        if (GPIO_PIN(pin) != first + i) {
+            self->shift = -1;
+        }
+        claim_pin(pins[i]);
+    }
+}
+
+void digitalio_port_deinit(digitalio_port_obj_t* self) {
+    for (size_t i = 0; i < self->num_pins; i++) {
+        reset_pin_number(self->pins[i]);
+    }
+    self->num_pins = 0;
+}
+
+void common_hal_digitalio_portin_construct(digitalio_portin_obj_t* self,
+    const mcu_pin_obj_t** pins, size_t num_pins, digitalio_pull_t pull) {
+    digitalio_port_construct(self, pins, num_pins);
+
+    enum gpio_pull_mode asf_pull = GPIO_PULL_OFF;
+    if (pull == PULL_UP) {
+        asf_pull = GPIO_PULL_UP;
+    } else if (pull == PULL_DOWN) {
+        asf_pull = GPIO_PULL_DOWN;
+    }
+    for (size_t i = 0; i < num_pins; i++) {
+        // Must set pull after setting direction.
+        gpio_set_pin_direction(self->pins[i], GPIO_DIRECTION_IN);
+        gpio_set_pin_pull_mode(self->pins[i], asf_pull);
+    }
+}
+
+bool common_hal_digitalio_portin_deinited(digitalio_portin_obj_t* self) {
+    return self->num_pins == 0;
+}
+
+void common_hal_digitalio_portin_deinit(digitalio_portin_obj_t* self) {
+    digitalio_port_deinit(self);
+}
+
+uint32_t common_hal_digitalio_portin_get_value(digitalio_portin_obj_t* self) {
+    return digitalio_port_from_bits(self, PORT->Group[self->group].IN.reg);
+}
@@ -0,0 +1,183 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/digitalio/PortOut.h"
+
+#include "hal/include/hal_gpio.h"
+#include "lib/utils/interrupt_char.h"
+#include "py/runtime.h"
+#include "samd/dma.h"
+#include "samd/timers.h"
+#include "supervisor/shared/translate.h"
+
+#include "audio_dma.h"
+#include "timer_handler.h"
+
+#define MAX_SEQUENCE_RATE 1000000
+
+#ifdef SAMD21
+#define FIRST_TC_DMAC_ID TC3_DMAC_ID_OVF
+#endif
+#ifdef SAMD51
+#define FIRST_TC_DMAC_ID TC0_DMAC_ID_OVF
+#endif
+
+STATIC void set_timer_frequency(Tc* timer, uint32_t frequency) {
+    uint32_t system_clock = 48000000;
+    uint32_t new_top;
+    uint8_t new_divisor;
+    for (new_divisor = 0; new_divisor < 8; new_divisor++) {
+        new_top = (system_clock / prescaler[new_divisor] / frequency) - 1;
+        if (new_top < (1u << 16)) {
+            break;
+        }
+    }
+    timer->COUNT16.CTRLA.bit.PRESCALER = new_divisor;
+    tc_wait_for_sync(timer);
+    timer->COUNT16.CC[0].reg = new_top;
+    tc_wait_for_sync(timer);
+}
+
+void common_hal_digitalio_portout_construct(digitalio_portout_obj_t* self,
+    const mcu_pin_obj_t** pins, size_t num_pins, uint32_t value) {
+    digitalio_port_construct(self, pins, num_pins);
+
+    for (size_t i = 0; i < num_pins; i++) {
+        uint8_t pin = self->pins[i];
+        gpio_set_pin_pull_mode(pin, GPIO_PULL_OFF);
+        // Turn on "strong" pin driving (more current available). See DRVSTR doc in datasheet.
+        hri_port_set_PINCFG_DRVSTR_bit(PORT, (enum gpio_port)GPIO_PORT(pin), GPIO_PIN(pin));
+    }
+    // Set the levels before driving the pins so they don't glitch.
+    PortGroup* group = &PORT->Group[self->group];
+    uint32_t bits = digitalio_port_to_bits(self, value);
+    group->OUTCLR.reg = self->mask & ~bits;
+    group->OUTSET.reg = bits;
+    group->DIRSET.reg = self->mask;
+}
+
+bool common_hal_digitalio_portout_deinited(digitalio_portout_obj_t* self) {
+    return self->num_pins == 0;
+}
+
+void common_hal_digitalio_portout_deinit(digitalio_portout_obj_t* self) {
+    digitalio_port_deinit(self);
+}
+
+uint32_t common_hal_digitalio_portout_get_value(digitalio_portout_obj_t* self) {
+    return digitalio_port_from_bits(self, PORT->Group[self->group].OUT.reg);
+}
+
+void common_hal_digitalio_portout_set_value(digitalio_portout_obj_t* self, uint32_t value) {
+    // Toggling only the pins that differ changes them all with one write and leaves the rest of
+    // the group alone.
+    PortGroup* group = &PORT->Group[self->group];
+    group->OUTTGL.reg = (group->OUT.reg ^ digitalio_port_to_bits(self, value)) & self->mask;
+}
+
+STATIC uint32_t get_sequence_value(const uint8_t* values, size_t index, uint8_t bytes_per_value) {
+    switch (bytes_per_value) {
+        case 2:
+            return ((const uint16_t*) values)[index];
+        case 4:
+            return ((const uint32_t*) values)[index];
+        default:
+            return values[index];
+    }
+}
+
+void common_hal_digitalio_portout_write_sequence(digitalio_portout_obj_t* self,
+    const uint8_t* values, size_t len, uint8_t bytes_per_value, uint32_t rate) {
+    if (len == 0) {
+        return;
+    }
+    if (rate > MAX_SEQUENCE_RATE) {
+        mp_raise_ValueError_varg(translate("Sample rate too high. It must be less than %d"), MAX_SEQUENCE_RATE);
+    }
+    if (len > 0xffff) {
+        mp_raise_ValueError_varg(translate("Buffer length %d too big. It must be less than %d"), len, 0x10000);
+    }
+
+    // DMA writes OUTTGL so that only our pins change. Each value becomes the toggle from the
+    // one before it.
+    PortGroup* group = &PORT->Group[self->group];
+    uint32_t* toggles = m_new(uint32_t, len);
+    uint32_t last = group->OUT.reg & self->mask;
+    for (size_t i = 0; i < len; i++) {
+        uint32_t bits = digitalio_port_to_bits(self, get_sequence_value(values, i, bytes_per_value));
+        toggles[i] = last ^ bits;
+        last = bits;
+    }
+
+    uint8_t tc_index = find_free_timer();
+    if (tc_index == 0xff) {
+        m_free(toggles);
+        mp_raise_RuntimeError(translate("All timers in use"));
+    }
+    uint8_t dma_channel = audio_dma_allocate_channel();
+    if (dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        m_free(toggles);
+        mp_raise_RuntimeError(translate("No DMA channel found"));
+    }
+
+    DmacDescriptor* descriptor = dma_descriptor(dma_channel);
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_WORD | DMAC_BTCTRL_SRCINC;
+    descriptor->BTCNT.reg = len;
+    descriptor->SRCADDR.reg = (uint32_t) (toggles + len);
+    descriptor->DSTADDR.reg = (uint32_t) &group->OUTTGL.reg;
+    descriptor->DESCADDR.reg = 0;
+    dma_configure(dma_channel, FIRST_TC_DMAC_ID + 3 * tc_index, false);
+    dma_enable_channel(dma_channel);
+
+    // Each overflow of the timer moves one value.
+    uint8_t tc_gclk = 0;
+    #ifdef SAMD51
+    tc_gclk = 1;
+    #endif
+    set_timer_handler(true, tc_index, TC_HANDLER_NO_INTERRUPT);
+    turn_on_clocks(true, tc_index, tc_gclk);
+    Tc* t = tc_insts[tc_index];
+    tc_set_enable(t, false);
+    tc_reset(t);
+    #ifdef SAMD51
+    t->COUNT16.WAVE.reg = TC_WAVE_WAVEGEN_MFRQ;
+    #endif
+    #ifdef SAMD21
+    t->COUNT16.CTRLA.bit.WAVEGEN = TC_CTRLA_WAVEGEN_MFRQ_Val;
+    #endif
+    set_timer_frequency(t, rate);
+    tc_set_enable(t, true);
+
+    while ((dma_transfer_status(dma_channel) & (DMAC_CHINTFLAG_TCMPL | DMAC_CHINTFLAG_TERR)) == 0 &&
+           !mp_hal_is_interrupted()) {
+        RUN_BACKGROUND_TASKS;
+    }
+
+    tc_set_enable(t, false);
+    tc_reset(t);
+    audio_dma_free_channel(dma_channel);
+    m_free(toggles);
+}
@@ -33,11 +33,21 @@
 #include "py/runtime.h"
 
 #include "hal/include/hal_gpio.h"
+#include "peripherals/samd/dma.h"
 #include "peripherals/samd/sercom.h"
+#include "supervisor/shared/background_task.h"
+
+#include "audio_dma.h"
+
+STATIC background_task_t registers_task;
+
+STATIC void stop_registers(i2cslave_i2c_slave_obj_t *self);
+STATIC void i2cslave_registers_background(void);
 
 void common_hal_i2cslave_i2c_slave_construct(i2cslave_i2c_slave_obj_t *self,
         const mcu_pin_obj_t *scl, const mcu_pin_obj_t *sda,
-        uint8_t *addresses, unsigned int num_addresses, bool smbus) {
+        uint8_t *addresses, unsigned int num_addresses, bool smbus,
+        uint8_t *registers, size_t registers_len) {
     uint8_t sercom_index;
     uint32_t sda_pinmux, scl_pinmux;
     Sercom *sercom = samd_i2c_get_sercom(scl, sda, &sercom_index, &sda_pinmux, &scl_pinmux);
@@ -91,6 +101,22 @@ void common_hal_i2cslave_i2c_slave_construct(i2cslave_i2c_slave_obj_t *self,
     }
     sercom->I2CS.CTRLA.bit.SCLSM = 0; // Clock stretch before ack
     sercom->I2CS.CTRLA.bit.MODE = 0x04; // Slave mode
+
+    self->registers = registers;
+    self->registers_len = registers_len;
+    self->dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    self->register_pointer = 0;
+    self->written_start = 0;
+    self->written_end = 0;
+    self->in_transfer = false;
+    if (registers != NULL) {
+        // Reading or writing DATA, by the CPU or DMA, sends the ACK action.
+        sercom->I2CS.CTRLB.bit.SMEN = 1;
+        self->next = MP_STATE_VM(i2cslave_register_slaves);
+        MP_STATE_VM(i2cslave_register_slaves) = self;
+        background_task_add(&registers_task, i2cslave_registers_background, BACKGROUND_TASK_PRIORITY_AUDIO_DECODE, 1);
+    }
+
     sercom->I2CS.CTRLA.bit.ENABLE = 1;
 }
 
@@ -103,6 +129,9 @@ void common_hal_i2cslave_i2c_slave_deinit(i2cslave_i2c_slave_obj_t *self) {
         return;
     }
 
+    if (self->registers != NULL) {
+        stop_registers(self);
+    }
     self->sercom->I2CS.CTRLA.bit.ENABLE = 0;
 
     reset_pin_number(self->sda_pin);
@@ -250,3 +279,212 @@ void common_hal_i2cslave_i2c_slave_close(i2cslave_i2c_slave_obj_t *self) {
         mp_raise_OSError(MP_EIO);
     }
 }
+
+// With registers, transfers are served in the background. The background task handles the
+// address and the register pointer, which the clock is stretched for, and the bytes of a block
+// go by DMA. Bytes are moved by the task when no DMA channel is free or past the end of the
+// registers.
+
+// SERCOMn's DMA triggers follow SERCOM0's.
+STATIC uint8_t sercom_dma_index(Sercom* sercom) {
+    Sercom* sercom_insts[SERCOM_INST_NUM] = SERCOM_INSTS;
+    uint8_t sercom_index = 0;
+    while (sercom_insts[sercom_index] != sercom) {
+        sercom_index++;
+    }
+    return sercom_index;
+}
+
+STATIC void start_block_dma(i2cslave_i2c_slave_obj_t *self) {
+    size_t len = self->registers_len - self->register_pointer;
+    // Short blocks aren't worth a channel.
+    if (len < 4) {
+        return;
+    }
+    uint8_t channel = audio_dma_allocate_channel();
+    if (channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        return;
+    }
+    uint32_t data_reg = (uint32_t) &self->sercom->I2CS.DATA.reg;
+    // Incrementing addresses point at the end of the block.
+    uint32_t block_end = (uint32_t) (self->registers + self->registers_len);
+    DmacDescriptor* descriptor = dma_descriptor(channel);
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID |
+                             DMAC_BTCTRL_BEATSIZE_BYTE |
+                             (self->receiving ? DMAC_BTCTRL_DSTINC : DMAC_BTCTRL_SRCINC);
+    descriptor->BTCNT.reg = len;
+    descriptor->SRCADDR.reg = self->receiving ? data_reg : block_end;
+    descriptor->DSTADDR.reg = self->receiving ? block_end : data_reg;
+    descriptor->DESCADDR.reg = 0;
+    // The write-back descriptor, which counts what's left, isn't updated until the first byte
+    // moves.
+    ((DmacDescriptor*) DMAC->WRBADDR.reg)[channel].BTCNT.reg = len;
+    uint8_t trigger = self->receiving ? SERCOM0_DMAC_ID_RX : SERCOM0_DMAC_ID_TX;
+    dma_configure(channel, trigger + 2 * sercom_dma_index(self->sercom), false);
+    self->dma_channel = channel;
+    self->dma_len = len;
+    dma_enable_channel(channel);
+}
+
+// Stops the block DMA, if any, and moves the register pointer past the bytes it moved.
+STATIC void stop_block_dma(i2cslave_i2c_slave_obj_t *self) {
+    if (self->dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        return;
+    }
+    audio_dma_free_channel(self->dma_channel);
+    size_t moved = self->dma_len - ((DmacDescriptor*) DMAC->WRBADDR.reg)[self->dma_channel].BTCNT.reg;
+    if (self->receiving && moved > 0) {
+        if (self->written_start == self->written_end) {
+            self->written_start = self->register_pointer;
+            self->written_end = self->register_pointer + moved;
+        } else {
+            self->written_start = MIN(self->written_start, self->register_pointer);
+            self->written_end = MAX(self->written_end, self->register_pointer + moved);
+        }
+    }
+    if (!self->receiving && moved > 0) {
+        self->sent = true;
+    }
+    self->register_pointer += moved;
+    self->dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+}
+
+STATIC bool block_dma_busy(i2cslave_i2c_slave_obj_t *self) {
+    return self->dma_channel < AUDIO_DMA_CHANNEL_COUNT &&
+           (dma_transfer_status(self->dma_channel) & (DMAC_CHINTFLAG_TCMPL | DMAC_CHINTFLAG_TERR)) == 0;
+}
+
+STATIC void receive_byte(i2cslave_i2c_slave_obj_t *self) {
+    Sercom *sercom = self->sercom;
+    if (!self->pointer_received) {
+        self->pointer_received = true;
+        sercom->I2CS.CTRLB.bit.ACKACT = 0;
+        self->register_pointer = sercom->I2CS.DATA.reg;
+        if (self->register_pointer < self->registers_len) {
+            start_block_dma(self);
+        }
+        return;
+    }
+    if (self->register_pointer >= self->registers_len) {
+        sercom->I2CS.CTRLB.bit.ACKACT = 1;
+        (void) sercom->I2CS.DATA.reg;
+        return;
+    }
+    size_t pointer = self->register_pointer++;
+    sercom->I2CS.CTRLB.bit.ACKACT = 0;
+    self->registers[pointer] = sercom->I2CS.DATA.reg;
+    if (self->written_start == self->written_end) {
+        self->written_start = pointer;
+        self->written_end = pointer + 1;
+    } else {
+        self->written_start = MIN(self->written_start, pointer);
+        self->written_end = MAX(self->written_end, pointer + 1);
+    }
+}
+
+STATIC void send_byte(i2cslave_i2c_slave_obj_t *self) {
+    Sercom *sercom = self->sercom;
+    if (self->sent && sercom->I2CS.STATUS.bit.RXNACK) {
+        // The master has all it wants. Wait for the next start.
+        sercom->I2CS.CTRLB.bit.CMD = 0x02;
+        return;
+    }
+    self->sent = true;
+    if (self->register_pointer < self->registers_len) {
+        sercom->I2CS.DATA.reg = self->registers[self->register_pointer++];
+    } else {
+        sercom->I2CS.DATA.reg = 0xff;
+    }
+}
+
+STATIC void address_matched(i2cslave_i2c_slave_obj_t *self) {
+    Sercom *sercom = self->sercom;
+    uint8_t address = sercom->I2CS.DATA.reg >> 1;
+    bool match = false;
+    for (unsigned int i = 0; i < self->num_addresses; i++) {
+        if (address == self->addresses[i]) {
+            match = true;
+        }
+    }
+    self->in_transfer = match;
+    self->receiving = !sercom->I2CS.STATUS.bit.DIR;
+    self->pointer_received = false;
+    self->sent = false;
+    // Reads carry on from the pointer the last write set.
+    if (match && !self->receiving && self->register_pointer < self->registers_len) {
+        start_block_dma(self);
+    }
+    common_hal_i2cslave_i2c_slave_ack(self, match);
+}
+
+STATIC void registers_background(i2cslave_i2c_slave_obj_t *self) {
+    Sercom *sercom = self->sercom;
+    uint8_t flags = sercom->I2CS.INTFLAG.reg;
+    if (flags & (SERCOM_I2CS_INTFLAG_ERROR | SERCOM_I2CS_INTFLAG_PREC)) {
+        stop_block_dma(self);
+        sercom->I2CS.INTFLAG.reg = flags & (SERCOM_I2CS_INTFLAG_ERROR | SERCOM_I2CS_INTFLAG_PREC);
+        self->in_transfer = false;
+    }
+    if (flags & SERCOM_I2CS_INTFLAG_AMATCH) {
+        // A repeated start ends the block as well.
+        stop_block_dma(self);
+        address_matched(self);
+        return;
+    }
+    if (!self->in_transfer || (flags & SERCOM_I2CS_INTFLAG_DRDY) == 0 || block_dma_busy(self)) {
+        return;
+    }
+    // The block ran off the end of the registers.
+    stop_block_dma(self);
+    if (self->receiving) {
+        receive_byte(self);
+    } else {
+        send_byte(self);
+    }
+}
+
+STATIC void i2cslave_registers_background(void) {
+    bool in_transfer = false;
+    for (i2cslave_i2c_slave_obj_t *self = MP_STATE_VM(i2cslave_register_slaves); self != NULL; self = self->next) {
+        registers_background(self);
+        in_transfer = in_transfer || self->in_transfer;
+    }
+    // Don't wait for the next tick while the master is waiting.
+    if (in_transfer) {
+        background_task_set_pending(&registers_task);
+    }
+}
+
+STATIC void stop_registers(i2cslave_i2c_slave_obj_t *self) {
+    stop_block_dma(self);
+    i2cslave_i2c_slave_obj_t **slave = (i2cslave_i2c_slave_obj_t **) &MP_STATE_VM(i2cslave_register_slaves);
+    while (*slave != NULL && *slave != self) {
+        slave = &(*slave)->next;
+    }
+    if (*slave != NULL) {
+        *slave = self->next;
+    }
+    if (MP_STATE_VM(i2cslave_register_slaves) == NULL) {
+        background_task_remove(&registers_task);
+    }
+}
+
+bool common_hal_i2cslave_i2c_slave_get_serving_registers(i2cslave_i2c_slave_obj_t *self) {
+    return self->registers != NULL;
+}
+
+bool common_hal_i2cslave_i2c_slave_get_written(i2cslave_i2c_slave_obj_t *self, size_t *start, size_t *end) {
+    if (self->written_start == self->written_end) {
+        return false;
+    }
+    *start = self->written_start;
+    *end = self->written_end;
+    self->written_start = 0;
+    self->written_end = 0;
+    return true;
+}
+
+void i2cslave_reset(void) {
+    // The slaves went with the heap and their SERCOMs and DMA channels are reset elsewhere.
+    background_task_remove(&registers_task);
+}
@@ -30,7 +30,7 @@
 #include "common-hal/microcontroller/Pin.h"
 #include "py/obj.h"
 
-typedef struct {
+typedef struct _i2cslave_i2c_slave_obj_t {
     mp_obj_base_t base;
 
     uint8_t *addresses;
@@ -40,6 +40,27 @@ typedef struct {
     uint8_t scl_pin;
     uint8_t sda_pin;
     bool writing;
+
+    // Registers served in the background, or NULL when Python handles requests.
+    uint8_t *registers;
+    size_t registers_len;
+    struct _i2cslave_i2c_slave_obj_t *next;
+    size_t register_pointer;
+    // Range of registers the master has written since it was last checked. Empty when
+    // written_start == written_end.
+    size_t written_start;
+    size_t written_end;
+    // Audio DMA channel moving the current block, AUDIO_DMA_CHANNEL_COUNT when bytes are
+    // moved one at a time.
+    uint8_t dma_channel;
+    uint16_t dma_len;
+    bool in_transfer;
+    bool receiving;
+    // The first byte the master writes sets register_pointer.
+    bool pointer_received;
+    bool sent;
 } i2cslave_i2c_slave_obj_t;
 
+void i2cslave_reset(void);
+
 #endif // MICROPY_INCLUDED_ATMEL_SAMD_COMMON_HAL_BUSIO_I2C_SLAVE_H
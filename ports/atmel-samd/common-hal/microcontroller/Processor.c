@@ -62,10 +62,13 @@
  */
 
 #include "common-hal/microcontroller/Processor.h"
+#include "shared-bindings/microcontroller/Processor.h"
 
+#include "hpl/gclk/hpl_gclk_base.h"
 #include "samd/adc.h"
 
 #include "peripheral_clk_config.h"
+#include "tick.h"
 
 #define ADC_TEMP_SAMPLE_LENGTH 4
 #define INT1V_VALUE_FLOAT 1.0
@@ -317,10 +320,70 @@ float common_hal_mcu_processor_get_voltage(void) {
     return (reading / 4095.0f) * 4.0f;
 }
 
+#ifdef SAMD51
+// GCLK0 divides DPLL0 down to these. Everything else that needs a steady clock
+// (SERCOM, USB, audio, PWM) is on another generator so it doesn't notice.
+STATIC const uint32_t cpu_frequencies[] = {
+    CONF_CPU_FREQUENCY,
+    CONF_CPU_FREQUENCY / 2,
+    CONF_CPU_FREQUENCY / 3,
+    CONF_CPU_FREQUENCY / 4,
+    CONF_CPU_FREQUENCY / 5,
+    CONF_CPU_FREQUENCY / 6,
+    CONF_CPU_FREQUENCY / 8,
+    CONF_CPU_FREQUENCY / 10,
+};
+
+STATIC uint32_t cpu_frequency = CONF_CPU_FREQUENCY;
+
+size_t common_hal_mcu_processor_get_frequencies(const uint32_t** frequencies) {
+    *frequencies = cpu_frequencies;
+    return MP_ARRAY_SIZE(cpu_frequencies);
+}
+
+// Flash wait states needed at a given frequency, from the SAMD51 datasheet
+// table 54-40, for VDD > 1.71V.
+STATIC uint8_t flash_wait_states(uint32_t frequency) {
+    const uint32_t limits[] = {22000000, 44000000, 67000000, 89000000, 111000000};
+    uint8_t wait_states = 0;
+    while (wait_states < MP_ARRAY_SIZE(limits) && frequency > limits[wait_states]) {
+        wait_states++;
+    }
+    return wait_states;
+}
+
+void common_hal_mcu_processor_set_frequency(uint32_t frequency) {
+    if (frequency == cpu_frequency) {
+        return;
+    }
+    bool manual_wait_states = NVMCTRL->CTRLA.bit.AUTOWS == 0;
+    // Add wait states before speeding up and remove them after slowing down.
+    if (manual_wait_states && frequency > cpu_frequency) {
+        NVMCTRL->CTRLA.bit.RWS = flash_wait_states(frequency);
+    }
+    hri_gclk_write_GENCTRL_DIV_bf(GCLK, 0, CONF_CPU_FREQUENCY / frequency);
+    if (manual_wait_states && frequency < cpu_frequency) {
+        NVMCTRL->CTRLA.bit.RWS = flash_wait_states(frequency);
+    }
+    cpu_frequency = frequency;
+    tick_set_frequency(frequency);
+}
+
+void processor_reset(void) {
+    common_hal_mcu_processor_set_frequency(CONF_CPU_FREQUENCY);
+}
+
+uint32_t common_hal_mcu_processor_get_frequency(void) {
+    return cpu_frequency;
+}
+#else
+void processor_reset(void) {
+}
+
 uint32_t common_hal_mcu_processor_get_frequency(void) {
-    // TODO(tannewt): Determine this dynamically.
     return CONF_CPU_FREQUENCY;
 }
+#endif
 
 void common_hal_mcu_processor_get_uid(uint8_t raw_id[]) {
     #ifdef SAMD21
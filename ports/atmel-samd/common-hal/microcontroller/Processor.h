@@ -36,4 +36,7 @@ typedef struct {
     // Stores no state currently.
 } mcu_processor_obj_t;
 
+// Goes back to the full CPU frequency.
+void processor_reset(void);
+
 #endif // MICROPY_INCLUDED_ATMEL_SAMD_COMMON_HAL_MICROCONTROLLER_PROCESSOR_H
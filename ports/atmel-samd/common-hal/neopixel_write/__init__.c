@@ -23,12 +23,25 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <string.h>
+
 #include "hpl_gpio.h"
 
+#include "py/gc.h"
+#include "py/mpstate.h"
 #include "py/mphal.h"
+#include "py/runtime.h"
 
+#include "common-hal/neopixel_write/__init__.h"
+#include "hal/include/hal_gpio.h"
+#include "peripheral_clk_config.h"
+#include "shared-bindings/microcontroller/Processor.h"
 #include "shared-bindings/neopixel_write/__init__.h"
 
+#include "samd/dma.h"
+#include "samd/sercom.h"
+
+#include "audio_dma.h"
 #include "tick.h"
 
 #ifdef SAMD51
@@ -94,13 +107,177 @@ static void neopixel_send_buffer_core(volatile uint32_t *clraddr, uint32_t pinMa
 uint64_t next_start_tick_ms = 0;
 uint32_t next_start_tick_us = 1000;
 
+// Longer strips are sent in the background by a SERCOM in SPI mode fed by
+// DMA. Each pixel bit becomes three SPI bits at 2.4MHz: 0b100 for a 0 and
+// 0b110 for a 1, which gives the 0.4us and 0.8us high times.
+#define SPI_BAUDRATE 2400000
+#define SPI_BYTES_PER_BYTE 3
+// 100us of low output after the data, so the strip latches before the DMA
+// reports completion.
+#define SPI_LATCH_BYTES 30
+
+static uint8_t transfer_dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+static uint8_t transfer_sercom_index;
+static uint8_t transfer_pin;
+
+STATIC bool transfer_done(void) {
+    return (dma_transfer_status(transfer_dma_channel) & (DMAC_CHINTFLAG_TCMPL | DMAC_CHINTFLAG_TERR)) != 0;
+}
+
+// Give the SERCOM and pin back once the data and latch have gone out.
+STATIC void finish_transfer(void) {
+    Sercom* sercom = sercom_insts[transfer_sercom_index];
+    while (sercom->SPI.INTFLAG.bit.TXC == 0) {}
+    audio_dma_free_channel(transfer_dma_channel);
+    transfer_dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    sercom->SPI.CTRLA.bit.SWRST = 1;
+    while (sercom->SPI.SYNCBUSY.bit.SWRST) {}
+    gpio_set_pin_function(transfer_pin, GPIO_PIN_FUNCTION_OFF);
+}
+
+STATIC void wait_for_transfer(void) {
+    if (transfer_dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        return;
+    }
+    while (!transfer_done()) {
+        RUN_BACKGROUND_TASKS;
+    }
+    // Background tasks may have finished it already.
+    if (transfer_dma_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        finish_transfer();
+    }
+}
+
+void neopixel_write_background(void) {
+    if (transfer_dma_channel < AUDIO_DMA_CHANNEL_COUNT && transfer_done()) {
+        finish_transfer();
+    }
+}
+
+void neopixel_write_reset(void) {
+    // The SERCOMs have been reset already so don't wait on them.
+    if (transfer_dma_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        audio_dma_free_channel(transfer_dma_channel);
+        transfer_dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    }
+}
+
+// Returns the DOPO that puts data out on the given pad or 0xff if there isn't one.
+STATIC uint8_t dopo_for_pad(uint8_t pad) {
+    switch (pad) {
+        case 0:
+            return 0;
+        #ifdef SAMD21
+        case 2:
+            return 1;
+        #endif
+        case 3:
+            return 2;
+        default:
+            return 0xff;
+    }
+}
+
+STATIC bool start_transfer(const mcu_pin_obj_t* pin, uint8_t *pixels, uint32_t numBytes) {
+    // The encoded data lives on the heap so it can't be sent before the VM
+    // starts or after it ends.
+    if (MP_STATE_MEM(gc_pool_start) == 0) {
+        return false;
+    }
+    Sercom* sercom = NULL;
+    uint8_t sercom_index = 0;
+    uint32_t pinmux = 0;
+    uint8_t dopo = 0xff;
+    for (int i = 0; i < NUM_SERCOMS_PER_PIN; i++) {
+        sercom_index = pin->sercom[i].index;
+        if (sercom_index >= SERCOM_INST_NUM ||
+            sercom_insts[sercom_index]->SPI.CTRLA.bit.ENABLE != 0) {
+            continue;
+        }
+        dopo = dopo_for_pad(pin->sercom[i].pad);
+        if (dopo != 0xff) {
+            sercom = sercom_insts[sercom_index];
+            pinmux = PINMUX(pin->number, (i == 0) ? MUX_C : MUX_D);
+            break;
+        }
+    }
+    if (sercom == NULL) {
+        return false;
+    }
+
+    // Reuse the last buffer when it's big enough.
+    size_t length = numBytes * SPI_BYTES_PER_BYTE + SPI_LATCH_BYTES;
+    uint8_t* encoded = MP_STATE_VM(neopixel_write_buffer);
+    if (encoded == NULL || gc_nbytes(encoded) < length) {
+        MP_STATE_VM(neopixel_write_buffer) = NULL;
+        encoded = m_malloc_maybe(length, false);
+        if (encoded == NULL) {
+            return false;
+        }
+        MP_STATE_VM(neopixel_write_buffer) = encoded;
+    }
+    uint8_t dma_channel = audio_dma_allocate_channel();
+    if (dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        return false;
+    }
+
+    uint8_t* out = encoded;
+    for (uint32_t i = 0; i < numBytes; i++) {
+        uint32_t bits = 0;
+        for (uint8_t mask = 0x80; mask > 0; mask >>= 1) {
+            bits = (bits << 3) | ((pixels[i] & mask) ? 0x6 : 0x4);
+        }
+        *out++ = bits >> 16;
+        *out++ = bits >> 8;
+        *out++ = bits;
+    }
+    memset(out, 0, SPI_LATCH_BYTES);
+
+    samd_peripherals_sercom_clock_init(sercom, sercom_index);
+    sercom->SPI.CTRLA.bit.SWRST = 1;
+    while (sercom->SPI.SYNCBUSY.bit.SWRST) {}
+    sercom->SPI.CTRLA.reg = SERCOM_SPI_CTRLA_MODE(3) | SERCOM_SPI_CTRLA_DOPO(dopo);
+    sercom->SPI.BAUD.reg = samd_peripherals_spi_baudrate_to_baud_reg_value(SPI_BAUDRATE);
+    sercom->SPI.CTRLA.bit.ENABLE = 1;
+    while (sercom->SPI.SYNCBUSY.bit.ENABLE) {}
+    gpio_set_pin_function(pin->number, pinmux);
+
+    DmacDescriptor* descriptor = dma_descriptor(dma_channel);
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_SRCINC;
+    descriptor->BTCNT.reg = length;
+    descriptor->SRCADDR.reg = (uint32_t) (encoded + length);
+    descriptor->DSTADDR.reg = (uint32_t) &sercom->SPI.DATA.reg;
+    descriptor->DESCADDR.reg = 0;
+    dma_configure(dma_channel, SERCOM0_DMAC_ID_TX + 2 * sercom_index, false);
+
+    transfer_sercom_index = sercom_index;
+    transfer_pin = pin->number;
+    transfer_dma_channel = dma_channel;
+    dma_enable_channel(dma_channel);
+    return true;
+}
+
 void common_hal_neopixel_write(const digitalio_digitalinout_obj_t* digitalinout, uint8_t *pixels, uint32_t numBytes) {
+    // Only one strip is sent at a time.
+    wait_for_transfer();
+    // BTCNT is 16 bits.
+    if (numBytes * SPI_BYTES_PER_BYTE + SPI_LATCH_BYTES <= 0xffff &&
+        start_transfer(digitalinout->pin, pixels, numBytes)) {
+        return;
+    }
+
     // This is adapted directly from the Adafruit NeoPixel library SAMD21G18A code:
     // https://github.com/adafruit/Adafruit_NeoPixel/blob/master/Adafruit_NeoPixel.cpp
     // and the asm version from https://github.com/microsoft/uf2-samdx1/blob/master/inc/neopixel.h
     uint32_t  pinMask;
     PortGroup* port;
 
+    #ifdef SAMD51
+    // The bit timing below counts cycles at the full CPU frequency.
+    uint32_t cpu_frequency = common_hal_mcu_processor_get_frequency();
+    common_hal_mcu_processor_set_frequency(CONF_CPU_FREQUENCY);
+    #endif
+
     // This must be called while interrupts are on in case we're waiting for a
     // future ms tick.
     wait_until(next_start_tick_ms, next_start_tick_us);
@@ -157,5 +334,8 @@ void common_hal_neopixel_write(const digitalio_digitalinout_obj_t* digitalinout,
     // Turn on interrupts after timing-sensitive code.
     mp_hal_enable_all_interrupts();
 
+    #ifdef SAMD51
+    common_hal_mcu_processor_set_frequency(cpu_frequency);
+    #endif
 }
 
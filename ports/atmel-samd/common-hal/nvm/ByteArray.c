@@ -48,6 +48,34 @@ bool common_hal_nvm_bytearray_set_bytes(nvm_bytearray_obj_t *self,
     return true;
 }
 
+uint32_t common_hal_nvm_bytearray_get_erase_size(nvm_bytearray_obj_t *self) {
+    #ifdef SAMD21
+    return NVMCTRL_ROW_SIZE;
+    #endif
+    #ifdef SAMD51
+    return NVMCTRL_BLOCK_SIZE;
+    #endif
+}
+
+bool common_hal_nvm_bytearray_erase(nvm_bytearray_obj_t *self, uint32_t start_index) {
+    struct flash_descriptor desc;
+    desc.dev.hw = NVMCTRL;
+    int32_t error_code = flash_erase(&desc, (uint32_t) self->start_address + start_index,
+                                     common_hal_nvm_bytearray_get_erase_size(self) / flash_get_page_size(&desc));
+    assert_heap_ok();
+    return error_code == ERR_NONE;
+}
+
+bool common_hal_nvm_bytearray_program(nvm_bytearray_obj_t *self,
+        uint32_t start_index, const uint8_t* values, uint32_t len) {
+    struct flash_descriptor desc;
+    desc.dev.hw = NVMCTRL;
+    int32_t error_code = flash_append(&desc, (uint32_t) self->start_address + start_index,
+                                      (uint8_t*) values, len);
+    assert_heap_ok();
+    return error_code == ERR_NONE;
+}
+
 // NVM memory is memory mapped so reading it is easy.
 void common_hal_nvm_bytearray_get_bytes(nvm_bytearray_obj_t *self,
     uint32_t start_index, uint32_t len, uint8_t* values) {
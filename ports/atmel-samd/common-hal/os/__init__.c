@@ -31,7 +31,11 @@
 #include "py/qstr.h"
 
 #ifdef SAMD51
-#include "hal/include/hal_rand_sync.h"
+#include <string.h>
+
+#include "hri/hri_mclk_d51.h"
+#include "sam.h"
+#include "shared-bindings/microcontroller/__init__.h"
 #endif
 
 STATIC const qstr os_uname_info_fields[] = {
@@ -66,18 +70,65 @@ mp_obj_t common_hal_os_uname(void) {
     return (mp_obj_t)&os_uname_info_obj;
 }
 
-bool common_hal_os_urandom(uint8_t* buffer, uint32_t length) {
-    #ifdef SAMD51
+#ifdef SAMD51
+// Entropy collected by the TRNG interrupt so that urandom doesn't usually
+// wait. The TRNG only runs until the pool is full again.
+#define URANDOM_POOL_SIZE 64
+
+STATIC uint8_t urandom_pool[URANDOM_POOL_SIZE];
+STATIC volatile size_t urandom_pool_len;
+
+STATIC void trng_start(void) {
     hri_mclk_set_APBCMASK_TRNG_bit(MCLK);
-    struct rand_sync_desc random;
-    rand_sync_init(&random, TRNG);
-    rand_sync_enable(&random);
+    TRNG->INTENSET.reg = TRNG_INTENSET_DATARDY;
+    NVIC_EnableIRQ(TRNG_IRQn);
+    TRNG->CTRLA.reg = TRNG_CTRLA_ENABLE;
+}
 
-    rand_sync_read_buf8(&random, buffer, length);
+void TRNG_Handler(void) {
+    // Reading DATA clears DATARDY.
+    uint32_t data = TRNG->DATA.reg;
+    size_t len = urandom_pool_len;
+    if (len + sizeof(data) <= URANDOM_POOL_SIZE) {
+        memcpy(urandom_pool + len, &data, sizeof(data));
+        len += sizeof(data);
+        urandom_pool_len = len;
+    }
+    if (len + sizeof(data) > URANDOM_POOL_SIZE) {
+        TRNG->CTRLA.reg = 0;
+        TRNG->INTENCLR.reg = TRNG_INTENCLR_DATARDY;
+        hri_mclk_clear_APBCMASK_TRNG_bit(MCLK);
+    }
+}
+
+// Moves up to length bytes out of the pool. Each byte is handed out once.
+STATIC size_t take_from_pool(uint8_t* buffer, size_t length) {
+    common_hal_mcu_disable_interrupts();
+    size_t count = MIN(length, urandom_pool_len);
+    urandom_pool_len -= count;
+    memcpy(buffer, urandom_pool + urandom_pool_len, count);
+    memset(urandom_pool + urandom_pool_len, 0, count);
+    common_hal_mcu_enable_interrupts();
+    return count;
+}
+#endif
 
-    rand_sync_disable(&random);
-    rand_sync_deinit(&random);
-    hri_mclk_clear_APBCMASK_TRNG_bit(MCLK);
+bool common_hal_os_urandom(uint8_t* buffer, uint32_t length) {
+    #ifdef SAMD51
+    size_t count = take_from_pool(buffer, length);
+    buffer += count;
+    length -= count;
+    // Refill in the background. Anything the pool couldn't cover arrives
+    // through it a word at a time.
+    trng_start();
+    while (length > 0) {
+        count = take_from_pool(buffer, length);
+        buffer += count;
+        length -= count;
+        if (length > 0) {
+            trng_start();
+        }
+    }
     return true;
     #else
     return false;
@@ -38,12 +38,28 @@
 #include "samd/timers.h"
 #include "supervisor/shared/translate.h"
 
+#include "samd/dma.h"
 #include "samd/pins.h"
 
+#include "audio_dma.h"
+
 #undef ENABLE
 
 #  define _TCC_SIZE(unused, n) TCC ## n ## _SIZE,
 #  define TCC_SIZES         { REPEAT_MACRO(_TCC_SIZE, 0, TCC_INST_NUM) }
+#  define _TCC_DMA_TRIGGER(unused, n) TCC ## n ## _DMAC_ID_OVF,
+#  define TCC_DMA_TRIGGERS  { REPEAT_MACRO(_TCC_DMA_TRIGGER, 0, TCC_INST_NUM) }
+
+// The timers run from a clock that doesn't change with the CPU frequency.
+#ifdef SAMD21
+#define PWM_CLOCK_FREQUENCY 48000000
+#define PWM_GCLK 0
+#endif
+#ifdef SAMD51
+#define PWM_CLOCK_FREQUENCY 120000000
+// GCLK4 is DPLL0 undivided, where GCLK0 may be divided down.
+#define PWM_GCLK 4
+#endif
 
 static uint32_t tcc_periods[TCC_INST_NUM];
 static uint32_t tc_periods[TC_INST_NUM];
@@ -61,6 +77,9 @@ uint8_t tcc_channels[5];   // Set by pwmout_reset() to {0xc0, 0xf0, 0xf8, 0xfc,
 
 static uint8_t never_reset_tc_or_tcc[TC_INST_NUM + TCC_INST_NUM];
 
+// DMA channels playing duty cycle sequences.
+static bool sequence_dma_channels[AUDIO_DMA_CHANNEL_COUNT];
+
 void common_hal_pulseio_pwmout_never_reset(pulseio_pwmout_obj_t *self) {
     if (self->timer->is_tc) {
         never_reset_tc_or_tcc[self->timer->index] += 1;
@@ -80,6 +99,12 @@ void common_hal_pulseio_pwmout_reset_ok(pulseio_pwmout_obj_t *self) {
 }
 
 void pwmout_reset(void) {
+    for (uint8_t i = 0; i < AUDIO_DMA_CHANNEL_COUNT; i++) {
+        if (sequence_dma_channels[i]) {
+            audio_dma_free_channel(i);
+            sequence_dma_channels[i] = false;
+        }
+    }
     // Reset all timers
     for (int i = 0; i < TCC_INST_NUM; i++) {
         target_tcc_frequencies[i] = 0;
@@ -136,6 +161,8 @@ pwmout_result_t common_hal_pulseio_pwmout_construct(pulseio_pwmout_obj_t* self,
     self->pin = pin;
     self->variable_frequency = variable_frequency;
     self->duty_cycle = duty;
+    self->sequence = NULL;
+    self->dma_channel = AUDIO_DMA_CHANNEL_COUNT;
 
     if (pin->timer[0].index >= TC_INST_NUM &&
         pin->timer[1].index >= TCC_INST_NUM
@@ -228,7 +255,7 @@ pwmout_result_t common_hal_pulseio_pwmout_construct(pulseio_pwmout_obj_t* self,
             resolution = _tcc_sizes[timer->index];
         }
         // First determine the divisor that gets us the highest resolution.
-        uint32_t system_clock = common_hal_mcu_processor_get_frequency();
+        uint32_t system_clock = PWM_CLOCK_FREQUENCY;
         uint32_t top;
         uint8_t divisor;
         for (divisor = 0; divisor < 8; divisor++) {
@@ -239,8 +266,7 @@ pwmout_result_t common_hal_pulseio_pwmout_construct(pulseio_pwmout_obj_t* self,
         }
 
         set_timer_handler(timer->is_tc, timer->index, TC_HANDLER_NO_INTERRUPT);
-        // We use the zeroeth clock on either port to go full speed.
-        turn_on_clocks(timer->is_tc, timer->index, 0);
+        turn_on_clocks(timer->is_tc, timer->index, PWM_GCLK);
 
         if (timer->is_tc) {
             tc_periods[timer->index] = top;
@@ -299,6 +325,7 @@ void common_hal_pulseio_pwmout_deinit(pulseio_pwmout_obj_t* self) {
     if (common_hal_pulseio_pwmout_deinited(self)) {
         return;
     }
+    common_hal_pulseio_pwmout_stop(self);
     const pin_timer_t* t = self->timer;
     if (t->is_tc) {
         Tc* tc = tc_insts[t->index];
@@ -322,7 +349,9 @@ void common_hal_pulseio_pwmout_deinit(pulseio_pwmout_obj_t* self) {
     self->pin = mp_const_none;
 }
 
-extern void common_hal_pulseio_pwmout_set_duty_cycle(pulseio_pwmout_obj_t* self, uint16_t duty) {
+// Writes the duty cycle into the buffer register, which is copied to the compare register at the
+// end of the period. TCC buffers are only copied while they aren't locked.
+static void write_duty_cycle(pulseio_pwmout_obj_t* self, uint16_t duty, bool lock) {
     // Store the unadjusted duty cycle. It turns out the the process of adjusting and calculating
     // the duty cycle here and reading it back is lossy - the value will decay over time.
     // Track it here so that if frequency is changed we can use this value to recalculate the
@@ -353,17 +382,116 @@ extern void common_hal_pulseio_pwmout_set_duty_cycle(pulseio_pwmout_obj_t* self,
         while (tcc->SYNCBUSY.reg != 0) {}
 
         // Lock out double-buffering while updating the CCB value.
-        tcc->CTRLBSET.bit.LUPD = 1;
+        if (lock) {
+            tcc->CTRLBSET.bit.LUPD = 1;
+        }
         #ifdef SAMD21
         tcc->CCB[channel].reg = adjusted_duty;
         #endif
         #ifdef SAMD51
         tcc->CCBUF[channel].reg = adjusted_duty;
         #endif
+        if (lock) {
+            tcc->CTRLBCLR.bit.LUPD = 1;
+        }
+    }
+}
+
+extern void common_hal_pulseio_pwmout_set_duty_cycle(pulseio_pwmout_obj_t* self, uint16_t duty) {
+    common_hal_pulseio_pwmout_stop(self);
+    write_duty_cycle(self, duty, true);
+}
+
+void common_hal_pulseio_pwmout_set_duty_cycles(pulseio_pwmout_obj_t** pwms, const uint16_t* duties, size_t count) {
+    // Lock the buffers of every TCC involved until all of them are written so that their outputs
+    // change in the same period. TCs can't be locked so they change as they're written.
+    uint8_t locked = 0;
+    for (size_t i = 0; i < count; i++) {
+        common_hal_pulseio_pwmout_stop(pwms[i]);
+        const pin_timer_t* t = pwms[i]->timer;
+        if (t->is_tc || (locked & (1 << t->index)) != 0) {
+            continue;
+        }
+        Tcc* tcc = tcc_insts[t->index];
+        while (tcc->SYNCBUSY.reg != 0) {}
+        tcc->CTRLBSET.bit.LUPD = 1;
+        locked |= 1 << t->index;
+    }
+    for (size_t i = 0; i < count; i++) {
+        write_duty_cycle(pwms[i], duties[i], false);
+    }
+    for (uint8_t i = 0; i < TCC_INST_NUM; i++) {
+        if ((locked & (1 << i)) == 0) {
+            continue;
+        }
+        Tcc* tcc = tcc_insts[i];
+        while (tcc->SYNCBUSY.reg != 0) {}
         tcc->CTRLBCLR.bit.LUPD = 1;
     }
 }
 
+// Sequences are played by DMA into the TCC's buffer register at the end of each period.
+void common_hal_pulseio_pwmout_play(pulseio_pwmout_obj_t* self, const uint16_t* duty_cycles, size_t len, bool loop) {
+    const pin_timer_t* t = self->timer;
+    if (t->is_tc) {
+        mp_raise_ValueError(translate("Duty cycle sequences aren't supported on this pin"));
+    }
+    // The block count is 16 bits.
+    if (len == 0 || len > 0xffff) {
+        mp_raise_ValueError(translate("Duty cycle sequences must have 1-65535 entries"));
+    }
+    common_hal_pulseio_pwmout_stop(self);
+
+    uint32_t* sequence = m_new(uint32_t, len);
+    for (size_t i = 0; i < len; i++) {
+        sequence[i] = ((uint64_t) tcc_periods[t->index]) * duty_cycles[i] / 0xffff;
+    }
+    uint8_t dma_channel = audio_dma_allocate_channel();
+    if (dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        mp_raise_RuntimeError(translate("No DMA channel found"));
+    }
+    self->sequence = sequence;
+    self->dma_channel = dma_channel;
+    sequence_dma_channels[dma_channel] = true;
+    // Frequency changes stop the sequence and start from the last duty cycle.
+    self->duty_cycle = duty_cycles[len - 1];
+
+    Tcc* tcc = tcc_insts[t->index];
+    DmacDescriptor* descriptor = dma_descriptor(dma_channel);
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID |
+                             DMAC_BTCTRL_BEATSIZE_WORD |
+                             DMAC_BTCTRL_SRCINC;
+    descriptor->BTCNT.reg = len;
+    // Incrementing addresses point at the end of the block.
+    descriptor->SRCADDR.reg = (uint32_t) (sequence + len);
+    #ifdef SAMD21
+    descriptor->DSTADDR.reg = (uint32_t) &tcc->CCB[tcc_channel(t)].reg;
+    #endif
+    #ifdef SAMD51
+    descriptor->DSTADDR.reg = (uint32_t) &tcc->CCBUF[tcc_channel(t)].reg;
+    #endif
+    descriptor->DESCADDR.reg = loop ? (uint32_t) descriptor : 0;
+
+    const uint8_t triggers[TCC_INST_NUM] = TCC_DMA_TRIGGERS;
+    dma_configure(dma_channel, triggers[t->index], false);
+    dma_enable_channel(dma_channel);
+}
+
+void common_hal_pulseio_pwmout_stop(pulseio_pwmout_obj_t* self) {
+    if (self->dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        return;
+    }
+    audio_dma_free_channel(self->dma_channel);
+    sequence_dma_channels[self->dma_channel] = false;
+    self->dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    self->sequence = NULL;
+}
+
+bool common_hal_pulseio_pwmout_get_playing(pulseio_pwmout_obj_t* self) {
+    return self->dma_channel < AUDIO_DMA_CHANNEL_COUNT &&
+           (dma_transfer_status(self->dma_channel) & (DMAC_CHINTFLAG_TCMPL | DMAC_CHINTFLAG_TERR)) == 0;
+}
+
 uint16_t common_hal_pulseio_pwmout_get_duty_cycle(pulseio_pwmout_obj_t* self) {
     const pin_timer_t* t = self->timer;
     if (t->is_tc) {
@@ -414,7 +542,7 @@ void common_hal_pulseio_pwmout_set_frequency(pulseio_pwmout_obj_t* self,
     } else {
         resolution = 24;
     }
-    uint32_t system_clock = common_hal_mcu_processor_get_frequency();
+    uint32_t system_clock = PWM_CLOCK_FREQUENCY;
     uint32_t new_top;
     uint8_t new_divisor;
     for (new_divisor = 0; new_divisor < 8; new_divisor++) {
@@ -461,7 +589,7 @@ void common_hal_pulseio_pwmout_set_frequency(pulseio_pwmout_obj_t* self,
 }
 
 uint32_t common_hal_pulseio_pwmout_get_frequency(pulseio_pwmout_obj_t* self) {
-    uint32_t system_clock = common_hal_mcu_processor_get_frequency();
+    uint32_t system_clock = PWM_CLOCK_FREQUENCY;
     const pin_timer_t* t = self->timer;
     uint8_t divisor;
     uint32_t top;
@@ -37,6 +37,10 @@ typedef struct {
     const pin_timer_t* timer;
     bool variable_frequency;
     uint16_t duty_cycle;
+    // Compare values of the duty cycle sequence being played, one per period.
+    uint32_t* sequence;
+    // AUDIO_DMA_CHANNEL_COUNT when no sequence is playing.
+    uint8_t dma_channel;
 } pulseio_pwmout_obj_t;
 
 void pwmout_reset(void);
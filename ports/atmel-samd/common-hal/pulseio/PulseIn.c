@@ -36,13 +36,36 @@
 #include "mpconfigport.h"
 #include "py/gc.h"
 #include "py/runtime.h"
+#include "samd/dma.h"
+#include "samd/events.h"
 #include "samd/external_interrupts.h"
 #include "samd/pins.h"
+#include "samd/timers.h"
 #include "shared-bindings/microcontroller/__init__.h"
 #include "shared-bindings/pulseio/PulseIn.h"
+#include "supervisor/shared/tick.h"
 #include "supervisor/shared/translate.h"
 
+#include "audio_dma.h"
 #include "tick.h"
+#include "timer_handler.h"
+
+// Edge timestamps are counted at 48MHz / 64 = 750kHz, so each count is 4/3us
+// and the 16 bit counter wraps every 87ms.
+#define CAPTURE_COUNT 32
+#define CAPTURE_WRAP_MS 87
+
+static pulseio_pulsein_obj_t* active_captures[TC_INST_NUM];
+
+STATIC void push_duration(pulseio_pulsein_obj_t* self, uint16_t duration) {
+    uint16_t i = (self->start + self->len) % self->maxlen;
+    self->buffer[i] = duration;
+    if (self->len < self->maxlen) {
+        self->len++;
+    } else {
+        self->start++;
+    }
+}
 
 static void pulsein_set_config(pulseio_pulsein_obj_t* self, bool first_edge) {
     uint32_t sense_setting;
@@ -94,18 +117,181 @@ void pulsein_interrupt_handler(uint8_t channel) {
             duration = total_diff;
         }
 
-        uint16_t i = (self->start + self->len) % self->maxlen;
-        self->buffer[i] = duration;
-        if (self->len < self->maxlen) {
-            self->len++;
-        } else {
-            self->start++;
-        }
+        push_duration(self, duration);
     }
     self->last_ms = current_ms;
     self->last_us = current_us;
 }
 
+STATIC uint16_t capture_position(pulseio_pulsein_obj_t* self) {
+    uint32_t remaining;
+    // The running channel's count is only in ACTIVE. Others are written back
+    // to memory between beats.
+    if (DMAC->ACTIVE.bit.ABUSY && DMAC->ACTIVE.bit.ID == self->dma_channel) {
+        remaining = DMAC->ACTIVE.bit.BTCNT;
+    } else {
+        DmacDescriptor* write_back = (DmacDescriptor*) DMAC->WRBADDR.reg;
+        remaining = write_back[self->dma_channel].BTCNT.reg;
+    }
+    if (remaining == 0 || remaining > CAPTURE_COUNT) {
+        return 0;
+    }
+    return CAPTURE_COUNT - remaining;
+}
+
+// Turns the timestamps DMA has stored since last time into durations. The
+// timer may have wrapped between two edges without it showing in their
+// timestamps. That is caught by noticing that no edge came for longer than
+// the wrap time, so this must run regularly.
+STATIC void capture_update(pulseio_pulsein_obj_t* self) {
+    uint64_t now = supervisor_ticks_ms64();
+    uint16_t write_index = capture_position(self);
+    if (write_index == self->capture_index) {
+        self->quiet_ms = now;
+        return;
+    }
+    bool wrapped = self->quiet_ms - self->last_edge_ms >= CAPTURE_WRAP_MS;
+    while (self->capture_index != write_index) {
+        uint16_t capture = self->captures[self->capture_index];
+        self->capture_index = (self->capture_index + 1) % CAPTURE_COUNT;
+        if (self->first_edge) {
+            self->first_edge = false;
+        } else {
+            uint32_t duration = 0xffff;
+            if (!wrapped) {
+                duration = ((uint16_t) (capture - self->last_capture)) * 4 / 3;
+            }
+            push_duration(self, MIN(duration, 0xffff));
+        }
+        wrapped = false;
+        self->last_capture = capture;
+    }
+    self->last_edge_ms = now;
+    self->quiet_ms = now;
+}
+
+void pulsein_background(void) {
+    for (uint8_t i = 0; i < TC_INST_NUM; i++) {
+        pulseio_pulsein_obj_t* self = active_captures[i];
+        if (self != NULL && tc_insts[i]->COUNT16.CTRLA.bit.ENABLE) {
+            capture_update(self);
+        }
+    }
+}
+
+void pulsein_reset(void) {
+    for (uint8_t i = 0; i < TC_INST_NUM; i++) {
+        if (active_captures[i] != NULL) {
+            audio_dma_free_channel(active_captures[i]->dma_channel);
+            active_captures[i] = NULL;
+        }
+    }
+}
+
+STATIC void set_eic_event_output(uint8_t channel, bool enable) {
+    eic_set_enable(false);
+    #ifdef SAMD21
+    uint32_t masked_value = EIC->EVCTRL.vec.EXTINTEO & ~(1 << channel);
+    EIC->EVCTRL.vec.EXTINTEO = masked_value | (enable ? 1 << channel : 0);
+    #endif
+    #ifdef SAMD51
+    uint32_t masked_value = EIC->EVCTRL.bit.EXTINTEO & ~(1 << channel);
+    EIC->EVCTRL.bit.EXTINTEO = masked_value | (enable ? 1 << channel : 0);
+    #endif
+    eic_set_enable(true);
+}
+
+// Sets up edge capture by TC and DMA. Returns false, with nothing claimed,
+// when the timer, event channel, DMA channel or memory isn't available.
+STATIC bool start_capture(pulseio_pulsein_obj_t* self) {
+    uint8_t tc_index = find_free_timer();
+    if (tc_index == 0xff) {
+        return false;
+    }
+    turn_on_event_system();
+    uint8_t event_channel = find_async_event_channel();
+    if (event_channel >= EVSYS_CHANNELS) {
+        return false;
+    }
+    uint16_t* captures = (uint16_t *) m_malloc_maybe(CAPTURE_COUNT * sizeof(uint16_t), false);
+    if (captures == NULL) {
+        return false;
+    }
+    uint8_t dma_channel = audio_dma_allocate_channel();
+    if (dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        m_free(captures);
+        return false;
+    }
+    self->tc_index = tc_index;
+    self->event_channel = event_channel;
+    self->dma_channel = dma_channel;
+    self->captures = captures;
+    self->capture_index = 0;
+    self->last_edge_ms = supervisor_ticks_ms64();
+    self->quiet_ms = self->last_edge_ms;
+    active_captures[tc_index] = self;
+
+    uint8_t tc_gclk = 0;
+    #ifdef SAMD51
+    tc_gclk = 1;
+    #endif
+    set_timer_handler(true, tc_index, TC_HANDLER_NO_INTERRUPT);
+    turn_on_clocks(true, tc_index, tc_gclk);
+    Tc* tc = tc_insts[tc_index];
+    tc_set_enable(tc, false);
+    tc_reset(tc);
+    // Each event copies the count into CC0, which triggers DMA.
+    #ifdef SAMD21
+    tc->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 | TC_CTRLA_PRESCALER_DIV64;
+    tc->COUNT16.CTRLC.reg = TC_CTRLC_CPTEN0;
+    uint8_t trigger = TC3_DMAC_ID_MC_0 + 3 * tc_index;
+    connect_event_user_to_channel(EVSYS_ID_USER_TC3_EVU + tc_index, event_channel);
+    #endif
+    #ifdef SAMD51
+    tc->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 | TC_CTRLA_PRESCALER_DIV64 | TC_CTRLA_CAPTEN0;
+    uint8_t trigger = TC0_DMAC_ID_MC_0 + 3 * tc_index;
+    connect_event_user_to_channel(EVSYS_ID_USER_TC0_EVU + tc_index, event_channel);
+    #endif
+    tc->COUNT16.EVCTRL.reg = TC_EVCTRL_TCEI;
+    init_async_event_channel(event_channel, EVSYS_ID_GEN_EIC_EXTINT_0 + self->channel);
+
+    DmacDescriptor* descriptor = dma_descriptor(dma_channel);
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_HWORD | DMAC_BTCTRL_DSTINC;
+    descriptor->BTCNT.reg = CAPTURE_COUNT;
+    descriptor->SRCADDR.reg = (uint32_t) &tc->COUNT16.CC[0].reg;
+    descriptor->DSTADDR.reg = (uint32_t) (captures + CAPTURE_COUNT);
+    // Loop back to the start of the buffer.
+    descriptor->DESCADDR.reg = (uint32_t) descriptor;
+    dma_configure(dma_channel, trigger, false);
+    dma_enable_channel(dma_channel);
+
+    // Both edges generate an event but no interrupt.
+    if (eic_get_enable() == 0) {
+        turn_on_external_interrupt_controller();
+    }
+    configure_eic_channel(self->channel, EIC_CONFIG_SENSE0_BOTH_Val);
+    set_eic_event_output(self->channel, true);
+    tc_set_enable(tc, true);
+    return true;
+}
+
+STATIC void stop_capture(pulseio_pulsein_obj_t* self) {
+    set_eic_event_output(self->channel, false);
+    disable_event_channel(self->event_channel);
+    #ifdef SAMD21
+    disable_event_user(EVSYS_ID_USER_TC3_EVU + self->tc_index);
+    #endif
+    #ifdef SAMD51
+    disable_event_user(EVSYS_ID_USER_TC0_EVU + self->tc_index);
+    #endif
+    Tc* tc = tc_insts[self->tc_index];
+    tc_set_enable(tc, false);
+    tc_reset(tc);
+    audio_dma_free_channel(self->dma_channel);
+    active_captures[self->tc_index] = NULL;
+    self->tc_index = 0xff;
+}
+
 void common_hal_pulseio_pulsein_construct(pulseio_pulsein_obj_t* self,
         const mcu_pin_obj_t* pin, uint16_t maxlen, bool idle_state) {
     if (!pin->has_extint) {
@@ -129,6 +315,13 @@ void common_hal_pulseio_pulsein_construct(pulseio_pulsein_obj_t* self,
     self->last_us = 0;
     self->last_ms = 0;
     self->errored_too_fast = false;
+    self->tc_index = 0xff;
+
+    gpio_set_pin_function(pin->number, GPIO_PIN_FUNCTION_A);
+    claim_pin(pin);
+    if (start_capture(self)) {
+        return;
+    }
 
     set_eic_channel_data(pin->extint_channel, (void*) self);
 
@@ -137,12 +330,8 @@ void common_hal_pulseio_pulsein_construct(pulseio_pulsein_obj_t* self,
         turn_on_external_interrupt_controller();
     }
 
-    gpio_set_pin_function(pin->number, GPIO_PIN_FUNCTION_A);
-
     turn_on_cpu_interrupt(self->channel);
 
-    claim_pin(pin);
-
     // Set config will enable the EIC.
     pulsein_set_config(self, true);
 }
@@ -155,13 +344,22 @@ void common_hal_pulseio_pulsein_deinit(pulseio_pulsein_obj_t* self) {
     if (common_hal_pulseio_pulsein_deinited(self)) {
         return;
     }
-    set_eic_handler(self->channel, EIC_HANDLER_NO_INTERRUPT);
+    if (self->tc_index != 0xff) {
+        stop_capture(self);
+    } else {
+        set_eic_handler(self->channel, EIC_HANDLER_NO_INTERRUPT);
+    }
     turn_off_eic_channel(self->channel);
     reset_pin_number(self->pin);
     self->pin = NO_PIN;
 }
 
 void common_hal_pulseio_pulsein_pause(pulseio_pulsein_obj_t* self) {
+    if (self->tc_index != 0xff) {
+        capture_update(self);
+        tc_set_enable(tc_insts[self->tc_index], false);
+        return;
+    }
     uint32_t mask = 1 << self->channel;
     EIC->INTENCLR.reg = mask << EIC_INTENSET_EXTINT_Pos;
 }
@@ -188,6 +386,15 @@ void common_hal_pulseio_pulsein_resume(pulseio_pulsein_obj_t* self,
     self->last_ms = 0;
     self->last_us = 0;
     gpio_set_pin_function(self->pin, GPIO_PIN_FUNCTION_A);
+
+    if (self->tc_index != 0xff) {
+        // Skip anything captured before the trigger pulse.
+        self->capture_index = capture_position(self);
+        self->last_edge_ms = supervisor_ticks_ms64();
+        self->quiet_ms = self->last_edge_ms;
+        tc_set_enable(tc_insts[self->tc_index], true);
+        return;
+    }
     uint32_t mask = 1 << self->channel;
     // Clear previous interrupt state and re-enable it.
     EIC->INTFLAG.reg = mask << EIC_INTFLAG_EXTINT_Pos;
@@ -204,6 +411,9 @@ void common_hal_pulseio_pulsein_clear(pulseio_pulsein_obj_t* self) {
 }
 
 uint16_t common_hal_pulseio_pulsein_popleft(pulseio_pulsein_obj_t* self) {
+    if (self->tc_index != 0xff) {
+        capture_update(self);
+    }
     if (self->len == 0) {
         mp_raise_IndexError(translate("pop from an empty PulseIn"));
     }
@@ -221,16 +431,25 @@ uint16_t common_hal_pulseio_pulsein_get_maxlen(pulseio_pulsein_obj_t* self) {
 }
 
 uint16_t common_hal_pulseio_pulsein_get_len(pulseio_pulsein_obj_t* self) {
+    if (self->tc_index != 0xff) {
+        capture_update(self);
+    }
     return self->len;
 }
 
 bool common_hal_pulseio_pulsein_get_paused(pulseio_pulsein_obj_t* self) {
+    if (self->tc_index != 0xff) {
+        return tc_insts[self->tc_index]->COUNT16.CTRLA.bit.ENABLE == 0;
+    }
     uint32_t mask = 1 << self->channel;
     return (EIC->INTENSET.reg & (mask << EIC_INTENSET_EXTINT_Pos)) == 0;
 }
 
 uint16_t common_hal_pulseio_pulsein_get_item(pulseio_pulsein_obj_t* self,
         int16_t index) {
+    if (self->tc_index != 0xff) {
+        capture_update(self);
+    }
     common_hal_mcu_disable_interrupts();
     if (index < 0) {
         index += self->len;
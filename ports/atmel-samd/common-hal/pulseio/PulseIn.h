@@ -44,9 +44,20 @@ typedef struct {
     volatile uint64_t last_ms;
     volatile uint16_t last_us;
     volatile bool errored_too_fast;
+    // When a timer is free, edges are timestamped by TC capture and moved to
+    // captures by DMA instead of interrupting. tc_index is 0xff otherwise.
+    uint8_t tc_index;
+    uint8_t event_channel;
+    uint8_t dma_channel;
+    uint16_t* captures;
+    uint16_t capture_index;
+    uint16_t last_capture;
+    uint64_t last_edge_ms;
+    uint64_t quiet_ms;
 } pulseio_pulsein_obj_t;
 
 void pulsein_reset(void);
+void pulsein_background(void);
 
 void pulsein_interrupt_handler(uint8_t channel);
 
@@ -27,10 +27,12 @@
 #include "common-hal/pulseio/PulseOut.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #include "hal/include/hal_gpio.h"
 
 #include "mpconfigport.h"
+#include "samd/dma.h"
 #include "samd/pins.h"
 #include "samd/timers.h"
 #include "py/gc.h"
@@ -39,6 +41,8 @@
 #include "supervisor/shared/translate.h"
 #include "timer_handler.h"
 
+#include "audio_dma.h"
+
 // This timer is shared amongst all PulseOut objects under the assumption that
 // the code is single threaded.
 static uint8_t refcount = 0;
@@ -51,6 +55,12 @@ static volatile uint16_t pulse_index = 0;
 static uint16_t pulse_length;
 static volatile uint32_t current_compare = 0;
 
+// When DMA channels are free, each compare match has one channel set the pin config for the
+// next pulse and the other set the compare for the end of it, so pulses don't wait for the CPU.
+// pincfg_dma_channel is allocated first so that it goes first when both are pending.
+static uint8_t pincfg_dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+static uint8_t compare_dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+
 static void turn_on(__IO PORT_PINCFG_Type * pincfg) {
     pincfg->reg = PORT_PINCFG_PMUXEN;
 }
@@ -60,6 +70,10 @@ static void turn_off(__IO PORT_PINCFG_Type * pincfg) {
 }
 
 void pulse_finish(void) {
+    if (pulse_index >= pulse_length) {
+        // Already done. The timer runs until the send is noticed to have finished.
+        return;
+    }
     pulse_index++;
 
     if (active_pincfg == NULL) {
@@ -89,7 +103,106 @@ void pulseout_interrupt_handler(uint8_t index) {
     tc->COUNT16.INTFLAG.reg = TC_INTFLAG_MC0;
 }
 
+static void free_dma_channels(void) {
+    if (pincfg_dma_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        audio_dma_free_channel(pincfg_dma_channel);
+        pincfg_dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    }
+    if (compare_dma_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        audio_dma_free_channel(compare_dma_channel);
+        compare_dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    }
+}
+
+// Sets up DMA to send the pulses. Returns false, with nothing claimed, when DMA channels or
+// memory aren't available.
+static bool start_dma(pulseio_pulseout_obj_t* self, uint16_t* pulses, uint16_t length) {
+    // The compare for the first pulse is set before starting.
+    uint16_t compare_count = length - 1;
+    uint8_t* buffer = m_malloc_maybe(compare_count * sizeof(uint16_t) + length, false);
+    if (buffer == NULL) {
+        return false;
+    }
+    pincfg_dma_channel = audio_dma_allocate_channel();
+    if (compare_count > 0) {
+        compare_dma_channel = audio_dma_allocate_channel();
+    }
+    if (pincfg_dma_channel >= AUDIO_DMA_CHANNEL_COUNT ||
+        (compare_count > 0 && compare_dma_channel >= AUDIO_DMA_CHANNEL_COUNT)) {
+        free_dma_channels();
+        m_free(buffer);
+        return false;
+    }
+    self->buffer = buffer;
+
+    // Match i ends pulse i, so it sets the compare for the end of pulse i + 1 and the pin config
+    // for it. The last match turns the carrier off.
+    uint16_t* compares = (uint16_t*) buffer;
+    uint8_t* pincfgs = buffer + compare_count * sizeof(uint16_t);
+    uint32_t compare = current_compare;
+    for (uint16_t i = 0; i < length; i++) {
+        if (i < compare_count) {
+            compare = (compare + pulses[i + 1] * 3 / 4) & 0xffff;
+            compares[i] = compare;
+        }
+        bool on = i + 1 < length && (i + 1) % 2 == 0;
+        pincfgs[i] = on ? PORT_PINCFG_PMUXEN : PORT_PINCFG_RESETVALUE;
+    }
+
+    Tc* tc = tc_insts[pulseout_tc_index];
+    #ifdef SAMD21
+    uint8_t trigger = TC3_DMAC_ID_MC_0 + 3 * pulseout_tc_index;
+    #endif
+    #ifdef SAMD51
+    uint8_t trigger = TC0_DMAC_ID_MC_0 + 3 * pulseout_tc_index;
+    #endif
+
+    // Incrementing addresses point at the end of the block.
+    DmacDescriptor* descriptor = dma_descriptor(pincfg_dma_channel);
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_SRCINC;
+    descriptor->BTCNT.reg = length;
+    descriptor->SRCADDR.reg = (uint32_t) (pincfgs + length);
+    descriptor->DSTADDR.reg = (uint32_t) &self->pincfg->reg;
+    descriptor->DESCADDR.reg = 0;
+    dma_configure(pincfg_dma_channel, trigger, false);
+
+    if (compare_count > 0) {
+        descriptor = dma_descriptor(compare_dma_channel);
+        descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_HWORD | DMAC_BTCTRL_SRCINC;
+        descriptor->BTCNT.reg = compare_count;
+        descriptor->SRCADDR.reg = (uint32_t) (compares + compare_count);
+        descriptor->DSTADDR.reg = (uint32_t) &tc->COUNT16.CC[0].reg;
+        descriptor->DESCADDR.reg = 0;
+        dma_configure(compare_dma_channel, trigger, false);
+        dma_enable_channel(compare_dma_channel);
+    }
+    dma_enable_channel(pincfg_dma_channel);
+    return true;
+}
+
+static bool send_finished(void) {
+    if (pincfg_dma_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        return (dma_transfer_status(pincfg_dma_channel) & (DMAC_CHINTFLAG_TCMPL | DMAC_CHINTFLAG_TERR)) != 0;
+    }
+    return pulse_index >= pulse_length;
+}
+
+static void stop_send(void) {
+    Tc* tc = tc_insts[pulseout_tc_index];
+    tc->COUNT16.CTRLBSET.reg = TC_CTRLBSET_CMD_STOP;
+    if (pincfg_dma_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        free_dma_channels();
+    } else {
+        tc->COUNT16.INTENCLR.reg = TC_INTENCLR_MC0;
+        tc_disable_interrupts(pulseout_tc_index);
+    }
+    // Turn the carrier off in case the send was cut short.
+    turn_off(active_pincfg);
+    active_pincfg = NULL;
+}
+
 void pulseout_reset() {
+    free_dma_channels();
     refcount = 0;
     pulseout_tc_index = 0xff;
     active_pincfg = NULL;
@@ -142,6 +255,7 @@ void common_hal_pulseio_pulseout_construct(pulseio_pulseout_obj_t* self,
     refcount++;
 
     self->pin = carrier->pin->number;
+    self->buffer = NULL;
 
     PortGroup *const port_base = &PORT->Group[GPIO_PORT(self->pin)];
     self->pincfg = &port_base->PINCFG[self->pin % 32];
@@ -162,6 +276,10 @@ void common_hal_pulseio_pulseout_deinit(pulseio_pulseout_obj_t* self) {
     if (common_hal_pulseio_pulseout_deinited(self)) {
         return;
     }
+    if (active_pincfg == self->pincfg) {
+        stop_send();
+    }
+    self->buffer = NULL;
     PortGroup *const port_base = &PORT->Group[GPIO_PORT(self->pin)];
     port_base->DIRCLR.reg = 1 << (self->pin % 32);
 
@@ -175,34 +293,56 @@ void common_hal_pulseio_pulseout_deinit(pulseio_pulseout_obj_t* self) {
     self->pin = NO_PIN;
 }
 
-void common_hal_pulseio_pulseout_send(pulseio_pulseout_obj_t* self, uint16_t* pulses, uint16_t length) {
+void common_hal_pulseio_pulseout_start(pulseio_pulseout_obj_t* self, uint16_t* pulses, uint16_t length) {
     if (active_pincfg != NULL) {
-        mp_raise_RuntimeError(translate("Another send is already active"));
+        if (!send_finished()) {
+            mp_raise_RuntimeError(translate("Another send is already active"));
+        }
+        stop_send();
+    }
+    self->buffer = NULL;
+    if (length == 0) {
+        return;
     }
-    active_pincfg = self->pincfg;
-    pulse_buffer = pulses;
-    pulse_index = 0;
-    pulse_length = length;
-
     current_compare = pulses[0] * 3 / 4;
     Tc* tc = tc_insts[pulseout_tc_index];
     tc->COUNT16.CC[0].reg = current_compare;
-
     // Clear our interrupt in case it was set earlier
     tc->COUNT16.INTFLAG.reg = TC_INTFLAG_MC0;
-    tc->COUNT16.INTENSET.reg = TC_INTENSET_MC0;
-    tc_enable_interrupts(pulseout_tc_index);
+
+    if (!start_dma(self, pulses, length)) {
+        // Fall back to moving on from the interrupt, which reads its own copy of the pulses.
+        uint16_t* copy = m_new(uint16_t, length);
+        memcpy(copy, pulses, length * sizeof(uint16_t));
+        self->buffer = copy;
+        pulse_buffer = copy;
+        pulse_index = 0;
+        pulse_length = length;
+        tc->COUNT16.INTENSET.reg = TC_INTENSET_MC0;
+        tc_enable_interrupts(pulseout_tc_index);
+    }
+    active_pincfg = self->pincfg;
     turn_on(active_pincfg);
     tc->COUNT16.CTRLBSET.reg = TC_CTRLBSET_CMD_RETRIGGER;
+}
+
+bool common_hal_pulseio_pulseout_get_sending(pulseio_pulseout_obj_t* self) {
+    if (active_pincfg != self->pincfg) {
+        return false;
+    }
+    if (!send_finished()) {
+        return true;
+    }
+    stop_send();
+    self->buffer = NULL;
+    return false;
+}
 
-    while(pulse_index < length) {
-        // Do other things while we wait. The interrupts will handle sending the
+void common_hal_pulseio_pulseout_send(pulseio_pulseout_obj_t* self, uint16_t* pulses, uint16_t length) {
+    common_hal_pulseio_pulseout_start(self, pulses, length);
+    while (common_hal_pulseio_pulseout_get_sending(self)) {
+        // Do other things while we wait. DMA or the interrupts will handle sending the
         // signal.
         RUN_BACKGROUND_TASKS;
     }
-
-    tc->COUNT16.CTRLBSET.reg = TC_CTRLBSET_CMD_STOP;
-    tc->COUNT16.INTENCLR.reg = TC_INTENCLR_MC0;
-    tc_disable_interrupts(pulseout_tc_index);
-    active_pincfg = NULL;
 }
@@ -35,6 +35,9 @@ typedef struct {
     mp_obj_base_t base;
     __IO PORT_PINCFG_Type *pincfg;
     uint8_t pin;
+    // What the current send reads: a copy of the pulses when an interrupt sends them, or the
+    // compare values followed by the pin configs when DMA does.
+    void *buffer;
 } pulseio_pulseout_obj_t;
 
 void pulseout_reset(void);
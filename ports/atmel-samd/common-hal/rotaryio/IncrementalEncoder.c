@@ -29,25 +29,125 @@
 #include "atmel_start_pins.h"
 
 #include "eic_handler.h"
+#include "samd/clocks.h"
 #include "samd/external_interrupts.h"
 #include "py/runtime.h"
+#include "supervisor/shared/tick.h"
 #include "supervisor/shared/translate.h"
 
+// One encoder for each pair of EIC channels, plus one on the PDEC.
+#define MAX_ENCODERS (EIC_EXTINT_NUM / 2 + 1)
+
+// Encoders whose velocity is sampled in the background.
+static rotaryio_incrementalencoder_obj_t* active_encoders[MAX_ENCODERS];
+
+#ifdef SAMD51
+#define NO_PDEC_INPUT 0xff
+
+static bool pdec_in_use;
+
+// Returns which PDEC quadrature input (0 for phase A, 1 for phase B) the pin can be routed to.
+STATIC uint8_t pdec_input(uint8_t pin) {
+    switch (pin) {
+        #ifdef PIN_PA24G_PDEC_QDI0
+        case PIN_PA24G_PDEC_QDI0:
+        #endif
+        #ifdef PIN_PB18G_PDEC_QDI0
+        case PIN_PB18G_PDEC_QDI0:
+        #endif
+        #ifdef PIN_PB22G_PDEC_QDI0
+        case PIN_PB22G_PDEC_QDI0:
+        #endif
+            return 0;
+        #ifdef PIN_PA25G_PDEC_QDI1
+        case PIN_PA25G_PDEC_QDI1:
+        #endif
+        #ifdef PIN_PB19G_PDEC_QDI1
+        case PIN_PB19G_PDEC_QDI1:
+        #endif
+        #ifdef PIN_PB23G_PDEC_QDI1
+        case PIN_PB23G_PDEC_QDI1:
+        #endif
+            return 1;
+        default:
+            return NO_PDEC_INPUT;
+    }
+}
+
+STATIC void pdec_sync(void) {
+    while (PDEC->SYNCBUSY.reg != 0) {}
+}
+
+STATIC uint16_t pdec_count(void) {
+    PDEC->CTRLBSET.reg = PDEC_CTRLBSET_CMD_READSYNC;
+    pdec_sync();
+    return PDEC->COUNT.reg;
+}
+
+STATIC void pdec_start(bool swap) {
+    MCLK->APBCMASK.bit.PDEC_ = true;
+    connect_gclk_to_peripheral(1, PDEC_GCLK_ID);
+
+    PDEC->CTRLA.reg = PDEC_CTRLA_SWRST;
+    pdec_sync();
+    // Count every edge of both phases on a 16 bit angular counter that wraps around. The
+    // position is worked out from the change in count so the wrap doesn't matter.
+    PDEC->CTRLA.reg = PDEC_CTRLA_MODE_QDEC | PDEC_CTRLA_CONF_X4 | PDEC_CTRLA_ANGULAR(7) |
+        PDEC_CTRLA_PINEN0 | PDEC_CTRLA_PINEN1 | (swap ? PDEC_CTRLA_SWAP : 0);
+    PDEC->CC[0].reg = 0xffff;
+    // Sample the inputs at 750kHz and ignore contact bounce shorter than 100us.
+    PDEC->PRESC.reg = PDEC_PRESC_PRESC_DIV64;
+    PDEC->FILTER.reg = PDEC_FILTER_FILTER(75);
+    pdec_sync();
+    PDEC->CTRLA.bit.ENABLE = true;
+    pdec_sync();
+    PDEC->CTRLBSET.reg = PDEC_CTRLBSET_CMD_START;
+    pdec_sync();
+    pdec_in_use = true;
+}
+
+STATIC void pdec_stop(void) {
+    PDEC->CTRLA.reg = PDEC_CTRLA_SWRST;
+    pdec_sync();
+    disconnect_gclk_from_peripheral(1, PDEC_GCLK_ID);
+    MCLK->APBCMASK.bit.PDEC_ = false;
+    pdec_in_use = false;
+}
+
+// Folds the edges counted by the PDEC since the last update into the position.
+STATIC void pdec_update(rotaryio_incrementalencoder_obj_t* self) {
+    uint16_t count = pdec_count();
+    int32_t quarters = self->quarter_count + (int16_t) (count - self->last_count);
+    self->last_count = count;
+    self->position += quarters / 4;
+    self->quarter_count = quarters % 4;
+}
+#endif
+
 void common_hal_rotaryio_incrementalencoder_construct(rotaryio_incrementalencoder_obj_t* self,
     const mcu_pin_obj_t* pin_a, const mcu_pin_obj_t* pin_b) {
-    if (!pin_a->has_extint || !pin_b->has_extint) {
-        mp_raise_RuntimeError(translate("Both pins must support hardware interrupts"));
-    }
+    // The SAMD51 has a peripheral dedicated to quadrature decoding. Use it when it's free and
+    // the pins can reach it, and fall back to the external interrupts otherwise.
+    self->pdec = false;
+    #ifdef SAMD51
+    uint8_t input_a = pdec_input(pin_a->number);
+    uint8_t input_b = pdec_input(pin_b->number);
+    self->pdec = !pdec_in_use && input_a != NO_PDEC_INPUT && input_b != NO_PDEC_INPUT &&
+        input_a != input_b;
+    #endif
 
-    // TODO: The SAMD51 has a peripheral dedicated to quadrature encoder debugging. Use it instead
-    // of the external interrupt.
+    if (!self->pdec) {
+        if (!pin_a->has_extint || !pin_b->has_extint) {
+            mp_raise_RuntimeError(translate("Both pins must support hardware interrupts"));
+        }
 
-    if (eic_get_enable()) {
-        if (!eic_channel_free(pin_a->extint_channel) || !eic_channel_free(pin_b->extint_channel)) {
-            mp_raise_RuntimeError(translate("A hardware interrupt channel is already in use"));
+        if (eic_get_enable()) {
+            if (!eic_channel_free(pin_a->extint_channel) || !eic_channel_free(pin_b->extint_channel)) {
+                mp_raise_RuntimeError(translate("A hardware interrupt channel is already in use"));
+            }
+        } else {
+            turn_on_external_interrupt_controller();
         }
-    } else {
-        turn_on_external_interrupt_controller();
     }
 
     // These default settings apply when the EIC isn't yet enabled.
@@ -56,6 +156,35 @@ void common_hal_rotaryio_incrementalencoder_construct(rotaryio_incrementalencode
     self->pin_a = pin_a->number;
     self->pin_b = pin_b->number;
 
+    self->position = 0;
+    self->quarter_count = 0;
+    self->sample_index = 0;
+    self->sample_count = 0;
+
+    claim_pin(pin_a);
+    claim_pin(pin_b);
+
+    for (size_t i = 0; i < MAX_ENCODERS; i++) {
+        if (active_encoders[i] == NULL) {
+            active_encoders[i] = self;
+            break;
+        }
+    }
+
+    #ifdef SAMD51
+    if (self->pdec) {
+        gpio_set_pin_function(self->pin_a, GPIO_PIN_FUNCTION_G);
+        gpio_set_pin_pull_mode(self->pin_a, GPIO_PULL_UP);
+
+        gpio_set_pin_function(self->pin_b, GPIO_PIN_FUNCTION_G);
+        gpio_set_pin_pull_mode(self->pin_b, GPIO_PULL_UP);
+
+        pdec_start(input_a == 1);
+        self->last_count = pdec_count();
+        return;
+    }
+    #endif
+
     gpio_set_pin_function(self->pin_a, GPIO_PIN_FUNCTION_A);
     gpio_set_pin_pull_mode(self->pin_a, GPIO_PULL_UP);
 
@@ -65,18 +194,12 @@ void common_hal_rotaryio_incrementalencoder_construct(rotaryio_incrementalencode
     set_eic_channel_data(self->eic_channel_a, (void*) self);
     set_eic_channel_data(self->eic_channel_b, (void*) self);
 
-    self->position = 0;
-    self->quarter_count = 0;
-
     // Top two bits of self->last_state don't matter, because they'll be gone as soon as
     // interrupt handler is called.
     self->last_state =
         ((uint8_t) gpio_get_pin_level(self->pin_a) << 1) |
         (uint8_t) gpio_get_pin_level(self->pin_b);
 
-    claim_pin(pin_a);
-    claim_pin(pin_b);
-
     set_eic_handler(self->eic_channel_a, EIC_HANDLER_INCREMENTAL_ENCODER);
     turn_on_eic_channel(self->eic_channel_a, EIC_CONFIG_SENSE0_BOTH_Val);
 
@@ -93,11 +216,24 @@ void common_hal_rotaryio_incrementalencoder_deinit(rotaryio_incrementalencoder_o
         return;
     }
 
-    set_eic_handler(self->eic_channel_a, EIC_HANDLER_NO_INTERRUPT);
-    turn_off_eic_channel(self->eic_channel_a);
+    for (size_t i = 0; i < MAX_ENCODERS; i++) {
+        if (active_encoders[i] == self) {
+            active_encoders[i] = NULL;
+        }
+    }
 
-    set_eic_handler(self->eic_channel_b, EIC_HANDLER_NO_INTERRUPT);
-    turn_off_eic_channel(self->eic_channel_b);
+    #ifdef SAMD51
+    if (self->pdec) {
+        pdec_stop();
+    } else
+    #endif
+    {
+        set_eic_handler(self->eic_channel_a, EIC_HANDLER_NO_INTERRUPT);
+        turn_off_eic_channel(self->eic_channel_a);
+
+        set_eic_handler(self->eic_channel_b, EIC_HANDLER_NO_INTERRUPT);
+        turn_off_eic_channel(self->eic_channel_b);
+    }
 
     reset_pin_number(self->pin_a);
     self->pin_a = NO_PIN;
@@ -107,14 +243,64 @@ void common_hal_rotaryio_incrementalencoder_deinit(rotaryio_incrementalencoder_o
 }
 
 mp_int_t common_hal_rotaryio_incrementalencoder_get_position(rotaryio_incrementalencoder_obj_t* self) {
+    #ifdef SAMD51
+    if (self->pdec) {
+        pdec_update(self);
+    }
+    #endif
     return self->position;
 }
 
 void common_hal_rotaryio_incrementalencoder_set_position(rotaryio_incrementalencoder_obj_t* self,
         mp_int_t new_position) {
+    // Shift the velocity samples along with the position so the jump doesn't count as movement.
+    mp_int_t shift = new_position - common_hal_rotaryio_incrementalencoder_get_position(self);
+    for (size_t i = 0; i < VELOCITY_SAMPLES; i++) {
+        self->sample_positions[i] += shift;
+    }
     self->position = new_position;
 }
 
+mp_float_t common_hal_rotaryio_incrementalencoder_get_velocity(rotaryio_incrementalencoder_obj_t* self) {
+    if (self->sample_count < 2) {
+        return 0;
+    }
+    size_t newest = (self->sample_index + VELOCITY_SAMPLES - 1) % VELOCITY_SAMPLES;
+    size_t oldest = (self->sample_index + VELOCITY_SAMPLES - self->sample_count) % VELOCITY_SAMPLES;
+    uint32_t elapsed_ms = self->sample_ms[newest] - self->sample_ms[oldest];
+    if (elapsed_ms == 0) {
+        return 0;
+    }
+    return (mp_float_t) (self->sample_positions[newest] - self->sample_positions[oldest]) * 1000 / elapsed_ms;
+}
+
+void incrementalencoder_background(void) {
+    uint32_t now = supervisor_ticks_ms32();
+    for (size_t i = 0; i < MAX_ENCODERS; i++) {
+        rotaryio_incrementalencoder_obj_t* self = active_encoders[i];
+        if (self == NULL) {
+            continue;
+        }
+        self->sample_positions[self->sample_index] = common_hal_rotaryio_incrementalencoder_get_position(self);
+        self->sample_ms[self->sample_index] = now;
+        self->sample_index = (self->sample_index + 1) % VELOCITY_SAMPLES;
+        if (self->sample_count < VELOCITY_SAMPLES) {
+            self->sample_count++;
+        }
+    }
+}
+
+void incrementalencoder_reset(void) {
+    for (size_t i = 0; i < MAX_ENCODERS; i++) {
+        active_encoders[i] = NULL;
+    }
+    #ifdef SAMD51
+    if (pdec_in_use) {
+        pdec_stop();
+    }
+    #endif
+}
+
 void incrementalencoder_interrupt_handler(uint8_t channel) {
     rotaryio_incrementalencoder_obj_t* self = get_eic_channel_data(channel);
 
@@ -31,6 +31,11 @@
 
 #include "py/obj.h"
 
+// Velocity is the change in position over the last VELOCITY_SAMPLES samples, taken every
+// VELOCITY_SAMPLE_MS milliseconds.
+#define VELOCITY_SAMPLES 4
+#define VELOCITY_SAMPLE_MS 25
+
 typedef struct {
     mp_obj_base_t base;
     uint8_t pin_a;
@@ -39,10 +44,18 @@ typedef struct {
     uint8_t eic_channel_b:4;
     uint8_t last_state:4;   // <old A><old B><new A><new B>
     int8_t quarter_count:4; // count intermediate transitions between detents
+    bool pdec;              // decoded by the PDEC instead of the EIC
+    uint16_t last_count;    // PDEC count when position was last updated
+    uint8_t sample_index;
+    uint8_t sample_count;
     mp_int_t position;
+    mp_int_t sample_positions[VELOCITY_SAMPLES];
+    uint32_t sample_ms[VELOCITY_SAMPLES];
 } rotaryio_incrementalencoder_obj_t;
 
 
 void incrementalencoder_interrupt_handler(uint8_t channel);
+void incrementalencoder_background(void);
+void incrementalencoder_reset(void);
 
 #endif // MICROPY_INCLUDED_ATMEL_SAMD_COMMON_HAL_ROTARYIO_INCREMENTALENCODER_H
@@ -44,9 +44,20 @@
 
 #include "tick.h"
 #include "adafruit_ptc.h"
+#include "supervisor/shared/background_task.h"
 
 bool touch_enabled = false;
 
+// Pads are measured one at a time in the background, one conversion per tick, so reading a pad
+// returns its latest filtered value instead of waiting for a conversion.
+static touchio_touchin_obj_t *scan_pads;
+// The pad being measured, if any.
+static touchio_touchin_obj_t *scan_converting;
+// The pad measured last. The next one measured follows it.
+static touchio_touchin_obj_t *scan_last;
+static bool scan_paused;
+static background_task_t scan_task;
+
 static uint16_t get_raw_reading(touchio_touchin_obj_t *self) {
     adafruit_ptc_start_conversion(PTC, &self->config);
 
@@ -58,42 +69,50 @@ static uint16_t get_raw_reading(touchio_touchin_obj_t *self) {
     return adafruit_ptc_get_conversion_result(PTC);
 }
 
-void common_hal_touchio_touchin_construct(touchio_touchin_obj_t* self,
-        const mcu_pin_obj_t *pin) {
-    if (!pin->has_touch) {
-        mp_raise_ValueError(translate("Invalid pin"));
-    }
-    claim_pin(pin);
-
-    // Turn on the PTC if its not in use. We won't turn it off until reset.
-    if ((( Ptc *) PTC)->CTRLA.bit.ENABLE == 0) {
-        // We run the PTC at 8mhz so divide the 48mhz clock by 6.
-        uint8_t gclk = find_free_gclk(6);
-        if (gclk > GCLK_GEN_NUM) {
-            mp_raise_RuntimeError(translate("No free GCLKs"));
-        }
-        enable_clock_generator(gclk, CLOCK_48MHZ, 6);
-
-        /* Setup and enable generic clock source for PTC module. */
-        connect_gclk_to_peripheral(gclk, PTC_GCLK_ID);
+static bool is_touched(touchio_touchin_obj_t *self) {
+    return (int32_t) (self->filtered - self->baseline) > self->threshold_offset * 256;
+}
 
-        _pm_enable_bus_clock(PM_BUS_APBC, PTC);
+static void update_pad(touchio_touchin_obj_t *self, uint16_t reading) {
+    uint32_t sample = reading << 8;
+    // Average over about four readings.
+    self->filtered += ((int32_t) (sample - self->filtered)) >> 2;
+    // The baseline follows readings that fall quickly, as when a touch is released, and follows
+    // those that rise slowly so that a touch isn't taken into it. It holds while touched.
+    int32_t drift = self->filtered - self->baseline;
+    if (drift < 0) {
+        self->baseline += drift >> 4;
+    } else if (!is_touched(self)) {
+        self->baseline += drift >> 8;
     }
+}
 
-    adafruit_ptc_get_config_default(&self->config);
-    self->config.pin = pin->number;
-    self->config.yline = pin->touch_y_line;
-
-    adafruit_ptc_init(PTC, &self->config);
-
-    // Initial values for pins will vary, depending on what peripherals the pins
-    // share on-chip.
-    //
-    // Set a "touched" threshold not too far above the initial value.
-    // For simple finger touch, the values may vary as much as a factor of two,
-    // but for touches using fruit or other objects, the difference is much less.
+static void touchin_background(void) {
+    if (scan_converting != NULL) {
+        if (!adafruit_ptc_is_conversion_finished(PTC)) {
+            return;
+        }
+        update_pad(scan_converting, adafruit_ptc_get_conversion_result(PTC));
+        scan_last = scan_converting;
+        scan_converting = NULL;
+    }
+    if (scan_paused || scan_pads == NULL) {
+        return;
+    }
+    touchio_touchin_obj_t *pad = scan_last == NULL ? NULL : scan_last->next;
+    if (pad == NULL) {
+        pad = scan_pads;
+    }
+    scan_converting = pad;
+    adafruit_ptc_start_conversion(PTC, &pad->config);
+}
 
-    self->threshold = get_raw_reading(self) + 100;
+// Waits for the pad being measured, if any, so the PTC can be used directly.
+static void pause_scan(void) {
+    scan_paused = true;
+    while (scan_converting != NULL) {
+        RUN_BACKGROUND_TASKS;
+    }
 }
 
 bool common_hal_touchio_touchin_deinited(touchio_touchin_obj_t* self) {
@@ -107,11 +126,32 @@ void common_hal_touchio_touchin_deinit(touchio_touchin_obj_t* self) {
     }
     // We leave the clocks running because they may be in use by others.
 
+    pause_scan();
+    for (touchio_touchin_obj_t **pad = &scan_pads; *pad != NULL; pad = &(*pad)->next) {
+        if (*pad == self) {
+            *pad = self->next;
+            break;
+        }
+    }
+    if (scan_last == self) {
+        scan_last = NULL;
+    }
+    if (scan_pads == NULL) {
+        background_task_remove(&scan_task);
+    }
+    scan_paused = false;
+
     reset_pin_number(self->config.pin);
     self->config.pin = NO_PIN;
 }
 
 void touchin_reset() {
+    background_task_remove(&scan_task);
+    scan_pads = NULL;
+    scan_converting = NULL;
+    scan_last = NULL;
+    scan_paused = false;
+
     Ptc* ptc = ((Ptc *) PTC);
     if (ptc->CTRLA.bit.ENABLE == 1) {
         ptc->CTRLA.bit.ENABLE = 0;
@@ -123,20 +163,26 @@ void touchin_reset() {
 }
 
 bool common_hal_touchio_touchin_get_value(touchio_touchin_obj_t *self) {
-    uint16_t reading = get_raw_reading(self);
-    return reading > self->threshold;
+    return is_touched(self);
 }
 
 uint16_t common_hal_touchio_touchin_get_raw_value(touchio_touchin_obj_t *self) {
-    return get_raw_reading(self);
+    return self->filtered >> 8;
 }
 
 uint16_t common_hal_touchio_touchin_get_threshold(touchio_touchin_obj_t *self) {
-    return self->threshold;
+    int32_t threshold = (self->baseline >> 8) + self->threshold_offset;
+    if (threshold < 0) {
+        return 0;
+    }
+    if (threshold > UINT16_MAX) {
+        return UINT16_MAX;
+    }
+    return threshold;
 }
 
 void common_hal_touchio_touchin_set_threshold(touchio_touchin_obj_t *self, uint16_t new_threshold) {
-    self->threshold = new_threshold;
+    self->threshold_offset = new_threshold - (int32_t) (self->baseline >> 8);
 }
 
 #endif // SAMD21
@@ -37,10 +37,17 @@
 
 #include "py/obj.h"
 
-typedef struct {
+typedef struct _touchio_touchin_obj_t {
     mp_obj_base_t base;
     struct adafruit_ptc_config config;
-    uint16_t threshold;
+    // Next pad in the background scan.
+    struct _touchio_touchin_obj_t *next;
+    // Readings in 1/256ths of a count. filtered is a running average of the raw readings and
+    // baseline follows it slowly while the pad isn't touched.
+    uint32_t filtered;
+    uint32_t baseline;
+    // Distance of the threshold above the baseline.
+    int32_t threshold_offset;
 } touchio_touchin_obj_t;
 
 void touchin_reset(void);
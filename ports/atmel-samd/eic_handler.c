@@ -31,6 +31,11 @@
 //#include "samd/external_interrupts.h"
 #include "eic_handler.h"
 
+#if CIRCUITPY_BACKGROUND_TRACE
+#include "supervisor/port.h"
+#include "supervisor/shared/background_trace.h"
+#endif
+
 // Which handler should be called for a particular channel?
 static uint8_t eic_channel_handler[EIC_EXTINT_NUM];
 
@@ -39,6 +44,9 @@ void set_eic_handler(uint8_t channel, uint8_t eic_handler) {
 }
 
 void shared_eic_handler(uint8_t channel) {
+    #if CIRCUITPY_BACKGROUND_TRACE
+    uint32_t trace_start = port_get_cycle_count();
+    #endif
     uint8_t handler = eic_channel_handler[channel];
     switch (handler) {
 #if CIRCUITPY_PULSEIO
@@ -62,4 +70,7 @@ void shared_eic_handler(uint8_t channel) {
     default:
         break;
     }
+    #if CIRCUITPY_BACKGROUND_TRACE
+    background_trace_record(BACKGROUND_TRACE_EIC, trace_start);
+    #endif
 }
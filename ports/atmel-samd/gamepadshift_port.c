@@ -0,0 +1,59 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-module/gamepadshift/__init__.h"
+
+#include "hal/include/hal_gpio.h"
+#include "sam.h"
+
+// Drives the shift registers through the PORT registers. This runs from the
+// tick interrupt, where going through digitalio for every edge costs too much.
+// The pins were set up as push-pull outputs and an input by GamePadShift.
+uint32_t gamepadshift_shift_in(gamepadshift_obj_t *self) {
+    const uint8_t clock = self->clock_pin->pin->number;
+    const uint8_t data = self->data_pin->pin->number;
+    const uint8_t latch = self->latch_pin->pin->number;
+    PortGroup *const clock_group = &PORT->Group[GPIO_PORT(clock)];
+    PortGroup *const data_group = &PORT->Group[GPIO_PORT(data)];
+    PortGroup *const latch_group = &PORT->Group[GPIO_PORT(latch)];
+    const uint32_t clock_mask = 1U << GPIO_PIN(clock);
+    const uint32_t data_mask = 1U << GPIO_PIN(data);
+    const uint32_t latch_mask = 1U << GPIO_PIN(latch);
+
+    uint32_t current = 0;
+    uint32_t bit = 1;
+    latch_group->OUTSET.reg = latch_mask;
+    for (int i = 0; i < self->buttons; ++i) {
+        clock_group->OUTCLR.reg = clock_mask;
+        if (data_group->IN.reg & data_mask) {
+            current |= bit;
+        }
+        clock_group->OUTSET.reg = clock_mask;
+        bit <<= 1;
+    }
+    latch_group->OUTCLR.reg = latch_mask;
+    return current;
+}
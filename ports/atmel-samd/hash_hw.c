@@ -0,0 +1,139 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <string.h>
+
+#include "py/obj.h"
+#include "extmod/modubinascii.h"
+#include "extmod/moduhashlib.h"
+
+#include "sam.h"
+
+// SHA1 and SHA256 on the Integrity Check Monitor, and CRC-32 on the Device
+// Service Unit. Both read memory themselves, so whole buffers are handed over
+// at once.
+
+// In a region descriptor, marks the last region to hash. The algorithm comes
+// from CFG.UALGO because the initial hash value is given in UIHVAL.
+#define ICM_RCFG_EOM (1 << 2)
+
+typedef struct {
+    uint32_t raddr;
+    uint32_t rcfg;
+    uint32_t rctrl; // number of 64 byte blocks - 1
+    uint32_t rnext;
+} icm_descriptor_t;
+
+// The ICM requires the descriptor list to be 64 byte aligned and the hash
+// area 128 byte aligned.
+static volatile icm_descriptor_t icm_descriptor __attribute__((aligned(64)));
+static volatile uint32_t icm_hash_area[8] __attribute__((aligned(128)));
+
+void mp_hal_sha_blocks(int algo, uint8_t *state, const uint8_t *data, size_t n) {
+    MCLK->AHBMASK.bit.ICM_ = true;
+    MCLK->APBCMASK.bit.ICM_ = true;
+    size_t state_len = algo == MP_HASH_SHA1 ? 20 : 32;
+    uint32_t block[16];
+    while (n > 0) {
+        const uint8_t *src = data;
+        // The transfer size field is 16 bits wide.
+        size_t count = MIN(n, 0x10000);
+        // The ICM reads whole words, so unaligned data is copied a block at a time.
+        if (((uintptr_t)data & 3) != 0) {
+            memcpy(block, data, 64);
+            src = (const uint8_t*)block;
+            count = 1;
+        }
+        ICM->CTRL.reg = ICM_CTRL_SWRST;
+        icm_descriptor.raddr = (uint32_t)src;
+        icm_descriptor.rcfg = ICM_RCFG_EOM;
+        icm_descriptor.rctrl = count - 1;
+        icm_descriptor.rnext = 0;
+        ICM->DSCR.reg = (uint32_t)&icm_descriptor;
+        ICM->HASH.reg = (uint32_t)icm_hash_area;
+        ICM->CFG.reg = ICM_CFG_UIHASH | (algo == MP_HASH_SHA1 ? ICM_CFG_UALGO_SHA1 : ICM_CFG_UALGO_SHA256);
+        // UIHVAL takes the state in the byte order of the digest.
+        for (size_t i = 0; i < state_len / 4; i++) {
+            uint32_t word;
+            memcpy(&word, state + i * 4, 4);
+            ICM->UIHVAL[i].reg = word;
+        }
+        ICM->CTRL.reg = ICM_CTRL_ENABLE;
+        while ((ICM->ISR.reg & ICM_ISR_RHC(1)) == 0) {
+        }
+        ICM->CTRL.reg = ICM_CTRL_DISABLE;
+        for (size_t i = 0; i < state_len / 4; i++) {
+            uint32_t word = icm_hash_area[i];
+            memcpy(state + i * 4, &word, 4);
+        }
+        data += count * 64;
+        n -= count;
+    }
+}
+
+static uint32_t crc32_bytes(uint32_t crc, const uint8_t *data, size_t len) {
+    while (len-- > 0) {
+        crc ^= *data++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ (0xedb88320 & -(crc & 1));
+        }
+    }
+    return crc;
+}
+
+uint32_t mp_hal_crc32(uint32_t crc, const uint8_t *data, size_t len) {
+    // The DSU works on whole words at word aligned addresses, so the bytes
+    // either side are done here.
+    size_t head = MIN((4 - ((uintptr_t)data & 3)) & 3, len);
+    crc = crc32_bytes(crc, data, head);
+    data += head;
+    len -= head;
+    size_t words = len & ~3;
+    if (words > 0) {
+        // The DSU is write protected by the PAC out of reset.
+        PAC->WRCTRL.reg = PAC_WRCTRL_PERID(ID_DSU) | PAC_WRCTRL_KEY_CLR;
+        DSU->STATUSA.reg = DSU_STATUSA_DONE | DSU_STATUSA_BERR;
+        DSU->ADDR.reg = (uint32_t)data;
+        // LENGTH counts words from bit 2, so takes the byte count as is.
+        DSU->LENGTH.reg = words;
+        DSU->DATA.reg = crc;
+        DSU->CTRL.reg = DSU_CTRL_CRC;
+        while (!DSU->STATUSA.bit.DONE) {
+        }
+        if (DSU->STATUSA.bit.BERR) {
+            // Memory the DSU can't read, such as with the device protected.
+            crc = crc32_bytes(crc, data, words);
+        } else {
+            crc = DSU->DATA.reg;
+        }
+        DSU->STATUSA.reg = DSU_STATUSA_DONE | DSU_STATUSA_BERR;
+        PAC->WRCTRL.reg = PAC_WRCTRL_PERID(ID_DSU) | PAC_WRCTRL_KEY_SET;
+        data += words;
+        len -= words;
+    }
+    return crc32_bytes(crc, data, len);
+}
@@ -49,6 +49,7 @@
 #define MICROPY_PY_IO                               (0)
 #define MICROPY_PY_UJSON                            (0)
 #define MICROPY_PY_REVERSE_SPECIAL_METHODS          (0)
+#define MICROPY_COMPILE_BY_STATEMENT                (1)
 #define MICROPY_PY_UERRNO_LIST \
     X(EPERM) \
     X(ENOENT) \
@@ -81,6 +82,17 @@
 #define MICROPY_PY_UJSON                            (1)
 #define MICROPY_PY_REVERSE_SPECIAL_METHODS          (1)
 //      MICROPY_PY_UERRNO_LIST - Use the default
+#define MICROPY_OPT_ATTR_LOOKUP_CACHE_SIZE          (32)
+// Hashing is done by the ICM and DSU in hash_hw.c
+#define MICROPY_PY_UHASHLIB                         (1)
+#define MICROPY_PY_UHASHLIB_SHA1                    (1)
+#define MICROPY_PY_UHASHLIB_HW                      (1)
+#define MICROPY_PY_UBINASCII                        (1)
+#define MICROPY_PY_UBINASCII_CRC32                  (1)
+#define MICROPY_PY_UBINASCII_CRC32_HW               (1)
+// Hot functions are copied to RAM at startup to avoid flash wait states, alongside the other
+// .ramfunc code. See boards/common.template.ld.
+#define PLACE_IN_ITCM(name) __attribute__((section(".ramfunc." #name))) name
 
 #endif // SAMD51
 
@@ -18,6 +18,19 @@ ifeq ($(LONGINT_IMPL),LONGLONG)
 MPY_TOOL_LONGINT_IMPL = -mlongint-impl=longlong
 endif
 
+# audiobusio.I2SIn is implemented for both SAMD21 and SAMD51.
+ifndef CIRCUITPY_AUDIOBUSIO_I2SIN
+CIRCUITPY_AUDIOBUSIO_I2SIN = $(CIRCUITPY_AUDIOBUSIO)
+endif
+
+ifndef CIRCUITPY_DIGITALIO_PORT
+CIRCUITPY_DIGITALIO_PORT = $(CIRCUITPY_FULL_BUILD)
+endif
+
+ifndef CIRCUITPY_COUNTIO
+CIRCUITPY_COUNTIO = $(CIRCUITPY_FULL_BUILD)
+endif
+
 # Put samd21-only choices here.
 ifeq ($(CHIP_FAMILY),samd21)
 # frequencyio not yet verified as working on SAMD21, though make it possible to override.
@@ -67,3 +80,13 @@ endif # samd51
 INTERNAL_LIBM = 1
 
 USB_SERIAL_NUMBER_LENGTH = 32
+
+# TinyUSB's task runs in PendSV. See supervisor/usb.c.
+ifndef CIRCUITPY_USB_IRQ_TASK
+CIRCUITPY_USB_IRQ_TASK = 1
+endif
+
+# Cycles are counted with the DWT on the SAMD51, SysTick on the SAMD21. See supervisor/port.c.
+ifndef CIRCUITPY_CYCLE_COUNTER
+CIRCUITPY_CYCLE_COUNTER = 1
+endif
@@ -60,7 +60,9 @@ void mp_hal_delay_ms(mp_uint_t delay) {
             break;
         }
         duration = (supervisor_ticks_ms64() - start_tick);
-        // TODO(tannewt): Go to sleep for a little while while we wait.
+        if (duration < delay) {
+            supervisor_idle();
+        }
     }
 }
 
@@ -68,13 +70,13 @@ void mp_hal_delay_ms(mp_uint_t delay) {
 // Do a simple timing loop to wait for a certain number of microseconds.
 // Can be used when interrupts are disabled, which makes tick_delay() unreliable.
 //
-// Testing done at 48 MHz on SAMD21 and 120 MHz on SAMD51, multiplication and division cancel out.
-// But get the frequency just in case.
+// Testing done at 48 MHz on SAMD21 and 120 MHz on SAMD51. The number of
+// iterations scales with the frequency because the SAMD51 CPU clock can change.
 #ifdef SAMD21
-#define DELAY_LOOP_ITERATIONS_PER_US ( (10U*48000000U) / common_hal_mcu_processor_get_frequency())
+#define DELAY_LOOP_ITERATIONS_PER_US ( common_hal_mcu_processor_get_frequency() / 4800000U)
 #endif
 #ifdef SAMD51
-#define DELAY_LOOP_ITERATIONS_PER_US ( (30U*120000000U) / common_hal_mcu_processor_get_frequency())
+#define DELAY_LOOP_ITERATIONS_PER_US ( common_hal_mcu_processor_get_frequency() / 4000000U)
 #endif
 
 void mp_hal_delay_us(mp_uint_t delay) {
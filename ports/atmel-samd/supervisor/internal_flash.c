@@ -41,6 +41,7 @@
 #endif
 #include "hal/include/hal_flash.h"
 
+#include "supervisor/flash.h"
 #include "supervisor/shared/rgb_led_status.h"
 
 static struct flash_descriptor supervisor_flash_desc;
@@ -92,6 +93,14 @@ static int32_t convert_block_to_flash_addr(uint32_t block) {
     return -1;
 }
 
+const uint8_t *supervisor_flash_get_mapped_block(uint32_t block) {
+    int32_t addr = convert_block_to_flash_addr(block);
+    if (addr == -1) {
+        return NULL;
+    }
+    return (const uint8_t *)addr;
+}
+
 bool supervisor_flash_read_block(uint8_t *dest, uint32_t block) {
     // non-MBR block, get data from flash memory
     int32_t src = convert_block_to_flash_addr(block);
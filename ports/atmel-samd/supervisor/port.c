@@ -52,11 +52,16 @@
 #include "common-hal/audiobusio/I2SOut.h"
 #include "common-hal/audioio/AudioOut.h"
 #include "common-hal/busio/SPI.h"
+#include "common-hal/countio/Counter.h"
+#include "common-hal/i2cslave/I2CSlave.h"
 #include "common-hal/microcontroller/Pin.h"
+#include "common-hal/microcontroller/Processor.h"
+#include "common-hal/neopixel_write/__init__.h"
 #include "common-hal/pulseio/PulseIn.h"
 #include "common-hal/pulseio/PulseOut.h"
 #include "common-hal/pulseio/PWMOut.h"
 #include "common-hal/ps2io/Ps2.h"
+#include "common-hal/rotaryio/IncrementalEncoder.h"
 #include "common-hal/rtc/RTC.h"
 
 #if CIRCUITPY_TOUCHIO_USE_NATIVE
@@ -74,6 +79,8 @@
 
 #include "supervisor/shared/safe_mode.h"
 #include "supervisor/shared/stack.h"
+#include "supervisor/shared/tick.h"
+#include "shared-bindings/microcontroller/__init__.h"
 
 #include "tusb.h"
 
@@ -223,6 +230,12 @@ safe_mode_t port_init(void) {
     // Configure millisecond timer initialization.
     tick_init();
 
+    #if CIRCUITPY_CYCLE_COUNTER && defined(SAMD51)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    #endif
+
 #if CIRCUITPY_RTC
     rtc_init();
 #endif
@@ -265,24 +278,38 @@ void reset_port(void) {
     //pdmin_reset();
 #endif
 
+#if CIRCUITPY_I2CSLAVE
+    i2cslave_reset();
+#endif
 #if CIRCUITPY_TOUCHIO && CIRCUITPY_TOUCHIO_USE_NATIVE
     touchin_reset();
 #endif
     eic_reset();
 #if CIRCUITPY_PULSEIO
+    pulsein_reset();
     pulseout_reset();
     pwmout_reset();
 #endif
+#if CIRCUITPY_ROTARYIO
+    incrementalencoder_reset();
+#endif
+#if CIRCUITPY_COUNTIO
+    counter_reset();
+#endif
 
 #if CIRCUITPY_ANALOGIO
     analogin_reset();
     analogout_reset();
 #endif
+#if CIRCUITPY_NEOPIXEL_WRITE
+    neopixel_write_reset();
+#endif
 #if CIRCUITPY_RTC
     rtc_reset();
 #endif
 
     reset_gclks();
+    processor_reset();
 
 #if CIRCUITPY_GAMEPAD
     gamepad_reset();
@@ -347,6 +374,41 @@ uint32_t port_get_saved_word(void) {
     return *safe_word;
 }
 
+#if CIRCUITPY_CYCLE_COUNTER
+uint32_t port_get_cycle_count(void) {
+    #ifdef SAMD51
+    return DWT->CYCCNT;
+    #else
+    // The M0+ has no cycle counter so count SysTick periods and the cycles
+    // into the current one. A pending SysTick interrupt means the counter
+    // reloaded and ticks_ms hasn't caught up yet.
+    common_hal_mcu_disable_interrupts();
+    uint32_t ms = supervisor_ticks_ms32();
+    uint32_t remaining = SysTick->VAL;
+    if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0) {
+        remaining = SysTick->VAL;
+        ms++;
+    }
+    common_hal_mcu_enable_interrupts();
+    uint32_t period = SysTick->LOAD + 1;
+    return ms * period + (period - 1 - remaining);
+    #endif
+}
+#endif
+
+void port_sleep_until_interrupt(void) {
+    #ifdef SAMD51
+    // A floating point exception flag keeps the FPU interrupt pending, which
+    // would wake us straight away.
+    if (__get_FPSCR() & ~(0x9f)) {
+        __set_FPSCR(__get_FPSCR() & ~(0x9f));
+        (void) __get_FPSCR();
+    }
+    #endif
+    __DSB();
+    __WFI();
+}
+
 /**
  * \brief Default interrupt handler for unused IRQs.
  */
@@ -39,7 +39,57 @@
 #include "atmel_start_pins.h"
 #include "hal_gpio.h"
 
+// Between instructions the QSPI is left set up to read the flash through
+// QSPI_AHB so that it can be read like memory. Each instruction ends that read
+// first and starts it again afterwards.
+static bool memory_mappable = false;
+static bool memory_mapped = false;
+
+static void start_memory_reads(void) {
+    if (!memory_mappable) {
+        return;
+    }
+    #ifdef EXTERNAL_FLASH_QSPI_DUAL
+    QSPI->INSTRCTRL.bit.INSTR = CMD_DUAL_READ;
+    uint32_t mode = QSPI_INSTRFRAME_WIDTH_DUAL_OUTPUT;
+    #else
+    QSPI->INSTRCTRL.bit.INSTR = CMD_QUAD_READ;
+    uint32_t mode = QSPI_INSTRFRAME_WIDTH_QUAD_OUTPUT;
+    #endif
+
+    QSPI->INSTRFRAME.reg = mode |
+                           QSPI_INSTRFRAME_ADDRLEN_24BITS |
+                           QSPI_INSTRFRAME_TFRTYPE_READMEMORY |
+                           QSPI_INSTRFRAME_INSTREN |
+                           QSPI_INSTRFRAME_ADDREN |
+                           QSPI_INSTRFRAME_DATAEN |
+                           QSPI_INSTRFRAME_DUMMYLEN(8);
+
+    // Dummy read of INSTRFRAME needed to synchronize.
+    (volatile uint32_t) QSPI->INSTRFRAME.reg;
+
+    // Start the transfer so that there is always one for end_memory_reads()
+    // to end.
+    (void) *(volatile uint8_t *) QSPI_AHB;
+    memory_mapped = true;
+}
+
+static void end_memory_reads(void) {
+    if (!memory_mapped) {
+        return;
+    }
+    memory_mapped = false;
+
+    QSPI->CTRLA.reg = QSPI_CTRLA_ENABLE | QSPI_CTRLA_LASTXFER;
+
+    while( !QSPI->INTFLAG.bit.INSTREND );
+
+    QSPI->INTFLAG.reg = QSPI_INTFLAG_INSTREND;
+}
+
 bool spi_flash_command(uint8_t command) {
+    end_memory_reads();
+
     QSPI->INSTRCTRL.bit.INSTR = command;
 
     QSPI->INSTRFRAME.reg = QSPI_INSTRFRAME_WIDTH_SINGLE_BIT_SPI |
@@ -53,10 +103,13 @@ bool spi_flash_command(uint8_t command) {
 
     QSPI->INTFLAG.reg = QSPI_INTFLAG_INSTREND;
 
+    start_memory_reads();
+
     return true;
 }
 
 bool spi_flash_read_command(uint8_t command, uint8_t* response, uint32_t length) {
+    end_memory_reads();
     samd_peripherals_disable_and_clear_cache();
 
     QSPI->INSTRCTRL.bit.INSTR = command;
@@ -82,10 +135,13 @@ bool spi_flash_read_command(uint8_t command, uint8_t* response, uint32_t length)
 
     samd_peripherals_enable_cache();
 
+    start_memory_reads();
+
     return true;
 }
 
 bool spi_flash_write_command(uint8_t command, uint8_t* data, uint32_t length) {
+    end_memory_reads();
     samd_peripherals_disable_and_clear_cache();
 
     QSPI->INSTRCTRL.bit.INSTR = command;
@@ -113,10 +169,16 @@ bool spi_flash_write_command(uint8_t command, uint8_t* data, uint32_t length) {
 
     samd_peripherals_enable_cache();
 
+    start_memory_reads();
+
     return true;
 }
 
 bool spi_flash_sector_command(uint8_t command, uint32_t address) {
+    end_memory_reads();
+    // Drop anything cached from the memory mapped sector we're erasing.
+    samd_peripherals_disable_and_clear_cache();
+
     QSPI->INSTRCTRL.bit.INSTR = command;
     QSPI->INSTRADDR.bit.ADDR = address;
 
@@ -132,10 +194,15 @@ bool spi_flash_sector_command(uint8_t command, uint32_t address) {
 
     QSPI->INTFLAG.reg = QSPI_INTFLAG_INSTREND;
 
+    samd_peripherals_enable_cache();
+
+    start_memory_reads();
+
     return true;
 }
 
 bool spi_flash_write_data(uint32_t address, uint8_t* data, uint32_t length) {
+    end_memory_reads();
     samd_peripherals_disable_and_clear_cache();
 
     QSPI->INSTRCTRL.bit.INSTR = CMD_PAGE_PROGRAM;
@@ -160,10 +227,19 @@ bool spi_flash_write_data(uint32_t address, uint8_t* data, uint32_t length) {
 
     samd_peripherals_enable_cache();
 
+    start_memory_reads();
+
     return true;
 }
 
 bool spi_flash_read_data(uint32_t address, uint8_t* data, uint32_t length) {
+    // Read straight from the memory mapped flash, through the cache, without
+    // setting up another instruction.
+    if (memory_mapped) {
+        memcpy(data, ((uint8_t *) QSPI_AHB) + address, length);
+        return true;
+    }
+
     samd_peripherals_disable_and_clear_cache();
 
     #ifdef EXTERNAL_FLASH_QSPI_DUAL
@@ -194,9 +270,18 @@ bool spi_flash_read_data(uint32_t address, uint8_t* data, uint32_t length) {
 
     samd_peripherals_enable_cache();
 
+    start_memory_reads();
+
     return true;
 }
 
+const uint8_t* spi_flash_get_mapped_address(uint32_t address) {
+    if (!memory_mapped) {
+        return NULL;
+    }
+    return ((const uint8_t *) QSPI_AHB) + address;
+}
+
 
 void spi_flash_init(void) {
     MCLK->APBCMASK.bit.QSPI_ = true;
@@ -228,5 +313,9 @@ void spi_flash_init(void) {
 void spi_flash_init_device(const external_flash_device* device) {
     check_quad_enable(device);
 
+    // Now that quad mode is on the flash can be memory mapped.
+    memory_mappable = true;
+    start_memory_reads();
+
     // TODO(tannewt): Adjust the speed for the found device.
 }
@@ -28,6 +28,7 @@
 #include "hpl/pm/hpl_pm_base.h"
 #include "hpl/gclk/hpl_gclk_base.h"
 #include "hal_gpio.h"
+#include "supervisor/usb.h"
 
 void init_usb_hardware(void) {
     #ifdef SAMD21
@@ -56,4 +57,19 @@ void init_usb_hardware(void) {
     gpio_set_pin_function(PIN_PA24, PINMUX_PA24H_USB_DM);
     gpio_set_pin_function(PIN_PA25, PINMUX_PA25H_USB_DP);
     #endif
+
+    #if CIRCUITPY_USB_IRQ_TASK
+    NVIC_SetPriority(PendSV_IRQn, (1 << __NVIC_PRIO_BITS) - 1);
+    #endif
+}
+
+#if CIRCUITPY_USB_IRQ_TASK
+// TinyUSB's task runs in PendSV, below every other interrupt.
+void usb_irq_task_trigger(void) {
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+}
+
+void PendSV_Handler(void) {
+    usb_irq_task();
 }
+#endif
@@ -28,6 +28,7 @@
 
 #include "peripheral_clk_config.h"
 
+#include "supervisor/port.h"
 #include "supervisor/shared/tick.h"
 #include "shared-bindings/microcontroller/__init__.h"
 #include "shared-bindings/microcontroller/Processor.h"
@@ -67,6 +68,13 @@ void tick_init() {
     #endif
 }
 
+void tick_set_frequency(uint32_t frequency) {
+    // Not SysTick_Config() because it would reset the interrupt priority. The
+    // tick in progress is cut short, which loses less than a millisecond.
+    SysTick->LOAD = frequency / 1000 - 1;
+    SysTick->VAL = 0;
+}
+
 void tick_delay(uint32_t us) {
     uint32_t ticks_per_us = common_hal_mcu_processor_get_frequency() / 1000 / 1000;
     uint32_t us_until_next_tick = SysTick->VAL / ticks_per_us;
@@ -105,3 +113,24 @@ void wait_until(uint64_t ms, uint32_t us_until_ms) {
     uint32_t ticks_per_us = common_hal_mcu_processor_get_frequency() / 1000 / 1000;
     while (supervisor_ticks_ms64() <= ms && SysTick->VAL / ticks_per_us >= us_until_ms) {}
 }
+
+// SysTick counts down from LOAD to 0 once per tick.
+void port_get_ticks_ns(uint64_t *ms, uint32_t *ns) {
+    uint32_t load = SysTick->LOAD;
+    uint64_t start_ms;
+    uint32_t current;
+    bool pending;
+    // Try again if the tick interrupt ran in between.
+    do {
+        start_ms = supervisor_ticks_ms64();
+        current = SysTick->VAL;
+        // The counter wrapped but the interrupt hasn't counted the tick yet because interrupts
+        // are disabled.
+        pending = (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0;
+        if (pending) {
+            current = SysTick->VAL;
+        }
+    } while (supervisor_ticks_ms64() != start_ms);
+    *ms = start_ms + pending;
+    *ns = (uint64_t) (load - current) * 1000000 / (load + 1);
+}
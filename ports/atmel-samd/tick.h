@@ -32,6 +32,9 @@ extern struct timer_descriptor ms_timer;
 
 void tick_init(void);
 
+// Keeps SysTick at 1ms after the CPU frequency changes.
+void tick_set_frequency(uint32_t frequency);
+
 void tick_delay(uint32_t us);
 
 void current_tick(uint64_t* ms, uint32_t* us_until_ms);
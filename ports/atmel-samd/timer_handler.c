@@ -32,6 +32,12 @@
 #include "common-hal/pulseio/PulseOut.h"
 #include "shared-module/_pew/PewPew.h"
 #include "common-hal/frequencyio/FrequencyIn.h"
+#include "common-hal/countio/Counter.h"
+
+#if CIRCUITPY_BACKGROUND_TRACE
+#include "supervisor/port.h"
+#include "supervisor/shared/background_trace.h"
+#endif
 
 static uint8_t tc_handler[TC_INST_NUM];
 
@@ -44,6 +50,9 @@ void set_timer_handler(bool is_tc, uint8_t index, uint8_t timer_handler) {
 void shared_timer_handler(bool is_tc, uint8_t index) {
     // Add calls to interrupt handlers for specific functionality here.
     // Make sure to add the handler #define to timer_handler.h
+    #if CIRCUITPY_BACKGROUND_TRACE
+    uint32_t trace_start = port_get_cycle_count();
+    #endif
     if (is_tc) {
         uint8_t handler = tc_handler[index];
         switch(handler) {
@@ -62,8 +71,16 @@ void shared_timer_handler(bool is_tc, uint8_t index) {
                 frequencyin_interrupt_handler(index);
             #endif
                 break;
+            case TC_HANDLER_COUNTER:
+            #if CIRCUITPY_COUNTIO
+                counter_interrupt_handler(index);
+            #endif
+                break;
             default:
                 break;
         }
     }
+    #if CIRCUITPY_BACKGROUND_TRACE
+    background_trace_record(BACKGROUND_TRACE_TIMER, trace_start);
+    #endif
 }
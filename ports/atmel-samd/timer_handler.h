@@ -30,6 +30,7 @@
 #define TC_HANDLER_PULSEOUT 0x1
 #define TC_HANDLER_PEW 0x2
 #define TC_HANDLER_FREQUENCYIN 0x3
+#define TC_HANDLER_COUNTER 0x4
 
 void set_timer_handler(bool is_tc, uint8_t index, uint8_t timer_handler);
 void shared_timer_handler(bool is_tc, uint8_t index);
@@ -26,8 +26,7 @@
 
 #include "background.h"
 
-#include "supervisor/usb.h"
-#include "supervisor/filesystem.h"
+#include "supervisor/shared/background_task.h"
 #include "supervisor/shared/stack.h"
 
 static bool running_background_tasks = false;
@@ -45,8 +44,8 @@ void run_background_tasks(void) {
     assert_heap_ok();
     running_background_tasks = true;
 
-    usb_background();
-    filesystem_background();
+    // The filesystem and USB register their own tasks.
+    background_tasks_run();
 
     running_background_tasks = false;
     assert_heap_ok();
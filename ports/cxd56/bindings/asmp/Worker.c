@@ -0,0 +1,232 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/objtuple.h"
+#include "py/runtime.h"
+
+#include "bindings/asmp/Worker.h"
+#include "shared-bindings/util.h"
+
+//| .. currentmodule:: asmp
+//|
+//| :class:`Worker` --- Native task on a spare core
+//| ================================================
+//|
+//| Runs a worker program on a core of its own and exchanges messages with it. Each message
+//| is a message id from 0 to 127 plus up to ``buffer_size`` bytes of data.
+//|
+//| The data goes through memory shared with the worker. The worker binds the message queue
+//| with key 1 and the shared memory with key 2. Each message carries the physical address
+//| of the shared memory, which starts with the data length in bytes as a 32-bit word,
+//| followed by the data. The worker replies by writing its result to the shared memory
+//| the same way and sending a message back. The VM doesn't touch the shared memory between
+//| `send` and the matching `receive`, so the worker can use it in place.
+//|
+//| .. class:: Worker(filename, *, buffer_size=4096)
+//|
+//|   Load a worker program and start it on a free core.
+//|
+//|   :param str filename: Path of the worker ELF file in the NuttX filesystem, such as
+//|     ``/mnt/sd0/fft``. Files on CIRCUITPY aren't visible to NuttX.
+//|   :param int buffer_size: Largest message size in bytes, in either direction
+//|
+//|   Compute an FFT on another core::
+//|
+//|     import asmp
+//|
+//|     samples = bytearray(2048)
+//|     spectrum = bytearray(2048)
+//|     with asmp.Worker("/mnt/sd0/fft") as fft:
+//|         fft.send(1, samples)
+//|         # Do other work while the worker runs.
+//|         msgid, length = fft.receive(spectrum)
+//|
+STATIC mp_obj_t asmp_worker_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_filename, ARG_buffer_size };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_filename, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_buffer_size, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 4096} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    const char *filename = mp_obj_str_get_str(args[ARG_filename].u_obj);
+    mp_int_t buffer_size = args[ARG_buffer_size].u_int;
+    if (buffer_size < 1) {
+        mp_raise_ValueError(translate("Buffer must be at least length 1"));
+    }
+
+    asmp_worker_obj_t *self = m_new_obj(asmp_worker_obj_t);
+    self->base.type = &asmp_worker_type;
+
+    common_hal_asmp_worker_construct(self, filename, buffer_size);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Stops the worker and frees its core for reuse.
+//|
+STATIC mp_obj_t asmp_worker_deinit(mp_obj_t self_in) {
+    asmp_worker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_asmp_worker_deinit(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(asmp_worker_deinit_obj, asmp_worker_deinit);
+
+STATIC void check_for_deinit(asmp_worker_obj_t *self) {
+    if (common_hal_asmp_worker_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes the worker when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t asmp_worker_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_asmp_worker_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(asmp_worker___exit___obj, 4, 4, asmp_worker_obj___exit__);
+
+//|   .. method:: send(msgid, buffer)
+//|
+//|      Copy ``buffer`` to the shared memory and send it to the worker. Only one message can
+//|      be outstanding at a time, so `receive` the reply before sending again.
+//|
+//|      :param int msgid: Message id, from 0 to 127, for the worker to interpret
+//|      :param bytearray buffer: Data to send, at most ``buffer_size`` bytes
+//|
+STATIC mp_obj_t asmp_worker_send(mp_obj_t self_in, mp_obj_t msgid_in, mp_obj_t buffer_in) {
+    asmp_worker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+
+    mp_int_t msgid = mp_obj_get_int(msgid_in);
+    if (msgid < 0 || msgid > 127) {
+        mp_raise_ValueError_varg(translate("%q must be %d-%d"), MP_QSTR_msgid, 0, 127);
+    }
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer_in, &bufinfo, MP_BUFFER_READ);
+
+    common_hal_asmp_worker_send(self, msgid, bufinfo.buf, bufinfo.len);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(asmp_worker_send_obj, asmp_worker_send);
+
+//|   .. method:: receive(buffer, *, timeout=None)
+//|
+//|      Wait for a message from the worker and copy its data into ``buffer``. Background
+//|      tasks keep running while waiting. If ``buffer`` is too small, `ValueError` is raised
+//|      and the message is kept for the next call.
+//|
+//|      :param bytearray buffer: Buffer to read the data into
+//|      :param float timeout: Seconds to wait, or ``None`` to wait forever
+//|      :return: a tuple of the message id and the number of bytes read, or ``None`` if the
+//|        timeout expired
+//|      :rtype: tuple or None
+//|
+STATIC mp_obj_t asmp_worker_receive(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_buffer, ARG_timeout };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_buffer, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_timeout, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
+    };
+    asmp_worker_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    check_for_deinit(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[ARG_buffer].u_obj, &bufinfo, MP_BUFFER_WRITE);
+
+    uint32_t timeout_ms = UINT32_MAX;
+    if (args[ARG_timeout].u_obj != mp_const_none) {
+        mp_float_t timeout = mp_obj_get_float(args[ARG_timeout].u_obj);
+        if (timeout < 0.0f) {
+            mp_raise_ValueError(translate("timeout must be >= 0.0"));
+        }
+        timeout_ms = timeout * 1000;
+    }
+
+    size_t len;
+    int msgid = common_hal_asmp_worker_receive(self, bufinfo.buf, bufinfo.len, &len, timeout_ms);
+    if (msgid < 0) {
+        return mp_const_none;
+    }
+    mp_obj_t items[2] = { MP_OBJ_NEW_SMALL_INT(msgid), MP_OBJ_NEW_SMALL_INT(len) };
+    return mp_obj_new_tuple(2, items);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(asmp_worker_receive_obj, 2, asmp_worker_receive);
+
+//|   .. attribute:: buffer_size
+//|
+//|     The largest message size in bytes. (read-only)
+//|
+STATIC mp_obj_t asmp_worker_obj_get_buffer_size(mp_obj_t self_in) {
+    asmp_worker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_asmp_worker_get_buffer_size(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(asmp_worker_get_buffer_size_obj, asmp_worker_obj_get_buffer_size);
+
+const mp_obj_property_t asmp_worker_buffer_size_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&asmp_worker_get_buffer_size_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t asmp_worker_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&asmp_worker_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&asmp_worker___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_send), MP_ROM_PTR(&asmp_worker_send_obj) },
+    { MP_ROM_QSTR(MP_QSTR_receive), MP_ROM_PTR(&asmp_worker_receive_obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_buffer_size), MP_ROM_PTR(&asmp_worker_buffer_size_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(asmp_worker_locals_dict, asmp_worker_locals_dict_table);
+
+const mp_obj_type_t asmp_worker_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Worker,
+    .make_new = asmp_worker_make_new,
+    .locals_dict = (mp_obj_dict_t*)&asmp_worker_locals_dict,
+};
@@ -0,0 +1,42 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_CXD56_BINDINGS_ASMP_WORKER_H
+#define MICROPY_INCLUDED_CXD56_BINDINGS_ASMP_WORKER_H
+
+#include "common-hal/asmp/Worker.h"
+
+extern const mp_obj_type_t asmp_worker_type;
+
+void common_hal_asmp_worker_construct(asmp_worker_obj_t *self, const char *filename, size_t buffer_size);
+void common_hal_asmp_worker_deinit(asmp_worker_obj_t *self);
+bool common_hal_asmp_worker_deinited(asmp_worker_obj_t *self);
+size_t common_hal_asmp_worker_get_buffer_size(asmp_worker_obj_t *self);
+void common_hal_asmp_worker_send(asmp_worker_obj_t *self, uint8_t msgid, const uint8_t *data, size_t len);
+// Returns the message id of the reply, or -1 on timeout or interrupt.
+int common_hal_asmp_worker_receive(asmp_worker_obj_t *self, uint8_t *data, size_t len, size_t *data_len, uint32_t timeout_ms);
+
+#endif // MICROPY_INCLUDED_CXD56_BINDINGS_ASMP_WORKER_H
@@ -131,3 +131,15 @@ void analogin_reset(void) {
         }
     }
 }
+
+bool common_hal_analogio_analogin_start_reading(analogio_analogin_obj_t *self, uint16_t* buffer, size_t len, uint32_t rate, bool loop) {
+    // Timed sampling isn't implemented on this port.
+    return false;
+}
+
+bool common_hal_analogio_analogin_get_reading(analogio_analogin_obj_t *self) {
+    return false;
+}
+
+void common_hal_analogio_analogin_stop_reading(analogio_analogin_obj_t *self) {
+}
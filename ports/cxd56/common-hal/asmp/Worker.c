@@ -0,0 +1,182 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "py/mphal.h"
+#include "py/runtime.h"
+
+#include "bindings/asmp/Worker.h"
+#include "supervisor/shared/tick.h"
+
+// The CXD5602 has six application cores and CircuitPython runs on one of them.
+#define ASMP_MAX_WORKERS (5)
+
+static asmp_worker_t workers[ASMP_MAX_WORKERS];
+
+static void worker_destroy(asmp_worker_t *worker) {
+    int exitcode;
+
+    if (worker->task_ready) {
+        mptask_destroy(&worker->task, true, &exitcode);
+    }
+    if (worker->buffer != NULL) {
+        mpshm_detach(&worker->shm);
+    }
+    if (worker->shm_ready) {
+        mpshm_destroy(&worker->shm);
+    }
+    if (worker->mq_ready) {
+        mpmq_destroy(&worker->mq);
+    }
+    memset(worker, 0, sizeof(asmp_worker_t));
+}
+
+void common_hal_asmp_worker_construct(asmp_worker_obj_t *self, const char *filename, size_t buffer_size) {
+    asmp_worker_t *worker = NULL;
+    for (size_t i = 0; i < ASMP_MAX_WORKERS; i++) {
+        if (!workers[i].task_ready) {
+            worker = &workers[i];
+            break;
+        }
+    }
+    if (worker == NULL) {
+        mp_raise_RuntimeError(translate("All cores in use"));
+    }
+
+    worker->buffer_size = buffer_size;
+    worker->reply = -1;
+
+    int ret = mptask_init(&worker->task, filename);
+    if (ret == 0) {
+        worker->task_ready = true;
+        ret = mptask_assign(&worker->task);
+    }
+    if (ret == 0) {
+        ret = mpmq_init(&worker->mq, ASMP_WORKER_KEY_MQ, mptask_getcpuid(&worker->task));
+    }
+    if (ret == 0) {
+        worker->mq_ready = true;
+        ret = mptask_bindobj(&worker->task, &worker->mq);
+    }
+    if (ret == 0) {
+        ret = mpshm_init(&worker->shm, ASMP_WORKER_KEY_SHM, sizeof(uint32_t) + buffer_size);
+    }
+    if (ret == 0) {
+        worker->shm_ready = true;
+        ret = mptask_bindobj(&worker->task, &worker->shm);
+    }
+    if (ret == 0) {
+        worker->buffer = mpshm_attach(&worker->shm, 0);
+        if (worker->buffer == NULL) {
+            ret = -ENOMEM;
+        }
+    }
+    if (ret == 0) {
+        ret = mptask_exec(&worker->task);
+    }
+    if (ret != 0) {
+        worker_destroy(worker);
+        mp_raise_OSError(-ret);
+    }
+
+    self->worker = worker;
+}
+
+bool common_hal_asmp_worker_deinited(asmp_worker_obj_t *self) {
+    return self->worker == NULL;
+}
+
+void common_hal_asmp_worker_deinit(asmp_worker_obj_t *self) {
+    if (common_hal_asmp_worker_deinited(self)) {
+        return;
+    }
+    worker_destroy(self->worker);
+    self->worker = NULL;
+}
+
+size_t common_hal_asmp_worker_get_buffer_size(asmp_worker_obj_t *self) {
+    return self->worker->buffer_size;
+}
+
+void common_hal_asmp_worker_send(asmp_worker_obj_t *self, uint8_t msgid, const uint8_t *data, size_t len) {
+    asmp_worker_t *worker = self->worker;
+    // The shared buffer belongs to the worker until it replies.
+    if (worker->busy) {
+        mp_raise_RuntimeError(translate("Worker is busy"));
+    }
+    if (len > worker->buffer_size) {
+        mp_raise_ValueError_varg(translate("Buffer length %d too big. It must be less than %d"), len, worker->buffer_size + 1);
+    }
+
+    worker->buffer[0] = len;
+    memcpy(worker->buffer + 1, data, len);
+    int ret = mpmq_send(&worker->mq, msgid, mpshm_virt2phys(&worker->shm, worker->buffer));
+    if (ret < 0) {
+        mp_raise_OSError(-ret);
+    }
+    worker->busy = true;
+}
+
+int common_hal_asmp_worker_receive(asmp_worker_obj_t *self, uint8_t *data, size_t len, size_t *data_len, uint32_t timeout_ms) {
+    asmp_worker_t *worker = self->worker;
+    // A reply that didn't fit in the last buffer is still waiting in shared memory.
+    if (worker->reply < 0) {
+        uint64_t start_ticks = supervisor_ticks_ms64();
+        uint32_t msgdata;
+        int ret;
+        while ((ret = mpmq_tryreceive(&worker->mq, &msgdata)) == -EAGAIN) {
+            RUN_BACKGROUND_TASKS;
+            // Allow user to break out of a timeout with a KeyboardInterrupt.
+            if (mp_hal_is_interrupted() || supervisor_ticks_ms64() - start_ticks >= timeout_ms) {
+                return -1;
+            }
+        }
+        if (ret < 0) {
+            mp_raise_OSError(-ret);
+        }
+        worker->reply = ret;
+    }
+
+    *data_len = MIN(worker->buffer[0], worker->buffer_size);
+    if (*data_len > len) {
+        mp_raise_ValueError(translate("Buffer is too small"));
+    }
+    memcpy(data, worker->buffer + 1, *data_len);
+    int msgid = worker->reply;
+    worker->reply = -1;
+    worker->busy = false;
+    return msgid;
+}
+
+void asmp_reset(void) {
+    for (size_t i = 0; i < ASMP_MAX_WORKERS; i++) {
+        if (workers[i].task_ready) {
+            worker_destroy(&workers[i]);
+        }
+    }
+}
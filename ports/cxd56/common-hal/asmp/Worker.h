@@ -0,0 +1,63 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_CXD56_COMMON_HAL_ASMP_WORKER_H
+#define MICROPY_INCLUDED_CXD56_COMMON_HAL_ASMP_WORKER_H
+
+#include <asmp/mptask.h>
+#include <asmp/mpmq.h>
+#include <asmp/mpshm.h>
+
+#include "py/obj.h"
+
+// Keys the worker uses to look up the message queue and shared memory bound to it.
+#define ASMP_WORKER_KEY_MQ (1)
+#define ASMP_WORKER_KEY_SHM (2)
+
+// The worker state lives outside the heap so that reset_port can stop the workers after the
+// heap is gone.
+typedef struct {
+    mptask_t task;
+    mpmq_t mq;
+    mpshm_t shm;
+    // The shared buffer: the data length in bytes followed by the data.
+    uint32_t *buffer;
+    size_t buffer_size;
+    int16_t reply;
+    bool task_ready;
+    bool mq_ready;
+    bool shm_ready;
+    bool busy;
+} asmp_worker_t;
+
+typedef struct {
+    mp_obj_base_t base;
+    asmp_worker_t *worker;
+} asmp_worker_obj_t;
+
+void asmp_reset(void);
+
+#endif // MICROPY_INCLUDED_CXD56_COMMON_HAL_ASMP_WORKER_H
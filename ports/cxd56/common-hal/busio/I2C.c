@@ -117,6 +117,23 @@ uint8_t common_hal_busio_i2c_read(busio_i2c_obj_t *self, uint16_t address, uint8
     return I2C_TRANSFER(self->i2c_dev, &msg, 1);
 }
 
+uint8_t common_hal_busio_i2c_write_read(busio_i2c_obj_t *self, uint16_t address, const uint8_t *out_data, size_t out_len, uint8_t *in_data, size_t in_len) {
+    struct i2c_msg_s msgs[2];
+
+    msgs[0].frequency = self->frequency;
+    msgs[0].addr = address;
+    msgs[0].flags = I2C_M_NOSTOP;
+    msgs[0].buffer = (uint8_t *) out_data;
+    msgs[0].length = out_len;
+
+    msgs[1].frequency = self->frequency;
+    msgs[1].addr = address;
+    msgs[1].flags = I2C_M_READ;
+    msgs[1].buffer = in_data;
+    msgs[1].length = in_len;
+    return I2C_TRANSFER(self->i2c_dev, msgs, 2);
+}
+
 void common_hal_busio_i2c_never_reset(busio_i2c_obj_t *self) {
     never_reset_pin_number(self->scl_pin->number);
     never_reset_pin_number(self->sda_pin->number);
@@ -124,6 +124,20 @@ bool common_hal_busio_spi_write(busio_spi_obj_t *self, const uint8_t *data, size
     return true;
 }
 
+bool common_hal_busio_spi_start_write(busio_spi_obj_t *self, const uint8_t *data, size_t len) {
+    // Background transfers aren't supported yet so finish the write now.
+    return common_hal_busio_spi_write(self, data, len);
+}
+
+bool common_hal_busio_spi_start_read(busio_spi_obj_t *self, uint8_t *data, size_t len, uint8_t write_value) {
+    // Background transfers aren't supported yet so finish the read now.
+    return common_hal_busio_spi_read(self, data, len, write_value);
+}
+
+bool common_hal_busio_spi_transfer_in_progress(busio_spi_obj_t *self) {
+    return false;
+}
+
 bool common_hal_busio_spi_read(busio_spi_obj_t *self, uint8_t *data, size_t len, uint8_t write_value) {
     SPI_EXCHANGE(self->spi_dev, NULL, data, len);
 
@@ -136,6 +150,25 @@ bool common_hal_busio_spi_transfer(busio_spi_obj_t *self, uint8_t *data_out, uin
     return true;
 }
 
+bool common_hal_busio_spi_transaction(busio_spi_obj_t *self, const busio_spi_segment_t *segments, size_t count, uint8_t write_value) {
+    // Without chained transfers, run the segments one after another.
+    for (size_t i = 0; i < count; i++) {
+        const busio_spi_segment_t *segment = &segments[i];
+        bool ok;
+        if (segment->in == NULL) {
+            ok = common_hal_busio_spi_write(self, segment->out, segment->len);
+        } else if (segment->out == NULL) {
+            ok = common_hal_busio_spi_read(self, segment->in, segment->len, write_value);
+        } else {
+            ok = common_hal_busio_spi_transfer(self, (uint8_t *) segment->out, segment->in, segment->len);
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
 uint32_t common_hal_busio_spi_get_frequency(busio_spi_obj_t *self) {
     return self->frequency;
 }
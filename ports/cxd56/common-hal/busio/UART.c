@@ -204,3 +204,8 @@ void busio_uart_reset(void) {
         }
     }
 }
+
+uint32_t common_hal_busio_uart_get_rx_overruns(busio_uart_obj_t *self) {
+    // The serial driver doesn't report lost bytes.
+    return 0;
+}
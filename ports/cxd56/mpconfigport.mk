@@ -8,6 +8,7 @@ USB_CDC_EP_NUM_DATA_IN = 1
 USB_MSC_EP_NUM_OUT = 5
 USB_MSC_EP_NUM_IN = 4
 
+CIRCUITPY_ASMP = 1
 CIRCUITPY_AUDIOIO = 0
 CIRCUITPY_AUDIOBUSIO = 0
 CIRCUITPY_I2CSLAVE = 0
@@ -38,6 +38,9 @@
 #include "common-hal/pulseio/PulseOut.h"
 #include "common-hal/pulseio/PWMOut.h"
 #include "common-hal/busio/UART.h"
+#if CIRCUITPY_ASMP
+#include "common-hal/asmp/Worker.h"
+#endif
 
 safe_mode_t port_init(void) {
     boardctl(BOARDIOC_INIT, 0);
@@ -56,6 +59,9 @@ void reset_cpu(void) {
 }
 
 void reset_port(void) {
+#if CIRCUITPY_ASMP
+    asmp_reset();
+#endif
 #if CIRCUITPY_ANALOGIO
     analogin_reset();
 #endif
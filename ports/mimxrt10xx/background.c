@@ -28,9 +28,8 @@
 
 //#include "audio_dma.h"
 #include "tick.h"
-#include "supervisor/filesystem.h"
+#include "supervisor/shared/background_task.h"
 #include "supervisor/shared/tick.h"
-#include "supervisor/usb.h"
 
 #include "py/runtime.h"
 #include "shared-module/network/__init__.h"
@@ -47,8 +46,29 @@ bool stack_ok_so_far = true;
 
 static bool running_background_tasks = false;
 
+#if CIRCUITPY_AUDIOIO || CIRCUITPY_AUDIOBUSIO
+static background_task_t audio_dma_task;
+#endif
+#if CIRCUITPY_DISPLAYIO
+static background_task_t displayio_task;
+#endif
+#if CIRCUITPY_NETWORK
+static background_task_t network_task;
+#endif
+
 void background_tasks_reset(void) {
     running_background_tasks = false;
+
+    // The filesystem and USB register their own tasks.
+    #if CIRCUITPY_AUDIOIO || CIRCUITPY_AUDIOBUSIO
+    background_task_add(&audio_dma_task, audio_dma_background, BACKGROUND_TASK_PRIORITY_AUDIO, 1);
+    #endif
+    #if CIRCUITPY_DISPLAYIO
+    background_task_add(&displayio_task, displayio_background, BACKGROUND_TASK_PRIORITY_DISPLAY, 1);
+    #endif
+    #if CIRCUITPY_NETWORK
+    background_task_add(&network_task, network_module_background, BACKGROUND_TASK_PRIORITY_NETWORK, 1);
+    #endif
 }
 
 void run_background_tasks(void) {
@@ -58,19 +78,7 @@ void run_background_tasks(void) {
     }
     assert_heap_ok();
     running_background_tasks = true;
-
-    #if CIRCUITPY_AUDIOIO || CIRCUITPY_AUDIOBUSIO
-    audio_dma_background();
-    #endif
-    #if CIRCUITPY_DISPLAYIO
-    displayio_background();
-    #endif
-
-    #if CIRCUITPY_NETWORK
-    network_module_background();
-    #endif
-    filesystem_background();
-    usb_background();
+    background_tasks_run();
     running_background_tasks = false;
     assert_heap_ok();
 
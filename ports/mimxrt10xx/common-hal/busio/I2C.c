@@ -186,6 +186,34 @@ uint8_t common_hal_busio_i2c_read(busio_i2c_obj_t *self, uint16_t addr,
     return MP_EIO;
 }
 
+uint8_t common_hal_busio_i2c_write_read(busio_i2c_obj_t *self, uint16_t addr,
+        const uint8_t *out_data, size_t out_len, uint8_t *in_data, size_t in_len) {
+    // LPI2C sends up to four bytes of subaddress before a repeated start.
+    if (out_len == 0 || out_len > 4) {
+        uint8_t status = common_hal_busio_i2c_write(self, addr, out_data, out_len, false);
+        if (status != 0) {
+            return status;
+        }
+        return common_hal_busio_i2c_read(self, addr, in_data, in_len);
+    }
+
+    lpi2c_master_transfer_t xfer = { 0 };
+    xfer.direction = kLPI2C_Read;
+    xfer.slaveAddress = addr;
+    for (size_t i = 0; i < out_len; i++) {
+        xfer.subaddress = (xfer.subaddress << 8) | out_data[i];
+    }
+    xfer.subaddressSize = out_len;
+    xfer.data = in_data;
+    xfer.dataSize = in_len;
+
+    const status_t status = LPI2C_MasterTransferBlocking(self->i2c, &xfer);
+    if (status == kStatus_Success)
+        return 0;
+
+    return MP_EIO;
+}
+
 void common_hal_busio_i2c_never_reset(busio_i2c_obj_t *self) {
 //    never_reset_sercom(self->i2c_desc.device.hw);
 //
@@ -250,3 +250,8 @@ bool common_hal_busio_uart_ready_to_tx(busio_uart_obj_t *self) {
 
     return LPUART_GetStatusFlags(self->uart) & kLPUART_TxDataRegEmptyFlag;
 }
+
+uint32_t common_hal_busio_uart_get_rx_overruns(busio_uart_obj_t *self) {
+    // The LPUART driver doesn't report when its ring buffer overflows.
+    return 0;
+}
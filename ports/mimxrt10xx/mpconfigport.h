@@ -40,6 +40,11 @@
 #define MICROPY_PY_UJSON                            (1)
 #define MICROPY_PY_REVERSE_SPECIAL_METHODS          (0)
 
+// Hot functions are copied to ITCM at startup on chips with room for them. See the linker scripts.
+#define PLACE_IN_ITCM(name) __attribute__((section(".itcm." #name))) name
+// Buffers that peripherals reach by DMA go in memory the data cache doesn't cover, on the 1062.
+#define PLACE_IN_DMA_SECTION(name) name __attribute__((section(".dma_buffers." #name)))
+
 #include "py/circuitpy_mpconfig.h"
 
 #define MICROPY_PORT_ROOT_POINTERS \
@@ -18,3 +18,13 @@ INTERNAL_LIBM = 1
 
 USB_SERIAL_NUMBER_LENGTH = 32
 USB_MSC_MAX_PACKET_SIZE = 512
+
+# TinyUSB's task runs in PendSV. See supervisor/usb.c.
+ifndef CIRCUITPY_USB_IRQ_TASK
+CIRCUITPY_USB_IRQ_TASK = 1
+endif
+
+# Cycles are counted with the DWT. See supervisor/port.c.
+ifndef CIRCUITPY_CYCLE_COUNTER
+CIRCUITPY_CYCLE_COUNTER = 1
+endif
@@ -54,10 +54,22 @@
 #include "fsl_gpio.h"
 #include "fsl_lpuart.h"
 
+#ifndef MIMXRT1011_SERIES
+extern uint32_t _ld_dma_buffers_start;
+#endif
+
 void mpu_init(void)
 {
 	ARM_MPU_Disable();
 
+	#ifndef MIMXRT1011_SERIES
+	// Everything else keeps the default memory map, where OCRAM is write-back cached. The
+	// DMA buffers at the start of OCRAM are normal memory that isn't cached.
+	MPU->RBAR = ARM_MPU_RBAR(0, (uint32_t) &_ld_dma_buffers_start);
+	MPU->RASR = ARM_MPU_RASR(1, ARM_MPU_AP_FULL, 1, 0, 0, 0, 0, ARM_MPU_REGION_SIZE_32KB);
+	ARM_MPU_Enable(MPU_CTRL_PRIVDEFENA_Msk);
+	#endif
+
 	SCB_EnableDCache();
 	SCB_EnableICache();
 }
@@ -69,6 +81,11 @@ safe_mode_t port_init(void) {
     // Configure millisecond timer initialization.
     tick_init();
 
+    #if CIRCUITPY_CYCLE_COUNTER
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    #endif
+
 #if CIRCUITPY_RTC
     rtc_init();
 #endif
@@ -138,9 +155,29 @@ void reset_cpu(void) {
 }
 
 extern uint32_t _heap_start, _estack;
+#ifdef MIMXRT1011_SERIES
 uint32_t *port_stack_get_limit(void) {
     return &_heap_start;
 }
+#else
+// The stack has DTCM to itself, and the heap has OCRAM.
+extern uint32_t _ld_stack_bottom, _heap_end;
+uint32_t *port_stack_get_limit(void) {
+    return &_ld_stack_bottom;
+}
+
+bool port_has_fixed_stack(void) {
+    return true;
+}
+
+uint32_t *port_heap_get_bottom(void) {
+    return &_heap_start;
+}
+
+uint32_t *port_heap_get_top(void) {
+    return &_heap_end;
+}
+#endif
 
 uint32_t *port_stack_get_top(void) {
     return &_estack;
@@ -156,6 +193,12 @@ uint32_t port_get_saved_word(void) {
     return __bss_end__;
 }
 
+#if CIRCUITPY_CYCLE_COUNTER
+uint32_t port_get_cycle_count(void) {
+    return DWT->CYCCNT;
+}
+#endif
+
 /**
  * \brief Default interrupt handler for unused IRQs.
  */
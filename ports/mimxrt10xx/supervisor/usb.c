@@ -26,6 +26,7 @@
  */
 
 #include "fsl_clock.h"
+#include "supervisor/usb.h"
 #include "tusb.h"
 
 void init_usb_hardware(void) {
@@ -49,8 +50,26 @@ void init_usb_hardware(void) {
     phytx &= ~(USBPHY_TX_D_CAL_MASK | USBPHY_TX_TXCAL45DM_MASK | USBPHY_TX_TXCAL45DP_MASK);
     phytx |= USBPHY_TX_D_CAL(0x0C) | USBPHY_TX_TXCAL45DP(0x06) | USBPHY_TX_TXCAL45DM(0x06);
     usb_phy->TX = phytx;
+
+    #if CIRCUITPY_USB_IRQ_TASK
+    NVIC_SetPriority(PendSV_IRQn, (1 << __NVIC_PRIO_BITS) - 1);
+    #endif
 }
 
 void USB_OTG1_IRQHandler(void) {
     tud_isr(0);
+    #if CIRCUITPY_USB_IRQ_TASK
+    usb_irq_task_trigger();
+    #endif
+}
+
+#if CIRCUITPY_USB_IRQ_TASK
+// TinyUSB's task runs in PendSV, below every other interrupt.
+void usb_irq_task_trigger(void) {
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
 }
+
+void PendSV_Handler(void) {
+    usb_irq_task();
+}
+#endif
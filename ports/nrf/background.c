@@ -25,8 +25,7 @@
  */
 
 #include "py/runtime.h"
-#include "supervisor/filesystem.h"
-#include "supervisor/usb.h"
+#include "supervisor/shared/background_task.h"
 #include "supervisor/shared/stack.h"
 
 #if CIRCUITPY_DISPLAYIO
@@ -35,20 +34,80 @@
 
 #if CIRCUITPY_AUDIOBUSIO
 #include "common-hal/audiobusio/I2SOut.h"
+#include "common-hal/audiobusio/PDMIn.h"
+#endif
+
+#if CIRCUITPY_AUDIOCORE
+#include "shared-module/audiocore/WaveFile.h"
+#endif
+
+#if CIRCUITPY_AUDIOMP3
+#include "shared-module/audiomp3/MP3Decoder.h"
 #endif
 
 #if CIRCUITPY_AUDIOPWMIO
 #include "common-hal/audiopwmio/PWMAudioOut.h"
 #endif
 
-#if CIRCUITPY_BLEIO
-#include "supervisor/shared/bluetooth.h"
+#if CIRCUITPY_NEOPIXEL_WRITE
+#include "common-hal/neopixel_write/__init__.h"
+#endif
+
+#if CIRCUITPY_ROTARYIO
+#include "common-hal/rotaryio/IncrementalEncoder.h"
 #endif
 
 static bool running_background_tasks = false;
 
+#if CIRCUITPY_AUDIOPWMIO
+static background_task_t audiopwmout_task;
+#endif
+#if CIRCUITPY_AUDIOBUSIO
+static background_task_t i2s_task;
+static background_task_t pdmin_task;
+#endif
+#if CIRCUITPY_AUDIOCORE
+static background_task_t wavefile_task;
+#endif
+#if CIRCUITPY_AUDIOMP3
+static background_task_t mp3file_task;
+#endif
+#if CIRCUITPY_DISPLAYIO
+static background_task_t displayio_task;
+#endif
+#if CIRCUITPY_NEOPIXEL_WRITE
+static background_task_t neopixel_write_task;
+#endif
+#if CIRCUITPY_ROTARYIO
+static background_task_t incrementalencoder_task;
+#endif
+
 void background_tasks_reset(void) {
     running_background_tasks = false;
+
+    // The filesystem, USB and BLE register their own tasks.
+    #if CIRCUITPY_AUDIOPWMIO
+    background_task_add(&audiopwmout_task, audiopwmout_background, BACKGROUND_TASK_PRIORITY_AUDIO, 1);
+    #endif
+    #if CIRCUITPY_AUDIOBUSIO
+    background_task_add(&i2s_task, i2s_background, BACKGROUND_TASK_PRIORITY_AUDIO, 1);
+    background_task_add(&pdmin_task, pdmin_background, BACKGROUND_TASK_PRIORITY_AUDIO, 1);
+    #endif
+    #if CIRCUITPY_AUDIOCORE
+    background_task_add(&wavefile_task, audioio_wavefile_background, BACKGROUND_TASK_PRIORITY_AUDIO_DECODE, 1);
+    #endif
+    #if CIRCUITPY_AUDIOMP3
+    background_task_add(&mp3file_task, audiomp3_mp3file_background, BACKGROUND_TASK_PRIORITY_AUDIO_DECODE, 1);
+    #endif
+    #if CIRCUITPY_DISPLAYIO
+    background_task_add(&displayio_task, displayio_background, BACKGROUND_TASK_PRIORITY_DISPLAY, 1);
+    #endif
+    #if CIRCUITPY_NEOPIXEL_WRITE
+    background_task_add(&neopixel_write_task, neopixel_write_background, BACKGROUND_TASK_PRIORITY_DISPLAY, 1);
+    #endif
+    #if CIRCUITPY_ROTARYIO
+    background_task_add(&incrementalencoder_task, incrementalencoder_background, BACKGROUND_TASK_PRIORITY_DISPLAY, VELOCITY_SAMPLE_MS);
+    #endif
 }
 
 void run_background_tasks(void) {
@@ -57,22 +116,7 @@ void run_background_tasks(void) {
         return;
     }
     running_background_tasks = true;
-    filesystem_background();
-    usb_background();
-#if CIRCUITPY_AUDIOPWMIO
-    audiopwmout_background();
-#endif
-#if CIRCUITPY_AUDIOBUSIO
-    i2s_background();
-#endif
-
-#if CIRCUITPY_BLEIO
-    supervisor_bluetooth_background();
-#endif
-
-    #if CIRCUITPY_DISPLAYIO
-    displayio_background();
-    #endif
+    background_tasks_run();
     running_background_tasks = false;
 
     assert_heap_ok();
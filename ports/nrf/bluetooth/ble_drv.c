@@ -40,6 +40,11 @@
 
 #include "supervisor/shared/bluetooth.h"
 
+#if CIRCUITPY_BACKGROUND_TRACE
+#include "supervisor/port.h"
+#include "supervisor/shared/background_trace.h"
+#endif
+
 nrf_nvic_state_t nrf_nvic_state = { 0 };
 
 // Flag indicating progress of internal flash operation.
@@ -54,15 +59,21 @@ void ble_drv_reset() {
     sd_flash_operation_status = SD_FLASH_OPERATION_DONE;
 }
 
-void ble_drv_add_event_handler_entry(ble_drv_evt_handler_entry_t* entry, ble_drv_evt_handler_t func, void *param) {
+void ble_drv_add_filtered_event_handler_entry(ble_drv_evt_handler_entry_t* entry, ble_drv_evt_handler_t func, void *param, uint8_t evt_groups, uint16_t conn_handle) {
     entry->next = MP_STATE_VM(ble_drv_evt_handler_entries);
     entry->param = param;
     entry->func = func;
+    entry->conn_handle = conn_handle;
+    entry->evt_groups = evt_groups;
 
     MP_STATE_VM(ble_drv_evt_handler_entries) = entry;
 }
 
-void ble_drv_add_event_handler(ble_drv_evt_handler_t func, void *param) {
+void ble_drv_add_event_handler_entry(ble_drv_evt_handler_entry_t* entry, ble_drv_evt_handler_t func, void *param) {
+    ble_drv_add_filtered_event_handler_entry(entry, func, param, BLE_DRV_EVT_ALL, BLE_CONN_HANDLE_ALL);
+}
+
+void ble_drv_add_filtered_event_handler(ble_drv_evt_handler_t func, void *param, uint8_t evt_groups) {
     ble_drv_evt_handler_entry_t *it = MP_STATE_VM(ble_drv_evt_handler_entries);
     while (it != NULL) {
         // If event handler and its corresponding param are already on the list, don't add again.
@@ -74,7 +85,24 @@ void ble_drv_add_event_handler(ble_drv_evt_handler_t func, void *param) {
 
     // Add a new handler to the front of the list
     ble_drv_evt_handler_entry_t *handler = m_new_ll(ble_drv_evt_handler_entry_t, 1);
-    ble_drv_add_event_handler_entry(handler, func, param);
+    ble_drv_add_filtered_event_handler_entry(handler, func, param, evt_groups, BLE_CONN_HANDLE_ALL);
+}
+
+void ble_drv_add_event_handler(ble_drv_evt_handler_t func, void *param) {
+    ble_drv_add_filtered_event_handler(func, param, BLE_DRV_EVT_ALL);
+}
+
+static uint8_t evt_group(uint16_t evt_id) {
+    if (evt_id < BLE_GAP_EVT_BASE) {
+        return BLE_DRV_EVT_COMMON;
+    } else if (evt_id < BLE_GATTC_EVT_BASE) {
+        return BLE_DRV_EVT_GAP;
+    } else if (evt_id < BLE_GATTS_EVT_BASE) {
+        return BLE_DRV_EVT_GATTC;
+    } else if (evt_id < BLE_L2CAP_EVT_BASE) {
+        return BLE_DRV_EVT_GATTS;
+    }
+    return BLE_DRV_EVT_L2CAP;
 }
 
 void ble_drv_remove_event_handler(ble_drv_evt_handler_t func, void *param) {
@@ -94,6 +122,9 @@ void ble_drv_remove_event_handler(ble_drv_evt_handler_t func, void *param) {
 extern void tusb_hal_nrf_power_event (uint32_t event);
 
 void SD_EVT_IRQHandler(void) {
+    #if CIRCUITPY_BACKGROUND_TRACE
+    uint32_t trace_start = port_get_cycle_count();
+    #endif
     uint32_t evt_id;
     while (sd_evt_get(&evt_id) != NRF_ERROR_NOT_FOUND) {
         switch (evt_id) {
@@ -142,10 +173,17 @@ void SD_EVT_IRQHandler(void) {
             continue;
         }
 
+        // Every event type starts with the connection handle, so any member of the union works.
+        uint16_t conn_handle = event->evt.gap_evt.conn_handle;
+        uint8_t group = evt_group(event->header.evt_id);
         ble_drv_evt_handler_entry_t *it = MP_STATE_VM(ble_drv_evt_handler_entries);
         bool done = false;
         while (it != NULL) {
-            done = it->func(event, it->param) || done;
+            // Skip handlers that ignore this event without calling them.
+            if ((it->evt_groups & group) != 0 &&
+                (it->conn_handle == BLE_CONN_HANDLE_ALL || it->conn_handle == conn_handle)) {
+                done = it->func(event, it->param) || done;
+            }
             it = it->next;
         }
         #if CIRCUITPY_VERBOSE_BLE
@@ -155,4 +193,7 @@ void SD_EVT_IRQHandler(void) {
         }
         #endif
     }
+    #if CIRCUITPY_BACKGROUND_TRACE
+    background_trace_record(BACKGROUND_TRACE_BLE, trace_start);
+    #endif
 }
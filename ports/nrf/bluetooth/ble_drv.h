@@ -52,6 +52,14 @@
 
 typedef bool (*ble_drv_evt_handler_t)(ble_evt_t*, void*);
 
+// Groups of events a handler can be limited to, so that it isn't called for events it ignores.
+#define BLE_DRV_EVT_COMMON (1 << 0)
+#define BLE_DRV_EVT_GAP    (1 << 1)
+#define BLE_DRV_EVT_GATTC  (1 << 2)
+#define BLE_DRV_EVT_GATTS  (1 << 3)
+#define BLE_DRV_EVT_L2CAP  (1 << 4)
+#define BLE_DRV_EVT_ALL    (0xff)
+
 typedef enum {
     SD_FLASH_OPERATION_DONE,
     SD_FLASH_OPERATION_IN_PROGRESS,
@@ -65,13 +73,18 @@ typedef struct ble_drv_evt_handler_entry {
     struct ble_drv_evt_handler_entry *next;
     void *param;
     ble_drv_evt_handler_t func;
+    // Only events for this connection (or BLE_CONN_HANDLE_ALL) and in these groups are passed on.
+    uint16_t conn_handle;
+    uint8_t evt_groups;
 } ble_drv_evt_handler_entry_t;
 
 void ble_drv_reset(void);
 void ble_drv_add_event_handler(ble_drv_evt_handler_t func, void *param);
+void ble_drv_add_filtered_event_handler(ble_drv_evt_handler_t func, void *param, uint8_t evt_groups);
 void ble_drv_remove_event_handler(ble_drv_evt_handler_t func, void *param);
 
 // Allow for user provided entries to prevent allocations outside the VM.
 void ble_drv_add_event_handler_entry(ble_drv_evt_handler_entry_t* entry, ble_drv_evt_handler_t func, void *param);
+void ble_drv_add_filtered_event_handler_entry(ble_drv_evt_handler_entry_t* entry, ble_drv_evt_handler_t func, void *param, uint8_t evt_groups, uint16_t conn_handle);
 
 #endif // MICROPY_INCLUDED_NRF_BLUETOOTH_BLE_DRV_H
@@ -30,8 +30,8 @@
 
 #include "ble.h"
 #include "ble_uart.h"
-#include "ringbuffer.h"
 #include "py/mphal.h"
+#include "py/ringbuf.h"
 #include "py/runtime.h"
 #include "lib/utils/interrupt_char.h"
 #include "shared-bindings/_bleio/Adapter.h"
@@ -49,8 +49,6 @@ static const char NUS_UUID[] = "6e400001-b5a3-f393-e0a9-e50e24dcca9e";
 #define NUS_TX_UUID 0x0003
 #define BUFFER_SIZE 128
 
-ringBuffer_typedef(uint8_t, ringbuffer_t);
-
 static bleio_device_obj_t m_device;
 static bleio_service_obj_t *m_nus;
 static bleio_characteristic_obj_t *m_tx_chara;
@@ -58,11 +56,8 @@ static bleio_characteristic_obj_t *m_rx_chara;
 
 static volatile bool m_cccd_enabled;
 
-static uint8_t m_rx_ring_buffer_data[BUFFER_SIZE];
-static ringbuffer_t m_rx_ring_buffer = {
-    .size = sizeof(m_rx_ring_buffer_data) + 1,
-    .elems = m_rx_ring_buffer_data,
-};
+static uint8_t m_rx_ring_buffer_data[BUFFER_SIZE + 1];
+static ringbuf_t m_rx_ring_buffer = {m_rx_ring_buffer_data, sizeof(m_rx_ring_buffer_data)};
 
 STATIC void on_ble_evt(ble_evt_t *ble_evt, void *param) {
     switch (ble_evt->header.evt_id) {
@@ -87,7 +82,7 @@ STATIC void on_ble_evt(ble_evt_t *ble_evt, void *param) {
                     } else
 #endif
                     {
-                        bufferWrite(&m_rx_ring_buffer, write->data[i]);
+                        ringbuf_put_n(&m_rx_ring_buffer, &write->data[i], 1);
                     }
                 }
             }
@@ -147,17 +142,15 @@ bool ble_uart_connected(void) {
 }
 
 char ble_uart_rx_chr(void) {
-    while (isBufferEmpty(&m_rx_ring_buffer)) {
+    while (ringbuf_count(&m_rx_ring_buffer) == 0) {
         RUN_BACKGROUND_TASKS;
     }
 
-    uint8_t byte;
-    bufferRead(&m_rx_ring_buffer, byte);
-    return (int)byte;
+    return ringbuf_get(&m_rx_ring_buffer);
 }
 
 bool ble_uart_stdin_any(void) {
-    return !isBufferEmpty(&m_rx_ring_buffer);
+    return ringbuf_count(&m_rx_ring_buffer) > 0;
 }
 
 void ble_uart_stdout_tx_str(const char *text) {
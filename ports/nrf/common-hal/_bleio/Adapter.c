@@ -36,6 +36,7 @@
 #include "nrf_nvic.h"
 #include "nrf_sdm.h"
 #include "tick.h"
+#include "common-hal/os/__init__.h"
 #include "py/gc.h"
 #include "py/objstr.h"
 #include "py/runtime.h"
@@ -86,6 +87,9 @@ STATIC uint32_t ble_stack_enable(void) {
 #endif
     };
 
+    // The SoftDevice owns the RNG from here on.
+    urandom_pool_stop();
+
     uint32_t err_code = sd_softdevice_enable(&clock_config, softdevice_assert_handler);
     if (err_code != NRF_SUCCESS) {
         return err_code;
@@ -214,8 +218,12 @@ STATIC bool adapter_on_ble_evt(ble_evt_t *ble_evt, void *self_in) {
             connection->connection_obj = mp_const_none;
             connection->pair_status = PAIR_NOT_PAIRED;
             connection->mtu = 0;
+            connection->phy = BLE_GAP_PHY_1MBPS;
+            connection->preferred_phys = BLE_GAP_PHY_AUTO;
+            connection->data_length = BLEIO_DATA_LENGTH_MIN;
 
-            ble_drv_add_event_handler_entry(&connection->handler_entry, connection_on_ble_evt, connection);
+            ble_drv_add_filtered_event_handler_entry(&connection->handler_entry, connection_on_ble_evt, connection,
+                BLE_DRV_EVT_ALL, connection->conn_handle);
             self->connection_objs = NULL;
 
             // Save the current connection parameters.
@@ -234,6 +242,16 @@ STATIC bool adapter_on_ble_evt(ble_evt_t *ble_evt, void *self_in) {
                 conn_params.min_conn_interval > connected->conn_params.max_conn_interval) {
                 sd_ble_gap_conn_param_update(ble_evt->evt.gap_evt.conn_handle, &conn_params);
             }
+
+            // Ask for the 2M PHY, a larger MTU and longer data lengths too so that notifications
+            // stream faster. The central may refuse any of them, so the results are ignored.
+            ble_gap_phys_t const phys = {
+                .rx_phys = BLE_GAP_PHY_2MBPS | BLE_GAP_PHY_1MBPS,
+                .tx_phys = BLE_GAP_PHY_2MBPS | BLE_GAP_PHY_1MBPS,
+            };
+            sd_ble_gap_phy_update(connection->conn_handle, &phys);
+            sd_ble_gattc_exchange_mtu_request(connection->conn_handle, BLE_GATTS_VAR_ATTR_LEN_MAX);
+            sd_ble_gap_data_length_update(connection->conn_handle, NULL, NULL);
             self->current_advertising_data = NULL;
             break;
         }
@@ -322,7 +340,7 @@ void common_hal_bleio_adapter_set_enabled(bleio_adapter_obj_t *self, bool enable
             connection->conn_handle = BLE_CONN_HANDLE_INVALID;
         }
         bleio_adapter_reset_name(self);
-        ble_drv_add_event_handler_entry(&self->handler_entry, adapter_on_ble_evt, self);
+        ble_drv_add_filtered_event_handler_entry(&self->handler_entry, adapter_on_ble_evt, self, BLE_DRV_EVT_GAP, BLE_CONN_HANDLE_ALL);
     } else {
         ble_drv_reset();
         self->scan_results = NULL;
@@ -404,14 +422,14 @@ STATIC bool scan_on_ble_evt(ble_evt_t *ble_evt, void *scan_results_in) {
     return true;
 }
 
-mp_obj_t common_hal_bleio_adapter_start_scan(bleio_adapter_obj_t *self, uint8_t* prefixes, size_t prefix_length, bool extended, mp_int_t buffer_size, mp_float_t timeout, mp_float_t interval, mp_float_t window, mp_int_t minimum_rssi, bool active) {
+mp_obj_t common_hal_bleio_adapter_start_scan(bleio_adapter_obj_t *self, uint8_t* prefixes, size_t prefix_length, bool extended, mp_int_t buffer_size, mp_float_t timeout, mp_float_t interval, mp_float_t window, mp_int_t minimum_rssi, bool active, mp_float_t duplicate_window, bool update_rssi) {
     if (self->scan_results != NULL) {
         if (!shared_module_bleio_scanresults_get_done(self->scan_results)) {
             mp_raise_bleio_BluetoothError(translate("Scan already in progess. Stop with stop_scan."));
         }
         self->scan_results = NULL;
     }
-    self->scan_results = shared_module_bleio_new_scanresults(buffer_size, prefixes, prefix_length, minimum_rssi);
+    self->scan_results = shared_module_bleio_new_scanresults(buffer_size, prefixes, prefix_length, minimum_rssi, duplicate_window, update_rssi);
     size_t max_packet_size = extended ? BLE_GAP_SCAN_BUFFER_EXTENDED_MAX_SUPPORTED : BLE_GAP_SCAN_BUFFER_MAX;
     uint8_t *raw_data = m_malloc(sizeof(ble_data_t) + max_packet_size, false);
     ble_data_t * sd_data = (ble_data_t *) raw_data;
@@ -419,7 +437,7 @@ mp_obj_t common_hal_bleio_adapter_start_scan(bleio_adapter_obj_t *self, uint8_t*
     sd_data->len = max_packet_size;
     sd_data->p_data = raw_data + sizeof(ble_data_t);
 
-    ble_drv_add_event_handler(scan_on_ble_evt, self->scan_results);
+    ble_drv_add_filtered_event_handler(scan_on_ble_evt, self->scan_results, BLE_DRV_EVT_GAP);
 
     uint32_t nrf_timeout = SEC_TO_UNITS(timeout, UNIT_10_MS);
     if (timeout <= 0.0001) {
@@ -506,7 +524,7 @@ mp_obj_t common_hal_bleio_adapter_connect(bleio_adapter_obj_t *self, bleio_addre
     };
 
     connect_info_t event_info;
-    ble_drv_add_event_handler(connect_on_ble_evt, &event_info);
+    ble_drv_add_filtered_event_handler(connect_on_ble_evt, &event_info, BLE_DRV_EVT_GAP);
     event_info.done = false;
 
     uint32_t err_code = sd_ble_gap_connect(&addr, &scan_params, &conn_params, BLE_CONN_CFG_TAG_CUSTOM);
@@ -694,7 +712,15 @@ mp_obj_t common_hal_bleio_adapter_get_connections(bleio_adapter_obj_t *self) {
 
 void bleio_adapter_gc_collect(bleio_adapter_obj_t* adapter) {
     gc_collect_root((void**)adapter, sizeof(bleio_adapter_obj_t) / sizeof(size_t));
-    gc_collect_root((void**)bleio_connections, sizeof(bleio_connections) / sizeof(size_t));
+    // Only mark the pointers. The rest of each connection is keys and
+    // parameters that could look like heap pointers.
+    for (size_t i = 0; i < BLEIO_TOTAL_CONNECTION_COUNT; i++) {
+        bleio_connection_internal_t *connection = &bleio_connections[i];
+        gc_collect_ptr(connection->remote_service_list);
+        gc_collect_ptr(connection->connection_obj);
+        gc_collect_ptr(connection->handler_entry.next);
+        gc_collect_ptr(connection->handler_entry.param);
+    }
 }
 
 void bleio_adapter_reset(bleio_adapter_obj_t* adapter) {
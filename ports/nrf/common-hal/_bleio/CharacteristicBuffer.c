@@ -43,12 +43,10 @@
 #include "common-hal/_bleio/CharacteristicBuffer.h"
 
 STATIC void write_to_ringbuf(bleio_characteristic_buffer_obj_t *self, uint8_t *data, uint16_t len) {
-    // Push all the data onto the ring buffer.
+    // Push all the data onto the ring buffer. If it's full, the oldest data is dropped.
     uint8_t is_nested_critical_region;
     sd_nvic_critical_region_enter(&is_nested_critical_region);
-    for (size_t i = 0; i < len; i++) {
-        ringbuf_put(&self->ringbuf, data[i]);
-    }
+    ringbuf_put_n(&self->ringbuf, data, len);
     sd_nvic_critical_region_exit(is_nested_critical_region);
 }
 
@@ -96,7 +94,7 @@ void common_hal_bleio_characteristic_buffer_construct(bleio_characteristic_buffe
     // true means long-lived, so it won't be moved.
     ringbuf_alloc(&self->ringbuf, buffer_size, true);
 
-    ble_drv_add_event_handler(characteristic_buffer_on_ble_evt, self);
+    ble_drv_add_filtered_event_handler(characteristic_buffer_on_ble_evt, self, BLE_DRV_EVT_GATTC | BLE_DRV_EVT_GATTS);
 
 }
 
@@ -112,14 +110,15 @@ int common_hal_bleio_characteristic_buffer_read(bleio_characteristic_buffer_obj_
         }
     }
 
+    return common_hal_bleio_characteristic_buffer_readinto(self, data, len);
+}
+
+size_t common_hal_bleio_characteristic_buffer_readinto(bleio_characteristic_buffer_obj_t *self, uint8_t *data, size_t len) {
     // Copy received data. Lock out write interrupt handler while copying.
     uint8_t is_nested_critical_region;
     sd_nvic_critical_region_enter(&is_nested_critical_region);
 
-    size_t rx_bytes = MIN(ringbuf_count(&self->ringbuf), len);
-    for ( size_t i = 0; i < rx_bytes; i++ ) {
-        data[i] = ringbuf_get(&self->ringbuf);
-    }
+    size_t rx_bytes = ringbuf_get_n(&self->ringbuf, data, MIN(len, self->ringbuf.size));
 
     // Writes now OK.
     sd_nvic_critical_region_exit(is_nested_critical_region);
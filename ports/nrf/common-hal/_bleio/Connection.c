@@ -88,14 +88,18 @@ bool connection_on_ble_evt(ble_evt_t *ble_evt, void *self_in) {
 
         case BLE_GAP_EVT_PHY_UPDATE_REQUEST: {
             ble_gap_phys_t const phys = {
-                .rx_phys = BLE_GAP_PHY_AUTO,
-                .tx_phys = BLE_GAP_PHY_AUTO,
+                .rx_phys = self->preferred_phys,
+                .tx_phys = self->preferred_phys,
             };
             sd_ble_gap_phy_update(ble_evt->evt.gap_evt.conn_handle, &phys);
             break;
         }
 
         case BLE_GAP_EVT_PHY_UPDATE: { // 0x22
+            ble_gap_evt_phy_update_t *update = &ble_evt->evt.gap_evt.params.phy_update;
+            if (update->status == BLE_HCI_STATUS_CODE_SUCCESS) {
+                self->phy = update->tx_phy;
+            }
             break;
         }
 
@@ -105,6 +109,7 @@ bool connection_on_ble_evt(ble_evt_t *ble_evt, void *self_in) {
             break;
 
         case BLE_GAP_EVT_DATA_LENGTH_UPDATE: { // 0x24
+            self->data_length = ble_evt->evt.gap_evt.params.data_length_update.effective_params.max_tx_octets;
             break;
         }
 
@@ -320,21 +325,88 @@ void common_hal_bleio_connection_pair(bleio_connection_internal_t *self, bool bo
     check_sec_status(self->sec_status);
 }
 
-mp_float_t common_hal_bleio_connection_get_connection_interval(bleio_connection_internal_t *self) {
+STATIC void wait_for_conn_params(bleio_connection_internal_t *self) {
     while (self->conn_params_updating && !mp_hal_is_interrupted()) {
         RUN_BACKGROUND_TASKS;
     }
+}
+
+// Ask the peer for new connection parameters. The supervision timeout is lengthened if needed
+// because the SD requires it to be longer than (1 + latency) * interval * 2.
+STATIC void update_conn_params(bleio_connection_internal_t *self, uint16_t interval, uint16_t latency) {
+    wait_for_conn_params(self);
+    ble_gap_conn_params_t conn_params = self->conn_params;
+    conn_params.min_conn_interval = interval;
+    conn_params.max_conn_interval = interval;
+    conn_params.slave_latency = latency;
+    // interval is in 1.25ms units and the timeout is in 10ms units.
+    uint32_t min_timeout = (1 + latency) * interval * 2 * 125 / 1000 + 1;
+    if (conn_params.conn_sup_timeout < min_timeout) {
+        conn_params.conn_sup_timeout = MIN(min_timeout, BLE_GAP_CP_CONN_SUP_TIMEOUT_MAX);
+    }
+
+    self->conn_params_updating = true;
+    uint32_t status = NRF_ERROR_BUSY;
+    while (status == NRF_ERROR_BUSY) {
+        status = sd_ble_gap_conn_param_update(self->conn_handle, &conn_params);
+        RUN_BACKGROUND_TASKS;
+    }
+    if (status != NRF_SUCCESS) {
+        self->conn_params_updating = false;
+    }
+    check_nrf_error(status);
+}
+
+mp_float_t common_hal_bleio_connection_get_connection_interval(bleio_connection_internal_t *self) {
+    wait_for_conn_params(self);
     return 1.25f * self->conn_params.min_conn_interval;
 }
 
 void common_hal_bleio_connection_set_connection_interval(bleio_connection_internal_t *self, mp_float_t new_interval) {
-    self->conn_params_updating = true;
-    uint16_t interval = new_interval / 1.25f;
-    self->conn_params.min_conn_interval = interval;
-    self->conn_params.max_conn_interval = interval;
+    update_conn_params(self, new_interval / 1.25f, self->conn_params.slave_latency);
+}
+
+uint16_t common_hal_bleio_connection_get_latency(bleio_connection_internal_t *self) {
+    wait_for_conn_params(self);
+    return self->conn_params.slave_latency;
+}
+
+void common_hal_bleio_connection_set_latency(bleio_connection_internal_t *self, uint16_t latency) {
+    update_conn_params(self, self->conn_params.min_conn_interval, latency);
+}
+
+uint8_t common_hal_bleio_connection_get_phy(bleio_connection_internal_t *self) {
+    return self->phy == BLE_GAP_PHY_2MBPS ? 2 : 1;
+}
+
+void common_hal_bleio_connection_set_phy(bleio_connection_internal_t *self, uint8_t mbps) {
+    self->preferred_phys = mbps == 2 ? BLE_GAP_PHY_2MBPS : BLE_GAP_PHY_1MBPS;
+    ble_gap_phys_t const phys = {
+        .rx_phys = self->preferred_phys,
+        .tx_phys = self->preferred_phys,
+    };
+    uint32_t status = NRF_ERROR_BUSY;
+    while (status == NRF_ERROR_BUSY) {
+        status = sd_ble_gap_phy_update(self->conn_handle, &phys);
+        RUN_BACKGROUND_TASKS;
+    }
+    check_nrf_error(status);
+}
+
+uint16_t common_hal_bleio_connection_get_data_length(bleio_connection_internal_t *self) {
+    return self->data_length;
+}
+
+void common_hal_bleio_connection_set_data_length(bleio_connection_internal_t *self, uint16_t data_length) {
+    ble_gap_data_length_params_t params = {
+        .max_tx_octets = data_length,
+        .max_rx_octets = data_length,
+        .max_tx_time_us = BLE_GAP_DATA_LENGTH_AUTO,
+        .max_rx_time_us = BLE_GAP_DATA_LENGTH_AUTO,
+    };
     uint32_t status = NRF_ERROR_BUSY;
     while (status == NRF_ERROR_BUSY) {
-        status = sd_ble_gap_conn_param_update(self->conn_handle, &self->conn_params);
+        status = sd_ble_gap_data_length_update(self->conn_handle, &params, NULL);
         RUN_BACKGROUND_TASKS;
     }
     check_nrf_error(status);
@@ -574,7 +646,7 @@ STATIC bool discovery_on_ble_evt(ble_evt_t *ble_evt, mp_obj_t payload) {
 }
 
 STATIC void discover_remote_services(bleio_connection_internal_t *self, mp_obj_t service_uuids_whitelist) {
-    ble_drv_add_event_handler(discovery_on_ble_evt, self);
+    ble_drv_add_filtered_event_handler(discovery_on_ble_evt, self, BLE_DRV_EVT_GAP | BLE_DRV_EVT_GATTC);
 
     // Start over with an empty list.
     self->remote_service_list = NULL;
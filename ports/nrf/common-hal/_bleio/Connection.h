@@ -66,6 +66,10 @@ typedef struct {
     ble_gap_conn_params_t conn_params;
     volatile bool conn_params_updating;
     uint16_t mtu;
+    // The PHY we transmit on, the PHYs we'd like to use, and the longest link layer packet we send.
+    uint8_t phy;
+    uint8_t preferred_phys;
+    uint16_t data_length;
 } bleio_connection_internal_t;
 
 typedef struct {
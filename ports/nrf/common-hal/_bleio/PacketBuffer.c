@@ -65,12 +65,11 @@ STATIC void write_to_ringbuf(bleio_packet_buffer_obj_t *self, uint8_t *data, uin
 }
 
 STATIC uint32_t queue_next_write(bleio_packet_buffer_obj_t *self) {
-    // Queue up the next outgoing buffer. We use two, one that has been passed to the SD for
-    // transmission (when packet_queued is true) and the other is `pending` and can still be
-    // modified. By primarily appending to the `pending` buffer we can reduce the protocol overhead
-    // of the lower level link and ATT layers.
-    self->packet_queued = false;
-    if (self->pending_size > 0) {
+    // Hand the pending buffer to the SD if it has room. The SD queues several notifications, so a
+    // connection event can carry more than one. Once its queue is full, further writes are
+    // appended to the `pending` buffer instead, which reduces the protocol overhead of the lower
+    // level link and ATT layers.
+    if (self->pending_size > 0 && self->packets_queued < self->max_packets_queued) {
         uint16_t conn_handle = self->conn_handle;
         uint32_t err_code;
         if (self->client) {
@@ -96,16 +95,26 @@ STATIC uint32_t queue_next_write(bleio_packet_buffer_obj_t *self) {
         }
         if (err_code != NRF_SUCCESS) {
             // On error, simply skip updating the pending buffers so that the next HVC or WRITE
-            // complete event triggers another attempt.
+            // complete event triggers another attempt. The SD's queue is shared with other
+            // characteristics on the connection, so it may be full even if ours isn't.
             return err_code;
         }
         self->pending_size = 0;
         self->pending_index = (self->pending_index + 1) % 2;
-        self->packet_queued = true;
+        self->packets_queued++;
     }
     return NRF_SUCCESS;
 }
 
+// Called when the SD reports that count packets have been sent.
+STATIC void packets_sent(bleio_packet_buffer_obj_t *self, uint8_t count) {
+    if (count > self->packets_queued) {
+        count = self->packets_queued;
+    }
+    self->packets_queued -= count;
+    queue_next_write(self);
+}
+
 STATIC bool packet_buffer_on_ble_client_evt(ble_evt_t *ble_evt, void *param) {
     bleio_packet_buffer_obj_t *self = (bleio_packet_buffer_obj_t *) param;
     uint16_t conn_handle = ble_evt->evt.gattc_evt.conn_handle;
@@ -126,11 +135,11 @@ STATIC bool packet_buffer_on_ble_client_evt(ble_evt_t *ble_evt, void *param) {
             break;
         }
         case BLE_GATTC_EVT_WRITE_CMD_TX_COMPLETE: {
-            queue_next_write(self);
+            packets_sent(self, ble_evt->evt.gattc_evt.params.write_cmd_tx_complete.count);
             break;
         }
         case BLE_GATTC_EVT_WRITE_RSP: {
-            queue_next_write(self);
+            packets_sent(self, 1);
             break;
         }
         default:
@@ -168,7 +177,19 @@ STATIC bool packet_buffer_on_ble_server_evt(ble_evt_t *ble_evt, void *param) {
             break;
         }
         case BLE_GATTS_EVT_HVN_TX_COMPLETE: {
-            queue_next_write(self);
+            if (conn_handle == self->conn_handle) {
+                packets_sent(self, ble_evt->evt.gatts_evt.params.hvn_tx_complete.count);
+            }
+            // Other PacketBuffers on the connection need to see this too.
+            return false;
+        }
+        case BLE_GATTS_EVT_HVC: {
+            // An indication was confirmed.
+            if (conn_handle == self->conn_handle &&
+                ble_evt->evt.gatts_evt.params.hvc.handle == self->characteristic->handle) {
+                packets_sent(self, 1);
+            }
+            return false;
         }
         default:
             return false;
@@ -204,7 +225,7 @@ void common_hal_bleio_packet_buffer_construct(
     }
 
     if (outgoing) {
-        self->packet_queued = false;
+        self->packets_queued = 0;
         self->pending_index = 0;
         self->pending_size = 0;
         self->outgoing[0] = m_malloc(characteristic->max_length, false);
@@ -215,7 +236,7 @@ void common_hal_bleio_packet_buffer_construct(
     }
 
     if (self->client) {
-        ble_drv_add_event_handler(packet_buffer_on_ble_client_evt, self);
+        ble_drv_add_filtered_event_handler(packet_buffer_on_ble_client_evt, self, BLE_DRV_EVT_GATTC);
         if (incoming) {
             // Prefer notify if both are available.
             if (incoming & CHAR_PROP_NOTIFY) {
@@ -226,17 +247,24 @@ void common_hal_bleio_packet_buffer_construct(
             }
         }
         if (outgoing) {
+            // Only one write request can be outstanding. The SD's write command queue is left at
+            // its default length of one to save RAM.
             self->write_type = BLE_GATT_OP_WRITE_REQ;
+            self->max_packets_queued = 1;
             if (outgoing & CHAR_PROP_WRITE_NO_RESPONSE) {
                 self->write_type = BLE_GATT_OP_WRITE_CMD;
             }
         }
     } else {
-        ble_drv_add_event_handler(packet_buffer_on_ble_server_evt, self);
+        ble_drv_add_filtered_event_handler(packet_buffer_on_ble_server_evt, self, BLE_DRV_EVT_GATTS);
         if (outgoing) {
+            // Only one indication can be outstanding, but the SD queues up to MAX_TX_IN_PROGRESS
+            // notifications (its hvn_tx_queue_size).
             self->write_type = BLE_GATT_HVX_INDICATION;
+            self->max_packets_queued = 1;
             if (outgoing & CHAR_PROP_NOTIFY) {
                 self->write_type = BLE_GATT_HVX_NOTIFICATION;
+                self->max_packets_queued = MAX_TX_IN_PROGRESS;
             }
         }
     }
@@ -276,6 +304,7 @@ void common_hal_bleio_packet_buffer_write(bleio_packet_buffer_obj_t *self, uint8
     }
     uint16_t packet_size = common_hal_bleio_packet_buffer_get_packet_size(self);
     uint16_t max_size = packet_size - len;
+    // Wait for the pending packet to go to the SD if this won't fit after it.
     while (max_size < self->pending_size && self->conn_handle != BLE_CONN_HANDLE_INVALID) {
         RUN_BACKGROUND_TASKS;
     }
@@ -294,16 +323,14 @@ void common_hal_bleio_packet_buffer_write(bleio_packet_buffer_obj_t *self, uint8
     memcpy(pending + self->pending_size, data, len);
     self->pending_size += len;
 
-    sd_nvic_critical_region_exit(is_nested_critical_region);
+    // If the SD has room then send this data straight away. Otherwise a completion event will.
+    queue_next_write(self);
 
-    // If no writes are queued then sneak in this data.
-    if (!self->packet_queued) {
-        queue_next_write(self);
-    }
+    sd_nvic_critical_region_exit(is_nested_critical_region);
 }
 
 uint16_t common_hal_bleio_packet_buffer_get_packet_size(bleio_packet_buffer_obj_t *self) {
-    uint16_t mtu;
+    uint16_t mtu = BLE_GATT_ATT_MTU_DEFAULT;
     if (self->conn_handle == BLE_CONN_HANDLE_INVALID) {
         return 0;
     }
@@ -314,14 +341,16 @@ uint16_t common_hal_bleio_packet_buffer_get_packet_size(bleio_packet_buffer_obj_
             break;
         }
     }
-    if (connection->mtu == 0) {
-        mtu = BLE_GATT_ATT_MTU_DEFAULT;
-    }
-    if (self->characteristic->max_length > mtu) {
-        mtu = self->characteristic->max_length;
+    if (connection->mtu != 0) {
+        mtu = connection->mtu;
     }
+    // A packet can't be longer than the negotiated MTU allows or than the characteristic.
     uint16_t att_overhead = 3;
-    return mtu - att_overhead;
+    uint16_t packet_size = mtu - att_overhead;
+    if (self->characteristic->max_length < packet_size) {
+        packet_size = self->characteristic->max_length;
+    }
+    return packet_size;
 }
 
 bool common_hal_bleio_packet_buffer_deinited(bleio_packet_buffer_obj_t *self) {
@@ -37,15 +37,17 @@ typedef struct {
     bleio_characteristic_obj_t *characteristic;
     // Ring buffer storing consecutive incoming values.
     ringbuf_t ringbuf;
-    // Two outgoing buffers to alternate between. One will be queued for transmission by the SD and
-    // the other is waiting to be queued and can be extended.
+    // Two outgoing buffers to alternate between. The SD copies a packet when it's queued, so the
+    // pending one can be extended while earlier packets wait in the SD's queue.
     uint8_t* outgoing[2];
     uint16_t pending_size;
     uint16_t conn_handle;
     uint8_t pending_index;
     uint8_t write_type;
     bool client;
-    bool packet_queued;
+    // Packets handed to the SD that it hasn't finished sending, and how many it can hold.
+    uint8_t packets_queued;
+    uint8_t max_packets_queued;
 } bleio_packet_buffer_obj_t;
 
 #endif // MICROPY_INCLUDED_NRF_COMMON_HAL_BLEIO_PACKETBUFFER_H
@@ -188,7 +188,7 @@ size_t common_hal_bleio_gattc_read(uint16_t handle, uint16_t conn_handle, uint8_
     read_info.conn_handle = conn_handle;
     // Set to true by the event handler.
     read_info.done = false;
-    ble_drv_add_event_handler(_on_gattc_read_rsp_evt, &read_info);
+    ble_drv_add_filtered_event_handler(_on_gattc_read_rsp_evt, &read_info, BLE_DRV_EVT_GATTC);
 
     uint32_t nrf_error = NRF_ERROR_BUSY;
     while (nrf_error == NRF_ERROR_BUSY) {
@@ -120,3 +120,15 @@ float common_hal_analogio_analogin_get_reference_voltage(analogio_analogin_obj_t
     // The nominal VCC voltage
     return 3.3f;
 }
+
+bool common_hal_analogio_analogin_start_reading(analogio_analogin_obj_t *self, uint16_t* buffer, size_t len, uint32_t rate, bool loop) {
+    // Timed sampling isn't implemented on this port.
+    return false;
+}
+
+bool common_hal_analogio_analogin_get_reading(analogio_analogin_obj_t *self) {
+    return false;
+}
+
+void common_hal_analogio_analogin_stop_reading(analogio_analogin_obj_t *self) {
+}
@@ -35,6 +35,16 @@
 #include "py/obj.h"
 #include "py/runtime.h"
 
+// Length of each of the two output buffers. Longer buffers survive longer pauses in background
+// processing at the cost of latency and RAM. Boards can override it.
+#ifndef I2SOUT_BUFFER_LENGTH_MS
+/* This duration was chosen empirically based on what would
+ * cause os.listdir('') to cause stuttering.  It seems like a
+ * rather long time.
+ */
+#define I2SOUT_BUFFER_LENGTH_MS (16)
+#endif
+
 static audiobusio_i2sout_obj_t *instance;
 
 struct { int16_t l, r; } static_sample16 = {0x8000, 0x8000};
@@ -106,6 +116,11 @@ void choose_i2s_clocking(audiobusio_i2sout_obj_t *self, uint32_t sample_rate) {
     self->sample_rate = best.sample_rate;
 }
 
+static uint32_t i2s_buffer_us(audiobusio_i2sout_obj_t* self) {
+    return audiosample_duration_us(self->buffer_length / (self->bytes_per_sample * self->channel_count),
+                                   self->sample_rate);
+}
+
 static void i2s_buffer_fill(audiobusio_i2sout_obj_t* self) {
     void *buffer = self->buffers[self->next_buffer];
     void *buffer_start = buffer;
@@ -193,6 +208,7 @@ void common_hal_audiobusio_i2sout_construct(audiobusio_i2sout_obj_t* self,
     if (instance)
         mp_raise_RuntimeError(translate("Device in use"));
     instance = self;
+    self->timing.stats = (audioio_playback_stats_t) { 0 };
 
     claim_pin(bit_clock);
     claim_pin(word_select);
@@ -260,13 +276,8 @@ void common_hal_audiobusio_i2sout_play(audiobusio_i2sout_obj_t* self,
         : I2S_CONFIG_CHANNELS_CHANNELS_Stereo;
 
     choose_i2s_clocking(self, sample_rate);
-    /* Allocate buffers based on a maximum duration
-     * This duration was chosen empirically based on what would
-     * cause os.listdir('') to cause stuttering.  It seems like a
-     * rather long time.
-     */
-    enum { buffer_length_ms = 16 };
-    self->buffer_length = sample_rate * buffer_length_ms
+    // Allocate buffers based on a maximum duration.
+    self->buffer_length = sample_rate * I2SOUT_BUFFER_LENGTH_MS
             * self->bytes_per_sample * self->channel_count / 1000;
     self->buffer_length = (self->buffer_length + 3) & ~3;
     self->buffers[0] = m_malloc(self->buffer_length, false);
@@ -281,6 +292,8 @@ void common_hal_audiobusio_i2sout_play(audiobusio_i2sout_obj_t* self,
     self->paused = false;
     self->stopping = false;
     i2s_buffer_fill(self);
+    // Nothing plays before the first buffer so it counts as queued.
+    audioio_playback_timing_start(&self->timing, 0, i2s_buffer_us(self));
 
     NRF_I2S->RXTXD.MAXCNT = self->buffer_length / 4;
     NRF_I2S->ENABLE = I2S_ENABLE_ENABLE_Enabled;
@@ -307,6 +320,10 @@ void common_hal_audiobusio_i2sout_stop(audiobusio_i2sout_obj_t* self) {
     self->stopping = true;
 }
 
+const audioio_playback_stats_t* common_hal_audiobusio_i2sout_get_stats(audiobusio_i2sout_obj_t* self) {
+    return &self->timing.stats;
+}
+
 bool common_hal_audiobusio_i2sout_get_playing(audiobusio_i2sout_obj_t* self) {
     if (NRF_I2S->EVENTS_STOPPED) {
         self->playing = false;
@@ -320,9 +337,12 @@ void i2s_background(void) {
         NRF_I2S->EVENTS_TXPTRUPD = 0;
         if (instance) {
             i2s_buffer_fill(instance);
+            audioio_playback_timing_refill(&instance->timing, i2s_buffer_us(instance));
         } else {
             NRF_I2S->TASKS_STOP = 1;
         }
+    } else if (instance && instance->playing) {
+        audioio_playback_timing_idle(&instance->timing);
     }
 }
 
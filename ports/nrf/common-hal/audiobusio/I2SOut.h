@@ -28,6 +28,7 @@
 #define MICROPY_INCLUDED_NRF_COMMON_HAL_AUDIOBUSIO_I2SOUT_H
 
 #include "py/obj.h"
+#include "shared-module/audiocore/__init__.h"
 
 typedef struct {
     mp_obj_base_t base;
@@ -39,6 +40,7 @@ typedef struct {
     uint16_t buffer_length;
     uint16_t sample_rate;
     uint32_t hold_value;
+    audioio_playback_timing_t timing;
 
     uint8_t next_buffer;
     uint8_t bit_clock_pin_number;
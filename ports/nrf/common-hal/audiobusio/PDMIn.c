@@ -25,15 +25,40 @@
  */
 
 #include "common-hal/audiobusio/PDMIn.h"
+#include "shared-bindings/audiobusio/PDMIn.h"
 #include "shared-bindings/microcontroller/Pin.h"
 
 #include "py/runtime.h"
 
+// 16ms at 16kHz so background tasks can be late without losing data.
+#define BACKGROUND_SAMPLES_PER_BUFFER 256
+
 __attribute__((used))
 NRF_PDM_Type *nrf_pdm = NRF_PDM;
 
 static uint32_t dummy_buffer[4];
 
+// PDMIn recording in the background.
+static audiobusio_pdmin_obj_t* background_pdmin;
+
+static void set_mode(audiobusio_pdmin_obj_t* self) {
+    // Note: Adafruit's module has SELECT pulled to GND, which makes the DATA
+    // valid when the CLK is low, therefore it must be sampled on the rising edge.
+    if (self->mono) {
+        nrf_pdm->MODE = PDM_MODE_OPERATION_Stereo | PDM_MODE_EDGE_LeftRising;
+    } else {
+        nrf_pdm->MODE = PDM_MODE_OPERATION_Mono | PDM_MODE_EDGE_LeftRising;
+    }
+}
+
+void pdmin_reset(void) {
+    if (background_pdmin != NULL) {
+        nrf_pdm->SAMPLE.PTR = (uintptr_t)&dummy_buffer;
+        nrf_pdm->SAMPLE.MAXCNT = 1;
+    }
+    background_pdmin = NULL;
+}
+
 void common_hal_audiobusio_pdmin_construct(audiobusio_pdmin_obj_t* self,
                                            const mcu_pin_obj_t* clock_pin,
                                            const mcu_pin_obj_t* data_pin,
@@ -47,6 +72,7 @@ void common_hal_audiobusio_pdmin_construct(audiobusio_pdmin_obj_t* self,
     claim_pin(data_pin);
 
     self->mono = mono;
+    self->ring = NULL;
     self->clock_pin_number = clock_pin->number;
     self->data_pin_number = data_pin->number;
 
@@ -74,6 +100,7 @@ bool common_hal_audiobusio_pdmin_deinited(audiobusio_pdmin_obj_t* self) {
 }
 
 void common_hal_audiobusio_pdmin_deinit(audiobusio_pdmin_obj_t* self) {
+    common_hal_audiobusio_pdmin_stop(self);
     nrf_pdm->ENABLE = 0;
 
     reset_pin_number(self->clock_pin_number);
@@ -92,13 +119,10 @@ uint32_t common_hal_audiobusio_pdmin_get_sample_rate(audiobusio_pdmin_obj_t* sel
 
 uint32_t common_hal_audiobusio_pdmin_record_to_buffer(audiobusio_pdmin_obj_t* self,
         uint16_t* output_buffer, uint32_t output_buffer_length) {
-    // Note: Adafruit's module has SELECT pulled to GND, which makes the DATA
-    // valid when the CLK is low, therefore it must be sampled on the rising edge.
-    if (self->mono) {
-        nrf_pdm->MODE = PDM_MODE_OPERATION_Stereo | PDM_MODE_EDGE_LeftRising;
-    } else {
-        nrf_pdm->MODE = PDM_MODE_OPERATION_Mono | PDM_MODE_EDGE_LeftRising;
+    if (common_hal_audiobusio_pdmin_get_recording(self)) {
+        mp_raise_RuntimeError(translate("Serializer in use"));
     }
+    set_mode(self);
 
     // step 1. Redirect to real buffer
     nrf_pdm->SAMPLE.PTR = (uintptr_t)output_buffer;
@@ -128,3 +152,90 @@ uint32_t common_hal_audiobusio_pdmin_record_to_buffer(audiobusio_pdmin_obj_t* se
         return (output_buffer_length / 4) * 4;
     }
 }
+
+void common_hal_audiobusio_pdmin_start(audiobusio_pdmin_obj_t* self, uint32_t buffer_length) {
+    if (common_hal_audiobusio_pdmin_get_recording(self)) {
+        return;
+    }
+    self->ring = m_new(uint16_t, buffer_length);
+    self->ring_length = buffer_length;
+    self->ring_start = 0;
+    self->ring_count = 0;
+    self->buffers[0] = m_new(int16_t, BACKGROUND_SAMPLES_PER_BUFFER);
+    self->buffers[1] = m_new(int16_t, BACKGROUND_SAMPLES_PER_BUFFER);
+    self->filling = -1;
+    self->queued = 0;
+    set_mode(self);
+
+    // Registers are double buffered so this takes effect when the dummy buffer is done.
+    nrf_pdm->EVENTS_STARTED = 0;
+    nrf_pdm->SAMPLE.PTR = (uintptr_t)self->buffers[0];
+    nrf_pdm->SAMPLE.MAXCNT = BACKGROUND_SAMPLES_PER_BUFFER;
+    background_pdmin = self;
+}
+
+void common_hal_audiobusio_pdmin_stop(audiobusio_pdmin_obj_t* self) {
+    if (!common_hal_audiobusio_pdmin_get_recording(self)) {
+        return;
+    }
+    nrf_pdm->SAMPLE.PTR = (uintptr_t)&dummy_buffer;
+    nrf_pdm->SAMPLE.MAXCNT = 1;
+    background_pdmin = NULL;
+    // Samples already recorded can still be read.
+    self->buffers[0] = NULL;
+    self->buffers[1] = NULL;
+}
+
+bool common_hal_audiobusio_pdmin_get_recording(audiobusio_pdmin_obj_t* self) {
+    return background_pdmin == self;
+}
+
+uint32_t common_hal_audiobusio_pdmin_readinto(audiobusio_pdmin_obj_t* self,
+        uint16_t* output_buffer, uint32_t output_buffer_length) {
+    if (self->ring == NULL) {
+        return 0;
+    }
+    uint32_t count = MIN(output_buffer_length, self->ring_count);
+    for (uint32_t i = 0; i < count; i++) {
+        output_buffer[i] = self->ring[self->ring_start];
+        self->ring_start++;
+        if (self->ring_start == self->ring_length) {
+            self->ring_start = 0;
+        }
+    }
+    self->ring_count -= count;
+    return count;
+}
+
+// Copies buffers the PDM has finished into the ring. Samples that don't fit are dropped.
+void pdmin_background(void) {
+    audiobusio_pdmin_obj_t* self = background_pdmin;
+    if (self == NULL || !nrf_pdm->EVENTS_STARTED) {
+        return;
+    }
+    nrf_pdm->EVENTS_STARTED = 0;
+    // The queued buffer has started filling so the one before it is complete.
+    int8_t done = self->filling;
+    self->filling = self->queued;
+    self->queued = !self->filling;
+    nrf_pdm->SAMPLE.PTR = (uintptr_t)self->buffers[self->queued];
+    nrf_pdm->SAMPLE.MAXCNT = BACKGROUND_SAMPLES_PER_BUFFER;
+    if (done < 0) {
+        return;
+    }
+
+    int16_t* buffer = self->buffers[done];
+    uint32_t end = self->ring_start + self->ring_count;
+    for (uint32_t i = 0; i < BACKGROUND_SAMPLES_PER_BUFFER; i++) {
+        if (self->ring_count == self->ring_length) {
+            break;
+        }
+        if (end >= self->ring_length) {
+            end -= self->ring_length;
+        }
+        // They want unsigned.
+        self->ring[end] = buffer[i] + 32768;
+        end++;
+        self->ring_count++;
+    }
+}
@@ -35,6 +35,18 @@ typedef struct {
     mp_obj_base_t base;
     uint8_t clock_pin_number, data_pin_number;
     bool mono;
+    // Background recording state. The PDM alternates between two buffers that are copied into
+    // the ring.
+    int8_t filling; // Buffer being filled or -1 when it's the dummy buffer.
+    uint8_t queued; // Buffer the PDM moves to next.
+    int16_t* buffers[2];
+    uint16_t* ring;
+    uint32_t ring_length; // In samples.
+    uint32_t ring_start;
+    uint32_t ring_count;
 } audiobusio_pdmin_obj_t;
 
+void pdmin_reset(void);
+void pdmin_background(void);
+
 #endif
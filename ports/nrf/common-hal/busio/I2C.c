@@ -68,6 +68,26 @@ void i2c_reset(void) {
     }
 }
 
+uint8_t common_hal_busio_i2c_write_read(busio_i2c_obj_t *self, uint16_t addr,
+        const uint8_t *out_data, size_t out_len, uint8_t *in_data, size_t in_len) {
+    // TWIM chains the write and the read with a repeated start when both fit
+    // in one EasyDMA transfer.
+    if (out_len == 0 || in_len == 0 || out_len > I2C_MAX_XFER_LEN || in_len > I2C_MAX_XFER_LEN) {
+        uint8_t status = common_hal_busio_i2c_write(self, addr, out_data, out_len, false);
+        if (status != 0) {
+            return status;
+        }
+        return common_hal_busio_i2c_read(self, addr, in_data, in_len);
+    }
+
+    nrfx_twim_enable(&self->twim_peripheral->twim);
+    nrfx_twim_xfer_desc_t xfer_desc = NRFX_TWIM_XFER_DESC_TXRX(addr, (uint8_t*) out_data, out_len, in_data, in_len);
+    nrfx_err_t err = nrfx_twim_xfer(&self->twim_peripheral->twim, &xfer_desc, 0);
+    nrfx_twim_disable(&self->twim_peripheral->twim);
+
+    return twi_error_to_mp(err);
+}
+
 void common_hal_busio_i2c_never_reset(busio_i2c_obj_t *self) {
     for (size_t i = 0 ; i < MP_ARRAY_SIZE(twim_peripherals); i++) {
         if (self->twim_peripheral == &twim_peripherals[i]) {
@@ -121,6 +121,74 @@ static nrf_spim_frequency_t baudrate_to_spim_frequency(const uint32_t baudrate)
     return 0;
 }
 
+// Starts the next piece of the transfer. Returns false if there's nothing left
+// to send or the piece can't be started.
+STATIC bool start_xfer_piece(busio_spi_obj_t *self) {
+    while (self->xfer_remaining == 0 && self->xfer_segments_left > 0) {
+        self->xfer_out = self->xfer_segments->out;
+        self->xfer_in = self->xfer_segments->in;
+        self->xfer_remaining = self->xfer_segments->len;
+        self->xfer_segments++;
+        self->xfer_segments_left--;
+    }
+    size_t len = MIN(self->xfer_remaining, self->spim_peripheral->max_xfer_size);
+    if (len == 0) {
+        return false;
+    }
+    const nrfx_spim_xfer_desc_t xfer = NRFX_SPIM_SINGLE_XFER(self->xfer_out, self->xfer_out == NULL ? 0 : len,
+        self->xfer_in, self->xfer_in == NULL ? 0 : len);
+    self->xfer_remaining -= len;
+    if (self->xfer_out != NULL) {
+        self->xfer_out += len;
+    }
+    if (self->xfer_in != NULL) {
+        self->xfer_in += len;
+    }
+    if (nrfx_spim_xfer(&self->spim_peripheral->spim, &xfer, 0) != NRFX_SUCCESS) {
+        self->xfer_failed = true;
+        return false;
+    }
+    return true;
+}
+
+STATIC void spim_event_handler(nrfx_spim_evt_t const *p_event, void *p_context) {
+    busio_spi_obj_t *self = p_context;
+    if (!start_xfer_piece(self)) {
+        self->xfer_in_progress = false;
+    }
+}
+
+STATIC void wait_for_transfer(busio_spi_obj_t *self) {
+    while (self->xfer_in_progress) {
+    }
+}
+
+// Starts a transfer that carries on after returning. data_out may be NULL to
+// send the over-read character instead and data_in may be NULL to ignore what's
+// read.
+STATIC bool start_transfer(busio_spi_obj_t *self, const uint8_t *data_out, uint8_t *data_in, size_t len) {
+    wait_for_transfer(self);
+    self->xfer_segments_left = 0;
+    self->xfer_out = data_out;
+    self->xfer_in = data_in;
+    self->xfer_remaining = len;
+    self->xfer_failed = false;
+    self->xfer_in_progress = true;
+    if (!start_xfer_piece(self)) {
+        self->xfer_in_progress = false;
+        return false;
+    }
+    return true;
+}
+
+STATIC bool transfer(busio_spi_obj_t *self, const uint8_t *data_out, uint8_t *data_in, size_t len) {
+    if (!start_transfer(self, data_out, data_in, len)) {
+        return false;
+    }
+    wait_for_transfer(self);
+    return !self->xfer_failed;
+}
+
 void common_hal_busio_spi_construct(busio_spi_obj_t *self, const mcu_pin_obj_t * clock, const mcu_pin_obj_t * mosi, const mcu_pin_obj_t * miso) {
     // Find a free instance.
     self->spim_peripheral = NULL;
@@ -159,7 +227,11 @@ void common_hal_busio_spi_construct(busio_spi_obj_t *self, const mcu_pin_obj_t *
         self->MISO_pin_number = NO_PIN;
     }
 
-    nrfx_err_t err = nrfx_spim_init(&self->spim_peripheral->spim, &config, NULL, NULL);
+    self->xfer_segments_left = 0;
+    self->xfer_in_progress = false;
+    // With a handler, transfers return straight away and the SPIM interrupt
+    // starts each following piece.
+    nrfx_err_t err = nrfx_spim_init(&self->spim_peripheral->spim, &config, spim_event_handler, self);
     if (err != NRFX_SUCCESS) {
         common_hal_busio_spi_deinit(self);
         mp_raise_OSError(MP_EIO);
@@ -174,6 +246,7 @@ void common_hal_busio_spi_deinit(busio_spi_obj_t *self) {
     if (common_hal_busio_spi_deinited(self))
         return;
 
+    wait_for_transfer(self);
     nrfx_spim_uninit(&self->spim_peripheral->spim);
 
     reset_pin_number(self->clock_pin_number);
@@ -187,6 +260,8 @@ bool common_hal_busio_spi_configure(busio_spi_obj_t *self, uint32_t baudrate, ui
       return false;
     }
 
+    wait_for_transfer(self);
+
     // Set desired frequency, rounding down, and don't go above available frequency for this SPIM.
     nrf_spim_frequency_set(self->spim_peripheral->spim.p_reg,
                            baudrate_to_spim_frequency(MIN(baudrate,
@@ -227,72 +302,61 @@ bool common_hal_busio_spi_write(busio_spi_obj_t *self, const uint8_t *data, size
     if (len == 0)
         return true;
 
-    const uint32_t max_xfer_size = self->spim_peripheral->max_xfer_size;
-    const uint32_t parts = len / max_xfer_size;
-    const uint32_t remainder = len % max_xfer_size;
-
-    for (uint32_t i = 0; i < parts; ++i) {
-        const nrfx_spim_xfer_desc_t xfer = NRFX_SPIM_XFER_TX(data + i * max_xfer_size, max_xfer_size);
-        if (nrfx_spim_xfer(&self->spim_peripheral->spim, &xfer, 0) != NRFX_SUCCESS)
-            return false;
-    }
+    return transfer(self, data, NULL, len);
+}
 
-    if (remainder > 0) {
-        const nrfx_spim_xfer_desc_t xfer = NRFX_SPIM_XFER_TX(data + parts * max_xfer_size, remainder);
-        if (nrfx_spim_xfer(&self->spim_peripheral->spim, &xfer, 0) != NRFX_SUCCESS)
-            return false;
-    }
+bool common_hal_busio_spi_start_write(busio_spi_obj_t *self, const uint8_t *data, size_t len) {
+    if (len == 0)
+        return true;
 
-    return true;
+    return start_transfer(self, data, NULL, len);
 }
 
-bool common_hal_busio_spi_read(busio_spi_obj_t *self, uint8_t *data, size_t len, uint8_t write_value) {
+bool common_hal_busio_spi_start_read(busio_spi_obj_t *self, uint8_t *data, size_t len, uint8_t write_value) {
     if (len == 0)
         return true;
 
-    const uint32_t max_xfer_size = self->spim_peripheral->max_xfer_size;
-    const uint32_t parts = len / max_xfer_size;
-    const uint32_t remainder = len % max_xfer_size;
+    wait_for_transfer(self);
+    nrf_spim_orc_set(self->spim_peripheral->spim.p_reg, write_value);
+    return start_transfer(self, NULL, data, len);
+}
 
-    for (uint32_t i = 0; i < parts; ++i) {
-        const nrfx_spim_xfer_desc_t xfer = NRFX_SPIM_XFER_RX(data + i * max_xfer_size, max_xfer_size);
-        if (nrfx_spim_xfer(&self->spim_peripheral->spim, &xfer, 0) != NRFX_SUCCESS)
-            return false;
-    }
+bool common_hal_busio_spi_transfer_in_progress(busio_spi_obj_t *self) {
+    return self->xfer_in_progress;
+}
 
-    if (remainder > 0) {
-        const nrfx_spim_xfer_desc_t xfer = NRFX_SPIM_XFER_RX(data + parts * max_xfer_size, remainder);
-        if (nrfx_spim_xfer(&self->spim_peripheral->spim, &xfer, 0) != NRFX_SUCCESS)
-            return false;
-    }
+bool common_hal_busio_spi_read(busio_spi_obj_t *self, uint8_t *data, size_t len, uint8_t write_value) {
+    if (len == 0)
+        return true;
 
-    return true;
+    wait_for_transfer(self);
+    nrf_spim_orc_set(self->spim_peripheral->spim.p_reg, write_value);
+    return transfer(self, NULL, data, len);
 }
 
 bool common_hal_busio_spi_transfer(busio_spi_obj_t *self, uint8_t *data_out, uint8_t *data_in, size_t len) {
     if (len == 0)
         return true;
 
+    return transfer(self, data_out, data_in, len);
+}
 
-    const uint32_t max_xfer_size = self->spim_peripheral->max_xfer_size;
-    const uint32_t parts = len / max_xfer_size;
-    const uint32_t remainder = len % max_xfer_size;
-
-    for (uint32_t i = 0; i < parts; ++i) {
-        const nrfx_spim_xfer_desc_t xfer = NRFX_SPIM_SINGLE_XFER(data_out + i * max_xfer_size, max_xfer_size,
-            data_in + i * max_xfer_size, max_xfer_size);
-        if (nrfx_spim_xfer(&self->spim_peripheral->spim, &xfer, 0) != NRFX_SUCCESS)
-            return false;
-    }
-
-    if (remainder > 0) {
-        const nrfx_spim_xfer_desc_t xfer = NRFX_SPIM_SINGLE_XFER(data_out + parts * max_xfer_size, remainder,
-            data_in + parts * max_xfer_size, remainder);
-        if (nrfx_spim_xfer(&self->spim_peripheral->spim, &xfer, 0) != NRFX_SUCCESS)
-            return false;
+// EasyDMA's list mode only steps through equal sized buffers so the segments
+// are chained from the SPIM interrupt instead.
+bool common_hal_busio_spi_transaction(busio_spi_obj_t *self, const busio_spi_segment_t *segments, size_t count, uint8_t write_value) {
+    wait_for_transfer(self);
+    nrf_spim_orc_set(self->spim_peripheral->spim.p_reg, write_value);
+    self->xfer_segments = segments;
+    self->xfer_segments_left = count;
+    self->xfer_remaining = 0;
+    self->xfer_failed = false;
+    self->xfer_in_progress = true;
+    if (!start_xfer_piece(self)) {
+        self->xfer_in_progress = false;
+        return !self->xfer_failed;
     }
-
-    return true;
+    wait_for_transfer(self);
+    return !self->xfer_failed;
 }
 
 uint32_t common_hal_busio_spi_get_frequency(busio_spi_obj_t* self) {
@@ -36,6 +36,8 @@ typedef struct {
     uint8_t max_xfer_size;
 } spim_peripheral_t;
 
+struct _busio_spi_segment_t;
+
 typedef struct {
     mp_obj_base_t base;
     spim_peripheral_t* spim_peripheral;
@@ -43,6 +45,15 @@ typedef struct {
     uint8_t clock_pin_number;
     uint8_t MOSI_pin_number;
     uint8_t MISO_pin_number;
+    // The transfer in progress, which the SPIM interrupt carries on in
+    // max_xfer_size pieces and then through any segments left.
+    const struct _busio_spi_segment_t *xfer_segments;
+    size_t xfer_segments_left;
+    const uint8_t *xfer_out;
+    uint8_t *xfer_in;
+    size_t xfer_remaining;
+    volatile bool xfer_in_progress;
+    volatile bool xfer_failed;
 } busio_spi_obj_t;
 
 void spi_reset(void);
@@ -97,7 +97,9 @@ static void uart_callback_irq (const nrfx_uarte_event_t * event, void * context)
 
     switch ( event->type ) {
         case NRFX_UARTE_EVT_RX_DONE:
-            ringbuf_put_n(&self->rbuf, event->data.rxtx.p_data, event->data.rxtx.bytes);
+            if (ringbuf_put_n(&self->rbuf, event->data.rxtx.p_data, event->data.rxtx.bytes) > 0) {
+                self->rx_overruns++;
+            }
 
             // keep receiving
             (void) nrfx_uarte_rx(self->uarte, &self->rx_char, 1);
@@ -109,9 +111,10 @@ static void uart_callback_irq (const nrfx_uarte_event_t * event, void * context)
 
         case NRFX_UARTE_EVT_ERROR:
             // Possible Error source is Overrun, Parity, Framing, Break
-            // uint32_t errsrc = event->data.error.error_mask;
-
-            ringbuf_put_n(&self->rbuf, event->data.error.rxtx.p_data, event->data.error.rxtx.bytes);
+            if ((event->data.error.error_mask & NRF_UARTE_ERROR_OVERRUN_MASK) != 0 ||
+                ringbuf_put_n(&self->rbuf, event->data.error.rxtx.p_data, event->data.error.rxtx.bytes) > 0) {
+                self->rx_overruns++;
+            }
 
             // Keep receiving
             (void) nrfx_uarte_rx(self->uarte, &self->rx_char, 1);
@@ -183,6 +186,7 @@ void common_hal_busio_uart_construct (busio_uart_obj_t *self,
         // in the long-lived pool is not strictly necessary)
         // (This is a macro.)
         ringbuf_alloc(&self->rbuf, receiver_buffer_size, true);
+        self->rx_overruns = 0;
 
         if ( !self->rbuf.buf ) {
             nrfx_uarte_uninit(self->uarte);
@@ -247,11 +251,7 @@ size_t common_hal_busio_uart_read(busio_uart_obj_t *self, uint8_t *data, size_t
     NVIC_DisableIRQ(nrfx_get_irq_number(self->uarte->p_reg));
 
     // copy received data
-    rx_bytes = ringbuf_count(&self->rbuf);
-    rx_bytes = MIN(rx_bytes, len);
-    for ( uint16_t i = 0; i < rx_bytes; i++ ) {
-        data[i] = ringbuf_get(&self->rbuf);
-    }
+    rx_bytes = ringbuf_get_n(&self->rbuf, data, MIN(len, self->rbuf.size));
 
     NVIC_EnableIRQ(nrfx_get_irq_number(self->uarte->p_reg));
 
@@ -321,3 +321,7 @@ void common_hal_busio_uart_clear_rx_buffer(busio_uart_obj_t *self) {
 bool common_hal_busio_uart_ready_to_tx(busio_uart_obj_t *self) {
     return !nrfx_uarte_tx_in_progress(self->uarte);
 }
+
+uint32_t common_hal_busio_uart_get_rx_overruns(busio_uart_obj_t *self) {
+    return self->rx_overruns;
+}
@@ -43,6 +43,7 @@ typedef struct {
 
     ringbuf_t rbuf;
     uint8_t rx_char; // EasyDMA buf
+    uint32_t rx_overruns;
 
     uint8_t tx_pin_number;
     uint8_t rx_pin_number;
@@ -0,0 +1,159 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "common-hal/countio/Counter.h"
+#include "nrfx_gpiote.h"
+#include "nrf_soc.h"
+#include "nrf_sdm.h"
+#include "nrf/timers.h"
+
+#include "py/runtime.h"
+#include "shared-bindings/countio/Counter.h"
+#include "shared-bindings/microcontroller/__init__.h"
+#include "supervisor/shared/translate.h"
+
+// PPI channels that are free to use with or without the SoftDevice.
+#define COUNTER_PPI_CHANNELS 16
+
+static uint16_t ppi_channels_in_use;
+
+STATIC void ppi_connect(uint8_t channel, uint32_t event, uint32_t task) {
+    uint8_t sd_en = 0;
+    (void) sd_softdevice_is_enabled(&sd_en);
+    if (sd_en) {
+        sd_ppi_channel_assign(channel, (const volatile void*) event, (const volatile void*) task);
+        sd_ppi_channel_enable_set(1 << channel);
+    } else {
+        NRF_PPI->CH[channel].EEP = event;
+        NRF_PPI->CH[channel].TEP = task;
+        NRF_PPI->CHENSET = 1 << channel;
+    }
+}
+
+STATIC void ppi_disconnect(uint8_t channel) {
+    uint8_t sd_en = 0;
+    (void) sd_softdevice_is_enabled(&sd_en);
+    if (sd_en) {
+        sd_ppi_channel_enable_clr(1 << channel);
+    } else {
+        NRF_PPI->CHENCLR = 1 << channel;
+    }
+}
+
+// The timer never interrupts but nrfx requires a handler.
+STATIC void counter_event_handler(nrf_timer_event_t event_type, void* p_context) {
+}
+
+void counter_reset(void) {
+    for (uint8_t i = 0; i < COUNTER_PPI_CHANNELS; i++) {
+        if ((ppi_channels_in_use & (1 << i)) != 0) {
+            ppi_disconnect(i);
+        }
+    }
+    ppi_channels_in_use = 0;
+}
+
+void common_hal_countio_counter_construct(countio_counter_obj_t* self, const mcu_pin_obj_t* pin) {
+    uint8_t ppi_channel = 0;
+    while (ppi_channel < COUNTER_PPI_CHANNELS && (ppi_channels_in_use & (1 << ppi_channel)) != 0) {
+        ppi_channel++;
+    }
+    if (ppi_channel == COUNTER_PPI_CHANNELS) {
+        mp_raise_RuntimeError(translate("All event channels in use"));
+    }
+    nrfx_timer_t* timer = nrf_peripherals_allocate_timer();
+    if (timer == NULL) {
+        mp_raise_RuntimeError(translate("All timers in use"));
+    }
+
+    nrfx_timer_config_t timer_config = {
+        .frequency = NRF_TIMER_FREQ_16MHz,
+        .mode = NRF_TIMER_MODE_LOW_POWER_COUNTER,
+        .bit_width = NRF_TIMER_BIT_WIDTH_32,
+        .interrupt_priority = NRFX_TIMER_DEFAULT_CONFIG_IRQ_PRIORITY,
+        .p_context = self,
+    };
+    nrfx_timer_init(timer, &timer_config, &counter_event_handler);
+
+    if (!nrfx_gpiote_is_init()) {
+        nrfx_gpiote_init(NRFX_GPIOTE_CONFIG_IRQ_PRIORITY);
+    }
+    nrfx_gpiote_in_config_t cfg = {
+        .sense = NRF_GPIOTE_POLARITY_LOTOHI,
+        .pull = NRF_GPIO_PIN_NOPULL,
+        .is_watcher = false,
+        .hi_accuracy = true,
+        .skip_gpio_setup = false
+    };
+    nrfx_gpiote_in_init(pin->number, &cfg, NULL);
+    // Generate the event without interrupting.
+    nrfx_gpiote_in_event_enable(pin->number, false);
+
+    self->timer = timer;
+    self->pin = pin->number;
+    self->ppi_channel = ppi_channel;
+    self->reset_total = 0;
+    ppi_channels_in_use |= 1 << ppi_channel;
+    claim_pin(pin);
+
+    ppi_connect(ppi_channel, nrfx_gpiote_in_event_addr_get(pin->number),
+        nrfx_timer_task_address_get(timer, NRF_TIMER_TASK_COUNT));
+    nrfx_timer_clear(timer);
+    nrfx_timer_enable(timer);
+}
+
+bool common_hal_countio_counter_deinited(countio_counter_obj_t* self) {
+    return self->pin == NO_PIN;
+}
+
+void common_hal_countio_counter_deinit(countio_counter_obj_t* self) {
+    if (common_hal_countio_counter_deinited(self)) {
+        return;
+    }
+    ppi_disconnect(self->ppi_channel);
+    ppi_channels_in_use &= ~(1 << self->ppi_channel);
+    nrfx_gpiote_in_event_disable(self->pin);
+    nrfx_gpiote_in_uninit(self->pin);
+    nrfx_timer_disable(self->timer);
+    nrfx_timer_uninit(self->timer);
+    nrf_peripherals_free_timer(self->timer);
+    self->timer = NULL;
+
+    reset_pin_number(self->pin);
+    self->pin = NO_PIN;
+}
+
+uint32_t common_hal_countio_counter_get_count(countio_counter_obj_t* self) {
+    return nrfx_timer_capture(self->timer, NRF_TIMER_CC_CHANNEL0) - self->reset_total;
+}
+
+uint32_t common_hal_countio_counter_reset(countio_counter_obj_t* self) {
+    // Capturing doesn't stop the count, so no edges are lost between reads.
+    uint32_t total = nrfx_timer_capture(self->timer, NRF_TIMER_CC_CHANNEL0);
+    uint32_t count = total - self->reset_total;
+    self->reset_total = total;
+    return count;
+}
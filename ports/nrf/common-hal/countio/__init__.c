@@ -0,0 +1 @@
+// No countio module functions.
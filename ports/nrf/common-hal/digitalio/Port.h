@@ -0,0 +1,75 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_NRF_COMMON_HAL_DIGITALIO_PORT_H
+#define MICROPY_INCLUDED_NRF_COMMON_HAL_DIGITALIO_PORT_H
+
+#include "common-hal/microcontroller/Pin.h"
+#include "nrf_gpio.h"
+#include "py/obj.h"
+
+// Shared by PortIn and PortOut.
+typedef struct {
+    mp_obj_base_t base;
+    NRF_GPIO_Type* gpio; // GPIO port of all of the pins.
+    uint32_t mask;      // The pins' bits in the port registers.
+    uint8_t num_pins;   // 0 once deinited.
+    int8_t shift;       // value << shift is the pins' bits when they are consecutive, otherwise -1.
+    uint8_t pins[32];
+} digitalio_port_obj_t;
+
+// Checks that the pins are on one port and claims them. Defined in PortIn.c.
+void digitalio_port_construct(digitalio_port_obj_t* self, const mcu_pin_obj_t** pins, size_t num_pins);
+void digitalio_port_deinit(digitalio_port_obj_t* self);
+
+// Converts a value, with bit n for the nth pin, to the pins' bits in the port registers.
+static inline uint32_t digitalio_port_to_bits(const digitalio_port_obj_t* self, uint32_t value) {
+    if (self->shift >= 0) {
+        return (value << self->shift) & self->mask;
+    }
+    uint32_t bits = 0;
+    for (size_t i = 0; i < self->num_pins; i++) {
+        if ((value & (1u << i)) != 0) {
+            bits |= 1u << (self->pins[i] & 0x1f);
+        }
+    }
+    return bits;
+}
+
+static inline uint32_t digitalio_port_from_bits(const digitalio_port_obj_t* self, uint32_t bits) {
+    if (self->shift >= 0) {
+        return (bits & self->mask) >> self->shift;
+    }
+    uint32_t value = 0;
+    for (size_t i = 0; i < self->num_pins; i++) {
+        if ((bits & (1u << (self->pins[i] & 0x1f))) != 0) {
+            value |= 1u << i;
+        }
+    }
+    return value;
+}
+
+#endif // MICROPY_INCLUDED_NRF_COMMON_HAL_DIGITALIO_PORT_H
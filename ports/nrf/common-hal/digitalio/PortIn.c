@@ -0,0 +1,92 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/digitalio/PortIn.h"
+
+#include "nrf_gpio.h"
+#include "py/runtime.h"
+#include "supervisor/shared/translate.h"
+
+void digitalio_port_construct(digitalio_port_obj_t* self, const mcu_pin_obj_t** pins, size_t num_pins) {
+    uint32_t first = pins[0]->number;
+    // Changes first to be a relative pin number in port.
+    NRF_GPIO_Type* gpio = nrf_gpio_pin_port_decode(&first);
+    for (size_t i = 0; i < num_pins; i++) {
+        uint32_t pin = pins[i]->number;
+        if (nrf_gpio_pin_port_decode(&pin) != gpio) {
+            mp_raise_ValueError(translate("Pins must be on the same port"));
+        }
+    }
+
+    self->gpio = gpio;
+    self->num_pins = num_pins;
+    self->mask = 0;
+    self->shift = first;
+    for (size_t i = 0; i < num_pins; i++) {
+        uint8_t pin = pins[i]->number;
+        self->pins[i] = pin;
+        self->mask |= 1u << (pin & 0x1f);
+        if ((pin & 0x1f) != first + i) {
+            self->shift = -1;
+        }
+        claim_pin(pins[i]);
+    }
+}
+
+void digitalio_port_deinit(digitalio_port_obj_t* self) {
+    for (size_t i = 0; i < self->num_pins; i++) {
+        nrf_gpio_cfg_default(self->pins[i]);
+        reset_pin_number(self->pins[i]);
+    }
+    self->num_pins = 0;
+}
+
+void common_hal_digitalio_portin_construct(digitalio_portin_obj_t* self,
+    const mcu_pin_obj_t** pins, size_t num_pins, digitalio_pull_t pull) {
+    digitalio_port_construct(self, pins, num_pins);
+
+    nrf_gpio_pin_pull_t hal_pull = NRF_GPIO_PIN_NOPULL;
+    if (pull == PULL_UP) {
+        hal_pull = NRF_GPIO_PIN_PULLUP;
+    } else if (pull == PULL_DOWN) {
+        hal_pull = NRF_GPIO_PIN_PULLDOWN;
+    }
+    for (size_t i = 0; i < num_pins; i++) {
+        nrf_gpio_cfg_input(self->pins[i], hal_pull);
+    }
+}
+
+bool common_hal_digitalio_portin_deinited(digitalio_portin_obj_t* self) {
+    return self->num_pins == 0;
+}
+
+void common_hal_digitalio_portin_deinit(digitalio_portin_obj_t* self) {
+    digitalio_port_deinit(self);
+}
+
+uint32_t common_hal_digitalio_portin_get_value(digitalio_portin_obj_t* self) {
+    return digitalio_port_from_bits(self, self->gpio->IN);
+}
@@ -0,0 +1,135 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/digitalio/PortOut.h"
+
+#include "lib/utils/interrupt_char.h"
+#include "nrf_gpio.h"
+#include "nrfx_timer.h"
+#include "peripherals/nrf/timers.h"
+#include "py/mphal.h"
+#include "py/runtime.h"
+#include "shared-bindings/microcontroller/__init__.h"
+#include "supervisor/shared/translate.h"
+
+#define MAX_SEQUENCE_RATE 1000000
+// At this rate and below there's time to run background tasks between values.
+#define BACKGROUND_SEQUENCE_RATE 1000
+
+void common_hal_digitalio_portout_construct(digitalio_portout_obj_t* self,
+    const mcu_pin_obj_t** pins, size_t num_pins, uint32_t value) {
+    digitalio_port_construct(self, pins, num_pins);
+
+    // Set the levels before driving the pins so they don't glitch.
+    uint32_t bits = digitalio_port_to_bits(self, value);
+    self->gpio->OUTCLR = self->mask & ~bits;
+    self->gpio->OUTSET = bits;
+    for (size_t i = 0; i < num_pins; i++) {
+        nrf_gpio_cfg(self->pins[i],
+                     NRF_GPIO_PIN_DIR_OUTPUT,
+                     NRF_GPIO_PIN_INPUT_DISCONNECT,
+                     NRF_GPIO_PIN_NOPULL,
+                     NRF_GPIO_PIN_H0H1,
+                     NRF_GPIO_PIN_NOSENSE);
+    }
+}
+
+bool common_hal_digitalio_portout_deinited(digitalio_portout_obj_t* self) {
+    return self->num_pins == 0;
+}
+
+void common_hal_digitalio_portout_deinit(digitalio_portout_obj_t* self) {
+    digitalio_port_deinit(self);
+}
+
+uint32_t common_hal_digitalio_portout_get_value(digitalio_portout_obj_t* self) {
+    return digitalio_port_from_bits(self, self->gpio->OUT);
+}
+
+// There is no toggle register, so the other pins on the port are protected from interrupts
+// while OUT is rewritten.
+STATIC void write_bits(digitalio_portout_obj_t* self, uint32_t bits) {
+    common_hal_mcu_disable_interrupts();
+    self->gpio->OUT = (self->gpio->OUT & ~self->mask) | bits;
+    common_hal_mcu_enable_interrupts();
+}
+
+void common_hal_digitalio_portout_set_value(digitalio_portout_obj_t* self, uint32_t value) {
+    write_bits(self, digitalio_port_to_bits(self, value));
+}
+
+STATIC uint32_t get_sequence_value(const uint8_t* values, size_t index, uint8_t bytes_per_value) {
+    switch (bytes_per_value) {
+        case 2:
+            return ((const uint16_t*) values)[index];
+        case 4:
+            return ((const uint32_t*) values)[index];
+        default:
+            return values[index];
+    }
+}
+
+void common_hal_digitalio_portout_write_sequence(digitalio_portout_obj_t* self,
+    const uint8_t* values, size_t len, uint8_t bytes_per_value, uint32_t rate) {
+    if (len == 0) {
+        return;
+    }
+    if (rate > MAX_SEQUENCE_RATE) {
+        mp_raise_ValueError_varg(translate("Sample rate too high. It must be less than %d"), MAX_SEQUENCE_RATE);
+    }
+    nrfx_timer_t* timer = nrf_peripherals_allocate_timer();
+    if (timer == NULL) {
+        mp_raise_RuntimeError(translate("All timers in use"));
+    }
+
+    // GPIO can't be written by EasyDMA, so the CPU writes each value when the timer's compare
+    // event comes round. The timer restarts itself so the pace doesn't drift.
+    NRF_TIMER_Type* t = timer->p_reg;
+    t->TASKS_STOP = 1;
+    t->TASKS_CLEAR = 1;
+    t->MODE = TIMER_MODE_MODE_Timer;
+    t->BITMODE = TIMER_BITMODE_BITMODE_32Bit;
+    t->PRESCALER = 0; // 16MHz
+    t->CC[0] = 16000000 / rate;
+    t->SHORTS = TIMER_SHORTS_COMPARE0_CLEAR_Msk;
+    t->INTENCLR = 0xffffffff;
+    t->EVENTS_COMPARE[0] = 0;
+    t->TASKS_START = 1;
+
+    for (size_t i = 0; i < len && !mp_hal_is_interrupted(); i++) {
+        uint32_t bits = digitalio_port_to_bits(self, get_sequence_value(values, i, bytes_per_value));
+        while (t->EVENTS_COMPARE[0] == 0) {
+            if (rate <= BACKGROUND_SEQUENCE_RATE) {
+                RUN_BACKGROUND_TASKS;
+            }
+        }
+        t->EVENTS_COMPARE[0] = 0;
+        write_bits(self, bits);
+    }
+
+    t->TASKS_STOP = 1;
+    nrf_peripherals_free_timer(timer);
+}
@@ -24,7 +24,11 @@
  * THE SOFTWARE.
  */
 
+#include "py/gc.h"
+#include "py/mpstate.h"
 #include "py/mphal.h"
+#include "py/runtime.h"
+#include "common-hal/neopixel_write/__init__.h"
 #include "shared-bindings/neopixel_write/__init__.h"
 #include "nrf_pwm.h"
 
@@ -100,28 +104,76 @@ static NRF_PWM_Type* find_free_pwm (void) {
 uint64_t next_start_tick_ms = 0;
 uint32_t next_start_tick_us = 1000;
 
+// The sequence ends with 100us of low output so the strip has latched by the
+// time SEQEND is set.
+#define LATCH_STEPS 80
+
+#define PATTERN_SIZE(numBytes) (numBytes * 8 * sizeof(uint16_t) + LATCH_STEPS * sizeof(uint16_t))
+
+// Use a static buffer to store 1 pixels worth of PWM data for the status led. uint32_t to ensure
+// alignment. Make it at least as big as PATTERN_SIZE(3), for one pixel of RGB data.
+// PATTERN_SIZE is a multiple of 4, so we don't need round up to make sure one_pixel is large enough.
+static uint32_t one_pixel[PATTERN_SIZE(3)/sizeof(uint32_t)];
+
+// The PWM sending the last pattern, if it's still running.
+static NRF_PWM_Type* transfer_pwm = NULL;
+
+STATIC void finish_transfer(void) {
+    NRF_PWM_Type* pwm = transfer_pwm;
+    transfer_pwm = NULL;
+
+    // Before leave we clear the flag for the event.
+    nrf_pwm_event_clear(pwm, NRF_PWM_EVENT_SEQEND0);
+
+    // We need to disable the device and disconnect
+    // all the outputs before leave or the device will not
+    // be selected on the next call.
+    // TODO: Check if disabling the device causes performance issues.
+    nrf_pwm_disable(pwm);
+    nrf_pwm_pins_set(pwm, (uint32_t[]) {0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL} );
+}
+
+STATIC void wait_for_transfer(void) {
+    while (transfer_pwm != NULL && !nrf_pwm_event_check(transfer_pwm, NRF_PWM_EVENT_SEQEND0)) {
+        RUN_BACKGROUND_TASKS;
+    }
+    // Background tasks may have finished it already.
+    if (transfer_pwm != NULL) {
+        finish_transfer();
+    }
+}
+
+void neopixel_write_background(void) {
+    if (transfer_pwm != NULL && nrf_pwm_event_check(transfer_pwm, NRF_PWM_EVENT_SEQEND0)) {
+        finish_transfer();
+    }
+}
+
+void neopixel_write_reset(void) {
+    if (transfer_pwm != NULL) {
+        nrf_pwm_task_trigger(transfer_pwm, NRF_PWM_TASK_STOP);
+        finish_transfer();
+    }
+}
+
 void common_hal_neopixel_write (const digitalio_digitalinout_obj_t* digitalinout, uint8_t *pixels, uint32_t numBytes) {
     // To support both the SoftDevice + Neopixels we use the EasyDMA
     // feature from the NRF25. However this technique implies to
     // generate a pattern and store it on the memory. The actual
     // memory used in bytes corresponds to the following formula:
-    //              totalMem = numBytes*8*2+(2*2)
-    // The two additional bytes at the end are needed to reset the
+    //              totalMem = numBytes*8*2+(LATCH_STEPS*2)
+    // The additional steps at the end are needed to reset the
     // sequence.
     //
+    // The pattern is sent in the background so it must outlive this call.
     // If there is not enough memory, we will fall back to cycle counter
     // using DWT
 
-#define PATTERN_SIZE(numBytes) (numBytes * 8 * sizeof(uint16_t) + 2 * sizeof(uint16_t))
-
     uint32_t pattern_size = PATTERN_SIZE(numBytes);
     uint16_t* pixels_pattern = NULL;
-    bool pattern_on_heap = false;
 
-    // Use the stack to store 1 pixels worth of PWM data for the status led. uint32_t to ensure alignment.
-    // Make it at least as big as PATTERN_SIZE(3), for one pixel of RGB data.
-    // PATTERN_SIZE is a multiple of 4, so we don't need round up to make sure one_pixel is large enough.
-    uint32_t one_pixel[PATTERN_SIZE(3)/sizeof(uint32_t)];
+    // Only one strip is sent at a time, and the PWM isn't free until then.
+    wait_for_transfer();
 
     NRF_PWM_Type* pwm = find_free_pwm();
 
@@ -129,19 +181,23 @@ void common_hal_neopixel_write (const digitalio_digitalinout_obj_t* digitalinout
     if ( pwm != NULL ) {
         if (pattern_size <= sizeof(one_pixel)) {
             pixels_pattern = (uint16_t *) one_pixel;
-        } else {
-            uint8_t sd_en = 0;
-            (void) sd_softdevice_is_enabled(&sd_en);
-            if (sd_en) {
-                // If the soft device is enabled then we must use PWM to
-                // transmit. This takes a bunch of memory to do so raise an
-                // exception if we can't.
-                pixels_pattern = (uint16_t *) m_malloc(pattern_size, false);
-            } else {
-                pixels_pattern = (uint16_t *) m_malloc_maybe(pattern_size, false);
+        } else if (MP_STATE_MEM(gc_pool_start) != 0) {
+            // Reuse the last pattern when it's big enough.
+            pixels_pattern = MP_STATE_VM(neopixel_write_buffer);
+            if (pixels_pattern == NULL || gc_nbytes(pixels_pattern) < pattern_size) {
+                MP_STATE_VM(neopixel_write_buffer) = NULL;
+                uint8_t sd_en = 0;
+                (void) sd_softdevice_is_enabled(&sd_en);
+                if (sd_en) {
+                    // If the soft device is enabled then we must use PWM to
+                    // transmit. This takes a bunch of memory to do so raise an
+                    // exception if we can't.
+                    pixels_pattern = (uint16_t *) m_malloc(pattern_size, false);
+                } else {
+                    pixels_pattern = (uint16_t *) m_malloc_maybe(pattern_size, false);
+                }
+                MP_STATE_VM(neopixel_write_buffer) = pixels_pattern;
             }
-
-            pattern_on_heap = true;
         }
     }
 
@@ -163,8 +219,9 @@ void common_hal_neopixel_write (const digitalio_digitalinout_obj_t* digitalinout
         }
 
         // Zero padding to indicate the end of sequence
-        pixels_pattern[pos++] = 0 | (0x8000);  // Seq end
-        pixels_pattern[pos++] = 0 | (0x8000);  // Seq end
+        for (uint16_t i = 0; i < LATCH_STEPS; i++) {
+            pixels_pattern[pos++] = 0 | (0x8000);  // Seq end
+        }
 
         // Set the wave mode to count UP
         // Set the PWM to use the 16MHz clock
@@ -190,13 +247,6 @@ void common_hal_neopixel_write (const digitalio_digitalinout_obj_t* digitalinout
         nrf_pwm_seq_refresh_set(pwm, 0, 0);
         nrf_pwm_seq_end_delay_set(pwm, 0, 0);
 
-        // The Neopixel implementation is a blocking algorithm. DMA
-        // allows for non-blocking operation. To "simulate" a blocking
-        // operation we enable the interruption for the end of sequence
-        // and block the execution thread until the event flag is set by
-        // the peripheral.
-        //    pwm->INTEN |= (PWM_INTEN_SEQEND0_Enabled<<PWM_INTEN_SEQEND0_Pos);
-
         // PSEL must be configured before enabling PWM
         nrf_pwm_pins_set(pwm, (uint32_t[]) {digitalinout->pin->number, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL} );
 
@@ -208,25 +258,11 @@ void common_hal_neopixel_write (const digitalio_digitalinout_obj_t* digitalinout
         nrf_pwm_event_clear(pwm, NRF_PWM_EVENT_SEQEND0);
         nrf_pwm_task_trigger(pwm, NRF_PWM_TASK_SEQSTART0);
 
-        // But we have to wait for the flag to be set.
-        while ( !nrf_pwm_event_check(pwm, NRF_PWM_EVENT_SEQEND0) ) {
-            RUN_BACKGROUND_TASKS;
-        }
-
-        // Before leave we clear the flag for the event.
-        nrf_pwm_event_clear(pwm, NRF_PWM_EVENT_SEQEND0);
-
-        // We need to disable the device and disconnect
-        // all the outputs before leave or the device will not
-        // be selected on the next call.
-        // TODO: Check if disabling the device causes performance issues.
-        nrf_pwm_disable(pwm);
-        nrf_pwm_pins_set(pwm, (uint32_t[]) {0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL} );
-
-        if (pattern_on_heap) {
-            m_free(pixels_pattern);
-        }
-
+        // DMA allows for non-blocking operation so we return straight away.
+        // The PWM is released by the next write or by background tasks once
+        // SEQEND is set. The latch steps take the place of the gap below.
+        transfer_pwm = pwm;
+        return;
     } // End of DMA implementation
     // ---------------------------------------------------------------------
     else {
@@ -72,6 +72,19 @@ bool common_hal_nvm_bytearray_set_bytes(nvm_bytearray_obj_t *self,
     return true;
 }
 
+uint32_t common_hal_nvm_bytearray_get_erase_size(nvm_bytearray_obj_t *self) {
+    return FLASH_PAGE_SIZE;
+}
+
+bool common_hal_nvm_bytearray_erase(nvm_bytearray_obj_t *self, uint32_t start_index) {
+    return nrf_nvm_safe_flash_page_erase((uint32_t) self->start_address + start_index);
+}
+
+bool common_hal_nvm_bytearray_program(nvm_bytearray_obj_t *self,
+        uint32_t start_index, const uint8_t* values, uint32_t len) {
+    return nrf_nvm_safe_flash_write((uint32_t) self->start_address + start_index, values, len);
+}
+
 void common_hal_nvm_bytearray_get_bytes(nvm_bytearray_obj_t *self,
     uint32_t start_index, uint32_t len, uint8_t* values) {
     memcpy(values, self->start_address + start_index, len);
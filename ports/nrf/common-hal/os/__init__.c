@@ -35,6 +35,11 @@
 
 #include "nrf_rng.h"
 
+#include <string.h>
+
+#include "common-hal/os/__init__.h"
+#include "shared-bindings/microcontroller/__init__.h"
+
 STATIC const qstr os_uname_info_fields[] = {
     MP_QSTR_sysname, MP_QSTR_nodename,
     MP_QSTR_release, MP_QSTR_version, MP_QSTR_machine
@@ -61,6 +66,52 @@ mp_obj_t common_hal_os_uname(void) {
     return (mp_obj_t)&os_uname_info_obj;
 }
 
+// Entropy collected by the RNG interrupt so that urandom doesn't usually
+// wait. The RNG only runs until the pool is full again. While the SoftDevice
+// is enabled it owns the RNG, and keeps a pool of its own.
+#define URANDOM_POOL_SIZE 64
+
+STATIC uint8_t urandom_pool[URANDOM_POOL_SIZE];
+STATIC volatile size_t urandom_pool_len;
+
+STATIC void rng_start(void) {
+    nrf_rng_int_enable(NRF_RNG, NRF_RNG_INT_VALRDY_MASK);
+    NVIC_SetPriority(RNG_IRQn, (1 << __NVIC_PRIO_BITS) - 1);
+    NVIC_EnableIRQ(RNG_IRQn);
+    nrf_rng_task_trigger(NRF_RNG, NRF_RNG_TASK_START);
+}
+
+void urandom_pool_stop(void) {
+    nrf_rng_task_trigger(NRF_RNG, NRF_RNG_TASK_STOP);
+    nrf_rng_int_disable(NRF_RNG, NRF_RNG_INT_VALRDY_MASK);
+    NVIC_DisableIRQ(RNG_IRQn);
+    nrf_rng_event_clear(NRF_RNG, NRF_RNG_EVENT_VALRDY);
+    NVIC_ClearPendingIRQ(RNG_IRQn);
+}
+
+void RNG_IRQHandler(void) {
+    nrf_rng_event_clear(NRF_RNG, NRF_RNG_EVENT_VALRDY);
+    size_t len = urandom_pool_len;
+    if (len < URANDOM_POOL_SIZE) {
+        urandom_pool[len++] = nrf_rng_random_value_get(NRF_RNG);
+        urandom_pool_len = len;
+    }
+    if (len == URANDOM_POOL_SIZE) {
+        urandom_pool_stop();
+    }
+}
+
+// Moves up to length bytes out of the pool. Each byte is handed out once.
+STATIC size_t take_from_pool(uint8_t* buffer, size_t length) {
+    common_hal_mcu_disable_interrupts();
+    size_t count = MIN(length, urandom_pool_len);
+    urandom_pool_len -= count;
+    memcpy(buffer, urandom_pool + urandom_pool_len, count);
+    memset(urandom_pool + urandom_pool_len, 0, count);
+    common_hal_mcu_enable_interrupts();
+    return count;
+}
+
 bool common_hal_os_urandom(uint8_t *buffer, uint32_t length) {
 #ifdef BLUETOOTH_SD
     uint8_t sd_en = 0;
@@ -86,17 +137,19 @@ bool common_hal_os_urandom(uint8_t *buffer, uint32_t length) {
     }
 #endif
 
-    nrf_rng_event_clear(NRF_RNG, NRF_RNG_EVENT_VALRDY);
-    nrf_rng_task_trigger(NRF_RNG, NRF_RNG_TASK_START);
-
-    for (uint32_t i = 0; i < length; i++) {
-        while (nrf_rng_event_check(NRF_RNG, NRF_RNG_EVENT_VALRDY) == 0);
-        nrf_rng_event_clear(NRF_RNG, NRF_RNG_EVENT_VALRDY);
-
-        buffer[i] = nrf_rng_random_value_get(NRF_RNG);
+    size_t count = take_from_pool(buffer, length);
+    buffer += count;
+    length -= count;
+    // Refill in the background. Anything the pool couldn't cover arrives
+    // through it a byte at a time.
+    rng_start();
+    while (length > 0) {
+        count = take_from_pool(buffer, length);
+        buffer += count;
+        length -= count;
+        if (length > 0) {
+            rng_start();
+        }
     }
-
-    nrf_rng_task_trigger(NRF_RNG, NRF_RNG_TASK_STOP);
-
     return true;
 }
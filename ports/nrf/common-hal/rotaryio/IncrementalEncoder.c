@@ -28,12 +28,54 @@
 #include "nrfx_gpiote.h"
 
 #include "py/runtime.h"
+#include "supervisor/shared/tick.h"
 
 #include <stdio.h>
 
 // obj array to map pin number -> self since nrfx hide the mapping
 static rotaryio_incrementalencoder_obj_t *_objs[NUMBER_OF_PINS];
 
+#ifdef NRF_QDEC
+static bool qdec_in_use;
+
+STATIC void qdec_start(uint8_t pin_a, uint8_t pin_b) {
+    // The QDEC doesn't configure the pins itself.
+    nrf_gpio_cfg_input(pin_a, NRF_GPIO_PIN_PULLUP);
+    nrf_gpio_cfg_input(pin_b, NRF_GPIO_PIN_PULLUP);
+
+    NRF_QDEC->PSEL.A = pin_a;
+    NRF_QDEC->PSEL.B = pin_b;
+    NRF_QDEC->PSEL.LED = QDEC_PSEL_LED_CONNECT_Disconnected << QDEC_PSEL_LED_CONNECT_Pos;
+    // Sampling every 128us with the debounce filter keeps up with about 7800 edges a second.
+    NRF_QDEC->SAMPLEPER = QDEC_SAMPLEPER_SAMPLEPER_128us;
+    NRF_QDEC->DBFEN = QDEC_DBFEN_DBFEN_Enabled;
+    NRF_QDEC->SHORTS = 0;
+    NRF_QDEC->INTENCLR = 0xffffffff;
+    NRF_QDEC->ENABLE = QDEC_ENABLE_ENABLE_Enabled;
+    NRF_QDEC->TASKS_READCLRACC = 1;
+    NRF_QDEC->TASKS_START = 1;
+    qdec_in_use = true;
+}
+
+STATIC void qdec_stop(void) {
+    NRF_QDEC->TASKS_STOP = 1;
+    NRF_QDEC->ENABLE = QDEC_ENABLE_ENABLE_Disabled;
+    NRF_QDEC->PSEL.A = QDEC_PSEL_A_CONNECT_Disconnected << QDEC_PSEL_A_CONNECT_Pos;
+    NRF_QDEC->PSEL.B = QDEC_PSEL_B_CONNECT_Disconnected << QDEC_PSEL_B_CONNECT_Pos;
+    qdec_in_use = false;
+}
+
+// Folds the edges accumulated by the QDEC since the last update into the position. The
+// accumulator saturates at 1023 edges, so it must be read at least that often; the background
+// velocity sampling takes care of that.
+STATIC void qdec_update(rotaryio_incrementalencoder_obj_t *self) {
+    NRF_QDEC->TASKS_READCLRACC = 1;
+    int32_t quarters = self->quarter + (int32_t) NRF_QDEC->ACCREAD;
+    self->position += quarters / 4;
+    self->quarter = quarters % 4;
+}
+#endif
+
 static void _intr_handler(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action) {
     rotaryio_incrementalencoder_obj_t *self = _objs[pin];
     if (!self) return;
@@ -65,10 +107,28 @@ void common_hal_rotaryio_incrementalencoder_construct(rotaryio_incrementalencode
 
     self->pin_a = pin_a->number;
     self->pin_b = pin_b->number;
+    self->quarter = 0;
+    self->position = 0;
+    self->sample_index = 0;
+    self->sample_count = 0;
 
     _objs[self->pin_a] = self;
     _objs[self->pin_b] = self;
 
+    claim_pin(pin_a);
+    claim_pin(pin_b);
+
+    // The QDEC decodes in hardware and can use any pins, but there's only one of it. Later
+    // encoders fall back to GPIOTE interrupts.
+    self->qdec = false;
+    #ifdef NRF_QDEC
+    if (!qdec_in_use) {
+        self->qdec = true;
+        qdec_start(self->pin_a, self->pin_b);
+        return;
+    }
+    #endif
+
     nrfx_gpiote_in_config_t cfg = {
         .sense = NRF_GPIOTE_POLARITY_TOGGLE,
         .pull = NRF_GPIO_PIN_PULLUP,
@@ -80,9 +140,6 @@ void common_hal_rotaryio_incrementalencoder_construct(rotaryio_incrementalencode
     nrfx_gpiote_in_init(self->pin_b, &cfg, _intr_handler);
     nrfx_gpiote_in_event_enable(self->pin_a, true);
     nrfx_gpiote_in_event_enable(self->pin_b, true);
-
-    claim_pin(pin_a);
-    claim_pin(pin_b);
 }
 
 bool common_hal_rotaryio_incrementalencoder_deinited(rotaryio_incrementalencoder_obj_t* self) {
@@ -96,10 +153,17 @@ void common_hal_rotaryio_incrementalencoder_deinit(rotaryio_incrementalencoder_o
     _objs[self->pin_a] = NULL;
     _objs[self->pin_b] = NULL;
 
-    nrfx_gpiote_in_event_disable(self->pin_a);
-    nrfx_gpiote_in_event_disable(self->pin_b);
-    nrfx_gpiote_in_uninit(self->pin_a);
-    nrfx_gpiote_in_uninit(self->pin_b);
+    #ifdef NRF_QDEC
+    if (self->qdec) {
+        qdec_stop();
+    } else
+    #endif
+    {
+        nrfx_gpiote_in_event_disable(self->pin_a);
+        nrfx_gpiote_in_event_disable(self->pin_b);
+        nrfx_gpiote_in_uninit(self->pin_a);
+        nrfx_gpiote_in_uninit(self->pin_b);
+    }
     reset_pin_number(self->pin_a);
     reset_pin_number(self->pin_b);
     self->pin_a = NO_PIN;
@@ -107,10 +171,62 @@ void common_hal_rotaryio_incrementalencoder_deinit(rotaryio_incrementalencoder_o
 }
 
 mp_int_t common_hal_rotaryio_incrementalencoder_get_position(rotaryio_incrementalencoder_obj_t* self) {
+    #ifdef NRF_QDEC
+    if (self->qdec) {
+        qdec_update(self);
+    }
+    #endif
     return self->position;
 }
 
 void common_hal_rotaryio_incrementalencoder_set_position(rotaryio_incrementalencoder_obj_t* self,
         mp_int_t new_position) {
+    // Shift the velocity samples along with the position so the jump doesn't count as movement.
+    mp_int_t shift = new_position - common_hal_rotaryio_incrementalencoder_get_position(self);
+    for (size_t i = 0; i < VELOCITY_SAMPLES; i++) {
+        self->sample_positions[i] += shift;
+    }
     self->position = new_position;
 }
+
+mp_float_t common_hal_rotaryio_incrementalencoder_get_velocity(rotaryio_incrementalencoder_obj_t* self) {
+    if (self->sample_count < 2) {
+        return 0;
+    }
+    size_t newest = (self->sample_index + VELOCITY_SAMPLES - 1) % VELOCITY_SAMPLES;
+    size_t oldest = (self->sample_index + VELOCITY_SAMPLES - self->sample_count) % VELOCITY_SAMPLES;
+    uint32_t elapsed_ms = self->sample_ms[newest] - self->sample_ms[oldest];
+    if (elapsed_ms == 0) {
+        return 0;
+    }
+    return (mp_float_t) (self->sample_positions[newest] - self->sample_positions[oldest]) * 1000 / elapsed_ms;
+}
+
+void incrementalencoder_background(void) {
+    uint32_t now = supervisor_ticks_ms32();
+    for (size_t pin = 0; pin < NUMBER_OF_PINS; pin++) {
+        rotaryio_incrementalencoder_obj_t *self = _objs[pin];
+        // Each encoder is in the table twice. Only sample it once.
+        if (self == NULL || self->pin_a != pin) {
+            continue;
+        }
+        self->sample_positions[self->sample_index] = common_hal_rotaryio_incrementalencoder_get_position(self);
+        self->sample_ms[self->sample_index] = now;
+        self->sample_index = (self->sample_index + 1) % VELOCITY_SAMPLES;
+        if (self->sample_count < VELOCITY_SAMPLES) {
+            self->sample_count++;
+        }
+    }
+}
+
+void incrementalencoder_reset(void) {
+    // GPIOTE is reset as a whole by pulsein_reset().
+    for (size_t pin = 0; pin < NUMBER_OF_PINS; pin++) {
+        _objs[pin] = NULL;
+    }
+    #ifdef NRF_QDEC
+    if (qdec_in_use) {
+        qdec_stop();
+    }
+    #endif
+}
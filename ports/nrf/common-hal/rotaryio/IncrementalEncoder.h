@@ -31,16 +31,28 @@
 
 #include "py/obj.h"
 
+// Velocity is the change in position over the last VELOCITY_SAMPLES samples, taken every
+// VELOCITY_SAMPLE_MS milliseconds.
+#define VELOCITY_SAMPLES 4
+#define VELOCITY_SAMPLE_MS 25
+
 typedef struct {
     mp_obj_base_t base;
     uint8_t pin_a;
     uint8_t pin_b;
     uint8_t state;
     int8_t quarter;
+    bool qdec;              // decoded by the QDEC instead of GPIOTE interrupts
+    uint8_t sample_index;
+    uint8_t sample_count;
     mp_int_t position;
+    mp_int_t sample_positions[VELOCITY_SAMPLES];
+    uint32_t sample_ms[VELOCITY_SAMPLES];
 } rotaryio_incrementalencoder_obj_t;
 
 
 void incrementalencoder_interrupt_handler(uint8_t channel);
+void incrementalencoder_background(void);
+void incrementalencoder_reset(void);
 
 #endif // MICROPY_INCLUDED_NRF_COMMON_HAL_ROTARYIO_INCREMENTALENCODER_H
@@ -51,6 +51,14 @@ endif
 # frequencyio not yet implemented
 CIRCUITPY_FREQUENCYIO = 0
 
+ifndef CIRCUITPY_DIGITALIO_PORT
+CIRCUITPY_DIGITALIO_PORT = 1
+endif
+
+ifndef CIRCUITPY_COUNTIO
+CIRCUITPY_COUNTIO = 1
+endif
+
 # nRF52840-specific
 
 ifeq ($(MCU_CHIP),nrf52840)
@@ -70,3 +78,13 @@ NRF_DEFINES += -DNRF52840_XXAA -DNRF52840
 CFLAGS += -DCONFIG_NFCT_PINS_AS_GPIOS
 
 endif
+
+# TinyUSB's task runs in PendSV. See supervisor/usb.c.
+ifndef CIRCUITPY_USB_IRQ_TASK
+CIRCUITPY_USB_IRQ_TASK = 1
+endif
+
+# Cycles are counted with the DWT. See supervisor/port.c.
+ifndef CIRCUITPY_CYCLE_COUNTER
+CIRCUITPY_CYCLE_COUNTER = 1
+endif
@@ -50,6 +50,52 @@ STATIC sd_flash_operation_status_t sd_flash_operation_wait_until_done(void) {
 }
 #endif
 
+bool nrf_nvm_safe_flash_page_erase(uint32_t page_addr) {
+    #ifdef BLUETOOTH_SD
+        uint8_t sd_en = 0;
+        (void) sd_softdevice_is_enabled(&sd_en);
+        if (sd_en) {
+            sd_flash_operation_start();
+            if (sd_flash_page_erase(page_addr / FLASH_PAGE_SIZE) != NRF_SUCCESS) {
+                return false;
+            }
+            return sd_flash_operation_wait_until_done() != SD_FLASH_OPERATION_ERROR;
+        }
+    #endif
+
+    nrfx_nvmc_page_erase(page_addr);
+    return true;
+}
+
+bool nrf_nvm_safe_flash_write(uint32_t addr, const uint8_t *data, uint32_t len) {
+    #ifdef BLUETOOTH_SD
+        uint8_t sd_en = 0;
+        (void) sd_softdevice_is_enabled(&sd_en);
+        if (sd_en) {
+            // Write at most half a page at a time, because writing a full page causes an
+            // assertion failure. See nrf_nvm_safe_flash_page_write.
+            while (len > 0) {
+                uint32_t write_len = MIN(len, FLASH_PAGE_SIZE / 2);
+                sd_flash_operation_start();
+                if (sd_flash_write((uint32_t *)addr, (const uint32_t *)data,
+                                   write_len / sizeof(uint32_t)) != NRF_SUCCESS) {
+                    return false;
+                }
+                if (sd_flash_operation_wait_until_done() == SD_FLASH_OPERATION_ERROR) {
+                    return false;
+                }
+                addr += write_len;
+                data += write_len;
+                len -= write_len;
+            }
+            return true;
+        }
+    #endif
+
+    nrfx_nvmc_words_write(addr, data, len / sizeof(uint32_t));
+    return true;
+}
+
 bool nrf_nvm_safe_flash_page_write(uint32_t page_addr, uint8_t *data) {
     #ifdef BLUETOOTH_SD
         uint8_t sd_en = 0;
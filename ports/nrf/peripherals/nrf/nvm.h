@@ -28,3 +28,6 @@
 #define FLASH_PAGE_SIZE (4096)
 
 bool nrf_nvm_safe_flash_page_write(uint32_t page_addr, uint8_t *data);
+bool nrf_nvm_safe_flash_page_erase(uint32_t page_addr);
+// Write whole words to erased flash without erasing it first. data must be word aligned.
+bool nrf_nvm_safe_flash_write(uint32_t addr, const uint8_t *data, uint32_t len);
@@ -30,6 +30,8 @@
 
 #include "nrfx/hal/nrf_power.h"
 #include "nrfx/drivers/include/nrfx_power.h"
+#include "nrf_sdm.h"
+#include "nrf_soc.h"
 
 #include "nrf/cache.h"
 #include "nrf/clocks.h"
@@ -43,9 +45,12 @@
 #include "common-hal/busio/I2C.h"
 #include "common-hal/busio/SPI.h"
 #include "common-hal/busio/UART.h"
+#include "common-hal/countio/Counter.h"
+#include "common-hal/neopixel_write/__init__.h"
 #include "common-hal/pulseio/PWMOut.h"
 #include "common-hal/pulseio/PulseOut.h"
 #include "common-hal/pulseio/PulseIn.h"
+#include "common-hal/rotaryio/IncrementalEncoder.h"
 #include "common-hal/rtc/RTC.h"
 #include "tick.h"
 
@@ -53,6 +58,7 @@
 
 #ifdef CIRCUITPY_AUDIOBUSIO
 #include "common-hal/audiobusio/I2SOut.h"
+#include "common-hal/audiobusio/PDMIn.h"
 #endif
 
 #ifdef CIRCUITPY_AUDIOPWMIO
@@ -84,6 +90,12 @@ safe_mode_t port_init(void) {
     // Configure millisecond timer initialization.
     tick_init();
 
+    #if CIRCUITPY_CYCLE_COUNTER
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    #endif
+
 #if CIRCUITPY_ANALOGIO
     analogin_init();
 #endif
@@ -109,6 +121,7 @@ void reset_port(void) {
 
 #if CIRCUITPY_AUDIOBUSIO
     i2s_reset();
+    pdmin_reset();
 #endif
 
 #if CIRCUITPY_AUDIOPWMIO
@@ -116,12 +129,24 @@ void reset_port(void) {
 #endif
 
 
+#if CIRCUITPY_NEOPIXEL_WRITE
+    neopixel_write_reset();
+#endif
+
 #if CIRCUITPY_PULSEIO
     pwmout_reset();
     pulseout_reset();
     pulsein_reset();
 #endif
 
+#if CIRCUITPY_ROTARYIO
+    incrementalencoder_reset();
+#endif
+
+#if CIRCUITPY_COUNTIO
+    counter_reset();
+#endif
+
     timers_reset();
 
 #if CIRCUITPY_RTC
@@ -164,6 +189,30 @@ uint32_t port_get_saved_word(void) {
     return _ebss;
 }
 
+#if CIRCUITPY_CYCLE_COUNTER
+uint32_t port_get_cycle_count(void) {
+    return DWT->CYCCNT;
+}
+#endif
+
+void port_sleep_until_interrupt(void) {
+    // A floating point exception flag keeps the FPU interrupt pending, which
+    // would wake us straight away.
+    if (NVIC_GetPendingIRQ(FPU_IRQn)) {
+        __set_FPSCR(__get_FPSCR() & ~(0x9f));
+        (void) __get_FPSCR();
+        NVIC_ClearPendingIRQ(FPU_IRQn);
+    }
+    uint8_t sd_enabled;
+    sd_softdevice_is_enabled(&sd_enabled);
+    if (sd_enabled) {
+        // The SoftDevice needs to know we're going to sleep.
+        sd_app_evt_wait();
+    } else {
+        __WFI();
+    }
+}
+
 void HardFault_Handler(void) {
     reset_into_safe_mode(HARD_CRASH);
     while (true) {
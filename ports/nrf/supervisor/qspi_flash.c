@@ -38,6 +38,9 @@
 #include "supervisor/shared/external_flash/common_commands.h"
 #include "supervisor/shared/external_flash/qspi_flash.h"
 
+// Where the QSPI peripheral maps the flash for execute in place reads.
+#define QSPI_XIP_START_ADDR (0x12000000)
+
 bool spi_flash_command(uint8_t command) {
     nrf_qspi_cinstr_conf_t cinstr_cfg = {
         .opcode = command,
@@ -90,6 +93,14 @@ bool spi_flash_read_data(uint32_t address, uint8_t* data, uint32_t length) {
     return nrfx_qspi_read(data, length, address) == NRFX_SUCCESS;
 }
 
+// The XIP window is available whenever the QSPI peripheral is active. It
+// isn't covered by the instruction cache for data reads, so it never holds
+// stale data after a write. Bulk reads still use EasyDMA above, which is
+// faster than reading through XIP.
+const uint8_t* spi_flash_get_mapped_address(uint32_t address) {
+    return (const uint8_t*) (QSPI_XIP_START_ADDR + address);
+}
+
 void spi_flash_init(void) {
     // Init QSPI flash
     nrfx_qspi_config_t qspi_cfg = {
@@ -45,6 +45,10 @@ void init_usb_hardware(void) {
     // 2 is max priority (0, 1 are reserved for SD)
     NVIC_SetPriority(USBD_IRQn, 2);
 
+    #if CIRCUITPY_USB_IRQ_TASK
+    NVIC_SetPriority(PendSV_IRQn, (1 << __NVIC_PRIO_BITS) - 1);
+    #endif
+
     // USB power may already be ready at this time -> no event generated
     // We need to invoke the handler based on the status initially for the first call
     static bool first_call = true;
@@ -87,3 +91,14 @@ void init_usb_hardware(void) {
         }
     }
 }
+
+#if CIRCUITPY_USB_IRQ_TASK
+// TinyUSB's task runs in PendSV, below every other interrupt.
+void usb_irq_task_trigger(void) {
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+}
+
+void PendSV_Handler(void) {
+    usb_irq_task();
+}
+#endif
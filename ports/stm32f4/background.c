@@ -25,8 +25,7 @@
  */
 
 #include "py/runtime.h"
-#include "supervisor/filesystem.h"
-#include "supervisor/usb.h"
+#include "supervisor/shared/background_task.h"
 #include "supervisor/shared/stack.h"
 
 #if CIRCUITPY_DISPLAYIO
@@ -35,8 +34,17 @@
 
 static bool running_background_tasks = false;
 
+#if CIRCUITPY_DISPLAYIO
+static background_task_t displayio_task;
+#endif
+
 void background_tasks_reset(void) {
     running_background_tasks = false;
+
+    // The filesystem and USB register their own tasks.
+    #if CIRCUITPY_DISPLAYIO
+    background_task_add(&displayio_task, displayio_background, BACKGROUND_TASK_PRIORITY_DISPLAY, 1);
+    #endif
 }
 
 void run_background_tasks(void) {
@@ -45,15 +53,7 @@ void run_background_tasks(void) {
         return;
     }
     running_background_tasks = true;
-    filesystem_background();
-
-    #if USB_AVAILABLE
-    usb_background();
-    #endif
-
-    #if CIRCUITPY_DISPLAYIO
-    displayio_background();
-    #endif
+    background_tasks_run();
     running_background_tasks = false;
 
     assert_heap_ok();
@@ -54,6 +54,23 @@ void i2c_reset(void) {
     #endif
 }
 
+uint8_t common_hal_busio_i2c_write_read(busio_i2c_obj_t *self, uint16_t addr,
+        const uint8_t *out_data, size_t out_len, uint8_t *in_data, size_t in_len) {
+    // The HAL's memory read sends a one or two byte register address and reads
+    // after a repeated start.
+    if (out_len == 1 || out_len == 2) {
+        uint16_t mem_address = out_len == 1 ? out_data[0] : (out_data[0] << 8) | out_data[1];
+        return HAL_I2C_Mem_Read(&(self->handle), (uint16_t)(addr<<1), mem_address,
+            out_len == 1 ? I2C_MEMADD_SIZE_8BIT : I2C_MEMADD_SIZE_16BIT,
+            in_data, (uint16_t)in_len, 500) == HAL_OK ? 0 : MP_EIO;
+    }
+    uint8_t status = common_hal_busio_i2c_write(self, addr, out_data, out_len, false);
+    if (status != 0) {
+        return status;
+    }
+    return common_hal_busio_i2c_read(self, addr, in_data, in_len);
+}
+
 void common_hal_busio_i2c_never_reset(busio_i2c_obj_t *self) {
     for (size_t i = 0 ; i < MP_ARRAY_SIZE(mcu_i2c_banks); i++) {
         if (self->handle.Instance == mcu_i2c_banks[i]) {
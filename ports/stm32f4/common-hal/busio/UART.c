@@ -203,6 +203,7 @@ void common_hal_busio_uart_construct(busio_uart_obj_t* self,
     // Init buffer for rx and claim pins
     if (self->rx != NULL) {
         ringbuf_alloc(&self->rbuf, receiver_buffer_size, true);
+        self->rx_overruns = 0;
         if (!self->rbuf.buf) {
             mp_raise_ValueError(translate("UART Buffer allocation error"));
         }
@@ -268,11 +269,7 @@ size_t common_hal_busio_uart_read(busio_uart_obj_t *self, uint8_t *data, size_t
     // Halt reception
     HAL_NVIC_DisableIRQ(self->irq);
     // copy received data
-    rx_bytes = ringbuf_count(&self->rbuf);
-    rx_bytes = MIN(rx_bytes, len);
-    for (uint16_t i = 0; i < rx_bytes; i++) {
-        data[i] = ringbuf_get(&self->rbuf);
-    }
+    rx_bytes = ringbuf_get_n(&self->rbuf, data, MIN(len, self->rbuf.size));
     HAL_NVIC_EnableIRQ(self->irq);
 
     if (rx_bytes == 0) {
@@ -312,7 +309,9 @@ void HAL_UART_RxCpltCallback(UART_HandleTypeDef *handle)
             if ((HAL_UART_GetState(handle) & HAL_UART_STATE_BUSY_RX) == HAL_UART_STATE_BUSY_RX) {
                 return;
             }
-            ringbuf_put_n(&context->rbuf, &context->rx_char, 1);
+            if (ringbuf_put_n(&context->rbuf, &context->rx_char, 1) > 0) {
+                context->rx_overruns++;
+            }
             errflag = HAL_UART_Receive_IT(handle, &context->rx_char, 1);
 
             return;
@@ -597,3 +596,7 @@ STATIC void uart_assign_irq(busio_uart_obj_t *self, USART_TypeDef * USARTx) {
     if (USARTx == UART10) self->irq = UART10_IRQn;
     #endif
 }
+
+uint32_t common_hal_busio_uart_get_rx_overruns(busio_uart_obj_t *self) {
+    return self->rx_overruns;
+}
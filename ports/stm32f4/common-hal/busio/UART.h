@@ -50,6 +50,7 @@ typedef struct {
 
     ringbuf_t rbuf;
     uint8_t rx_char;
+    uint32_t rx_overruns;
 
     uint32_t baudrate;
     uint32_t timeout_ms;
@@ -37,6 +37,9 @@
 // 24kiB stack
 #define CIRCUITPY_DEFAULT_STACK_SIZE            0x6000
 
+// CCM RAM on chips that have it. Otherwise ordinary .bss.
+#define PLACE_IN_DTCM_BSS(name) name __attribute__((section(".dtcm_bss." #name)))
+
 #include "py/circuitpy_mpconfig.h"
 
 #define MAX_UART 10 //how many UART are implemented
@@ -75,3 +75,13 @@ endif
 
 #ifeq ($(MCU_SUB_VARIANT), stm32f412zx)
 #endif
+
+# TinyUSB's task runs in PendSV. See supervisor/usb.c.
+ifndef CIRCUITPY_USB_IRQ_TASK
+CIRCUITPY_USB_IRQ_TASK = 1
+endif
+
+# Cycles are counted with the DWT. See supervisor/port.c.
+ifndef CIRCUITPY_CYCLE_COUNTER
+CIRCUITPY_CYCLE_COUNTER = 1
+endif
@@ -41,7 +41,17 @@
 
 #include "stm32f4xx_hal.h"
 
+#ifdef STM32F405xx
+extern uint32_t _ld_ccmram_bss_start, _ld_ccmram_bss_end;
+#endif
+
 safe_mode_t port_init(void) {
+    #ifdef STM32F405xx
+    for (uint32_t *p = &_ld_ccmram_bss_start; p < &_ld_ccmram_bss_end; p++) {
+        *p = 0;
+    }
+    #endif
+
     HAL_Init();
     __HAL_RCC_SYSCFG_CLK_ENABLE();
     __HAL_RCC_PWR_CLK_ENABLE();
@@ -50,6 +60,12 @@ safe_mode_t port_init(void) {
     stm32f4_peripherals_gpio_init();
 
     tick_init();
+
+    #if CIRCUITPY_CYCLE_COUNTER
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    #endif
+
     board_init(); 
 
     return NO_SAFE_MODE;
@@ -71,9 +87,29 @@ void reset_cpu(void) {
     NVIC_SystemReset();
 }
 
+#ifdef STM32F405xx
+// The stack has CCM RAM to itself, and the heap has RAM.
+extern uint32_t _ld_stack_bottom, _ld_heap_start, _ram_end;
+uint32_t *port_stack_get_limit(void) {
+    return &_ld_stack_bottom;
+}
+
+bool port_has_fixed_stack(void) {
+    return true;
+}
+
+uint32_t *port_heap_get_bottom(void) {
+    return &_ld_heap_start;
+}
+
+uint32_t *port_heap_get_top(void) {
+    return &_ram_end;
+}
+#else
 uint32_t *port_stack_get_limit(void) {
     return &_ebss;
 }
+#endif
 
 uint32_t *port_stack_get_top(void) {
     return &_estack;
@@ -89,6 +125,12 @@ uint32_t port_get_saved_word(void) {
     return _ebss;
 }
 
+#if CIRCUITPY_CYCLE_COUNTER
+uint32_t port_get_cycle_count(void) {
+    return DWT->CYCCNT;
+}
+#endif
+
 void HardFault_Handler(void) {
     reset_into_safe_mode(HARD_CRASH);
     while (true) {
@@ -95,6 +95,10 @@ bool spi_flash_read_data(uint32_t address, uint8_t* data, uint32_t length) {
     return false;
 }
 
+const uint8_t* spi_flash_get_mapped_address(uint32_t address) {
+    return NULL;
+}
+
 void spi_flash_init(void) {
     // Init QSPI flash
 //     nrfx_qspi_config_t qspi_cfg = {
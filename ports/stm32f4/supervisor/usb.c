@@ -109,4 +109,19 @@ void init_usb_hardware(void) {
     __HAL_RCC_USB_OTG_FS_CLK_ENABLE();
 
     init_usb_vbus_sense();
+
+    #if CIRCUITPY_USB_IRQ_TASK
+    NVIC_SetPriority(PendSV_IRQn, (1 << __NVIC_PRIO_BITS) - 1);
+    #endif
+}
+
+#if CIRCUITPY_USB_IRQ_TASK
+// TinyUSB's task runs in PendSV, below every other interrupt.
+void usb_irq_task_trigger(void) {
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
 }
+
+void PendSV_Handler(void) {
+    usb_irq_task();
+}
+#endif
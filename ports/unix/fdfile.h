@@ -32,6 +32,13 @@
 typedef struct _mp_obj_fdfile_t {
     mp_obj_base_t base;
     int fd;
+    #ifndef _WIN32
+    // set for files opened with 'm', which are read from a read-only mapping
+    bool mapped;
+    const byte *map;
+    size_t map_len;
+    size_t map_pos;
+    #endif
 } mp_obj_fdfile_t;
 
 extern const mp_obj_type_t mp_type_fileio;
@@ -25,11 +25,16 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#ifndef _WIN32
+#include <sys/uio.h>
+#include <sys/mman.h>
+#endif
 
 #include "py/runtime.h"
 #include "py/stream.h"
@@ -66,6 +71,18 @@ STATIC void fdfile_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kin
 STATIC mp_uint_t fdfile_read(mp_obj_t o_in, void *buf, mp_uint_t size, int *errcode) {
     mp_obj_fdfile_t *o = MP_OBJ_TO_PTR(o_in);
     check_fd_is_open(o);
+    #ifndef _WIN32
+    if (o->mapped) {
+        // copied straight from the page cache, without a system call
+        size_t left = o->map_pos < o->map_len ? o->map_len - o->map_pos : 0;
+        if (size > left) {
+            size = left;
+        }
+        memcpy(buf, o->map + o->map_pos, size);
+        o->map_pos += size;
+        return size;
+    }
+    #endif
     mp_int_t r = read(o->fd, buf, size);
     if (r == -1) {
         *errcode = errno;
@@ -77,6 +94,12 @@ STATIC mp_uint_t fdfile_read(mp_obj_t o_in, void *buf, mp_uint_t size, int *errc
 STATIC mp_uint_t fdfile_write(mp_obj_t o_in, const void *buf, mp_uint_t size, int *errcode) {
     mp_obj_fdfile_t *o = MP_OBJ_TO_PTR(o_in);
     check_fd_is_open(o);
+    #ifndef _WIN32
+    if (o->mapped) {
+        *errcode = EBADF;
+        return MP_STREAM_ERROR;
+    }
+    #endif
     #if MICROPY_PY_OS_DUPTERM
     if (o->fd <= STDERR_FILENO) {
         mp_hal_stdout_tx_strn(buf, size);
@@ -99,12 +122,81 @@ STATIC mp_uint_t fdfile_write(mp_obj_t o_in, const void *buf, mp_uint_t size, in
     return r;
 }
 
+#ifndef _WIN32
+STATIC mp_uint_t fdfile_writev(mp_obj_fdfile_t *o, const struct mp_stream_writev_t *arg, int *errcode) {
+    #if MICROPY_PY_OS_DUPTERM
+    if (o->fd <= STDERR_FILENO) {
+        // let mp_stream_writev write each buffer through fdfile_write
+        *errcode = EINVAL;
+        return MP_STREAM_ERROR;
+    }
+    #endif
+    struct iovec iov[8];
+    mp_uint_t done = 0;
+    size_t i = 0;
+    size_t skip = 0; // bytes of arg->iov[i] already written
+    while (i < arg->iovcnt) {
+        int n = 0;
+        size_t size = 0;
+        for (size_t j = i; j < arg->iovcnt && n < (int)MP_ARRAY_SIZE(iov); j++, n++) {
+            size_t off = j == i ? skip : 0;
+            iov[n].iov_base = (byte*)arg->iov[j].buf + off;
+            iov[n].iov_len = arg->iov[j].len - off;
+            size += iov[n].iov_len;
+        }
+        ssize_t r = writev(o->fd, iov, n);
+        if (r == -1 && errno == EINTR) {
+            if (MP_STATE_VM(mp_pending_exception) != MP_OBJ_NULL) {
+                mp_obj_t obj = MP_STATE_VM(mp_pending_exception);
+                MP_STATE_VM(mp_pending_exception) = MP_OBJ_NULL;
+                nlr_raise(obj);
+            }
+            continue;
+        }
+        if (r == -1) {
+            *errcode = errno;
+            return MP_STREAM_ERROR;
+        }
+        if (r == 0 && size != 0) {
+            // no progress, as for write in mp_stream_rw
+            break;
+        }
+        done += r;
+        // step past what was written, which may end part way through a buffer
+        while (i < arg->iovcnt && (size_t)r >= arg->iov[i].len - skip) {
+            r -= arg->iov[i].len - skip;
+            skip = 0;
+            i++;
+        }
+        skip += r;
+    }
+    return done;
+}
+#endif
+
 STATIC mp_uint_t fdfile_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg, int *errcode) {
     mp_obj_fdfile_t *o = MP_OBJ_TO_PTR(o_in);
     check_fd_is_open(o);
     switch (request) {
         case MP_STREAM_SEEK: {
             struct mp_stream_seek_t *s = (struct mp_stream_seek_t*)arg;
+            #ifndef _WIN32
+            if (o->mapped) {
+                mp_off_t off = s->offset;
+                if (s->whence == SEEK_CUR) {
+                    off += o->map_pos;
+                } else if (s->whence == SEEK_END) {
+                    off += o->map_len;
+                }
+                if (off < 0) {
+                    *errcode = EINVAL;
+                    return MP_STREAM_ERROR;
+                }
+                o->map_pos = off;
+                s->offset = off;
+                return 0;
+            }
+            #endif
             off_t off = lseek(o->fd, s->offset, s->whence);
             if (off == (off_t)-1) {
                 *errcode = errno;
@@ -113,6 +205,10 @@ STATIC mp_uint_t fdfile_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg, i
             s->offset = off;
             return 0;
         }
+        #ifndef _WIN32
+        case MP_STREAM_WRITEV:
+            return fdfile_writev(o, (const struct mp_stream_writev_t*)arg, errcode);
+        #endif
         case MP_STREAM_FLUSH:
             if (fsync(o->fd) < 0) {
                 *errcode = errno;
@@ -120,6 +216,12 @@ STATIC mp_uint_t fdfile_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg, i
             }
             return 0;
         case MP_STREAM_CLOSE:
+            #ifndef _WIN32
+            if (o->mapped && o->map_len > 0) {
+                munmap((void*)o->map, o->map_len);
+            }
+            o->mapped = false;
+            #endif
             close(o->fd);
             #ifdef MICROPY_CPYTHON_COMPAT
             o->fd = -1;
@@ -154,11 +256,50 @@ STATIC const mp_arg_t file_open_args[] = {
 };
 #define FILE_OPEN_NUM_ARGS MP_ARRAY_SIZE(file_open_args)
 
+#ifndef _WIN32
+// Maps the whole of a file opened read-only. Reads are then copies out of the
+// mapping and a binary file gives the mapping itself as a read-only buffer.
+STATIC void fdfile_map(mp_obj_fdfile_t *o) {
+    struct stat st;
+    if (fstat(o->fd, &st) == -1) {
+        int err = errno;
+        close(o->fd);
+        mp_raise_OSError(err);
+    }
+    o->map = NULL;
+    o->map_len = st.st_size;
+    o->map_pos = 0;
+    if (o->map_len > 0) {
+        void *map = mmap(NULL, o->map_len, PROT_READ, MAP_PRIVATE, o->fd, 0);
+        if (map == MAP_FAILED) {
+            int err = errno;
+            close(o->fd);
+            mp_raise_OSError(err);
+        }
+        o->map = map;
+    }
+    o->mapped = true;
+}
+
+// Valid until the file is closed: a memoryview of it mustn't be used after.
+STATIC mp_int_t fdfile_get_buffer(mp_obj_t self_in, mp_buffer_info_t *bufinfo, mp_uint_t flags) {
+    mp_obj_fdfile_t *self = MP_OBJ_TO_PTR(self_in);
+    if (!self->mapped || (flags & MP_BUFFER_WRITE)) {
+        return 1;
+    }
+    bufinfo->buf = (void*)self->map;
+    bufinfo->len = self->map_len;
+    bufinfo->typecode = 'B';
+    return 0;
+}
+#endif
+
 STATIC mp_obj_t fdfile_open(const mp_obj_type_t *type, mp_arg_val_t *args) {
     mp_obj_fdfile_t *o = m_new_obj(mp_obj_fdfile_t);
     const char *mode_s = mp_obj_str_get_str(args[1].u_obj);
 
     int mode_rw = 0, mode_x = 0;
+    bool mode_m = false;
     while (*mode_s) {
         switch (*mode_s++) {
             case 'r':
@@ -175,6 +316,9 @@ STATIC mp_obj_t fdfile_open(const mp_obj_type_t *type, mp_arg_val_t *args) {
             case '+':
                 mode_rw = O_RDWR;
                 break;
+            case 'm':
+                mode_m = true;
+                break;
             #if MICROPY_PY_IO_FILEIO
             // If we don't have io.FileIO, then files are in text mode implicitly
             case 'b':
@@ -196,12 +340,25 @@ STATIC mp_obj_t fdfile_open(const mp_obj_type_t *type, mp_arg_val_t *args) {
         return MP_OBJ_FROM_PTR(o);
     }
 
+    #ifndef _WIN32
+    if (mode_m && mode_rw != O_RDONLY) {
+        mp_raise_ValueError(translate("mapped files are read only"));
+    }
+    #else
+    (void)mode_m;
+    #endif
+
     const char *fname = mp_obj_str_get_str(fid);
     int fd = open(fname, mode_x | mode_rw, 0644);
     if (fd == -1) {
         mp_raise_OSError(errno);
     }
     o->fd = fd;
+    #ifndef _WIN32
+    if (mode_m) {
+        fdfile_map(o);
+    }
+    #endif
     return MP_OBJ_FROM_PTR(o);
 }
 
@@ -218,6 +375,7 @@ STATIC const mp_rom_map_elem_t rawfile_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_readline), MP_ROM_PTR(&mp_stream_unbuffered_readline_obj) },
     { MP_ROM_QSTR(MP_QSTR_readlines), MP_ROM_PTR(&mp_stream_unbuffered_readlines_obj) },
     { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&mp_stream_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_writev), MP_ROM_PTR(&mp_stream_writev_obj) },
     { MP_ROM_QSTR(MP_QSTR_seek), MP_ROM_PTR(&mp_stream_seek_obj) },
     { MP_ROM_QSTR(MP_QSTR_tell), MP_ROM_PTR(&mp_stream_tell_obj) },
     { MP_ROM_QSTR(MP_QSTR_flush), MP_ROM_PTR(&mp_stream_flush_obj) },
@@ -234,6 +392,9 @@ STATIC const mp_stream_p_t fileio_stream_p = {
     .read = fdfile_read,
     .write = fdfile_write,
     .ioctl = fdfile_ioctl,
+    #ifndef _WIN32
+    .has_writev = true,
+    #endif
 };
 
 const mp_obj_type_t mp_type_fileio = {
@@ -243,6 +404,9 @@ const mp_obj_type_t mp_type_fileio = {
     .make_new = fdfile_make_new,
     .getiter = mp_identity_getiter,
     .iternext = mp_stream_unbuffered_iter,
+    #ifndef _WIN32
+    .buffer_p = { .get_buffer = fdfile_get_buffer },
+    #endif
     .protocol = &fileio_stream_p,
     .locals_dict = (mp_obj_dict_t*)&rawfile_locals_dict,
 };
@@ -254,6 +418,9 @@ STATIC const mp_stream_p_t textio_stream_p = {
     .write = fdfile_write,
     .ioctl = fdfile_ioctl,
     .is_text = true,
+    #ifndef _WIN32
+    .has_writev = true,
+    #endif
 };
 
 const mp_obj_type_t mp_type_textio = {
@@ -36,11 +36,14 @@
 #include <sys/types.h>
 #include <errno.h>
 #include <signal.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 
 #include "py/compile.h"
 #include "py/frozenmod.h"
 #include "py/runtime.h"
 #include "py/builtin.h"
+#include "py/persistentcode.h"
 #include "py/repl.h"
 #include "py/gc.h"
 #include "py/stackctrl.h"
@@ -685,6 +688,28 @@ uint mp_import_stat(const char *path) {
 }
 #endif
 
+#if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+// The mapping is never released because functions loaded from it keep
+// pointing into it for the life of the process.
+const byte *mp_persistent_code_map_file(const char *filename, size_t *len) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat st;
+    void *buf = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        buf = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (buf == MAP_FAILED) {
+        return NULL;
+    }
+    *len = st.st_size;
+    return buf;
+}
+#endif
+
 void nlr_jump_fail(void *val) {
     printf("FATAL: uncaught NLR %p\n", val);
     exit(1);
@@ -43,7 +43,10 @@
 #if !defined(MICROPY_EMIT_ARM) && defined(__arm__) && !defined(__thumb2__)
     #define MICROPY_EMIT_ARM        (1)
 #endif
+#define MICROPY_EMIT_NATIVE_FLOAT   (1)
 #define MICROPY_COMP_MODULE_CONST   (1)
+#define MICROPY_COMP_CONST_FLOAT    (1)
+#define MICROPY_COMP_CONST_TUPLE    (1)
 #define MICROPY_COMP_TRIPLE_TUPLE_ASSIGN (1)
 #define MICROPY_COMP_RETURN_IF_EXPR (1)
 #define MICROPY_ENABLE_GC           (1)
@@ -56,6 +59,7 @@
 // check stdout a chance to pass, etc.
 #define MICROPY_DEBUG_PRINTER_DEST  mp_stderr_print
 #define MICROPY_READER_POSIX        (1)
+#define MICROPY_READER_POSIX_MMAP   (1)
 #define MICROPY_USE_READLINE_HISTORY (1)
 #define MICROPY_HELPER_REPL         (1)
 #define MICROPY_REPL_EMACS_KEYS     (1)
@@ -63,21 +67,45 @@
 #define MICROPY_HELPER_LEXER_UNIX   (1)
 #define MICROPY_ENABLE_SOURCE_LINE  (1)
 #define MICROPY_FLOAT_IMPL          (MICROPY_FLOAT_IMPL_DOUBLE)
+#define MICROPY_FLOAT_FORMAT_SHORTEST (1)
+#define MICROPY_FLOAT_FORMAT_SHORTEST_FULL_TABLES (1)
 #define MICROPY_LONGINT_IMPL        (MICROPY_LONGINT_IMPL_MPZ)
 #define MICROPY_STREAMS_NON_BLOCK   (1)
 #define MICROPY_STREAMS_POSIX_API   (1)
 #define MICROPY_OPT_COMPUTED_GOTO   (1)
+#define MICROPY_OPT_MAP_LOOKUP_CACHE (1)
+#define MICROPY_MAP_COMPACT_MAX     (8)
+#define MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS (1)
+#define MICROPY_OPT_VM_SMALL_INT_FAST_PATH (1)
+#define MICROPY_OPT_MPZ_FAST_MUL    (1)
+#define MICROPY_OPT_ATTR_LOOKUP_CACHE (1)
+#define MICROPY_OPT_STR_INDEX_CACHE (1)
+#define MICROPY_GC_FREE_RUN_INDEX   (1)
+#define MICROPY_GC_SMALL_FREE_LISTS (1)
+#define MICROPY_GC_LAZY_SWEEP       (1)
+#if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
+#define MICROPY_GC_THREAD_CACHE     (16)
+#endif
+// Translated messages are decoded with a lookup table, and cached unless threads run without the
+// GIL.
+#define CIRCUITPY_TRANSLATE_DECODE_TABLE (1)
+#if !(MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL)
+#define CIRCUITPY_TRANSLATE_CACHE_ENTRIES (4)
+#endif
+#define MICROPY_GC_LONG_LIVED_PROMOTE_AFTER (4)
 #ifndef MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE (1)
 #endif
 #define MICROPY_CAN_OVERRIDE_BUILTINS (1)
 #define MICROPY_PY_FUNCTION_ATTRS   (1)
 #define MICROPY_PY_DESCRIPTORS      (1)
+#define MICROPY_PY_SLOTS            (1)
 #define MICROPY_PY_BUILTINS_STR_UNICODE (1)
 #define MICROPY_PY_BUILTINS_STR_CENTER (1)
 #define MICROPY_PY_BUILTINS_STR_PARTITION (1)
 #define MICROPY_PY_BUILTINS_STR_SPLITLINES (1)
 #define MICROPY_PY_BUILTINS_MEMORYVIEW (1)
+#define MICROPY_PY_BUILTINS_MEMORYVIEW_CAST (1)
 #define MICROPY_PY_BUILTINS_FROZENSET (1)
 #define MICROPY_PY_BUILTINS_COMPILE (1)
 #define MICROPY_PY_BUILTINS_NOTIMPLEMENTED (1)
@@ -88,6 +116,7 @@
 #define MICROPY_PY_ALL_SPECIAL_METHODS (1)
 #define MICROPY_PY_REVERSE_SPECIAL_METHODS (1)
 #define MICROPY_PY_ARRAY_SLICE_ASSIGN (1)
+#define MICROPY_PY_ARRAY_VECTOR (1)
 #define MICROPY_PY_BUILTINS_SLICE_ATTRS (1)
 #define MICROPY_PY_SYS_EXIT         (1)
 #if defined(__APPLE__) && defined(__MACH__)
@@ -106,8 +135,10 @@
 #define MICROPY_PY_CMATH            (1)
 #define MICROPY_PY_IO_IOBASE        (1)
 #define MICROPY_PY_IO_FILEIO        (1)
+#define MICROPY_PY_IO_BUFFEREDREADER (1)
 #define MICROPY_PY_GC_COLLECT_RETVAL (1)
 #define MICROPY_MODULE_FROZEN_STR   (1)
+#define MICROPY_MODULE_FROZEN_ROM_FUN (MICROPY_MODULE_FROZEN_MPY)
 
 #ifndef MICROPY_STACKLESS
 #define MICROPY_STACKLESS           (0)
@@ -122,14 +153,18 @@
 #define MICROPY_PY_UZLIB            (1)
 #define MICROPY_PY_UJSON            (1)
 #define MICROPY_PY_URE              (1)
+#define MICROPY_PY_URE_CACHE_SIZE   (8)
 #define MICROPY_PY_UHEAPQ           (1)
 #define MICROPY_PY_UTIMEQ           (1)
+#define MICROPY_PY_UASYNCIO         (1)
 #define MICROPY_PY_UHASHLIB         (1)
 #if MICROPY_PY_USSL
 #define MICROPY_PY_UHASHLIB_SHA1    (1)
 #endif
 #define MICROPY_PY_UBINASCII        (1)
 #define MICROPY_PY_UBINASCII_CRC32  (1)
+#define MICROPY_PY_UBINASCII_CRC32_TABLE (1)
+#define MICROPY_PY_UBINASCII_INTO   (1)
 #define MICROPY_PY_URANDOM          (1)
 #ifndef MICROPY_PY_USELECT_POSIX
 #define MICROPY_PY_USELECT_POSIX    (1)
@@ -144,6 +179,7 @@
 #define MICROPY_FATFS_RPATH            (2)
 #define MICROPY_FATFS_MAX_SS           (4096)
 #define MICROPY_FATFS_LFN_CODE_PAGE    (437) /* 1=SFN/ANSI 437=LFN/U.S.(OEM) */
+#define MICROPY_FATFS_WINCACHE         (4)
 #define MICROPY_VFS_FAT                (0)
 
 // Define to MICROPY_ERROR_REPORTING_DETAILED to get function, etc.
@@ -167,6 +203,7 @@ extern const struct _mp_print_t mp_stderr_print;
 
 #define MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF   (1)
 #define MICROPY_EMERGENCY_EXCEPTION_BUF_SIZE  (256)
+#define MICROPY_EXCEPTION_POOL_SIZE (4)
 #define MICROPY_KBD_EXCEPTION       (1)
 #define MICROPY_ASYNC_KBD_INTR      (1)
 
@@ -215,6 +252,32 @@ extern const struct _mp_obj_module_t mp_module_jni;
 #else
 #define MICROPY_PY_USELECT_DEF
 #endif
+// displayio draws into a FramebufferBus so compositing can be profiled and tested on the host.
+// Displays only refresh when asked to because there are no background tasks.
+#if CIRCUITPY_DISPLAYIO
+extern const struct _mp_obj_module_t displayio_module;
+#define CIRCUITPY_DISPLAYIO_DEF { MP_ROM_QSTR(MP_QSTR_displayio), MP_ROM_PTR(&displayio_module) },
+#define CIRCUITPY_DISPLAY_LIMIT (1)
+#define CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE (128)
+#define CIRCUITPY_DISPLAY_REFRESH_BUDGET_US (0)
+#define CIRCUITPY_DISPLAYIO_HARDWARE (0)
+#define CIRCUITPY_DISPLAYIO_FRAMEBUFFERBUS (1)
+#define RUN_BACKGROUND_TASKS ((void) 0)
+#else
+#define CIRCUITPY_DISPLAYIO_DEF
+#endif
+#if CIRCUITPY_FIXEDPOINT
+extern const struct _mp_obj_module_t fixedpoint_module;
+#define CIRCUITPY_FIXEDPOINT_DEF { MP_ROM_QSTR(MP_QSTR_fixedpoint), MP_ROM_PTR(&fixedpoint_module) },
+#else
+#define CIRCUITPY_FIXEDPOINT_DEF
+#endif
+#if CIRCUITPY_RANDOM
+extern const struct _mp_obj_module_t random_module;
+#define CIRCUITPY_RANDOM_DEF { MP_ROM_QSTR(MP_QSTR_random), MP_ROM_PTR(&random_module) },
+#else
+#define CIRCUITPY_RANDOM_DEF
+#endif
 
 #define MICROPY_PORT_BUILTIN_MODULES \
     MICROPY_PY_FFI_DEF \
@@ -225,6 +288,9 @@ extern const struct _mp_obj_module_t mp_module_jni;
     MICROPY_PY_UOS_DEF \
     MICROPY_PY_USELECT_DEF \
     MICROPY_PY_TERMIOS_DEF \
+    CIRCUITPY_DISPLAYIO_DEF \
+    CIRCUITPY_FIXEDPOINT_DEF \
+    CIRCUITPY_RANDOM_DEF \
 
 // type definitions for the specific machine
 
@@ -295,6 +361,14 @@ void mp_unix_mark_exec(void);
     const char *readline_hist[50]; \
     void *mmap_region_head; \
 
+// Sleep a little between checks for events, rather than spinning
+#define MICROPY_EVENT_POLL_HOOK \
+    do { \
+        extern void mp_handle_pending(void); \
+        mp_handle_pending(); \
+        usleep(500); \
+    } while (0);
+
 // We need to provide a declaration/definition of alloca()
 // unless support for it is disabled.
 #if !defined(MICROPY_NO_ALLOCA) || MICROPY_NO_ALLOCA == 0
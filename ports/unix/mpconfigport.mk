@@ -34,6 +34,15 @@ MICROPY_SSL_AXTLS = 1
 # outside of MicroPython, it can just link with mbedTLS library.
 MICROPY_SSL_MBEDTLS = 0
 
+# displayio drawing into memory through displayio.FramebufferBus
+CIRCUITPY_DISPLAYIO = 1
+
+# CircuitPython's Q15 and Q31 fixedpoint arithmetic
+CIRCUITPY_FIXEDPOINT = 1
+
+# CircuitPython's xoshiro128** random, seeded from /dev/urandom
+CIRCUITPY_RANDOM = 1
+
 # jni module requires JVM/JNI
 MICROPY_PY_JNI = 0
 
@@ -34,6 +34,8 @@
 
 #define MICROPY_FLOAT_HIGH_QUALITY_HASH (1)
 #define MICROPY_ENABLE_SCHEDULER       (1)
+#define MICROPY_SCHEDULER_PRIORITIES   (2)
+#define MICROPY_SCHEDULER_STATS        (1)
 #define MICROPY_READER_VFS             (1)
 #define MICROPY_PY_DELATTR_SETATTR     (1)
 #define MICROPY_PY_REVERSE_SPECIAL_METHODS (1)
@@ -47,6 +49,8 @@
 #define MICROPY_VFS_POSIX              (1)
 #undef MICROPY_VFS_FAT
 #define MICROPY_VFS_FAT                (1)
+#define MICROPY_VFS_FAT_IMPORT_STAT_CACHE (1)
+#define MICROPY_VFS_ROM                (1)
 #define MICROPY_FATFS_USE_LABEL        (1)
 #define MICROPY_PY_FRAMEBUF            (1)
 #define MICROPY_PY_COLLECTIONS_NAMEDTUPLE__ASDICT (1)
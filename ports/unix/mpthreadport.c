@@ -201,6 +201,21 @@ void mp_thread_finish(void) {
     pthread_mutex_unlock(&thread_mutex);
 }
 
+bool mp_thread_is_only_thread(void) {
+    pthread_mutex_lock(&thread_mutex);
+    // Finished threads aren't unlinked, and can't be told apart from ones
+    // that haven't started yet, so any other entry counts.
+    bool only = true;
+    for (thread_t *th = thread; th != NULL; th = th->next) {
+        if (th->id != pthread_self()) {
+            only = false;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&thread_mutex);
+    return only;
+}
+
 void mp_thread_mutex_init(mp_thread_mutex_t *mutex) {
     pthread_mutex_init(mutex, NULL);
 }
@@ -25,8 +25,11 @@
  */
 
 #include <pthread.h>
+#include <stdbool.h>
 
 typedef pthread_mutex_t mp_thread_mutex_t;
 
 void mp_thread_init(void);
 void mp_thread_gc_others(void);
+// Whether no thread but the calling one has been started.
+bool mp_thread_is_only_thread(void);
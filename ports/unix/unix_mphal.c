@@ -197,3 +197,16 @@ mp_uint_t mp_hal_ticks_us(void) {
     gettimeofday(&tv, NULL);
     return tv.tv_sec * 1000000 + tv.tv_usec;
 }
+
+#if CIRCUITPY_DISPLAYIO
+#include "shared-bindings/time/__init__.h"
+
+// Stops displayio from refreshing once Ctrl-C is pending.
+bool mp_hal_is_interrupted(void) {
+    return MP_STATE_VM(mp_pending_exception) != MP_OBJ_NULL;
+}
+
+void common_hal_time_delay_ms(uint32_t delay) {
+    mp_hal_delay_ms(delay);
+}
+#endif
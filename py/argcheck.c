@@ -87,8 +87,30 @@ void mp_arg_check_num_kw_array(size_t n_args, size_t n_kw, size_t n_args_min, si
 
 void mp_arg_parse_all(size_t n_pos, const mp_obj_t *pos, mp_map_t *kws, size_t n_allowed, const mp_arg_t *allowed, mp_arg_val_t *out_vals) {
     size_t pos_found = 0, kws_found = 0;
+    size_t n_kw = kws->used;
+
+    // Place the keywords with one pass of qstr compares rather than a map lookup per allowed
+    // argument. Bit i of kws_given is set when out_vals[i].u_obj holds a keyword's value.
+    uint32_t kws_given = 0;
+    bool kws_placed = n_kw > 0 && kws->all_keys_are_qstrs && n_allowed <= 32;
+    if (kws_placed) {
+        for (size_t k = 0; k < kws->alloc; k++) {
+            if (!MP_MAP_SLOT_IS_FILLED(kws, k)) {
+                continue;
+            }
+            qstr key = MP_OBJ_QSTR_VALUE(kws->table[k].key);
+            for (size_t i = n_pos; i < n_allowed; i++) {
+                if (allowed[i].qst == key) {
+                    kws_given |= (uint32_t)1 << i;
+                    out_vals[i].u_obj = kws->table[k].value;
+                    break;
+                }
+            }
+        }
+    }
+
     for (size_t i = 0; i < n_allowed; i++) {
-        mp_obj_t given_arg;
+        mp_obj_t given_arg = MP_OBJ_NULL;
         if (i < n_pos) {
             if (allowed[i].flags & MP_ARG_KW_ONLY) {
                 goto extra_positional;
@@ -96,8 +118,19 @@ void mp_arg_parse_all(size_t n_pos, const mp_obj_t *pos, mp_map_t *kws, size_t n
             pos_found++;
             given_arg = pos[i];
         } else {
-            mp_map_elem_t *kw = mp_map_lookup(kws, MP_OBJ_NEW_QSTR(allowed[i].qst), MP_MAP_LOOKUP);
-            if (kw == NULL) {
+            if (kws_found == n_kw) {
+                // every keyword has been used, so the rest take their defaults
+            } else if (kws_placed) {
+                if (kws_given & ((uint32_t)1 << i)) {
+                    given_arg = out_vals[i].u_obj;
+                }
+            } else {
+                mp_map_elem_t *kw = mp_map_lookup(kws, MP_OBJ_NEW_QSTR(allowed[i].qst), MP_MAP_LOOKUP);
+                if (kw != NULL) {
+                    given_arg = kw->value;
+                }
+            }
+            if (given_arg == MP_OBJ_NULL) {
                 if (allowed[i].flags & MP_ARG_REQUIRED) {
                     if (MICROPY_ERROR_REPORTING == MICROPY_ERROR_REPORTING_TERSE) {
                         mp_arg_error_terse_mismatch();
@@ -108,10 +141,8 @@ void mp_arg_parse_all(size_t n_pos, const mp_obj_t *pos, mp_map_t *kws, size_t n
                 }
                 out_vals[i] = allowed[i].defval;
                 continue;
-            } else {
-                kws_found++;
-                given_arg = kw->value;
             }
+            kws_found++;
         }
         if ((allowed[i].flags & MP_ARG_KIND_MASK) == MP_ARG_BOOL) {
             out_vals[i].u_bool = mp_obj_is_true(given_arg);
@@ -131,7 +162,7 @@ void mp_arg_parse_all(size_t n_pos, const mp_obj_t *pos, mp_map_t *kws, size_t n
             mp_raise_TypeError(translate("extra positional arguments given"));
         }
     }
-    if (kws_found < kws->used) {
+    if (kws_found < n_kw) {
         if (MICROPY_ERROR_REPORTING == MICROPY_ERROR_REPORTING_TERSE) {
             mp_arg_error_terse_mismatch();
         } else {
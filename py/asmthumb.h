@@ -214,6 +214,33 @@ static inline void asm_thumb_ldrb_rlo_rlo_i5(asm_thumb_t *as, uint rlo_dest, uin
 static inline void asm_thumb_ldrh_rlo_rlo_i5(asm_thumb_t *as, uint rlo_dest, uint rlo_base, uint byte_offset)
     { asm_thumb_format_9_10(as, ASM_THUMB_FORMAT_10_LDRH, rlo_dest, rlo_base, byte_offset); }
 
+// VFP: single precision float operations on s0-s31, which need an FPU
+// Two operand ops take sd and sm, and have a fixed value for sn
+
+#define ASM_THUMB_VFP_OP_VADD (0xee300a00)
+#define ASM_THUMB_VFP_OP_VSUB (0xee300a40)
+#define ASM_THUMB_VFP_OP_VMUL (0xee200a00)
+#define ASM_THUMB_VFP_OP_VDIV (0xee800a00)
+#define ASM_THUMB_VFP_OP_VCMP (0xeeb40a40)
+#define ASM_THUMB_VFP_OP_VCVT_F32_S32 (0xeeb80ac0)
+#define ASM_THUMB_VFP_OP_VCVT_F32_U32 (0xeeb80a40)
+#define ASM_THUMB_VFP_OP_VCVT_S32_F32 (0xeebd0ac0) // rounds towards zero
+#define ASM_THUMB_VFP_OP_VCVT_U32_F32 (0xeebc0ac0) // rounds towards zero
+
+static inline void asm_thumb_vfp_op_sreg_sreg_sreg(asm_thumb_t *as, uint32_t op, uint sd, uint sn, uint sm) {
+    asm_thumb_op32(as, (op >> 16) | ((sd & 1) << 6) | (sn >> 1),
+        (op & 0xffff) | ((sd >> 1) << 12) | ((sn & 1) << 7) | ((sm & 1) << 5) | (sm >> 1));
+}
+static inline void asm_thumb_vfp_op_sreg_sreg(asm_thumb_t *as, uint32_t op, uint sd, uint sm)
+    { asm_thumb_vfp_op_sreg_sreg_sreg(as, op, sd, 0, sm); }
+static inline void asm_thumb_vmov_sreg_reg(asm_thumb_t *as, uint sn, uint reg_src)
+    { asm_thumb_op32(as, 0xee00 | (sn >> 1), 0x0a10 | (reg_src << 12) | ((sn & 1) << 7)); }
+static inline void asm_thumb_vmov_reg_sreg(asm_thumb_t *as, uint reg_dest, uint sn)
+    { asm_thumb_op32(as, 0xee10 | (sn >> 1), 0x0a10 | (reg_dest << 12) | ((sn & 1) << 7)); }
+// copy the flags of the last vcmp to the APSR, for a conditional
+static inline void asm_thumb_vmrs_apsr_fpscr(asm_thumb_t *as)
+    { asm_thumb_op32(as, 0xeef1, 0xfa10); }
+
 // TODO convert these to above format style
 
 #define ASM_THUMB_OP_MOVW (0xf240)
@@ -72,6 +72,58 @@ const byte *mp_decode_uint_skip(const byte *ptr) {
     return ptr;
 }
 
+// Find the source line of the instruction at ip in the bytecode starting at
+// bytecode, using the line number table in the code info block.  The block
+// (function) name and source file are stored through the given pointers.
+size_t mp_bytecode_get_source_line(const byte *bytecode, const mp_uint_t *const_table, const byte *ip, qstr *block_name, qstr *source_file) {
+    (void)const_table; // only used when qstrs are loaded in place
+    const byte *ci = bytecode;
+    ci = mp_decode_uint_skip(ci); // skip n_state
+    ci = mp_decode_uint_skip(ci); // skip n_exc_stack
+    ci++; // skip scope_params
+    ci++; // skip n_pos_args
+    ci++; // skip n_kwonly_args
+    ci++; // skip n_def_pos_args
+    size_t bc = ip - ci;
+    size_t code_info_size = mp_decode_uint_value(ci);
+    ci = mp_decode_uint_skip(ci); // skip code_info_size
+    bc -= code_info_size;
+    #if MICROPY_PERSISTENT_CODE
+    *block_name = MP_BC_RESOLVE_QSTR(ci[0] | (ci[1] << 8), const_table);
+    *source_file = MP_BC_RESOLVE_QSTR(ci[2] | (ci[3] << 8), const_table);
+    ci += 4;
+    #else
+    *block_name = mp_decode_uint_value(ci);
+    ci = mp_decode_uint_skip(ci);
+    *source_file = mp_decode_uint_value(ci);
+    ci = mp_decode_uint_skip(ci);
+    #endif
+    size_t source_line = 1;
+    size_t c;
+    while ((c = *ci)) {
+        size_t b, l;
+        if ((c & 0x80) == 0) {
+            // 0b0LLBBBBB encoding
+            b = c & 0x1f;
+            l = c >> 5;
+            ci += 1;
+        } else {
+            // 0b1LLLBBBB 0bLLLLLLLL encoding (l's LSB in second byte)
+            b = c & 0xf;
+            l = ((c << 4) & 0x700) | ci[1];
+            ci += 2;
+        }
+        if (bc >= b) {
+            bc -= b;
+            source_line += l;
+        } else {
+            // found source line corresponding to bytecode offset
+            break;
+        }
+    }
+    return source_line;
+}
+
 STATIC NORETURN void fun_pos_args_mismatch(mp_obj_fun_bc_t *f, size_t expected, size_t given) {
 #if MICROPY_ERROR_REPORTING == MICROPY_ERROR_REPORTING_TERSE
     // generic message, used also for other argument issues
@@ -294,6 +346,19 @@ continue2:;
     dump_args(code_state->state, n_state);
 }
 
+// The binary ops that MP_BC_BINARY_OP_SMALL_INT can encode, indexed by the top
+// 3 bits of its argument.
+const byte mp_bc_small_int_binary_op[8] = {
+    MP_BINARY_OP_LESS,
+    MP_BINARY_OP_MORE,
+    MP_BINARY_OP_EQUAL,
+    MP_BINARY_OP_NOT_EQUAL,
+    MP_BINARY_OP_ADD,
+    MP_BINARY_OP_SUBTRACT,
+    MP_BINARY_OP_INPLACE_ADD,
+    MP_BINARY_OP_INPLACE_SUBTRACT,
+};
+
 #if MICROPY_PERSISTENT_CODE_LOAD || MICROPY_PERSISTENT_CODE_SAVE
 
 // The following table encodes the number of bytes that a specific opcode
@@ -301,6 +366,12 @@ continue2:;
 //     MP_BC_MAKE_CLOSURE
 //     MP_BC_MAKE_CLOSURE_DEFARGS
 //     MP_BC_RAISE_VARARGS
+// There are 4 superinstructions that always have an extra byte (for the
+// two with a qstr, it follows the qstr):
+//     MP_BC_LOAD_FAST_ATTR
+//     MP_BC_LOAD_FAST_METHOD
+//     MP_BC_LOAD_FAST_PAIR
+//     MP_BC_BINARY_OP_SMALL_INT
 // There are 4 special opcodes that have an extra byte only when
 // MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE is enabled:
 //     MP_BC_LOAD_NAME
@@ -332,7 +403,7 @@ STATIC const byte opcode_format_table[64] = {
     OC4(U, O, B, O), // 0x3c-0x3f
     OC4(O, B, B, O), // 0x40-0x43
     OC4(B, B, O, B), // 0x44-0x47
-    OC4(U, U, U, U), // 0x48-0x4b
+    OC4(Q, Q, B, B), // 0x48-0x4b
     OC4(U, U, U, U), // 0x4c-0x4f
     OC4(V, V, U, V), // 0x50-0x53
     OC4(B, U, V, V), // 0x54-0x57
@@ -396,10 +467,15 @@ uint mp_opcode_format(const byte *ip, size_t *opcode_size) {
     uint f = (opcode_format_table[*ip >> 2] >> (2 * (*ip & 3))) & 3;
     const byte *ip_start = ip;
     if (f == MP_OPCODE_QSTR) {
+        if (*ip == MP_BC_LOAD_FAST_ATTR || *ip == MP_BC_LOAD_FAST_METHOD) {
+            ip += 1;
+        }
         ip += 3;
     } else {
         int extra_byte = (
-            *ip == MP_BC_RAISE_VARARGS
+            *ip == MP_BC_LOAD_FAST_PAIR
+            || *ip == MP_BC_BINARY_OP_SMALL_INT
+            || *ip == MP_BC_RAISE_VARARGS
             || *ip == MP_BC_MAKE_CLOSURE
             || *ip == MP_BC_MAKE_CLOSURE_DEFARGS
             #if MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE
@@ -92,9 +92,20 @@ typedef struct _mp_code_state_t {
 mp_uint_t mp_decode_uint(const byte **ptr);
 mp_uint_t mp_decode_uint_value(const byte *ptr);
 const byte *mp_decode_uint_skip(const byte *ptr);
+size_t mp_bytecode_get_source_line(const byte *bytecode, const mp_uint_t *const_table, const byte *ip, qstr *block_name, qstr *source_file);
 
 mp_vm_return_kind_t mp_execute_bytecode(mp_code_state_t *code_state, volatile mp_obj_t inject_exc);
-mp_code_state_t *mp_obj_fun_bc_prepare_codestate(mp_obj_t func, size_t n_args, size_t n_kw, const mp_obj_t *args);
+#if MICROPY_VM_OPCODE_STATS
+void mp_opcode_stats_print(const mp_print_t *print);
+void mp_opcode_stats_reset(void);
+#endif
+#if MICROPY_STACKLESS
+mp_code_state_t *mp_obj_fun_bc_alloc_codestate(mp_obj_t func);
+void mp_obj_fun_bc_init_codestate(mp_code_state_t *code_state, size_t n_args, size_t n_kw, const mp_obj_t *args);
+bool mp_obj_is_closure_of_fun_bc(mp_obj_t self_in);
+mp_code_state_t *mp_obj_closure_alloc_codestate(mp_obj_t self_in);
+void mp_obj_closure_init_codestate(mp_code_state_t *code_state, mp_obj_t self_in, size_t n_args, size_t n_kw, const mp_obj_t *args);
+#endif
 void mp_setup_code_state(mp_code_state_t *code_state, size_t n_args, size_t n_kw, const mp_obj_t *args);
 void mp_bytecode_print(const void *descr, const byte *code, mp_uint_t len, const mp_uint_t *const_table);
 void mp_bytecode_print2(const byte *code, size_t len, const mp_uint_t *const_table);
@@ -107,6 +118,20 @@ const byte *mp_bytecode_print_str(const byte *ip);
 #define MP_TAGPTR_TAG1(x) ((uintptr_t)(x) & 2)
 #define MP_TAGPTR_MAKE(ptr, tag) ((void*)((uintptr_t)(ptr) | (tag)))
 
+// Binary ops encoded by MP_BC_BINARY_OP_SMALL_INT
+extern const byte mp_bc_small_int_binary_op[8];
+
+// Bytecode saved to run in place refers to qstrs, including those in the
+// prelude, by the index of a constant table slot holding the qstr object,
+// with this bit set.
+#define MP_BC_QSTR_SLOT (0x8000)
+#if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+#define MP_BC_RESOLVE_QSTR(qst, const_table) \
+    (((qst) & MP_BC_QSTR_SLOT) ? MP_OBJ_QSTR_VALUE((mp_obj_t)(const_table)[(qst) & ~MP_BC_QSTR_SLOT]) : (qst))
+#else
+#define MP_BC_RESOLVE_QSTR(qst, const_table) (qst)
+#endif
+
 #if MICROPY_PERSISTENT_CODE_LOAD || MICROPY_PERSISTENT_CODE_SAVE
 
 #define MP_OPCODE_BYTE (0)
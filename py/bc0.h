@@ -82,6 +82,14 @@
 #define MP_BC_UNWIND_JUMP        (0x46) // rel byte code offset, 16-bit signed, in excess; then a byte
 #define MP_BC_GET_ITER_STACK     (0x47)
 
+// Fused forms of common sequences, see MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS
+#define MP_BC_LOAD_FAST_ATTR      (0x48) // qstr, then byte local num
+#define MP_BC_LOAD_FAST_METHOD    (0x49) // qstr, then byte local num
+#define MP_BC_LOAD_FAST_PAIR      (0x4a) // byte: first local num in low nibble, second in high
+#define MP_BC_BINARY_OP_SMALL_INT (0x4b) // byte: op index in top 3 bits, small int + 16 in low 5
+
+#define MP_BC_LOAD_FAST_UNCHECKED (0x4c) // uint; pushes the local even if it's unbound
+
 #define MP_BC_BUILD_TUPLE        (0x50) // uint
 #define MP_BC_BUILD_LIST         (0x51) // uint
 #define MP_BC_BUILD_MAP          (0x53) // uint
@@ -29,6 +29,10 @@
 #include "py/obj.h"
 
 mp_obj_t mp_builtin___import__(size_t n_args, const mp_obj_t *args);
+#if MICROPY_RELOAD_MODULES
+// Runs the file at path again in the globals of module_obj.
+void mp_import_reload_file(mp_obj_t module_obj, const char *path);
+#endif
 mp_obj_t mp_builtin_open(size_t n_args, const mp_obj_t *args, mp_map_t *kwargs);
 mp_obj_t mp_micropython_mem_info(size_t n_args, const mp_obj_t *args);
 
@@ -111,6 +115,7 @@ extern const mp_obj_module_t mp_module_urandom;
 extern const mp_obj_module_t mp_module_uselect;
 extern const mp_obj_module_t mp_module_ussl;
 extern const mp_obj_module_t mp_module_utimeq;
+extern const mp_obj_module_t mp_module_uasyncio;
 extern const mp_obj_module_t mp_module_machine;
 extern const mp_obj_module_t mp_module_lwip;
 extern const mp_obj_module_t mp_module_websocket;
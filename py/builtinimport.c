@@ -33,10 +33,17 @@
 #include "py/gc_long_lived.h"
 #include "py/gc.h"
 #include "py/objmodule.h"
+#include "py/objfun.h"
 #include "py/persistentcode.h"
 #include "py/runtime.h"
 #include "py/builtin.h"
 #include "py/frozenmod.h"
+#include "py/reload.h"
+
+#if MICROPY_MODULE_CACHE
+#include "py/stream.h"
+#include "extmod/vfs.h"
+#endif
 
 #include "supervisor/shared/translate.h"
 
@@ -149,13 +156,34 @@ STATIC void do_load_from_lexer(mp_obj_t module_obj, mp_lexer_t *lex) {
 
     // parse, compile and execute the module in its context
     mp_obj_dict_t *mod_globals = mp_obj_module_get_globals(module_obj);
+    #if MICROPY_COMPILE_BY_STATEMENT
+    mp_parse_compile_execute_by_statement(lex, mod_globals);
+    #else
     mp_parse_compile_execute(lex, MP_PARSE_FILE_INPUT, mod_globals, mod_globals);
+    #endif
     mp_obj_module_set_globals(module_obj, make_dict_long_lived(mod_globals, 10));
 }
 #endif
 
 #if MICROPY_PERSISTENT_CODE_LOAD || MICROPY_MODULE_FROZEN_MPY
 STATIC void do_execute_raw_code(mp_obj_t module_obj, mp_raw_code_t *raw_code, const char *filename) {
+    #if MICROPY_MODULE_FROZEN_ROM_FUN
+    // A frozen module runs in the static globals dict that its prebuilt functions refer
+    // to, unless an earlier import of the module is still using it.
+    if (raw_code->kind == MP_CODE_BYTECODE && raw_code->data.u_byte.rom_fun != NULL
+        && raw_code->data.u_byte.rom_fun->globals->base.type == NULL) {
+        mp_obj_dict_t *rom_globals = raw_code->data.u_byte.rom_fun->globals;
+        mp_map_t *old_map = &mp_obj_module_get_globals(module_obj)->map;
+        mp_obj_dict_init(rom_globals, old_map->used + 1);
+        for (size_t i = 0; i < old_map->alloc; i++) {
+            if (MP_MAP_SLOT_IS_FILLED(old_map, i)) {
+                mp_obj_dict_store(MP_OBJ_FROM_PTR(rom_globals), old_map->table[i].key, old_map->table[i].value);
+            }
+        }
+        mp_obj_module_set_globals(module_obj, rom_globals);
+    }
+    #endif
+
     #if MICROPY_PY___FILE__
     mp_store_attr(module_obj, MP_QSTR___file__, MP_OBJ_NEW_QSTR(qstr_from_str(filename)));
     #endif
@@ -191,6 +219,140 @@ STATIC void do_execute_raw_code(mp_obj_t module_obj, mp_raw_code_t *raw_code, co
 }
 #endif
 
+#if MICROPY_MODULE_CACHE
+// Modules compiled from .py files are saved to __pycache__/<name>.mpy next to them, after a header
+// holding the size and modification time of the source, and loaded from there while those still
+// match. Nothing is saved while the filesystem can't be written, such as when it's read-only to
+// Python, so imports compile from source then.
+
+#define MODULE_CACHE_HEADER_LEN (8)
+
+// Fills header with the size and modification time of the source.
+STATIC void module_cache_header(const char *source, byte *header) {
+    mp_obj_t *items;
+    mp_obj_get_array_fixed_n(mp_vfs_stat(mp_obj_new_str(source, strlen(source))), 10, &items);
+    uint32_t size = mp_obj_get_int_truncated(items[6]);
+    uint32_t mtime = mp_obj_get_int_truncated(items[8]);
+    for (size_t i = 0; i < 4; i++) {
+        header[i] = size >> (8 * i);
+        header[4 + i] = mtime >> (8 * i);
+    }
+}
+
+// Adds the __pycache__ directory for the source to path, followed by the cache file name when
+// with_name is true.
+STATIC void module_cache_path(const char *source, vstr_t *path, bool with_name) {
+    const char *name = strrchr(source, PATH_SEP_CHAR);
+    name = name == NULL ? source : name + 1;
+    vstr_add_strn(path, source, name - source);
+    vstr_add_str(path, "__pycache__");
+    if (with_name) {
+        vstr_add_char(path, PATH_SEP_CHAR);
+        // Swap .py for .mpy.
+        vstr_add_strn(path, name, strlen(name) - 3);
+        vstr_add_str(path, ".mpy");
+    }
+}
+
+// Returns the cached code if its header matches, otherwise NULL.
+STATIC mp_raw_code_t *module_cache_load(const char *cache_path, const byte *header) {
+    if (mp_import_stat(cache_path) != MP_IMPORT_STAT_FILE) {
+        return NULL;
+    }
+    mp_reader_t reader;
+    mp_reader_new_file(&reader, cache_path);
+    for (size_t i = 0; i < MODULE_CACHE_HEADER_LEN; i++) {
+        if (reader.readbyte(reader.data) != header[i]) {
+            reader.close(reader.data);
+            return NULL;
+        }
+    }
+    return mp_raw_code_load(&reader);
+}
+
+// Writes the code to a temporary file that then replaces the cache file, so that a write cut
+// short doesn't leave a cache file behind.
+STATIC void module_cache_save(const char *source, const char *cache_path, mp_raw_code_t *raw_code, const byte *header) {
+    vstr_t dir;
+    vstr_init(&dir, strlen(source) + 12);
+    module_cache_path(source, &dir, false);
+    if (mp_import_stat(vstr_null_terminated_str(&dir)) == MP_IMPORT_STAT_NO_EXIST) {
+        mp_vfs_mkdir(mp_obj_new_str(dir.buf, dir.len));
+    }
+    vstr_clear(&dir);
+
+    size_t cache_path_len = strlen(cache_path);
+    mp_obj_t cache_path_obj = mp_obj_new_str(cache_path, cache_path_len);
+    vstr_t temp;
+    vstr_init(&temp, cache_path_len + 5);
+    vstr_add_strn(&temp, cache_path, cache_path_len);
+    vstr_add_str(&temp, ".tmp");
+    mp_obj_t temp_obj = mp_obj_new_str(temp.buf, temp.len);
+    vstr_clear(&temp);
+
+    mp_obj_t open_args[2] = { temp_obj, MP_OBJ_NEW_QSTR(MP_QSTR_wb) };
+    mp_obj_t file = mp_vfs_open(MP_ARRAY_SIZE(open_args), open_args, (mp_map_t*)&mp_const_empty_map);
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        mp_stream_write(file, header, MODULE_CACHE_HEADER_LEN, MP_STREAM_RW_WRITE);
+        mp_print_t print = {MP_OBJ_TO_PTR(file), mp_stream_write_adaptor};
+        mp_raw_code_save(raw_code, &print);
+        mp_stream_close(file);
+        nlr_pop();
+    } else {
+        // Such as when the code can't be saved or the filesystem is full.
+        mp_stream_close(file);
+        mp_vfs_remove(temp_obj);
+        nlr_jump(nlr.ret_val);
+    }
+    if (mp_import_stat(cache_path) != MP_IMPORT_STAT_NO_EXIST) {
+        mp_vfs_remove(cache_path_obj);
+    }
+    mp_vfs_rename(temp_obj, cache_path_obj);
+}
+
+// Loads the source from its cache, or compiles it and tries to cache it. Returns false when the
+// source can't be stat'ed so it should be loaded as usual.
+STATIC bool do_load_cached(mp_obj_t module_obj, const char *source) {
+    byte header[MODULE_CACHE_HEADER_LEN];
+    vstr_t cache_path;
+    vstr_init(&cache_path, strlen(source) + 16);
+    module_cache_path(source, &cache_path, true);
+    mp_raw_code_t *raw_code = NULL;
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        module_cache_header(source, header);
+        nlr_pop();
+    } else {
+        vstr_clear(&cache_path);
+        return false;
+    }
+    if (nlr_push(&nlr) == 0) {
+        raw_code = module_cache_load(vstr_null_terminated_str(&cache_path), header);
+        nlr_pop();
+    } else {
+        // An unreadable or out of date cache file is replaced below.
+    }
+
+    if (raw_code == NULL) {
+        mp_lexer_t *lex = mp_lexer_new_from_file(source);
+        qstr source_name = lex->source_name;
+        mp_parse_tree_t parse_tree = mp_parse(lex, MP_PARSE_FILE_INPUT);
+        raw_code = mp_compile_to_raw_code(&parse_tree, source_name, MP_EMIT_OPT_NONE, false);
+        if (nlr_push(&nlr) == 0) {
+            module_cache_save(source, vstr_null_terminated_str(&cache_path), raw_code, header);
+            nlr_pop();
+        } else {
+            // The module still runs when it can't be cached.
+        }
+    }
+    vstr_clear(&cache_path);
+
+    do_execute_raw_code(module_obj, raw_code, source);
+    return true;
+}
+#endif
+
 STATIC void do_load(mp_obj_t module_obj, vstr_t *file) {
     #if MICROPY_MODULE_FROZEN || MICROPY_PERSISTENT_CODE_LOAD || MICROPY_ENABLE_COMPILER
     char *file_str = vstr_null_terminated_str(file);
@@ -238,6 +400,12 @@ STATIC void do_load(mp_obj_t module_obj, vstr_t *file) {
     }
     #endif
 
+    #if MICROPY_MODULE_CACHE
+    if (do_load_cached(module_obj, file_str)) {
+        return;
+    }
+    #endif
+
     // If we can compile scripts then load the file and compile and execute it.
     #if MICROPY_ENABLE_COMPILER
     {
@@ -252,6 +420,17 @@ STATIC void do_load(mp_obj_t module_obj, vstr_t *file) {
     #endif
 }
 
+#if MICROPY_RELOAD_MODULES
+void mp_import_reload_file(mp_obj_t module_obj, const char *path) {
+    vstr_t file;
+    vstr_init(&file, strlen(path) + 1);
+    vstr_add_str(&file, path);
+    do_load(module_obj, &file);
+    vstr_clear(&file);
+    gc_collect();
+}
+#endif
+
 STATIC void chop_component(const char *start, const char **end) {
     const char *p = *end;
     while (p > start) {
@@ -357,6 +536,9 @@ mp_obj_t mp_builtin___import__(size_t n_args, const mp_obj_t *args) {
     mp_obj_t module_obj = mp_module_get(module_name_qstr);
     if (module_obj != MP_OBJ_NULL) {
         DEBUG_printf("Module already loaded\n");
+        #if MICROPY_RELOAD_MODULES
+        mp_reload_track_import(module_obj);
+        #endif
         // If it's not a package, return module right away
         char *p = strchr(mod_str, '.');
         if (p == NULL) {
@@ -464,10 +646,16 @@ mp_obj_t mp_builtin___import__(size_t n_args, const mp_obj_t *args) {
                         //mp_warning("%s is imported as namespace package", vstr_str(&path));
                     } else {
                         do_load(module_obj, &path);
+                        #if MICROPY_RELOAD_MODULES
+                        mp_reload_track_file(module_obj, vstr_null_terminated_str(&path));
+                        #endif
                     }
                     path.len = orig_path_len;
                 } else { // MP_IMPORT_STAT_FILE
                     do_load(module_obj, &path);
+                    #if MICROPY_RELOAD_MODULES
+                    mp_reload_track_file(module_obj, vstr_null_terminated_str(&path));
+                    #endif
                     // This should be the last component in the import path.  If there are
                     // remaining components then it's an ImportError because the current path
                     // (the module that was just loaded) is not a package.  This will be caught
@@ -478,6 +666,9 @@ mp_obj_t mp_builtin___import__(size_t n_args, const mp_obj_t *args) {
                 // afterwards.
                 gc_collect();
             }
+            #if MICROPY_RELOAD_MODULES
+            mp_reload_track_import(module_obj);
+            #endif
             if (outer_module_obj != MP_OBJ_NULL) {
                 qstr s = qstr_from_strn(mod_str + last, i - last);
                 mp_store_attr(outer_module_obj, s, module_obj);
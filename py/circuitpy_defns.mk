@@ -114,12 +114,18 @@ endif
 ifeq ($(CIRCUITPY_AUDIOCORE),1)
 SRC_PATTERNS += audiocore/%
 endif
+ifeq ($(CIRCUITPY_AUDIOEFFECTS),1)
+SRC_PATTERNS += audioeffects/%
+endif
 ifeq ($(CIRCUITPY_AUDIOMIXER),1)
 SRC_PATTERNS += audiomixer/%
 endif
 ifeq ($(CIRCUITPY_AUDIOMP3),1)
 SRC_PATTERNS += audiomp3/%
 endif
+ifeq ($(CIRCUITPY_AUDIOSYNTH),1)
+SRC_PATTERNS += audiosynth/%
+endif
 ifeq ($(CIRCUITPY_BITBANGIO),1)
 SRC_PATTERNS += bitbangio/%
 endif
@@ -136,12 +142,18 @@ endif
 ifeq ($(CIRCUITPY_BUSIO),1)
 SRC_PATTERNS += busio/% bitbangio/OneWire.%
 endif
+ifeq ($(CIRCUITPY_COUNTIO),1)
+SRC_PATTERNS += countio/%
+endif
 ifeq ($(CIRCUITPY_DIGITALIO),1)
 SRC_PATTERNS += digitalio/%
 endif
 ifeq ($(CIRCUITPY_DISPLAYIO),1)
 SRC_PATTERNS += displayio/% terminalio/% fontio/%
 endif
+ifeq ($(CIRCUITPY_FIXEDPOINT),1)
+SRC_PATTERNS += fixedpoint/%
+endif
 ifeq ($(CIRCUITPY_FREQUENCYIO),1)
 SRC_PATTERNS += frequencyio/%
 endif
@@ -214,6 +226,12 @@ endif
 ifeq ($(CIRCUITPY_UHEAP),1)
 SRC_PATTERNS += uheap/%
 endif
+ifeq ($(CIRCUITPY_USB_AUDIO),1)
+SRC_PATTERNS += usb_audio/%
+endif
+ifeq ($(CIRCUITPY_USB_CDC),1)
+SRC_PATTERNS += usb_cdc/%
+endif
 ifeq ($(CIRCUITPY_USB_HID),1)
 SRC_PATTERNS += usb_hid/%
 endif
@@ -254,6 +272,8 @@ SRC_COMMON_HAL_ALL = \
 	busio/SPI.c \
 	busio/UART.c \
 	busio/__init__.c \
+	countio/Counter.c \
+	countio/__init__.c \
 	digitalio/DigitalInOut.c \
 	digitalio/__init__.c \
 	displayio/ParallelBus.c \
@@ -319,11 +339,15 @@ SRC_SHARED_MODULE_ALL = \
 	audiocore/__init__.c \
 	audiocore/RawSample.c \
 	audiocore/WaveFile.c \
+	audioeffects/__init__.c \
+	audioeffects/Effect.c \
 	audiomixer/__init__.c \
 	audiomixer/Mixer.c \
 	audiomixer/MixerVoice.c \
 	audiomp3/__init__.c \
 	audiomp3/MP3Decoder.c \
+	audiosynth/__init__.c \
+	audiosynth/Synthesizer.c \
 	bitbangio/I2C.c \
 	bitbangio/OneWire.c \
 	bitbangio/SPI.c \
@@ -339,20 +363,26 @@ SRC_SHARED_MODULE_ALL = \
 	displayio/I2CDisplay.c \
 	displayio/OnDiskBitmap.c \
 	displayio/Palette.c \
+	displayio/RLEBitmap.c \
 	displayio/Shape.c \
 	displayio/TileGrid.c \
 	displayio/__init__.c \
+	fixedpoint/__init__.c \
 	fontio/BuiltinFont.c \
+	fontio/OnDiskFont.c \
 	fontio/__init__.c \
 	gamepad/GamePad.c \
 	gamepad/__init__.c \
 	gamepadshift/GamePadShift.c \
 	gamepadshift/__init__.c \
+	nvm/KeyValueStore.c \
 	os/__init__.c \
 	random/__init__.c \
 	socket/__init__.c \
 	network/__init__.c \
 	storage/__init__.c \
+	storage/RAMBlockDevice.c \
+	struct/Struct.c \
 	struct/__init__.c \
 	terminalio/Terminal.c \
 	terminalio/__init__.c \
@@ -364,6 +394,19 @@ SRC_SHARED_MODULE_ALL = \
 # All possible sources are listed here, and are filtered by SRC_PATTERNS.
 SRC_SHARED_MODULE = $(filter $(SRC_PATTERNS), $(SRC_SHARED_MODULE_ALL))
 
+# audiobusio.I2SIn is only available on ports that implement it.
+ifeq ($(CIRCUITPY_AUDIOBUSIO_I2SIN),1)
+SRC_COMMON_HAL_ALL += \
+	audiobusio/I2SIn.c
+endif
+
+# digitalio.PortIn and PortOut are only available on ports that implement them.
+ifeq ($(CIRCUITPY_DIGITALIO_PORT),1)
+SRC_COMMON_HAL_ALL += \
+	digitalio/PortIn.c \
+	digitalio/PortOut.c
+endif
+
 # Use the native touchio if requested. This flag is set conditionally in, say, mpconfigport.h.
 # The presence of common-hal/touchio/* # does not imply it's available for all chips in a port,
 # so there is an explicit flag. For example, SAMD21 touchio is native, but SAMD51 is not.
@@ -400,7 +443,9 @@ endif
 # All possible sources are listed here, and are filtered by SRC_PATTERNS.
 SRC_SHARED_MODULE_INTERNAL = \
 $(filter $(SRC_PATTERNS), \
+	audiocore/playback.c \
 	displayio/display_core.c \
+	displayio/vector.c \
 )
 
 ifeq ($(INTERNAL_LIBM),1)
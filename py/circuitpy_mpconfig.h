@@ -53,12 +53,15 @@
 #define MICROPY_ALLOC_PATH_MAX           (256)
 #define MICROPY_CAN_OVERRIDE_BUILTINS    (1)
 #define MICROPY_COMP_CONST               (1)
+#define MICROPY_COMP_CONST_FLOAT         (1)
+#define MICROPY_COMP_CONST_TUPLE         (CIRCUITPY_FULL_BUILD)
 #define MICROPY_COMP_DOUBLE_TUPLE_ASSIGN (1)
 #define MICROPY_COMP_MODULE_CONST        (1)
 #define MICROPY_COMP_TRIPLE_TUPLE_ASSIGN (0)
 #define MICROPY_DEBUG_PRINTERS           (0)
 #define MICROPY_EMIT_INLINE_THUMB        (CIRCUITPY_ENABLE_MPY_NATIVE)
 #define MICROPY_EMIT_THUMB               (CIRCUITPY_ENABLE_MPY_NATIVE)
+#define MICROPY_EMIT_NATIVE_FLOAT        (CIRCUITPY_ENABLE_MPY_NATIVE)
 #define MICROPY_EMIT_X64                 (0)
 #define MICROPY_ENABLE_DOC_STRING        (0)
 #define MICROPY_ENABLE_FINALISER         (1)
@@ -74,10 +77,19 @@
 #define MICROPY_MEM_STATS                (0)
 #define MICROPY_NONSTANDARD_TYPECODES    (0)
 #define MICROPY_OPT_COMPUTED_GOTO        (1)
+#define MICROPY_OPT_MAP_LOOKUP_CACHE     (1)
+#define MICROPY_MAP_COMPACT_MAX          (8)
 #define MICROPY_PERSISTENT_CODE_LOAD     (1)
+#define MICROPY_MODULE_FROZEN_ROM_FUN    (MICROPY_MODULE_FROZEN_MPY)
+// Internal flash and QSPI flash can be memory mapped, so they can run .mpy
+// files in place.
+#ifndef MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+#define MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE (INTERNAL_FLASH_FILESYSTEM || QSPI_FLASH_FILESYSTEM)
+#endif
 
 #define MICROPY_PY_ARRAY                 (1)
 #define MICROPY_PY_ARRAY_SLICE_ASSIGN    (1)
+#define MICROPY_PY_ARRAY_VECTOR          (CIRCUITPY_FULL_BUILD)
 #define MICROPY_PY_ASYNC_AWAIT           (0)
 #define MICROPY_PY_ATTRTUPLE             (1)
 
@@ -88,6 +100,7 @@
 #define MICROPY_PY_BUILTINS_HELP_MODULES (1)
 #define MICROPY_PY_BUILTINS_INPUT        (1)
 #define MICROPY_PY_BUILTINS_MEMORYVIEW   (1)
+#define MICROPY_PY_BUILTINS_MEMORYVIEW_CAST (CIRCUITPY_FULL_BUILD)
 #define MICROPY_PY_BUILTINS_MIN_MAX      (1)
 #define MICROPY_PY_BUILTINS_PROPERTY     (1)
 #define MICROPY_PY_BUILTINS_REVERSED     (1)
@@ -130,6 +143,11 @@
 #define MICROPY_FATFS_USE_LABEL       (1)
 #define MICROPY_FATFS_RPATH           (2)
 #define MICROPY_FATFS_MULTI_PARTITION (1)
+// Number of recently used FAT and directory sectors kept in each mount, on top
+// of the one sector window. Each costs FILESYSTEM_BLOCK_SIZE bytes of ram.
+#if CIRCUITPY_FULL_BUILD
+#define MICROPY_FATFS_WINCACHE        (4)
+#endif
 
 // Only enable this if you really need it. It allocates a byte cache of this size.
 // #define MICROPY_FATFS_MAX_SS           (4096)
@@ -138,7 +156,16 @@
 
 #define MICROPY_VFS                 (1)
 #define MICROPY_VFS_FAT             (MICROPY_VFS)
+#define MICROPY_VFS_FAT_IMPORT_STAT_CACHE (CIRCUITPY_FULL_BUILD)
+#define MICROPY_VFS_ROM             (CIRCUITPY_FULL_BUILD)
+#define MICROPY_VFS_ROM_COMPRESSION (MICROPY_VFS_ROM)
 #define MICROPY_READER_VFS          (MICROPY_VFS)
+#define MICROPY_READER_VFS_BLOCK_SIZE (FILESYSTEM_BLOCK_SIZE)
+#if CIRCUITPY_FULL_BUILD
+#define MICROPY_READER_VFS_BLOCKS   (8)
+#else
+#define MICROPY_READER_VFS_BLOCKS   (2)
+#endif
 
 // type definitions for the specific machine
 
@@ -146,8 +173,9 @@
 
 #define MICROPY_MAKE_POINTER_CALLABLE(p) ((void*)((mp_uint_t)(p) | 1))
 
-// Track stack usage. Expose results via ustack module.
-#define MICROPY_MAX_STACK_USAGE       (0)
+// Paint the stack at VM start to track its high water mark. Expose results via
+// the supervisor and ustack modules.
+#define MICROPY_MAX_STACK_USAGE       (CIRCUITPY_STACK_HIGH_WATER)
 
 // This port is intended to be 32-bit, but unfortunately, int32_t for
 // different targets may be defined in different ways - either as int
@@ -183,7 +211,39 @@ typedef long mp_off_t;
 // Remove some lesser-used functionality to make small builds fit.
 #define MICROPY_BUILTIN_METHOD_CHECK_SELF_ARG (CIRCUITPY_FULL_BUILD)
 #define MICROPY_CPYTHON_COMPAT                (CIRCUITPY_FULL_BUILD)
+#define MICROPY_GC_FREE_RUN_INDEX             (CIRCUITPY_FULL_BUILD)
+#define MICROPY_GC_LAZY_SWEEP                 (CIRCUITPY_FULL_BUILD)
+#define MICROPY_GC_SMALL_FREE_LISTS           (CIRCUITPY_FULL_BUILD)
+#define MICROPY_FLOAT_FORMAT_SHORTEST         (CIRCUITPY_FULL_BUILD)
+#define MICROPY_GC_LONG_LIVED_PROMOTE_AFTER   (CIRCUITPY_FULL_BUILD * 4)
 #define MICROPY_MODULE_WEAK_LINKS             (CIRCUITPY_FULL_BUILD)
+#define MICROPY_OPT_ATTR_LOOKUP_CACHE         (CIRCUITPY_FULL_BUILD)
+// Six words of RAM per entry. Ports with more RAM may ask for more.
+#ifndef MICROPY_OPT_ATTR_LOOKUP_CACHE_SIZE
+#define MICROPY_OPT_ATTR_LOOKUP_CACHE_SIZE    (16)
+#endif
+#define MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS (CIRCUITPY_FULL_BUILD)
+#define MICROPY_OPT_STR_INDEX_CACHE           (CIRCUITPY_FULL_BUILD)
+#define MICROPY_OPT_VM_SMALL_INT_FAST_PATH (CIRCUITPY_FULL_BUILD)
+#define MICROPY_OPT_MPZ_FAST_MUL              (CIRCUITPY_FULL_BUILD)
+#define MICROPY_PY_SLOTS                      (CIRCUITPY_FULL_BUILD)
+#define MICROPY_RELOAD_MODULES                (CIRCUITPY_FULL_BUILD)
+#define MICROPY_MODULE_CACHE                  (CIRCUITPY_FULL_BUILD)
+#define MICROPY_PERSISTENT_CODE_SAVE          (MICROPY_MODULE_CACHE)
+// Calls between Python functions don't recurse on the C stack. Their frames
+// come from a fixed size Python stack rather than the heap. The pystack then
+// limits recursion depth, at roughly 80 bytes for each level of a small
+// function, so boards opt in with a size that suits their RAM.
+#ifndef MICROPY_ENABLE_PYSTACK
+#define MICROPY_ENABLE_PYSTACK                (0)
+#endif
+#define MICROPY_STACKLESS                     (MICROPY_ENABLE_PYSTACK)
+#ifndef CIRCUITPY_PYSTACK_SIZE
+#define CIRCUITPY_PYSTACK_SIZE                (8 * 1024)
+#endif
+#define MICROPY_TRACK_CURRENT_CODE_STATE (CIRCUITPY_PROFILER || CIRCUITPY_UHEAP)
+#define MICROPY_GC_ALLOC_PROFILE (CIRCUITPY_UHEAP)
+#define MICROPY_GC_IMAGE (CIRCUITPY_HEAP_IMAGE)
 #define MICROPY_PY_ALL_SPECIAL_METHODS        (CIRCUITPY_FULL_BUILD)
 #define MICROPY_PY_BUILTINS_COMPLEX           (CIRCUITPY_FULL_BUILD)
 #define MICROPY_PY_BUILTINS_FROZENSET         (CIRCUITPY_FULL_BUILD)
@@ -191,6 +251,7 @@ typedef long mp_off_t;
 #define MICROPY_PY_BUILTINS_STR_PARTITION     (CIRCUITPY_FULL_BUILD)
 #define MICROPY_PY_BUILTINS_STR_SPLITLINES    (CIRCUITPY_FULL_BUILD)
 #define MICROPY_PY_UERRNO                     (CIRCUITPY_FULL_BUILD)
+#define MICROPY_PY_IO_BUFFEREDREADER          (CIRCUITPY_FULL_BUILD)
 // Opposite setting is deliberate.
 #define MICROPY_PY_UERRNO_ERRORCODE           (!CIRCUITPY_FULL_BUILD)
 #ifndef MICROPY_PY_URE
@@ -199,6 +260,18 @@ typedef long mp_off_t;
 #define MICROPY_PY_URE_MATCH_GROUPS           (CIRCUITPY_FULL_BUILD)
 #define MICROPY_PY_URE_MATCH_SPAN_START_END   (CIRCUITPY_FULL_BUILD)
 #define MICROPY_PY_URE_SUB                    (CIRCUITPY_FULL_BUILD)
+#define MICROPY_PY_URE_CACHE_SIZE             (4)
+#ifndef MICROPY_PY_UASYNCIO
+#define MICROPY_PY_UASYNCIO                   (CIRCUITPY_FULL_BUILD)
+#endif
+// framebuf can draw straight into a displayio.Bitmap.
+#ifndef MICROPY_PY_FRAMEBUF
+#define MICROPY_PY_FRAMEBUF                   (CIRCUITPY_FULL_BUILD && CIRCUITPY_DISPLAYIO)
+#endif
+#ifndef MICROPY_PY_UBINASCII_INTO
+#define MICROPY_PY_UBINASCII_INTO             (CIRCUITPY_FULL_BUILD)
+#endif
+#define MICROPY_EXCEPTION_POOL_SIZE           (4)
 
 // LONGINT_IMPL_xxx are defined in the Makefile.
 //
@@ -226,8 +299,18 @@ typedef long mp_off_t;
 #if CIRCUITPY_ANALOGIO
 #define ANALOGIO_MODULE        { MP_OBJ_NEW_QSTR(MP_QSTR_analogio), (mp_obj_t)&analogio_module },
 extern const struct _mp_obj_module_t analogio_module;
+// Maps AnalogIn objects to the buffer they're sampling into.
+#define ANALOGIO_ROOT_POINTERS mp_obj_t analogio_analogin_readings;
 #else
 #define ANALOGIO_MODULE
+#define ANALOGIO_ROOT_POINTERS
+#endif
+
+#if CIRCUITPY_ASMP
+extern const struct _mp_obj_module_t asmp_module;
+#define ASMP_MODULE            { MP_OBJ_NEW_QSTR(MP_QSTR_asmp), (mp_obj_t)&asmp_module },
+#else
+#define ASMP_MODULE
 #endif
 
 #if CIRCUITPY_AUDIOBUSIO
@@ -240,8 +323,19 @@ extern const struct _mp_obj_module_t audiobusio_module;
 #if CIRCUITPY_AUDIOCORE
 #define AUDIOCORE_MODULE         { MP_OBJ_NEW_QSTR(MP_QSTR_audiocore), (mp_obj_t)&audiocore_module },
 extern const struct _mp_obj_module_t audiocore_module;
+// WaveFiles that load ahead in the background.
+#define AUDIOCORE_READ_AHEAD_COUNT (2)
+#define AUDIOCORE_ROOT_POINTERS mp_obj_t wavefile_read_ahead[AUDIOCORE_READ_AHEAD_COUNT];
 #else
 #define AUDIOCORE_MODULE
+#define AUDIOCORE_ROOT_POINTERS
+#endif
+
+#if CIRCUITPY_AUDIOEFFECTS
+#define AUDIOEFFECTS_MODULE         { MP_OBJ_NEW_QSTR(MP_QSTR_audioeffects), (mp_obj_t)&audioeffects_module },
+extern const struct _mp_obj_module_t audioeffects_module;
+#else
+#define AUDIOEFFECTS_MODULE
 #endif
 
 #if CIRCUITPY_AUDIOIO
@@ -261,8 +355,18 @@ extern const struct _mp_obj_module_t audiomixer_module;
 #if CIRCUITPY_AUDIOMP3
 #define AUDIOMP3_MODULE         { MP_OBJ_NEW_QSTR(MP_QSTR_audiomp3), (mp_obj_t)&audiomp3_module },
 extern const struct _mp_obj_module_t audiomp3_module;
+// The MP3Decoder that decodes ahead in the background.
+#define AUDIOMP3_ROOT_POINTERS mp_obj_t mp3file_decode_ahead;
 #else
 #define AUDIOMP3_MODULE
+#define AUDIOMP3_ROOT_POINTERS
+#endif
+
+#if CIRCUITPY_AUDIOSYNTH
+#define AUDIOSYNTH_MODULE         { MP_OBJ_NEW_QSTR(MP_QSTR_audiosynth), (mp_obj_t)&audiosynth_module },
+extern const struct _mp_obj_module_t audiosynth_module;
+#else
+#define AUDIOSYNTH_MODULE
 #endif
 
 #if CIRCUITPY_AUDIOPWMIO
@@ -310,8 +414,18 @@ extern const struct _mp_obj_module_t board_module;
 #if CIRCUITPY_BUSIO
 extern const struct _mp_obj_module_t busio_module;
 #define BUSIO_MODULE           { MP_OBJ_NEW_QSTR(MP_QSTR_busio), (mp_obj_t)&busio_module },
+// Maps SPI objects to the buffer of their background transfer.
+#define BUSIO_ROOT_POINTERS mp_obj_t busio_spi_transfers;
 #else
 #define BUSIO_MODULE
+#define BUSIO_ROOT_POINTERS
+#endif
+
+#if CIRCUITPY_COUNTIO
+extern const struct _mp_obj_module_t countio_module;
+#define COUNTIO_MODULE         { MP_OBJ_NEW_QSTR(MP_QSTR_countio), (mp_obj_t)&countio_module },
+#else
+#define COUNTIO_MODULE
 #endif
 
 #if CIRCUITPY_DIGITALIO
@@ -331,6 +445,23 @@ extern const struct _mp_obj_module_t terminalio_module;
 #ifndef CIRCUITPY_DISPLAY_LIMIT
 #define CIRCUITPY_DISPLAY_LIMIT (1)
 #endif
+// Size of each of the two pixel buffers used to refresh a display, in uint32_ts.
+#ifndef CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE
+#define CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE (128)
+#endif
+// Longest a background display refresh runs in one go, in microseconds, before it yields to other
+// background tasks and resumes on the next pass. 0 refreshes whole frames at once.
+#ifndef CIRCUITPY_DISPLAY_REFRESH_BUDGET_US
+#define CIRCUITPY_DISPLAY_REFRESH_BUDGET_US (5000)
+#endif
+// Display buses, backlights and EPaperDisplay need pins, and OnDiskBitmap reads files through
+// FatFs. Hosts without them, such as the unix port, turn this off and draw into a FramebufferBus.
+#ifndef CIRCUITPY_DISPLAYIO_HARDWARE
+#define CIRCUITPY_DISPLAYIO_HARDWARE (1)
+#endif
+#ifndef CIRCUITPY_DISPLAYIO_FRAMEBUFFERBUS
+#define CIRCUITPY_DISPLAYIO_FRAMEBUFFERBUS (0)
+#endif
 #else
 #define DISPLAYIO_MODULE
 #define FONTIO_MODULE
@@ -338,6 +469,13 @@ extern const struct _mp_obj_module_t terminalio_module;
 #define CIRCUITPY_DISPLAY_LIMIT (0)
 #endif
 
+#if CIRCUITPY_FIXEDPOINT
+extern const struct _mp_obj_module_t fixedpoint_module;
+#define FIXEDPOINT_MODULE      { MP_OBJ_NEW_QSTR(MP_QSTR_fixedpoint), (mp_obj_t)&fixedpoint_module },
+#else
+#define FIXEDPOINT_MODULE
+#endif
+
 #if CIRCUITPY_FREQUENCYIO
 extern const struct _mp_obj_module_t frequencyio_module;
 #define FREQUENCYIO_MODULE       { MP_OBJ_NEW_QSTR(MP_QSTR_frequencyio), (mp_obj_t)&frequencyio_module },
@@ -370,8 +508,11 @@ extern const struct _mp_obj_module_t gamepadshift_module;
 #if CIRCUITPY_I2CSLAVE
 extern const struct _mp_obj_module_t i2cslave_module;
 #define I2CSLAVE_MODULE        { MP_OBJ_NEW_QSTR(MP_QSTR_i2cslave), (mp_obj_t)&i2cslave_module },
+// I2CSlaves serving registers in the background.
+#define I2CSLAVE_ROOT_POINTERS void *i2cslave_register_slaves;
 #else
 #define I2CSLAVE_MODULE
+#define I2CSLAVE_ROOT_POINTERS
 #endif
 
 #if CIRCUITPY_MATH
@@ -391,8 +532,11 @@ extern const struct _mp_obj_module_t microcontroller_module;
 #if CIRCUITPY_NEOPIXEL_WRITE
 extern const struct _mp_obj_module_t neopixel_write_module;
 #define NEOPIXEL_WRITE_MODULE  { MP_OBJ_NEW_QSTR(MP_QSTR_neopixel_write),(mp_obj_t)&neopixel_write_module },
+// Encoded data of a write that's sent in the background.
+#define NEOPIXEL_WRITE_ROOT_POINTERS void *neopixel_write_buffer;
 #else
 #define NEOPIXEL_WRITE_MODULE
+#define NEOPIXEL_WRITE_ROOT_POINTERS
 #endif
 
 #if CIRCUITPY_NETWORK
@@ -401,6 +545,8 @@ extern const struct _mp_obj_module_t socket_module;
 #define NETWORK_MODULE         { MP_OBJ_NEW_QSTR(MP_QSTR_network), (mp_obj_t)&network_module },
 #define SOCKET_MODULE          { MP_OBJ_NEW_QSTR(MP_QSTR_socket), (mp_obj_t)&socket_module },
 #define NETWORK_ROOT_POINTERS mp_obj_list_t mod_network_nic_list;
+// Sockets are signalled by network_module_background.
+#define MICROPY_STREAMS_READY_EVENTS (1)
 #if MICROPY_PY_WIZNET5K
     extern const struct _mp_obj_module_t wiznet_module;
     #define WIZNET_MODULE        { MP_OBJ_NEW_QSTR(MP_QSTR_wiznet), (mp_obj_t)&wiznet_module },
@@ -412,9 +558,12 @@ extern const struct _mp_obj_module_t socket_module;
 #define NETWORK_ROOT_POINTERS
 #endif
 
-// This is not a top-level module; it's microcontroller.nvm.
+// The memory itself is microcontroller.nvm. The module holds KeyValueStore.
 #if CIRCUITPY_NVM
 extern const struct _mp_obj_module_t nvm_module;
+#define NVM_MODULE             { MP_OBJ_NEW_QSTR(MP_QSTR_nvm), (mp_obj_t)&nvm_module },
+#else
+#define NVM_MODULE
 #endif
 
 #if CIRCUITPY_OS
@@ -510,6 +659,12 @@ extern const struct _mp_obj_module_t supervisor_module;
 #define SUPERVISOR_MODULE
 #endif
 
+#if CIRCUITPY_PROFILER
+#define PROFILER_ROOT_POINTERS void *profiler_samples;
+#else
+#define PROFILER_ROOT_POINTERS
+#endif
+
 #if CIRCUITPY_TIME
 extern const struct _mp_obj_module_t time_module;
 #define TIME_MODULE            { MP_OBJ_NEW_QSTR(MP_QSTR_time), (mp_obj_t)&time_module },
@@ -529,8 +684,26 @@ extern const struct _mp_obj_module_t touchio_module;
 #if CIRCUITPY_UHEAP
 extern const struct _mp_obj_module_t uheap_module;
 #define UHEAP_MODULE           { MP_OBJ_NEW_QSTR(MP_QSTR_uheap),(mp_obj_t)&uheap_module },
+#define UHEAP_ROOT_POINTERS void *uheap_alloc_profile;
 #else
 #define UHEAP_MODULE
+#define UHEAP_ROOT_POINTERS
+#endif
+
+#if CIRCUITPY_USB_CDC
+extern const struct _mp_obj_module_t usb_cdc_module;
+#define USB_CDC_MODULE         { MP_OBJ_NEW_QSTR(MP_QSTR_usb_cdc),(mp_obj_t)&usb_cdc_module },
+#else
+#define USB_CDC_MODULE
+#endif
+
+#if CIRCUITPY_USB_AUDIO
+extern const struct _mp_obj_module_t usb_audio_module;
+#define USB_AUDIO_MODULE       { MP_OBJ_NEW_QSTR(MP_QSTR_usb_audio),(mp_obj_t)&usb_audio_module },
+#define USB_AUDIO_ROOT_POINTERS mp_obj_t usb_audio_microphone_source;
+#else
+#define USB_AUDIO_MODULE
+#define USB_AUDIO_ROOT_POINTERS
 #endif
 
 #if CIRCUITPY_USB_HID
@@ -593,21 +766,26 @@ extern const struct _mp_obj_module_t ustack_module;
 // Some are omitted because they're in MICROPY_PORT_BUILTIN_MODULE_WEAK_LINKS above.
 #define MICROPY_PORT_BUILTIN_MODULES_STRONG_LINKS \
     ANALOGIO_MODULE \
+    ASMP_MODULE \
     AUDIOBUSIO_MODULE \
     AUDIOCORE_MODULE \
+    AUDIOEFFECTS_MODULE \
     AUDIOIO_MODULE \
     AUDIOMIXER_MODULE \
     AUDIOMP3_MODULE \
     AUDIOPWMIO_MODULE \
+    AUDIOSYNTH_MODULE \
     BITBANGIO_MODULE \
     BLEIO_MODULE \
     BOARD_MODULE \
     BUSIO_MODULE \
+    COUNTIO_MODULE \
     DIGITALIO_MODULE \
     DISPLAYIO_MODULE \
       FONTIO_MODULE \
       TERMINALIO_MODULE \
     ERRNO_MODULE \
+    FIXEDPOINT_MODULE \
     FREQUENCYIO_MODULE \
     GAMEPAD_MODULE \
     GAMEPADSHIFT_MODULE \
@@ -619,6 +797,7 @@ extern const struct _mp_obj_module_t ustack_module;
     NETWORK_MODULE \
       SOCKET_MODULE \
       WIZNET_MODULE \
+    NVM_MODULE \
     PEW_MODULE \
     PIXELBUF_MODULE \
     PS2IO_MODULE \
@@ -634,6 +813,8 @@ extern const struct _mp_obj_module_t ustack_module;
     SUPERVISOR_MODULE \
     TOUCHIO_MODULE \
     UHEAP_MODULE \
+    USB_AUDIO_MODULE \
+    USB_CDC_MODULE \
     USB_HID_MODULE \
     USB_MIDI_MODULE \
     USTACK_MODULE \
@@ -663,11 +844,20 @@ extern const struct _mp_obj_module_t ustack_module;
     vstr_t *repl_line; \
     mp_obj_t rtc_time_source; \
     GAMEPAD_ROOT_POINTERS \
+    AUDIOCORE_ROOT_POINTERS \
+    AUDIOMP3_ROOT_POINTERS \
+    BUSIO_ROOT_POINTERS \
+    I2CSLAVE_ROOT_POINTERS \
+    ANALOGIO_ROOT_POINTERS \
+    NEOPIXEL_WRITE_ROOT_POINTERS \
     mp_obj_t pew_singleton; \
     mp_obj_t terminal_tilegrid_tiles; \
     BOARD_UART_ROOT_POINTER \
     FLASH_ROOT_POINTERS \
     NETWORK_ROOT_POINTERS \
+    PROFILER_ROOT_POINTERS \
+    UHEAP_ROOT_POINTERS \
+    USB_AUDIO_ROOT_POINTERS \
 
 void supervisor_run_background_tasks_if_tick(void);
 #define RUN_BACKGROUND_TASKS (supervisor_run_background_tasks_if_tick())
@@ -677,18 +867,53 @@ void supervisor_run_background_tasks_if_tick(void);
 
 #define MICROPY_VM_HOOK_LOOP RUN_BACKGROUND_TASKS;
 #define MICROPY_VM_HOOK_RETURN RUN_BACKGROUND_TASKS;
+#define MICROPY_EVENT_POLL_HOOK RUN_BACKGROUND_TASKS; mp_handle_pending();
+void supervisor_idle(void);
+#define MICROPY_EVENT_WAIT_HOOK supervisor_idle();
 
 // CIRCUITPY_AUTORELOAD_DELAY_MS = 0 will completely disable autoreload.
 #ifndef CIRCUITPY_AUTORELOAD_DELAY_MS
 #define CIRCUITPY_AUTORELOAD_DELAY_MS 500
 #endif
 
+// Filesystem writes are flushed after this long without another write...
 #ifndef CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS
 #define CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS 1000
 #endif
 
+// ... or when the oldest unflushed write is this old.
+#ifndef CIRCUITPY_FILESYSTEM_FLUSH_MAX_AGE_MS
+#define CIRCUITPY_FILESYSTEM_FLUSH_MAX_AGE_MS 5000
+#endif
+
+// USB serial output is buffered this much and sent by the USB background task.
+// With 0 it's written straight into TinyUSB's FIFO.
+#ifndef CIRCUITPY_SERIAL_TX_BUFFER_SIZE
+#if CIRCUITPY_FULL_BUILD
+#define CIRCUITPY_SERIAL_TX_BUFFER_SIZE 1024
+#else
+#define CIRCUITPY_SERIAL_TX_BUFFER_SIZE 0
+#endif
+#endif
+
+#if CIRCUITPY_BACKGROUND_TRACE && !CIRCUITPY_CYCLE_COUNTER
+#error CIRCUITPY_BACKGROUND_TRACE needs CIRCUITPY_CYCLE_COUNTER
+#endif
+
+// Most recent background task and interrupt runs kept by the trace...
+#ifndef CIRCUITPY_BACKGROUND_TRACE_ENTRIES
+#define CIRCUITPY_BACKGROUND_TRACE_ENTRIES 64
+#endif
+
+// ... and how many tasks and interrupts have their longest run kept.
+#ifndef CIRCUITPY_BACKGROUND_TRACE_WORST_ENTRIES
+#define CIRCUITPY_BACKGROUND_TRACE_WORST_ENTRIES 16
+#endif
+
 #define CIRCUITPY_BOOT_OUTPUT_FILE "/boot_out.txt"
 
+#define CIRCUITPY_HEAP_IMAGE_FILE "/.heap_image"
+
 #define CIRCUITPY_VERBOSE_BLE 0
 
 #endif  // __INCLUDED_MPCONFIG_CIRCUITPY_H
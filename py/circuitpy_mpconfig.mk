@@ -79,6 +79,12 @@ CIRCUITPY_AUDIOBUSIO = $(CIRCUITPY_FULL_BUILD)
 endif
 CFLAGS += -DCIRCUITPY_AUDIOBUSIO=$(CIRCUITPY_AUDIOBUSIO)
 
+# audiobusio.I2SIn is only implemented on some ports. See circuitpy_defns.mk.
+ifndef CIRCUITPY_AUDIOBUSIO_I2SIN
+CIRCUITPY_AUDIOBUSIO_I2SIN = 0
+endif
+CFLAGS += -DCIRCUITPY_AUDIOBUSIO_I2SIN=$(CIRCUITPY_AUDIOBUSIO_I2SIN)
+
 ifndef CIRCUITPY_AUDIOIO
 CIRCUITPY_AUDIOIO = $(CIRCUITPY_FULL_BUILD)
 endif
@@ -109,6 +115,16 @@ CIRCUITPY_AUDIOMIXER = $(CIRCUITPY_AUDIOIO)
 endif
 CFLAGS += -DCIRCUITPY_AUDIOMIXER=$(CIRCUITPY_AUDIOMIXER)
 
+ifndef CIRCUITPY_AUDIOEFFECTS
+CIRCUITPY_AUDIOEFFECTS = $(CIRCUITPY_AUDIOMIXER)
+endif
+CFLAGS += -DCIRCUITPY_AUDIOEFFECTS=$(CIRCUITPY_AUDIOEFFECTS)
+
+ifndef CIRCUITPY_AUDIOSYNTH
+CIRCUITPY_AUDIOSYNTH = $(CIRCUITPY_AUDIOMIXER)
+endif
+CFLAGS += -DCIRCUITPY_AUDIOSYNTH=$(CIRCUITPY_AUDIOSYNTH)
+
 ifndef CIRCUITPY_AUDIOMP3
 ifeq ($(CIRCUITPY_FULL_BUILD),1)
 CIRCUITPY_AUDIOMP3 = $(CIRCUITPY_AUDIOCORE)
@@ -139,16 +155,33 @@ CIRCUITPY_BUSIO = $(CIRCUITPY_DEFAULT_BUILD)
 endif
 CFLAGS += -DCIRCUITPY_BUSIO=$(CIRCUITPY_BUSIO)
 
+# countio is only implemented on some ports. See the port's mpconfigport.mk.
+ifndef CIRCUITPY_COUNTIO
+CIRCUITPY_COUNTIO = 0
+endif
+CFLAGS += -DCIRCUITPY_COUNTIO=$(CIRCUITPY_COUNTIO)
+
 ifndef CIRCUITPY_DIGITALIO
 CIRCUITPY_DIGITALIO = $(CIRCUITPY_DEFAULT_BUILD)
 endif
 CFLAGS += -DCIRCUITPY_DIGITALIO=$(CIRCUITPY_DIGITALIO)
 
+# digitalio.PortIn and PortOut are only implemented on some ports. See circuitpy_defns.mk.
+ifndef CIRCUITPY_DIGITALIO_PORT
+CIRCUITPY_DIGITALIO_PORT = 0
+endif
+CFLAGS += -DCIRCUITPY_DIGITALIO_PORT=$(CIRCUITPY_DIGITALIO_PORT)
+
 ifndef CIRCUITPY_DISPLAYIO
 CIRCUITPY_DISPLAYIO = $(CIRCUITPY_FULL_BUILD)
 endif
 CFLAGS += -DCIRCUITPY_DISPLAYIO=$(CIRCUITPY_DISPLAYIO)
 
+ifndef CIRCUITPY_FIXEDPOINT
+CIRCUITPY_FIXEDPOINT = $(CIRCUITPY_FULL_BUILD)
+endif
+CFLAGS += -DCIRCUITPY_FIXEDPOINT=$(CIRCUITPY_FIXEDPOINT)
+
 ifndef CIRCUITPY_FREQUENCYIO
 CIRCUITPY_FREQUENCYIO = $(CIRCUITPY_FULL_BUILD)
 endif
@@ -231,6 +264,13 @@ CIRCUITPY_RTC = $(CIRCUITPY_DEFAULT_BUILD)
 endif
 CFLAGS += -DCIRCUITPY_RTC=$(CIRCUITPY_RTC)
 
+# CIRCUITPY_ASMP is handled in the cxd56 tree.
+# Only for CXD56 chips.
+ifndef CIRCUITPY_ASMP
+CIRCUITPY_ASMP = 0
+endif
+CFLAGS += -DCIRCUITPY_ASMP=$(CIRCUITPY_ASMP)
+
 # CIRCUITPY_SAMD is handled in the atmel-samd tree.
 # Only for SAMD chips.
 # Assume not a SAMD build.
@@ -260,6 +300,56 @@ CIRCUITPY_SUPERVISOR = $(CIRCUITPY_ALWAYS_BUILD)
 endif
 CFLAGS += -DCIRCUITPY_SUPERVISOR=$(CIRCUITPY_SUPERVISOR)
 
+# Sampling bytecode profiler in the supervisor module. Off by default because
+# it adds a store to every bytecode function call.
+ifndef CIRCUITPY_PROFILER
+CIRCUITPY_PROFILER = 0
+endif
+CFLAGS += -DCIRCUITPY_PROFILER=$(CIRCUITPY_PROFILER)
+
+# supervisor.cycle_count(), from the port's CPU cycle counter. Ports that have
+# one turn it on.
+ifndef CIRCUITPY_CYCLE_COUNTER
+CIRCUITPY_CYCLE_COUNTER = 0
+endif
+CFLAGS += -DCIRCUITPY_CYCLE_COUNTER=$(CIRCUITPY_CYCLE_COUNTER)
+
+# Background task and interrupt timing trace in the supervisor module. Off by
+# default because it times every background task and traced interrupt. Needs
+# CIRCUITPY_CYCLE_COUNTER.
+ifndef CIRCUITPY_BACKGROUND_TRACE
+CIRCUITPY_BACKGROUND_TRACE = 0
+endif
+CFLAGS += -DCIRCUITPY_BACKGROUND_TRACE=$(CIRCUITPY_BACKGROUND_TRACE)
+
+# supervisor.max_stack_usage() and max_pystack_usage(), from painting both
+# stacks when the VM starts. Safe mode after a crash also reports the C stack's.
+ifndef CIRCUITPY_STACK_HIGH_WATER
+CIRCUITPY_STACK_HIGH_WATER = $(CIRCUITPY_FULL_BUILD)
+endif
+CFLAGS += -DCIRCUITPY_STACK_HIGH_WATER=$(CIRCUITPY_STACK_HIGH_WATER)
+
+# supervisor.boot_times(), timestamps of the steps of a cold start.
+ifndef CIRCUITPY_BOOT_TIMING
+CIRCUITPY_BOOT_TIMING = $(CIRCUITPY_FULL_BUILD)
+endif
+CFLAGS += -DCIRCUITPY_BOOT_TIMING=$(CIRCUITPY_BOOT_TIMING)
+
+# Skip the safe mode reset window and start USB before mounting the
+# filesystem. Off by default because safe mode can then only be entered after a
+# crash, not by pressing reset, and boot.py runs after USB is already up.
+ifndef CIRCUITPY_FAST_BOOT
+CIRCUITPY_FAST_BOOT = 0
+endif
+CFLAGS += -DCIRCUITPY_FAST_BOOT=$(CIRCUITPY_FAST_BOOT)
+
+# supervisor.save_heap_image(), to skip code.py's imports on later runs. Off
+# by default because the modules must not hold on to hardware they set up.
+ifndef CIRCUITPY_HEAP_IMAGE
+CIRCUITPY_HEAP_IMAGE = 0
+endif
+CFLAGS += -DCIRCUITPY_HEAP_IMAGE=$(CIRCUITPY_HEAP_IMAGE)
+
 ifndef CIRCUITPY_TIME
 CIRCUITPY_TIME = $(CIRCUITPY_ALWAYS_BUILD)
 endif
@@ -282,6 +372,20 @@ CIRCUITPY_UHEAP = 0
 endif
 CFLAGS += -DCIRCUITPY_UHEAP=$(CIRCUITPY_UHEAP)
 
+# A USB audio speaker and microphone, exposed as usb_audio. Off by default because it takes three
+# isochronous endpoints, and it needs a TinyUSB that takes application class drivers.
+ifndef CIRCUITPY_USB_AUDIO
+CIRCUITPY_USB_AUDIO = 0
+endif
+CFLAGS += -DCIRCUITPY_USB_AUDIO=$(CIRCUITPY_USB_AUDIO)
+
+# A second USB CDC interface for binary data, exposed as usb_cdc.data. Off by default because it
+# takes three more endpoints.
+ifndef CIRCUITPY_USB_CDC
+CIRCUITPY_USB_CDC = 0
+endif
+CFLAGS += -DCIRCUITPY_USB_CDC=$(CIRCUITPY_USB_CDC)
+
 ifndef CIRCUITPY_USB_HID
 CIRCUITPY_USB_HID = $(CIRCUITPY_DEFAULT_BUILD)
 endif
@@ -292,6 +396,13 @@ CIRCUITPY_USB_MIDI = $(CIRCUITPY_DEFAULT_BUILD)
 endif
 CFLAGS += -DCIRCUITPY_USB_MIDI=$(CIRCUITPY_USB_MIDI)
 
+# Also run TinyUSB's task from the lowest priority interrupt. Ports that turn this on provide
+# usb_irq_task_trigger() and call usb_irq_task() from that interrupt.
+ifndef CIRCUITPY_USB_IRQ_TASK
+CIRCUITPY_USB_IRQ_TASK = 0
+endif
+CFLAGS += -DCIRCUITPY_USB_IRQ_TASK=$(CIRCUITPY_USB_IRQ_TASK)
+
 ifndef CIRCUITPY_PEW
 CIRCUITPY_PEW = 0
 endif
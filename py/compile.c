@@ -2000,6 +2000,15 @@ STATIC void compile_test_if_expr(compiler_t *comp, mp_parse_node_struct_t *pns)
     assert(MP_PARSE_NODE_IS_STRUCT_KIND(pns->nodes[1], PN_test_if_else));
     mp_parse_node_struct_t *pns_test_if_else = (mp_parse_node_struct_t*)pns->nodes[1];
 
+    // optimisation: only compile the value that is used when the condition is constant
+    if (mp_parse_node_is_const_true(pns_test_if_else->nodes[0])) {
+        compile_node(comp, pns->nodes[0]);
+        return;
+    } else if (mp_parse_node_is_const_false(pns_test_if_else->nodes[0])) {
+        compile_node(comp, pns_test_if_else->nodes[1]);
+        return;
+    }
+
     uint l_fail = comp_next_label(comp);
     uint l_end = comp_next_label(comp);
     c_if_cond(comp, pns_test_if_else->nodes[0], false, l_fail); // condition
@@ -2347,11 +2356,28 @@ STATIC void compile_comprehension(compiler_t *comp, mp_parse_node_struct_t *pns,
     // compile the comprehension
     close_over_variables_etc(comp, this_scope, 0, 0);
 
+    // pass variables captured by value, in the order of the outer scope
+    int n_by_value = 0;
+    #if MICROPY_COMP_CAPTURE_BY_VALUE
+    for (int i = 0; i < comp->scope_cur->id_info_len; i++) {
+        id_info_t *id = &comp->scope_cur->id_info[i];
+        id_info_t *id2 = scope_find(this_scope, id->qst);
+        if (id2 != NULL && (id2->flags & ID_FLAG_IS_BY_VALUE)) {
+            // An unbound variable is passed as is, so that like a cell it only
+            // raises NameError when the comprehension reads it. The outer scope
+            // is never native, so this always goes to the bytecode emitter.
+            assert(id->kind == ID_INFO_KIND_LOCAL);
+            mp_emit_bc_load_fast_unchecked(comp->emit, id->local_num);
+            n_by_value += 1;
+        }
+    }
+    #endif
+
     compile_node(comp, pns_comp_for->nodes[1]); // source of the iterator
     if (kind == SCOPE_GEN_EXPR) {
         EMIT_ARG(get_iter, false);
     }
-    EMIT_ARG(call_function, 1, 0, 0);
+    EMIT_ARG(call_function, n_by_value + 1, 0, 0);
 }
 
 STATIC void compile_atom_paren(compiler_t *comp, mp_parse_node_struct_t *pns) {
@@ -3336,6 +3362,100 @@ STATIC void scope_compute_things(scope_t *scope) {
     }
 }
 
+#if MICROPY_COMP_CAPTURE_BY_VALUE
+// List, dict and set comprehensions run to completion when they're created, and
+// can't assign to the variables they close over. So a cell that only they close
+// over can be a plain local whose value is passed to them as an argument. That
+// saves allocating the cell and, if nothing else is closed over, the closure.
+
+STATIC bool scope_runs_in_place(scope_t *scope) {
+    return scope->kind == SCOPE_LIST_COMP || scope->kind == SCOPE_DICT_COMP || scope->kind == SCOPE_SET_COMP;
+}
+
+// The scope whose variable a free variable refers to.
+STATIC scope_t *scope_free_var_owner(scope_t *scope, qstr qst) {
+    for (scope = scope->parent; scope != NULL; scope = scope->parent) {
+        id_info_t *id = scope_find(scope, qst);
+        if (id == NULL || id->kind != ID_INFO_KIND_FREE) {
+            break;
+        }
+    }
+    return scope;
+}
+
+STATIC void scope_capture_by_value(compiler_t *comp) {
+    for (scope_t *s = comp->scope_head; s != NULL; s = s->next) {
+        // the native emitters need the type of a local before it's loaded
+        if (!SCOPE_IS_FUNC_LIKE(s->kind) || s->emit_options == MP_EMIT_OPT_NATIVE_PYTHON
+            || s->emit_options == MP_EMIT_OPT_VIPER) {
+            continue;
+        }
+        for (int i = 0; i < s->id_info_len; i++) {
+            id_info_t *id = &s->id_info[i];
+            if (id->kind != ID_INFO_KIND_CELL) {
+                continue;
+            }
+            bool by_value = true;
+            for (scope_t *s2 = comp->scope_head; s2 != NULL && by_value; s2 = s2->next) {
+                id_info_t *id2 = scope_find(s2, id->qst);
+                if (id2 != NULL && id2->kind == ID_INFO_KIND_FREE
+                    && scope_free_var_owner(s2, id->qst) == s && !scope_runs_in_place(s2)) {
+                    by_value = false;
+                }
+            }
+            if (!by_value) {
+                continue;
+            }
+            for (scope_t *s2 = comp->scope_head; s2 != NULL; s2 = s2->next) {
+                id_info_t *id2 = scope_find(s2, id->qst);
+                if (id2 != NULL && id2->kind == ID_INFO_KIND_FREE && scope_free_var_owner(s2, id->qst) == s) {
+                    id2->flags |= ID_FLAG_IS_BY_VALUE;
+                }
+            }
+            // keeps its local_num, it's just not converted to a cell
+            id->kind = ID_INFO_KIND_LOCAL;
+        }
+    }
+
+    // Closed over cells come first in the arguments, followed by the values
+    // passed as arguments and then the iterator.
+    for (scope_t *s = comp->scope_head; s != NULL; s = s->next) {
+        int num_free = 0;
+        int num_by_value = 0;
+        for (int i = 0; i < s->id_info_len; i++) {
+            id_info_t *id = &s->id_info[i];
+            if (id->kind == ID_INFO_KIND_FREE) {
+                num_free += 1;
+                if (id->flags & ID_FLAG_IS_BY_VALUE) {
+                    num_by_value += 1;
+                }
+            }
+        }
+        if (num_by_value == 0) {
+            continue;
+        }
+        int next_cell = 0;
+        int next_by_value = num_free - num_by_value;
+        for (int n = 0; n < num_free; n++) {
+            for (int i = 0; i < s->id_info_len; i++) {
+                id_info_t *id = &s->id_info[i];
+                if (id->kind == ID_INFO_KIND_FREE && id->local_num == n) {
+                    // cells only move down, to numbers already searched for,
+                    // and values stop being free, so neither is found again
+                    if (id->flags & ID_FLAG_IS_BY_VALUE) {
+                        id->kind = ID_INFO_KIND_LOCAL;
+                        id->local_num = next_by_value++;
+                    } else {
+                        id->local_num = next_cell++;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+}
+#endif
+
 #if !MICROPY_PERSISTENT_CODE_SAVE
 STATIC
 #endif
@@ -3381,6 +3501,11 @@ mp_raw_code_t *mp_compile_to_raw_code(mp_parse_tree_t *parse_tree, qstr source_f
     for (scope_t *s = comp->scope_head; s != NULL && comp->compile_error == MP_OBJ_NULL; s = s->next) {
         scope_compute_things(s);
     }
+    #if MICROPY_COMP_CAPTURE_BY_VALUE
+    if (comp->compile_error == MP_OBJ_NULL) {
+        scope_capture_by_value(comp);
+    }
+    #endif
 
     // set max number of labels now that it's calculated
     emit_bc_set_max_num_labels(emit_bc, max_num_labels);
@@ -200,6 +200,7 @@ void mp_emit_bc_adjust_stack_size(emit_t *emit, mp_int_t delta);
 void mp_emit_bc_set_source_line(emit_t *emit, mp_uint_t line);
 
 void mp_emit_bc_load_local(emit_t *emit, qstr qst, mp_uint_t local_num, int kind);
+void mp_emit_bc_load_fast_unchecked(emit_t *emit, mp_uint_t local_num);
 void mp_emit_bc_load_global(emit_t *emit, qstr qst, int kind);
 void mp_emit_bc_store_local(emit_t *emit, qstr qst, mp_uint_t local_num, int kind);
 void mp_emit_bc_store_global(emit_t *emit, qstr qst, int kind);
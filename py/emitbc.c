@@ -33,6 +33,7 @@
 #include "py/mpstate.h"
 #include "py/emit.h"
 #include "py/bc0.h"
+#include "py/bc.h"
 
 #if MICROPY_ENABLE_COMPILER
 
@@ -55,6 +56,12 @@ struct _emit_t {
     mp_uint_t last_source_line_offset;
     mp_uint_t last_source_line;
 
+    // The last single byte opcode that a superinstruction could start with, and the
+    // bytecode offset just after it.  Only fused if nothing was emitted since, and
+    // cleared by anything (labels, line changes) that would be lost by fusing.
+    byte fuse_opcode;
+    size_t fuse_offset;
+
     mp_uint_t max_num_labels;
     mp_uint_t *label_offsets;
 
@@ -168,6 +175,32 @@ STATIC void emit_write_code_info_bytes_lines(emit_t *emit, mp_uint_t bytes_to_sk
 }
 #endif
 
+STATIC void emit_bc_fuse_clear(emit_t *emit) {
+    emit->fuse_opcode = 0;
+}
+
+STATIC void emit_bc_fuse_candidate(emit_t *emit, byte opcode) {
+    if (MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS_DYNAMIC) {
+        emit->fuse_opcode = opcode;
+        emit->fuse_offset = emit->bytecode_offset;
+    }
+}
+
+// If the opcode just emitted is base + i for i < n, removes it from the bytecode so
+// the caller can emit a superinstruction in its place and returns i.  Else returns -1.
+STATIC int emit_bc_fuse_take(emit_t *emit, byte base, byte n) {
+    byte opcode = emit->fuse_opcode;
+    if (MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS_DYNAMIC
+        && opcode != 0
+        && emit->fuse_offset == emit->bytecode_offset
+        && opcode >= base && opcode - base < n) {
+        emit->bytecode_offset -= 1;
+        emit->fuse_opcode = 0;
+        return opcode - base;
+    }
+    return -1;
+}
+
 // all functions must go through this one to emit byte code
 STATIC byte *emit_get_cur_to_write_bytecode(emit_t *emit, int num_bytes_to_write) {
     //printf("emit %d\n", num_bytes_to_write);
@@ -313,6 +346,7 @@ void mp_emit_bc_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scope) {
     emit->scope = scope;
     emit->last_source_line_offset = 0;
     emit->last_source_line = 1;
+    emit_bc_fuse_clear(emit);
     #ifndef NDEBUG
     // With debugging enabled labels are checked for unique assignment
     if (pass < MP_PASS_EMIT && emit->label_offsets != NULL) {
@@ -481,6 +515,7 @@ void mp_emit_bc_set_source_line(emit_t *emit, mp_uint_t source_line) {
         emit_write_code_info_bytes_lines(emit, bytes_to_skip, lines_to_skip);
         emit->last_source_line_offset = emit->bytecode_offset;
         emit->last_source_line = source_line;
+        emit_bc_fuse_clear(emit);
     }
 #else
     (void)emit;
@@ -490,6 +525,8 @@ void mp_emit_bc_set_source_line(emit_t *emit, mp_uint_t source_line) {
 
 void mp_emit_bc_label_assign(emit_t *emit, mp_uint_t l) {
     emit_bc_pre(emit, 0);
+    // a jump may land here, so the preceding opcode must stay separate
+    emit_bc_fuse_clear(emit);
     if (emit->pass == MP_PASS_SCOPE) {
         return;
     }
@@ -536,6 +573,7 @@ void mp_emit_bc_load_const_small_int(emit_t *emit, mp_int_t arg) {
     emit_bc_pre(emit, 1);
     if (-16 <= arg && arg <= 47) {
         emit_write_bytecode_byte(emit, MP_BC_LOAD_CONST_SMALL_INT_MULTI + 16 + arg);
+        emit_bc_fuse_candidate(emit, MP_BC_LOAD_CONST_SMALL_INT_MULTI + 16 + arg);
     } else {
         emit_write_bytecode_byte_int(emit, MP_BC_LOAD_CONST_SMALL_INT, arg);
     }
@@ -562,12 +600,25 @@ void mp_emit_bc_load_local(emit_t *emit, qstr qst, mp_uint_t local_num, int kind
     (void)qst;
     emit_bc_pre(emit, 1);
     if (kind == MP_EMIT_IDOP_LOCAL_FAST && local_num <= 15) {
-        emit_write_bytecode_byte(emit, MP_BC_LOAD_FAST_MULTI + local_num);
+        int prev = emit_bc_fuse_take(emit, MP_BC_LOAD_FAST_MULTI, 16);
+        if (prev >= 0) {
+            emit_write_bytecode_byte_byte(emit, MP_BC_LOAD_FAST_PAIR, prev | (local_num << 4));
+        } else {
+            emit_write_bytecode_byte(emit, MP_BC_LOAD_FAST_MULTI + local_num);
+            emit_bc_fuse_candidate(emit, MP_BC_LOAD_FAST_MULTI + local_num);
+        }
     } else {
         emit_write_bytecode_byte_uint(emit, MP_BC_LOAD_FAST_N + kind, local_num);
     }
 }
 
+#if MICROPY_COMP_CAPTURE_BY_VALUE
+void mp_emit_bc_load_fast_unchecked(emit_t *emit, mp_uint_t local_num) {
+    emit_bc_pre(emit, 1);
+    emit_write_bytecode_byte_uint(emit, MP_BC_LOAD_FAST_UNCHECKED, local_num);
+}
+#endif
+
 void mp_emit_bc_load_global(emit_t *emit, qstr qst, int kind) {
     MP_STATIC_ASSERT(MP_BC_LOAD_NAME + MP_EMIT_IDOP_GLOBAL_NAME == MP_BC_LOAD_NAME);
     MP_STATIC_ASSERT(MP_BC_LOAD_NAME + MP_EMIT_IDOP_GLOBAL_GLOBAL == MP_BC_LOAD_GLOBAL);
@@ -581,6 +632,12 @@ void mp_emit_bc_load_global(emit_t *emit, qstr qst, int kind) {
 
 void mp_emit_bc_load_method(emit_t *emit, qstr qst, bool is_super) {
     emit_bc_pre(emit, 1 - 2 * is_super);
+    int local_num = is_super ? -1 : emit_bc_fuse_take(emit, MP_BC_LOAD_FAST_MULTI, 16);
+    if (local_num >= 0) {
+        emit_write_bytecode_byte_qstr(emit, MP_BC_LOAD_FAST_METHOD, qst);
+        emit_write_bytecode_byte(emit, local_num);
+        return;
+    }
     emit_write_bytecode_byte_qstr(emit, is_super ? MP_BC_LOAD_SUPER_METHOD : MP_BC_LOAD_METHOD, qst);
 }
 
@@ -606,6 +663,15 @@ void mp_emit_bc_subscr(emit_t *emit, int kind) {
 void mp_emit_bc_attr(emit_t *emit, qstr qst, int kind) {
     if (kind == MP_EMIT_ATTR_LOAD) {
         emit_bc_pre(emit, 0);
+        // the fused form has no room for the lookup cache byte
+        if (!MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE_DYNAMIC) {
+            int local_num = emit_bc_fuse_take(emit, MP_BC_LOAD_FAST_MULTI, 16);
+            if (local_num >= 0) {
+                emit_write_bytecode_byte_qstr(emit, MP_BC_LOAD_FAST_ATTR, qst);
+                emit_write_bytecode_byte(emit, local_num);
+                return;
+            }
+        }
         emit_write_bytecode_byte_qstr(emit, MP_BC_LOAD_ATTR, qst);
     } else {
         if (kind == MP_EMIT_ATTR_DELETE) {
@@ -786,7 +852,17 @@ void mp_emit_bc_binary_op(emit_t *emit, mp_binary_op_t op) {
         op = MP_BINARY_OP_IS;
     }
     emit_bc_pre(emit, -1);
-    emit_write_bytecode_byte(emit, MP_BC_BINARY_OP_MULTI + op);
+    int op_index = 0;
+    while (op_index < 8 && mp_bc_small_int_binary_op[op_index] != op) {
+        ++op_index;
+    }
+    int arg = op_index < 8 ? emit_bc_fuse_take(emit, MP_BC_LOAD_CONST_SMALL_INT_MULTI, 32) : -1;
+    if (arg >= 0) {
+        // arg is the small int + 16
+        emit_write_bytecode_byte_byte(emit, MP_BC_BINARY_OP_SMALL_INT, (op_index << 5) | arg);
+    } else {
+        emit_write_bytecode_byte(emit, MP_BC_BINARY_OP_MULTI + op);
+    }
     if (invert) {
         emit_bc_pre(emit, 0);
         emit_write_bytecode_byte(emit, MP_BC_UNARY_OP_MULTI + MP_UNARY_OP_NOT);
@@ -34,6 +34,7 @@
 #include "py/emitglue.h"
 #include "py/runtime0.h"
 #include "py/bc.h"
+#include "py/objfun.h"
 
 #if MICROPY_DEBUG_VERBOSE // print debugging info
 #define DEBUG_PRINT (1)
@@ -143,6 +144,15 @@ mp_obj_t mp_make_function_from_raw_code(const mp_raw_code_t *rc, mp_obj_t def_ar
             break;
         #endif
         case MP_CODE_BYTECODE:
+            #if MICROPY_MODULE_FROZEN_ROM_FUN
+            // frozen functions without default args can use their prebuilt object when
+            // they are made within the globals of their own module
+            if (rc->data.u_byte.rom_fun != NULL && def_args == MP_OBJ_NULL && def_kw_args == MP_OBJ_NULL
+                && rc->data.u_byte.rom_fun->globals == mp_globals_get()) {
+                fun = MP_OBJ_FROM_PTR(rc->data.u_byte.rom_fun);
+                break;
+            }
+            #endif
             fun = mp_obj_new_fun_bc(def_args, def_kw_args, rc->data.u_byte.bytecode, rc->data.u_byte.const_table);
             break;
         default:
@@ -52,6 +52,10 @@ typedef struct _mp_raw_code_t {
             uint16_t n_obj;
             uint16_t n_raw_code;
             #endif
+            #if MICROPY_MODULE_FROZEN_ROM_FUN
+            // prebuilt function object for frozen code, or NULL
+            const struct _mp_obj_fun_bc_t *rom_fun;
+            #endif
         } u_byte;
         struct {
             void *fun_data;
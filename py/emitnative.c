@@ -77,6 +77,12 @@
 // wrapper around everything in this file
 #if N_X64 || N_X86 || N_THUMB || N_ARM || N_XTENSA
 
+// Viper floats hold the bits of an mp_float_t in a machine word, so they need
+// single precision floats or a 64-bit arch
+#define N_FLOAT (MICROPY_EMIT_NATIVE_FLOAT && (MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_FLOAT || N_X64))
+// whether float ops use the FPU, rather than calling helper functions
+#define N_THUMB_FLOAT (N_FLOAT && N_THUMB && MICROPY_EMIT_THUMB_FLOAT)
+
 // define additional generic helper macros
 #define ASM_MOV_LOCAL_IMM_VIA(as, local_num, imm, reg_temp) \
     do { \
@@ -105,6 +111,7 @@ typedef enum {
     VTYPE_PTR8 = 0x00 | MP_NATIVE_TYPE_PTR8,
     VTYPE_PTR16 = 0x00 | MP_NATIVE_TYPE_PTR16,
     VTYPE_PTR32 = 0x00 | MP_NATIVE_TYPE_PTR32,
+    VTYPE_FLOAT = 0x00 | MP_NATIVE_TYPE_FLOAT,
 
     VTYPE_PTR_NONE = 0x50 | MP_NATIVE_TYPE_PTR,
 
@@ -122,10 +129,21 @@ STATIC qstr vtype_to_qstr(vtype_kind_t vtype) {
         case VTYPE_PTR8: return MP_QSTR_ptr8;
         case VTYPE_PTR16: return MP_QSTR_ptr16;
         case VTYPE_PTR32: return MP_QSTR_ptr32;
+        #if N_FLOAT
+        case VTYPE_FLOAT: return MP_QSTR_float;
+        #endif
         case VTYPE_PTR_NONE: default: return MP_QSTR_None;
     }
 }
 
+#if N_FLOAT
+STATIC mp_uint_t float_to_bits(mp_float_t f) {
+    union { mp_float_t f; mp_uint_t u; } v = {.u = 0};
+    v.f = f;
+    return v.u;
+}
+#endif
+
 typedef struct _stack_info_t {
     vtype_kind_t vtype;
     stack_info_kind_t kind;
@@ -196,6 +214,9 @@ STATIC void emit_native_set_native_type(emit_t *emit, mp_uint_t op, mp_uint_t ar
                 case MP_QSTR_ptr8: type = VTYPE_PTR8; break;
                 case MP_QSTR_ptr16: type = VTYPE_PTR16; break;
                 case MP_QSTR_ptr32: type = VTYPE_PTR32; break;
+                #if N_FLOAT
+                case MP_QSTR_float: type = VTYPE_FLOAT; break;
+                #endif
                 default: EMIT_NATIVE_VIPER_TYPE_ERROR(emit, translate("unknown type '%q'"), arg2); return;
             }
             if (op == MP_EMIT_NATIVE_TYPE_RETURN) {
@@ -755,6 +776,12 @@ STATIC void emit_get_stack_pointer_to_reg_for_pop(emit_t *emit, mp_uint_t reg_de
                     ASM_MOV_LOCAL_IMM_VIA(emit->as, emit->stack_start + emit->stack_size - 1 - i, (uintptr_t)MP_OBJ_NEW_SMALL_INT(si->data.u_imm), reg_dest);
                     si->vtype = VTYPE_PYOBJ;
                     break;
+                #if N_FLOAT
+                case VTYPE_FLOAT:
+                    // store the bits, to be boxed below
+                    ASM_MOV_LOCAL_IMM_VIA(emit->as, emit->stack_start + emit->stack_size - 1 - i, si->data.u_imm, reg_dest);
+                    break;
+                #endif
                 default:
                     // not handled
                     mp_raise_NotImplementedError(translate("conversion to object"));
@@ -922,6 +949,13 @@ STATIC void emit_native_load_const_str(emit_t *emit, qstr qst) {
 
 STATIC void emit_native_load_const_obj(emit_t *emit, mp_obj_t obj) {
     emit_native_pre(emit);
+    #if N_FLOAT
+    if (emit->do_viper_types && mp_obj_is_float(obj)) {
+        // float constants are unboxed in viper, like small ints
+        emit_post_push_imm(emit, VTYPE_FLOAT, float_to_bits(mp_obj_float_get(obj)));
+        return;
+    }
+    #endif
     need_reg_single(emit, REG_RET, 0);
     ASM_MOV_REG_ALIGNED_IMM(emit->as, REG_RET, (mp_uint_t)obj);
     emit_post_push_reg(emit, VTYPE_PYOBJ, REG_RET);
@@ -1004,6 +1038,11 @@ STATIC void emit_native_load_global(emit_t *emit, qstr qst, int kind) {
             } else if (qst == MP_QSTR_ptr32) {
                 emit_post_push_imm(emit, VTYPE_BUILTIN_CAST, VTYPE_PTR32);
                 return;
+            #if N_FLOAT
+            } else if (qst == MP_QSTR_float) {
+                emit_post_push_imm(emit, VTYPE_BUILTIN_CAST, VTYPE_FLOAT);
+                return;
+            #endif
             }
         }
     }
@@ -1786,6 +1825,16 @@ STATIC void emit_native_unary_op(emit_t *emit, mp_unary_op_t op) {
     if (vtype == VTYPE_PYOBJ) {
         emit_call_with_imm_arg(emit, MP_F_UNARY_OP, op, REG_ARG_1);
         emit_post_push_reg(emit, VTYPE_PYOBJ, REG_RET);
+    #if N_FLOAT
+    } else if (vtype == VTYPE_FLOAT && (op == MP_UNARY_OP_POSITIVE || op == MP_UNARY_OP_NEGATIVE)) {
+        if (op == MP_UNARY_OP_NEGATIVE) {
+            // flip the sign bit
+            need_reg_single(emit, REG_ARG_3, 0);
+            ASM_MOV_REG_IMM(emit->as, REG_ARG_3, (mp_uint_t)1 << (sizeof(mp_float_t) * 8 - 1));
+            ASM_XOR_REG_REG(emit->as, REG_ARG_2, REG_ARG_3);
+        }
+        emit_post_push_reg(emit, VTYPE_FLOAT, REG_ARG_2);
+    #endif
     } else {
         adjust_stack(emit, 1);
         EMIT_NATIVE_VIPER_TYPE_ERROR(emit,
@@ -1793,6 +1842,63 @@ STATIC void emit_native_unary_op(emit_t *emit, mp_unary_op_t op) {
     }
 }
 
+#if N_FLOAT
+// arithmetic and comparison between two floats
+STATIC void emit_native_binary_op_float(emit_t *emit, mp_binary_op_t op) {
+    if (MP_BINARY_OP_INPLACE_OR <= op && op <= MP_BINARY_OP_INPLACE_POWER) {
+        op += MP_BINARY_OP_OR - MP_BINARY_OP_INPLACE_OR;
+    }
+    bool is_compare = MP_BINARY_OP_LESS <= op && op <= MP_BINARY_OP_NOT_EQUAL;
+    if (!is_compare && op != MP_BINARY_OP_ADD && op != MP_BINARY_OP_SUBTRACT
+        && op != MP_BINARY_OP_MULTIPLY && op != MP_BINARY_OP_TRUE_DIVIDE) {
+        adjust_stack(emit, -1);
+        EMIT_NATIVE_VIPER_TYPE_ERROR(emit,
+            translate("binary op %q not implemented"), mp_binary_op_method_name[op]);
+        return;
+    }
+    vtype_kind_t vtype_lhs, vtype_rhs;
+    emit_pre_pop_reg_reg(emit, &vtype_rhs, REG_ARG_3, &vtype_lhs, REG_ARG_2);
+    #if N_THUMB_FLOAT
+    need_reg_single(emit, REG_RET, 0);
+    asm_thumb_vmov_sreg_reg(emit->as, 14, REG_ARG_2);
+    asm_thumb_vmov_sreg_reg(emit->as, 15, REG_ARG_3);
+    if (is_compare) {
+        asm_thumb_vfp_op_sreg_sreg(emit->as, ASM_THUMB_VFP_OP_VCMP, 14, 15);
+        asm_thumb_vmrs_apsr_fpscr(emit->as);
+        // these conditions are false if either side is nan, except for not equal
+        static uint16_t ops[6] = {
+            ASM_THUMB_OP_ITE_MI,
+            ASM_THUMB_OP_ITE_GT,
+            ASM_THUMB_OP_ITE_EQ,
+            ASM_THUMB_OP_ITE_HI,
+            ASM_THUMB_OP_ITE_GE,
+            ASM_THUMB_OP_ITE_EQ,
+        };
+        static byte ret[6] = { 1, 1, 1, 0, 1, 0, };
+        asm_thumb_op16(emit->as, ops[op - MP_BINARY_OP_LESS]);
+        asm_thumb_mov_rlo_i8(emit->as, REG_RET, ret[op - MP_BINARY_OP_LESS]);
+        asm_thumb_mov_rlo_i8(emit->as, REG_RET, ret[op - MP_BINARY_OP_LESS] ^ 1);
+    } else {
+        uint32_t vfp_op;
+        if (op == MP_BINARY_OP_ADD) {
+            vfp_op = ASM_THUMB_VFP_OP_VADD;
+        } else if (op == MP_BINARY_OP_SUBTRACT) {
+            vfp_op = ASM_THUMB_VFP_OP_VSUB;
+        } else if (op == MP_BINARY_OP_MULTIPLY) {
+            vfp_op = ASM_THUMB_VFP_OP_VMUL;
+        } else {
+            vfp_op = ASM_THUMB_VFP_OP_VDIV;
+        }
+        asm_thumb_vfp_op_sreg_sreg_sreg(emit->as, vfp_op, 14, 14, 15);
+        asm_thumb_vmov_reg_sreg(emit->as, REG_RET, 14);
+    }
+    #else
+    emit_call_with_imm_arg(emit, MP_F_NATIVE_FLOAT_BINARY_OP, op, REG_ARG_1);
+    #endif
+    emit_post_push_reg(emit, is_compare ? VTYPE_BOOL : VTYPE_FLOAT, REG_RET);
+}
+#endif
+
 STATIC void emit_native_binary_op(emit_t *emit, mp_binary_op_t op) {
     DEBUG_printf("binary_op(" UINT_FMT ")\n", op);
     vtype_kind_t vtype_lhs = peek_vtype(emit, 1);
@@ -1963,6 +2069,10 @@ STATIC void emit_native_binary_op(emit_t *emit, mp_binary_op_t op) {
             emit_call_with_imm_arg(emit, MP_F_UNARY_OP, MP_UNARY_OP_NOT, REG_ARG_1);
         }
         emit_post_push_reg(emit, VTYPE_PYOBJ, REG_RET);
+    #if N_FLOAT
+    } else if (vtype_lhs == VTYPE_FLOAT && vtype_rhs == VTYPE_FLOAT) {
+        emit_native_binary_op_float(emit, op);
+    #endif
     } else {
         adjust_stack(emit, -1);
         EMIT_NATIVE_VIPER_TYPE_ERROR(emit,
@@ -2105,6 +2215,33 @@ STATIC void emit_native_make_closure(emit_t *emit, scope_t *scope, mp_uint_t n_c
     emit_post_push_reg(emit, VTYPE_PYOBJ, REG_RET);
 }
 
+#if N_FLOAT
+// cast the top of the stack between float and int or uint, popping the cast
+STATIC void emit_native_cast_float(emit_t *emit, vtype_kind_t vtype_from, vtype_kind_t vtype_to) {
+    vtype_kind_t vtype;
+    emit_pre_pop_reg(emit, &vtype, REG_ARG_1);
+    emit_pre_pop_discard(emit);
+    #if N_THUMB_FLOAT
+    uint32_t vfp_op;
+    if (vtype_to == VTYPE_FLOAT) {
+        vfp_op = vtype_from == VTYPE_UINT ? ASM_THUMB_VFP_OP_VCVT_F32_U32 : ASM_THUMB_VFP_OP_VCVT_F32_S32;
+    } else {
+        vfp_op = vtype_to == VTYPE_UINT ? ASM_THUMB_VFP_OP_VCVT_U32_F32 : ASM_THUMB_VFP_OP_VCVT_S32_F32;
+    }
+    asm_thumb_vmov_sreg_reg(emit->as, 15, REG_ARG_1);
+    asm_thumb_vfp_op_sreg_sreg(emit->as, vfp_op, 15, 15);
+    asm_thumb_vmov_reg_sreg(emit->as, REG_RET, 15);
+    #else
+    if (vtype_to == VTYPE_FLOAT) {
+        emit_call_with_imm_arg(emit, MP_F_NATIVE_FLOAT_FROM_INT, vtype_from, REG_ARG_2);
+    } else {
+        emit_call_with_imm_arg(emit, MP_F_NATIVE_FLOAT_TO_INT, vtype_to, REG_ARG_2);
+    }
+    #endif
+    emit_post_push_reg(emit, vtype_to, REG_RET);
+}
+#endif
+
 STATIC void emit_native_call_function(emit_t *emit, mp_uint_t n_positional, mp_uint_t n_keyword, mp_uint_t star_flags) {
     DEBUG_printf("call_function(n_pos=" UINT_FMT ", n_kw=" UINT_FMT ", star_flags=" UINT_FMT ")\n", n_positional, n_keyword, star_flags);
 
@@ -2131,6 +2268,13 @@ STATIC void emit_native_call_function(emit_t *emit, mp_uint_t n_positional, mp_u
             case VTYPE_BOOL:
             case VTYPE_INT:
             case VTYPE_UINT:
+                #if N_FLOAT
+                if (vtype_cast == VTYPE_FLOAT) {
+                    emit_native_cast_float(emit, peek_vtype(emit, 0), VTYPE_FLOAT);
+                    break;
+                }
+                #endif
+                // fallthrough
             case VTYPE_PTR:
             case VTYPE_PTR8:
             case VTYPE_PTR16:
@@ -2139,6 +2283,17 @@ STATIC void emit_native_call_function(emit_t *emit, mp_uint_t n_positional, mp_u
                 emit_fold_stack_top(emit, REG_ARG_1);
                 emit_post_top_set_vtype(emit, vtype_cast);
                 break;
+            #if N_FLOAT
+            case VTYPE_FLOAT:
+                if (vtype_cast == VTYPE_INT || vtype_cast == VTYPE_UINT) {
+                    emit_native_cast_float(emit, VTYPE_FLOAT, vtype_cast);
+                } else if (vtype_cast == VTYPE_FLOAT) {
+                    emit_fold_stack_top(emit, REG_ARG_1);
+                } else {
+                    mp_raise_NotImplementedError(translate("casting"));
+                }
+                break;
+            #endif
             default:
                 // this can happen when casting a cast: int(int)
                 mp_raise_NotImplementedError(translate("casting"));
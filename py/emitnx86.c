@@ -59,6 +59,11 @@ STATIC byte mp_f_n_args[MP_F_NUMBER_OF] = {
     [MP_F_SETUP_CODE_STATE] = 5,
     [MP_F_SMALL_INT_FLOOR_DIVIDE] = 2,
     [MP_F_SMALL_INT_MODULO] = 2,
+    #if MICROPY_EMIT_NATIVE_FLOAT
+    [MP_F_NATIVE_FLOAT_BINARY_OP] = 3,
+    [MP_F_NATIVE_FLOAT_FROM_INT] = 2,
+    [MP_F_NATIVE_FLOAT_TO_INT] = 2,
+    #endif
 };
 
 #define N_X86 (1)
@@ -28,6 +28,7 @@
 #if MICROPY_FLOAT_IMPL != MICROPY_FLOAT_IMPL_NONE
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <math.h>
@@ -426,4 +427,422 @@ int mp_format_float(FPTYPE f, char *buf, size_t buf_size, char fmt, int prec, ch
     return s - buf;
 }
 
+#if MICROPY_FLOAT_FORMAT_SHORTEST
+
+/***********************************************************************
+
+  Shortest round-trip formatting, following Ulf Adams' Ryu algorithm
+  (https://github.com/ulfjack/ryu, Boost Software License 1.0).
+
+  The float is m2 * 2^e2.  The bounds of the interval of reals that read
+  back as it are scaled by 2^e2 / 10^q, with a 125-bit approximation of
+  a power of 5, giving integers vm <= vr <= vp.  Digits are then dropped
+  from all three while vm and vp still differ, and vr is rounded.
+
+  Parsing scales the other way with the same tables, which is exact for
+  decimals of up to 17 digits.
+
+***********************************************************************/
+
+#if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_FLOAT
+#define FP_MANTISSA_BITS (23)
+#define FP_EXPONENT_BITS (8)
+typedef uint32_t fp_bits_t;
+#else
+#define FP_MANTISSA_BITS (52)
+#define FP_EXPONENT_BITS (11)
+typedef uint64_t fp_bits_t;
+#endif
+#define FP_BIAS ((1 << (FP_EXPONENT_BITS - 1)) - 1)
+
+#define POW5_INV_BITCOUNT (125)
+#define POW5_BITCOUNT (125)
+#define POW5_STEP (26)
+
+#include "py/formatfloattables.h"
+
+// ceil(log2(5^e)), or 1 when e == 0
+static inline int pow5bits(int e) {
+    return (int)(((uint32_t)e * 1217359) >> 19) + 1;
+}
+
+// floor(log10(2^e))
+static inline int log10_pow2(int e) {
+    return (int)(((uint32_t)e * 78913) >> 18);
+}
+
+// floor(log10(5^e))
+static inline int log10_pow5(int e) {
+    return (int)(((uint32_t)e * 732923) >> 20);
+}
+
+static bool multiple_of_pow5(uint64_t v, int q) {
+    for (; q > 0; --q) {
+        if (v % 5 != 0) {
+            return false;
+        }
+        v /= 5;
+    }
+    return true;
+}
+
+static inline bool multiple_of_pow2(uint64_t v, int q) {
+    return q < 64 && (v & (((uint64_t)1 << q) - 1)) == 0;
+}
+
+// floor(log2(v)), for v > 0
+static int floor_log2(uint64_t v) {
+    int n = 0;
+    for (int b = 32; b > 0; b >>= 1) {
+        if (v >> b) {
+            v >>= b;
+            n += b;
+        }
+    }
+    return n;
+}
+
+// Powers of 10 that are exact floats.
+static const FPTYPE exact_pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+    #if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_DOUBLE
+    1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    #endif
+};
+#define EXACT_POW10_MAX ((int)(sizeof(exact_pow10) / sizeof(exact_pow10[0])) - 1)
+
+// Returns the low 64 bits of a * b and stores the high 64 bits in *hi.
+static uint64_t umul128(uint64_t a, uint64_t b, uint64_t *hi) {
+    #if defined(__SIZEOF_INT128__)
+    unsigned __int128 p = (unsigned __int128)a * b;
+    *hi = (uint64_t)(p >> 64);
+    return (uint64_t)p;
+    #else
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+    uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+    uint64_t p00 = a_lo * b_lo, p01 = a_lo * b_hi, p10 = a_hi * b_lo, p11 = a_hi * b_hi;
+    uint64_t mid1 = p10 + (p00 >> 32);
+    uint64_t mid2 = p01 + (uint32_t)mid1;
+    *hi = p11 + (mid1 >> 32) + (mid2 >> 32);
+    return (mid2 << 32) | (uint32_t)p00;
+    #endif
+}
+
+// Returns (m * mul) >> j for a 128-bit mul, where 64 < j < 192 and the
+// result fits in 64 bits.
+static uint64_t mul_shift_64(uint64_t m, const uint64_t *mul, int j) {
+    assert(64 < j && j < 192);
+    uint64_t high0, high1;
+    umul128(m, mul[0], &high0);
+    uint64_t low1 = umul128(m, mul[1], &high1);
+    uint64_t sum = high0 + low1;
+    high1 += sum < high0;
+    j -= 64;
+    if (j >= 64) {
+        return high1 >> (j - 64);
+    }
+    return (high1 << (64 - j)) | (sum >> j);
+}
+
+#if !MICROPY_FLOAT_FORMAT_SHORTEST_FULL_TABLES
+// Stores the low 128 bits of ((m * mul) >> shift) + add in r, for a 128-bit
+// mul and 0 < shift < 64.
+static void mul_shift_128(uint64_t m, const uint64_t *mul, int shift, uint32_t add, uint64_t *r) {
+    uint64_t high0, high1;
+    uint64_t low0 = umul128(m, mul[0], &high0);
+    uint64_t low1 = umul128(m, mul[1], &high1);
+    uint64_t mid = high0 + low1;
+    high1 += mid < high0;
+    r[0] = (low0 >> shift) | (mid << (64 - shift));
+    r[1] = (mid >> shift) | (high1 << (64 - shift));
+    r[0] += add;
+    r[1] += r[0] < add;
+}
+
+static inline uint32_t pow5_offset(const uint32_t *offsets, int i) {
+    return (offsets[i / 16] >> ((i % 16) * 2)) & 3;
+}
+#endif
+
+// The multiplier for 5^i, using buf to build it if there is no full table.
+static const uint64_t *pow5_mul(int i, uint64_t *buf) {
+    #if MICROPY_FLOAT_FORMAT_SHORTEST_FULL_TABLES
+    (void)buf;
+    return pow5_split[i];
+    #else
+    int base = i / POW5_STEP;
+    int offset = i - base * POW5_STEP;
+    if (offset == 0) {
+        return pow5_split2[base];
+    }
+    mul_shift_128(pow5_small[offset], pow5_split2[base], pow5bits(i) - pow5bits(base * POW5_STEP),
+        pow5_offset(pow5_offsets, i), buf);
+    return buf;
+    #endif
+}
+
+// The multiplier for 1/5^i, using buf to build it if there is no full table.
+static const uint64_t *pow5_inv_mul(int i, uint64_t *buf) {
+    #if MICROPY_FLOAT_FORMAT_SHORTEST_FULL_TABLES
+    (void)buf;
+    return pow5_inv_split[i];
+    #else
+    int base = (i + POW5_STEP - 1) / POW5_STEP;
+    int offset = base * POW5_STEP - i;
+    const uint64_t *mul = pow5_inv_split2[base];
+    if (offset == 0) {
+        return mul;
+    }
+    // the table entries are rounded up by one, so take that off first
+    uint64_t mul_down[2] = {mul[0] - 1, mul[1] - (mul[0] == 0)};
+    mul_shift_128(pow5_small[offset], mul_down, pow5bits(base * POW5_STEP) - pow5bits(i),
+        1 + pow5_offset(pow5_inv_offsets, i), buf);
+    return buf;
+    #endif
+}
+
+// Computes the shortest digits * 10^exp that reads back as the positive,
+// finite, non-zero float with the given bits.  Of several such, the one
+// closest to the float is chosen.  The reader may ignore the low
+// ignore_bits of the mantissa (which must be zero in bits).
+static uint64_t format_float_shortest_digits(fp_bits_t bits, int ignore_bits, int *exp) {
+    fp_bits_t ieee_man = bits & (((fp_bits_t)1 << FP_MANTISSA_BITS) - 1);
+    int ieee_exp = (int)(bits >> FP_MANTISSA_BITS);
+    int e2;
+    uint64_t m2;
+    if (ieee_exp == 0) {
+        e2 = 1 - FP_BIAS - FP_MANTISSA_BITS - 2;
+        m2 = ieee_man;
+    } else {
+        e2 = ieee_exp - FP_BIAS - FP_MANTISSA_BITS - 2;
+        m2 = ((uint64_t)1 << FP_MANTISSA_BITS) | ieee_man;
+    }
+    assert((m2 & ((1 << ignore_bits) - 1)) == 0);
+
+    // The interval [mm, mp] around mv = 4 * m2, in quarters of the last bit
+    // of the mantissa.  It reaches halfway to the neighbouring floats, and
+    // ties read back as the float with the even mantissa.  Below a power of
+    // 2 the neighbour is closer.  With ignored bits, any float up to the
+    // next one with those bits clear reads back the same.
+    uint64_t mv = 4 * m2;
+    uint64_t mm = mv - 1 - (ieee_man != 0 || ieee_exp <= 1);
+    uint64_t mp = mv + ((uint64_t)4 << ignore_bits) - 2;
+    bool accept_lower = (m2 & 1) == 0;
+    bool accept_upper = accept_lower && ignore_bits == 0;
+
+    // Scale by 2^e2 / 10^e10.  The zeros flags record whether nothing
+    // but zeros was dropped from vm and vr, including by the scaling.
+    uint64_t buf[2];
+    uint64_t vr, vp, vm;
+    int e10;
+    bool vm_zeros = false;
+    bool vr_zeros;
+    if (e2 >= 0) {
+        // leave at least one digit to drop so that rounding is known
+        int q = log10_pow2(e2) - (e2 > 3);
+        int j = -e2 + q + POW5_INV_BITCOUNT + pow5bits(q) - 1;
+        const uint64_t *mul = pow5_inv_mul(q, buf);
+        e10 = q;
+        vr = mul_shift_64(mv, mul, j);
+        vp = mul_shift_64(mp, mul, j);
+        vm = mul_shift_64(mm, mul, j);
+        // the scaling is exact if 5^q divides the value
+        vr_zeros = multiple_of_pow5(mv, q);
+        if (accept_lower) {
+            vm_zeros = multiple_of_pow5(mm, q);
+        }
+        if (!accept_upper) {
+            vp -= multiple_of_pow5(mp, q);
+        }
+    } else {
+        int q = log10_pow5(-e2) - (-e2 > 1);
+        int i = -e2 - q;
+        int j = q - (pow5bits(i) - POW5_BITCOUNT);
+        const uint64_t *mul = pow5_mul(i, buf);
+        e10 = q + e2;
+        vr = mul_shift_64(mv, mul, j);
+        vp = mul_shift_64(mp, mul, j);
+        vm = mul_shift_64(mm, mul, j);
+        // the scaling is exact if 2^q divides the value
+        vr_zeros = multiple_of_pow2(mv, q);
+        if (accept_lower) {
+            vm_zeros = multiple_of_pow2(mm, q);
+        }
+        if (!accept_upper) {
+            vp -= multiple_of_pow2(mp, q);
+        }
+    }
+
+    // Drop digits while the bounds still differ, then more while they are
+    // zeros of an included lower bound.
+    int removed = 0;
+    int last = 0;
+    while (vp / 10 > vm / 10 || (vm_zeros && vm % 10 == 0 && vm != 0)) {
+        vm_zeros &= vm % 10 == 0;
+        vr_zeros &= last == 0;
+        last = vr % 10;
+        vr /= 10;
+        vp /= 10;
+        vm /= 10;
+        ++removed;
+    }
+    if (vr_zeros && last == 5 && vr % 2 == 0) {
+        // exactly halfway, so round to even
+        last = 4;
+    }
+    *exp = e10 + removed;
+    // round up if vr is outside the interval, or if that's closer
+    return vr + ((vr == vm && (!accept_lower || !vm_zeros)) || last >= 5);
+}
+
+FPTYPE mp_float_from_decimal(uint64_t digits, int exp) {
+    if (digits == 0) {
+        return 0;
+    }
+    if (digits <= (uint64_t)1 << (FP_MANTISSA_BITS + 1) && -EXACT_POW10_MAX <= exp && exp <= EXACT_POW10_MAX) {
+        // digits and the power of 10 are exact floats, so this rounds once
+        return exp < 0 ? (FPTYPE)digits / exact_pow10[-exp] : (FPTYPE)digits * exact_pow10[exp];
+    }
+    int n = 1;
+    for (uint64_t d = digits; d >= 10; d /= 10) {
+        ++n;
+    }
+    assert(n <= DEC_MAX_DIGITS);
+    if (n + exp <= DEC_EXP_ZERO) {
+        return 0;
+    }
+    if (n + exp >= DEC_EXP_INF) {
+        return (FPTYPE)INFINITY;
+    }
+
+    // Scale to m2 * 2^e2, with a bit or two more in m2 than the mantissa
+    // holds, and note whether that was exact.
+    uint64_t buf[2];
+    int e2;
+    uint64_t m2;
+    bool exact;
+    if (exp >= 0) {
+        e2 = floor_log2(digits) + exp + pow5bits(exp) - 1 - (FP_MANTISSA_BITS + 1);
+        int j = e2 - exp - pow5bits(exp) + POW5_BITCOUNT;
+        m2 = mul_shift_64(digits, pow5_mul(exp, buf), j);
+        exact = e2 < exp || (e2 - exp < 64 && multiple_of_pow2(digits, e2 - exp));
+    } else {
+        e2 = floor_log2(digits) + exp - pow5bits(-exp) - (FP_MANTISSA_BITS + 1);
+        int j = e2 - exp + pow5bits(-exp) - 1 + POW5_INV_BITCOUNT;
+        m2 = mul_shift_64(digits, pow5_inv_mul(-exp, buf), j);
+        exact = multiple_of_pow5(digits, -exp) && (e2 - exp <= 0 || multiple_of_pow2(digits, e2 - exp));
+    }
+
+    int ieee_exp = e2 + FP_BIAS + floor_log2(m2);
+    if (ieee_exp < 0) {
+        ieee_exp = 0;
+    }
+    if (ieee_exp > (1 << FP_EXPONENT_BITS) - 2) {
+        return (FPTYPE)INFINITY;
+    }
+
+    // Drop the extra bits, and subnormal ones, rounding half to even.
+    int shift = (ieee_exp == 0 ? 1 : ieee_exp) - e2 - FP_BIAS - FP_MANTISSA_BITS;
+    assert(0 < shift && shift < 64);
+    exact &= (m2 & (((uint64_t)1 << (shift - 1)) - 1)) == 0;
+    bool round_up = ((m2 >> (shift - 1)) & 1) && (!exact || ((m2 >> shift) & 1));
+    uint64_t ieee_man = (m2 >> shift) + round_up;
+    ieee_man &= ((uint64_t)1 << FP_MANTISSA_BITS) - 1;
+    if (ieee_man == 0 && round_up) {
+        // rounded up to the next power of 2 (or infinity)
+        ++ieee_exp;
+    }
+
+    union {
+        FPTYPE f;
+        fp_bits_t u;
+    } fb;
+    fb.u = ((fp_bits_t)ieee_exp << FP_MANTISSA_BITS) | (fp_bits_t)ieee_man;
+    return fb.f;
+}
+
+int mp_format_float_shortest(FPTYPE f, char *buf, size_t buf_size, int exp_limit, int ignore_bits) {
+    // sign, digits, "0.000", and exponent
+    #if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_FLOAT
+    assert(buf_size >= 16);
+    #else
+    assert(buf_size >= 32);
+    #endif
+    (void)buf_size;
+
+    char *s = buf;
+    if (fp_signbit(f) && !fp_isnan(f)) {
+        *s++ = '-';
+        f = -f;
+    }
+    if (fp_isinf(f) || fp_isnan(f)) {
+        *s++ = fp_isnan(f) ? 'n' : 'i';
+        *s++ = fp_isnan(f) ? 'a' : 'n';
+        *s++ = fp_isnan(f) ? 'n' : 'f';
+        *s = '\0';
+        return s - buf;
+    }
+    if (fp_iszero(f)) {
+        *s++ = '0';
+        *s = '\0';
+        return s - buf;
+    }
+
+    union {
+        FPTYPE f;
+        fp_bits_t u;
+    } fb = {f};
+    int exp;
+    uint64_t digits = format_float_shortest_digits(fb.u, ignore_bits, &exp);
+
+    char dig[20];
+    int n = 0;
+    do {
+        dig[n++] = '0' + digits % 10;
+        digits /= 10;
+    } while (digits != 0);
+    // decimal exponent of the first digit
+    int e = exp + n - 1;
+
+    if (-4 <= e && e < exp_limit) {
+        if (e < 0) {
+            *s++ = '0';
+            *s++ = '.';
+            for (int i = -1; i > e; --i) {
+                *s++ = '0';
+            }
+        }
+        for (int i = 0; i <= e || i < n; ++i) {
+            *s++ = i < n ? dig[n - 1 - i] : '0';
+            if (i == e && i + 1 < n) {
+                *s++ = '.';
+            }
+        }
+    } else {
+        *s++ = dig[n - 1];
+        if (n > 1) {
+            *s++ = '.';
+            while (--n > 0) {
+                *s++ = dig[n - 1];
+            }
+        }
+        *s++ = 'e';
+        *s++ = e < 0 ? '-' : '+';
+        if (e < 0) {
+            e = -e;
+        }
+        if (e >= 100) {
+            *s++ = '0' + e / 100;
+        }
+        *s++ = '0' + (e / 10) % 10;
+        *s++ = '0' + e % 10;
+    }
+    *s = '\0';
+
+    assert((size_t)(s + 1 - buf) <= buf_size);
+    return s - buf;
+}
+
+#endif // MICROPY_FLOAT_FORMAT_SHORTEST
+
 #endif // MICROPY_FLOAT_IMPL != MICROPY_FLOAT_IMPL_NONE
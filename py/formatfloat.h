@@ -30,6 +30,17 @@
 
 #if MICROPY_PY_BUILTINS_FLOAT
 int mp_format_float(mp_float_t f, char *buf, size_t bufSize, char fmt, int prec, char sign);
+#if MICROPY_FLOAT_FORMAT_SHORTEST
+// Formats f with the fewest digits that read back as f, in exponential
+// notation if its exponent is below -4 or at least exp_limit.  When f is
+// stored without the low ignore_bits of its mantissa, reading back as any
+// float up to the next such value is enough.  buf_size must be at least
+// 16 for single precision, 32 for double.
+int mp_format_float_shortest(mp_float_t f, char *buf, size_t buf_size, int exp_limit, int ignore_bits);
+// Returns the float nearest to digits * 10^exp, with ties to even.  digits
+// must be less than 10^17.
+mp_float_t mp_float_from_decimal(uint64_t digits, int exp);
+#endif
 #endif
 
 #endif // MICROPY_INCLUDED_PY_FORMATFLOAT_H
@@ -48,4 +48,10 @@ int mp_find_frozen_module(const char *str, size_t len, void **data);
 const char *mp_find_frozen_str(const char *str, size_t str_len, size_t *len);
 mp_import_stat_t mp_frozen_stat(const char *str);
 
+#if MICROPY_MODULE_FROZEN_ROM_FUN
+// The globals of each frozen .mpy module, which its prebuilt functions refer to.
+extern mp_obj_dict_t mp_frozen_mpy_globals[];
+extern const size_t mp_frozen_mpy_globals_len;
+#endif
+
 #endif // MICROPY_INCLUDED_PY_FROZENMOD_H
@@ -30,6 +30,7 @@
 
 #include "py/gc.h"
 #include "py/runtime.h"
+#include "py/frozenmod.h"
 
 #include "supervisor/shared/safe_mode.h"
 
@@ -74,6 +75,13 @@
 #define ATB_HEAD_TO_MARK(block) do { MP_STATE_MEM(gc_alloc_table_start)[(block) / BLOCKS_PER_ATB] |= (AT_MARK << BLOCK_SHIFT(block)); } while (0)
 #define ATB_MARK_TO_HEAD(block) do { MP_STATE_MEM(gc_alloc_table_start)[(block) / BLOCKS_PER_ATB] &= (~(AT_TAIL << BLOCK_SHIFT(block))); } while (0)
 
+#if MICROPY_GC_LAZY_SWEEP
+// live objects that a lazy sweep hasn't reached yet are still marked
+#define ATB_IS_HEAD(block) (ATB_GET_KIND(block) == AT_HEAD || ATB_GET_KIND(block) == AT_MARK)
+#else
+#define ATB_IS_HEAD(block) (ATB_GET_KIND(block) == AT_HEAD)
+#endif
+
 #define BLOCK_FROM_PTR(ptr) (((byte*)(ptr) - MP_STATE_MEM(gc_pool_start)) / BYTES_PER_BLOCK)
 #define PTR_FROM_BLOCK(block) (((block) * BYTES_PER_BLOCK + (uintptr_t)MP_STATE_MEM(gc_pool_start)))
 #define ATB_FROM_BLOCK(bl) ((bl) / BLOCKS_PER_ATB)
@@ -109,6 +117,112 @@ void __attribute__ ((noinline)) gc_log_change(uint32_t start_block, uint32_t len
 #endif
 
 // TODO waste less memory; currently requires that all entries in alloc_table have a corresponding block in pool
+#define NO_FREE_RUN ((size_t)-1)
+
+#if MICROPY_GC_SMALL_FREE_LISTS
+STATIC void gc_small_free_reset(void) {
+    memset(MP_STATE_MEM(gc_small_free_count), 0, sizeof(MP_STATE_MEM(gc_small_free_count)));
+    memset(MP_STATE_MEM(gc_small_free_next), 0, sizeof(MP_STATE_MEM(gc_small_free_next)));
+}
+
+STATIC void gc_small_free_add(size_t start, size_t len) {
+    if (len == 0 || len > MICROPY_GC_SMALL_FREE_LIST_BLOCKS) {
+        return;
+    }
+    uint8_t count = MP_STATE_MEM(gc_small_free_count)[len - 1];
+    if (count < MICROPY_GC_SMALL_FREE_LIST_LEN) {
+        MP_STATE_MEM(gc_small_free)[len - 1][count] = start;
+        MP_STATE_MEM(gc_small_free_count)[len - 1] = count + 1;
+    }
+}
+
+// Take the next hole of exactly n_blocks blocks that ends before limit_block.
+// Returns its first block, or NO_FREE_RUN if the table must be searched.
+STATIC size_t gc_small_free_take(size_t n_blocks, size_t limit_block) {
+    uint8_t *next = &MP_STATE_MEM(gc_small_free_next)[n_blocks - 1];
+    uint8_t count = MP_STATE_MEM(gc_small_free_count)[n_blocks - 1];
+    while (*next < count) {
+        size_t start = MP_STATE_MEM(gc_small_free)[n_blocks - 1][*next];
+        if (start + n_blocks > limit_block) {
+            // the rest are higher still
+            *next = count;
+            break;
+        }
+        (*next)++;
+        size_t n_free = 0;
+        while (n_free < n_blocks && ATB_GET_KIND(start + n_free) == AT_FREE) {
+            n_free++;
+        }
+        if (n_free == n_blocks) {
+            return start;
+        }
+    }
+    return NO_FREE_RUN;
+}
+#endif
+
+#if MICROPY_GC_FREE_RUN_INDEX
+
+// size class of a run of at least 2 blocks: 2-3 blocks, 4-7, 8-15, ...
+STATIC size_t gc_free_run_class(size_t n_blocks) {
+    size_t c = 0;
+    while (n_blocks >= 4 && c < MICROPY_GC_FREE_RUN_CLASSES - 1) {
+        n_blocks >>= 1;
+        c++;
+    }
+    return c;
+}
+
+STATIC void gc_free_run_add(size_t start, size_t len) {
+    if (len < 2) {
+        // single blocks are found quickly from gc_first_free_atb_index
+        return;
+    }
+    size_t c = gc_free_run_class(len);
+    uint8_t count = MP_STATE_MEM(gc_free_run_count)[c];
+    if (count < MICROPY_GC_FREE_RUN_SLOTS) {
+        MP_STATE_MEM(gc_free_runs)[c][count].start = start;
+        MP_STATE_MEM(gc_free_runs)[c][count].len = len;
+        MP_STATE_MEM(gc_free_run_count)[c] = count + 1;
+    }
+}
+
+STATIC void gc_free_run_remove(size_t c, size_t i) {
+    uint8_t count = --MP_STATE_MEM(gc_free_run_count)[c];
+    memmove(&MP_STATE_MEM(gc_free_runs)[c][i], &MP_STATE_MEM(gc_free_runs)[c][i + 1],
+        (count - i) * sizeof(MP_STATE_MEM(gc_free_runs)[c][0]));
+}
+
+// Take the first n_blocks blocks of a known free run that ends before
+// limit_block, smallest size class first. Returns the first block, or
+// NO_FREE_RUN if no such run is known and the table must be scanned.
+STATIC size_t gc_free_run_take(size_t n_blocks, size_t limit_block) {
+    for (size_t c = gc_free_run_class(n_blocks); c < MICROPY_GC_FREE_RUN_CLASSES; c++) {
+        for (size_t i = 0; i < MP_STATE_MEM(gc_free_run_count)[c];) {
+            size_t start = MP_STATE_MEM(gc_free_runs)[c][i].start;
+            size_t len = MP_STATE_MEM(gc_free_runs)[c][i].len;
+            if (len < n_blocks || start + n_blocks > limit_block) {
+                i++;
+                continue;
+            }
+            size_t n_free = 0;
+            while (n_free < n_blocks && ATB_GET_KIND(start + n_free) == AT_FREE) {
+                n_free++;
+            }
+            gc_free_run_remove(c, i);
+            if (n_free == n_blocks) {
+                gc_free_run_add(start + n_blocks, len - n_blocks);
+                return start;
+            }
+            // Blocks in the run were allocated after the sweep found it, so
+            // only the ones before them are still known to be free.
+            gc_free_run_add(start, n_free);
+        }
+    }
+    return NO_FREE_RUN;
+}
+#endif
+
 void gc_init(void *start, void *end) {
     // align end pointer on block boundary
     end = (void*)((uintptr_t)end & (~(BYTES_PER_BLOCK - 1)));
@@ -157,6 +271,32 @@ void gc_init(void *start, void *end) {
     // lived objects are allocated.
     MP_STATE_MEM(gc_lowest_long_lived_ptr) = (void*) PTR_FROM_BLOCK(MP_STATE_MEM(gc_alloc_table_byte_len * BLOCKS_PER_ATB));
 
+    #if MICROPY_GC_LAZY_SWEEP
+    MP_STATE_MEM(gc_sweep).block = gc_pool_block_len;
+    MP_STATE_MEM(gc_sweep).run_len = 0;
+    MP_STATE_MEM(gc_sweep).free_tail = false;
+    MP_STATE_MEM(gc_sweep).lazy = false;
+    #endif
+
+    #if MICROPY_GC_LONG_LIVED_PROMOTE_AFTER
+    MP_STATE_MEM(gc_collections_since_promote) = 0;
+    MP_STATE_MEM(gc_promote_len) = 0;
+    #endif
+
+    #if MICROPY_GC_SMALL_FREE_LISTS
+    gc_small_free_reset();
+    #endif
+
+    #if MICROPY_GC_FREE_RUN_INDEX
+    // The whole pool is one free run.
+    memset(MP_STATE_MEM(gc_free_run_count), 0, sizeof(MP_STATE_MEM(gc_free_run_count)));
+    gc_free_run_add(0, gc_pool_block_len);
+    #endif
+
+    #if MICROPY_GC_THREAD_CACHE
+    MP_STATE_THREAD(gc_cache_len) = 0;
+    #endif
+
     // unlock the GC
     MP_STATE_MEM(gc_lock_depth) = 0;
 
@@ -214,11 +354,96 @@ bool gc_is_locked(void) {
 #endif
 #endif
 
+#if MICROPY_GC_LONG_LIVED_PROMOTE_AFTER
+// Index of the first promotion candidate at or after block.
+STATIC size_t gc_promote_index(size_t block) {
+    size_t lo = 0;
+    size_t hi = MP_STATE_MEM(gc_promote_len);
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (MP_STATE_MEM(gc_promote_blocks)[mid] < block) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Called for every pointer to a head block that marking finds, whether or
+// not the block is already marked.
+STATIC void gc_promote_count_ref(size_t block) {
+    size_t i = gc_promote_index(block);
+    if (i < MP_STATE_MEM(gc_promote_len) && MP_STATE_MEM(gc_promote_blocks)[i] == block &&
+        MP_STATE_MEM(gc_promote_refs)[i] < UINT8_MAX) {
+        MP_STATE_MEM(gc_promote_refs)[i]++;
+    }
+}
+
+#define GC_PROMOTE_COUNT_REF(block) \
+    do { \
+        if (MP_STATE_MEM(gc_promote_len) != 0) { \
+            gc_promote_count_ref(block); \
+        } \
+    } while (0)
+
+bool gc_promote_add(void *ptr) {
+    // Only the start of a short lived allocation can be moved.
+    if (!VERIFY_PTR(ptr) || ptr >= MP_STATE_MEM(gc_lowest_long_lived_ptr)) {
+        return false;
+    }
+    size_t block = BLOCK_FROM_PTR(ptr);
+    if ((void *)PTR_FROM_BLOCK(block) != ptr || ATB_GET_KIND(block) == AT_FREE || ATB_GET_KIND(block) == AT_TAIL) {
+        return false;
+    }
+    size_t len = MP_STATE_MEM(gc_promote_len);
+    size_t i = gc_promote_index(block);
+    if (i < len && MP_STATE_MEM(gc_promote_blocks)[i] == block) {
+        return true;
+    }
+    if (len == MICROPY_GC_LONG_LIVED_PROMOTE_MAX) {
+        return false;
+    }
+    memmove(&MP_STATE_MEM(gc_promote_blocks)[i + 1], &MP_STATE_MEM(gc_promote_blocks)[i], (len - i) * sizeof(size_t));
+    memmove(&MP_STATE_MEM(gc_promote_refs)[i + 1], &MP_STATE_MEM(gc_promote_refs)[i], len - i);
+    MP_STATE_MEM(gc_promote_blocks)[i] = block;
+    MP_STATE_MEM(gc_promote_refs)[i] = 0;
+    MP_STATE_MEM(gc_promote_len) = len + 1;
+    return true;
+}
+
+size_t gc_promote_refs(const void *ptr) {
+    if (!VERIFY_PTR(ptr)) {
+        return 0;
+    }
+    size_t block = BLOCK_FROM_PTR(ptr);
+    size_t i = gc_promote_index(block);
+    if (i == MP_STATE_MEM(gc_promote_len) || MP_STATE_MEM(gc_promote_blocks)[i] != block) {
+        return 0;
+    }
+    return MP_STATE_MEM(gc_promote_refs)[i];
+}
+
+// A block allocated where a freed candidate was isn't the one that was counted.
+STATIC void gc_promote_forget(size_t block) {
+    size_t i = gc_promote_index(block);
+    if (i < MP_STATE_MEM(gc_promote_len) && MP_STATE_MEM(gc_promote_blocks)[i] == block) {
+        MP_STATE_MEM(gc_promote_refs)[i] = 0;
+    }
+}
+
+void gc_promote_clear(void) {
+    MP_STATE_MEM(gc_promote_len) = 0;
+}
+#else
+#define GC_PROMOTE_COUNT_REF(block)
+#endif
+
 // Take the given block as the topmost block on the stack. Check all it's
 // children: mark the unmarked child blocks and put those newly marked
 // blocks on the stack. When all children have been checked, pop off the
 // topmost block on the stack and repeat with that one.
-STATIC void gc_mark_subtree(size_t block) {
+STATIC void PLACE_IN_ITCM(gc_mark_subtree)(size_t block) {
     // Start with the block passed in the argument.
     size_t sp = 0;
     for (;;) {
@@ -235,6 +460,7 @@ STATIC void gc_mark_subtree(size_t block) {
             if (VERIFY_PTR(ptr)) {
                 // Mark and push this pointer
                 size_t childblock = BLOCK_FROM_PTR(ptr);
+                GC_PROMOTE_COUNT_REF(childblock);
                 if (ATB_GET_KIND(childblock) == AT_HEAD) {
                     // an unmarked head, mark it, and push it on gc stack
                     TRACE_MARK(childblock, ptr);
@@ -272,13 +498,48 @@ STATIC void gc_deal_with_stack_overflow(void) {
     }
 }
 
-STATIC void gc_sweep(void) {
+#define GC_TRACK_FREE_RUNS (MICROPY_GC_FREE_RUN_INDEX || MICROPY_GC_SMALL_FREE_LISTS || MICROPY_GC_LAZY_SWEEP)
+
+STATIC void gc_sweep_begin(mp_gc_sweep_t *sweep) {
     #if MICROPY_PY_GC_COLLECT_RETVAL
     MP_STATE_MEM(gc_collected) = 0;
     #endif
+    #if MICROPY_GC_FREE_RUN_INDEX
+    memset(MP_STATE_MEM(gc_free_run_count), 0, sizeof(MP_STATE_MEM(gc_free_run_count)));
+    #endif
+    #if MICROPY_GC_SMALL_FREE_LISTS
+    gc_small_free_reset();
+    #endif
+    sweep->block = 0;
+    sweep->run_len = 0;
+    sweep->free_tail = false;
+}
+
+// Sweep from sweep->block up to end_block. Returns the longest run of free
+// blocks seen, counting those just before sweep->block. Unless finalise is
+// set, stops early at the first object with a finaliser to run.
+STATIC size_t gc_sweep_blocks(mp_gc_sweep_t *sweep, size_t end_block, bool finalise) {
+    #if GC_TRACK_FREE_RUNS
+    size_t run_len = sweep->run_len;
+    size_t max_run = 0;
+    #endif
     // free unmarked heads and their tails
-    int free_tail = 0;
-    for (size_t block = 0; block < MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB; block++) {
+    int free_tail = sweep->free_tail;
+    size_t total_blocks = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB;
+    size_t block;
+    // Don't stop partway through freeing an object. A free head followed by
+    // tails would make gc_alloc, gc_realloc and gc_nbytes take those tails
+    // as part of whatever is allocated at the head next.
+    for (block = sweep->block;
+         block < end_block || (free_tail && block < total_blocks && ATB_GET_KIND(block) == AT_TAIL);
+         block++) {
+        #if MICROPY_ENABLE_FINALISER
+        if (!finalise && ATB_GET_KIND(block) == AT_HEAD && FTB_GET(block)) {
+            break;
+        }
+        #else
+        (void)finalise;
+        #endif
         switch (ATB_GET_KIND(block)) {
             case AT_HEAD:
 #if MICROPY_ENABLE_FINALISER
@@ -332,13 +593,113 @@ STATIC void gc_sweep(void) {
                 free_tail = 0;
                 break;
         }
+
+        #if GC_TRACK_FREE_RUNS
+        if (ATB_GET_KIND(block) == AT_FREE) {
+            if (++run_len > max_run) {
+                max_run = run_len;
+            }
+        } else {
+            #if MICROPY_GC_FREE_RUN_INDEX
+            gc_free_run_add(block - run_len, run_len);
+            #endif
+            #if MICROPY_GC_SMALL_FREE_LISTS
+            gc_small_free_add(block - run_len, run_len);
+            #endif
+            run_len = 0;
+        }
+        #endif
     }
+    sweep->block = block;
+    sweep->free_tail = free_tail;
+    #if GC_TRACK_FREE_RUNS
+    #if MICROPY_GC_FREE_RUN_INDEX
+    if (block == total_blocks) {
+        gc_free_run_add(block - run_len, run_len);
+    }
+    #endif
+    sweep->run_len = run_len;
+    return max_run;
+    #else
+    return 0;
+    #endif
 }
 
+STATIC void gc_sweep(void) {
+    #if MICROPY_GC_LAZY_SWEEP
+    mp_gc_sweep_t *sweep = &MP_STATE_MEM(gc_sweep);
+    #else
+    mp_gc_sweep_t sweep_state;
+    mp_gc_sweep_t *sweep = &sweep_state;
+    #endif
+    gc_sweep_begin(sweep);
+    gc_sweep_blocks(sweep, MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB, true);
+}
+
+#if MICROPY_GC_LAZY_SWEEP
+// Until the sweep reaches them, blocks are only kept if they're marked. An
+// allocation made there (or grown into there) must be marked too.
+STATIC void gc_sweep_protect(size_t head, size_t end_block) {
+    mp_gc_sweep_t *sweep = &MP_STATE_MEM(gc_sweep);
+    if (head >= sweep->block) {
+        ATB_HEAD_TO_MARK(head);
+    } else if (end_block >= sweep->block) {
+        // its tails continue past where the sweep stopped
+        sweep->free_tail = false;
+        sweep->run_len = 0;
+    } else if (sweep->block - end_block - 1 < sweep->run_len) {
+        // it was part of the free run the sweep is in
+        sweep->run_len = sweep->block - end_block - 1;
+    }
+}
+
+// Must be called with the GC entered and locked.
+STATIC void gc_sweep_finish(void) {
+    gc_sweep_blocks(&MP_STATE_MEM(gc_sweep), MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB, true);
+}
+
+bool gc_sweep_step(size_t n_blocks, bool finalise) {
+    GC_ENTER();
+    mp_gc_sweep_t *sweep = &MP_STATE_MEM(gc_sweep);
+    size_t total_blocks = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB;
+    if (MP_STATE_MEM(gc_pool_start) == 0 || MP_STATE_MEM(gc_lock_depth) > 0 || sweep->block >= total_blocks) {
+        GC_EXIT();
+        return false;
+    }
+    // finalisers run by the sweep mustn't allocate, as in gc_collect
+    MP_STATE_MEM(gc_lock_depth)++;
+    size_t first_atb = sweep->block / BLOCKS_PER_ATB;
+    size_t start_block = sweep->block;
+    size_t step_end;
+    size_t max_run;
+    do {
+        step_end = MIN(sweep->block + MICROPY_GC_SWEEP_STEP_BLOCKS, total_blocks);
+        max_run = gc_sweep_blocks(sweep, step_end, finalise);
+    } while (max_run < n_blocks && sweep->block >= step_end && sweep->block < total_blocks);
+    if (sweep->block == start_block) {
+        // stopped at an object whose finaliser it may not run
+        MP_STATE_MEM(gc_lock_depth)--;
+        GC_EXIT();
+        return false;
+    }
+    // the newly freed blocks may be outside the range gc_alloc searches
+    if (first_atb < MP_STATE_MEM(gc_first_free_atb_index)) {
+        MP_STATE_MEM(gc_first_free_atb_index) = first_atb;
+    }
+    if ((sweep->block - 1) / BLOCKS_PER_ATB > MP_STATE_MEM(gc_last_free_atb_index)) {
+        MP_STATE_MEM(gc_last_free_atb_index) = (sweep->block - 1) / BLOCKS_PER_ATB;
+    }
+    MP_STATE_MEM(gc_lock_depth)--;
+    GC_EXIT();
+    return true;
+}
+#endif
+
 // Mark can handle NULL pointers because it verifies the pointer is within the heap bounds.
 STATIC void gc_mark(void* ptr) {
     if (VERIFY_PTR(ptr)) {
         size_t block = BLOCK_FROM_PTR(ptr);
+        GC_PROMOTE_COUNT_REF(block);
         if (ATB_GET_KIND(block) == AT_HEAD) {
             // An unmarked head: mark it, and mark all its children
             TRACE_MARK(block, ptr);
@@ -348,9 +709,49 @@ STATIC void gc_mark(void* ptr) {
     }
 }
 
+// Registered roots outlive the heap because they're in static memory.
+STATIC gc_root_t *gc_roots;
+
+STATIC void gc_root_add(gc_root_t *root) {
+    for (gc_root_t *r = gc_roots; r != NULL; r = r->next) {
+        if (r == root) {
+            return;
+        }
+    }
+    root->next = gc_roots;
+    gc_roots = root;
+}
+
+void gc_root_add_ptrs(gc_root_t *root, void **ptrs, size_t len) {
+    root->ptrs = ptrs;
+    root->len = len;
+    root->collect = NULL;
+    gc_root_add(root);
+}
+
+void gc_root_add_collect(gc_root_t *root, void (*collect)(void)) {
+    root->ptrs = NULL;
+    root->len = 0;
+    root->collect = collect;
+    gc_root_add(root);
+}
+
+void gc_root_remove(gc_root_t *root) {
+    for (gc_root_t **r = &gc_roots; *r != NULL; r = &(*r)->next) {
+        if (*r == root) {
+            *r = root->next;
+            return;
+        }
+    }
+}
+
 void gc_collect_start(void) {
     GC_ENTER();
     MP_STATE_MEM(gc_lock_depth)++;
+    #if MICROPY_GC_LAZY_SWEEP
+    // marks left by the last collection must be swept before marking again
+    gc_sweep_finish();
+    #endif
     #if MICROPY_GC_ALLOC_THRESHOLD
     MP_STATE_MEM(gc_alloc_amount) = 0;
     #endif
@@ -366,6 +767,20 @@ void gc_collect_start(void) {
 
     gc_mark(MP_STATE_MEM(permanent_pointers));
 
+    for (gc_root_t *root = gc_roots; root != NULL; root = root->next) {
+        if (root->collect != NULL) {
+            root->collect();
+        } else {
+            gc_collect_root(root->ptrs, root->len);
+        }
+    }
+
+    #if MICROPY_MODULE_FROZEN_ROM_FUN
+    // The globals dicts of frozen modules are static but their tables are on the heap.
+    gc_collect_root((void**)(void*)mp_frozen_mpy_globals,
+        mp_frozen_mpy_globals_len * sizeof(mp_obj_dict_t) / sizeof(void*));
+    #endif
+
     #if MICROPY_ENABLE_PYSTACK
     // Trace root pointers from the Python stack.
     ptrs = (void**)(void*)MP_STATE_THREAD(pystack_start);
@@ -386,9 +801,24 @@ void gc_collect_root(void **ptrs, size_t len) {
 
 void gc_collect_end(void) {
     gc_deal_with_stack_overflow();
+    #if MICROPY_GC_LAZY_SWEEP
+    if (MP_STATE_MEM(gc_sweep).lazy) {
+        // gc_alloc and gc_sweep_step sweep the heap bit by bit from here
+        MP_STATE_MEM(gc_sweep).lazy = false;
+        gc_sweep_begin(&MP_STATE_MEM(gc_sweep));
+    } else {
+        gc_sweep();
+    }
+    #else
     gc_sweep();
+    #endif
     MP_STATE_MEM(gc_first_free_atb_index) = 0;
     MP_STATE_MEM(gc_last_free_atb_index) = MP_STATE_MEM(gc_alloc_table_byte_len) - 1;
+    #if MICROPY_GC_LONG_LIVED_PROMOTE_AFTER
+    if (MP_STATE_MEM(gc_collections_since_promote) < MICROPY_GC_LONG_LIVED_PROMOTE_AFTER) {
+        MP_STATE_MEM(gc_collections_since_promote)++;
+    }
+    #endif
     MP_STATE_MEM(gc_lock_depth)--;
     GC_EXIT();
 }
@@ -396,8 +826,16 @@ void gc_collect_end(void) {
 void gc_sweep_all(void) {
     GC_ENTER();
     MP_STATE_MEM(gc_lock_depth)++;
+    #if MICROPY_GC_LAZY_SWEEP
+    // unmark objects the last sweep hadn't reached so they're freed too
+    gc_sweep_finish();
+    #endif
     MP_STATE_MEM(gc_stack_overflow) = 0;
     gc_collect_end();
+    #if MICROPY_GC_THREAD_CACHE
+    // everything was freed, including the blocks this thread had taken
+    MP_STATE_THREAD(gc_cache_len) = 0;
+    #endif
 }
 
 void gc_info(gc_info_t *info) {
@@ -420,6 +858,7 @@ void gc_info(gc_info_t *info) {
                 break;
 
             case AT_HEAD:
+            case AT_MARK: // live, but not reached yet by a lazy sweep
                 info->used += 1;
                 len = 1;
                 break;
@@ -428,10 +867,6 @@ void gc_info(gc_info_t *info) {
                 info->used += 1;
                 len += 1;
                 break;
-
-            case AT_MARK:
-                // shouldn't happen
-                break;
         }
 
         block++;
@@ -441,7 +876,7 @@ void gc_info(gc_info_t *info) {
             kind = ATB_GET_KIND(block);
         }
 
-        if (finish || kind == AT_FREE || kind == AT_HEAD) {
+        if (finish || kind == AT_FREE || kind == AT_HEAD || kind == AT_MARK) {
             if (len == 1) {
                 info->num_1block += 1;
             } else if (len == 2) {
@@ -450,7 +885,7 @@ void gc_info(gc_info_t *info) {
             if (len > info->max_block) {
                 info->max_block = len;
             }
-            if (finish || kind == AT_HEAD) {
+            if (finish || kind == AT_HEAD || kind == AT_MARK) {
                 if (len_free > info->max_free) {
                     info->max_free = len_free;
                 }
@@ -464,6 +899,203 @@ void gc_info(gc_info_t *info) {
     GC_EXIT();
 }
 
+void gc_census(gc_census_callback_t allocation, void *arg, size_t *free_runs, size_t n_free_runs) {
+    GC_ENTER();
+    MP_STATE_MEM(gc_lock_depth)++;
+    #if MICROPY_GC_LAZY_SWEEP
+    // a head the sweep hasn't reached yet may be garbage
+    gc_sweep_finish();
+    MP_STATE_MEM(gc_first_free_atb_index) = 0;
+    MP_STATE_MEM(gc_last_free_atb_index) = MP_STATE_MEM(gc_alloc_table_byte_len) - 1;
+    #endif
+    size_t total_blocks = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB;
+    for (size_t block = 0; block < total_blocks;) {
+        size_t kind = ATB_GET_KIND(block);
+        size_t len = 1;
+        while (block + len < total_blocks && ATB_GET_KIND(block + len) == (kind == AT_FREE ? AT_FREE : AT_TAIL)) {
+            len++;
+        }
+        if (kind == AT_FREE) {
+            size_t i = 0;
+            while (i + 1 < n_free_runs && (len >> (i + 1)) != 0) {
+                i++;
+            }
+            free_runs[i]++;
+        } else {
+            allocation((void *)PTR_FROM_BLOCK(block), len * BYTES_PER_BLOCK, arg);
+        }
+        block += len;
+    }
+    MP_STATE_MEM(gc_lock_depth)--;
+    GC_EXIT();
+}
+
+#if MICROPY_GC_IMAGE
+// Where the heap an image was saved from lies. An image only loads into a heap
+// at the same address, so that the pointers inside it stay valid.
+typedef struct _gc_image_header_t {
+    byte *alloc_table_start;
+    byte *pool_start;
+    byte *pool_end;
+    void *lowest_long_lived_ptr;
+    void **permanent_pointers;
+} gc_image_header_t;
+
+// Passes each allocated run of blocks to io, lowest first. Free blocks aren't
+// part of an image.
+STATIC bool gc_image_blocks(gc_image_io_t io, void *arg) {
+    size_t total_blocks = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB;
+    for (size_t block = 0; block < total_blocks;) {
+        bool is_free = ATB_GET_KIND(block) == AT_FREE;
+        size_t len = 1;
+        while (block + len < total_blocks && (ATB_GET_KIND(block + len) == AT_FREE) == is_free) {
+            len++;
+        }
+        if (!is_free && !io((void *)PTR_FROM_BLOCK(block), len * BYTES_PER_BLOCK, arg)) {
+            return false;
+        }
+        block += len;
+    }
+    return true;
+}
+
+// Writes the allocation tables and then the allocated blocks. Roots aren't
+// saved: the caller saves whichever it means to restore after gc_image_load.
+bool gc_image_save(gc_image_io_t write, void *arg) {
+    GC_ENTER();
+    MP_STATE_MEM(gc_lock_depth)++;
+    #if MICROPY_GC_LAZY_SWEEP
+    // unswept garbage would be saved as allocated
+    gc_sweep_finish();
+    MP_STATE_MEM(gc_first_free_atb_index) = 0;
+    MP_STATE_MEM(gc_last_free_atb_index) = MP_STATE_MEM(gc_alloc_table_byte_len) - 1;
+    #endif
+    gc_image_header_t header = {
+        .alloc_table_start = MP_STATE_MEM(gc_alloc_table_start),
+        .pool_start = MP_STATE_MEM(gc_pool_start),
+        .pool_end = MP_STATE_MEM(gc_pool_end),
+        .lowest_long_lived_ptr = MP_STATE_MEM(gc_lowest_long_lived_ptr),
+        .permanent_pointers = MP_STATE_MEM(permanent_pointers),
+    };
+    bool ok = write(&header, sizeof(header), arg)
+        && write(MP_STATE_MEM(gc_alloc_table_start), MP_STATE_MEM(gc_pool_start) - MP_STATE_MEM(gc_alloc_table_start), arg)
+        && gc_image_blocks(write, arg);
+    MP_STATE_MEM(gc_lock_depth)--;
+    GC_EXIT();
+    return ok;
+}
+
+// Loads an image into a heap fresh from gc_init. If the image doesn't fit this
+// heap nothing is changed, and if reading fails part way the heap is emptied
+// again. Either way false is returned.
+bool gc_image_load(gc_image_io_t read, void *arg) {
+    gc_image_header_t header;
+    if (!read(&header, sizeof(header), arg) ||
+        header.alloc_table_start != MP_STATE_MEM(gc_alloc_table_start) ||
+        header.pool_start != MP_STATE_MEM(gc_pool_start) ||
+        header.pool_end != MP_STATE_MEM(gc_pool_end)) {
+        return false;
+    }
+    GC_ENTER();
+    MP_STATE_MEM(gc_lock_depth)++;
+    // the tables come first so that gc_image_blocks walks the same runs as the save did
+    bool ok = read(MP_STATE_MEM(gc_alloc_table_start), MP_STATE_MEM(gc_pool_start) - MP_STATE_MEM(gc_alloc_table_start), arg)
+        && gc_image_blocks(read, arg);
+    MP_STATE_MEM(gc_lock_depth)--;
+    GC_EXIT();
+    if (!ok) {
+        gc_init(MP_STATE_MEM(gc_alloc_table_start), MP_STATE_MEM(gc_pool_end));
+        return false;
+    }
+    MP_STATE_MEM(gc_lowest_long_lived_ptr) = header.lowest_long_lived_ptr;
+    MP_STATE_MEM(permanent_pointers) = header.permanent_pointers;
+    // gc_init indexed the whole pool as free
+    #if MICROPY_GC_FREE_RUN_INDEX
+    memset(MP_STATE_MEM(gc_free_run_count), 0, sizeof(MP_STATE_MEM(gc_free_run_count)));
+    #endif
+    #if MICROPY_GC_SMALL_FREE_LISTS
+    gc_small_free_reset();
+    #endif
+    return true;
+}
+#endif
+
+#if MICROPY_GC_THREAD_CACHE
+// Takes up to MICROPY_GC_THREAD_CACHE free single blocks from the start of the
+// heap for this thread. It never collects: when none are found before the
+// long lived section gc_alloc goes the usual way.
+STATIC void gc_thread_cache_refill(void) {
+    GC_ENTER();
+    if (MP_STATE_MEM(gc_lock_depth) > 0
+        #if MICROPY_GC_ALLOC_THRESHOLD
+        || (MP_STATE_MEM(gc_auto_collect_enabled) && MP_STATE_MEM(gc_alloc_amount) >= MP_STATE_MEM(gc_alloc_threshold))
+        #endif
+        ) {
+        GC_EXIT();
+        return;
+    }
+    size_t crossover_block = BLOCK_FROM_PTR(MP_STATE_MEM(gc_lowest_long_lived_ptr));
+    size_t last = MP_STATE_MEM(gc_last_free_atb_index);
+    #if MICROPY_GC_LAZY_SWEEP
+    if (MP_STATE_MEM(gc_sweep).block / BLOCKS_PER_ATB < last) {
+        last = MP_STATE_MEM(gc_sweep).block / BLOCKS_PER_ATB;
+    }
+    #endif
+    // Fill from the top so the lowest block is handed out first.
+    void **cache = MP_STATE_THREAD(gc_cache);
+    size_t n = MICROPY_GC_THREAD_CACHE;
+    for (size_t i = MP_STATE_MEM(gc_first_free_atb_index); n > 0 && i <= last; i++) {
+        byte a = MP_STATE_MEM(gc_alloc_table_start)[i];
+        for (size_t j = 0; n > 0 && j < BLOCKS_PER_ATB; j++) {
+            if ((a & (0x3 << (j * 2))) != 0) {
+                continue;
+            }
+            size_t block = i * BLOCKS_PER_ATB + j;
+            if (block >= crossover_block) {
+                i = last;
+                break;
+            }
+            #ifdef LOG_HEAP_ACTIVITY
+            gc_log_change(block, 1);
+            #endif
+            ATB_FREE_TO_HEAD(block);
+            #if MICROPY_GC_LAZY_SWEEP
+            gc_sweep_protect(block, block);
+            #endif
+            cache[--n] = (void*)PTR_FROM_BLOCK(block);
+            MP_STATE_MEM(gc_first_free_atb_index) = (block + 1) / BLOCKS_PER_ATB;
+        }
+    }
+    size_t len = MICROPY_GC_THREAD_CACHE - n;
+    if (n > 0) {
+        memmove(cache, cache + n, len * sizeof(void*));
+        memset(cache + len, 0, n * sizeof(void*));
+    }
+    #if MICROPY_GC_ALLOC_THRESHOLD
+    MP_STATE_MEM(gc_alloc_amount) += len;
+    #endif
+    MP_STATE_THREAD(gc_cache_len) = len;
+    GC_EXIT();
+    for (size_t k = 0; k < len; k++) {
+        memset(cache[k], 0, BYTES_PER_BLOCK);
+    }
+}
+
+// Frees the blocks this thread holds. Returns whether there were any.
+STATIC bool gc_thread_cache_flush(void) {
+    size_t len = MP_STATE_THREAD(gc_cache_len);
+    if (len == 0) {
+        return false;
+    }
+    MP_STATE_THREAD(gc_cache_len) = 0;
+    while (len > 0) {
+        gc_free(MP_STATE_THREAD(gc_cache)[--len]);
+        MP_STATE_THREAD(gc_cache)[len] = NULL;
+    }
+    return true;
+}
+#endif
+
 // We place long lived objects at the end of the heap rather than the start. This reduces
 // fragmentation by localizing the heap churn to one portion of memory (the start of the heap.)
 void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
@@ -479,6 +1111,26 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
         reset_into_safe_mode(GC_ALLOC_OUTSIDE_VM);
     }
 
+    #if MICROPY_GC_THREAD_CACHE
+    // Blocks in the cache are already marked as used and zeroed, and are
+    // found by a collection through this thread's state.
+    if (n_blocks == 1 && !has_finaliser && !long_lived && MP_STATE_MEM(gc_lock_depth) == 0) {
+        if (MP_STATE_THREAD(gc_cache_len) == 0) {
+            gc_thread_cache_refill();
+        }
+        size_t len = MP_STATE_THREAD(gc_cache_len);
+        if (len > 0) {
+            void *ret_ptr = MP_STATE_THREAD(gc_cache)[--len];
+            MP_STATE_THREAD(gc_cache)[len] = NULL;
+            MP_STATE_THREAD(gc_cache_len) = len;
+            #if MICROPY_GC_ALLOC_PROFILE
+            gc_alloc_profile_record(n_bytes);
+            #endif
+            return ret_ptr;
+        }
+    }
+    #endif
+
     GC_ENTER();
 
     // check if GC is locked
@@ -496,6 +1148,9 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
     #if MICROPY_GC_ALLOC_THRESHOLD
     if (!collected && MP_STATE_MEM(gc_alloc_amount) >= MP_STATE_MEM(gc_alloc_threshold)) {
         GC_EXIT();
+        #if MICROPY_GC_LAZY_SWEEP
+        MP_STATE_MEM(gc_sweep).lazy = true;
+        #endif
         gc_collect();
         collected = 1;
         GC_ENTER();
@@ -507,16 +1162,51 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
     // When we start searching on the other side of the crossover block we make sure to
     // perform a collect. That way we'll get the closest free block in our section.
     size_t crossover_block = BLOCK_FROM_PTR(MP_STATE_MEM(gc_lowest_long_lived_ptr));
+    // whether found_block came from a list rather than a search from the start
+    bool listed = false;
     while (keep_looking) {
+        #if MICROPY_GC_SMALL_FREE_LISTS
+        if (!long_lived && n_blocks <= MICROPY_GC_SMALL_FREE_LIST_BLOCKS) {
+            size_t block = gc_small_free_take(n_blocks, collected ? NO_FREE_RUN : crossover_block);
+            if (block != NO_FREE_RUN) {
+                found_block = block + n_blocks - 1;
+                n_free = n_blocks;
+                listed = true;
+                break;
+            }
+        }
+        #endif
+        #if MICROPY_GC_FREE_RUN_INDEX
+        // Short lived allocations come from the start of the heap, which is
+        // what the index holds first.
+        if (!long_lived && n_blocks > 1) {
+            size_t block = gc_free_run_take(n_blocks, collected ? NO_FREE_RUN : crossover_block);
+            if (block != NO_FREE_RUN) {
+                found_block = block + n_blocks - 1;
+                n_free = n_blocks;
+                listed = true;
+                break;
+            }
+        }
+        #endif
         int8_t direction = 1;
         size_t start = MP_STATE_MEM(gc_first_free_atb_index);
+        size_t last = MP_STATE_MEM(gc_last_free_atb_index);
         if (long_lived) {
             direction = -1;
-            start = MP_STATE_MEM(gc_last_free_atb_index);
+            start = last;
         }
+        #if MICROPY_GC_LAZY_SWEEP
+        // Dead objects past where a lazy sweep stopped aren't free yet, so a
+        // search through them costs time proportional to the heap. Sweep
+        // another step instead.
+        if (!long_lived && MP_STATE_MEM(gc_sweep).block / BLOCKS_PER_ATB < last) {
+            last = MP_STATE_MEM(gc_sweep).block / BLOCKS_PER_ATB;
+        }
+        #endif
         n_free = 0;
         // look for a run of n_blocks available blocks
-        for (size_t i = start; keep_looking && MP_STATE_MEM(gc_first_free_atb_index) <= i && i <= MP_STATE_MEM(gc_last_free_atb_index); i += direction) {
+        for (size_t i = start; keep_looking && MP_STATE_MEM(gc_first_free_atb_index) <= i && i <= last; i += direction) {
             byte a = MP_STATE_MEM(gc_alloc_table_start)[i];
             // Four ATB states are packed into a single byte.
             int j = 0;
@@ -546,11 +1236,30 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
         }
 
         GC_EXIT();
+        #if MICROPY_GC_LAZY_SWEEP
+        // sweeping more of the heap may free enough without collecting
+        if (gc_sweep_step(n_blocks, true)) {
+            keep_looking = true;
+            GC_ENTER();
+            continue;
+        }
+        #endif
+        #if MICROPY_GC_THREAD_CACHE
+        // the blocks this thread holds may be what's missing
+        if (gc_thread_cache_flush()) {
+            keep_looking = true;
+            GC_ENTER();
+            continue;
+        }
+        #endif
         // nothing found!
         if (collected) {
             return NULL;
         }
         DEBUG_printf("gc_alloc(" UINT_FMT "): no free mem, triggering GC\n", n_bytes);
+        #if MICROPY_GC_LAZY_SWEEP
+        MP_STATE_MEM(gc_sweep).lazy = true;
+        #endif
         gc_collect();
         collected = true;
         // Try again since we've hopefully freed up space.
@@ -568,13 +1277,13 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
     if (!long_lived) {
         end_block = found_block;
         start_block = found_block - n_free + 1;
-        if (n_blocks == 1) {
+        if (n_blocks == 1 && !listed) {
             MP_STATE_MEM(gc_first_free_atb_index) = (found_block + 1) / BLOCKS_PER_ATB;
         }
     } else {
         start_block = found_block;
         end_block = found_block + n_free - 1;
-        if (n_blocks == 1) {
+        if (n_blocks == 1 && !listed) {
             MP_STATE_MEM(gc_last_free_atb_index) = (found_block - 1) / BLOCKS_PER_ATB;
         }
     }
@@ -592,6 +1301,10 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
         ATB_FREE_TO_TAIL(bl);
     }
 
+    #if MICROPY_GC_LAZY_SWEEP
+    gc_sweep_protect(start_block, end_block);
+    #endif
+
     // get pointer to first block
     // we must create this pointer before unlocking the GC so a collection can find it
     void *ret_ptr = (void*)(MP_STATE_MEM(gc_pool_start) + start_block * BYTES_PER_BLOCK);
@@ -639,6 +1352,10 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
     gc_dump_alloc_table();
     #endif
 
+    #if MICROPY_GC_ALLOC_PROFILE
+    gc_alloc_profile_record(n_bytes);
+    #endif
+
     return ret_ptr;
 }
 
@@ -673,12 +1390,18 @@ void gc_free(void *ptr) {
         // get the GC block number corresponding to this pointer
         assert(VERIFY_PTR(ptr));
         size_t block = BLOCK_FROM_PTR(ptr);
-        assert(ATB_GET_KIND(block) == AT_HEAD);
+        assert(ATB_IS_HEAD(block));
 
         #if MICROPY_ENABLE_FINALISER
         FTB_CLEAR(block);
         #endif
 
+        #if MICROPY_GC_LONG_LIVED_PROMOTE_AFTER
+        if (MP_STATE_MEM(gc_promote_len) != 0) {
+            gc_promote_forget(block);
+        }
+        #endif
+
         // set the last_free pointer to this block if it's earlier in the heap
         if (block / BLOCKS_PER_ATB < MP_STATE_MEM(gc_first_free_atb_index)) {
             MP_STATE_MEM(gc_first_free_atb_index) = block / BLOCKS_PER_ATB;
@@ -708,7 +1431,7 @@ size_t gc_nbytes(const void *ptr) {
     GC_ENTER();
     if (VERIFY_PTR(ptr)) {
         size_t block = BLOCK_FROM_PTR(ptr);
-        if (ATB_GET_KIND(block) == AT_HEAD) {
+        if (ATB_IS_HEAD(block)) {
             // work out number of consecutive blocks in the chain starting with this on
             size_t n_blocks = 0;
             do {
@@ -821,7 +1544,7 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
     // get the GC block number corresponding to this pointer
     assert(VERIFY_PTR(ptr));
     size_t block = BLOCK_FROM_PTR(ptr);
-    assert(ATB_GET_KIND(block) == AT_HEAD);
+    assert(ATB_IS_HEAD(block));
 
     // compute number of new blocks that are requested
     size_t new_blocks = (n_bytes + BYTES_PER_BLOCK - 1) / BYTES_PER_BLOCK;
@@ -893,6 +1616,9 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
             assert(ATB_GET_KIND(bl) == AT_FREE);
             ATB_FREE_TO_TAIL(bl);
         }
+        #if MICROPY_GC_LAZY_SWEEP
+        gc_sweep_protect(block, block + new_blocks - 1);
+        #endif
 
         GC_EXIT();
 
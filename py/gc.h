@@ -53,20 +53,61 @@ bool gc_is_locked(void);
 
 // A given port must implement gc_collect by using the other collect functions.
 void gc_collect(void);
+#if MICROPY_GC_ALLOC_PROFILE
+// Called after each successful allocation, with the GC unlocked.
+void gc_alloc_profile_record(size_t n_bytes);
+#endif
+
 void gc_collect_start(void);
 void gc_collect_ptr(void *ptr);
 void gc_collect_root(void **ptrs, size_t len);
 void gc_collect_end(void);
 
+// Memory outside the heap that holds heap pointers, such as a static struct
+// in a C module, can be registered so every collection marks it. Register
+// only the slots that hold pointers, or a function that marks them with
+// gc_collect_ptr(). Buffers of pixels or samples should never be registered
+// because random data in them keeps garbage alive. The gc_root_t is owned by
+// the caller and must stay valid until it's removed; registering it again is
+// harmless.
+typedef struct _gc_root_t {
+    struct _gc_root_t *next;
+    void **ptrs;
+    size_t len;
+    void (*collect)(void);
+} gc_root_t;
+
+void gc_root_add_ptrs(gc_root_t *root, void **ptrs, size_t len);
+void gc_root_add_collect(gc_root_t *root, void (*collect)(void));
+void gc_root_remove(gc_root_t *root);
+
 void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived);
 
 // Use this function to sweep the whole heap and run all finalisers
 void gc_sweep_all(void);
 
+#if MICROPY_GC_LAZY_SWEEP
+// Continue a sweep left by an automatic collection, one step at a time until
+// a free run of n_blocks has been seen. Unless finalise is set, the sweep stops
+// at the first object with a finaliser, to be left for a sweep that may run
+// Python code. Returns false if nothing was swept.
+bool gc_sweep_step(size_t n_blocks, bool finalise);
+#endif
+
 void gc_free(void *ptr); // does not call finaliser
 size_t gc_nbytes(const void *ptr);
 bool gc_has_finaliser(const void *ptr);
 void *gc_make_long_lived(void *old_ptr);
+
+#if MICROPY_GC_LONG_LIVED_PROMOTE_AFTER
+// Collections count the references to the blocks added with gc_promote_add, so
+// that a block is only moved when its one reference can be updated. Returns
+// false if ptr isn't the start of a short lived block or there's no room.
+bool gc_promote_add(void *ptr);
+// References the last collection found to ptr, or 0 if it wasn't added.
+size_t gc_promote_refs(const void *ptr);
+void gc_promote_clear(void);
+#endif
 void *gc_realloc(void *ptr, size_t n_bytes, bool allow_move);
 
 // Prevents a pointer from ever being freed because it establishes a permanent reference to it. Use
@@ -84,6 +125,20 @@ typedef struct _gc_info_t {
 } gc_info_t;
 
 void gc_info(gc_info_t *info);
+
+// Calls allocation with every allocated block of the heap and its size in bytes, then adds the
+// free runs of blocks to free_runs, where free_runs[i] counts runs of 2**i to 2**(i+1)-1 blocks
+// and the last entry takes the longer ones too. The GC is locked so allocation can't allocate.
+typedef void (*gc_census_callback_t)(void *ptr, size_t n_bytes, void *arg);
+void gc_census(gc_census_callback_t allocation, void *arg, size_t *free_runs, size_t n_free_runs);
+
+#if MICROPY_GC_IMAGE
+// Reads or writes len bytes at buf. Returns false on failure.
+typedef bool (*gc_image_io_t)(void *buf, size_t len, void *arg);
+bool gc_image_save(gc_image_io_t write, void *arg);
+bool gc_image_load(gc_image_io_t read, void *arg);
+#endif
+
 void gc_dump_info(void);
 void gc_dump_alloc_table(void);
 
@@ -28,6 +28,7 @@
 #include "py/gc_long_lived.h"
 #include "py/gc.h"
 #include "py/mpstate.h"
+#include "py/objtuple.h"
 
 mp_obj_fun_bc_t *make_fun_bc_long_lived(mp_obj_fun_bc_t *fun_bc, uint8_t max_depth) {
     #ifndef MICROPY_ENABLE_GC
@@ -147,3 +148,145 @@ mp_obj_t make_obj_long_lived(mp_obj_t obj, uint8_t max_depth){
         return gc_make_long_lived(obj);
     }
 }
+
+#if MICROPY_GC_LONG_LIVED_PROMOTE_AFTER
+// The collector is conservative, so a block can only be moved once a collection has found exactly
+// one reference to it: the slot or tuple item that promote_value then updates. Everything else
+// keeps its identity. Only values compared by value are considered, so that a block the count
+// skips costs nothing but the chance to move it.
+
+STATIC void select_block(const void *ptr) {
+    gc_promote_add((void *)ptr);
+}
+
+// Moves the block at ptr if it's safe to, and frees the old copy.
+STATIC void *promote_block(void *ptr) {
+    if (gc_promote_refs(ptr) != 1) {
+        return ptr;
+    }
+    void *new_ptr = gc_make_long_lived(ptr);
+    if (new_ptr != ptr) {
+        gc_free(ptr);
+    }
+    return new_ptr;
+}
+
+// Before the collection, adds obj and what it holds as candidates. After it, moves them.
+STATIC mp_obj_t promote_value(mp_obj_t obj, uint8_t max_depth, bool move) {
+    if (max_depth == 0 || !MP_OBJ_IS_OBJ(obj) || !VERIFY_PTR((void *)MP_OBJ_TO_PTR(obj))) {
+        return obj;
+    }
+    if (MP_OBJ_IS_TYPE(obj, &mp_type_str) || MP_OBJ_IS_TYPE(obj, &mp_type_bytes)) {
+        mp_obj_str_t *str = MP_OBJ_TO_PTR(obj);
+        if (!move) {
+            select_block(str->data);
+            select_block(str);
+            return obj;
+        }
+        // The data moves on its own if something else shares it.
+        if (gc_promote_refs(str) == 1) {
+            str->data = promote_block((byte *)str->data);
+        }
+        return MP_OBJ_FROM_PTR(promote_block(str));
+    }
+    #if MICROPY_PY_BUILTINS_FLOAT && MICROPY_OBJ_REPR != MICROPY_OBJ_REPR_C && MICROPY_OBJ_REPR != MICROPY_OBJ_REPR_D
+    if (MP_OBJ_IS_TYPE(obj, &mp_type_float)) {
+        if (!move) {
+            select_block(MP_OBJ_TO_PTR(obj));
+            return obj;
+        }
+        return MP_OBJ_FROM_PTR(promote_block(MP_OBJ_TO_PTR(obj)));
+    }
+    #endif
+    if (MP_OBJ_IS_TYPE(obj, &mp_type_tuple)) {
+        mp_obj_tuple_t *tuple = MP_OBJ_TO_PTR(obj);
+        if (move) {
+            tuple = promote_block(tuple);
+        } else {
+            select_block(tuple);
+        }
+        // An item only referenced by the tuple is updated in place, even when the tuple itself
+        // stays put, because everything that sees the item sees it through this tuple.
+        for (size_t i = 0; i < tuple->len; i++) {
+            mp_obj_t item = promote_value(tuple->items[i], max_depth - 1, move);
+            if (move) {
+                tuple->items[i] = item;
+            }
+        }
+        return MP_OBJ_FROM_PTR(tuple);
+    }
+    return obj;
+}
+
+STATIC void promote_map(mp_map_t *map, bool move) {
+    if (map->is_fixed) {
+        return;
+    }
+    for (size_t i = 0; i < map->alloc; i++) {
+        if (MP_MAP_SLOT_IS_FILLED(map, i)) {
+            mp_obj_t value = promote_value(map->table[i].value, 4, move);
+            if (move) {
+                map->table[i].value = value;
+            }
+        }
+    }
+}
+
+STATIC void promote_globals(mp_obj_dict_t *globals, bool move) {
+    promote_map(&globals->map, move);
+    if (globals->map.is_fixed) {
+        return;
+    }
+    // Class attributes live as long as the class does.
+    for (size_t i = 0; i < globals->map.alloc; i++) {
+        if (MP_MAP_SLOT_IS_FILLED(&globals->map, i)) {
+            mp_obj_t value = globals->map.table[i].value;
+            if (MP_OBJ_IS_TYPE(value, &mp_type_type)) {
+                mp_obj_type_t *type = MP_OBJ_TO_PTR(value);
+                if (type->locals_dict != NULL && VERIFY_PTR((void *)type->locals_dict)) {
+                    promote_map(&type->locals_dict->map, move);
+                }
+            }
+        }
+    }
+}
+
+STATIC void promote_all(bool move) {
+    promote_globals(&MP_STATE_VM(dict_main), move);
+    mp_map_t *modules = &MP_STATE_VM(mp_loaded_modules_dict).map;
+    for (size_t i = 0; i < modules->alloc; i++) {
+        if (MP_MAP_SLOT_IS_FILLED(modules, i) &&
+            MP_OBJ_IS_TYPE(modules->table[i].value, &mp_type_module)) {
+            promote_globals(mp_obj_module_get_globals(modules->table[i].value), move);
+        }
+    }
+}
+#endif
+
+void gc_long_lived_collect(void) {
+    #if MICROPY_GC_LONG_LIVED_PROMOTE_AFTER
+    if (MP_STATE_MEM(gc_collections_since_promote) < MICROPY_GC_LONG_LIVED_PROMOTE_AFTER ||
+        MP_STATE_MEM(gc_lock_depth) > 0
+        #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
+        // Without the GIL another thread could take a reference after the collection counted them.
+        || !mp_thread_is_only_thread()
+        #endif
+        ) {
+        gc_collect();
+        return;
+    }
+    promote_all(false);
+    gc_collect();
+    MP_STATE_MEM(gc_collections_since_promote) = 0;
+    // No code runs between the collection and the moves, so the references it counted are still
+    // all there are. Collecting again while moving would sweep lazily and leave the blocks to be
+    // freed marked.
+    bool auto_collect = MP_STATE_MEM(gc_auto_collect_enabled);
+    MP_STATE_MEM(gc_auto_collect_enabled) = false;
+    promote_all(true);
+    MP_STATE_MEM(gc_auto_collect_enabled) = auto_collect;
+    gc_promote_clear();
+    #else
+    gc_collect();
+    #endif
+}
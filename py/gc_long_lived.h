@@ -40,4 +40,10 @@ mp_obj_dict_t *make_dict_long_lived(mp_obj_dict_t *dict, uint8_t max_depth);
 mp_obj_str_t *make_str_long_lived(mp_obj_str_t *str);
 mp_obj_t make_obj_long_lived(mp_obj_t obj, uint8_t max_depth);
 
+// Collects garbage like gc_collect. Call between bytecodes. Every
+// MICROPY_GC_LONG_LIVED_PROMOTE_AFTER collections it also moves the values that module globals and
+// classes have held onto to the long lived portion of the heap, where that collection found no
+// other reference to them.
+void gc_long_lived_collect(void);
+
 #endif // MICROPY_INCLUDED_PY_GC_LONG_LIVED_H
@@ -75,13 +75,39 @@ C_ESCAPES = {
 }
 
 # this must match the equivalent function in qstr.c
-def compute_hash(qstr, bytes_hash):
+def compute_full_hash(qstr):
     hash = 5381
     for b in qstr:
-        hash = (hash * 33) ^ b
+        hash = ((hash * 33) ^ b) & 0xffffffff
+    return hash
+
+# this must match the equivalent function in qstr.c
+def compute_hash(qstr, bytes_hash):
+    hash = compute_full_hash(qstr)
     # Make sure that valid hash is never zero, zero means "hash not computed"
     return (hash & ((1 << (8 * bytes_hash)) - 1)) or 1
 
+# this must match Q_INDEX_SLOT in qstr.c
+def index_slot(full_hash, mask):
+    return (full_hash ^ (full_hash >> 16)) & mask
+
+# Builds the open addressed hash index of a pool. Each slot holds a position in the pool plus one
+# or 0 when empty. It is kept at most three quarters full.
+def make_index(pool_qstrs):
+    length = 1
+    while length * 3 < len(pool_qstrs) * 4 + 1:
+        length *= 2
+    mask = length - 1
+    index = [0] * length
+    for i, qstr in enumerate(pool_qstrs):
+        if qstr is None:
+            continue
+        slot = index_slot(compute_full_hash(bytes_cons(qstr, 'utf8')), mask)
+        while index[slot] != 0:
+            slot = (slot + 1) & mask
+        index[slot] = i + 1
+    return index
+
 def translate(translation_file, i18ns):
     with open(translation_file, "rb") as f:
         table = gettext.GNUTranslations(f)
@@ -132,9 +158,25 @@ def compute_huffman_coding(translations, qstrs, compression_filename):
     print("// estimated total memory size", len(lengths) + 2*len(values) + sum(len(cb[u]) for u in all_strings_concat))
     print("//", values, lengths)
     values_type = "uint16_t" if max(ord(u) for u in values) > 255 else "uint8_t"
+    # Entry i decodes the code of at most 8 bits that starts the 8 bits i. It holds the code length
+    # in the top 4 bits and the index into values, or is 0 when the code is longer.
+    decode_table = [0] * 256
+    code = 0
+    index = 0
+    for length, count in enumerate(lengths, 1):
+        for _ in range(count):
+            if length <= 8:
+                for suffix in range(1 << (8 - length)):
+                    decode_table[code << (8 - length) | suffix] = length << 12 | index
+            code += 1
+            index += 1
+        code <<= 1
     with open(compression_filename, "w") as f:
         f.write("const uint8_t lengths[] = {{ {} }};\n".format(", ".join(map(str, lengths))))
         f.write("const {} values[] = {{ {} }};\n".format(values_type, ", ".join(str(ord(u)) for u in values)))
+        f.write("#if CIRCUITPY_TRANSLATE_DECODE_TABLE\n")
+        f.write("const uint16_t decode_table[] = {{ {} }};\n".format(", ".join(map(str, decode_table))))
+        f.write("#endif\n")
     return values, lengths
 
 def decompress(encoding_table, length, encoded):
@@ -335,10 +377,19 @@ def print_qstr_data(encoding_table, qcfgs, qstrs, i18ns):
     total_qstr_size = 0
     total_qstr_compressed_size = 0
     # go through each qstr and print it out
+    pool_qstrs = [None]
     for order, ident, qstr in sorted(qstrs.values(), key=lambda x: x[0]):
         qbytes = make_bytes(cfg_bytes_len, cfg_bytes_hash, qstr)
         print('QDEF(MP_QSTR_%s, %s)' % (ident, qbytes))
         total_qstr_size += len(qstr)
+        pool_qstrs.append(qstr)
+
+    # print the hash index of the pool, leaving out the NULL qstr
+    index = make_index(pool_qstrs)
+    print('#ifdef QINDEX')
+    for i in range(0, len(index), 16):
+        print('QINDEX(%s)' % ', '.join(str(entry) for entry in index[i:i + 16]))
+    print('#endif')
 
     total_text_size = 0
     total_text_compressed_size = 0
@@ -73,9 +73,27 @@ STATIC size_t get_hash_alloc_greater_or_equal_to(size_t x) {
     return (x + x / 2) | 1;
 }
 
+#if MICROPY_OPT_MAP_LOOKUP_CACHE
+// The cache is indexed by the key alone, and each entry holds the position in whichever
+// map the key was last found in.  A hit is confirmed by comparing the key in that slot,
+// so stale or colliding entries just fall back to the normal search.
+#define MAP_CACHE_ENTRY(index) (MP_STATE_VM(map_lookup_cache)[(((uintptr_t)(index)) >> 2) & (MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE - 1)])
+#define MAP_CACHE_SET(index, pos) (MAP_CACHE_ENTRY(index) = (pos) & 0xff)
+#else
+#define MAP_CACHE_SET(index, pos) (void)0
+#endif
+
+// Ordered maps that aren't fixed can be added to and removed from.
+#define MAP_ORDERED_MUTABLE (MICROPY_PY_COLLECTIONS_ORDEREDDICT || MICROPY_MAP_COMPACT_MAX > 0)
+
 /******************************************************************************/
 /* map                                                                        */
 
+STATIC void mp_map_set_compact(mp_map_t *map, size_t n) {
+    map->is_compact = MICROPY_MAP_COMPACT_MAX > 0 && n <= MICROPY_MAP_COMPACT_MAX;
+    map->is_ordered = map->is_compact;
+}
+
 void mp_map_init(mp_map_t *map, size_t n) {
     if (n == 0) {
         map->alloc = 0;
@@ -87,7 +105,7 @@ void mp_map_init(mp_map_t *map, size_t n) {
     map->used = 0;
     map->all_keys_are_qstrs = 1;
     map->is_fixed = 0;
-    map->is_ordered = 0;
+    mp_map_set_compact(map, n);
 }
 
 void mp_map_init_fixed_table(mp_map_t *map, size_t n, const mp_obj_t *table) {
@@ -96,6 +114,7 @@ void mp_map_init_fixed_table(mp_map_t *map, size_t n, const mp_obj_t *table) {
     map->all_keys_are_qstrs = 1;
     map->is_fixed = 1;
     map->is_ordered = 1;
+    map->is_compact = 0;
     map->table = (mp_map_elem_t*)table;
 }
 
@@ -115,6 +134,10 @@ void mp_map_clear(mp_map_t *map) {
     map->used = 0;
     map->all_keys_are_qstrs = 1;
     map->is_fixed = 0;
+    if (map->is_compact || !map->is_ordered) {
+        // an OrderedDict stays ordered, anything else starts small again
+        mp_map_set_compact(map, 0);
+    }
     map->table = NULL;
 }
 
@@ -143,7 +166,7 @@ STATIC void mp_map_rehash(mp_map_t *map) {
 //  - returns slot, with key non-null and value=MP_OBJ_NULL if it was added
 // MP_MAP_LOOKUP_REMOVE_IF_FOUND behaviour:
 //  - returns NULL if not found, else the slot if was found in with key null and value non-null
-mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t lookup_kind) {
+mp_map_elem_t *PLACE_IN_ITCM(mp_map_lookup)(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t lookup_kind) {
     // If the map is a fixed array then we must only be called for a lookup
     assert(!map->is_fixed || lookup_kind == MP_MAP_LOOKUP);
 
@@ -166,11 +189,22 @@ mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t
         }
     }
 
+    #if MICROPY_OPT_MAP_LOOKUP_CACHE
+    // Try the position this key was last found at.  Only an identical key counts as a hit,
+    // anything else (including equal but distinct keys) goes through the full search below.
+    if (lookup_kind != MP_MAP_LOOKUP_REMOVE_IF_FOUND && map->alloc != 0) {
+        size_t pos = MAP_CACHE_ENTRY(index);
+        if (pos < map->alloc && map->table[pos].key == index) {
+            return &map->table[pos];
+        }
+    }
+    #endif
+
     // if the map is an ordered array then we must do a brute force linear search
     if (map->is_ordered) {
         for (mp_map_elem_t *elem = &map->table[0], *top = &map->table[map->used]; elem < top; elem++) {
             if (elem->key == index || (!compare_only_ptrs && mp_obj_equal(elem->key, index))) {
-                #if MICROPY_PY_COLLECTIONS_ORDEREDDICT
+                #if MAP_ORDERED_MUTABLE
                 if (MP_UNLIKELY(lookup_kind == MP_MAP_LOOKUP_REMOVE_IF_FOUND)) {
                     // remove the found element by moving the rest of the array down
                     mp_obj_t value = elem->value;
@@ -182,21 +216,43 @@ mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t
                     elem->value = value;
                 }
                 #endif
+                MAP_CACHE_SET(index, elem - map->table);
                 return elem;
             }
         }
-        #if MICROPY_PY_COLLECTIONS_ORDEREDDICT
+        #if MAP_ORDERED_MUTABLE
         if (MP_LIKELY(lookup_kind != MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)) {
             return NULL;
         }
+        #if MICROPY_MAP_COMPACT_MAX
+        if (map->is_compact && (map->used == MICROPY_MAP_COMPACT_MAX || !MP_OBJ_IS_QSTR(index))) {
+            // too big, or about to need mp_obj_equal, for a linear search
+            map->is_compact = 0;
+            map->is_ordered = 0;
+            if (map->used != 0) {
+                mp_map_rehash(map);
+            }
+            // an empty map keeps its preallocated size, as a hash table would
+            return mp_map_lookup(map, index, lookup_kind);
+        }
+        #endif
         if (map->used == map->alloc) {
             // TODO: Alloc policy
-            map->alloc += 4;
-            map->table = m_renew(mp_map_elem_t, map->table, map->used, map->alloc);
-            mp_seq_clear(map->table, map->used, map->alloc, sizeof(*map->table));
+            size_t new_alloc = map->alloc + 4;
+            #if MICROPY_MAP_COMPACT_MAX
+            if (map->is_compact) {
+                // grow a GC block at a time
+                new_alloc = MIN(map->alloc + 2, MICROPY_MAP_COMPACT_MAX);
+            }
+            #endif
+            map->table = m_renew(mp_map_elem_t, map->table, map->alloc, new_alloc);
+            mp_seq_clear(map->table, map->alloc, new_alloc, sizeof(*map->table));
+            map->alloc = new_alloc;
         }
         mp_map_elem_t *elem = map->table + map->used++;
         elem->key = index;
+        // a removed element may have been left here
+        elem->value = MP_OBJ_NULL;
         if (!MP_OBJ_IS_QSTR(index)) {
             map->all_keys_are_qstrs = 0;
         }
@@ -263,6 +319,8 @@ mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t
                     slot->key = MP_OBJ_SENTINEL;
                 }
                 // keep slot->value so that caller can access it if needed
+            } else {
+                MAP_CACHE_SET(index, pos);
             }
             return slot;
         }
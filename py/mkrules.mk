@@ -115,6 +115,12 @@ ifneq ($(FROZEN_MPY_DIRS),)
 $(MPY_CROSS): $(TOP)/py/*.[ch] $(TOP)/mpy-cross/*.[ch] $(TOP)/ports/windows/fmode.c
 	$(Q)$(MAKE) -C $(TOP)/mpy-cross
 
+# Set FROZEN_MPY_BUNDLE = 1 to also make const() values imported from other frozen modules known
+# to mpy-cross, which compiles each file on its own.
+ifeq ($(FROZEN_MPY_BUNDLE),1)
+PREPROCESS_FROZEN_MODULES_FLAGS += --bundle
+endif
+
 # Copy all the modules and single python files to freeze to a common area, omitting top-level dirs (the repo names).
 # Do any preprocessing necessary: currently, this adds version information, removes examples, and
 # non-library .py files in the modules (setup.py and conf.py)
@@ -122,7 +128,7 @@ $(MPY_CROSS): $(TOP)/py/*.[ch] $(TOP)/mpy-cross/*.[ch] $(TOP)/ports/windows/fmod
 $(BUILD)/frozen_mpy: $(FROZEN_MPY_DIRS)
 	$(ECHO) FREEZE $(FROZEN_MPY_DIRS)
 	$(Q)$(MKDIR) -p $@
-	$(Q)$(PREPROCESS_FROZEN_MODULES) -o $@ $(FROZEN_MPY_DIRS)
+	$(Q)$(PREPROCESS_FROZEN_MODULES) $(PREPROCESS_FROZEN_MODULES_FLAGS) -o $@ $(FROZEN_MPY_DIRS)
 	$(Q)$(CD) $@ && \
 $(FIND) -L . -type f -name '*.py' | sed 's=^\./==' | \
 xargs -n1 "$(abspath $(MPY_CROSS))" $(MPY_CROSS_FLAGS)
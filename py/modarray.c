@@ -24,13 +24,604 @@
  * THE SOFTWARE.
  */
 
+#include <math.h>
+#include <string.h>
+
 #include "py/builtin.h"
+#include "py/binary.h"
+#include "py/objarray.h"
+#include "py/runtime.h"
+
+#include "supervisor/shared/translate.h"
 
 #if MICROPY_PY_ARRAY
 
+#if MICROPY_PY_ARRAY_VECTOR
+
+// Elementwise arithmetic and reductions over anything with a buffer of numbers.
+// Elements are converted a chunk at a time into a work buffer of int64_t or
+// mp_float_t, so inputs and output may have different integer (or float)
+// typecodes. Integer results are saturated to the range of the output.
+
+enum {
+    VEC_S8, VEC_U8, VEC_S16, VEC_U16, VEC_S32, VEC_U32,
+    VEC_F32, VEC_F64,
+};
+
+enum { VEC_ADD, VEC_SUB, VEC_MUL };
+
+#define VEC_CHUNK (16)
+
+typedef struct _vec_t {
+    void *buf;
+    size_t len; // in elements
+    char typecode;
+    uint8_t kind;
+} vec_t;
+
+typedef union _vec_work_t {
+    int64_t i[VEC_CHUNK];
+    #if MICROPY_PY_BUILTINS_FLOAT
+    mp_float_t f[VEC_CHUNK];
+    #endif
+} vec_work_t;
+
+#define VEC_IS_FLOAT(v) ((v)->kind >= VEC_F32)
+
+#if (defined (__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1)) //Cortex-M4 w/FPU
+#define VEC_SIMD (1)
+
+static inline uint32_t vec_qadd16(uint32_t x, uint32_t y) {
+    uint32_t r;
+    __asm ("qadd16 %0, %1, %2" : "=r" (r) : "r" (x), "r" (y));
+    return r;
+}
+
+static inline uint32_t vec_qsub16(uint32_t x, uint32_t y) {
+    uint32_t r;
+    __asm ("qsub16 %0, %1, %2" : "=r" (r) : "r" (x), "r" (y));
+    return r;
+}
+
+static inline uint32_t vec_uqadd8(uint32_t x, uint32_t y) {
+    uint32_t r;
+    __asm ("uqadd8 %0, %1, %2" : "=r" (r) : "r" (x), "r" (y));
+    return r;
+}
+
+static inline uint32_t vec_uqsub8(uint32_t x, uint32_t y) {
+    uint32_t r;
+    __asm ("uqsub8 %0, %1, %2" : "=r" (r) : "r" (x), "r" (y));
+    return r;
+}
+
+// acc + x.lo * y.lo + x.hi * y.hi, with signed 16 bit halves
+static inline int64_t vec_smlald(uint32_t x, uint32_t y, int64_t acc) {
+    __asm ("smlald %Q0, %R0, %1, %2" : "+r" (acc) : "r" (x), "r" (y));
+    return acc;
+}
+#else
+#define VEC_SIMD (0)
+#endif
+
+STATIC void vec_get(mp_obj_t obj, vec_t *v, mp_uint_t flags) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(obj, &bufinfo, flags);
+    char typecode = bufinfo.typecode == BYTEARRAY_TYPECODE ? 'B' : bufinfo.typecode;
+    size_t sz = mp_binary_get_size('@', typecode, NULL);
+    int kind = 0;
+    switch (typecode) {
+        case 'b': case 'h': case 'i': case 'l':
+            kind = VEC_S8;
+            break;
+        case 'B': case 'H': case 'I': case 'L':
+            kind = VEC_U8;
+            break;
+        #if MICROPY_PY_BUILTINS_FLOAT
+        case 'f':
+            kind = VEC_F32;
+            sz = 1;
+            break;
+        case 'd':
+            kind = VEC_F64;
+            sz = 1;
+            break;
+        #endif
+        default:
+            sz = 0;
+    }
+    if (sz == 2) {
+        kind += VEC_S16;
+    } else if (sz == 4) {
+        kind += VEC_S32;
+    } else if (sz != 1) {
+        mp_raise_ValueError(translate("bad typecode"));
+    }
+    v->buf = bufinfo.buf;
+    v->len = bufinfo.len / mp_binary_get_size('@', typecode, NULL);
+    v->typecode = typecode;
+    v->kind = kind;
+}
+
+// Gets the second operand of a binary operation, returning false if it is a scalar
+STATIC bool vec_get_operand(const vec_t *a, mp_obj_t obj, vec_t *b) {
+    if (mp_obj_is_integer(obj) || mp_obj_is_float(obj)) {
+        return false;
+    }
+    vec_get(obj, b, MP_BUFFER_READ);
+    if (VEC_IS_FLOAT(b) != VEC_IS_FLOAT(a)) {
+        mp_raise_ValueError(translate("bad typecode"));
+    }
+    if (b->len != a->len) {
+        mp_raise_ValueError(translate("buffers must be the same length"));
+    }
+    return true;
+}
+
+// Sets up out for len results, in args[out_arg] if given or else in a new array
+// like a, and returns the object holding them.
+STATIC mp_obj_t vec_get_out(const vec_t *a, size_t len, size_t n_args, const mp_obj_t *args, size_t out_arg, vec_t *out) {
+    if (n_args > out_arg && args[out_arg] != mp_const_none) {
+        vec_get(args[out_arg], out, MP_BUFFER_WRITE);
+        if (VEC_IS_FLOAT(out) != VEC_IS_FLOAT(a)) {
+            mp_raise_ValueError(translate("bad typecode"));
+        }
+        if (out->len != len) {
+            mp_raise_ValueError(translate("buffers must be the same length"));
+        }
+        return args[out_arg];
+    }
+    mp_obj_t o = mp_obj_new_array(a->typecode, len);
+    out->buf = ((mp_obj_array_t *)MP_OBJ_TO_PTR(o))->items;
+    out->len = len;
+    out->typecode = a->typecode;
+    out->kind = a->kind;
+    return o;
+}
+
+#define VEC_LOAD(T, dest) { \
+        const T *p = (const T *)v->buf + start; \
+        for (size_t k = 0; k < n; k++) { \
+            dest[k] = p[k]; \
+        } \
+        break; \
+}
+
+STATIC void vec_load(const vec_t *v, size_t start, size_t n, vec_work_t *w) {
+    switch (v->kind) {
+        case VEC_S8: VEC_LOAD(int8_t, w->i)
+        case VEC_U8: VEC_LOAD(uint8_t, w->i)
+        case VEC_S16: VEC_LOAD(int16_t, w->i)
+        case VEC_U16: VEC_LOAD(uint16_t, w->i)
+        case VEC_S32: VEC_LOAD(int32_t, w->i)
+        case VEC_U32: VEC_LOAD(uint32_t, w->i)
+        #if MICROPY_PY_BUILTINS_FLOAT
+        case VEC_F32: VEC_LOAD(float, w->f)
+        case VEC_F64: VEC_LOAD(double, w->f)
+        #endif
+    }
+}
+
+#define VEC_STORE_INT(T, lo, hi) { \
+        T *p = (T *)v->buf + start; \
+        for (size_t k = 0; k < n; k++) { \
+            int64_t x = w->i[k]; \
+            p[k] = x < (lo) ? (lo) : x > (hi) ? (hi) : x; \
+        } \
+        break; \
+}
+
+#define VEC_STORE_FLOAT(T) { \
+        T *p = (T *)v->buf + start; \
+        for (size_t k = 0; k < n; k++) { \
+            p[k] = w->f[k]; \
+        } \
+        break; \
+}
+
+STATIC void vec_store(const vec_t *v, size_t start, size_t n, const vec_work_t *w) {
+    switch (v->kind) {
+        case VEC_S8: VEC_STORE_INT(int8_t, INT8_MIN, INT8_MAX)
+        case VEC_U8: VEC_STORE_INT(uint8_t, 0, UINT8_MAX)
+        case VEC_S16: VEC_STORE_INT(int16_t, INT16_MIN, INT16_MAX)
+        case VEC_U16: VEC_STORE_INT(uint16_t, 0, UINT16_MAX)
+        case VEC_S32: VEC_STORE_INT(int32_t, INT32_MIN, INT32_MAX)
+        case VEC_U32: VEC_STORE_INT(uint32_t, 0, UINT32_MAX)
+        #if MICROPY_PY_BUILTINS_FLOAT
+        case VEC_F32: VEC_STORE_FLOAT(float)
+        case VEC_F64: VEC_STORE_FLOAT(double)
+        #endif
+    }
+}
+
+STATIC mp_obj_t vec_new_int(int64_t v) {
+    if ((mp_int_t)v == v) {
+        return mp_obj_new_int((mp_int_t)v);
+    }
+    return mp_obj_new_int_from_ll(v);
+}
+
+#if VEC_SIMD
+// Handles as many leading elements of a saturating add or subtract as possible,
+// two int16 or four uint8 at a time, and returns how many were done.
+STATIC size_t vec_binary_simd(int op, const vec_t *a, const vec_t *b, const vec_t *out) {
+    if (op == VEC_MUL || a->kind != b->kind || a->kind != out->kind
+        || (a->kind != VEC_S16 && a->kind != VEC_U8)) {
+        return 0;
+    }
+    const byte *pa = a->buf;
+    const byte *pb = b->buf;
+    byte *po = out->buf;
+    size_t words = a->len * (a->kind == VEC_S16 ? 2 : 1) / 4;
+    for (size_t i = 0; i < words * 4; i += 4) {
+        uint32_t x, y;
+        memcpy(&x, pa + i, 4);
+        memcpy(&y, pb + i, 4);
+        if (a->kind == VEC_S16) {
+            x = op == VEC_ADD ? vec_qadd16(x, y) : vec_qsub16(x, y);
+        } else {
+            x = op == VEC_ADD ? vec_uqadd8(x, y) : vec_uqsub8(x, y);
+        }
+        memcpy(po + i, &x, 4);
+    }
+    return words * (a->kind == VEC_S16 ? 2 : 4);
+}
+#endif
+
+STATIC mp_obj_t vec_binary(size_t n_args, const mp_obj_t *args, int op) {
+    vec_t a, b, out;
+    vec_get(args[0], &a, MP_BUFFER_READ);
+    bool is_vec = vec_get_operand(&a, args[1], &b);
+    mp_obj_t res = vec_get_out(&a, a.len, n_args, args, 2, &out);
+    size_t i = 0;
+    vec_work_t wa, wb;
+    if (VEC_IS_FLOAT(&a)) {
+        #if MICROPY_PY_BUILTINS_FLOAT
+        mp_float_t s = is_vec ? 0 : mp_obj_get_float(args[1]);
+        for (; i < a.len; i += VEC_CHUNK) {
+            size_t n = MIN(VEC_CHUNK, a.len - i);
+            vec_load(&a, i, n, &wa);
+            if (is_vec) {
+                vec_load(&b, i, n, &wb);
+            }
+            for (size_t k = 0; k < n; k++) {
+                mp_float_t y = is_vec ? wb.f[k] : s;
+                wa.f[k] = op == VEC_ADD ? wa.f[k] + y : op == VEC_SUB ? wa.f[k] - y : wa.f[k] * y;
+            }
+            vec_store(&out, i, n, &wa);
+        }
+        #endif
+        return res;
+    }
+    // elements are within 33 bits, so sums with a scalar of up to 40 bits can't overflow
+    int64_t s = 0;
+    if (!is_vec) {
+        s = mp_obj_get_int(args[1]);
+        if (op != VEC_MUL) {
+            s = MAX(-((int64_t)1 << 40), MIN(s, (int64_t)1 << 40));
+        }
+    }
+    #if VEC_SIMD
+    else {
+        i = vec_binary_simd(op, &a, &b, &out);
+    }
+    #endif
+    for (; i < a.len; i += VEC_CHUNK) {
+        size_t n = MIN(VEC_CHUNK, a.len - i);
+        vec_load(&a, i, n, &wa);
+        if (is_vec) {
+            vec_load(&b, i, n, &wb);
+        }
+        for (size_t k = 0; k < n; k++) {
+            int64_t x = wa.i[k];
+            int64_t y = is_vec ? wb.i[k] : s;
+            if (op == VEC_ADD) {
+                x += y;
+            } else if (op == VEC_SUB) {
+                x -= y;
+            } else if (__builtin_mul_overflow(x, y, &x)) {
+                x = (wa.i[k] < 0) != (y < 0) ? INT64_MIN : INT64_MAX;
+            }
+            wa.i[k] = x;
+        }
+        vec_store(&out, i, n, &wa);
+    }
+    return res;
+}
+
+STATIC mp_obj_t array_vec_add(size_t n_args, const mp_obj_t *args) {
+    return vec_binary(n_args, args, VEC_ADD);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(array_vec_add_obj, 2, 3, array_vec_add);
+
+STATIC mp_obj_t array_vec_sub(size_t n_args, const mp_obj_t *args) {
+    return vec_binary(n_args, args, VEC_SUB);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(array_vec_sub_obj, 2, 3, array_vec_sub);
+
+STATIC mp_obj_t array_vec_mul(size_t n_args, const mp_obj_t *args) {
+    return vec_binary(n_args, args, VEC_MUL);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(array_vec_mul_obj, 2, 3, array_vec_mul);
+
+#if MICROPY_PY_BUILTINS_FLOAT
+STATIC mp_obj_t array_vec_scale(size_t n_args, const mp_obj_t *args) {
+    vec_t a, out;
+    vec_get(args[0], &a, MP_BUFFER_READ);
+    mp_float_t factor = mp_obj_get_float(args[1]);
+    mp_obj_t res = vec_get_out(&a, a.len, n_args, args, 2, &out);
+    bool is_float = VEC_IS_FLOAT(&a);
+    // integers are scaled by factor in 16.16 fixed point, rounding to nearest
+    int64_t q = 0;
+    if (!is_float) {
+        factor *= 65536;
+        q = factor > (1 << 30) ? (1 << 30) : factor < -(1 << 30) ? -(1 << 30) : (int64_t)MICROPY_FLOAT_C_FUN(floor)(factor + MICROPY_FLOAT_CONST(0.5));
+    }
+    vec_work_t w;
+    for (size_t i = 0; i < a.len; i += VEC_CHUNK) {
+        size_t n = MIN(VEC_CHUNK, a.len - i);
+        vec_load(&a, i, n, &w);
+        for (size_t k = 0; k < n; k++) {
+            if (is_float) {
+                w.f[k] *= factor;
+            } else {
+                w.i[k] = (w.i[k] * q + 0x8000) >> 16;
+            }
+        }
+        vec_store(&out, i, n, &w);
+    }
+    return res;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(array_vec_scale_obj, 2, 3, array_vec_scale);
+#endif
+
+STATIC mp_obj_t array_vec_clamp(size_t n_args, const mp_obj_t *args) {
+    vec_t a, out;
+    vec_get(args[0], &a, MP_BUFFER_READ);
+    mp_obj_t res = vec_get_out(&a, a.len, n_args, args, 3, &out);
+    vec_work_t w;
+    #if MICROPY_PY_BUILTINS_FLOAT
+    if (VEC_IS_FLOAT(&a)) {
+        mp_float_t lo = mp_obj_get_float(args[1]);
+        mp_float_t hi = mp_obj_get_float(args[2]);
+        for (size_t i = 0; i < a.len; i += VEC_CHUNK) {
+            size_t n = MIN(VEC_CHUNK, a.len - i);
+            vec_load(&a, i, n, &w);
+            for (size_t k = 0; k < n; k++) {
+                w.f[k] = w.f[k] < lo ? lo : w.f[k] > hi ? hi : w.f[k];
+            }
+            vec_store(&out, i, n, &w);
+        }
+        return res;
+    }
+    #endif
+    int64_t lo = mp_obj_get_int(args[1]);
+    int64_t hi = mp_obj_get_int(args[2]);
+    for (size_t i = 0; i < a.len; i += VEC_CHUNK) {
+        size_t n = MIN(VEC_CHUNK, a.len - i);
+        vec_load(&a, i, n, &w);
+        for (size_t k = 0; k < n; k++) {
+            w.i[k] = w.i[k] < lo ? lo : w.i[k] > hi ? hi : w.i[k];
+        }
+        vec_store(&out, i, n, &w);
+    }
+    return res;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(array_vec_clamp_obj, 3, 4, array_vec_clamp);
+
+STATIC mp_obj_t array_vec_sum(mp_obj_t a_in) {
+    vec_t a;
+    vec_get(a_in, &a, MP_BUFFER_READ);
+    vec_work_t w;
+    #if MICROPY_PY_BUILTINS_FLOAT
+    if (VEC_IS_FLOAT(&a)) {
+        mp_float_t sum = 0;
+        for (size_t i = 0; i < a.len; i += VEC_CHUNK) {
+            size_t n = MIN(VEC_CHUNK, a.len - i);
+            vec_load(&a, i, n, &w);
+            for (size_t k = 0; k < n; k++) {
+                sum += w.f[k];
+            }
+        }
+        return mp_obj_new_float(sum);
+    }
+    #endif
+    int64_t sum = 0;
+    size_t i = 0;
+    #if VEC_SIMD
+    if (a.kind == VEC_S16) {
+        const byte *p = a.buf;
+        for (; i + 2 <= a.len; i += 2) {
+            uint32_t x;
+            memcpy(&x, p + i * 2, 4);
+            sum = vec_smlald(x, 0x00010001, sum);
+        }
+    }
+    #endif
+    for (; i < a.len; i += VEC_CHUNK) {
+        size_t n = MIN(VEC_CHUNK, a.len - i);
+        vec_load(&a, i, n, &w);
+        for (size_t k = 0; k < n; k++) {
+            sum += w.i[k];
+        }
+    }
+    return vec_new_int(sum);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(array_vec_sum_obj, array_vec_sum);
+
+STATIC mp_obj_t vec_min_max(mp_obj_t a_in, bool is_max) {
+    vec_t a;
+    vec_get(a_in, &a, MP_BUFFER_READ);
+    if (a.len == 0) {
+        mp_raise_ValueError(translate("arg is an empty sequence"));
+    }
+    vec_work_t w;
+    #if MICROPY_PY_BUILTINS_FLOAT
+    if (VEC_IS_FLOAT(&a)) {
+        vec_load(&a, 0, 1, &w);
+        mp_float_t best = w.f[0];
+        for (size_t i = 1; i < a.len; i += VEC_CHUNK) {
+            size_t n = MIN(VEC_CHUNK, a.len - i);
+            vec_load(&a, i, n, &w);
+            for (size_t k = 0; k < n; k++) {
+                if (is_max ? w.f[k] > best : w.f[k] < best) {
+                    best = w.f[k];
+                }
+            }
+        }
+        return mp_obj_new_float(best);
+    }
+    #endif
+    vec_load(&a, 0, 1, &w);
+    int64_t best = w.i[0];
+    for (size_t i = 1; i < a.len; i += VEC_CHUNK) {
+        size_t n = MIN(VEC_CHUNK, a.len - i);
+        vec_load(&a, i, n, &w);
+        for (size_t k = 0; k < n; k++) {
+            if (is_max ? w.i[k] > best : w.i[k] < best) {
+                best = w.i[k];
+            }
+        }
+    }
+    return vec_new_int(best);
+}
+
+STATIC mp_obj_t array_vec_min(mp_obj_t a_in) {
+    return vec_min_max(a_in, false);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(array_vec_min_obj, array_vec_min);
+
+STATIC mp_obj_t array_vec_max(mp_obj_t a_in) {
+    return vec_min_max(a_in, true);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(array_vec_max_obj, array_vec_max);
+
+STATIC mp_obj_t array_vec_dot(mp_obj_t a_in, mp_obj_t b_in) {
+    vec_t a, b;
+    vec_get(a_in, &a, MP_BUFFER_READ);
+    if (!vec_get_operand(&a, b_in, &b)) {
+        mp_raise_TypeError(NULL);
+    }
+    vec_work_t wa, wb;
+    #if MICROPY_PY_BUILTINS_FLOAT
+    if (VEC_IS_FLOAT(&a)) {
+        mp_float_t sum = 0;
+        for (size_t i = 0; i < a.len; i += VEC_CHUNK) {
+            size_t n = MIN(VEC_CHUNK, a.len - i);
+            vec_load(&a, i, n, &wa);
+            vec_load(&b, i, n, &wb);
+            for (size_t k = 0; k < n; k++) {
+                sum += wa.f[k] * wb.f[k];
+            }
+        }
+        return mp_obj_new_float(sum);
+    }
+    #endif
+    int64_t sum = 0;
+    size_t i = 0;
+    #if VEC_SIMD
+    if (a.kind == VEC_S16 && b.kind == VEC_S16) {
+        const byte *pa = a.buf;
+        const byte *pb = b.buf;
+        for (; i + 2 <= a.len; i += 2) {
+            uint32_t x, y;
+            memcpy(&x, pa + i * 2, 4);
+            memcpy(&y, pb + i * 2, 4);
+            sum = vec_smlald(x, y, sum);
+        }
+    }
+    #endif
+    for (; i < a.len; i += VEC_CHUNK) {
+        size_t n = MIN(VEC_CHUNK, a.len - i);
+        vec_load(&a, i, n, &wa);
+        vec_load(&b, i, n, &wb);
+        for (size_t k = 0; k < n; k++) {
+            sum += wa.i[k] * wb.i[k];
+        }
+    }
+    return vec_new_int(sum);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(array_vec_dot_obj, array_vec_dot);
+
+// Result i is the mean of a[i:i + window]. The running sum is updated with the
+// element leaving the window before the result overwrites it, so out may be a
+// view of a starting at the same place.
+STATIC mp_obj_t array_vec_moving_average(size_t n_args, const mp_obj_t *args) {
+    vec_t a, out;
+    vec_get(args[0], &a, MP_BUFFER_READ);
+    mp_int_t window_in = mp_obj_get_int(args[1]);
+    if (window_in < 1 || (size_t)window_in > a.len) {
+        mp_raise_ValueError(translate("invalid window size"));
+    }
+    size_t window = window_in;
+    size_t len = a.len - window + 1;
+    mp_obj_t res = vec_get_out(&a, len, n_args, args, 2, &out);
+    bool is_float = VEC_IS_FLOAT(&a);
+    vec_work_t head, tail;
+    int64_t sum = 0;
+    #if MICROPY_PY_BUILTINS_FLOAT
+    mp_float_t fsum = 0;
+    #endif
+    for (size_t i = 0; i < window - 1; i += VEC_CHUNK) {
+        size_t n = MIN(VEC_CHUNK, window - 1 - i);
+        vec_load(&a, i, n, &head);
+        for (size_t k = 0; k < n; k++) {
+            #if MICROPY_PY_BUILTINS_FLOAT
+            if (is_float) {
+                fsum += head.f[k];
+                continue;
+            }
+            #endif
+            sum += head.i[k];
+        }
+    }
+    for (size_t i = 0; i < len; i += VEC_CHUNK) {
+        size_t n = MIN(VEC_CHUNK, len - i);
+        vec_load(&a, i + window - 1, n, &head);
+        vec_load(&a, i, n, &tail);
+        for (size_t k = 0; k < n; k++) {
+            #if MICROPY_PY_BUILTINS_FLOAT
+            if (is_float) {
+                fsum += head.f[k];
+                head.f[k] = fsum / window;
+                fsum -= tail.f[k];
+                continue;
+            }
+            #endif
+            sum += head.i[k];
+            // 32 bit division is much cheaper where the sum allows it
+            if (sum >= INT32_MIN && sum <= INT32_MAX) {
+                head.i[k] = (int32_t)sum / (int32_t)window;
+            } else {
+                head.i[k] = sum / (int64_t)window;
+            }
+            sum -= tail.i[k];
+        }
+        vec_store(&out, i, n, &head);
+    }
+    return res;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(array_vec_moving_average_obj, 2, 3, array_vec_moving_average);
+
+#endif // MICROPY_PY_ARRAY_VECTOR
+
 STATIC const mp_rom_map_elem_t mp_module_array_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_array) },
     { MP_ROM_QSTR(MP_QSTR_array), MP_ROM_PTR(&mp_type_array) },
+    #if MICROPY_PY_ARRAY_VECTOR
+    { MP_ROM_QSTR(MP_QSTR_add), MP_ROM_PTR(&array_vec_add_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sub), MP_ROM_PTR(&array_vec_sub_obj) },
+    { MP_ROM_QSTR(MP_QSTR_mul), MP_ROM_PTR(&array_vec_mul_obj) },
+    #if MICROPY_PY_BUILTINS_FLOAT
+    { MP_ROM_QSTR(MP_QSTR_scale), MP_ROM_PTR(&array_vec_scale_obj) },
+    #endif
+    { MP_ROM_QSTR(MP_QSTR_clamp), MP_ROM_PTR(&array_vec_clamp_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sum), MP_ROM_PTR(&array_vec_sum_obj) },
+    { MP_ROM_QSTR(MP_QSTR_min), MP_ROM_PTR(&array_vec_min_obj) },
+    { MP_ROM_QSTR(MP_QSTR_max), MP_ROM_PTR(&array_vec_max_obj) },
+    { MP_ROM_QSTR(MP_QSTR_dot), MP_ROM_PTR(&array_vec_dot_obj) },
+    { MP_ROM_QSTR(MP_QSTR_moving_average), MP_ROM_PTR(&array_vec_moving_average_obj) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(mp_module_array_globals, mp_module_array_globals_table);
@@ -199,6 +199,147 @@ STATIC const mp_obj_type_t bufwriter_type = {
 };
 #endif // MICROPY_PY_IO_BUFFEREDWRITER
 
+#if MICROPY_PY_IO_BUFFEREDREADER
+// Reads from the stream a buffer at a time, so small reads and readline don't
+// each go to the stream.  buf[pos:len] holds what has been read but not used.
+typedef struct _mp_obj_bufreader_t {
+    mp_obj_base_t base;
+    mp_obj_t stream;
+    size_t alloc;
+    size_t pos;
+    size_t len;
+    byte buf[0];
+} mp_obj_bufreader_t;
+
+STATIC mp_obj_t bufreader_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    mp_arg_check_num(n_args, kw_args, 1, 2, false);
+    mp_get_stream_raise(args[0], MP_STREAM_OP_READ);
+    size_t alloc = n_args > 1 ? mp_obj_get_int(args[1]) : 256;
+    if (alloc == 0) {
+        mp_raise_ValueError(NULL);
+    }
+    mp_obj_bufreader_t *o = m_new_obj_var(mp_obj_bufreader_t, byte, alloc);
+    o->base.type = type;
+    o->stream = args[0];
+    o->alloc = alloc;
+    o->pos = 0;
+    o->len = 0;
+    return MP_OBJ_FROM_PTR(o);
+}
+
+// Read once from the stream into the empty buffer
+STATIC mp_uint_t bufreader_fill(mp_obj_bufreader_t *self, int *errcode) {
+    self->pos = 0;
+    self->len = 0;
+    mp_uint_t out_sz = mp_get_stream(self->stream)->read(self->stream, self->buf, self->alloc, errcode);
+    if (out_sz != MP_STREAM_ERROR) {
+        self->len = out_sz;
+    }
+    return out_sz;
+}
+
+STATIC mp_uint_t bufreader_read(mp_obj_t self_in, void *buf, mp_uint_t size, int *errcode) {
+    mp_obj_bufreader_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->pos == self->len) {
+        if (size >= self->alloc) {
+            // Nothing is gained by copying large reads through the buffer
+            return mp_get_stream(self->stream)->read(self->stream, buf, size, errcode);
+        }
+        mp_uint_t out_sz = bufreader_fill(self, errcode);
+        if (out_sz == 0 || out_sz == MP_STREAM_ERROR) {
+            return out_sz;
+        }
+    }
+    size = MIN(size, self->len - self->pos);
+    memcpy(buf, self->buf + self->pos, size);
+    self->pos += size;
+    return size;
+}
+
+// Copy a line of at most max bytes, ending with its newline if there is one,
+// into vstr or dest.  Stops early at the end of the stream or when it would
+// block, and returns the length of the line.
+STATIC size_t bufreader_line(mp_obj_bufreader_t *self, vstr_t *vstr, byte *dest, size_t max) {
+    size_t done = 0;
+    while (done < max) {
+        if (self->pos == self->len) {
+            int errcode;
+            mp_uint_t out_sz = bufreader_fill(self, &errcode);
+            if (out_sz == MP_STREAM_ERROR) {
+                if (mp_is_nonblocking_error(errcode)) {
+                    break;
+                }
+                mp_raise_OSError(errcode);
+            }
+            if (out_sz == 0) {
+                break;
+            }
+        }
+        const byte *start = self->buf + self->pos;
+        size_t n = MIN(max - done, self->len - self->pos);
+        const byte *nl = memchr(start, '\n', n);
+        if (nl != NULL) {
+            n = nl - start + 1;
+        }
+        if (vstr != NULL) {
+            vstr_add_strn(vstr, (const char*)start, n);
+        } else {
+            memcpy(dest + done, start, n);
+        }
+        self->pos += n;
+        done += n;
+        if (nl != NULL) {
+            break;
+        }
+    }
+    return done;
+}
+
+STATIC mp_obj_t bufreader_readline(size_t n_args, const mp_obj_t *args) {
+    mp_obj_bufreader_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_int_t max = -1;
+    if (n_args > 1) {
+        max = mp_obj_get_int(args[1]);
+    }
+    vstr_t vstr;
+    vstr_init(&vstr, 16);
+    bufreader_line(self, &vstr, NULL, max < 0 ? (size_t)-1 : (size_t)max);
+    return mp_obj_new_str_from_vstr(&mp_type_bytes, &vstr);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(bufreader_readline_obj, 1, 2, bufreader_readline);
+
+// Like readline, but into a buffer instead of a new bytes object.  A line that
+// doesn't fit is continued by the next call.
+STATIC mp_obj_t bufreader_readline_into(mp_obj_t self_in, mp_obj_t buf_in) {
+    mp_obj_bufreader_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_WRITE);
+    return MP_OBJ_NEW_SMALL_INT(bufreader_line(self, NULL, bufinfo.buf, bufinfo.len));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(bufreader_readline_into_obj, bufreader_readline_into);
+
+STATIC const mp_rom_map_elem_t bufreader_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_read), MP_ROM_PTR(&mp_stream_read_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&mp_stream_readinto_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readline), MP_ROM_PTR(&bufreader_readline_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readline_into), MP_ROM_PTR(&bufreader_readline_into_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(bufreader_locals_dict, bufreader_locals_dict_table);
+
+STATIC const mp_stream_p_t bufreader_stream_p = {
+    MP_PROTO_IMPLEMENT(MP_QSTR_protocol_stream)
+    .read = bufreader_read,
+};
+
+STATIC const mp_obj_type_t bufreader_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_BufferedReader,
+    .make_new = bufreader_make_new,
+    .protocol = &bufreader_stream_p,
+    .locals_dict = (mp_obj_dict_t*)&bufreader_locals_dict,
+};
+#endif // MICROPY_PY_IO_BUFFEREDREADER
+
 #if MICROPY_PY_IO_RESOURCE_STREAM
 STATIC mp_obj_t resource_stream(mp_obj_t package_in, mp_obj_t path_in) {
     VSTR_FIXED(path_buf, MICROPY_ALLOC_PATH_MAX);
@@ -274,6 +415,9 @@ STATIC const mp_rom_map_elem_t mp_module_io_globals_table[] = {
     #if MICROPY_PY_IO_BUFFEREDWRITER
     { MP_ROM_QSTR(MP_QSTR_BufferedWriter), MP_ROM_PTR(&bufwriter_type) },
     #endif
+    #if MICROPY_PY_IO_BUFFEREDREADER
+    { MP_ROM_QSTR(MP_QSTR_BufferedReader), MP_ROM_PTR(&bufreader_type) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(mp_module_io_globals, mp_module_io_globals_table);
@@ -25,8 +25,10 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "py/builtin.h"
+#include "py/bc.h"
 #include "py/stackctrl.h"
 #include "py/runtime.h"
 #include "py/gc.h"
@@ -109,6 +111,18 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_qstr_info_obj, 0, 1, m
 
 #endif // MICROPY_PY_MICROPYTHON_MEM_INFO
 
+#if MICROPY_VM_OPCODE_STATS
+STATIC mp_obj_t mp_micropython_opcode_stats(size_t n_args, const mp_obj_t *args) {
+    mp_opcode_stats_print(&mp_plat_print);
+    if (n_args == 1 && mp_obj_is_true(args[0])) {
+        // true arg given means start counting again
+        mp_opcode_stats_reset();
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_opcode_stats_obj, 0, 1, mp_micropython_opcode_stats);
+#endif
+
 #if MICROPY_PY_MICROPYTHON_STACK_USE
 STATIC mp_obj_t mp_micropython_stack_use(void) {
     return MP_OBJ_NEW_SMALL_INT(mp_stack_usage());
@@ -150,13 +164,45 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(mp_micropython_kbd_intr_obj, mp_micropython_kbd
 #endif
 
 #if MICROPY_ENABLE_SCHEDULER
-STATIC mp_obj_t mp_micropython_schedule(mp_obj_t function, mp_obj_t arg) {
-    if (!mp_sched_schedule(function, arg)) {
+STATIC mp_obj_t mp_micropython_schedule(size_t n_args, const mp_obj_t *args) {
+    mp_int_t priority = 0;
+    if (n_args > 2) {
+        priority = mp_obj_get_int(args[2]);
+        if (priority < 0 || priority >= MICROPY_SCHEDULER_PRIORITIES) {
+            mp_raise_ValueError(translate("invalid priority"));
+        }
+    }
+    bool coalesce = n_args > 3 && mp_obj_is_true(args[3]);
+    if (!mp_sched_schedule_priority(args[0], args[1], priority, coalesce)) {
         mp_raise_msg(&mp_type_RuntimeError, translate("schedule stack full"));
     }
     return mp_const_none;
 }
-STATIC MP_DEFINE_CONST_FUN_OBJ_2(mp_micropython_schedule_obj, mp_micropython_schedule);
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_schedule_obj, 2, 4, mp_micropython_schedule);
+
+#if MICROPY_SCHEDULER_STATS
+// Return (scheduled, coalesced, dropped, max_depth, max_latency_us) for the
+// priority level, and reset them.
+STATIC mp_obj_t mp_micropython_schedule_stats(mp_obj_t priority_in) {
+    mp_int_t priority = mp_obj_get_int(priority_in);
+    if (priority < 0 || priority >= MICROPY_SCHEDULER_PRIORITIES) {
+        mp_raise_ValueError(translate("invalid priority"));
+    }
+    mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+    mp_sched_stats_t stats = MP_STATE_VM(sched_stats)[priority];
+    memset(&MP_STATE_VM(sched_stats)[priority], 0, sizeof(stats));
+    MICROPY_END_ATOMIC_SECTION(atomic_state);
+    mp_obj_t items[5] = {
+        mp_obj_new_int_from_uint(stats.scheduled),
+        mp_obj_new_int_from_uint(stats.coalesced),
+        mp_obj_new_int_from_uint(stats.dropped),
+        MP_OBJ_NEW_SMALL_INT(stats.max_depth),
+        mp_obj_new_int_from_uint(stats.max_latency_us),
+    };
+    return mp_obj_new_tuple(5, items);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(mp_micropython_schedule_stats_obj, mp_micropython_schedule_stats);
+#endif
 #endif
 
 STATIC const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
@@ -174,6 +220,9 @@ STATIC const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_mem_info), MP_ROM_PTR(&mp_micropython_mem_info_obj) },
     { MP_ROM_QSTR(MP_QSTR_qstr_info), MP_ROM_PTR(&mp_micropython_qstr_info_obj) },
 #endif
+    #if MICROPY_VM_OPCODE_STATS
+    { MP_ROM_QSTR(MP_QSTR_opcode_stats), MP_ROM_PTR(&mp_micropython_opcode_stats_obj) },
+    #endif
     #if MICROPY_PY_MICROPYTHON_STACK_USE
     { MP_ROM_QSTR(MP_QSTR_stack_use), MP_ROM_PTR(&mp_micropython_stack_use_obj) },
     #endif
@@ -192,6 +241,9 @@ STATIC const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
     #endif
     #if MICROPY_ENABLE_SCHEDULER
     { MP_ROM_QSTR(MP_QSTR_schedule), MP_ROM_PTR(&mp_micropython_schedule_obj) },
+    #if MICROPY_SCHEDULER_STATS
+    { MP_ROM_QSTR(MP_QSTR_schedule_stats), MP_ROM_PTR(&mp_micropython_schedule_stats_obj) },
+    #endif
     #endif
 };
 
@@ -127,6 +127,78 @@
 #define MICROPY_GC_ALLOC_THRESHOLD (1)
 #endif
 
+// Whether the sweep records free runs of blocks, bucketed by size, so that
+// multi-block allocations usually don't have to scan the allocation table.
+// Each of the MICROPY_GC_FREE_RUN_CLASSES size classes (2-3 blocks, 4-7,
+// ..., with the last open ended) remembers up to MICROPY_GC_FREE_RUN_SLOTS
+// runs, lowest address first.
+#ifndef MICROPY_GC_FREE_RUN_INDEX
+#define MICROPY_GC_FREE_RUN_INDEX (0)
+#endif
+#ifndef MICROPY_GC_FREE_RUN_CLASSES
+#define MICROPY_GC_FREE_RUN_CLASSES (6)
+#endif
+#ifndef MICROPY_GC_FREE_RUN_SLOTS
+#define MICROPY_GC_FREE_RUN_SLOTS (4)
+#endif
+
+// Whether the sweep lists the holes of exactly 1, 2, ... up to
+// MICROPY_GC_SMALL_FREE_LIST_BLOCKS blocks, up to MICROPY_GC_SMALL_FREE_LIST_LEN
+// of each, so that small short lived objects like boxed floats, small tuples
+// and bound methods are allocated into an exact fit without a scan.
+#ifndef MICROPY_GC_SMALL_FREE_LISTS
+#define MICROPY_GC_SMALL_FREE_LISTS (0)
+#endif
+#ifndef MICROPY_GC_SMALL_FREE_LIST_BLOCKS
+#define MICROPY_GC_SMALL_FREE_LIST_BLOCKS (2)
+#endif
+#ifndef MICROPY_GC_SMALL_FREE_LIST_LEN
+#define MICROPY_GC_SMALL_FREE_LIST_LEN (16)
+#endif
+
+// Whether collections triggered by an allocation only mark, leaving the
+// sweep to be done a step of MICROPY_GC_SWEEP_STEP_BLOCKS blocks at a time
+// by later allocations and gc_sweep_step. This shortens the pause of an
+// automatic collection. gc.collect() still sweeps the whole heap at once.
+#ifndef MICROPY_GC_LAZY_SWEEP
+#define MICROPY_GC_LAZY_SWEEP (0)
+#endif
+#ifndef MICROPY_GC_SWEEP_STEP_BLOCKS
+#define MICROPY_GC_SWEEP_STEP_BLOCKS (256)
+#endif
+
+// Number of free single blocks each thread takes from the heap at a time,
+// so that most one block allocations don't take the GC mutex. Only useful
+// without the GIL, when threads allocate in parallel. 0 disables the cache.
+#ifndef MICROPY_GC_THREAD_CACHE
+#define MICROPY_GC_THREAD_CACHE (0)
+#endif
+
+// Number of collections after which gc_long_lived_collect moves the strings,
+// bytes, tuples and floats held by module globals and classes to the long
+// lived end of the heap. 0 leaves them where they were allocated.
+#ifndef MICROPY_GC_LONG_LIVED_PROMOTE_AFTER
+#define MICROPY_GC_LONG_LIVED_PROMOTE_AFTER (0)
+#endif
+
+// Number of blocks one promotion pass may move. The collection before it
+// counts the references to each of them.
+#ifndef MICROPY_GC_LONG_LIVED_PROMOTE_MAX
+#define MICROPY_GC_LONG_LIVED_PROMOTE_MAX (16)
+#endif
+
+// Whether gc_alloc reports the size of every allocation it makes to
+// gc_alloc_profile_record, which must then be provided by the port.
+#ifndef MICROPY_GC_ALLOC_PROFILE
+#define MICROPY_GC_ALLOC_PROFILE (0)
+#endif
+
+// Whether gc_image_save and gc_image_load are provided, to copy the heap out
+// to storage and back into a later heap at the same address.
+#ifndef MICROPY_GC_IMAGE
+#define MICROPY_GC_IMAGE (0)
+#endif
+
 // Number of bytes to allocate initially when creating new chunks to store
 // interned string data.  Smaller numbers lead to more chunks being needed
 // and more wastage at the end of the chunk.  Larger numbers lead to wasted
@@ -141,6 +213,12 @@
 #define MICROPY_QSTR_POOL_MAX_ENTRIES (64)
 #endif
 
+// Whether to look qstrs up through a hash index in each pool instead of scanning them. The index
+// of the ROM pool is generated at build time and costs two bytes of flash per slot.
+#ifndef MICROPY_QSTR_INDEX
+#define MICROPY_QSTR_INDEX (1)
+#endif
+
 // Initial amount for lexer indentation level
 #ifndef MICROPY_ALLOC_LEXER_INDENT_INIT
 #define MICROPY_ALLOC_LEXER_INDENT_INIT (10)
@@ -252,11 +330,29 @@
 #define MICROPY_PERSISTENT_CODE_LOAD (0)
 #endif
 
+// Whether .mpy files that are memory mapped (see mp_persistent_code_map_file)
+// and were saved with mpy-cross -min-place can run from where they are,
+// instead of having their bytecode copied to the heap.  Qstrs in such bytecode
+// refer to slots in the function's constant table, which adds a check to
+// every qstr the VM decodes.  Can't be used with
+// MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE, which writes to the bytecode.
+#ifndef MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+#define MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE (0)
+#endif
+
 // Whether to support saving of persistent code
 #ifndef MICROPY_PERSISTENT_CODE_SAVE
 #define MICROPY_PERSISTENT_CODE_SAVE (0)
 #endif
 
+// Whether modules compiled from .py files are saved in a __pycache__ directory
+// next to them and loaded from there while the source is unchanged (see
+// py/builtinimport.c). Needs MICROPY_VFS, MICROPY_PERSISTENT_CODE_LOAD and
+// MICROPY_PERSISTENT_CODE_SAVE.
+#ifndef MICROPY_MODULE_CACHE
+#define MICROPY_MODULE_CACHE (0)
+#endif
+
 // Whether generated code can persist independently of the VM/runtime instance
 // This is enabled automatically when needed by other features
 #ifndef MICROPY_PERSISTENT_CODE
@@ -293,6 +389,22 @@
 #define MICROPY_EMIT_INLINE_THUMB_FLOAT (1)
 #endif
 
+// Whether viper functions support the float type, which holds unboxed floats.
+// It needs single precision floats, or double precision on x64.
+#ifndef MICROPY_EMIT_NATIVE_FLOAT
+#define MICROPY_EMIT_NATIVE_FLOAT (0)
+#endif
+
+// Whether the Thumb2 native emitter uses VFP instructions for viper floats,
+// rather than helper functions; this needs a single precision FPU
+#ifndef MICROPY_EMIT_THUMB_FLOAT
+#if defined(__ARM_FP) && (__ARM_FP & 4)
+#define MICROPY_EMIT_THUMB_FLOAT (1)
+#else
+#define MICROPY_EMIT_THUMB_FLOAT (0)
+#endif
+#endif
+
 // Whether to emit ARM native code
 #ifndef MICROPY_EMIT_ARM
 #define MICROPY_EMIT_ARM (0)
@@ -330,9 +442,11 @@
 // Configure dynamic compiler macros
 #if MICROPY_DYNAMIC_COMPILER
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE_DYNAMIC (mp_dynamic_compiler.opt_cache_map_lookup_in_bytecode)
+#define MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS_DYNAMIC (mp_dynamic_compiler.opt_bytecode_superinstructions)
 #define MICROPY_PY_BUILTINS_STR_UNICODE_DYNAMIC (mp_dynamic_compiler.py_builtins_str_unicode)
 #else
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE_DYNAMIC MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE
+#define MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS_DYNAMIC MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS
 #define MICROPY_PY_BUILTINS_STR_UNICODE_DYNAMIC MICROPY_PY_BUILTINS_STR_UNICODE
 #endif
 
@@ -341,11 +455,30 @@
 #define MICROPY_COMP_CONST_FOLDING (1)
 #endif
 
+// Whether constant folding also applies to floats; eg 2*0.5 rewritten as 1.0
+// Requires MICROPY_PY_BUILTINS_FLOAT
+#ifndef MICROPY_COMP_CONST_FLOAT
+#define MICROPY_COMP_CONST_FLOAT (0)
+#endif
+
+// Whether to fold tuples of constants into a single constant; eg (1, 'a')
+// Has no effect when MICROPY_PERSISTENT_CODE_SAVE is enabled
+#ifndef MICROPY_COMP_CONST_TUPLE
+#define MICROPY_COMP_CONST_TUPLE (0)
+#endif
+
 // Whether to enable lookup of constants in modules; eg module.CONST
 #ifndef MICROPY_COMP_MODULE_CONST
 #define MICROPY_COMP_MODULE_CONST (0)
 #endif
 
+// Whether files are parsed, compiled and executed one top-level statement at a time, so that
+// only one statement's parse tree is ever in memory. A syntax error is then only raised once the
+// statements before it have run.
+#ifndef MICROPY_COMPILE_BY_STATEMENT
+#define MICROPY_COMPILE_BY_STATEMENT (0)
+#endif
+
 // Whether to enable constant optimisation; id = const(value)
 #ifndef MICROPY_COMP_CONST
 #define MICROPY_COMP_CONST (1)
@@ -369,6 +502,12 @@
 #define MICROPY_COMP_RETURN_IF_EXPR (0)
 #endif
 
+// Whether variables closed over only by list, dict and set comprehensions
+// are passed to them by value, saving a cell and maybe a closure per call
+#ifndef MICROPY_COMP_CAPTURE_BY_VALUE
+#define MICROPY_COMP_CAPTURE_BY_VALUE (1)
+#endif
+
 /*****************************************************************************/
 /* Internal debugging stuff                                                  */
 
@@ -407,12 +546,123 @@
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE (0)
 #endif
 
+// Whether to remember where recent mp_map_lookup calls found their key, so that
+// repeated lookups in ROM module globals and type locals dicts (which are
+// searched linearly) and in hashed dicts usually hit on the first comparison.
+// Uses MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE bytes of RAM and a little code ROM.
+#ifndef MICROPY_OPT_MAP_LOOKUP_CACHE
+#define MICROPY_OPT_MAP_LOOKUP_CACHE (0)
+#endif
+
+// Number of entries in the map lookup cache.  Must be a power of two.
+#ifndef MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE
+#define MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE (128)
+#endif
+
+// Maps whose keys are all qstrs are kept as a dense array in insertion order,
+// and searched by comparing pointers, until they hold more than this many
+// entries. Then they become hash tables. 0 hashes every map that isn't fixed.
+// Instance, module and keyword argument dicts are mostly this small.
+#ifndef MICROPY_MAP_COMPACT_MAX
+#define MICROPY_MAP_COMPACT_MAX (0)
+#endif
+
+// Whether to remember the result of recent class attribute lookups, so that
+// method calls and special method dispatch on instances of Python classes can
+// skip walking the class and its bases.  Entries are dropped whenever any class
+// has an attribute stored or deleted, and at soft reset.  Uses 6 words of RAM
+// per MICROPY_OPT_ATTR_LOOKUP_CACHE_SIZE entry and keeps up to that many
+// otherwise unreachable classes and methods alive.
+#ifndef MICROPY_OPT_ATTR_LOOKUP_CACHE
+#define MICROPY_OPT_ATTR_LOOKUP_CACHE (0)
+#endif
+
+// Number of entries in the class attribute lookup cache.  Must be a power of two.
+#ifndef MICROPY_OPT_ATTR_LOOKUP_CACHE_SIZE
+#define MICROPY_OPT_ATTR_LOOKUP_CACHE_SIZE (32)
+#endif
+
+// Whether str indexing, slicing, len() and find() on long unicode strings
+// remember, for the last few strings used, how many characters they have and
+// where every MICROPY_OPT_STR_INDEX_CACHE_STRIDE'th character starts, rather
+// than counting characters from the start every time.  ASCII-only strings need
+// no positions and are indexed directly.  Non-ASCII strings take a word per
+// stride characters.  Entries are dropped at soft reset, and up to
+// MICROPY_OPT_STR_INDEX_CACHE_SIZE otherwise unreachable strings are kept alive.
+#ifndef MICROPY_OPT_STR_INDEX_CACHE
+#define MICROPY_OPT_STR_INDEX_CACHE (0)
+#endif
+
+// Number of strings in the str index cache.
+#ifndef MICROPY_OPT_STR_INDEX_CACHE_SIZE
+#define MICROPY_OPT_STR_INDEX_CACHE_SIZE (2)
+#endif
+
+// Characters between recorded positions in the str index cache.  Must be a
+// power of two.
+#ifndef MICROPY_OPT_STR_INDEX_CACHE_STRIDE
+#define MICROPY_OPT_STR_INDEX_CACHE_STRIDE (32)
+#endif
+
+// Whether to fuse common sequences of bytecodes into single opcodes: LOAD_FAST
+// followed by LOAD_ATTR or LOAD_METHOD, two LOAD_FASTs in a row, and a small int
+// constant followed by an arithmetic or comparison BINARY_OP.  The fused forms
+// take the same space as the originals and save a dispatch each.  Bytecode using
+// them is marked in the .mpy feature flags; ports with this enabled can still
+// load .mpy files without them.
+#ifndef MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS
+#define MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS (0)
+#endif
+
+// Whether the VM handles add, subtract, comparison, bitwise and shift ops on
+// two small ints inline, only calling mp_binary_op on overflow or for other
+// operand types.  Costs a few hundred bytes of code in the VM.
+#ifndef MICROPY_OPT_VM_SMALL_INT_FAST_PATH
+#define MICROPY_OPT_VM_SMALL_INT_FAST_PATH (0)
+#endif
+
+// Whether to keep a pointer to the code state of the running bytecode
+// function in the thread state, so that a sampling profiler interrupt can see
+// which function and instruction are executing.
+#ifndef MICROPY_TRACK_CURRENT_CODE_STATE
+#define MICROPY_TRACK_CURRENT_CODE_STATE (0)
+#endif
+
+// Whether to count how often each opcode, and each pair of consecutive
+// opcodes within a function, is executed.  The counts are printed by
+// micropython.opcode_stats() and can be summarised by
+// tools/analyze_opcode_stats.py.  This slows down the VM, so is only meant
+// for builds used to measure a workload.
+#ifndef MICROPY_VM_OPCODE_STATS
+#define MICROPY_VM_OPCODE_STATS (0)
+#endif
+
+// Number of distinct opcode pairs that can be counted; must be a power of 2.
+// Each slot takes 8 bytes.  Pairs that don't fit are counted as overflow.
+#ifndef MICROPY_VM_OPCODE_STATS_PAIR_SLOTS
+#define MICROPY_VM_OPCODE_STATS_PAIR_SLOTS (512)
+#endif
+
 // Whether to use fast versions of bitwise operations (and, or, xor) when the
 // arguments are both positive.  Increases Thumb2 code size by about 250 bytes.
 #ifndef MICROPY_OPT_MPZ_BITWISE
 #define MICROPY_OPT_MPZ_BITWISE (0)
 #endif
 
+// Whether to multiply big integers by Karatsuba's method once both are long
+// enough, square them with half the digit products, and use a sliding window
+// for pow(x, y, z).  Each of these needs scratch memory from the heap and
+// falls back to the plain method if it can't get it.
+#ifndef MICROPY_OPT_MPZ_FAST_MUL
+#define MICROPY_OPT_MPZ_FAST_MUL (0)
+#endif
+
+// Number of mpz digits the shorter operand needs for Karatsuba's method to be
+// used.  Must be at least 4.
+#ifndef MICROPY_MPZ_KARATSUBA_THRESHOLD
+#define MICROPY_MPZ_KARATSUBA_THRESHOLD (32)
+#endif
+
 /*****************************************************************************/
 /* Python internal features                                                  */
 
@@ -428,11 +678,27 @@
 #define MICROPY_READER_POSIX (0)
 #endif
 
+// Whether the POSIX reader maps regular files into memory instead of reading
+// them, so .mpy and source files are loaded without a system call per chunk.
+#ifndef MICROPY_READER_POSIX_MMAP
+#define MICROPY_READER_POSIX_MMAP (0)
+#endif
+
 // Whether to use the VFS reader for importing files
 #ifndef MICROPY_READER_VFS
 #define MICROPY_READER_VFS (0)
 #endif
 
+// Largest number of blocks of MICROPY_READER_VFS_BLOCK_SIZE bytes that the VFS
+// reader reads at once. 0 reads through a small fixed buffer instead.
+#ifndef MICROPY_READER_VFS_BLOCKS
+#define MICROPY_READER_VFS_BLOCKS (0)
+#endif
+
+#ifndef MICROPY_READER_VFS_BLOCK_SIZE
+#define MICROPY_READER_VFS_BLOCK_SIZE (512)
+#endif
+
 // Number of VFS mounts to persist across soft-reset.
 #ifndef MICROPY_FATFS_NUM_PERSISTENT
 #define MICROPY_FATFS_NUM_PERSISTENT (0)
@@ -454,6 +720,20 @@
 #define MICROPY_VM_HOOK_RETURN
 #endif
 
+// Hook called repeatedly while waiting for an event, such as by uasyncio when
+// no task is ready to run; it should handle pending exceptions and callbacks,
+// and may sleep until the next interrupt
+#ifndef MICROPY_EVENT_POLL_HOOK
+#define MICROPY_EVENT_POLL_HOOK mp_handle_pending();
+#endif
+
+// Hook called after MICROPY_EVENT_POLL_HOOK while waiting for something that
+// is signalled, such as a stream's ready event; it may sleep until the next
+// interrupt
+#ifndef MICROPY_EVENT_WAIT_HOOK
+#define MICROPY_EVENT_WAIT_HOOK
+#endif
+
 // Whether to include the garbage collector
 #ifndef MICROPY_ENABLE_GC
 #define MICROPY_ENABLE_GC (0)
@@ -496,6 +776,14 @@
 #   endif
 #endif
 
+// Number of caught exceptions kept for reuse, 0 to disable.  An exception
+// raised by mp_raise_xxx() and caught by an except clause without "as" goes
+// back in the pool along with its args tuple and traceback buffer, so a
+// raise/except retry loop doesn't allocate.  Requires the GC.
+#ifndef MICROPY_EXCEPTION_POOL_SIZE
+#define MICROPY_EXCEPTION_POOL_SIZE (0)
+#endif
+
 // Whether to provide the mp_kbd_exception object, and micropython.kbd_intr function
 #ifndef MICROPY_KBD_EXCEPTION
 #define MICROPY_KBD_EXCEPTION (0)
@@ -610,6 +898,21 @@ typedef double mp_float_t;
 #define MICROPY_FLOAT_HIGH_QUALITY_HASH (0)
 #endif
 
+// Whether repr() and str() of a float give the shortest digits that read
+// back as the same float, rather than a fixed number of digits.  Parsing of
+// decimals with up to 17 significant digits is then correctly rounded too.
+// This needs tables of 128-bit powers of 5, see the option below.
+#ifndef MICROPY_FLOAT_FORMAT_SHORTEST
+#define MICROPY_FLOAT_FORMAT_SHORTEST (0)
+#endif
+
+// Whether the shortest float formatting uses a full table of powers of 5
+// (about 1.8k of ROM for single precision, 10.5k for double) or a compact
+// one (about 0.3k, 0.8k) from which each entry takes an extra multiplication.
+#ifndef MICROPY_FLOAT_FORMAT_SHORTEST_FULL_TABLES
+#define MICROPY_FLOAT_FORMAT_SHORTEST_FULL_TABLES (0)
+#endif
+
 // Enable features which improve CPython compatibility
 // but may lead to more code size/memory usage.
 // TODO: Originally intended as generic category to not
@@ -632,6 +935,12 @@ typedef double mp_float_t;
 #define MICROPY_STREAMS_NON_BLOCK (0)
 #endif
 
+// Whether streams can signal that they may have become ready, so select,
+// poll and uasyncio only poll them again after that instead of spinning
+#ifndef MICROPY_STREAMS_READY_EVENTS
+#define MICROPY_STREAMS_READY_EVENTS (0)
+#endif
+
 // Whether to provide stream functions with POSIX-like signatures
 // (useful for porting existing libraries to MicroPython).
 #ifndef MICROPY_STREAMS_POSIX_API
@@ -658,11 +967,24 @@ typedef double mp_float_t;
 #define MICROPY_MODULE_FROZEN_MPY (0)
 #endif
 
+// Whether frozen .mpy modules come with their function objects prebuilt in ROM,
+// so that defining a function or method while importing them doesn't allocate
+#ifndef MICROPY_MODULE_FROZEN_ROM_FUN
+#define MICROPY_MODULE_FROZEN_ROM_FUN (0)
+#endif
+
 // Convenience macro for whether frozen modules are supported
 #ifndef MICROPY_MODULE_FROZEN
 #define MICROPY_MODULE_FROZEN (MICROPY_MODULE_FROZEN_STR || MICROPY_MODULE_FROZEN_MPY)
 #endif
 
+// Whether modules imported from the filesystem can be reloaded in place when
+// their files change, instead of restarting the VM (see py/reload.c). Needs
+// MICROPY_VFS.
+#ifndef MICROPY_RELOAD_MODULES
+#define MICROPY_RELOAD_MODULES (0)
+#endif
+
 // Whether you can override builtins in the builtins module
 #ifndef MICROPY_CAN_OVERRIDE_BUILTINS
 #define MICROPY_CAN_OVERRIDE_BUILTINS (0)
@@ -697,6 +1019,18 @@ typedef double mp_float_t;
 #define MICROPY_SCHEDULER_DEPTH (4)
 #endif
 
+// Number of priority levels of the scheduler, each with a queue of
+// MICROPY_SCHEDULER_DEPTH entries; pending callbacks of higher levels run first
+#ifndef MICROPY_SCHEDULER_PRIORITIES
+#define MICROPY_SCHEDULER_PRIORITIES (1)
+#endif
+
+// Whether to count scheduled, coalesced and dropped callbacks and track the
+// queue depth and latency of each priority level (requires mp_hal_ticks_us)
+#ifndef MICROPY_SCHEDULER_STATS
+#define MICROPY_SCHEDULER_STATS (0)
+#endif
+
 // Support for generic VFS sub-system
 #ifndef MICROPY_VFS
 #define MICROPY_VFS (0)
@@ -712,6 +1046,29 @@ typedef double mp_float_t;
 #define MICROPY_VFS_FAT (0)
 #endif
 
+// Support for VFS ROM component, to mount a read-only image such as one built
+// by tools/mkromfs.py
+#ifndef MICROPY_VFS_ROM
+#define MICROPY_VFS_ROM (0)
+#endif
+
+// Whether the ROM VFS can read files stored with zlib compression
+#ifndef MICROPY_VFS_ROM_COMPRESSION
+#define MICROPY_VFS_ROM_COMPRESSION (MICROPY_VFS_ROM && MICROPY_PY_UZLIB)
+#endif
+
+// Whether the FAT VFS answers import stats from cached directory listings,
+// so resolving an import doesn't search a directory on the filesystem for
+// every sys.path entry and file extension it tries
+#ifndef MICROPY_VFS_FAT_IMPORT_STAT_CACHE
+#define MICROPY_VFS_FAT_IMPORT_STAT_CACHE (0)
+#endif
+
+// Bytes of heap used to hold the cached directory listings
+#ifndef MICROPY_VFS_FAT_IMPORT_STAT_CACHE_SIZE
+#define MICROPY_VFS_FAT_IMPORT_STAT_CACHE_SIZE (1024)
+#endif
+
 /*****************************************************************************/
 /* Fine control over Python builtins, classes, modules, etc                  */
 
@@ -741,6 +1098,12 @@ typedef double mp_float_t;
 #define MICROPY_PY_DELATTR_SETATTR (0)
 #endif
 
+// Whether to support class __slots__, giving instances a fixed array of
+// attributes in place of a members map
+#ifndef MICROPY_PY_SLOTS
+#define MICROPY_PY_SLOTS (0)
+#endif
+
 // Support for async/await/async for/async with
 #ifndef MICROPY_PY_ASYNC_AWAIT
 #define MICROPY_PY_ASYNC_AWAIT (1)
@@ -795,6 +1158,11 @@ typedef double mp_float_t;
 #define MICROPY_PY_BUILTINS_MEMORYVIEW (0)
 #endif
 
+// Whether to support memoryview.cast()
+#ifndef MICROPY_PY_BUILTINS_MEMORYVIEW_CAST
+#define MICROPY_PY_BUILTINS_MEMORYVIEW_CAST (0)
+#endif
+
 // Whether to support set object
 #ifndef MICROPY_PY_BUILTINS_SET
 #define MICROPY_PY_BUILTINS_SET (1)
@@ -963,6 +1331,12 @@ typedef double mp_float_t;
 #define MICROPY_PY_ARRAY_SLICE_ASSIGN (0)
 #endif
 
+// Whether to provide elementwise arithmetic and reductions over arrays and
+// memoryviews (array.add, array.dot, array.moving_average etc).
+#ifndef MICROPY_PY_ARRAY_VECTOR
+#define MICROPY_PY_ARRAY_VECTOR (0)
+#endif
+
 // Whether to support nonstandard typecodes "O", "P" and "S"
 // in array and struct modules.
 #ifndef MICROPY_NONSTANDARD_TYPECODES
@@ -1056,6 +1430,11 @@ typedef double mp_float_t;
 #define MICROPY_PY_IO_BUFFEREDWRITER (0)
 #endif
 
+// Whether to provide "io.BufferedReader" class
+#ifndef MICROPY_PY_IO_BUFFEREDREADER
+#define MICROPY_PY_IO_BUFFEREDREADER (0)
+#endif
+
 // Whether to provide "struct" module
 #ifndef MICROPY_PY_STRUCT
 #define MICROPY_PY_STRUCT (1)
@@ -1181,6 +1560,12 @@ typedef double mp_float_t;
 #define MICROPY_PY_URE_SUB (0)
 #endif
 
+// Number of patterns compiled by ure.match(), ure.search() and ure.sub() to
+// keep for reuse, so calling them with the same pattern doesn't recompile it
+#ifndef MICROPY_PY_URE_CACHE_SIZE
+#define MICROPY_PY_URE_CACHE_SIZE (0)
+#endif
+
 #ifndef MICROPY_PY_UHEAPQ
 #define MICROPY_PY_UHEAPQ (0)
 #endif
@@ -1190,6 +1575,12 @@ typedef double mp_float_t;
 #define MICROPY_PY_UTIMEQ (0)
 #endif
 
+// Whether to provide the "uasyncio" module, an event loop for coroutines with
+// the task queue, tasks and events in C
+#ifndef MICROPY_PY_UASYNCIO
+#define MICROPY_PY_UASYNCIO (0)
+#endif
+
 #ifndef MICROPY_PY_UHASHLIB
 #define MICROPY_PY_UHASHLIB (0)
 #endif
@@ -1202,15 +1593,40 @@ typedef double mp_float_t;
 #define MICROPY_PY_UHASHLIB_SHA256 (1)
 #endif
 
+// Whether the port hashes SHA1 and SHA256 blocks in hardware, providing
+// mp_hal_sha_blocks from extmod/moduhashlib.h
+#ifndef MICROPY_PY_UHASHLIB_HW
+#define MICROPY_PY_UHASHLIB_HW (0)
+#endif
+
 #ifndef MICROPY_PY_UBINASCII
 #define MICROPY_PY_UBINASCII (0)
 #endif
 
-// Depends on MICROPY_PY_UZLIB
+// Whether to provide hexlify_into, unhexlify_into, a2b_base64_into and
+// b2a_base64_into, which write into a given buffer instead of allocating
+#ifndef MICROPY_PY_UBINASCII_INTO
+#define MICROPY_PY_UBINASCII_INTO (0)
+#endif
+
+// Depends on MICROPY_PY_UZLIB, unless MICROPY_PY_UBINASCII_CRC32_HW or
+// MICROPY_PY_UBINASCII_CRC32_TABLE is set
 #ifndef MICROPY_PY_UBINASCII_CRC32
 #define MICROPY_PY_UBINASCII_CRC32 (0)
 #endif
 
+// Whether the port computes CRC-32 in hardware, providing mp_hal_crc32 from
+// extmod/modubinascii.h
+#ifndef MICROPY_PY_UBINASCII_CRC32_HW
+#define MICROPY_PY_UBINASCII_CRC32_HW (0)
+#endif
+
+// Whether to compute CRC-32 in software with its own 4 KiB of tables, four
+// bytes per step, rather than with uzlib's small table a nibble at a time
+#ifndef MICROPY_PY_UBINASCII_CRC32_TABLE
+#define MICROPY_PY_UBINASCII_CRC32_TABLE (0)
+#endif
+
 #ifndef MICROPY_PY_URANDOM
 #define MICROPY_PY_URANDOM (0)
 #endif
@@ -1425,6 +1841,20 @@ typedef double mp_float_t;
 #define MP_NOINLINE __attribute__((noinline))
 #endif
 
+// Modifier for hot functions that should run from the fastest memory, such as tightly coupled
+// memory or RAM. Used as PLACE_IN_ITCM(name) in place of the name in a function definition. Ports
+// that define it put the function in a section that their linker scripts place there.
+#ifndef PLACE_IN_ITCM
+#define PLACE_IN_ITCM(name) name
+#endif
+
+// Modifier for hot static variables that should live in the fastest data memory, such as DTCM or
+// CCM RAM. Used as PLACE_IN_DTCM_BSS(name) in place of the name in a definition without an
+// initializer. The memory may not be reachable by DMA.
+#ifndef PLACE_IN_DTCM_BSS
+#define PLACE_IN_DTCM_BSS(name) name
+#endif
+
 // Modifier for functions which should be always inlined
 #ifndef MP_ALWAYSINLINE
 #define MP_ALWAYSINLINE __attribute__((always_inline))
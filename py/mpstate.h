@@ -45,7 +45,9 @@
 typedef struct mp_dynamic_compiler_t {
     uint8_t small_int_bits; // must be <= host small_int_bits
     bool opt_cache_map_lookup_in_bytecode;
+    bool opt_bytecode_superinstructions;
     bool py_builtins_str_unicode;
+    bool mpy_in_place; // save qstrs as constant table slots
 } mp_dynamic_compiler_t;
 extern mp_dynamic_compiler_t mp_dynamic_compiler;
 #endif
@@ -58,8 +60,55 @@ extern mp_dynamic_compiler_t mp_dynamic_compiler;
 typedef struct _mp_sched_item_t {
     mp_obj_t func;
     mp_obj_t arg;
+    #if MICROPY_SCHEDULER_STATS
+    mp_uint_t ticks_us; // when it was scheduled
+    #endif
 } mp_sched_item_t;
 
+#if MICROPY_SCHEDULER_STATS
+typedef struct _mp_sched_stats_t {
+    uint32_t scheduled;
+    uint32_t coalesced;
+    uint32_t dropped; // because the queue was full
+    uint32_t max_latency_us;
+    uint16_t max_depth;
+} mp_sched_stats_t;
+#endif
+
+#if MICROPY_OPT_ATTR_LOOKUP_CACHE
+// Result of looking up attr in a class and its bases, see mp_obj_class_lookup.
+// found_value is MP_OBJ_NULL if the attribute wasn't found and MP_OBJ_SENTINEL
+// if it is handled by a native special method slot.
+typedef struct _mp_attr_lookup_cache_entry_t {
+    const mp_obj_type_t *type;
+    qstr attr;
+    size_t meth_offset;
+    size_t epoch;
+    const mp_obj_type_t *found_type;
+    mp_obj_t found_value;
+} mp_attr_lookup_cache_entry_t;
+#endif
+
+#if MICROPY_OPT_STR_INDEX_CACHE
+// Character positions in a long str, see str_index_cache_get.  n_chars == len
+// for ASCII-only strings, which don't need checkpoints.
+typedef struct _mp_str_index_cache_entry_t {
+    const byte *data;
+    size_t len;
+    size_t n_chars;
+    // byte offset of character (i + 1) * MICROPY_OPT_STR_INDEX_CACHE_STRIDE
+    size_t *checkpoints;
+} mp_str_index_cache_entry_t;
+#endif
+
+// Progress of a sweep of the heap, see gc_sweep_blocks.
+typedef struct _mp_gc_sweep_t {
+    size_t block; // next block to sweep
+    size_t run_len; // number of free blocks just before it
+    bool free_tail; // whether tails at block belong to a freed head
+    bool lazy; // whether the next collection leaves the sweep to gc_sweep_step
+} mp_gc_sweep_t;
+
 // This structure hold information about the memory allocation system.
 typedef struct _mp_state_mem_t {
     #if MICROPY_MEM_STATS
@@ -95,6 +144,39 @@ typedef struct _mp_state_mem_t {
     size_t gc_first_free_atb_index;
     size_t gc_last_free_atb_index;
 
+    #if MICROPY_GC_FREE_RUN_INDEX
+    // Free runs found by the last sweep, see gc_alloc. These are hints: blocks
+    // may have been allocated since, so a run is checked before it's used.
+    struct {
+        size_t start;
+        size_t len;
+    } gc_free_runs[MICROPY_GC_FREE_RUN_CLASSES][MICROPY_GC_FREE_RUN_SLOTS];
+    uint8_t gc_free_run_count[MICROPY_GC_FREE_RUN_CLASSES];
+    #endif
+
+    #if MICROPY_GC_SMALL_FREE_LISTS
+    // Holes of exactly 1, 2, ... blocks found by the last sweep, lowest first
+    // and checked before use like gc_free_runs. Entries before the next one
+    // have been used.
+    size_t gc_small_free[MICROPY_GC_SMALL_FREE_LIST_BLOCKS][MICROPY_GC_SMALL_FREE_LIST_LEN];
+    uint8_t gc_small_free_count[MICROPY_GC_SMALL_FREE_LIST_BLOCKS];
+    uint8_t gc_small_free_next[MICROPY_GC_SMALL_FREE_LIST_BLOCKS];
+    #endif
+
+    #if MICROPY_GC_LAZY_SWEEP
+    mp_gc_sweep_t gc_sweep;
+    #endif
+
+    #if MICROPY_GC_LONG_LIVED_PROMOTE_AFTER
+    // collections since gc_long_lived_collect last promoted
+    uint16_t gc_collections_since_promote;
+    // blocks that may be promoted, in order, and the references to each that
+    // the collection found
+    size_t gc_promote_blocks[MICROPY_GC_LONG_LIVED_PROMOTE_MAX];
+    uint8_t gc_promote_refs[MICROPY_GC_LONG_LIVED_PROMOTE_MAX];
+    uint8_t gc_promote_len;
+    #endif
+
     #if MICROPY_PY_GC_COLLECT_RETVAL
     size_t gc_collected;
     #endif
@@ -141,6 +223,11 @@ typedef struct _mp_state_vm_t {
     // exception object of type ReloadException
     mp_obj_exception_t mp_reload_exception;
 
+    #if MICROPY_EXCEPTION_POOL_SIZE
+    // caught exceptions that can be reused, see objexcept.c
+    mp_obj_exception_t *mp_exception_pool[MICROPY_EXCEPTION_POOL_SIZE];
+    #endif
+
     // dictionary with loaded modules (may be exposed as sys.modules)
     mp_obj_dict_t mp_loaded_modules_dict;
 
@@ -148,7 +235,8 @@ typedef struct _mp_state_vm_t {
     volatile mp_obj_t mp_pending_exception;
 
     #if MICROPY_ENABLE_SCHEDULER
-    mp_sched_item_t sched_stack[MICROPY_SCHEDULER_DEPTH];
+    // a circular queue for each priority level
+    mp_sched_item_t sched_queue[MICROPY_SCHEDULER_PRIORITIES][MICROPY_SCHEDULER_DEPTH];
     #endif
 
     // current exception being handled, for sys.exc_info()
@@ -168,6 +256,19 @@ typedef struct _mp_state_vm_t {
     mp_obj_dict_t *mp_module_builtins_override_dict;
     #endif
 
+    #if MICROPY_OPT_ATTR_LOOKUP_CACHE
+    // Entries keep their types and values alive, so a cached type can't be
+    // collected and have a new one allocated at its address.
+    mp_attr_lookup_cache_entry_t attr_lookup_cache[MICROPY_OPT_ATTR_LOOKUP_CACHE_SIZE];
+    #endif
+
+    #if MICROPY_OPT_STR_INDEX_CACHE
+    // Entries keep their strings alive, so a cached string's data can't be
+    // freed and other data allocated at its address.
+    mp_str_index_cache_entry_t str_index_cache[MICROPY_OPT_STR_INDEX_CACHE_SIZE];
+    size_t str_index_cache_next;
+    #endif
+
     // include any root pointers defined by a port
     MICROPY_PORT_ROOT_POINTERS
 
@@ -186,11 +287,29 @@ typedef struct _mp_state_vm_t {
     mp_obj_t lwip_slip_stream;
     #endif
 
+    #if MICROPY_PY_UASYNCIO
+    struct _mp_uasyncio_state_t *uasyncio_state;
+    #endif
+
+    #if MICROPY_PY_URE && MICROPY_PY_URE_CACHE_SIZE
+    // patterns compiled by the module-level ure functions, most recent first
+    mp_obj_t ure_cache[MICROPY_PY_URE_CACHE_SIZE];
+    #endif
+
     #if MICROPY_VFS
     struct _mp_vfs_mount_t *vfs_cur;
     struct _mp_vfs_mount_t *vfs_mount_table;
     #endif
 
+    #if MICROPY_VFS_FAT_IMPORT_STAT_CACHE
+    byte *fat_import_stat_cache;
+    #endif
+
+    #if MICROPY_RELOAD_MODULES
+    // files that modules and the main program were loaded from, see reload.c
+    struct _mp_reload_file_t *reload_files;
+    #endif
+
     //
     // END ROOT POINTER SECTION
     ////////////////////////////////////////////////////////////
@@ -210,6 +329,32 @@ typedef struct _mp_state_vm_t {
     mp_uint_t mp_optimise_value;
     #endif
 
+    #if MICROPY_OPT_ATTR_LOOKUP_CACHE
+    // Bumped whenever a class dict is changed, see mp_obj_class_lookup.
+    size_t attr_lookup_epoch;
+    #endif
+
+    #if MICROPY_VFS_FAT_IMPORT_STAT_CACHE
+    // Bytes of fat_import_stat_cache holding directory listings, see vfs_fat.c.
+    size_t fat_import_stat_cache_used;
+    #endif
+
+    #if MICROPY_RELOAD_MODULES
+    size_t reload_files_len;
+    size_t reload_files_alloc;
+    // set when the pending reload exception may be handled by reloading modules
+    bool reload_modules_requested;
+    #endif
+
+    #if MICROPY_OPT_MAP_LOOKUP_CACHE
+    // Table position (mod 256) where a key was last found, see mp_map_lookup.
+    uint8_t map_lookup_cache[MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE];
+    #endif
+
+    #if MICROPY_EXCEPTION_POOL_SIZE
+    uint8_t mp_exception_pool_len;
+    #endif
+
     // size of the emergency exception buf, if it's dynamically allocated
     #if MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF && MICROPY_EMERGENCY_EXCEPTION_BUF_SIZE == 0
     mp_int_t mp_emergency_exception_buf_size;
@@ -217,7 +362,12 @@ typedef struct _mp_state_vm_t {
 
     #if MICROPY_ENABLE_SCHEDULER
     volatile int16_t sched_state;
-    uint16_t sched_sp;
+    uint16_t sched_len; // total over all levels
+    uint16_t sched_level_idx[MICROPY_SCHEDULER_PRIORITIES];
+    uint16_t sched_level_len[MICROPY_SCHEDULER_PRIORITIES];
+    #if MICROPY_SCHEDULER_STATS
+    mp_sched_stats_t sched_stats[MICROPY_SCHEDULER_PRIORITIES];
+    #endif
     #endif
 
     #if MICROPY_PY_THREAD_GIL
@@ -256,6 +406,17 @@ typedef struct _mp_state_thread_t {
     mp_obj_dict_t *dict_globals;
 
     nlr_buf_t *nlr_top;
+
+    #if MICROPY_TRACK_CURRENT_CODE_STATE
+    // code state of the innermost bytecode function being executed
+    struct _mp_code_state_t *current_code_state;
+    #endif
+
+    #if MICROPY_GC_THREAD_CACHE
+    // free single blocks taken by this thread, handed out by gc_alloc
+    void *gc_cache[MICROPY_GC_THREAD_CACHE];
+    size_t gc_cache_len;
+    #endif
 } mp_state_thread_t;
 
 // This structure combines the above 3 structures.
@@ -424,7 +424,7 @@ STATIC size_t mpn_mul_dig_add_dig(mpz_dig_t *idig, size_t ilen, mpz_dig_t dmul,
    assumes enough memory in i; assumes i is zeroed; assumes normalised j, k
    can have j, k point to same memory
 */
-STATIC size_t mpn_mul(mpz_dig_t *idig, mpz_dig_t *jdig, size_t jlen, mpz_dig_t *kdig, size_t klen) {
+STATIC size_t mpn_mul(mpz_dig_t *idig, const mpz_dig_t *jdig, size_t jlen, const mpz_dig_t *kdig, size_t klen) {
     mpz_dig_t *oidig = idig;
     size_t ilen = 0;
 
@@ -433,7 +433,7 @@ STATIC size_t mpn_mul(mpz_dig_t *idig, mpz_dig_t *jdig, size_t jlen, mpz_dig_t *
         mpz_dbl_dig_t carry = 0;
 
         size_t jl = jlen;
-        for (mpz_dig_t *jd = jdig; jl > 0; --jl, ++jd, ++id) {
+        for (const mpz_dig_t *jd = jdig; jl > 0; --jl, ++jd, ++id) {
             carry += (mpz_dbl_dig_t)*id + (mpz_dbl_dig_t)*jd * (mpz_dbl_dig_t)*kdig; // will never overflow so long as DIG_SIZE <= 8*sizeof(mpz_dbl_dig_t)/2
             *id = carry & DIG_MASK;
             carry >>= DIG_SIZE;
@@ -449,6 +449,159 @@ STATIC size_t mpn_mul(mpz_dig_t *idig, mpz_dig_t *jdig, size_t jlen, mpz_dig_t *
     return ilen;
 }
 
+#if MICROPY_OPT_MPZ_FAST_MUL
+
+#if MICROPY_MPZ_KARATSUBA_THRESHOLD < 4
+#error MICROPY_MPZ_KARATSUBA_THRESHOLD must be at least 4
+#endif
+
+/* computes i = j * j
+   returns number of digits in i
+   assumes enough memory in i; assumes i is zeroed
+   each cross product j[a] * j[b] is only computed once, then doubled
+*/
+STATIC size_t mpn_sqr(mpz_dig_t *idig, const mpz_dig_t *jdig, size_t jlen) {
+    // cross products, a < b
+    for (size_t a = 0; a + 1 < jlen; ++a) {
+        mpz_dig_t *id = idig + 2 * a + 1;
+        mpz_dbl_dig_t carry = 0;
+        for (size_t b = a + 1; b < jlen; ++b, ++id) {
+            carry += (mpz_dbl_dig_t)*id + (mpz_dbl_dig_t)jdig[a] * (mpz_dbl_dig_t)jdig[b];
+            *id = carry & DIG_MASK;
+            carry >>= DIG_SIZE;
+        }
+        *id = carry;
+    }
+
+    // double them
+    mpz_dig_t top = 0;
+    for (size_t a = 0; a < 2 * jlen; ++a) {
+        mpz_dig_t d = idig[a];
+        idig[a] = ((d << 1) | top) & DIG_MASK;
+        top = d >> (DIG_SIZE - 1);
+    }
+
+    // add the squares on the diagonal
+    mpz_dbl_dig_t carry = 0;
+    for (size_t a = 0; a < jlen; ++a) {
+        mpz_dbl_dig_t sq = (mpz_dbl_dig_t)jdig[a] * (mpz_dbl_dig_t)jdig[a];
+        carry += (mpz_dbl_dig_t)idig[2 * a] + (sq & DIG_MASK);
+        idig[2 * a] = carry & DIG_MASK;
+        carry >>= DIG_SIZE;
+        carry += (mpz_dbl_dig_t)idig[2 * a + 1] + (sq >> DIG_SIZE);
+        idig[2 * a + 1] = carry & DIG_MASK;
+        carry >>= DIG_SIZE;
+    }
+
+    return mpn_remove_trailing_zeros(idig, idig + 2 * jlen);
+}
+
+/* number of digits of scratch memory that mpn_mul_kara needs for n digit operands
+*/
+STATIC size_t mpn_mul_kara_scratch_len(size_t n) {
+    size_t len = 0;
+    while (n >= MICROPY_MPZ_KARATSUBA_THRESHOLD) {
+        n = n - n / 2 + 1;
+        len += 4 * n;
+    }
+    return len;
+}
+
+/* computes i = j * k, all 2n digits of it, by Karatsuba's method
+   j and k have n digits each, not necessarily normalised
+   assumes tdig has mpn_mul_kara_scratch_len(n) digits
+   squares (using less scratch) if j, k point to the same memory
+*/
+STATIC void mpn_mul_kara(mpz_dig_t *idig, const mpz_dig_t *jdig, const mpz_dig_t *kdig, size_t n, mpz_dig_t *tdig) {
+    if (n < MICROPY_MPZ_KARATSUBA_THRESHOLD) {
+        memset(idig, 0, 2 * n * sizeof(mpz_dig_t));
+        if (jdig == kdig) {
+            mpn_sqr(idig, jdig, n);
+        } else {
+            mpn_mul(idig, jdig, n, kdig, n);
+        }
+        return;
+    }
+
+    // j = j1 * B^h + j0 and k = k1 * B^h + k0, where j0 and k0 have h digits
+    size_t h = n / 2;
+    size_t hh = n - h;
+
+    // low and high products go straight to i
+    mpn_mul_kara(idig, jdig, kdig, h, tdig);
+    mpn_mul_kara(idig + 2 * h, jdig + h, kdig + h, hh, tdig);
+
+    // middle product (j0 + j1) * (k0 + k1) - j0 * k0 - j1 * k1
+    mpz_dig_t *sj = tdig;
+    mpz_dig_t *sk = sj;
+    mpz_dig_t *mid = tdig + 2 * (hh + 1);
+    sj[hh] = 0;
+    mpn_add(sj, jdig + h, hh, jdig, h);
+    if (jdig != kdig) {
+        sk = tdig + hh + 1;
+        sk[hh] = 0;
+        mpn_add(sk, kdig + h, hh, kdig, h);
+    }
+    mpn_mul_kara(mid, sj, sk, hh + 1, mid + 2 * (hh + 1));
+    mpn_sub(mid, mid, 2 * (hh + 1), idig, 2 * h);
+    mpn_sub(mid, mid, 2 * (hh + 1), idig + 2 * h, 2 * hh);
+
+    // the whole product fits in 2n digits so this never carries out
+    mpn_add(idig + h, idig + h, 2 * n - h, mid, 2 * (hh + 1));
+}
+
+/* computes i = j * k
+   returns number of digits in i
+   assumes enough memory in i; assumes i is zeroed; assumes normalised j, k
+   can have j, k point to same memory, and squares if they're the same number
+   uses Karatsuba's method when the shorter operand has at least
+   MICROPY_MPZ_KARATSUBA_THRESHOLD digits and scratch memory can be had,
+   otherwise the schoolbook method
+*/
+STATIC size_t mpn_mul_fast(mpz_dig_t *idig, const mpz_dig_t *jdig, size_t jlen, const mpz_dig_t *kdig, size_t klen) {
+    if (jdig == kdig && jlen == klen) {
+        mpz_dig_t *tdig = NULL;
+        size_t tlen = mpn_mul_kara_scratch_len(jlen);
+        if (tlen == 0 || (tdig = m_new_maybe(mpz_dig_t, tlen)) == NULL) {
+            return mpn_sqr(idig, jdig, jlen);
+        }
+        mpn_mul_kara(idig, jdig, jdig, jlen, tdig);
+        m_del(mpz_dig_t, tdig, tlen);
+        return mpn_remove_trailing_zeros(idig, idig + 2 * jlen);
+    }
+
+    if (jlen < klen) {
+        const mpz_dig_t *t = jdig; jdig = kdig; kdig = t;
+        size_t tl = jlen; jlen = klen; klen = tl;
+    }
+
+    // cut j into pieces as long as k and multiply each by k; the last
+    // piece is padded out with zeros
+    size_t tlen = mpn_mul_kara_scratch_len(klen) + 3 * klen;
+    mpz_dig_t *tdig;
+    if (klen < MICROPY_MPZ_KARATSUBA_THRESHOLD || (tdig = m_new_maybe(mpz_dig_t, tlen)) == NULL) {
+        return mpn_mul(idig, jdig, jlen, kdig, klen);
+    }
+    mpz_dig_t *prod = tdig;
+    mpz_dig_t *piece = tdig + 2 * klen;
+    for (size_t done = 0; done < jlen; done += klen) {
+        const mpz_dig_t *p = jdig + done;
+        size_t plen = MIN(klen, jlen - done);
+        if (plen < klen) {
+            memcpy(piece, p, plen * sizeof(mpz_dig_t));
+            memset(piece + plen, 0, (klen - plen) * sizeof(mpz_dig_t));
+            p = piece;
+        }
+        mpn_mul_kara(prod, p, kdig, klen, piece + klen);
+        mpn_add(idig + done, idig + done, jlen + klen - done, prod, plen + klen);
+    }
+    m_del(mpz_dig_t, tdig, tlen);
+
+    return mpn_remove_trailing_zeros(idig, idig + jlen + klen);
+}
+
+#endif // MICROPY_OPT_MPZ_FAST_MUL
+
 /* natural_div - quo * den + new_num = old_num (ie num is replaced with rem)
    assumes den != 0
    assumes num_dig has enough memory to be extended by 1 digit
@@ -1314,7 +1467,11 @@ void mpz_mul_inpl(mpz_t *dest, const mpz_t *lhs, const mpz_t *rhs) {
 
     mpz_need_dig(dest, lhs->len + rhs->len); // min mem l+r-1, max mem l+r
     memset(dest->dig, 0, dest->alloc * sizeof(mpz_dig_t));
+    #if MICROPY_OPT_MPZ_FAST_MUL
+    dest->len = mpn_mul_fast(dest->dig, lhs->dig, lhs->len, rhs->dig, rhs->len);
+    #else
     dest->len = mpn_mul(dest->dig, lhs->dig, lhs->len, rhs->dig, rhs->len);
+    #endif
 
     if (lhs->neg == rhs->neg) {
         dest->neg = 0;
@@ -1362,6 +1519,117 @@ void mpz_pow_inpl(mpz_t *dest, const mpz_t *lhs, const mpz_t *rhs) {
 /* computes dest = (lhs ** rhs) % mod
    can have dest, lhs, rhs the same; mod can't be the same as dest
 */
+#if MICROPY_OPT_MPZ_FAST_MUL
+// Left to right sliding window exponentiation.  The exponent's bits are taken
+// up to w at a time, using a table of x ** 1, x ** 3, ... x ** (2 ** w - 1)
+// mod m, so there is a multiply for every window rather than every set bit.
+// If the table can't be allocated in full a narrower window is used.
+STATIC bool mpz_bit(const mpz_t *z, size_t bit) {
+    return (z->dig[bit / DIG_SIZE] >> (bit % DIG_SIZE)) & 1;
+}
+
+void mpz_pow3_inpl(mpz_t *dest, const mpz_t *lhs, const mpz_t *rhs, const mpz_t *mod) {
+    if (lhs->len == 0 || rhs->neg != 0 || (mod->len == 1 && mod->dig[0] == 1)) {
+        mpz_set_from_int(dest, 0);
+        return;
+    }
+
+    if (rhs->len == 0) {
+        mpz_set_from_int(dest, 1);
+        return;
+    }
+
+    mpz_t *n_copy = NULL;
+    if (rhs == dest) {
+        rhs = n_copy = mpz_clone(rhs);
+    }
+    size_t n_bits = (rhs->len - 1) * DIG_SIZE;
+    for (mpz_dig_t d = rhs->dig[rhs->len - 1]; d != 0; d >>= 1) {
+        n_bits++;
+    }
+    size_t w = n_bits <= 8 ? 1 : n_bits <= 24 ? 2 : n_bits <= 80 ? 3 : n_bits <= 240 ? 4 : 5;
+
+    mpz_t prod; mpz_init_zero(&prod);
+    mpz_t quo; mpz_init_zero(&quo);
+    mpz_t x; mpz_init_zero(&x);
+    mpz_divmod_inpl(&quo, &x, lhs, mod);
+
+    // dest is free to use as scratch until the result goes in it
+    size_t n_odd = 1;
+    size_t odd_alloc = (size_t)1 << (w - 1);
+    mpz_t *odd = NULL;
+    if (w > 1) {
+        odd = m_new_maybe(mpz_t, odd_alloc);
+    }
+    if (odd == NULL) {
+        w = 1;
+        odd = &x;
+    } else {
+        odd[0] = x;
+        mpz_t x2; mpz_init_zero(&x2);
+        mpz_mul_inpl(&prod, &x, &x);
+        mpz_divmod_inpl(&quo, &x2, &prod, mod);
+        size_t alloc = MAX(mod->len, MIN_ALLOC);
+        for (; n_odd < odd_alloc; ++n_odd) {
+            mpz_t *z = &odd[n_odd];
+            mpz_init_zero(z);
+            z->dig = m_new_maybe(mpz_dig_t, alloc);
+            if (z->dig == NULL) {
+                break;
+            }
+            z->alloc = alloc;
+            mpz_mul_inpl(&prod, &odd[n_odd - 1], &x2);
+            mpz_divmod_inpl(&quo, dest, &prod, mod);
+            mpz_set(z, dest);
+        }
+        mpz_deinit(&x2);
+        while (((size_t)1 << (w - 1)) > n_odd) {
+            --w;
+        }
+    }
+
+    bool started = false;
+    for (size_t i = n_bits; i > 0;) {
+        size_t low = i - 1;
+        if (mpz_bit(rhs, low)) {
+            // the widest window down from bit i - 1 that ends on a set bit
+            low = i > w ? i - w : 0;
+            while (!mpz_bit(rhs, low)) {
+                ++low;
+            }
+        }
+        size_t val = 0;
+        for (size_t b = i; b > low; --b) {
+            if (started) {
+                mpz_mul_inpl(&prod, dest, dest);
+                mpz_divmod_inpl(&quo, dest, &prod, mod);
+            }
+            val = (val << 1) | mpz_bit(rhs, b - 1);
+        }
+        if (val != 0) {
+            if (started) {
+                mpz_mul_inpl(&prod, dest, &odd[val >> 1]);
+                mpz_divmod_inpl(&quo, dest, &prod, mod);
+            } else {
+                mpz_set(dest, &odd[val >> 1]);
+                started = true;
+            }
+        }
+        i = low;
+    }
+
+    for (size_t i = 1; i < n_odd; ++i) {
+        mpz_deinit(&odd[i]);
+    }
+    if (odd != &x) {
+        m_del(mpz_t, odd, odd_alloc);
+    }
+    mpz_deinit(&x);
+    mpz_deinit(&quo);
+    mpz_deinit(&prod);
+    mpz_free(n_copy);
+}
+#else
 void mpz_pow3_inpl(mpz_t *dest, const mpz_t *lhs, const mpz_t *rhs, const mpz_t *mod) {
     if (lhs->len == 0 || rhs->neg != 0 || (mod->len == 1 && mod->dig[0] == 1)) {
         mpz_set_from_int(dest, 0);
@@ -1395,6 +1663,7 @@ void mpz_pow3_inpl(mpz_t *dest, const mpz_t *lhs, const mpz_t *rhs, const mpz_t
     mpz_free(x);
     mpz_free(n);
 }
+#endif
 
 #if 0
 these functions are unused
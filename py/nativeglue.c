@@ -39,6 +39,27 @@
 #define DEBUG_printf(...) (void)0
 #endif
 
+#if MICROPY_EMIT_NATIVE && MICROPY_EMIT_NATIVE_FLOAT
+
+// viper floats are held as the bits of an mp_float_t in a machine word
+typedef union _native_float_t {
+    mp_float_t f;
+    mp_uint_t u;
+} native_float_t;
+
+STATIC mp_uint_t native_float_bits(mp_float_t f) {
+    native_float_t v = {.u = 0};
+    v.f = f;
+    return v.u;
+}
+
+STATIC mp_float_t native_float_value(mp_uint_t u) {
+    native_float_t v = {.u = u};
+    return v.f;
+}
+
+#endif
+
 #if MICROPY_EMIT_NATIVE
 
 // convert a MicroPython object to a valid native value based on type
@@ -49,6 +70,9 @@ mp_uint_t mp_convert_obj_to_native(mp_obj_t obj, mp_uint_t type) {
         case MP_NATIVE_TYPE_BOOL:
         case MP_NATIVE_TYPE_INT:
         case MP_NATIVE_TYPE_UINT: return mp_obj_get_int_truncated(obj);
+        #if MICROPY_EMIT_NATIVE_FLOAT
+        case MP_NATIVE_TYPE_FLOAT: return native_float_bits(mp_obj_get_float(obj));
+        #endif
         default: { // cast obj to a pointer
             mp_buffer_info_t bufinfo;
             if (mp_get_buffer(obj, &bufinfo, MP_BUFFER_RW)) {
@@ -73,6 +97,9 @@ mp_obj_t mp_convert_native_to_obj(mp_uint_t val, mp_uint_t type) {
         case MP_NATIVE_TYPE_BOOL: return mp_obj_new_bool(val);
         case MP_NATIVE_TYPE_INT: return mp_obj_new_int(val);
         case MP_NATIVE_TYPE_UINT: return mp_obj_new_int_from_uint(val);
+        #if MICROPY_EMIT_NATIVE && MICROPY_EMIT_NATIVE_FLOAT
+        case MP_NATIVE_TYPE_FLOAT: return mp_obj_new_float(native_float_value(val));
+        #endif
         default: // a pointer
             // we return just the value of the pointer as an integer
             return mp_obj_new_int_from_uint(val);
@@ -123,6 +150,43 @@ STATIC mp_obj_t mp_native_iternext(mp_obj_iter_buf_t *iter) {
     return mp_iternext(obj);
 }
 
+#if MICROPY_EMIT_NATIVE_FLOAT
+// arithmetic and comparison of viper floats, for when the emitter doesn't use
+// an FPU; comparisons return a bool, and division by zero gives inf or nan
+STATIC mp_uint_t mp_native_float_binary_op(mp_uint_t op, mp_uint_t lhs_in, mp_uint_t rhs_in) {
+    mp_float_t lhs = native_float_value(lhs_in);
+    mp_float_t rhs = native_float_value(rhs_in);
+    switch (op) {
+        case MP_BINARY_OP_ADD: return native_float_bits(lhs + rhs);
+        case MP_BINARY_OP_SUBTRACT: return native_float_bits(lhs - rhs);
+        case MP_BINARY_OP_MULTIPLY: return native_float_bits(lhs * rhs);
+        case MP_BINARY_OP_TRUE_DIVIDE: return native_float_bits(lhs / rhs);
+        case MP_BINARY_OP_LESS: return lhs < rhs;
+        case MP_BINARY_OP_MORE: return lhs > rhs;
+        case MP_BINARY_OP_EQUAL: return lhs == rhs;
+        case MP_BINARY_OP_LESS_EQUAL: return lhs <= rhs;
+        case MP_BINARY_OP_MORE_EQUAL: return lhs >= rhs;
+        default: return lhs != rhs; // MP_BINARY_OP_NOT_EQUAL
+    }
+}
+
+// convert an int or uint to a viper float
+STATIC mp_uint_t mp_native_float_from_int(mp_uint_t val, mp_uint_t type) {
+    if (type == MP_NATIVE_TYPE_UINT) {
+        return native_float_bits((mp_float_t)val);
+    }
+    return native_float_bits((mp_float_t)(mp_int_t)val);
+}
+
+// convert a viper float to an int or uint, truncating towards zero
+STATIC mp_uint_t mp_native_float_to_int(mp_uint_t val, mp_uint_t type) {
+    if (type == MP_NATIVE_TYPE_UINT) {
+        return (mp_uint_t)native_float_value(val);
+    }
+    return (mp_int_t)native_float_value(val);
+}
+#endif
+
 // these must correspond to the respective enum in runtime0.h
 void *const mp_fun_table[MP_F_NUMBER_OF] = {
     mp_convert_obj_to_native,
@@ -173,6 +237,11 @@ void *const mp_fun_table[MP_F_NUMBER_OF] = {
     mp_setup_code_state,
     mp_small_int_floor_divide,
     mp_small_int_modulo,
+#if MICROPY_EMIT_NATIVE_FLOAT
+    mp_native_float_binary_op,
+    mp_native_float_from_int,
+    mp_native_float_to_int,
+#endif
 };
 
 /*
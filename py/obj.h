@@ -368,7 +368,9 @@ typedef struct _mp_map_t {
     size_t is_ordered : 1;  // an ordered array
     size_t scanning : 1;    // true if we're in the middle of scanning linked dictionaries,
                             // e.g., make_dict_long_lived()
-    size_t used : (8 * sizeof(size_t) - 4);
+    size_t is_compact : 1;  // an ordered array that becomes a hash table when it outgrows
+                            // MICROPY_MAP_COMPACT_MAX or gets a key that isn't a qstr
+    size_t used : (8 * sizeof(size_t) - 5);
     size_t alloc;
     mp_map_elem_t *table;
 } mp_map_t;
@@ -733,6 +735,14 @@ mp_obj_t mp_obj_exception_get_value(mp_obj_t self_in);
 mp_obj_t mp_obj_exception_make_new(const mp_obj_type_t *type_in, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args);
 mp_obj_t mp_alloc_emergency_exception_buf(mp_obj_t size_in);
 void mp_init_emergency_exception_buf(void);
+#if MICROPY_EXCEPTION_POOL_SIZE
+void mp_obj_exception_set_recyclable(mp_obj_t self_in);
+void mp_obj_exception_keep(mp_obj_t self_in);
+void mp_obj_exception_discard(mp_obj_t self_in);
+void mp_obj_exception_recycle(mp_obj_t self_in);
+#else
+#define mp_obj_exception_keep(self_in) (void)(self_in)
+#endif
 
 // str
 bool mp_obj_str_equal(mp_obj_t s1, mp_obj_t s2);
@@ -788,7 +798,18 @@ mp_map_t *mp_obj_dict_get_map(mp_obj_t self_in);
 // set
 void mp_obj_set_store(mp_obj_t self_in, mp_obj_t item);
 
+// enumerate
+// Gets the next pair in the order mp_unpack_sequence stores it, items[0] being the value and
+// items[1] the index, without making a tuple. Returns false when exhausted.
+bool mp_obj_enumerate_next_unpacked(mp_obj_t self_in, mp_obj_t *items);
+
 // slice
+typedef struct _mp_obj_slice_t {
+    mp_obj_base_t base;
+    mp_obj_t start;
+    mp_obj_t stop;
+    mp_obj_t step;
+} mp_obj_slice_t;
 void mp_obj_slice_get(mp_obj_t self_in, mp_obj_t *start, mp_obj_t *stop, mp_obj_t *step);
 
 // functions
@@ -849,6 +870,8 @@ typedef struct _mp_rom_obj_static_class_method_t {
 
 // property
 const mp_obj_t *mp_obj_property_get(mp_obj_t self_in);
+mp_obj_t mp_obj_property_call_get(mp_obj_t getter, mp_obj_t self_in);
+void mp_obj_property_call_set(mp_obj_t setter, mp_obj_t self_in, mp_obj_t value);
 
 // sequence helpers
 
@@ -110,6 +110,12 @@ STATIC mp_obj_array_t *array_new(char typecode, size_t n) {
 }
 #endif
 
+#if MICROPY_PY_ARRAY_VECTOR
+mp_obj_t mp_obj_new_array(char typecode, size_t n) {
+    return MP_OBJ_FROM_PTR(array_new(typecode, n));
+}
+#endif
+
 #if MICROPY_PY_BUILTINS_BYTEARRAY || MICROPY_PY_ARRAY
 STATIC mp_obj_t array_construct(char typecode, mp_obj_t initializer) {
     // bytearrays can be raw-initialised from anything with the buffer protocol
@@ -229,6 +235,38 @@ STATIC mp_obj_t memoryview_make_new(const mp_obj_type_t *type_in, size_t n_args,
 
     return MP_OBJ_FROM_PTR(self);
 }
+
+#if MICROPY_PY_BUILTINS_MEMORYVIEW_CAST
+// Returns a memoryview of the same memory with another item type. The start
+// of the view must stay a whole number of the new items from the base of the
+// buffer, which keeps them aligned.
+STATIC mp_obj_t memoryview_cast(mp_obj_t self_in, mp_obj_t format_in) {
+    mp_obj_array_t *self = MP_OBJ_TO_PTR(self_in);
+    const char *format = mp_obj_str_get_str(format_in);
+    // only plain numbers, the nonstandard typecodes could forge pointers
+    if (format[0] == '\0' || format[1] != '\0' || strchr("bBhHiIlLqQfd", format[0]) == NULL) {
+        mp_raise_ValueError(translate("bad typecode"));
+    }
+    size_t old_sz = mp_binary_get_size('@', self->typecode & TYPECODE_MASK, NULL);
+    size_t new_sz = mp_binary_get_size('@', format[0], NULL);
+    size_t offset = self->free * old_sz;
+    size_t len = self->len * old_sz;
+    if (offset % new_sz != 0 || len % new_sz != 0) {
+        mp_raise_ValueError(translate("buffer size must match format"));
+    }
+    mp_obj_array_t *o = MP_OBJ_TO_PTR(mp_obj_new_memoryview(
+        format[0] | (self->typecode & MP_OBJ_ARRAY_TYPECODE_FLAG_RW), len / new_sz, self->items));
+    o->free = offset / new_sz;
+    return MP_OBJ_FROM_PTR(o);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(memoryview_cast_obj, memoryview_cast);
+
+STATIC const mp_rom_map_elem_t memoryview_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_cast), MP_ROM_PTR(&memoryview_cast_obj) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(memoryview_locals_dict, memoryview_locals_dict_table);
+#endif
 #endif
 
 STATIC mp_obj_t array_unary_op(mp_unary_op_t op, mp_obj_t o_in) {
@@ -595,6 +633,9 @@ const mp_obj_type_t mp_type_memoryview = {
     .binary_op = array_binary_op,
     .subscr = array_subscr,
     .buffer_p = { .get_buffer = array_get_buffer },
+    #if MICROPY_PY_BUILTINS_MEMORYVIEW_CAST
+    .locals_dict = (mp_obj_dict_t*)&memoryview_locals_dict,
+    #endif
 };
 #endif
 
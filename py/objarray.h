@@ -42,4 +42,7 @@ typedef struct _mp_obj_array_t {
     void *items;
 } mp_obj_array_t;
 
+// Returns a new array of n uninitialised items
+mp_obj_t mp_obj_new_array(char typecode, size_t n);
+
 #endif // MICROPY_INCLUDED_PY_OBJARRAY_H
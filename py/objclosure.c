@@ -28,6 +28,7 @@
 
 #include "py/obj.h"
 #include "py/runtime.h"
+#include "py/bc.h"
 
 typedef struct _mp_obj_closure_t {
     mp_obj_base_t base;
@@ -95,3 +96,40 @@ mp_obj_t mp_obj_new_closure(mp_obj_t fun, size_t n_closed_over, const mp_obj_t *
     memcpy(o->closed, closed, n_closed_over * sizeof(mp_obj_t));
     return MP_OBJ_FROM_PTR(o);
 }
+
+#if MICROPY_STACKLESS
+bool mp_obj_is_closure_of_fun_bc(mp_obj_t self_in) {
+    if (!MP_OBJ_IS_TYPE(self_in, &closure_type)) {
+        return false;
+    }
+    mp_obj_closure_t *self = MP_OBJ_TO_PTR(self_in);
+    return MP_OBJ_IS_TYPE(self->fun, &mp_type_fun_bc);
+}
+
+mp_code_state_t *mp_obj_closure_alloc_codestate(mp_obj_t self_in) {
+    mp_obj_closure_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_fun_bc_alloc_codestate(self->fun);
+}
+
+// Like closure_call, but sets up a code state for the VM to run in place of
+// recursing.  The concatenated args only need to live until then, because
+// mp_setup_code_state copies them into the code state.
+void mp_obj_closure_init_codestate(mp_code_state_t *code_state, mp_obj_t self_in, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_obj_closure_t *self = MP_OBJ_TO_PTR(self_in);
+    size_t n_total = self->n_closed + n_args + 2 * n_kw;
+    if (n_total <= 5) {
+        mp_obj_t args2[5];
+        memcpy(args2, self->closed, self->n_closed * sizeof(mp_obj_t));
+        memcpy(args2 + self->n_closed, args, (n_args + 2 * n_kw) * sizeof(mp_obj_t));
+        mp_obj_fun_bc_init_codestate(code_state, self->n_closed + n_args, n_kw, args2);
+        return;
+    }
+    // The code state was allocated before this, so freeing it straight away
+    // is in LIFO order on the pystack.
+    mp_obj_t *args2 = mp_nonlocal_alloc(n_total * sizeof(mp_obj_t));
+    memcpy(args2, self->closed, self->n_closed * sizeof(mp_obj_t));
+    memcpy(args2 + self->n_closed, args, (n_args + 2 * n_kw) * sizeof(mp_obj_t));
+    mp_obj_fun_bc_init_codestate(code_state, self->n_closed + n_args, n_kw, args2);
+    mp_nonlocal_free(args2, n_total * sizeof(mp_obj_t));
+}
+#endif
@@ -47,6 +47,14 @@ typedef struct _mp_obj_complex_t {
     mp_float_t imag;
 } mp_obj_complex_t;
 
+STATIC void complex_format_part(mp_float_t f, char *buf, size_t buf_size, int precision) {
+    #if MICROPY_FLOAT_FORMAT_SHORTEST
+    mp_format_float_shortest(f, buf, buf_size, precision, 0);
+    #else
+    mp_format_float(f, buf, buf_size, 'g', precision, '\0');
+    #endif
+}
+
 STATIC void complex_print(const mp_print_t *print, mp_obj_t o_in, mp_print_kind_t kind) {
     (void)kind;
     mp_obj_complex_t *o = MP_OBJ_TO_PTR(o_in);
@@ -62,15 +70,15 @@ STATIC void complex_print(const mp_print_t *print, mp_obj_t o_in, mp_print_kind_
     const int precision = 16;
 #endif
     if (o->real == 0) {
-        mp_format_float(o->imag, buf, sizeof(buf), 'g', precision, '\0');
+        complex_format_part(o->imag, buf, sizeof(buf), precision);
         mp_printf(print, "%sj", buf);
     } else {
-        mp_format_float(o->real, buf, sizeof(buf), 'g', precision, '\0');
+        complex_format_part(o->real, buf, sizeof(buf), precision);
         mp_printf(print, "(%s", buf);
         if (o->imag >= 0 || isnan(o->imag)) {
             mp_print_str(print, "+");
         }
-        mp_format_float(o->imag, buf, sizeof(buf), 'g', precision, '\0');
+        complex_format_part(o->imag, buf, sizeof(buf), precision);
         mp_printf(print, "%sj)", buf);
     }
 }
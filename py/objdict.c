@@ -88,6 +88,7 @@ STATIC mp_obj_t dict_make_new(const mp_obj_type_t *type, size_t n_args, const mp
     #if MICROPY_PY_COLLECTIONS_ORDEREDDICT
     if (type == &mp_type_ordereddict) {
         dict->map.is_ordered = 1;
+        dict->map.is_compact = 0;
     }
     #endif
     if (n_args > 0 || kw_args != NULL) {
@@ -168,7 +169,7 @@ mp_obj_t mp_obj_dict_get(mp_obj_t self_in, mp_obj_t index) {
     mp_obj_dict_t *self = MP_OBJ_TO_PTR(self_in);
     mp_map_elem_t *elem = mp_map_lookup(&self->map, index, MP_MAP_LOOKUP);
     if (elem == NULL) {
-        nlr_raise(mp_obj_new_exception_arg1(&mp_type_KeyError, index));
+        mp_raise_arg1(&mp_type_KeyError, index);
     } else {
         return elem->value;
     }
@@ -184,7 +185,7 @@ STATIC mp_obj_t dict_subscr(mp_obj_t self_in, mp_obj_t index, mp_obj_t value) {
         mp_obj_dict_t *self = MP_OBJ_TO_PTR(self_in);
         mp_map_elem_t *elem = mp_map_lookup(&self->map, index, MP_MAP_LOOKUP);
         if (elem == NULL) {
-            nlr_raise(mp_obj_new_exception_arg1(&mp_type_KeyError, index));
+            mp_raise_arg1(&mp_type_KeyError, index);
         } else {
             return elem->value;
         }
@@ -225,6 +226,7 @@ STATIC mp_obj_t dict_copy(mp_obj_t self_in) {
     other->map.all_keys_are_qstrs = self->map.all_keys_are_qstrs;
     other->map.is_fixed = 0;
     other->map.is_ordered = self->map.is_ordered;
+    other->map.is_compact = self->map.is_compact;
     memcpy(other->map.table, self->map.table, self->map.alloc * sizeof(mp_map_elem_t));
     return other_out;
 }
@@ -271,7 +273,7 @@ STATIC mp_obj_t dict_get_helper(size_t n_args, const mp_obj_t *args, mp_map_look
     if (elem == NULL || elem->value == MP_OBJ_NULL) {
         if (n_args == 2) {
             if (lookup_kind == MP_MAP_LOOKUP_REMOVE_IF_FOUND) {
-                nlr_raise(mp_obj_new_exception_arg1(&mp_type_KeyError, args[1]));
+                mp_raise_arg1(&mp_type_KeyError, args[1]);
             } else {
                 value = mp_const_none;
             }
@@ -314,9 +316,14 @@ STATIC mp_obj_t dict_popitem(mp_obj_t self_in) {
     if (next == NULL) {
         mp_raise_msg(&mp_type_KeyError, translate("popitem(): dictionary is empty"));
     }
+    if (self->map.is_ordered) {
+        // an ordered array has no holes, so take the last element like CPython does
+        next = &self->map.table[self->map.used - 1];
+    }
     self->map.used--;
     mp_obj_t items[] = {next->key, next->value};
-    next->key = MP_OBJ_SENTINEL; // must mark key as sentinel to indicate that it was deleted
+    // must mark key as sentinel to indicate that it was deleted, unless it was the end of an ordered array
+    next->key = self->map.is_ordered ? MP_OBJ_NULL : MP_OBJ_SENTINEL;
     next->value = MP_OBJ_NULL;
     mp_obj_t tuple = mp_obj_new_tuple(2, items);
 
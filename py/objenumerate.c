@@ -89,4 +89,16 @@ STATIC mp_obj_t enumerate_iternext(mp_obj_t self_in) {
     }
 }
 
+bool mp_obj_enumerate_next_unpacked(mp_obj_t self_in, mp_obj_t *items) {
+    assert(MP_OBJ_IS_TYPE(self_in, &mp_type_enumerate));
+    mp_obj_enumerate_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_t next = mp_iternext(self->iter);
+    if (next == MP_OBJ_STOP_ITERATION) {
+        return false;
+    }
+    items[0] = next;
+    items[1] = MP_OBJ_NEW_SMALL_INT(self->cur++);
+    return true;
+}
+
 #endif // MICROPY_PY_BUILTINS_ENUMERATE
@@ -46,6 +46,9 @@
 // Number of traceback entries to reserve in the emergency exception buffer
 #define EMG_TRACEBACK_ALLOC (2 * TRACEBACK_ENTRY_LEN)
 
+// Largest traceback_alloc that fits in its bitfield
+#define TRACEBACK_ALLOC_MAX (((size_t)1 << (8 * sizeof(size_t) / 2 - 2)) - 1)
+
 // Optionally allocated buffer for storing the first argument of an exception
 // allocated when the heap is locked.
 #if MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF
@@ -94,7 +97,87 @@ mp_obj_t mp_alloc_emergency_exception_buf(mp_obj_t size_in) {
 // Instance of GeneratorExit exception - needed by generator.close()
 // This would belong to objgenerator.c, but to keep mp_obj_exception_t
 // definition module-private so far, have it here.
-const mp_obj_exception_t mp_const_GeneratorExit_obj = {{&mp_type_GeneratorExit}, 0, 0, NULL, (mp_obj_tuple_t*)&mp_const_empty_tuple_obj};
+const mp_obj_exception_t mp_const_GeneratorExit_obj = {{&mp_type_GeneratorExit}, .args = (mp_obj_tuple_t*)&mp_const_empty_tuple_obj};
+
+#if MICROPY_EXCEPTION_POOL_SIZE
+// An exception made by mp_raise_xxx() has no other references when it's raised,
+// and is marked recyclable.  It stays so while it is caught by an except clause
+// without "as" in the frame that called the raising function; the VM marks it
+// discarded when such a clause pops it.  Anything that may keep a reference
+// clears is_recyclable: raising it again from Python, sys.exc_info(), and any C
+// code that stores a caught exception (it must call mp_obj_exception_keep).
+// When the clause finishes, a recyclable and discarded exception goes in a pool
+// of free exceptions, and the next one created reuses it along with its
+// traceback buffer and, if the number of args matches, its args tuple.
+
+void mp_obj_exception_set_recyclable(mp_obj_t self_in) {
+    if (mp_obj_is_native_exception_instance(self_in)) {
+        mp_obj_exception_t *self = MP_OBJ_TO_PTR(self_in);
+        self->is_recyclable = 1;
+    }
+}
+
+// These two don't write to exceptions that aren't recyclable, which may be in ROM
+void mp_obj_exception_keep(mp_obj_t self_in) {
+    if (mp_obj_is_native_exception_instance(self_in)) {
+        mp_obj_exception_t *self = MP_OBJ_TO_PTR(self_in);
+        if (self->is_recyclable) {
+            self->is_recyclable = 0;
+        }
+    }
+}
+
+void mp_obj_exception_discard(mp_obj_t self_in) {
+    if (mp_obj_is_native_exception_instance(self_in)) {
+        mp_obj_exception_t *self = MP_OBJ_TO_PTR(self_in);
+        if (self->is_recyclable) {
+            self->is_discarded = 1;
+        }
+    }
+}
+
+void mp_obj_exception_recycle(mp_obj_t self_in) {
+    if (!mp_obj_is_native_exception_instance(self_in)) {
+        return;
+    }
+    mp_obj_exception_t *self = MP_OBJ_TO_PTR(self_in);
+    // with more than one traceback entry it went through other frames, which
+    // may have kept it; the emergency exception object isn't on the heap
+    if (!self->is_recyclable || !self->is_discarded
+        || self->traceback_len != TRACEBACK_ENTRY_LEN
+        || MP_STATE_VM(mp_exception_pool_len) == MICROPY_EXCEPTION_POOL_SIZE
+        || gc_nbytes(self) == 0) {
+        return;
+    }
+    self->is_recyclable = 0;
+    #if MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF
+    if (self->traceback_data == (size_t*)MP_STATE_VM(mp_emergency_exception_buf)) {
+        self->traceback_data = NULL;
+    }
+    #endif
+    if (gc_nbytes(self->args) == 0) {
+        // the empty tuple, or one in the emergency buffer
+        self->args = (mp_obj_tuple_t*)&mp_const_empty_tuple_obj;
+    } else {
+        // don't keep the old args alive
+        for (size_t i = 0; i < self->args->len; i++) {
+            self->args->items[i] = mp_const_none;
+        }
+    }
+    MP_STATE_VM(mp_exception_pool)[MP_STATE_VM(mp_exception_pool_len)++] = self;
+}
+
+// Take a free exception from the pool, or return NULL if there is none.
+STATIC mp_obj_exception_t *exception_pool_take(void) {
+    if (MP_STATE_VM(mp_exception_pool_len) == 0) {
+        return NULL;
+    }
+    size_t i = --MP_STATE_VM(mp_exception_pool_len);
+    mp_obj_exception_t *o_exc = MP_STATE_VM(mp_exception_pool)[i];
+    MP_STATE_VM(mp_exception_pool)[i] = NULL;
+    return o_exc;
+}
+#endif
 
 void mp_obj_exception_print(const mp_print_t *print, mp_obj_t o_in, mp_print_kind_t kind) {
     mp_obj_exception_t *o = MP_OBJ_TO_PTR(o_in);
@@ -133,23 +216,41 @@ void mp_obj_exception_print(const mp_print_t *print, mp_obj_t o_in, mp_print_kin
 mp_obj_t mp_obj_exception_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     mp_arg_check_num(n_args, kw_args, 0, MP_OBJ_FUN_ARGS_MAX, false);
 
-    // Try to allocate memory for the exception, with fallback to emergency exception object
-    mp_obj_exception_t *o_exc = m_new_obj_maybe(mp_obj_exception_t);
-    if (o_exc == NULL) {
-        o_exc = &MP_STATE_VM(mp_emergency_exception_obj);
+    mp_obj_exception_t *o_exc = NULL;
+    mp_obj_tuple_t *o_tuple = NULL;
+    #if MICROPY_EXCEPTION_POOL_SIZE
+    // Reuse a free exception, keeping its traceback buffer and args tuple
+    o_exc = exception_pool_take();
+    if (o_exc != NULL) {
+        o_exc->traceback_len = 0;
+        o_exc->is_discarded = 0;
+        if (o_exc->args->len == n_args) {
+            o_tuple = o_exc->args;
+        }
+    } else
+    #endif
+    {
+        // Try to allocate memory for the exception, with fallback to emergency exception object
+        o_exc = m_new_obj_maybe(mp_obj_exception_t);
+        if (o_exc == NULL) {
+            o_exc = &MP_STATE_VM(mp_emergency_exception_obj);
+        }
+        o_exc->traceback_data = NULL;
+        o_exc->is_recyclable = 0;
+        o_exc->is_discarded = 0;
     }
 
     // Populate the exception object
     o_exc->base.type = type;
-    o_exc->traceback_data = NULL;
 
-    mp_obj_tuple_t *o_tuple;
     if (n_args == 0) {
         // No args, can use the empty tuple straightaway
         o_tuple = (mp_obj_tuple_t*)&mp_const_empty_tuple_obj;
     } else {
-        // Try to allocate memory for the tuple containing the args
-        o_tuple = m_new_obj_var_maybe(mp_obj_tuple_t, mp_obj_t, n_args);
+        if (o_tuple == NULL) {
+            // Try to allocate memory for the tuple containing the args
+            o_tuple = m_new_obj_var_maybe(mp_obj_tuple_t, mp_obj_t, n_args);
+        }
 
         #if MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF
         // If we are called by mp_obj_new_exception_msg_varg then it will have
@@ -518,6 +619,9 @@ void mp_obj_exception_add_traceback(mp_obj_t self_in, qstr file, size_t line, qs
         }
         self->traceback_len = 0;
     } else if (self->traceback_len + TRACEBACK_ENTRY_LEN > self->traceback_alloc) {
+        if ((size_t)self->traceback_alloc + TRACEBACK_ENTRY_LEN > TRACEBACK_ALLOC_MAX) {
+            return;
+        }
         #if MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF
         if (self->traceback_data == (size_t*)MP_STATE_VM(mp_emergency_exception_buf)) {
             // Can't resize the emergency buffer
@@ -31,7 +31,10 @@
 
 typedef struct _mp_obj_exception_t {
     mp_obj_base_t base;
-    size_t traceback_alloc : (8 * sizeof(size_t) / 2);
+    size_t traceback_alloc : (8 * sizeof(size_t) / 2 - 2);
+    // for MICROPY_EXCEPTION_POOL_SIZE, see objexcept.c
+    size_t is_recyclable : 1;
+    size_t is_discarded : 1;
     size_t traceback_len : (8 * sizeof(size_t) / 2);
     size_t *traceback_data;
     mp_obj_tuple_t *args;
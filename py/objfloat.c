@@ -125,7 +125,12 @@ STATIC void float_print(const mp_print_t *print, mp_obj_t o_in, mp_print_kind_t
     char buf[32];
     const int precision = 16;
 #endif
+    #if MICROPY_FLOAT_FORMAT_SHORTEST
+    // float objects drop the low 2 bits of the mantissa with MICROPY_OBJ_REPR_C
+    mp_format_float_shortest(o_val, buf, sizeof(buf), precision, MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_C ? 2 : 0);
+    #else
     mp_format_float(o_val, buf, sizeof(buf), 'g', precision, '\0');
+    #endif
     mp_print_str(print, buf);
     if (strchr(buf, '.') == NULL && strchr(buf, 'e') == NULL && strchr(buf, 'n') == NULL) {
         // Python floats always have decimal point (unless inf or nan)
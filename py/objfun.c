@@ -167,7 +167,7 @@ qstr mp_obj_fun_get_name(mp_const_obj_t fun_in) {
     bc++; // skip n_pos_args
     bc++; // skip n_kwonly_args
     bc++; // skip n_def_pos_args
-    return mp_obj_code_get_name(bc);
+    return MP_BC_RESOLVE_QSTR(mp_obj_code_get_name(bc), fun->const_table);
 }
 
 #if MICROPY_CPYTHON_COMPAT
@@ -218,7 +218,10 @@ STATIC void dump_args(const mp_obj_t *a, size_t sz) {
     code_state->old_globals = mp_globals_get();
 
 #if MICROPY_STACKLESS
-mp_code_state_t *mp_obj_fun_bc_prepare_codestate(mp_obj_t self_in, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+// The code state is allocated and set up in two steps so that a caller that
+// has to build an args array can allocate it after the code state.  On the
+// pystack the array can then be freed as soon as the code state is set up.
+mp_code_state_t *mp_obj_fun_bc_alloc_codestate(mp_obj_t self_in) {
     MP_STACK_CHECK();
     mp_obj_fun_bc_t *self = MP_OBJ_TO_PTR(self_in);
 
@@ -240,12 +243,17 @@ mp_code_state_t *mp_obj_fun_bc_prepare_codestate(mp_obj_t self_in, size_t n_args
     }
     #endif
 
+    code_state->fun_bc = self;
+    return code_state;
+}
+
+void mp_obj_fun_bc_init_codestate(mp_code_state_t *code_state, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_obj_fun_bc_t *self = code_state->fun_bc;
+
     INIT_CODESTATE(code_state, self, n_args, n_kw, args);
 
     // execute the byte code with the correct globals context
     mp_globals_set(self->globals);
-
-    return code_state;
 }
 #endif
 
@@ -281,7 +289,14 @@ STATIC mp_obj_t fun_bc_call(mp_obj_t self_in, size_t n_args, size_t n_kw, const
 
     // execute the byte code with the correct globals context
     mp_globals_set(self->globals);
+    #if MICROPY_TRACK_CURRENT_CODE_STATE
+    mp_code_state_t *prev_code_state = MP_STATE_THREAD(current_code_state);
+    MP_STATE_THREAD(current_code_state) = code_state;
+    #endif
     mp_vm_return_kind_t vm_return_kind = mp_execute_bytecode(code_state, MP_OBJ_NULL);
+    #if MICROPY_TRACK_CURRENT_CODE_STATE
+    MP_STATE_THREAD(current_code_state) = prev_code_state;
+    #endif
     mp_globals_set(code_state->old_globals);
 
 #if VM_DETECT_STACK_OVERFLOW
@@ -29,7 +29,6 @@
 
 #include "py/objlist.h"
 #include "py/runtime.h"
-#include "py/stackctrl.h"
 
 #include "supervisor/shared/translate.h"
 
@@ -289,35 +288,368 @@ STATIC mp_obj_t list_pop(size_t n_args, const mp_obj_t *args) {
     return ret;
 }
 
-STATIC void mp_quicksort(mp_obj_t *head, mp_obj_t *tail, mp_obj_t key_fn, mp_obj_t binop_less_result) {
-    MP_STACK_CHECK();
-    while (head < tail) {
-        mp_obj_t *h = head - 1;
-        mp_obj_t *t = tail;
-        mp_obj_t v = key_fn == MP_OBJ_NULL ? tail[0] : mp_call_function_1(key_fn, tail[0]); // get pivot using key_fn
-        for (;;) {
-            do ++h; while (h < t && mp_binary_op(MP_BINARY_OP_LESS, key_fn == MP_OBJ_NULL ? h[0] : mp_call_function_1(key_fn, h[0]), v) == binop_less_result);
-            do --t; while (h < t && mp_binary_op(MP_BINARY_OP_LESS, v, key_fn == MP_OBJ_NULL ? t[0] : mp_call_function_1(key_fn, t[0])) == binop_less_result);
-            if (h >= t) break;
-            mp_obj_t x = h[0];
-            h[0] = t[0];
-            t[0] = x;
+// list.sort is a natural merge sort in the style of CPython's timsort, minus
+// its galloping mode.  Runs already present in the data are found and
+// extended to a minimum length by binary insertion, then merged pairwise
+// while keeping the run lengths on the stack roughly Fibonacci, so sorted or
+// nearly sorted input costs O(n) and the worst case is O(n log(n)).  Equal
+// elements never change order.
+//
+// The sort works on an array of elements that are either one word (the list
+// items themselves) or two (a key computed once by key_fn and its item).
+// Merges go through a buffer holding the shorter of the two runs; if that
+// can't be allocated they fall back to merging in place by rotation.
+
+#define LIST_SORT_MIN_MERGE (64)
+// Enough for any run stack that fits in memory; see the invariant in
+// list_sort_collapse.
+#define LIST_SORT_MAX_RUNS (40)
+
+typedef struct _list_sort_run_t {
+    mp_obj_t *base;
+    size_t len;
+} list_sort_run_t;
+
+typedef struct _list_sort_t {
+    size_t width;
+    bool reverse;
+    mp_obj_t *buf;
+    size_t buf_alloc;
+    // While a merge has elements out in buf, hole_len of them starting at
+    // hole_src still belong at hole_dest.  These are written on every step
+    // so they are right if a comparison raises.
+    mp_obj_t *volatile hole_dest;
+    mp_obj_t *volatile hole_src;
+    volatile size_t hole_len;
+    size_t n_runs;
+    list_sort_run_t runs[LIST_SORT_MAX_RUNS];
+} list_sort_t;
+
+// Whether element a must come before element b.  With reverse the comparison
+// is flipped rather than the result, so equal elements stay in order.
+STATIC bool list_sort_less(list_sort_t *s, const mp_obj_t *a, const mp_obj_t *b) {
+    if (s->reverse) {
+        const mp_obj_t *t = a;
+        a = b;
+        b = t;
+    }
+    return mp_obj_is_true(mp_binary_op(MP_BINARY_OP_LESS, a[0], b[0]));
+}
+
+STATIC void list_sort_copy(list_sort_t *s, mp_obj_t *dest, const mp_obj_t *src, size_t n) {
+    memmove(dest, src, n * s->width * sizeof(mp_obj_t));
+}
+
+STATIC void list_sort_reverse(list_sort_t *s, mp_obj_t *lo, mp_obj_t *hi) {
+    size_t w = s->width;
+    for (hi -= w; lo < hi; lo += w, hi -= w) {
+        for (size_t i = 0; i < w; ++i) {
+            mp_obj_t t = lo[i];
+            lo[i] = hi[i];
+            hi[i] = t;
+        }
+    }
+}
+
+// Swap the n1 elements at base with the n2 that follow them.
+STATIC void list_sort_rotate(list_sort_t *s, mp_obj_t *base, size_t n1, size_t n2) {
+    mp_obj_t *mid = base + n1 * s->width;
+    mp_obj_t *end = mid + n2 * s->width;
+    list_sort_reverse(s, base, mid);
+    list_sort_reverse(s, mid, end);
+    list_sort_reverse(s, base, end);
+}
+
+// Number of the n elements at base that x doesn't have to come before.
+STATIC size_t list_sort_upper_bound(list_sort_t *s, const mp_obj_t *base, size_t n, const mp_obj_t *x) {
+    size_t lo = 0;
+    while (lo < n) {
+        size_t mid = lo + (n - lo) / 2;
+        if (list_sort_less(s, x, base + mid * s->width)) {
+            n = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+// Number of the n elements at base that must come before x.
+STATIC size_t list_sort_lower_bound(list_sort_t *s, const mp_obj_t *base, size_t n, const mp_obj_t *x) {
+    size_t lo = 0;
+    while (lo < n) {
+        size_t mid = lo + (n - lo) / 2;
+        if (list_sort_less(s, base + mid * s->width, x)) {
+            lo = mid + 1;
+        } else {
+            n = mid;
+        }
+    }
+    return lo;
+}
+
+// Extend the sorted prefix of length start to all n elements at base.
+STATIC void list_sort_insertion(list_sort_t *s, mp_obj_t *base, size_t n, size_t start) {
+    size_t w = s->width;
+    for (size_t i = start; i < n; ++i) {
+        mp_obj_t *x = base + i * w;
+        size_t pos = list_sort_upper_bound(s, base, i, x);
+        if (pos < i) {
+            mp_obj_t t[2];
+            list_sort_copy(s, t, x, 1);
+            list_sort_copy(s, base + (pos + 1) * w, base + pos * w, i - pos);
+            list_sort_copy(s, base + pos * w, t, 1);
+        }
+    }
+}
+
+// Length of the run at the start of the n elements at base.  A strictly
+// descending run is reversed in place; requiring it to be strict keeps the
+// sort stable.
+STATIC size_t list_sort_count_run(list_sort_t *s, mp_obj_t *base, size_t n) {
+    size_t w = s->width;
+    if (n < 2) {
+        return n;
+    }
+    size_t len = 2;
+    if (list_sort_less(s, base + w, base)) {
+        while (len < n && list_sort_less(s, base + len * w, base + (len - 1) * w)) {
+            ++len;
+        }
+        list_sort_reverse(s, base, base + len * w);
+    } else {
+        while (len < n && !list_sort_less(s, base + len * w, base + (len - 1) * w)) {
+            ++len;
         }
-        mp_obj_t x = h[0];
-        h[0] = tail[0];
-        tail[0] = x;
-        // do the smaller recursive call first, to keep stack within O(log(N))
-        if (t - head < tail - h - 1) {
-            mp_quicksort(head, t, key_fn, binop_less_result);
-            head = h + 1;
+    }
+    return len;
+}
+
+// Minimum run length for n elements, chosen so that n / minrun is a power of
+// two or slightly less, which keeps the final merges balanced.
+STATIC size_t list_sort_min_run(size_t n) {
+    size_t r = 0;
+    while (n >= LIST_SORT_MIN_MERGE) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+STATIC bool list_sort_ensure_buf(list_sort_t *s, size_t n) {
+    if (n <= s->buf_alloc) {
+        return true;
+    }
+    if (s->buf != NULL) {
+        m_del(mp_obj_t, s->buf, s->buf_alloc * s->width);
+        s->buf_alloc = 0;
+    }
+    s->buf = m_new_maybe(mp_obj_t, n * s->width);
+    if (s->buf == NULL) {
+        return false;
+    }
+    s->buf_alloc = n;
+    return true;
+}
+
+// Merge the n1 elements at a with the n2 at b, which directly follow them,
+// going forwards from a copy of the first run.
+STATIC void list_sort_merge_lo(list_sort_t *s, mp_obj_t *a, size_t n1, mp_obj_t *b, size_t n2) {
+    size_t w = s->width;
+    mp_obj_t *src = s->buf;
+    list_sort_copy(s, src, a, n1);
+    mp_obj_t *dest = a;
+    s->hole_dest = dest;
+    s->hole_src = src;
+    s->hole_len = n1;
+    while (n1 > 0 && n2 > 0) {
+        if (list_sort_less(s, b, src)) {
+            list_sort_copy(s, dest, b, 1);
+            b += w;
+            --n2;
         } else {
-            mp_quicksort(h + 1, tail, key_fn, binop_less_result);
-            tail = t;
+            list_sort_copy(s, dest, src, 1);
+            src += w;
+            --n1;
+            s->hole_src = src;
+            s->hole_len = n1;
+        }
+        dest += w;
+        s->hole_dest = dest;
+    }
+    list_sort_copy(s, dest, src, n1);
+    s->hole_len = 0;
+}
+
+// As list_sort_merge_lo but going backwards from a copy of the second run.
+STATIC void list_sort_merge_hi(list_sort_t *s, mp_obj_t *a, size_t n1, mp_obj_t *b, size_t n2) {
+    size_t w = s->width;
+    list_sort_copy(s, s->buf, b, n2);
+    mp_obj_t *src = s->buf + (n2 - 1) * w;
+    mp_obj_t *dest = b + (n2 - 1) * w;
+    a += (n1 - 1) * w;
+    s->hole_dest = b;
+    s->hole_src = s->buf;
+    s->hole_len = n2;
+    while (n1 > 0 && n2 > 0) {
+        if (list_sort_less(s, src, a)) {
+            list_sort_copy(s, dest, a, 1);
+            a -= w;
+            --n1;
+        } else {
+            list_sort_copy(s, dest, src, 1);
+            src -= w;
+            --n2;
+            s->hole_len = n2;
+        }
+        dest -= w;
+        s->hole_dest = dest + w - n2 * w;
+    }
+    list_sort_copy(s, dest + w - n2 * w, s->buf, n2);
+    s->hole_len = 0;
+}
+
+// Merge without a buffer: move each block of the second run that goes
+// before the head of the first into place with a rotation.
+STATIC void list_sort_merge_in_place(list_sort_t *s, mp_obj_t *a, size_t n1, mp_obj_t *b, size_t n2) {
+    size_t w = s->width;
+    while (n1 > 0 && n2 > 0) {
+        size_t k = list_sort_lower_bound(s, b, n2, a);
+        list_sort_rotate(s, a, n1, k);
+        a += (k + 1) * w;
+        b += k * w;
+        n2 -= k;
+        --n1;
+        if (n2 > 0) {
+            k = list_sort_upper_bound(s, a, n1, b);
+            a += k * w;
+            n1 -= k;
+        }
+    }
+}
+
+STATIC void list_sort_merge_at(list_sort_t *s, size_t i) {
+    size_t w = s->width;
+    mp_obj_t *a = s->runs[i].base;
+    size_t n1 = s->runs[i].len;
+    mp_obj_t *b = s->runs[i + 1].base;
+    size_t n2 = s->runs[i + 1].len;
+    s->runs[i].len = n1 + n2;
+    if (i + 2 < s->n_runs) {
+        s->runs[i + 1] = s->runs[i + 2];
+    }
+    --s->n_runs;
+
+    // elements of the first run that go before all of the second are
+    // already in place, as are those of the second after all of the first
+    size_t k = list_sort_upper_bound(s, a, n1, b);
+    a += k * w;
+    n1 -= k;
+    if (n1 == 0) {
+        return;
+    }
+    n2 = list_sort_lower_bound(s, b, n2, a + (n1 - 1) * w);
+    if (n2 == 0) {
+        return;
+    }
+
+    if (!list_sort_ensure_buf(s, MIN(n1, n2))) {
+        list_sort_merge_in_place(s, a, n1, b, n2);
+    } else if (n1 <= n2) {
+        list_sort_merge_lo(s, a, n1, b, n2);
+    } else {
+        list_sort_merge_hi(s, a, n1, b, n2);
+    }
+}
+
+// Merge runs until, for the top three lengths, A > B + C and B > C.  This
+// bounds the stack depth by the log of n to the base of the golden ratio.
+STATIC void list_sort_collapse(list_sort_t *s) {
+    list_sort_run_t *r = s->runs;
+    while (s->n_runs > 1) {
+        size_t i = s->n_runs - 2;
+        if ((i > 0 && r[i - 1].len <= r[i].len + r[i + 1].len)
+            || (i > 1 && r[i - 2].len <= r[i - 1].len + r[i].len)) {
+            if (r[i - 1].len < r[i + 1].len) {
+                --i;
+            }
+        } else if (r[i].len > r[i + 1].len) {
+            break;
+        }
+        list_sort_merge_at(s, i);
+    }
+}
+
+STATIC void list_sort_run(list_sort_t *s, mp_obj_t *base, size_t n) {
+    size_t w = s->width;
+    size_t min_run = list_sort_min_run(n);
+    while (n > 0) {
+        size_t len = list_sort_count_run(s, base, n);
+        if (len < min_run) {
+            size_t forced = MIN(min_run, n);
+            list_sort_insertion(s, base, forced, len);
+            len = forced;
+        }
+        s->runs[s->n_runs].base = base;
+        s->runs[s->n_runs].len = len;
+        ++s->n_runs;
+        list_sort_collapse(s);
+        base += len * w;
+        n -= len;
+    }
+    while (s->n_runs > 1) {
+        size_t i = s->n_runs - 2;
+        if (i > 0 && s->runs[i - 1].len < s->runs[i + 1].len) {
+            --i;
+        }
+        list_sort_merge_at(s, i);
+    }
+}
+
+STATIC void list_sort(mp_obj_t *items, size_t n, mp_obj_t key_fn, bool reverse) {
+    list_sort_t s;
+    s.reverse = reverse;
+    s.buf = NULL;
+    s.buf_alloc = 0;
+    s.hole_len = 0;
+    s.n_runs = 0;
+
+    // with a key function, sort (key, item) pairs so each key is computed once
+    mp_obj_t *base = items;
+    s.width = 1;
+    if (key_fn != MP_OBJ_NULL) {
+        base = m_new(mp_obj_t, 2 * n);
+        for (size_t i = 0; i < n; ++i) {
+            base[2 * i] = mp_call_function_1(key_fn, items[i]);
+            base[2 * i + 1] = items[i];
+        }
+        s.width = 2;
+    }
+
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        list_sort_run(&s, base, n);
+        nlr_pop();
+    } else {
+        // put back whatever a merge had out in the buffer so the list is
+        // still a permutation of its items
+        if (s.hole_len > 0) {
+            list_sort_copy(&s, s.hole_dest, s.hole_src, s.hole_len);
+        }
+        nlr_jump(nlr.ret_val);
+    }
+
+    if (s.buf != NULL) {
+        m_del(mp_obj_t, s.buf, s.buf_alloc * s.width);
+    }
+    if (key_fn != MP_OBJ_NULL) {
+        for (size_t i = 0; i < n; ++i) {
+            items[i] = base[2 * i + 1];
         }
+        m_del(mp_obj_t, base, 2 * n);
     }
 }
 
-// TODO Python defines sort to be stable but ours is not
 mp_obj_t mp_obj_list_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_key, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_PTR(&mp_const_none_obj)} },
@@ -335,9 +667,9 @@ mp_obj_t mp_obj_list_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_
     mp_obj_list_t *self = MP_OBJ_TO_PTR(pos_args[0]);
 
     if (self->len > 1) {
-        mp_quicksort(self->items, self->items + self->len - 1,
-                     args.key.u_obj == mp_const_none ? MP_OBJ_NULL : args.key.u_obj,
-                     args.reverse.u_bool ? mp_const_false : mp_const_true);
+        list_sort(self->items, self->len,
+                  args.key.u_obj == mp_const_none ? MP_OBJ_NULL : args.key.u_obj,
+                  args.reverse.u_bool);
     }
 
     return mp_const_none;
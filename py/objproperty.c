@@ -101,4 +101,24 @@ const mp_obj_t *mp_obj_property_get(mp_obj_t self_in) {
     return self->proxy;
 }
 
+// Getters and setters written in C, such as those in shared-bindings, are called through their
+// function pointer rather than through mp_call_function_n_kw, which would check the arguments.
+mp_obj_t mp_obj_property_call_get(mp_obj_t getter, mp_obj_t self_in) {
+    if (MP_OBJ_IS_TYPE(getter, &mp_type_fun_builtin_1)) {
+        const mp_obj_fun_builtin_fixed_t *fun = MP_OBJ_TO_PTR(getter);
+        return fun->fun._1(self_in);
+    }
+    return mp_call_function_n_kw(getter, 1, 0, &self_in);
+}
+
+void mp_obj_property_call_set(mp_obj_t setter, mp_obj_t self_in, mp_obj_t value) {
+    if (MP_OBJ_IS_TYPE(setter, &mp_type_fun_builtin_2)) {
+        const mp_obj_fun_builtin_fixed_t *fun = MP_OBJ_TO_PTR(setter);
+        fun->fun._2(self_in, value);
+        return;
+    }
+    mp_obj_t args[2] = {self_in, value};
+    mp_call_function_n_kw(setter, 2, 0, args);
+}
+
 #endif // MICROPY_PY_BUILTINS_PROPERTY
@@ -40,12 +40,6 @@
 
 // TODO: This implements only variant of slice with 2 integer args only.
 // CPython supports 3rd arg (step), plus args can be arbitrary Python objects.
-typedef struct _mp_obj_slice_t {
-    mp_obj_base_t base;
-    mp_obj_t start;
-    mp_obj_t stop;
-    mp_obj_t step;
-} mp_obj_slice_t;
 
 STATIC void slice_print(const mp_print_t *print, mp_obj_t o_in, mp_print_kind_t kind) {
     (void)kind;
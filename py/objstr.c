@@ -284,29 +284,85 @@ wrong_args:
     mp_raise_TypeError(translate("wrong number of arguments"));
 }
 
+// Haystacks at least this long are searched with Horspool's algorithm, which
+// costs a 256-entry table up front but then skips ahead by up to the needle
+// length at each mismatch. Shorter ones aren't worth building the table for.
+#define FIND_SUBBYTES_HORSPOOL_MIN (64)
+
+STATIC const byte *find_subbytes_horspool(const byte *haystack, size_t hlen, const byte *needle, size_t nlen, int direction) {
+    // How far the window can move when the byte at its leading end is a given
+    // value. Capping at 255 keeps the table small and only ever shortens a
+    // skip, which is always safe.
+    byte skip[256];
+    memset(skip, nlen < 255 ? nlen : 255, sizeof(skip));
+    if (direction > 0) {
+        for (size_t i = 0; i < nlen - 1; i++) {
+            size_t d = nlen - 1 - i;
+            skip[needle[i]] = d < 255 ? d : 255;
+        }
+        const byte *last = needle + nlen - 1;
+        for (size_t pos = 0; pos <= hlen - nlen;) {
+            byte b = haystack[pos + nlen - 1];
+            if (b == *last && memcmp(haystack + pos, needle, nlen - 1) == 0) {
+                return haystack + pos;
+            }
+            pos += skip[b];
+        }
+    } else {
+        for (size_t i = nlen - 1; i > 0; i--) {
+            skip[needle[i]] = i < 255 ? i : 255;
+        }
+        for (size_t pos = hlen - nlen;;) {
+            byte b = haystack[pos];
+            if (b == *needle && memcmp(haystack + pos + 1, needle + 1, nlen - 1) == 0) {
+                return haystack + pos;
+            }
+            if (pos < skip[b]) {
+                break;
+            }
+            pos -= skip[b];
+        }
+    }
+    return NULL;
+}
+
 // like strstr but with specified length and allows \0 bytes
-// TODO replace with something more efficient/standard
 const byte *find_subbytes(const byte *haystack, size_t hlen, const byte *needle, size_t nlen, int direction) {
-    if (hlen >= nlen) {
-        size_t str_index, str_index_end;
+    if (hlen < nlen) {
+        return NULL;
+    }
+    if (nlen == 1) {
         if (direction > 0) {
-            str_index = 0;
-            str_index_end = hlen - nlen;
-        } else {
-            str_index = hlen - nlen;
-            str_index_end = 0;
+            return memchr(haystack, *needle, hlen);
         }
-        for (;;) {
-            if (memcmp(&haystack[str_index], needle, nlen) == 0) {
-                //found
-                return haystack + str_index;
-            }
-            if (str_index == str_index_end) {
-                //not found
-                break;
+        for (const byte *p = haystack + hlen; p != haystack;) {
+            if (*--p == *needle) {
+                return p;
             }
-            str_index += direction;
         }
+        return NULL;
+    }
+    if (nlen > 1 && hlen >= FIND_SUBBYTES_HORSPOOL_MIN) {
+        return find_subbytes_horspool(haystack, hlen, needle, nlen, direction);
+    }
+    size_t str_index, str_index_end;
+    if (direction > 0) {
+        str_index = 0;
+        str_index_end = hlen - nlen;
+    } else {
+        str_index = hlen - nlen;
+        str_index_end = 0;
+    }
+    for (;;) {
+        if (memcmp(&haystack[str_index], needle, nlen) == 0) {
+            //found
+            return haystack + str_index;
+        }
+        if (str_index == str_index_end) {
+            //not found
+            break;
+        }
+        str_index += direction;
     }
     return NULL;
 }
@@ -568,14 +624,9 @@ mp_obj_t mp_obj_str_split(size_t n_args, const mp_obj_t *args) {
 
         for (;;) {
             const byte *start = s;
-            for (;;) {
-                if (splits == 0 || s + sep_len > top) {
-                    s = top;
-                    break;
-                } else if (memcmp(s, sep_str, sep_len) == 0) {
-                    break;
-                }
-                s++;
+            s = splits == 0 ? NULL : find_subbytes(s, top - s, (const byte*)sep_str, sep_len, 1);
+            if (s == NULL) {
+                s = top;
             }
             mp_obj_list_append(res, mp_obj_new_str_of_type(self_type, start, s - start));
             if (s >= top) {
@@ -674,16 +725,8 @@ STATIC mp_obj_t str_rsplit(size_t n_args, const mp_obj_t *args) {
         const byte *beg = s;
         const byte *last = s + len;
         for (;;) {
-            s = last - sep_len;
-            for (;;) {
-                if (splits == 0 || s < beg) {
-                    break;
-                } else if (memcmp(s, sep_str, sep_len) == 0) {
-                    break;
-                }
-                s--;
-            }
-            if (s < beg || splits == 0) {
+            s = splits == 0 ? NULL : find_subbytes(beg, last - beg, (const byte*)sep_str, sep_len, -1);
+            if (s == NULL) {
                 res->items[idx] = mp_obj_new_str_of_type(self_type, beg, last - beg);
                 break;
             }
@@ -962,7 +1005,8 @@ STATIC NORETURN void terse_str_format_value_error(void) {
 STATIC vstr_t mp_obj_str_format_helper(const char *str, const char *top, int *arg_i, size_t n_args, const mp_obj_t *args, mp_map_t *kwargs) {
     vstr_t vstr;
     mp_print_t print;
-    vstr_init_print(&vstr, 16, &print);
+    // The result is usually about as long as the format string.
+    vstr_init_print(&vstr, top - str + 16, &print);
 
     for (; str < top; str++) {
         if (*str == '}') {
@@ -1417,7 +1461,8 @@ STATIC mp_obj_t str_modulo_format(mp_obj_t pattern, size_t n_args, const mp_obj_
     size_t arg_i = 0;
     vstr_t vstr;
     mp_print_t print;
-    vstr_init_print(&vstr, 16, &print);
+    // The result is usually about as long as the format string.
+    vstr_init_print(&vstr, len + 16, &print);
 
     for (const byte *top = str + len; str < top; str++) {
         mp_obj_t arg = MP_OBJ_NULL;
@@ -1740,13 +1785,13 @@ STATIC mp_obj_t str_count(size_t n_args, const mp_obj_t *args) {
 
     // count the occurrences
     mp_int_t num_occurrences = 0;
-    for (const byte *haystack_ptr = start; haystack_ptr + needle_len <= end;) {
-        if (memcmp(haystack_ptr, needle, needle_len) == 0) {
-            num_occurrences++;
-            haystack_ptr += needle_len;
-        } else {
-            haystack_ptr = utf8_next_char(haystack_ptr);
+    for (const byte *haystack_ptr = start; haystack_ptr < end;) {
+        haystack_ptr = find_subbytes(haystack_ptr, end - haystack_ptr, needle, needle_len, 1);
+        if (haystack_ptr == NULL) {
+            break;
         }
+        num_occurrences++;
+        haystack_ptr += needle_len;
     }
 
     return MP_OBJ_NEW_SMALL_INT(num_occurrences);
@@ -172,6 +172,29 @@ STATIC mp_obj_t stringio_getvalue(mp_obj_t self_in) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(stringio_getvalue_obj, stringio_getvalue);
 
+// Truncating keeps the buffer, so writing into the same object again after
+// seek(0) and truncate() builds the next string without reallocating.
+STATIC mp_obj_t stringio_truncate(size_t n_args, const mp_obj_t *args) {
+    mp_obj_stringio_t *self = MP_OBJ_TO_PTR(args[0]);
+    check_stringio_is_open(self);
+    mp_uint_t size = self->pos;
+    if (n_args > 1 && args[1] != mp_const_none) {
+        mp_int_t s = mp_obj_get_int(args[1]);
+        if (s < 0) {
+            mp_raise_ValueError(translate("negative size"));
+        }
+        size = s;
+    }
+    if (size < self->vstr->len) {
+        if (self->vstr->fixed_buf) {
+            stringio_copy_on_write(self);
+        }
+        self->vstr->len = size;
+    }
+    return mp_obj_new_int_from_uint(size);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(stringio_truncate_obj, 1, 2, stringio_truncate);
+
 STATIC mp_obj_t stringio___exit__(size_t n_args, const mp_obj_t *args) {
     (void)n_args;
     return mp_stream_close(args[0]);
@@ -232,6 +255,7 @@ STATIC const mp_rom_map_elem_t stringio_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_seek), MP_ROM_PTR(&mp_stream_seek_obj) },
     { MP_ROM_QSTR(MP_QSTR_flush), MP_ROM_PTR(&mp_stream_flush_obj) },
     { MP_ROM_QSTR(MP_QSTR_close), MP_ROM_PTR(&mp_stream_close_obj) },
+    { MP_ROM_QSTR(MP_QSTR_truncate), MP_ROM_PTR(&stringio_truncate_obj) },
     { MP_ROM_QSTR(MP_QSTR_getvalue), MP_ROM_PTR(&stringio_getvalue_obj) },
     { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&mp_identity_obj) },
     { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&stringio___exit___obj) },
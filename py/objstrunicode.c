@@ -100,12 +100,86 @@ STATIC void uni_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t
     }
 }
 
+#if MICROPY_OPT_STR_INDEX_CACHE
+#define STR_INDEX_STRIDE (MICROPY_OPT_STR_INDEX_CACHE_STRIDE)
+
+// Shorter strings are scanned each time.
+#define STR_INDEX_CACHE_MIN_LEN (2 * STR_INDEX_STRIDE)
+
+// Returns the cache entry for a string, recording its character positions if
+// it isn't there already. Returns NULL if there's no memory for them.
+STATIC const mp_str_index_cache_entry_t *str_index_cache_get(const byte *data, size_t len) {
+    mp_str_index_cache_entry_t *cache = MP_STATE_VM(str_index_cache);
+    for (size_t i = 0; i < MICROPY_OPT_STR_INDEX_CACHE_SIZE; i++) {
+        if (cache[i].data == data && cache[i].len == len) {
+            return &cache[i];
+        }
+    }
+
+    mp_str_index_cache_entry_t *entry = &cache[MP_STATE_VM(str_index_cache_next)];
+    MP_STATE_VM(str_index_cache_next) = (MP_STATE_VM(str_index_cache_next) + 1) % MICROPY_OPT_STR_INDEX_CACHE_SIZE;
+    entry->data = NULL;
+    entry->checkpoints = NULL;
+
+    size_t n_chars = utf8_charlen(data, len);
+    size_t *checkpoints = NULL;
+    if (n_chars != len && n_chars > STR_INDEX_STRIDE) {
+        checkpoints = m_new_maybe(size_t, (n_chars - 1) / STR_INDEX_STRIDE);
+        if (checkpoints == NULL) {
+            return NULL;
+        }
+        size_t n = 0;
+        size_t i = 0;
+        for (size_t offset = 0; offset < len; offset++) {
+            if (!UTF8_IS_CONT(data[offset])) {
+                if (i != 0 && i % STR_INDEX_STRIDE == 0) {
+                    checkpoints[n++] = offset;
+                }
+                i++;
+            }
+        }
+    }
+    entry->data = data;
+    entry->len = len;
+    entry->n_chars = n_chars;
+    entry->checkpoints = checkpoints;
+    return entry;
+}
+
+// Pointer to the lead byte of character i, which must be in range.
+STATIC const byte *str_index_cache_ptr(const mp_str_index_cache_entry_t *entry, size_t i) {
+    if (entry->n_chars == entry->len) {
+        return entry->data + i;
+    }
+    const byte *s = entry->data;
+    if (i >= STR_INDEX_STRIDE) {
+        s += entry->checkpoints[i / STR_INDEX_STRIDE - 1];
+        i %= STR_INDEX_STRIDE;
+    }
+    while (i--) {
+        ++s;
+        while (UTF8_IS_CONT(*s)) {
+            ++s;
+        }
+    }
+    return s;
+}
+#endif
+
 STATIC mp_obj_t uni_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
     GET_STR_DATA_LEN(self_in, str_data, str_len);
     switch (op) {
         case MP_UNARY_OP_BOOL:
             return mp_obj_new_bool(str_len != 0);
         case MP_UNARY_OP_LEN:
+            #if MICROPY_OPT_STR_INDEX_CACHE
+            if (str_len >= STR_INDEX_CACHE_MIN_LEN) {
+                const mp_str_index_cache_entry_t *entry = str_index_cache_get(str_data, str_len);
+                if (entry != NULL) {
+                    return MP_OBJ_NEW_SMALL_INT(entry->n_chars);
+                }
+            }
+            #endif
             return MP_OBJ_NEW_SMALL_INT(utf8_charlen(str_data, str_len));
         default:
             return MP_OBJ_NULL; // op not supported
@@ -124,6 +198,32 @@ size_t str_offset_to_index(const mp_obj_type_t *type, const byte *self_data, siz
 
     size_t index_val = 0;
     const byte *s = self_data;
+    #if MICROPY_OPT_STR_INDEX_CACHE
+    if (self_len >= STR_INDEX_CACHE_MIN_LEN) {
+        const mp_str_index_cache_entry_t *entry = str_index_cache_get(self_data, self_len);
+        if (entry != NULL) {
+            if (entry->n_chars == self_len) {
+                return offset;
+            }
+            // start from the last checkpoint at or before offset
+            size_t lo = 0;
+            size_t hi = entry->checkpoints == NULL ? 0 : (entry->n_chars - 1) / STR_INDEX_STRIDE;
+            while (lo < hi) {
+                size_t mid = (lo + hi + 1) / 2;
+                if (entry->checkpoints[mid - 1] <= offset) {
+                    lo = mid;
+                } else {
+                    hi = mid - 1;
+                }
+            }
+            if (lo > 0) {
+                index_val = lo * STR_INDEX_STRIDE;
+                s += entry->checkpoints[lo - 1];
+                offset -= entry->checkpoints[lo - 1];
+            }
+        }
+    }
+    #endif
     for (size_t i = 0; i < offset; i++, s++) {
         if (!UTF8_IS_CONT(*s)) {
             ++index_val;
@@ -154,6 +254,28 @@ const byte *str_index_to_ptr(const mp_obj_type_t *type, const byte *self_data, s
         mp_raise_TypeError_varg(translate("string indices must be integers, not %s"), mp_obj_get_type_str(index));
     }
     const byte *s, *top = self_data + self_len;
+    #if MICROPY_OPT_STR_INDEX_CACHE
+    if (self_len >= STR_INDEX_CACHE_MIN_LEN) {
+        const mp_str_index_cache_entry_t *entry = str_index_cache_get(self_data, self_len);
+        if (entry != NULL) {
+            if (i < 0) {
+                i += entry->n_chars;
+                if (i < 0) {
+                    if (is_slice) {
+                        return self_data;
+                    }
+                    mp_raise_IndexError(translate("string index out of range"));
+                }
+            } else if ((size_t)i >= entry->n_chars) {
+                if (is_slice) {
+                    return top;
+                }
+                mp_raise_IndexError(translate("string index out of range"));
+            }
+            return str_index_cache_ptr(entry, i);
+        }
+    }
+    #endif
     if (i < 0)
     {
         // Negative indexing is performed by counting from the end of the string.
@@ -48,9 +48,6 @@
 #define ENABLE_SPECIAL_ACCESSORS \
     (MICROPY_PY_DESCRIPTORS  || MICROPY_PY_DELATTR_SETATTR || MICROPY_PY_BUILTINS_PROPERTY)
 
-#define TYPE_FLAG_IS_SUBCLASSED (0x0001)
-#define TYPE_FLAG_HAS_SPECIAL_ACCESSORS (0x0002)
-
 STATIC mp_obj_t static_class_method_make_new(const mp_obj_type_t *self_in, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args);
 
 /******************************************************************************/
@@ -104,6 +101,18 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_KW(native_base_init_wrapper_obj, 1, native_base_i
 STATIC
 #endif
 mp_obj_instance_t *mp_obj_new_instance(const mp_obj_type_t *class, const mp_obj_type_t **native_base) {
+    #if MICROPY_PY_SLOTS
+    if (mp_obj_type_has_slots(class)) {
+        // slotted classes never have a native base
+        size_t n_slots = ((const mp_obj_slots_type_t*)class)->n_slots;
+        mp_obj_slots_instance_t *o = m_new_obj_var(mp_obj_slots_instance_t, mp_obj_t, n_slots);
+        o->base.type = class;
+        for (size_t i = 0; i < n_slots; i++) {
+            o->slots[i] = MP_OBJ_NULL;
+        }
+        return (mp_obj_instance_t*)o;
+    }
+    #endif
     size_t num_native_bases = instance_count_native_bases(class, native_base);
     assert(num_native_bases < 2);
     mp_obj_instance_t *o = m_new_obj_var(mp_obj_instance_t, mp_obj_t, num_native_bases);
@@ -148,9 +157,37 @@ struct class_lookup_data {
     size_t meth_offset;
     mp_obj_t *dest;
     bool is_type;
+    #if MICROPY_OPT_ATTR_LOOKUP_CACHE
+    // Filled in by class_lookup_walk for the attribute lookup cache.
+    bool cacheable;
+    const mp_obj_type_t *found_type;
+    mp_obj_t found_value;
+    #endif
 };
 
-STATIC void mp_obj_class_lookup(struct class_lookup_data  *lookup, const mp_obj_type_t *type) {
+// Fill in lookup->dest for value, found in the locals_dict of type.
+STATIC void class_lookup_found(struct class_lookup_data *lookup, const mp_obj_type_t *type, mp_obj_t value) {
+    if (lookup->is_type) {
+        // If we look up a class method, we need to return original type for which we
+        // do a lookup, not a (base) type in which we found the class method.
+        const mp_obj_type_t *org_type = (const mp_obj_type_t*)lookup->obj;
+        mp_convert_member_lookup(MP_OBJ_NULL, org_type, value, lookup->dest);
+    } else if (MP_OBJ_IS_TYPE(value, &mp_type_property)) {
+        lookup->dest[0] = value;
+    } else {
+        mp_obj_instance_t *obj = lookup->obj;
+        mp_obj_t obj_obj;
+        if (obj != NULL && mp_obj_is_native_type(type) && type != &mp_type_object /* object is not a real type */) {
+            // If we're dealing with native base class, then it applies to native sub-object
+            obj_obj = obj->subobj[0];
+        } else {
+            obj_obj = MP_OBJ_FROM_PTR(obj);
+        }
+        mp_convert_member_lookup(obj_obj, type, value, lookup->dest);
+    }
+}
+
+STATIC void class_lookup_walk(struct class_lookup_data  *lookup, const mp_obj_type_t *type) {
     assert(lookup->dest[0] == MP_OBJ_NULL);
     assert(lookup->dest[1] == MP_OBJ_NULL);
     for (;;) {
@@ -167,6 +204,9 @@ STATIC void mp_obj_class_lookup(struct class_lookup_data  *lookup, const mp_obj_
                 DEBUG_printf("mp_obj_class_lookup: Matched special meth slot (off=%d) for %s\n",
                     lookup->meth_offset, qstr_str(lookup->attr));
                 lookup->dest[0] = MP_OBJ_SENTINEL;
+                #if MICROPY_OPT_ATTR_LOOKUP_CACHE
+                lookup->found_value = MP_OBJ_SENTINEL;
+                #endif
                 return;
             }
         }
@@ -177,25 +217,11 @@ STATIC void mp_obj_class_lookup(struct class_lookup_data  *lookup, const mp_obj_
             mp_map_t *locals_map = &type->locals_dict->map;
             mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(lookup->attr), MP_MAP_LOOKUP);
             if (elem != NULL) {
-                if (lookup->is_type) {
-                    // If we look up a class method, we need to return original type for which we
-                    // do a lookup, not a (base) type in which we found the class method.
-                    const mp_obj_type_t *org_type = (const mp_obj_type_t*)lookup->obj;
-                    mp_convert_member_lookup(MP_OBJ_NULL, org_type, elem->value, lookup->dest);
-                } else if (MP_OBJ_IS_TYPE(elem->value, &mp_type_property)) {
-                    lookup->dest[0] = elem->value;
-                    return;
-                } else {
-                    mp_obj_instance_t *obj = lookup->obj;
-                    mp_obj_t obj_obj;
-                    if (obj != NULL && mp_obj_is_native_type(type) && type != &mp_type_object /* object is not a real type */) {
-                        // If we're dealing with native base class, then it applies to native sub-object
-                        obj_obj = obj->subobj[0];
-                    } else {
-                        obj_obj = MP_OBJ_FROM_PTR(obj);
-                    }
-                    mp_convert_member_lookup(obj_obj, type, elem->value, lookup->dest);
-                }
+                #if MICROPY_OPT_ATTR_LOOKUP_CACHE
+                lookup->found_type = type;
+                lookup->found_value = elem->value;
+                #endif
+                class_lookup_found(lookup, type, elem->value);
 #if DEBUG_PRINT
                 printf("mp_obj_class_lookup: Returning: ");
                 mp_obj_print(lookup->dest[0], PRINT_REPR); printf(" ");
@@ -210,6 +236,10 @@ STATIC void mp_obj_class_lookup(struct class_lookup_data  *lookup, const mp_obj_
         // but some attributes of native types may be handled using .load_attr method,
         // so make sure we try to lookup those too.
         if (lookup->obj != NULL && !lookup->is_type && mp_obj_is_native_type(type) && type != &mp_type_object /* object is not a real type */) {
+            #if MICROPY_OPT_ATTR_LOOKUP_CACHE
+            // The native attr handler may depend on the state of the sub-object.
+            lookup->cacheable = false;
+            #endif
             mp_load_method_maybe(lookup->obj->subobj[0], lookup->attr, lookup->dest);
             if (lookup->dest[0] != MP_OBJ_NULL) {
                 return;
@@ -233,7 +263,7 @@ STATIC void mp_obj_class_lookup(struct class_lookup_data  *lookup, const mp_obj_
                     // Not a "real" type
                     continue;
                 }
-                mp_obj_class_lookup(lookup, bt);
+                class_lookup_walk(lookup, bt);
                 if (lookup->dest[0] != MP_OBJ_NULL) {
                     return;
                 }
@@ -253,6 +283,50 @@ STATIC void mp_obj_class_lookup(struct class_lookup_data  *lookup, const mp_obj_
     }
 }
 
+#if MICROPY_OPT_ATTR_LOOKUP_CACHE
+#define ATTR_CACHE_SLOT(type, attr) ((((uintptr_t)(type) >> 3) ^ (attr)) & (MICROPY_OPT_ATTR_LOOKUP_CACHE_SIZE - 1))
+
+// A change to one class dict can change the result of lookups in its subclasses,
+// which aren't known, so drop everything.  New classes don't need this: they can't
+// reuse the address of a cached type because the cache keeps those alive.
+STATIC void attr_lookup_cache_invalidate(void) {
+    MP_STATE_VM(attr_lookup_epoch) += 1;
+}
+#endif
+
+STATIC void mp_obj_class_lookup(struct class_lookup_data  *lookup, const mp_obj_type_t *type) {
+    #if MICROPY_OPT_ATTR_LOOKUP_CACHE
+    // Type lookups are less common and return the type itself in dest[1], so aren't cached.
+    if (!lookup->is_type) {
+        mp_attr_lookup_cache_entry_t *entry = &MP_STATE_VM(attr_lookup_cache)[ATTR_CACHE_SLOT(type, lookup->attr)];
+        if (entry->type == type && entry->attr == lookup->attr
+            && entry->meth_offset == lookup->meth_offset
+            && entry->epoch == MP_STATE_VM(attr_lookup_epoch)) {
+            if (entry->found_value == MP_OBJ_SENTINEL) {
+                lookup->dest[0] = MP_OBJ_SENTINEL;
+            } else if (entry->found_value != MP_OBJ_NULL) {
+                class_lookup_found(lookup, entry->found_type, entry->found_value);
+            }
+            return;
+        }
+        lookup->cacheable = true;
+        lookup->found_type = NULL;
+        lookup->found_value = MP_OBJ_NULL;
+        class_lookup_walk(lookup, type);
+        if (lookup->cacheable) {
+            entry->type = type;
+            entry->attr = lookup->attr;
+            entry->meth_offset = lookup->meth_offset;
+            entry->epoch = MP_STATE_VM(attr_lookup_epoch);
+            entry->found_type = lookup->found_type;
+            entry->found_value = lookup->found_value;
+        }
+        return;
+    }
+    #endif
+    class_lookup_walk(lookup, type);
+}
+
 STATIC void instance_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
     mp_obj_instance_t *self = MP_OBJ_TO_PTR(self_in);
     qstr meth = (kind == PRINT_STR) ? MP_QSTR___str__ : MP_QSTR___repr__;
@@ -425,6 +499,12 @@ STATIC mp_obj_t instance_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
         const mp_obj_type_t *native_base;
         size_t num_native_bases = instance_count_native_bases(mp_obj_get_type(self_in), &native_base);
 
+        #if MICROPY_PY_SLOTS
+        if (mp_obj_type_has_slots(self->base.type)) {
+            size_t n_slots = ((const mp_obj_slots_type_t*)self->base.type)->n_slots;
+            return MP_OBJ_NEW_SMALL_INT(sizeof(mp_obj_slots_instance_t) + sizeof(mp_obj_t) * n_slots);
+        }
+        #endif
         size_t sz = sizeof(*self) + sizeof(*self->subobj) * num_native_bases
             + sizeof(*self->members.table) * self->members.alloc;
         return MP_OBJ_NEW_SMALL_INT(sz);
@@ -597,6 +677,19 @@ STATIC void mp_obj_instance_load_attr(mp_obj_t self_in, qstr attr, mp_obj_t *des
     assert(mp_obj_is_instance_type(mp_obj_get_type(self_in)));
     mp_obj_instance_t *self = MP_OBJ_TO_PTR(self_in);
 
+    #if MICROPY_PY_SLOTS
+    if (mp_obj_type_has_slots(self->base.type)) {
+        // a set slot is always treated as a value; an unset one falls
+        // through to the class, like a missing member
+        mp_obj_slots_instance_t *o = MP_OBJ_TO_PTR(self_in);
+        ssize_t i = mp_obj_slots_index(self->base.type, attr);
+        if (i >= 0 && o->slots[i] != MP_OBJ_NULL) {
+            dest[0] = o->slots[i];
+            return;
+        }
+        goto lookup_class;
+    }
+    #endif
     mp_map_elem_t *elem = mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
     if (elem != NULL) {
         // object member, always treated as a value
@@ -619,6 +712,9 @@ STATIC void mp_obj_instance_load_attr(mp_obj_t self_in, qstr attr, mp_obj_t *des
         return;
     }
 #endif
+    #if MICROPY_PY_SLOTS
+lookup_class:;
+    #endif
     struct class_lookup_data lookup = {
         .obj = self,
         .attr = attr,
@@ -648,7 +744,7 @@ STATIC void mp_obj_instance_load_attr(mp_obj_t self_in, qstr attr, mp_obj_t *des
             if (proxy[0] == mp_const_none) {
                 mp_raise_AttributeError(translate("unreadable attribute"));
             } else {
-                dest[0] = mp_call_function_n_kw(proxy[0], 1, 0, &self_in);
+                dest[0] = mp_obj_property_call_get(proxy[0], self_in);
             }
             return;
         }
@@ -742,7 +838,7 @@ STATIC bool mp_obj_instance_store_attr(mp_obj_t self_in, qstr attr, mp_obj_t val
                     // TODO better error message?
                     return false;
                 } else {
-                    mp_call_function_n_kw(proxy[1], 2, 0, dest);
+                    mp_obj_property_call_set(proxy[1], self_in, value);
                     return true;
                 }
             }
@@ -805,6 +901,19 @@ STATIC bool mp_obj_instance_store_attr(mp_obj_t self_in, qstr attr, mp_obj_t val
 
 skip_special_accessors:
 
+    #if MICROPY_PY_SLOTS
+    if (mp_obj_type_has_slots(self->base.type)) {
+        // only the names in __slots__ can be stored
+        mp_obj_slots_instance_t *o = MP_OBJ_TO_PTR(self_in);
+        ssize_t i = mp_obj_slots_index(self->base.type, attr);
+        if (i < 0 || (value == MP_OBJ_NULL && o->slots[i] == MP_OBJ_NULL)) {
+            return false;
+        }
+        o->slots[i] = value;
+        return true;
+    }
+    #endif
+
     if (value == MP_OBJ_NULL) {
         // delete attribute
         mp_map_elem_t *elem = mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_REMOVE_IF_FOUND);
@@ -1084,6 +1193,9 @@ STATIC void type_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
                 mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_REMOVE_IF_FOUND);
                 if (elem != NULL) {
                     dest[0] = MP_OBJ_NULL; // indicate success
+                    #if MICROPY_OPT_ATTR_LOOKUP_CACHE
+                    attr_lookup_cache_invalidate();
+                    #endif
                 }
             } else {
                 #if ENABLE_SPECIAL_ACCESSORS
@@ -1103,6 +1215,9 @@ STATIC void type_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
                 mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
                 elem->value = dest[1];
                 dest[0] = MP_OBJ_NULL; // indicate success
+                #if MICROPY_OPT_ATTR_LOOKUP_CACHE
+                attr_lookup_cache_invalidate();
+                #endif
             }
         }
     }
@@ -1118,6 +1233,68 @@ const mp_obj_type_t mp_type_type = {
     .attr = type_attr,
 };
 
+#if MICROPY_PY_SLOTS
+ssize_t mp_obj_slots_index(const mp_obj_type_t *type, qstr attr) {
+    const mp_obj_slots_type_t *self = (const mp_obj_slots_type_t*)type;
+    for (size_t i = 0; i < self->n_slots; i++) {
+        if (self->slots[i] == attr) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Allocate the type for a class whose instances use a fixed slot layout, or
+// return NULL if they need a members map: when there is no __slots__, or it
+// includes __dict__, or a base class is native, unslotted or one of several.
+STATIC mp_obj_type_t *slots_type_new(size_t bases_len, mp_obj_t *bases_items, mp_map_t *locals_map) {
+    mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(MP_QSTR___slots__), MP_MAP_LOOKUP);
+    if (elem == NULL || bases_len > 1) {
+        return NULL;
+    }
+    const mp_obj_slots_type_t *base = NULL;
+    if (bases_len == 1) {
+        const mp_obj_type_t *t = MP_OBJ_TO_PTR(bases_items[0]);
+        if (mp_obj_type_has_slots(t)) {
+            base = (const mp_obj_slots_type_t*)t;
+        } else if (t != &mp_type_object) {
+            return NULL;
+        }
+    }
+
+    // __slots__ is a single name or an iterable of names
+    mp_obj_t names = elem->value;
+    if (MP_OBJ_IS_STR(names)) {
+        names = mp_obj_new_tuple(1, &names);
+    } else {
+        names = mp_type_tuple.make_new(&mp_type_tuple, 1, &names, NULL);
+    }
+    size_t n_names;
+    mp_obj_t *items;
+    mp_obj_tuple_get(names, &n_names, &items);
+    for (size_t i = 0; i < n_names; i++) {
+        if (mp_obj_str_get_qstr(items[i]) == MP_QSTR___dict__) {
+            return NULL;
+        }
+    }
+
+    size_t n_base = base == NULL ? 0 : base->n_slots;
+    mp_obj_slots_type_t *o = m_malloc0(sizeof(mp_obj_slots_type_t) + sizeof(qstr) * (n_base + n_names), true);
+    o->type.flags = TYPE_FLAG_HAS_SLOTS;
+    if (base != NULL) {
+        memcpy(o->slots, base->slots, sizeof(qstr) * n_base);
+    }
+    o->n_slots = n_base;
+    for (size_t i = 0; i < n_names; i++) {
+        qstr attr = mp_obj_str_get_qstr(items[i]);
+        if (attr != MP_QSTR___weakref__ && mp_obj_slots_index(&o->type, attr) < 0) {
+            o->slots[o->n_slots++] = attr;
+        }
+    }
+    return &o->type;
+}
+#endif
+
 mp_obj_t mp_obj_new_type(qstr name, mp_obj_t bases_tuple, mp_obj_t locals_dict) {
     // Verify input objects have expected type
     if (!MP_OBJ_IS_TYPE(bases_tuple, &mp_type_tuple)) {
@@ -1156,9 +1333,15 @@ mp_obj_t mp_obj_new_type(qstr name, mp_obj_t bases_tuple, mp_obj_t locals_dict)
         #endif
     }
 
-    mp_obj_type_t *o = m_new0_ll(mp_obj_type_t, 1);
+    mp_obj_type_t *o = NULL;
+    #if MICROPY_PY_SLOTS
+    o = slots_type_new(bases_len, bases_items, mp_obj_dict_get_map(locals_dict));
+    #endif
+    if (o == NULL) {
+        o = m_new0_ll(mp_obj_type_t, 1);
+    }
     o->base.type = &mp_type_type;
-    o->flags = base_flags;
+    o->flags |= base_flags;
     o->name = name;
     o->print = instance_print;
     o->make_new = mp_obj_instance_make_new;
@@ -1319,7 +1502,7 @@ STATIC void super_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
                 if (proxy[0] == mp_const_none) {
                     mp_raise_AttributeError(translate("unreadable attribute"));
                 } else {
-                    dest[0] = mp_call_function_n_kw(proxy[0], 1, 0, &self_in);
+                    dest[0] = mp_obj_property_call_get(proxy[0], self_in);
                 }
             }
             #endif
@@ -37,6 +37,34 @@ typedef struct _mp_obj_instance_t {
     // TODO maybe cache __getattr__ and __setattr__ for efficient lookup of them
 } mp_obj_instance_t;
 
+// flags for user-defined classes, stored in mp_obj_type_t.flags
+#define TYPE_FLAG_IS_SUBCLASSED (0x0001)
+#define TYPE_FLAG_HAS_SPECIAL_ACCESSORS (0x0002)
+#define TYPE_FLAG_HAS_SLOTS (0x0004)
+
+#if MICROPY_PY_SLOTS
+// a class that defines __slots__ has this type, with the slot names of its
+// base classes first, and its instances have a slot value (or MP_OBJ_NULL if
+// unset) for each name instead of a members map
+typedef struct _mp_obj_slots_type_t {
+    mp_obj_type_t type;
+    size_t n_slots;
+    qstr slots[];
+} mp_obj_slots_type_t;
+
+typedef struct _mp_obj_slots_instance_t {
+    mp_obj_base_t base;
+    mp_obj_t slots[];
+} mp_obj_slots_instance_t;
+
+#define mp_obj_type_has_slots(type) ((type)->flags & TYPE_FLAG_HAS_SLOTS)
+
+// index of attr in the slots of a slotted type, or -1 if it isn't one
+ssize_t mp_obj_slots_index(const mp_obj_type_t *type, qstr attr);
+#else
+#define mp_obj_type_has_slots(type) (false)
+#endif
+
 void mp_obj_assert_native_inited(mp_obj_t native_object);
 
 #if MICROPY_CPYTHON_COMPAT
@@ -239,7 +239,7 @@ typedef struct _parser_t {
     mp_parse_chunk_t *cur_chunk;
 
     #if MICROPY_COMP_CONST
-    mp_map_t consts;
+    mp_map_t *consts;
     #endif
 } parser_t;
 
@@ -324,6 +324,7 @@ STATIC uint8_t pop_rule(parser_t *parser, size_t *arg_i, size_t *src_line) {
 
 bool mp_parse_node_is_const_false(mp_parse_node_t pn) {
     return MP_PARSE_NODE_IS_TOKEN_KIND(pn, MP_TOKEN_KW_FALSE)
+        || MP_PARSE_NODE_IS_TOKEN_KIND(pn, MP_TOKEN_KW_NONE)
         || (MP_PARSE_NODE_IS_SMALL_INT(pn) && MP_PARSE_NODE_LEAF_SMALL_INT(pn) == 0);
 }
 
@@ -482,7 +483,7 @@ STATIC void push_result_token(parser_t *parser, uint8_t rule_id) {
         // if name is a standalone identifier, look it up in the table of dynamic constants
         mp_map_elem_t *elem;
         if (rule_id == RULE_atom
-            && (elem = mp_map_lookup(&parser->consts, MP_OBJ_NEW_QSTR(id), MP_MAP_LOOKUP)) != NULL) {
+            && (elem = mp_map_lookup(parser->consts, MP_OBJ_NEW_QSTR(id), MP_MAP_LOOKUP)) != NULL) {
             if (MP_OBJ_IS_SMALL_INT(elem->value)) {
                 pn = mp_parse_node_new_small_int_checked(parser, elem->value);
             } else {
@@ -606,8 +607,149 @@ STATIC bool fold_logical_constants(parser_t *parser, uint8_t rule_id, size_t *nu
     return false;
 }
 
+// folded strings and bytes longer than this are left to be built at runtime
+#define FOLD_MAX_STR_LEN (256)
+
+STATIC bool get_const_object_maybe(mp_parse_node_t pn, mp_obj_t *o) {
+    if (mp_parse_node_get_int_maybe(pn, o)) {
+        return true;
+    } else if (MP_PARSE_NODE_IS_STRUCT_KIND(pn, RULE_const_object)) {
+        // a float, complex, long string or folded tuple
+        mp_parse_node_struct_t *pns = (mp_parse_node_struct_t*)pn;
+        #if MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_D
+        *o = (uint64_t)pns->nodes[0] | ((uint64_t)pns->nodes[1] << 32);
+        #else
+        *o = (mp_obj_t)pns->nodes[0];
+        #endif
+        return true;
+    } else if (MP_PARSE_NODE_IS_LEAF(pn) && MP_PARSE_NODE_LEAF_KIND(pn) == MP_PARSE_NODE_STRING) {
+        *o = MP_OBJ_NEW_QSTR(MP_PARSE_NODE_LEAF_ARG(pn));
+        return true;
+    } else if (MP_PARSE_NODE_IS_LEAF(pn) && MP_PARSE_NODE_LEAF_KIND(pn) == MP_PARSE_NODE_BYTES) {
+        size_t len;
+        const byte *data = qstr_data(MP_PARSE_NODE_LEAF_ARG(pn), &len);
+        *o = mp_obj_new_bytes(data, len);
+        return true;
+    } else if (MP_PARSE_NODE_IS_TOKEN_KIND(pn, MP_TOKEN_KW_NONE)) {
+        *o = mp_const_none;
+        return true;
+    } else if (MP_PARSE_NODE_IS_TOKEN_KIND(pn, MP_TOKEN_KW_TRUE)) {
+        *o = mp_const_true;
+        return true;
+    } else if (MP_PARSE_NODE_IS_TOKEN_KIND(pn, MP_TOKEN_KW_FALSE)) {
+        *o = mp_const_false;
+        return true;
+    } else {
+        return false;
+    }
+}
+
+STATIC bool is_foldable_number(mp_obj_t o) {
+    #if MICROPY_COMP_CONST_FLOAT
+    if (mp_obj_is_float(o)) {
+        return true;
+    }
+    #endif
+    return MP_OBJ_IS_INT(o);
+}
+
+// Returns whether lhs op rhs can be evaluated at compile time without raising.
+STATIC bool binary_op_is_foldable(mp_binary_op_t op, mp_obj_t lhs, mp_obj_t rhs) {
+    if (MP_OBJ_IS_INT(lhs) && MP_OBJ_IS_INT(rhs)) {
+        int rhs_sign = mp_obj_int_sign(rhs);
+        if (op <= MP_BINARY_OP_RSHIFT) {
+            // << and >> can't have negative rhs
+            return rhs_sign >= 0;
+        } else if (op == MP_BINARY_OP_TRUE_DIVIDE) {
+            // leave int / int to the runtime, which may not support floats
+            return false;
+        } else if (op >= MP_BINARY_OP_FLOOR_DIVIDE) {
+            // % and // can't have zero rhs
+            return rhs_sign != 0;
+        }
+        return true;
+    }
+    #if MICROPY_COMP_CONST_FLOAT
+    if (is_foldable_number(lhs) && is_foldable_number(rhs)) {
+        // one of them is a float
+        if (op <= MP_BINARY_OP_RSHIFT) {
+            return false;
+        } else if (op >= MP_BINARY_OP_FLOOR_DIVIDE) {
+            return mp_obj_get_float(rhs) != 0;
+        }
+        return true;
+    }
+    #endif
+    if (!MP_OBJ_IS_STR_OR_BYTES(lhs)) {
+        return false;
+    }
+    size_t len;
+    mp_obj_str_get_data(lhs, &len);
+    if (op == MP_BINARY_OP_ADD) {
+        // concatenation of two strings or two bytes
+        if (!(MP_OBJ_IS_STR_OR_BYTES(rhs) && MP_OBJ_IS_STR(lhs) == MP_OBJ_IS_STR(rhs))) {
+            return false;
+        }
+        size_t rhs_len;
+        mp_obj_str_get_data(rhs, &rhs_len);
+        return len + rhs_len <= FOLD_MAX_STR_LEN;
+    } else if (op == MP_BINARY_OP_MULTIPLY && MP_OBJ_IS_SMALL_INT(rhs)) {
+        // repetition, with the string on the left
+        mp_int_t n = MP_OBJ_SMALL_INT_VALUE(rhs);
+        return n <= 0 || (n <= FOLD_MAX_STR_LEN && n * len <= FOLD_MAX_STR_LEN);
+    }
+    return false;
+}
+
+// Returns whether the two operands of a comparison can be compared at compile time.
+STATIC bool compare_is_foldable(mp_obj_t lhs, mp_obj_t rhs) {
+    if (is_foldable_number(lhs) && is_foldable_number(rhs)) {
+        return true;
+    }
+    return MP_OBJ_IS_STR_OR_BYTES(lhs) && MP_OBJ_IS_STR_OR_BYTES(rhs)
+        && MP_OBJ_IS_STR(lhs) == MP_OBJ_IS_STR(rhs);
+}
+
+#if MICROPY_COMP_CONST_TUPLE && (!MICROPY_PERSISTENT_CODE_SAVE || MICROPY_MODULE_CACHE)
+// Folds (a, b, ...) where all the items are constants into a tuple object.
+// .mpy files can't hold tuple constants, so this is disabled when saving them,
+// except for the module cache which is only loaded by the same firmware.
+STATIC bool fold_const_tuple(parser_t *parser, mp_obj_t *o) {
+    mp_parse_node_t pn = peek_result(parser, 0);
+    if (!MP_PARSE_NODE_IS_STRUCT_KIND(pn, RULE_testlist_comp)) {
+        return false;
+    }
+    mp_parse_node_struct_t *pns = (mp_parse_node_struct_t*)pn;
+    mp_parse_node_t *items = &pns->nodes[1];
+    size_t n = 1;
+    if (MP_PARSE_NODE_IS_STRUCT_KIND(pns->nodes[1], RULE_testlist_comp_3b)) {
+        // one item with a trailing comma
+        n = 0;
+    } else if (MP_PARSE_NODE_IS_STRUCT_KIND(pns->nodes[1], RULE_testlist_comp_3c)) {
+        mp_parse_node_struct_t *pns_list = (mp_parse_node_struct_t*)pns->nodes[1];
+        items = pns_list->nodes;
+        n = MP_PARSE_NODE_STRUCT_NUM_NODES(pns_list);
+    } else if (MP_PARSE_NODE_IS_STRUCT_KIND(pns->nodes[1], RULE_comp_for)) {
+        // a generator expression
+        return false;
+    }
+    mp_obj_tuple_t *tuple = MP_OBJ_TO_PTR(mp_obj_new_tuple(1 + n, NULL));
+    if (!get_const_object_maybe(pns->nodes[0], &tuple->items[0])) {
+        return false;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (!get_const_object_maybe(items[i], &tuple->items[1 + i])) {
+            return false;
+        }
+    }
+    *o = MP_OBJ_FROM_PTR(tuple);
+    return true;
+}
+#endif
+
 STATIC bool fold_constants(parser_t *parser, uint8_t rule_id, size_t num_args) {
-    // this code does folding of arbitrary integer expressions, eg 1 + 2 * 3 + 4
+    // this code does folding of arbitrary constant expressions, eg 1 + 2 * 3 + 4,
+    // and of comparisons between constants
     // it does not do partial folding, eg 1 + 2 + x -> 3 + x
 
     mp_obj_t arg0;
@@ -640,13 +782,13 @@ STATIC bool fold_constants(parser_t *parser, uint8_t rule_id, size_t num_args) {
         || rule_id == RULE_term) {
         // folding for binary ops: << >> + - * / % //
         mp_parse_node_t pn = peek_result(parser, num_args - 1);
-        if (!mp_parse_node_get_int_maybe(pn, &arg0)) {
+        if (!get_const_object_maybe(pn, &arg0)) {
             return false;
         }
         for (ssize_t i = num_args - 2; i >= 1; i -= 2) {
             pn = peek_result(parser, i - 1);
             mp_obj_t arg1;
-            if (!mp_parse_node_get_int_maybe(pn, &arg1)) {
+            if (!get_const_object_maybe(pn, &arg1)) {
                 return false;
             }
             mp_token_kind_t tok = MP_PARSE_NODE_LEAF_ARG(peek_result(parser, i));
@@ -655,7 +797,7 @@ STATIC bool fold_constants(parser_t *parser, uint8_t rule_id, size_t num_args) {
                 MP_BINARY_OP_SUBTRACT,
                 MP_BINARY_OP_MULTIPLY,
                 255,//MP_BINARY_OP_POWER,
-                255,//MP_BINARY_OP_TRUE_DIVIDE,
+                MP_BINARY_OP_TRUE_DIVIDE,
                 MP_BINARY_OP_FLOOR_DIVIDE,
                 MP_BINARY_OP_MODULO,
                 255,//MP_BINARY_OP_LESS
@@ -664,27 +806,50 @@ STATIC bool fold_constants(parser_t *parser, uint8_t rule_id, size_t num_args) {
                 MP_BINARY_OP_RSHIFT,
             };
             mp_binary_op_t op = token_to_op[tok - MP_TOKEN_OP_PLUS];
-            if (op == (mp_binary_op_t)255) {
+            if (op == (mp_binary_op_t)255 || !binary_op_is_foldable(op, arg0, arg1)) {
                 return false;
             }
-            int rhs_sign = mp_obj_int_sign(arg1);
-            if (op <= MP_BINARY_OP_RSHIFT) {
-                // << and >> can't have negative rhs
-                if (rhs_sign < 0) {
-                    return false;
-                }
-            } else if (op >= MP_BINARY_OP_FLOOR_DIVIDE) {
-                // % and // can't have zero rhs
-                if (rhs_sign == 0) {
-                    return false;
-                }
-            }
             arg0 = mp_binary_op(op, arg0, arg1);
         }
+    } else if (rule_id == RULE_comparison) {
+        // folding for comparisons: < > == >= <= !=, which may be chained
+        mp_parse_node_t pn = peek_result(parser, num_args - 1);
+        mp_obj_t lhs;
+        if (!get_const_object_maybe(pn, &lhs)) {
+            return false;
+        }
+        arg0 = mp_const_true;
+        for (ssize_t i = num_args - 2; i >= 1; i -= 2) {
+            pn = peek_result(parser, i);
+            if (!MP_PARSE_NODE_IS_LEAF(pn) || MP_PARSE_NODE_LEAF_KIND(pn) != MP_PARSE_NODE_TOKEN) {
+                // "is", "is not" and "not in"
+                return false;
+            }
+            mp_token_kind_t tok = MP_PARSE_NODE_LEAF_ARG(pn);
+            mp_binary_op_t op;
+            switch (tok) {
+                case MP_TOKEN_OP_LESS: op = MP_BINARY_OP_LESS; break;
+                case MP_TOKEN_OP_MORE: op = MP_BINARY_OP_MORE; break;
+                case MP_TOKEN_OP_DBL_EQUAL: op = MP_BINARY_OP_EQUAL; break;
+                case MP_TOKEN_OP_LESS_EQUAL: op = MP_BINARY_OP_LESS_EQUAL; break;
+                case MP_TOKEN_OP_MORE_EQUAL: op = MP_BINARY_OP_MORE_EQUAL; break;
+                case MP_TOKEN_OP_NOT_EQUAL: op = MP_BINARY_OP_NOT_EQUAL; break;
+                default: return false; // "in"
+            }
+            mp_obj_t rhs;
+            if (!get_const_object_maybe(peek_result(parser, i - 1), &rhs)
+                || !compare_is_foldable(lhs, rhs)) {
+                return false;
+            }
+            if (mp_binary_op(op, lhs, rhs) == mp_const_false) {
+                arg0 = mp_const_false;
+            }
+            lhs = rhs;
+        }
     } else if (rule_id == RULE_factor_2) {
         // folding for unary ops: + - ~
         mp_parse_node_t pn = peek_result(parser, 0);
-        if (!mp_parse_node_get_int_maybe(pn, &arg0)) {
+        if (!get_const_object_maybe(pn, &arg0) || !is_foldable_number(arg0)) {
             return false;
         }
         mp_token_kind_t tok = MP_PARSE_NODE_LEAF_ARG(peek_result(parser, 1));
@@ -695,10 +860,21 @@ STATIC bool fold_constants(parser_t *parser, uint8_t rule_id, size_t num_args) {
             op = MP_UNARY_OP_NEGATIVE;
         } else {
             assert(tok == MP_TOKEN_OP_TILDE); // should be
+            if (!MP_OBJ_IS_INT(arg0)) {
+                return false;
+            }
             op = MP_UNARY_OP_INVERT;
         }
         arg0 = mp_unary_op(op, arg0);
 
+    #if MICROPY_COMP_CONST_TUPLE && (!MICROPY_PERSISTENT_CODE_SAVE || MICROPY_MODULE_CACHE)
+    } else if (rule_id == RULE_atom_paren) {
+        // folding for tuples of constants: (1, 'a', None)
+        if (!fold_const_tuple(parser, &arg0)) {
+            return false;
+        }
+    #endif
+
     #if MICROPY_COMP_CONST
     } else if (rule_id == RULE_expr_stmt) {
         mp_parse_node_t pn1 = peek_result(parser, 0);
@@ -730,7 +906,7 @@ STATIC bool fold_constants(parser_t *parser, uint8_t rule_id, size_t num_args) {
                 }
 
                 // store the value in the table of dynamic constants
-                mp_map_elem_t *elem = mp_map_lookup(&parser->consts, MP_OBJ_NEW_QSTR(id), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
+                mp_map_elem_t *elem = mp_map_lookup(parser->consts, MP_OBJ_NEW_QSTR(id), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
                 assert(elem->value == MP_OBJ_NULL);
                 elem->value = value;
 
@@ -791,6 +967,19 @@ STATIC bool fold_constants(parser_t *parser, uint8_t rule_id, size_t num_args) {
     }
     if (MP_OBJ_IS_SMALL_INT(arg0)) {
         push_result_node(parser, mp_parse_node_new_small_int_checked(parser, arg0));
+    } else if (arg0 == mp_const_false || arg0 == mp_const_true) {
+        push_result_node(parser, mp_parse_node_new_leaf(MP_PARSE_NODE_TOKEN,
+            arg0 == mp_const_true ? MP_TOKEN_KW_TRUE : MP_TOKEN_KW_FALSE));
+    } else if (MP_OBJ_IS_STR_OR_BYTES(arg0)) {
+        // intern the result like a string literal would be
+        size_t len;
+        const char *str = mp_obj_str_get_data(arg0, &len);
+        qstr qst = len <= MICROPY_ALLOC_PARSE_INTERN_STRING_LEN ? qstr_from_strn(str, len) : qstr_find_strn(str, len);
+        if (qst != MP_QSTR_NULL) {
+            push_result_node(parser, mp_parse_node_new_leaf(MP_OBJ_IS_STR(arg0) ? MP_PARSE_NODE_STRING : MP_PARSE_NODE_BYTES, qst));
+        } else {
+            push_result_node(parser, make_node_const_object(parser, 0, arg0));
+        }
     } else {
         // TODO reuse memory for parse node struct?
         push_result_node(parser, make_node_const_object(parser, 0, arg0));
@@ -835,7 +1024,9 @@ STATIC void push_result_rule(parser_t *parser, size_t src_line, uint8_t rule_id,
     push_result_node(parser, (mp_parse_node_t)pn);
 }
 
-mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
+// Parses top_level_rule, which must reach the end of the input unless it is RULE_stmt. consts
+// holds the constants defined so far when MICROPY_COMP_CONST is enabled.
+STATIC mp_parse_tree_t parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind, size_t top_level_rule, mp_map_t *consts) {
 
     // initialise parser and allocate memory for its stacks
 
@@ -874,16 +1065,11 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
     parser.cur_chunk = NULL;
 
     #if MICROPY_COMP_CONST
-    mp_map_init(&parser.consts, 0);
+    parser.consts = consts;
+    #else
+    (void)consts;
     #endif
 
-    // work out the top-level rule to use, and push it on the stack
-    size_t top_level_rule;
-    switch (input_kind) {
-        case MP_PARSE_SINGLE_INPUT: top_level_rule = RULE_single_input; break;
-        case MP_PARSE_EVAL_INPUT: top_level_rule = RULE_eval_input; break;
-        default: top_level_rule = RULE_file_input;
-    }
     push_rule(&parser, lex->tok_line, top_level_rule, 0);
 
     // parse!
@@ -1144,10 +1330,6 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
         }
     }
 
-    #if MICROPY_COMP_CONST
-    mp_map_deinit(&parser.consts);
-    #endif
-
     // truncate final chunk and link into chain of chunks
     if (parser.cur_chunk != NULL) {
         (void)m_renew_maybe(byte, parser.cur_chunk,
@@ -1160,7 +1342,8 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
     }
 
     if (
-        lex->tok_kind != MP_TOKEN_END // check we are at the end of the token stream
+        // check we are at the end of the token stream
+        (lex->tok_kind != MP_TOKEN_END && top_level_rule != RULE_stmt)
         || parser.result_stack_top == 0 // check that we got a node (can fail on empty input)
         ) {
     syntax_error:;
@@ -1189,12 +1372,46 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
     m_del(rule_stack_t, parser.rule_stack, parser.rule_stack_alloc);
     m_del(mp_parse_node_t, parser.result_stack, parser.result_stack_alloc);
 
+    return parser.tree;
+}
+
+mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
+    // work out the top-level rule to use
+    size_t top_level_rule;
+    switch (input_kind) {
+        case MP_PARSE_SINGLE_INPUT: top_level_rule = RULE_single_input; break;
+        case MP_PARSE_EVAL_INPUT: top_level_rule = RULE_eval_input; break;
+        default: top_level_rule = RULE_file_input;
+    }
+
+    #if MICROPY_COMP_CONST
+    mp_map_t consts;
+    mp_map_init(&consts, 0);
+    mp_parse_tree_t tree = parse(lex, input_kind, top_level_rule, &consts);
+    mp_map_deinit(&consts);
+    #else
+    mp_parse_tree_t tree = parse(lex, input_kind, top_level_rule, NULL);
+    #endif
+
     // we also free the lexer on behalf of the caller
     mp_lexer_free(lex);
 
-    return parser.tree;
+    return tree;
 }
 
+#if MICROPY_COMPILE_BY_STATEMENT
+bool mp_parse_file_stmt(mp_lexer_t *lex, mp_map_t *consts, mp_parse_tree_t *tree) {
+    while (lex->tok_kind == MP_TOKEN_NEWLINE) {
+        mp_lexer_to_next(lex);
+    }
+    if (lex->tok_kind == MP_TOKEN_END) {
+        return false;
+    }
+    *tree = parse(lex, MP_PARSE_FILE_INPUT, RULE_stmt, consts);
+    return true;
+}
+#endif
+
 void mp_parse_tree_clear(mp_parse_tree_t *tree) {
     mp_parse_chunk_t *chunk = tree->chunk;
     while (chunk != NULL) {
@@ -102,6 +102,13 @@ typedef struct _mp_parse_t {
 // the parser will raise an exception if an error occurred
 // the parser will free the lexer before it returns
 mp_parse_tree_t mp_parse(struct _mp_lexer_t *lex, mp_parse_input_kind_t input_kind);
+
+#if MICROPY_COMPILE_BY_STATEMENT
+// Parses the next top-level statement of a file into tree, leaving the lexer at the one after it.
+// Returns false at the end of the file. consts carries the constants defined by earlier
+// statements and must be initialised before the first call. The lexer isn't freed.
+bool mp_parse_file_stmt(struct _mp_lexer_t *lex, mp_map_t *consts, mp_parse_tree_t *tree);
+#endif
 void mp_parse_tree_clear(mp_parse_tree_t *tree);
 
 #endif // MICROPY_INCLUDED_PY_PARSE_H
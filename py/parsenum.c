@@ -31,6 +31,7 @@
 #include "py/parsenumbase.h"
 #include "py/parsenum.h"
 #include "py/smallint.h"
+#include "py/formatfloat.h"
 
 #include "supervisor/shared/translate.h"
 
@@ -172,6 +173,26 @@ typedef enum {
     PARSE_DEC_IN_EXP,
 } parse_dec_in_t;
 
+#if MICROPY_PY_BUILTINS_FLOAT && MICROPY_FLOAT_FORMAT_SHORTEST
+// Converts the leading digits of a decimal number exactly.  If nonzero digits
+// were dropped after them, the number lies between digits and digits + 1 (in
+// their last place), so if both give the same float so does the number.
+STATIC bool parse_dec_exact(uint64_t digits, int exp, bool dropped, mp_float_t *val) {
+    mp_float_t f = mp_float_from_decimal(digits, exp);
+    if (dropped) {
+        if (++digits == 100000000000000000ULL) {
+            digits /= 10;
+            ++exp;
+        }
+        if (mp_float_from_decimal(digits, exp) != f) {
+            return false;
+        }
+    }
+    *val = f;
+    return true;
+}
+#endif
+
 mp_obj_t mp_parse_num_decimal(const char *str, size_t len, bool allow_imag, bool force_complex, mp_lexer_t *lex) {
 #if MICROPY_PY_BUILTINS_FLOAT
 
@@ -233,6 +254,13 @@ mp_obj_t mp_parse_num_decimal(const char *str, size_t len, bool allow_imag, bool
         bool exp_neg = false;
         int exp_val = 0;
         int exp_extra = 0;
+        #if MICROPY_FLOAT_FORMAT_SHORTEST
+        // up to 17 leading significant digits, for an exact conversion
+        uint64_t dig_val = 0;
+        int dig_count = 0;
+        int dig_exp = 0;
+        bool dig_dropped = false;
+        #endif
         while (str < top) {
             unsigned int dig = *str++;
             if ('0' <= dig && dig <= '9') {
@@ -245,6 +273,16 @@ mp_obj_t mp_parse_num_decimal(const char *str, size_t len, bool allow_imag, bool
                         exp_val = 10 * exp_val + dig;
                     }
                 } else {
+                    #if MICROPY_FLOAT_FORMAT_SHORTEST
+                    if (dig_count < 17) {
+                        dig_val = 10 * dig_val + dig;
+                        dig_count += dig_val != 0;
+                        dig_exp -= in == PARSE_DEC_IN_FRAC;
+                    } else {
+                        dig_dropped |= dig != 0;
+                        dig_exp += in == PARSE_DEC_IN_INTG;
+                    }
+                    #endif
                     if (dec_val < DEC_VAL_MAX) {
                         // dec_val won't overflow so keep accumulating
                         dec_val = 10 * dec_val + dig;
@@ -291,13 +329,20 @@ mp_obj_t mp_parse_num_decimal(const char *str, size_t len, bool allow_imag, bool
             exp_val = -exp_val;
         }
 
-        // apply the exponent, making sure it's not a subnormal value
-        exp_val += exp_extra;
-        if (exp_val < SMALL_NORMAL_EXP) {
-            exp_val -= SMALL_NORMAL_EXP;
-            dec_val *= SMALL_NORMAL_VAL;
+        bool exact = false;
+        #if MICROPY_FLOAT_FORMAT_SHORTEST
+        exact = parse_dec_exact(dig_val, exp_val + dig_exp, dig_dropped, &dec_val);
+        #endif
+
+        if (!exact) {
+            // apply the exponent, making sure it's not a subnormal value
+            exp_val += exp_extra;
+            if (exp_val < SMALL_NORMAL_EXP) {
+                exp_val -= SMALL_NORMAL_EXP;
+                dec_val *= SMALL_NORMAL_VAL;
+            }
+            dec_val *= MICROPY_FLOAT_C_FUN(pow)(10, exp_val);
         }
-        dec_val *= MICROPY_FLOAT_C_FUN(pow)(10, exp_val);
     }
 
     // negate value if needed
@@ -39,6 +39,7 @@
 #if MICROPY_PERSISTENT_CODE_LOAD || MICROPY_PERSISTENT_CODE_SAVE
 
 #include "py/smallint.h"
+#include "py/objtuple.h"
 
 // The current version of .mpy files
 #define MPY_VERSION (3)
@@ -48,12 +49,24 @@
 #define MPY_FEATURE_FLAGS ( \
     ((MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE) << 0) \
     | ((MICROPY_PY_BUILTINS_STR_UNICODE) << 1) \
+    | ((MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS) << 2) \
     )
 // This is a version of the flags that can be configured at runtime.
 #define MPY_FEATURE_FLAGS_DYNAMIC ( \
     ((MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE_DYNAMIC) << 0) \
     | ((MICROPY_PY_BUILTINS_STR_UNICODE_DYNAMIC) << 1) \
+    | ((MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS_DYNAMIC) << 2) \
     )
+// Flags for optional opcodes: files without them load on ports that support them.
+#define MPY_FEATURE_FLAGS_OPTIONAL (1 << 2)
+// Set when qstrs in the bytecode are MP_BC_QSTR_SLOT references rather than
+// placeholders, so the bytecode can run in place.  Loaders that copy the
+// bytecode overwrite them as usual, so it doesn't affect compatibility.
+#define MPY_FEATURE_QSTR_SLOTS (1 << 3)
+
+#if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE && MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE
+#error "MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE needs bytecode that isn't written to"
+#endif
 
 #if MICROPY_PERSISTENT_CODE_LOAD || (MICROPY_PERSISTENT_CODE_SAVE && !MICROPY_DYNAMIC_COMPILER)
 // The bytecode will depend on the number of bits in a small-int, and
@@ -115,6 +128,12 @@ STATIC int read_byte(mp_reader_t *reader) {
 }
 
 STATIC void read_bytes(mp_reader_t *reader, byte *buf, size_t len) {
+    // memory readers, including mapped files, give the bytes in one go
+    const byte *src = mp_reader_mem_skip(reader, len);
+    if (src != NULL) {
+        memcpy(buf, src, len);
+        return;
+    }
     while (len-- > 0) {
         mp_uint_t b =reader->readbyte(reader->data);
         if (b == MP_READER_EOF) {
@@ -151,6 +170,21 @@ STATIC mp_obj_t load_obj(mp_reader_t *reader) {
     byte obj_type = read_byte(reader);
     if (obj_type == 'e') {
         return MP_OBJ_FROM_PTR(&mp_const_ellipsis_obj);
+    #if MICROPY_MODULE_CACHE
+    } else if (obj_type == 'n') {
+        return mp_const_none;
+    } else if (obj_type == 'T') {
+        return mp_const_true;
+    } else if (obj_type == 'F') {
+        return mp_const_false;
+    } else if (obj_type == 't') {
+        size_t len = read_uint(reader);
+        mp_obj_tuple_t *tuple = MP_OBJ_TO_PTR(mp_obj_new_tuple(len, NULL));
+        for (size_t i = 0; i < len; i++) {
+            tuple->items[i] = load_obj(reader);
+        }
+        return MP_OBJ_FROM_PTR(tuple);
+    #endif
     } else {
         size_t len = read_uint(reader);
         vstr_t vstr;
@@ -181,11 +215,60 @@ STATIC void load_bytecode_qstrs(mp_reader_t *reader, byte *ip, byte *ip_top) {
     }
 }
 
-STATIC mp_raw_code_t *load_raw_code(mp_reader_t *reader) {
-    // load bytecode
+#if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+// The qstrs of bytecode that runs in place go in constant table slots after
+// the arguments, objects and raw code: simple_name, source_file and then one
+// per qstr operand in order.  Check that the bytecode refers to exactly those
+// slots, so running it can't index outside the table.
+STATIC size_t count_bytecode_qstrs(const byte *ip, const byte *ip_top) {
+    size_t n = 0;
+    while (ip < ip_top) {
+        size_t sz;
+        if (mp_opcode_format(ip, &sz) == MP_OPCODE_QSTR) {
+            n += 1;
+        }
+        ip += sz;
+    }
+    return n;
+}
+
+STATIC bool check_qstr_slot(const byte *ptr, size_t slot) {
+    return (ptr[0] | (ptr[1] << 8)) == (MP_BC_QSTR_SLOT | slot);
+}
+
+STATIC void check_bytecode_qstr_slots(const byte *ip, const byte *ip2, const byte *ip_top, size_t slot) {
+    if (!check_qstr_slot(ip2, slot) || !check_qstr_slot(ip2 + 2, slot + 1)) {
+        raise_corrupt_mpy();
+    }
+    slot += 2;
+    while (ip < ip_top) {
+        size_t sz;
+        if (mp_opcode_format(ip, &sz) == MP_OPCODE_QSTR) {
+            if (!check_qstr_slot(ip + 1, slot++)) {
+                raise_corrupt_mpy();
+            }
+        }
+        ip += sz;
+    }
+}
+#endif
+
+STATIC mp_raw_code_t *load_raw_code(mp_reader_t *reader, bool in_place) {
+    // load bytecode, or find it in the reader's buffer
     size_t bc_len = read_uint(reader);
-    byte *bytecode = m_new(byte, bc_len);
-    read_bytes(reader, bytecode, bc_len);
+    byte *bytecode;
+    #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+    if (in_place) {
+        bytecode = (byte*)mp_reader_mem_skip(reader, bc_len);
+        if (bytecode == NULL) {
+            raise_corrupt_mpy();
+        }
+    } else
+    #endif
+    {
+        bytecode = m_new(byte, bc_len);
+        read_bytes(reader, bytecode, bc_len);
+    }
 
     // extract prelude
     const byte *ip = bytecode;
@@ -193,17 +276,39 @@ STATIC mp_raw_code_t *load_raw_code(mp_reader_t *reader) {
     bytecode_prelude_t prelude;
     extract_prelude(&ip, &ip2, &prelude);
 
-    // load qstrs and link global qstr ids into bytecode
-    qstr simple_name = load_qstr(reader);
-    qstr source_file = load_qstr(reader);
-    ((byte*)ip2)[0] = simple_name; ((byte*)ip2)[1] = simple_name >> 8;
-    ((byte*)ip2)[2] = source_file; ((byte*)ip2)[3] = source_file >> 8;
-    load_bytecode_qstrs(reader, (byte*)ip, bytecode + bc_len);
+    #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+    // load qstrs to go in the constant table once its size is known
+    size_t n_qstr = 0;
+    qstr *qstrs = NULL;
+    if (in_place) {
+        n_qstr = 2 + count_bytecode_qstrs(ip, bytecode + bc_len);
+        qstrs = m_new(qstr, n_qstr);
+        for (size_t i = 0; i < n_qstr; ++i) {
+            qstrs[i] = load_qstr(reader);
+        }
+    } else
+    #endif
+    {
+        // load qstrs and link global qstr ids into bytecode
+        qstr simple_name = load_qstr(reader);
+        qstr source_file = load_qstr(reader);
+        ((byte*)ip2)[0] = simple_name; ((byte*)ip2)[1] = simple_name >> 8;
+        ((byte*)ip2)[2] = source_file; ((byte*)ip2)[3] = source_file >> 8;
+        load_bytecode_qstrs(reader, (byte*)ip, bytecode + bc_len);
+    }
 
     // load constant table
     size_t n_obj = read_uint(reader);
     size_t n_raw_code = read_uint(reader);
-    mp_uint_t *const_table = m_new(mp_uint_t, prelude.n_pos_args + prelude.n_kwonly_args + n_obj + n_raw_code);
+    size_t n_const = prelude.n_pos_args + prelude.n_kwonly_args + n_obj + n_raw_code;
+    #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+    if (in_place) {
+        check_bytecode_qstr_slots(ip, ip2, bytecode + bc_len, n_const);
+    }
+    mp_uint_t *const_table = m_new(mp_uint_t, n_const + n_qstr);
+    #else
+    mp_uint_t *const_table = m_new(mp_uint_t, n_const);
+    #endif
     mp_uint_t *ct = const_table;
     for (size_t i = 0; i < prelude.n_pos_args + prelude.n_kwonly_args; ++i) {
         *ct++ = (mp_uint_t)MP_OBJ_NEW_QSTR(load_qstr(reader));
@@ -212,8 +317,14 @@ STATIC mp_raw_code_t *load_raw_code(mp_reader_t *reader) {
         *ct++ = (mp_uint_t)load_obj(reader);
     }
     for (size_t i = 0; i < n_raw_code; ++i) {
-        *ct++ = (mp_uint_t)(uintptr_t)load_raw_code(reader);
+        *ct++ = (mp_uint_t)(uintptr_t)load_raw_code(reader, in_place);
+    }
+    #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+    for (size_t i = 0; i < n_qstr; ++i) {
+        *ct++ = (mp_uint_t)MP_OBJ_NEW_QSTR(qstrs[i]);
     }
+    m_del(qstr, qstrs, n_qstr);
+    #endif
 
     // create raw_code and return it
     mp_raw_code_t *rc = mp_emit_glue_new_raw_code();
@@ -229,27 +340,47 @@ STATIC mp_raw_code_t *load_raw_code(mp_reader_t *reader) {
     return rc;
 }
 
-mp_raw_code_t *mp_raw_code_load(mp_reader_t *reader) {
+STATIC mp_raw_code_t *raw_code_load(mp_reader_t *reader, bool in_place) {
     byte header[4];
     read_bytes(reader, header, sizeof(header));
+    byte feature_flags = header[2] & ~MPY_FEATURE_QSTR_SLOTS;
     if (header[0] != 'M'
         || header[1] != MPY_VERSION
-        || header[2] != MPY_FEATURE_FLAGS
+        || (feature_flags | (MPY_FEATURE_FLAGS & MPY_FEATURE_FLAGS_OPTIONAL)) != MPY_FEATURE_FLAGS
         || header[3] > mp_small_int_bits()) {
         mp_raise_MpyError(translate("Incompatible .mpy file. Please update all .mpy files. See http://adafru.it/mpy-update for more info."));
     }
-    mp_raw_code_t *rc = load_raw_code(reader);
+    mp_raw_code_t *rc = load_raw_code(reader, in_place && (header[2] & MPY_FEATURE_QSTR_SLOTS));
     reader->close(reader->data);
     return rc;
 }
 
+mp_raw_code_t *mp_raw_code_load(mp_reader_t *reader) {
+    return raw_code_load(reader, false);
+}
+
 mp_raw_code_t *mp_raw_code_load_mem(const byte *buf, size_t len) {
     mp_reader_t reader;
     mp_reader_new_mem(&reader, buf, len, 0);
     return mp_raw_code_load(&reader);
 }
 
+#if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+mp_raw_code_t *mp_raw_code_load_in_place(const byte *buf, size_t len) {
+    mp_reader_t reader;
+    mp_reader_new_mem(&reader, buf, len, 0);
+    return raw_code_load(&reader, true);
+}
+#endif
+
 mp_raw_code_t *mp_raw_code_load_file(const char *filename) {
+    #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+    size_t len;
+    const byte *buf = mp_persistent_code_map_file(filename, &len);
+    if (buf != NULL) {
+        return mp_raw_code_load_in_place(buf, len);
+    }
+    #endif
     mp_reader_t reader;
     mp_reader_new_file(&reader, filename);
     return mp_raw_code_load(&reader);
@@ -300,11 +431,27 @@ STATIC void save_obj(mp_print_t *print, mp_obj_t o) {
     } else if (MP_OBJ_TO_PTR(o) == &mp_const_ellipsis_obj) {
         byte obj_type = 'e';
         mp_print_bytes(print, &obj_type, 1);
+    #if MICROPY_MODULE_CACHE
+    // Only the module cache saves folded tuples and the constants they may hold, see parse.c.
+    } else if (o == mp_const_none || o == mp_const_true || o == mp_const_false) {
+        byte obj_type = o == mp_const_none ? 'n' : o == mp_const_true ? 'T' : 'F';
+        mp_print_bytes(print, &obj_type, 1);
+    } else if (MP_OBJ_IS_TYPE(o, &mp_type_tuple)) {
+        byte obj_type = 't';
+        size_t len;
+        mp_obj_t *items;
+        mp_obj_tuple_get(o, &len, &items);
+        mp_print_bytes(print, &obj_type, 1);
+        mp_print_uint(print, len);
+        for (size_t i = 0; i < len; i++) {
+            save_obj(print, items[i]);
+        }
+    #endif
     } else {
         // we save numbers using a simplistic text representation
         // TODO could be improved
         byte obj_type;
-        if (MP_OBJ_IS_TYPE(o, &mp_type_int)) {
+        if (MP_OBJ_IS_INT(o)) {
             obj_type = 'i';
         #if MICROPY_PY_BUILTINS_COMPLEX
         } else if (MP_OBJ_IS_TYPE(o, &mp_type_complex)) {
@@ -337,21 +484,62 @@ STATIC void save_bytecode_qstrs(mp_print_t *print, const byte *ip, const byte *i
     }
 }
 
+#if MICROPY_DYNAMIC_COMPILER
+#define MPY_SAVE_IN_PLACE (mp_dynamic_compiler.mpy_in_place)
+#else
+#define MPY_SAVE_IN_PLACE (0)
+#endif
+
+STATIC void set_qstr_slot(byte *ptr, size_t slot) {
+    assert(slot < MP_BC_QSTR_SLOT);
+    ptr[0] = slot;
+    ptr[1] = (MP_BC_QSTR_SLOT | slot) >> 8;
+}
+
+// Save bytecode with its qstrs replaced by the constant table slots a loader
+// running it in place puts them in, see load_raw_code.
+STATIC void save_bytecode_in_place(mp_print_t *print, mp_raw_code_t *rc, const bytecode_prelude_t *prelude) {
+    size_t bc_len = rc->data.u_byte.bc_len;
+    byte *bytecode = m_new(byte, bc_len);
+    memcpy(bytecode, rc->data.u_byte.bytecode, bc_len);
+    const byte *ip = bytecode;
+    const byte *ip2;
+    bytecode_prelude_t copy_prelude;
+    extract_prelude(&ip, &ip2, &copy_prelude);
+
+    size_t slot = prelude->n_pos_args + prelude->n_kwonly_args + rc->data.u_byte.n_obj + rc->data.u_byte.n_raw_code;
+    set_qstr_slot((byte*)ip2, slot++);
+    set_qstr_slot((byte*)ip2 + 2, slot++);
+    while (ip < bytecode + bc_len) {
+        size_t sz;
+        if (mp_opcode_format(ip, &sz) == MP_OPCODE_QSTR) {
+            set_qstr_slot((byte*)ip + 1, slot++);
+        }
+        ip += sz;
+    }
+    mp_print_bytes(print, bytecode, bc_len);
+    m_del(byte, bytecode, bc_len);
+}
+
 STATIC void save_raw_code(mp_print_t *print, mp_raw_code_t *rc) {
     if (rc->kind != MP_CODE_BYTECODE) {
         mp_raise_ValueError(translate("can only save bytecode"));
     }
 
-    // save bytecode
-    mp_print_uint(print, rc->data.u_byte.bc_len);
-    mp_print_bytes(print, rc->data.u_byte.bytecode, rc->data.u_byte.bc_len);
-
     // extract prelude
     const byte *ip = rc->data.u_byte.bytecode;
     const byte *ip2;
     bytecode_prelude_t prelude;
     extract_prelude(&ip, &ip2, &prelude);
 
+    // save bytecode
+    mp_print_uint(print, rc->data.u_byte.bc_len);
+    if (MPY_SAVE_IN_PLACE) {
+        save_bytecode_in_place(print, rc, &prelude);
+    } else {
+        mp_print_bytes(print, rc->data.u_byte.bytecode, rc->data.u_byte.bc_len);
+    }
+
     // save qstrs
     save_qstr(print, ip2[0] | (ip2[1] << 8)); // simple_name
     save_qstr(print, ip2[2] | (ip2[3] << 8)); // source_file
@@ -379,7 +567,7 @@ void mp_raw_code_save(mp_raw_code_t *rc, mp_print_t *print) {
     //  byte  version
     //  byte  feature flags
     //  byte  number of bits in a small int
-    byte header[4] = {'M', MPY_VERSION, MPY_FEATURE_FLAGS_DYNAMIC,
+    byte header[4] = {'M', MPY_VERSION, MPY_FEATURE_FLAGS_DYNAMIC | (MPY_SAVE_IN_PLACE ? MPY_FEATURE_QSTR_SLOTS : 0),
         #if MICROPY_DYNAMIC_COMPILER
         mp_dynamic_compiler.small_int_bits,
         #else
@@ -413,7 +601,8 @@ void mp_raw_code_save_file(mp_raw_code_t *rc, const char *filename) {
     close(fd);
 }
 
-#else
+#elif !MICROPY_MODULE_CACHE
+// The module cache saves through the VFS so it doesn't need this.
 #error mp_raw_code_save_file not implemented for this platform
 #endif
 
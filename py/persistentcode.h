@@ -34,6 +34,16 @@ mp_raw_code_t *mp_raw_code_load(mp_reader_t *reader);
 mp_raw_code_t *mp_raw_code_load_mem(const byte *buf, size_t len);
 mp_raw_code_t *mp_raw_code_load_file(const char *filename);
 
+#if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+// Load from a buffer that stays valid and unchanged while the code may run,
+// such as memory mapped flash, running the bytecode where it is if possible.
+mp_raw_code_t *mp_raw_code_load_in_place(const byte *buf, size_t len);
+
+// Provided by the port: return the address and length of a .mpy file if its
+// contents are memory mapped and contiguous, otherwise NULL.
+const byte *mp_persistent_code_map_file(const char *filename, size_t *len);
+#endif
+
 void mp_raw_code_save(mp_raw_code_t *rc, mp_print_t *print);
 void mp_raw_code_save_file(mp_raw_code_t *rc, const char *filename);
 
@@ -33,8 +33,8 @@
 #include "py/qstr.h"
 #include "py/gc.h"
 
-// NOTE: we are using linear arrays to store and search for qstr's (unique strings, interned strings)
-// ultimately we will replace this with a static hash table of some kind
+// NOTE: we are using linear arrays to store qstr's (unique strings, interned strings). Each pool
+// can have a hash index to search it. The ROM pool's index is generated by makeqstrdata.py
 // also probably need to include the length in the string data, to allow null bytes in the string
 
 #if MICROPY_DEBUG_VERBOSE // print debugging info
@@ -76,19 +76,33 @@
 #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
 #define QSTR_ENTER() mp_thread_mutex_lock(&MP_STATE_VM(qstr_mutex), 1)
 #define QSTR_EXIT() mp_thread_mutex_unlock(&MP_STATE_VM(qstr_mutex))
+// qstr_find_strn and qstr_str don't take the mutex, so a new qstr or pool must
+// be complete before anything that leads to it is stored.
+#define QSTR_PUBLISH() __atomic_thread_fence(__ATOMIC_RELEASE)
 #else
 #define QSTR_ENTER()
 #define QSTR_EXIT()
+#define QSTR_PUBLISH()
 #endif
 
+// Slot to start probing a pool index at. The stored hash may be a single byte so the index uses
+// the upper bits of the full hash too.
 // this must match the equivalent function in makeqstrdata.py
-mp_uint_t qstr_compute_hash(const byte *data, size_t len) {
+#define Q_INDEX_SLOT(full_hash, mask) (((full_hash) ^ ((full_hash) >> 16)) & (mask))
+
+// The full 32 bit hash of a qstr. Its low bits are the stored hash.
+// this must match the equivalent function in makeqstrdata.py
+STATIC uint32_t compute_full_hash(const byte *data, size_t len) {
     // djb2 algorithm; see http://www.cse.yorku.ca/~oz/hash.html
-    mp_uint_t hash = 5381;
+    uint32_t hash = 5381;
     for (const byte *top = data + len; data < top; data++) {
         hash = ((hash << 5) + hash) ^ (*data); // hash * 33 ^ data
     }
-    hash &= Q_HASH_MASK;
+    return hash;
+}
+
+STATIC mp_uint_t stored_hash(uint32_t full_hash) {
+    mp_uint_t hash = full_hash & Q_HASH_MASK;
     // Make sure that valid hash is never zero, zero means "hash not computed"
     if (hash == 0) {
         hash++;
@@ -96,11 +110,35 @@ mp_uint_t qstr_compute_hash(const byte *data, size_t len) {
     return hash;
 }
 
+mp_uint_t qstr_compute_hash(const byte *data, size_t len) {
+    return stored_hash(compute_full_hash(data, len));
+}
+
+#if MICROPY_QSTR_INDEX && !defined(NO_QSTR)
+// Generated by makeqstrdata.py from the same qstrs as mp_qstr_const_pool.
+STATIC const uint16_t mp_qstr_const_index[] = {
+#define QDEF(id, str)
+#define TRANSLATION(id, length, compressed...)
+#define QINDEX(...) __VA_ARGS__,
+#include "genhdr/qstrdefs.generated.h"
+#undef QINDEX
+#undef TRANSLATION
+#undef QDEF
+};
+#define CONST_POOL_INDEX mp_qstr_const_index
+#define CONST_POOL_INDEX_MASK (MP_ARRAY_SIZE(mp_qstr_const_index) - 1)
+#else
+#define CONST_POOL_INDEX NULL
+#define CONST_POOL_INDEX_MASK 0
+#endif
+
 const qstr_pool_t mp_qstr_const_pool = {
     NULL,               // no previous pool
     0,                  // no previous pool
     10,                 // set so that the first dynamically allocated pool is twice this size; must be <= the len (just below)
     MP_QSTRnumber_of,   // corresponds to number of strings in array just below
+    CONST_POOL_INDEX,
+    CONST_POOL_INDEX_MASK,
     {
 #ifndef NO_QSTR
 #define QDEF(id, str) str,
@@ -139,7 +177,7 @@ STATIC const byte *find_qstr(qstr q) {
 }
 
 // qstr_mutex must be taken while in this function
-STATIC qstr qstr_add(const byte *q_ptr) {
+STATIC qstr qstr_add(const byte *q_ptr, uint32_t full_hash) {
     DEBUG_printf("QSTR: add hash=%d len=%d data=%.*s\n", Q_GET_HASH(q_ptr), Q_GET_LENGTH(q_ptr), Q_GET_LENGTH(q_ptr), Q_GET_DATA(q_ptr));
 
     // make sure we have room in the pool for a new qstr
@@ -148,7 +186,17 @@ STATIC qstr qstr_add(const byte *q_ptr) {
         if (new_pool_length > MICROPY_QSTR_POOL_MAX_ENTRIES) {
             new_pool_length = MICROPY_QSTR_POOL_MAX_ENTRIES;
         }
-        qstr_pool_t *pool = m_new_ll_obj_var_maybe(qstr_pool_t, const char*, new_pool_length);
+        // The index is kept at most two thirds full so probes stay short. It lives in the same
+        // allocation, after the qstrs.
+        size_t index_length = 0;
+        #if MICROPY_QSTR_INDEX
+        index_length = 1;
+        while (index_length < new_pool_length + new_pool_length / 2) {
+            index_length *= 2;
+        }
+        #endif
+        size_t pool_size = sizeof(qstr_pool_t) + sizeof(const char*) * new_pool_length;
+        qstr_pool_t *pool = m_malloc_maybe(pool_size + sizeof(uint16_t) * index_length, true);
         if (pool == NULL) {
             QSTR_EXIT();
             m_malloc_fail(new_pool_length);
@@ -157,23 +205,61 @@ STATIC qstr qstr_add(const byte *q_ptr) {
         pool->total_prev_len = MP_STATE_VM(last_pool)->total_prev_len + MP_STATE_VM(last_pool)->len;
         pool->alloc = new_pool_length;
         pool->len = 0;
+        pool->index = NULL;
+        pool->index_mask = 0;
+        #if MICROPY_QSTR_INDEX
+        uint16_t *index = (uint16_t*)((byte*)pool + pool_size);
+        memset(index, 0, sizeof(uint16_t) * index_length);
+        pool->index = index;
+        pool->index_mask = index_length - 1;
+        #endif
+        QSTR_PUBLISH();
         MP_STATE_VM(last_pool) = pool;
         DEBUG_printf("QSTR: allocate new pool of size %d\n", MP_STATE_VM(last_pool)->alloc);
     }
 
     // add the new qstr
-    MP_STATE_VM(last_pool)->qstrs[MP_STATE_VM(last_pool)->len++] = q_ptr;
+    qstr_pool_t *pool = MP_STATE_VM(last_pool);
+    pool->qstrs[pool->len] = q_ptr;
+    QSTR_PUBLISH();
+    #if MICROPY_QSTR_INDEX
+    if (pool->index != NULL) {
+        // Only runtime pools are added to and their index is on the heap.
+        uint16_t *index = (uint16_t*)pool->index;
+        size_t slot = Q_INDEX_SLOT(full_hash, pool->index_mask);
+        while (index[slot] != 0) {
+            slot = (slot + 1) & pool->index_mask;
+        }
+        index[slot] = pool->len + 1;
+    }
+    #else
+    (void)full_hash;
+    #endif
+    pool->len++;
 
     // return id for the newly-added qstr
     return MP_STATE_VM(last_pool)->total_prev_len + MP_STATE_VM(last_pool)->len - 1;
 }
 
-qstr qstr_find_strn(const char *str, size_t str_len) {
-    // work out hash of str
-    mp_uint_t str_hash = qstr_compute_hash((const byte*)str, str_len);
+STATIC qstr find_strn(const char *str, size_t str_len, uint32_t full_hash) {
+    mp_uint_t str_hash = stored_hash(full_hash);
 
     // search pools for the data
     for (qstr_pool_t *pool = MP_STATE_VM(last_pool); pool != NULL; pool = pool->prev) {
+        #if MICROPY_QSTR_INDEX
+        if (pool->index != NULL) {
+            // The index always has empty slots so probing ends.
+            for (size_t slot = Q_INDEX_SLOT(full_hash, pool->index_mask); pool->index[slot] != 0;
+                 slot = (slot + 1) & pool->index_mask) {
+                size_t i = pool->index[slot] - 1;
+                const byte *q = pool->qstrs[i];
+                if (Q_GET_HASH(q) == str_hash && Q_GET_LENGTH(q) == str_len && memcmp(Q_GET_DATA(q), str, str_len) == 0) {
+                    return pool->total_prev_len + i;
+                }
+            }
+            continue;
+        }
+        #endif
         for (const byte **q = pool->qstrs, **q_top = pool->qstrs + pool->len; q < q_top; q++) {
             if (Q_GET_HASH(*q) == str_hash && Q_GET_LENGTH(*q) == str_len && memcmp(Q_GET_DATA(*q), str, str_len) == 0) {
                 return pool->total_prev_len + (q - pool->qstrs);
@@ -185,6 +271,10 @@ qstr qstr_find_strn(const char *str, size_t str_len) {
     return 0;
 }
 
+qstr qstr_find_strn(const char *str, size_t str_len) {
+    return find_strn(str, str_len, compute_full_hash((const byte*)str, str_len));
+}
+
 qstr qstr_from_str(const char *str) {
     return qstr_from_strn(str, strlen(str));
 }
@@ -192,13 +282,23 @@ qstr qstr_from_str(const char *str) {
 qstr qstr_from_strn(const char *str, size_t len) {
     assert(len < (1 << (8 * MICROPY_QSTR_BYTES_IN_LEN)));
     QSTR_ENTER();
-    qstr q = qstr_find_strn(str, len);
+    uint32_t full_hash = compute_full_hash((const byte*)str, len);
+    qstr q = find_strn(str, len, full_hash);
     if (q == 0) {
         // qstr does not exist in interned pool so need to add it
 
         // compute number of bytes needed to intern this string
         size_t n_bytes = MICROPY_QSTR_BYTES_IN_HASH + MICROPY_QSTR_BYTES_IN_LEN + len + 1;
 
+        #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+        // Bytecode that runs in place uses the top bit of a 16-bit qstr to mean
+        // a constant table slot (MP_BC_QSTR_SLOT), so qstrs can't reach it.
+        if (MP_STATE_VM(last_pool)->total_prev_len + MP_STATE_VM(last_pool)->len >= 0x8000) {
+            QSTR_EXIT();
+            m_malloc_fail(n_bytes);
+        }
+        #endif
+
         if (MP_STATE_VM(qstr_last_chunk) != NULL && MP_STATE_VM(qstr_last_used) + n_bytes > MP_STATE_VM(qstr_last_alloc)) {
             // not enough room at end of previously interned string so try to grow
             byte *new_p = m_renew_maybe(byte, MP_STATE_VM(qstr_last_chunk), MP_STATE_VM(qstr_last_alloc), MP_STATE_VM(qstr_last_alloc) + n_bytes, false);
@@ -237,12 +337,12 @@ qstr qstr_from_strn(const char *str, size_t len) {
         MP_STATE_VM(qstr_last_used) += n_bytes;
 
         // store the interned strings' data
-        mp_uint_t hash = qstr_compute_hash((const byte*)str, len);
+        mp_uint_t hash = stored_hash(full_hash);
         Q_SET_HASH(q_ptr, hash);
         Q_SET_LENGTH(q_ptr, len);
         memcpy(q_ptr + MICROPY_QSTR_BYTES_IN_HASH + MICROPY_QSTR_BYTES_IN_LEN, str, len);
         q_ptr[MICROPY_QSTR_BYTES_IN_HASH + MICROPY_QSTR_BYTES_IN_LEN + len] = '\0';
-        q = qstr_add(q_ptr);
+        q = qstr_add(q_ptr, full_hash);
     }
     QSTR_EXIT();
     return q;
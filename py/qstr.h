@@ -52,6 +52,10 @@ typedef struct _qstr_pool_t {
     size_t total_prev_len;
     size_t alloc;
     size_t len;
+    // Open addressed hash table of positions in qstrs plus one, with 0 marking empty slots. It has
+    // index_mask + 1 slots. NULL when the pool is searched linearly.
+    const uint16_t *index;
+    size_t index_mask;
     const byte *qstrs[];
 } qstr_pool_t;
 
@@ -66,11 +66,30 @@ void mp_reader_new_mem(mp_reader_t *reader, const byte *buf, size_t len, size_t
     reader->close = mp_reader_mem_close;
 }
 
+// Return a pointer to the next len bytes of a reader made by mp_reader_new_mem
+// and move past them.  Returns NULL for other readers or if there are fewer
+// than len bytes left.
+const byte *mp_reader_mem_skip(mp_reader_t *reader, size_t len) {
+    if (reader->readbyte != mp_reader_mem_readbyte) {
+        return NULL;
+    }
+    mp_reader_mem_t *rm = (mp_reader_mem_t*)reader->data;
+    if ((size_t)(rm->end - rm->cur) < len) {
+        return NULL;
+    }
+    const byte *buf = rm->cur;
+    rm->cur += len;
+    return buf;
+}
+
 #if MICROPY_READER_POSIX
 
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#if MICROPY_READER_POSIX_MMAP
+#include <sys/mman.h>
+#endif
 
 typedef struct _mp_reader_posix_t {
     bool close_fd;
@@ -125,12 +144,33 @@ void mp_reader_new_file_from_fd(mp_reader_t *reader, int fd, bool close_fd) {
 }
 
 #if !MICROPY_VFS_POSIX
+#if MICROPY_READER_POSIX_MMAP
+STATIC void mp_reader_mmap_close(void *data) {
+    mp_reader_mem_t *reader = (mp_reader_mem_t*)data;
+    munmap((void*)reader->beg, reader->end - reader->beg);
+    m_del_obj(mp_reader_mem_t, reader);
+}
+#endif
+
 // If MICROPY_VFS_POSIX is defined then this function is provided by the VFS layer
 void mp_reader_new_file(mp_reader_t *reader, const char *filename) {
     int fd = open(filename, O_RDONLY, 0644);
     if (fd < 0) {
         mp_raise_OSError(errno);
     }
+    #if MICROPY_READER_POSIX_MMAP
+    // A mapped file is read as memory, so mp_reader_mem_skip works on it.
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void *buf = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (buf != MAP_FAILED) {
+            close(fd);
+            mp_reader_new_mem(reader, buf, st.st_size, 0);
+            reader->close = mp_reader_mmap_close;
+            return;
+        }
+    }
+    #endif
     mp_reader_new_file_from_fd(reader, fd, true);
 }
 #endif
@@ -5,6 +5,15 @@
 #include "reload.h"
 #include "py/mpstate.h"
 
+#if MICROPY_RELOAD_MODULES
+#include "py/builtin.h"
+#include "py/nlr.h"
+#include "py/objlist.h"
+#include "py/runtime.h"
+#include "extmod/vfs.h"
+#include "supervisor/shared/autoreload.h"
+#endif
+
 void mp_raise_reload_exception(void) {
     MP_STATE_VM(mp_pending_exception) = MP_OBJ_FROM_PTR(&MP_STATE_VM(mp_reload_exception));
 #if MICROPY_ENABLE_SCHEDULER
@@ -14,3 +23,173 @@ void mp_raise_reload_exception(void) {
 #endif
 
 }
+
+#if MICROPY_RELOAD_MODULES
+
+// Files are compared by the size and modification time they had when they were loaded. Entries
+// are added as loads finish so a module comes after the modules it imports.
+typedef struct _mp_reload_file_t {
+    mp_obj_t module;
+    qstr path;
+    mp_obj_t size;
+    mp_obj_t mtime;
+    // list of the modules that import this one
+    mp_obj_t importers;
+} mp_reload_file_t;
+
+static bool reload_modules_enabled = false;
+
+void mp_reload_modules_enable(bool enable) {
+    reload_modules_enabled = enable;
+}
+
+void mp_raise_reload_modules_exception(void) {
+    MP_STATE_VM(reload_modules_requested) = true;
+    mp_raise_reload_exception();
+}
+
+STATIC void stat_file(qstr path, mp_obj_t *size, mp_obj_t *mtime) {
+    mp_obj_t *items;
+    mp_obj_get_array_fixed_n(mp_vfs_stat(MP_OBJ_NEW_QSTR(path)), 10, &items);
+    *size = items[6];
+    *mtime = items[8];
+}
+
+STATIC mp_reload_file_t *find_file(mp_obj_t module_obj) {
+    mp_reload_file_t *files = MP_STATE_VM(reload_files);
+    for (size_t i = 0; i < MP_STATE_VM(reload_files_len); i++) {
+        if (files[i].module == module_obj) {
+            return &files[i];
+        }
+    }
+    return NULL;
+}
+
+void mp_reload_track_file(mp_obj_t module_obj, const char *path) {
+    if (!reload_modules_enabled) {
+        return;
+    }
+    qstr path_qstr = qstr_from_str(path);
+    mp_obj_t size;
+    mp_obj_t mtime;
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        stat_file(path_qstr, &size, &mtime);
+        nlr_pop();
+    } else {
+        return;
+    }
+    if (MP_STATE_VM(reload_files_len) == MP_STATE_VM(reload_files_alloc)) {
+        size_t new_alloc = MP_STATE_VM(reload_files_alloc) + 8;
+        MP_STATE_VM(reload_files) = m_renew(mp_reload_file_t, MP_STATE_VM(reload_files),
+            MP_STATE_VM(reload_files_alloc), new_alloc);
+        MP_STATE_VM(reload_files_alloc) = new_alloc;
+    }
+    mp_reload_file_t *file = &MP_STATE_VM(reload_files)[MP_STATE_VM(reload_files_len)++];
+    file->module = module_obj;
+    file->path = path_qstr;
+    file->size = size;
+    file->mtime = mtime;
+    file->importers = mp_obj_new_list(0, NULL);
+}
+
+void mp_reload_track_import(mp_obj_t module_obj) {
+    if (!reload_modules_enabled) {
+        return;
+    }
+    mp_reload_file_t *file = find_file(module_obj);
+    if (file == NULL) {
+        return;
+    }
+    // The running module is the one whose globals are in use.
+    mp_obj_dict_t *globals = mp_globals_get();
+    mp_map_t *modules = &MP_STATE_VM(mp_loaded_modules_dict).map;
+    for (size_t i = 0; i < modules->alloc; i++) {
+        if (!MP_MAP_SLOT_IS_FILLED(modules, i)) {
+            continue;
+        }
+        mp_obj_t importer = modules->table[i].value;
+        if (importer != module_obj && MP_OBJ_IS_TYPE(importer, &mp_type_module)
+            && mp_obj_module_get_globals(importer) == globals) {
+            mp_obj_list_t *importers = MP_OBJ_TO_PTR(file->importers);
+            for (size_t j = 0; j < importers->len; j++) {
+                if (importers->items[j] == importer) {
+                    return;
+                }
+            }
+            mp_obj_list_append(file->importers, importer);
+            return;
+        }
+    }
+}
+
+bool mp_reload_changed_modules(void) {
+    if (!MP_STATE_VM(reload_modules_requested)) {
+        return false;
+    }
+    MP_STATE_VM(reload_modules_requested) = false;
+    size_t len = MP_STATE_VM(reload_files_len);
+    if (len == 0) {
+        return false;
+    }
+    bool reload[len];
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) != 0) {
+        // A file went missing or failed to run. Restarting reports it.
+        return false;
+    }
+    mp_reload_file_t *files = MP_STATE_VM(reload_files);
+    bool changed = false;
+    for (size_t i = 0; i < len; i++) {
+        mp_obj_t size;
+        mp_obj_t mtime;
+        stat_file(files[i].path, &size, &mtime);
+        reload[i] = !mp_obj_equal(size, files[i].size) || !mp_obj_equal(mtime, files[i].mtime);
+        if (reload[i] && files[i].module == MP_OBJ_NULL) {
+            nlr_pop();
+            return false;
+        }
+        changed = changed || reload[i];
+    }
+    if (!changed) {
+        // Something other than the loaded code changed.
+        nlr_pop();
+        return false;
+    }
+    // Modules that import a changed module run again too so the names they took from it are
+    // updated. The main program isn't run again.
+    while (changed) {
+        changed = false;
+        for (size_t i = 0; i < len; i++) {
+            if (!reload[i]) {
+                continue;
+            }
+            mp_obj_list_t *importers = MP_OBJ_TO_PTR(files[i].importers);
+            for (size_t j = 0; j < len; j++) {
+                if (reload[j] || files[j].module == MP_OBJ_NULL) {
+                    continue;
+                }
+                for (size_t k = 0; k < importers->len; k++) {
+                    if (importers->items[k] == files[j].module) {
+                        reload[j] = true;
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (reload[i]) {
+            // Stat first so changes made while the module runs are picked up next time.
+            files = MP_STATE_VM(reload_files);
+            stat_file(files[i].path, &files[i].size, &files[i].mtime);
+            mp_import_reload_file(files[i].module, qstr_str(files[i].path));
+        }
+    }
+    nlr_pop();
+    reload_requested = false;
+    return true;
+}
+
+#endif
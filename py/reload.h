@@ -5,6 +5,30 @@
 #ifndef CIRCUITPYTHON_RELOAD_H
 #define CIRCUITPYTHON_RELOAD_H
 
+#include "py/obj.h"
+
 void mp_raise_reload_exception(void);
 
+#if MICROPY_RELOAD_MODULES
+// Raises the reload exception but lets the VM reload the modules whose files changed in place
+// instead, when it can. See mp_reload_changed_modules.
+void mp_raise_reload_modules_exception(void);
+
+// Turns the tracking below on or off. It stays set across VM restarts so that everything the
+// next program loads is tracked.
+void mp_reload_modules_enable(bool enable);
+
+// Remembers the file that module_obj was loaded from, or the main program when module_obj is
+// MP_OBJ_NULL. Files that can't be found, such as frozen modules, aren't remembered.
+void mp_reload_track_file(mp_obj_t module_obj, const char *path);
+// Remembers that the running module imports module_obj.
+void mp_reload_track_import(mp_obj_t module_obj);
+
+// Runs the modules whose files changed, and the modules that import them, again in their
+// existing globals. Returns false when the VM must restart instead: when the reload wasn't
+// requested by mp_raise_reload_modules_exception, when no module changed, when the main program
+// changed or when reloading fails.
+bool mp_reload_changed_modules(void);
+#endif
+
 #endif //CIRCUITPYTHON_RELOAD_H
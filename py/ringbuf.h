@@ -29,12 +29,18 @@
 #include "py/gc.h"
 
 #include <stdint.h>
+#include <string.h>
 
+// A byte ring buffer for one producer and one consumer. Put functions only move iput and get
+// functions only move iget, and data is copied before the index moves, so one side may run in an
+// interrupt without locking. ringbuf_put_n() is the exception because it drops old data.
 typedef struct _ringbuf_t {
     uint8_t *buf;
     uint16_t size;
-    uint16_t iget;
-    uint16_t iput;
+    volatile uint16_t iget;
+    volatile uint16_t iput;
+    // The most bytes held at once, to help choose the buffer size.
+    uint16_t high_water;
 } ringbuf_t;
 
 // Static initialization:
@@ -47,63 +53,170 @@ typedef struct _ringbuf_t {
     (r)->buf = gc_alloc(sz, false, long_lived);   \
     (r)->size = sz; \
     (r)->iget = (r)->iput = 0; \
+    (r)->high_water = 0; \
+}
+
+// Keeps the compiler from moving buffer accesses past an index update.
+#define RINGBUF_BARRIER() __asm__ volatile ("" : : : "memory")
+
+static inline uint16_t ringbuf_advance(ringbuf_t *r, uint16_t i, uint16_t n) {
+    uint32_t next = i + n;
+    if (next >= r->size) {
+        next -= r->size;
+    }
+    return next;
+}
+
+static inline uint16_t ringbuf_count(ringbuf_t *r)
+{
+    int count = r->iput - r->iget;
+    if ( count < 0 ) {
+        count += r->size;
+    }
+
+    return (uint16_t) count;
+}
+
+// One slot is always left empty to tell a full buffer from an empty one.
+static inline uint16_t ringbuf_num_empty(ringbuf_t *r)
+{
+    return r->size - 1 - ringbuf_count(r);
+}
+
+static inline void ringbuf_clear(ringbuf_t *r)
+{
+    r->iput = r->iget = 0;
+}
+
+static inline void ringbuf_update_high_water(ringbuf_t *r) {
+    uint16_t count = ringbuf_count(r);
+    if (count > r->high_water) {
+        r->high_water = count;
+    }
 }
 
 static inline int ringbuf_get(ringbuf_t *r) {
-    if (r->iget == r->iput) {
+    uint16_t iget = r->iget;
+    if (iget == r->iput) {
         return -1;
     }
-    uint8_t v = r->buf[r->iget++];
-    if (r->iget >= r->size) {
-        r->iget = 0;
-    }
+    uint8_t v = r->buf[iget];
+    RINGBUF_BARRIER();
+    r->iget = ringbuf_advance(r, iget, 1);
     return v;
 }
 
 static inline int ringbuf_put(ringbuf_t *r, uint8_t v) {
-    uint32_t iput_new = r->iput + 1;
-    if (iput_new >= r->size) {
-        iput_new = 0;
-    }
+    uint16_t iput = r->iput;
+    uint16_t iput_new = ringbuf_advance(r, iput, 1);
     if (iput_new == r->iget) {
         return -1;
     }
-    r->buf[r->iput] = v;
+    r->buf[iput] = v;
+    RINGBUF_BARRIER();
     r->iput = iput_new;
+    ringbuf_update_high_water(r);
     return 0;
 }
 
-static inline uint16_t ringbuf_count(ringbuf_t *r)
-{
-    volatile int count = r->iput - r->iget;
-    if ( count < 0 ) {
-        count += r->size;
+// Spans let a driver read or write in place, such as by handing them to DMA. A span never wraps
+// around the end of the buffer, so there may be more after it.
+
+// Sets *data to the oldest bytes and returns how many can be read there.
+static inline uint16_t ringbuf_get_span(ringbuf_t *r, uint8_t **data) {
+    uint16_t iget = r->iget;
+    uint16_t iput = r->iput;
+    *data = r->buf + iget;
+    return (iput >= iget ? iput : r->size) - iget;
+}
+
+// Drops n bytes that have been read from the span.
+static inline void ringbuf_consume(ringbuf_t *r, uint16_t n) {
+    RINGBUF_BARRIER();
+    r->iget = ringbuf_advance(r, r->iget, n);
+}
+
+// Sets *data to free space and returns how many bytes can be written there.
+static inline uint16_t ringbuf_put_span(ringbuf_t *r, uint8_t **data) {
+    uint16_t iget = r->iget;
+    uint16_t iput = r->iput;
+    *data = r->buf + iput;
+    if (iget > iput) {
+        return iget - iput - 1;
     }
+    // Stop short of the end if the empty slot has to be there.
+    return r->size - iput - (iget == 0 ? 1 : 0);
+}
 
-    return (uint16_t) count;
+// Adds n bytes that have been written to the span.
+static inline void ringbuf_commit(ringbuf_t *r, uint16_t n) {
+    RINGBUF_BARRIER();
+    r->iput = ringbuf_advance(r, r->iput, n);
+    ringbuf_update_high_water(r);
 }
 
-static inline void ringbuf_clear(ringbuf_t *r)
+// Copies up to bufsize of the oldest bytes without removing them, in at most two memcpys. Returns
+// the number of bytes copied.
+static inline uint16_t ringbuf_peek_n(ringbuf_t* r, uint8_t* buf, uint16_t bufsize)
 {
-    r->iput = r->iget = 0;
+    uint16_t iget = r->iget;
+    uint16_t count = ringbuf_count(r);
+    if (bufsize > count) {
+        bufsize = count;
+    }
+    uint16_t first = r->size - iget;
+    if (first > bufsize) {
+        first = bufsize;
+    }
+    memcpy(buf, r->buf + iget, first);
+    memcpy(buf + first, r->buf, bufsize - first);
+    return bufsize;
 }
 
-// will overwrite old data
-static inline void ringbuf_put_n(ringbuf_t* r, uint8_t* buf, uint8_t bufsize)
+// Returns the number of bytes copied, which is less than bufsize if the buffer runs out.
+static inline uint16_t ringbuf_get_n(ringbuf_t* r, uint8_t* buf, uint16_t bufsize)
 {
-    for(uint8_t i=0; i < bufsize; i++) {
-        if ( ringbuf_put(r, buf[i]) < 0 ) {
-            // if full overwrite old data
-            (void) ringbuf_get(r);
-            ringbuf_put(r, buf[i]);
-        }
+    bufsize = ringbuf_peek_n(r, buf, bufsize);
+    ringbuf_consume(r, bufsize);
+    return bufsize;
+}
+
+// Copies in as much of buf as fits, in at most two memcpys, and returns how much that was.
+static inline uint16_t ringbuf_try_put_n(ringbuf_t* r, const uint8_t* buf, uint16_t bufsize)
+{
+    uint16_t available = ringbuf_num_empty(r);
+    if (bufsize > available) {
+        bufsize = available;
     }
+    uint16_t iput = r->iput;
+    uint16_t first = r->size - iput;
+    if (first > bufsize) {
+        first = bufsize;
+    }
+    memcpy(r->buf + iput, buf, first);
+    memcpy(r->buf, buf + first, bufsize - first);
+    ringbuf_commit(r, bufsize);
+    return bufsize;
 }
 
-static inline void ringbuf_get_n(ringbuf_t* r, uint8_t* buf, uint8_t bufsize)
+// will overwrite old data and return how many old bytes were lost
+static inline uint16_t ringbuf_put_n(ringbuf_t* r, const uint8_t* buf, uint16_t bufsize)
 {
-    for(uint8_t i=0; i < bufsize; i++) {
-        buf[i] = ringbuf_get(r);
+    uint16_t capacity = r->size - 1;
+    uint16_t overwritten = 0;
+    if (bufsize > capacity) {
+        // Only the end of buf will fit.
+        overwritten = bufsize - capacity;
+        buf += overwritten;
+        bufsize = capacity;
+    }
+    uint16_t available = ringbuf_num_empty(r);
+    if (bufsize > available) {
+        // if full overwrite old data
+        r->iget = ringbuf_advance(r, r->iget, bufsize - available);
+        overwritten += bufsize - available;
     }
+    ringbuf_try_put_n(r, buf, bufsize);
+    return overwritten;
 }
 #endif // MICROPY_INCLUDED_PY_RINGBUF_H
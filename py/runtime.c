@@ -44,6 +44,7 @@
 #include "py/builtin.h"
 #include "py/stackctrl.h"
 #include "py/gc.h"
+#include "py/frozenmod.h"
 
 #include "supervisor/shared/translate.h"
 
@@ -66,9 +67,29 @@ void mp_init(void) {
 
     // no pending exceptions to start with
     MP_STATE_VM(mp_pending_exception) = MP_OBJ_NULL;
+
+    #if MICROPY_TRACK_CURRENT_CODE_STATE
+    MP_STATE_THREAD(current_code_state) = NULL;
+    #endif
+
+    #if MICROPY_OPT_ATTR_LOOKUP_CACHE
+    // types from a previous heap may be at the same addresses as new ones
+    MP_STATE_VM(attr_lookup_epoch) += 1;
+    #endif
+    #if MICROPY_OPT_STR_INDEX_CACHE
+    memset(MP_STATE_VM(str_index_cache), 0, sizeof(MP_STATE_VM(str_index_cache)));
+    #endif
+    #if MICROPY_MODULE_FROZEN_ROM_FUN
+    // globals of frozen modules imported before a soft reset belong to the old heap
+    memset(mp_frozen_mpy_globals, 0, mp_frozen_mpy_globals_len * sizeof(mp_obj_dict_t));
+    #endif
     #if MICROPY_ENABLE_SCHEDULER
     MP_STATE_VM(sched_state) = MP_SCHED_IDLE;
-    MP_STATE_VM(sched_sp) = 0;
+    MP_STATE_VM(sched_len) = 0;
+    memset(MP_STATE_VM(sched_level_len), 0, sizeof(MP_STATE_VM(sched_level_len)));
+    #if MICROPY_SCHEDULER_STATS
+    memset(MP_STATE_VM(sched_stats), 0, sizeof(MP_STATE_VM(sched_stats)));
+    #endif
     #endif
 
 #if MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF
@@ -90,6 +111,18 @@ void mp_init(void) {
     MP_STATE_VM(mp_reload_exception).traceback_data = NULL;
     MP_STATE_VM(mp_reload_exception).args = (mp_obj_tuple_t*)&mp_const_empty_tuple_obj;
 
+    #if MICROPY_RELOAD_MODULES
+    MP_STATE_VM(reload_files) = NULL;
+    MP_STATE_VM(reload_files_len) = 0;
+    MP_STATE_VM(reload_files_alloc) = 0;
+    MP_STATE_VM(reload_modules_requested) = false;
+    #endif
+
+    #if MICROPY_EXCEPTION_POOL_SIZE
+    memset(MP_STATE_VM(mp_exception_pool), 0, sizeof(MP_STATE_VM(mp_exception_pool)));
+    MP_STATE_VM(mp_exception_pool_len) = 0;
+    #endif
+
     // call port specific initialization if any
 #ifdef MICROPY_PORT_INIT_FUNC
     MICROPY_PORT_INIT_FUNC;
@@ -129,6 +162,19 @@ void mp_init(void) {
            sizeof(MP_STATE_VM(fs_user_mount)) - MICROPY_FATFS_NUM_PERSISTENT);
     #endif
 
+    #if MICROPY_PY_UASYNCIO
+    MP_STATE_VM(uasyncio_state) = NULL;
+    #endif
+
+    #if MICROPY_PY_URE && MICROPY_PY_URE_CACHE_SIZE
+    memset(MP_STATE_VM(ure_cache), 0, sizeof(MP_STATE_VM(ure_cache)));
+    #endif
+
+    #if MICROPY_VFS_FAT_IMPORT_STAT_CACHE
+    MP_STATE_VM(fat_import_stat_cache) = NULL;
+    MP_STATE_VM(fat_import_stat_cache_used) = 0;
+    #endif
+
     #if MICROPY_PY_THREAD_GIL
     mp_thread_mutex_init(&MP_STATE_VM(gil_mutex));
     #endif
@@ -1037,7 +1083,7 @@ void mp_convert_member_lookup(mp_obj_t self, const mp_obj_type_t *type, mp_obj_t
         if (proxy[0] == mp_const_none) {
             mp_raise_AttributeError(translate("unreadable attribute"));
         } else {
-            dest[0] = mp_call_function_n_kw(proxy[0], 1, 0, &self);
+            dest[0] = mp_obj_property_call_get(proxy[0], self);
         }
     #endif
     } else {
@@ -1160,7 +1206,7 @@ void mp_store_attr(mp_obj_t base, qstr attr, mp_obj_t value) {
                     return;
                 }
             } else if (proxy[1] != mp_const_none) {
-                mp_call_function_n_kw(proxy[1], 2, 0, dest);
+                mp_obj_property_call_set(proxy[1], base, value);
                 return;
             }
         }
@@ -1367,7 +1413,9 @@ mp_obj_t mp_make_raise_obj(mp_obj_t o) {
         // could have const instances in ROM which we return here instead
         return mp_call_function_n_kw(o, 0, 0, NULL);
     } else if (mp_obj_is_exception_instance(o)) {
-        // o is an instance of an exception, so use it as the exception
+        // o is an instance of an exception, so use it as the exception; it
+        // may be referenced elsewhere so can't be reused once caught
+        mp_obj_exception_keep(o);
         return o;
     } else {
         // o cannot be used as an exception, so return a type error (which will be raised by the caller)
@@ -1499,6 +1547,54 @@ mp_obj_t mp_parse_compile_execute(mp_lexer_t *lex, mp_parse_input_kind_t parse_i
     }
 }
 
+#if MICROPY_COMPILE_BY_STATEMENT
+void mp_parse_compile_execute_by_statement(mp_lexer_t *lex, mp_obj_dict_t *globals) {
+    // save context
+    mp_obj_dict_t *volatile old_globals = mp_globals_get();
+    mp_obj_dict_t *volatile old_locals = mp_locals_get();
+
+    // set new context
+    mp_globals_set(globals);
+    mp_locals_set(globals);
+
+    #if MICROPY_COMP_CONST
+    mp_map_t consts;
+    mp_map_init(&consts, 0);
+    mp_map_t *consts_ptr = &consts;
+    #else
+    mp_map_t *consts_ptr = NULL;
+    #endif
+
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        qstr source_name = lex->source_name;
+        mp_parse_tree_t parse_tree;
+        // only one statement's parse tree and code is live at a time
+        while (mp_parse_file_stmt(lex, consts_ptr, &parse_tree)) {
+            mp_obj_t stmt_fun = mp_compile(&parse_tree, source_name, MP_EMIT_OPT_NONE, false);
+            mp_call_function_0(stmt_fun);
+        }
+        nlr_pop();
+    } else {
+        // exception; tidy up, restore context and re-raise same exception
+        #if MICROPY_COMP_CONST
+        mp_map_deinit(&consts);
+        #endif
+        mp_lexer_free(lex);
+        mp_globals_set(old_globals);
+        mp_locals_set(old_locals);
+        nlr_jump(nlr.ret_val);
+    }
+
+    #if MICROPY_COMP_CONST
+    mp_map_deinit(&consts);
+    #endif
+    mp_lexer_free(lex);
+    mp_globals_set(old_globals);
+    mp_locals_set(old_locals);
+}
+#endif
+
 #endif // MICROPY_ENABLE_COMPILER
 
 NORETURN void m_malloc_fail(size_t num_bytes) {
@@ -1512,11 +1608,19 @@ NORETURN void m_malloc_fail(size_t num_bytes) {
         translate("memory allocation failed, allocating %u bytes"), (uint)num_bytes);
 }
 
+// Raise an exception made here, which nothing else refers to yet
+STATIC NORETURN void raise_new(mp_obj_t exc) {
+    #if MICROPY_EXCEPTION_POOL_SIZE
+    mp_obj_exception_set_recyclable(exc);
+    #endif
+    nlr_raise(exc);
+}
+
 NORETURN void mp_raise_msg(const mp_obj_type_t *exc_type, const compressed_string_t *msg) {
     if (msg == NULL) {
-        nlr_raise(mp_obj_new_exception(exc_type));
+        raise_new(mp_obj_new_exception(exc_type));
     } else {
-        nlr_raise(mp_obj_new_exception_msg(exc_type, msg));
+        raise_new(mp_obj_new_exception_msg(exc_type, msg));
     }
 }
 
@@ -1525,7 +1629,11 @@ NORETURN void mp_raise_msg_varg(const mp_obj_type_t *exc_type, const compressed_
     va_start(argptr,fmt);
     mp_obj_t exception = mp_obj_new_exception_msg_vlist(exc_type, fmt, argptr);
     va_end(argptr);
-    nlr_raise(exception);
+    raise_new(exception);
+}
+
+NORETURN void mp_raise_arg1(const mp_obj_type_t *exc_type, mp_obj_t arg) {
+    raise_new(mp_obj_new_exception_arg1(exc_type, arg));
 }
 
 NORETURN void mp_raise_AttributeError(const compressed_string_t *msg) {
@@ -1553,7 +1661,7 @@ NORETURN void mp_raise_ValueError_varg(const compressed_string_t *fmt, ...) {
     va_start(argptr,fmt);
     mp_obj_t exception = mp_obj_new_exception_msg_vlist(&mp_type_ValueError, fmt, argptr);
     va_end(argptr);
-    nlr_raise(exception);
+    raise_new(exception);
 }
 
 NORETURN void mp_raise_TypeError(const compressed_string_t *msg) {
@@ -1565,11 +1673,11 @@ NORETURN void mp_raise_TypeError_varg(const compressed_string_t *fmt, ...) {
     va_start(argptr,fmt);
     mp_obj_t exception = mp_obj_new_exception_msg_vlist(&mp_type_TypeError, fmt, argptr);
     va_end(argptr);
-    nlr_raise(exception);
+    raise_new(exception);
 }
 
 NORETURN void mp_raise_OSError(int errno_) {
-    nlr_raise(mp_obj_new_exception_arg1(&mp_type_OSError, MP_OBJ_NEW_SMALL_INT(errno_)));
+    mp_raise_arg1(&mp_type_OSError, MP_OBJ_NEW_SMALL_INT(errno_));
 }
 
 NORETURN void mp_raise_OSError_msg(const compressed_string_t *msg) {
@@ -1581,7 +1689,7 @@ NORETURN void mp_raise_OSError_msg_varg(const compressed_string_t *fmt, ...) {
     va_start(argptr,fmt);
     mp_obj_t exception = mp_obj_new_exception_msg_vlist(&mp_type_OSError, fmt, argptr);
     va_end(argptr);
-    nlr_raise(exception);
+    raise_new(exception);
 }
 
 NORETURN void mp_raise_NotImplementedError(const compressed_string_t *msg) {
@@ -1593,7 +1701,7 @@ NORETURN void mp_raise_NotImplementedError_varg(const compressed_string_t *fmt,
     va_start(argptr,fmt);
     mp_obj_t exception = mp_obj_new_exception_msg_vlist(&mp_type_NotImplementedError, fmt, argptr);
     va_end(argptr);
-    nlr_raise(exception);
+    raise_new(exception);
 }
 
 NORETURN void mp_raise_OverflowError_varg(const compressed_string_t *fmt, ...) {
@@ -1601,7 +1709,7 @@ NORETURN void mp_raise_OverflowError_varg(const compressed_string_t *fmt, ...) {
     va_start(argptr,fmt);
     mp_obj_t exception = mp_obj_new_exception_msg_vlist(&mp_type_OverflowError, fmt, argptr);
     va_end(argptr);
-    nlr_raise(exception);
+    raise_new(exception);
 }
 
 NORETURN void mp_raise_MpyError(const compressed_string_t *msg) {
@@ -43,6 +43,7 @@
 #define MP_NATIVE_TYPE_PTR8 (0x05)
 #define MP_NATIVE_TYPE_PTR16 (0x06)
 #define MP_NATIVE_TYPE_PTR32 (0x07)
+#define MP_NATIVE_TYPE_FLOAT (0x08)
 
 typedef enum {
     // These ops may appear in the bytecode. Changing this group
@@ -193,6 +194,11 @@ typedef enum {
     MP_F_SETUP_CODE_STATE,
     MP_F_SMALL_INT_FLOOR_DIVIDE,
     MP_F_SMALL_INT_MODULO,
+#if MICROPY_EMIT_NATIVE_FLOAT
+    MP_F_NATIVE_FLOAT_BINARY_OP,
+    MP_F_NATIVE_FLOAT_FROM_INT,
+    MP_F_NATIVE_FLOAT_TO_INT,
+#endif
     MP_F_NUMBER_OF,
 } mp_fun_kind_t;
 
@@ -26,10 +26,35 @@
 
 #include <stdio.h>
 
+#include "py/mphal.h"
 #include "py/runtime.h"
 
 #if MICROPY_ENABLE_SCHEDULER
 
+// Take the oldest callback of the highest level that has one.  Must be called
+// in an atomic section with callbacks pending.
+STATIC mp_sched_item_t sched_pop(void) {
+    size_t level = MICROPY_SCHEDULER_PRIORITIES - 1;
+    while (MP_STATE_VM(sched_level_len)[level] == 0) {
+        --level;
+    }
+    size_t idx = MP_STATE_VM(sched_level_idx)[level];
+    mp_sched_item_t item = MP_STATE_VM(sched_queue)[level][idx];
+    MP_STATE_VM(sched_queue)[level][idx].func = MP_OBJ_NULL; // so we don't retain a pointer
+    MP_STATE_VM(sched_queue)[level][idx].arg = MP_OBJ_NULL;
+    MP_STATE_VM(sched_level_idx)[level] = (idx + 1) % MICROPY_SCHEDULER_DEPTH;
+    --MP_STATE_VM(sched_level_len)[level];
+    --MP_STATE_VM(sched_len);
+    #if MICROPY_SCHEDULER_STATS
+    mp_sched_stats_t *stats = &MP_STATE_VM(sched_stats)[level];
+    uint32_t latency = mp_hal_ticks_us() - item.ticks_us;
+    if (latency > stats->max_latency_us) {
+        stats->max_latency_us = latency;
+    }
+    #endif
+    return item;
+}
+
 // A variant of this is inlined in the VM at the pending exception check
 void mp_handle_pending(void) {
     if (MP_STATE_VM(sched_state) == MP_SCHED_PENDING) {
@@ -51,8 +76,8 @@ void mp_handle_pending(void) {
 // or by the VM's inlined version of that function.
 void mp_handle_pending_tail(mp_uint_t atomic_state) {
     MP_STATE_VM(sched_state) = MP_SCHED_LOCKED;
-    if (MP_STATE_VM(sched_sp) > 0) {
-        mp_sched_item_t item = MP_STATE_VM(sched_stack)[--MP_STATE_VM(sched_sp)];
+    if (mp_sched_num_pending()) {
+        mp_sched_item_t item = sched_pop();
         MICROPY_END_ATOMIC_SECTION(atomic_state);
         mp_call_function_1_protected(item.func, item.arg);
     } else {
@@ -84,25 +109,62 @@ void mp_sched_unlock(void) {
     MICROPY_END_ATOMIC_SECTION(atomic_state);
 }
 
-bool mp_sched_schedule(mp_obj_t function, mp_obj_t arg) {
+// Queue a callback at the given priority level, higher levels running first.
+// With coalesce, a callback already pending with the same function and
+// argument isn't queued again, and that counts as success.
+bool mp_sched_schedule_priority(mp_obj_t function, mp_obj_t arg, size_t priority, bool coalesce) {
+    assert(priority < MICROPY_SCHEDULER_PRIORITIES);
     mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
-    bool ret;
-    if (MP_STATE_VM(sched_sp) < MICROPY_SCHEDULER_DEPTH) {
+    mp_sched_item_t *queue = MP_STATE_VM(sched_queue)[priority];
+    size_t idx = MP_STATE_VM(sched_level_idx)[priority];
+    size_t len = MP_STATE_VM(sched_level_len)[priority];
+    #if MICROPY_SCHEDULER_STATS
+    mp_sched_stats_t *stats = &MP_STATE_VM(sched_stats)[priority];
+    #endif
+    bool ret = true;
+    if (coalesce) {
+        for (size_t i = 0; i < len; ++i) {
+            mp_sched_item_t *item = &queue[(idx + i) % MICROPY_SCHEDULER_DEPTH];
+            if (item->func == function && item->arg == arg) {
+                #if MICROPY_SCHEDULER_STATS
+                ++stats->coalesced;
+                #endif
+                goto done;
+            }
+        }
+    }
+    if (len < MICROPY_SCHEDULER_DEPTH) {
         if (MP_STATE_VM(sched_state) == MP_SCHED_IDLE) {
             MP_STATE_VM(sched_state) = MP_SCHED_PENDING;
         }
-        MP_STATE_VM(sched_stack)[MP_STATE_VM(sched_sp)].func = function;
-        MP_STATE_VM(sched_stack)[MP_STATE_VM(sched_sp)].arg = arg;
-        ++MP_STATE_VM(sched_sp);
-        ret = true;
+        mp_sched_item_t *item = &queue[(idx + len) % MICROPY_SCHEDULER_DEPTH];
+        item->func = function;
+        item->arg = arg;
+        MP_STATE_VM(sched_level_len)[priority] = ++len;
+        ++MP_STATE_VM(sched_len);
+        #if MICROPY_SCHEDULER_STATS
+        item->ticks_us = mp_hal_ticks_us();
+        ++stats->scheduled;
+        if (len > stats->max_depth) {
+            stats->max_depth = len;
+        }
+        #endif
     } else {
-        // schedule stack is full
+        // this level's queue is full
+        #if MICROPY_SCHEDULER_STATS
+        ++stats->dropped;
+        #endif
         ret = false;
     }
+done:
     MICROPY_END_ATOMIC_SECTION(atomic_state);
     return ret;
 }
 
+bool mp_sched_schedule(mp_obj_t function, mp_obj_t arg) {
+    return mp_sched_schedule_priority(function, arg, 0, false);
+}
+
 #else // MICROPY_ENABLE_SCHEDULER
 
 // A variant of this is inlined in the VM at the pending exception check
@@ -47,7 +47,7 @@
 #if MICROPY_PERSISTENT_CODE
 
 #define DECODE_QSTR \
-    qst = ip[0] | ip[1] << 8; \
+    qst = MP_BC_RESOLVE_QSTR(ip[0] | ip[1] << 8, mp_showbc_const_table); \
     ip += 2;
 #define DECODE_PTR \
     DECODE_UINT; \
@@ -96,8 +96,8 @@ void mp_bytecode_print(const void *descr, const byte *ip, mp_uint_t len, const m
     ip += code_info_size;
 
     #if MICROPY_PERSISTENT_CODE
-    qstr block_name = code_info[0] | (code_info[1] << 8);
-    qstr source_file = code_info[2] | (code_info[3] << 8);
+    qstr block_name = MP_BC_RESOLVE_QSTR(code_info[0] | (code_info[1] << 8), const_table);
+    qstr source_file = MP_BC_RESOLVE_QSTR(code_info[2] | (code_info[3] << 8), const_table);
     code_info += 4;
     #else
     qstr block_name = mp_decode_uint(&code_info);
@@ -211,6 +211,11 @@ const byte *mp_bytecode_print_str(const byte *ip) {
             printf("LOAD_FAST_N " UINT_FMT, unum);
             break;
 
+        case MP_BC_LOAD_FAST_UNCHECKED:
+            DECODE_UINT;
+            printf("LOAD_FAST_UNCHECKED " UINT_FMT, unum);
+            break;
+
         case MP_BC_LOAD_DEREF:
             DECODE_UINT;
             printf("LOAD_DEREF " UINT_FMT, unum);
@@ -245,6 +250,29 @@ const byte *mp_bytecode_print_str(const byte *ip) {
             printf("LOAD_METHOD %s", qstr_str(qst));
             break;
 
+        case MP_BC_LOAD_FAST_ATTR:
+            DECODE_QSTR;
+            printf("LOAD_FAST_ATTR " UINT_FMT " %s", (mp_uint_t)*ip++, qstr_str(qst));
+            break;
+
+        case MP_BC_LOAD_FAST_METHOD:
+            DECODE_QSTR;
+            printf("LOAD_FAST_METHOD " UINT_FMT " %s", (mp_uint_t)*ip++, qstr_str(qst));
+            break;
+
+        case MP_BC_LOAD_FAST_PAIR:
+            printf("LOAD_FAST_PAIR " UINT_FMT " " UINT_FMT, (mp_uint_t)(*ip & 0xf), (mp_uint_t)(*ip >> 4));
+            ip += 1;
+            break;
+
+        case MP_BC_BINARY_OP_SMALL_INT: {
+            mp_uint_t op = mp_bc_small_int_binary_op[*ip >> 5];
+            printf("BINARY_OP_SMALL_INT " UINT_FMT " %s " INT_FMT, op,
+                qstr_str(mp_binary_op_method_name[op]), (mp_int_t)(*ip & 0x1f) - 16);
+            ip += 1;
+            break;
+        }
+
         case MP_BC_LOAD_SUPER_METHOD:
             DECODE_QSTR;
             printf("LOAD_SUPER_METHOD %s", qstr_str(qst));
@@ -31,6 +31,7 @@
 #include "py/objstr.h"
 #include "py/stream.h"
 #include "py/runtime.h"
+#include "py/mphal.h"
 #include "supervisor/shared/translate.h"
 
 // This file defines generic Python stream read/write methods which
@@ -97,6 +98,33 @@ const mp_stream_p_t *mp_get_stream_raise(mp_obj_t self_in, int flags) {
     return stream_p;
 }
 
+#if MICROPY_STREAMS_READY_EVENTS
+
+STATIC volatile uint32_t stream_ready_events;
+
+void mp_stream_signal_ready(void) {
+    stream_ready_events++;
+}
+
+uint32_t mp_stream_ready_events(void) {
+    return stream_ready_events;
+}
+
+bool mp_stream_wait_ready(uint32_t events, mp_uint_t start_ms, mp_uint_t timeout_ms) {
+    while (stream_ready_events == events) {
+        if (timeout_ms != (mp_uint_t)-1 && mp_hal_ticks_ms() - start_ms >= timeout_ms) {
+            return false;
+        }
+        MICROPY_EVENT_POLL_HOOK
+        if (stream_ready_events == events) {
+            MICROPY_EVENT_WAIT_HOOK
+        }
+    }
+    return true;
+}
+
+#endif
+
 STATIC mp_obj_t stream_read_generic(size_t n_args, const mp_obj_t *args, byte flags) {
     // What to do if sz < -1?  Python docs don't specify this case.
     // CPython does a readall, but here we silently let negatives through,
@@ -275,6 +303,61 @@ STATIC mp_obj_t stream_write1_method(mp_obj_t self_in, mp_obj_t arg) {
 }
 MP_DEFINE_CONST_FUN_OBJ_2(mp_stream_write1_obj, stream_write1_method);
 
+// Write all of each buffer in turn, letting the stream do it in one go if it can.
+// Like mp_stream_rw, returns the number of bytes written and sets *errcode.
+mp_uint_t mp_stream_writev(mp_obj_t stream, const mp_stream_iovec_t *iov, size_t iovcnt, int *errcode) {
+    const mp_stream_p_t *stream_p = mp_get_stream(stream);
+    if (stream_p->has_writev) {
+        struct mp_stream_writev_t arg = {iov, iovcnt};
+        *errcode = 0;
+        mp_uint_t out_sz = stream_p->ioctl(stream, MP_STREAM_WRITEV, (uintptr_t)&arg, errcode);
+        if (out_sz != MP_STREAM_ERROR) {
+            return out_sz;
+        }
+        if (*errcode != MP_EINVAL) {
+            return 0;
+        }
+        // the stream can't do it this time, so write the buffers one by one
+    }
+    mp_uint_t done = 0;
+    for (size_t i = 0; i < iovcnt; i++) {
+        done += mp_stream_write_exactly(stream, iov[i].buf, iov[i].len, errcode);
+        if (*errcode != 0) {
+            break;
+        }
+    }
+    return done;
+}
+
+// Write each buffer in a list or tuple, without joining them first
+STATIC mp_obj_t stream_writev_method(mp_obj_t self_in, mp_obj_t bufs_in) {
+    const mp_stream_p_t *stream_p = mp_get_stream_raise(self_in, MP_STREAM_OP_WRITE);
+    size_t n;
+    mp_obj_t *bufs;
+    mp_obj_get_array(bufs_in, &n, &bufs);
+    mp_stream_iovec_t iov[8];
+    mp_uint_t done = 0;
+    for (size_t i = 0; i < n;) {
+        size_t iovcnt = 0;
+        for (; iovcnt < MP_ARRAY_SIZE(iov) && i < n; iovcnt++, i++) {
+            mp_buffer_info_t bufinfo;
+            mp_get_buffer_raise(bufs[i], &bufinfo, MP_BUFFER_READ);
+            if (!stream_p->is_text && MP_OBJ_IS_STR(bufs[i])) {
+                mp_raise_ValueError(translate("string not supported; use bytes or bytearray"));
+            }
+            iov[iovcnt].buf = bufinfo.buf;
+            iov[iovcnt].len = bufinfo.len;
+        }
+        int errcode;
+        done += mp_stream_writev(self_in, iov, iovcnt, &errcode);
+        if (errcode != 0) {
+            mp_raise_OSError(errcode);
+        }
+    }
+    return mp_obj_new_int_from_uint(done);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(mp_stream_writev_obj, stream_writev_method);
+
 STATIC mp_obj_t stream_readinto(size_t n_args, const mp_obj_t *args) {
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_WRITE);
@@ -42,6 +42,7 @@
 #define MP_STREAM_SET_OPTS      (7)  // Set stream options
 #define MP_STREAM_GET_DATA_OPTS (8)  // Get data/message options
 #define MP_STREAM_SET_DATA_OPTS (9)  // Set data/message options
+#define MP_STREAM_WRITEV        (10) // Write several buffers, arg is struct mp_stream_writev_t*
 
 // These poll ioctl values are compatible with Linux
 #define MP_STREAM_POLL_RD  (0x0001)
@@ -58,6 +59,19 @@ struct mp_stream_seek_t {
     int whence;
 };
 
+// One buffer for mp_stream_writev
+typedef struct _mp_stream_iovec_t {
+    const void *buf;
+    size_t len;
+} mp_stream_iovec_t;
+
+// Argument structure for MP_STREAM_WRITEV, which returns the number of bytes written
+// after writing all of them unless there's an error
+struct mp_stream_writev_t {
+    const mp_stream_iovec_t *iov;
+    size_t iovcnt;
+};
+
 // seek ioctl "whence" values
 #define MP_SEEK_SET (0)
 #define MP_SEEK_CUR (1)
@@ -73,6 +87,8 @@ typedef struct _mp_stream_p_t {
     mp_uint_t (*ioctl)(mp_obj_t obj, mp_uint_t request, uintptr_t arg, int *errcode);
     mp_uint_t is_text : 1; // default is bytes, set this for text stream
     bool pyserial_compatibility: 1;  // adjust API to match pyserial more closely
+    bool has_writev: 1; // ioctl supports MP_STREAM_WRITEV
+    bool signals_ready: 1; // calls mp_stream_signal_ready when it may have become ready
 } mp_stream_p_t;
 
 MP_DECLARE_CONST_FUN_OBJ_VAR_BETWEEN(mp_stream_read_obj);
@@ -82,6 +98,7 @@ MP_DECLARE_CONST_FUN_OBJ_VAR_BETWEEN(mp_stream_unbuffered_readline_obj);
 MP_DECLARE_CONST_FUN_OBJ_1(mp_stream_unbuffered_readlines_obj);
 MP_DECLARE_CONST_FUN_OBJ_VAR_BETWEEN(mp_stream_write_obj);
 MP_DECLARE_CONST_FUN_OBJ_2(mp_stream_write1_obj);
+MP_DECLARE_CONST_FUN_OBJ_2(mp_stream_writev_obj);
 MP_DECLARE_CONST_FUN_OBJ_1(mp_stream_close_obj);
 MP_DECLARE_CONST_FUN_OBJ_VAR_BETWEEN(mp_stream_seek_obj);
 MP_DECLARE_CONST_FUN_OBJ_1(mp_stream_tell_obj);
@@ -106,6 +123,19 @@ mp_obj_t mp_stream_unbuffered_iter(mp_obj_t self);
 
 mp_obj_t mp_stream_write(mp_obj_t self_in, const void *buf, size_t len, byte flags);
 
+#if MICROPY_STREAMS_READY_EVENTS
+// Streams with signals_ready set call this, possibly from an interrupt, when
+// they may have become ready.
+void mp_stream_signal_ready(void);
+// Read this before polling so that a stream becoming ready after being polled
+// isn't missed.
+uint32_t mp_stream_ready_events(void);
+// Waits until mp_stream_ready_events changes from events and returns true, or
+// returns false once timeout_ms have passed since start_ms. A timeout of -1
+// waits for ever.
+bool mp_stream_wait_ready(uint32_t events, mp_uint_t start_ms, mp_uint_t timeout_ms);
+#endif
+
 // C-level helper functions
 #define MP_STREAM_RW_READ  0
 #define MP_STREAM_RW_WRITE 2
@@ -113,6 +143,7 @@ mp_obj_t mp_stream_write(mp_obj_t self_in, const void *buf, size_t len, byte fla
 mp_uint_t mp_stream_rw(mp_obj_t stream, void *buf, mp_uint_t size, int *errcode, byte flags);
 #define mp_stream_write_exactly(stream, buf, size, err) mp_stream_rw(stream, (byte*)buf, size, err, MP_STREAM_RW_WRITE)
 #define mp_stream_read_exactly(stream, buf, size, err) mp_stream_rw(stream, buf, size, err, MP_STREAM_RW_READ)
+mp_uint_t mp_stream_writev(mp_obj_t stream, const mp_stream_iovec_t *iov, size_t iovcnt, int *errcode);
 
 void mp_stream_write_adaptor(void *self, const char *buf, size_t len);
 mp_obj_t mp_stream_flush(mp_obj_t self);
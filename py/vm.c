@@ -34,6 +34,8 @@
 #include "py/runtime.h"
 #include "py/bc0.h"
 #include "py/bc.h"
+#include "py/smallint.h"
+#include "py/reload.h"
 
 #if 0
 #define TRACE(ip) printf("sp=%d ", (int)(sp - &code_state->state[0] + 1)); mp_bytecode_print2(ip, 1, code_state->fun_bc->const_table);
@@ -59,7 +61,7 @@
 #if MICROPY_PERSISTENT_CODE
 
 #define DECODE_QSTR \
-    qstr qst = ip[0] | ip[1] << 8; \
+    qstr qst = MP_BC_RESOLVE_QSTR(ip[0] | ip[1] << 8, code_state->fun_bc->const_table); \
     ip += 2;
 #define DECODE_PTR \
     DECODE_UINT; \
@@ -110,13 +112,186 @@
     exc_sp--; /* pop back to previous exception handler */ \
     CLEAR_SYS_EXC_INFO() /* just clear sys.exc_info(), not compliant, but it shouldn't be used in 1st place */
 
+#if MICROPY_OPT_VM_SMALL_INT_FAST_PATH || MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS
+// Perform op on two small int values without going through mp_binary_op.
+// Returns MP_OBJ_NULL if the op is not handled here or the result would not
+// fit in a small int, in which case the caller must use mp_binary_op.
+static inline mp_obj_t vm_small_int_binary_op(mp_binary_op_t op, mp_int_t lhs, mp_int_t rhs) {
+    switch (op) {
+        case MP_BINARY_OP_LESS: return mp_obj_new_bool(lhs < rhs);
+        case MP_BINARY_OP_MORE: return mp_obj_new_bool(lhs > rhs);
+        case MP_BINARY_OP_EQUAL: return mp_obj_new_bool(lhs == rhs);
+        case MP_BINARY_OP_LESS_EQUAL: return mp_obj_new_bool(lhs <= rhs);
+        case MP_BINARY_OP_MORE_EQUAL: return mp_obj_new_bool(lhs >= rhs);
+        case MP_BINARY_OP_NOT_EQUAL: return mp_obj_new_bool(lhs != rhs);
+        // the bitwise ops can't overflow
+        case MP_BINARY_OP_OR:
+        case MP_BINARY_OP_INPLACE_OR: return MP_OBJ_NEW_SMALL_INT(lhs | rhs);
+        case MP_BINARY_OP_XOR:
+        case MP_BINARY_OP_INPLACE_XOR: return MP_OBJ_NEW_SMALL_INT(lhs ^ rhs);
+        case MP_BINARY_OP_AND:
+        case MP_BINARY_OP_INPLACE_AND: return MP_OBJ_NEW_SMALL_INT(lhs & rhs);
+        case MP_BINARY_OP_LSHIFT:
+        case MP_BINARY_OP_INPLACE_LSHIFT:
+            // negative counts raise, and large results need a big int
+            if (rhs < 0 || rhs >= (mp_int_t)BITS_PER_WORD
+                || lhs > (MP_SMALL_INT_MAX >> rhs) || lhs < (MP_SMALL_INT_MIN >> rhs)) {
+                return MP_OBJ_NULL;
+            }
+            return MP_OBJ_NEW_SMALL_INT(lhs << rhs);
+        case MP_BINARY_OP_RSHIFT:
+        case MP_BINARY_OP_INPLACE_RSHIFT:
+            if (rhs < 0) {
+                return MP_OBJ_NULL;
+            }
+            if (rhs >= (mp_int_t)BITS_PER_WORD) {
+                rhs = BITS_PER_WORD - 1;
+            }
+            return MP_OBJ_NEW_SMALL_INT(lhs >> rhs);
+        case MP_BINARY_OP_ADD:
+        case MP_BINARY_OP_INPLACE_ADD:
+            lhs += rhs;
+            break;
+        case MP_BINARY_OP_SUBTRACT:
+        case MP_BINARY_OP_INPLACE_SUBTRACT:
+            lhs -= rhs;
+            break;
+        default:
+            return MP_OBJ_NULL;
+    }
+    // two small ints can't overflow mp_int_t when added or subtracted
+    if (!MP_SMALL_INT_FITS(lhs)) {
+        return MP_OBJ_NULL;
+    }
+    return MP_OBJ_NEW_SMALL_INT(lhs);
+}
+#endif
+
+#if MICROPY_VM_OPCODE_STATS
+
+// Marks that no opcode has been executed yet in this invocation, so the
+// next one doesn't start a pair.
+#define OPCODE_STATS_NO_PREV (0x100)
+
+typedef struct _opcode_stats_pair_t {
+    uint16_t pair; // previous opcode in the high byte
+    uint32_t count; // 0 means the slot is free
+} opcode_stats_pair_t;
+
+STATIC uint32_t opcode_stats_counts[256];
+STATIC opcode_stats_pair_t opcode_stats_pairs[MICROPY_VM_OPCODE_STATS_PAIR_SLOTS];
+STATIC uint32_t opcode_stats_pair_overflow;
+
+static inline void opcode_stats_record(uint *prev, byte op) {
+    opcode_stats_counts[op] += 1;
+    if (*prev != OPCODE_STATS_NO_PREV) {
+        uint16_t pair = *prev << 8 | op;
+        size_t slot = (pair ^ (pair >> 7)) & (MICROPY_VM_OPCODE_STATS_PAIR_SLOTS - 1);
+        size_t i;
+        for (i = 0; i < MICROPY_VM_OPCODE_STATS_PAIR_SLOTS; i++) {
+            opcode_stats_pair_t *p = &opcode_stats_pairs[slot];
+            if (p->count == 0 || p->pair == pair) {
+                p->pair = pair;
+                p->count += 1;
+                break;
+            }
+            slot = (slot + 1) & (MICROPY_VM_OPCODE_STATS_PAIR_SLOTS - 1);
+        }
+        if (i == MICROPY_VM_OPCODE_STATS_PAIR_SLOTS) {
+            opcode_stats_pair_overflow += 1;
+        }
+    }
+    *prev = op;
+}
+
+void mp_opcode_stats_print(const mp_print_t *print) {
+    // This format is read by tools/analyze_opcode_stats.py
+    mp_printf(print, "opcode_stats 1\n");
+    for (size_t i = 0; i < 256; i++) {
+        if (opcode_stats_counts[i] != 0) {
+            mp_printf(print, "op 0x%02x %u\n", (uint)i, (uint)opcode_stats_counts[i]);
+        }
+    }
+    for (size_t i = 0; i < MICROPY_VM_OPCODE_STATS_PAIR_SLOTS; i++) {
+        const opcode_stats_pair_t *p = &opcode_stats_pairs[i];
+        if (p->count != 0) {
+            mp_printf(print, "pair 0x%02x 0x%02x %u\n", p->pair >> 8, p->pair & 0xff, (uint)p->count);
+        }
+    }
+    mp_printf(print, "pair_overflow %u\n", (uint)opcode_stats_pair_overflow);
+}
+
+void mp_opcode_stats_reset(void) {
+    memset(opcode_stats_counts, 0, sizeof(opcode_stats_counts));
+    memset(opcode_stats_pairs, 0, sizeof(opcode_stats_pairs));
+    opcode_stats_pair_overflow = 0;
+}
+
+#define OPCODE_STATS_RECORD(op) opcode_stats_record(&opcode_stats_prev, (op))
+#else
+#define OPCODE_STATS_RECORD(op)
+#endif
+
+#if MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE && MICROPY_PY_SLOTS
+// Whether the cached byte x of a LOAD_ATTR/STORE_ATTR is the slot of attr
+STATIC inline bool vm_is_cached_slot(const mp_obj_type_t *type, mp_uint_t x, qstr attr) {
+    const mp_obj_slots_type_t *slots_type = (const mp_obj_slots_type_t*)type;
+    return x < slots_type->n_slots && slots_type->slots[x] == attr;
+}
+#endif
+
+#if MICROPY_STACKLESS
+// Calls to bytecode functions, and to closures over them, are run by
+// switching code_state to a new frame instead of recursing into
+// mp_execute_bytecode, so they don't use any C stack.
+STATIC inline bool vm_is_stackless_callable(mp_obj_t fun) {
+    return mp_obj_get_type(fun) == &mp_type_fun_bc || mp_obj_is_closure_of_fun_bc(fun);
+}
+
+STATIC mp_code_state_t *vm_alloc_codestate(mp_obj_t fun) {
+    if (mp_obj_get_type(fun) == &mp_type_fun_bc) {
+        return mp_obj_fun_bc_alloc_codestate(fun);
+    }
+    return mp_obj_closure_alloc_codestate(fun);
+}
+
+STATIC void vm_init_codestate(mp_code_state_t *code_state, mp_obj_t fun, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    if (mp_obj_get_type(fun) == &mp_type_fun_bc) {
+        mp_obj_fun_bc_init_codestate(code_state, n_args, n_kw, args);
+    } else {
+        mp_obj_closure_init_codestate(code_state, fun, n_args, n_kw, args);
+    }
+}
+
+STATIC mp_code_state_t *vm_prepare_codestate(mp_obj_t fun, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_code_state_t *code_state = vm_alloc_codestate(fun);
+    if (code_state != NULL) {
+        vm_init_codestate(code_state, fun, n_args, n_kw, args);
+    }
+    return code_state;
+}
+#endif
+
+#if MICROPY_EXCEPTION_POOL_SIZE
+// Called when the except clause of the handler at exc_sp finishes.  Its
+// exception may be reused unless an enclosing clause can still re-raise it.
+STATIC void vm_recycle_exception(mp_exc_stack_t *exc_stack, mp_exc_stack_t *exc_sp) {
+    for (mp_exc_stack_t *e = exc_sp - 1; e >= exc_stack; e--) {
+        if (e->prev_exc == exc_sp->prev_exc) {
+            return;
+        }
+    }
+    mp_obj_exception_recycle(MP_OBJ_FROM_PTR(exc_sp->prev_exc));
+}
+#endif
+
 // fastn has items in reverse order (fastn[0] is local[0], fastn[-1] is local[1], etc)
 // sp points to bottom of stack which grows up
 // returns:
 //  MP_VM_RETURN_NORMAL, sp valid, return value in *sp
 //  MP_VM_RETURN_YIELD, ip, sp valid, yielded value in *sp
 //  MP_VM_RETURN_EXCEPTION, exception in fastn[0]
-mp_vm_return_kind_t mp_execute_bytecode(mp_code_state_t *code_state, volatile mp_obj_t inject_exc) {
+mp_vm_return_kind_t PLACE_IN_ITCM(mp_execute_bytecode)(mp_code_state_t *code_state, volatile mp_obj_t inject_exc) {
 #define SELECTIVE_EXC_IP (0)
 #if SELECTIVE_EXC_IP
 #define MARK_EXC_IP_SELECTIVE() { code_state->ip = ip; } /* stores ip 1 byte past last opcode */
@@ -130,6 +305,7 @@ mp_vm_return_kind_t mp_execute_bytecode(mp_code_state_t *code_state, volatile mp
     #define DISPATCH() do { \
         TRACE(ip); \
         MARK_EXC_IP_GLOBAL(); \
+        OPCODE_STATS_RECORD(*ip); \
         goto *entry_table[*ip++]; \
     } while (0)
     #define DISPATCH_WITH_PEND_EXC_CHECK() goto pending_exception_check
@@ -150,6 +326,11 @@ mp_vm_return_kind_t mp_execute_bytecode(mp_code_state_t *code_state, volatile mp
 
 #if MICROPY_STACKLESS
 run_code_state: ;
+    #if MICROPY_TRACK_CURRENT_CODE_STATE
+    // Stackless calls and returns change frames without going through
+    // fun_bc_call, so keep the running frame up to date here.
+    MP_STATE_THREAD(current_code_state) = code_state;
+    #endif
 #endif
     // Pointers which are constant for particular invocation of mp_execute_bytecode()
     mp_obj_t * /*const*/ fastn;
@@ -179,6 +360,9 @@ outer_dispatch_loop:
             const byte *ip = code_state->ip;
             mp_obj_t *sp = code_state->sp;
             mp_obj_t obj_shared;
+            #if MICROPY_VM_OPCODE_STATS
+            uint opcode_stats_prev = OPCODE_STATS_NO_PREV;
+            #endif
             MICROPY_VM_HOOK_INIT
 
             // If we have exception to inject, now that we finish setting up
@@ -201,6 +385,7 @@ dispatch_loop:
 #else
                 TRACE(ip);
                 MARK_EXC_IP_GLOBAL();
+                OPCODE_STATS_RECORD(*ip);
                 switch (*ip++) {
 #endif
 
@@ -260,6 +445,12 @@ dispatch_loop:
                     DISPATCH();
                 }
 
+                ENTRY(MP_BC_LOAD_FAST_UNCHECKED): {
+                    DECODE_UINT;
+                    PUSH(fastn[-unum]);
+                    DISPATCH();
+                }
+
                 ENTRY(MP_BC_LOAD_DEREF): {
                     DECODE_UINT;
                     obj_shared = mp_obj_cell_get(fastn[-unum]);
@@ -336,7 +527,28 @@ dispatch_loop:
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
                     mp_obj_t top = TOP();
-                    if (mp_obj_is_instance_type(mp_obj_get_type(top))) {
+                    const mp_obj_type_t *type = mp_obj_get_type(top);
+                    #if MICROPY_PY_SLOTS
+                    if (mp_obj_is_instance_type(type) && mp_obj_type_has_slots(type)) {
+                        // the cached byte is the index of the slot
+                        mp_uint_t x = *ip;
+                        if (!vm_is_cached_slot(type, x, qst)) {
+                            x = mp_obj_slots_index(type, qst);
+                            if (x > 255) {
+                                goto load_attr_cache_fail;
+                            }
+                            *(byte*)ip = x;
+                        }
+                        mp_obj_slots_instance_t *self = MP_OBJ_TO_PTR(top);
+                        if (self->slots[x] == MP_OBJ_NULL) {
+                            goto load_attr_cache_fail;
+                        }
+                        SET_TOP(self->slots[x]);
+                        ip++;
+                        DISPATCH();
+                    }
+                    #endif
+                    if (mp_obj_is_instance_type(type)) {
                         mp_obj_instance_t *self = MP_OBJ_TO_PTR(top);
                         mp_uint_t x = *ip;
                         mp_obj_t key = MP_OBJ_NEW_QSTR(qst);
@@ -370,6 +582,43 @@ dispatch_loop:
                     DISPATCH();
                 }
 
+                #if MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS
+                ENTRY(MP_BC_LOAD_FAST_ATTR): {
+                    MARK_EXC_IP_SELECTIVE();
+                    DECODE_QSTR;
+                    obj_shared = fastn[-(mp_int_t)*ip++];
+                    if (obj_shared == MP_OBJ_NULL) {
+                        goto local_name_error;
+                    }
+                    PUSH(mp_load_attr(obj_shared, qst));
+                    DISPATCH();
+                }
+
+                ENTRY(MP_BC_LOAD_FAST_METHOD): {
+                    MARK_EXC_IP_SELECTIVE();
+                    DECODE_QSTR;
+                    obj_shared = fastn[-(mp_int_t)*ip++];
+                    if (obj_shared == MP_OBJ_NULL) {
+                        goto local_name_error;
+                    }
+                    PUSH(obj_shared);
+                    mp_load_method(*sp, qst, sp);
+                    sp += 1;
+                    DISPATCH();
+                }
+
+                ENTRY(MP_BC_LOAD_FAST_PAIR): {
+                    mp_uint_t locals = *ip++;
+                    obj_shared = fastn[-(mp_int_t)(locals & 0xf)];
+                    if (obj_shared == MP_OBJ_NULL) {
+                        goto local_name_error;
+                    }
+                    PUSH(obj_shared);
+                    obj_shared = fastn[-(mp_int_t)(locals >> 4)];
+                    goto load_check;
+                }
+                #endif
+
                 ENTRY(MP_BC_LOAD_SUPER_METHOD): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
@@ -434,7 +683,29 @@ dispatch_loop:
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
                     mp_obj_t top = TOP();
-                    if (mp_obj_is_instance_type(mp_obj_get_type(top)) && sp[-1] != MP_OBJ_NULL) {
+                    const mp_obj_type_t *type = mp_obj_get_type(top);
+                    #if MICROPY_PY_SLOTS
+                    if (mp_obj_is_instance_type(type) && mp_obj_type_has_slots(type) && sp[-1] != MP_OBJ_NULL) {
+                        // a property or __setattr__ may take over the store
+                        if (type->flags & TYPE_FLAG_HAS_SPECIAL_ACCESSORS) {
+                            goto store_attr_cache_fail;
+                        }
+                        mp_uint_t x = *ip;
+                        if (!vm_is_cached_slot(type, x, qst)) {
+                            x = mp_obj_slots_index(type, qst);
+                            if (x > 255) {
+                                goto store_attr_cache_fail;
+                            }
+                            *(byte*)ip = x;
+                        }
+                        mp_obj_slots_instance_t *self = MP_OBJ_TO_PTR(top);
+                        self->slots[x] = sp[-1];
+                        sp -= 2;
+                        ip++;
+                        DISPATCH();
+                    }
+                    #endif
+                    if (mp_obj_is_instance_type(type) && sp[-1] != MP_OBJ_NULL) {
                         mp_obj_instance_t *self = MP_OBJ_TO_PTR(top);
                         mp_uint_t x = *ip;
                         mp_obj_t key = MP_OBJ_NEW_QSTR(qst);
@@ -515,6 +786,12 @@ dispatch_loop:
                     DISPATCH();
 
                 ENTRY(MP_BC_POP_TOP):
+                    #if MICROPY_EXCEPTION_POOL_SIZE
+                    if (MP_UNLIKELY(currently_in_except_block) && TOP() == MP_OBJ_FROM_PTR(exc_sp->prev_exc)) {
+                        // an except clause without "as" is dropping its exception
+                        mp_obj_exception_discard(TOP());
+                    }
+                    #endif
                     sp -= 1;
                     DISPATCH();
 
@@ -622,6 +899,7 @@ dispatch_loop:
                         assert(mp_obj_is_exception_instance(TOP()));
                         // stack: (..., __exit__, ctx_mgr, exc_instance)
                         // Need to pass (exc_type, exc_instance, None) as arguments to __exit__.
+                        mp_obj_exception_keep(sp[0]);
                         sp[1] = sp[0];
                         sp[0] = MP_OBJ_FROM_PTR(mp_obj_get_type(sp[0]));
                         sp[2] = mp_const_none;
@@ -751,7 +1029,22 @@ unwind_jump:;
                     } else {
                         obj = MP_OBJ_FROM_PTR(&sp[-MP_OBJ_ITER_BUF_NSLOTS + 1]);
                     }
-                    mp_obj_t value = mp_iternext_allow_raise(obj);
+                    mp_obj_t value;
+                    #if MICROPY_PY_BUILTINS_ENUMERATE
+                    // "for i, x in enumerate(...)" unpacks each pair as soon as it's made, so
+                    // push the pair the way UNPACK_SEQUENCE would and skip it instead.
+                    if (ip[0] == MP_BC_UNPACK_SEQUENCE && ip[1] == 2 && MP_OBJ_IS_TYPE(obj, &mp_type_enumerate)) {
+                        if (mp_obj_enumerate_next_unpacked(obj, sp + 1)) {
+                            sp += 2;
+                            ip += 2;
+                            DISPATCH_WITH_PEND_EXC_CHECK();
+                        }
+                        value = MP_OBJ_STOP_ITERATION;
+                    } else
+                    #endif
+                    {
+                        value = mp_iternext_allow_raise(obj);
+                    }
                     if (value == MP_OBJ_STOP_ITERATION) {
                         sp -= MP_OBJ_ITER_BUF_NSLOTS; // pop the exhausted iterator
                         ip += ulab; // jump to after for-block
@@ -772,6 +1065,9 @@ unwind_jump:;
                 ENTRY(MP_BC_POP_EXCEPT):
                     assert(exc_sp >= exc_stack);
                     assert(currently_in_except_block);
+                    #if MICROPY_EXCEPTION_POOL_SIZE
+                    vm_recycle_exception(exc_stack, exc_sp);
+                    #endif
                     POP_EXC_BLOCK();
                     DISPATCH();
 
@@ -818,16 +1114,29 @@ unwind_jump:;
                 ENTRY(MP_BC_BUILD_SLICE): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_UINT;
-                    if (unum == 2) {
-                        mp_obj_t stop = POP();
-                        mp_obj_t start = TOP();
-                        SET_TOP(mp_obj_new_slice(start, stop, mp_const_none));
-                    } else {
-                        mp_obj_t step = POP();
-                        mp_obj_t stop = POP();
-                        mp_obj_t start = TOP();
-                        SET_TOP(mp_obj_new_slice(start, stop, step));
+                    mp_obj_t step = mp_const_none;
+                    if (unum == 3) {
+                        step = POP();
                     }
+                    mp_obj_t stop = POP();
+                    mp_obj_t start = TOP();
+                    // When the slice is only used to subscript a native type, as in
+                    // buf[a:b] or buf[a:b] = x, it can live on the C stack because
+                    // native subscr functions don't keep a reference to the index.
+                    // Instances are excluded as their __getitem__ may keep it.
+                    if ((*ip == MP_BC_LOAD_SUBSCR || *ip == MP_BC_STORE_SUBSCR)
+                        && mp_obj_is_native_type(mp_obj_get_type(sp[-1]))) {
+                        mp_obj_slice_t slice = {{&mp_type_slice}, start, stop, step};
+                        if (*ip++ == MP_BC_LOAD_SUBSCR) {
+                            sp--;
+                            SET_TOP(mp_obj_subscr(TOP(), MP_OBJ_FROM_PTR(&slice), MP_OBJ_SENTINEL));
+                        } else {
+                            mp_obj_subscr(sp[-1], MP_OBJ_FROM_PTR(&slice), sp[-2]);
+                            sp -= 3;
+                        }
+                        DISPATCH();
+                    }
+                    SET_TOP(mp_obj_new_slice(start, stop, step));
                     DISPATCH();
                 }
 #endif
@@ -906,11 +1215,11 @@ unwind_jump:;
                     // (unum >> 8) & 0xff == n_keyword
                     sp -= (unum & 0xff) + ((unum >> 7) & 0x1fe);
                     #if MICROPY_STACKLESS
-                    if (mp_obj_get_type(*sp) == &mp_type_fun_bc) {
+                    if (vm_is_stackless_callable(*sp)) {
                         code_state->ip = ip;
                         code_state->sp = sp;
                         code_state->exc_sp = MP_TAGPTR_MAKE(exc_sp, currently_in_except_block);
-                        mp_code_state_t *new_state = mp_obj_fun_bc_prepare_codestate(*sp, unum & 0xff, (unum >> 8) & 0xff, sp + 1);
+                        mp_code_state_t *new_state = vm_prepare_codestate(*sp, unum & 0xff, (unum >> 8) & 0xff, sp + 1);
                         #if !MICROPY_ENABLE_PYSTACK
                         if (new_state == NULL) {
                             // Couldn't allocate codestate on heap: in the strict case raise
@@ -942,21 +1251,15 @@ unwind_jump:;
                     // fun arg0 arg1 ... kw0 val0 kw1 val1 ... seq dict <- TOS
                     sp -= (unum & 0xff) + ((unum >> 7) & 0x1fe) + 2;
                     #if MICROPY_STACKLESS
-                    if (mp_obj_get_type(*sp) == &mp_type_fun_bc) {
+                    if (vm_is_stackless_callable(*sp)) {
                         code_state->ip = ip;
                         code_state->sp = sp;
                         code_state->exc_sp = MP_TAGPTR_MAKE(exc_sp, currently_in_except_block);
 
-                        mp_call_args_t out_args;
-                        mp_call_prepare_args_n_kw_var(false, unum, sp, &out_args);
-
-                        mp_code_state_t *new_state = mp_obj_fun_bc_prepare_codestate(out_args.fun,
-                            out_args.n_args, out_args.n_kw, out_args.args);
-                        #if !MICROPY_ENABLE_PYSTACK
-                        // Freeing args at this point does not follow a LIFO order so only do it if
-                        // pystack is not enabled.  For pystack, they are freed when code_state is.
-                        mp_nonlocal_free(out_args.args, out_args.n_alloc * sizeof(mp_obj_t));
-                        #endif
+                        // The new code state is allocated before the args array so that,
+                        // on the pystack, the array can be freed in LIFO order once the
+                        // code state has copied it.
+                        mp_code_state_t *new_state = vm_alloc_codestate(*sp);
                         #if !MICROPY_ENABLE_PYSTACK
                         if (new_state == NULL) {
                             // Couldn't allocate codestate on heap: in the strict case raise
@@ -967,6 +1270,12 @@ unwind_jump:;
                         } else
                         #endif
                         {
+                            mp_call_args_t out_args;
+                            mp_call_prepare_args_n_kw_var(false, unum, sp, &out_args);
+                            vm_init_codestate(new_state, out_args.fun,
+                                out_args.n_args, out_args.n_kw, out_args.args);
+                            mp_nonlocal_free(out_args.args, out_args.n_alloc * sizeof(mp_obj_t));
+
                             new_state->prev = code_state;
                             code_state = new_state;
                             nlr_pop();
@@ -985,7 +1294,7 @@ unwind_jump:;
                     // (unum >> 8) & 0xff == n_keyword
                     sp -= (unum & 0xff) + ((unum >> 7) & 0x1fe) + 1;
                     #if MICROPY_STACKLESS
-                    if (mp_obj_get_type(*sp) == &mp_type_fun_bc) {
+                    if (vm_is_stackless_callable(*sp)) {
                         code_state->ip = ip;
                         code_state->sp = sp;
                         code_state->exc_sp = MP_TAGPTR_MAKE(exc_sp, currently_in_except_block);
@@ -994,7 +1303,7 @@ unwind_jump:;
                         size_t n_kw = (unum >> 8) & 0xff;
                         int adjust = (sp[1] == MP_OBJ_NULL) ? 0 : 1;
 
-                        mp_code_state_t *new_state = mp_obj_fun_bc_prepare_codestate(*sp, n_args + adjust, n_kw, sp + 2 - adjust);
+                        mp_code_state_t *new_state = vm_prepare_codestate(*sp, n_args + adjust, n_kw, sp + 2 - adjust);
                         #if !MICROPY_ENABLE_PYSTACK
                         if (new_state == NULL) {
                             // Couldn't allocate codestate on heap: in the strict case raise
@@ -1025,21 +1334,15 @@ unwind_jump:;
                     // fun self arg0 arg1 ... kw0 val0 kw1 val1 ... seq dict <- TOS
                     sp -= (unum & 0xff) + ((unum >> 7) & 0x1fe) + 3;
                     #if MICROPY_STACKLESS
-                    if (mp_obj_get_type(*sp) == &mp_type_fun_bc) {
+                    if (vm_is_stackless_callable(*sp)) {
                         code_state->ip = ip;
                         code_state->sp = sp;
                         code_state->exc_sp = MP_TAGPTR_MAKE(exc_sp, currently_in_except_block);
 
-                        mp_call_args_t out_args;
-                        mp_call_prepare_args_n_kw_var(true, unum, sp, &out_args);
-
-                        mp_code_state_t *new_state = mp_obj_fun_bc_prepare_codestate(out_args.fun,
-                            out_args.n_args, out_args.n_kw, out_args.args);
-                        #if !MICROPY_ENABLE_PYSTACK
-                        // Freeing args at this point does not follow a LIFO order so only do it if
-                        // pystack is not enabled.  For pystack, they are freed when code_state is.
-                        mp_nonlocal_free(out_args.args, out_args.n_alloc * sizeof(mp_obj_t));
-                        #endif
+                        // The new code state is allocated before the args array so that,
+                        // on the pystack, the array can be freed in LIFO order once the
+                        // code state has copied it.
+                        mp_code_state_t *new_state = vm_alloc_codestate(*sp);
                         #if !MICROPY_ENABLE_PYSTACK
                         if (new_state == NULL) {
                             // Couldn't allocate codestate on heap: in the strict case raise
@@ -1050,6 +1353,12 @@ unwind_jump:;
                         } else
                         #endif
                         {
+                            mp_call_args_t out_args;
+                            mp_call_prepare_args_n_kw_var(true, unum, sp, &out_args);
+                            vm_init_codestate(new_state, out_args.fun,
+                                out_args.n_args, out_args.n_kw, out_args.args);
+                            mp_nonlocal_free(out_args.args, out_args.n_alloc * sizeof(mp_obj_t));
+
                             new_state->prev = code_state;
                             code_state = new_state;
                             nlr_pop();
@@ -1226,6 +1535,25 @@ yield:
                     DISPATCH();
                 }
 
+                #if MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS
+                ENTRY(MP_BC_BINARY_OP_SMALL_INT): {
+                    MARK_EXC_IP_SELECTIVE();
+                    mp_uint_t arg = *ip++;
+                    mp_binary_op_t op = mp_bc_small_int_binary_op[arg >> 5];
+                    mp_int_t rhs = (mp_int_t)(arg & 0x1f) - 16;
+                    mp_obj_t lhs = TOP();
+                    if (MP_OBJ_IS_SMALL_INT(lhs)) {
+                        mp_obj_t res = vm_small_int_binary_op(op, MP_OBJ_SMALL_INT_VALUE(lhs), rhs);
+                        if (res != MP_OBJ_NULL) {
+                            SET_TOP(res);
+                            DISPATCH();
+                        }
+                    }
+                    SET_TOP(mp_binary_op(op, lhs, MP_OBJ_NEW_SMALL_INT(rhs)));
+                    DISPATCH();
+                }
+                #endif
+
                 ENTRY(MP_BC_IMPORT_STAR):
                     MARK_EXC_IP_SELECTIVE();
                     mp_import_all(POP());
@@ -1253,6 +1581,16 @@ yield:
                     MARK_EXC_IP_SELECTIVE();
                     mp_obj_t rhs = POP();
                     mp_obj_t lhs = TOP();
+                    #if MICROPY_OPT_VM_SMALL_INT_FAST_PATH
+                    if (MP_OBJ_IS_SMALL_INT(lhs) && MP_OBJ_IS_SMALL_INT(rhs)) {
+                        mp_obj_t res = vm_small_int_binary_op(ip[-1] - MP_BC_BINARY_OP_MULTI,
+                            MP_OBJ_SMALL_INT_VALUE(lhs), MP_OBJ_SMALL_INT_VALUE(rhs));
+                        if (res != MP_OBJ_NULL) {
+                            SET_TOP(res);
+                            DISPATCH();
+                        }
+                    }
+                    #endif
                     SET_TOP(mp_binary_op(ip[-1] - MP_BC_BINARY_OP_MULTI, lhs, rhs));
                     DISPATCH();
                 }
@@ -1276,6 +1614,16 @@ yield:
                     } else if (ip[-1] < MP_BC_BINARY_OP_MULTI + MP_BINARY_OP_NUM_BYTECODE) {
                         mp_obj_t rhs = POP();
                         mp_obj_t lhs = TOP();
+                        #if MICROPY_OPT_VM_SMALL_INT_FAST_PATH
+                        if (MP_OBJ_IS_SMALL_INT(lhs) && MP_OBJ_IS_SMALL_INT(rhs)) {
+                            mp_obj_t res = vm_small_int_binary_op(ip[-1] - MP_BC_BINARY_OP_MULTI,
+                                MP_OBJ_SMALL_INT_VALUE(lhs), MP_OBJ_SMALL_INT_VALUE(rhs));
+                            if (res != MP_OBJ_NULL) {
+                                SET_TOP(res);
+                                DISPATCH();
+                            }
+                        }
+                        #endif
                         SET_TOP(mp_binary_op(ip[-1] - MP_BC_BINARY_OP_MULTI, lhs, rhs));
                         DISPATCH();
                     } else
@@ -1306,6 +1654,11 @@ pending_exception_check:
                             MP_STATE_VM(sched_state) = MP_SCHED_IDLE;
                         }
                         MICROPY_END_ATOMIC_SECTION(atomic_state);
+                        #if MICROPY_RELOAD_MODULES
+                        // Changed modules may be reloaded in place instead of restarting.
+                        if (obj != MP_OBJ_FROM_PTR(&MP_STATE_VM(mp_reload_exception))
+                            || !mp_reload_changed_modules())
+                        #endif
                         RAISE(obj);
                     }
                     mp_handle_pending_tail(atomic_state);
@@ -1316,6 +1669,11 @@ pending_exception_check:
                     MARK_EXC_IP_SELECTIVE();
                     mp_obj_t obj = MP_STATE_VM(mp_pending_exception);
                     MP_STATE_VM(mp_pending_exception) = MP_OBJ_NULL;
+                    #if MICROPY_RELOAD_MODULES
+                    // Changed modules may be reloaded in place instead of restarting.
+                    if (obj != MP_OBJ_FROM_PTR(&MP_STATE_VM(mp_reload_exception))
+                        || !mp_reload_changed_modules())
+                    #endif
                     RAISE(obj);
                 }
                 #endif
@@ -1381,50 +1739,8 @@ unwind_loop:
             // TODO: don't set traceback for exceptions re-raised by END_FINALLY.
             // But consider how to handle nested exceptions.
             if (nlr.ret_val != &mp_const_GeneratorExit_obj) {
-                const byte *ip = code_state->fun_bc->bytecode;
-                ip = mp_decode_uint_skip(ip); // skip n_state
-                ip = mp_decode_uint_skip(ip); // skip n_exc_stack
-                ip++; // skip scope_params
-                ip++; // skip n_pos_args
-                ip++; // skip n_kwonly_args
-                ip++; // skip n_def_pos_args
-                size_t bc = code_state->ip - ip;
-                size_t code_info_size = mp_decode_uint_value(ip);
-                ip = mp_decode_uint_skip(ip); // skip code_info_size
-                bc -= code_info_size;
-                #if MICROPY_PERSISTENT_CODE
-                qstr block_name = ip[0] | (ip[1] << 8);
-                qstr source_file = ip[2] | (ip[3] << 8);
-                ip += 4;
-                #else
-                qstr block_name = mp_decode_uint_value(ip);
-                ip = mp_decode_uint_skip(ip);
-                qstr source_file = mp_decode_uint_value(ip);
-                ip = mp_decode_uint_skip(ip);
-                #endif
-                size_t source_line = 1;
-                size_t c;
-                while ((c = *ip)) {
-                    size_t b, l;
-                    if ((c & 0x80) == 0) {
-                        // 0b0LLBBBBB encoding
-                        b = c & 0x1f;
-                        l = c >> 5;
-                        ip += 1;
-                    } else {
-                        // 0b1LLLBBBB 0bLLLLLLLL encoding (l's LSB in second byte)
-                        b = c & 0xf;
-                        l = ((c << 4) & 0x700) | ip[1];
-                        ip += 2;
-                    }
-                    if (bc >= b) {
-                        bc -= b;
-                        source_line += l;
-                    } else {
-                        // found source line corresponding to bytecode offset
-                        break;
-                    }
-                }
+                qstr block_name, source_file;
+                size_t source_line = mp_bytecode_get_source_line(code_state->fun_bc->bytecode, code_state->fun_bc->const_table, code_state->ip, &block_name, &source_file);
                 mp_obj_exception_add_traceback(MP_OBJ_FROM_PTR(nlr.ret_val), source_file, source_line, block_name);
             }
 
@@ -1465,6 +1781,9 @@ unwind_loop:
                 mp_nonlocal_free(code_state, sizeof(mp_code_state_t));
                 #endif
                 code_state = new_code_state;
+                #if MICROPY_TRACK_CURRENT_CODE_STATE
+                MP_STATE_THREAD(current_code_state) = code_state;
+                #endif
                 size_t n_state = mp_decode_uint_value(code_state->fun_bc->bytecode);
                 fastn = &code_state->state[n_state - 1];
                 exc_stack = (mp_exc_stack_t*)(code_state->state + n_state);
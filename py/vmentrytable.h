@@ -39,12 +39,19 @@ static const void *const entry_table[256] = {
     [MP_BC_LOAD_CONST_OBJ] = &&entry_MP_BC_LOAD_CONST_OBJ,
     [MP_BC_LOAD_NULL] = &&entry_MP_BC_LOAD_NULL,
     [MP_BC_LOAD_FAST_N] = &&entry_MP_BC_LOAD_FAST_N,
+    [MP_BC_LOAD_FAST_UNCHECKED] = &&entry_MP_BC_LOAD_FAST_UNCHECKED,
     [MP_BC_LOAD_DEREF] = &&entry_MP_BC_LOAD_DEREF,
     [MP_BC_LOAD_NAME] = &&entry_MP_BC_LOAD_NAME,
     [MP_BC_LOAD_GLOBAL] = &&entry_MP_BC_LOAD_GLOBAL,
     [MP_BC_LOAD_ATTR] = &&entry_MP_BC_LOAD_ATTR,
     [MP_BC_LOAD_METHOD] = &&entry_MP_BC_LOAD_METHOD,
     [MP_BC_LOAD_SUPER_METHOD] = &&entry_MP_BC_LOAD_SUPER_METHOD,
+    #if MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS
+    [MP_BC_LOAD_FAST_ATTR] = &&entry_MP_BC_LOAD_FAST_ATTR,
+    [MP_BC_LOAD_FAST_METHOD] = &&entry_MP_BC_LOAD_FAST_METHOD,
+    [MP_BC_LOAD_FAST_PAIR] = &&entry_MP_BC_LOAD_FAST_PAIR,
+    [MP_BC_BINARY_OP_SMALL_INT] = &&entry_MP_BC_BINARY_OP_SMALL_INT,
+    #endif
     [MP_BC_LOAD_BUILD_CLASS] = &&entry_MP_BC_LOAD_BUILD_CLASS,
     [MP_BC_LOAD_SUBSCR] = &&entry_MP_BC_LOAD_SUBSCR,
     [MP_BC_STORE_FAST_N] = &&entry_MP_BC_STORE_FAST_N,
@@ -36,6 +36,13 @@
 // returned value is always at least 1 greater than argument
 #define ROUND_ALLOC(a) (((a) & ((~0U) - 7)) + 8)
 
+// A growing vstr adds half its size again, so building a long string takes a
+// logarithmic number of reallocations, but never more than this many bytes
+// beyond what it needs, to keep the waste bounded on a small heap.
+#ifndef VSTR_MAX_GROWTH
+#define VSTR_MAX_GROWTH (1024)
+#endif
+
 // Init the vstr so it allocs exactly given number of bytes.  Set length to zero.
 void vstr_init(vstr_t *vstr, size_t alloc) {
     if (alloc < 1) {
@@ -113,7 +120,13 @@ STATIC void vstr_ensure_extra(vstr_t *vstr, size_t size) {
             // be there, so the only safe option is to raise an exception.
             mp_raise_msg(&mp_type_RuntimeError, NULL);
         }
-        size_t new_alloc = ROUND_ALLOC((vstr->len + size) + 16);
+        size_t growth = vstr->alloc / 2;
+        if (growth < 16) {
+            growth = 16;
+        } else if (growth > VSTR_MAX_GROWTH) {
+            growth = VSTR_MAX_GROWTH;
+        }
+        size_t new_alloc = ROUND_ALLOC((vstr->len + size) + growth);
         char *new_buf = m_renew(char, vstr->buf, vstr->alloc, new_alloc);
         vstr->alloc = new_alloc;
         vstr->buf = new_buf;
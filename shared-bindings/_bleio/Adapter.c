@@ -210,7 +210,7 @@ STATIC mp_obj_t bleio_adapter_stop_advertising(mp_obj_t self_in) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(bleio_adapter_stop_advertising_obj, bleio_adapter_stop_advertising);
 
-//|   .. method:: start_scan(prefixes=b"", \*, buffer_size=512, extended=False, timeout=None, interval=0.1, window=0.1, minimum_rssi=-80, active=True)
+//|   .. method:: start_scan(prefixes=b"", \*, buffer_size=512, extended=False, timeout=None, interval=0.1, window=0.1, minimum_rssi=-80, active=True, duplicate_window=0, update_rssi=False)
 //|
 //|     Starts a BLE scan and returns an iterator of results. Advertisements and scan responses are
 //|     filtered and returned separately.
@@ -218,6 +218,8 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(bleio_adapter_stop_advertising_obj, bleio_adapt
 //|     :param sequence prefixes: Sequence of byte string prefixes to filter advertising packets
 //|         with. A packet without an advertising structure that matches one of the prefixes is
 //|         ignored. Format is one byte for length (n) and n bytes of prefix and can be repeated.
+//|         A prefix starts with the advertising data type, so ``b"\x01\xff"`` matches any
+//|         manufacturer data and ``b"\x03\xff\x22\x08"`` matches data from manufacturer 0x0822.
 //|     :param int buffer_size: the maximum number of advertising bytes to buffer.
 //|     :param bool extended: When True, support extended advertising packets. Increasing buffer_size is recommended when this is set.
 //|     :param float timeout: the scan timeout in seconds. If None, will scan until `stop_scan` is called.
@@ -227,11 +229,16 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(bleio_adapter_stop_advertising_obj, bleio_adapt
 //|        window must be <= interval.
 //|     :param int minimum_rssi: the minimum rssi of entries to return.
 //|     :param bool active: retrieve scan responses for scannable advertisements.
+//|     :param float duplicate_window: ignore repeated advertisements or scan responses from a device
+//|        for this many seconds after one is returned. The most recently seen devices are
+//|        remembered. 0 returns every packet.
+//|     :param bool update_rssi: when a duplicate is ignored but the earlier entry hasn't been read
+//|        yet, update that entry's rssi.
 //|     :returns: an iterable of `_bleio.ScanEntry` objects
 //|     :rtype: iterable
 //|
 STATIC mp_obj_t bleio_adapter_start_scan(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
-    enum { ARG_prefixes, ARG_buffer_size, ARG_extended, ARG_timeout, ARG_interval, ARG_window, ARG_minimum_rssi, ARG_active };
+    enum { ARG_prefixes, ARG_buffer_size, ARG_extended, ARG_timeout, ARG_interval, ARG_window, ARG_minimum_rssi, ARG_active, ARG_duplicate_window, ARG_update_rssi };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_prefixes,  MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
         { MP_QSTR_buffer_size,  MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 512} },
@@ -241,6 +248,8 @@ STATIC mp_obj_t bleio_adapter_start_scan(size_t n_args, const mp_obj_t *pos_args
         { MP_QSTR_window,   MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
         { MP_QSTR_minimum_rssi,  MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = -80} },
         { MP_QSTR_active,  MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = true} },
+        { MP_QSTR_duplicate_window,  MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = MP_OBJ_NEW_SMALL_INT(0)} },
+        { MP_QSTR_update_rssi,  MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
     };
 
     bleio_adapter_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
@@ -270,6 +279,8 @@ STATIC mp_obj_t bleio_adapter_start_scan(size_t n_args, const mp_obj_t *pos_args
         mp_raise_ValueError(translate("window must be <= interval"));
     }
 
+    const mp_float_t duplicate_window = mp_obj_get_float(args[ARG_duplicate_window].u_obj);
+
     mp_buffer_info_t prefix_bufinfo;
     prefix_bufinfo.len = 0;
     if (args[ARG_prefixes].u_obj != MP_OBJ_NULL) {
@@ -279,7 +290,7 @@ STATIC mp_obj_t bleio_adapter_start_scan(size_t n_args, const mp_obj_t *pos_args
         }
     }
 
-    return common_hal_bleio_adapter_start_scan(self, prefix_bufinfo.buf, prefix_bufinfo.len, args[ARG_extended].u_bool, args[ARG_buffer_size].u_int, timeout, interval, window, args[ARG_minimum_rssi].u_int, args[ARG_active].u_bool);
+    return common_hal_bleio_adapter_start_scan(self, prefix_bufinfo.buf, prefix_bufinfo.len, args[ARG_extended].u_bool, args[ARG_buffer_size].u_int, timeout, interval, window, args[ARG_minimum_rssi].u_int, args[ARG_active].u_bool, duplicate_window, args[ARG_update_rssi].u_bool);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(bleio_adapter_start_scan_obj, 1, bleio_adapter_start_scan);
 
@@ -113,13 +113,6 @@ STATIC void check_for_deinit(bleio_characteristic_buffer_obj_t *self) {
 //|     :return: Data read
 //|     :rtype: bytes or None
 //|
-//|   .. method:: readinto(buf)
-//|
-//|     Read bytes into the ``buf``. Read at most ``len(buf)`` bytes.
-//|
-//|     :return: number of bytes read and stored into ``buf``
-//|     :rtype: int or None (on a non-blocking error)
-//|
 //|   .. method:: readline()
 //|
 //|     Read a line, ending in a newline character.
@@ -170,6 +163,25 @@ STATIC mp_uint_t bleio_characteristic_buffer_ioctl(mp_obj_t self_in, mp_uint_t r
     return ret;
 }
 
+//|   .. method:: readinto(buf)
+//|
+//|     Read the bytes that have already been received into ``buf``, at most ``len(buf)`` of them.
+//|     Unlike `read`, this doesn't wait for more to arrive.
+//|
+//|     :return: number of bytes read and stored into ``buf``, which may be 0
+//|     :rtype: int
+//|
+STATIC mp_obj_t bleio_characteristic_buffer_readinto(mp_obj_t self_in, mp_obj_t buf_in) {
+    bleio_characteristic_buffer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    raise_error_if_not_connected(self);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_WRITE);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_bleio_characteristic_buffer_readinto(self, bufinfo.buf, bufinfo.len));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(bleio_characteristic_buffer_readinto_obj, bleio_characteristic_buffer_readinto);
+
 //|   .. attribute:: in_waiting
 //|
 //|     The number of bytes in the input buffer, available to be read
@@ -217,7 +229,7 @@ STATIC const mp_rom_map_elem_t bleio_characteristic_buffer_locals_dict_table[] =
     // Standard stream methods.
     { MP_OBJ_NEW_QSTR(MP_QSTR_read),     MP_ROM_PTR(&mp_stream_read_obj) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_readline), MP_ROM_PTR(&mp_stream_unbuffered_readline_obj)},
-    { MP_OBJ_NEW_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&mp_stream_readinto_obj) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&bleio_characteristic_buffer_readinto_obj) },
     // CharacteristicBuffer is currently read-only.
     // { MP_OBJ_NEW_QSTR(MP_QSTR_write),    MP_ROM_PTR(&mp_stream_write_obj) },
 
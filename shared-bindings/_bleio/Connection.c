@@ -233,6 +233,120 @@ const mp_obj_property_t bleio_connection_connection_interval_obj = {
                (mp_obj_t)&mp_const_none_obj },
 };
 
+//|   .. attribute:: latency
+//|
+//|     The number of connection events the peripheral may skip when it has nothing to send. Higher
+//|     numbers save power on the peripheral but slow down data sent to it. 0 gives the lowest
+//|     latency, which suits input devices such as keyboards and game controllers. Must be 0-499.
+//|
+//|     As with `connection_interval`, the peer may reject a new value.
+//|
+STATIC mp_obj_t bleio_connection_get_latency(mp_obj_t self_in) {
+    bleio_connection_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    bleio_connection_ensure_connected(self);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_bleio_connection_get_latency(self->connection));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(bleio_connection_get_latency_obj, bleio_connection_get_latency);
+
+STATIC mp_obj_t bleio_connection_set_latency(mp_obj_t self_in, mp_obj_t latency_in) {
+    bleio_connection_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    mp_int_t latency = mp_obj_get_int(latency_in);
+    if (latency < 0 || latency > BLEIO_LATENCY_MAX) {
+        mp_raise_ValueError_varg(translate("%q must be %d-%d"), MP_QSTR_latency, 0, BLEIO_LATENCY_MAX);
+    }
+
+    bleio_connection_ensure_connected(self);
+    common_hal_bleio_connection_set_latency(self->connection, latency);
+
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(bleio_connection_set_latency_obj, bleio_connection_set_latency);
+
+const mp_obj_property_t bleio_connection_latency_obj = {
+    .base.type = &mp_type_property,
+    .proxy = { (mp_obj_t)&bleio_connection_get_latency_obj,
+               (mp_obj_t)&bleio_connection_set_latency_obj,
+               (mp_obj_t)&mp_const_none_obj },
+};
+
+//|   .. attribute:: phy
+//|
+//|     The radio data rate in megabits per second, 1 or 2. 2 is faster and uses less power per byte
+//|     but has shorter range.
+//|
+//|     Setting `phy` asks the peer to switch. It may refuse, and the change takes effect a few
+//|     connection events later.
+//|
+STATIC mp_obj_t bleio_connection_get_phy(mp_obj_t self_in) {
+    bleio_connection_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    bleio_connection_ensure_connected(self);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_bleio_connection_get_phy(self->connection));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(bleio_connection_get_phy_obj, bleio_connection_get_phy);
+
+STATIC mp_obj_t bleio_connection_set_phy(mp_obj_t self_in, mp_obj_t phy_in) {
+    bleio_connection_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    mp_int_t phy = mp_obj_get_int(phy_in);
+    if (phy < 1 || phy > 2) {
+        mp_raise_ValueError_varg(translate("%q must be %d-%d"), MP_QSTR_phy, 1, 2);
+    }
+
+    bleio_connection_ensure_connected(self);
+    common_hal_bleio_connection_set_phy(self->connection, phy);
+
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(bleio_connection_set_phy_obj, bleio_connection_set_phy);
+
+const mp_obj_property_t bleio_connection_phy_obj = {
+    .base.type = &mp_type_property,
+    .proxy = { (mp_obj_t)&bleio_connection_get_phy_obj,
+               (mp_obj_t)&bleio_connection_set_phy_obj,
+               (mp_obj_t)&mp_const_none_obj },
+};
+
+//|   .. attribute:: data_length
+//|
+//|     The longest link layer packet payload sent on this connection, in bytes. Longer packets
+//|     carry more data per connection event. Must be 27-251.
+//|
+//|     Setting `data_length` asks the peer for the new length. The peer may choose a shorter one.
+//|
+STATIC mp_obj_t bleio_connection_get_data_length(mp_obj_t self_in) {
+    bleio_connection_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    bleio_connection_ensure_connected(self);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_bleio_connection_get_data_length(self->connection));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(bleio_connection_get_data_length_obj, bleio_connection_get_data_length);
+
+STATIC mp_obj_t bleio_connection_set_data_length(mp_obj_t self_in, mp_obj_t data_length_in) {
+    bleio_connection_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    mp_int_t data_length = mp_obj_get_int(data_length_in);
+    if (data_length < BLEIO_DATA_LENGTH_MIN || data_length > BLEIO_DATA_LENGTH_MAX) {
+        mp_raise_ValueError_varg(translate("%q must be %d-%d"), MP_QSTR_data_length,
+                                 BLEIO_DATA_LENGTH_MIN, BLEIO_DATA_LENGTH_MAX);
+    }
+
+    bleio_connection_ensure_connected(self);
+    common_hal_bleio_connection_set_data_length(self->connection, data_length);
+
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(bleio_connection_set_data_length_obj, bleio_connection_set_data_length);
+
+const mp_obj_property_t bleio_connection_data_length_obj = {
+    .base.type = &mp_type_property,
+    .proxy = { (mp_obj_t)&bleio_connection_get_data_length_obj,
+               (mp_obj_t)&bleio_connection_set_data_length_obj,
+               (mp_obj_t)&mp_const_none_obj },
+};
+
 STATIC const mp_rom_map_elem_t bleio_connection_locals_dict_table[] = {
     // Methods
     { MP_ROM_QSTR(MP_QSTR_pair),                     MP_ROM_PTR(&bleio_connection_pair_obj) },
@@ -243,6 +357,9 @@ STATIC const mp_rom_map_elem_t bleio_connection_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_connected),           MP_ROM_PTR(&bleio_connection_connected_obj) },
     { MP_ROM_QSTR(MP_QSTR_paired),              MP_ROM_PTR(&bleio_connection_paired_obj) },
     { MP_ROM_QSTR(MP_QSTR_connection_interval), MP_ROM_PTR(&bleio_connection_connection_interval_obj) },
+    { MP_ROM_QSTR(MP_QSTR_latency),             MP_ROM_PTR(&bleio_connection_latency_obj) },
+    { MP_ROM_QSTR(MP_QSTR_phy),                 MP_ROM_PTR(&bleio_connection_phy_obj) },
+    { MP_ROM_QSTR(MP_QSTR_data_length),         MP_ROM_PTR(&bleio_connection_data_length_obj) },
 
 };
 
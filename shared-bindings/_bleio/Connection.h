@@ -32,6 +32,12 @@
 #include "common-hal/_bleio/Connection.h"
 #include "common-hal/_bleio/Service.h"
 
+// Limits from the Bluetooth spec: link layer payload lengths and the number of connection
+// events a peripheral may skip.
+#define BLEIO_DATA_LENGTH_MIN (27)
+#define BLEIO_DATA_LENGTH_MAX (251)
+#define BLEIO_LATENCY_MAX (499)
+
 extern const mp_obj_type_t bleio_connection_type;
 
 extern void common_hal_bleio_connection_pair(bleio_connection_internal_t *self, bool bond);
@@ -42,6 +48,12 @@ extern mp_obj_tuple_t *common_hal_bleio_connection_discover_remote_services(blei
 
 mp_float_t common_hal_bleio_connection_get_connection_interval(bleio_connection_internal_t *self);
 void common_hal_bleio_connection_set_connection_interval(bleio_connection_internal_t *self, mp_float_t new_interval);
+uint16_t common_hal_bleio_connection_get_latency(bleio_connection_internal_t *self);
+void common_hal_bleio_connection_set_latency(bleio_connection_internal_t *self, uint16_t latency);
+uint8_t common_hal_bleio_connection_get_phy(bleio_connection_internal_t *self);
+void common_hal_bleio_connection_set_phy(bleio_connection_internal_t *self, uint8_t mbps);
+uint16_t common_hal_bleio_connection_get_data_length(bleio_connection_internal_t *self);
+void common_hal_bleio_connection_set_data_length(bleio_connection_internal_t *self, uint16_t data_length);
 
 void bleio_connection_ensure_connected(bleio_connection_obj_t *self);
 
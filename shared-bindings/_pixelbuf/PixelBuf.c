@@ -163,6 +163,7 @@ STATIC mp_obj_t pixelbuf_pixelbuf_make_new(const mp_obj_type_t *type, size_t n_a
         else if (self->brightness > 1)
             self->brightness = 1;
     }
+    self->brightness_scale = pixelbuf_brightness_scale(self->brightness);
 
     if (self->byteorder.is_dotstar) {
         // Initialize the buffer with the dotstar start bytes.
@@ -227,6 +228,7 @@ STATIC mp_obj_t pixelbuf_pixelbuf_obj_set_brightness(mp_obj_t self_in, mp_obj_t
         self->brightness = 1;
     else if (self->brightness < 0)
         self->brightness = 0;
+    self->brightness_scale = pixelbuf_brightness_scale(self->brightness);
     if (self->two_buffers)
         pixelbuf_recalculate_brightness(self);
     if (self->auto_write)
@@ -249,7 +251,7 @@ void pixelbuf_recalculate_brightness(pixelbuf_pixelbuf_obj_t *self) {
     for (uint i = 0; i < self->bytes; i++) {
         // Don't adjust per-pixel luminance bytes in dotstar mode
         if (!self->byteorder.is_dotstar || (i % 4 != 0))
-            buf[i] = rawbuf[i] * self->brightness;
+            buf[i] = PIXELBUF_SCALE(rawbuf[i], self->brightness_scale);
     }
 }
 
@@ -340,6 +342,76 @@ STATIC mp_obj_t pixelbuf_pixelbuf_show(mp_obj_t self_in) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(pixelbuf_pixelbuf_show_obj, pixelbuf_pixelbuf_show);
 
+// Clamps a pixel index like a slice bound.
+STATIC size_t pixel_index(pixelbuf_pixelbuf_obj_t *self, mp_obj_t index_in) {
+    mp_int_t index = mp_obj_get_int(index_in);
+    if (index < 0) {
+        index += self->pixels;
+        if (index < 0) {
+            index = 0;
+        }
+    } else if ((size_t) index > self->pixels) {
+        index = self->pixels;
+    }
+    return index;
+}
+
+//|   .. method:: fill(color)
+//|
+//|     Sets every pixel to ``color``. The color is only converted once so this
+//|     is much faster than setting each pixel in turn.
+//|
+STATIC mp_obj_t pixelbuf_pixelbuf_fill(mp_obj_t self_in, mp_obj_t color) {
+    pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
+    pixelbuf_fill_range(self, 0, self->pixels, color);
+    if (self->auto_write)
+        pixelbuf_call_show(self_in);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(pixelbuf_pixelbuf_fill_obj, pixelbuf_pixelbuf_fill);
+
+//|   .. method:: fill_range(start, stop, color)
+//|
+//|     Sets the pixels from ``start`` up to but not including ``stop`` to
+//|     ``color``. Negative indices count from the end.
+//|
+STATIC mp_obj_t pixelbuf_pixelbuf_fill_range(size_t n_args, const mp_obj_t *args) {
+    pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(args[0]);
+    pixelbuf_fill_range(self, pixel_index(self, args[1]), pixel_index(self, args[2]), args[3]);
+    if (self->auto_write)
+        pixelbuf_call_show(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pixelbuf_pixelbuf_fill_range_obj, 4, 4, pixelbuf_pixelbuf_fill_range);
+
+//|   .. method:: gradient(start, stop, start_color, stop_color)
+//|
+//|     Fades the pixels from ``start`` up to but not including ``stop`` from
+//|     ``start_color`` to ``stop_color``. Negative indices count from the end.
+//|
+STATIC mp_obj_t pixelbuf_pixelbuf_gradient(size_t n_args, const mp_obj_t *args) {
+    pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(args[0]);
+    pixelbuf_gradient(self, pixel_index(self, args[1]), pixel_index(self, args[2]), args[3], args[4]);
+    if (self->auto_write)
+        pixelbuf_call_show(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pixelbuf_pixelbuf_gradient_obj, 5, 5, pixelbuf_pixelbuf_gradient);
+
+//|   .. method:: rotate(count)
+//|
+//|     Moves every pixel ``count`` places towards the end. Pixels that go off
+//|     the end come back at the start. A negative ``count`` moves them towards
+//|     the start.
+//|
+STATIC mp_obj_t pixelbuf_pixelbuf_rotate(mp_obj_t self_in, mp_obj_t count) {
+    pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
+    pixelbuf_rotate(self, mp_obj_get_int(count));
+    if (self->auto_write)
+        pixelbuf_call_show(self_in);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(pixelbuf_pixelbuf_rotate_obj, pixelbuf_pixelbuf_rotate);
 
 //|   .. method:: __getitem__(index)
 //|
@@ -408,7 +480,7 @@ STATIC mp_obj_t pixelbuf_pixelbuf_subscr(mp_obj_t self_in, mp_obj_t index_in, mp
                 if (MP_OBJ_IS_TYPE(value, &mp_type_list) || MP_OBJ_IS_TYPE(value, &mp_type_tuple) || MP_OBJ_IS_INT(value)) {
                     pixelbuf_set_pixel(self->buf + (target_i * self->pixel_step),
                         self->two_buffers ? self->rawbuf + (i * self->pixel_step) : NULL,
-                        self->brightness, item, &self->byteorder, self->byteorder.is_dotstar);
+                        self->brightness_scale, item, &self->byteorder, self->byteorder.is_dotstar);
                 }
             }
             if (self->auto_write)
@@ -430,7 +502,7 @@ STATIC mp_obj_t pixelbuf_pixelbuf_subscr(mp_obj_t self_in, mp_obj_t index_in, mp
             return pixelbuf_get_pixel(pixelstart, &self->byteorder, self->byteorder.is_dotstar);
         } else { // Store
             pixelbuf_set_pixel(self->buf + offset, self->two_buffers ? self->rawbuf + offset : NULL,
-                self->brightness, value, &self->byteorder, self->byteorder.is_dotstar);
+                self->brightness_scale, value, &self->byteorder, self->byteorder.is_dotstar);
             if (self->auto_write)
                 pixelbuf_call_show(self_in);
             return mp_const_none;
@@ -444,6 +516,10 @@ STATIC const mp_rom_map_elem_t pixelbuf_pixelbuf_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_brightness), MP_ROM_PTR(&pixelbuf_pixelbuf_brightness_obj)},
     { MP_ROM_QSTR(MP_QSTR_buf), MP_ROM_PTR(&pixelbuf_pixelbuf_buf_obj)},
     { MP_ROM_QSTR(MP_QSTR_byteorder), MP_ROM_PTR(&pixelbuf_pixelbuf_byteorder_str)},
+    { MP_ROM_QSTR(MP_QSTR_fill), MP_ROM_PTR(&pixelbuf_pixelbuf_fill_obj)},
+    { MP_ROM_QSTR(MP_QSTR_fill_range), MP_ROM_PTR(&pixelbuf_pixelbuf_fill_range_obj)},
+    { MP_ROM_QSTR(MP_QSTR_gradient), MP_ROM_PTR(&pixelbuf_pixelbuf_gradient_obj)},
+    { MP_ROM_QSTR(MP_QSTR_rotate), MP_ROM_PTR(&pixelbuf_pixelbuf_rotate_obj)},
     { MP_ROM_QSTR(MP_QSTR_show), MP_ROM_PTR(&pixelbuf_pixelbuf_show_obj)},
 };
 
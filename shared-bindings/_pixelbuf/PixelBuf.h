@@ -40,6 +40,8 @@ typedef struct {
     mp_obj_t bytearray;
     mp_obj_t rawbytearray;
     mp_float_t brightness;
+    // brightness as a fixed point scale, see PIXELBUF_SCALE.
+    uint16_t brightness_scale;
     bool two_buffers;
     size_t offset;
     uint8_t *rawbuf;
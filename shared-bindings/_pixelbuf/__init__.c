@@ -94,10 +94,7 @@ STATIC mp_obj_t pixelbuf_fill(mp_obj_t pixelbuf_in, mp_obj_t value) {
         mp_raise_TypeError(translate("Expected a PixelBuf instance"));
     pixelbuf_pixelbuf_obj_t *pixelbuf = MP_OBJ_TO_PTR(obj);
 
-    for (size_t offset = 0; offset < pixelbuf->bytes; offset+= pixelbuf->pixel_step) {
-        pixelbuf_set_pixel(pixelbuf->buf + offset, pixelbuf->two_buffers ? (pixelbuf->rawbuf + offset) : NULL,
-                           pixelbuf->brightness, value, &pixelbuf->byteorder, pixelbuf->byteorder.is_dotstar);
-    }
+    pixelbuf_fill_range(pixelbuf, 0, pixelbuf->pixels, value);
     if (pixelbuf->auto_write)
         pixelbuf_call_show(pixelbuf_in);
     return mp_const_none;
@@ -60,7 +60,7 @@
 //|     :param int x1: Right edge of the fragment.
 //|     :param int y1: Bottom edge of the fragment.
 //|     :param list layers: A list of the :py:class:`~_stage.Layer` objects.
-//|     :param bytearray buffer: A buffer to use for rendering.
+//|     :param bytearray buffer: A buffer to use for rendering. Half of it is rendered while the other half is sent.
 //|     :param ~displayio.Display display: The display to use.
 //|     :param int scale: How many times should the image be scaled up.
 //|
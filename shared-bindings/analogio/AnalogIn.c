@@ -27,6 +27,7 @@
 #include <string.h>
 
 #include "lib/utils/context_manager_helpers.h"
+#include "lib/utils/interrupt_char.h"
 #include "py/binary.h"
 #include "py/mphal.h"
 #include "py/nlr.h"
@@ -79,9 +80,27 @@ STATIC mp_obj_t analogio_analogin_make_new(const mp_obj_type_t *type,
 //|
 //|      Turn off the AnalogIn and release the pin for other use.
 //|
+// Keeps the buffer being sampled into from being collected until sampling
+// stops.
+STATIC void pin_reading_buffer(analogio_analogin_obj_t *self, mp_obj_t buffer) {
+    if (MP_STATE_VM(analogio_analogin_readings) == MP_OBJ_NULL) {
+        MP_STATE_VM(analogio_analogin_readings) = mp_obj_new_dict(1);
+    }
+    mp_obj_dict_store(MP_STATE_VM(analogio_analogin_readings), MP_OBJ_FROM_PTR(self), buffer);
+}
+
+STATIC void unpin_reading_buffer(analogio_analogin_obj_t *self) {
+    if (MP_STATE_VM(analogio_analogin_readings) == MP_OBJ_NULL) {
+        return;
+    }
+    mp_map_lookup(mp_obj_dict_get_map(MP_STATE_VM(analogio_analogin_readings)), MP_OBJ_FROM_PTR(self),
+                  MP_MAP_LOOKUP_REMOVE_IF_FOUND);
+}
+
 STATIC mp_obj_t analogio_analogin_deinit(mp_obj_t self_in) {
    analogio_analogin_obj_t *self = MP_OBJ_TO_PTR(self_in);
    common_hal_analogio_analogin_deinit(self);
+   unpin_reading_buffer(self);
    return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_1(analogio_analogin_deinit_obj, analogio_analogin_deinit);
@@ -105,6 +124,7 @@ STATIC void check_for_deinit(analogio_analogin_obj_t *self) {
 STATIC mp_obj_t analogio_analogin___exit__(size_t n_args, const mp_obj_t *args) {
     (void)n_args;
     common_hal_analogio_analogin_deinit(args[0]);
+    unpin_reading_buffer(args[0]);
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(analogio_analogin___exit___obj, 4, 4, analogio_analogin___exit__);
@@ -114,11 +134,12 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(analogio_analogin___exit___obj, 4, 4,
 //|     The value on the analog pin between 0 and 65535 inclusive (16-bit). (read-only)
 //|
 //|     Even if the underlying analog to digital converter (ADC) is lower
-//|     resolution, the value is 16-bit.
+//|     resolution, the value is 16-bit. Reading it stops any background reading.
 //|
 STATIC mp_obj_t analogio_analogin_obj_get_value(mp_obj_t self_in) {
     analogio_analogin_obj_t *self = MP_OBJ_TO_PTR(self_in);
     check_for_deinit(self);
+    unpin_reading_buffer(self);
     return MP_OBJ_NEW_SMALL_INT(common_hal_analogio_analogin_get_value(self));
 }
 MP_DEFINE_CONST_FUN_OBJ_1(analogio_analogin_get_value_obj, analogio_analogin_obj_get_value);
@@ -156,12 +177,127 @@ const mp_obj_property_t analogio_analogin_reference_voltage_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+// Shared arg checking for read_into and start_reading.
+STATIC void start_reading(analogio_analogin_obj_t *self, mp_obj_t buffer, mp_int_t rate, bool loop) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer, &bufinfo, MP_BUFFER_WRITE);
+    if (bufinfo.typecode != 'H') {
+        mp_raise_ValueError(translate("buffer must be an array of type 'H'"));
+    }
+    if (rate <= 0) {
+        mp_raise_ValueError(translate("Sample rate must be positive"));
+    }
+    size_t len = bufinfo.len / sizeof(uint16_t);
+    if (len == 0) {
+        mp_raise_ValueError(translate("Buffer must be at least length 1"));
+    }
+    common_hal_analogio_analogin_stop_reading(self);
+    pin_reading_buffer(self, buffer);
+    if (!common_hal_analogio_analogin_start_reading(self, bufinfo.buf, len, rate, loop)) {
+        unpin_reading_buffer(self);
+        mp_raise_NotImplementedError(translate("Timed sampling not supported"));
+    }
+}
+
+//|   .. method:: read_into(buffer, rate)
+//|
+//|     Fill ``buffer`` with values read ``rate`` times a second. The values are
+//|     timed by hardware so they're evenly spaced however busy the code is.
+//|     Each value is scaled like `value`.
+//|
+//|     :param array buffer: An ``array.array`` of type ``'H'`` to fill
+//|     :param int rate: Values to read per second
+//|
+STATIC mp_obj_t analogio_analogin_read_into(mp_obj_t self_in, mp_obj_t buffer, mp_obj_t rate) {
+    analogio_analogin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    start_reading(self, buffer, mp_obj_get_int(rate), false);
+    while (common_hal_analogio_analogin_get_reading(self)) {
+        RUN_BACKGROUND_TASKS;
+        // Allow user to break out of a long read with a KeyboardInterrupt.
+        if (mp_hal_is_interrupted()) {
+            common_hal_analogio_analogin_stop_reading(self);
+            break;
+        }
+    }
+    unpin_reading_buffer(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_3(analogio_analogin_read_into_obj, analogio_analogin_read_into);
+
+//|   .. method:: start_reading(buffer, rate, *, loop=False)
+//|
+//|     Start filling ``buffer`` like `read_into` but return straight away while
+//|     the values are read in the background. `reading` is ``False`` once the
+//|     buffer is full. With ``loop``, reading carries on from the start of the
+//|     buffer until `stop_reading` is called.
+//|
+//|     :param array buffer: An ``array.array`` of type ``'H'`` to fill
+//|     :param int rate: Values to read per second
+//|     :param bool loop: Keep reading into the buffer over and over
+//|
+STATIC mp_obj_t analogio_analogin_start_reading(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_buffer, ARG_rate, ARG_loop };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_buffer, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_rate,   MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_loop,   MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+    };
+    analogio_analogin_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    check_for_deinit(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    start_reading(self, args[ARG_buffer].u_obj, args[ARG_rate].u_int, args[ARG_loop].u_bool);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(analogio_analogin_start_reading_obj, 1, analogio_analogin_start_reading);
+
+//|   .. method:: stop_reading()
+//|
+//|     Stop reading values in the background.
+//|
+STATIC mp_obj_t analogio_analogin_stop_reading(mp_obj_t self_in) {
+    analogio_analogin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_analogio_analogin_stop_reading(self);
+    unpin_reading_buffer(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(analogio_analogin_stop_reading_obj, analogio_analogin_stop_reading);
+
+//|   .. attribute:: reading
+//|
+//|     True while values are being read in the background. (read-only)
+//|
+STATIC mp_obj_t analogio_analogin_obj_get_reading(mp_obj_t self_in) {
+    analogio_analogin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    if (common_hal_analogio_analogin_get_reading(self)) {
+        return mp_const_true;
+    }
+    unpin_reading_buffer(self);
+    return mp_const_false;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(analogio_analogin_get_reading_obj, analogio_analogin_obj_get_reading);
+
+const mp_obj_property_t analogio_analogin_reading_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&analogio_analogin_get_reading_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 STATIC const mp_rom_map_elem_t analogio_analogin_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_deinit),             MP_ROM_PTR(&analogio_analogin_deinit_obj) },
     { MP_ROM_QSTR(MP_QSTR___enter__),          MP_ROM_PTR(&default___enter___obj) },
     { MP_ROM_QSTR(MP_QSTR___exit__),           MP_ROM_PTR(&analogio_analogin___exit___obj) },
     { MP_ROM_QSTR(MP_QSTR_value),              MP_ROM_PTR(&analogio_analogin_value_obj)},
     { MP_ROM_QSTR(MP_QSTR_reference_voltage),  MP_ROM_PTR(&analogio_analogin_reference_voltage_obj)},
+    { MP_ROM_QSTR(MP_QSTR_read_into),          MP_ROM_PTR(&analogio_analogin_read_into_obj)},
+    { MP_ROM_QSTR(MP_QSTR_start_reading),      MP_ROM_PTR(&analogio_analogin_start_reading_obj)},
+    { MP_ROM_QSTR(MP_QSTR_stop_reading),       MP_ROM_PTR(&analogio_analogin_stop_reading_obj)},
+    { MP_ROM_QSTR(MP_QSTR_reading),            MP_ROM_PTR(&analogio_analogin_reading_obj)},
 };
 
 STATIC MP_DEFINE_CONST_DICT(analogio_analogin_locals_dict, analogio_analogin_locals_dict_table);
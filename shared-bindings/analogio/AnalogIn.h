@@ -38,4 +38,11 @@ bool common_hal_analogio_analogin_deinited(analogio_analogin_obj_t* self);
 uint16_t common_hal_analogio_analogin_get_value(analogio_analogin_obj_t* self);
 float common_hal_analogio_analogin_get_reference_voltage(analogio_analogin_obj_t* self);
 
+// Starts filling buffer with len values, taken rate times a second, in the background. With loop,
+// starts again at the beginning of the buffer once it's full. Returns false if the port can't
+// sample on a timer.
+bool common_hal_analogio_analogin_start_reading(analogio_analogin_obj_t* self, uint16_t* buffer, size_t len, uint32_t rate, bool loop);
+bool common_hal_analogio_analogin_get_reading(analogio_analogin_obj_t* self);
+void common_hal_analogio_analogin_stop_reading(analogio_analogin_obj_t* self);
+
 #endif  // __MICROPY_INCLUDED_SHARED_BINDINGS_ANALOGIO_ANALOGIN_H__
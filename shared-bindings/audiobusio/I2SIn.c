@@ -0,0 +1,276 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/binary.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/microcontroller/Pin.h"
+#include "shared-bindings/audiobusio/I2SIn.h"
+#include "shared-bindings/util.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: audiobusio
+//|
+//| :class:`I2SIn` -- Record an input I2S audio stream
+//| ========================================================
+//|
+//| I2S is used to receive an audio stream from an I2S microphone or codec. The samples are
+//| recorded in the background without being processed.
+//|
+//| .. class:: I2SIn(bit_clock, word_select, data, *, sample_rate=16000, bit_depth=16, left_justified=False)
+//|
+//|   Create a I2SIn object associated with the given pins. The bit clock and word select are
+//|   driven by the microcontroller.
+//|
+//|   :param ~microcontroller.Pin bit_clock: The bit clock (or serial clock) pin
+//|   :param ~microcontroller.Pin word_select: The word select (or left/right clock) pin
+//|   :param ~microcontroller.Pin data: The data input pin
+//|   :param int sample_rate: Target sample_rate of the recording. Check `sample_rate` for actual value.
+//|   :param int bit_depth: Bits per sample. Must be 16, 24 or 32. 24 bit samples are received in
+//|     32 bit slots and read as 32 bit values with the sample in the top 24 bits.
+//|   :param bool left_justified: True when data bits are aligned with the word select clock. False
+//|     when they are shifted by one to match classic I2S protocol.
+//|
+//|   Samples are always recorded in left, right pairs.
+//|
+//|   Record from an I2S microphone while doing other work::
+//|
+//|     import array
+//|     import audiobusio
+//|     import board
+//|
+//|     b = array.array("i", [0] * 256)
+//|     mic = audiobusio.I2SIn(board.D1, board.D0, board.D9, bit_depth=24)
+//|     mic.start()
+//|     while True:
+//|         count = mic.readinto(b)
+//|         # Process the first count samples of b, then update the display.
+//|
+STATIC mp_obj_t audiobusio_i2sin_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_bit_clock, ARG_word_select, ARG_data, ARG_sample_rate, ARG_bit_depth, ARG_left_justified };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_bit_clock,      MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_word_select,    MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_data,           MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_sample_rate,    MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 16000} },
+        { MP_QSTR_bit_depth,      MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 16} },
+        { MP_QSTR_left_justified, MP_ARG_KW_ONLY | MP_ARG_BOOL,{.u_bool = false} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t bit_clock_obj = args[ARG_bit_clock].u_obj;
+    assert_pin(bit_clock_obj, false);
+    const mcu_pin_obj_t *bit_clock = MP_OBJ_TO_PTR(bit_clock_obj);
+    assert_pin_free(bit_clock);
+
+    mp_obj_t word_select_obj = args[ARG_word_select].u_obj;
+    assert_pin(word_select_obj, false);
+    const mcu_pin_obj_t *word_select = MP_OBJ_TO_PTR(word_select_obj);
+    assert_pin_free(word_select);
+
+    mp_obj_t data_obj = args[ARG_data].u_obj;
+    assert_pin(data_obj, false);
+    const mcu_pin_obj_t *data = MP_OBJ_TO_PTR(data_obj);
+    assert_pin_free(data);
+
+    mp_int_t sample_rate = args[ARG_sample_rate].u_int;
+    if (sample_rate <= 0) {
+        mp_raise_ValueError(translate("Sample rate must be positive"));
+    }
+    mp_int_t bit_depth = args[ARG_bit_depth].u_int;
+    if (bit_depth != 16 && bit_depth != 24 && bit_depth != 32) {
+        mp_raise_ValueError(translate("Invalid number of bits"));
+    }
+
+    audiobusio_i2sin_obj_t *self = m_new_obj(audiobusio_i2sin_obj_t);
+    self->base.type = &audiobusio_i2sin_type;
+    common_hal_audiobusio_i2sin_construct(self, bit_clock, word_select, data, sample_rate,
+                                          bit_depth, args[ARG_left_justified].u_bool);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Deinitialises the I2SIn and releases any hardware resources for reuse.
+//|
+STATIC mp_obj_t audiobusio_i2sin_deinit(mp_obj_t self_in) {
+    audiobusio_i2sin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_audiobusio_i2sin_deinit(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(audiobusio_i2sin_deinit_obj, audiobusio_i2sin_deinit);
+
+STATIC void check_for_deinit(audiobusio_i2sin_obj_t *self) {
+    if (common_hal_audiobusio_i2sin_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes the hardware when exiting a context.
+//|
+STATIC mp_obj_t audiobusio_i2sin_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_audiobusio_i2sin_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(audiobusio_i2sin___exit___obj, 4, 4, audiobusio_i2sin_obj___exit__);
+
+//|   .. method:: start(*, buffer_length=4096)
+//|
+//|     Starts recording in the background until `stop` is called. Recorded samples are kept
+//|     until they are read by `readinto`. When ``buffer_length`` samples are waiting the oldest
+//|     are dropped to make room.
+//|
+//|     :param int buffer_length: Number of recorded samples to hold
+//|
+STATIC mp_obj_t audiobusio_i2sin_obj_start(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_buffer_length };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_buffer_length, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 4096} },
+    };
+    audiobusio_i2sin_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    check_for_deinit(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_int_t buffer_length = args[ARG_buffer_length].u_int;
+    if (buffer_length < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_buffer_length);
+    }
+    common_hal_audiobusio_i2sin_start(self, buffer_length);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(audiobusio_i2sin_start_obj, 1, audiobusio_i2sin_obj_start);
+
+//|   .. method:: stop()
+//|
+//|     Stops recording in the background. Samples already recorded can still be read.
+//|
+STATIC mp_obj_t audiobusio_i2sin_obj_stop(mp_obj_t self_in) {
+    audiobusio_i2sin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_audiobusio_i2sin_stop(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiobusio_i2sin_stop_obj, audiobusio_i2sin_obj_stop);
+
+//|   .. method:: readinto(destination)
+//|
+//|     Moves samples recorded in the background into destination without waiting for more.
+//|     destination must be an array of type 'h' or 'H' for 16 bit samples and of a 32 bit type
+//|     such as 'i' or 'l' otherwise.
+//|
+//|     :return: The number of samples read. It is 0 when none are waiting.
+//|
+STATIC mp_obj_t audiobusio_i2sin_obj_readinto(mp_obj_t self_obj, mp_obj_t destination) {
+    audiobusio_i2sin_obj_t *self = MP_OBJ_TO_PTR(self_obj);
+    check_for_deinit(self);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(destination, &bufinfo, MP_BUFFER_WRITE);
+    size_t item_size = mp_binary_get_size('@', bufinfo.typecode, NULL);
+    if (common_hal_audiobusio_i2sin_get_bit_depth(self) == 16) {
+        if (bufinfo.typecode != 'h' && bufinfo.typecode != 'H') {
+            mp_raise_ValueError(translate("destination buffer must be an array of type 'H' for bit_depth = 16"));
+        }
+    } else if (item_size != 4 || bufinfo.typecode == 'f') {
+        mp_raise_ValueError(translate("bad typecode"));
+    }
+    uint32_t length = common_hal_audiobusio_i2sin_readinto(self, bufinfo.buf, bufinfo.len);
+    return MP_OBJ_NEW_SMALL_INT(length / item_size);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audiobusio_i2sin_readinto_obj, audiobusio_i2sin_obj_readinto);
+
+//|   .. attribute:: recording
+//|
+//|     True while recording in the background. (read-only)
+//|
+STATIC mp_obj_t audiobusio_i2sin_obj_get_recording(mp_obj_t self_in) {
+    audiobusio_i2sin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_bool(common_hal_audiobusio_i2sin_get_recording(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiobusio_i2sin_get_recording_obj, audiobusio_i2sin_obj_get_recording);
+
+const mp_obj_property_t audiobusio_i2sin_recording_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiobusio_i2sin_get_recording_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: sample_rate
+//|
+//|     The actual sample_rate of the recording. This may not match the constructed
+//|     sample rate due to internal clock limitations.
+//|
+STATIC mp_obj_t audiobusio_i2sin_obj_get_sample_rate(mp_obj_t self_in) {
+    audiobusio_i2sin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_audiobusio_i2sin_get_sample_rate(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiobusio_i2sin_get_sample_rate_obj, audiobusio_i2sin_obj_get_sample_rate);
+
+const mp_obj_property_t audiobusio_i2sin_sample_rate_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiobusio_i2sin_get_sample_rate_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t audiobusio_i2sin_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&audiobusio_i2sin_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&audiobusio_i2sin___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_start), MP_ROM_PTR(&audiobusio_i2sin_start_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop), MP_ROM_PTR(&audiobusio_i2sin_stop_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&audiobusio_i2sin_readinto_obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_recording), MP_ROM_PTR(&audiobusio_i2sin_recording_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sample_rate), MP_ROM_PTR(&audiobusio_i2sin_sample_rate_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(audiobusio_i2sin_locals_dict, audiobusio_i2sin_locals_dict_table);
+
+const mp_obj_type_t audiobusio_i2sin_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_I2SIn,
+    .make_new = audiobusio_i2sin_make_new,
+    .locals_dict = (mp_obj_dict_t*)&audiobusio_i2sin_locals_dict,
+};
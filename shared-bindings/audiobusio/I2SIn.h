@@ -0,0 +1,52 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOBUSIO_I2SIN_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOBUSIO_I2SIN_H
+
+#include "common-hal/audiobusio/I2SIn.h"
+#include "common-hal/microcontroller/Pin.h"
+
+extern const mp_obj_type_t audiobusio_i2sin_type;
+
+// bit_depth is 16, 24 or 32. Samples are always recorded in left, right pairs.
+void common_hal_audiobusio_i2sin_construct(audiobusio_i2sin_obj_t* self,
+    const mcu_pin_obj_t* bit_clock, const mcu_pin_obj_t* word_select, const mcu_pin_obj_t* data,
+    uint32_t sample_rate, uint8_t bit_depth, bool left_justified);
+void common_hal_audiobusio_i2sin_deinit(audiobusio_i2sin_obj_t* self);
+bool common_hal_audiobusio_i2sin_deinited(audiobusio_i2sin_obj_t* self);
+// Records into a ring of at least buffer_length samples in the background until stopped.
+void common_hal_audiobusio_i2sin_start(audiobusio_i2sin_obj_t* self, uint32_t buffer_length);
+void common_hal_audiobusio_i2sin_stop(audiobusio_i2sin_obj_t* self);
+bool common_hal_audiobusio_i2sin_get_recording(audiobusio_i2sin_obj_t* self);
+// Moves up to length bytes of recorded samples into buffer and returns how many bytes. Only whole
+// samples are moved.
+uint32_t common_hal_audiobusio_i2sin_readinto(audiobusio_i2sin_obj_t* self,
+    uint8_t* buffer, uint32_t length);
+uint8_t common_hal_audiobusio_i2sin_get_bit_depth(audiobusio_i2sin_obj_t* self);
+uint32_t common_hal_audiobusio_i2sin_get_sample_rate(audiobusio_i2sin_obj_t* self);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOBUSIO_I2SIN_H
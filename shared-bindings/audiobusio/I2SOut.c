@@ -30,6 +30,7 @@
 #include "py/binary.h"
 #include "py/objproperty.h"
 #include "py/runtime.h"
+#include "shared-bindings/audiocore/__init__.h"
 #include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/audiobusio/I2SOut.h"
 #include "shared-bindings/util.h"
@@ -266,6 +267,34 @@ const mp_obj_property_t audiobusio_i2sout_paused_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+//|   .. attribute:: stats
+//|
+//|     Buffer refill statistics for the current or last playback as a named tuple with these
+//|     fields:
+//|
+//|     * ``refills`` - buffers refilled in the background
+//|     * ``late_refills`` - refills with less than a quarter of a buffer of audio left to play
+//|     * ``underruns`` - refills that came after the queued audio ran out, audible as a glitch
+//|     * ``last_margin_us`` - audio left to play at the last refill in microseconds
+//|     * ``min_margin_us`` - smallest margin seen. Negative when there was an underrun.
+//|
+//|     Frequent late refills mean background tasks or Python code are delaying refills. Longer
+//|     sample buffers, such as a larger `audiomixer.Mixer` ``buffer_size``, give more margin.
+//|
+STATIC mp_obj_t audiobusio_i2sout_obj_get_stats(mp_obj_t self_in) {
+    audiobusio_i2sout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return audiocore_playback_stats_to_obj(common_hal_audiobusio_i2sout_get_stats(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiobusio_i2sout_get_stats_obj, audiobusio_i2sout_obj_get_stats);
+
+const mp_obj_property_t audiobusio_i2sout_stats_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiobusio_i2sout_get_stats_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 STATIC const mp_rom_map_elem_t audiobusio_i2sout_locals_dict_table[] = {
     // Methods
     { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&audiobusio_i2sout_deinit_obj) },
@@ -280,6 +309,7 @@ STATIC const mp_rom_map_elem_t audiobusio_i2sout_locals_dict_table[] = {
     // Properties
     { MP_ROM_QSTR(MP_QSTR_playing), MP_ROM_PTR(&audiobusio_i2sout_playing_obj) },
     { MP_ROM_QSTR(MP_QSTR_paused), MP_ROM_PTR(&audiobusio_i2sout_paused_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stats), MP_ROM_PTR(&audiobusio_i2sout_stats_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(audiobusio_i2sout_locals_dict, audiobusio_i2sout_locals_dict_table);
 
@@ -40,6 +40,13 @@ void common_hal_audiobusio_pdmin_deinit(audiobusio_pdmin_obj_t* self);
 bool common_hal_audiobusio_pdmin_deinited(audiobusio_pdmin_obj_t* self);
 uint32_t common_hal_audiobusio_pdmin_record_to_buffer(audiobusio_pdmin_obj_t* self,
     uint16_t* buffer, uint32_t length);
+// Records into a ring of buffer_length samples in the background until stopped.
+void common_hal_audiobusio_pdmin_start(audiobusio_pdmin_obj_t* self, uint32_t buffer_length);
+void common_hal_audiobusio_pdmin_stop(audiobusio_pdmin_obj_t* self);
+bool common_hal_audiobusio_pdmin_get_recording(audiobusio_pdmin_obj_t* self);
+// Moves up to length samples recorded in the background into buffer and returns how many.
+uint32_t common_hal_audiobusio_pdmin_readinto(audiobusio_pdmin_obj_t* self,
+    uint16_t* buffer, uint32_t length);
 uint8_t common_hal_audiobusio_pdmin_get_bit_depth(audiobusio_pdmin_obj_t* self);
 uint32_t common_hal_audiobusio_pdmin_get_sample_rate(audiobusio_pdmin_obj_t* self);
 // TODO(tannewt): Add record to file
@@ -31,6 +31,9 @@
 
 #include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/audiobusio/__init__.h"
+#if CIRCUITPY_AUDIOBUSIO_I2SIN
+#include "shared-bindings/audiobusio/I2SIn.h"
+#endif
 #include "shared-bindings/audiobusio/I2SOut.h"
 #include "shared-bindings/audiobusio/PDMIn.h"
 
@@ -51,6 +54,7 @@
 //| .. toctree::
 //|     :maxdepth: 3
 //|
+//|     I2SIn
 //|     I2SOut
 //|     PDMIn
 //|
@@ -61,6 +65,9 @@
 
 STATIC const mp_rom_map_elem_t audiobusio_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_audiobusio) },
+    #if CIRCUITPY_AUDIOBUSIO_I2SIN
+    { MP_ROM_QSTR(MP_QSTR_I2SIn), MP_ROM_PTR(&audiobusio_i2sin_type) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_I2SOut), MP_ROM_PTR(&audiobusio_i2sout_type) },
     { MP_ROM_QSTR(MP_QSTR_PDMIn), MP_ROM_PTR(&audiobusio_pdmin_type) },
 };
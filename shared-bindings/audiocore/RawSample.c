@@ -42,16 +42,27 @@
 //|
 //| An in-memory sound sample
 //|
-//| .. class:: RawSample(buffer, *, channel_count=1, sample_rate=8000)
+//| .. class:: RawSample(buffer, *, channel_count=1, sample_rate=8000, start=0, end=None, loop_start=None, loop_end=None)
 //|
 //|   Create a RawSample based on the given buffer of signed values. If channel_count is more than
 //|   1 then each channel's samples should alternate. In other words, for a two channel buffer, the
 //|   first sample will be for channel 1, the second sample will be for channel two, the third for
 //|   channel 1 and so on.
 //|
-//|   :param array buffer: An `array.array` with samples
+//|   The buffer is played in place and is never copied, so many RawSamples can share one bank of
+//|   sounds in RAM or in a frozen `bytes` object. Pass a `memoryview` or the frame offsets below to
+//|   play part of it.
+//|
+//|   When ``loop_start`` or ``loop_end`` is given, the sample plays up to ``loop_end`` and then
+//|   repeats from ``loop_start`` until `release` is called. It then plays out to ``end``.
+//|
+//|   :param array buffer: An `array.array` or `memoryview` with samples
 //|   :param int channel_count: The number of channels in the buffer
 //|   :param int sample_rate: The desired playback sample rate
+//|   :param int start: First frame to play
+//|   :param int end: Frame to stop playing at. Defaults to the end of the buffer.
+//|   :param int loop_start: First frame of the sustain loop. Defaults to ``start``.
+//|   :param int loop_end: Frame the sustain loop jumps back at. Defaults to ``end``.
 //|
 //|   Simple 8ksps 440 Hz sin wave::
 //|
@@ -74,12 +85,23 @@
 //|     time.sleep(1)
 //|     dac.stop()
 //|
+STATIC mp_int_t get_frame(mp_obj_t frame_obj, mp_int_t default_frame) {
+    if (frame_obj == mp_const_none) {
+        return default_frame;
+    }
+    return mp_obj_get_int(frame_obj);
+}
+
 STATIC mp_obj_t audioio_rawsample_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
-    enum { ARG_buffer, ARG_channel_count, ARG_sample_rate };
+    enum { ARG_buffer, ARG_channel_count, ARG_sample_rate, ARG_start, ARG_end, ARG_loop_start, ARG_loop_end };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_buffer, MP_ARG_OBJ | MP_ARG_REQUIRED },
         { MP_QSTR_channel_count, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1 } },
         { MP_QSTR_sample_rate, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 8000} },
+        { MP_QSTR_start, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
+        { MP_QSTR_end, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_loop_start, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_loop_end, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
@@ -95,9 +117,36 @@ STATIC mp_obj_t audioio_rawsample_make_new(const mp_obj_type_t *type, size_t n_a
         } else if (bufinfo.typecode != 'b' && bufinfo.typecode != 'B' && bufinfo.typecode != BYTEARRAY_TYPECODE) {
             mp_raise_ValueError(translate("sample_source buffer must be a bytearray or array of type 'h', 'H', 'b' or 'B'"));
         }
+        if (args[ARG_channel_count].u_int < 1) {
+            mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_channel_count);
+        }
         common_hal_audioio_rawsample_construct(self, ((uint8_t*)bufinfo.buf), bufinfo.len,
                                                bytes_per_sample, signed_samples, args[ARG_channel_count].u_int,
                                                args[ARG_sample_rate].u_int);
+        self->buffer_obj = args[ARG_buffer].u_obj;
+
+        mp_int_t frame_count = common_hal_audioio_rawsample_get_frame_count(self);
+        mp_int_t start = args[ARG_start].u_int;
+        mp_int_t end = get_frame(args[ARG_end].u_obj, frame_count);
+        if (start < 0 || start >= end) {
+            mp_raise_ValueError_varg(translate("%q index out of range"), MP_QSTR_start);
+        }
+        if (end > frame_count) {
+            mp_raise_ValueError_varg(translate("%q index out of range"), MP_QSTR_end);
+        }
+        mp_int_t loop_start = 0;
+        mp_int_t loop_end = 0;
+        if (args[ARG_loop_start].u_obj != mp_const_none || args[ARG_loop_end].u_obj != mp_const_none) {
+            loop_start = get_frame(args[ARG_loop_start].u_obj, start);
+            loop_end = get_frame(args[ARG_loop_end].u_obj, end);
+            if (loop_start < start || loop_start >= end) {
+                mp_raise_ValueError_varg(translate("%q index out of range"), MP_QSTR_loop_start);
+            }
+            if (loop_end <= loop_start || loop_end > end) {
+                mp_raise_ValueError_varg(translate("%q index out of range"), MP_QSTR_loop_end);
+            }
+        }
+        common_hal_audioio_rawsample_set_region(self, start, end, loop_start, loop_end);
     } else {
         mp_raise_TypeError(translate("buffer must be a bytes-like object"));
     }
@@ -140,6 +189,19 @@ STATIC mp_obj_t audioio_rawsample_obj___exit__(size_t n_args, const mp_obj_t *ar
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(audioio_rawsample___exit___obj, 4, 4, audioio_rawsample_obj___exit__);
 
+//|   .. method:: release()
+//|
+//|     Lets the sample leave its sustain loop once the current pass finishes and play out to
+//|     its end. Playing the sample again restarts the loop. Does nothing without a loop.
+//|
+STATIC mp_obj_t audioio_rawsample_obj_release(mp_obj_t self_in) {
+    audioio_rawsample_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_audioio_rawsample_release(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioio_rawsample_release_obj, audioio_rawsample_obj_release);
+
 //|   .. attribute:: sample_rate
 //|
 //|     32 bit value that dictates how quickly samples are played in Hertz (cycles per second).
@@ -174,6 +236,7 @@ STATIC const mp_rom_map_elem_t audioio_rawsample_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&audioio_rawsample_deinit_obj) },
     { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
     { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&audioio_rawsample___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_release), MP_ROM_PTR(&audioio_rawsample_release_obj) },
 
     // Properties
     { MP_ROM_QSTR(MP_QSTR_sample_rate), MP_ROM_PTR(&audioio_rawsample_sample_rate_obj) },
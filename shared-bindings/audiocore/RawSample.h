@@ -35,6 +35,13 @@ extern const mp_obj_type_t audioio_rawsample_type;
 void common_hal_audioio_rawsample_construct(audioio_rawsample_obj_t* self,
     uint8_t* buffer, uint32_t len, uint8_t bytes_per_sample, bool samples_signed,
     uint8_t channel_count, uint32_t sample_rate);
+// Plays frames start to end of the buffer. loop_end of 0 disables the sustain loop. The caller
+// checks that start <= loop_start < loop_end <= end.
+void common_hal_audioio_rawsample_set_region(audioio_rawsample_obj_t* self,
+    uint32_t start, uint32_t end, uint32_t loop_start, uint32_t loop_end);
+uint32_t common_hal_audioio_rawsample_get_frame_count(audioio_rawsample_obj_t* self);
+// Plays the sustain loop to its end and then the rest of the sample.
+void common_hal_audioio_rawsample_release(audioio_rawsample_obj_t* self);
 
 void common_hal_audioio_rawsample_deinit(audioio_rawsample_obj_t* self);
 bool common_hal_audioio_rawsample_deinited(audioio_rawsample_obj_t* self);
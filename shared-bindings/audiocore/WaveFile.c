@@ -42,12 +42,16 @@
 //| be 8 bit unsigned or 16 bit signed. If a buffer is provided, it will be used instead of allocating
 //| an internal buffer.
 //|
-//| .. class:: WaveFile(file[, buffer])
+//| .. class:: WaveFile(file[, buffer], *, read_ahead=0)
 //|
 //|   Load a .wav file for playback with `audioio.AudioOut` or `audiobusio.I2SOut`.
 //|
 //|   :param typing.BinaryIO file: Already opened wave file
 //|   :param bytearray buffer: Optional pre-allocated buffer, that will be split in half and used for double-buffering of the data. If not provided, two 512 byte buffers are allocated internally.
+//|   :param int read_ahead: Bytes of audio to load ahead of playback in the background. Playback
+//|     then rides out slow filesystem reads, such as while other files are written to the same
+//|     flash. When non-zero, a ring of buffers is allocated internally and ``buffer`` only sets
+//|     the size of each one.
 //|
 //|
 //|   Playing a wave file from flash::
@@ -71,24 +75,35 @@
 //|       pass
 //|     print("stopped")
 //|
-STATIC mp_obj_t audioio_wavefile_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
-    mp_arg_check_num(n_args, kw_args, 1, 2, false);
+STATIC mp_obj_t audioio_wavefile_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_file, ARG_buffer, ARG_read_ahead };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_file, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_buffer, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_read_ahead, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
     audioio_wavefile_obj_t *self = m_new_obj(audioio_wavefile_obj_t);
     self->base.type = &audioio_wavefile_type;
-    if (!MP_OBJ_IS_TYPE(args[0], &mp_type_fileio)) {
+    if (!MP_OBJ_IS_TYPE(args[ARG_file].u_obj, &mp_type_fileio)) {
         mp_raise_TypeError(translate("file must be a file opened in byte mode"));
     }
     uint8_t *buffer = NULL;
     size_t buffer_size = 0;
-    if (n_args >= 2) {
+    if (args[ARG_buffer].u_obj != mp_const_none) {
         mp_buffer_info_t bufinfo;
-        mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_WRITE);
+        mp_get_buffer_raise(args[ARG_buffer].u_obj, &bufinfo, MP_BUFFER_WRITE);
         buffer = bufinfo.buf;
         buffer_size = bufinfo.len;
     }
-    common_hal_audioio_wavefile_construct(self, MP_OBJ_TO_PTR(args[0]),
-                                          buffer, buffer_size);
+    mp_int_t read_ahead = args[ARG_read_ahead].u_int;
+    if (read_ahead < 0) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+    common_hal_audioio_wavefile_construct(self, MP_OBJ_TO_PTR(args[ARG_file].u_obj),
+                                          buffer, buffer_size, read_ahead);
 
     return MP_OBJ_FROM_PTR(self);
 }
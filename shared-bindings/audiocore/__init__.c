@@ -27,6 +27,7 @@
 #include <stdint.h>
 
 #include "py/obj.h"
+#include "py/objnamedtuple.h"
 #include "py/runtime.h"
 
 #include "shared-bindings/microcontroller/Pin.h"
@@ -53,6 +54,42 @@
 //|     WaveFile
 //|
 
+STATIC const mp_obj_namedtuple_type_t audiocore_playback_stats_type = {
+    .base = {
+        .base = {
+            .type = &mp_type_type
+        },
+        .name = MP_QSTR_PlaybackStats,
+        .print = namedtuple_print,
+        .make_new = namedtuple_make_new,
+        .unary_op = mp_obj_tuple_unary_op,
+        .binary_op = mp_obj_tuple_binary_op,
+        .attr = namedtuple_attr,
+        .subscr = mp_obj_tuple_subscr,
+        .getiter = mp_obj_tuple_getiter,
+        .parent = &mp_type_tuple,
+    },
+    .n_fields = 5,
+    .fields = {
+        MP_QSTR_refills,
+        MP_QSTR_late_refills,
+        MP_QSTR_underruns,
+        MP_QSTR_last_margin_us,
+        MP_QSTR_min_margin_us
+    },
+};
+
+mp_obj_t audiocore_playback_stats_to_obj(const audioio_playback_stats_t* stats) {
+    mp_obj_t fields[5] = {
+        mp_obj_new_int_from_uint(stats->refills),
+        mp_obj_new_int_from_uint(stats->late_refills),
+        mp_obj_new_int_from_uint(stats->underruns),
+        mp_obj_new_int(stats->last_margin_us),
+        mp_obj_new_int(stats->min_margin_us),
+    };
+    return namedtuple_make_new((const mp_obj_type_t*) &audiocore_playback_stats_type, 5, fields, NULL);
+}
+
 STATIC const mp_rom_map_elem_t audiocore_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_audiocore) },
     { MP_ROM_QSTR(MP_QSTR_RawSample), MP_ROM_PTR(&audioio_rawsample_type) },
@@ -28,7 +28,9 @@
 #define MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOCORE___INIT___H
 
 #include "py/obj.h"
+#include "shared-module/audiocore/__init__.h"
 
-// Nothing now.
+// Returns a PlaybackStats named tuple for the output stats properties.
+mp_obj_t audiocore_playback_stats_to_obj(const audioio_playback_stats_t* stats);
 
 #endif  // MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOCORE___INIT___H
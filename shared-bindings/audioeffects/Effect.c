@@ -0,0 +1,405 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/audioeffects/Effect.h"
+
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/util.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: audioeffects
+//|
+//| :class:`Effect` -- Filters, amplifies and echoes an audio sample as it plays
+//| =============================================================================
+//|
+//| Effect wraps another sample and processes it with an optional biquad filter, a gain, a delay
+//| line with feedback for echoes and an optional soft clipper, in that order. The output is
+//| signed 16 bit with the channel count and sample rate of the source.
+//|
+//| .. class:: Effect(source, *, buffer_size=1024, max_delay=0.0)
+//|
+//|   Create an Effect that processes ``source`` when played.
+//|
+//|   :param source: The sample to process. Must be 8 or 16 bit with one or two channels.
+//|   :param int buffer_size: The total size in bytes of the buffers to process into
+//|   :param float max_delay: The longest `delay` in seconds. Memory for it is allocated up front.
+//|
+//|   Playing a wave file with a low-pass filter and an echo::
+//|
+//|     import board
+//|     import audioio
+//|     import audiocore
+//|     import audioeffects
+//|
+//|     a = audioio.AudioOut(board.A0)
+//|     music = audiocore.WaveFile(open("cplay-5.1-16bit-16khz.wav", "rb"))
+//|     effect = audioeffects.Effect(music, max_delay=0.25)
+//|     effect.lowpass(2000)
+//|     effect.delay = 0.25
+//|     effect.feedback = 0.4
+//|     effect.soft_clip = True
+//|     a.play(effect)
+//|     while a.playing:
+//|       pass
+//|
+STATIC mp_obj_t audioeffects_effect_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_source, ARG_buffer_size, ARG_max_delay };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_source, MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_buffer_size, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1024} },
+        { MP_QSTR_max_delay, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = MP_OBJ_NULL} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    // The sample protocol raises if source isn't a sample.
+    mp_obj_t source = args[ARG_source].u_obj;
+    mp_int_t buffer_size = args[ARG_buffer_size].u_int;
+    if (buffer_size < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_buffer_size);
+    }
+    mp_float_t max_delay = args[ARG_max_delay].u_obj == MP_OBJ_NULL
+        ? (mp_float_t) 0.0
+        : mp_obj_get_float(args[ARG_max_delay].u_obj);
+    if (max_delay < 0) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+
+    audioeffects_effect_obj_t *self = m_new_obj(audioeffects_effect_obj_t);
+    self->base.type = &audioeffects_effect_type;
+    common_hal_audioeffects_effect_construct(self, source, buffer_size, max_delay);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Deinitialises the Effect and releases its buffers.
+//|
+STATIC mp_obj_t audioeffects_effect_deinit(mp_obj_t self_in) {
+    audioeffects_effect_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_audioeffects_effect_deinit(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(audioeffects_effect_deinit_obj, audioeffects_effect_deinit);
+
+STATIC void check_for_deinit(audioeffects_effect_obj_t *self) {
+    if (common_hal_audioeffects_effect_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes the Effect when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t audioeffects_effect_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_audioeffects_effect_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(audioeffects_effect___exit___obj, 4, 4, audioeffects_effect_obj___exit__);
+
+STATIC void set_filter(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args,
+                       audioeffects_filter_t filter, mp_float_t default_q) {
+    enum { ARG_frequency, ARG_gain, ARG_q };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_frequency, MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_gain, MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_q, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = MP_OBJ_NULL} },
+    };
+    audioeffects_effect_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    check_for_deinit(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_float_t frequency = mp_obj_get_float(args[ARG_frequency].u_obj);
+    // Nyquist frequency.
+    if (frequency <= 0 || frequency >= common_hal_audioeffects_effect_get_sample_rate(self) / 2) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+    mp_float_t q = args[ARG_q].u_obj == MP_OBJ_NULL ? default_q : mp_obj_get_float(args[ARG_q].u_obj);
+    if (q <= 0) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+    mp_float_t gain_db = 0;
+    if (filter == AUDIOEFFECTS_FILTER_PEAKING) {
+        if (args[ARG_gain].u_obj == MP_OBJ_NULL) {
+            mp_raise_TypeError(translate("Invalid argument"));
+        }
+        gain_db = mp_obj_get_float(args[ARG_gain].u_obj);
+    } else if (args[ARG_gain].u_obj != MP_OBJ_NULL) {
+        mp_raise_TypeError(translate("Invalid argument"));
+    }
+    common_hal_audioeffects_effect_set_filter(self, filter, frequency, q, gain_db);
+}
+
+//|   .. method:: lowpass(frequency, *, q=0.7071)
+//|
+//|     Filters out frequencies above ``frequency`` Hertz. Higher ``q`` values make the cutoff
+//|     sharper and add a peak at it.
+//|
+STATIC mp_obj_t audioeffects_effect_obj_lowpass(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    set_filter(n_args, pos_args, kw_args, AUDIOEFFECTS_FILTER_LOWPASS, MICROPY_FLOAT_CONST(0.7071));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(audioeffects_effect_lowpass_obj, 2, audioeffects_effect_obj_lowpass);
+
+//|   .. method:: highpass(frequency, *, q=0.7071)
+//|
+//|     Filters out frequencies below ``frequency`` Hertz.
+//|
+STATIC mp_obj_t audioeffects_effect_obj_highpass(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    set_filter(n_args, pos_args, kw_args, AUDIOEFFECTS_FILTER_HIGHPASS, MICROPY_FLOAT_CONST(0.7071));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(audioeffects_effect_highpass_obj, 2, audioeffects_effect_obj_highpass);
+
+//|   .. method:: peaking(frequency, gain, *, q=1.0)
+//|
+//|     Boosts (positive ``gain``) or cuts (negative ``gain``) frequencies around ``frequency``
+//|     Hertz by ``gain`` decibels. Higher ``q`` values affect a narrower band.
+//|
+STATIC mp_obj_t audioeffects_effect_obj_peaking(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    set_filter(n_args, pos_args, kw_args, AUDIOEFFECTS_FILTER_PEAKING, MICROPY_FLOAT_CONST(1.0));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(audioeffects_effect_peaking_obj, 3, audioeffects_effect_obj_peaking);
+
+//|   .. method:: clear_filter()
+//|
+//|     Stops filtering.
+//|
+STATIC mp_obj_t audioeffects_effect_obj_clear_filter(mp_obj_t self_in) {
+    audioeffects_effect_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_audioeffects_effect_set_filter(self, AUDIOEFFECTS_FILTER_NONE, 0, 0, 0);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioeffects_effect_clear_filter_obj, audioeffects_effect_obj_clear_filter);
+
+//|   .. attribute:: gain
+//|
+//|     Linear gain from 0.0 to 8.0, applied after the filter. Changes ramp in over one buffer.
+//|
+STATIC mp_obj_t audioeffects_effect_obj_get_gain(mp_obj_t self_in) {
+    audioeffects_effect_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_float(common_hal_audioeffects_effect_get_gain(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioeffects_effect_get_gain_obj, audioeffects_effect_obj_get_gain);
+
+STATIC mp_obj_t audioeffects_effect_obj_set_gain(mp_obj_t self_in, mp_obj_t gain_in) {
+    audioeffects_effect_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    mp_float_t gain = mp_obj_get_float(gain_in);
+    if (gain < 0 || gain > 8) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+    common_hal_audioeffects_effect_set_gain(self, gain);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audioeffects_effect_set_gain_obj, audioeffects_effect_obj_set_gain);
+
+const mp_obj_property_t audioeffects_effect_gain_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audioeffects_effect_get_gain_obj,
+              (mp_obj_t)&audioeffects_effect_set_gain_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: delay
+//|
+//|     Echo delay in seconds, up to ``max_delay``. 0 turns the delay line off. Changing it clears
+//|     the echoes that are still sounding.
+//|
+STATIC mp_obj_t audioeffects_effect_obj_get_delay(mp_obj_t self_in) {
+    audioeffects_effect_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_float(common_hal_audioeffects_effect_get_delay(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioeffects_effect_get_delay_obj, audioeffects_effect_obj_get_delay);
+
+STATIC mp_obj_t audioeffects_effect_obj_set_delay(mp_obj_t self_in, mp_obj_t delay_in) {
+    audioeffects_effect_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    mp_float_t delay = mp_obj_get_float(delay_in);
+    if (delay < 0 || delay > common_hal_audioeffects_effect_get_max_delay(self)) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+    common_hal_audioeffects_effect_set_delay(self, delay);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audioeffects_effect_set_delay_obj, audioeffects_effect_obj_set_delay);
+
+const mp_obj_property_t audioeffects_effect_delay_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audioeffects_effect_get_delay_obj,
+              (mp_obj_t)&audioeffects_effect_set_delay_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: feedback
+//|
+//|     How much of the delayed output is mixed back in, from 0.0 to 1.0.
+//|
+STATIC mp_obj_t audioeffects_effect_obj_get_feedback(mp_obj_t self_in) {
+    audioeffects_effect_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_float(common_hal_audioeffects_effect_get_feedback(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioeffects_effect_get_feedback_obj, audioeffects_effect_obj_get_feedback);
+
+STATIC mp_obj_t audioeffects_effect_obj_set_feedback(mp_obj_t self_in, mp_obj_t feedback_in) {
+    audioeffects_effect_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    mp_float_t feedback = mp_obj_get_float(feedback_in);
+    if (feedback < 0 || feedback > 1) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+    common_hal_audioeffects_effect_set_feedback(self, feedback);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audioeffects_effect_set_feedback_obj, audioeffects_effect_obj_set_feedback);
+
+const mp_obj_property_t audioeffects_effect_feedback_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audioeffects_effect_get_feedback_obj,
+              (mp_obj_t)&audioeffects_effect_set_feedback_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: soft_clip
+//|
+//|     When True, peaks are rounded off gradually instead of being clipped flat at full scale.
+//|
+STATIC mp_obj_t audioeffects_effect_obj_get_soft_clip(mp_obj_t self_in) {
+    audioeffects_effect_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_bool(common_hal_audioeffects_effect_get_soft_clip(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioeffects_effect_get_soft_clip_obj, audioeffects_effect_obj_get_soft_clip);
+
+STATIC mp_obj_t audioeffects_effect_obj_set_soft_clip(mp_obj_t self_in, mp_obj_t soft_clip) {
+    audioeffects_effect_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_audioeffects_effect_set_soft_clip(self, mp_obj_is_true(soft_clip));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audioeffects_effect_set_soft_clip_obj, audioeffects_effect_obj_set_soft_clip);
+
+const mp_obj_property_t audioeffects_effect_soft_clip_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audioeffects_effect_get_soft_clip_obj,
+              (mp_obj_t)&audioeffects_effect_set_soft_clip_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: playing
+//|
+//|     True while the source still has data to process. (read-only)
+//|
+STATIC mp_obj_t audioeffects_effect_obj_get_playing(mp_obj_t self_in) {
+    audioeffects_effect_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_bool(common_hal_audioeffects_effect_get_playing(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioeffects_effect_get_playing_obj, audioeffects_effect_obj_get_playing);
+
+const mp_obj_property_t audioeffects_effect_playing_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audioeffects_effect_get_playing_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: sample_rate
+//|
+//|     32 bit value that dictates how quickly samples are played in Hertz (cycles per second).
+//|     Always the sample rate of the source. (read-only)
+//|
+STATIC mp_obj_t audioeffects_effect_obj_get_sample_rate(mp_obj_t self_in) {
+    audioeffects_effect_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_audioeffects_effect_get_sample_rate(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioeffects_effect_get_sample_rate_obj, audioeffects_effect_obj_get_sample_rate);
+
+const mp_obj_property_t audioeffects_effect_sample_rate_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audioeffects_effect_get_sample_rate_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t audioeffects_effect_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&audioeffects_effect_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&audioeffects_effect___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_lowpass), MP_ROM_PTR(&audioeffects_effect_lowpass_obj) },
+    { MP_ROM_QSTR(MP_QSTR_highpass), MP_ROM_PTR(&audioeffects_effect_highpass_obj) },
+    { MP_ROM_QSTR(MP_QSTR_peaking), MP_ROM_PTR(&audioeffects_effect_peaking_obj) },
+    { MP_ROM_QSTR(MP_QSTR_clear_filter), MP_ROM_PTR(&audioeffects_effect_clear_filter_obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_gain), MP_ROM_PTR(&audioeffects_effect_gain_obj) },
+    { MP_ROM_QSTR(MP_QSTR_delay), MP_ROM_PTR(&audioeffects_effect_delay_obj) },
+    { MP_ROM_QSTR(MP_QSTR_feedback), MP_ROM_PTR(&audioeffects_effect_feedback_obj) },
+    { MP_ROM_QSTR(MP_QSTR_soft_clip), MP_ROM_PTR(&audioeffects_effect_soft_clip_obj) },
+    { MP_ROM_QSTR(MP_QSTR_playing), MP_ROM_PTR(&audioeffects_effect_playing_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sample_rate), MP_ROM_PTR(&audioeffects_effect_sample_rate_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(audioeffects_effect_locals_dict, audioeffects_effect_locals_dict_table);
+
+STATIC const audiosample_p_t audioeffects_effect_proto = {
+    MP_PROTO_IMPLEMENT(MP_QSTR_protocol_audiosample)
+    .sample_rate = (audiosample_sample_rate_fun)common_hal_audioeffects_effect_get_sample_rate,
+    .bits_per_sample = (audiosample_bits_per_sample_fun)common_hal_audioeffects_effect_get_bits_per_sample,
+    .channel_count = (audiosample_channel_count_fun)common_hal_audioeffects_effect_get_channel_count,
+    .reset_buffer = (audiosample_reset_buffer_fun)audioeffects_effect_reset_buffer,
+    .get_buffer = (audiosample_get_buffer_fun)audioeffects_effect_get_buffer,
+    .get_buffer_structure = (audiosample_get_buffer_structure_fun)audioeffects_effect_get_buffer_structure,
+};
+
+const mp_obj_type_t audioeffects_effect_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Effect,
+    .make_new = audioeffects_effect_make_new,
+    .locals_dict = (mp_obj_dict_t*)&audioeffects_effect_locals_dict,
+    .protocol = &audioeffects_effect_proto,
+};
@@ -0,0 +1,73 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOEFFECTS_EFFECT_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOEFFECTS_EFFECT_H
+
+#include "shared-module/audioeffects/Effect.h"
+
+extern const mp_obj_type_t audioeffects_effect_type;
+
+typedef enum {
+    AUDIOEFFECTS_FILTER_NONE,
+    AUDIOEFFECTS_FILTER_LOWPASS,
+    AUDIOEFFECTS_FILTER_HIGHPASS,
+    AUDIOEFFECTS_FILTER_PEAKING,
+} audioeffects_filter_t;
+
+void common_hal_audioeffects_effect_construct(audioeffects_effect_obj_t* self,
+                                              mp_obj_t source,
+                                              uint32_t buffer_size,
+                                              mp_float_t max_delay);
+
+void common_hal_audioeffects_effect_deinit(audioeffects_effect_obj_t* self);
+bool common_hal_audioeffects_effect_deinited(audioeffects_effect_obj_t* self);
+
+bool common_hal_audioeffects_effect_get_playing(audioeffects_effect_obj_t* self);
+uint32_t common_hal_audioeffects_effect_get_sample_rate(audioeffects_effect_obj_t* self);
+uint8_t common_hal_audioeffects_effect_get_channel_count(audioeffects_effect_obj_t* self);
+uint8_t common_hal_audioeffects_effect_get_bits_per_sample(audioeffects_effect_obj_t* self);
+
+// gain_db is only used by peaking filters.
+void common_hal_audioeffects_effect_set_filter(audioeffects_effect_obj_t* self,
+                                               audioeffects_filter_t filter,
+                                               mp_float_t frequency, mp_float_t q,
+                                               mp_float_t gain_db);
+
+mp_float_t common_hal_audioeffects_effect_get_gain(audioeffects_effect_obj_t* self);
+void common_hal_audioeffects_effect_set_gain(audioeffects_effect_obj_t* self, mp_float_t gain);
+
+mp_float_t common_hal_audioeffects_effect_get_max_delay(audioeffects_effect_obj_t* self);
+mp_float_t common_hal_audioeffects_effect_get_delay(audioeffects_effect_obj_t* self);
+void common_hal_audioeffects_effect_set_delay(audioeffects_effect_obj_t* self, mp_float_t delay);
+
+mp_float_t common_hal_audioeffects_effect_get_feedback(audioeffects_effect_obj_t* self);
+void common_hal_audioeffects_effect_set_feedback(audioeffects_effect_obj_t* self, mp_float_t feedback);
+
+bool common_hal_audioeffects_effect_get_soft_clip(audioeffects_effect_obj_t* self);
+void common_hal_audioeffects_effect_set_soft_clip(audioeffects_effect_obj_t* self, bool soft_clip);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOEFFECTS_EFFECT_H
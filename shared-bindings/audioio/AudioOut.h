@@ -30,6 +30,7 @@
 #include "common-hal/audioio/AudioOut.h"
 #include "common-hal/microcontroller/Pin.h"
 #include "shared-bindings/audiocore/RawSample.h"
+#include "shared-module/audiocore/__init__.h"
 
 extern const mp_obj_type_t audioio_audioout_type;
 
@@ -45,5 +46,6 @@ bool common_hal_audioio_audioout_get_playing(audioio_audioout_obj_t* self);
 void common_hal_audioio_audioout_pause(audioio_audioout_obj_t* self);
 void common_hal_audioio_audioout_resume(audioio_audioout_obj_t* self);
 bool common_hal_audioio_audioout_get_paused(audioio_audioout_obj_t* self);
+const audioio_playback_stats_t* common_hal_audioio_audioout_get_stats(audioio_audioout_obj_t* self);
 
 #endif // MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOIO_AUDIOOUT_H
@@ -47,7 +47,7 @@
 //|
 //| .. class:: Mixer(voice_count=2, buffer_size=1024, channel_count=2, bits_per_sample=16, samples_signed=True, sample_rate=8000)
 //|
-//|   Create a Mixer object that can mix multiple channels with the same sample rate.
+//|   Create a Mixer object that can mix multiple channels into one with the given format.
 //|   Samples are accessed and controlled with the mixer's `audiomixer.MixerVoice` objects.
 //|
 //|   :param int voice_count: The maximum number of voices to mix
@@ -55,7 +55,7 @@
 //|   :param int channel_count: The number of channels the source samples contain. 1 = mono; 2 = stereo.
 //|   :param int bits_per_sample: The bits per sample of the samples being played
 //|   :param bool samples_signed: Samples are signed (True) or unsigned (False)
-//|   :param int sample_rate: The sample rate to be used for all samples
+//|   :param int sample_rate: The sample rate of the mixed output
 //|
 //|   Playing a wave file from flash::
 //|
@@ -225,7 +225,9 @@ const mp_obj_property_t audiomixer_mixer_voice_obj = {
 //|
 //|     Sample must be an `audiocore.WaveFile`, `audiocore.RawSample`, or `audiomixer.Mixer`.
 //|
-//|     The sample must match the Mixer's encoding settings given in the constructor.
+//|     Samples with a different sample rate, channel count, bits per sample or signedness than the
+//|     mixer are converted as they play. Samples that match are mixed without conversion, which
+//|     takes less time.
 //|
 STATIC mp_obj_t audiomixer_mixer_obj_play(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_sample, ARG_voice, ARG_loop };
@@ -65,7 +65,9 @@ STATIC mp_obj_t audiomixer_mixervoice_make_new(const mp_obj_type_t *type, size_t
 //|
 //|     Sample must be an `audiocore.WaveFile`, `audiomixer.Mixer` or `audiocore.RawSample`.
 //|
-//|     The sample must match the `audiomixer.Mixer`'s encoding settings given in the constructor.
+//|     Samples with a different sample rate, channel count, bits per sample or signedness than the
+//|     mixer are converted as they play. Samples that match are mixed without conversion, which
+//|     takes less time.
 //|
 STATIC mp_obj_t audiomixer_mixervoice_obj_play(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_sample, ARG_loop };
@@ -28,6 +28,7 @@
 #include <stdint.h>
 
 #include "lib/utils/context_manager_helpers.h"
+#include "py/objnamedtuple.h"
 #include "py/objproperty.h"
 #include "py/runtime.h"
 #include "shared-bindings/audiomp3/MP3Decoder.h"
@@ -41,12 +42,16 @@
 //|
 //| An object that decodes MP3 files for playback on an audio device.
 //|
-//| .. class:: MP3(file[, buffer])
+//| .. class:: MP3(file[, buffer], *, decode_ahead=0)
 //|
 //|   Load a .mp3 file for playback with `audioio.AudioOut` or `audiobusio.I2SOut`.
 //|
 //|   :param typing.BinaryIO file: Already opened mp3 file
 //|   :param bytearray buffer: Optional pre-allocated buffer, that will be split in half and used for double-buffering of the data. If not provided, two buffers are allocated internally.  The specific buffer size required depends on the mp3 file.
+//|   :param int decode_ahead: Number of frames to decode in the background ahead of playback.
+//|     Each frame takes 4.5kB. Decoding ahead moves decode time out of the audio refill so it
+//|     doesn't delay other background tasks. ``buffer`` is not used when it is set. Only one
+//|     MP3Decoder decodes ahead at a time; the last one played takes over.
 //|
 //|
 //|   Playing a mp3 file from flash::
@@ -70,24 +75,36 @@
 //|       pass
 //|     print("stopped")
 //|
-STATIC mp_obj_t audiomp3_mp3file_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
-    mp_arg_check_num(n_args, kw_args, 1, 2, false);
+STATIC mp_obj_t audiomp3_mp3file_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_file, ARG_buffer, ARG_decode_ahead };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_file, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_buffer, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_decode_ahead, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
     audiomp3_mp3file_obj_t *self = m_new_obj(audiomp3_mp3file_obj_t);
     self->base.type = &audiomp3_mp3file_type;
-    if (!MP_OBJ_IS_TYPE(args[0], &mp_type_fileio)) {
+    if (!MP_OBJ_IS_TYPE(args[ARG_file].u_obj, &mp_type_fileio)) {
         mp_raise_TypeError(translate("file must be a file opened in byte mode"));
     }
     uint8_t *buffer = NULL;
     size_t buffer_size = 0;
-    if (n_args >= 2) {
+    if (args[ARG_buffer].u_obj != mp_const_none) {
         mp_buffer_info_t bufinfo;
-        mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_WRITE);
+        mp_get_buffer_raise(args[ARG_buffer].u_obj, &bufinfo, MP_BUFFER_WRITE);
         buffer = bufinfo.buf;
         buffer_size = bufinfo.len;
     }
-    common_hal_audiomp3_mp3file_construct(self, MP_OBJ_TO_PTR(args[0]),
-                                          buffer, buffer_size);
+    // Two more frames are held by the output.
+    mp_int_t decode_ahead = args[ARG_decode_ahead].u_int;
+    if (decode_ahead < 0 || decode_ahead > 0xff - 2) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+    common_hal_audiomp3_mp3file_construct(self, MP_OBJ_TO_PTR(args[ARG_file].u_obj),
+                                          buffer, buffer_size, decode_ahead);
 
     return MP_OBJ_FROM_PTR(self);
 }
@@ -239,7 +256,93 @@ const mp_obj_property_t audiomp3_mp3file_rms_level_obj = {
               (mp_obj_t)&mp_const_none_obj,
               (mp_obj_t)&mp_const_none_obj},
 };
+//|   .. attribute:: decode_budget_us
+//|
+//|     Microseconds each background pass may spend decoding ahead. A frame is only started when
+//|     the time left in the pass is at least as long as the last frame took to decode. 0, the
+//|     default, decodes one frame per pass. Frames that aren't ready in time are decoded when
+//|     playback needs them.
+//|
+STATIC mp_obj_t audiomp3_mp3file_obj_get_decode_budget_us(mp_obj_t self_in) {
+    audiomp3_mp3file_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_int_from_uint(common_hal_audiomp3_mp3file_get_decode_budget_us(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiomp3_mp3file_get_decode_budget_us_obj, audiomp3_mp3file_obj_get_decode_budget_us);
 
+STATIC mp_obj_t audiomp3_mp3file_obj_set_decode_budget_us(mp_obj_t self_in, mp_obj_t budget_us) {
+    audiomp3_mp3file_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    mp_int_t budget = mp_obj_get_int(budget_us);
+    if (budget < 0) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+    common_hal_audiomp3_mp3file_set_decode_budget_us(self, budget);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audiomp3_mp3file_set_decode_budget_us_obj, audiomp3_mp3file_obj_set_decode_budget_us);
+
+const mp_obj_property_t audiomp3_mp3file_decode_budget_us_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiomp3_mp3file_get_decode_budget_us_obj,
+              (mp_obj_t)&audiomp3_mp3file_set_decode_budget_us_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_obj_namedtuple_type_t audiomp3_decode_stats_type = {
+    .base = {
+        .base = {
+            .type = &mp_type_type
+        },
+        .name = MP_QSTR_DecodeStats,
+        .print = namedtuple_print,
+        .make_new = namedtuple_make_new,
+        .unary_op = mp_obj_tuple_unary_op,
+        .binary_op = mp_obj_tuple_binary_op,
+        .attr = namedtuple_attr,
+        .subscr = mp_obj_tuple_subscr,
+        .getiter = mp_obj_tuple_getiter,
+        .parent = &mp_type_tuple,
+    },
+    .n_fields = 4,
+    .fields = {
+        MP_QSTR_frames,
+        MP_QSTR_late_frames,
+        MP_QSTR_last_decode_us,
+        MP_QSTR_max_decode_us
+    },
+};
+
+//|   .. attribute:: decode_stats
+//|
+//|     Decoding statistics since playback started as a named tuple with these fields:
+//|
+//|     * ``frames`` - frames decoded
+//|     * ``late_frames`` - frames decoded when playback needed them because decoding ahead fell
+//|       behind. Always 0 without ``decode_ahead``.
+//|     * ``last_decode_us`` - time the last frame took to read and decode in microseconds
+//|     * ``max_decode_us`` - longest time a frame took
+//|
+STATIC mp_obj_t audiomp3_mp3file_obj_get_decode_stats(mp_obj_t self_in) {
+    audiomp3_mp3file_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    const audiomp3_decode_stats_t* stats = common_hal_audiomp3_mp3file_get_decode_stats(self);
+    mp_obj_t fields[4] = {
+        mp_obj_new_int_from_uint(stats->frames),
+        mp_obj_new_int_from_uint(stats->late_frames),
+        mp_obj_new_int_from_uint(stats->last_decode_us),
+        mp_obj_new_int_from_uint(stats->max_decode_us),
+    };
+    return namedtuple_make_new((const mp_obj_type_t*) &audiomp3_decode_stats_type, 4, fields, NULL);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiomp3_mp3file_get_decode_stats_obj, audiomp3_mp3file_obj_get_decode_stats);
+
+const mp_obj_property_t audiomp3_mp3file_decode_stats_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiomp3_mp3file_get_decode_stats_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
 
 STATIC const mp_rom_map_elem_t audiomp3_mp3file_locals_dict_table[] = {
     // Methods
@@ -253,6 +356,8 @@ STATIC const mp_rom_map_elem_t audiomp3_mp3file_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_bits_per_sample), MP_ROM_PTR(&audiomp3_mp3file_bits_per_sample_obj) },
     { MP_ROM_QSTR(MP_QSTR_channel_count), MP_ROM_PTR(&audiomp3_mp3file_channel_count_obj) },
     { MP_ROM_QSTR(MP_QSTR_rms_level), MP_ROM_PTR(&audiomp3_mp3file_rms_level_obj) },
+    { MP_ROM_QSTR(MP_QSTR_decode_budget_us), MP_ROM_PTR(&audiomp3_mp3file_decode_budget_us_obj) },
+    { MP_ROM_QSTR(MP_QSTR_decode_stats), MP_ROM_PTR(&audiomp3_mp3file_decode_stats_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(audiomp3_mp3file_locals_dict, audiomp3_mp3file_locals_dict_table);
 
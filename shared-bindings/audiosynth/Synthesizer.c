@@ -0,0 +1,309 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/audiosynth/Synthesizer.h"
+
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/util.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: audiosynth
+//|
+//| :class:`Synthesizer` -- Plays notes from a wavetable
+//| =====================================================
+//|
+//| Synthesizer is an audio sample that renders up to ``voice_count`` notes at once from a single
+//| cycle wavetable as it plays. Each voice has its own frequency, velocity and attack, decay,
+//| sustain, release (ADSR) envelope state. The output is mono, signed 16 bit.
+//|
+//| .. class:: Synthesizer(wavetable, *, voice_count=4, sample_rate=22050, buffer_size=1024, attack=0.01, decay=0.1, sustain=0.8, release=0.2)
+//|
+//|   Create a Synthesizer that plays ``wavetable`` at the pressed frequencies.
+//|
+//|   :param array.array wavetable: One cycle of the waveform as signed 16 bit samples (typecode ``'h'``).
+//|     Voices are summed, so keep its peaks at or below full scale divided by the number of
+//|     voices that sound at once to avoid clipping.
+//|   :param int voice_count: The maximum number of notes that sound at once
+//|   :param int sample_rate: The sample rate of the output
+//|   :param int buffer_size: The total size in bytes of the buffers to render into
+//|   :param float attack: Seconds to rise to full level after a press
+//|   :param float decay: Seconds to fall from full level to the sustain level
+//|   :param float sustain: Level from 0.0 to 1.0 held while pressed
+//|   :param float release: Seconds to fall from full level to silence after a release
+//|
+//|   Playing a chord with a sine wavetable::
+//|
+//|     import array
+//|     import math
+//|     import time
+//|     import board
+//|     import audioio
+//|     import audiosynth
+//|
+//|     sine = array.array("h", [int(math.sin(math.pi * 2 * i / 64) * 8000) for i in range(64)])
+//|     synth = audiosynth.Synthesizer(sine, voice_count=3)
+//|     a = audioio.AudioOut(board.A0)
+//|     a.play(synth)
+//|     for voice, frequency in enumerate((261.6, 329.6, 392.0)):
+//|         synth.press(voice, frequency)
+//|     time.sleep(1)
+//|     synth.release_all()
+//|
+STATIC mp_float_t float_arg(mp_obj_t arg, mp_float_t default_value) {
+    mp_float_t value = arg == MP_OBJ_NULL ? default_value : mp_obj_get_float(arg);
+    if (value < 0) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+    return value;
+}
+
+STATIC mp_obj_t audiosynth_synthesizer_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_wavetable, ARG_voice_count, ARG_sample_rate, ARG_buffer_size, ARG_attack, ARG_decay, ARG_sustain, ARG_release };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_wavetable, MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_voice_count, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 4} },
+        { MP_QSTR_sample_rate, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 22050} },
+        { MP_QSTR_buffer_size, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1024} },
+        { MP_QSTR_attack, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_decay, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_sustain, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_release, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = MP_OBJ_NULL} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[ARG_wavetable].u_obj, &bufinfo, MP_BUFFER_READ);
+    if (bufinfo.typecode != 'h') {
+        mp_raise_ValueError(translate("bad typecode"));
+    }
+    // Phases keep 16 bits of wavetable index.
+    size_t wavetable_length = bufinfo.len / sizeof(int16_t);
+    if (wavetable_length < 2 || wavetable_length > 0xffff) {
+        mp_raise_ValueError(translate("Invalid buffer size"));
+    }
+
+    mp_int_t voice_count = args[ARG_voice_count].u_int;
+    if (voice_count < 1 || voice_count > 255) {
+        mp_raise_ValueError(translate("Invalid voice count"));
+    }
+    mp_int_t sample_rate = args[ARG_sample_rate].u_int;
+    if (sample_rate < 1) {
+        mp_raise_ValueError(translate("Sample rate must be positive"));
+    }
+    mp_int_t buffer_size = args[ARG_buffer_size].u_int;
+    if (buffer_size < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_buffer_size);
+    }
+    mp_float_t sustain = float_arg(args[ARG_sustain].u_obj, MICROPY_FLOAT_CONST(0.8));
+    if (sustain > 1) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+
+    audiosynth_synthesizer_obj_t *self = m_new_obj_var(audiosynth_synthesizer_obj_t, audiosynth_voice_t, voice_count);
+    self->base.type = &audiosynth_synthesizer_type;
+    common_hal_audiosynth_synthesizer_construct(self, args[ARG_wavetable].u_obj, bufinfo.buf,
+        wavetable_length, voice_count, buffer_size, sample_rate,
+        float_arg(args[ARG_attack].u_obj, MICROPY_FLOAT_CONST(0.01)),
+        float_arg(args[ARG_decay].u_obj, MICROPY_FLOAT_CONST(0.1)),
+        sustain,
+        float_arg(args[ARG_release].u_obj, MICROPY_FLOAT_CONST(0.2)));
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Deinitialises the Synthesizer and releases its buffers.
+//|
+STATIC mp_obj_t audiosynth_synthesizer_deinit(mp_obj_t self_in) {
+    audiosynth_synthesizer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_audiosynth_synthesizer_deinit(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(audiosynth_synthesizer_deinit_obj, audiosynth_synthesizer_deinit);
+
+STATIC void check_for_deinit(audiosynth_synthesizer_obj_t *self) {
+    if (common_hal_audiosynth_synthesizer_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes the Synthesizer when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t audiosynth_synthesizer_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_audiosynth_synthesizer_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(audiosynth_synthesizer___exit___obj, 4, 4, audiosynth_synthesizer_obj___exit__);
+
+STATIC uint8_t voice_arg(audiosynth_synthesizer_obj_t *self, mp_obj_t voice_in) {
+    mp_int_t voice = mp_obj_get_int(voice_in);
+    if (voice < 0 || voice >= self->voice_count) {
+        mp_raise_ValueError(translate("Invalid voice"));
+    }
+    return voice;
+}
+
+//|   .. method:: press(voice, frequency, velocity=1.0)
+//|
+//|     Starts the attack of a note at ``frequency`` Hertz on the given voice. ``velocity`` from
+//|     0.0 to 1.0 scales its level. Pressing a voice that is still sounding changes its note
+//|     without restarting the waveform.
+//|
+STATIC mp_obj_t audiosynth_synthesizer_obj_press(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_voice, ARG_frequency, ARG_velocity };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_voice, MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_frequency, MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_velocity, MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+    };
+    audiosynth_synthesizer_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    check_for_deinit(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    uint8_t voice = voice_arg(self, args[ARG_voice].u_obj);
+    mp_float_t frequency = mp_obj_get_float(args[ARG_frequency].u_obj);
+    // Nyquist frequency.
+    if (frequency <= 0 || frequency >= common_hal_audiosynth_synthesizer_get_sample_rate(self) / 2) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+    mp_float_t velocity = float_arg(args[ARG_velocity].u_obj, MICROPY_FLOAT_CONST(1.0));
+    if (velocity > 1) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+    common_hal_audiosynth_synthesizer_press(self, voice, frequency, velocity);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(audiosynth_synthesizer_press_obj, 3, audiosynth_synthesizer_obj_press);
+
+//|   .. method:: release(voice)
+//|
+//|     Starts the release of the note on the given voice.
+//|
+STATIC mp_obj_t audiosynth_synthesizer_obj_release(mp_obj_t self_in, mp_obj_t voice_in) {
+    audiosynth_synthesizer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_audiosynth_synthesizer_release(self, voice_arg(self, voice_in));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audiosynth_synthesizer_release_obj, audiosynth_synthesizer_obj_release);
+
+//|   .. method:: release_all()
+//|
+//|     Starts the release of every sounding note.
+//|
+STATIC mp_obj_t audiosynth_synthesizer_obj_release_all(mp_obj_t self_in) {
+    audiosynth_synthesizer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_audiosynth_synthesizer_release_all(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiosynth_synthesizer_release_all_obj, audiosynth_synthesizer_obj_release_all);
+
+//|   .. attribute:: playing
+//|
+//|     True when any voice is sounding, including during its release. (read-only)
+//|
+STATIC mp_obj_t audiosynth_synthesizer_obj_get_playing(mp_obj_t self_in) {
+    audiosynth_synthesizer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_bool(common_hal_audiosynth_synthesizer_get_playing(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiosynth_synthesizer_get_playing_obj, audiosynth_synthesizer_obj_get_playing);
+
+const mp_obj_property_t audiosynth_synthesizer_playing_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiosynth_synthesizer_get_playing_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: sample_rate
+//|
+//|     32 bit value that dictates how quickly samples are played in Hertz (cycles per second). (read-only)
+//|
+STATIC mp_obj_t audiosynth_synthesizer_obj_get_sample_rate(mp_obj_t self_in) {
+    audiosynth_synthesizer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_audiosynth_synthesizer_get_sample_rate(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiosynth_synthesizer_get_sample_rate_obj, audiosynth_synthesizer_obj_get_sample_rate);
+
+const mp_obj_property_t audiosynth_synthesizer_sample_rate_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiosynth_synthesizer_get_sample_rate_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t audiosynth_synthesizer_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&audiosynth_synthesizer_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&audiosynth_synthesizer___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_press), MP_ROM_PTR(&audiosynth_synthesizer_press_obj) },
+    { MP_ROM_QSTR(MP_QSTR_release), MP_ROM_PTR(&audiosynth_synthesizer_release_obj) },
+    { MP_ROM_QSTR(MP_QSTR_release_all), MP_ROM_PTR(&audiosynth_synthesizer_release_all_obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_playing), MP_ROM_PTR(&audiosynth_synthesizer_playing_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sample_rate), MP_ROM_PTR(&audiosynth_synthesizer_sample_rate_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(audiosynth_synthesizer_locals_dict, audiosynth_synthesizer_locals_dict_table);
+
+STATIC const audiosample_p_t audiosynth_synthesizer_proto = {
+    MP_PROTO_IMPLEMENT(MP_QSTR_protocol_audiosample)
+    .sample_rate = (audiosample_sample_rate_fun)common_hal_audiosynth_synthesizer_get_sample_rate,
+    .bits_per_sample = (audiosample_bits_per_sample_fun)common_hal_audiosynth_synthesizer_get_bits_per_sample,
+    .channel_count = (audiosample_channel_count_fun)common_hal_audiosynth_synthesizer_get_channel_count,
+    .reset_buffer = (audiosample_reset_buffer_fun)audiosynth_synthesizer_reset_buffer,
+    .get_buffer = (audiosample_get_buffer_fun)audiosynth_synthesizer_get_buffer,
+    .get_buffer_structure = (audiosample_get_buffer_structure_fun)audiosynth_synthesizer_get_buffer_structure,
+};
+
+const mp_obj_type_t audiosynth_synthesizer_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Synthesizer,
+    .make_new = audiosynth_synthesizer_make_new,
+    .locals_dict = (mp_obj_dict_t*)&audiosynth_synthesizer_locals_dict,
+    .protocol = &audiosynth_synthesizer_proto,
+};
@@ -0,0 +1,60 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOSYNTH_SYNTHESIZER_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOSYNTH_SYNTHESIZER_H
+
+#include "shared-module/audiosynth/Synthesizer.h"
+
+extern const mp_obj_type_t audiosynth_synthesizer_type;
+
+// Envelope times are in seconds and sustain is a level from 0.0 to 1.0.
+void common_hal_audiosynth_synthesizer_construct(audiosynth_synthesizer_obj_t* self,
+                                                 mp_obj_t wavetable_obj,
+                                                 int16_t* wavetable,
+                                                 uint32_t wavetable_length,
+                                                 uint8_t voice_count,
+                                                 uint32_t buffer_size,
+                                                 uint32_t sample_rate,
+                                                 mp_float_t attack,
+                                                 mp_float_t decay,
+                                                 mp_float_t sustain,
+                                                 mp_float_t release);
+
+void common_hal_audiosynth_synthesizer_deinit(audiosynth_synthesizer_obj_t* self);
+bool common_hal_audiosynth_synthesizer_deinited(audiosynth_synthesizer_obj_t* self);
+
+void common_hal_audiosynth_synthesizer_press(audiosynth_synthesizer_obj_t* self, uint8_t voice,
+                                             mp_float_t frequency, mp_float_t velocity);
+void common_hal_audiosynth_synthesizer_release(audiosynth_synthesizer_obj_t* self, uint8_t voice);
+void common_hal_audiosynth_synthesizer_release_all(audiosynth_synthesizer_obj_t* self);
+
+bool common_hal_audiosynth_synthesizer_get_playing(audiosynth_synthesizer_obj_t* self);
+uint32_t common_hal_audiosynth_synthesizer_get_sample_rate(audiosynth_synthesizer_obj_t* self);
+uint8_t common_hal_audiosynth_synthesizer_get_channel_count(audiosynth_synthesizer_obj_t* self);
+uint8_t common_hal_audiosynth_synthesizer_get_bits_per_sample(audiosynth_synthesizer_obj_t* self);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOSYNTH_SYNTHESIZER_H
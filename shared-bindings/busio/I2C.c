@@ -193,7 +193,7 @@ MP_DEFINE_CONST_FUN_OBJ_1(busio_i2c_unlock_obj, busio_i2c_obj_unlock);
 //|      :param int start: Index to start writing at
 //|      :param int end: Index to write up to but not include. Defaults to ``len(buffer)``
 //|
-// Shared arg parsing for readfrom_into and writeto_then_readfrom.
+// Arg parsing for readfrom_into.
 STATIC void readfrom(busio_i2c_obj_t *self, mp_int_t address, mp_obj_t buffer, int32_t start, mp_int_t end) {
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(buffer, &bufinfo, MP_BUFFER_WRITE);
@@ -251,7 +251,7 @@ MP_DEFINE_CONST_FUN_OBJ_KW(busio_i2c_readfrom_into_obj, 3, busio_i2c_readfrom_in
 //|      :param bool stop: If true, output an I2C stop condition after the buffer is written.
 //|                        Deprecated. Will be removed in 6.x and act as stop=True.
 //|
-// Shared arg parsing for writeto and writeto_then_readfrom.
+// Arg parsing for writeto.
 STATIC void writeto(busio_i2c_obj_t *self, mp_int_t address, mp_obj_t buffer, int32_t start, mp_int_t end, bool stop) {
     // get the buffer to write the data from
     mp_buffer_info_t bufinfo;
@@ -289,6 +289,31 @@ STATIC mp_obj_t busio_i2c_writeto(size_t n_args, const mp_obj_t *pos_args, mp_ma
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(busio_i2c_writeto_obj, 1, busio_i2c_writeto);
 
+// Shared arg parsing for writeto_then_readfrom and read_registers.
+STATIC void write_read(busio_i2c_obj_t *self, mp_int_t address,
+                       mp_obj_t out_buffer, int32_t out_start, mp_int_t out_end,
+                       mp_obj_t in_buffer, int32_t in_start, mp_int_t in_end) {
+    mp_buffer_info_t out_bufinfo;
+    mp_get_buffer_raise(out_buffer, &out_bufinfo, MP_BUFFER_READ);
+    size_t out_length = out_bufinfo.len;
+    normalize_buffer_bounds(&out_start, out_end, &out_length);
+
+    mp_buffer_info_t in_bufinfo;
+    mp_get_buffer_raise(in_buffer, &in_bufinfo, MP_BUFFER_WRITE);
+    size_t in_length = in_bufinfo.len;
+    normalize_buffer_bounds(&in_start, in_end, &in_length);
+    if (in_length == 0) {
+        mp_raise_ValueError(translate("Buffer must be at least length 1"));
+    }
+
+    uint8_t status = common_hal_busio_i2c_write_read(self, address,
+                                                     ((uint8_t*) out_bufinfo.buf) + out_start, out_length,
+                                                     ((uint8_t*) in_bufinfo.buf) + in_start, in_length);
+    if (status != 0) {
+        mp_raise_OSError(status);
+    }
+}
+
 //|   .. method:: writeto_then_readfrom(address, out_buffer, in_buffer, *, out_start=0, out_end=None, in_start=0, in_end=None)
 //|
 //|      Write the bytes from ``out_buffer`` to the slave specified by ``address``, generate no stop
@@ -324,15 +349,43 @@ STATIC mp_obj_t busio_i2c_writeto_then_readfrom(size_t n_args, const mp_obj_t *p
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
-    writeto(self, args[ARG_address].u_int, args[ARG_out_buffer].u_obj, args[ARG_out_start].u_int,
-            args[ARG_out_end].u_int, false);
-    readfrom(self, args[ARG_address].u_int, args[ARG_in_buffer].u_obj, args[ARG_in_start].u_int,
-             args[ARG_in_end].u_int);
+    write_read(self, args[ARG_address].u_int,
+               args[ARG_out_buffer].u_obj, args[ARG_out_start].u_int, args[ARG_out_end].u_int,
+               args[ARG_in_buffer].u_obj, args[ARG_in_start].u_int, args[ARG_in_end].u_int);
 
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(busio_i2c_writeto_then_readfrom_obj, 3, busio_i2c_writeto_then_readfrom);
 
+//|   .. method:: read_registers(address, registers)
+//|
+//|      Do a `writeto_then_readfrom` for each ``(out_buffer, in_buffer)`` pair in ``registers``,
+//|      such as a register address and the buffer for its value, in one call. This saves the
+//|      overhead of a call per register when polling several registers of a sensor.
+//|      Use a `memoryview` to read into part of a buffer.
+//|
+//|      :param int address: 7-bit device address
+//|      :param list registers: ``(out_buffer, in_buffer)`` pairs to write and then read
+//|
+STATIC mp_obj_t busio_i2c_read_registers(mp_obj_t self_in, mp_obj_t address_in, mp_obj_t registers_in) {
+    busio_i2c_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    check_lock(self);
+    mp_int_t address = mp_obj_get_int(address_in);
+
+    size_t count;
+    mp_obj_t *registers;
+    mp_obj_get_array(registers_in, &count, &registers);
+    for (size_t i = 0; i < count; i++) {
+        mp_obj_t *buffers;
+        mp_obj_get_array_fixed_n(registers[i], 2, &buffers);
+        write_read(self, address, buffers[0], 0, INT_MAX, buffers[1], 0, INT_MAX);
+    }
+
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_3(busio_i2c_read_registers_obj, busio_i2c_read_registers);
+
 STATIC const mp_rom_map_elem_t busio_i2c_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&busio_i2c_deinit_obj) },
     { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
@@ -345,6 +398,7 @@ STATIC const mp_rom_map_elem_t busio_i2c_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_readfrom_into), MP_ROM_PTR(&busio_i2c_readfrom_into_obj) },
     { MP_ROM_QSTR(MP_QSTR_writeto), MP_ROM_PTR(&busio_i2c_writeto_obj) },
     { MP_ROM_QSTR(MP_QSTR_writeto_then_readfrom), MP_ROM_PTR(&busio_i2c_writeto_then_readfrom_obj) },
+    { MP_ROM_QSTR(MP_QSTR_read_registers), MP_ROM_PTR(&busio_i2c_read_registers_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(busio_i2c_locals_dict, busio_i2c_locals_dict_table);
@@ -69,6 +69,12 @@ extern uint8_t common_hal_busio_i2c_write(busio_i2c_obj_t *self, uint16_t addres
 extern uint8_t common_hal_busio_i2c_read(busio_i2c_obj_t *self, uint16_t address,
                                             uint8_t * data, size_t len);
 
+// Writes out_data without a stop bit and then reads into in_data after a repeated start, as one
+// transaction. Returns 0 on success or an appropriate error code from mperrno.h
+extern uint8_t common_hal_busio_i2c_write_read(busio_i2c_obj_t *self, uint16_t address,
+                                                  const uint8_t * out_data, size_t out_len,
+                                                  uint8_t * in_data, size_t in_len);
+
 // This is used by the supervisor to claim I2C devices indefinitely.
 extern void common_hal_busio_i2c_never_reset(busio_i2c_obj_t *self);
 
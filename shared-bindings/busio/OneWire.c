@@ -44,12 +44,20 @@
 //|
 //| Protocol definition is here: https://www.maximintegrated.com/en/app-notes/index.mvp/id/126
 //|
-//| .. class:: OneWire(pin)
+//| .. class:: OneWire(pin, *, rx=None)
 //|
 //|   Create a OneWire object associated with the given pin. The object
 //|   implements the lowest level timing-sensitive bits of the protocol.
 //|
+//|   Normally the bus is bitbanged, with interrupts off for each bit. When
+//|   ``rx`` is given, the time slots are generated by a UART instead, so
+//|   interrupts stay on and multi-byte transfers run in the background. ``pin``
+//|   is then the UART TX, which must pull the bus low through a Schottky diode
+//|   (cathode to TX) or an open-drain buffer, and ``rx`` connects straight to
+//|   the bus. The pins must be usable together by `busio.UART`.
+//|
 //|   :param ~microcontroller.Pin pin: Pin connected to the OneWire bus
+//|   :param ~microcontroller.Pin rx: UART RX pin connected to the OneWire bus
 //|
 //|   Read a short series of pulses::
 //|
@@ -63,20 +71,24 @@
 //|     print(onewire.read_bit())
 //|
 STATIC mp_obj_t busio_onewire_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
-    enum { ARG_pin };
+    enum { ARG_pin, ARG_rx };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_pin, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_rx, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
     assert_pin(args[ARG_pin].u_obj, false);
     const mcu_pin_obj_t* pin = MP_OBJ_TO_PTR(args[ARG_pin].u_obj);
     assert_pin_free(pin);
+    assert_pin(args[ARG_rx].u_obj, true);
+    const mcu_pin_obj_t* rx = MP_OBJ_TO_PTR(args[ARG_rx].u_obj);
+    assert_pin_free(rx);
 
     busio_onewire_obj_t *self = m_new_obj(busio_onewire_obj_t);
     self->base.type = &busio_onewire_type;
 
-    common_hal_busio_onewire_construct(self, pin);
+    common_hal_busio_onewire_construct(self, pin, rx);
     return MP_OBJ_FROM_PTR(self);
 }
 
@@ -158,6 +170,65 @@ STATIC mp_obj_t busio_onewire_obj_write_bit(mp_obj_t self_in, mp_obj_t bool_obj)
 }
 MP_DEFINE_CONST_FUN_OBJ_2(busio_onewire_write_bit_obj, busio_onewire_obj_write_bit);
 
+//|   .. method:: readinto(buf)
+//|
+//|     Read bytes into ``buf``, least significant bit first.
+//|
+//|     :param bytearray buf: buffer to fill
+//|
+STATIC mp_obj_t busio_onewire_obj_readinto(mp_obj_t self_in, mp_obj_t buf_in) {
+    busio_onewire_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_WRITE);
+    common_hal_busio_onewire_read(self, bufinfo.buf, bufinfo.len);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(busio_onewire_readinto_obj, busio_onewire_obj_readinto);
+
+//|   .. method:: write(buf)
+//|
+//|     Write the bytes in ``buf``, least significant bit first.
+//|
+//|     :param bytearray buf: bytes to write
+//|
+STATIC mp_obj_t busio_onewire_obj_write(mp_obj_t self_in, mp_obj_t buf_in) {
+    busio_onewire_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_READ);
+    common_hal_busio_onewire_write(self, bufinfo.buf, bufinfo.len);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(busio_onewire_write_obj, busio_onewire_obj_write);
+
+//|   .. method:: scan()
+//|
+//|     Run the ROM search and return the 8 byte ROM code of every device on
+//|     the bus. The search stops early at a ROM code that fails its CRC.
+//|
+//|     :return: List of ROM codes as `bytes`
+//|     :rtype: list
+//|
+STATIC mp_obj_t busio_onewire_obj_scan(mp_obj_t self_in) {
+    busio_onewire_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    uint8_t rom[8] = {0};
+    uint8_t last_discrepancy = 0;
+    do {
+        if (!common_hal_busio_onewire_search(self, rom, &last_discrepancy)) {
+            break;
+        }
+        mp_obj_list_append(list, mp_obj_new_bytes(rom, sizeof(rom)));
+    } while (last_discrepancy != 0);
+    return list;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(busio_onewire_scan_obj, busio_onewire_obj_scan);
+
 STATIC const mp_rom_map_elem_t busio_onewire_locals_dict_table[] = {
     // Methods
     { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&busio_onewire_deinit_obj) },
@@ -166,6 +237,9 @@ STATIC const mp_rom_map_elem_t busio_onewire_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&busio_onewire_reset_obj) },
     { MP_ROM_QSTR(MP_QSTR_read_bit), MP_ROM_PTR(&busio_onewire_read_bit_obj) },
     { MP_ROM_QSTR(MP_QSTR_write_bit), MP_ROM_PTR(&busio_onewire_write_bit_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&busio_onewire_readinto_obj) },
+    { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&busio_onewire_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_scan), MP_ROM_PTR(&busio_onewire_scan_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(busio_onewire_locals_dict, busio_onewire_locals_dict_table);
 
@@ -99,9 +99,27 @@ STATIC mp_obj_t busio_spi_make_new(const mp_obj_type_t *type, size_t n_args, con
 //|
 //|      Turn off the SPI bus.
 //|
+// Keeps the buffer of a background transfer from being collected until the
+// transfer is done.
+STATIC void pin_transfer_buffer(busio_spi_obj_t *self, mp_obj_t buffer) {
+    if (MP_STATE_VM(busio_spi_transfers) == MP_OBJ_NULL) {
+        MP_STATE_VM(busio_spi_transfers) = mp_obj_new_dict(1);
+    }
+    mp_obj_dict_store(MP_STATE_VM(busio_spi_transfers), MP_OBJ_FROM_PTR(self), buffer);
+}
+
+STATIC void unpin_transfer_buffer(busio_spi_obj_t *self) {
+    if (MP_STATE_VM(busio_spi_transfers) == MP_OBJ_NULL) {
+        return;
+    }
+    mp_map_lookup(mp_obj_dict_get_map(MP_STATE_VM(busio_spi_transfers)), MP_OBJ_FROM_PTR(self),
+                  MP_MAP_LOOKUP_REMOVE_IF_FOUND);
+}
+
 STATIC mp_obj_t busio_spi_obj_deinit(mp_obj_t self_in) {
     busio_spi_obj_t *self = MP_OBJ_TO_PTR(self_in);
     common_hal_busio_spi_deinit(self);
+    unpin_transfer_buffer(self);
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_1(busio_spi_deinit_obj, busio_spi_obj_deinit);
@@ -120,6 +138,7 @@ MP_DEFINE_CONST_FUN_OBJ_1(busio_spi_deinit_obj, busio_spi_obj_deinit);
 STATIC mp_obj_t busio_spi_obj___exit__(size_t n_args, const mp_obj_t *args) {
     (void)n_args;
     common_hal_busio_spi_deinit(args[0]);
+    unpin_transfer_buffer(MP_OBJ_TO_PTR(args[0]));
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(busio_spi_obj___exit___obj, 4, 4, busio_spi_obj___exit__);
@@ -366,6 +385,199 @@ STATIC mp_obj_t busio_spi_write_readinto(size_t n_args, const mp_obj_t *pos_args
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(busio_spi_write_readinto_obj, 2, busio_spi_write_readinto);
 
+//|   .. method:: transaction(segments, *, write_value=0)
+//|
+//|     Run a sequence of writes and reads back to back, such as a command
+//|     followed by its data, without copying the buffers together first.
+//|     ``segments`` is a list of ``(buffer_out, buffer_in)`` tuples. A segment
+//|     with ``buffer_in`` of ``None`` only writes and one with ``buffer_out``
+//|     of ``None`` only reads, writing ``write_value`` for each byte read. When
+//|     both are given they must be the same length, as in `write_readinto`.
+//|     Use a `memoryview` to send or receive part of a buffer.
+//|     The SPI object must be locked.
+//|
+//|     :param list segments: The ``(buffer_out, buffer_in)`` segments in order
+//|     :param int write_value: Value to write while reading. (Usually ignored.)
+//|
+STATIC mp_obj_t busio_spi_transaction(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_segments, ARG_write_value };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_segments,   MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_write_value,MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+    };
+    busio_spi_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    check_for_deinit(self);
+    check_lock(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    size_t count;
+    mp_obj_t *items;
+    mp_obj_get_array(args[ARG_segments].u_obj, &count, &items);
+    if (count == 0) {
+        return mp_const_none;
+    }
+
+    busio_spi_segment_t *segments = m_new(busio_spi_segment_t, count);
+    for (size_t i = 0; i < count; i++) {
+        mp_obj_t *buffers;
+        mp_obj_get_array_fixed_n(items[i], 2, &buffers);
+        busio_spi_segment_t *segment = &segments[i];
+        segment->out = NULL;
+        segment->in = NULL;
+        if (buffers[0] != mp_const_none) {
+            mp_buffer_info_t bufinfo;
+            mp_get_buffer_raise(buffers[0], &bufinfo, MP_BUFFER_READ);
+            segment->out = bufinfo.buf;
+            segment->len = bufinfo.len;
+        }
+        // A segment with neither buffer fails here.
+        if (buffers[1] != mp_const_none || segment->out == NULL) {
+            mp_buffer_info_t bufinfo;
+            mp_get_buffer_raise(buffers[1], &bufinfo, MP_BUFFER_WRITE);
+            if (segment->out != NULL && bufinfo.len != segment->len) {
+                mp_raise_ValueError(translate("buffer slices must be of equal length"));
+            }
+            segment->in = bufinfo.buf;
+            segment->len = bufinfo.len;
+        }
+    }
+
+    bool ok = common_hal_busio_spi_transaction(self, segments, count, args[ARG_write_value].u_int);
+    m_del(busio_spi_segment_t, segments, count);
+    // Any background transfer finished before the transaction started.
+    unpin_transfer_buffer(self);
+    if (!ok) {
+        mp_raise_OSError(MP_EIO);
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(busio_spi_transaction_obj, 2, busio_spi_transaction);
+
+//|   .. method:: start_write(buffer, *, start=0, end=None)
+//|
+//|     Start writing out the data in ``buffer`` and return without waiting for
+//|     it to be sent, so that the code can carry on while the hardware sends it.
+//|     Use `done` or `wait` to find out when it's sent. ``buffer`` must not be
+//|     changed until then. Other SPI calls wait for the transfer to finish first.
+//|     The SPI object must be locked. Boards that can't transfer in the
+//|     background send the data before returning.
+//|
+//|     :param bytearray buffer: Write out the data in this buffer
+//|     :param int start: Start of the slice of ``buffer`` to write out: ``buffer[start:end]``
+//|     :param int end: End of the slice; this index is not included. Defaults to ``len(buffer)``
+//|
+STATIC mp_obj_t busio_spi_start_write(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_buffer, ARG_start, ARG_end };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_buffer,     MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_start,      MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_end,        MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = INT_MAX} },
+    };
+    busio_spi_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    check_for_deinit(self);
+    check_lock(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[ARG_buffer].u_obj, &bufinfo, MP_BUFFER_READ);
+    int32_t start = args[ARG_start].u_int;
+    size_t length = bufinfo.len;
+    normalize_buffer_bounds(&start, args[ARG_end].u_int, &length);
+
+    if (length == 0) {
+        return mp_const_none;
+    }
+
+    pin_transfer_buffer(self, args[ARG_buffer].u_obj);
+    bool ok = common_hal_busio_spi_start_write(self, ((uint8_t*)bufinfo.buf) + start, length);
+    if (!ok) {
+        unpin_transfer_buffer(self);
+        mp_raise_OSError(MP_EIO);
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(busio_spi_start_write_obj, 2, busio_spi_start_write);
+
+//|   .. method:: start_readinto(buffer, *, start=0, end=None, write_value=0)
+//|
+//|     Start reading into ``buffer`` while writing ``write_value`` for each byte
+//|     read, and return without waiting for the data. ``buffer`` holds the data
+//|     once `done` returns ``True`` or `wait` returns. Otherwise the same as
+//|     `start_write`.
+//|
+//|     :param bytearray buffer: Read data into this buffer
+//|     :param int start: Start of the slice of ``buffer`` to read into: ``buffer[start:end]``
+//|     :param int end: End of the slice; this index is not included. Defaults to ``len(buffer)``
+//|     :param int write_value: Value to write while reading. (Usually ignored.)
+//|
+STATIC mp_obj_t busio_spi_start_readinto(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_buffer, ARG_start, ARG_end, ARG_write_value };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_buffer,     MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_start,      MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_end,        MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = INT_MAX} },
+        { MP_QSTR_write_value,MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+    };
+    busio_spi_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    check_for_deinit(self);
+    check_lock(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[ARG_buffer].u_obj, &bufinfo, MP_BUFFER_WRITE);
+    int32_t start = args[ARG_start].u_int;
+    size_t length = bufinfo.len;
+    normalize_buffer_bounds(&start, args[ARG_end].u_int, &length);
+
+    if (length == 0) {
+        return mp_const_none;
+    }
+
+    pin_transfer_buffer(self, args[ARG_buffer].u_obj);
+    bool ok = common_hal_busio_spi_start_read(self, ((uint8_t*)bufinfo.buf) + start, length, args[ARG_write_value].u_int);
+    if (!ok) {
+        unpin_transfer_buffer(self);
+        mp_raise_OSError(MP_EIO);
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(busio_spi_start_readinto_obj, 2, busio_spi_start_readinto);
+
+//|   .. method:: done()
+//|
+//|     Returns ``True`` once the transfer started by `start_write` or
+//|     `start_readinto` has finished, or if there isn't one.
+//|
+STATIC mp_obj_t busio_spi_done(mp_obj_t self_in) {
+    busio_spi_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    if (common_hal_busio_spi_transfer_in_progress(self)) {
+        return mp_const_false;
+    }
+    unpin_transfer_buffer(self);
+    return mp_const_true;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(busio_spi_done_obj, busio_spi_done);
+
+//|   .. method:: wait()
+//|
+//|     Wait for the transfer started by `start_write` or `start_readinto` to
+//|     finish. Background tasks keep running while waiting.
+//|
+STATIC mp_obj_t busio_spi_wait(mp_obj_t self_in) {
+    busio_spi_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    while (common_hal_busio_spi_transfer_in_progress(self)) {
+        RUN_BACKGROUND_TASKS;
+    }
+    unpin_transfer_buffer(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(busio_spi_wait_obj, busio_spi_wait);
+
 //|   .. attribute:: frequency
 //|
 //|     The actual SPI bus frequency. This may not match the frequency requested
@@ -397,6 +609,11 @@ STATIC const mp_rom_map_elem_t busio_spi_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&busio_spi_readinto_obj) },
     { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&busio_spi_write_obj) },
     { MP_ROM_QSTR(MP_QSTR_write_readinto), MP_ROM_PTR(&busio_spi_write_readinto_obj) },
+    { MP_ROM_QSTR(MP_QSTR_transaction), MP_ROM_PTR(&busio_spi_transaction_obj) },
+    { MP_ROM_QSTR(MP_QSTR_start_write), MP_ROM_PTR(&busio_spi_start_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_start_readinto), MP_ROM_PTR(&busio_spi_start_readinto_obj) },
+    { MP_ROM_QSTR(MP_QSTR_done), MP_ROM_PTR(&busio_spi_done_obj) },
+    { MP_ROM_QSTR(MP_QSTR_wait), MP_ROM_PTR(&busio_spi_wait_obj) },
     { MP_ROM_QSTR(MP_QSTR_frequency), MP_ROM_PTR(&busio_spi_frequency_obj) }
 };
 STATIC MP_DEFINE_CONST_DICT(busio_spi_locals_dict, busio_spi_locals_dict_table);
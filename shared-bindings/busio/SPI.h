@@ -52,12 +52,35 @@ extern void common_hal_busio_spi_unlock(busio_spi_obj_t *self);
 // Writes out the given data.
 extern bool common_hal_busio_spi_write(busio_spi_obj_t *self, const uint8_t *data, size_t len);
 
+// Starts writing out the given data and may return before the transfer is done. data must stay
+// valid until common_hal_busio_spi_transfer_in_progress() returns false. Ports without background
+// transfers finish the write before returning.
+extern bool common_hal_busio_spi_start_write(busio_spi_obj_t *self, const uint8_t *data, size_t len);
+
+// Starts reading in len bytes while outputting write_value, like common_hal_busio_spi_start_write.
+extern bool common_hal_busio_spi_start_read(busio_spi_obj_t *self, uint8_t *data, size_t len, uint8_t write_value);
+
+// Returns true while a transfer started by common_hal_busio_spi_start_write or
+// common_hal_busio_spi_start_read is still going. Other calls wait for it to finish first.
+extern bool common_hal_busio_spi_transfer_in_progress(busio_spi_obj_t *self);
+
 // Reads in len bytes while outputting zeroes.
 extern bool common_hal_busio_spi_read(busio_spi_obj_t *self, uint8_t *data, size_t len, uint8_t write_value);
 
 // Reads and write len bytes simultaneously.
 extern bool common_hal_busio_spi_transfer(busio_spi_obj_t *self, uint8_t *data_out, uint8_t *data_in, size_t len);
 
+// One part of a transaction. out is NULL to send the write value and in is NULL to ignore what's
+// read.
+typedef struct _busio_spi_segment_t {
+    const uint8_t *out;
+    uint8_t *in;
+    size_t len;
+} busio_spi_segment_t;
+
+// Runs the segments back to back without copying them together first.
+extern bool common_hal_busio_spi_transaction(busio_spi_obj_t *self, const busio_spi_segment_t *segments, size_t count, uint8_t write_value);
+
 // Return actual SPI bus frequency.
 uint32_t common_hal_busio_spi_get_frequency(busio_spi_obj_t* self);
 
@@ -202,6 +202,14 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(busio_uart___exit___obj, 4, 4, busio_
 //|     :return: the number of bytes written
 //|     :rtype: int or None
 //|
+//|   .. method:: writev(bufs)
+//|
+//|     Write each buffer in the list or tuple ``bufs`` in turn, such as a
+//|     header and a payload, without joining them first.
+//|
+//|     :return: the number of bytes written
+//|     :rtype: int
+//|
 
 // These three methods are used by the shared stream methods.
 STATIC mp_uint_t busio_uart_read(mp_obj_t self_in, void *buf_in, mp_uint_t size, int *errcode) {
@@ -290,6 +298,26 @@ const mp_obj_property_t busio_uart_in_waiting_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+//|   .. attribute:: rx_overruns
+//|
+//|     The number of times received bytes were lost because the input buffer
+//|     filled up before they were read. A bigger ``receiver_buffer_size`` or
+//|     reading more often helps. (read-only)
+//|
+STATIC mp_obj_t busio_uart_obj_get_rx_overruns(mp_obj_t self_in) {
+    busio_uart_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_int_from_uint(common_hal_busio_uart_get_rx_overruns(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(busio_uart_get_rx_overruns_obj, busio_uart_obj_get_rx_overruns);
+
+const mp_obj_property_t busio_uart_rx_overruns_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&busio_uart_get_rx_overruns_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 //|   .. attribute:: timeout
 //|
 //|     The current timeout, in seconds (float).
@@ -384,12 +412,14 @@ STATIC const mp_rom_map_elem_t busio_uart_locals_dict_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_readline), MP_ROM_PTR(&mp_stream_unbuffered_readline_obj)},
     { MP_OBJ_NEW_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&mp_stream_readinto_obj) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_write),    MP_ROM_PTR(&mp_stream_write_obj) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_writev),   MP_ROM_PTR(&mp_stream_writev_obj) },
 
     { MP_OBJ_NEW_QSTR(MP_QSTR_reset_input_buffer), MP_ROM_PTR(&busio_uart_reset_input_buffer_obj) },
 
     // Properties
     { MP_ROM_QSTR(MP_QSTR_baudrate),     MP_ROM_PTR(&busio_uart_baudrate_obj) },
     { MP_ROM_QSTR(MP_QSTR_in_waiting),   MP_ROM_PTR(&busio_uart_in_waiting_obj) },
+    { MP_ROM_QSTR(MP_QSTR_rx_overruns),  MP_ROM_PTR(&busio_uart_rx_overruns_obj) },
     { MP_ROM_QSTR(MP_QSTR_timeout),      MP_ROM_PTR(&busio_uart_timeout_obj) },
 
     // Nested Enum-like Classes.
@@ -0,0 +1,171 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/microcontroller/Pin.h"
+#include "shared-bindings/countio/Counter.h"
+#include "shared-bindings/util.h"
+
+//| .. currentmodule:: countio
+//|
+//| :class:`Counter` -- Count rising edges
+//| ======================================
+//|
+//| Counter counts the rising edges of a digital signal in hardware. The CPU
+//| isn't involved with the edges at all, so signals of 100kHz and more can be
+//| counted while the program does other things.
+//|
+//| .. class:: Counter(pin)
+//|
+//|   Create a Counter object associated with the given pin. It starts counting
+//|   from zero straight away.
+//|
+//|   :param ~microcontroller.Pin pin: Pin to count edges on.
+//|
+//|   Count the pulses of a flow meter::
+//|
+//|     import countio
+//|     import time
+//|     import board
+//|
+//|     flow = countio.Counter(board.D11)
+//|
+//|     while True:
+//|         time.sleep(10)
+//|         print(flow.reset() / 450, "litres in the last 10 seconds")
+//|
+STATIC mp_obj_t countio_counter_make_new(const mp_obj_type_t *type, size_t n_args,
+         const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_pin };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_pin, MP_ARG_REQUIRED | MP_ARG_OBJ },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    assert_pin(args[ARG_pin].u_obj, false);
+    mcu_pin_obj_t* pin = MP_OBJ_TO_PTR(args[ARG_pin].u_obj);
+    assert_pin_free(pin);
+
+    countio_counter_obj_t *self = m_new_obj(countio_counter_obj_t);
+    self->base.type = &countio_counter_type;
+
+    common_hal_countio_counter_construct(self, pin);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Deinitialises the Counter and releases any hardware resources for reuse.
+//|
+STATIC mp_obj_t countio_counter_deinit(mp_obj_t self_in) {
+    countio_counter_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_countio_counter_deinit(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(countio_counter_deinit_obj, countio_counter_deinit);
+
+STATIC void check_for_deinit(countio_counter_obj_t *self) {
+    if (common_hal_countio_counter_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes the hardware when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t countio_counter_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_countio_counter_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(countio_counter___exit___obj, 4, 4, countio_counter_obj___exit__);
+
+//|   .. attribute:: count
+//|
+//|     The number of rising edges since the Counter was created or last reset.
+//|     It wraps around to 0 after 2**32 - 1.
+//|
+STATIC mp_obj_t countio_counter_obj_get_count(mp_obj_t self_in) {
+    countio_counter_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+
+    return mp_obj_new_int_from_uint(common_hal_countio_counter_get_count(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(countio_counter_get_count_obj, countio_counter_obj_get_count);
+
+const mp_obj_property_t countio_counter_count_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&countio_counter_get_count_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. method:: reset()
+//|
+//|     Return `count` and start counting again from zero. No edge is lost or
+//|     counted twice between the two, so calling this periodically gives exact
+//|     counts for each period.
+//|
+STATIC mp_obj_t countio_counter_obj_reset(mp_obj_t self_in) {
+    countio_counter_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+
+    return mp_obj_new_int_from_uint(common_hal_countio_counter_reset(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(countio_counter_reset_obj, countio_counter_obj_reset);
+
+STATIC const mp_rom_map_elem_t countio_counter_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&countio_counter_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&countio_counter___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&countio_counter_reset_obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_count), MP_ROM_PTR(&countio_counter_count_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(countio_counter_locals_dict, countio_counter_locals_dict_table);
+
+const mp_obj_type_t countio_counter_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Counter,
+    .make_new = countio_counter_make_new,
+    .locals_dict = (mp_obj_dict_t*)&countio_counter_locals_dict,
+};
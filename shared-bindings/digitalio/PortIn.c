@@ -0,0 +1,157 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/digitalio/__init__.h"
+#include "shared-bindings/digitalio/PortIn.h"
+#include "shared-bindings/digitalio/Pull.h"
+#include "shared-bindings/util.h"
+
+//| .. currentmodule:: digitalio
+//|
+//| :class:`PortIn` -- read several pins at once
+//| ============================================
+//|
+//| PortIn reads a group of input pins with a single register access. All of the pins must be
+//| on the same GPIO port of the microcontroller.
+//|
+//| .. class:: PortIn(pins, *, pull=None)
+//|
+//|   Create a PortIn object associated with the given pins.
+//|
+//|   :param ~microcontroller.Pin pins: Sequence of up to 32 pins. The first pin is bit 0 of
+//|     `value`.
+//|   :param Pull pull: pull configuration for all of the pins
+//|
+//|   For example, to read the columns of a key matrix::
+//|
+//|     import digitalio
+//|     import board
+//|
+//|     columns = digitalio.PortIn((board.D5, board.D6, board.D9, board.D10),
+//|                                pull=digitalio.Pull.UP)
+//|     print(bin(columns.value))
+//|
+STATIC mp_obj_t digitalio_portin_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_pins, ARG_pull };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_pins, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_pull, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = mp_const_none} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    const mcu_pin_obj_t* pins[DIGITALIO_PORT_MAX_PINS];
+    size_t num_pins = digitalio_validate_port_pins(args[ARG_pins].u_obj, pins);
+
+    digitalio_pull_t pull = PULL_NONE;
+    if (args[ARG_pull].u_rom_obj == &digitalio_pull_up_obj) {
+        pull = PULL_UP;
+    } else if (args[ARG_pull].u_rom_obj == &digitalio_pull_down_obj) {
+        pull = PULL_DOWN;
+    }
+
+    digitalio_portin_obj_t *self = m_new_obj(digitalio_portin_obj_t);
+    self->base.type = &digitalio_portin_type;
+    common_hal_digitalio_portin_construct(self, pins, num_pins, pull);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Turn off the PortIn and release the pins for other use.
+//|
+STATIC mp_obj_t digitalio_portin_deinit(mp_obj_t self_in) {
+    digitalio_portin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_digitalio_portin_deinit(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(digitalio_portin_deinit_obj, digitalio_portin_deinit);
+
+STATIC void check_for_deinit(digitalio_portin_obj_t *self) {
+    if (common_hal_digitalio_portin_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes the hardware when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t digitalio_portin_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_digitalio_portin_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(digitalio_portin___exit___obj, 4, 4, digitalio_portin_obj___exit__);
+
+//|   .. attribute:: value
+//|
+//|     The levels of all of the pins as an int. Bit n is the level of the nth pin. (read-only)
+//|
+STATIC mp_obj_t digitalio_portin_obj_get_value(mp_obj_t self_in) {
+    digitalio_portin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_int_from_uint(common_hal_digitalio_portin_get_value(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(digitalio_portin_get_value_obj, digitalio_portin_obj_get_value);
+
+const mp_obj_property_t digitalio_portin_value_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&digitalio_portin_get_value_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t digitalio_portin_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&digitalio_portin_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&digitalio_portin___exit___obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_value), MP_ROM_PTR(&digitalio_portin_value_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(digitalio_portin_locals_dict, digitalio_portin_locals_dict_table);
+
+const mp_obj_type_t digitalio_portin_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_PortIn,
+    .make_new = digitalio_portin_make_new,
+    .locals_dict = (mp_obj_dict_t*)&digitalio_portin_locals_dict,
+};
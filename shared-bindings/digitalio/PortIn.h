@@ -0,0 +1,42 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_DIGITALIO_PORTIN_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_DIGITALIO_PORTIN_H
+
+#include "common-hal/digitalio/PortIn.h"
+#include "common-hal/microcontroller/Pin.h"
+#include "shared-bindings/digitalio/Pull.h"
+
+extern const mp_obj_type_t digitalio_portin_type;
+
+void common_hal_digitalio_portin_construct(digitalio_portin_obj_t* self,
+    const mcu_pin_obj_t** pins, size_t num_pins, digitalio_pull_t pull);
+void common_hal_digitalio_portin_deinit(digitalio_portin_obj_t* self);
+bool common_hal_digitalio_portin_deinited(digitalio_portin_obj_t* self);
+uint32_t common_hal_digitalio_portin_get_value(digitalio_portin_obj_t* self);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_DIGITALIO_PORTIN_H
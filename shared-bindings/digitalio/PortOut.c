@@ -0,0 +1,211 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/binary.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/digitalio/__init__.h"
+#include "shared-bindings/digitalio/PortOut.h"
+#include "shared-bindings/util.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: digitalio
+//|
+//| :class:`PortOut` -- write several pins at once
+//| ==============================================
+//|
+//| PortOut drives a group of output pins with a single register access, so they all change at
+//| the same time. All of the pins must be on the same GPIO port of the microcontroller.
+//|
+//| .. class:: PortOut(pins, *, value=0)
+//|
+//|   Create a PortOut object associated with the given pins and start driving them.
+//|
+//|   :param ~microcontroller.Pin pins: Sequence of up to 32 pins. The first pin is bit 0 of
+//|     `value`.
+//|   :param int value: initial levels of the pins
+//|
+//|   For example, to put a byte on an 8 bit bus and strobe it::
+//|
+//|     import digitalio
+//|     import board
+//|
+//|     bus = digitalio.PortOut([getattr(board, "D" + str(i)) for i in range(8)])
+//|     strobe = digitalio.DigitalInOut(board.D9)
+//|     strobe.switch_to_output()
+//|     bus.value = 0x5a
+//|     strobe.value = True
+//|     strobe.value = False
+//|
+STATIC mp_obj_t digitalio_portout_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_pins, ARG_value };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_pins, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_value, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    const mcu_pin_obj_t* pins[DIGITALIO_PORT_MAX_PINS];
+    size_t num_pins = digitalio_validate_port_pins(args[ARG_pins].u_obj, pins);
+
+    digitalio_portout_obj_t *self = m_new_obj(digitalio_portout_obj_t);
+    self->base.type = &digitalio_portout_type;
+    common_hal_digitalio_portout_construct(self, pins, num_pins, args[ARG_value].u_int);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Turn off the PortOut and release the pins for other use.
+//|
+STATIC mp_obj_t digitalio_portout_deinit(mp_obj_t self_in) {
+    digitalio_portout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_digitalio_portout_deinit(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(digitalio_portout_deinit_obj, digitalio_portout_deinit);
+
+STATIC void check_for_deinit(digitalio_portout_obj_t *self) {
+    if (common_hal_digitalio_portout_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes the hardware when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t digitalio_portout_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_digitalio_portout_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(digitalio_portout___exit___obj, 4, 4, digitalio_portout_obj___exit__);
+
+//|   .. method:: write_sequence(values, *, rate)
+//|
+//|     Write each of the values in turn, ``rate`` times a second, and return once the last one
+//|     has been written. The timing is kept by hardware rather than by the VM.
+//|
+//|     :param array.array values: values to write. The typecode must be ``'B'``, ``'H'`` or
+//|       ``'I'``, or ``values`` can be a `bytes` or `bytearray`.
+//|     :param int rate: values per second
+//|
+STATIC mp_obj_t digitalio_portout_obj_write_sequence(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_values, ARG_rate };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_values, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_rate, MP_ARG_KW_ONLY | MP_ARG_REQUIRED | MP_ARG_INT },
+    };
+    digitalio_portout_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    check_for_deinit(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[ARG_values].u_obj, &bufinfo, MP_BUFFER_READ);
+    uint8_t bytes_per_value;
+    switch (bufinfo.typecode) {
+        case 'B':
+        case BYTEARRAY_TYPECODE:
+            bytes_per_value = 1;
+            break;
+        case 'H':
+            bytes_per_value = 2;
+            break;
+        case 'I':
+            bytes_per_value = 4;
+            break;
+        default:
+            mp_raise_ValueError(translate("bad typecode"));
+    }
+    mp_int_t rate = args[ARG_rate].u_int;
+    if (rate <= 0) {
+        mp_raise_ValueError(translate("Sample rate must be positive"));
+    }
+
+    common_hal_digitalio_portout_write_sequence(self, bufinfo.buf, bufinfo.len / bytes_per_value,
+        bytes_per_value, rate);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(digitalio_portout_write_sequence_obj, 1, digitalio_portout_obj_write_sequence);
+
+//|   .. attribute:: value
+//|
+//|     The levels of all of the pins as an int. Bit n is the level of the nth pin.
+//|
+STATIC mp_obj_t digitalio_portout_obj_get_value(mp_obj_t self_in) {
+    digitalio_portout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_int_from_uint(common_hal_digitalio_portout_get_value(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(digitalio_portout_get_value_obj, digitalio_portout_obj_get_value);
+
+STATIC mp_obj_t digitalio_portout_obj_set_value(mp_obj_t self_in, mp_obj_t value) {
+    digitalio_portout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_digitalio_portout_set_value(self, mp_obj_get_int_truncated(value));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(digitalio_portout_set_value_obj, digitalio_portout_obj_set_value);
+
+const mp_obj_property_t digitalio_portout_value_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&digitalio_portout_get_value_obj,
+              (mp_obj_t)&digitalio_portout_set_value_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t digitalio_portout_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&digitalio_portout_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&digitalio_portout___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_write_sequence), MP_ROM_PTR(&digitalio_portout_write_sequence_obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_value), MP_ROM_PTR(&digitalio_portout_value_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(digitalio_portout_locals_dict, digitalio_portout_locals_dict_table);
+
+const mp_obj_type_t digitalio_portout_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_PortOut,
+    .make_new = digitalio_portout_make_new,
+    .locals_dict = (mp_obj_dict_t*)&digitalio_portout_locals_dict,
+};
@@ -0,0 +1,46 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_DIGITALIO_PORTOUT_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_DIGITALIO_PORTOUT_H
+
+#include "common-hal/digitalio/PortOut.h"
+#include "common-hal/microcontroller/Pin.h"
+
+extern const mp_obj_type_t digitalio_portout_type;
+
+void common_hal_digitalio_portout_construct(digitalio_portout_obj_t* self,
+    const mcu_pin_obj_t** pins, size_t num_pins, uint32_t value);
+void common_hal_digitalio_portout_deinit(digitalio_portout_obj_t* self);
+bool common_hal_digitalio_portout_deinited(digitalio_portout_obj_t* self);
+uint32_t common_hal_digitalio_portout_get_value(digitalio_portout_obj_t* self);
+void common_hal_digitalio_portout_set_value(digitalio_portout_obj_t* self, uint32_t value);
+// Writes each of the len values, which are bytes_per_value bytes long, rate times a second.
+// Returns once the last value has been written.
+void common_hal_digitalio_portout_write_sequence(digitalio_portout_obj_t* self,
+    const uint8_t* values, size_t len, uint8_t bytes_per_value, uint32_t rate);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_DIGITALIO_PORTOUT_H
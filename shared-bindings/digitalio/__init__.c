@@ -35,8 +35,13 @@
 #include "shared-bindings/digitalio/Direction.h"
 #include "shared-bindings/digitalio/DriveMode.h"
 #include "shared-bindings/digitalio/Pull.h"
+#if CIRCUITPY_DIGITALIO_PORT
+#include "shared-bindings/digitalio/PortIn.h"
+#include "shared-bindings/digitalio/PortOut.h"
+#endif
 
 #include "py/runtime.h"
+#include "supervisor/shared/translate.h"
 
 //| :mod:`digitalio` --- Basic digital pin support
 //| =================================================
@@ -53,6 +58,8 @@
 //|     :maxdepth: 3
 //|
 //|     DigitalInOut
+//|     PortIn
+//|     PortOut
 //|     Direction
 //|     DriveMode
 //|     Pull
@@ -88,10 +95,38 @@
 //|       led.value = False
 //|       time.sleep(0.1)
 //|
+//| `PortIn` and `PortOut` are only available on some microcontrollers.
+//|
+
+#if CIRCUITPY_DIGITALIO_PORT
+size_t digitalio_validate_port_pins(mp_obj_t pins_obj, const mcu_pin_obj_t** pins) {
+    size_t num_pins;
+    mp_obj_t *items;
+    mp_obj_get_array(pins_obj, &num_pins, &items);
+    if (num_pins == 0 || num_pins > DIGITALIO_PORT_MAX_PINS) {
+        mp_raise_ValueError(translate("Invalid pins"));
+    }
+    for (size_t i = 0; i < num_pins; i++) {
+        assert_pin(items[i], false);
+        pins[i] = MP_OBJ_TO_PTR(items[i]);
+        assert_pin_free(pins[i]);
+        for (size_t j = 0; j < i; j++) {
+            if (pins[j] == pins[i]) {
+                mp_raise_ValueError(translate("Invalid pins"));
+            }
+        }
+    }
+    return num_pins;
+}
+#endif
 
 STATIC const mp_rom_map_elem_t digitalio_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_digitalio) },
     { MP_ROM_QSTR(MP_QSTR_DigitalInOut),  MP_ROM_PTR(&digitalio_digitalinout_type) },
+    #if CIRCUITPY_DIGITALIO_PORT
+    { MP_ROM_QSTR(MP_QSTR_PortIn),        MP_ROM_PTR(&digitalio_portin_type) },
+    { MP_ROM_QSTR(MP_QSTR_PortOut),       MP_ROM_PTR(&digitalio_portout_type) },
+    #endif
 
     // Enum-like Classes.
     { MP_ROM_QSTR(MP_QSTR_Direction),          MP_ROM_PTR(&digitalio_direction_type) },
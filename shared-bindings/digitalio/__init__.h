@@ -27,8 +27,14 @@
 #ifndef MICROPY_INCLUDED_SHARED_BINDINGS_DIGITALIO___INIT___H
 #define MICROPY_INCLUDED_SHARED_BINDINGS_DIGITALIO___INIT___H
 
+#include "common-hal/microcontroller/Pin.h"
 #include "py/obj.h"
 
-// Nothing now.
+// The most pins a PortIn or PortOut can group, one for each bit of its value.
+#define DIGITALIO_PORT_MAX_PINS 32
+
+// Checks that pins_obj is a sequence of between 1 and DIGITALIO_PORT_MAX_PINS distinct, free
+// pins and copies them into pins. Returns the number of pins.
+size_t digitalio_validate_port_pins(mp_obj_t pins_obj, const mcu_pin_obj_t** pins);
 
 #endif  // MICROPY_INCLUDED_SHARED_BINDINGS_DIGITALIO___INIT___H
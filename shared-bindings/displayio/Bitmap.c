@@ -32,6 +32,7 @@
 #include "py/binary.h"
 #include "py/objproperty.h"
 #include "py/runtime.h"
+#include "shared-bindings/displayio/__init__.h"
 #include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/util.h"
 #include "supervisor/shared/translate.h"
@@ -178,9 +179,235 @@ STATIC mp_obj_t bitmap_subscr(mp_obj_t self_in, mp_obj_t index_obj, mp_obj_t val
     return mp_const_none;
 }
 
+STATIC uint32_t get_value(displayio_bitmap_t *self, mp_obj_t value_obj) {
+    mp_uint_t value = mp_obj_get_int_truncated(value_obj);
+    uint32_t bits = common_hal_displayio_bitmap_get_bits_per_value(self);
+    if (bits < 32 && value >= (1u << bits)) {
+        mp_raise_ValueError(translate("pixel value requires too many bits"));
+    }
+    return value;
+}
+
+//|   .. method:: fill(value)
+//|
+//|     Sets every value in the bitmap to the given value.
+//|
+STATIC mp_obj_t displayio_bitmap_obj_fill(mp_obj_t self_in, mp_obj_t value_obj) {
+    displayio_bitmap_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_displayio_bitmap_fill(self, get_value(self, value_obj));
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(displayio_bitmap_fill_obj, displayio_bitmap_obj_fill);
+
+//|   .. method:: fill_region(x1, y1, x2, y2, value)
+//|
+//|     Sets the values from x1,y1 up to but not including x2,y2 to the given value. The region is
+//|     clipped to the bitmap.
+//|
+STATIC mp_obj_t displayio_bitmap_obj_fill_region(size_t n_args, const mp_obj_t *args) {
+    displayio_bitmap_t *self = MP_OBJ_TO_PTR(args[0]);
+    common_hal_displayio_bitmap_fill_region(self, mp_obj_get_int(args[1]), mp_obj_get_int(args[2]),
+        mp_obj_get_int(args[3]), mp_obj_get_int(args[4]), get_value(self, args[5]));
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(displayio_bitmap_fill_region_obj, 6, 6, displayio_bitmap_obj_fill_region);
+
+//|   .. method:: blit(x, y, source_bitmap, *, x1=0, y1=0, x2=None, y2=None, skip_index=None)
+//|
+//|     Copies the area of source_bitmap from x1,y1 up to but not including x2,y2 into this bitmap
+//|     with its top left corner at x,y. Areas outside either bitmap are clipped.
+//|
+//|     :param int x: Column of the destination for the top left corner of the copy
+//|     :param int y: Row of the destination for the top left corner of the copy
+//|     :param displayio.Bitmap source_bitmap: Bitmap to copy from. It may be this bitmap.
+//|     :param int x1: Left column of the area to copy
+//|     :param int y1: Top row of the area to copy
+//|     :param int x2: Column past the right of the area to copy. Defaults to the source width.
+//|     :param int y2: Row past the bottom of the area to copy. Defaults to the source height.
+//|     :param int skip_index: Source value that is not copied so the destination shows through
+//|
+STATIC mp_obj_t displayio_bitmap_obj_blit(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_x, ARG_y, ARG_source_bitmap, ARG_x1, ARG_y1, ARG_x2, ARG_y2, ARG_skip_index };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_x, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_y, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_source_bitmap, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_x1, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
+        { MP_QSTR_y1, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
+        { MP_QSTR_x2, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_y2, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_skip_index, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    displayio_bitmap_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_obj_t source_obj = args[ARG_source_bitmap].u_obj;
+    if (!MP_OBJ_IS_TYPE(source_obj, &displayio_bitmap_type)) {
+        mp_raise_TypeError_varg(translate("Expected a %q"), displayio_bitmap_type.name);
+    }
+    displayio_bitmap_t *source = MP_OBJ_TO_PTR(source_obj);
+
+    mp_int_t x2 = common_hal_displayio_bitmap_get_width(source);
+    if (args[ARG_x2].u_obj != mp_const_none) {
+        x2 = mp_obj_get_int(args[ARG_x2].u_obj);
+    }
+    mp_int_t y2 = common_hal_displayio_bitmap_get_height(source);
+    if (args[ARG_y2].u_obj != mp_const_none) {
+        y2 = mp_obj_get_int(args[ARG_y2].u_obj);
+    }
+    uint32_t skip_index = 0;
+    bool skip_index_none = args[ARG_skip_index].u_obj == mp_const_none;
+    if (!skip_index_none) {
+        skip_index = mp_obj_get_int_truncated(args[ARG_skip_index].u_obj);
+    }
+
+    common_hal_displayio_bitmap_blit(self, args[ARG_x].u_int, args[ARG_y].u_int, source,
+        args[ARG_x1].u_int, args[ARG_y1].u_int, x2, y2, skip_index, skip_index_none);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(displayio_bitmap_blit_obj, 4, displayio_bitmap_obj_blit);
+
+// The pen draws with value and anti-aliases with the ramp - 1 values after it.
+STATIC void get_pen(displayio_bitmap_t *self, mp_obj_t value_obj, mp_int_t ramp, displayio_vector_pen_t* pen) {
+    if (ramp < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_ramp);
+    }
+    if (ramp > 255) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+    uint32_t value = get_value(self, value_obj);
+    get_value(self, mp_obj_new_int_from_uint(value + ramp - 1));
+    displayio_bitmap_get_pen(self, value, ramp, pen);
+}
+
+//|   .. method:: draw_line(x0, y0, x1, y1, value, *, ramp=1)
+//|
+//|     Draws a line from x0,y0 to x1,y1 inclusive. Pixels outside the bitmap are clipped.
+//|
+//|     :param int value: Value of pixels fully covered by the line
+//|     :param int ramp: Number of values, starting at value, that fade towards the background.
+//|       Lines are anti-aliased when it is more than one. The palette is expected to blend from
+//|       the line color at value to the background color at ``value + ramp``.
+//|
+STATIC mp_obj_t displayio_bitmap_obj_draw_line(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_x0, ARG_y0, ARG_x1, ARG_y1, ARG_value, ARG_ramp };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_x0, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_y0, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_x1, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_y1, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_value, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_ramp, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    displayio_bitmap_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    displayio_vector_pen_t pen;
+    get_pen(self, args[ARG_value].u_obj, args[ARG_ramp].u_int, &pen);
+    displayio_vector_line(&pen, args[ARG_x0].u_int, args[ARG_y0].u_int, args[ARG_x1].u_int, args[ARG_y1].u_int);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(displayio_bitmap_draw_line_obj, 6, displayio_bitmap_obj_draw_line);
+
+//|   .. method:: draw_circle(x, y, radius, value, *, fill=False, ramp=1)
+//|
+//|     Draws a circle centered on x,y. Pixels outside the bitmap are clipped.
+//|
+//|     :param int value: Value of pixels fully covered by the circle
+//|     :param bool fill: When true the inside of the circle is set too
+//|     :param int ramp: Number of values, starting at value, that fade towards the background.
+//|       The edge of a filled circle is anti-aliased when it is more than one.
+//|
+STATIC mp_obj_t displayio_bitmap_obj_draw_circle(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_x, ARG_y, ARG_radius, ARG_value, ARG_fill, ARG_ramp };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_x, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_y, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_radius, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_value, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_fill, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
+        { MP_QSTR_ramp, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    displayio_bitmap_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_int_t radius = args[ARG_radius].u_int;
+    if (radius < 0 || radius > 0x7fff) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+    displayio_vector_pen_t pen;
+    get_pen(self, args[ARG_value].u_obj, args[ARG_ramp].u_int, &pen);
+    if (args[ARG_fill].u_bool) {
+        displayio_vector_fill_circle(&pen, args[ARG_x].u_int, args[ARG_y].u_int, radius);
+    } else {
+        displayio_vector_circle(&pen, args[ARG_x].u_int, args[ARG_y].u_int, radius);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(displayio_bitmap_draw_circle_obj, 5, displayio_bitmap_obj_draw_circle);
+
+//|   .. method:: draw_arc(x, y, radius, start_angle, end_angle, value)
+//|
+//|     Draws the part of a circle centered on x,y from start_angle clockwise to end_angle. Angles
+//|     are in degrees with 0 pointing to the right.
+//|
+STATIC mp_obj_t displayio_bitmap_obj_draw_arc(size_t n_args, const mp_obj_t *args) {
+    displayio_bitmap_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_int_t radius = mp_obj_get_int(args[3]);
+    if (radius < 0 || radius > 0x7fff) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+    displayio_vector_pen_t pen;
+    get_pen(self, args[6], 1, &pen);
+    displayio_vector_arc(&pen, mp_obj_get_int(args[1]), mp_obj_get_int(args[2]), radius,
+        mp_obj_get_float(args[4]), mp_obj_get_float(args[5]));
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(displayio_bitmap_draw_arc_obj, 7, 7, displayio_bitmap_obj_draw_arc);
+
+//|   .. method:: draw_polygon(points, value, *, fill=False)
+//|
+//|     Draws the outline of the polygon through the given (x, y) tuples back to the first one.
+//|
+//|     :param bool fill: When true the inside is set too using the even-odd rule
+//|
+STATIC mp_obj_t displayio_bitmap_obj_draw_polygon(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_points, ARG_value, ARG_fill };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_points, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_value, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_fill, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    displayio_bitmap_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    displayio_vector_pen_t pen;
+    get_pen(self, args[ARG_value].u_obj, 1, &pen);
+    uint16_t point_count;
+    int16_t* points = displayio_get_points(args[ARG_points].u_obj, &point_count);
+    if (args[ARG_fill].u_bool) {
+        displayio_vector_fill_polygon(&pen, points, point_count);
+    }
+    displayio_vector_polygon(&pen, points, point_count);
+    m_del(int16_t, points, 2 * point_count);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(displayio_bitmap_draw_polygon_obj, 3, displayio_bitmap_obj_draw_polygon);
+
 STATIC const mp_rom_map_elem_t displayio_bitmap_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_height), MP_ROM_PTR(&displayio_bitmap_height_obj) },
     { MP_ROM_QSTR(MP_QSTR_width), MP_ROM_PTR(&displayio_bitmap_width_obj) },
+    { MP_ROM_QSTR(MP_QSTR_blit), MP_ROM_PTR(&displayio_bitmap_blit_obj) },
+    { MP_ROM_QSTR(MP_QSTR_draw_arc), MP_ROM_PTR(&displayio_bitmap_draw_arc_obj) },
+    { MP_ROM_QSTR(MP_QSTR_draw_circle), MP_ROM_PTR(&displayio_bitmap_draw_circle_obj) },
+    { MP_ROM_QSTR(MP_QSTR_draw_line), MP_ROM_PTR(&displayio_bitmap_draw_line_obj) },
+    { MP_ROM_QSTR(MP_QSTR_draw_polygon), MP_ROM_PTR(&displayio_bitmap_draw_polygon_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fill), MP_ROM_PTR(&displayio_bitmap_fill_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fill_region), MP_ROM_PTR(&displayio_bitmap_fill_region_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(displayio_bitmap_locals_dict, displayio_bitmap_locals_dict_table);
 
@@ -30,11 +30,14 @@
 
 #include "lib/utils/context_manager_helpers.h"
 #include "py/binary.h"
+#include "py/objnamedtuple.h"
 #include "py/objproperty.h"
 #include "py/objtype.h"
 #include "py/runtime.h"
 #include "shared-bindings/displayio/Group.h"
+#if CIRCUITPY_DISPLAYIO_HARDWARE
 #include "shared-bindings/microcontroller/Pin.h"
+#endif
 #include "shared-bindings/util.h"
 #include "shared-module/displayio/__init__.h"
 #include "supervisor/shared/translate.h"
@@ -51,7 +54,7 @@
 //| Most people should not use this class directly. Use a specific display driver instead that will
 //| contain the initialization sequence at minimum.
 //|
-//| .. class:: Display(display_bus, init_sequence, *, width, height, colstart=0, rowstart=0, rotation=0, color_depth=16, grayscale=False, pixels_in_byte_share_row=True, bytes_per_cell=1, reverse_pixels_in_byte=False, set_column_command=0x2a, set_row_command=0x2b, write_ram_command=0x2c, set_vertical_scroll=0, backlight_pin=None, brightness_command=None, brightness=1.0, auto_brightness=False, single_byte_bounds=False, data_as_commands=False, auto_refresh=True, native_frames_per_second=60)
+//| .. class:: Display(display_bus, init_sequence, *, width, height, colstart=0, rowstart=0, rotation=0, color_depth=16, grayscale=False, pixels_in_byte_share_row=True, bytes_per_cell=1, reverse_pixels_in_byte=False, set_column_command=0x2a, set_row_command=0x2b, write_ram_command=0x2c, set_vertical_scroll=0, vertical_scroll_lines=0, rotation_command=None, rotation_values=None, backlight_pin=None, brightness_command=None, brightness=1.0, auto_brightness=False, single_byte_bounds=False, data_as_commands=False, auto_refresh=True, native_frames_per_second=60)
 //|
 //|   Create a Display object on the given display bus (`displayio.FourWire` or `displayio.ParallelBus`).
 //|
@@ -96,6 +99,9 @@
 //|   :param int set_row_command: Command used so set the start and end rows to update
 //|   :param int write_ram_command: Command used to write pixels values into the update region. Ignored if data_as_commands is set.
 //|   :param int set_vertical_scroll: Command used to set the first row to show
+//|   :param int vertical_scroll_lines: Number of rows in the display's memory, such as 320 for an ILI9341. When set with set_vertical_scroll, the built-in terminal scrolls in hardware so only new lines are sent. The scroll area is set with the MIPI vertical scrolling definition command (0x33).
+//|   :param int rotation_command: Command used to rotate the display in hardware, such as MADCTL (0x36). When None, rotation is done in software while drawing.
+//|   :param buffer rotation_values: Four data bytes to send with rotation_command for 0, 90, 180 and 270 degrees. colstart and rowstart are used as given for every rotation.
 //|   :param microcontroller.Pin backlight_pin: Pin connected to the display's backlight
 //|   :param int brightness_command: Command to set display brightness. Usually available in OLED controllers.
 //|   :param bool brightness: Initial display brightness. This value is ignored if auto_brightness is True.
@@ -106,7 +112,7 @@
 //|   :param int native_frames_per_second: Number of display refreshes per second that occur with the given init_sequence.
 //|
 STATIC mp_obj_t displayio_display_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
-    enum { ARG_display_bus, ARG_init_sequence, ARG_width, ARG_height, ARG_colstart, ARG_rowstart, ARG_rotation, ARG_color_depth, ARG_grayscale, ARG_pixels_in_byte_share_row, ARG_bytes_per_cell, ARG_reverse_pixels_in_byte, ARG_set_column_command, ARG_set_row_command, ARG_write_ram_command, ARG_set_vertical_scroll, ARG_backlight_pin, ARG_brightness_command, ARG_brightness, ARG_auto_brightness, ARG_single_byte_bounds, ARG_data_as_commands, ARG_auto_refresh, ARG_native_frames_per_second };
+    enum { ARG_display_bus, ARG_init_sequence, ARG_width, ARG_height, ARG_colstart, ARG_rowstart, ARG_rotation, ARG_color_depth, ARG_grayscale, ARG_pixels_in_byte_share_row, ARG_bytes_per_cell, ARG_reverse_pixels_in_byte, ARG_set_column_command, ARG_set_row_command, ARG_write_ram_command, ARG_set_vertical_scroll, ARG_vertical_scroll_lines, ARG_rotation_command, ARG_rotation_values, ARG_backlight_pin, ARG_brightness_command, ARG_brightness, ARG_auto_brightness, ARG_single_byte_bounds, ARG_data_as_commands, ARG_auto_refresh, ARG_native_frames_per_second };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_display_bus, MP_ARG_REQUIRED | MP_ARG_OBJ },
         { MP_QSTR_init_sequence, MP_ARG_REQUIRED | MP_ARG_OBJ },
@@ -124,6 +130,9 @@ STATIC mp_obj_t displayio_display_make_new(const mp_obj_type_t *type, size_t n_a
         { MP_QSTR_set_row_command, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0x2b} },
         { MP_QSTR_write_ram_command, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0x2c} },
         { MP_QSTR_set_vertical_scroll, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0x0} },
+        { MP_QSTR_vertical_scroll_lines, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
+        { MP_QSTR_rotation_command, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_rotation_values, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
         { MP_QSTR_backlight_pin, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
         { MP_QSTR_brightness_command, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = NO_BRIGHTNESS_COMMAND} },
         { MP_QSTR_brightness, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = MP_OBJ_NEW_SMALL_INT(1)} },
@@ -142,12 +151,18 @@ STATIC mp_obj_t displayio_display_make_new(const mp_obj_type_t *type, size_t n_a
     mp_get_buffer_raise(args[ARG_init_sequence].u_obj, &bufinfo, MP_BUFFER_READ);
 
     mp_obj_t backlight_pin_obj = args[ARG_backlight_pin].u_obj;
-    assert_pin(backlight_pin_obj, true);
     const mcu_pin_obj_t* backlight_pin = NULL;
+    #if CIRCUITPY_DISPLAYIO_HARDWARE
+    assert_pin(backlight_pin_obj, true);
     if (backlight_pin_obj != NULL && backlight_pin_obj != mp_const_none) {
         backlight_pin = MP_OBJ_TO_PTR(backlight_pin_obj);
         assert_pin_free(backlight_pin);
     }
+    #else
+    if (backlight_pin_obj != mp_const_none) {
+        mp_raise_ValueError(translate("Invalid pin"));
+    }
+    #endif
 
     mp_float_t brightness = mp_obj_get_float(args[ARG_brightness].u_obj);
 
@@ -156,6 +171,18 @@ STATIC mp_obj_t displayio_display_make_new(const mp_obj_type_t *type, size_t n_a
         mp_raise_ValueError(translate("Display rotation must be in 90 degree increments"));
     }
 
+    uint16_t rotation_command = NO_COMMAND;
+    const uint8_t* rotation_values = NULL;
+    if (args[ARG_rotation_command].u_obj != mp_const_none) {
+        rotation_command = mp_obj_get_int(args[ARG_rotation_command].u_obj) & 0xff;
+        mp_buffer_info_t rotation_bufinfo;
+        mp_get_buffer_raise(args[ARG_rotation_values].u_obj, &rotation_bufinfo, MP_BUFFER_READ);
+        if (rotation_bufinfo.len != 4) {
+            mp_raise_ValueError(translate("Value length != required fixed length"));
+        }
+        rotation_values = rotation_bufinfo.buf;
+    }
+
     displayio_display_obj_t *self = NULL;
     for (uint8_t i = 0; i < CIRCUITPY_DISPLAY_LIMIT; i++) {
         if (displays[i].display.base.type == NULL ||
@@ -176,6 +203,8 @@ STATIC mp_obj_t displayio_display_make_new(const mp_obj_type_t *type, size_t n_a
         args[ARG_set_column_command].u_int, args[ARG_set_row_command].u_int,
         args[ARG_write_ram_command].u_int,
         args[ARG_set_vertical_scroll].u_int,
+        args[ARG_vertical_scroll_lines].u_int,
+        rotation_command, rotation_values,
         bufinfo.buf, bufinfo.len,
         MP_OBJ_TO_PTR(backlight_pin),
         args[ARG_brightness_command].u_int,
@@ -255,7 +284,9 @@ MP_DEFINE_CONST_FUN_OBJ_KW(displayio_display_refresh_obj, 1, displayio_display_o
 
 //|   .. attribute:: auto_refresh
 //|
-//|     True when the display is refreshed automatically.
+//|     True when the display is refreshed automatically. Automatic refreshes of large changes are
+//|     spread over several background passes so that audio and USB keep running. `refresh` always
+//|     finishes a frame before it returns.
 //|
 STATIC mp_obj_t displayio_display_obj_get_auto_refresh(mp_obj_t self_in) {
     displayio_display_obj_t *self = native_display(self_in);
@@ -409,6 +440,73 @@ const mp_obj_property_t displayio_display_rotation_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+STATIC const mp_obj_namedtuple_type_t displayio_display_stats_type = {
+    .base = {
+        .base = {
+            .type = &mp_type_type
+        },
+        .name = MP_QSTR_DisplayStats,
+        .print = namedtuple_print,
+        .make_new = namedtuple_make_new,
+        .unary_op = mp_obj_tuple_unary_op,
+        .binary_op = mp_obj_tuple_binary_op,
+        .attr = namedtuple_attr,
+        .subscr = mp_obj_tuple_subscr,
+        .getiter = mp_obj_tuple_getiter,
+        .parent = &mp_type_tuple,
+    },
+    .n_fields = 8,
+    .fields = {
+        MP_QSTR_frames,
+        MP_QSTR_dropped_frames,
+        MP_QSTR_last_frame_us,
+        MP_QSTR_average_frame_us,
+        MP_QSTR_composite_us,
+        MP_QSTR_send_us,
+        MP_QSTR_pixels_sent,
+        MP_QSTR_refresh_areas
+    },
+};
+
+//|   .. attribute:: stats
+//|
+//|     Refresh statistics as a named tuple with these fields:
+//|
+//|     * ``frames`` - refreshes that updated at least one area
+//|     * ``dropped_frames`` - refreshes skipped because ``target_frames_per_second`` was missed
+//|     * ``last_frame_us`` - time the last frame took in microseconds
+//|     * ``average_frame_us`` - moving average of the frame time in microseconds
+//|     * ``composite_us`` - time the last frame spent computing pixels in microseconds
+//|     * ``send_us`` - rest of the last frame's time, spent sending to the display, in microseconds
+//|     * ``pixels_sent`` - pixels sent in the last frame
+//|     * ``refresh_areas`` - areas updated in the last frame
+//|
+//|     The times are useful to tell whether a slow frame is limited by drawing or by the bus.
+//|
+STATIC mp_obj_t displayio_display_obj_get_stats(mp_obj_t self_in) {
+    displayio_display_obj_t *self = native_display(self_in);
+    const displayio_display_stats_t* stats = common_hal_displayio_display_get_stats(self);
+    mp_obj_t fields[8] = {
+        mp_obj_new_int_from_uint(stats->frames),
+        mp_obj_new_int_from_uint(stats->dropped_frames),
+        mp_obj_new_int_from_uint(stats->last_frame_us),
+        mp_obj_new_int_from_uint(stats->average_frame_us),
+        mp_obj_new_int_from_uint(stats->composite_us),
+        mp_obj_new_int_from_uint(stats->send_us),
+        mp_obj_new_int_from_uint(stats->pixels_sent),
+        MP_OBJ_NEW_SMALL_INT(stats->refresh_areas),
+    };
+    return namedtuple_make_new((const mp_obj_type_t*) &displayio_display_stats_type, 8, fields, NULL);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(displayio_display_get_stats_obj, displayio_display_obj_get_stats);
+
+const mp_obj_property_t displayio_display_stats_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&displayio_display_get_stats_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 //|   .. attribute:: bus
 //|
 //|	The bus being used by the display
@@ -501,6 +599,7 @@ STATIC const mp_rom_map_elem_t displayio_display_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_width), MP_ROM_PTR(&displayio_display_width_obj) },
     { MP_ROM_QSTR(MP_QSTR_height), MP_ROM_PTR(&displayio_display_height_obj) },
     { MP_ROM_QSTR(MP_QSTR_rotation), MP_ROM_PTR(&displayio_display_rotation_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stats), MP_ROM_PTR(&displayio_display_stats_obj) },
     { MP_ROM_QSTR(MP_QSTR_bus), MP_ROM_PTR(&displayio_display_bus_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(displayio_display_locals_dict, displayio_display_locals_dict_table);
@@ -0,0 +1,176 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/displayio/FramebufferBus.h"
+
+#include <stdint.h>
+
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-module/displayio/__init__.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: displayio
+//|
+//| :class:`FramebufferBus` -- Draw a display into memory
+//| ==========================================================================
+//|
+//| Emulates the memory of a display that takes MIPI DCS commands so that displays can be drawn
+//| without hardware, such as on the unix port for profiling and testing. Only the column address
+//| (0x2a), page address (0x2b) and write memory (0x2c) commands are emulated so the `Display`
+//| should use its default commands, no rotation command and no hardware scrolling.
+//|
+//| .. class:: FramebufferBus(width, height, *, color_depth=16)
+//|
+//|   Create a FramebufferBus with memory for width by height pixels. Pass the same color depth to
+//|   `Display`. Rows of fewer than 8 bits per pixel are packed with the first pixel in the most
+//|   significant bits.
+//|
+//|   Like other display buses, it is in use until `displayio.release_displays()` is called.
+//|
+//|   :param int width: Width of the display memory in pixels
+//|   :param int height: Height of the display memory in pixels
+//|   :param int color_depth: Bits per pixel: 1, 2, 4, 8, 16, 24 or 32
+//|
+STATIC mp_obj_t displayio_framebufferbus_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_width, ARG_height, ARG_color_depth };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_width, MP_ARG_INT | MP_ARG_REQUIRED },
+        { MP_QSTR_height, MP_ARG_INT | MP_ARG_REQUIRED },
+        { MP_QSTR_color_depth, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 16} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_int_t width = args[ARG_width].u_int;
+    mp_int_t height = args[ARG_height].u_int;
+    if (width <= 0 || width > 0xffff || height <= 0 || height > 0xffff) {
+        mp_raise_ValueError(translate("Invalid buffer size"));
+    }
+    mp_int_t color_depth = args[ARG_color_depth].u_int;
+    switch (color_depth) {
+        case 1: case 2: case 4: case 8: case 16: case 24: case 32:
+            break;
+        default:
+            mp_raise_ValueError(translate("Invalid number of bits"));
+    }
+
+    displayio_framebufferbus_obj_t* self = NULL;
+    for (uint8_t i = 0; i < CIRCUITPY_DISPLAY_LIMIT; i++) {
+        if (displays[i].bus_base.type == NULL ||
+            displays[i].bus_base.type == &mp_type_NoneType) {
+            self = &displays[i].framebuffer_bus;
+            self->base.type = &displayio_framebufferbus_type;
+            break;
+        }
+    }
+    if (self == NULL) {
+        mp_raise_RuntimeError(translate("Too many display busses"));
+    }
+
+    common_hal_displayio_framebufferbus_construct(self, width, height, color_depth);
+    return self;
+}
+
+//|   .. method:: reset()
+//|
+//|     Clears the display memory as a hardware reset would.
+//|
+STATIC mp_obj_t displayio_framebufferbus_obj_reset(mp_obj_t self_in) {
+    common_hal_displayio_framebufferbus_reset(self_in);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(displayio_framebufferbus_reset_obj, displayio_framebufferbus_obj_reset);
+
+//|   .. method:: send(command, data)
+//|
+//|     Sends the given command value followed by the full set of data.
+//|
+STATIC mp_obj_t displayio_framebufferbus_obj_send(mp_obj_t self, mp_obj_t command_obj, mp_obj_t data_obj) {
+    mp_int_t command_int = mp_obj_get_int(command_obj);
+    if (command_int > 255 || command_int < 0) {
+        mp_raise_ValueError(translate("Command must be an int between 0 and 255"));
+    }
+    uint8_t command = command_int;
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(data_obj, &bufinfo, MP_BUFFER_READ);
+
+    common_hal_displayio_framebufferbus_begin_transaction(self);
+    common_hal_displayio_framebufferbus_send(self, DISPLAY_COMMAND, CHIP_SELECT_UNTOUCHED, &command, 1);
+    common_hal_displayio_framebufferbus_send(self, DISPLAY_DATA, CHIP_SELECT_UNTOUCHED, ((uint8_t*) bufinfo.buf), bufinfo.len);
+    common_hal_displayio_framebufferbus_end_transaction(self);
+
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_3(displayio_framebufferbus_send_obj, displayio_framebufferbus_obj_send);
+
+//|   .. method:: save(file)
+//|
+//|     Writes the display memory to the given file, opened in byte mode, as a binary PPM image.
+//|     Color depths of 8 bits or less are written as grayscale PGM images instead. 16-bit pixels
+//|     are RGB565, most significant byte first.
+//|
+STATIC mp_obj_t displayio_framebufferbus_obj_save(mp_obj_t self_in, mp_obj_t file) {
+    displayio_framebufferbus_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_displayio_framebufferbus_save(self, file);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(displayio_framebufferbus_save_obj, displayio_framebufferbus_obj_save);
+
+//|   .. attribute:: buffer
+//|
+//|     A bytearray of the display memory, row by row. It is only valid until the bus is released.
+//|     (read only)
+//|
+STATIC mp_obj_t displayio_framebufferbus_obj_get_buffer(mp_obj_t self_in) {
+    displayio_framebufferbus_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    uint32_t length;
+    uint8_t* buffer = common_hal_displayio_framebufferbus_get_buffer(self, &length);
+    return mp_obj_new_bytearray_by_ref(length, buffer);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(displayio_framebufferbus_get_buffer_obj, displayio_framebufferbus_obj_get_buffer);
+
+const mp_obj_property_t displayio_framebufferbus_buffer_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&displayio_framebufferbus_get_buffer_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t displayio_framebufferbus_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&displayio_framebufferbus_reset_obj) },
+    { MP_ROM_QSTR(MP_QSTR_send), MP_ROM_PTR(&displayio_framebufferbus_send_obj) },
+    { MP_ROM_QSTR(MP_QSTR_save), MP_ROM_PTR(&displayio_framebufferbus_save_obj) },
+    { MP_ROM_QSTR(MP_QSTR_buffer), MP_ROM_PTR(&displayio_framebufferbus_buffer_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(displayio_framebufferbus_locals_dict, displayio_framebufferbus_locals_dict_table);
+
+const mp_obj_type_t displayio_framebufferbus_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_FramebufferBus,
+    .make_new = displayio_framebufferbus_make_new,
+    .locals_dict = (mp_obj_dict_t*)&displayio_framebufferbus_locals_dict,
+};
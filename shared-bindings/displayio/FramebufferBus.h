@@ -0,0 +1,55 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_DISPLAYIO_FRAMEBUFFERBUS_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_DISPLAYIO_FRAMEBUFFERBUS_H
+
+#include "shared-module/displayio/FramebufferBus.h"
+
+#include "shared-bindings/displayio/__init__.h"
+
+extern const mp_obj_type_t displayio_framebufferbus_type;
+
+void common_hal_displayio_framebufferbus_construct(displayio_framebufferbus_obj_t* self,
+    uint16_t width, uint16_t height, uint8_t color_depth);
+
+void common_hal_displayio_framebufferbus_deinit(displayio_framebufferbus_obj_t* self);
+
+bool common_hal_displayio_framebufferbus_reset(mp_obj_t self);
+bool common_hal_displayio_framebufferbus_bus_free(mp_obj_t self);
+
+bool common_hal_displayio_framebufferbus_begin_transaction(mp_obj_t self);
+
+void common_hal_displayio_framebufferbus_send(mp_obj_t self, display_byte_type_t byte_type, display_chip_select_behavior_t chip_select, uint8_t *data, uint32_t data_length);
+
+void common_hal_displayio_framebufferbus_end_transaction(mp_obj_t self);
+
+uint8_t* common_hal_displayio_framebufferbus_get_buffer(displayio_framebufferbus_obj_t* self, uint32_t* length);
+
+// Writes the framebuffer to stream as a binary PPM image, or PGM for 8 bits or less per pixel.
+void common_hal_displayio_framebufferbus_save(displayio_framebufferbus_obj_t* self, mp_obj_t stream);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_DISPLAYIO_FRAMEBUFFERBUS_H
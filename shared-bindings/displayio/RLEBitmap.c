@@ -0,0 +1,165 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/displayio/RLEBitmap.h"
+
+#include <stdint.h>
+
+#include "py/runtime.h"
+#include "py/objproperty.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: displayio
+//|
+//| :class:`RLEBitmap` -- Read-only run-length encoded bitmap
+//| ==========================================================================
+//|
+//| Stores a bitmap compressed with run-length encoding. Pixels are decoded run by run as they are
+//| drawn so the whole image is never decompressed. Flat shaded images are much smaller than a
+//| `Bitmap` and draw quickly.
+//|
+//| The data starts with a 12 byte header: ``CPR`` followed by a format version of 1, the bits
+//| per value, a reserved byte, a 16-bit width, a 16-bit height and two reserved bytes. Next is a
+//| 32-bit offset from the start of the data for each row. Each row is a series of runs that
+//| start with a header byte. When its top bit is set, the following value repeats
+//| ``(header & 0x7f) + 1`` times. Otherwise, ``(header & 0x7f) + 1`` values follow. Values use
+//| as many bytes as needed for the bits per value. Multi-byte values are little endian.
+//|
+//| .. class:: RLEBitmap(data)
+//|
+//|   Create an RLEBitmap object from the given file or buffer.
+//|
+//|   A file is read into memory once. A buffer, such as ``bytes`` in a frozen module, is used in
+//|   place and must not be changed.
+//|
+//|   :param data: The file opened in byte mode or buffer to load
+//|
+STATIC mp_obj_t displayio_rlebitmap_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    mp_arg_check_num(n_args, kw_args, 1, 1, false);
+
+    displayio_rlebitmap_t *self = m_new_obj(displayio_rlebitmap_t);
+    self->base.type = &displayio_rlebitmap_type;
+    #if CIRCUITPY_DISPLAYIO_HARDWARE
+    if (MP_OBJ_IS_TYPE(pos_args[0], &mp_type_fileio)) {
+        common_hal_displayio_rlebitmap_construct_from_file(self, MP_OBJ_TO_PTR(pos_args[0]));
+        return MP_OBJ_FROM_PTR(self);
+    }
+    #endif
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(pos_args[0], &bufinfo, MP_BUFFER_READ);
+    common_hal_displayio_rlebitmap_construct_from_buffer(self, pos_args[0], bufinfo.buf, bufinfo.len);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. attribute:: width
+//|
+//|      Width of the bitmap. (read only)
+//|
+STATIC mp_obj_t displayio_rlebitmap_obj_get_width(mp_obj_t self_in) {
+    displayio_rlebitmap_t *self = MP_OBJ_TO_PTR(self_in);
+
+    return MP_OBJ_NEW_SMALL_INT(common_hal_displayio_rlebitmap_get_width(self));
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(displayio_rlebitmap_get_width_obj, displayio_rlebitmap_obj_get_width);
+
+const mp_obj_property_t displayio_rlebitmap_width_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&displayio_rlebitmap_get_width_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+
+};
+
+//|   .. attribute:: height
+//|
+//|      Height of the bitmap. (read only)
+//|
+STATIC mp_obj_t displayio_rlebitmap_obj_get_height(mp_obj_t self_in) {
+    displayio_rlebitmap_t *self = MP_OBJ_TO_PTR(self_in);
+
+    return MP_OBJ_NEW_SMALL_INT(common_hal_displayio_rlebitmap_get_height(self));
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(displayio_rlebitmap_get_height_obj, displayio_rlebitmap_obj_get_height);
+
+const mp_obj_property_t displayio_rlebitmap_height_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&displayio_rlebitmap_get_height_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+
+};
+
+//|   .. method:: __getitem__(index)
+//|
+//|     Returns the value at the given index. The index can either be an x,y tuple or an int equal
+//|     to ``y * width + x``.
+//|
+//|     This allows you to::
+//|
+//|       print(rle_bitmap[0,1])
+//|
+STATIC mp_obj_t rlebitmap_subscr(mp_obj_t self_in, mp_obj_t index_obj, mp_obj_t value_obj) {
+    if (value_obj != MP_OBJ_SENTINEL) {
+        // Only loads are supported.
+        return MP_OBJ_NULL; // op not supported
+    }
+    displayio_rlebitmap_t *self = MP_OBJ_TO_PTR(self_in);
+
+    uint16_t x = 0;
+    uint16_t y = 0;
+    if (MP_OBJ_IS_SMALL_INT(index_obj)) {
+        mp_int_t i = MP_OBJ_SMALL_INT_VALUE(index_obj);
+        uint16_t width = common_hal_displayio_rlebitmap_get_width(self);
+        x = i % width;
+        y = i / width;
+    } else {
+        mp_obj_t* items;
+        mp_obj_get_array_fixed_n(index_obj, 2, &items);
+        x = mp_obj_get_int(items[0]);
+        y = mp_obj_get_int(items[1]);
+        if (x >= common_hal_displayio_rlebitmap_get_width(self) || y >= common_hal_displayio_rlebitmap_get_height(self)) {
+            mp_raise_IndexError(translate("pixel coordinates out of bounds"));
+        }
+    }
+    return mp_obj_new_int_from_uint(common_hal_displayio_rlebitmap_get_pixel(self, x, y));
+}
+
+STATIC const mp_rom_map_elem_t displayio_rlebitmap_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_height), MP_ROM_PTR(&displayio_rlebitmap_height_obj) },
+    { MP_ROM_QSTR(MP_QSTR_width), MP_ROM_PTR(&displayio_rlebitmap_width_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(displayio_rlebitmap_locals_dict, displayio_rlebitmap_locals_dict_table);
+
+const mp_obj_type_t displayio_rlebitmap_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_RLEBitmap,
+    .make_new = displayio_rlebitmap_make_new,
+    .subscr = rlebitmap_subscr,
+    .locals_dict = (mp_obj_dict_t*)&displayio_rlebitmap_locals_dict,
+};
@@ -31,6 +31,7 @@
 #include "py/binary.h"
 #include "py/objproperty.h"
 #include "py/runtime.h"
+#include "shared-bindings/displayio/__init__.h"
 #include "shared-bindings/util.h"
 #include "supervisor/shared/translate.h"
 
@@ -108,8 +109,45 @@ STATIC mp_obj_t displayio_shape_obj_set_boundary(size_t n_args, const mp_obj_t *
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(displayio_shape_set_boundary_obj, 4, 4, displayio_shape_obj_set_boundary);
 
+//|   .. method:: set_circle(x, y, radius)
+//|
+//|     Replaces every row's boundary with the filled circle centered on x,y. Rows the circle
+//|     doesn't cover are empty. Only the stored top left of a mirrored shape is used.
+//|
+STATIC mp_obj_t displayio_shape_obj_set_circle(size_t n_args, const mp_obj_t *args) {
+    (void) n_args;
+    displayio_shape_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_int_t radius = mp_obj_get_int(args[3]);
+    if (radius < 0 || radius > 0x7fff) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+    common_hal_displayio_shape_set_circle(self, mp_obj_get_int(args[1]), mp_obj_get_int(args[2]), radius);
+
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(displayio_shape_set_circle_obj, 4, 4, displayio_shape_obj_set_circle);
+
+//|   .. method:: set_polygon(points)
+//|
+//|     Replaces every row's boundary with the polygon through the given (x, y) tuples. Each row
+//|     covers from the leftmost to the rightmost pixel of the polygon on it so the polygon should
+//|     be convex.
+//|
+STATIC mp_obj_t displayio_shape_obj_set_polygon(mp_obj_t self_in, mp_obj_t points_obj) {
+    displayio_shape_t *self = MP_OBJ_TO_PTR(self_in);
+    uint16_t point_count;
+    int16_t* points = displayio_get_points(points_obj, &point_count);
+    common_hal_displayio_shape_set_polygon(self, points, point_count);
+    m_del(int16_t, points, 2 * point_count);
+
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(displayio_shape_set_polygon_obj, displayio_shape_obj_set_polygon);
+
 STATIC const mp_rom_map_elem_t displayio_shape_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_set_boundary), MP_ROM_PTR(&displayio_shape_set_boundary_obj) },
+    { MP_ROM_QSTR(MP_QSTR_set_circle), MP_ROM_PTR(&displayio_shape_set_circle_obj) },
+    { MP_ROM_QSTR(MP_QSTR_set_polygon), MP_ROM_PTR(&displayio_shape_set_polygon_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(displayio_shape_locals_dict, displayio_shape_locals_dict_table);
 
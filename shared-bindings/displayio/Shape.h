@@ -36,6 +36,8 @@ void common_hal_displayio_shape_construct(displayio_shape_t *self, uint32_t widt
 
 void common_hal_displayio_shape_set_boundary(displayio_shape_t *self, uint16_t y, uint16_t start_x,
                                              uint16_t end_x);
+void common_hal_displayio_shape_set_circle(displayio_shape_t *self, int16_t x, int16_t y, uint16_t radius);
+void common_hal_displayio_shape_set_polygon(displayio_shape_t *self, const int16_t* points, uint16_t point_count);
 uint32_t common_hal_displayio_shape_get_pixel(void *shape, int16_t x, int16_t y);
 
 #endif // MICROPY_INCLUDED_SHARED_BINDINGS_DISPLAYIO_SHAPE_H
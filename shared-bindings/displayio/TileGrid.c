@@ -35,8 +35,11 @@
 #include "py/runtime.h"
 #include "shared-bindings/displayio/Bitmap.h"
 #include "shared-bindings/displayio/ColorConverter.h"
+#if CIRCUITPY_DISPLAYIO_HARDWARE
 #include "shared-bindings/displayio/OnDiskBitmap.h"
+#endif
 #include "shared-bindings/displayio/Palette.h"
+#include "shared-bindings/displayio/RLEBitmap.h"
 #include "shared-bindings/displayio/Shape.h"
 #include "supervisor/shared/translate.h"
 
@@ -98,11 +101,18 @@ STATIC mp_obj_t displayio_tilegrid_make_new(const mp_obj_type_t *type, size_t n_
         native = bitmap;
         bitmap_width = bmp->width;
         bitmap_height = bmp->height;
+    #if CIRCUITPY_DISPLAYIO_HARDWARE
     } else if (MP_OBJ_IS_TYPE(bitmap, &displayio_ondiskbitmap_type)) {
         displayio_ondiskbitmap_t* bmp = MP_OBJ_TO_PTR(bitmap);
         native = bitmap;
         bitmap_width = bmp->width;
         bitmap_height = bmp->height;
+    #endif
+    } else if (MP_OBJ_IS_TYPE(bitmap, &displayio_rlebitmap_type)) {
+        displayio_rlebitmap_t* bmp = MP_OBJ_TO_PTR(bitmap);
+        native = bitmap;
+        bitmap_width = bmp->width;
+        bitmap_height = bmp->height;
     } else {
         mp_raise_TypeError_varg(translate("unsupported %q type"), MP_QSTR_bitmap);
     }
@@ -327,6 +337,98 @@ const mp_obj_property_t displayio_tilegrid_pixel_shader_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+//|   .. attribute:: animating
+//|
+//|     True while an animation started with `animate` is running. (read only)
+//|
+STATIC mp_obj_t displayio_tilegrid_obj_get_animating(mp_obj_t self_in) {
+    displayio_tilegrid_t *self = native_tilegrid(self_in);
+    return mp_obj_new_bool(common_hal_displayio_tilegrid_get_animating(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(displayio_tilegrid_get_animating_obj, displayio_tilegrid_obj_get_animating);
+
+const mp_obj_property_t displayio_tilegrid_animating_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&displayio_tilegrid_get_animating_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. method:: animate(frames, *, frame_period=0.1, velocity=(0, 0), loop=True)
+//|
+//|     Animates the tilegrid in the background while it is shown. Every tile shows each tile index
+//|     in frames for frame_period seconds, and the tilegrid moves at the given velocity.
+//|     Changes are drawn by the normal display refresh so no Python code runs per frame.
+//|
+//|     Calling it again replaces the running animation. Setting x, y or tiles while animating
+//|     is overridden by the next frame.
+//|
+//|     :param list frames: Tile indices to show in order. May be empty to only move.
+//|     :param float frame_period: Seconds to show each frame
+//|     :param tuple velocity: Pixels per second to move in x and y
+//|     :param bool loop: Show the frames again after the last one. Otherwise, the last frame
+//|       stays while the tilegrid keeps moving.
+//|
+STATIC mp_obj_t displayio_tilegrid_obj_animate(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_frames, ARG_frame_period, ARG_velocity, ARG_loop };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_frames, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_frame_period, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_velocity, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_loop, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = true} },
+    };
+    displayio_tilegrid_t *self = native_tilegrid(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    size_t frame_count;
+    mp_obj_t* frame_items;
+    mp_obj_get_array(args[ARG_frames].u_obj, &frame_count, &frame_items);
+    if (frame_count > 0xffff) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+    uint8_t frames[frame_count > 0 ? frame_count : 1];
+    for (size_t i = 0; i < frame_count; i++) {
+        mp_int_t value = mp_obj_get_int(frame_items[i]);
+        if (value < 0 || value > 255) {
+            mp_raise_ValueError(translate("Tile value out of bounds"));
+        }
+        frames[i] = value;
+    }
+
+    mp_float_t frame_period = MICROPY_FLOAT_CONST(0.1);
+    if (args[ARG_frame_period].u_obj != mp_const_none) {
+        frame_period = mp_obj_get_float(args[ARG_frame_period].u_obj);
+    }
+    if (frame_period < 0) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+
+    int16_t dx = 0;
+    int16_t dy = 0;
+    if (args[ARG_velocity].u_obj != mp_const_none) {
+        mp_obj_t* items;
+        mp_obj_get_array_fixed_n(args[ARG_velocity].u_obj, 2, &items);
+        dx = mp_obj_get_int(items[0]);
+        dy = mp_obj_get_int(items[1]);
+    }
+
+    common_hal_displayio_tilegrid_animate(self, frames, frame_count, frame_period * 1000, dx, dy, args[ARG_loop].u_bool);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(displayio_tilegrid_animate_obj, 2, displayio_tilegrid_obj_animate);
+
+//|   .. method:: stop_animation()
+//|
+//|     Stops the animation and leaves the tilegrid at its current frame and position.
+//|
+STATIC mp_obj_t displayio_tilegrid_obj_stop_animation(mp_obj_t self_in) {
+    displayio_tilegrid_t *self = native_tilegrid(self_in);
+    common_hal_displayio_tilegrid_stop_animation(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(displayio_tilegrid_stop_animation_obj, displayio_tilegrid_obj_stop_animation);
+
 //|   .. method:: __getitem__(index)
 //|
 //|     Returns the tile index at the given index. The index can either be an x,y tuple or an int equal
@@ -399,6 +501,11 @@ STATIC const mp_rom_map_elem_t displayio_tilegrid_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_flip_y), MP_ROM_PTR(&displayio_tilegrid_flip_y_obj) },
     { MP_ROM_QSTR(MP_QSTR_transpose_xy), MP_ROM_PTR(&displayio_tilegrid_transpose_xy_obj) },
     { MP_ROM_QSTR(MP_QSTR_pixel_shader),          MP_ROM_PTR(&displayio_tilegrid_pixel_shader_obj) },
+    { MP_ROM_QSTR(MP_QSTR_animating), MP_ROM_PTR(&displayio_tilegrid_animating_obj) },
+
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_animate), MP_ROM_PTR(&displayio_tilegrid_animate_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop_animation), MP_ROM_PTR(&displayio_tilegrid_stop_animation_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(displayio_tilegrid_locals_dict, displayio_tilegrid_locals_dict_table);
 
@@ -62,4 +62,9 @@ void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t
 // Private API for scrolling the TileGrid.
 void common_hal_displayio_tilegrid_set_top_left(displayio_tilegrid_t *self, uint16_t x, uint16_t y);
 
+void common_hal_displayio_tilegrid_animate(displayio_tilegrid_t *self, const uint8_t* frames, uint16_t frame_count,
+    uint32_t frame_period_ms, int16_t dx, int16_t dy, bool loop);
+void common_hal_displayio_tilegrid_stop_animation(displayio_tilegrid_t *self);
+bool common_hal_displayio_tilegrid_get_animating(displayio_tilegrid_t *self);
+
 #endif // MICROPY_INCLUDED_SHARED_BINDINGS_DISPLAYIO_TILEGRID_H
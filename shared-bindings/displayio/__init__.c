@@ -33,15 +33,22 @@
 #include "shared-bindings/displayio/Bitmap.h"
 #include "shared-bindings/displayio/ColorConverter.h"
 #include "shared-bindings/displayio/Display.h"
+#include "shared-bindings/displayio/Group.h"
+#include "shared-bindings/displayio/Palette.h"
+#include "shared-bindings/displayio/RLEBitmap.h"
+#include "shared-bindings/displayio/Shape.h"
+#if CIRCUITPY_DISPLAYIO_HARDWARE
 #include "shared-bindings/displayio/EPaperDisplay.h"
 #include "shared-bindings/displayio/FourWire.h"
-#include "shared-bindings/displayio/Group.h"
 #include "shared-bindings/displayio/I2CDisplay.h"
 #include "shared-bindings/displayio/OnDiskBitmap.h"
-#include "shared-bindings/displayio/Palette.h"
 #include "shared-bindings/displayio/ParallelBus.h"
-#include "shared-bindings/displayio/Shape.h"
+#endif
+#if CIRCUITPY_DISPLAYIO_FRAMEBUFFERBUS
+#include "shared-bindings/displayio/FramebufferBus.h"
+#endif
 #include "shared-bindings/displayio/TileGrid.h"
+#include "supervisor/shared/translate.h"
 
 //| :mod:`displayio` --- Native display driving
 //| =========================================================================
@@ -63,10 +70,12 @@
 //|     Display
 //|     EPaperDisplay
 //|     FourWire
+//|     FramebufferBus
 //|     Group
 //|     I2CDisplay
 //|     OnDiskBitmap
 //|     Palette
+//|     RLEBitmap
 //|     ParallelBus
 //|     Shape
 //|     TileGrid
@@ -88,21 +97,49 @@ STATIC mp_obj_t displayio_release_displays(void) {
 }
 MP_DEFINE_CONST_FUN_OBJ_0(displayio_release_displays_obj, displayio_release_displays);
 
+int16_t* displayio_get_points(mp_obj_t points_obj, uint16_t* point_count) {
+    size_t len;
+    mp_obj_t* items;
+    mp_obj_get_array(points_obj, &len, &items);
+    if (len > 0xffff) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+    int16_t* points = m_new(int16_t, 2 * len);
+    for (size_t i = 0; i < len; i++) {
+        mp_obj_t* point;
+        mp_obj_get_array_fixed_n(items[i], 2, &point);
+        points[2 * i] = mp_obj_get_int(point[0]);
+        points[2 * i + 1] = mp_obj_get_int(point[1]);
+    }
+    *point_count = len;
+    return points;
+}
+
 STATIC const mp_rom_map_elem_t displayio_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_displayio) },
     { MP_ROM_QSTR(MP_QSTR_Bitmap), MP_ROM_PTR(&displayio_bitmap_type) },
     { MP_ROM_QSTR(MP_QSTR_ColorConverter), MP_ROM_PTR(&displayio_colorconverter_type) },
     { MP_ROM_QSTR(MP_QSTR_Display), MP_ROM_PTR(&displayio_display_type) },
+    #if CIRCUITPY_DISPLAYIO_HARDWARE
     { MP_ROM_QSTR(MP_QSTR_EPaperDisplay), MP_ROM_PTR(&displayio_epaperdisplay_type) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_Group), MP_ROM_PTR(&displayio_group_type) },
+    #if CIRCUITPY_DISPLAYIO_HARDWARE
     { MP_ROM_QSTR(MP_QSTR_OnDiskBitmap), MP_ROM_PTR(&displayio_ondiskbitmap_type) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_Palette), MP_ROM_PTR(&displayio_palette_type) },
+    { MP_ROM_QSTR(MP_QSTR_RLEBitmap), MP_ROM_PTR(&displayio_rlebitmap_type) },
     { MP_ROM_QSTR(MP_QSTR_Shape), MP_ROM_PTR(&displayio_shape_type) },
     { MP_ROM_QSTR(MP_QSTR_TileGrid), MP_ROM_PTR(&displayio_tilegrid_type) },
 
+    #if CIRCUITPY_DISPLAYIO_HARDWARE
     { MP_ROM_QSTR(MP_QSTR_FourWire), MP_ROM_PTR(&displayio_fourwire_type) },
     { MP_ROM_QSTR(MP_QSTR_I2CDisplay), MP_ROM_PTR(&displayio_i2cdisplay_type) },
     { MP_ROM_QSTR(MP_QSTR_ParallelBus), MP_ROM_PTR(&displayio_parallelbus_type) },
+    #endif
+    #if CIRCUITPY_DISPLAYIO_FRAMEBUFFERBUS
+    { MP_ROM_QSTR(MP_QSTR_FramebufferBus), MP_ROM_PTR(&displayio_framebufferbus_type) },
+    #endif
 
     { MP_ROM_QSTR(MP_QSTR_release_displays), MP_ROM_PTR(&displayio_release_displays_obj) },
 };
@@ -47,4 +47,7 @@ typedef void (*display_bus_end_transaction)(mp_obj_t bus);
 
 void common_hal_displayio_release_displays(void);
 
+// Converts a sequence of (x, y) tuples into x, y pairs allocated on the heap.
+int16_t* displayio_get_points(mp_obj_t points_obj, uint16_t* point_count);
+
 #endif  // MICROPY_INCLUDED_SHARED_BINDINGS_DISPLAYIO___INIT___H
@@ -0,0 +1,276 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "py/binary.h"
+#include "py/obj.h"
+#include "py/runtime.h"
+#include "shared-bindings/fixedpoint/__init__.h"
+#include "supervisor/shared/translate.h"
+
+//| :mod:`fixedpoint` --- Q15 and Q31 fixed-point arithmetic
+//| ========================================================
+//|
+//| .. module:: fixedpoint
+//|   :synopsis: Q15 and Q31 fixed-point arithmetic
+//|
+//| The `fixedpoint` module does saturating fractional arithmetic with integer instructions only,
+//| for boards without a floating point unit. A Q15 value is an integer ``q`` standing for
+//| ``q / 32768``, from -1.0 up to just under 1.0, and a Q31 value is one standing for
+//| ``q / 2**31``. Q15 values are small integers, so working with them doesn't allocate.
+//|
+//| Arrays are `array.array` objects with typecode ``'h'`` for Q15 and ``'i'`` for Q31. Results
+//| are rounded and clamped to the range of the format rather than wrapping around.
+//|
+
+// Q15 scalars are ints in the int16_t range.
+STATIC int16_t get_q15(mp_obj_t obj) {
+    mp_int_t value = mp_obj_get_int(obj);
+    if (value < INT16_MIN || value > INT16_MAX) {
+        mp_raise_ValueError_varg(translate("%q must be %d-%d"), MP_QSTR_value, INT16_MIN, INT16_MAX);
+    }
+    return value;
+}
+
+// Gets the buffer of a Q15 or Q31 array and returns its length in items.
+STATIC size_t get_array(mp_obj_t obj, mp_buffer_info_t *bufinfo, mp_uint_t flags, bool *q31) {
+    mp_get_buffer_raise(obj, bufinfo, flags);
+    size_t item_size = mp_binary_get_size('@', bufinfo->typecode, NULL);
+    if (bufinfo->typecode == 'h') {
+        *q31 = false;
+    } else if ((bufinfo->typecode == 'i' || bufinfo->typecode == 'l') && item_size == 4) {
+        *q31 = true;
+    } else {
+        mp_raise_ValueError(translate("bad typecode"));
+    }
+    return bufinfo->len / item_size;
+}
+
+// Gets the buffer of an array that must match the first one's format and length.
+STATIC void get_matching_array(mp_obj_t obj, mp_buffer_info_t *bufinfo, mp_uint_t flags, bool q31, size_t len) {
+    bool this_q31;
+    if (get_array(obj, bufinfo, flags, &this_q31) != len || this_q31 != q31) {
+        mp_raise_ValueError(translate("Arrays must be the same type and length"));
+    }
+}
+
+//| .. function:: from_float(x, *, q31=False)
+//|
+//|   Returns the Q15 value (or Q31 value with ``q31=True``) closest to ``x``, clamped to the
+//|   range of the format. Converting constants once up front keeps floats out of loops.
+//|
+STATIC mp_obj_t fixedpoint_from_float(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_x, ARG_q31 };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_x, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_q31, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_float_t x = mp_obj_get_float(args[ARG_x].u_obj);
+    mp_float_t scale = args[ARG_q31].u_bool ? MICROPY_FLOAT_CONST(2147483648.0) : MICROPY_FLOAT_CONST(32768.0);
+    int32_t max = args[ARG_q31].u_bool ? INT32_MAX : INT16_MAX;
+    mp_float_t value = x * scale;
+    value += value < 0 ? MICROPY_FLOAT_CONST(-0.5) : MICROPY_FLOAT_CONST(0.5);
+    // Clamp before converting since a single precision scale - 1 rounds back up to scale.
+    if (value >= scale) {
+        return mp_obj_new_int(max);
+    } else if (value <= -scale) {
+        return mp_obj_new_int(-max - 1);
+    }
+    return mp_obj_new_int((int32_t) value);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(fixedpoint_from_float_obj, 1, fixedpoint_from_float);
+
+//| .. function:: to_float(value, *, q31=False)
+//|
+//|   Returns the number that the Q15 value (or Q31 value with ``q31=True``) stands for.
+//|
+STATIC mp_obj_t fixedpoint_to_float(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_value, ARG_q31 };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_value, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_q31, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_float_t scale = args[ARG_q31].u_bool ? MICROPY_FLOAT_CONST(2147483648.0) : MICROPY_FLOAT_CONST(32768.0);
+    return mp_obj_new_float(mp_obj_get_float(args[ARG_value].u_obj) / scale);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(fixedpoint_to_float_obj, 1, fixedpoint_to_float);
+
+//| .. function:: add(a, b)
+//|
+//|   Returns the Q15 sum of ``a`` and ``b``.
+//|
+STATIC mp_obj_t fixedpoint_add(mp_obj_t a_in, mp_obj_t b_in) {
+    return MP_OBJ_NEW_SMALL_INT(shared_modules_fixedpoint_add_q15(get_q15(a_in), get_q15(b_in)));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(fixedpoint_add_obj, fixedpoint_add);
+
+//| .. function:: sub(a, b)
+//|
+//|   Returns the Q15 difference ``a - b``.
+//|
+STATIC mp_obj_t fixedpoint_sub(mp_obj_t a_in, mp_obj_t b_in) {
+    return MP_OBJ_NEW_SMALL_INT(shared_modules_fixedpoint_sub_q15(get_q15(a_in), get_q15(b_in)));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(fixedpoint_sub_obj, fixedpoint_sub);
+
+//| .. function:: mul(a, b)
+//|
+//|   Returns the Q15 product of ``a`` and ``b``.
+//|
+STATIC mp_obj_t fixedpoint_mul(mp_obj_t a_in, mp_obj_t b_in) {
+    return MP_OBJ_NEW_SMALL_INT(shared_modules_fixedpoint_mul_q15(get_q15(a_in), get_q15(b_in)));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(fixedpoint_mul_obj, fixedpoint_mul);
+
+//| .. function:: add_array(dest, a, b)
+//|
+//|   Stores the sums of the items of arrays ``a`` and ``b`` into ``dest``. All three must have
+//|   the same type and length. ``dest`` may be ``a`` or ``b``.
+//|
+STATIC mp_obj_t fixedpoint_add_array(mp_obj_t dest_in, mp_obj_t a_in, mp_obj_t b_in) {
+    mp_buffer_info_t dest, a, b;
+    bool q31;
+    size_t len = get_array(dest_in, &dest, MP_BUFFER_WRITE, &q31);
+    get_matching_array(a_in, &a, MP_BUFFER_READ, q31, len);
+    get_matching_array(b_in, &b, MP_BUFFER_READ, q31, len);
+    if (q31) {
+        shared_modules_fixedpoint_add_q31_array(dest.buf, a.buf, b.buf, len);
+    } else {
+        shared_modules_fixedpoint_add_q15_array(dest.buf, a.buf, b.buf, len);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(fixedpoint_add_array_obj, fixedpoint_add_array);
+
+//| .. function:: mul_array(dest, a, b)
+//|
+//|   Stores the products of the items of arrays ``a`` and ``b`` into ``dest``. All three must
+//|   have the same type and length. ``dest`` may be ``a`` or ``b``.
+//|
+STATIC mp_obj_t fixedpoint_mul_array(mp_obj_t dest_in, mp_obj_t a_in, mp_obj_t b_in) {
+    mp_buffer_info_t dest, a, b;
+    bool q31;
+    size_t len = get_array(dest_in, &dest, MP_BUFFER_WRITE, &q31);
+    get_matching_array(a_in, &a, MP_BUFFER_READ, q31, len);
+    get_matching_array(b_in, &b, MP_BUFFER_READ, q31, len);
+    if (q31) {
+        shared_modules_fixedpoint_mul_q31_array(dest.buf, a.buf, b.buf, len);
+    } else {
+        shared_modules_fixedpoint_mul_q15_array(dest.buf, a.buf, b.buf, len);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(fixedpoint_mul_array_obj, fixedpoint_mul_array);
+
+//| .. function:: scale_array(dest, src, gain)
+//|
+//|   Stores the items of array ``src`` multiplied by the Q15 value ``gain`` into ``dest``, which
+//|   must have the same type and length. ``dest`` may be ``src``.
+//|
+STATIC mp_obj_t fixedpoint_scale_array(mp_obj_t dest_in, mp_obj_t src_in, mp_obj_t gain_in) {
+    mp_buffer_info_t dest, src;
+    bool q31;
+    size_t len = get_array(dest_in, &dest, MP_BUFFER_WRITE, &q31);
+    get_matching_array(src_in, &src, MP_BUFFER_READ, q31, len);
+    int16_t gain = get_q15(gain_in);
+    if (q31) {
+        shared_modules_fixedpoint_scale_q31_array(dest.buf, src.buf, gain, len);
+    } else {
+        shared_modules_fixedpoint_scale_q15_array(dest.buf, src.buf, gain, len);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(fixedpoint_scale_array_obj, fixedpoint_scale_array);
+
+//| .. function:: dot(a, b)
+//|
+//|   Returns the sum of the products of the items of arrays ``a`` and ``b``, in their format.
+//|
+STATIC mp_obj_t fixedpoint_dot(mp_obj_t a_in, mp_obj_t b_in) {
+    mp_buffer_info_t a, b;
+    bool q31;
+    size_t len = get_array(a_in, &a, MP_BUFFER_READ, &q31);
+    get_matching_array(b_in, &b, MP_BUFFER_READ, q31, len);
+    if (q31) {
+        return mp_obj_new_int(shared_modules_fixedpoint_dot_q31(a.buf, b.buf, len));
+    }
+    return MP_OBJ_NEW_SMALL_INT(shared_modules_fixedpoint_dot_q15(a.buf, b.buf, len));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(fixedpoint_dot_obj, fixedpoint_dot);
+
+//| .. function:: fir(dest, src, taps)
+//|
+//|   Runs array ``src`` through the FIR filter with coefficients ``taps`` and stores the result
+//|   into ``dest``. Each output uses ``len(taps)`` inputs, the last of which is the one at the
+//|   same position plus ``len(taps) - 1``, so ``src`` must have ``len(taps) - 1`` more items than
+//|   ``dest``. To filter a stream, keep the last ``len(taps) - 1`` inputs at the start of
+//|   ``src`` for the next call. All three arrays must have the same type.
+//|
+STATIC mp_obj_t fixedpoint_fir(mp_obj_t dest_in, mp_obj_t src_in, mp_obj_t taps_in) {
+    mp_buffer_info_t dest, src, taps;
+    bool q31, src_q31, taps_q31;
+    size_t dest_len = get_array(dest_in, &dest, MP_BUFFER_WRITE, &q31);
+    size_t src_len = get_array(src_in, &src, MP_BUFFER_READ, &src_q31);
+    size_t n_taps = get_array(taps_in, &taps, MP_BUFFER_READ, &taps_q31);
+    if (src_q31 != q31 || taps_q31 != q31 || n_taps == 0 || src_len != dest_len + n_taps - 1) {
+        mp_raise_ValueError(translate("Arrays must be the same type and length"));
+    }
+    if (q31) {
+        shared_modules_fixedpoint_fir_q31(dest.buf, dest_len, src.buf, taps.buf, n_taps);
+    } else {
+        shared_modules_fixedpoint_fir_q15(dest.buf, dest_len, src.buf, taps.buf, n_taps);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(fixedpoint_fir_obj, fixedpoint_fir);
+
+STATIC const mp_rom_map_elem_t fixedpoint_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_fixedpoint) },
+    { MP_ROM_QSTR(MP_QSTR_from_float), MP_ROM_PTR(&fixedpoint_from_float_obj) },
+    { MP_ROM_QSTR(MP_QSTR_to_float), MP_ROM_PTR(&fixedpoint_to_float_obj) },
+    { MP_ROM_QSTR(MP_QSTR_add), MP_ROM_PTR(&fixedpoint_add_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sub), MP_ROM_PTR(&fixedpoint_sub_obj) },
+    { MP_ROM_QSTR(MP_QSTR_mul), MP_ROM_PTR(&fixedpoint_mul_obj) },
+    { MP_ROM_QSTR(MP_QSTR_add_array), MP_ROM_PTR(&fixedpoint_add_array_obj) },
+    { MP_ROM_QSTR(MP_QSTR_mul_array), MP_ROM_PTR(&fixedpoint_mul_array_obj) },
+    { MP_ROM_QSTR(MP_QSTR_scale_array), MP_ROM_PTR(&fixedpoint_scale_array_obj) },
+    { MP_ROM_QSTR(MP_QSTR_dot), MP_ROM_PTR(&fixedpoint_dot_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fir), MP_ROM_PTR(&fixedpoint_fir_obj) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(fixedpoint_module_globals, fixedpoint_module_globals_table);
+
+const mp_obj_module_t fixedpoint_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t*)&fixedpoint_module_globals,
+};
@@ -0,0 +1,53 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_FIXEDPOINT___INIT___H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_FIXEDPOINT___INIT___H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Q15 values are int16_t fractions of 1 << 15 and Q31 values int32_t fractions of 1 << 31.
+// Results are rounded and saturate rather than wrap.
+
+int16_t shared_modules_fixedpoint_add_q15(int16_t a, int16_t b);
+int16_t shared_modules_fixedpoint_sub_q15(int16_t a, int16_t b);
+int16_t shared_modules_fixedpoint_mul_q15(int16_t a, int16_t b);
+
+void shared_modules_fixedpoint_add_q15_array(int16_t *dest, const int16_t *a, const int16_t *b, size_t len);
+void shared_modules_fixedpoint_add_q31_array(int32_t *dest, const int32_t *a, const int32_t *b, size_t len);
+void shared_modules_fixedpoint_mul_q15_array(int16_t *dest, const int16_t *a, const int16_t *b, size_t len);
+void shared_modules_fixedpoint_mul_q31_array(int32_t *dest, const int32_t *a, const int32_t *b, size_t len);
+// gain is Q15 for both.
+void shared_modules_fixedpoint_scale_q15_array(int16_t *dest, const int16_t *src, int16_t gain, size_t len);
+void shared_modules_fixedpoint_scale_q31_array(int32_t *dest, const int32_t *src, int16_t gain, size_t len);
+int16_t shared_modules_fixedpoint_dot_q15(const int16_t *a, const int16_t *b, size_t len);
+int32_t shared_modules_fixedpoint_dot_q31(const int32_t *a, const int32_t *b, size_t len);
+// Each of the dest_len outputs uses n_taps inputs, so src holds dest_len + n_taps - 1 items.
+void shared_modules_fixedpoint_fir_q15(int16_t *dest, size_t dest_len, const int16_t *src, const int16_t *taps, size_t n_taps);
+void shared_modules_fixedpoint_fir_q31(int32_t *dest, size_t dest_len, const int32_t *src, const int32_t *taps, size_t n_taps);
+
+#endif  // MICROPY_INCLUDED_SHARED_BINDINGS_FIXEDPOINT___INIT___H
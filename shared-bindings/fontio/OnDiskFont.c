@@ -0,0 +1,122 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/fontio/OnDiskFont.h"
+
+#include <stdint.h>
+
+#include "py/runtime.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: fontio
+//|
+//| :class:`OnDiskFont` -- Loads glyphs straight from disk
+//| ==========================================================================
+//|
+//| Loads glyphs from a font file on demand and keeps the most recently used ones. Glyphs are
+//| read from the file as they are needed rather than parsed into memory up front.
+//|
+//| The file starts with a 12 byte header: ``CPF`` followed by a format version of 1, the bits
+//| per pixel (1, 2, 4 or 8), the width and height of the bounding box, a reserved byte, a 16-bit
+//| glyph count and two reserved bytes. A 16 byte entry for each glyph follows, sorted by
+//| codepoint: a 32-bit codepoint, the 32-bit file offset of the glyph's pixels, then width,
+//| height, dx, dy, shift_x and shift_y as single bytes with the last four signed, plus two
+//| reserved bytes. Multi-byte values are little endian. Each row of pixels starts on a new byte
+//| with the leftmost pixel in the most significant bits.
+//|
+//| .. class:: OnDiskFont(file, *, cache_size=64)
+//|
+//|   Create an OnDiskFont object with the given file.
+//|
+//|   The file must be kept open while the font is used.
+//|
+//|   :param file file: The open font file
+//|   :param int cache_size: The number of glyphs to keep loaded
+//|
+STATIC mp_obj_t fontio_ondiskfont_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_file, ARG_cache_size };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_file, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_cache_size, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 64} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if (!MP_OBJ_IS_TYPE(args[ARG_file].u_obj, &mp_type_fileio)) {
+        mp_raise_TypeError(translate("file must be a file opened in byte mode"));
+    }
+    mp_int_t cache_size = args[ARG_cache_size].u_int;
+    if (cache_size < 1 || cache_size > 0xffff) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_cache_size);
+    }
+
+    fontio_ondiskfont_t *self = m_new_obj(fontio_ondiskfont_t);
+    self->base.type = &fontio_ondiskfont_type;
+    common_hal_fontio_ondiskfont_construct(self, MP_OBJ_TO_PTR(args[ARG_file].u_obj), cache_size);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: get_bounding_box()
+//|
+//|     Returns the maximum bounds of all glyphs in the font in a tuple of two values: width, height.
+//|
+STATIC mp_obj_t fontio_ondiskfont_obj_get_bounding_box(mp_obj_t self_in) {
+    fontio_ondiskfont_t *self = MP_OBJ_TO_PTR(self_in);
+
+    return common_hal_fontio_ondiskfont_get_bounding_box(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(fontio_ondiskfont_get_bounding_box_obj, fontio_ondiskfont_obj_get_bounding_box);
+
+//|   .. method:: get_glyph(codepoint)
+//|
+//|     Returns a `fontio.Glyph` for the given codepoint or None if no glyph is available. Each
+//|     glyph has its own read-only `displayio.Bitmap` and a tile_index of 0 so it can be shown
+//|     with a `displayio.TileGrid`.
+//|
+STATIC mp_obj_t fontio_ondiskfont_obj_get_glyph(mp_obj_t self_in, mp_obj_t codepoint_obj) {
+    fontio_ondiskfont_t *self = MP_OBJ_TO_PTR(self_in);
+
+    mp_int_t codepoint;
+    if (!mp_obj_get_int_maybe(codepoint_obj, &codepoint)) {
+        mp_raise_ValueError_varg(translate("%q should be an int"), MP_QSTR_codepoint);
+    }
+    return common_hal_fontio_ondiskfont_get_glyph(self, codepoint);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(fontio_ondiskfont_get_glyph_obj, fontio_ondiskfont_obj_get_glyph);
+
+STATIC const mp_rom_map_elem_t fontio_ondiskfont_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_get_bounding_box), MP_ROM_PTR(&fontio_ondiskfont_get_bounding_box_obj) },
+    { MP_ROM_QSTR(MP_QSTR_get_glyph), MP_ROM_PTR(&fontio_ondiskfont_get_glyph_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(fontio_ondiskfont_locals_dict, fontio_ondiskfont_locals_dict_table);
+
+const mp_obj_type_t fontio_ondiskfont_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_OnDiskFont,
+    .make_new = fontio_ondiskfont_make_new,
+    .locals_dict = (mp_obj_dict_t*)&fontio_ondiskfont_locals_dict,
+};
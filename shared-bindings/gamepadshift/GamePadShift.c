@@ -37,13 +37,16 @@
 //| :class:`GamePadShift` -- Scan buttons for presses through a shift register
 //| ===========================================================================
 //|
-//| .. class:: GamePadShift(clock, data, latch)
+//| .. class:: GamePadShift(clock, data, latch, *, buttons=8)
 //|
 //|     Initializes button scanning routines.
 //|
 //|     The ``clock``, ``data`` and ``latch`` parameters are ``DigitalInOut``
 //|     objects connected to the shift register controlling the buttons.
 //|
+//|     ``buttons`` is the number of inputs to read, up to 32. Use more than 8
+//|     when shift registers are chained, such as 16 for two 74HC165s.
+//|
 //|     They button presses are accumulated, until the ``get_pressed`` method
 //|     is called, at which point the button state is cleared, and the new
 //|     button presses start to be recorded.
@@ -54,11 +57,12 @@
 STATIC mp_obj_t gamepadshift_make_new(const mp_obj_type_t *type, size_t n_args,
         const mp_obj_t *pos_args, mp_map_t *kw_args) {
 
-    enum { ARG_clock, ARG_data, ARG_latch };
+    enum { ARG_clock, ARG_data, ARG_latch, ARG_buttons };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_clock, MP_ARG_REQUIRED | MP_ARG_OBJ},
         { MP_QSTR_data, MP_ARG_REQUIRED | MP_ARG_OBJ },
         { MP_QSTR_latch, MP_ARG_REQUIRED | MP_ARG_OBJ},
+        { MP_QSTR_buttons, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 8} },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args),
@@ -67,6 +71,10 @@ STATIC mp_obj_t gamepadshift_make_new(const mp_obj_type_t *type, size_t n_args,
     digitalio_digitalinout_obj_t *clock_pin = assert_digitalinout(args[ARG_clock].u_obj);
     digitalio_digitalinout_obj_t *data_pin = assert_digitalinout(args[ARG_data].u_obj);
     digitalio_digitalinout_obj_t *latch_pin = assert_digitalinout(args[ARG_latch].u_obj);
+    mp_int_t buttons = args[ARG_buttons].u_int;
+    if (buttons < 1 || buttons > 32) {
+        mp_raise_ValueError(translate("buttons must be 1-32"));
+    }
 
     gamepadshift_obj_t* gamepad_singleton = MP_STATE_VM(gamepad_singleton);
     if (!gamepad_singleton ||
@@ -77,7 +85,7 @@ STATIC mp_obj_t gamepadshift_make_new(const mp_obj_type_t *type, size_t n_args,
         gamepad_singleton = gc_make_long_lived(gamepad_singleton);
         MP_STATE_VM(gamepad_singleton) = gamepad_singleton;
     }
-    common_hal_gamepadshift_gamepadshift_init(gamepad_singleton, clock_pin, data_pin, latch_pin);
+    common_hal_gamepadshift_gamepadshift_init(gamepad_singleton, clock_pin, data_pin, latch_pin, buttons);
     return MP_OBJ_FROM_PTR(gamepad_singleton);
 }
 
@@ -85,15 +93,16 @@ STATIC mp_obj_t gamepadshift_make_new(const mp_obj_type_t *type, size_t n_args,
 //|
 //|         Get the status of buttons pressed since the last call and clear it.
 //|
-//|         Returns an 8-bit number, with bits that correspond to buttons,
-//|         which have been pressed (or held down) since the last call to this
-//|         function set to 1, and the remaining bits set to 0. Then it clears
+//|         Returns a number with one bit per button, bit 0 being the first one
+//|         shifted in. Bits of buttons which have been pressed (or held down)
+//|         since the last call to this function are set to 1, and the
+//|         remaining bits are set to 0. Then it clears
 //|         the button state, so that new button presses (or buttons that are
 //|         held down) can be recorded for the next call.
 //|
 STATIC mp_obj_t gamepadshift_get_pressed(mp_obj_t self_in) {
     gamepadshift_obj_t* gamepad_singleton = MP_STATE_VM(gamepad_singleton);
-    mp_obj_t pressed = MP_OBJ_NEW_SMALL_INT(gamepad_singleton->pressed);
+    mp_obj_t pressed = mp_obj_new_int_from_uint(gamepad_singleton->pressed);
     gamepad_singleton->pressed = gamepad_singleton->last;
     return pressed;
 }
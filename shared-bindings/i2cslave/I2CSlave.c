@@ -54,25 +54,33 @@ STATIC mp_obj_t mp_obj_new_i2cslave_i2c_slave_request(i2cslave_i2c_slave_obj_t *
 //| :class:`I2CSlave` --- Two wire serial protocol slave
 //| ----------------------------------------------------
 //|
-//| .. class:: I2CSlave(scl, sda, addresses, smbus=False)
+//| .. class:: I2CSlave(scl, sda, addresses, smbus=False, registers=None)
 //|
 //|   I2C is a two-wire protocol for communicating between devices.
 //|   This implements the slave side.
 //|
+//|   When ``registers`` is given, the slave serves it as a register file in the background
+//|   instead of handing requests to Python. The first byte the master writes selects a
+//|   register, following bytes are written to it and the registers after it, and reads start
+//|   at the selected register. `request` can't be used then; use `written` to see what
+//|   the master changed.
+//|
 //|   :param ~microcontroller.Pin scl: The clock pin
 //|   :param ~microcontroller.Pin sda: The data pin
 //|   :param tuple addresses: The I2C addresses to respond to (how many is hw dependent).
 //|   :param bool smbus: Use SMBUS timings if the hardware supports it
+//|   :param bytearray registers: Up to 256 registers to serve
 //|
 STATIC mp_obj_t i2cslave_i2c_slave_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     i2cslave_i2c_slave_obj_t *self = m_new_obj(i2cslave_i2c_slave_obj_t);
     self->base.type = &i2cslave_i2c_slave_type;
-    enum { ARG_scl, ARG_sda, ARG_addresses, ARG_smbus };
+    enum { ARG_scl, ARG_sda, ARG_addresses, ARG_smbus, ARG_registers };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_scl, MP_ARG_REQUIRED | MP_ARG_OBJ },
         { MP_QSTR_sda, MP_ARG_REQUIRED | MP_ARG_OBJ },
         { MP_QSTR_addresses, MP_ARG_REQUIRED | MP_ARG_OBJ },
         { MP_QSTR_smbus, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+        { MP_QSTR_registers, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
@@ -104,7 +112,16 @@ STATIC mp_obj_t i2cslave_i2c_slave_make_new(const mp_obj_type_t *type, size_t n_
         mp_raise_ValueError(translate("addresses is empty"));
     }
 
-    common_hal_i2cslave_i2c_slave_construct(self, scl, sda, addresses, i, args[ARG_smbus].u_bool);
+    mp_buffer_info_t registers = { .buf = NULL, .len = 0 };
+    if (args[ARG_registers].u_obj != mp_const_none) {
+        mp_get_buffer_raise(args[ARG_registers].u_obj, &registers, MP_BUFFER_RW);
+        if (registers.len == 0 || registers.len > 256) {
+            mp_raise_ValueError(translate("registers must be 1-256 bytes"));
+        }
+    }
+
+    common_hal_i2cslave_i2c_slave_construct(self, scl, sda, addresses, i, args[ARG_smbus].u_bool,
+        registers.buf, registers.len);
     return (mp_obj_t)self;
 }
 
@@ -160,6 +177,10 @@ STATIC mp_obj_t i2cslave_i2c_slave_request(size_t n_args, const mp_obj_t *pos_ar
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
+    if (common_hal_i2cslave_i2c_slave_get_serving_registers(self)) {
+        mp_raise_RuntimeError(translate("Requests are handled in the background when serving registers"));
+    }
+
     #if MICROPY_PY_BUILTINS_FLOAT
     float f = mp_obj_get_float(args[ARG_timeout].u_obj) * 1000;
     int timeout_ms = (int)f;
@@ -215,11 +236,34 @@ STATIC mp_obj_t i2cslave_i2c_slave_request(size_t n_args, const mp_obj_t *pos_ar
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(i2cslave_i2c_slave_request_obj, 1, i2cslave_i2c_slave_request);
 
+//|   .. method:: written()
+//|
+//|      Returns the ``(start, end)`` slice of ``registers`` the master has written since the last
+//|      call, or None if it hasn't written any. When there were several writes, the slice covers
+//|      all of them.
+//|
+STATIC mp_obj_t i2cslave_i2c_slave_written(mp_obj_t self_in) {
+    mp_check_self(MP_OBJ_IS_TYPE(self_in, &i2cslave_i2c_slave_type));
+    i2cslave_i2c_slave_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if(common_hal_i2cslave_i2c_slave_deinited(self)) {
+        raise_deinited_error();
+    }
+    size_t start;
+    size_t end;
+    if (!common_hal_i2cslave_i2c_slave_get_written(self, &start, &end)) {
+        return mp_const_none;
+    }
+    mp_obj_t items[2] = { MP_OBJ_NEW_SMALL_INT(start), MP_OBJ_NEW_SMALL_INT(end) };
+    return mp_obj_new_tuple(2, items);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(i2cslave_i2c_slave_written_obj, i2cslave_i2c_slave_written);
+
 STATIC const mp_rom_map_elem_t i2cslave_i2c_slave_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&i2cslave_i2c_slave_deinit_obj) },
     { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
     { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&i2cslave_i2c_slave___exit___obj) },
     { MP_ROM_QSTR(MP_QSTR_request), MP_ROM_PTR(&i2cslave_i2c_slave_request_obj) },
+    { MP_ROM_QSTR(MP_QSTR_written), MP_ROM_PTR(&i2cslave_i2c_slave_written_obj) },
 
 };
 
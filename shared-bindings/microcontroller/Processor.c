@@ -31,8 +31,18 @@
 #include <stdint.h>
 
 #include "py/objproperty.h"
-
+#include "py/objtuple.h"
 #include "py/runtime.h"
+#include "supervisor/shared/translate.h"
+
+size_t MP_WEAK common_hal_mcu_processor_get_frequencies(const uint32_t** frequencies) {
+    *frequencies = NULL;
+    return 0;
+}
+
+void MP_WEAK common_hal_mcu_processor_set_frequency(uint32_t frequency) {
+    mp_raise_NotImplementedError(translate("CPU frequency can't be changed on this board"));
+}
 
 //| .. currentmodule:: microcontroller
 //|
@@ -56,7 +66,18 @@
 
 //|     .. attribute:: frequency
 //|
-//|       The CPU operating frequency as an `int`, in Hertz. (read-only)
+//|       The CPU operating frequency as an `int`, in Hertz. On boards that
+//|       list `frequencies` it can be set to one of them, trading power for
+//|       speed: the fastest for a burst of signal processing or display
+//|       updates, a slower one while waiting. Peripherals keep their timing
+//|       because they run from clocks that don't change. It goes back to the
+//|       fastest when the VM restarts::
+//|
+//|         import microcontroller
+//|         cpu = microcontroller.cpu
+//|         cpu.frequency = min(cpu.frequencies)
+//|         # ... wait for something to do
+//|         cpu.frequency = max(cpu.frequencies)
 //|
 STATIC mp_obj_t mcu_processor_get_frequency(mp_obj_t self) {
     return mp_obj_new_int_from_uint(common_hal_mcu_processor_get_frequency());
@@ -64,9 +85,54 @@ STATIC mp_obj_t mcu_processor_get_frequency(mp_obj_t self) {
 
 MP_DEFINE_CONST_FUN_OBJ_1(mcu_processor_get_frequency_obj, mcu_processor_get_frequency);
 
+STATIC mp_obj_t mcu_processor_set_frequency(mp_obj_t self, mp_obj_t frequency_in) {
+    uint32_t frequency = mp_obj_get_int(frequency_in);
+    const uint32_t* frequencies;
+    size_t count = common_hal_mcu_processor_get_frequencies(&frequencies);
+    if (count == 0) {
+        // Raises.
+        common_hal_mcu_processor_set_frequency(frequency);
+        return mp_const_none;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (frequencies[i] == frequency) {
+            common_hal_mcu_processor_set_frequency(frequency);
+            return mp_const_none;
+        }
+    }
+    mp_raise_ValueError(translate("frequency must be one of microcontroller.cpu.frequencies"));
+}
+
+MP_DEFINE_CONST_FUN_OBJ_2(mcu_processor_set_frequency_obj, mcu_processor_set_frequency);
+
 const mp_obj_property_t mcu_processor_frequency_obj = {
     .base.type = &mp_type_property,
     .proxy = {(mp_obj_t)&mcu_processor_get_frequency_obj,  // getter
+              (mp_obj_t)&mcu_processor_set_frequency_obj,  // setter
+              (mp_obj_t)&mp_const_none_obj,            // no deleter
+    },
+};
+
+//|     .. attribute:: frequencies
+//|
+//|       The frequencies, in Hertz, that `frequency` can be set to as a tuple,
+//|       fastest first. Empty when the frequency can't be changed. (read-only)
+//|
+STATIC mp_obj_t mcu_processor_get_frequencies(mp_obj_t self) {
+    const uint32_t* frequencies;
+    size_t count = common_hal_mcu_processor_get_frequencies(&frequencies);
+    mp_obj_tuple_t *result = MP_OBJ_TO_PTR(mp_obj_new_tuple(count, NULL));
+    for (size_t i = 0; i < count; i++) {
+        result->items[i] = mp_obj_new_int_from_uint(frequencies[i]);
+    }
+    return MP_OBJ_FROM_PTR(result);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(mcu_processor_get_frequencies_obj, mcu_processor_get_frequencies);
+
+const mp_obj_property_t mcu_processor_frequencies_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&mcu_processor_get_frequencies_obj,  // getter
               (mp_obj_t)&mp_const_none_obj,            // no setter
               (mp_obj_t)&mp_const_none_obj,            // no deleter
     },
@@ -136,6 +202,7 @@ const mp_obj_property_t mcu_processor_voltage_obj = {
 
 STATIC const mp_rom_map_elem_t mcu_processor_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_frequency), MP_ROM_PTR(&mcu_processor_frequency_obj) },
+    { MP_ROM_QSTR(MP_QSTR_frequencies), MP_ROM_PTR(&mcu_processor_frequencies_obj) },
     { MP_ROM_QSTR(MP_QSTR_temperature), MP_ROM_PTR(&mcu_processor_temperature_obj) },
     { MP_ROM_QSTR(MP_QSTR_uid), MP_ROM_PTR(&mcu_processor_uid_obj) },
     { MP_ROM_QSTR(MP_QSTR_voltage), MP_ROM_PTR(&mcu_processor_voltage_obj) },
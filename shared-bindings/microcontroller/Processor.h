@@ -34,6 +34,10 @@
 const mp_obj_type_t mcu_processor_type;
 
 uint32_t common_hal_mcu_processor_get_frequency(void);
+// Ports that can change the CPU clock return the frequencies it can be set to,
+// fastest first, and implement set_frequency. The defaults say it can't.
+size_t common_hal_mcu_processor_get_frequencies(const uint32_t** frequencies);
+void common_hal_mcu_processor_set_frequency(uint32_t frequency);
 float common_hal_mcu_processor_get_temperature(void);
 void common_hal_mcu_processor_get_uid(uint8_t raw_id[]);
 float common_hal_mcu_processor_get_voltage(void);
@@ -59,6 +59,10 @@
 //|
 //|   Write buf out on the given DigitalInOut.
 //|
+//|   Where the hardware allows, the bytes are sent in the background and this
+//|   returns before they're all out. ``buf`` can be changed straight away
+//|   because it's copied first. A following write waits for the last one.
+//|
 //|   :param ~digitalio.DigitalInOut digitalinout: the DigitalInOut to output with
 //|   :param bytearray buf: The bytes to clock out. No assumption is made about color order
 //|
@@ -40,4 +40,14 @@ bool common_hal_nvm_bytearray_set_bytes(nvm_bytearray_obj_t *self,
 void common_hal_nvm_bytearray_get_bytes(nvm_bytearray_obj_t *self,
     uint32_t start_index, uint32_t len, uint8_t* values);
 
+// Lower level access for nvm.KeyValueStore, which appends to erased memory instead of rewriting.
+// The smallest part of the memory that can be erased at once.
+uint32_t common_hal_nvm_bytearray_get_erase_size(nvm_bytearray_obj_t *self);
+// Erase the erase size bytes at start_index, which must be a multiple of it.
+bool common_hal_nvm_bytearray_erase(nvm_bytearray_obj_t *self, uint32_t start_index);
+// Write to erased memory without erasing it first. start_index and len must be multiples of 16
+// and each 16 bytes may only be written once between erases.
+bool common_hal_nvm_bytearray_program(nvm_bytearray_obj_t *self,
+    uint32_t start_index, const uint8_t* values, uint32_t len);
+
 #endif  // MICROPY_INCLUDED_SHARED_BINDINGS_NVM_BYTEARRAY_H
@@ -0,0 +1,191 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "py/objlist.h"
+#include "py/runtime.h"
+#include "shared-bindings/nvm/KeyValueStore.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: nvm
+//|
+//| :class:`KeyValueStore` -- Stores values by key in non-volatile memory
+//| ===========================================================================
+//|
+//| Each assignment appends a small record to the non-volatile memory instead of erasing and
+//| rewriting it, so values can be updated often without wearing it out. The latest records are
+//| copied to a fresh area when it fills up. Assigning the value a key already has writes nothing.
+//|
+//| Usage::
+//|
+//|    import microcontroller
+//|    import nvm
+//|    settings = nvm.KeyValueStore(microcontroller.nvm)
+//|    settings["boots"] = (int.from_bytes(settings.get("boots", b"\x00"), "little") + 1).to_bytes(4, "little")
+//|
+
+//| .. class:: KeyValueStore(nvm)
+//|
+//|   Use ``nvm`` to store keys and values. Its contents are replaced by an empty store the first
+//|   time, and it must not be written to directly afterwards. Create one store for it and keep
+//|   it.
+//|
+//|   When ``nvm`` is a single erase block, a power loss while the records are being copied to
+//|   make room loses the stored values.
+//|
+//|   :param ~nvm.ByteArray nvm: the non-volatile memory to use, usually `microcontroller.nvm`
+//|
+STATIC mp_obj_t nvm_keyvaluestore_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    mp_arg_check_num(n_args, kw_args, 1, 1, false);
+    if (!MP_OBJ_IS_TYPE(args[0], &nvm_bytearray_type)) {
+        mp_raise_TypeError_varg(translate("Expected a %q"), MP_QSTR_ByteArray);
+    }
+    nvm_keyvaluestore_obj_t *self = m_new_obj(nvm_keyvaluestore_obj_t);
+    self->base.type = &nvm_keyvaluestore_type;
+    common_hal_nvm_keyvaluestore_construct(self, MP_OBJ_TO_PTR(args[0]));
+    return MP_OBJ_FROM_PTR(self);
+}
+
+STATIC void check_key(mp_obj_t key) {
+    if (MP_OBJ_IS_STR(key)) {
+        size_t len;
+        mp_obj_str_get_data(key, &len);
+        if (len <= NVM_KEYVALUESTORE_MAX_KEY_LEN) {
+            return;
+        }
+    }
+    mp_raise_ValueError_varg(translate("Keys must be str of at most %d bytes"), NVM_KEYVALUESTORE_MAX_KEY_LEN);
+}
+
+//|   .. method:: get(key, default=None)
+//|
+//|     Return the value of ``key`` as bytes, or ``default`` if it isn't stored.
+//|
+STATIC mp_obj_t nvm_keyvaluestore_get(size_t n_args, const mp_obj_t *args) {
+    nvm_keyvaluestore_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    check_key(args[1]);
+    mp_obj_t value = common_hal_nvm_keyvaluestore_get(self, args[1]);
+    if (value == MP_OBJ_NULL) {
+        return n_args > 2 ? args[2] : mp_const_none;
+    }
+    return value;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(nvm_keyvaluestore_get_obj, 2, 3, nvm_keyvaluestore_get);
+
+//|   .. method:: keys()
+//|
+//|     Return a list of the stored keys.
+//|
+STATIC mp_obj_t nvm_keyvaluestore_keys(mp_obj_t self_in) {
+    nvm_keyvaluestore_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_map_t *map = mp_obj_dict_get_map(self->index);
+    mp_obj_t keys = mp_obj_new_list(0, NULL);
+    for (size_t i = 0; i < map->alloc; i++) {
+        if (MP_MAP_SLOT_IS_FILLED(map, i)) {
+            mp_obj_list_append(keys, map->table[i].key);
+        }
+    }
+    return keys;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(nvm_keyvaluestore_keys_obj, nvm_keyvaluestore_keys);
+
+//|   .. method:: __len__()
+//|
+//|     Return the number of stored keys. This is used by (`len`)
+//|
+STATIC mp_obj_t nvm_keyvaluestore_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
+    nvm_keyvaluestore_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    size_t len = common_hal_nvm_keyvaluestore_get_length(self);
+    switch (op) {
+        case MP_UNARY_OP_BOOL: return mp_obj_new_bool(len != 0);
+        case MP_UNARY_OP_LEN: return MP_OBJ_NEW_SMALL_INT(len);
+        default: return MP_OBJ_NULL; // op not supported
+    }
+}
+
+STATIC mp_obj_t nvm_keyvaluestore_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs_in) {
+    nvm_keyvaluestore_obj_t *self = MP_OBJ_TO_PTR(lhs_in);
+    switch (op) {
+        case MP_BINARY_OP_CONTAINS:
+            return mp_obj_new_bool(MP_OBJ_IS_STR(rhs_in) &&
+                mp_map_lookup(mp_obj_dict_get_map(self->index), rhs_in, MP_MAP_LOOKUP) != NULL);
+        default:
+            return MP_OBJ_NULL; // op not supported
+    }
+}
+
+//|   .. method:: __getitem__(key)
+//|
+//|     Return the value of ``key`` as bytes.
+//|
+//|   .. method:: __setitem__(key, value)
+//|
+//|     Store ``value``, which may be any buffer such as bytes, for ``key``.
+//|
+//|   .. method:: __delitem__(key)
+//|
+//|     Remove ``key`` from the store.
+//|
+STATIC mp_obj_t nvm_keyvaluestore_subscr(mp_obj_t self_in, mp_obj_t key, mp_obj_t value) {
+    nvm_keyvaluestore_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_key(key);
+    if (value == MP_OBJ_NULL) {
+        // delete
+        if (!common_hal_nvm_keyvaluestore_delete(self, key)) {
+            nlr_raise(mp_obj_new_exception_arg1(&mp_type_KeyError, key));
+        }
+        return mp_const_none;
+    } else if (value == MP_OBJ_SENTINEL) {
+        // load
+        mp_obj_t result = common_hal_nvm_keyvaluestore_get(self, key);
+        if (result == MP_OBJ_NULL) {
+            nlr_raise(mp_obj_new_exception_arg1(&mp_type_KeyError, key));
+        }
+        return result;
+    } else {
+        // store
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(value, &bufinfo, MP_BUFFER_READ);
+        common_hal_nvm_keyvaluestore_set(self, key, bufinfo.buf, bufinfo.len);
+        return mp_const_none;
+    }
+}
+
+STATIC const mp_rom_map_elem_t nvm_keyvaluestore_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_get), MP_ROM_PTR(&nvm_keyvaluestore_get_obj) },
+    { MP_ROM_QSTR(MP_QSTR_keys), MP_ROM_PTR(&nvm_keyvaluestore_keys_obj) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(nvm_keyvaluestore_locals_dict, nvm_keyvaluestore_locals_dict_table);
+
+const mp_obj_type_t nvm_keyvaluestore_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_KeyValueStore,
+    .make_new = nvm_keyvaluestore_make_new,
+    .subscr = nvm_keyvaluestore_subscr,
+    .unary_op = nvm_keyvaluestore_unary_op,
+    .binary_op = nvm_keyvaluestore_binary_op,
+    .locals_dict = (mp_obj_t)&nvm_keyvaluestore_locals_dict,
+};
@@ -0,0 +1,43 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_NVM_KEYVALUESTORE_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_NVM_KEYVALUESTORE_H
+
+#include "shared-module/nvm/KeyValueStore.h"
+
+extern const mp_obj_type_t nvm_keyvaluestore_type;
+
+void common_hal_nvm_keyvaluestore_construct(nvm_keyvaluestore_obj_t *self, nvm_bytearray_obj_t *nvm);
+size_t common_hal_nvm_keyvaluestore_get_length(nvm_keyvaluestore_obj_t *self);
+// Returns MP_OBJ_NULL when key isn't stored.
+mp_obj_t common_hal_nvm_keyvaluestore_get(nvm_keyvaluestore_obj_t *self, mp_obj_t key);
+void common_hal_nvm_keyvaluestore_set(nvm_keyvaluestore_obj_t *self, mp_obj_t key,
+    const uint8_t *value, size_t len);
+// Returns false when key isn't stored.
+bool common_hal_nvm_keyvaluestore_delete(nvm_keyvaluestore_obj_t *self, mp_obj_t key);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_NVM_KEYVALUESTORE_H
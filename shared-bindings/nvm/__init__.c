@@ -30,6 +30,7 @@
 
 #include "shared-bindings/nvm/__init__.h"
 #include "shared-bindings/nvm/ByteArray.h"
+#include "shared-bindings/nvm/KeyValueStore.h"
 
 //| :mod:`nvm` --- Non-volatile memory
 //| ===========================================================
@@ -48,9 +49,11 @@
 //|     :maxdepth: 3
 //|
 //|     ByteArray
+//|     KeyValueStore
 STATIC const mp_rom_map_elem_t nvm_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_nvm) },
     { MP_ROM_QSTR(MP_QSTR_ByteArray),   MP_ROM_PTR(&nvm_bytearray_type) },
+    { MP_ROM_QSTR(MP_QSTR_KeyValueStore),   MP_ROM_PTR(&nvm_keyvaluestore_type) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(nvm_module_globals, nvm_module_globals_table);
@@ -35,6 +35,23 @@
 #include "shared-bindings/util.h"
 #include "supervisor/shared/translate.h"
 
+void MP_WEAK common_hal_pulseio_pwmout_set_duty_cycles(pulseio_pwmout_obj_t** pwms, const uint16_t* duties, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        common_hal_pulseio_pwmout_set_duty_cycle(pwms[i], duties[i]);
+    }
+}
+
+void MP_WEAK common_hal_pulseio_pwmout_play(pulseio_pwmout_obj_t* self, const uint16_t* duty_cycles, size_t len, bool loop) {
+    mp_raise_NotImplementedError(translate("Duty cycle sequences aren't supported on this pin"));
+}
+
+void MP_WEAK common_hal_pulseio_pwmout_stop(pulseio_pwmout_obj_t* self) {
+}
+
+bool MP_WEAK common_hal_pulseio_pwmout_get_playing(pulseio_pwmout_obj_t* self) {
+    return false;
+}
+
 //| .. currentmodule:: pulseio
 //|
 //| :class:`PWMOut` -- Output a Pulse Width Modulated signal
@@ -231,15 +248,79 @@ const mp_obj_property_t pulseio_pwmout_frequency_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+//|   .. method:: play(duty_cycles, *, loop=False)
+//|
+//|     Outputs one duty cycle from ``duty_cycles`` per PWM period in the background, such as to
+//|     generate a waveform. The values are read when `play` is called so the buffer can be
+//|     reused right away. Setting `duty_cycle` or `frequency` stops playback and the output
+//|     keeps the last duty cycle played when it finishes.
+//|
+//|     :param array.array duty_cycles: 16 bit duty cycles in an array of type 'H'
+//|     :param bool loop: Start over at the beginning of ``duty_cycles`` after the last one
+//|
+STATIC mp_obj_t pulseio_pwmout_obj_play(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_duty_cycles, ARG_loop };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_duty_cycles, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_loop, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+    };
+    pulseio_pwmout_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    check_for_deinit(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[ARG_duty_cycles].u_obj, &bufinfo, MP_BUFFER_READ);
+    if (bufinfo.typecode != 'H') {
+        mp_raise_ValueError(translate("buffer must be an array of type 'H'"));
+    }
+    common_hal_pulseio_pwmout_play(self, bufinfo.buf, bufinfo.len / sizeof(uint16_t), args[ARG_loop].u_bool);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(pulseio_pwmout_play_obj, 1, pulseio_pwmout_obj_play);
+
+//|   .. method:: stop()
+//|
+//|     Stops playing duty cycles. The output keeps the duty cycle it's at.
+//|
+STATIC mp_obj_t pulseio_pwmout_obj_stop(mp_obj_t self_in) {
+    pulseio_pwmout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_pulseio_pwmout_stop(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(pulseio_pwmout_stop_obj, pulseio_pwmout_obj_stop);
+
+//|   .. attribute:: playing
+//|
+//|     True when duty cycles are being played. (read-only)
+//|
+STATIC mp_obj_t pulseio_pwmout_obj_get_playing(mp_obj_t self_in) {
+    pulseio_pwmout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_bool(common_hal_pulseio_pwmout_get_playing(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(pulseio_pwmout_get_playing_obj, pulseio_pwmout_obj_get_playing);
+
+const mp_obj_property_t pulseio_pwmout_playing_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&pulseio_pwmout_get_playing_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 STATIC const mp_rom_map_elem_t pulseio_pwmout_locals_dict_table[] = {
     // Methods
     { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&pulseio_pwmout_deinit_obj) },
     { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
     { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&pulseio_pwmout___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_play), MP_ROM_PTR(&pulseio_pwmout_play_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop), MP_ROM_PTR(&pulseio_pwmout_stop_obj) },
 
     // Properties
     { MP_ROM_QSTR(MP_QSTR_duty_cycle), MP_ROM_PTR(&pulseio_pwmout_duty_cycle_obj) },
     { MP_ROM_QSTR(MP_QSTR_frequency), MP_ROM_PTR(&pulseio_pwmout_frequency_obj) },
+    { MP_ROM_QSTR(MP_QSTR_playing), MP_ROM_PTR(&pulseio_pwmout_playing_obj) },
     // TODO(tannewt): Add enabled to determine whether the signal is output
     // without giving up the resources. Useful for IR output.
 };
@@ -51,6 +51,15 @@ extern void common_hal_pulseio_pwmout_set_frequency(pulseio_pwmout_obj_t* self,
 extern uint32_t common_hal_pulseio_pwmout_get_frequency(pulseio_pwmout_obj_t* self);
 extern bool common_hal_pulseio_pwmout_get_variable_frequency(pulseio_pwmout_obj_t* self);
 
+// Sets the duty cycles of several outputs so that outputs sharing a timer change in the same
+// period. Ports that can't do that set them one after another.
+extern void common_hal_pulseio_pwmout_set_duty_cycles(pulseio_pwmout_obj_t** pwms, const uint16_t* duties, size_t count);
+// Plays one duty cycle per period in the background. Setting the duty cycle or frequency stops
+// it. Ports without support raise NotImplementedError.
+extern void common_hal_pulseio_pwmout_play(pulseio_pwmout_obj_t* self, const uint16_t* duty_cycles, size_t len, bool loop);
+extern void common_hal_pulseio_pwmout_stop(pulseio_pwmout_obj_t* self);
+extern bool common_hal_pulseio_pwmout_get_playing(pulseio_pwmout_obj_t* self);
+
 // This is used by the supervisor to claim PWMOut devices indefinitely.
 extern void common_hal_pulseio_pwmout_never_reset(pulseio_pwmout_obj_t *self);
 extern void common_hal_pulseio_pwmout_reset_ok(pulseio_pwmout_obj_t *self);
@@ -36,6 +36,15 @@
 #include "shared-bindings/util.h"
 #include "supervisor/shared/translate.h"
 
+// Ports that can't send in the background send before returning.
+void MP_WEAK common_hal_pulseio_pulseout_start(pulseio_pulseout_obj_t* self, uint16_t* pulses, uint16_t len) {
+    common_hal_pulseio_pulseout_send(self, pulses, len);
+}
+
+bool MP_WEAK common_hal_pulseio_pulseout_get_sending(pulseio_pulseout_obj_t* self) {
+    return false;
+}
+
 //| .. currentmodule:: pulseio
 //|
 //| :class:`PulseOut` -- Output a pulse train
@@ -114,32 +123,67 @@ STATIC mp_obj_t pulseio_pulseout_obj___exit__(size_t n_args, const mp_obj_t *arg
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pulseio_pulseout___exit___obj, 4, 4, pulseio_pulseout_obj___exit__);
 
-//|   .. method:: send(pulses)
+//|   .. method:: send(pulses, *, blocking=True)
 //|
 //|     Pulse alternating on and off durations in microseconds starting with on.
 //|     ``pulses`` must be an `array.array` with data type 'H' for unsigned
 //|     halfword (two bytes).
 //|
-//|     This method waits until the whole array of pulses has been sent and
-//|     ensures the signal is off afterwards.
+//|     By default this method waits until the whole array of pulses has been
+//|     sent and ensures the signal is off afterwards. With ``blocking=False`` it
+//|     returns once sending has started, where the hardware can send in the
+//|     background, and `sending` tells when it is done. ``pulses`` may be changed
+//|     as soon as this returns.
 //|
 //|     :param array.array pulses: pulse durations in microseconds
-//|
-STATIC mp_obj_t pulseio_pulseout_obj_send(mp_obj_t self_in, mp_obj_t pulses) {
-    pulseio_pulseout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+//|     :param bool blocking: wait for the pulses to be sent
+//|
+STATIC mp_obj_t pulseio_pulseout_obj_send(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_pulses, ARG_blocking };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_pulses, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_blocking, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = true} },
+    };
+    pulseio_pulseout_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
     if (common_hal_pulseio_pulseout_deinited(self)) {
         raise_deinited_error();
     }
 
     mp_buffer_info_t bufinfo;
-    mp_get_buffer_raise(pulses, &bufinfo, MP_BUFFER_READ);
+    mp_get_buffer_raise(args[ARG_pulses].u_obj, &bufinfo, MP_BUFFER_READ);
     if (bufinfo.typecode != 'H') {
         mp_raise_TypeError(translate("Array must contain halfwords (type 'H')"));
     }
-    common_hal_pulseio_pulseout_send(self, (uint16_t *)bufinfo.buf, bufinfo.len / 2);
+    if (args[ARG_blocking].u_bool) {
+        common_hal_pulseio_pulseout_send(self, (uint16_t *)bufinfo.buf, bufinfo.len / 2);
+    } else {
+        common_hal_pulseio_pulseout_start(self, (uint16_t *)bufinfo.buf, bufinfo.len / 2);
+    }
     return mp_const_none;
 }
-MP_DEFINE_CONST_FUN_OBJ_2(pulseio_pulseout_send_obj, pulseio_pulseout_obj_send);
+MP_DEFINE_CONST_FUN_OBJ_KW(pulseio_pulseout_send_obj, 2, pulseio_pulseout_obj_send);
+
+//|   .. attribute:: sending
+//|
+//|     True while pulses started by a non-blocking `send` are still being sent. (read-only)
+//|
+STATIC mp_obj_t pulseio_pulseout_obj_get_sending(mp_obj_t self_in) {
+    pulseio_pulseout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (common_hal_pulseio_pulseout_deinited(self)) {
+        raise_deinited_error();
+    }
+    return mp_obj_new_bool(common_hal_pulseio_pulseout_get_sending(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(pulseio_pulseout_get_sending_obj, pulseio_pulseout_obj_get_sending);
+
+const mp_obj_property_t pulseio_pulseout_sending_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&pulseio_pulseout_get_sending_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
 
 STATIC const mp_rom_map_elem_t pulseio_pulseout_locals_dict_table[] = {
     // Methods
@@ -147,6 +191,9 @@ STATIC const mp_rom_map_elem_t pulseio_pulseout_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
     { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&pulseio_pulseout___exit___obj) },
     { MP_ROM_QSTR(MP_QSTR_send), MP_ROM_PTR(&pulseio_pulseout_send_obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_sending), MP_ROM_PTR(&pulseio_pulseout_sending_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(pulseio_pulseout_locals_dict, pulseio_pulseout_locals_dict_table);
 
@@ -39,5 +39,9 @@ extern void common_hal_pulseio_pulseout_deinit(pulseio_pulseout_obj_t* self);
 extern bool common_hal_pulseio_pulseout_deinited(pulseio_pulseout_obj_t* self);
 extern void common_hal_pulseio_pulseout_send(pulseio_pulseout_obj_t* self,
     uint16_t* pulses, uint16_t len);
+// Starts sending without waiting for the pulses to finish. pulses may change once this returns.
+extern void common_hal_pulseio_pulseout_start(pulseio_pulseout_obj_t* self,
+    uint16_t* pulses, uint16_t len);
+extern bool common_hal_pulseio_pulseout_get_sending(pulseio_pulseout_obj_t* self);
 
 #endif // MICROPY_INCLUDED_SHARED_BINDINGS_PULSEIO_PULSEOUT_H
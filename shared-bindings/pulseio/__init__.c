@@ -34,6 +34,7 @@
 #include "shared-bindings/pulseio/PulseIn.h"
 #include "shared-bindings/pulseio/PulseOut.h"
 #include "shared-bindings/pulseio/PWMOut.h"
+#include "shared-bindings/util.h"
 
 //| :mod:`pulseio` --- Support for pulse based protocols
 //| =====================================================
@@ -76,11 +77,50 @@
 //| to do it yourself.
 //|
 
+//| .. function:: set_duty_cycles(pwms, duty_cycles)
+//|
+//|   Sets the `PWMOut.duty_cycle` of each of ``pwms`` to the matching value of ``duty_cycles``.
+//|   Outputs that share a timer switch to their new duty cycles in the same PWM period, so a
+//|   change across RGB LED or motor channels doesn't tear. Outputs on different timers change
+//|   one after another.
+//|
+//|   :param tuple pwms: The PWMOuts to update
+//|   :param tuple duty_cycles: The new 16 bit duty cycles
+//|
+STATIC mp_obj_t pulseio_set_duty_cycles(mp_obj_t pwms_in, mp_obj_t duty_cycles_in) {
+    size_t count;
+    mp_obj_t *pwm_objs;
+    mp_obj_get_array(pwms_in, &count, &pwm_objs);
+    mp_obj_t *duty_objs;
+    mp_obj_get_array_fixed_n(duty_cycles_in, count, &duty_objs);
+
+    pulseio_pwmout_obj_t *pwms[count];
+    uint16_t duties[count];
+    for (size_t i = 0; i < count; i++) {
+        if (!MP_OBJ_IS_TYPE(pwm_objs[i], &pulseio_pwmout_type)) {
+            mp_raise_TypeError_varg(translate("Expected a %q"), MP_QSTR_PWMOut);
+        }
+        pwms[i] = MP_OBJ_TO_PTR(pwm_objs[i]);
+        if (common_hal_pulseio_pwmout_deinited(pwms[i])) {
+            raise_deinited_error();
+        }
+        mp_int_t duty = mp_obj_get_int(duty_objs[i]);
+        if (duty < 0 || duty > 0xffff) {
+            mp_raise_ValueError(translate("PWM duty_cycle must be between 0 and 65535 inclusive (16 bit resolution)"));
+        }
+        duties[i] = duty;
+    }
+    common_hal_pulseio_pwmout_set_duty_cycles(pwms, duties, count);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(pulseio_set_duty_cycles_obj, pulseio_set_duty_cycles);
+
 STATIC const mp_rom_map_elem_t pulseio_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_pulseio) },
     { MP_ROM_QSTR(MP_QSTR_PulseIn), MP_ROM_PTR(&pulseio_pulsein_type) },
     { MP_ROM_QSTR(MP_QSTR_PulseOut), MP_ROM_PTR(&pulseio_pulseout_type) },
     { MP_ROM_QSTR(MP_QSTR_PWMOut), MP_ROM_PTR(&pulseio_pwmout_type) },
+    { MP_ROM_QSTR(MP_QSTR_set_duty_cycles), MP_ROM_PTR(&pulseio_set_duty_cycles_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(pulseio_module_globals, pulseio_module_globals_table);
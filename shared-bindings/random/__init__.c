@@ -29,6 +29,7 @@
 #include <string.h>
 
 #include "py/obj.h"
+#include "py/objint.h"
 #include "py/runtime.h"
 #include "shared-bindings/random/__init__.h"
 #include "supervisor/shared/translate.h"
@@ -66,17 +67,49 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(random_seed_obj, random_seed);
 
 //| .. function:: getrandbits(k)
 //|
-//|   Returns an integer with *k* random bits.
+//|   Returns an integer with *k* random bits. More than 32 bits needs long
+//|   integer support.
 //|
 STATIC mp_obj_t random_getrandbits(mp_obj_t num_in) {
-    int n = mp_obj_get_int(num_in);
-    if (n > 32 || n == 0) {
+    mp_int_t n = mp_obj_get_int(num_in);
+    if (n <= 0) {
         mp_raise_ValueError(NULL);
     }
-    return mp_obj_new_int_from_uint(shared_modules_random_getrandbits((uint8_t) n));
+    if (n <= 32) {
+        return mp_obj_new_int_from_uint(shared_modules_random_getrandbits((uint8_t) n));
+    }
+    #if MICROPY_LONGINT_IMPL == MICROPY_LONGINT_IMPL_NONE
+    mp_raise_ValueError(NULL);
+    #else
+    size_t len = (n + 7) / 8;
+    byte *buf = m_new(byte, len);
+    shared_modules_random_fill(buf, len);
+    // Little endian, so the excess bits are at the top of the last byte.
+    buf[len - 1] &= 0xff >> (len * 8 - n);
+    mp_obj_t result = mp_obj_int_from_bytes_impl(false, len, buf);
+    m_del(byte, buf, len);
+    return result;
+    #endif
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(random_getrandbits_obj, random_getrandbits);
 
+//| .. function:: randbytes(n)
+//|
+//|   Returns *n* random bytes, generated four at a time. Like the rest of this
+//|   module they aren't suitable for cryptography; use `os.urandom` for that.
+//|
+STATIC mp_obj_t random_randbytes(mp_obj_t num_in) {
+    mp_int_t n = mp_obj_get_int(num_in);
+    if (n < 0) {
+        mp_raise_ValueError(NULL);
+    }
+    vstr_t vstr;
+    vstr_init_len(&vstr, n);
+    shared_modules_random_fill((uint8_t *) vstr.buf, n);
+    return mp_obj_new_str_from_vstr(&mp_type_bytes, &vstr);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(random_randbytes_obj, random_randbytes);
+
 //| .. function:: randrange(stop)
 //|               randrange(start, stop, step=1)
 //|
@@ -174,6 +207,7 @@ STATIC const mp_rom_map_elem_t mp_module_random_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_random) },
     { MP_ROM_QSTR(MP_QSTR_seed), MP_ROM_PTR(&random_seed_obj) },
     { MP_ROM_QSTR(MP_QSTR_getrandbits), MP_ROM_PTR(&random_getrandbits_obj) },
+    { MP_ROM_QSTR(MP_QSTR_randbytes), MP_ROM_PTR(&random_randbytes_obj) },
     { MP_ROM_QSTR(MP_QSTR_randrange), MP_ROM_PTR(&random_randrange_obj) },
     { MP_ROM_QSTR(MP_QSTR_randint), MP_ROM_PTR(&random_randint_obj) },
     { MP_ROM_QSTR(MP_QSTR_choice), MP_ROM_PTR(&random_choice_obj) },
@@ -47,6 +47,9 @@
 //|   state of an incremental rotary encoder (also known as a quadrature encoder.) Position is
 //|   relative to the position when the object is contructed.
 //|
+//|   Where the microcontroller has a quadrature decoder peripheral and the pins can be routed to
+//|   it, the pulses are counted in hardware. Otherwise each edge is handled by an interrupt.
+//|
 //|   :param ~microcontroller.Pin pin_a: First pin to read pulses from.
 //|   :param ~microcontroller.Pin pin_b: Second pin to read pulses from.
 //|
@@ -154,12 +157,33 @@ const mp_obj_property_t rotaryio_incrementalencoder_position_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+//|   .. attribute:: velocity
+//|
+//|     The speed of the encoder in positions per second, averaged over the last 100 milliseconds
+//|     or so. Positive when the position is increasing. (read-only)
+//|
+STATIC mp_obj_t rotaryio_incrementalencoder_obj_get_velocity(mp_obj_t self_in) {
+    rotaryio_incrementalencoder_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+
+    return mp_obj_new_float(common_hal_rotaryio_incrementalencoder_get_velocity(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(rotaryio_incrementalencoder_get_velocity_obj, rotaryio_incrementalencoder_obj_get_velocity);
+
+const mp_obj_property_t rotaryio_incrementalencoder_velocity_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&rotaryio_incrementalencoder_get_velocity_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 STATIC const mp_rom_map_elem_t rotaryio_incrementalencoder_locals_dict_table[] = {
     // Methods
     { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&rotaryio_incrementalencoder_deinit_obj) },
     { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
     { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&rotaryio_incrementalencoder___exit___obj) },
     { MP_ROM_QSTR(MP_QSTR_position), MP_ROM_PTR(&rotaryio_incrementalencoder_position_obj) },
+    { MP_ROM_QSTR(MP_QSTR_velocity), MP_ROM_PTR(&rotaryio_incrementalencoder_velocity_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(rotaryio_incrementalencoder_locals_dict, rotaryio_incrementalencoder_locals_dict_table);
 
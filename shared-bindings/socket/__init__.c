@@ -503,6 +503,7 @@ STATIC const mp_stream_p_t socket_stream_p = {
     MP_PROTO_IMPLEMENT(MP_QSTR_protocol_stream)
     .ioctl = socket_ioctl,
     .is_text = false,
+    .signals_ready = true,
 };
 
 STATIC const mp_obj_type_t socket_type = {
@@ -0,0 +1,145 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "extmod/vfs.h"
+#include "py/mperrno.h"
+#include "py/runtime.h"
+#include "shared-bindings/storage/RAMBlockDevice.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: storage
+//|
+//| :class:`RAMBlockDevice` -- A block device in RAM
+//| ===========================================================================
+//|
+//| A block device whose blocks are kept in RAM, for scratch files that would otherwise wear out
+//| the flash and wait for it to be erased. Blocks take memory once something other than zeros is
+//| written to them, so an empty filesystem needs only a few. The contents are lost when the VM
+//| restarts.
+//|
+//| Usage::
+//|
+//|    import storage
+//|    ramdisk = storage.RAMBlockDevice(128)
+//|    storage.VfsFat.mkfs(ramdisk)
+//|    storage.mount(storage.VfsFat(ramdisk), "/ram")
+//|    with open("/ram/log.txt", "w") as f:
+//|        f.write("hello")
+//|
+
+//| .. class:: RAMBlockDevice(block_count)
+//|
+//|   Create a device of ``block_count`` blocks of 512 bytes.
+//|
+STATIC mp_obj_t storage_ramblockdevice_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    mp_arg_check_num(n_args, kw_args, 1, 1, false);
+    mp_int_t block_count = mp_obj_get_int(args[0]);
+    if (block_count < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_block_count);
+    }
+    storage_ramblockdevice_obj_t *self = m_new_obj(storage_ramblockdevice_obj_t);
+    self->base.type = type;
+    common_hal_storage_ramblockdevice_construct(self, block_count);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+// Returns the number of blocks buf covers, starting at block_num.
+STATIC uint32_t get_blocks(storage_ramblockdevice_obj_t *self, mp_obj_t block_num_in, mp_buffer_info_t *bufinfo) {
+    mp_uint_t block_num = mp_obj_get_int(block_num_in);
+    uint32_t count = bufinfo->len / STORAGE_RAMBLOCKDEVICE_BLOCK_SIZE;
+    uint32_t block_count = common_hal_storage_ramblockdevice_get_block_count(self);
+    if (bufinfo->len % STORAGE_RAMBLOCKDEVICE_BLOCK_SIZE != 0 || block_num > block_count ||
+        count > block_count - block_num) {
+        mp_raise_OSError(MP_EIO);
+    }
+    return count;
+}
+
+//|   .. method:: readblocks(block_num, buf)
+//|
+//|     Read whole blocks from ``block_num`` onward into ``buf``.
+//|
+STATIC mp_obj_t storage_ramblockdevice_readblocks(mp_obj_t self_in, mp_obj_t block_num, mp_obj_t buf) {
+    storage_ramblockdevice_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf, &bufinfo, MP_BUFFER_WRITE);
+    uint32_t count = get_blocks(self, block_num, &bufinfo);
+    common_hal_storage_ramblockdevice_readblocks(self, mp_obj_get_int(block_num), bufinfo.buf, count);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(storage_ramblockdevice_readblocks_obj, storage_ramblockdevice_readblocks);
+
+//|   .. method:: writeblocks(block_num, buf)
+//|
+//|     Write whole blocks from ``buf`` to ``block_num`` onward.
+//|
+STATIC mp_obj_t storage_ramblockdevice_writeblocks(mp_obj_t self_in, mp_obj_t block_num, mp_obj_t buf) {
+    storage_ramblockdevice_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf, &bufinfo, MP_BUFFER_READ);
+    uint32_t count = get_blocks(self, block_num, &bufinfo);
+    if (!common_hal_storage_ramblockdevice_writeblocks(self, mp_obj_get_int(block_num), bufinfo.buf, count)) {
+        mp_raise_OSError(MP_ENOMEM);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(storage_ramblockdevice_writeblocks_obj, storage_ramblockdevice_writeblocks);
+
+//|   .. method:: ioctl(op, arg)
+//|
+//|     Answer the block device control operations used by `VfsFat`.
+//|
+STATIC mp_obj_t storage_ramblockdevice_ioctl(mp_obj_t self_in, mp_obj_t op_in, mp_obj_t arg_in) {
+    storage_ramblockdevice_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    (void)arg_in;
+    switch (mp_obj_get_int(op_in)) {
+        case BP_IOCTL_INIT:
+        case BP_IOCTL_DEINIT:
+        case BP_IOCTL_SYNC:
+            return MP_OBJ_NEW_SMALL_INT(0);
+        case BP_IOCTL_SEC_COUNT:
+            return mp_obj_new_int_from_uint(common_hal_storage_ramblockdevice_get_block_count(self));
+        case BP_IOCTL_SEC_SIZE:
+            return MP_OBJ_NEW_SMALL_INT(STORAGE_RAMBLOCKDEVICE_BLOCK_SIZE);
+        default:
+            return mp_const_none;
+    }
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(storage_ramblockdevice_ioctl_obj, storage_ramblockdevice_ioctl);
+
+STATIC const mp_rom_map_elem_t storage_ramblockdevice_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_readblocks), MP_ROM_PTR(&storage_ramblockdevice_readblocks_obj) },
+    { MP_ROM_QSTR(MP_QSTR_writeblocks), MP_ROM_PTR(&storage_ramblockdevice_writeblocks_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ioctl), MP_ROM_PTR(&storage_ramblockdevice_ioctl_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(storage_ramblockdevice_locals_dict, storage_ramblockdevice_locals_dict_table);
+
+const mp_obj_type_t storage_ramblockdevice_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_RAMBlockDevice,
+    .make_new = storage_ramblockdevice_make_new,
+    .locals_dict = (mp_obj_dict_t*)&storage_ramblockdevice_locals_dict,
+};
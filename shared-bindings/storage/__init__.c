@@ -29,10 +29,12 @@
 #include <string.h>
 
 #include "extmod/vfs_fat.h"
+#include "extmod/vfs_rom.h"
 #include "py/obj.h"
 #include "py/objnamedtuple.h"
 #include "py/runtime.h"
 #include "shared-bindings/storage/__init__.h"
+#include "shared-bindings/storage/RAMBlockDevice.h"
 #include "supervisor/shared/translate.h"
 
 //| :mod:`storage` --- storage management
@@ -162,6 +164,24 @@ mp_obj_t storage_erase_filesystem(void) {
 }
 MP_DEFINE_CONST_FUN_OBJ_0(storage_erase_filesystem_obj, storage_erase_filesystem);
 
+//| .. function:: flush_statistics()
+//|
+//|   Returns a tuple of the number of times the ``CIRCUITPY`` filesystem has
+//|   been flushed to flash, and the number of flushes saved by waiting for
+//|   writes to stop. Each saved flush is a flash sector that wasn't erased
+//|   and programmed again.
+//|
+mp_obj_t storage_flush_statistics(void) {
+    uint32_t flushes, flushes_saved;
+    common_hal_storage_get_flush_statistics(&flushes, &flushes_saved);
+    mp_obj_t items[] = {
+        mp_obj_new_int_from_uint(flushes),
+        mp_obj_new_int_from_uint(flushes_saved),
+    };
+    return mp_obj_new_tuple(MP_ARRAY_SIZE(items), items);
+}
+MP_DEFINE_CONST_FUN_OBJ_0(storage_flush_statistics_obj, storage_flush_statistics);
+
 STATIC const mp_rom_map_elem_t storage_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_storage) },
 
@@ -170,6 +190,8 @@ STATIC const mp_rom_map_elem_t storage_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_remount), MP_ROM_PTR(&storage_remount_obj) },
     { MP_ROM_QSTR(MP_QSTR_getmount), MP_ROM_PTR(&storage_getmount_obj) },
     { MP_ROM_QSTR(MP_QSTR_erase_filesystem), MP_ROM_PTR(&storage_erase_filesystem_obj) },
+    { MP_ROM_QSTR(MP_QSTR_RAMBlockDevice), MP_ROM_PTR(&storage_ramblockdevice_type) },
+    { MP_ROM_QSTR(MP_QSTR_flush_statistics), MP_ROM_PTR(&storage_flush_statistics_obj) },
 
     //| .. class:: VfsFat(block_device)
     //|
@@ -221,6 +243,29 @@ STATIC const mp_rom_map_elem_t storage_module_globals_table[] = {
     //|     Don't call this directly, call `storage.umount`.
     //|
     { MP_ROM_QSTR(MP_QSTR_VfsFat), MP_ROM_PTR(&mp_fat_vfs_type) },
+
+    #if MICROPY_VFS_ROM
+    //| .. class:: VfsRom(image)
+    //|
+    //|   Create a read-only filesystem that reads files straight out of ``image``, a buffer holding
+    //|   an image built by ``tools/mkromfs.py``. When the image is in flash, for example as a
+    //|   frozen ``bytes`` object, nothing is copied to RAM. Files are found by hashing their path,
+    //|   so looking one up doesn't walk directories. An uncompressed file can be used in place with
+    //|   ``memoryview(f)`` while it is open; compressed files are decompressed as they are read.
+    //|
+    //|   :param image: Buffer holding the filesystem image. It must not change while in use.
+    //|
+    //|   Usage::
+    //|
+    //|     import storage
+    //|     import assets  # frozen module made by mkromfs.py --module
+    //|     storage.mount(storage.VfsRom(assets.IMAGE), "/assets")
+    //|
+    //|   It has the same methods as `VfsFat`, except ``mkfs`` and ``label``. Those that would change the
+    //|   filesystem raise ``OSError``.
+    //|
+    { MP_ROM_QSTR(MP_QSTR_VfsRom), MP_ROM_PTR(&mp_type_vfs_rom) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(storage_module_globals, storage_module_globals_table);
@@ -0,0 +1,232 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <string.h>
+
+#include "py/objlist.h"
+#include "py/objproperty.h"
+#include "py/objtuple.h"
+#include "py/runtime.h"
+#include "shared-bindings/struct/Struct.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: struct
+//|
+//| :class:`Struct` -- precompiled format
+//| =====================================
+//|
+//| A format string parsed once, up front, for packing and unpacking the same
+//| layout many times, such as the registers of a sensor::
+//|
+//|     import struct
+//|
+//|     accel = struct.Struct("<hhh")
+//|     buf = bytearray(accel.size)
+//|     xyz = [0, 0, 0]
+//|     while True:
+//|         i2c.readfrom_into(0x18, buf)
+//|         accel.unpack_into(xyz, buf)
+//|
+//| .. class:: Struct(format)
+//|
+//|   Parse ``format``, which uses the same codes as the module functions.
+//|
+
+STATIC mp_obj_t struct_struct_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    mp_arg_check_num(n_args, kw_args, 1, 1, false);
+    struct_struct_obj_t *self = m_new_obj_var(struct_struct_obj_t, struct_struct_op_t, shared_modules_struct_struct_count(args[0]));
+    self->base.type = &struct_struct_type;
+    shared_modules_struct_struct_construct(self, args[0]);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+// Returns the start of the data in bufinfo at offset, which may be negative to
+// count from the end.
+STATIC byte *struct_struct_buffer_at(mp_buffer_info_t *bufinfo, mp_int_t offset) {
+    if (offset < 0) {
+        offset = (mp_int_t)bufinfo->len + offset;
+        if (offset < 0) {
+            mp_raise_RuntimeError(translate("buffer too small"));
+        }
+    }
+    return (byte *)bufinfo->buf + offset;
+}
+
+//|   .. attribute:: format
+//|
+//|     The format string passed to the constructor.
+//|
+STATIC mp_obj_t struct_struct_obj_get_format(mp_obj_t self_in) {
+    struct_struct_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return self->format;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(struct_struct_get_format_obj, struct_struct_obj_get_format);
+
+const mp_obj_property_t struct_struct_format_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&struct_struct_get_format_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: size
+//|
+//|     The number of bytes needed to store the format, like `calcsize`.
+//|
+STATIC mp_obj_t struct_struct_obj_get_size(mp_obj_t self_in) {
+    struct_struct_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return MP_OBJ_NEW_SMALL_INT(self->size);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(struct_struct_get_size_obj, struct_struct_obj_get_size);
+
+const mp_obj_property_t struct_struct_size_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&struct_struct_get_size_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. method:: pack(*values)
+//|
+//|     Pack the values and return them as a bytes object.
+//|
+STATIC mp_obj_t struct_struct_pack(size_t n_args, const mp_obj_t *args) {
+    struct_struct_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    vstr_t vstr;
+    vstr_init_len(&vstr, self->size);
+    byte *p = (byte*)vstr.buf;
+    shared_modules_struct_struct_pack_into(self, p, p + self->size, n_args - 1, &args[1]);
+    return mp_obj_new_str_from_vstr(&mp_type_bytes, &vstr);
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(struct_struct_pack_obj, 1, MP_OBJ_FUN_ARGS_MAX, struct_struct_pack);
+
+//|   .. method:: pack_into(buffer, offset, *values)
+//|
+//|     Pack the values into buffer starting at offset. offset may be negative
+//|     to count from the end of buffer.
+//|
+STATIC mp_obj_t struct_struct_pack_into(size_t n_args, const mp_obj_t *args) {
+    struct_struct_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_WRITE);
+    byte *p = struct_struct_buffer_at(&bufinfo, mp_obj_get_int(args[2]));
+    shared_modules_struct_struct_pack_into(self, p, (byte *)bufinfo.buf + bufinfo.len, n_args - 3, &args[3]);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(struct_struct_pack_into_obj, 3, MP_OBJ_FUN_ARGS_MAX, struct_struct_pack_into);
+
+//|   .. method:: unpack(data)
+//|
+//|     Unpack data, which must be exactly `size` bytes long, and return a
+//|     tuple of the values.
+//|
+STATIC mp_obj_t struct_struct_unpack(mp_obj_t self_in, mp_obj_t data) {
+    struct_struct_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(data, &bufinfo, MP_BUFFER_READ);
+    mp_obj_tuple_t *res = MP_OBJ_TO_PTR(mp_obj_new_tuple(self->n_ops, NULL));
+    shared_modules_struct_struct_unpack_into(self, bufinfo.buf, (byte *)bufinfo.buf + bufinfo.len, true, res->items);
+    return MP_OBJ_FROM_PTR(res);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(struct_struct_unpack_obj, struct_struct_unpack);
+
+//|   .. method:: unpack_from(data, offset=0)
+//|
+//|     Unpack from data starting at offset and return a tuple of the values.
+//|     offset may be negative to count from the end of data. data only has to
+//|     be big enough.
+//|
+STATIC mp_obj_t struct_struct_unpack_from(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_buffer, ARG_offset };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_buffer, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_offset, MP_ARG_INT, {.u_int = 0} },
+    };
+    struct_struct_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[ARG_buffer].u_obj, &bufinfo, MP_BUFFER_READ);
+    byte *p = struct_struct_buffer_at(&bufinfo, args[ARG_offset].u_int);
+    mp_obj_tuple_t *res = MP_OBJ_TO_PTR(mp_obj_new_tuple(self->n_ops, NULL));
+    shared_modules_struct_struct_unpack_into(self, p, (byte *)bufinfo.buf + bufinfo.len, false, res->items);
+    return MP_OBJ_FROM_PTR(res);
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(struct_struct_unpack_from_obj, 2, struct_struct_unpack_from);
+
+//|   .. method:: unpack_into(items, data, offset=0)
+//|
+//|     Like `unpack_from`, but store the values in the list items instead of
+//|     allocating a new tuple. items must already hold one entry per value.
+//|
+STATIC mp_obj_t struct_struct_unpack_into(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_items, ARG_buffer, ARG_offset };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_items, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_buffer, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_offset, MP_ARG_INT, {.u_int = 0} },
+    };
+    struct_struct_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if (!MP_OBJ_IS_TYPE(args[ARG_items].u_obj, &mp_type_list)) {
+        mp_raise_TypeError(translate("argument num/types mismatch"));
+    }
+    size_t len;
+    mp_obj_t *items;
+    mp_obj_list_get(args[ARG_items].u_obj, &len, &items);
+    if (len != self->n_ops) {
+        mp_raise_ValueError(translate("tuple/list has wrong length"));
+    }
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[ARG_buffer].u_obj, &bufinfo, MP_BUFFER_READ);
+    byte *p = struct_struct_buffer_at(&bufinfo, args[ARG_offset].u_int);
+    shared_modules_struct_struct_unpack_into(self, p, (byte *)bufinfo.buf + bufinfo.len, false, items);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(struct_struct_unpack_into_obj, 3, struct_struct_unpack_into);
+
+STATIC const mp_rom_map_elem_t struct_struct_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_format), MP_ROM_PTR(&struct_struct_format_obj) },
+    { MP_ROM_QSTR(MP_QSTR_size), MP_ROM_PTR(&struct_struct_size_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pack), MP_ROM_PTR(&struct_struct_pack_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pack_into), MP_ROM_PTR(&struct_struct_pack_into_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unpack), MP_ROM_PTR(&struct_struct_unpack_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unpack_from), MP_ROM_PTR(&struct_struct_unpack_from_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unpack_into), MP_ROM_PTR(&struct_struct_unpack_into_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(struct_struct_locals_dict, struct_struct_locals_dict_table);
+
+const mp_obj_type_t struct_struct_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Struct,
+    .make_new = struct_struct_make_new,
+    .locals_dict = (mp_obj_dict_t*)&struct_struct_locals_dict,
+};
@@ -26,7 +26,9 @@
 
 #include <stdbool.h>
 #include "py/objproperty.h"
+#include "py/runtime.h"
 #include "shared-bindings/supervisor/Runtime.h"
+#include "supervisor/serial.h"
 
 //TODO: add USB, REPL to description once they're operational
 //| .. currentmodule:: supervisor
@@ -101,10 +103,56 @@ const mp_obj_property_t supervisor_serial_bytes_available_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+//|     .. attribute:: runtime.serial_write_blocking
+//|
+//|         When ``True``, the default, `print` waits for the host to read
+//|         the serial output when the output buffer is full. When ``False``,
+//|         the output that doesn't fit is dropped so that the code never
+//|         waits on the host. Boards without an output buffer always wait.
+//|         It goes back to ``True`` when the code stops running.
+//|
+STATIC mp_obj_t supervisor_get_serial_write_blocking(mp_obj_t self){
+    return mp_obj_new_bool(serial_get_write_blocking());
+}
+MP_DEFINE_CONST_FUN_OBJ_1(supervisor_get_serial_write_blocking_obj, supervisor_get_serial_write_blocking);
+
+STATIC mp_obj_t supervisor_set_serial_write_blocking(mp_obj_t self, mp_obj_t blocking){
+    serial_set_write_blocking(mp_obj_is_true(blocking));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(supervisor_set_serial_write_blocking_obj, supervisor_set_serial_write_blocking);
+
+const mp_obj_property_t supervisor_serial_write_blocking_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&supervisor_get_serial_write_blocking_obj,
+              (mp_obj_t)&supervisor_set_serial_write_blocking_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+
+//|     .. attribute:: runtime.serial_bytes_dropped
+//|
+//|         Returns the number of serial output bytes dropped while
+//|         `serial_write_blocking` was ``False``. (read-only)
+//|
+STATIC mp_obj_t supervisor_get_serial_bytes_dropped(mp_obj_t self){
+    return mp_obj_new_int_from_uint(serial_get_bytes_dropped());
+}
+MP_DEFINE_CONST_FUN_OBJ_1(supervisor_get_serial_bytes_dropped_obj, supervisor_get_serial_bytes_dropped);
+
+const mp_obj_property_t supervisor_serial_bytes_dropped_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&supervisor_get_serial_bytes_dropped_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 
 STATIC const mp_rom_map_elem_t supervisor_runtime_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_serial_connected), MP_ROM_PTR(&supervisor_serial_connected_obj) },
     { MP_ROM_QSTR(MP_QSTR_serial_bytes_available), MP_ROM_PTR(&supervisor_serial_bytes_available_obj) },
+    { MP_ROM_QSTR(MP_QSTR_serial_write_blocking), MP_ROM_PTR(&supervisor_serial_write_blocking_obj) },
+    { MP_ROM_QSTR(MP_QSTR_serial_bytes_dropped), MP_ROM_PTR(&supervisor_serial_bytes_dropped_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(supervisor_runtime_locals_dict, supervisor_runtime_locals_dict_table);
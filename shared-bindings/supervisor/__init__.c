@@ -29,8 +29,13 @@
 
 #include "lib/utils/interrupt_char.h"
 #include "supervisor/shared/autoreload.h"
+#include "supervisor/shared/background_trace.h"
+#include "supervisor/shared/boot_timing.h"
+#include "supervisor/shared/heap_image.h"
+#include "supervisor/shared/profiler.h"
 #include "supervisor/shared/rgb_led_status.h"
 #include "supervisor/shared/stack.h"
+#include "supervisor/shared/tick.h"
 #include "supervisor/shared/translate.h"
 
 #include "shared-bindings/supervisor/__init__.h"
@@ -60,15 +65,35 @@
 //|   This object is the sole instance of `supervisor.Runtime`.
 //|
 
-//| .. method:: enable_autoreload()
+//| .. method:: enable_autoreload(*, incremental=False)
 //|
 //|   Enable autoreload based on USB file write activity.
 //|
-STATIC mp_obj_t supervisor_enable_autoreload(void) {
+//|   With ``incremental`` set, when only the files of imported modules changed, those modules and
+//|   the modules that import them run again in place of restarting everything. The main file
+//|   keeps running, so it only sees the changes through ``module.name``, not names it took with
+//|   ``from module import name``. Changes to the main file, or to files that aren't imported
+//|   modules, restart everything as before. Only modules imported after incremental reload is
+//|   enabled are reloaded, until the next restart.
+//|
+STATIC mp_obj_t supervisor_enable_autoreload(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_incremental };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_incremental, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    #if !MICROPY_RELOAD_MODULES
+    if (args[ARG_incremental].u_bool) {
+        mp_raise_NotImplementedError(translate("Incremental reload not supported"));
+    }
+    #endif
+    autoreload_set_incremental(args[ARG_incremental].u_bool);
     autoreload_enable();
     return mp_const_none;
 }
-MP_DEFINE_CONST_FUN_OBJ_0(supervisor_enable_autoreload_obj, supervisor_enable_autoreload);
+MP_DEFINE_CONST_FUN_OBJ_KW(supervisor_enable_autoreload_obj, 0, supervisor_enable_autoreload);
 
 //| .. method:: disable_autoreload()
 //|
@@ -124,6 +149,205 @@ STATIC mp_obj_t supervisor_set_next_stack_limit(mp_obj_t size_obj) {
 }
 MP_DEFINE_CONST_FUN_OBJ_1(supervisor_set_next_stack_limit_obj, supervisor_set_next_stack_limit);
 
+#if MICROPY_MAX_STACK_USAGE
+//| .. method:: max_stack_usage()
+//|
+//|   Return the most bytes of C stack used since the VM started. Running code
+//|   that goes deepest and then this shows how far `set_next_stack_limit` can
+//|   be lowered, leaving the rest to the heap. Safe mode after a crash prints
+//|   it too.
+//|
+STATIC mp_obj_t supervisor_max_stack_usage(void) {
+    return mp_obj_new_int_from_uint(stack_get_max_usage());
+}
+MP_DEFINE_CONST_FUN_OBJ_0(supervisor_max_stack_usage_obj, supervisor_max_stack_usage);
+
+#if MICROPY_ENABLE_PYSTACK
+//| .. method:: max_pystack_usage()
+//|
+//|   Return the most bytes of the Python stack, which holds the frames of
+//|   Python function calls, used since the VM started.
+//|
+STATIC mp_obj_t supervisor_max_pystack_usage(void) {
+    return mp_obj_new_int_from_uint(pystack_get_max_usage());
+}
+MP_DEFINE_CONST_FUN_OBJ_0(supervisor_max_pystack_usage_obj, supervisor_max_pystack_usage);
+#endif
+#endif
+
+#if CIRCUITPY_PROFILER
+//| .. method:: start_profiler(*, interval=1, samples=256)
+//|
+//|   Start sampling which Python function and line is running every ``interval``
+//|   milliseconds. The last ``samples`` samples are kept. Restarting the
+//|   profiler discards the previous samples.
+//|
+STATIC mp_obj_t supervisor_start_profiler(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_interval, ARG_samples };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_interval, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 1} },
+        { MP_QSTR_samples, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 256} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if (args[ARG_interval].u_int < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_interval);
+    }
+    if (args[ARG_samples].u_int < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_samples);
+    }
+    supervisor_profiler_start(args[ARG_interval].u_int, args[ARG_samples].u_int);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(supervisor_start_profiler_obj, 0, supervisor_start_profiler);
+
+//| .. method:: stop_profiler()
+//|
+//|   Stop sampling. The samples taken so far are kept for `profiler_results`.
+//|
+STATIC mp_obj_t supervisor_stop_profiler(void) {
+    supervisor_profiler_stop();
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_0(supervisor_stop_profiler_obj, supervisor_stop_profiler);
+
+//| .. method:: profiler_results()
+//|
+//|   Return a dict mapping ``(filename, function_name, line)`` tuples to the
+//|   number of samples taken while that line was running. Time spent outside
+//|   of Python code, such as sleeping or in the REPL, is not counted.
+//|
+STATIC mp_obj_t supervisor_profiler_results(void) {
+    return supervisor_profiler_histogram();
+}
+MP_DEFINE_CONST_FUN_OBJ_0(supervisor_profiler_results_obj, supervisor_profiler_results);
+#endif
+
+#if CIRCUITPY_CYCLE_COUNTER
+//| .. method:: cycle_count()
+//|
+//|   Return the number of CPU cycles since startup. Unlike `time.monotonic()`
+//|   it counts every cycle and doesn't lose precision, so the difference of two
+//|   counts times short runs of code exactly. Divide by
+//|   `microcontroller.cpu.frequency <microcontroller.Processor.frequency>` to
+//|   get seconds. The CPU doesn't count while it sleeps.
+//|
+STATIC mp_obj_t supervisor_cycle_count(void) {
+    return mp_obj_new_int_from_ull(supervisor_ticks_cycles64());
+}
+MP_DEFINE_CONST_FUN_OBJ_0(supervisor_cycle_count_obj, supervisor_cycle_count);
+#endif
+
+//| .. method:: ticks_us()
+//|
+//|   Return the microseconds since startup, wrapped to a small int so that
+//|   reading it doesn't allocate. Only compare values with `ticks_diff`.
+//|
+STATIC mp_obj_t supervisor_ticks_us(void) {
+    return MP_OBJ_NEW_SMALL_INT((supervisor_ticks_ns64() / 1000) & (MICROPY_PY_UTIME_TICKS_PERIOD - 1));
+}
+MP_DEFINE_CONST_FUN_OBJ_0(supervisor_ticks_us_obj, supervisor_ticks_us);
+
+//| .. method:: ticks_diff(end, start)
+//|
+//|   Return the signed difference ``end - start`` of two `ticks_us` values,
+//|   allowing for the wrap around between them.
+//|
+STATIC mp_obj_t supervisor_ticks_diff(mp_obj_t end_in, mp_obj_t start_in) {
+    mp_uint_t start = mp_obj_get_int(start_in);
+    mp_uint_t end = mp_obj_get_int(end_in);
+    mp_int_t diff = ((end - start + MICROPY_PY_UTIME_TICKS_PERIOD / 2) & (MICROPY_PY_UTIME_TICKS_PERIOD - 1))
+                   - MICROPY_PY_UTIME_TICKS_PERIOD / 2;
+    return MP_OBJ_NEW_SMALL_INT(diff);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(supervisor_ticks_diff_obj, supervisor_ticks_diff);
+
+//| .. method:: ticks_add(ticks, delta)
+//|
+//|   Return the `ticks_us` value ``delta`` microseconds after ``ticks``.
+//|   ``delta`` may be negative.
+//|
+STATIC mp_obj_t supervisor_ticks_add(mp_obj_t ticks_in, mp_obj_t delta_in) {
+    mp_uint_t ticks = mp_obj_get_int(ticks_in);
+    mp_uint_t delta = mp_obj_get_int(delta_in);
+    return MP_OBJ_NEW_SMALL_INT((ticks + delta) & (MICROPY_PY_UTIME_TICKS_PERIOD - 1));
+}
+MP_DEFINE_CONST_FUN_OBJ_2(supervisor_ticks_add_obj, supervisor_ticks_add);
+
+#if CIRCUITPY_BACKGROUND_TRACE
+//| .. method:: background_trace()
+//|
+//|   Return the most recent background task and interrupt runs as a tuple of
+//|   ``(id, start, cycles)`` tuples, oldest first. ``id`` is the address of the
+//|   background task's function, or the name of the interrupt such as
+//|   ``"tick"``. ``start`` and ``cycles`` count CPU cycles.
+//|
+STATIC mp_obj_t supervisor_background_trace(void) {
+    return background_trace_records();
+}
+MP_DEFINE_CONST_FUN_OBJ_0(supervisor_background_trace_obj, supervisor_background_trace);
+
+//| .. method:: background_trace_worst()
+//|
+//|   Return a dict mapping each background task and interrupt ``id`` to its
+//|   longest run in cycles since the trace was reset. The trace is kept
+//|   across reloads and shown in the safe mode message.
+//|
+STATIC mp_obj_t supervisor_background_trace_worst(void) {
+    return background_trace_worst();
+}
+MP_DEFINE_CONST_FUN_OBJ_0(supervisor_background_trace_worst_obj, supervisor_background_trace_worst);
+
+//| .. method:: reset_background_trace()
+//|
+//|   Forget the recorded runs and longest runs.
+//|
+STATIC mp_obj_t supervisor_reset_background_trace(void) {
+    background_trace_reset();
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_0(supervisor_reset_background_trace_obj, supervisor_reset_background_trace);
+#endif
+
+#if CIRCUITPY_HEAP_IMAGE
+//| .. method:: save_heap_image()
+//|
+//|   Save the heap to ``/.heap_image`` so that the next time code.py runs it
+//|   starts with the modules imported so far already in `sys.modules`. Call it
+//|   once the imports are done. The image is used until the firmware or any
+//|   of the imported files change, and saving again from a run that started
+//|   with a still good image does nothing.
+//|
+//|   Modules must not set up hardware when imported, because the hardware is
+//|   reset between runs while the objects in the image are not. The
+//|   filesystem must be writable from CircuitPython, see `storage.remount`.
+//|
+//|   Returns ``True`` if an image was written.
+//|
+STATIC mp_obj_t supervisor_save_heap_image(void) {
+    return mp_obj_new_bool(heap_image_save());
+}
+MP_DEFINE_CONST_FUN_OBJ_0(supervisor_save_heap_image_obj, supervisor_save_heap_image);
+#endif
+
+#if CIRCUITPY_BOOT_TIMING
+//| .. method:: boot_times()
+//|
+//|   Return when each step of the last cold start finished, as a tuple of
+//|   ``(name, microseconds)`` tuples: ``"port_init"``, ``"flash_init"``,
+//|   ``"filesystem_mount"``, ``"usb_enumerated"``, ``"boot_py"``,
+//|   ``"code_py"`` (code.py is about to start) and ``"first_frame"`` (the
+//|   first display refresh finished). Times count from the start of the port's
+//|   tick during its initialization, so time in the bootloader isn't included.
+//|   Steps not reached yet have a time of None. Reloads don't change them.
+//|
+STATIC mp_obj_t supervisor_boot_times(void) {
+    return boot_timing_phases();
+}
+MP_DEFINE_CONST_FUN_OBJ_0(supervisor_boot_times_obj, supervisor_boot_times);
+#endif
+
 STATIC const mp_rom_map_elem_t supervisor_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_supervisor) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_enable_autoreload),  MP_ROM_PTR(&supervisor_enable_autoreload_obj) },
@@ -132,6 +356,34 @@ STATIC const mp_rom_map_elem_t supervisor_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_runtime),  MP_ROM_PTR(&common_hal_supervisor_runtime_obj) },
     { MP_ROM_QSTR(MP_QSTR_reload),  MP_ROM_PTR(&supervisor_reload_obj) },
     { MP_ROM_QSTR(MP_QSTR_set_next_stack_limit),  MP_ROM_PTR(&supervisor_set_next_stack_limit_obj) },
+    #if MICROPY_MAX_STACK_USAGE
+    { MP_ROM_QSTR(MP_QSTR_max_stack_usage),  MP_ROM_PTR(&supervisor_max_stack_usage_obj) },
+    #if MICROPY_ENABLE_PYSTACK
+    { MP_ROM_QSTR(MP_QSTR_max_pystack_usage),  MP_ROM_PTR(&supervisor_max_pystack_usage_obj) },
+    #endif
+    #endif
+    #if CIRCUITPY_PROFILER
+    { MP_ROM_QSTR(MP_QSTR_start_profiler),  MP_ROM_PTR(&supervisor_start_profiler_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop_profiler),  MP_ROM_PTR(&supervisor_stop_profiler_obj) },
+    { MP_ROM_QSTR(MP_QSTR_profiler_results),  MP_ROM_PTR(&supervisor_profiler_results_obj) },
+    #endif
+    #if CIRCUITPY_CYCLE_COUNTER
+    { MP_ROM_QSTR(MP_QSTR_cycle_count),  MP_ROM_PTR(&supervisor_cycle_count_obj) },
+    #endif
+    { MP_ROM_QSTR(MP_QSTR_ticks_us),  MP_ROM_PTR(&supervisor_ticks_us_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ticks_diff),  MP_ROM_PTR(&supervisor_ticks_diff_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ticks_add),  MP_ROM_PTR(&supervisor_ticks_add_obj) },
+    #if CIRCUITPY_BACKGROUND_TRACE
+    { MP_ROM_QSTR(MP_QSTR_background_trace),  MP_ROM_PTR(&supervisor_background_trace_obj) },
+    { MP_ROM_QSTR(MP_QSTR_background_trace_worst),  MP_ROM_PTR(&supervisor_background_trace_worst_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reset_background_trace),  MP_ROM_PTR(&supervisor_reset_background_trace_obj) },
+    #endif
+    #if CIRCUITPY_HEAP_IMAGE
+    { MP_ROM_QSTR(MP_QSTR_save_heap_image),  MP_ROM_PTR(&supervisor_save_heap_image_obj) },
+    #endif
+    #if CIRCUITPY_BOOT_TIMING
+    { MP_ROM_QSTR(MP_QSTR_boot_times),  MP_ROM_PTR(&supervisor_boot_times_obj) },
+    #endif
 
 };
 
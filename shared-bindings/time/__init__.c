@@ -34,6 +34,7 @@
 #include "lib/timeutils/timeutils.h"
 #include "shared-bindings/rtc/__init__.h"
 #include "shared-bindings/time/__init__.h"
+#include "supervisor/shared/tick.h"
 #include "supervisor/shared/translate.h"
 
 //| :mod:`time` --- time and timing related functions
@@ -210,14 +211,15 @@ MP_DEFINE_CONST_FUN_OBJ_0(time_time_obj, time_time);
 
 //| .. function:: monotonic_ns()
 //|
-//|   Return the time of the specified clock clk_id in nanoseconds.
+//|   Return the time of the monotonic clock in nanoseconds. Unlike `monotonic`
+//|   it doesn't lose precision over time, and on ports that can read the timer
+//|   behind the millisecond tick it resolves less than a millisecond.
 //|
 //|   :return: the current time
 //|   :rtype: int
 //|
 STATIC mp_obj_t time_monotonic_ns(void) {
-    uint64_t time64 = common_hal_time_monotonic() * 1000000llu;
-    return mp_obj_new_int_from_ll((long long) time64);
+    return mp_obj_new_int_from_ull(supervisor_ticks_ns64());
 }
 MP_DEFINE_CONST_FUN_OBJ_0(time_monotonic_ns_obj, time_monotonic_ns);
 
@@ -138,6 +138,9 @@ const mp_obj_property_t touchio_touchin_value_obj = {
 //|
 //|     The raw touch measurement as an `int`. (read-only)
 //|
+//|     On the SAMD21 all pads are measured in the background and this is the average of the
+//|     last few measurements, so reading it doesn't wait for a new one.
+//|
 STATIC mp_obj_t touchio_touchin_obj_get_raw_value(mp_obj_t self_in) {
     touchio_touchin_obj_t *self = MP_OBJ_TO_PTR(self_in);
     check_for_deinit(self);
@@ -163,6 +166,9 @@ const mp_obj_property_t touchio_touchin_raw_value_obj = {
 //|
 //|     You can adjust `threshold` to make the pin more or less sensitive.
 //|
+//|     On the SAMD21 `threshold` moves with slow drift in the untouched `raw_value`, such as
+//|     from changes in temperature or humidity, and keeps its distance above it.
+//|
 STATIC mp_obj_t touchio_touchin_obj_get_threshold(mp_obj_t self_in) {
     touchio_touchin_obj_t *self = MP_OBJ_TO_PTR(self_in);
     check_for_deinit(self);
@@ -28,6 +28,7 @@
 
 #include "py/obj.h"
 #include "py/runtime.h"
+#include "supervisor/shared/translate.h"
 
 #include "shared-bindings/uheap/__init__.h"
 
@@ -50,9 +51,71 @@ STATIC mp_obj_t uheap_info(mp_obj_t obj) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(uheap_info_obj, uheap_info);
 
+//| .. function:: census()
+//|
+//|   Collect garbage, then return a tuple of two dicts describing the heap. The
+//|   first maps each type to a ``(count, bytes)`` tuple for its instances. Types
+//|   are only recognised if they can be reached from a module. All other
+//|   allocations, such as buffers inside objects, are counted under ``None``.
+//|   The second maps a size in bytes to the number of free runs of at least that
+//|   size (but less than twice that, apart from the largest size listed), which
+//|   shows how fragmented the heap is.
+//|
+STATIC mp_obj_t uheap_census(void) {
+    return shared_module_uheap_census();
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(uheap_census_obj, uheap_census);
+
+//| .. function:: start_profiler(*, entries=32)
+//|
+//|   Start counting heap allocations by the Python line that makes them. Up to
+//|   ``entries`` bytecode instructions are told apart. Restarting the profiler
+//|   discards the previous counts.
+//|
+STATIC mp_obj_t uheap_start_profiler(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_entries };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_entries, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 32} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if (args[ARG_entries].u_int < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_entries);
+    }
+    shared_module_uheap_profiler_start(args[ARG_entries].u_int);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(uheap_start_profiler_obj, 0, uheap_start_profiler);
+
+//| .. function:: stop_profiler()
+//|
+//|   Stop counting allocations. The counts so far are kept for `profiler_results`.
+//|
+STATIC mp_obj_t uheap_stop_profiler(void) {
+    shared_module_uheap_profiler_stop();
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(uheap_stop_profiler_obj, uheap_stop_profiler);
+
+//| .. function:: profiler_results()
+//|
+//|   Return a dict mapping ``(filename, function_name, line)`` tuples to
+//|   ``(allocations, bytes)`` tuples. Allocations made outside of Python code,
+//|   or by instructions that didn't fit in the table, are counted under ``None``.
+//|
+STATIC mp_obj_t uheap_profiler_results(void) {
+    return shared_module_uheap_profiler_results();
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(uheap_profiler_results_obj, uheap_profiler_results);
+
 STATIC const mp_rom_map_elem_t uheap_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_uheap) },
     { MP_ROM_QSTR(MP_QSTR_info), MP_ROM_PTR(&uheap_info_obj) },
+    { MP_ROM_QSTR(MP_QSTR_census), MP_ROM_PTR(&uheap_census_obj) },
+    { MP_ROM_QSTR(MP_QSTR_start_profiler), MP_ROM_PTR(&uheap_start_profiler_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop_profiler), MP_ROM_PTR(&uheap_stop_profiler_obj) },
+    { MP_ROM_QSTR(MP_QSTR_profiler_results), MP_ROM_PTR(&uheap_profiler_results_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(uheap_module_globals, uheap_module_globals_table);
@@ -31,4 +31,11 @@
 
 extern uint32_t shared_module_uheap_info(mp_obj_t obj);
 
+extern mp_obj_t shared_module_uheap_census(void);
+
+extern void shared_module_uheap_profiler_start(size_t entry_count);
+extern void shared_module_uheap_profiler_stop(void);
+extern mp_obj_t shared_module_uheap_profiler_results(void);
+extern void shared_module_uheap_profiler_reset(void);
+
 #endif  // MICROPY_INCLUDED_SHARED_BINDINGS_UHEAP___INIT___H
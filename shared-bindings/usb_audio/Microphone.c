@@ -0,0 +1,145 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "shared-bindings/usb_audio/Microphone.h"
+
+#include "py/objproperty.h"
+#include "py/runtime.h"
+
+//| .. currentmodule:: usb_audio
+//|
+//| :class:`Microphone` -- Audio to the host
+//| ========================================
+//|
+//| .. class:: Microphone()
+//|
+//|   You cannot create an instance of `usb_audio.Microphone`. Use `usb_audio.microphone`.
+//|
+//|   Send what an `audiobusio.I2SIn` or mono `audiobusio.PDMIn` records to the host::
+//|
+//|     import audiobusio
+//|     import board
+//|     import usb_audio
+//|
+//|     mic = audiobusio.PDMIn(board.MICROPHONE_CLOCK, board.MICROPHONE_DATA, sample_rate=16000, bit_depth=16)
+//|     mic.start()
+//|     usb_audio.microphone.source = mic
+//|
+//|   The host receives signed 16 bit stereo. Mono sources are sent on both channels.
+//|
+
+//|   .. attribute:: source
+//|
+//|     The recording `audiobusio.I2SIn` or `audiobusio.PDMIn` to send, or None. Its sample rate
+//|     must be within 2% of `sample_rate`. Start it recording with its ``start()`` method.
+//|
+STATIC mp_obj_t usb_audio_microphone_obj_get_source(mp_obj_t self_in) {
+    usb_audio_microphone_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return common_hal_usb_audio_microphone_get_source(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(usb_audio_microphone_get_source_obj, usb_audio_microphone_obj_get_source);
+
+STATIC mp_obj_t usb_audio_microphone_obj_set_source(mp_obj_t self_in, mp_obj_t source) {
+    usb_audio_microphone_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_usb_audio_microphone_set_source(self, source == mp_const_none ? MP_OBJ_NULL : source);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(usb_audio_microphone_set_source_obj, usb_audio_microphone_obj_set_source);
+
+const mp_obj_property_t usb_audio_microphone_source_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&usb_audio_microphone_get_source_obj,
+              (mp_obj_t)&usb_audio_microphone_set_source_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: sample_rate
+//|
+//|     The sample rate the host receives. (read-only)
+//|
+STATIC mp_obj_t usb_audio_microphone_obj_get_sample_rate(mp_obj_t self_in) {
+    usb_audio_microphone_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_usb_audio_microphone_get_sample_rate(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(usb_audio_microphone_get_sample_rate_obj, usb_audio_microphone_obj_get_sample_rate);
+
+const mp_obj_property_t usb_audio_microphone_sample_rate_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&usb_audio_microphone_get_sample_rate_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: streaming
+//|
+//|     True while the host has the microphone open. (read-only)
+//|
+STATIC mp_obj_t usb_audio_microphone_obj_get_streaming(mp_obj_t self_in) {
+    usb_audio_microphone_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_bool(common_hal_usb_audio_microphone_get_streaming(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(usb_audio_microphone_get_streaming_obj, usb_audio_microphone_obj_get_streaming);
+
+const mp_obj_property_t usb_audio_microphone_streaming_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&usb_audio_microphone_get_streaming_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: overruns
+//|
+//|     The number of times the buffer to the host was full while the source had more. (read-only)
+//|
+STATIC mp_obj_t usb_audio_microphone_obj_get_overruns(mp_obj_t self_in) {
+    usb_audio_microphone_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_int_from_uint(common_hal_usb_audio_microphone_get_overruns(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(usb_audio_microphone_get_overruns_obj, usb_audio_microphone_obj_get_overruns);
+
+const mp_obj_property_t usb_audio_microphone_overruns_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&usb_audio_microphone_get_overruns_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t usb_audio_microphone_locals_dict_table[] = {
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_source),      MP_ROM_PTR(&usb_audio_microphone_source_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sample_rate), MP_ROM_PTR(&usb_audio_microphone_sample_rate_obj) },
+    { MP_ROM_QSTR(MP_QSTR_streaming),   MP_ROM_PTR(&usb_audio_microphone_streaming_obj) },
+    { MP_ROM_QSTR(MP_QSTR_overruns),    MP_ROM_PTR(&usb_audio_microphone_overruns_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(usb_audio_microphone_locals_dict, usb_audio_microphone_locals_dict_table);
+
+const mp_obj_type_t usb_audio_microphone_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Microphone,
+    .locals_dict = (mp_obj_dict_t*)&usb_audio_microphone_locals_dict,
+};
@@ -0,0 +1,142 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "shared-bindings/usb_audio/Speaker.h"
+
+#include "py/objproperty.h"
+#include "py/runtime.h"
+
+//| .. currentmodule:: usb_audio
+//|
+//| :class:`Speaker` -- Audio from the host
+//| =======================================
+//|
+//| .. class:: Speaker()
+//|
+//|   You cannot create an instance of `usb_audio.Speaker`. Use `usb_audio.speaker`.
+//|
+//|   Play it like any other sample, with ``loop`` False. It is signed 16 bit stereo and never
+//|   ends. It plays silence while the host isn't sending and until half its buffer has filled.
+//|   The host is told to speed up or slow down to keep the buffer half full, so the player's
+//|   clock sets the pace.
+//|
+
+//|   .. attribute:: sample_rate
+//|
+//|     The sample rate the host sends. (read-only)
+//|
+STATIC mp_obj_t usb_audio_speaker_obj_get_sample_rate(mp_obj_t self_in) {
+    usb_audio_speaker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_usb_audio_speaker_get_sample_rate(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(usb_audio_speaker_get_sample_rate_obj, usb_audio_speaker_obj_get_sample_rate);
+
+const mp_obj_property_t usb_audio_speaker_sample_rate_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&usb_audio_speaker_get_sample_rate_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: streaming
+//|
+//|     True while the host has the speaker open. (read-only)
+//|
+STATIC mp_obj_t usb_audio_speaker_obj_get_streaming(mp_obj_t self_in) {
+    usb_audio_speaker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_bool(common_hal_usb_audio_speaker_get_streaming(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(usb_audio_speaker_get_streaming_obj, usb_audio_speaker_obj_get_streaming);
+
+const mp_obj_property_t usb_audio_speaker_streaming_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&usb_audio_speaker_get_streaming_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: underruns
+//|
+//|     The number of times the player ran out of audio while the host was streaming. (read-only)
+//|
+STATIC mp_obj_t usb_audio_speaker_obj_get_underruns(mp_obj_t self_in) {
+    usb_audio_speaker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_int_from_uint(common_hal_usb_audio_speaker_get_underruns(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(usb_audio_speaker_get_underruns_obj, usb_audio_speaker_obj_get_underruns);
+
+const mp_obj_property_t usb_audio_speaker_underruns_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&usb_audio_speaker_get_underruns_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: overruns
+//|
+//|     The number of packets from the host dropped because the buffer was full, such as when the
+//|     speaker isn't playing. (read-only)
+//|
+STATIC mp_obj_t usb_audio_speaker_obj_get_overruns(mp_obj_t self_in) {
+    usb_audio_speaker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_int_from_uint(common_hal_usb_audio_speaker_get_overruns(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(usb_audio_speaker_get_overruns_obj, usb_audio_speaker_obj_get_overruns);
+
+const mp_obj_property_t usb_audio_speaker_overruns_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&usb_audio_speaker_get_overruns_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t usb_audio_speaker_locals_dict_table[] = {
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_sample_rate), MP_ROM_PTR(&usb_audio_speaker_sample_rate_obj) },
+    { MP_ROM_QSTR(MP_QSTR_streaming),   MP_ROM_PTR(&usb_audio_speaker_streaming_obj) },
+    { MP_ROM_QSTR(MP_QSTR_underruns),   MP_ROM_PTR(&usb_audio_speaker_underruns_obj) },
+    { MP_ROM_QSTR(MP_QSTR_overruns),    MP_ROM_PTR(&usb_audio_speaker_overruns_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(usb_audio_speaker_locals_dict, usb_audio_speaker_locals_dict_table);
+
+STATIC const audiosample_p_t usb_audio_speaker_proto = {
+    MP_PROTO_IMPLEMENT(MP_QSTR_protocol_audiosample)
+    .sample_rate = (audiosample_sample_rate_fun)common_hal_usb_audio_speaker_get_sample_rate,
+    .bits_per_sample = (audiosample_bits_per_sample_fun)common_hal_usb_audio_speaker_get_bits_per_sample,
+    .channel_count = (audiosample_channel_count_fun)common_hal_usb_audio_speaker_get_channel_count,
+    .reset_buffer = (audiosample_reset_buffer_fun)usb_audio_speaker_reset_buffer,
+    .get_buffer = (audiosample_get_buffer_fun)usb_audio_speaker_get_buffer,
+    .get_buffer_structure = (audiosample_get_buffer_structure_fun)usb_audio_speaker_get_buffer_structure,
+};
+
+const mp_obj_type_t usb_audio_speaker_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Speaker,
+    .locals_dict = (mp_obj_dict_t*)&usb_audio_speaker_locals_dict,
+    .protocol = &usb_audio_speaker_proto,
+};
@@ -0,0 +1,41 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_USB_AUDIO_SPEAKER_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_USB_AUDIO_SPEAKER_H
+
+#include "shared-module/usb_audio/Speaker.h"
+
+extern const mp_obj_type_t usb_audio_speaker_type;
+
+uint32_t common_hal_usb_audio_speaker_get_sample_rate(usb_audio_speaker_obj_t* self);
+uint8_t common_hal_usb_audio_speaker_get_bits_per_sample(usb_audio_speaker_obj_t* self);
+uint8_t common_hal_usb_audio_speaker_get_channel_count(usb_audio_speaker_obj_t* self);
+bool common_hal_usb_audio_speaker_get_streaming(usb_audio_speaker_obj_t* self);
+uint32_t common_hal_usb_audio_speaker_get_underruns(usb_audio_speaker_obj_t* self);
+uint32_t common_hal_usb_audio_speaker_get_overruns(usb_audio_speaker_obj_t* self);
+
+#endif  // MICROPY_INCLUDED_SHARED_BINDINGS_USB_AUDIO_SPEAKER_H
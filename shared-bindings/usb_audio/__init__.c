@@ -0,0 +1,83 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#include "shared-bindings/usb_audio/Microphone.h"
+#include "shared-bindings/usb_audio/Speaker.h"
+
+//| :mod:`usb_audio` --- Audio over USB
+//| =================================================
+//|
+//| .. module:: usb_audio
+//|   :synopsis: Audio over USB
+//|
+//| The `usb_audio` module streams audio between the host and the audio pipeline. The board shows
+//| up as a USB sound card with a speaker and a microphone. Samples are moved in the background so
+//| latency is set by buffer sizes rather than by Python.
+//|
+//| Play what the host sends through I2S::
+//|
+//|   import audiobusio
+//|   import board
+//|   import usb_audio
+//|
+//|   i2s = audiobusio.I2SOut(board.D1, board.D0, board.D9)
+//|   i2s.play(usb_audio.speaker)
+//|
+//| Libraries
+//|
+//| .. toctree::
+//|     :maxdepth: 3
+//|
+//|     Speaker
+//|     Microphone
+//|
+//| .. data:: speaker
+//|
+//|   The `Speaker`, which plays what the host sends.
+//|
+//| .. data:: microphone
+//|
+//|   The `Microphone`, which sends what its source records to the host.
+//|
+STATIC const mp_rom_map_elem_t usb_audio_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__),   MP_ROM_QSTR(MP_QSTR_usb_audio) },
+    { MP_ROM_QSTR(MP_QSTR_Speaker),    MP_ROM_PTR(&usb_audio_speaker_type) },
+    { MP_ROM_QSTR(MP_QSTR_Microphone), MP_ROM_PTR(&usb_audio_microphone_type) },
+    { MP_ROM_QSTR(MP_QSTR_speaker),    MP_ROM_PTR(&usb_audio_speaker_obj) },
+    { MP_ROM_QSTR(MP_QSTR_microphone), MP_ROM_PTR(&usb_audio_microphone_obj) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(usb_audio_module_globals, usb_audio_module_globals_table);
+
+const mp_obj_module_t usb_audio_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t*)&usb_audio_module_globals,
+};
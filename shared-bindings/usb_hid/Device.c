@@ -45,20 +45,32 @@
 //|
 //|   Not currently dynamically supported.
 //|
-//|   .. method:: send_report(buf)
+//|   .. method:: send_report(buf, *, block=True)
 //|
-//|     Send a HID report.
+//|     Send a HID report. Reports are queued and sent as the host polls for them, so this returns
+//|     straight away unless the queue is full.
 //|
-STATIC mp_obj_t usb_hid_device_send_report(mp_obj_t self_in, mp_obj_t buffer) {
-    usb_hid_device_obj_t *self = MP_OBJ_TO_PTR(self_in);
+//|     :param bool block: when the queue is full, wait for room. When False, return False
+//|       immediately instead.
+//|     :return: True if the report was queued
+//|     :rtype: bool
+//|
+STATIC mp_obj_t usb_hid_device_send_report(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_buf, ARG_block };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_buf,   MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_block, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = true} },
+    };
+    usb_hid_device_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
     mp_buffer_info_t bufinfo;
-    mp_get_buffer_raise(buffer, &bufinfo, MP_BUFFER_READ);
+    mp_get_buffer_raise(args[ARG_buf].u_obj, &bufinfo, MP_BUFFER_READ);
 
-    common_hal_usb_hid_device_send_report(self, ((uint8_t*) bufinfo.buf), bufinfo.len);
-    return mp_const_none;
+    return mp_obj_new_bool(common_hal_usb_hid_device_send_report(self, ((uint8_t*) bufinfo.buf), bufinfo.len, args[ARG_block].u_bool));
 }
-MP_DEFINE_CONST_FUN_OBJ_2(usb_hid_device_send_report_obj, usb_hid_device_send_report);
+MP_DEFINE_CONST_FUN_OBJ_KW(usb_hid_device_send_report_obj, 1, usb_hid_device_send_report);
 
 //|   .. attribute:: usage_page
 //|
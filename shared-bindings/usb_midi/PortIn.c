@@ -70,6 +70,24 @@
 //|     :rtype: bytes or None
 //|
 
+//|   .. method:: read_packets(buf)
+//|
+//|     Read whole 4 byte USB-MIDI event packets into ``buf`` without waiting. Each packet is the
+//|     cable number and code index, followed by a complete MIDI message of up to three bytes, so no
+//|     parsing is needed to find message boundaries. Don't mix this with `read` because a partly
+//|     read packet is dropped.
+//|
+//|     :return: number of bytes read, a multiple of 4
+//|     :rtype: int
+//|
+STATIC mp_obj_t usb_midi_portin_obj_read_packets(mp_obj_t self_in, mp_obj_t buf_in) {
+    usb_midi_portin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_WRITE);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_usb_midi_portin_read_packets(self, bufinfo.buf, bufinfo.len));
+}
+MP_DEFINE_CONST_FUN_OBJ_2(usb_midi_portin_read_packets_obj, usb_midi_portin_obj_read_packets);
+
 // These three methods are used by the shared stream methods.
 STATIC mp_uint_t usb_midi_portin_read(mp_obj_t self_in, void *buf_in, mp_uint_t size, int *errcode) {
     usb_midi_portin_obj_t *self = MP_OBJ_TO_PTR(self_in);
@@ -103,6 +121,7 @@ STATIC const mp_rom_map_elem_t usb_midi_portin_locals_dict_table[] = {
     // Standard stream methods.
     { MP_OBJ_NEW_QSTR(MP_QSTR_read),     MP_ROM_PTR(&mp_stream_read_obj) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&mp_stream_readinto_obj) },
+    { MP_ROM_QSTR(MP_QSTR_read_packets), MP_ROM_PTR(&usb_midi_portin_read_packets_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(usb_midi_portin_locals_dict, usb_midi_portin_locals_dict_table);
 
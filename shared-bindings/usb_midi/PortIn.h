@@ -35,6 +35,10 @@ extern const mp_obj_type_t usb_midi_portin_type;
 extern size_t common_hal_usb_midi_portin_read(usb_midi_portin_obj_t *self,
     uint8_t *data, size_t len, int *errcode);
 
+// Read whole 4 byte USB-MIDI event packets.
+extern size_t common_hal_usb_midi_portin_read_packets(usb_midi_portin_obj_t *self,
+    uint8_t *data, size_t len);
+
 extern uint32_t common_hal_usb_midi_portin_bytes_available(usb_midi_portin_obj_t *self);
 extern void common_hal_usb_midi_portin_clear_buffer(usb_midi_portin_obj_t *self);
 
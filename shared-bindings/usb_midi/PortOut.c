@@ -53,12 +53,32 @@
 //
 //|   .. method:: write(buf)
 //|
-//|     Write the buffer of bytes to the bus.
+//|     Write the buffer of bytes to the bus. Messages may use running status, leaving out the
+//|     status byte when it repeats the previous channel message's.
 //|
 //|     :return: the number of bytes written
 //|     :rtype: int or None
 //|
 
+//|   .. method:: write_packets(buf)
+//|
+//|     Write whole 4 byte USB-MIDI event packets without waiting. This skips parsing the MIDI
+//|     byte stream and is the fastest way to send many messages.
+//|
+//|     :return: the number of bytes written, a multiple of 4
+//|     :rtype: int
+//|
+STATIC mp_obj_t usb_midi_portout_obj_write_packets(mp_obj_t self_in, mp_obj_t buf_in) {
+    usb_midi_portout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_READ);
+    if (bufinfo.len % 4 != 0) {
+        mp_raise_ValueError(translate("Buffer length must be a multiple of 4"));
+    }
+    return MP_OBJ_NEW_SMALL_INT(common_hal_usb_midi_portout_write_packets(self, bufinfo.buf, bufinfo.len));
+}
+MP_DEFINE_CONST_FUN_OBJ_2(usb_midi_portout_write_packets_obj, usb_midi_portout_obj_write_packets);
+
 STATIC mp_uint_t usb_midi_portout_write(mp_obj_t self_in, const void *buf_in, mp_uint_t size, int *errcode) {
     usb_midi_portout_obj_t *self = MP_OBJ_TO_PTR(self_in);
     const byte *buf = buf_in;
@@ -85,6 +105,7 @@ STATIC mp_uint_t usb_midi_portout_ioctl(mp_obj_t self_in, mp_uint_t request, mp_
 STATIC const mp_rom_map_elem_t usb_midi_portout_locals_dict_table[] = {
     // Standard stream methods.
     { MP_OBJ_NEW_QSTR(MP_QSTR_write),    MP_ROM_PTR(&mp_stream_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_write_packets), MP_ROM_PTR(&usb_midi_portout_write_packets_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(usb_midi_portout_locals_dict, usb_midi_portout_locals_dict_table);
 
@@ -34,13 +34,24 @@
 #include "shared-bindings/_bleio/ScanEntry.h"
 #include "shared-bindings/_bleio/ScanResults.h"
 
-bleio_scanresults_obj_t* shared_module_bleio_new_scanresults(size_t buffer_size, uint8_t* prefixes, size_t prefixes_len, mp_int_t minimum_rssi) {
+// Offset of the rssi within an entry on the buffer. It comes after the type and the ticks.
+#define RSSI_OFFSET (sizeof(uint8_t) + sizeof(uint64_t))
+
+bleio_scanresults_obj_t* shared_module_bleio_new_scanresults(size_t buffer_size, uint8_t* prefixes, size_t prefixes_len, mp_int_t minimum_rssi, mp_float_t duplicate_window, bool update_rssi) {
     bleio_scanresults_obj_t* self = m_new_obj(bleio_scanresults_obj_t);
     self->base.type = &bleio_scanresults_type;
     ringbuf_alloc(&self->buf, buffer_size, false);
     self->prefixes = prefixes;
     self->prefix_length = prefixes_len;
     self->minimum_rssi = minimum_rssi;
+    self->duplicates = NULL;
+    if (duplicate_window > 0) {
+        self->duplicates = m_new0(bleio_scan_duplicate_t, BLEIO_SCAN_DUPLICATE_COUNT);
+    }
+    self->duplicate_window_ms = duplicate_window * 1000;
+    self->put_total = 0;
+    self->get_total = 0;
+    self->update_rssi = update_rssi;
     return self;
 }
 
@@ -67,6 +78,7 @@ mp_obj_t common_hal_bleio_scanresults_next(bleio_scanresults_obj_t *self) {
 
     mp_obj_str_t *o = MP_OBJ_TO_PTR(mp_obj_new_bytes_of_zeros(len));
     ringbuf_get_n(&self->buf, (uint8_t*) o->data, len);
+    self->get_total += RSSI_OFFSET + sizeof(rssi) + sizeof(peer_addr) + sizeof(addr_type) + sizeof(len) + len;
 
     bleio_scanentry_obj_t *entry = m_new_obj(bleio_scanentry_obj_t);
     entry->base.type = &bleio_scanentry_type;
@@ -85,6 +97,46 @@ mp_obj_t common_hal_bleio_scanresults_next(bleio_scanresults_obj_t *self) {
     return MP_OBJ_FROM_PTR(entry);
 }
 
+// Finds the device in the recently seen list, or returns NULL.
+STATIC bleio_scan_duplicate_t* find_duplicate(bleio_scanresults_obj_t* self,
+                                              bool scan_response,
+                                              uint8_t *peer_addr,
+                                              uint8_t addr_type) {
+    for (size_t i = 0; i < BLEIO_SCAN_DUPLICATE_COUNT; i++) {
+        bleio_scan_duplicate_t *d = &self->duplicates[i];
+        if (d->addr_type == addr_type && d->scan_response == scan_response &&
+            memcmp(d->peer_addr, peer_addr, sizeof(d->peer_addr)) == 0) {
+            return d;
+        }
+    }
+    return NULL;
+}
+
+// Remember a device that was just added to the buffer. New devices replace the one seen longest
+// ago.
+STATIC void remember_device(bleio_scanresults_obj_t* self,
+                            bleio_scan_duplicate_t *d,
+                            uint32_t now_ms,
+                            bool scan_response,
+                            uint8_t *peer_addr,
+                            uint8_t addr_type,
+                            uint32_t position,
+                            uint16_t index) {
+    if (d == NULL) {
+        d = &self->duplicates[0];
+        for (size_t i = 1; i < BLEIO_SCAN_DUPLICATE_COUNT; i++) {
+            if (now_ms - self->duplicates[i].last_seen_ms > now_ms - d->last_seen_ms) {
+                d = &self->duplicates[i];
+            }
+        }
+        memcpy(d->peer_addr, peer_addr, sizeof(d->peer_addr));
+        d->addr_type = addr_type;
+        d->scan_response = scan_response;
+    }
+    d->last_seen_ms = now_ms;
+    d->position = position;
+    d->index = index;
+}
 
 void shared_module_bleio_scanresults_append(bleio_scanresults_obj_t* self,
                                             uint64_t ticks_ms,
@@ -97,11 +149,6 @@ void shared_module_bleio_scanresults_append(bleio_scanresults_obj_t* self,
                                             uint16_t len) {
     int32_t packet_size = sizeof(uint8_t) + sizeof(ticks_ms) + sizeof(rssi) + NUM_BLEIO_ADDRESS_BYTES +
         sizeof(addr_type) + sizeof(len) + len;
-    int32_t empty_space = self->buf.size - ringbuf_count(&self->buf);
-    if (packet_size >= empty_space) {
-        // We can't fit the packet so skip it.
-        return;
-    }
     // Filter the packet.
     if (rssi < self->minimum_rssi) {
         return;
@@ -111,6 +158,30 @@ void shared_module_bleio_scanresults_append(bleio_scanresults_obj_t* self,
     if (!bleio_scanentry_data_matches(data, len, self->prefixes, self->prefix_length, true)) {
         return;
     }
+
+    // Drop reports from devices seen recently, but refresh the RSSI of the earlier entry if it
+    // hasn't been read yet.
+    bleio_scan_duplicate_t *duplicate = NULL;
+    if (self->duplicates != NULL) {
+        duplicate = find_duplicate(self, scan_response, peer_addr, addr_type);
+        if (duplicate != NULL && (uint32_t) ticks_ms - duplicate->last_seen_ms < self->duplicate_window_ms) {
+            int32_t unread = duplicate->position - self->get_total;
+            if (self->update_rssi && unread >= 0) {
+                self->buf.buf[(duplicate->index + RSSI_OFFSET) % self->buf.size] = rssi;
+            }
+            return;
+        }
+    }
+
+    int32_t empty_space = self->buf.size - ringbuf_count(&self->buf);
+    if (packet_size >= empty_space) {
+        // We can't fit the packet so skip it.
+        return;
+    }
+    if (self->duplicates != NULL) {
+        remember_device(self, duplicate, ticks_ms, scan_response, peer_addr, addr_type,
+                        self->put_total, self->buf.iput);
+    }
     uint8_t type = 0;
     if (connectable) {
         type |= 1 << 0;
@@ -127,6 +198,7 @@ void shared_module_bleio_scanresults_append(bleio_scanresults_obj_t* self,
     ringbuf_put(&self->buf, addr_type);
     ringbuf_put_n(&self->buf, (uint8_t*) &len, sizeof(len));
     ringbuf_put_n(&self->buf, data, len);
+    self->put_total += packet_size;
 }
 
 bool shared_module_bleio_scanresults_get_done(bleio_scanresults_obj_t* self) {
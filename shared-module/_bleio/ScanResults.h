@@ -33,6 +33,20 @@
 #include "py/obj.h"
 #include "py/ringbuf.h"
 
+// The number of recently seen devices remembered for duplicate filtering.
+#define BLEIO_SCAN_DUPLICATE_COUNT (16)
+
+typedef struct {
+    uint8_t peer_addr[6];
+    uint8_t addr_type;
+    bool scan_response;
+    uint32_t last_seen_ms;
+    // Where the device's last entry starts, counted in bytes put on the buffer since the start
+    // and as an index into the buffer.
+    uint32_t position;
+    uint16_t index;
+} bleio_scan_duplicate_t;
+
 typedef struct {
     mp_obj_base_t base;
     // Pointers that needs to live until the scan is done.
@@ -42,11 +56,18 @@ typedef struct {
     uint8_t* prefixes;
     size_t prefix_length;
     mp_int_t minimum_rssi;
+    // NULL when duplicates aren't filtered.
+    bleio_scan_duplicate_t* duplicates;
+    uint32_t duplicate_window_ms;
+    // Total bytes put on and taken off buf, used to find entries that haven't been read yet.
+    uint32_t put_total;
+    uint32_t get_total;
+    bool update_rssi;
     bool active;
     bool done;
 } bleio_scanresults_obj_t;
 
-bleio_scanresults_obj_t* shared_module_bleio_new_scanresults(size_t buffer_size, uint8_t* prefixes, size_t prefixes_len, mp_int_t minimum_rssi);
+bleio_scanresults_obj_t* shared_module_bleio_new_scanresults(size_t buffer_size, uint8_t* prefixes, size_t prefixes_len, mp_int_t minimum_rssi, mp_float_t duplicate_window, bool update_rssi);
 
 bool shared_module_bleio_scanresults_get_done(bleio_scanresults_obj_t* self);
 void shared_module_bleio_scanresults_set_done(bleio_scanresults_obj_t* self, bool done);
@@ -43,7 +43,11 @@ void pixelbuf_set_pixel_int(uint8_t *buf, mp_int_t value, pixelbuf_byteorder_det
     }
 }
 
-void pixelbuf_set_pixel(uint8_t *buf, uint8_t *rawbuf, float brightness, mp_obj_t *item, pixelbuf_byteorder_details_t *byteorder, bool dotstar) {
+uint16_t pixelbuf_brightness_scale(mp_float_t brightness) {
+    return (uint16_t) (brightness * PIXELBUF_FULL_BRIGHTNESS + (mp_float_t) 0.5);
+}
+
+void pixelbuf_set_pixel(uint8_t *buf, uint8_t *rawbuf, uint16_t brightness, mp_obj_t *item, pixelbuf_byteorder_details_t *byteorder, bool dotstar) {
     if (MP_OBJ_IS_INT(item)) {
         uint8_t *target = rawbuf ? rawbuf : buf;
         pixelbuf_set_pixel_int(target, mp_obj_get_int_truncated(item), byteorder);
@@ -53,13 +57,13 @@ void pixelbuf_set_pixel(uint8_t *buf, uint8_t *rawbuf, float brightness, mp_obj_
                 rawbuf[0] = DOTSTAR_LED_START_FULL_BRIGHT;
         }
         if (rawbuf) {
-            buf[byteorder->byteorder.r] = rawbuf[byteorder->byteorder.r] * brightness;
-            buf[byteorder->byteorder.g] = rawbuf[byteorder->byteorder.g] * brightness;
-            buf[byteorder->byteorder.b] = rawbuf[byteorder->byteorder.b] * brightness;
+            buf[byteorder->byteorder.r] = PIXELBUF_SCALE(rawbuf[byteorder->byteorder.r], brightness);
+            buf[byteorder->byteorder.g] = PIXELBUF_SCALE(rawbuf[byteorder->byteorder.g], brightness);
+            buf[byteorder->byteorder.b] = PIXELBUF_SCALE(rawbuf[byteorder->byteorder.b], brightness);
         } else {
-            buf[byteorder->byteorder.r] *= brightness;
-            buf[byteorder->byteorder.g] *= brightness;
-            buf[byteorder->byteorder.b] *= brightness;
+            buf[byteorder->byteorder.r] = PIXELBUF_SCALE(buf[byteorder->byteorder.r], brightness);
+            buf[byteorder->byteorder.g] = PIXELBUF_SCALE(buf[byteorder->byteorder.g], brightness);
+            buf[byteorder->byteorder.b] = PIXELBUF_SCALE(buf[byteorder->byteorder.b], brightness);
         }
     } else {
         mp_obj_t *items;
@@ -68,13 +72,16 @@ void pixelbuf_set_pixel(uint8_t *buf, uint8_t *rawbuf, float brightness, mp_obj_
         if (len != byteorder->bpp && !dotstar) 
             mp_raise_ValueError_varg(translate("Expected tuple of length %d, got %d"), byteorder->bpp, len);
 
-        buf[byteorder->byteorder.r] = mp_obj_get_int_truncated(items[PIXEL_R]) * brightness;
-        buf[byteorder->byteorder.g] = mp_obj_get_int_truncated(items[PIXEL_G]) * brightness;
-        buf[byteorder->byteorder.b] = mp_obj_get_int_truncated(items[PIXEL_B]) * brightness;
+        uint8_t r = mp_obj_get_int_truncated(items[PIXEL_R]);
+        uint8_t g = mp_obj_get_int_truncated(items[PIXEL_G]);
+        uint8_t b = mp_obj_get_int_truncated(items[PIXEL_B]);
+        buf[byteorder->byteorder.r] = PIXELBUF_SCALE(r, brightness);
+        buf[byteorder->byteorder.g] = PIXELBUF_SCALE(g, brightness);
+        buf[byteorder->byteorder.b] = PIXELBUF_SCALE(b, brightness);
         if (rawbuf) {
-            rawbuf[byteorder->byteorder.r] = mp_obj_get_int_truncated(items[PIXEL_R]);
-            rawbuf[byteorder->byteorder.g] = mp_obj_get_int_truncated(items[PIXEL_G]);
-            rawbuf[byteorder->byteorder.b] = mp_obj_get_int_truncated(items[PIXEL_B]);
+            rawbuf[byteorder->byteorder.r] = r;
+            rawbuf[byteorder->byteorder.g] = g;
+            rawbuf[byteorder->byteorder.b] = b;
         }
         if (len > 3) {
             if (dotstar) {
@@ -82,9 +89,10 @@ void pixelbuf_set_pixel(uint8_t *buf, uint8_t *rawbuf, float brightness, mp_obj_
                 if (rawbuf)
                     rawbuf[byteorder->byteorder.w] = buf[byteorder->byteorder.w];
             } else {
-                buf[byteorder->byteorder.w] = mp_obj_get_int_truncated(items[PIXEL_W]) * brightness;
+                uint8_t w = mp_obj_get_int_truncated(items[PIXEL_W]);
+                buf[byteorder->byteorder.w] = PIXELBUF_SCALE(w, brightness);
                 if (rawbuf)
-                    rawbuf[byteorder->byteorder.w] = mp_obj_get_int_truncated(items[PIXEL_W]);
+                    rawbuf[byteorder->byteorder.w] = w;
             }
         } else if (dotstar) {
             buf[byteorder->byteorder.w] = DOTSTAR_LED_START_FULL_BRIGHT;
@@ -118,3 +126,93 @@ mp_obj_t *pixelbuf_get_pixel(uint8_t *buf, pixelbuf_byteorder_details_t *byteord
 
     return mp_obj_new_tuple(byteorder->bpp, elems);
 }
+
+// Converts a color to the bytes of one pixel before brightness is applied.
+STATIC void pixelbuf_color_to_raw(pixelbuf_pixelbuf_obj_t *self, mp_obj_t color, uint8_t *raw) {
+    uint8_t scaled[4];
+    memset(raw, 0, 4);
+    pixelbuf_set_pixel(scaled, raw, PIXELBUF_FULL_BRIGHTNESS, color, &self->byteorder, self->byteorder.is_dotstar);
+}
+
+STATIC void pixelbuf_scale_raw(pixelbuf_pixelbuf_obj_t *self, const uint8_t *raw, uint8_t *scaled) {
+    for (size_t i = 0; i < self->pixel_step; i++) {
+        // Don't adjust per-pixel luminance bytes in dotstar mode
+        if (self->byteorder.is_dotstar && i == 0) {
+            scaled[i] = raw[i];
+        } else {
+            scaled[i] = PIXELBUF_SCALE(raw[i], self->brightness_scale);
+        }
+    }
+}
+
+void pixelbuf_fill_range(pixelbuf_pixelbuf_obj_t *self, size_t start, size_t stop, mp_obj_t color) {
+    uint8_t raw[4];
+    uint8_t scaled[4];
+    // Convert the color once and copy it into place.
+    pixelbuf_color_to_raw(self, color, raw);
+    pixelbuf_scale_raw(self, raw, scaled);
+    for (size_t offset = start * self->pixel_step; offset < stop * self->pixel_step; offset += self->pixel_step) {
+        memcpy(self->buf + offset, scaled, self->pixel_step);
+        if (self->two_buffers) {
+            memcpy(self->rawbuf + offset, raw, self->pixel_step);
+        }
+    }
+}
+
+void pixelbuf_gradient(pixelbuf_pixelbuf_obj_t *self, size_t start, size_t stop, mp_obj_t start_color, mp_obj_t stop_color) {
+    if (stop <= start) {
+        return;
+    }
+    uint8_t from[4];
+    uint8_t to[4];
+    pixelbuf_color_to_raw(self, start_color, from);
+    pixelbuf_color_to_raw(self, stop_color, to);
+    // Bytes are interpolated in buffer order. The top bits of dotstar
+    // luminance bytes are the same at both ends so they're left alone.
+    int32_t steps = stop - start - 1;
+    for (size_t i = start; i < stop; i++) {
+        int32_t t = i - start;
+        uint8_t raw[4];
+        uint8_t scaled[4];
+        for (size_t j = 0; j < self->pixel_step; j++) {
+            raw[j] = steps == 0 ? from[j] : from[j] + ((to[j] - from[j]) * t) / steps;
+        }
+        pixelbuf_scale_raw(self, raw, scaled);
+        memcpy(self->buf + i * self->pixel_step, scaled, self->pixel_step);
+        if (self->two_buffers) {
+            memcpy(self->rawbuf + i * self->pixel_step, raw, self->pixel_step);
+        }
+    }
+}
+
+STATIC void reverse_bytes(uint8_t *start, uint8_t *end) {
+    while (start < end) {
+        end--;
+        uint8_t b = *start;
+        *start = *end;
+        *end = b;
+        start++;
+    }
+}
+
+// Moves the first len - count bytes count bytes along and the rest to the start.
+STATIC void rotate_bytes(uint8_t *buf, size_t len, size_t count) {
+    reverse_bytes(buf, buf + len);
+    reverse_bytes(buf, buf + count);
+    reverse_bytes(buf + count, buf + len);
+}
+
+void pixelbuf_rotate(pixelbuf_pixelbuf_obj_t *self, mp_int_t count) {
+    if (self->pixels == 0) {
+        return;
+    }
+    count %= (mp_int_t) self->pixels;
+    if (count < 0) {
+        count += self->pixels;
+    }
+    size_t len = self->pixels * self->pixel_step;
+    rotate_bytes(self->buf, len, count * self->pixel_step);
+    if (self->two_buffers) {
+        rotate_bytes(self->rawbuf, len, count * self->pixel_step);
+    }
+}
@@ -28,6 +28,7 @@
 #include "py/obj.h"
 #include "py/objarray.h"
 #include "../../shared-bindings/_pixelbuf/types.h"
+#include "../../shared-bindings/_pixelbuf/PixelBuf.h"
 
 #ifndef PIXELBUF_SHARED_MODULE_H
 #define PIXELBUF_SHARED_MODULE_H
@@ -42,9 +43,17 @@
 #define DOTSTAR_GET_BRIGHTNESS(value) ((value & 0b00011111) / 31.0)
 #define DOTSTAR_LED_START_FULL_BRIGHT 0xFF
 
-void pixelbuf_set_pixel(uint8_t *buf, uint8_t *rawbuf, float brightness, mp_obj_t *item, pixelbuf_byteorder_details_t *byteorder, bool dotstar);
+// Brightness is applied as a fixed point scale where 256 is full brightness.
+#define PIXELBUF_FULL_BRIGHTNESS 256
+#define PIXELBUF_SCALE(value, scale) ((uint8_t) (((value) * (scale)) >> 8))
+
+uint16_t pixelbuf_brightness_scale(mp_float_t brightness);
+void pixelbuf_set_pixel(uint8_t *buf, uint8_t *rawbuf, uint16_t brightness, mp_obj_t *item, pixelbuf_byteorder_details_t *byteorder, bool dotstar);
 mp_obj_t *pixelbuf_get_pixel(uint8_t *buf, pixelbuf_byteorder_details_t *byteorder, bool dotstar);
 mp_obj_t *pixelbuf_get_pixel_array(uint8_t *buf, uint len, pixelbuf_byteorder_details_t *byteorder, uint8_t step, mp_int_t slice_step, bool dotstar);
 void pixelbuf_set_pixel_int(uint8_t *buf, mp_int_t value, pixelbuf_byteorder_details_t *byteorder);
+void pixelbuf_fill_range(pixelbuf_pixelbuf_obj_t *self, size_t start, size_t stop, mp_obj_t color);
+void pixelbuf_gradient(pixelbuf_pixelbuf_obj_t *self, size_t start, size_t stop, mp_obj_t start_color, mp_obj_t stop_color);
+void pixelbuf_rotate(pixelbuf_pixelbuf_obj_t *self, mp_int_t count);
 
 #endif
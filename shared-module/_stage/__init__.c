@@ -52,6 +52,12 @@ void render_stage(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
     display->core.send(display->core.bus, DISPLAY_COMMAND,
                       CHIP_SELECT_TOGGLE_EVERY_BYTE,
                       &display->write_ram_command, 1);
+    // Split the buffer in two so one half is rendered while the other is sent. Buses that send
+    // in the background finish a send before starting the next one so a half is free again once
+    // the other half has been sent.
+    size_t half_size = buffer_size >= 2 ? buffer_size / 2 : buffer_size;
+    uint16_t *half = buffer;
+    uint16_t *other_half = buffer + buffer_size - half_size;
     size_t index = 0;
     for (uint16_t y = y0; y < y1; ++y) {
         for (uint8_t yscale = 0; yscale < scale; ++yscale) {
@@ -69,13 +75,16 @@ void render_stage(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
                     }
                 }
                 for (uint8_t xscale = 0; xscale < scale; ++xscale) {
-                    buffer[index] = c;
+                    half[index] = c;
                     index += 1;
-                    // The buffer is full, send it.
-                    if (index >= buffer_size) {
+                    // The half is full, send it and switch to the other one.
+                    if (index >= half_size) {
                         display->core.send(display->core.bus, DISPLAY_DATA,
                                            CHIP_SELECT_UNTOUCHED,
-                                           ((uint8_t*)buffer), buffer_size * 2);
+                                           ((uint8_t*)half), half_size * 2);
+                        uint16_t *sent = half;
+                        half = other_half;
+                        other_half = sent;
                         index = 0;
                     }
                 }
@@ -86,7 +95,7 @@ void render_stage(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
     if (index) {
         display->core.send(display->core.bus, DISPLAY_DATA,
                            CHIP_SELECT_UNTOUCHED,
-                           ((uint8_t*)buffer), index * 2);
+                           ((uint8_t*)half), index * 2);
     }
 
     displayio_display_core_end_transaction(&display->core);
@@ -28,6 +28,7 @@
 
 #include <stdint.h>
 
+#include "py/misc.h"
 #include "shared-module/audiocore/RawSample.h"
 
 void common_hal_audioio_rawsample_construct(audioio_rawsample_obj_t* self,
@@ -44,10 +45,36 @@ void common_hal_audioio_rawsample_construct(audioio_rawsample_obj_t* self,
     self->channel_count = channel_count;
     self->sample_rate = sample_rate;
     self->buffer_read = false;
+    common_hal_audioio_rawsample_set_region(self, 0,
+        common_hal_audioio_rawsample_get_frame_count(self), 0, 0);
+}
+
+uint32_t common_hal_audioio_rawsample_get_frame_count(audioio_rawsample_obj_t* self) {
+    return self->len / (self->bits_per_sample / 8) / self->channel_count;
+}
+
+void common_hal_audioio_rawsample_set_region(audioio_rawsample_obj_t* self,
+                                             uint32_t start, uint32_t end,
+                                             uint32_t loop_start, uint32_t loop_end) {
+    self->start = start;
+    self->end = end;
+    self->loop_start = loop_start;
+    self->loop_end = loop_end;
+    audioio_rawsample_reset_buffer(self, false, 0);
+}
+
+void common_hal_audioio_rawsample_release(audioio_rawsample_obj_t* self) {
+    if (self->released) {
+        return;
+    }
+    // The channel that is ahead plays its tail next. The other catches up first.
+    self->release_pass = MAX(self->loop_passes[0], self->loop_passes[1]);
+    self->released = true;
 }
 
 void common_hal_audioio_rawsample_deinit(audioio_rawsample_obj_t* self) {
     self->buffer = NULL;
+    self->buffer_obj = MP_OBJ_NULL;
 }
 bool common_hal_audioio_rawsample_deinited(audioio_rawsample_obj_t* self) {
     return self->buffer == NULL;
@@ -70,6 +97,17 @@ uint8_t common_hal_audioio_rawsample_get_channel_count(audioio_rawsample_obj_t*
 void audioio_rawsample_reset_buffer(audioio_rawsample_obj_t* self,
                                     bool single_channel,
                                     uint8_t channel) {
+    if (single_channel) {
+        channel %= 2;
+        self->state[channel] = RAWSAMPLE_START;
+        self->loop_passes[channel] = 0;
+    } else {
+        self->state[0] = self->state[1] = RAWSAMPLE_START;
+        self->loop_passes[0] = self->loop_passes[1] = 0;
+    }
+    if (self->state[0] == RAWSAMPLE_START && self->state[1] == RAWSAMPLE_START) {
+        self->released = false;
+    }
 }
 
 audioio_get_buffer_result_t audioio_rawsample_get_buffer(audioio_rawsample_obj_t* self,
@@ -77,21 +115,53 @@ audioio_get_buffer_result_t audioio_rawsample_get_buffer(audioio_rawsample_obj_t
                                                          uint8_t channel,
                                                          uint8_t** buffer,
                                                          uint32_t* buffer_length) {
-    *buffer_length = self->len;
+    uint32_t frame_size = (self->bits_per_sample / 8) * self->channel_count;
+    uint8_t* frames = self->buffer;
     if (single_channel) {
-        *buffer = self->buffer + (channel % self->channel_count) * (self->bits_per_sample / 8);
-    } else {
-        *buffer = self->buffer;
+        frames += (channel % self->channel_count) * (self->bits_per_sample / 8);
+    }
+    // The buffer is handed out in place. Only the frames that play next are chosen.
+    uint32_t first = self->start;
+    uint32_t last = self->end;
+    audioio_get_buffer_result_t result = GET_BUFFER_DONE;
+    if (self->loop_end != 0) {
+        uint8_t c = single_channel ? channel % 2 : 0;
+        if (self->state[c] == RAWSAMPLE_START) {
+            if (!self->released) {
+                last = self->loop_end;
+                self->state[c] = RAWSAMPLE_LOOP;
+                result = GET_BUFFER_MORE_DATA;
+            }
+        } else if (self->released && self->loop_passes[c] >= self->release_pass &&
+                   self->loop_end < self->end) {
+            first = self->loop_end;
+        } else {
+            first = self->loop_start;
+            if (!self->released || self->loop_passes[c] < self->release_pass) {
+                last = self->loop_end;
+                self->loop_passes[c]++;
+                result = GET_BUFFER_MORE_DATA;
+            } else {
+                // Nothing follows the loop so finish with one more pass of it.
+                last = self->loop_end;
+            }
+        }
+        if (result == GET_BUFFER_DONE) {
+            self->state[c] = RAWSAMPLE_DONE;
+        }
     }
-    return GET_BUFFER_DONE;
+    *buffer = frames + first * frame_size;
+    *buffer_length = (last - first) * frame_size;
+    return result;
 }
 
 void audioio_rawsample_get_buffer_structure(audioio_rawsample_obj_t* self, bool single_channel,
                                             bool* single_buffer, bool* samples_signed,
                                             uint32_t* max_buffer_length, uint8_t* spacing) {
-    *single_buffer = true;
+    // A sustain loop hands out more than one part of the buffer so it needs double buffering.
+    *single_buffer = self->loop_end == 0;
     *samples_signed = self->samples_signed;
-    *max_buffer_length = self->len;
+    *max_buffer_length = (self->end - self->start) * (self->bits_per_sample / 8) * self->channel_count;
     if (single_channel) {
         *spacing = self->channel_count;
     } else {
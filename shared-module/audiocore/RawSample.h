@@ -31,8 +31,15 @@
 
 #include "shared-module/audiocore/__init__.h"
 
+typedef enum {
+    RAWSAMPLE_START,
+    RAWSAMPLE_LOOP,
+    RAWSAMPLE_DONE,
+} audioio_rawsample_state_t;
+
 typedef struct {
     mp_obj_base_t base;
+    mp_obj_t buffer_obj; // Keeps the buffer alive when it is a memoryview into another object.
     uint8_t* buffer;
     uint32_t len;
     uint8_t bits_per_sample;
@@ -40,6 +47,17 @@ typedef struct {
     uint8_t channel_count;
     uint32_t sample_rate;
     bool buffer_read;
+    // Frames of buffer that play. loop_end is 0 when there is no sustain loop. Otherwise the
+    // sample loops from loop_end back to loop_start until released and then plays to end.
+    uint32_t start;
+    uint32_t end;
+    uint32_t loop_start;
+    uint32_t loop_end;
+    bool released;
+    uint32_t release_pass; // Loop passes each channel plays before its tail once released.
+    // Per channel so two single channel players step through the sample together.
+    audioio_rawsample_state_t state[2];
+    uint32_t loop_passes[2];
 } audioio_rawsample_obj_t;
 
 
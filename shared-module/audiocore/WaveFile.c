@@ -30,6 +30,7 @@
 #include <string.h>
 
 #include "py/mperrno.h"
+#include "py/mpstate.h"
 #include "py/runtime.h"
 
 #include "shared-module/audiocore/WaveFile.h"
@@ -45,10 +46,82 @@ struct wave_format_chunk {
     uint16_t extra_params; // Assumed to be zero below.
 };
 
+STATIC void register_read_ahead(audioio_wavefile_obj_t* self) {
+    mp_obj_t* slots = MP_STATE_VM(wavefile_read_ahead);
+    size_t free_slot = AUDIOCORE_READ_AHEAD_COUNT;
+    for (size_t i = 0; i < AUDIOCORE_READ_AHEAD_COUNT; i++) {
+        if (slots[i] == self) {
+            return;
+        }
+        if (slots[i] == NULL && free_slot == AUDIOCORE_READ_AHEAD_COUNT) {
+            free_slot = i;
+        }
+    }
+    if (free_slot == AUDIOCORE_READ_AHEAD_COUNT) {
+        // Take over from the one registered first. It still works but reads blocks as they are
+        // needed.
+        for (size_t i = 1; i < AUDIOCORE_READ_AHEAD_COUNT; i++) {
+            slots[i - 1] = slots[i];
+        }
+        free_slot = AUDIOCORE_READ_AHEAD_COUNT - 1;
+    }
+    slots[free_slot] = self;
+}
+
+STATIC void unregister_read_ahead(audioio_wavefile_obj_t* self) {
+    mp_obj_t* slots = MP_STATE_VM(wavefile_read_ahead);
+    for (size_t i = 0; i < AUDIOCORE_READ_AHEAD_COUNT; i++) {
+        if (slots[i] == self) {
+            slots[i] = NULL;
+        }
+    }
+}
+
+// Loads the block after the ready ones. Returns false when there is nothing left to load or the
+// read fails.
+STATIC bool load_block(audioio_wavefile_obj_t* self) {
+    if (self->read_ahead_remaining == 0) {
+        return false;
+    }
+    uint32_t length = self->len;
+    if (length > self->read_ahead_remaining) {
+        length = self->read_ahead_remaining;
+    }
+    uint16_t block = (self->next_block + self->ready_blocks) % self->ring_blocks;
+    UINT length_read;
+    if (f_read(&self->file->fp, self->ring + block * self->len, length, &length_read) != FR_OK ||
+        length_read != length) {
+        // Stop loading. get_buffer reports the error once the loaded blocks run out.
+        self->read_ahead_remaining = 0;
+        return false;
+    }
+    self->read_ahead_remaining -= length;
+    self->ready_blocks += 1;
+    return true;
+}
+
+void audioio_wavefile_background(void) {
+    for (size_t i = 0; i < AUDIOCORE_READ_AHEAD_COUNT; i++) {
+        audioio_wavefile_obj_t* self = MP_STATE_VM(wavefile_read_ahead)[i];
+        // The output holds on to the last two blocks handed out. Load one block at a time to keep
+        // each background pass short.
+        if (self != NULL && self->ready_blocks + 2 < self->ring_blocks) {
+            load_block(self);
+        }
+    }
+}
+
+void audioio_wavefile_reset(void) {
+    for (size_t i = 0; i < AUDIOCORE_READ_AHEAD_COUNT; i++) {
+        MP_STATE_VM(wavefile_read_ahead)[i] = NULL;
+    }
+}
+
 void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t* self,
                                            pyb_file_obj_t* file,
                                            uint8_t *buffer,
-                                           size_t buffer_size) {
+                                           size_t buffer_size,
+                                           size_t read_ahead) {
     // Load the wave
     self->file = file;
     uint8_t chunk_header[16];
@@ -110,9 +183,37 @@ void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t* self,
     self->file_length = data_length;
     self->data_start = self->file->fp.fptr;
 
-    // Try to allocate two buffers, one will be loaded from file and the other
-    // DMAed to DAC.
-    if (buffer_size) {
+    self->ring = NULL;
+    if (read_ahead > 0) {
+        // The ring replaces the two buffers. Blocks are word aligned for the output.
+        self->len = 256;
+        if (buffer_size) {
+            self->len = (buffer_size / 2) & ~3;
+        }
+        if (self->len == 0) {
+            mp_raise_ValueError(translate("Invalid argument"));
+        }
+        // Two blocks are held by the output at a time so the read ahead comes on top of them.
+        uint32_t ahead = read_ahead / self->len;
+        if (ahead == 0) {
+            ahead = 1;
+        } else if (ahead > 0xffff - 2) {
+            ahead = 0xffff - 2;
+        }
+        self->ring_blocks = 2 + ahead;
+        self->ring = m_malloc(self->ring_blocks * self->len, false);
+        if (self->ring == NULL) {
+            mp_raise_msg(&mp_type_MemoryError,
+                         translate("Couldn't allocate input buffer"));
+        }
+        self->buffer = self->ring;
+        self->second_buffer = self->ring + self->len;
+        self->next_block = 0;
+        self->ready_blocks = 0;
+        self->read_ahead_remaining = 0;
+    } else if (buffer_size) {
+        // Try to allocate two buffers, one will be loaded from file and the other
+        // DMAed to DAC.
         self->len = buffer_size / 2;
         self->buffer = buffer;
         self->second_buffer = buffer + self->len;
@@ -135,6 +236,10 @@ void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t* self,
 }
 
 void common_hal_audioio_wavefile_deinit(audioio_wavefile_obj_t* self) {
+    if (self->ring != NULL) {
+        unregister_read_ahead(self);
+        self->ring = NULL;
+    }
     self->buffer = NULL;
     self->second_buffer = NULL;
 }
@@ -181,6 +286,12 @@ void audioio_wavefile_reset_buffer(audioio_wavefile_obj_t* self,
     self->read_count = 0;
     self->left_read_count = 0;
     self->right_read_count = 0;
+    if (self->ring != NULL) {
+        // The blocks in use by the output stay put. Loading restarts after them.
+        self->ready_blocks = 0;
+        self->read_ahead_remaining = self->file_length;
+        register_read_ahead(self);
+    }
 }
 
 audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t* self,
@@ -211,13 +322,30 @@ audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t*
             num_bytes_to_load = self->bytes_remaining;
         }
         UINT length_read;
-        if (self->buffer_index % 2 == 1) {
-            *buffer = self->second_buffer;
+        if (self->ring != NULL) {
+            // Read it now if loading ahead fell behind.
+            if (self->ready_blocks == 0 && !load_block(self)) {
+                return GET_BUFFER_ERROR;
+            }
+            *buffer = self->ring + self->next_block * self->len;
+            length_read = num_bytes_to_load;
+            self->next_block = (self->next_block + 1) % self->ring_blocks;
+            self->ready_blocks -= 1;
+            // Point the buffer the code below alternates between at the block.
+            if (self->buffer_index % 2 == 1) {
+                self->second_buffer = *buffer;
+            } else {
+                self->buffer = *buffer;
+            }
         } else {
-            *buffer = self->buffer;
-        }
-        if (f_read(&self->file->fp, *buffer, num_bytes_to_load, &length_read) != FR_OK || length_read != num_bytes_to_load) {
-            return GET_BUFFER_ERROR;
+            if (self->buffer_index % 2 == 1) {
+                *buffer = self->second_buffer;
+            } else {
+                *buffer = self->buffer;
+            }
+            if (f_read(&self->file->fp, *buffer, num_bytes_to_load, &length_read) != FR_OK || length_read != num_bytes_to_load) {
+                return GET_BUFFER_ERROR;
+            }
         }
         self->bytes_remaining -= length_read;
         // Pad the last buffer to word align it.
@@ -53,8 +53,21 @@ typedef struct {
     uint32_t read_count;
     uint32_t left_read_count;
     uint32_t right_read_count;
+
+    // Ring of ring_blocks buffers of len bytes that is loaded ahead of playback. NULL when each
+    // buffer is read as it is needed.
+    uint8_t* ring;
+    uint16_t ring_blocks;
+    uint16_t next_block; // Next block to hand out.
+    uint16_t ready_blocks; // Blocks loaded after next_block, including it.
+    uint32_t read_ahead_remaining; // Bytes of data not yet loaded into the ring.
 } audioio_wavefile_obj_t;
 
+// Loads read ahead blocks for playing WaveFiles. Call it from background tasks.
+void audioio_wavefile_background(void);
+// Forgets all read ahead WaveFiles. Call it before the heap goes away.
+void audioio_wavefile_reset(void);
+
 // These are not available from Python because it may be called in an interrupt.
 void audioio_wavefile_reset_buffer(audioio_wavefile_obj_t* self,
                                    bool single_channel,
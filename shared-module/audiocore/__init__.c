@@ -35,6 +35,8 @@
 #include "shared-bindings/audiomixer/Mixer.h"
 #include "shared-module/audiomixer/Mixer.h"
 
+#include "tick.h"
+
 uint32_t audiosample_sample_rate(mp_obj_t sample_obj) {
     const audiosample_p_t *proto = mp_proto_get_or_throw(MP_QSTR_protocol_audiosample, sample_obj);
     return proto->sample_rate(MP_OBJ_TO_PTR(sample_obj));
@@ -70,3 +72,65 @@ void audiosample_get_buffer_structure(mp_obj_t sample_obj, bool single_channel,
     proto->get_buffer_structure(MP_OBJ_TO_PTR(sample_obj), single_channel, single_buffer,
         samples_signed, max_buffer_length, spacing);
 }
+
+uint32_t audiosample_ticks_us(void) {
+    uint64_t ms;
+    uint32_t us_until_ms;
+    current_tick(&ms, &us_until_ms);
+    return ms * 1000 + (1000 - us_until_ms);
+}
+
+uint32_t audiosample_duration_us(uint32_t frame_count, uint32_t sample_rate) {
+    if (sample_rate == 0) {
+        return 0;
+    }
+    return (uint64_t) frame_count * 1000000 / sample_rate;
+}
+
+void audioio_playback_timing_start(audioio_playback_timing_t* timing, uint32_t playing_us,
+                                   uint32_t queued_us) {
+    uint32_t now = audiosample_ticks_us();
+    timing->stats = (audioio_playback_stats_t) { 0 };
+    timing->playing_since_us = now;
+    timing->playing_end_us = now + playing_us;
+    timing->queued_us = queued_us;
+}
+
+void audioio_playback_timing_idle(audioio_playback_timing_t* timing) {
+    timing->playing_since_us = audiosample_ticks_us();
+}
+
+void audioio_playback_timing_refill(audioio_playback_timing_t* timing, uint32_t refill_us) {
+    uint32_t now = audiosample_ticks_us();
+    // The playing buffer ended sometime after it was last seen playing and before now. Assume it
+    // ended on time unless that falls outside what was seen.
+    uint32_t ended = timing->playing_end_us;
+    if ((int32_t) (ended - timing->playing_since_us) < 0) {
+        ended = timing->playing_since_us;
+    }
+    if ((int32_t) (ended - now) > 0) {
+        ended = now;
+    }
+    uint32_t playing_us = timing->queued_us;
+    int32_t margin = ended + playing_us - now;
+
+    audioio_playback_stats_t* stats = &timing->stats;
+    stats->refills++;
+    if (margin < 0) {
+        stats->underruns++;
+    } else if ((uint32_t) margin < playing_us / 4) {
+        stats->late_refills++;
+    }
+    stats->last_margin_us = margin;
+    if (stats->refills == 1 || margin < stats->min_margin_us) {
+        stats->min_margin_us = margin;
+    }
+
+    timing->playing_since_us = now;
+    timing->playing_end_us = ended + playing_us;
+    if (margin < 0) {
+        // The DMA has looped back into stale audio so the new buffer starts after it.
+        timing->playing_end_us = now + playing_us;
+    }
+    timing->queued_us = refill_us;
+}
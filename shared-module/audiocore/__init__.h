@@ -62,6 +62,25 @@ typedef struct _audiosample_p_t {
     audiosample_get_buffer_structure_fun get_buffer_structure;
 } audiosample_p_t;
 
+// How well background refills keep up with playback. A margin is how much queued audio was left
+// when a buffer was refilled, in microseconds. Negative margins are underruns.
+typedef struct {
+    uint32_t refills;
+    uint32_t late_refills; // Refills with less than a quarter of the playing buffer to spare.
+    uint32_t underruns; // Refills after the queued audio ran out. Old audio was replayed instead.
+    int32_t last_margin_us;
+    int32_t min_margin_us;
+} audioio_playback_stats_t;
+
+// Estimates when the playing buffer ends from the times it was polled and refilled. Times are
+// microseconds that wrap around.
+typedef struct {
+    audioio_playback_stats_t stats;
+    uint32_t playing_since_us; // Last time the playing buffer was seen still playing.
+    uint32_t playing_end_us; // Expected end of the playing buffer.
+    uint32_t queued_us; // Duration of the buffer queued after it.
+} audioio_playback_timing_t;
+
 uint32_t audiosample_sample_rate(mp_obj_t sample_obj);
 uint8_t audiosample_bits_per_sample(mp_obj_t sample_obj);
 uint8_t audiosample_channel_count(mp_obj_t sample_obj);
@@ -74,4 +93,17 @@ void audiosample_get_buffer_structure(mp_obj_t sample_obj, bool single_channel,
                                       bool* single_buffer, bool* samples_signed,
                                       uint32_t* max_buffer_length, uint8_t* spacing);
 
+// Microseconds that wrap around every ~71 minutes. Only use it for short durations.
+uint32_t audiosample_ticks_us(void);
+// Duration of frame_count frames in microseconds.
+uint32_t audiosample_duration_us(uint32_t frame_count, uint32_t sample_rate);
+
+// Call when playback starts with the first buffer playing and the second one queued behind it.
+void audioio_playback_timing_start(audioio_playback_timing_t* timing, uint32_t playing_us,
+                                   uint32_t queued_us);
+// Call when a poll finds the playing buffer hasn't finished.
+void audioio_playback_timing_idle(audioio_playback_timing_t* timing);
+// Call when a buffer of refill_us has been queued because the previous one finished.
+void audioio_playback_timing_refill(audioio_playback_timing_t* timing, uint32_t refill_us);
+
 #endif  // MICROPY_INCLUDED_SHARED_MODULE_AUDIOCORE__INIT__H
@@ -0,0 +1,164 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-module/audiocore/playback.h"
+
+#include "py/runtime.h"
+
+void audioio_playback_init(audioio_playback_t* playback) {
+    playback->sample = MP_OBJ_NULL;
+    playback->first_buffer = NULL;
+    playback->second_buffer = NULL;
+    playback->timing.stats = (audioio_playback_stats_t) { 0 };
+}
+
+bool audioio_playback_setup(audioio_playback_t* playback, mp_obj_t sample, bool loop,
+                            bool single_channel, uint8_t audio_channel, bool output_signed) {
+    playback->sample = sample;
+    playback->loop = loop;
+    playback->single_channel = single_channel;
+    playback->audio_channel = audio_channel;
+    playback->signed_to_unsigned = false;
+    playback->unsigned_to_signed = false;
+    playback->first_buffer = NULL;
+    playback->second_buffer = NULL;
+    playback->first_buffer_free = true;
+    playback->spacing = 1;
+    playback->sample_rate = audiosample_sample_rate(sample);
+    playback->bytes_per_sample = audiosample_bits_per_sample(sample) / 8;
+    playback->frame_size = playback->bytes_per_sample;
+    if (!single_channel) {
+        playback->frame_size *= audiosample_channel_count(sample);
+    }
+    audiosample_reset_buffer(sample, single_channel, audio_channel);
+
+    bool samples_signed;
+    uint32_t max_buffer_length;
+    audiosample_get_buffer_structure(sample, single_channel, &playback->single_buffer,
+                                     &samples_signed, &max_buffer_length, &playback->spacing);
+    if (output_signed != samples_signed) {
+        max_buffer_length /= playback->spacing;
+        playback->first_buffer = (uint8_t*) m_malloc_maybe(max_buffer_length, false);
+        if (playback->first_buffer == NULL) {
+            return false;
+        }
+        if (!playback->single_buffer) {
+            playback->second_buffer = (uint8_t*) m_malloc_maybe(max_buffer_length, false);
+            if (playback->second_buffer == NULL) {
+                return false;
+            }
+        }
+        playback->signed_to_unsigned = !output_signed && samples_signed;
+        playback->unsigned_to_signed = output_signed && !samples_signed;
+    }
+    return true;
+}
+
+STATIC void convert_signed(audioio_playback_t* playback, uint8_t* buffer, uint32_t buffer_length,
+                           uint8_t** output_buffer, uint32_t* output_buffer_length,
+                           uint8_t* output_spacing) {
+    if (playback->first_buffer_free) {
+        *output_buffer = playback->first_buffer;
+    } else {
+        *output_buffer = playback->second_buffer;
+    }
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wcast-align"
+    if (playback->signed_to_unsigned || playback->unsigned_to_signed) {
+        *output_buffer_length = buffer_length / playback->spacing;
+        *output_spacing = 1;
+        uint32_t out_i = 0;
+        if (playback->bytes_per_sample == 1) {
+            for (uint32_t i = 0; i < buffer_length; i += playback->spacing) {
+                if (playback->signed_to_unsigned) {
+                    ((uint8_t*) *output_buffer)[out_i] = ((int8_t*) buffer)[i] + 0x80;
+                } else {
+                    ((int8_t*) *output_buffer)[out_i] = ((uint8_t*) buffer)[i] - 0x80;
+                }
+                out_i += 1;
+            }
+        } else if (playback->bytes_per_sample == 2) {
+            for (uint32_t i = 0; i < buffer_length / 2; i += playback->spacing) {
+                if (playback->signed_to_unsigned) {
+                    ((uint16_t*) *output_buffer)[out_i] = ((int16_t*) buffer)[i] + 0x8000;
+                } else {
+                    ((int16_t*) *output_buffer)[out_i] = ((uint16_t*) buffer)[i] - 0x8000;
+                }
+                out_i += 1;
+            }
+        }
+    } else {
+        *output_buffer = buffer;
+        *output_buffer_length = buffer_length;
+        *output_spacing = playback->spacing;
+    }
+    #pragma GCC diagnostic pop
+    playback->first_buffer_free = !playback->first_buffer_free;
+}
+
+audioio_get_buffer_result_t audioio_playback_load_block(audioio_playback_t* playback,
+                                                        uint8_t** buffer, uint32_t* buffer_length,
+                                                        uint8_t* spacing) {
+    uint8_t* sample_buffer;
+    uint32_t sample_buffer_length;
+    audioio_get_buffer_result_t result =
+        audiosample_get_buffer(playback->sample, playback->single_channel,
+                               playback->audio_channel, &sample_buffer, &sample_buffer_length);
+    if (result == GET_BUFFER_ERROR) {
+        return result;
+    }
+    convert_signed(playback, sample_buffer, sample_buffer_length, buffer, buffer_length, spacing);
+    playback->last_block_us = audiosample_duration_us(
+        audioio_playback_block_frames(playback, *buffer_length, *spacing), playback->sample_rate);
+    if (result == GET_BUFFER_DONE && playback->loop) {
+        audiosample_reset_buffer(playback->sample, playback->single_channel,
+                                 playback->audio_channel);
+        result = GET_BUFFER_MORE_DATA;
+    }
+    return result;
+}
+
+uint32_t audioio_playback_block_frames(audioio_playback_t* playback, uint32_t buffer_length,
+                                       uint8_t spacing) {
+    return buffer_length / playback->frame_size / spacing;
+}
+
+void audioio_playback_started(audioio_playback_t* playback, uint32_t first_block_us,
+                              uint32_t second_block_us) {
+    audioio_playback_timing_start(&playback->timing, first_block_us, second_block_us);
+}
+
+void audioio_playback_idle(audioio_playback_t* playback) {
+    audioio_playback_timing_idle(&playback->timing);
+}
+
+void audioio_playback_refilled(audioio_playback_t* playback) {
+    audioio_playback_timing_refill(&playback->timing, playback->last_block_us);
+}
+
+const audioio_playback_stats_t* audioio_playback_get_stats(audioio_playback_t* playback) {
+    return &playback->timing.stats;
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_AUDIOCORE_PLAYBACK_H
+#define MICROPY_INCLUDED_SHARED_MODULE_AUDIOCORE_PLAYBACK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "py/obj.h"
+
+#include "shared-module/audiocore/__init__.h"
+
+// Port neutral part of playing an audiosample with DMA. It pulls blocks from the sample, loops,
+// converts signedness and keeps the timing stats. Ports only queue the blocks it returns and
+// tell it when one finishes.
+typedef struct {
+    mp_obj_t sample;
+    uint8_t audio_channel;
+    uint8_t bytes_per_sample;
+    uint8_t frame_size; // Bytes per frame of the blocks handed to the sample's player.
+    uint8_t spacing; // Sample spacing of the blocks from the sample.
+    bool loop;
+    bool single_channel;
+    bool single_buffer;
+    bool signed_to_unsigned;
+    bool unsigned_to_signed;
+    bool first_buffer_free;
+    uint8_t* first_buffer; // Conversion buffers. NULL when the sample's blocks are used as is.
+    uint8_t* second_buffer;
+    uint32_t sample_rate;
+    uint32_t last_block_us; // Duration of the block loaded last.
+    audioio_playback_timing_t timing;
+} audioio_playback_t;
+
+void audioio_playback_init(audioio_playback_t* playback);
+
+// Resets the sample and allocates what converting it needs. Returns false when out of memory.
+// single_channel is true to only play audio_channel. output_signed is the sample format the
+// hardware takes.
+bool audioio_playback_setup(audioio_playback_t* playback, mp_obj_t sample, bool loop,
+                            bool single_channel, uint8_t audio_channel, bool output_signed);
+
+// Loads the next block to queue into buffer. spacing is the distance between consecutive
+// samples in it. Returns GET_BUFFER_DONE when it is the last block and GET_BUFFER_ERROR when
+// playback should stop right away.
+audioio_get_buffer_result_t audioio_playback_load_block(audioio_playback_t* playback,
+                                                        uint8_t** buffer, uint32_t* buffer_length,
+                                                        uint8_t* spacing);
+
+// Frames in a block returned by audioio_playback_load_block.
+uint32_t audioio_playback_block_frames(audioio_playback_t* playback, uint32_t buffer_length,
+                                       uint8_t spacing);
+
+// Call when playback starts with the first blocks loaded. second_block_us is 0 for single
+// buffer samples.
+void audioio_playback_started(audioio_playback_t* playback, uint32_t first_block_us,
+                              uint32_t second_block_us);
+// Call when a poll finds no block finished and when a finished block has been replaced by the
+// one loaded last.
+void audioio_playback_idle(audioio_playback_t* playback);
+void audioio_playback_refilled(audioio_playback_t* playback);
+
+const audioio_playback_stats_t* audioio_playback_get_stats(audioio_playback_t* playback);
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_AUDIOCORE_PLAYBACK_H
@@ -0,0 +1,398 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/audioeffects/Effect.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "py/runtime.h"
+#include "shared-module/audiocore/__init__.h"
+
+void common_hal_audioeffects_effect_construct(audioeffects_effect_obj_t* self,
+                                              mp_obj_t source,
+                                              uint32_t buffer_size,
+                                              mp_float_t max_delay) {
+    bool single_buffer;
+    uint32_t max_buffer_length;
+    uint8_t spacing;
+    audiosample_get_buffer_structure(source, false, &single_buffer, &self->source_signed,
+                                     &max_buffer_length, &spacing);
+    self->source_bits_per_sample = audiosample_bits_per_sample(source);
+    if (self->source_bits_per_sample != 8 && self->source_bits_per_sample != 16) {
+        mp_raise_ValueError(translate("bits_per_sample must be 8 or 16"));
+    }
+    self->channel_count = audiosample_channel_count(source);
+    if (self->channel_count < 1 || self->channel_count > 2) {
+        mp_raise_ValueError(translate("Too many channels in sample."));
+    }
+    self->sample_rate = audiosample_sample_rate(source);
+    self->source = source;
+
+    // Whole frames of 16 bit samples in each half.
+    uint8_t frame_size = self->channel_count * sizeof(int16_t);
+    self->len = buffer_size / 2 / sizeof(uint32_t) * sizeof(uint32_t) / frame_size * frame_size;
+    if (self->len == 0) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+
+    self->first_buffer = m_malloc(self->len, false);
+    if (self->first_buffer == NULL) {
+        common_hal_audioeffects_effect_deinit(self);
+        mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate first buffer"));
+    }
+
+    self->second_buffer = m_malloc(self->len, false);
+    if (self->second_buffer == NULL) {
+        common_hal_audioeffects_effect_deinit(self);
+        mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate second buffer"));
+    }
+
+    self->max_delay_length = (uint32_t) (max_delay * self->sample_rate) * self->channel_count;
+    self->delay_line = NULL;
+    if (self->max_delay_length > 0) {
+        self->delay_line = m_new(int16_t, self->max_delay_length);
+    }
+    self->delay_length = 0;
+    self->delay_index = 0;
+    self->feedback = 0;
+
+    self->filter_enabled = false;
+    self->gain = 1 << 12;
+    self->current_gain = self->gain;
+    self->soft_clip = false;
+}
+
+void common_hal_audioeffects_effect_deinit(audioeffects_effect_obj_t* self) {
+    self->first_buffer = NULL;
+    self->second_buffer = NULL;
+    self->delay_line = NULL;
+    self->source = MP_OBJ_NULL;
+}
+
+bool common_hal_audioeffects_effect_deinited(audioeffects_effect_obj_t* self) {
+    return self->first_buffer == NULL;
+}
+
+uint32_t common_hal_audioeffects_effect_get_sample_rate(audioeffects_effect_obj_t* self) {
+    return self->sample_rate;
+}
+
+uint8_t common_hal_audioeffects_effect_get_channel_count(audioeffects_effect_obj_t* self) {
+    return self->channel_count;
+}
+
+uint8_t common_hal_audioeffects_effect_get_bits_per_sample(audioeffects_effect_obj_t* self) {
+    return 16;
+}
+
+// Coefficients are from Robert Bristow-Johnson's Audio EQ Cookbook.
+void common_hal_audioeffects_effect_set_filter(audioeffects_effect_obj_t* self,
+                                               audioeffects_filter_t filter,
+                                               mp_float_t frequency, mp_float_t q,
+                                               mp_float_t gain_db) {
+    if (filter == AUDIOEFFECTS_FILTER_NONE) {
+        self->filter_enabled = false;
+        return;
+    }
+    mp_float_t w0 = 2 * MICROPY_FLOAT_CONST(3.14159265358979) * frequency / self->sample_rate;
+    mp_float_t cos_w0 = MICROPY_FLOAT_C_FUN(cos)(w0);
+    mp_float_t alpha = MICROPY_FLOAT_C_FUN(sin)(w0) / (2 * q);
+    mp_float_t b0, b1, b2;
+    mp_float_t a0 = 1 + alpha;
+    mp_float_t a1 = -2 * cos_w0;
+    mp_float_t a2 = 1 - alpha;
+    if (filter == AUDIOEFFECTS_FILTER_LOWPASS) {
+        b1 = 1 - cos_w0;
+        b0 = b1 / 2;
+        b2 = b0;
+    } else if (filter == AUDIOEFFECTS_FILTER_HIGHPASS) {
+        b1 = -(1 + cos_w0);
+        b0 = -b1 / 2;
+        b2 = b0;
+    } else {
+        mp_float_t a = MICROPY_FLOAT_C_FUN(pow)(10, gain_db / 40);
+        b0 = 1 + alpha * a;
+        b1 = a1;
+        b2 = 1 - alpha * a;
+        a0 = 1 + alpha / a;
+        a2 = 1 - alpha / a;
+    }
+    mp_float_t scale = (1 << 24) / a0;
+    self->filter.b0 = b0 * scale;
+    self->filter.b1 = b1 * scale;
+    self->filter.b2 = b2 * scale;
+    self->filter.a1 = a1 * scale;
+    self->filter.a2 = a2 * scale;
+    if (!self->filter_enabled) {
+        memset(self->filter_state, 0, sizeof(self->filter_state));
+    }
+    self->filter_enabled = true;
+}
+
+mp_float_t common_hal_audioeffects_effect_get_gain(audioeffects_effect_obj_t* self) {
+    return (mp_float_t) self->gain / (1 << 12);
+}
+
+void common_hal_audioeffects_effect_set_gain(audioeffects_effect_obj_t* self, mp_float_t gain) {
+    self->gain = gain * (1 << 12);
+}
+
+mp_float_t common_hal_audioeffects_effect_get_max_delay(audioeffects_effect_obj_t* self) {
+    return (mp_float_t) (self->max_delay_length / self->channel_count) / self->sample_rate;
+}
+
+mp_float_t common_hal_audioeffects_effect_get_delay(audioeffects_effect_obj_t* self) {
+    return (mp_float_t) (self->delay_length / self->channel_count) / self->sample_rate;
+}
+
+void common_hal_audioeffects_effect_set_delay(audioeffects_effect_obj_t* self, mp_float_t delay) {
+    uint32_t delay_length = (uint32_t) (delay * self->sample_rate) * self->channel_count;
+    if (delay_length > self->max_delay_length) {
+        delay_length = self->max_delay_length;
+    }
+    if (delay_length != self->delay_length) {
+        // Start from silence rather than echo audio from an older delay.
+        memset(self->delay_line, 0, delay_length * sizeof(int16_t));
+        self->delay_index = 0;
+        self->delay_length = delay_length;
+    }
+}
+
+mp_float_t common_hal_audioeffects_effect_get_feedback(audioeffects_effect_obj_t* self) {
+    return (mp_float_t) self->feedback / (1 << 15);
+}
+
+void common_hal_audioeffects_effect_set_feedback(audioeffects_effect_obj_t* self, mp_float_t feedback) {
+    int32_t value = feedback * (1 << 15);
+    if (value > INT16_MAX) {
+        value = INT16_MAX;
+    }
+    self->feedback = value;
+}
+
+bool common_hal_audioeffects_effect_get_soft_clip(audioeffects_effect_obj_t* self) {
+    return self->soft_clip;
+}
+
+void common_hal_audioeffects_effect_set_soft_clip(audioeffects_effect_obj_t* self, bool soft_clip) {
+    self->soft_clip = soft_clip;
+}
+
+bool common_hal_audioeffects_effect_get_playing(audioeffects_effect_obj_t* self) {
+    return self->source_more_data || self->source_length > 0;
+}
+
+void audioeffects_effect_reset_buffer(audioeffects_effect_obj_t* self,
+                                      bool single_channel,
+                                      uint8_t channel) {
+    if (single_channel && channel == 1) {
+        return;
+    }
+    // The filter and delay line keep their state so a looping source stays smooth.
+    audiosample_reset_buffer(self->source, false, 0);
+    self->source_more_data = true;
+    self->source_length = 0;
+    self->read_count = 0;
+    self->left_read_count = 0;
+    self->right_read_count = 0;
+}
+
+static inline int32_t saturate16(int32_t value) {
+    #if (defined (__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1)) //Cortex-M4 w/FPU
+    return __SSAT(value, 16);
+    #else
+    if (value > INT16_MAX) {
+        return INT16_MAX;
+    } else if (value < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return value;
+    #endif
+}
+
+// Rounds off peaks with x * (27 + x^2) / (27 + 9 * x^2), which follows tanh(x) up to 3.0.
+STATIC int16_t soft_clip(int32_t value) {
+    const int32_t limit = 3 << 15;
+    if (value > limit) {
+        return INT16_MAX;
+    } else if (value < -limit) {
+        return INT16_MIN;
+    }
+    int32_t squared = (value * value) >> 15;
+    int64_t numerator = (int64_t) value * ((27 << 15) + squared);
+    int32_t denominator = (27 << 15) + 9 * squared;
+    return saturate16(numerator / denominator);
+}
+
+// Reads the next frame of the source as signed 16 bit samples. Returns false when it has run out.
+STATIC bool read_frame(audioeffects_effect_obj_t* self, int16_t* frame) {
+    if (self->source_length == 0) {
+        if (!self->source_more_data) {
+            return false;
+        }
+        audioio_get_buffer_result_t result = audiosample_get_buffer(self->source, false, 0,
+            &self->source_data, &self->source_length);
+        self->source_more_data = result == GET_BUFFER_MORE_DATA;
+        if (result == GET_BUFFER_ERROR || self->source_length == 0) {
+            self->source_more_data = false;
+            self->source_length = 0;
+            return false;
+        }
+    }
+    uint8_t* data = self->source_data;
+    for (uint8_t c = 0; c < self->channel_count; c++) {
+        if (self->source_bits_per_sample == 8) {
+            uint8_t raw = data[c];
+            frame[c] = (self->source_signed ? raw : raw ^ 0x80) << 8;
+        } else {
+            uint16_t raw = data[2 * c] | (data[2 * c + 1] << 8);
+            frame[c] = self->source_signed ? raw : raw ^ 0x8000;
+        }
+    }
+    uint8_t frame_size = self->channel_count * self->source_bits_per_sample / 8;
+    if (self->source_length < frame_size) {
+        self->source_length = 0;
+    } else {
+        self->source_length -= frame_size;
+    }
+    self->source_data = data + frame_size;
+    return true;
+}
+
+STATIC int32_t filter_sample(audioeffects_effect_obj_t* self, uint8_t channel, int32_t x) {
+    int32_t* state = self->filter_state[channel];
+    audioeffects_biquad_t* f = &self->filter;
+    int64_t sum = (int64_t) f->b0 * x + (int64_t) f->b1 * state[0] + (int64_t) f->b2 * state[1] -
+                  (int64_t) f->a1 * state[2] - (int64_t) f->a2 * state[3];
+    int32_t y = saturate16(sum >> 24);
+    state[1] = state[0];
+    state[0] = x;
+    state[3] = state[2];
+    state[2] = y;
+    return y;
+}
+
+// Fills the buffer with processed frames. Returns false when the source ran out before it was full.
+STATIC bool process(audioeffects_effect_obj_t* self, int16_t* buffer) {
+    uint32_t frame_count = self->len / sizeof(int16_t) / self->channel_count;
+    int32_t start_gain = self->current_gain;
+    int32_t gain_change = (int32_t) self->gain - start_gain;
+    bool more = true;
+    for (uint32_t i = 0; i < frame_count; i++) {
+        int16_t frame[2] = {0, 0};
+        if (more) {
+            more = read_frame(self, frame);
+        }
+        // Ramp to the new gain over the buffer so changes don't click.
+        int32_t gain = start_gain;
+        if (gain_change != 0) {
+            gain += gain_change * (int32_t) (i + 1) / (int32_t) frame_count;
+        }
+        for (uint8_t c = 0; c < self->channel_count; c++) {
+            int32_t value = frame[c];
+            if (self->filter_enabled) {
+                value = filter_sample(self, c, value);
+            }
+            value = (value * gain) >> 12;
+            if (self->delay_length > 0) {
+                int16_t* delayed = &self->delay_line[self->delay_index];
+                value += (*delayed * self->feedback) >> 15;
+                *delayed = saturate16(value);
+                self->delay_index++;
+                if (self->delay_index == self->delay_length) {
+                    self->delay_index = 0;
+                }
+            }
+            if (self->soft_clip) {
+                buffer[i * self->channel_count + c] = soft_clip(value);
+            } else {
+                buffer[i * self->channel_count + c] = saturate16(value);
+            }
+        }
+    }
+    self->current_gain = self->gain;
+    return more;
+}
+
+audioio_get_buffer_result_t audioeffects_effect_get_buffer(audioeffects_effect_obj_t* self,
+                                                           bool single_channel,
+                                                           uint8_t channel,
+                                                           uint8_t** buffer,
+                                                           uint32_t* buffer_length) {
+    if (!single_channel) {
+        channel = 0;
+    }
+
+    uint32_t channel_read_count = self->left_read_count;
+    if (channel == 1) {
+        channel_read_count = self->right_read_count;
+    }
+    *buffer_length = self->len;
+
+    bool need_more_data = self->read_count == channel_read_count;
+    if (need_more_data) {
+        int16_t* sample_buffer;
+        if (self->use_first_buffer) {
+            sample_buffer = self->first_buffer;
+        } else {
+            sample_buffer = self->second_buffer;
+        }
+        self->use_first_buffer = !self->use_first_buffer;
+        *buffer = (uint8_t*) sample_buffer;
+        process(self, sample_buffer);
+        self->read_count += 1;
+    } else if (!self->use_first_buffer) {
+        *buffer = (uint8_t*) self->first_buffer;
+    } else {
+        *buffer = (uint8_t*) self->second_buffer;
+    }
+
+    if (channel == 0) {
+        self->left_read_count += 1;
+    } else if (channel == 1) {
+        self->right_read_count += 1;
+        *buffer = *buffer + sizeof(int16_t);
+    }
+    if (self->source_more_data || self->source_length > 0) {
+        return GET_BUFFER_MORE_DATA;
+    }
+    return GET_BUFFER_DONE;
+}
+
+void audioeffects_effect_get_buffer_structure(audioeffects_effect_obj_t* self, bool single_channel,
+                                              bool* single_buffer, bool* samples_signed,
+                                              uint32_t* max_buffer_length, uint8_t* spacing) {
+    *single_buffer = false;
+    *samples_signed = true;
+    *max_buffer_length = self->len;
+    if (single_channel) {
+        *spacing = self->channel_count;
+    } else {
+        *spacing = 1;
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_AUDIOEFFECTS_EFFECT_H
+#define MICROPY_INCLUDED_SHARED_MODULE_AUDIOEFFECTS_EFFECT_H
+
+#include "py/obj.h"
+
+#include "shared-module/audiocore/__init__.h"
+
+// Biquad coefficients normalized by a0 with 24 fractional bits.
+typedef struct {
+    int32_t b0;
+    int32_t b1;
+    int32_t b2;
+    int32_t a1;
+    int32_t a2;
+} audioeffects_biquad_t;
+
+typedef struct {
+    mp_obj_base_t base;
+    mp_obj_t source;
+    int16_t* first_buffer;
+    int16_t* second_buffer;
+    uint32_t len; // in bytes
+    bool use_first_buffer;
+    uint8_t channel_count;
+    uint32_t sample_rate;
+
+    // Source format and the part of its last buffer that hasn't been processed yet.
+    uint8_t source_bits_per_sample;
+    bool source_signed;
+    bool source_more_data;
+    uint8_t* source_data;
+    uint32_t source_length; // in bytes
+
+    uint32_t read_count;
+    uint32_t left_read_count;
+    uint32_t right_read_count;
+
+    bool filter_enabled;
+    audioeffects_biquad_t filter;
+    int32_t filter_state[2][4]; // x[n-1], x[n-2], y[n-1], y[n-2] for each channel.
+
+    uint16_t gain; // Target gain with 12 fractional bits. It is reached over one buffer.
+    uint16_t current_gain;
+
+    int16_t* delay_line;
+    uint32_t max_delay_length; // in samples of all channels
+    uint32_t delay_length; // in samples of all channels. 0 when off.
+    uint32_t delay_index;
+    int16_t feedback; // 15 fractional bits
+
+    bool soft_clip;
+} audioeffects_effect_obj_t;
+
+// These are not available from Python because it may be called in an interrupt.
+void audioeffects_effect_reset_buffer(audioeffects_effect_obj_t* self,
+                                      bool single_channel,
+                                      uint8_t channel);
+audioio_get_buffer_result_t audioeffects_effect_get_buffer(audioeffects_effect_obj_t* self,
+                                                           bool single_channel,
+                                                           uint8_t channel,
+                                                           uint8_t** buffer,
+                                                           uint32_t* buffer_length); // length in bytes
+void audioeffects_effect_get_buffer_structure(audioeffects_effect_obj_t* self, bool single_channel,
+                                              bool* single_buffer, bool* samples_signed,
+                                              uint32_t* max_buffer_length, uint8_t* spacing);
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_AUDIOEFFECTS_EFFECT_H
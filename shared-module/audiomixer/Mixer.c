@@ -295,7 +295,143 @@ static inline uint32_t mult16signed(uint32_t val, int32_t mul) {
     #endif
 }
 
-audioio_get_buffer_result_t audiomixer_mixer_get_buffer(audiomixer_mixer_obj_t* self,
+STATIC uint32_t _silence(audiomixer_mixer_obj_t* self) {
+    if (self->samples_signed) {
+        return 0;
+    }
+    if (self->bits_per_sample == 8) {
+        return 0x7f7f7f7f;
+    }
+    return 0x7fff7fff;
+}
+
+STATIC uint32_t _mix_word(audiomixer_mixer_obj_t* self, uint32_t word, uint32_t sample_value) {
+    if (self->bits_per_sample == 8) {
+        if (self->samples_signed) {
+            return add8signed(word, sample_value);
+        }
+        return add8unsigned(word, sample_value);
+    }
+    if (self->samples_signed) {
+        return add16signed(word, sample_value);
+    }
+    return add16unsigned(word, sample_value);
+}
+
+// Interpolates from a to b by fraction out of 1 << 14.
+static inline int16_t interpolate(int16_t a, int16_t b, uint16_t fraction) {
+    #if (defined (__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1)) //Cortex-M4 w/FPU
+    uint32_t samples = ((uint32_t) (uint16_t) a) | ((uint32_t) b << 16);
+    uint32_t weights = ((1 << 14) - fraction) | ((uint32_t) fraction << 16);
+    return ((int32_t) __SMLAD(samples, weights, 0)) >> 14;
+    #else
+    return a + ((((int32_t) b - a) * fraction) >> 14);
+    #endif
+}
+
+// Reads the next frame of a converting voice as signed 16 bit samples in the mixer's channel count.
+// Returns false when the sample has run out.
+STATIC bool _read_frame(audiomixer_mixer_obj_t* self, audiomixer_mixervoice_obj_t* voice, int16_t* frame) {
+    if (voice->buffer_length == 0) {
+        if (!voice->more_data) {
+            if (!voice->loop) {
+                return false;
+            }
+            audiosample_reset_buffer(voice->sample, false, 0);
+        }
+        audioio_get_buffer_result_t result = audiosample_get_buffer(voice->sample, false, 0, (uint8_t**) &voice->remaining_buffer, &voice->buffer_length);
+        voice->more_data = result == GET_BUFFER_MORE_DATA;
+        if (voice->buffer_length == 0) {
+            return false;
+        }
+    }
+    uint8_t* data = (uint8_t*) voice->remaining_buffer;
+    int16_t samples[2];
+    for (uint8_t c = 0; c < voice->channel_count; c++) {
+        if (voice->bits_per_sample == 8) {
+            uint8_t raw = data[c];
+            samples[c] = (voice->samples_signed ? raw : raw ^ 0x80) << 8;
+        } else {
+            uint16_t raw = data[2 * c] | (data[2 * c + 1] << 8);
+            samples[c] = voice->samples_signed ? raw : raw ^ 0x8000;
+        }
+    }
+    uint8_t frame_size = voice->channel_count * voice->bits_per_sample / 8;
+    if (voice->buffer_length < frame_size) {
+        voice->buffer_length = 0;
+    } else {
+        voice->buffer_length -= frame_size;
+    }
+    voice->remaining_buffer = (uint32_t*) (data + frame_size);
+
+    if (self->channel_count == 1) {
+        frame[0] = voice->channel_count == 1 ? samples[0] : ((int32_t) samples[0] + samples[1]) / 2;
+    } else {
+        frame[0] = samples[0];
+        frame[1] = voice->channel_count == 1 ? samples[0] : samples[1];
+    }
+    return true;
+}
+
+// Produces the next word of mixer output from a converting voice by linearly interpolating between
+// its frames at the mixer's rate. The voice's level is applied too. Returns false when the sample
+// has run out.
+STATIC bool _convert_word(audiomixer_mixer_obj_t* self, audiomixer_mixervoice_obj_t* voice, uint32_t* word) {
+    uint8_t bits = self->bits_per_sample;
+    uint8_t samples_per_word = 32 / bits;
+    uint32_t result = 0;
+    for (uint8_t i = 0; i < samples_per_word; i += self->channel_count) {
+        while (voice->phase >= (1 << 16)) {
+            voice->frames[0][0] = voice->frames[1][0];
+            voice->frames[0][1] = voice->frames[1][1];
+            if (!_read_frame(self, voice, voice->frames[1])) {
+                return false;
+            }
+            voice->phase -= 1 << 16;
+        }
+        uint16_t fraction = voice->phase >> 2;
+        for (uint8_t c = 0; c < self->channel_count; c++) {
+            int32_t value = interpolate(voice->frames[0][c], voice->frames[1][c], fraction);
+            value = (value * voice->level) >> 15;
+            uint32_t packed;
+            if (bits == 8) {
+                packed = (uint8_t) ((value >> 8) ^ (self->samples_signed ? 0 : 0x80));
+            } else {
+                packed = (uint16_t) (value ^ (self->samples_signed ? 0 : 0x8000));
+            }
+            result |= packed << (bits * (i + c));
+        }
+        voice->phase += voice->step;
+    }
+    *word = result;
+    return true;
+}
+
+STATIC void PLACE_IN_ITCM(_mix_converted_voice)(audiomixer_mixer_obj_t* self, audiomixer_mixervoice_obj_t* voice,
+                                 uint32_t* word_buffer, bool voices_active) {
+    bool voice_done = voice->sample == NULL;
+    for (uint32_t i = 0; i < self->len / sizeof(uint32_t); i++) {
+        uint32_t sample_value;
+        if (!voice_done && !_convert_word(self, voice, &sample_value)) {
+            voice->sample = NULL;
+            voice_done = true;
+        }
+        if (voice_done) {
+            // Exit early if another voice already set all samples once.
+            if (voices_active) {
+                return;
+            }
+            sample_value = _silence(self);
+        }
+        if (!voices_active) {
+            word_buffer[i] = sample_value;
+        } else {
+            word_buffer[i] = _mix_word(self, word_buffer[i], sample_value);
+        }
+    }
+}
+
+audioio_get_buffer_result_t PLACE_IN_ITCM(audiomixer_mixer_get_buffer)(audiomixer_mixer_obj_t* self,
                                                         bool single_channel,
                                                         uint8_t channel,
                                                         uint8_t** buffer,
@@ -324,6 +460,11 @@ audioio_get_buffer_result_t audiomixer_mixer_get_buffer(audiomixer_mixer_obj_t*
         bool voices_active = false;
         for (int32_t v = 0; v < self->voice_count; v++) {
             audiomixer_mixervoice_obj_t* voice = MP_OBJ_TO_PTR(self->voice[v]);
+            if (voice->sample != NULL && voice->convert) {
+                _mix_converted_voice(self, voice, word_buffer, voices_active);
+                voices_active = true;
+                continue;
+            }
 
             uint32_t j = 0;
             bool voice_done = voice->sample == NULL;
@@ -353,14 +494,7 @@ audioio_get_buffer_result_t audiomixer_mixer_get_buffer(audiomixer_mixer_obj_t*
                     if (voices_active) {
                         continue;
                     }
-                    sample_value = 0;
-                    if (!self->samples_signed) {
-                        if (self->bits_per_sample == 8) {
-                            sample_value = 0x7f7f7f7f;
-                        } else {
-                            sample_value = 0x7fff7fff;
-                        }
-                    }
+                    sample_value = _silence(self);
                 } else {
                     sample_value = voice->remaining_buffer[j];
                 }
@@ -383,19 +517,7 @@ audioio_get_buffer_result_t audiomixer_mixer_get_buffer(audiomixer_mixer_obj_t*
                 if (!voices_active) {
                     word_buffer[i] = sample_value;
                 } else {
-                    if (self->bits_per_sample == 8) {
-                        if (self->samples_signed) {
-                            word_buffer[i] = add8signed(word_buffer[i], sample_value);
-                        } else {
-                            word_buffer[i] = add8unsigned(word_buffer[i], sample_value);
-                        }
-                    } else {
-                        if (self->samples_signed) {
-                            word_buffer[i] = add16signed(word_buffer[i], sample_value);
-                        } else {
-                            word_buffer[i] = add16unsigned(word_buffer[i], sample_value);
-                        }
-                    }
+                    word_buffer[i] = _mix_word(self, word_buffer[i], sample_value);
                 }
                 j++;
             }
@@ -38,8 +38,16 @@ typedef struct {
     bool loop;
     bool more_data;
     uint32_t* remaining_buffer;
-    uint32_t buffer_length;
+    uint32_t buffer_length; // In words, or in bytes when converting.
     int16_t level;
+    // Samples that differ from the mixer in rate or format are converted as they are mixed.
+    bool convert;
+    bool samples_signed;
+    uint8_t bits_per_sample;
+    uint8_t channel_count;
+    uint32_t step; // Sample frames per mixer frame in 16.16 fixed point.
+    uint32_t phase; // Position past frames[0] in 16.16 fixed point.
+    int16_t frames[2][2]; // The two frames to interpolate between, in the mixer's channel count.
 } audiomixer_mixervoice_obj_t;
 
 
@@ -32,6 +32,7 @@
 #include <math.h>
 
 #include "py/mperrno.h"
+#include "py/mpstate.h"
 #include "py/runtime.h"
 
 #include "shared-module/audiomp3/MP3Decoder.h"
@@ -154,10 +155,80 @@ STATIC bool mp3file_get_next_frame_info(audiomp3_mp3file_obj_t* self, MP3FrameIn
     return err == ERR_MP3_NONE;
 }
 
+// Decodes the next frame into buffer and records how long it took.
+STATIC audioio_get_buffer_result_t mp3file_decode_frame(audiomp3_mp3file_obj_t* self, int16_t* buffer) {
+    uint32_t start = audiosample_ticks_us();
+    mp3file_skip_id3v2(self);
+    if (!mp3file_find_sync_word(self)) {
+        return self->eof ? GET_BUFFER_DONE : GET_BUFFER_ERROR;
+    }
+    int bytes_left = BYTES_LEFT(self);
+    uint8_t *inbuf = READ_PTR(self);
+    int err = MP3Decode(self->decoder, &inbuf, &bytes_left, buffer, 0);
+    CONSUME(self, BYTES_LEFT(self) - bytes_left);
+
+    uint32_t decode_us = audiosample_ticks_us() - start;
+    self->stats.frames += 1;
+    self->stats.last_decode_us = decode_us;
+    if (decode_us > self->stats.max_decode_us) {
+        self->stats.max_decode_us = decode_us;
+    }
+    if (err) {
+        return GET_BUFFER_DONE;
+    }
+    return GET_BUFFER_MORE_DATA;
+}
+
+// Decodes the frame after the ready ones. Once a frame fails, decoding stops and decode_result
+// keeps why.
+STATIC void mp3file_decode_ring_frame(audiomp3_mp3file_obj_t* self) {
+    if (self->decode_result != GET_BUFFER_MORE_DATA) {
+        return;
+    }
+    uint8_t frame = (self->next_frame + self->ready_frames) % self->ring_frames;
+    int16_t* buffer = self->ring + frame * (MAX_BUFFER_LEN / sizeof(int16_t));
+    self->decode_result = mp3file_decode_frame(self, buffer);
+    if (self->decode_result == GET_BUFFER_MORE_DATA) {
+        self->ready_frames += 1;
+    }
+}
+
+void audiomp3_mp3file_background(void) {
+    audiomp3_mp3file_obj_t* self = MP_STATE_VM(mp3file_decode_ahead);
+    if (self == NULL) {
+        return;
+    }
+    uint32_t start = audiosample_ticks_us();
+    // The output holds on to the last two frames handed out.
+    while (self->ready_frames + 2 < self->ring_frames &&
+           self->decode_result == GET_BUFFER_MORE_DATA) {
+        if (self->decode_budget_us == 0) {
+            mp3file_decode_ring_frame(self);
+            break;
+        }
+        // Assume the next frame takes as long as the last one.
+        if (audiosample_ticks_us() - start + self->stats.last_decode_us > self->decode_budget_us) {
+            break;
+        }
+        mp3file_decode_ring_frame(self);
+    }
+}
+
+void audiomp3_mp3file_reset(void) {
+    MP_STATE_VM(mp3file_decode_ahead) = NULL;
+}
+
+// Restarts decoding ahead after the frames in use by the output.
+STATIC void mp3file_restart_ring(audiomp3_mp3file_obj_t* self) {
+    self->ready_frames = 0;
+    self->decode_result = GET_BUFFER_MORE_DATA;
+}
+
 void common_hal_audiomp3_mp3file_construct(audiomp3_mp3file_obj_t* self,
                                            pyb_file_obj_t* file,
                                            uint8_t *buffer,
-                                           size_t buffer_size) {
+                                           size_t buffer_size,
+                                           uint8_t decode_ahead) {
     // XXX Adafruit_MP3 uses a 2kB input buffer and two 4kB output buffers.
     // for a whopping total of 10kB buffers (+mp3 decoder state and frame buffer)
     // At 44kHz, that's 23ms of output audio data.
@@ -183,10 +254,27 @@ void common_hal_audiomp3_mp3file_construct(audiomp3_mp3file_obj_t* self,
                      translate("Couldn't allocate decoder"));
     }
 
+    self->ring = NULL;
+    self->decode_budget_us = 0;
+    self->stats = (audiomp3_decode_stats_t) { 0 };
     if ((intptr_t)buffer & 1) {
         buffer += 1; buffer_size -= 1;
     }
-    if (buffer_size >= 2 * MAX_BUFFER_LEN) {
+    if (decode_ahead > 0) {
+        // The ring replaces the two buffers. Two frames are held by the output at a time so the
+        // decoded ahead ones come on top of them.
+        self->ring_frames = 2 + decode_ahead;
+        self->ring = m_malloc(self->ring_frames * MAX_BUFFER_LEN, false);
+        if (self->ring == NULL) {
+            common_hal_audiomp3_mp3file_deinit(self);
+            mp_raise_msg(&mp_type_MemoryError,
+                         translate("Couldn't allocate first buffer"));
+        }
+        self->buffers[0] = self->ring;
+        self->buffers[1] = self->ring + MAX_BUFFER_LEN / sizeof(int16_t);
+        self->next_frame = 0;
+        mp3file_restart_ring(self);
+    } else if (buffer_size >= 2 * MAX_BUFFER_LEN) {
         self->buffers[0] = (int16_t*)(void*)buffer;
         self->buffers[1] = (int16_t*)(void*)(buffer + MAX_BUFFER_LEN);
     } else {
@@ -229,6 +317,10 @@ void common_hal_audiomp3_mp3file_set_file(audiomp3_mp3file_obj_t* self, pyb_file
                      translate("Failed to parse MP3 file"));
     }
 
+    if (self->ring != NULL) {
+        mp3file_restart_ring(self);
+    }
+
     self->sample_rate = fi.samprate;
     self->channel_count = fi.nChans;
     self->frame_buffer_size = fi.outputSamps*sizeof(int16_t);
@@ -236,6 +328,10 @@ void common_hal_audiomp3_mp3file_set_file(audiomp3_mp3file_obj_t* self, pyb_file
 }
 
 void common_hal_audiomp3_mp3file_deinit(audiomp3_mp3file_obj_t* self) {
+    if (MP_STATE_VM(mp3file_decode_ahead) == self) {
+        MP_STATE_VM(mp3file_decode_ahead) = NULL;
+    }
+    self->ring = NULL;
     MP3FreeDecoder(self->decoder);
     self->decoder = NULL;
     self->inbuf = NULL;
@@ -284,6 +380,13 @@ void audiomp3_mp3file_reset_buffer(audiomp3_mp3file_obj_t* self,
     mp3file_update_inbuf(self);
     mp3file_skip_id3v2(self);
     mp3file_find_sync_word(self);
+    self->stats = (audiomp3_decode_stats_t) { 0 };
+    if (self->ring != NULL) {
+        mp3file_restart_ring(self);
+        // Only one MP3Decoder decodes ahead at a time. The one before it decodes as frames are
+        // needed.
+        MP_STATE_VM(mp3file_decode_ahead) = self;
+    }
 }
 
 audioio_get_buffer_result_t audiomp3_mp3file_get_buffer(audiomp3_mp3file_obj_t* self,
@@ -310,22 +413,34 @@ audioio_get_buffer_result_t audiomp3_mp3file_get_buffer(audiomp3_mp3file_obj_t*
     self->buffer_index = !self->buffer_index;
     self->other_channel = 1-channel;
     self->other_buffer_index = self->buffer_index;
-    int16_t *buffer = (int16_t *)(void *)self->buffers[self->buffer_index];
-    *bufptr = (uint8_t*)buffer;
 
-    mp3file_skip_id3v2(self);
-    if (!mp3file_find_sync_word(self)) {
-        return self->eof ? GET_BUFFER_DONE : GET_BUFFER_ERROR;
-    }
-    int bytes_left = BYTES_LEFT(self);
-    uint8_t *inbuf = READ_PTR(self);
-    int err = MP3Decode(self->decoder, &inbuf, &bytes_left, buffer, 0);
-    CONSUME(self, BYTES_LEFT(self) - bytes_left);
-    if (err) {
-        return GET_BUFFER_DONE;
+    if (self->ring != NULL) {
+        // Decode it now if decoding ahead fell behind.
+        if (self->ready_frames == 0 && self->decode_result == GET_BUFFER_MORE_DATA) {
+            self->stats.late_frames += 1;
+            mp3file_decode_ring_frame(self);
+        }
+        int16_t* frame = self->ring + self->next_frame * (MAX_BUFFER_LEN / sizeof(int16_t));
+        // Point the buffer the other channel and rms_level use at the frame.
+        self->buffers[self->buffer_index] = frame;
+        *bufptr = (uint8_t*)frame;
+        if (self->ready_frames == 0) {
+            // Play silence rather than a stale frame.
+            memset(frame, 0, self->frame_buffer_size);
+            return self->decode_result;
+        }
+        self->next_frame = (self->next_frame + 1) % self->ring_frames;
+        self->ready_frames -= 1;
+        if (self->ready_frames == 0 && self->decode_result == GET_BUFFER_DONE) {
+            return GET_BUFFER_DONE;
+        }
+        return GET_BUFFER_MORE_DATA;
     }
 
-    return GET_BUFFER_MORE_DATA;
+    int16_t *buffer = (int16_t *)(void *)self->buffers[self->buffer_index];
+    *bufptr = (uint8_t*)buffer;
+
+    return mp3file_decode_frame(self, buffer);
 }
 
 void audiomp3_mp3file_get_buffer_structure(audiomp3_mp3file_obj_t* self, bool single_channel,
@@ -341,6 +456,18 @@ void audiomp3_mp3file_get_buffer_structure(audiomp3_mp3file_obj_t* self, bool si
     }
 }
 
+uint32_t common_hal_audiomp3_mp3file_get_decode_budget_us(audiomp3_mp3file_obj_t* self) {
+    return self->decode_budget_us;
+}
+
+void common_hal_audiomp3_mp3file_set_decode_budget_us(audiomp3_mp3file_obj_t* self, uint32_t budget_us) {
+    self->decode_budget_us = budget_us;
+}
+
+const audiomp3_decode_stats_t* common_hal_audiomp3_mp3file_get_decode_stats(audiomp3_mp3file_obj_t* self) {
+    return &self->stats;
+}
+
 float common_hal_audiomp3_mp3file_get_rms_level(audiomp3_mp3file_obj_t* self) {
     float sumsq = 0.f;
     // Assumes no DC component to the audio.  Is that a safe assumption?
@@ -33,6 +33,14 @@
 
 #include "shared-module/audiocore/__init__.h"
 
+// Times are in microseconds.
+typedef struct {
+    uint32_t frames;
+    uint32_t late_frames; // Frames decoded when the output needed them because none were ready.
+    uint32_t last_decode_us;
+    uint32_t max_decode_us;
+} audiomp3_decode_stats_t;
+
 typedef struct {
     mp_obj_base_t base;
     struct _MP3DecInfo *decoder;
@@ -52,8 +60,26 @@ typedef struct {
 
     int8_t other_channel;
     int8_t other_buffer_index;
+
+    // Ring of ring_frames frames of MAX_BUFFER_LEN bytes that is decoded ahead of playback. NULL
+    // when each frame is decoded as it is needed.
+    int16_t* ring;
+    uint8_t ring_frames;
+    uint8_t next_frame; // Next frame to hand out.
+    uint8_t ready_frames; // Frames decoded after next_frame, including it.
+    // Result of decoding the frame after the ready ones. Decoding ahead stops when it isn't
+    // GET_BUFFER_MORE_DATA.
+    audioio_get_buffer_result_t decode_result;
+    uint32_t decode_budget_us; // Background time to spend decoding per pass. 0 for one frame.
+
+    audiomp3_decode_stats_t stats;
 } audiomp3_mp3file_obj_t;
 
+// Decodes ahead for the playing MP3Decoder. Call it from background tasks.
+void audiomp3_mp3file_background(void);
+// Forgets the decode ahead MP3Decoder. Call it before the heap goes away.
+void audiomp3_mp3file_reset(void);
+
 // These are not available from Python because it may be called in an interrupt.
 void audiomp3_mp3file_reset_buffer(audiomp3_mp3file_obj_t* self,
                                    bool single_channel,
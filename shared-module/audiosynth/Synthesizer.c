@@ -0,0 +1,282 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/audiosynth/Synthesizer.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "py/runtime.h"
+#include "shared-module/audiocore/__init__.h"
+
+#define ENVELOPE_FULL (1 << 24)
+
+// Change in level per sample to go from 0 to full in the given time.
+STATIC uint32_t envelope_step(mp_float_t time, uint32_t sample_rate) {
+    mp_float_t samples = time * sample_rate;
+    if (samples < 1) {
+        return ENVELOPE_FULL;
+    }
+    return ENVELOPE_FULL / samples;
+}
+
+void common_hal_audiosynth_synthesizer_construct(audiosynth_synthesizer_obj_t* self,
+                                                 mp_obj_t wavetable_obj,
+                                                 int16_t* wavetable,
+                                                 uint32_t wavetable_length,
+                                                 uint8_t voice_count,
+                                                 uint32_t buffer_size,
+                                                 uint32_t sample_rate,
+                                                 mp_float_t attack,
+                                                 mp_float_t decay,
+                                                 mp_float_t sustain,
+                                                 mp_float_t release) {
+    self->len = buffer_size / 2 / sizeof(uint32_t) * sizeof(uint32_t);
+    if (self->len == 0) {
+        mp_raise_ValueError(translate("Invalid argument"));
+    }
+
+    self->first_buffer = m_malloc(self->len, false);
+    if (self->first_buffer == NULL) {
+        common_hal_audiosynth_synthesizer_deinit(self);
+        mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate first buffer"));
+    }
+
+    self->second_buffer = m_malloc(self->len, false);
+    if (self->second_buffer == NULL) {
+        common_hal_audiosynth_synthesizer_deinit(self);
+        mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate second buffer"));
+    }
+
+    self->wavetable_obj = wavetable_obj;
+    self->wavetable = wavetable;
+    self->wavetable_length = wavetable_length;
+    self->sample_rate = sample_rate;
+    self->attack_step = envelope_step(attack, sample_rate);
+    self->decay_step = envelope_step(decay, sample_rate);
+    self->sustain_level = sustain * ENVELOPE_FULL;
+    self->release_step = envelope_step(release, sample_rate);
+
+    self->voice_count = voice_count;
+    memset(self->voices, 0, voice_count * sizeof(audiosynth_voice_t));
+}
+
+void common_hal_audiosynth_synthesizer_deinit(audiosynth_synthesizer_obj_t* self) {
+    self->first_buffer = NULL;
+    self->second_buffer = NULL;
+    self->wavetable_obj = MP_OBJ_NULL;
+    self->wavetable = NULL;
+}
+
+bool common_hal_audiosynth_synthesizer_deinited(audiosynth_synthesizer_obj_t* self) {
+    return self->first_buffer == NULL;
+}
+
+void common_hal_audiosynth_synthesizer_press(audiosynth_synthesizer_obj_t* self, uint8_t voice,
+                                             mp_float_t frequency, mp_float_t velocity) {
+    audiosynth_voice_t* v = &self->voices[voice];
+    v->phase_increment = frequency * self->wavetable_length * (1 << 16) / self->sample_rate;
+    v->velocity = velocity * INT16_MAX;
+    // Restarting a sounding voice keeps its phase and level so it doesn't click.
+    if (v->state == AUDIOSYNTH_ENVELOPE_OFF) {
+        v->phase = 0;
+        v->level = 0;
+    }
+    v->state = AUDIOSYNTH_ENVELOPE_ATTACK;
+}
+
+void common_hal_audiosynth_synthesizer_release(audiosynth_synthesizer_obj_t* self, uint8_t voice) {
+    audiosynth_voice_t* v = &self->voices[voice];
+    if (v->state != AUDIOSYNTH_ENVELOPE_OFF) {
+        v->state = AUDIOSYNTH_ENVELOPE_RELEASE;
+    }
+}
+
+void common_hal_audiosynth_synthesizer_release_all(audiosynth_synthesizer_obj_t* self) {
+    for (uint8_t i = 0; i < self->voice_count; i++) {
+        common_hal_audiosynth_synthesizer_release(self, i);
+    }
+}
+
+bool common_hal_audiosynth_synthesizer_get_playing(audiosynth_synthesizer_obj_t* self) {
+    for (uint8_t i = 0; i < self->voice_count; i++) {
+        if (self->voices[i].state != AUDIOSYNTH_ENVELOPE_OFF) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t common_hal_audiosynth_synthesizer_get_sample_rate(audiosynth_synthesizer_obj_t* self) {
+    return self->sample_rate;
+}
+
+uint8_t common_hal_audiosynth_synthesizer_get_channel_count(audiosynth_synthesizer_obj_t* self) {
+    return 1;
+}
+
+uint8_t common_hal_audiosynth_synthesizer_get_bits_per_sample(audiosynth_synthesizer_obj_t* self) {
+    return 16;
+}
+
+void audiosynth_synthesizer_reset_buffer(audiosynth_synthesizer_obj_t* self,
+                                         bool single_channel,
+                                         uint8_t channel) {
+    self->read_count = 0;
+    self->left_read_count = 0;
+    self->right_read_count = 0;
+}
+
+// Moves the envelope on by one sample.
+static inline void step_envelope(audiosynth_synthesizer_obj_t* self, audiosynth_voice_t* v) {
+    switch (v->state) {
+        case AUDIOSYNTH_ENVELOPE_ATTACK:
+            if (v->level >= ENVELOPE_FULL - self->attack_step) {
+                v->level = ENVELOPE_FULL;
+                v->state = AUDIOSYNTH_ENVELOPE_DECAY;
+            } else {
+                v->level += self->attack_step;
+            }
+            break;
+        case AUDIOSYNTH_ENVELOPE_DECAY:
+            if (v->level <= self->sustain_level + self->decay_step) {
+                v->level = self->sustain_level;
+                v->state = AUDIOSYNTH_ENVELOPE_SUSTAIN;
+                // Percussive envelopes end without a release.
+                if (v->level == 0) {
+                    v->state = AUDIOSYNTH_ENVELOPE_OFF;
+                }
+            } else {
+                v->level -= self->decay_step;
+            }
+            break;
+        case AUDIOSYNTH_ENVELOPE_RELEASE:
+            if (v->level <= self->release_step) {
+                v->level = 0;
+                v->state = AUDIOSYNTH_ENVELOPE_OFF;
+            } else {
+                v->level -= self->release_step;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+STATIC void render(audiosynth_synthesizer_obj_t* self, int16_t* buffer) {
+    uint32_t sample_count = self->len / sizeof(int16_t);
+    int16_t* table = self->wavetable;
+    uint32_t table_length = self->wavetable_length;
+    uint32_t phase_end = table_length << 16;
+    for (uint32_t i = 0; i < sample_count; i++) {
+        int32_t sum = 0;
+        for (uint8_t j = 0; j < self->voice_count; j++) {
+            audiosynth_voice_t* v = &self->voices[j];
+            if (v->state == AUDIOSYNTH_ENVELOPE_OFF) {
+                continue;
+            }
+            // Linearly interpolate between wavetable entries, wrapping at the end.
+            uint32_t index = v->phase >> 16;
+            uint32_t next = index + 1;
+            if (next == table_length) {
+                next = 0;
+            }
+            int32_t a = table[index];
+            int32_t fraction = (v->phase & 0xffff) >> 1;
+            int32_t value = a + (((table[next] - a) * fraction) >> 15);
+            int32_t amplitude = ((v->level >> 9) * v->velocity) >> 15;
+            sum += (value * amplitude) >> 15;
+
+            v->phase += v->phase_increment;
+            if (v->phase >= phase_end) {
+                v->phase -= phase_end;
+            }
+            step_envelope(self, v);
+        }
+        #if (defined (__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1)) //Cortex-M4 w/FPU
+        buffer[i] = __SSAT(sum, 16);
+        #else
+        if (sum > INT16_MAX) {
+            sum = INT16_MAX;
+        } else if (sum < INT16_MIN) {
+            sum = INT16_MIN;
+        }
+        buffer[i] = sum;
+        #endif
+    }
+}
+
+audioio_get_buffer_result_t audiosynth_synthesizer_get_buffer(audiosynth_synthesizer_obj_t* self,
+                                                              bool single_channel,
+                                                              uint8_t channel,
+                                                              uint8_t** buffer,
+                                                              uint32_t* buffer_length) {
+    if (!single_channel) {
+        channel = 0;
+    }
+
+    // Both channels of a stereo output play the same mono buffer.
+    uint32_t channel_read_count = self->left_read_count;
+    if (channel == 1) {
+        channel_read_count = self->right_read_count;
+    }
+    *buffer_length = self->len;
+
+    bool need_more_data = self->read_count == channel_read_count;
+    if (need_more_data) {
+        int16_t* sample_buffer;
+        if (self->use_first_buffer) {
+            sample_buffer = self->first_buffer;
+        } else {
+            sample_buffer = self->second_buffer;
+        }
+        self->use_first_buffer = !self->use_first_buffer;
+        render(self, sample_buffer);
+        *buffer = (uint8_t*) sample_buffer;
+        self->read_count += 1;
+    } else if (!self->use_first_buffer) {
+        *buffer = (uint8_t*) self->first_buffer;
+    } else {
+        *buffer = (uint8_t*) self->second_buffer;
+    }
+
+    if (channel == 0) {
+        self->left_read_count += 1;
+    } else if (channel == 1) {
+        self->right_read_count += 1;
+    }
+    // Silence is rendered while no voice is pressed so the output keeps running.
+    return GET_BUFFER_MORE_DATA;
+}
+
+void audiosynth_synthesizer_get_buffer_structure(audiosynth_synthesizer_obj_t* self, bool single_channel,
+                                                 bool* single_buffer, bool* samples_signed,
+                                                 uint32_t* max_buffer_length, uint8_t* spacing) {
+    *single_buffer = false;
+    *samples_signed = true;
+    *max_buffer_length = self->len;
+    *spacing = 1;
+}
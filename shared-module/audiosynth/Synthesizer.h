@@ -0,0 +1,88 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_AUDIOSYNTH_SYNTHESIZER_H
+#define MICROPY_INCLUDED_SHARED_MODULE_AUDIOSYNTH_SYNTHESIZER_H
+
+#include "py/obj.h"
+
+#include "shared-module/audiocore/__init__.h"
+
+typedef enum {
+    AUDIOSYNTH_ENVELOPE_OFF,
+    AUDIOSYNTH_ENVELOPE_ATTACK,
+    AUDIOSYNTH_ENVELOPE_DECAY,
+    AUDIOSYNTH_ENVELOPE_SUSTAIN,
+    AUDIOSYNTH_ENVELOPE_RELEASE,
+} audiosynth_envelope_state_t;
+
+typedef struct {
+    uint32_t phase; // Position in the wavetable with 16 fractional bits.
+    uint32_t phase_increment;
+    uint32_t level; // Envelope level with 24 fractional bits.
+    int16_t velocity; // 15 fractional bits
+    uint8_t state;
+} audiosynth_voice_t;
+
+typedef struct {
+    mp_obj_base_t base;
+    mp_obj_t wavetable_obj; // Keeps the wavetable buffer alive.
+    int16_t* wavetable;
+    uint32_t wavetable_length; // in samples
+    int16_t* first_buffer;
+    int16_t* second_buffer;
+    uint32_t len; // in bytes
+    bool use_first_buffer;
+    uint32_t sample_rate;
+
+    uint32_t read_count;
+    uint32_t left_read_count;
+    uint32_t right_read_count;
+
+    // Envelope changes per sample with 24 fractional bits, shared by all voices.
+    uint32_t attack_step;
+    uint32_t decay_step;
+    uint32_t sustain_level;
+    uint32_t release_step;
+
+    uint8_t voice_count;
+    audiosynth_voice_t voices[];
+} audiosynth_synthesizer_obj_t;
+
+// These are not available from Python because it may be called in an interrupt.
+void audiosynth_synthesizer_reset_buffer(audiosynth_synthesizer_obj_t* self,
+                                         bool single_channel,
+                                         uint8_t channel);
+audioio_get_buffer_result_t audiosynth_synthesizer_get_buffer(audiosynth_synthesizer_obj_t* self,
+                                                              bool single_channel,
+                                                              uint8_t channel,
+                                                              uint8_t** buffer,
+                                                              uint32_t* buffer_length); // length in bytes
+void audiosynth_synthesizer_get_buffer_structure(audiosynth_synthesizer_obj_t* self, bool single_channel,
+                                                 bool* single_buffer, bool* samples_signed,
+                                                 uint32_t* max_buffer_length, uint8_t* spacing);
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_AUDIOSYNTH_SYNTHESIZER_H
@@ -91,10 +91,16 @@ void shared_module_bitbangio_spi_deinit(bitbangio_spi_obj_t *self) {
 
 void shared_module_bitbangio_spi_configure(bitbangio_spi_obj_t *self,
         uint32_t baudrate, uint8_t polarity, uint8_t phase, uint8_t bits) {
-    self->delay_half = 500000 / baudrate;
-    // round delay_half up so that: actual_baudrate <= requested_baudrate
-    if (500000 % baudrate != 0) {
-        self->delay_half += 1;
+    // Above 500kHz a half period is under the 1us delay resolution, so run as
+    // fast as the pins can be toggled instead.
+    if (baudrate > 500000) {
+        self->delay_half = 0;
+    } else {
+        self->delay_half = 500000 / baudrate;
+        // round delay_half up so that: actual_baudrate <= requested_baudrate
+        if (500000 % baudrate != 0) {
+            self->delay_half += 1;
+        }
     }
 
     self->polarity = polarity;
@@ -120,6 +126,82 @@ void shared_module_bitbangio_spi_unlock(bitbangio_spi_obj_t *self) {
     self->locked = false;
 }
 
+MP_WEAK bool bitbangio_pin_registers(const digitalio_digitalinout_obj_t* pin, bitbangio_pin_registers_t* registers) {
+    return false;
+}
+
+// One bit, most significant first, with all of the addresses and masks
+// already in locals. For phase 0 the data is set up before the leading clock
+// edge and both sides sample on it. For phase 1 the data changes on the
+// leading edge and is sampled before the trailing one.
+#define FAST_BIT_PHASE0(n) \
+    *((out & (1 << (n))) ? mosi_set : mosi_clear) = mosi_mask; \
+    *clock_active = clock_mask; \
+    in |= ((*miso_in & miso_mask) != 0) << (n); \
+    *clock_idle = clock_mask;
+#define FAST_BIT_PHASE1(n) \
+    *clock_active = clock_mask; \
+    *((out & (1 << (n))) ? mosi_set : mosi_clear) = mosi_mask; \
+    in |= ((*miso_in & miso_mask) != 0) << (n); \
+    *clock_idle = clock_mask;
+
+// Transfers len bytes through the port's registers as fast as the CPU allows.
+// dout may be NULL to clock out zeroes and din may be NULL to ignore MISO.
+// Returns false, having done nothing, if the port can't drive the pins
+// directly. Interrupts stay on: the clock paces the device, so a late edge
+// only slows the transfer down.
+STATIC bool fast_transfer(bitbangio_spi_obj_t *self, const uint8_t *dout, uint8_t *din, size_t len) {
+    bitbangio_pin_registers_t clock;
+    bitbangio_pin_registers_t mosi;
+    bitbangio_pin_registers_t miso;
+    // Stands in for an unused MOSI or MISO.
+    uint32_t scratch = 0;
+    if (!bitbangio_pin_registers(&self->clock, &clock)) {
+        return false;
+    }
+    if (!self->has_mosi) {
+        mosi.set = mosi.clear = &scratch;
+        mosi.mask = 0;
+    } else if (!bitbangio_pin_registers(&self->mosi, &mosi)) {
+        return false;
+    }
+    if (din == NULL) {
+        miso.in = &scratch;
+        miso.mask = 0;
+    } else if (!bitbangio_pin_registers(&self->miso, &miso)) {
+        return false;
+    }
+
+    volatile uint32_t* const clock_active = self->polarity == 0 ? clock.set : clock.clear;
+    volatile uint32_t* const clock_idle = self->polarity == 0 ? clock.clear : clock.set;
+    const uint32_t clock_mask = clock.mask;
+    volatile uint32_t* const mosi_set = mosi.set;
+    volatile uint32_t* const mosi_clear = mosi.clear;
+    const uint32_t mosi_mask = mosi.mask;
+    volatile const uint32_t* const miso_in = miso.in;
+    const uint32_t miso_mask = miso.mask;
+
+    for (size_t i = 0; i < len; ++i) {
+        const uint8_t out = dout != NULL ? dout[i] : 0;
+        uint8_t in = 0;
+        if (self->phase == 0) {
+            FAST_BIT_PHASE0(7) FAST_BIT_PHASE0(6) FAST_BIT_PHASE0(5) FAST_BIT_PHASE0(4)
+            FAST_BIT_PHASE0(3) FAST_BIT_PHASE0(2) FAST_BIT_PHASE0(1) FAST_BIT_PHASE0(0)
+        } else {
+            FAST_BIT_PHASE1(7) FAST_BIT_PHASE1(6) FAST_BIT_PHASE1(5) FAST_BIT_PHASE1(4)
+            FAST_BIT_PHASE1(3) FAST_BIT_PHASE1(2) FAST_BIT_PHASE1(1) FAST_BIT_PHASE1(0)
+        }
+        if (din != NULL) {
+            din[i] = in;
+        }
+
+        #ifdef MICROPY_EVENT_POLL_HOOK
+        MICROPY_EVENT_POLL_HOOK;
+        #endif
+    }
+    return true;
+}
+
 // Writes out the given data.
 bool shared_module_bitbangio_spi_write(bitbangio_spi_obj_t *self, const uint8_t *data, size_t len) {
     if (len > 0 && !self->has_mosi) {
@@ -129,25 +211,9 @@ bool shared_module_bitbangio_spi_write(bitbangio_spi_obj_t *self, const uint8_t
 
     // only MSB transfer is implemented
 
-    // If a port defines MICROPY_PY_MACHINE_SPI_MIN_DELAY, and the configured
-    // delay_half is equal to this value, then the software SPI implementation
-    // will run as fast as possible, limited only by CPU speed and GPIO time.
-    #ifdef MICROPY_PY_MACHINE_SPI_MIN_DELAY
-    if (delay_half <= MICROPY_PY_MACHINE_SPI_MIN_DELAY) {
-        for (size_t i = 0; i < len; ++i) {
-            uint8_t data_out = data[i];
-            for (int j = 0; j < 8; ++j, data_out <<= 1) {
-                common_hal_digitalio_digitalinout_set_value(&self->mosi, (data_out >> 7) & 1);
-                common_hal_digitalio_digitalinout_set_value(&self->clock, 1 - self->polarity);
-                common_hal_digitalio_digitalinout_set_value(&self->clock, self->polarity);
-            }
-            if (dest != NULL) {
-                dest[i] = data_in;
-            }
-        }
+    if (delay_half == 0 && fast_transfer(self, data, NULL, len)) {
         return true;
     }
-    #endif
 
     for (size_t i = 0; i < len; ++i) {
         uint8_t data_out = data[i];
@@ -185,27 +251,9 @@ bool shared_module_bitbangio_spi_read(bitbangio_spi_obj_t *self, uint8_t *data,
 
     // only MSB transfer is implemented
 
-    // If a port defines MICROPY_PY_MACHINE_SPI_MIN_DELAY, and the configured
-    // delay_half is equal to this value, then the software SPI implementation
-    // will run as fast as possible, limited only by CPU speed and GPIO time.
-    #ifdef MICROPY_PY_MACHINE_SPI_MIN_DELAY
-    if (delay_half <= MICROPY_PY_MACHINE_SPI_MIN_DELAY) {
-        // Clock out zeroes while we read.
-        if (self->has_mosi) {
-            common_hal_digitalio_digitalinout_set_value(&self->mosi, false);
-        }
-        for (size_t i = 0; i < len; ++i) {
-            uint8_t data_in = 0;
-            for (int j = 0; j < 8; ++j, data_out <<= 1) {
-                common_hal_digitalio_digitalinout_set_value(&self->clock, 1 - self->polarity);
-                data_in = (data_in << 1) | common_hal_digitalio_digitalinout_get_value(&self->miso);
-                common_hal_digitalio_digitalinout_set_value(&self->clock, self->polarity);
-            }
-            data[i] = data_in;
-        }
+    if (delay_half == 0 && fast_transfer(self, NULL, data, len)) {
         return true;
     }
-    #endif
     if (self->has_mosi) {
         common_hal_digitalio_digitalinout_set_value(&self->mosi, false);
     }
@@ -248,29 +296,9 @@ bool shared_module_bitbangio_spi_transfer(bitbangio_spi_obj_t *self, const uint8
 
     // only MSB transfer is implemented
 
-    // If a port defines MICROPY_PY_MACHINE_SPI_MIN_DELAY, and the configured
-    // delay_half is equal to this value, then the software SPI implementation
-    // will run as fast as possible, limited only by CPU speed and GPIO time.
-    #ifdef MICROPY_PY_MACHINE_SPI_MIN_DELAY
-    if (delay_half <= MICROPY_PY_MACHINE_SPI_MIN_DELAY) {
-        for (size_t i = 0; i < len; ++i) {
-            uint8_t data_out = dout[i];
-            uint8_t data_in = 0;
-            for (int j = 0; j < 8; ++j, data_out <<= 1) {
-                common_hal_digitalio_digitalinout_set_value(&self->mosi, (data_out >> 7) & 1);
-                common_hal_digitalio_digitalinout_set_value(&self->clock, 1 - self->polarity);
-                data_in = (data_in << 1) | common_hal_digitalio_digitalinout_get_value(&self->miso);
-                common_hal_digitalio_digitalinout_set_value(&self->clock, self->polarity);
-            }
-            din[i] = data_in;
-
-            if (dest != NULL) {
-                dest[i] = data_in;
-            }
-        }
+    if (delay_half == 0 && fast_transfer(self, dout, din, len)) {
         return true;
     }
-    #endif
 
     for (size_t i = 0; i < len; ++i) {
         uint8_t data_out = dout[i];
@@ -58,4 +58,17 @@ typedef struct {
     volatile bool locked:1;
 } bitbangio_spi_obj_t;
 
+// A pin's output set and clear registers, its input register and its bit in
+// them, for driving it without going through digitalio.
+typedef struct {
+    volatile uint32_t* set;
+    volatile uint32_t* clear;
+    volatile const uint32_t* in;
+    uint32_t mask;
+} bitbangio_pin_registers_t;
+
+// Fills in registers and returns true when the port can drive pin directly.
+// The portable version returns false, which keeps bitbangio on digitalio.
+bool bitbangio_pin_registers(const digitalio_digitalinout_obj_t* pin, bitbangio_pin_registers_t* registers);
+
 #endif // MICROPY_INCLUDED_SHARED_MODULE_BITBANGIO_TYPES_H
@@ -68,3 +68,12 @@ uint8_t common_hal_busio_i2c_read(busio_i2c_obj_t *self, uint16_t addr,
         uint8_t * data, size_t len) {
     return shared_module_bitbangio_i2c_read(&self->bitbang, addr, data, len);
 }
+
+uint8_t common_hal_busio_i2c_write_read(busio_i2c_obj_t *self, uint16_t addr,
+        const uint8_t * out_data, size_t out_len, uint8_t * in_data, size_t in_len) {
+    uint8_t status = shared_module_bitbangio_i2c_write(&self->bitbang, addr, out_data, out_len, false);
+    if (status != 0) {
+        return status;
+    }
+    return shared_module_bitbangio_i2c_read(&self->bitbang, addr, in_data, in_len);
+}
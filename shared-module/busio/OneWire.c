@@ -24,17 +24,44 @@
  * THE SOFTWARE.
  */
 
-// Wraps the bitbangio implementation of OneWire for use in busio.
+// Wraps the bitbangio implementation of OneWire for use in busio, or times the
+// slots with a UART when the bus is wired to both its TX and RX.
+#include <string.h>
+
 #include "common-hal/microcontroller/Pin.h"
 #include "shared-bindings/bitbangio/OneWire.h"
+#include "shared-bindings/busio/OneWire.h"
+#include "shared-bindings/busio/UART.h"
 #include "shared-module/busio/OneWire.h"
 
+// Each UART character is a time slot. At 115200 baud the start bit alone
+// pulls the bus low for 8.7us, so 0xff writes a 1 or reads a bit, which is 1
+// when it echoes back unchanged. 0x00 holds the bus low for 78us to write a 0.
+// A reset is 0xf0 at 9600 baud, which is low for 520us, and any presence
+// pulse changes the echo.
+#define UART_SLOT_BAUDRATE 115200
+#define UART_RESET_BAUDRATE 9600
+#define UART_SLOT_READ 0xff
+#define UART_SLOT_WRITE_0 0x00
+#define UART_RESET 0xf0
+
+#define ROM_SEARCH 0xf0
+
 void common_hal_busio_onewire_construct(busio_onewire_obj_t* self,
-        const mcu_pin_obj_t* pin) {
+        const mcu_pin_obj_t* pin, const mcu_pin_obj_t* rx) {
+    self->use_uart = rx != NULL;
+    if (self->use_uart) {
+        common_hal_busio_uart_construct(&self->uart, pin, rx, UART_SLOT_BAUDRATE, 8, PARITY_NONE, 1,
+                                        (mp_float_t) 0.1f, 2 * ONEWIRE_UART_CHUNK);
+        return;
+    }
     shared_module_bitbangio_onewire_construct(&self->bitbang, pin);
 }
 
 bool common_hal_busio_onewire_deinited(busio_onewire_obj_t* self) {
+    if (self->use_uart) {
+        return common_hal_busio_uart_deinited(&self->uart);
+    }
     return shared_module_bitbangio_onewire_deinited(&self->bitbang);
 }
 
@@ -42,18 +69,178 @@ void common_hal_busio_onewire_deinit(busio_onewire_obj_t* self) {
     if (common_hal_busio_onewire_deinited(self)) {
         return;
     }
+    if (self->use_uart) {
+        common_hal_busio_uart_deinit(&self->uart);
+        return;
+    }
     shared_module_bitbangio_onewire_deinit(&self->bitbang);
 }
 
+// Sends the slots and replaces each with its echo. Slots that don't echo
+// back read as 0.
+STATIC void uart_slots(busio_onewire_obj_t* self, uint8_t* slots, size_t len) {
+    int errcode;
+    common_hal_busio_uart_clear_rx_buffer(&self->uart);
+    common_hal_busio_uart_write(&self->uart, slots, len, &errcode);
+    size_t received = common_hal_busio_uart_read(&self->uart, slots, len, &errcode);
+    memset(slots + received, 0, len - received);
+}
+
 bool common_hal_busio_onewire_reset(busio_onewire_obj_t* self) {
-    return shared_module_bitbangio_onewire_reset(&self->bitbang);
+    if (!self->use_uart) {
+        return shared_module_bitbangio_onewire_reset(&self->bitbang);
+    }
+    uint8_t slot = UART_RESET;
+    common_hal_busio_uart_set_baudrate(&self->uart, UART_RESET_BAUDRATE);
+    uart_slots(self, &slot, 1);
+    common_hal_busio_uart_set_baudrate(&self->uart, UART_SLOT_BAUDRATE);
+    // A missing echo means the bus is stuck low, which isn't a presence pulse.
+    return slot == UART_RESET || slot == 0;
 }
 
 bool common_hal_busio_onewire_read_bit(busio_onewire_obj_t* self) {
-    return shared_module_bitbangio_onewire_read_bit(&self->bitbang);
+    if (!self->use_uart) {
+        return shared_module_bitbangio_onewire_read_bit(&self->bitbang);
+    }
+    uint8_t slot = UART_SLOT_READ;
+    uart_slots(self, &slot, 1);
+    return slot == UART_SLOT_READ;
 }
 
 void common_hal_busio_onewire_write_bit(busio_onewire_obj_t* self,
         bool bit) {
-    shared_module_bitbangio_onewire_write_bit(&self->bitbang, bit);
+    if (!self->use_uart) {
+        shared_module_bitbangio_onewire_write_bit(&self->bitbang, bit);
+        return;
+    }
+    uint8_t slot = bit ? UART_SLOT_READ : UART_SLOT_WRITE_0;
+    uart_slots(self, &slot, 1);
+}
+
+// Bytes go least significant bit first. Over a UART a whole chunk of slots
+// is sent at once.
+void common_hal_busio_onewire_read(busio_onewire_obj_t* self, uint8_t* data, size_t len) {
+    if (!self->use_uart) {
+        for (size_t i = 0; i < len; i++) {
+            uint8_t byte = 0;
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                if (shared_module_bitbangio_onewire_read_bit(&self->bitbang)) {
+                    byte |= 1 << bit;
+                }
+            }
+            data[i] = byte;
+        }
+        return;
+    }
+    uint8_t slots[ONEWIRE_UART_CHUNK];
+    while (len > 0) {
+        size_t count = MIN(len, ONEWIRE_UART_CHUNK / 8);
+        memset(slots, UART_SLOT_READ, count * 8);
+        uart_slots(self, slots, count * 8);
+        for (size_t i = 0; i < count; i++) {
+            uint8_t byte = 0;
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                if (slots[i * 8 + bit] == UART_SLOT_READ) {
+                    byte |= 1 << bit;
+                }
+            }
+            data[i] = byte;
+        }
+        data += count;
+        len -= count;
+    }
+}
+
+void common_hal_busio_onewire_write(busio_onewire_obj_t* self, const uint8_t* data, size_t len) {
+    if (!self->use_uart) {
+        for (size_t i = 0; i < len; i++) {
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                shared_module_bitbangio_onewire_write_bit(&self->bitbang, (data[i] >> bit) & 1);
+            }
+        }
+        return;
+    }
+    uint8_t slots[ONEWIRE_UART_CHUNK];
+    while (len > 0) {
+        size_t count = MIN(len, ONEWIRE_UART_CHUNK / 8);
+        for (size_t i = 0; i < count; i++) {
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                slots[i * 8 + bit] = ((data[i] >> bit) & 1) ? UART_SLOT_READ : UART_SLOT_WRITE_0;
+            }
+        }
+        uart_slots(self, slots, count * 8);
+        data += count;
+        len -= count;
+    }
+}
+
+// Dallas/Maxim CRC-8 of a ROM code, which is 0 over all eight bytes when it's
+// valid.
+STATIC uint8_t rom_crc8(const uint8_t* rom) {
+    uint8_t crc = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+        uint8_t byte = rom[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            uint8_t mix = (crc ^ byte) & 1;
+            crc >>= 1;
+            if (mix) {
+                crc ^= 0x8c;
+            }
+            byte >>= 1;
+        }
+    }
+    return crc;
+}
+
+// Reads a ROM bit and its complement, in one UART transfer when possible.
+STATIC uint8_t read_bit_pair(busio_onewire_obj_t* self) {
+    if (!self->use_uart) {
+        uint8_t bits = shared_module_bitbangio_onewire_read_bit(&self->bitbang);
+        return bits | shared_module_bitbangio_onewire_read_bit(&self->bitbang) << 1;
+    }
+    uint8_t slots[2] = {UART_SLOT_READ, UART_SLOT_READ};
+    uart_slots(self, slots, 2);
+    return (slots[0] == UART_SLOT_READ) | (slots[1] == UART_SLOT_READ) << 1;
+}
+
+// One pass of the ROM search in Maxim application note 187. rom holds the
+// previous result and *last_discrepancy the bit (1-64) where that pass chose
+// 0 over 1, or 0 before the first pass. Sets *last_discrepancy to 0 after the
+// last device. Returns false when no (further) device answers correctly.
+bool common_hal_busio_onewire_search(busio_onewire_obj_t* self, uint8_t* rom, uint8_t* last_discrepancy) {
+    if (common_hal_busio_onewire_reset(self)) {
+        return false;
+    }
+    const uint8_t command = ROM_SEARCH;
+    common_hal_busio_onewire_write(self, &command, 1);
+
+    uint8_t last_zero = 0;
+    for (uint8_t bit_number = 1; bit_number <= 64; bit_number++) {
+        uint8_t byte = (bit_number - 1) / 8;
+        uint8_t mask = 1 << ((bit_number - 1) % 8);
+        uint8_t bits = read_bit_pair(self);
+        bool direction;
+        if (bits == 0x3) {
+            // Nothing answered.
+            return false;
+        } else if (bits != 0) {
+            // Every remaining device has the same bit here.
+            direction = bits & 1;
+        } else if (bit_number < *last_discrepancy) {
+            direction = (rom[byte] & mask) != 0;
+        } else {
+            direction = bit_number == *last_discrepancy;
+        }
+        if (bits == 0 && !direction) {
+            last_zero = bit_number;
+        }
+        if (direction) {
+            rom[byte] |= mask;
+        } else {
+            rom[byte] &= ~mask;
+        }
+        common_hal_busio_onewire_write_bit(self, direction);
+    }
+    *last_discrepancy = last_zero;
+    return rom_crc8(rom) == 0;
 }
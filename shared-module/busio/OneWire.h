@@ -27,13 +27,22 @@
 #ifndef MICROPY_INCLUDED_ATMEL_SAMD_SHARED_MODULE_BUSIO_ONEWIRE_H
 #define MICROPY_INCLUDED_ATMEL_SAMD_SHARED_MODULE_BUSIO_ONEWIRE_H
 
+#include "common-hal/busio/UART.h"
 #include "shared-module/bitbangio/types.h"
 
 #include "py/obj.h"
 
+// Slots sent to the UART in one go. The receive buffer must hold their echo.
+#define ONEWIRE_UART_CHUNK 64
+
 typedef struct {
     mp_obj_base_t base;
     bitbangio_onewire_obj_t bitbang;
+    // When use_uart is set every time slot is a character on the UART instead
+    // of bitbanged. The UART transmits and receives in the background so
+    // interrupts stay on.
+    busio_uart_obj_t uart;
+    bool use_uart;
 } busio_onewire_obj_t;
 
 #endif // MICROPY_INCLUDED_ATMEL_SAMD_SHARED_MODULE_BUSIO_ONEWIRE_H
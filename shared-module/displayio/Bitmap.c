@@ -64,10 +64,11 @@ void common_hal_displayio_bitmap_construct(displayio_bitmap_t *self, uint32_t wi
     self->x_mask = (1 << self->x_shift) - 1; // Used as a modulus on the x value
     self->bitmask = (1 << bits_per_value) - 1;
 
-    self->dirty_area.x1 = 0;
-    self->dirty_area.x2 = width;
-    self->dirty_area.y1 = 0;
-    self->dirty_area.y2 = height;
+    self->dirty_areas[0].x1 = 0;
+    self->dirty_areas[0].x2 = width;
+    self->dirty_areas[0].y1 = 0;
+    self->dirty_areas[0].y2 = height;
+    self->dirty_area_count = 1;
 }
 
 uint16_t common_hal_displayio_bitmap_get_height(displayio_bitmap_t *self) {
@@ -105,38 +106,64 @@ uint32_t common_hal_displayio_bitmap_get_pixel(displayio_bitmap_t *self, int16_t
     return 0;
 }
 
-void common_hal_displayio_bitmap_set_pixel(displayio_bitmap_t *self, int16_t x, int16_t y, uint32_t value) {
-    if (self->read_only) {
-        mp_raise_RuntimeError(translate("Read-only object"));
+STATIC bool _areas_touch(const displayio_area_t* a, const displayio_area_t* b) {
+    return a->x1 <= b->x2 && b->x1 <= a->x2 && a->y1 <= b->y2 && b->y1 <= a->y2;
+}
+
+// Adds the given area to the dirty areas. It grows a dirty area that it touches. Otherwise it gets
+// its own, and when there are none left the two areas that grow the least when combined are.
+void displayio_bitmap_mark_dirty(displayio_bitmap_t *self, int16_t x1, int16_t y1, int16_t x2, int16_t y2) {
+    if (x1 >= x2 || y1 >= y2) {
+        return;
     }
-    // Update the dirty area.
-    if (self->dirty_area.x1 == self->dirty_area.x2) {
-        self->dirty_area.x1 = x;
-        self->dirty_area.x2 = x + 1;
-        self->dirty_area.y1 = y;
-        self->dirty_area.y2 = y + 1;
-    } else {
-        if (x < self->dirty_area.x1) {
-            self->dirty_area.x1 = x;
-        } else if (x >= self->dirty_area.x2) {
-            self->dirty_area.x2 = x + 1;
+    displayio_area_t area = {x1, y1, x2, y2, NULL};
+    displayio_area_t* areas = self->dirty_areas;
+    for (uint8_t i = 0; i < self->dirty_area_count; i++) {
+        if (_areas_touch(&areas[i], &area)) {
+            displayio_area_expand(&areas[i], &area);
+            return;
         }
-        if (y < self->dirty_area.y1) {
-            self->dirty_area.y1 = y;
-        } else if (y >= self->dirty_area.y2) {
-            self->dirty_area.y2 = y + 1;
+    }
+    if (self->dirty_area_count < DISPLAYIO_BITMAP_DIRTY_AREAS) {
+        displayio_area_copy(&area, &areas[self->dirty_area_count]);
+        self->dirty_area_count++;
+        return;
+    }
+    // Index DISPLAYIO_BITMAP_DIRTY_AREAS stands for the new area.
+    uint8_t best_a = 0;
+    uint8_t best_b = DISPLAYIO_BITMAP_DIRTY_AREAS;
+    int32_t best_growth = INT32_MAX;
+    for (uint8_t a = 0; a < DISPLAYIO_BITMAP_DIRTY_AREAS; a++) {
+        for (uint8_t b = a + 1; b <= DISPLAYIO_BITMAP_DIRTY_AREAS; b++) {
+            const displayio_area_t* other = b < DISPLAYIO_BITMAP_DIRTY_AREAS ? &areas[b] : &area;
+            displayio_area_t combined;
+            displayio_area_union(&areas[a], other, &combined);
+            int32_t growth = displayio_area_size(&combined) - displayio_area_size(&areas[a]) -
+                displayio_area_size(other);
+            if (growth < best_growth) {
+                best_growth = growth;
+                best_a = a;
+                best_b = b;
+            }
         }
     }
+    if (best_b == DISPLAYIO_BITMAP_DIRTY_AREAS) {
+        displayio_area_expand(&areas[best_a], &area);
+    } else {
+        displayio_area_expand(&areas[best_a], &areas[best_b]);
+        displayio_area_copy(&area, &areas[best_b]);
+    }
+}
 
-    // Update our data
+void displayio_bitmap_write_pixel(displayio_bitmap_t *self, int16_t x, int16_t y, uint32_t value) {
     int32_t row_start = y * self->stride;
     uint32_t bytes_per_value = self->bits_per_value / 8;
     if (bytes_per_value < 1) {
         uint32_t bit_position = (sizeof(size_t) * 8 - ((x & self->x_mask) + 1) * self->bits_per_value);
         uint32_t index = row_start + (x >> self->x_shift);
-        uint32_t word = self->data[index];
-        word &= ~(self->bitmask << bit_position);
-        word |= (value & self->bitmask) << bit_position;
+        size_t word = self->data[index];
+        word &= ~((size_t) self->bitmask << bit_position);
+        word |= (size_t) (value & self->bitmask) << bit_position;
         self->data[index] = word;
     } else {
         size_t* row = self->data + row_start;
@@ -150,15 +177,147 @@ void common_hal_displayio_bitmap_set_pixel(displayio_bitmap_t *self, int16_t x,
     }
 }
 
+void common_hal_displayio_bitmap_set_pixel(displayio_bitmap_t *self, int16_t x, int16_t y, uint32_t value) {
+    if (self->read_only) {
+        mp_raise_RuntimeError(translate("Read-only object"));
+    }
+    displayio_bitmap_mark_dirty(self, x, y, x + 1, y + 1);
+    displayio_bitmap_write_pixel(self, x, y, value);
+}
+
+void common_hal_displayio_bitmap_fill_region(displayio_bitmap_t *self, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint32_t value) {
+    if (self->read_only) {
+        mp_raise_RuntimeError(translate("Read-only object"));
+    }
+    if (x1 < 0) {
+        x1 = 0;
+    }
+    if (y1 < 0) {
+        y1 = 0;
+    }
+    if (x2 > self->width) {
+        x2 = self->width;
+    }
+    if (y2 > self->height) {
+        y2 = self->height;
+    }
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+    displayio_bitmap_mark_dirty(self, x1, y1, x2, y2);
+
+    // Every value in a word is the same so its layout doesn't depend on byte order.
+    size_t word = 0;
+    value &= self->bits_per_value == 32 ? 0xffffffff : ((1u << self->bits_per_value) - 1);
+    for (uint8_t i = 0; i < sizeof(size_t) * 8; i += self->bits_per_value) {
+        word |= ((size_t) value) << i;
+    }
+    uint32_t values_per_word = self->x_mask + 1;
+    for (int16_t y = y1; y < y2; y++) {
+        int16_t x = x1;
+        while (x < x2 && (x & self->x_mask) != 0) {
+            displayio_bitmap_write_pixel(self, x, y, value);
+            x++;
+        }
+        size_t* row = self->data + y * self->stride;
+        while (x + values_per_word <= (uint32_t) x2) {
+            row[x >> self->x_shift] = word;
+            x += values_per_word;
+        }
+        while (x < x2) {
+            displayio_bitmap_write_pixel(self, x, y, value);
+            x++;
+        }
+    }
+}
+
+void common_hal_displayio_bitmap_fill(displayio_bitmap_t *self, uint32_t value) {
+    common_hal_displayio_bitmap_fill_region(self, 0, 0, self->width, self->height, value);
+}
+
+void common_hal_displayio_bitmap_blit(displayio_bitmap_t *self, int16_t x, int16_t y, displayio_bitmap_t *source,
+        int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint32_t skip_index, bool skip_index_none) {
+    if (self->read_only) {
+        mp_raise_RuntimeError(translate("Read-only object"));
+    }
+    // Clip the source area to the source and then to where it lands in the destination.
+    if (x1 < 0) {
+        x -= x1;
+        x1 = 0;
+    }
+    if (y1 < 0) {
+        y -= y1;
+        y1 = 0;
+    }
+    if (x2 > source->width) {
+        x2 = source->width;
+    }
+    if (y2 > source->height) {
+        y2 = source->height;
+    }
+    if (x < 0) {
+        x1 -= x;
+        x = 0;
+    }
+    if (y < 0) {
+        y1 -= y;
+        y = 0;
+    }
+    if (x + (x2 - x1) > self->width) {
+        x2 = x1 + self->width - x;
+    }
+    if (y + (y2 - y1) > self->height) {
+        y2 = y1 + self->height - y;
+    }
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+    int16_t width = x2 - x1;
+    int16_t height = y2 - y1;
+    displayio_bitmap_mark_dirty(self, x, y, x + width, y + height);
+
+    // Copy in the order that doesn't overwrite source pixels before they're read.
+    bool bottom_up = source == self && y > y1;
+    bool right_to_left = source == self && y == y1 && x > x1;
+    uint32_t bytes_per_value = self->bits_per_value / 8;
+    for (int16_t i = 0; i < height; i++) {
+        int16_t row = bottom_up ? height - 1 - i : i;
+        if (skip_index_none && source->bits_per_value == self->bits_per_value && bytes_per_value > 0) {
+            uint8_t* dest_row = (uint8_t*) (self->data + (y + row) * self->stride);
+            uint8_t* source_row = (uint8_t*) (source->data + (y1 + row) * source->stride);
+            memmove(dest_row + x * bytes_per_value, source_row + x1 * bytes_per_value, width * bytes_per_value);
+            continue;
+        }
+        for (int16_t j = 0; j < width; j++) {
+            int16_t column = right_to_left ? width - 1 - j : j;
+            uint32_t value = common_hal_displayio_bitmap_get_pixel(source, x1 + column, y1 + row);
+            if (skip_index_none || value != skip_index) {
+                displayio_bitmap_write_pixel(self, x + column, y + row, value);
+            }
+        }
+    }
+}
+
 displayio_area_t* displayio_bitmap_get_refresh_areas(displayio_bitmap_t *self, displayio_area_t* tail) {
-    if (self->dirty_area.x1 == self->dirty_area.x2) {
-        return tail;
+    for (uint8_t i = 0; i < self->dirty_area_count; i++) {
+        self->dirty_areas[i].next = tail;
+        tail = &self->dirty_areas[i];
     }
-    self->dirty_area.next = tail;
-    return &self->dirty_area;
+    return tail;
 }
 
 void displayio_bitmap_finish_refresh(displayio_bitmap_t *self) {
-    self->dirty_area.x1 = 0;
-    self->dirty_area.x2 = 0;
+    self->dirty_area_count = 0;
+}
+
+STATIC void _draw_span(void* target, int16_t x1, int16_t x2, int16_t y, uint32_t value) {
+    common_hal_displayio_bitmap_fill_region(target, x1, y, x2, y + 1, value);
+}
+
+void displayio_bitmap_get_pen(displayio_bitmap_t *self, uint32_t value, uint8_t ramp, displayio_vector_pen_t* pen) {
+    pen->span = _draw_span;
+    pen->target = self;
+    pen->value = value;
+    pen->height = self->height;
+    pen->ramp = ramp;
 }
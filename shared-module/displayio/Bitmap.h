@@ -32,6 +32,11 @@
 
 #include "py/obj.h"
 #include "shared-module/displayio/area.h"
+#include "shared-module/displayio/vector.h"
+
+// Changes are tracked in up to this many areas so that changes far apart don't refresh everything
+// between them.
+#define DISPLAYIO_BITMAP_DIRTY_AREAS 4
 
 typedef struct {
     mp_obj_base_t base;
@@ -42,12 +47,19 @@ typedef struct {
     uint8_t bits_per_value;
     uint8_t x_shift;
     size_t x_mask;
-    displayio_area_t dirty_area;
+    displayio_area_t dirty_areas[DISPLAYIO_BITMAP_DIRTY_AREAS];
     uint16_t bitmask;
+    uint8_t dirty_area_count;
     bool read_only;
 } displayio_bitmap_t;
 
 void displayio_bitmap_finish_refresh(displayio_bitmap_t *self);
 displayio_area_t* displayio_bitmap_get_refresh_areas(displayio_bitmap_t *self, displayio_area_t* tail);
+// Sets up pen to draw value, and ramp - 1 values after it, into the bitmap.
+void displayio_bitmap_get_pen(displayio_bitmap_t *self, uint32_t value, uint8_t ramp, displayio_vector_pen_t* pen);
+// For drawing code that changes many pixels: write them without tracking each one and then mark
+// the area they're in once. Pixels must be within the bitmap.
+void displayio_bitmap_write_pixel(displayio_bitmap_t *self, int16_t x, int16_t y, uint32_t value);
+void displayio_bitmap_mark_dirty(displayio_bitmap_t *self, int16_t x1, int16_t y1, int16_t x2, int16_t y2);
 
 #endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_BITMAP_H
@@ -26,8 +26,14 @@
 
 #include "shared-bindings/displayio/ColorConverter.h"
 
+#include <string.h>
+
 #include "py/misc.h"
 
+#if defined(__ARM_FEATURE_SIMD32)
+#include <arm_acle.h>
+#endif
+
 uint32_t displayio_colorconverter_dither_noise_1 (uint32_t n)
 {
   n = (n >> 13) ^ n;
@@ -39,8 +45,14 @@ uint32_t displayio_colorconverter_dither_noise_2(uint32_t x, uint32_t y) {
     return displayio_colorconverter_dither_noise_1(x + y * 0xFFFF);
 }
 
+STATIC void _invalidate_cache(displayio_colorconverter_t* self) {
+    memset(self->cached_valid, 0, sizeof(self->cached_valid));
+}
+
 void common_hal_displayio_colorconverter_construct(displayio_colorconverter_t* self, bool dither) {
     self->dither = dither;
+    memset(&self->cached_colorspace, 0, sizeof(self->cached_colorspace));
+    _invalidate_cache(self);
 }
 
 uint16_t displayio_colorconverter_compute_rgb565(uint32_t color_rgb888) {
@@ -130,58 +142,96 @@ bool common_hal_displayio_colorconverter_get_dither(displayio_colorconverter_t*
     return self->dither;
 }
 
-void displayio_colorconverter_convert(displayio_colorconverter_t *self, const _displayio_colorspace_t* colorspace, const displayio_input_pixel_t *input_pixel, displayio_output_pixel_t *output_color) {
-    uint32_t pixel = input_pixel->pixel;
-    
-    if (self->dither){
-        uint8_t randr = (displayio_colorconverter_dither_noise_2(input_pixel->tile_x,input_pixel->tile_y));
-        uint8_t randg = (displayio_colorconverter_dither_noise_2(input_pixel->tile_x+33,input_pixel->tile_y));
-        uint8_t randb = (displayio_colorconverter_dither_noise_2(input_pixel->tile_x,input_pixel->tile_y+33));
-
-        uint32_t r8 = (pixel >> 16);
-        uint32_t g8 = (pixel >> 8) & 0xff;
-        uint32_t b8 = pixel & 0xff;
-
-        if (colorspace->depth == 16) {
-            b8 = MIN(255,b8 + (randb&0x07));
-            r8 = MIN(255,r8 + (randr&0x07));
-            g8 = MIN(255,g8 + (randg&0x03));
-        } else {
-            int bitmask = 0xFF >> colorspace->depth;
-            b8 = MIN(255,b8 + (randb&bitmask));
-            r8 = MIN(255,r8 + (randr&bitmask));
-            g8 = MIN(255,g8 + (randg&bitmask));
-        }
-        pixel = r8 << 16 | g8 << 8 | b8;
+// Adds location based noise to pixel before it is truncated to the colorspace's depth.
+STATIC uint32_t _dither(const _displayio_colorspace_t* colorspace, uint32_t pixel, uint16_t x, uint16_t y) {
+    uint8_t randr = (displayio_colorconverter_dither_noise_2(x, y));
+    uint8_t randg = (displayio_colorconverter_dither_noise_2(x + 33, y));
+    uint8_t randb = (displayio_colorconverter_dither_noise_2(x, y + 33));
+
+    uint32_t noise;
+    if (colorspace->depth == 16) {
+        noise = (randr & 0x07) << 16 | (randg & 0x03) << 8 | (randb & 0x07);
+    } else {
+        uint8_t bitmask = 0xFF >> colorspace->depth;
+        noise = (randr & bitmask) << 16 | (randg & bitmask) << 8 | (randb & bitmask);
     }
+    #if defined(__ARM_FEATURE_SIMD32)
+    // Saturating add of all three channels at once.
+    return __uqadd8(pixel, noise);
+    #else
+    uint32_t r8 = MIN(255, (pixel >> 16) + (noise >> 16));
+    uint32_t g8 = MIN(255, ((pixel >> 8) & 0xff) + ((noise >> 8) & 0xff));
+    uint32_t b8 = MIN(255, (pixel & 0xff) + (noise & 0xff));
+    return r8 << 16 | g8 << 8 | b8;
+    #endif
+}
 
+STATIC bool _supported(const _displayio_colorspace_t* colorspace) {
+    return colorspace->depth == 16 || colorspace->tricolor ||
+           (colorspace->grayscale && colorspace->depth <= 8);
+}
+
+// The colorspace must be supported.
+STATIC uint32_t _convert_pixel(const _displayio_colorspace_t* colorspace, uint32_t pixel) {
     if (colorspace->depth == 16) {
-        output_color->pixel = displayio_colorconverter_compute_rgb565(pixel);
-        output_color->opaque = true;
-        return;
+        return displayio_colorconverter_compute_rgb565(pixel);
     } else if (colorspace->tricolor) {
         uint8_t luma = displayio_colorconverter_compute_luma(pixel);
-        output_color->pixel = luma >> (8 - colorspace->depth);
+        uint32_t color = luma >> (8 - colorspace->depth);
         if (displayio_colorconverter_compute_chroma(pixel) <= 16) {
             if (!colorspace->grayscale) {
-                output_color->pixel = 0;
+                color = 0;
             }
-            output_color->opaque = true;
-            return;
+            return color;
         }
         uint8_t pixel_hue = displayio_colorconverter_compute_hue(pixel);
-        displayio_colorconverter_compute_tricolor(colorspace, pixel_hue, luma, &output_color->pixel);
-        return;
-    }  else if (colorspace->grayscale && colorspace->depth <= 8) {
-        uint8_t luma = displayio_colorconverter_compute_luma(pixel);
-        output_color->pixel = luma >> (8 - colorspace->depth);
-        output_color->opaque = true;
+        displayio_colorconverter_compute_tricolor(colorspace, pixel_hue, luma, &color);
+        return color;
+    }
+    uint8_t luma = displayio_colorconverter_compute_luma(pixel);
+    return luma >> (8 - colorspace->depth);
+}
+
+void displayio_colorconverter_convert(displayio_colorconverter_t *self, const _displayio_colorspace_t* colorspace, const displayio_input_pixel_t *input_pixel, displayio_output_pixel_t *output_color) {
+    if (!_supported(colorspace)) {
+        output_color->opaque = false;
         return;
     }
-    output_color->opaque = false;
+    uint32_t pixel = input_pixel->pixel;
+    if (self->dither) {
+        pixel = _dither(colorspace, pixel, input_pixel->tile_x, input_pixel->tile_y);
+    }
+    output_color->pixel = _convert_pixel(colorspace, pixel);
+    output_color->opaque = true;
 }
 
+bool displayio_colorconverter_convert_row(displayio_colorconverter_t *self, const _displayio_colorspace_t* colorspace, const uint32_t* input, uint16_t x, uint16_t y, uint32_t* output, uint16_t count) {
+    if (!_supported(colorspace)) {
+        return false;
+    }
+    if (self->dither) {
+        for (uint16_t i = 0; i < count; i++) {
+            output[i] = _convert_pixel(colorspace, _dither(colorspace, input[i], x + i, y));
+        }
+        return true;
+    }
 
+    if (memcmp(&self->cached_colorspace, colorspace, sizeof(_displayio_colorspace_t)) != 0) {
+        self->cached_colorspace = *colorspace;
+        _invalidate_cache(self);
+    }
+    for (uint16_t i = 0; i < count; i++) {
+        uint32_t pixel = input[i];
+        uint8_t index = (pixel ^ (pixel >> 8) ^ (pixel >> 16)) % DISPLAYIO_COLORCONVERTER_CACHE_SIZE;
+        if (!self->cached_valid[index] || self->cached_input[index] != pixel) {
+            self->cached_input[index] = pixel;
+            self->cached_output[index] = _convert_pixel(colorspace, pixel);
+            self->cached_valid[index] = true;
+        }
+        output[i] = self->cached_output[index];
+    }
+    return true;
+}
 
 // Currently no refresh logic is needed for a ColorConverter.
 bool displayio_colorconverter_needs_refresh(displayio_colorconverter_t *self) {
@@ -33,14 +33,26 @@
 #include "py/obj.h"
 #include "shared-module/displayio/Palette.h"
 
+// Number of entries in the direct-mapped cache of recently converted colors.
+#define DISPLAYIO_COLORCONVERTER_CACHE_SIZE (16)
+
 typedef struct {
     mp_obj_base_t base;
+    // Recent input colors and their conversions for cached_colorspace. Only used without dither
+    // because dithering depends on the pixel location.
+    uint32_t cached_input[DISPLAYIO_COLORCONVERTER_CACHE_SIZE];
+    uint32_t cached_output[DISPLAYIO_COLORCONVERTER_CACHE_SIZE];
+    bool cached_valid[DISPLAYIO_COLORCONVERTER_CACHE_SIZE];
+    _displayio_colorspace_t cached_colorspace;
     bool dither;
 } displayio_colorconverter_t;
 
 bool displayio_colorconverter_needs_refresh(displayio_colorconverter_t *self);
 void displayio_colorconverter_finish_refresh(displayio_colorconverter_t *self);
 void displayio_colorconverter_convert(displayio_colorconverter_t *self, const _displayio_colorspace_t* colorspace, const displayio_input_pixel_t *input_pixel, displayio_output_pixel_t *output_color);
+// Converts count RGB888 pixels from a bitmap row starting at x, y. Returns false when the colorspace
+// isn't supported, in which case all of the pixels are transparent.
+bool displayio_colorconverter_convert_row(displayio_colorconverter_t *self, const _displayio_colorspace_t* colorspace, const uint32_t* input, uint16_t x, uint16_t y, uint32_t* output, uint16_t count);
 
 uint32_t displayio_colorconverter_dither_noise_1 (uint32_t n);
 uint32_t displayio_colorconverter_dither_noise_2(uint32_t x, uint32_t y);
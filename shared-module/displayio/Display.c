@@ -27,14 +27,17 @@
 #include "shared-bindings/displayio/Display.h"
 
 #include "py/runtime.h"
-#include "shared-bindings/displayio/FourWire.h"
-#include "shared-bindings/displayio/I2CDisplay.h"
-#include "shared-bindings/displayio/ParallelBus.h"
+#if CIRCUITPY_DISPLAYIO_HARDWARE
 #include "shared-bindings/microcontroller/Pin.h"
+#endif
 #include "shared-bindings/time/__init__.h"
 #include "shared-module/displayio/__init__.h"
 #include "shared-module/displayio/display_core.h"
+#include "shared-module/displayio/mipi_constants.h"
 #include "supervisor/shared/display.h"
+#if CIRCUITPY_BOOT_TIMING
+#include "supervisor/shared/boot_timing.h"
+#endif
 #include "supervisor/shared/tick.h"
 #include "supervisor/usb.h"
 
@@ -43,12 +46,59 @@
 
 #include "tick.h"
 
+STATIC void _send_command(displayio_display_obj_t* self, uint8_t command, uint8_t* data, uint8_t data_size) {
+    while (!displayio_display_core_begin_transaction(&self->core)) {
+        RUN_BACKGROUND_TASKS;
+    }
+    if (self->data_as_commands) {
+        uint8_t full_command[data_size + 1];
+        full_command[0] = command;
+        memcpy(full_command + 1, data, data_size);
+        self->core.send(self->core.bus, DISPLAY_COMMAND, CHIP_SELECT_TOGGLE_EVERY_BYTE, full_command, data_size + 1);
+    } else {
+        self->core.send(self->core.bus, DISPLAY_COMMAND, CHIP_SELECT_TOGGLE_EVERY_BYTE, &command, 1);
+        self->core.send(self->core.bus, DISPLAY_DATA, CHIP_SELECT_UNTOUCHED, data, data_size);
+    }
+    displayio_display_core_end_transaction(&self->core);
+}
+
+STATIC void _send_rotation(displayio_display_obj_t* self) {
+    if (self->rotation_command == NO_COMMAND) {
+        return;
+    }
+    _send_command(self, self->rotation_command, &self->rotation_values[(self->core.rotation / 90) % 4], 1);
+}
+
+// Scrolling moves rows along the panel's own vertical axis so it is only used without rotation.
+STATIC bool _hardware_scroll_available(displayio_display_obj_t* self) {
+    return self->vertical_scroll_lines > 0 && self->core.rotation == 0;
+}
+
+STATIC void _send_scroll_start(displayio_display_obj_t* self) {
+    uint16_t start = self->core.rowstart + self->scroll_offset;
+    uint8_t data[2] = {start >> 8, start & 0xff};
+    _send_command(self, self->set_vertical_scroll, data, 2);
+}
+
+STATIC void _set_terminal_scroll(bool hardware_scroll) {
+    displayio_tilegrid_t* grid = &supervisor_terminal_text_grid;
+    if (grid->hardware_scroll == hardware_scroll) {
+        return;
+    }
+    grid->hardware_scroll = hardware_scroll;
+    // Pending changes were tracked for the other mode.
+    if (grid->scrolled_pixels != 0) {
+        grid->scrolled_pixels = 0;
+        grid->full_change = true;
+    }
+}
+
 void common_hal_displayio_display_construct(displayio_display_obj_t* self,
         mp_obj_t bus, uint16_t width, uint16_t height, int16_t colstart, int16_t rowstart,
         uint16_t rotation, uint16_t color_depth, bool grayscale, bool pixels_in_byte_share_row,
         uint8_t bytes_per_cell, bool reverse_pixels_in_byte, uint8_t set_column_command,
         uint8_t set_row_command, uint8_t write_ram_command, uint8_t set_vertical_scroll,
-        uint8_t* init_sequence, uint16_t init_sequence_len, const mcu_pin_obj_t* backlight_pin,
+        uint16_t vertical_scroll_lines, uint16_t rotation_command, const uint8_t* rotation_values, uint8_t* init_sequence, uint16_t init_sequence_len, const mcu_pin_obj_t* backlight_pin,
         uint16_t brightness_command, mp_float_t brightness, bool auto_brightness,
         bool single_byte_bounds, bool data_as_commands, bool auto_refresh, uint16_t native_frames_per_second) {
     // Turn off auto-refresh as we init.
@@ -59,12 +109,22 @@ void common_hal_displayio_display_construct(displayio_display_obj_t* self,
         ram_width = 0xff;
         ram_height = 0xff;
     }
-    displayio_display_core_construct(&self->core, bus, width, height, ram_width, ram_height, colstart, rowstart, rotation,
+    self->rotation_command = rotation_command;
+    if (rotation_command != NO_COMMAND) {
+        memcpy(self->rotation_values, rotation_values, sizeof(self->rotation_values));
+    }
+    // The panel rotates itself when it has a rotation command so compositing uses the identity
+    // transform.
+    uint16_t software_rotation = rotation_command == NO_COMMAND ? rotation : 0;
+    displayio_display_core_construct(&self->core, bus, width, height, ram_width, ram_height, colstart, rowstart, software_rotation,
         color_depth, grayscale, pixels_in_byte_share_row, bytes_per_cell, reverse_pixels_in_byte);
+    self->core.rotation = rotation % 360;
+    displayio_display_core_allocate_buffers(&self->core);
 
     self->set_column_command = set_column_command;
     self->set_row_command = set_row_command;
     self->write_ram_command = write_ram_command;
+    self->set_vertical_scroll = set_vertical_scroll;
     self->brightness_command = brightness_command;
     self->auto_brightness = auto_brightness;
     self->first_manual_refresh = !auto_refresh;
@@ -72,6 +132,8 @@ void common_hal_displayio_display_construct(displayio_display_obj_t* self,
 
     self->native_frames_per_second = native_frames_per_second;
     self->native_ms_per_frame = 1000 / native_frames_per_second;
+    memset(&self->stats, 0, sizeof(self->stats));
+    self->refresh_in_progress = false;
 
     uint32_t i = 0;
     while (i < init_sequence_len) {
@@ -104,9 +166,26 @@ void common_hal_displayio_display_construct(displayio_display_obj_t* self,
         common_hal_time_delay_ms(delay_length_ms);
         i += 2 + data_size;
     }
+    _send_rotation(self);
+
+    // Divide display memory into a fixed top area for rowstart, the visible rows that scroll and
+    // whatever rows are left below them.
+    uint16_t panel_rows = self->core.rotation % 180 == 0 ? height : width;
+    self->scroll_offset = 0;
+    self->vertical_scroll_lines = 0;
+    if (set_vertical_scroll != 0 && vertical_scroll_lines >= rowstart + panel_rows) {
+        self->vertical_scroll_lines = vertical_scroll_lines;
+        uint16_t bottom_rows = vertical_scroll_lines - rowstart - panel_rows;
+        uint8_t scroll_area[6] = {rowstart >> 8, rowstart & 0xff, panel_rows >> 8, panel_rows & 0xff,
+            bottom_rows >> 8, bottom_rows & 0xff};
+        _send_command(self, MIPI_COMMAND_SET_SCROLL_AREA, scroll_area, sizeof(scroll_area));
+        _send_scroll_start(self);
+    }
 
     supervisor_start_terminal(width, height);
 
+    bool has_backlight = false;
+    #if CIRCUITPY_DISPLAYIO_HARDWARE
     // Always set the backlight type in case we're reusing memory.
     self->backlight_inout.base.type = &mp_type_NoneType;
     if (backlight_pin != NULL && common_hal_mcu_pin_is_free(backlight_pin)) {
@@ -120,8 +199,9 @@ void common_hal_displayio_display_construct(displayio_display_obj_t* self,
             common_hal_pulseio_pwmout_never_reset(&self->backlight_pwm);
         }
     }
-    if (!self->auto_brightness && (self->backlight_inout.base.type != &mp_type_NoneType ||
-                                   brightness_command != NO_BRIGHTNESS_COMMAND)) {
+    has_backlight = self->backlight_inout.base.type != &mp_type_NoneType;
+    #endif
+    if (!self->auto_brightness && (has_backlight || brightness_command != NO_BRIGHTNESS_COMMAND)) {
         common_hal_displayio_display_set_brightness(self, brightness);
     } else {
         self->current_brightness = -1.0;
@@ -134,7 +214,15 @@ void common_hal_displayio_display_construct(displayio_display_obj_t* self,
 }
 
 bool common_hal_displayio_display_show(displayio_display_obj_t* self, displayio_group_t* root_group) {
-    return displayio_display_core_show(&self->core, root_group);
+    // Only the built-in terminal scrolls in hardware and only while the display shows it.
+    bool showed_terminal = self->core.current_group == &circuitpython_splash;
+    bool ok = displayio_display_core_show(&self->core, root_group);
+    if (self->core.current_group == &circuitpython_splash) {
+        _set_terminal_scroll(_hardware_scroll_available(self));
+    } else if (showed_terminal) {
+        _set_terminal_scroll(false);
+    }
+    return ok;
 }
 
 uint16_t common_hal_displayio_display_get_width(displayio_display_obj_t* self){
@@ -160,12 +248,15 @@ mp_float_t common_hal_displayio_display_get_brightness(displayio_display_obj_t*
 bool common_hal_displayio_display_set_brightness(displayio_display_obj_t* self, mp_float_t brightness) {
     self->updating_backlight = true;
     bool ok = false;
-    if (self->backlight_pwm.base.type == &pulseio_pwmout_type) {
+    if (false) {
+    #if CIRCUITPY_DISPLAYIO_HARDWARE
+    } else if (self->backlight_pwm.base.type == &pulseio_pwmout_type) {
         common_hal_pulseio_pwmout_set_duty_cycle(&self->backlight_pwm, (uint16_t) (0xffff * brightness));
         ok = true;
     } else if (self->backlight_inout.base.type == &digitalio_digitalinout_type) {
         common_hal_digitalio_digitalinout_set_value(&self->backlight_inout, brightness > 0.99);
         ok = true;
+    #endif
     } else if (self->brightness_command != NO_BRIGHTNESS_COMMAND) {
         ok = displayio_display_core_begin_transaction(&self->core);
         if (ok) {
@@ -203,6 +294,44 @@ STATIC const displayio_area_t* _get_refresh_areas(displayio_display_obj_t *self)
     return NULL;
 }
 
+// Scrolls the display to match the terminal and returns the areas to redraw with the parts of the
+// screen around the terminal added. The terminal must not be covered by other layers because they
+// scroll with it.
+STATIC const displayio_area_t* _scroll_terminal(displayio_display_obj_t* self, const displayio_area_t* areas) {
+    displayio_tilegrid_t* grid = &supervisor_terminal_text_grid;
+    if (!grid->hardware_scroll || grid->scrolled_pixels == 0 ||
+        self->core.current_group != &circuitpython_splash || grid->hidden || grid->hidden_by_parent) {
+        return areas;
+    }
+    uint16_t height = self->core.height;
+    uint16_t pixels = (grid->scrolled_pixels * grid->absolute_transform->scale) % height;
+    self->scroll_offset = (self->scroll_offset + pixels) % height;
+    _send_scroll_start(self);
+    if (self->core.full_refresh) {
+        return areas;
+    }
+
+    const displayio_area_t* terminal = &grid->current_area;
+    int16_t width = self->core.width;
+    int16_t y1 = terminal->y1 > 0 ? terminal->y1 : 0;
+    int16_t y2 = terminal->y2 < height ? terminal->y2 : height;
+    displayio_area_t around[4] = {
+        {0, 0, width, y1, NULL},
+        {0, y2, width, height, NULL},
+        {0, y1, terminal->x1, y2, NULL},
+        {terminal->x2, y1, width, y2, NULL},
+    };
+    for (uint8_t i = 0; i < 4; i++) {
+        if (around[i].x1 >= around[i].x2 || around[i].y1 >= around[i].y2) {
+            continue;
+        }
+        displayio_area_copy(&around[i], &self->scroll_areas[i]);
+        self->scroll_areas[i].next = areas;
+        areas = &self->scroll_areas[i];
+    }
+    return areas;
+}
+
 STATIC void _send_pixels(displayio_display_obj_t* self, uint8_t* pixels, uint32_t length) {
     if (!self->data_as_commands) {
         self->core.send(self->core.bus, DISPLAY_COMMAND, CHIP_SELECT_TOGGLE_EVERY_BYTE, &self->write_ram_command, 1);
@@ -210,14 +339,76 @@ STATIC void _send_pixels(displayio_display_obj_t* self, uint8_t* pixels, uint32_
     self->core.send(self->core.bus, DISPLAY_DATA, CHIP_SELECT_UNTOUCHED, pixels, length);
 }
 
-STATIC bool _refresh_area(displayio_display_obj_t* self, const displayio_area_t* area) {
-    uint16_t buffer_size = 128; // In uint32_ts
+STATIC void _compute_subrectangle(const displayio_area_t* clipped, uint16_t rows_per_buffer, uint16_t index, displayio_area_t* subrectangle) {
+    subrectangle->x1 = clipped->x1;
+    subrectangle->y1 = clipped->y1 + rows_per_buffer * index;
+    subrectangle->x2 = clipped->x2;
+    subrectangle->y2 = subrectangle->y1 + rows_per_buffer;
+    if (subrectangle->y2 > clipped->y2) {
+        subrectangle->y2 = clipped->y2;
+    }
+}
+
+// Microseconds that wrap around every ~71 minutes. Only use it for short durations.
+STATIC uint32_t _ticks_us(void) {
+    uint64_t ms;
+    uint32_t us_until_ms;
+    current_tick(&ms, &us_until_ms);
+    return ms * 1000 + (1000 - us_until_ms);
+}
+
+STATIC void _fill_subrectangle(displayio_display_obj_t* self, displayio_area_t* subrectangle, uint32_t* mask, uint32_t mask_length, uint32_t* buffer, uint16_t buffer_size) {
+    uint32_t start = _ticks_us();
+    memset(mask, 0, mask_length * sizeof(mask[0]));
+    memset(buffer, 0, buffer_size * sizeof(buffer[0]));
+
+    displayio_display_core_fill_area(&self->core, subrectangle, mask, buffer);
+    self->stats.composite_us += _ticks_us() - start;
+    self->stats.pixels_sent += displayio_area_size(subrectangle);
+}
+
+// Sets the region in display memory that shows the given screen area. Screen rows are offset
+// when the display is scrolled in hardware.
+STATIC void _set_region_to_update(displayio_display_obj_t* self, const displayio_area_t* area) {
+    displayio_area_t region;
+    displayio_area_copy(area, &region);
+    if (self->scroll_offset != 0) {
+        region.y1 += self->scroll_offset;
+        region.y2 += self->scroll_offset;
+        if (region.y1 >= self->core.height) {
+            region.y1 -= self->core.height;
+            region.y2 -= self->core.height;
+        }
+    }
+    displayio_display_core_set_region_to_update(&self->core, self->set_column_command, self->set_row_command, NO_COMMAND, NO_COMMAND, self->data_as_commands, false, &region);
+}
+
+// True once the time from _ticks_us() has reached deadline. A deadline of 0 is never reached.
+STATIC bool _past_deadline(uint32_t deadline) {
+    return deadline != 0 && (int32_t) (_ticks_us() - deadline) >= 0;
+}
+
+// Returns false when the area isn't finished, either because the bus is busy or because deadline
+// passed. The top of the area is moved down past the rows that were sent so it can be resumed.
+STATIC bool _refresh_area(displayio_display_obj_t* self, displayio_area_t* area, uint32_t deadline) {
+    uint16_t buffer_size = CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE; // In uint32_ts
 
     displayio_area_t clipped;
     // Clip the area to the display by overlapping the areas. If there is no overlap then we're done.
     if (!displayio_display_core_clip_area(&self->core, area, &clipped)) {
         return true;
     }
+    // Areas that wrap around the end of the scrolled rows in display memory are sent in two parts.
+    int16_t wrap_row = self->core.height - self->scroll_offset;
+    if (self->scroll_offset != 0 && clipped.y1 < wrap_row && wrap_row < clipped.y2) {
+        clipped.y2 = wrap_row;
+        if (!_refresh_area(self, &clipped, deadline)) {
+            area->y1 = clipped.y1;
+            return false;
+        }
+        area->y1 = wrap_row;
+        return _refresh_area(self, area, deadline);
+    }
     uint16_t subrectangles = 1;
     uint16_t rows_per_buffer = displayio_area_height(&clipped);
     uint8_t pixels_per_word = (sizeof(uint32_t) * 8) / self->core.colorspace.depth;
@@ -239,32 +430,51 @@ STATIC bool _refresh_area(displayio_display_obj_t* self, const displayio_area_t*
             subrectangles++;
         }
         pixels_per_buffer = rows_per_buffer * displayio_area_width(&clipped);
-        buffer_size = pixels_per_buffer / pixels_per_word;
-        if (pixels_per_buffer % pixels_per_word) {
-            buffer_size += 1;
-        }
+    }
+    buffer_size = pixels_per_buffer / pixels_per_word;
+    if (pixels_per_buffer % pixels_per_word) {
+        buffer_size += 1;
     }
 
-    // Allocated and shared as a uint32_t array so the compiler knows the
+    // Use the two buffers allocated outside the heap when we have them so that the next
+    // subrectangle can be filled while the current one is sent. Otherwise, fall back to a single
+    // buffer on the stack. Buffers are shared as uint32_t arrays so the compiler knows the
     // alignment everywhere.
-    uint32_t buffer[buffer_size];
+    uint32_t* buffers[2];
+    uint8_t buffer_count = 0;
+    // A single row can be wider than the allocated buffers.
+    if (buffer_size <= CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE) {
+        buffer_count = displayio_display_core_get_buffers(&self->core, buffers);
+    }
+    uint32_t stack_buffer[buffer_count > 0 ? 1 : buffer_size];
+    if (buffer_count == 0) {
+        buffers[0] = stack_buffer;
+        buffer_count = 1;
+    }
     uint32_t mask_length = (pixels_per_buffer / 32) + 1;
     uint32_t mask[mask_length];
-    uint16_t remaining_rows = displayio_area_height(&clipped);
+
+    displayio_area_t subrectangle;
+    displayio_area_t next_subrectangle;
+    _compute_subrectangle(&clipped, rows_per_buffer, 0, &subrectangle);
+    _fill_subrectangle(self, &subrectangle, mask, mask_length, buffers[0], buffer_size);
 
     for (uint16_t j = 0; j < subrectangles; j++) {
-        displayio_area_t subrectangle = {
-            .x1 = clipped.x1,
-            .y1 = clipped.y1 + rows_per_buffer * j,
-            .x2 = clipped.x2,
-            .y2 = clipped.y1 + rows_per_buffer * (j + 1)
-        };
-        if (remaining_rows < rows_per_buffer) {
-            subrectangle.y2 = subrectangle.y1 + remaining_rows;
+        uint32_t* buffer = buffers[j % buffer_count];
+        bool has_next = j + 1 < subrectangles;
+        if (has_next) {
+            _compute_subrectangle(&clipped, rows_per_buffer, j + 1, &next_subrectangle);
         }
-        remaining_rows -= rows_per_buffer;
 
-        displayio_display_core_set_region_to_update(&self->core, self->set_column_command, self->set_row_command, NO_COMMAND, NO_COMMAND, self->data_as_commands, false, &subrectangle);
+        // Can't acquire display bus; skip the rest of the data.
+        if (!displayio_display_core_bus_free(&self->core)) {
+            area->y1 = subrectangle.y1;
+            return false;
+        }
+        // Send this subrectangle and stop when out of time.
+        bool stop = has_next && _past_deadline(deadline);
+
+        _set_region_to_update(self, &subrectangle);
 
         uint16_t subrectangle_size_bytes;
         if (self->core.colorspace.depth >= 8) {
@@ -273,39 +483,94 @@ STATIC bool _refresh_area(displayio_display_obj_t* self, const displayio_area_t*
             subrectangle_size_bytes = displayio_area_size(&subrectangle) / (8 / self->core.colorspace.depth);
         }
 
-        memset(mask, 0, mask_length * sizeof(mask[0]));
-        memset(buffer, 0, buffer_size * sizeof(buffer[0]));
-
-        displayio_display_core_fill_area(&self->core, &subrectangle, mask, buffer);
-
-        // Can't acquire display bus; skip the rest of the data.
-        if (!displayio_display_core_bus_free(&self->core)) {
-            return false;
-        }
-
         displayio_display_core_begin_transaction(&self->core);
         _send_pixels(self, (uint8_t*) buffer, subrectangle_size_bytes);
+        // Buses that send in the background return before the pixels are out. Fill the other
+        // buffer while they go. end_transaction waits for the send to finish.
+        if (has_next && !stop && buffer_count > 1) {
+            _fill_subrectangle(self, &next_subrectangle, mask, mask_length, buffers[(j + 1) % buffer_count], buffer_size);
+        }
         displayio_display_core_end_transaction(&self->core);
 
-        // TODO(tannewt): Make refresh displays faster so we don't starve other
-        // background tasks.
-        usb_background();
+        if (stop) {
+            area->y1 = next_subrectangle.y1;
+            return false;
+        }
+        if (has_next && buffer_count == 1) {
+            _fill_subrectangle(self, &next_subrectangle, mask, mask_length, buffer, buffer_size);
+        }
+        subrectangle = next_subrectangle;
+
+        // Refreshes without a deadline don't return to the other background tasks until the
+        // whole frame is out so keep USB going.
+        if (deadline == 0) {
+            usb_background();
+        }
     }
     return true;
 }
 
-STATIC void _refresh_display(displayio_display_obj_t* self) {
+// Refreshes for at most budget_us, or the whole frame when it is 0. An unfinished frame is resumed
+// by the next call. The frame's areas are taken, and the layers' changes cleared, when it starts so
+// changes made while it is paused are drawn by the next frame.
+STATIC void _refresh_display(displayio_display_obj_t* self, uint32_t budget_us) {
     if (!displayio_display_core_bus_free(&self->core)) {
         // Can't acquire display bus; skip updating this display. Try next display.
         return;
     }
-    displayio_display_core_start_refresh(&self->core);
-    const displayio_area_t* current_area = _get_refresh_areas(self);
-    while (current_area != NULL) {
-        _refresh_area(self, current_area);
-        current_area = current_area->next;
+    uint32_t start = _ticks_us();
+    displayio_display_stats_t* stats = &self->stats;
+    if (!self->refresh_in_progress) {
+        displayio_display_core_start_refresh(&self->core);
+        const displayio_area_t* areas = _scroll_terminal(self, _get_refresh_areas(self));
+        const displayio_area_t* first_area = displayio_display_core_coalesce_areas(&self->core, areas, self->refresh_areas);
+        displayio_display_core_finish_refresh(&self->core);
+        if (first_area == NULL) {
+            return;
+        }
+        self->refresh_area_count = 0;
+        for (const displayio_area_t* area = first_area; area != NULL; area = area->next) {
+            self->refresh_area_count++;
+        }
+        self->next_area = 0;
+        self->refresh_in_progress = true;
+        self->frame_us = 0;
+        stats->composite_us = 0;
+        stats->pixels_sent = 0;
+        stats->refresh_areas = 0;
+    }
+    // Layers may have moved since the index was last built.
+    if (self->core.current_group != NULL) {
+        displayio_group_build_index(self->core.current_group);
+    }
+
+    uint32_t deadline = 0;
+    if (budget_us != 0) {
+        // Zero means no deadline so step past it.
+        deadline = (start + budget_us) | 1;
+    }
+    while (self->next_area < self->refresh_area_count) {
+        if (!_refresh_area(self, &self->refresh_areas[self->next_area], deadline) && deadline != 0) {
+            self->frame_us += _ticks_us() - start;
+            return;
+        }
+        stats->refresh_areas++;
+        self->next_area++;
+    }
+    self->refresh_in_progress = false;
+
+    stats->last_frame_us = self->frame_us + _ticks_us() - start;
+    stats->send_us = stats->last_frame_us - stats->composite_us;
+    if (stats->frames == 0) {
+        stats->average_frame_us = stats->last_frame_us;
+    } else {
+        // Exponential moving average that weighs the latest frame by 1/8.
+        stats->average_frame_us += ((int32_t) (stats->last_frame_us - stats->average_frame_us)) / 8;
     }
-    displayio_display_core_finish_refresh(&self->core);
+    stats->frames++;
+    #if CIRCUITPY_BOOT_TIMING
+    boot_timing_mark(BOOT_PHASE_FIRST_FRAME);
+    #endif
 }
 
 void common_hal_displayio_display_set_rotation(displayio_display_obj_t* self, int rotation){
@@ -316,18 +581,36 @@ void common_hal_displayio_display_set_rotation(displayio_display_obj_t* self, in
         self->core.width = self->core.height;
         self->core.height = tmp;
     }
-    displayio_display_core_set_rotation(&self->core, rotation);
+    if (self->rotation_command == NO_COMMAND) {
+        displayio_display_core_set_rotation(&self->core, rotation);
+    } else {
+        displayio_display_core_set_rotation(&self->core, 0);
+        self->core.rotation = rotation % 360;
+        _send_rotation(self);
+    }
+    if (self->vertical_scroll_lines > 0 && self->scroll_offset != 0) {
+        self->scroll_offset = 0;
+        _send_scroll_start(self);
+    }
+    if (self->core.current_group == &circuitpython_splash) {
+        _set_terminal_scroll(_hardware_scroll_available(self));
+    }
     supervisor_stop_terminal();
     supervisor_start_terminal(self->core.width, self->core.height);
     if (self->core.current_group != NULL) {
         displayio_group_update_transform(self->core.current_group, &self->core.transform);
     }
+    self->core.full_refresh = true;
 }
 
 uint16_t common_hal_displayio_display_get_rotation(displayio_display_obj_t* self){
     return self->core.rotation;
 }
 
+const displayio_display_stats_t* common_hal_displayio_display_get_stats(displayio_display_obj_t* self) {
+    return &self->stats;
+}
+
 
 bool common_hal_displayio_display_refresh(displayio_display_obj_t* self, uint32_t target_ms_per_frame, uint32_t maximum_ms_per_real_frame) {
     if (!self->auto_refresh && !self->first_manual_refresh) {
@@ -341,6 +624,7 @@ bool common_hal_displayio_display_refresh(displayio_display_obj_t* self, uint32_
         self->last_refresh_call = current_time;
         // Skip the actual refresh to help catch up.
         if (current_ms_since_last_call > target_ms_per_frame) {
+            self->stats.dropped_frames++;
             return false;
         }
         uint32_t remaining_time = target_ms_per_frame - (current_ms_since_real_refresh % target_ms_per_frame);
@@ -350,7 +634,11 @@ bool common_hal_displayio_display_refresh(displayio_display_obj_t* self, uint32_
         }
     }
     self->first_manual_refresh = false;
-    _refresh_display(self);
+    // Finish a frame that background refreshes started before drawing the current one.
+    if (self->refresh_in_progress) {
+        _refresh_display(self, 0);
+    }
+    _refresh_display(self, 0);
     return true;
 }
 
@@ -381,19 +669,26 @@ STATIC void _update_backlight(displayio_display_obj_t* self) {
 void displayio_display_background(displayio_display_obj_t* self) {
     _update_backlight(self);
 
-    if (self->auto_refresh && (supervisor_ticks_ms64() - self->core.last_refresh) > self->native_ms_per_frame) {
-        _refresh_display(self);
+    if (self->refresh_in_progress ||
+        (self->auto_refresh && (supervisor_ticks_ms64() - self->core.last_refresh) > self->native_ms_per_frame)) {
+        _refresh_display(self, CIRCUITPY_DISPLAY_REFRESH_BUDGET_US);
     }
 }
 
 void release_display(displayio_display_obj_t* self) {
+    self->refresh_in_progress = false;
+    if (self->core.current_group == &circuitpython_splash) {
+        _set_terminal_scroll(false);
+    }
     release_display_core(&self->core);
+    #if CIRCUITPY_DISPLAYIO_HARDWARE
     if (self->backlight_pwm.base.type == &pulseio_pwmout_type) {
         common_hal_pulseio_pwmout_reset_ok(&self->backlight_pwm);
         common_hal_pulseio_pwmout_deinit(&self->backlight_pwm);
     } else if (self->backlight_inout.base.type == &digitalio_digitalinout_type) {
         common_hal_digitalio_digitalinout_deinit(&self->backlight_inout);
     }
+    #endif
 }
 
 void reset_display(displayio_display_obj_t* self) {
@@ -27,34 +27,65 @@
 #ifndef MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_DISPLAY_H
 #define MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_DISPLAY_H
 
-#include "shared-bindings/digitalio/DigitalInOut.h"
 #include "shared-bindings/displayio/Group.h"
+#if CIRCUITPY_DISPLAYIO_HARDWARE
+#include "shared-bindings/digitalio/DigitalInOut.h"
 #include "shared-bindings/pulseio/PWMOut.h"
+#endif
 
 #include "shared-module/displayio/area.h"
 #include "shared-module/displayio/display_core.h"
 
+// Times are in microseconds. Everything but the frame counts and average is for the last frame
+// that refreshed at least one area.
+typedef struct {
+    uint32_t frames;
+    uint32_t dropped_frames; // Refreshes skipped because target_ms_per_frame was missed.
+    uint32_t last_frame_us;
+    uint32_t average_frame_us;
+    uint32_t composite_us; // Time spent filling pixel buffers.
+    uint32_t send_us; // Rest of the frame time, spent setting regions, sending and waiting.
+    uint32_t pixels_sent;
+    uint16_t refresh_areas;
+} displayio_display_stats_t;
+
 typedef struct {
     mp_obj_base_t base;
     displayio_display_core_t core;
+    #if CIRCUITPY_DISPLAYIO_HARDWARE
     union {
         digitalio_digitalinout_obj_t backlight_inout;
         pulseio_pwmout_obj_t backlight_pwm;
     };
+    #endif
     uint64_t last_backlight_refresh;
     uint64_t last_refresh_call;
     mp_float_t current_brightness;
     uint16_t brightness_command;
     uint16_t native_frames_per_second;
     uint16_t native_ms_per_frame;
+    uint16_t rotation_command; // NO_COMMAND when rotation is done in software.
+    uint8_t rotation_values[4]; // Data for rotation_command at 0, 90, 180 and 270 degrees.
+    uint16_t vertical_scroll_lines; // Rows in display memory. 0 when hardware scrolling is unused.
+    uint16_t scroll_offset; // Display row shown at the top of the screen, relative to rowstart.
+    displayio_area_t scroll_areas[4]; // Parts of the screen outside the terminal to redraw on scroll.
+    displayio_display_stats_t stats;
+    // Areas of the frame being refreshed. The one at next_area is first to resume with. Its top
+    // is moved down as rows are sent.
+    displayio_area_t refresh_areas[DISPLAYIO_MAX_REFRESH_AREAS];
+    uint8_t refresh_area_count;
+    uint8_t next_area;
+    uint32_t frame_us; // Time spent on the current frame so far.
     uint8_t set_column_command;
     uint8_t set_row_command;
     uint8_t write_ram_command;
+    uint8_t set_vertical_scroll;
     bool auto_refresh;
     bool first_manual_refresh;
     bool data_as_commands;
     bool auto_brightness;
     bool updating_backlight;
+    bool refresh_in_progress;
 } displayio_display_obj_t;
 
 void displayio_display_background(displayio_display_obj_t* self);
@@ -51,6 +51,7 @@ void common_hal_displayio_epaperdisplay_construct(displayio_epaperdisplay_obj_t*
         uint16_t set_column_window_command, uint16_t set_row_window_command,
         uint16_t set_current_column_command, uint16_t set_current_row_command,
         uint16_t write_black_ram_command, bool black_bits_inverted, uint16_t write_color_ram_command, bool color_bits_inverted, uint32_t highlight_color, uint16_t refresh_display_command, mp_float_t refresh_time,
+        uint8_t* partial_refresh_sequence, uint16_t partial_refresh_sequence_len, uint16_t full_refresh_interval,
         const mcu_pin_obj_t* busy_pin, bool busy_state, mp_float_t seconds_per_frame, bool chip_select) {
     if (highlight_color != 0x000000) {
         self->core.colorspace.tricolor = true;
@@ -79,6 +80,11 @@ void common_hal_displayio_epaperdisplay_construct(displayio_epaperdisplay_obj_t*
     self->start_sequence_len = start_sequence_len;
     self->stop_sequence = stop_sequence;
     self->stop_sequence_len = stop_sequence_len;
+    self->partial_refresh_sequence = partial_refresh_sequence;
+    self->partial_refresh_sequence_len = partial_refresh_sequence_len;
+    self->full_refresh_interval = full_refresh_interval;
+    self->partial_refreshes = 0;
+    self->partial_refresh = false;
 
     self->busy.base.type = &mp_type_NoneType;
     if (busy_pin != NULL) {
@@ -169,6 +175,9 @@ void displayio_epaperdisplay_start_refresh(displayio_epaperdisplay_obj_t* self)
     self->core.bus_reset(self->core.bus);
 
     send_command_sequence(self, true, self->start_sequence, self->start_sequence_len);
+    if (self->partial_refresh) {
+        send_command_sequence(self, true, self->partial_refresh_sequence, self->partial_refresh_sequence_len);
+    }
     displayio_display_core_start_refresh(&self->core);
 }
 
@@ -191,6 +200,11 @@ void displayio_epaperdisplay_finish_refresh(displayio_epaperdisplay_obj_t* self)
     displayio_display_core_end_transaction(&self->core);
     self->refreshing = true;
 
+    if (self->partial_refresh) {
+        self->partial_refreshes++;
+    } else {
+        self->partial_refreshes = 0;
+    }
     displayio_display_core_finish_refresh(&self->core);
 }
 
@@ -321,10 +335,20 @@ bool common_hal_displayio_epaperdisplay_refresh(displayio_epaperdisplay_obj_t* s
         // Can't acquire display bus; skip updating this display. Try next display.
         return false;
     }
-    const displayio_area_t* current_area = displayio_epaperdisplay_get_refresh_areas(self);
+    displayio_area_t merged[DISPLAYIO_MAX_REFRESH_AREAS];
+    const displayio_area_t* current_area = displayio_display_core_coalesce_areas(&self->core, displayio_epaperdisplay_get_refresh_areas(self), merged);
     if (current_area == NULL) {
         return true;
     }
+    // Partial refreshes only update the changed areas. Otherwise, and every full_refresh_interval
+    // partial refreshes to clear ghosting, the whole display is rewritten.
+    bool partial_capable = self->partial_refresh_sequence_len > 0 && self->set_row_window_command != NO_COMMAND;
+    self->partial_refresh = partial_capable && !self->core.full_refresh &&
+        (self->full_refresh_interval == 0 || self->partial_refreshes < self->full_refresh_interval);
+    if (partial_capable && !self->partial_refresh) {
+        self->core.area.next = NULL;
+        current_area = &self->core.area;
+    }
     displayio_epaperdisplay_start_refresh(self);
     while (current_area != NULL) {
         displayio_epaperdisplay_refresh_area(self, current_area);
@@ -369,6 +393,7 @@ void displayio_epaperdisplay_collect_ptrs(displayio_epaperdisplay_obj_t* self) {
     displayio_display_core_collect_ptrs(&self->core);
     gc_collect_ptr(self->start_sequence);
     gc_collect_ptr(self->stop_sequence);
+    gc_collect_ptr(self->partial_refresh_sequence);
 }
 
 bool maybe_refresh_epaperdisplay(void) {
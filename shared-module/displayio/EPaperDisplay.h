@@ -43,6 +43,10 @@ typedef struct {
     uint32_t start_sequence_len;
     uint8_t* stop_sequence;
     uint32_t stop_sequence_len;
+    uint8_t* partial_refresh_sequence; // Sent after start_sequence when only part is refreshed.
+    uint32_t partial_refresh_sequence_len;
+    uint16_t full_refresh_interval; // Partial refreshes allowed before a full one. 0 is unlimited.
+    uint16_t partial_refreshes; // Partial refreshes since the last full one.
     uint16_t refresh_time;
     uint16_t set_column_window_command;
     uint16_t set_row_window_command;
@@ -56,6 +60,7 @@ typedef struct {
     bool black_bits_inverted;
     bool color_bits_inverted;
     bool refreshing;
+    bool partial_refresh; // True while a partial refresh is in progress.
     display_chip_select_behavior_t chip_select;
 } displayio_epaperdisplay_obj_t;
 
@@ -112,8 +112,16 @@ bool common_hal_displayio_fourwire_begin_transaction(mp_obj_t obj) {
     return true;
 }
 
+STATIC void wait_for_write(displayio_fourwire_obj_t* self) {
+    while (common_hal_busio_spi_transfer_in_progress(self->bus)) {
+        RUN_BACKGROUND_TASKS;
+    }
+}
+
 void common_hal_displayio_fourwire_send(mp_obj_t obj, display_byte_type_t data_type, display_chip_select_behavior_t chip_select, uint8_t *data, uint32_t data_length) {
     displayio_fourwire_obj_t* self = MP_OBJ_TO_PTR(obj);
+    // Finish any earlier data before changing the command line.
+    wait_for_write(self);
     common_hal_digitalio_digitalinout_set_value(&self->command, data_type == DISPLAY_DATA);
     if (chip_select == CHIP_SELECT_TOGGLE_EVERY_BYTE) {
         // Toggle chip select after each command byte in case the display driver
@@ -125,12 +133,15 @@ void common_hal_displayio_fourwire_send(mp_obj_t obj, display_byte_type_t data_t
             common_hal_digitalio_digitalinout_set_value(&self->chip_select, false);
         }
     } else {
-        common_hal_busio_spi_write(self->bus, data, data_length);
+        // The write may continue in the background. It is always finished before the next send or
+        // the end of the transaction so the caller can use the time to prepare more data.
+        common_hal_busio_spi_start_write(self->bus, data, data_length);
     }
 }
 
 void common_hal_displayio_fourwire_end_transaction(mp_obj_t obj) {
     displayio_fourwire_obj_t* self = MP_OBJ_TO_PTR(obj);
+    wait_for_write(self);
     common_hal_digitalio_digitalinout_set_value(&self->chip_select, true);
     common_hal_busio_spi_unlock(self->bus);
 }
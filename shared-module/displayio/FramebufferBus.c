@@ -0,0 +1,268 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/displayio/FramebufferBus.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "py/runtime.h"
+#include "py/stream.h"
+#include "shared-module/displayio/mipi_constants.h"
+
+// Sets the window back to the whole framebuffer.
+STATIC void _reset_window(displayio_framebufferbus_obj_t* self) {
+    self->x1 = 0;
+    self->x2 = self->stride / self->bytes_per_column - 1;
+    self->y1 = 0;
+    self->y2 = self->height - 1;
+    self->x = self->x1;
+    self->y = self->y1;
+    self->partial_length = 0;
+}
+
+void common_hal_displayio_framebufferbus_construct(displayio_framebufferbus_obj_t* self,
+    uint16_t width, uint16_t height, uint8_t color_depth) {
+    self->width = width;
+    self->height = height;
+    self->color_depth = color_depth;
+    if (color_depth < 8) {
+        // Packed pixels are addressed a byte at a time.
+        self->bytes_per_column = 1;
+        self->stride = (width * color_depth + 7) / 8;
+    } else {
+        self->bytes_per_column = color_depth / 8;
+        self->stride = width * self->bytes_per_column;
+    }
+    self->framebuffer = allocate_memory(align32_size(self->stride * height), false, false);
+    if (self->framebuffer == NULL) {
+        self->base.type = &mp_type_NoneType;
+        mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate framebuffer"));
+    }
+    memset(self->framebuffer->ptr, 0, self->framebuffer->length);
+    self->command = MIPI_COMMAND_WRITE_MEMORY_START;
+    self->parameter_count = 0;
+    _reset_window(self);
+}
+
+void common_hal_displayio_framebufferbus_deinit(displayio_framebufferbus_obj_t* self) {
+    if (self->framebuffer != NULL) {
+        free_memory(self->framebuffer);
+        self->framebuffer = NULL;
+    }
+}
+
+bool common_hal_displayio_framebufferbus_reset(mp_obj_t obj) {
+    displayio_framebufferbus_obj_t* self = MP_OBJ_TO_PTR(obj);
+    memset(self->framebuffer->ptr, 0, self->framebuffer->length);
+    _reset_window(self);
+    return true;
+}
+
+bool common_hal_displayio_framebufferbus_bus_free(mp_obj_t obj) {
+    (void) obj;
+    return true;
+}
+
+bool common_hal_displayio_framebufferbus_begin_transaction(mp_obj_t obj) {
+    (void) obj;
+    return true;
+}
+
+// Collects the parameters of the address commands. Bounds are either one byte each or two bytes,
+// big endian, when the display doesn't use single byte bounds.
+STATIC void _add_parameters(displayio_framebufferbus_obj_t* self, const uint8_t* data, uint32_t data_length) {
+    for (uint32_t i = 0; i < data_length && self->parameter_count < sizeof(self->parameters); i++) {
+        self->parameters[self->parameter_count++] = data[i];
+    }
+    uint16_t start;
+    uint16_t end;
+    if (self->parameter_count == 2) {
+        start = self->parameters[0];
+        end = self->parameters[1];
+    } else if (self->parameter_count == 4) {
+        start = self->parameters[0] << 8 | self->parameters[1];
+        end = self->parameters[2] << 8 | self->parameters[3];
+    } else {
+        return;
+    }
+    if (self->command == MIPI_COMMAND_SET_COLUMN_ADDRESS) {
+        self->x1 = start;
+        self->x2 = end;
+    } else {
+        self->y1 = start;
+        self->y2 = end;
+    }
+}
+
+// Copies whole column units into the window, a row at a time. Anything outside the framebuffer or
+// past the end of the window is dropped.
+STATIC void _write_columns(displayio_framebufferbus_obj_t* self, const uint8_t* data, uint32_t count) {
+    uint8_t* framebuffer = (uint8_t*) self->framebuffer->ptr;
+    uint32_t columns = self->stride / self->bytes_per_column;
+    while (count > 0 && self->y <= self->y2) {
+        uint32_t run = self->x2 - self->x + 1;
+        if (run > count) {
+            run = count;
+        }
+        if (self->y < self->height && self->x < columns) {
+            uint32_t visible = columns - self->x;
+            if (visible > run) {
+                visible = run;
+            }
+            memcpy(framebuffer + self->y * self->stride + self->x * self->bytes_per_column, data,
+                   visible * self->bytes_per_column);
+        }
+        data += run * self->bytes_per_column;
+        count -= run;
+        self->x += run;
+        if (self->x > self->x2) {
+            self->x = self->x1;
+            self->y++;
+        }
+    }
+}
+
+STATIC void _write_memory(displayio_framebufferbus_obj_t* self, const uint8_t* data, uint32_t data_length) {
+    if (self->x2 < self->x1 || self->y2 < self->y1) {
+        return;
+    }
+    uint8_t unit = self->bytes_per_column;
+    // Finish a column unit that was split across sends.
+    if (self->partial_length > 0) {
+        while (self->partial_length < unit && data_length > 0) {
+            self->partial[self->partial_length++] = *data++;
+            data_length--;
+        }
+        if (self->partial_length < unit) {
+            return;
+        }
+        _write_columns(self, self->partial, 1);
+        self->partial_length = 0;
+    }
+    uint32_t count = data_length / unit;
+    _write_columns(self, data, count);
+    self->partial_length = data_length - count * unit;
+    memcpy(self->partial, data + count * unit, self->partial_length);
+}
+
+// Commands other than the address and write memory ones, such as those in the init sequence, are
+// ignored. Displays that send data as commands include the parameters with the command and have
+// no write memory command so any data after an address command is written to memory.
+void common_hal_displayio_framebufferbus_send(mp_obj_t obj, display_byte_type_t data_type, display_chip_select_behavior_t chip_select, uint8_t *data, uint32_t data_length) {
+    displayio_framebufferbus_obj_t* self = MP_OBJ_TO_PTR(obj);
+    (void) chip_select;
+    if (data_length == 0) {
+        return;
+    }
+    if (data_type == DISPLAY_COMMAND) {
+        self->command = data[0];
+        self->parameter_count = 0;
+        if (self->command == MIPI_COMMAND_WRITE_MEMORY_START) {
+            self->x = self->x1;
+            self->y = self->y1;
+            self->partial_length = 0;
+        }
+        if (data_length == 1) {
+            return;
+        }
+        data++;
+        data_length--;
+        if (self->command == MIPI_COMMAND_SET_COLUMN_ADDRESS ||
+            self->command == MIPI_COMMAND_SET_PAGE_ADDRESS) {
+            _add_parameters(self, data, data_length);
+            self->command = MIPI_COMMAND_WRITE_MEMORY_START;
+            self->x = self->x1;
+            self->y = self->y1;
+            self->partial_length = 0;
+        }
+        return;
+    }
+    if (self->command == MIPI_COMMAND_SET_COLUMN_ADDRESS ||
+        self->command == MIPI_COMMAND_SET_PAGE_ADDRESS) {
+        _add_parameters(self, data, data_length);
+    } else if (self->command == MIPI_COMMAND_WRITE_MEMORY_START) {
+        _write_memory(self, data, data_length);
+    }
+}
+
+void common_hal_displayio_framebufferbus_end_transaction(mp_obj_t obj) {
+    (void) obj;
+}
+
+uint8_t* common_hal_displayio_framebufferbus_get_buffer(displayio_framebufferbus_obj_t* self, uint32_t* length) {
+    *length = self->stride * self->height;
+    return (uint8_t*) self->framebuffer->ptr;
+}
+
+// Converts row y into 8-bit gray values or RGB888 triplets.
+STATIC void _convert_row(displayio_framebufferbus_obj_t* self, uint16_t y, uint8_t* out) {
+    const uint8_t* row = (const uint8_t*) self->framebuffer->ptr + y * self->stride;
+    uint8_t depth = self->color_depth;
+    if (depth == 16) {
+        // RGB565 goes out big endian like it does over SPI.
+        for (uint16_t x = 0; x < self->width; x++) {
+            uint16_t pixel = row[2 * x] << 8 | row[2 * x + 1];
+            uint8_t r = pixel >> 11;
+            uint8_t g = (pixel >> 5) & 0x3f;
+            uint8_t b = pixel & 0x1f;
+            out[3 * x] = r << 3 | r >> 2;
+            out[3 * x + 1] = g << 2 | g >> 4;
+            out[3 * x + 2] = b << 3 | b >> 2;
+        }
+    } else if (depth > 16) {
+        for (uint16_t x = 0; x < self->width; x++) {
+            memcpy(out + 3 * x, row + x * self->bytes_per_column, 3);
+        }
+    } else {
+        // The first pixel is in the most significant bits of each byte.
+        uint8_t max_value = (1 << depth) - 1;
+        uint8_t pixels_per_byte = 8 / depth;
+        for (uint16_t x = 0; x < self->width; x++) {
+            uint8_t shift = 8 - depth * (x % pixels_per_byte + 1);
+            uint8_t value = (row[x / pixels_per_byte] >> shift) & max_value;
+            out[x] = value * 255 / max_value;
+        }
+    }
+}
+
+void common_hal_displayio_framebufferbus_save(displayio_framebufferbus_obj_t* self, mp_obj_t stream) {
+    mp_get_stream_raise(stream, MP_STREAM_OP_WRITE);
+    bool gray = self->color_depth <= 8;
+    vstr_t header;
+    vstr_init(&header, 20);
+    vstr_printf(&header, "%s\n%u %u\n255\n", gray ? "P5" : "P6", self->width, self->height);
+    mp_stream_write(stream, header.buf, header.len, MP_STREAM_RW_WRITE);
+    vstr_clear(&header);
+
+    size_t row_length = self->width * (gray ? 1 : 3);
+    uint8_t* row = m_new(uint8_t, row_length);
+    for (uint16_t y = 0; y < self->height; y++) {
+        _convert_row(self, y, row);
+        mp_stream_write(stream, row, row_length, MP_STREAM_RW_WRITE);
+    }
+    m_del(uint8_t, row, row_length);
+}
@@ -0,0 +1,58 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_FRAMEBUFFERBUS_H
+#define MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_FRAMEBUFFERBUS_H
+
+#include "py/obj.h"
+#include "supervisor/memory.h"
+
+// Emulates the memory of a MIPI DCS display. The column and page address commands set the window
+// that write memory start fills, one column unit at a time. A column unit is a pixel for color
+// depths of 8 or more and a byte of packed pixels below that.
+typedef struct {
+    mp_obj_base_t base;
+    supervisor_allocation* framebuffer;
+    uint32_t stride; // Bytes per row.
+    uint32_t x; // Next column unit written.
+    uint32_t y;
+    uint16_t width;
+    uint16_t height;
+    uint16_t x1;
+    uint16_t x2;
+    uint16_t y1;
+    uint16_t y2;
+    uint8_t color_depth;
+    uint8_t bytes_per_column;
+    uint8_t command; // Last command sent. Data that follows belongs to it.
+    uint8_t parameters[4];
+    uint8_t parameter_count;
+    // Bytes of a column unit that didn't arrive in the same send as the rest of it.
+    uint8_t partial[4];
+    uint8_t partial_length;
+} displayio_framebufferbus_obj_t;
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_FRAMEBUFFERBUS_H
@@ -26,12 +26,17 @@
 
 #include "shared-bindings/displayio/Group.h"
 
+#include <string.h>
+
 #include "py/runtime.h"
 #include "shared-bindings/displayio/TileGrid.h"
 
 void common_hal_displayio_group_construct(displayio_group_t* self, uint32_t max_size, uint32_t scale, mp_int_t x, mp_int_t y) {
     displayio_group_child_t* children = m_new(displayio_group_child_t, max_size);
     displayio_group_construct(self, children, max_size, scale, x, y);
+    if (max_size >= DISPLAYIO_GROUP_INDEX_MIN_SIZE) {
+        self->band_masks = m_new(uint32_t, DISPLAYIO_GROUP_INDEX_BANDS * ((max_size + 31) / 32));
+    }
 }
 
 bool common_hal_displayio_group_get_hidden(displayio_group_t* self) {
@@ -309,24 +314,116 @@ void displayio_group_construct(displayio_group_t* self, displayio_group_child_t*
     self->item_removed = false;
     self->scale = scale;
     self->in_group = false;
+    self->band_masks = NULL;
+    self->index_valid = false;
+}
+
+STATIC uint16_t _band(displayio_group_t *self, int16_t y) {
+    if (y < self->index_y1) {
+        return 0;
+    }
+    uint16_t band = (y - self->index_y1) / self->band_height;
+    if (band >= DISPLAYIO_GROUP_INDEX_BANDS) {
+        return DISPLAYIO_GROUP_INDEX_BANDS - 1;
+    }
+    return band;
+}
+
+// Records which bands of rows each child covers. Nothing moves while a refresh is in progress so
+// this is done once when it starts.
+void displayio_group_build_index(displayio_group_t *self) {
+    bool first = true;
+    int16_t y1 = 0;
+    int16_t y2 = 0;
+    for (size_t i = 0; i < self->size; i++) {
+        mp_obj_t layer = self->children[i].native;
+        if (MP_OBJ_IS_TYPE(layer, &displayio_group_type)) {
+            displayio_group_build_index(layer);
+        } else if (MP_OBJ_IS_TYPE(layer, &displayio_tilegrid_type)) {
+            displayio_tilegrid_t* tilegrid = layer;
+            if (first || tilegrid->current_area.y1 < y1) {
+                y1 = tilegrid->current_area.y1;
+            }
+            if (first || tilegrid->current_area.y2 > y2) {
+                y2 = tilegrid->current_area.y2;
+            }
+            first = false;
+        }
+    }
+    if (self->band_masks == NULL) {
+        return;
+    }
+    self->index_y1 = y1;
+    self->band_height = (y2 - y1 + DISPLAYIO_GROUP_INDEX_BANDS - 1) / DISPLAYIO_GROUP_INDEX_BANDS;
+    if (self->band_height == 0) {
+        self->band_height = 1;
+    }
+    uint16_t words = (self->max_size + 31) / 32;
+    memset(self->band_masks, 0, DISPLAYIO_GROUP_INDEX_BANDS * words * sizeof(uint32_t));
+    for (size_t i = 0; i < self->size; i++) {
+        mp_obj_t layer = self->children[i].native;
+        uint16_t first_band = 0;
+        uint16_t last_band = DISPLAYIO_GROUP_INDEX_BANDS - 1;
+        if (MP_OBJ_IS_TYPE(layer, &displayio_tilegrid_type)) {
+            displayio_tilegrid_t* tilegrid = layer;
+            if (tilegrid->current_area.y1 == tilegrid->current_area.y2) {
+                continue;
+            }
+            first_band = _band(self, tilegrid->current_area.y1);
+            last_band = _band(self, tilegrid->current_area.y2 - 1);
+        }
+        // Groups are put in every band.
+        for (uint16_t band = first_band; band <= last_band; band++) {
+            self->band_masks[band * words + i / 32] |= 1u << (i % 32);
+        }
+    }
+    self->index_valid = true;
+}
+
+STATIC bool _fill_layer(mp_obj_t layer, const _displayio_colorspace_t* colorspace, const displayio_area_t* area, uint32_t* mask, uint32_t* buffer) {
+    if (MP_OBJ_IS_TYPE(layer, &displayio_tilegrid_type)) {
+        return displayio_tilegrid_fill_area(layer, colorspace, area, mask, buffer);
+    } else if (MP_OBJ_IS_TYPE(layer, &displayio_group_type)) {
+        return displayio_group_fill_area(layer, colorspace, area, mask, buffer);
+    }
+    return false;
+}
+
+// Visits only the children in the bands the area covers, still from the top child down.
+STATIC bool _fill_area_indexed(displayio_group_t *self, const _displayio_colorspace_t* colorspace, const displayio_area_t* area, uint32_t* mask, uint32_t* buffer) {
+    uint16_t first_band = _band(self, area->y1);
+    uint16_t last_band = _band(self, area->y2 - 1);
+    uint16_t words = (self->max_size + 31) / 32;
+    for (int32_t word = (self->size - 1) / 32; word >= 0; word--) {
+        uint32_t candidates = 0;
+        for (uint16_t band = first_band; band <= last_band; band++) {
+            candidates |= self->band_masks[band * words + word];
+        }
+        for (int32_t bit = 31; candidates != 0 && bit >= 0; bit--) {
+            if ((candidates & (1u << bit)) == 0) {
+                continue;
+            }
+            candidates &= ~(1u << bit);
+            size_t i = word * 32 + bit;
+            if (i < self->size && _fill_layer(self->children[i].native, colorspace, area, mask, buffer)) {
+                return true;
+            }
+        }
+    }
+    return false;
 }
 
 bool displayio_group_fill_area(displayio_group_t *self, const _displayio_colorspace_t* colorspace, const displayio_area_t* area, uint32_t* mask, uint32_t* buffer) {
+    if (self->index_valid) {
+        return _fill_area_indexed(self, colorspace, area, mask, buffer);
+    }
     // Track if any of the layers finishes filling in the given area. We can ignore any remaining
     // layers at that point.
     bool full_coverage = false;
     for (int32_t i = self->size - 1; i >= 0 ; i--) {
-        mp_obj_t layer = self->children[i].native;
-        if (MP_OBJ_IS_TYPE(layer, &displayio_tilegrid_type)) {
-            if (displayio_tilegrid_fill_area(layer, colorspace, area, mask, buffer)) {
-                full_coverage = true;
-                break;
-            }
-        } else if (MP_OBJ_IS_TYPE(layer, &displayio_group_type)) {
-            if (displayio_group_fill_area(layer, colorspace, area, mask, buffer)) {
-                full_coverage = true;
-                break;
-            }
+        if (_fill_layer(self->children[i].native, colorspace, area, mask, buffer)) {
+            full_coverage = true;
+            break;
         }
     }
     return full_coverage;
@@ -334,6 +431,7 @@ bool displayio_group_fill_area(displayio_group_t *self, const _displayio_colorsp
 
 void displayio_group_finish_refresh(displayio_group_t *self) {
     self->item_removed = false;
+    self->index_valid = false;
     for (int32_t i = self->size - 1; i >= 0 ; i--) {
         mp_obj_t layer = self->children[i].native;
         if (MP_OBJ_IS_TYPE(layer, &displayio_tilegrid_type)) {
@@ -344,6 +442,17 @@ void displayio_group_finish_refresh(displayio_group_t *self) {
     }
 }
 
+void displayio_group_animate(displayio_group_t *self, uint64_t now_ms) {
+    for (size_t i = 0; i < self->size; i++) {
+        mp_obj_t layer = self->children[i].native;
+        if (MP_OBJ_IS_TYPE(layer, &displayio_tilegrid_type)) {
+            displayio_tilegrid_animate(layer, now_ms);
+        } else if (MP_OBJ_IS_TYPE(layer, &displayio_group_type)) {
+            displayio_group_animate(layer, now_ms);
+        }
+    }
+}
+
 displayio_area_t* displayio_group_get_refresh_areas(displayio_group_t *self, displayio_area_t* tail) {
     if (self->item_removed) {
         self->dirty_area.next = tail;
@@ -34,6 +34,12 @@
 #include "shared-module/displayio/area.h"
 #include "shared-module/displayio/Palette.h"
 
+// Groups that can hold at least this many children keep an index of which children cover which
+// rows so that filling an area only visits the children that may overlap it.
+#define DISPLAYIO_GROUP_INDEX_MIN_SIZE (16)
+// Number of horizontal bands the index splits the children's extent into.
+#define DISPLAYIO_GROUP_INDEX_BANDS (16)
+
 typedef struct {
     mp_obj_t native;
     mp_obj_t original;
@@ -44,8 +50,13 @@ typedef struct {
     displayio_group_child_t* children;
     displayio_buffer_transform_t absolute_transform;
     displayio_area_t dirty_area; // Catch all for changed area
+    // One bit per child for each band, DISPLAYIO_GROUP_INDEX_BANDS rows of (max_size + 31) / 32
+    // words. NULL for small groups.
+    uint32_t* band_masks;
     int16_t x;
     int16_t y;
+    int16_t index_y1; // First row of the first band.
+    uint16_t band_height;
     uint16_t scale;
     uint16_t size;
     uint16_t max_size;
@@ -53,15 +64,18 @@ typedef struct {
     bool in_group :1;
     bool hidden :1;
     bool hidden_by_parent :1;
-    uint8_t padding :4;
+    bool index_valid :1; // Only true from the start of a refresh until it finishes.
+    uint8_t padding :3;
 } displayio_group_t;
 
 void displayio_group_construct(displayio_group_t* self, displayio_group_child_t* child_array, uint32_t max_size, uint32_t scale, mp_int_t x, mp_int_t y);
 void displayio_group_set_hidden_by_parent(displayio_group_t *self, bool hidden);
 bool displayio_group_get_previous_area(displayio_group_t *group, displayio_area_t* area);
 bool displayio_group_fill_area(displayio_group_t *group, const _displayio_colorspace_t* colorspace, const displayio_area_t* area, uint32_t* mask, uint32_t *buffer);
+void displayio_group_build_index(displayio_group_t *self);
 void displayio_group_update_transform(displayio_group_t *group, const displayio_buffer_transform_t* parent_transform);
 void displayio_group_finish_refresh(displayio_group_t *self);
+void displayio_group_animate(displayio_group_t *self, uint64_t now_ms);
 displayio_area_t* displayio_group_get_refresh_areas(displayio_group_t *self, displayio_area_t* tail);
 
 #endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_GROUP_H
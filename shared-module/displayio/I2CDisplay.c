@@ -99,27 +99,55 @@ bool common_hal_displayio_i2cdisplay_bus_free(mp_obj_t obj) {
 
 bool common_hal_displayio_i2cdisplay_begin_transaction(mp_obj_t obj) {
     displayio_i2cdisplay_obj_t* self = MP_OBJ_TO_PTR(obj);
-    return common_hal_busio_i2c_try_lock(self->bus);
+    if (!common_hal_busio_i2c_try_lock(self->bus)) {
+        return false;
+    }
+    self->command_length = 0;
+    return true;
 }
 
+STATIC void _flush_commands(displayio_i2cdisplay_obj_t* self) {
+    if (self->command_length == 0) {
+        return;
+    }
+    common_hal_busio_i2c_write(self->bus, self->address, self->commands, self->command_length, true);
+    self->command_length = 0;
+}
+
+// Everything sent during a transaction goes out in as few I2C writes as possible. Each command byte
+// is marked as one that is followed by another control byte so they can be held and sent ahead of
+// the data that follows them in the same write. Data runs to the end of a write.
 void common_hal_displayio_i2cdisplay_send(mp_obj_t obj, display_byte_type_t data_type, display_chip_select_behavior_t chip_select, uint8_t *data, uint32_t data_length) {
     displayio_i2cdisplay_obj_t* self = MP_OBJ_TO_PTR(obj);
     if (data_type == DISPLAY_COMMAND) {
-        uint8_t command_bytes[2 * data_length];
+        if (self->command_length + 2 * data_length > DISPLAYIO_I2CDISPLAY_COMMAND_BUFFER_SIZE) {
+            _flush_commands(self);
+        }
+        if (2 * data_length > DISPLAYIO_I2CDISPLAY_COMMAND_BUFFER_SIZE) {
+            uint8_t command_bytes[2 * data_length];
+            for (uint32_t i = 0; i < data_length; i++) {
+                command_bytes[2 * i] = 0x80;
+                command_bytes[2 * i + 1] = data[i];
+            }
+            common_hal_busio_i2c_write(self->bus, self->address, command_bytes, 2 * data_length, true);
+            return;
+        }
         for (uint32_t i = 0; i < data_length; i++) {
-            command_bytes[2 * i] = 0x80;
-            command_bytes[2 * i + 1] = data[i];
+            self->commands[self->command_length++] = 0x80;
+            self->commands[self->command_length++] = data[i];
         }
-        common_hal_busio_i2c_write(self->bus, self->address, command_bytes, 2 * data_length, true);
     } else {
-        uint8_t data_bytes[data_length + 1];
-        data_bytes[0] = 0x40;
-        memcpy(data_bytes + 1, data, data_length);
-        common_hal_busio_i2c_write(self->bus, self->address, data_bytes, data_length + 1, true);
+        uint8_t data_bytes[self->command_length + data_length + 1];
+        memcpy(data_bytes, self->commands, self->command_length);
+        data_bytes[self->command_length] = 0x40;
+        memcpy(data_bytes + self->command_length + 1, data, data_length);
+        common_hal_busio_i2c_write(self->bus, self->address, data_bytes, sizeof(data_bytes), true);
+        self->command_length = 0;
     }
 }
 
 void common_hal_displayio_i2cdisplay_end_transaction(mp_obj_t obj) {
     displayio_i2cdisplay_obj_t* self = MP_OBJ_TO_PTR(obj);
+    _flush_commands(self);
     common_hal_busio_i2c_unlock(self->bus);
 }
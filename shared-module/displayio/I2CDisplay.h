@@ -30,12 +30,17 @@
 #include "common-hal/busio/I2C.h"
 #include "common-hal/digitalio/DigitalInOut.h"
 
+// Command bytes, each with its control byte, that are held until the rest of the transaction.
+#define DISPLAYIO_I2CDISPLAY_COMMAND_BUFFER_SIZE (32)
+
 typedef struct {
     mp_obj_base_t base;
     busio_i2c_obj_t* bus;
     busio_i2c_obj_t inline_bus;
     digitalio_digitalinout_obj_t reset;
     uint16_t address;
+    uint8_t command_length;
+    uint8_t commands[DISPLAYIO_I2CDISPLAY_COMMAND_BUFFER_SIZE];
 } displayio_i2cdisplay_obj_t;
 
 #endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_I2CDISPLAY_H
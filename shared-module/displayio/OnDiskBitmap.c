@@ -114,65 +114,94 @@ void common_hal_displayio_ondiskbitmap_construct(displayio_ondiskbitmap_t *self,
         self->stride = (bit_stride / 8);
     }
 
+    self->row_cache = m_malloc(self->stride, false);
+    self->cached_row = -1;
 }
 
-
-uint32_t common_hal_displayio_ondiskbitmap_get_pixel(displayio_ondiskbitmap_t *self,
-        int16_t x, int16_t y) {
-    if (x < 0 || x >= self->width || y < 0 || y >= self->height) {
-        return 0;
+// Returns the raw data for row y, reading the whole scanline with one f_read when it isn't the
+// cached one. Returns NULL if it can't be read.
+STATIC const uint8_t* _get_row_data(displayio_ondiskbitmap_t *self, int16_t y) {
+    if (self->cached_row == y) {
+        return self->row_cache;
+    }
+    self->cached_row = -1;
+    if (f_lseek(&self->file->fp, self->data_offset + (self->height - y - 1) * self->stride) != FR_OK) {
+        return NULL;
+    }
+    UINT bytes_read;
+    if (f_read(&self->file->fp, self->row_cache, self->stride, &bytes_read) != FR_OK ||
+        bytes_read != self->stride) {
+        return NULL;
     }
+    self->cached_row = y;
+    return self->row_cache;
+}
 
-    uint32_t location;
+STATIC uint32_t _decode_pixel(displayio_ondiskbitmap_t *self, const uint8_t* row, int16_t x) {
     uint8_t bytes_per_pixel = (self->bits_per_pixel / 8)  ? (self->bits_per_pixel /8) : 1;
     uint8_t pixels_per_byte = 8 / self->bits_per_pixel;
-    if (pixels_per_byte == 0){
-        location = self->data_offset + (self->height - y - 1) * self->stride + x * bytes_per_pixel;
+    uint32_t pixel_data = 0;
+    if (pixels_per_byte == 0) {
+        memcpy(&pixel_data, row + x * bytes_per_pixel, bytes_per_pixel);
     } else {
-        location = self->data_offset + (self->height - y - 1) * self->stride + x / pixels_per_byte;
+        pixel_data = row[x / pixels_per_byte];
     }
-    // We don't cache here because the underlying FS caches sectors.
-    f_lseek(&self->file->fp, location);
-    UINT bytes_read;
-    uint32_t pixel_data = 0;
-    uint32_t result = f_read(&self->file->fp, &pixel_data, bytes_per_pixel, &bytes_read);
-    if (result == FR_OK) {
-        uint32_t tmp = 0;
-        uint8_t red;
-        uint8_t green;
-        uint8_t blue;
-        if (bytes_per_pixel == 1) {
-            uint8_t offset = (x % pixels_per_byte) * self->bits_per_pixel;
-            uint8_t mask = (1 << self->bits_per_pixel) - 1;
-
-            uint8_t index = (pixel_data >> ((8 - self->bits_per_pixel) - offset)) & mask;
-            if (self->bits_per_pixel == 1) {
-                if (index == 1) {
-                    return 0xFFFFFF;
-                } else {
-                    return 0x000000;
-                }
-            }
-            return self->palette_data[index];
-        } else if (bytes_per_pixel == 2) {
-            if (self->g_bitmask == 0x07e0) { // 565
-                red =((pixel_data & self->r_bitmask) >>11);
-                green = ((pixel_data & self->g_bitmask) >>5);
-                blue = ((pixel_data & self->b_bitmask) >> 0);
-            } else { // 555
-                red =((pixel_data & self->r_bitmask) >>10);
-                green = ((pixel_data & self->g_bitmask) >>4);
-                blue = ((pixel_data & self->b_bitmask) >> 0);
+
+    uint32_t tmp = 0;
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+    if (bytes_per_pixel == 1) {
+        uint8_t offset = (x % pixels_per_byte) * self->bits_per_pixel;
+        uint8_t mask = (1 << self->bits_per_pixel) - 1;
+
+        uint8_t index = (pixel_data >> ((8 - self->bits_per_pixel) - offset)) & mask;
+        if (self->bits_per_pixel == 1) {
+            if (index == 1) {
+                return 0xFFFFFF;
+            } else {
+                return 0x000000;
             }
-            tmp = (red << 19 | green << 10 | blue << 3);
-            return tmp;
-        } else if ((bytes_per_pixel == 4) && (self->bitfield_compressed)) {
-            return pixel_data & 0x00FFFFFF;
+        }
+        return self->palette_data[index];
+    } else if (bytes_per_pixel == 2) {
+        if (self->g_bitmask == 0x07e0) { // 565
+            red =((pixel_data & self->r_bitmask) >>11);
+            green = ((pixel_data & self->g_bitmask) >>5);
+            blue = ((pixel_data & self->b_bitmask) >> 0);
+        } else { // 555
+            red =((pixel_data & self->r_bitmask) >>10);
+            green = ((pixel_data & self->g_bitmask) >>4);
+            blue = ((pixel_data & self->b_bitmask) >> 0);
+        }
+        tmp = (red << 19 | green << 10 | blue << 3);
+        return tmp;
+    } else if ((bytes_per_pixel == 4) && (self->bitfield_compressed)) {
+        return pixel_data & 0x00FFFFFF;
+    } else {
+        return pixel_data;
+    }
+}
+
+void displayio_ondiskbitmap_get_row(displayio_ondiskbitmap_t *self, int16_t x, int16_t y, uint32_t* values, uint16_t count) {
+    const uint8_t* row = NULL;
+    if (y >= 0 && y < self->height) {
+        row = _get_row_data(self, y);
+    }
+    for (uint16_t i = 0; i < count; i++, x++) {
+        if (row == NULL || x < 0 || x >= self->width) {
+            values[i] = 0;
         } else {
-            return pixel_data;
+            values[i] = _decode_pixel(self, row, x);
         }
     }
-    return 0;
+}
+
+uint32_t common_hal_displayio_ondiskbitmap_get_pixel(displayio_ondiskbitmap_t *self,
+        int16_t x, int16_t y) {
+    uint32_t pixel;
+    displayio_ondiskbitmap_get_row(self, x, y, &pixel, 1);
+    return pixel;
 }
 
 uint16_t common_hal_displayio_ondiskbitmap_get_height(displayio_ondiskbitmap_t *self) {
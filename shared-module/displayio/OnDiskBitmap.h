@@ -47,6 +47,11 @@ typedef struct {
     pyb_file_obj_t* file;
     uint8_t bits_per_pixel;
     uint32_t* palette_data;
+    uint8_t* row_cache; // One scanline of raw BMP data.
+    int16_t cached_row; // Row held in row_cache or -1 if none.
 } displayio_ondiskbitmap_t;
 
+// Fills values with count RGB888 pixels from row y starting at x. Pixels outside the bitmap are 0.
+void displayio_ondiskbitmap_get_row(displayio_ondiskbitmap_t *self, int16_t x, int16_t y, uint32_t* values, uint16_t count);
+
 #endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_ONDISKBITMAP_H
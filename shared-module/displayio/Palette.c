@@ -31,14 +31,18 @@
 void common_hal_displayio_palette_construct(displayio_palette_t* self, uint16_t color_count) {
     self->color_count = color_count;
     self->colors = (_displayio_color_t *) m_malloc(color_count * sizeof(_displayio_color_t), false);
+    self->cached_colors = (uint32_t *) m_malloc(color_count * sizeof(uint32_t), false);
+    self->cache_valid = false;
 }
 
 void common_hal_displayio_palette_make_opaque(displayio_palette_t* self, uint32_t palette_index) {
     self->colors[palette_index].transparent = false;
+    self->cache_valid = false;
 }
 
 void common_hal_displayio_palette_make_transparent(displayio_palette_t* self, uint32_t palette_index) {
     self->colors[palette_index].transparent = true;
+    self->cache_valid = false;
 }
 
 uint32_t common_hal_displayio_palette_get_len(displayio_palette_t* self) {
@@ -57,17 +61,14 @@ void common_hal_displayio_palette_set_color(displayio_palette_t* self, uint32_t
     self->colors[palette_index].chroma = chroma;
     self->colors[palette_index].hue = displayio_colorconverter_compute_hue(color);
     self->needs_refresh = true;
+    self->cache_valid = false;
 }
 
 uint32_t common_hal_displayio_palette_get_color(displayio_palette_t* self, uint32_t palette_index) {
     return self->colors[palette_index].rgb888;
 }
 
-bool displayio_palette_get_color(displayio_palette_t *self, const _displayio_colorspace_t* colorspace, uint32_t palette_index, uint32_t* color) {
-    if (palette_index > self->color_count || self->colors[palette_index].transparent) {
-        return false; // returns opaque
-    }
-
+STATIC void _convert_color(displayio_palette_t *self, const _displayio_colorspace_t* colorspace, uint32_t palette_index, uint32_t* color) {
     if (colorspace->tricolor) {
         uint8_t luma = self->colors[palette_index].luma;
         *color = luma >> (8 - colorspace->depth);
@@ -76,7 +77,7 @@ bool displayio_palette_get_color(displayio_palette_t *self, const _displayio_col
             if (!colorspace->grayscale) {
                 *color = 0;
             }
-            return true;
+            return;
         }
         uint8_t pixel_hue = self->colors[palette_index].hue;
         displayio_colorconverter_compute_tricolor(colorspace, pixel_hue, luma, color);
@@ -85,7 +86,54 @@ bool displayio_palette_get_color(displayio_palette_t *self, const _displayio_col
     } else {
         *color = self->colors[palette_index].rgb565;
     }
+}
 
+// Only compares the fields that change color conversion.
+STATIC bool _same_conversion(const _displayio_colorspace_t* a, const _displayio_colorspace_t* b) {
+    return a->depth == b->depth &&
+           a->grayscale == b->grayscale &&
+           a->tricolor == b->tricolor &&
+           a->tricolor_hue == b->tricolor_hue &&
+           a->tricolor_luma == b->tricolor_luma;
+}
+
+const uint32_t* displayio_palette_get_converted_colors(displayio_palette_t *self, const _displayio_colorspace_t* colorspace) {
+    if (self->cached_colors == NULL) {
+        return NULL;
+    }
+    if (self->cache_valid && _same_conversion(&self->cached_colorspace, colorspace)) {
+        return self->cached_colors;
+    }
+    for (uint32_t i = 0; i < self->color_count; i++) {
+        if (self->colors[i].transparent) {
+            self->cached_colors[i] = DISPLAYIO_PALETTE_TRANSPARENT;
+        } else {
+            _convert_color(self, colorspace, i, &self->cached_colors[i]);
+        }
+    }
+    self->cached_colorspace = *colorspace;
+    self->cache_valid = true;
+    return self->cached_colors;
+}
+
+bool displayio_palette_get_color(displayio_palette_t *self, const _displayio_colorspace_t* colorspace, uint32_t palette_index, uint32_t* color) {
+    if (palette_index >= self->color_count) {
+        return false; // returns opaque
+    }
+
+    const uint32_t* converted = displayio_palette_get_converted_colors(self, colorspace);
+    if (converted != NULL) {
+        if (converted[palette_index] == DISPLAYIO_PALETTE_TRANSPARENT) {
+            return false;
+        }
+        *color = converted[palette_index];
+        return true;
+    }
+
+    if (self->colors[palette_index].transparent) {
+        return false;
+    }
+    _convert_color(self, colorspace, palette_index, color);
     return true;
 }
 
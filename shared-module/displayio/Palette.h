@@ -67,16 +67,27 @@ typedef struct {
     bool opaque;
 } displayio_output_pixel_t;
 
+// Marks a transparent color in a palette's converted color cache.
+#define DISPLAYIO_PALETTE_TRANSPARENT (0x80000000)
+
 typedef struct {
     mp_obj_base_t base;
     _displayio_color_t* colors;
+    // Colors converted for cached_colorspace, or DISPLAYIO_PALETTE_TRANSPARENT. May be NULL in
+    // which case colors are converted every time.
+    uint32_t* cached_colors;
     uint32_t color_count;
+    _displayio_colorspace_t cached_colorspace;
+    bool cache_valid;
     bool needs_refresh;
 } displayio_palette_t;
 
 // Returns false if color fetch did not succeed (out of range or transparent).
 // Returns true if color is opaque, and sets color.
 bool displayio_palette_get_color(displayio_palette_t *palette, const _displayio_colorspace_t* colorspace, uint32_t palette_index, uint32_t* color);
+// Returns all of the palette's colors converted for the colorspace with transparent colors set to
+// DISPLAYIO_PALETTE_TRANSPARENT. Returns NULL if the palette has no cache.
+const uint32_t* displayio_palette_get_converted_colors(displayio_palette_t *self, const _displayio_colorspace_t* colorspace);
 bool displayio_palette_needs_refresh(displayio_palette_t *self);
 void displayio_palette_finish_refresh(displayio_palette_t *self);
 
@@ -0,0 +1,159 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/displayio/RLEBitmap.h"
+
+#include <string.h>
+
+#include "py/mperrno.h"
+#include "py/runtime.h"
+
+#define HEADER_SIZE (12)
+#define REPEAT_RUN (0x80)
+
+static uint32_t read_value(const uint8_t* data, uint8_t length) {
+    uint32_t value = 0;
+    for (int8_t i = length - 1; i >= 0; i--) {
+        value = value << 8 | data[i];
+    }
+    return value;
+}
+
+STATIC void _load(displayio_rlebitmap_t *self) {
+    if (self->data_length < HEADER_SIZE || memcmp(self->data, "CPR", 3) != 0 || self->data[3] != 1) {
+        mp_raise_ValueError(translate("Invalid file"));
+    }
+    self->bits_per_value = self->data[4];
+    if (self->bits_per_value == 0 || self->bits_per_value > 32) {
+        mp_raise_ValueError(translate("Invalid bits per value"));
+    }
+    self->bytes_per_value = (self->bits_per_value + 7) / 8;
+    self->width = read_value(self->data + 6, 2);
+    self->height = read_value(self->data + 8, 2);
+    if (self->data_length < HEADER_SIZE + self->height * 4U) {
+        mp_raise_ValueError(translate("Invalid file"));
+    }
+    for (uint16_t y = 0; y < self->height; y++) {
+        if (read_value(self->data + HEADER_SIZE + y * 4, 4) >= self->data_length) {
+            mp_raise_ValueError(translate("Invalid file"));
+        }
+    }
+    self->cursor_y = -1;
+}
+
+#if CIRCUITPY_DISPLAYIO_HARDWARE
+void common_hal_displayio_rlebitmap_construct_from_file(displayio_rlebitmap_t *self, pyb_file_obj_t* file) {
+    // Compressed images are small enough to keep in RAM, unlike the decompressed pixels.
+    uint32_t length = f_size(&file->fp);
+    uint8_t* data = m_malloc(length, false);
+    f_rewind(&file->fp);
+    UINT bytes_read;
+    if (f_read(&file->fp, data, length, &bytes_read) != FR_OK || bytes_read != length) {
+        mp_raise_OSError(MP_EIO);
+    }
+    self->buffer = MP_OBJ_NULL;
+    self->data = data;
+    self->data_length = length;
+    _load(self);
+}
+#endif
+
+void common_hal_displayio_rlebitmap_construct_from_buffer(displayio_rlebitmap_t *self, mp_obj_t buffer, const uint8_t* data, uint32_t data_length) {
+    // Keep the object so the data isn't collected. Frozen data is used in place.
+    self->buffer = buffer;
+    self->data = data;
+    self->data_length = data_length;
+    _load(self);
+}
+
+// Each row is a series of runs that start with a header byte. When the top bit is set, the next
+// value repeats (header & 0x7f) + 1 times. Otherwise, (header & 0x7f) + 1 values follow.
+void displayio_rlebitmap_get_row(displayio_rlebitmap_t *self, int16_t x, int16_t y, uint32_t* values, uint16_t count) {
+    if (y < 0 || y >= self->height || x < 0) {
+        memset(values, 0, count * sizeof(uint32_t));
+        return;
+    }
+    if (y != self->cursor_y || x < self->cursor_x) {
+        self->cursor_y = y;
+        self->cursor_x = 0;
+        self->cursor_offset = read_value(self->data + HEADER_SIZE + y * 4, 4);
+    }
+    uint32_t offset = self->cursor_offset;
+    uint16_t run_x = self->cursor_x;
+    uint8_t value_size = self->bytes_per_value;
+    while (count > 0 && run_x < self->width && offset < self->data_length) {
+        uint8_t header = self->data[offset];
+        bool repeat = (header & REPEAT_RUN) != 0;
+        uint16_t run_length = (header & ~REPEAT_RUN) + 1;
+        uint32_t run_size = 1 + (repeat ? 1 : run_length) * value_size;
+        if (offset + run_size > self->data_length) {
+            break;
+        }
+        if (x >= run_x + run_length) {
+            offset += run_size;
+            run_x += run_length;
+            continue;
+        }
+        self->cursor_x = run_x;
+        self->cursor_offset = offset;
+
+        uint16_t start = x - run_x;
+        uint16_t n = run_length - start;
+        if (n > count) {
+            n = count;
+        }
+        const uint8_t* run_values = self->data + offset + 1;
+        if (repeat) {
+            uint32_t value = read_value(run_values, value_size);
+            for (uint16_t i = 0; i < n; i++) {
+                values[i] = value;
+            }
+        } else {
+            run_values += start * value_size;
+            for (uint16_t i = 0; i < n; i++, run_values += value_size) {
+                values[i] = read_value(run_values, value_size);
+            }
+        }
+        values += n;
+        count -= n;
+        x += n;
+    }
+    memset(values, 0, count * sizeof(uint32_t));
+}
+
+uint32_t common_hal_displayio_rlebitmap_get_pixel(displayio_rlebitmap_t *self, int16_t x, int16_t y) {
+    uint32_t value;
+    displayio_rlebitmap_get_row(self, x, y, &value, 1);
+    return value;
+}
+
+uint16_t common_hal_displayio_rlebitmap_get_height(displayio_rlebitmap_t *self) {
+    return self->height;
+}
+
+uint16_t common_hal_displayio_rlebitmap_get_width(displayio_rlebitmap_t *self) {
+    return self->width;
+}
@@ -0,0 +1,53 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_RLEBITMAP_H
+#define MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_RLEBITMAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "py/obj.h"
+
+typedef struct {
+    mp_obj_base_t base;
+    mp_obj_t buffer; // Object that owns data when it wasn't read from a file.
+    const uint8_t* data;
+    uint32_t data_length;
+    uint16_t width;
+    uint16_t height;
+    uint8_t bits_per_value;
+    uint8_t bytes_per_value;
+    // The last run read so reading along a row doesn't decode it from the start each time.
+    int16_t cursor_y;
+    uint16_t cursor_x;
+    uint32_t cursor_offset;
+} displayio_rlebitmap_t;
+
+// Fills values with count values from row y starting at x. Values outside the bitmap are 0.
+void displayio_rlebitmap_get_row(displayio_rlebitmap_t *self, int16_t x, int16_t y, uint32_t* values, uint16_t count);
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_RLEBITMAP_H
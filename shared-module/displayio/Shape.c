@@ -29,6 +29,7 @@
 #include <string.h>
 
 #include "py/runtime.h"
+#include "shared-module/displayio/vector.h"
 
 void common_hal_displayio_shape_construct(displayio_shape_t *self, uint32_t width,
     uint32_t height, bool mirror_x, bool mirror_y) {
@@ -48,11 +49,37 @@ void common_hal_displayio_shape_construct(displayio_shape_t *self, uint32_t widt
     }
     self->half_height = height;
 
-    self->data = m_malloc(height * sizeof(uint32_t), false);
+    // Each stored row, including the last one at index height, has a start and end.
+    self->data = m_malloc((height + 1) * sizeof(uint32_t), false);
     for (uint16_t i = 0; i <= height; i++) {
         self->data[2 * i] = 0;
         self->data[2 * i + 1] = width;
     }
+
+    self->dirty_area.x1 = 0;
+    self->dirty_area.x2 = self->width;
+    self->dirty_area.y1 = 0;
+    self->dirty_area.y2 = self->height;
+}
+
+// Grows the dirty area to the full width of the given stored rows and their mirror.
+STATIC void _mark_dirty(displayio_shape_t *self, int16_t y1, int16_t y2) {
+    if (self->mirror_y) {
+        y2 = self->height - y1;
+    }
+    if (self->dirty_area.x1 == self->dirty_area.x2) {
+        self->dirty_area.x1 = 0;
+        self->dirty_area.x2 = self->width;
+        self->dirty_area.y1 = y1;
+        self->dirty_area.y2 = y2;
+        return;
+    }
+    if (y1 < self->dirty_area.y1) {
+        self->dirty_area.y1 = y1;
+    }
+    if (y2 > self->dirty_area.y2) {
+        self->dirty_area.y2 = y2;
+    }
 }
 
 void common_hal_displayio_shape_set_boundary(displayio_shape_t *self, uint16_t y, uint16_t start_x, uint16_t end_x) {
@@ -68,6 +95,63 @@ void common_hal_displayio_shape_set_boundary(displayio_shape_t *self, uint16_t y
     }
     self->data[2 * y] = start_x;
     self->data[2 * y + 1] = end_x;
+    _mark_dirty(self, y, y + 1);
+}
+
+// Grows the boundary of row y to include the span. Only the stored part of a mirrored shape is kept.
+STATIC void _boundary_span(void* target, int16_t x1, int16_t x2, int16_t y, uint32_t value) {
+    (void) value;
+    displayio_shape_t *self = target;
+    if (self->mirror_y && y > self->half_height) {
+        return;
+    }
+    if (x1 < 0) {
+        x1 = 0;
+    }
+    if (x2 > self->width) {
+        x2 = self->width;
+    }
+    if (self->mirror_x && x2 > self->half_width + 1) {
+        x2 = self->half_width + 1;
+    }
+    if (x1 >= x2) {
+        return;
+    }
+    uint16_t* row = self->data + 2 * y;
+    if (x1 < row[0]) {
+        row[0] = x1;
+    }
+    if (x2 - 1 > row[1]) {
+        row[1] = x2 - 1;
+    }
+}
+
+// Empties every row and sets up pen to grow the boundaries back out.
+STATIC void _start_outline(displayio_shape_t *self, displayio_vector_pen_t* pen) {
+    for (uint16_t i = 0; i <= self->half_height; i++) {
+        self->data[2 * i] = 0xffff;
+        self->data[2 * i + 1] = 0;
+    }
+    _mark_dirty(self, 0, self->height);
+    pen->span = _boundary_span;
+    pen->target = self;
+    pen->value = 1;
+    pen->height = self->height;
+    pen->ramp = 1;
+}
+
+void common_hal_displayio_shape_set_circle(displayio_shape_t *self, int16_t x, int16_t y, uint16_t radius) {
+    displayio_vector_pen_t pen;
+    _start_outline(self, &pen);
+    displayio_vector_fill_circle(&pen, x, y, radius);
+}
+
+void common_hal_displayio_shape_set_polygon(displayio_shape_t *self, const int16_t* points, uint16_t point_count) {
+    displayio_vector_pen_t pen;
+    _start_outline(self, &pen);
+    displayio_vector_fill_polygon(&pen, points, point_count);
+    // The edges are drawn too so thin polygons that miss every row center still show up.
+    displayio_vector_polygon(&pen, points, point_count);
 }
 
 uint32_t common_hal_displayio_shape_get_pixel(void *obj, int16_t x, int16_t y) {
@@ -88,3 +172,16 @@ uint32_t common_hal_displayio_shape_get_pixel(void *obj, int16_t x, int16_t y) {
     }
     return 1;
 }
+
+displayio_area_t* displayio_shape_get_refresh_areas(displayio_shape_t *self, displayio_area_t* tail) {
+    if (self->dirty_area.x1 == self->dirty_area.x2) {
+        return tail;
+    }
+    self->dirty_area.next = tail;
+    return &self->dirty_area;
+}
+
+void displayio_shape_finish_refresh(displayio_shape_t *self) {
+    self->dirty_area.x1 = 0;
+    self->dirty_area.x2 = 0;
+}
@@ -31,6 +31,7 @@
 #include <stdint.h>
 
 #include "py/obj.h"
+#include "shared-module/displayio/area.h"
 
 typedef struct {
     mp_obj_base_t base;
@@ -39,8 +40,12 @@ typedef struct {
     uint16_t half_width;
     uint16_t half_height;
     uint16_t* data;
+    displayio_area_t dirty_area;
     bool mirror_x;
     bool mirror_y;
 } displayio_shape_t;
 
+void displayio_shape_finish_refresh(displayio_shape_t *self);
+displayio_area_t* displayio_shape_get_refresh_areas(displayio_shape_t *self, displayio_area_t* tail);
+
 #endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_SHAPE_H
@@ -29,9 +29,15 @@
 #include "py/runtime.h"
 #include "shared-bindings/displayio/Bitmap.h"
 #include "shared-bindings/displayio/ColorConverter.h"
+#if CIRCUITPY_DISPLAYIO_HARDWARE
 #include "shared-bindings/displayio/OnDiskBitmap.h"
+#endif
 #include "shared-bindings/displayio/Palette.h"
+#include "shared-bindings/displayio/RLEBitmap.h"
 #include "shared-bindings/displayio/Shape.h"
+#include "supervisor/shared/tick.h"
+
+#include <string.h>
 
 void common_hal_displayio_tilegrid_construct(displayio_tilegrid_t *self, mp_obj_t bitmap,
         uint16_t bitmap_width_in_tiles, uint16_t bitmap_height_in_tiles,
@@ -69,6 +75,9 @@ void common_hal_displayio_tilegrid_construct(displayio_tilegrid_t *self, mp_obj_
     self->in_group = false;
     self->hidden = false;
     self->hidden_by_parent = false;
+    self->hardware_scroll = false;
+    self->scrolled_pixels = 0;
+    self->animation = NULL;
     self->previous_area.x1 = 0xffff;
     self->previous_area.x2 = self->previous_area.x1;
     self->flip_x = false;
@@ -97,7 +106,7 @@ bool displayio_tilegrid_get_previous_area(displayio_tilegrid_t *self, displayio_
     return true;
 }
 
-void _update_current_x(displayio_tilegrid_t *self) {
+STATIC void _update_current_x(displayio_tilegrid_t *self) {
     int16_t width;
     if (self->transpose_xy) {
         width = self->pixel_height;
@@ -123,7 +132,7 @@ void _update_current_x(displayio_tilegrid_t *self) {
     }
 }
 
-void _update_current_y(displayio_tilegrid_t *self) {
+STATIC void _update_current_y(displayio_tilegrid_t *self) {
     int16_t height;
     if (self->transpose_xy) {
         height = self->pixel_width;
@@ -219,18 +228,8 @@ uint8_t common_hal_displayio_tilegrid_get_tile(displayio_tilegrid_t *self, uint1
     return tiles[y * self->width_in_tiles + x];
 }
 
-void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint8_t tile_index) {
-    if (tile_index >= self->tiles_in_bitmap) {
-        mp_raise_ValueError(translate("Tile index out of bounds"));
-    }
-    uint8_t* tiles = self->tiles;
-    if (self->inline_tiles) {
-        tiles = (uint8_t*) &self->tiles;
-    }
-    if (tiles == NULL) {
-        return;
-    }
-    tiles[y * self->width_in_tiles + x] = tile_index;
+// Marks count tiles in a row as changed. tx and ty are relative to the top left tile.
+STATIC void _mark_tiles_dirty(displayio_tilegrid_t *self, uint16_t tx, uint16_t ty, uint16_t count) {
     displayio_area_t temp_area;
     displayio_area_t* tile_area;
     if (!self->partial_change) {
@@ -238,24 +237,68 @@ void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t
     } else {
         tile_area = &temp_area;
     }
+    tile_area->x1 = tx * self->tile_width;
+    tile_area->x2 = tile_area->x1 + count * self->tile_width;
+    tile_area->y1 = ty * self->tile_height;
+    tile_area->y2 = tile_area->y1 + self->tile_height;
+
+    if (self->partial_change) {
+        displayio_area_expand(&self->dirty_area, &temp_area);
+    }
+
+    self->partial_change = true;
+}
+
+STATIC uint16_t _relative_x(displayio_tilegrid_t *self, uint16_t x) {
     int16_t tx = (x - self->top_left_x) % self->width_in_tiles;
     if (tx < 0) {
         tx += self->width_in_tiles;
     }
-    tile_area->x1 = tx * self->tile_width;
-    tile_area->x2 = tile_area->x1 + self->tile_width;
+    return tx;
+}
+
+STATIC uint16_t _relative_y(displayio_tilegrid_t *self, uint16_t y) {
     int16_t ty = (y - self->top_left_y) % self->height_in_tiles;
     if (ty < 0) {
         ty += self->height_in_tiles;
     }
-    tile_area->y1 = ty * self->tile_height;
-    tile_area->y2 = tile_area->y1 + self->tile_height;
+    return ty;
+}
 
-    if (self->partial_change) {
-        displayio_area_expand(&self->dirty_area, &temp_area);
+void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint8_t tile_index) {
+    if (tile_index >= self->tiles_in_bitmap) {
+        mp_raise_ValueError(translate("Tile index out of bounds"));
     }
+    uint8_t* tiles = self->tiles;
+    if (self->inline_tiles) {
+        tiles = (uint8_t*) &self->tiles;
+    }
+    if (tiles == NULL) {
+        return;
+    }
+    tiles[y * self->width_in_tiles + x] = tile_index;
+    _mark_tiles_dirty(self, _relative_x(self, x), _relative_y(self, y), 1);
+}
 
-    self->partial_change = true;
+void displayio_tilegrid_set_tile_span(displayio_tilegrid_t *self, uint16_t x, uint16_t y, const uint8_t* tile_indices, uint16_t count) {
+    uint8_t* tiles = self->tiles;
+    if (self->inline_tiles) {
+        tiles = (uint8_t*) &self->tiles;
+    }
+    if (tiles == NULL || count == 0) {
+        return;
+    }
+    memcpy(tiles + y * self->width_in_tiles + x, tile_indices, count);
+    // The span is shown in two pieces when it wraps around the right edge.
+    uint16_t tx = _relative_x(self, x);
+    uint16_t ty = _relative_y(self, y);
+    uint16_t first_count = self->width_in_tiles - tx;
+    if (count <= first_count) {
+        _mark_tiles_dirty(self, tx, ty, count);
+    } else {
+        _mark_tiles_dirty(self, tx, ty, first_count);
+        _mark_tiles_dirty(self, 0, ty, count - first_count);
+    }
 }
 
 bool common_hal_displayio_tilegrid_get_flip_x(displayio_tilegrid_t *self) {
@@ -305,12 +348,252 @@ void common_hal_displayio_tilegrid_set_transpose_xy(displayio_tilegrid_t *self,
 }
 
 void common_hal_displayio_tilegrid_set_top_left(displayio_tilegrid_t *self, uint16_t x, uint16_t y) {
+    bool first_draw = self->previous_area.x1 == self->previous_area.x2;
+    uint16_t rows = (y + self->height_in_tiles - self->top_left_y) % self->height_in_tiles;
+    uint16_t pixels = rows * self->tile_height;
+    bool same_x = x == self->top_left_x;
     self->top_left_x = x;
     self->top_left_y = y;
+    if (!self->hardware_scroll || !same_x || first_draw || self->full_change || self->moved ||
+        self->hidden || self->hidden_by_parent || self->scrolled_pixels + pixels >= self->pixel_height) {
+        self->scrolled_pixels = 0;
+        self->full_change = true;
+        return;
+    }
+    if (rows == 0) {
+        return;
+    }
+    // The display moves what is already shown up so only the rows that wrapped around to the
+    // bottom need to be drawn. Shift pending changes up with everything else.
+    self->scrolled_pixels += pixels;
+    if (self->partial_change) {
+        self->dirty_area.y1 -= pixels;
+        self->dirty_area.y2 -= pixels;
+        if (self->dirty_area.y2 <= 0) {
+            self->partial_change = false;
+        } else if (self->dirty_area.y1 < 0) {
+            self->dirty_area.y1 = 0;
+        }
+    }
+    displayio_area_t new_rows = {0, self->pixel_height - pixels, self->pixel_width, self->pixel_height, NULL};
+    if (self->partial_change) {
+        displayio_area_expand(&self->dirty_area, &new_rows);
+    } else {
+        displayio_area_copy(&new_rows, &self->dirty_area);
+    }
+    self->partial_change = true;
+}
+
+uint16_t displayio_tilegrid_animation_count = 0;
+
+void common_hal_displayio_tilegrid_animate(displayio_tilegrid_t *self, const uint8_t* frames, uint16_t frame_count,
+        uint32_t frame_period_ms, int16_t dx, int16_t dy, bool loop) {
+    for (uint16_t i = 0; i < frame_count; i++) {
+        if (frames[i] >= self->tiles_in_bitmap) {
+            mp_raise_ValueError(translate("Tile index out of bounds"));
+        }
+    }
+    displayio_tilegrid_animation_t* animation = self->animation;
+    if (animation == NULL) {
+        animation = m_new_obj(displayio_tilegrid_animation_t);
+        displayio_tilegrid_animation_count++;
+    }
+    animation->frames = NULL;
+    if (frame_count > 0) {
+        animation->frames = m_new(uint8_t, frame_count);
+        memcpy(animation->frames, frames, frame_count);
+    }
+    animation->frame_count = frame_count;
+    animation->frame_period_ms = frame_period_ms;
+    animation->start_ms = supervisor_ticks_ms64();
+    animation->start_x = self->x;
+    animation->start_y = self->y;
+    animation->dx = dx;
+    animation->dy = dy;
+    animation->loop = loop;
+    animation->frame = 0xffff;
+    self->animation = animation;
+    displayio_tilegrid_animate(self, animation->start_ms);
+}
+
+void common_hal_displayio_tilegrid_stop_animation(displayio_tilegrid_t *self) {
+    if (self->animation == NULL) {
+        return;
+    }
+    self->animation = NULL;
+    displayio_tilegrid_animation_count--;
+}
+
+bool common_hal_displayio_tilegrid_get_animating(displayio_tilegrid_t *self) {
+    return self->animation != NULL;
+}
+
+void displayio_tilegrid_animate(displayio_tilegrid_t *self, uint64_t now_ms) {
+    displayio_tilegrid_animation_t* animation = self->animation;
+    if (animation == NULL) {
+        return;
+    }
+    // Everything is computed from the start so rounding doesn't add up over time.
+    int64_t elapsed_ms = now_ms - animation->start_ms;
+    common_hal_displayio_tilegrid_set_x(self, animation->start_x + animation->dx * elapsed_ms / 1000);
+    common_hal_displayio_tilegrid_set_y(self, animation->start_y + animation->dy * elapsed_ms / 1000);
+
+    if (animation->frame_count == 0) {
+        return;
+    }
+    uint32_t frame = 0;
+    if (animation->frame_period_ms > 0) {
+        uint64_t frames_elapsed = elapsed_ms / animation->frame_period_ms;
+        if (animation->loop) {
+            frame = frames_elapsed % animation->frame_count;
+        } else if (frames_elapsed < animation->frame_count) {
+            frame = frames_elapsed;
+        } else {
+            frame = animation->frame_count - 1;
+        }
+    }
+    uint8_t* tiles = self->tiles;
+    if (self->inline_tiles) {
+        tiles = (uint8_t*) &self->tiles;
+    }
+    if (tiles == NULL) {
+        return;
+    }
+    if (frame == animation->frame) {
+        return;
+    }
+    animation->frame = frame;
+    memset(tiles, animation->frames[frame], self->width_in_tiles * self->height_in_tiles);
     self->full_change = true;
 }
 
-bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self, const _displayio_colorspace_t* colorspace, const displayio_area_t* area, uint32_t* mask, uint32_t *buffer) {
+// Number of pixels the fast path reads and converts at once.
+#define FILL_RUN_LENGTH (32)
+
+// Reads count values from a row of the source bitmap starting at x, y.
+STATIC void _read_run(mp_obj_t source, int16_t x, int16_t y, uint32_t* values, uint16_t count) {
+    #if CIRCUITPY_DISPLAYIO_HARDWARE
+    if (MP_OBJ_IS_TYPE(source, &displayio_ondiskbitmap_type)) {
+        displayio_ondiskbitmap_get_row(source, x, y, values, count);
+        return;
+    }
+    #endif
+    if (MP_OBJ_IS_TYPE(source, &displayio_rlebitmap_type)) {
+        displayio_rlebitmap_get_row(source, x, y, values, count);
+        return;
+    }
+    displayio_bitmap_t* bitmap = source;
+    if (y < 0 || y >= bitmap->height) {
+        memset(values, 0, count * sizeof(uint32_t));
+        return;
+    }
+    size_t* row = bitmap->data + y * bitmap->stride;
+    uint8_t bits_per_value = bitmap->bits_per_value;
+    if (bits_per_value < 8) {
+        for (uint16_t i = 0; i < count; i++, x++) {
+            size_t word = row[x >> bitmap->x_shift];
+            values[i] = (word >> (sizeof(size_t) * 8 - ((x & bitmap->x_mask) + 1) * bits_per_value)) & bitmap->bitmask;
+        }
+    } else if (bits_per_value == 8) {
+        for (uint16_t i = 0; i < count; i++) {
+            values[i] = ((uint8_t*) row)[x + i];
+        }
+    } else if (bits_per_value == 16) {
+        for (uint16_t i = 0; i < count; i++) {
+            values[i] = ((uint16_t*) row)[x + i];
+        }
+    } else {
+        for (uint16_t i = 0; i < count; i++) {
+            values[i] = ((uint32_t*) row)[x + i];
+        }
+    }
+}
+
+// Converts count values through the pixel shader in place. Transparent results are set to
+// DISPLAYIO_PALETTE_TRANSPARENT.
+STATIC void _convert_run(mp_obj_t pixel_shader, const uint32_t* converted_colors, const _displayio_colorspace_t* colorspace,
+        uint32_t* values, uint16_t x, uint16_t y, uint16_t count) {
+    if (pixel_shader == mp_const_none) {
+        for (uint16_t i = 0; i < count; i++) {
+            // Only the low bits are ever written out.
+            values[i] &= 0xffff;
+        }
+    } else if (MP_OBJ_IS_TYPE(pixel_shader, &displayio_palette_type)) {
+        displayio_palette_t* palette = pixel_shader;
+        for (uint16_t i = 0; i < count; i++) {
+            uint32_t value = values[i];
+            if (converted_colors != NULL) {
+                values[i] = value < palette->color_count ? converted_colors[value] : DISPLAYIO_PALETTE_TRANSPARENT;
+            } else if (!displayio_palette_get_color(palette, colorspace, value, &values[i])) {
+                values[i] = DISPLAYIO_PALETTE_TRANSPARENT;
+            }
+        }
+    } else if (!displayio_colorconverter_convert_row(pixel_shader, colorspace, values, x, y, values, count)) {
+        for (uint16_t i = 0; i < count; i++) {
+            values[i] = DISPLAYIO_PALETTE_TRANSPARENT;
+        }
+    }
+}
+
+// Fast path for an unscaled TileGrid that isn't flipped or transposed relative to the display and
+// draws onto a display with whole bytes per pixel. Tiles are looked up once per run of pixels in a
+// tile, and each run is read and converted at once instead of pixel by pixel.
+STATIC bool _fill_area_unscaled(displayio_tilegrid_t *self, uint8_t* tiles, const _displayio_colorspace_t* colorspace,
+        int16_t start_x, int16_t end_x, int16_t start_y, int16_t end_y, int16_t x_shift, int16_t y_shift,
+        uint16_t buffer_width, uint32_t* mask, uint32_t *buffer, bool full_coverage) {
+    const uint32_t* converted_colors = NULL;
+    if (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_palette_type)) {
+        converted_colors = displayio_palette_get_converted_colors(self->pixel_shader, colorspace);
+    }
+    uint32_t values[FILL_RUN_LENGTH];
+
+    for (int16_t y = start_y; y < end_y; y++) {
+        int16_t row_start = (y - start_y + y_shift) * buffer_width; // in pixels
+        uint16_t tile_row = ((y / self->tile_height + self->top_left_y) % self->height_in_tiles) * self->width_in_tiles;
+        uint16_t y_in_tile = y % self->tile_height;
+        int16_t x = start_x;
+        while (x < end_x) {
+            uint16_t x_in_tile = x % self->tile_width;
+            int16_t run_end = x - x_in_tile + self->tile_width;
+            if (run_end > end_x) {
+                run_end = end_x;
+            }
+            if (run_end - x > FILL_RUN_LENGTH) {
+                run_end = x + FILL_RUN_LENGTH;
+            }
+            uint16_t count = run_end - x;
+            uint8_t tile = tiles[tile_row + (x / self->tile_width + self->top_left_x) % self->width_in_tiles];
+            int16_t tile_x = (tile % self->bitmap_width_in_tiles) * self->tile_width + x_in_tile;
+            int16_t tile_y = (tile / self->bitmap_width_in_tiles) * self->tile_height + y_in_tile;
+
+            _read_run(self->bitmap, tile_x, tile_y, values, count);
+            _convert_run(self->pixel_shader, converted_colors, colorspace, values, tile_x, tile_y, count);
+
+            int16_t offset = row_start + (x - start_x + x_shift);
+            for (uint16_t i = 0; i < count; i++, offset++) {
+                // Check the mask first to see if the pixel has already been set.
+                if ((mask[offset / 32] & (1 << (offset % 32))) != 0) {
+                    continue;
+                }
+                if (values[i] == DISPLAYIO_PALETTE_TRANSPARENT) {
+                    // A pixel is transparent so we haven't fully covered the area ourselves.
+                    full_coverage = false;
+                    continue;
+                }
+                mask[offset / 32] |= 1 << (offset % 32);
+                if (colorspace->depth == 16) {
+                    *(((uint16_t*) buffer) + offset) = values[i];
+                } else {
+                    *(((uint8_t*) buffer) + offset) = values[i];
+                }
+            }
+            x = run_end;
+        }
+    }
+    return full_coverage;
+}
+
+bool PLACE_IN_ITCM(displayio_tilegrid_fill_area)(displayio_tilegrid_t *self, const _displayio_colorspace_t* colorspace, const displayio_area_t* area, uint32_t* mask, uint32_t *buffer) {
     // If no tiles are present we have no impact.
     uint8_t* tiles = self->tiles;
     if (self->inline_tiles) {
@@ -395,6 +678,21 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self, const _displayio_c
         y_shift = temp_shift;
     }
 
+    if (self->absolute_transform->scale == 1 && start == 0 && x_stride == 1 &&
+            self->transpose_xy == self->absolute_transform->transpose_xy &&
+            (colorspace->depth == 16 || colorspace->depth == 8) &&
+            (MP_OBJ_IS_TYPE(self->bitmap, &displayio_bitmap_type) ||
+             #if CIRCUITPY_DISPLAYIO_HARDWARE
+             MP_OBJ_IS_TYPE(self->bitmap, &displayio_ondiskbitmap_type) ||
+             #endif
+             MP_OBJ_IS_TYPE(self->bitmap, &displayio_rlebitmap_type)) &&
+            (self->pixel_shader == mp_const_none ||
+             MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_palette_type) ||
+             MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_colorconverter_type))) {
+        return _fill_area_unscaled(self, tiles, colorspace, start_x, end_x, start_y, end_y, x_shift, y_shift,
+                                   y_stride, mask, buffer, full_coverage);
+    }
+
     uint8_t pixels_per_byte = 8 / colorspace->depth;
 
     displayio_input_pixel_t input_pixel;
@@ -432,8 +730,12 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self, const _displayio_c
                 input_pixel.pixel = common_hal_displayio_bitmap_get_pixel(self->bitmap, input_pixel.tile_x, input_pixel.tile_y);
             } else if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_shape_type)) {
                 input_pixel.pixel = common_hal_displayio_shape_get_pixel(self->bitmap, input_pixel.tile_x, input_pixel.tile_y);
+            #if CIRCUITPY_DISPLAYIO_HARDWARE
             } else if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_ondiskbitmap_type)) {
                 input_pixel.pixel = common_hal_displayio_ondiskbitmap_get_pixel(self->bitmap, input_pixel.tile_x, input_pixel.tile_y);
+            #endif
+            } else if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_rlebitmap_type)) {
+                input_pixel.pixel = common_hal_displayio_rlebitmap_get_pixel(self->bitmap, input_pixel.tile_x, input_pixel.tile_y);
             }
             
             output_pixel.opaque = true;
@@ -491,6 +793,7 @@ void displayio_tilegrid_finish_refresh(displayio_tilegrid_t *self) {
     self->moved = false;
     self->full_change = false;
     self->partial_change = false;
+    self->scrolled_pixels = 0;
     if (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_palette_type)) {
         displayio_palette_finish_refresh(self->pixel_shader);
     } else if (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_colorconverter_type)) {
@@ -499,15 +802,65 @@ void displayio_tilegrid_finish_refresh(displayio_tilegrid_t *self) {
     if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_bitmap_type)) {
         displayio_bitmap_finish_refresh(self->bitmap);
     } else if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_shape_type)) {
-        // TODO: Support shape changes.
+        displayio_shape_finish_refresh(self->bitmap);
+    #if CIRCUITPY_DISPLAYIO_HARDWARE
     } else if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_ondiskbitmap_type)) {
         // OnDiskBitmap changes will trigger a complete reload so no need to
         // track changes.
+    #endif
+    } else if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_rlebitmap_type)) {
+        // RLEBitmaps are read-only.
     }
     // TODO(tannewt): We could double buffer changes to position and move them over here.
     // That way they won't change during a refresh and tear.
 }
 
+// Copies the changed areas of a full bitmap, which end at tail, into ours so we can transform
+// them. The first goes in dirty_area unless it is already in use. Returns the number put in
+// bitmap_dirty_areas.
+STATIC uint8_t _copy_dirty_areas(displayio_tilegrid_t *self, const displayio_area_t* areas, const displayio_area_t* tail) {
+    uint8_t count = 0;
+    for (const displayio_area_t* area = areas; area != tail; area = area->next) {
+        if (!self->partial_change) {
+            displayio_area_copy(area, &self->dirty_area);
+            self->partial_change = true;
+        } else if (count < DISPLAYIO_BITMAP_DIRTY_AREAS - 1) {
+            displayio_area_copy(area, &self->bitmap_dirty_areas[count]);
+            count++;
+        } else {
+            displayio_area_expand(&self->dirty_area, area);
+        }
+    }
+    return count;
+}
+
+// Turns a relative area into an absolute one.
+STATIC void _transform_dirty_area(displayio_tilegrid_t *self, displayio_area_t* area) {
+    if (self->absolute_transform->transpose_xy) {
+        int16_t x1 = area->x1;
+        area->x1 = self->absolute_transform->x + self->absolute_transform->dx * (self->y + area->y1);
+        area->y1 = self->absolute_transform->y + self->absolute_transform->dy * (self->x + x1);
+        int16_t x2 = area->x2;
+        area->x2 = self->absolute_transform->x + self->absolute_transform->dx * (self->y + area->y2);
+        area->y2 = self->absolute_transform->y + self->absolute_transform->dy * (self->x + x2);
+    } else {
+        area->x1 = self->absolute_transform->x + self->absolute_transform->dx * (self->x + area->x1);
+        area->y1 = self->absolute_transform->y + self->absolute_transform->dy * (self->y + area->y1);
+        area->x2 = self->absolute_transform->x + self->absolute_transform->dx * (self->x + area->x2);
+        area->y2 = self->absolute_transform->y + self->absolute_transform->dy * (self->y + area->y2);
+    }
+    if (area->y2 < area->y1) {
+        int16_t temp = area->y2;
+        area->y2 = area->y1;
+        area->y1 = temp;
+    }
+    if (area->x2 < area->x1) {
+        int16_t temp = area->x2;
+        area->x2 = area->x1;
+        area->x1 = temp;
+    }
+}
+
 displayio_area_t* displayio_tilegrid_get_refresh_areas(displayio_tilegrid_t *self, displayio_area_t* tail) {
     bool first_draw = self->previous_area.x1 == self->previous_area.x2;
     bool hidden = self->hidden || self->hidden_by_parent;
@@ -531,14 +884,23 @@ displayio_area_t* displayio_tilegrid_get_refresh_areas(displayio_tilegrid_t *sel
     }
 
     // If we have an in-memory bitmap, then check it for modifications.
+    uint8_t bitmap_dirty_areas = 0;
     if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_bitmap_type)) {
         displayio_area_t* refresh_area = displayio_bitmap_get_refresh_areas(self->bitmap, tail);
         if (refresh_area != tail) {
             // Special case a TileGrid that shows a full bitmap and use its
-            // dirty area. Copy it to ours so we can transform it.
+            // dirty areas. Copy them to ours so we can transform them.
             if (self->tiles_in_bitmap == 1) {
-                displayio_area_copy(refresh_area, &self->dirty_area);
-                self->partial_change = true;
+                bitmap_dirty_areas = _copy_dirty_areas(self, refresh_area, tail);
+            } else {
+                self->full_change = true;
+            }
+        }
+    } else if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_shape_type)) {
+        displayio_area_t* refresh_area = displayio_shape_get_refresh_areas(self->bitmap, tail);
+        if (refresh_area != tail) {
+            if (self->tiles_in_bitmap == 1) {
+                bitmap_dirty_areas = _copy_dirty_areas(self, refresh_area, tail);
             } else {
                 self->full_change = true;
             }
@@ -556,30 +918,12 @@ displayio_area_t* displayio_tilegrid_get_refresh_areas(displayio_tilegrid_t *sel
     }
 
     if (self->partial_change) {
-        if (self->absolute_transform->transpose_xy) {
-            int16_t x1 = self->dirty_area.x1;
-            self->dirty_area.x1 = self->absolute_transform->x + self->absolute_transform->dx * (self->y + self->dirty_area.y1);
-            self->dirty_area.y1 = self->absolute_transform->y + self->absolute_transform->dy * (self->x + x1);
-            int16_t x2 = self->dirty_area.x2;
-            self->dirty_area.x2 = self->absolute_transform->x + self->absolute_transform->dx * (self->y + self->dirty_area.y2);
-            self->dirty_area.y2 = self->absolute_transform->y + self->absolute_transform->dy * (self->x + x2);
-        } else {
-            self->dirty_area.x1 = self->absolute_transform->x + self->absolute_transform->dx * (self->x + self->dirty_area.x1);
-            self->dirty_area.y1 = self->absolute_transform->y + self->absolute_transform->dy * (self->y + self->dirty_area.y1);
-            self->dirty_area.x2 = self->absolute_transform->x + self->absolute_transform->dx * (self->x + self->dirty_area.x2);
-            self->dirty_area.y2 = self->absolute_transform->y + self->absolute_transform->dy * (self->y + self->dirty_area.y2);
-        }
-        if (self->dirty_area.y2 < self->dirty_area.y1) {
-            int16_t temp = self->dirty_area.y2;
-            self->dirty_area.y2 = self->dirty_area.y1;
-            self->dirty_area.y1 = temp;
+        for (int8_t i = bitmap_dirty_areas - 1; i >= 0; i--) {
+            _transform_dirty_area(self, &self->bitmap_dirty_areas[i]);
+            self->bitmap_dirty_areas[i].next = tail;
+            tail = &self->bitmap_dirty_areas[i];
         }
-        if (self->dirty_area.x2 < self->dirty_area.x1) {
-            int16_t temp = self->dirty_area.x2;
-            self->dirty_area.x2 = self->dirty_area.x1;
-            self->dirty_area.x1 = temp;
-        }
-
+        _transform_dirty_area(self, &self->dirty_area);
         self->dirty_area.next = tail;
         return &self->dirty_area;
     }
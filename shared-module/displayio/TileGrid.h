@@ -32,8 +32,23 @@
 
 #include "py/obj.h"
 #include "shared-module/displayio/area.h"
+#include "shared-module/displayio/Bitmap.h"
 #include "shared-module/displayio/Palette.h"
 
+// Frames and movement that displayio_background() applies to a TileGrid over time.
+typedef struct {
+    uint8_t* frames; // Tile index to show on every tile for each frame.
+    uint64_t start_ms;
+    uint32_t frame_period_ms;
+    uint16_t frame_count;
+    uint16_t frame; // Frame last shown.
+    int16_t start_x;
+    int16_t start_y;
+    int16_t dx; // Pixels per second.
+    int16_t dy;
+    bool loop;
+} displayio_tilegrid_animation_t;
+
 typedef struct {
     mp_obj_base_t base;
     mp_obj_t bitmap;
@@ -50,9 +65,13 @@ typedef struct {
     uint16_t tile_height;
     uint16_t top_left_x;
     uint16_t top_left_y;
+    uint16_t scrolled_pixels; // Local rows the tiles moved up by in hardware since the last refresh.
     uint8_t* tiles;
+    displayio_tilegrid_animation_t* animation; // NULL when not animating.
     const displayio_buffer_transform_t* absolute_transform;
     displayio_area_t dirty_area; // Stored as a relative area until the refresh area is fetched.
+    // Further areas of a full bitmap that changed. Only valid while refresh areas are fetched.
+    displayio_area_t bitmap_dirty_areas[DISPLAYIO_BITMAP_DIRTY_AREAS - 1];
     displayio_area_t previous_area; // Stored as an absolute area.
     displayio_area_t current_area; // Stored as an absolute area so it applies across frames.
     bool partial_change :1;
@@ -65,11 +84,22 @@ typedef struct {
     bool transpose_xy  :1;
     bool hidden :1;
     bool hidden_by_parent :1;
-    uint8_t padding :6;
+    bool hardware_scroll :1; // The display scrolls this grid itself when top_left_y changes.
+    uint8_t padding :5;
 } displayio_tilegrid_t;
 
 void displayio_tilegrid_set_hidden_by_parent(displayio_tilegrid_t *self, bool hidden);
 
+// Sets count tiles in row y starting at x, which must all fit in the row, and marks them changed
+// together. Tile indices aren't checked against the bitmap.
+void displayio_tilegrid_set_tile_span(displayio_tilegrid_t *self, uint16_t x, uint16_t y, const uint8_t* tile_indices, uint16_t count);
+
+// Number of TileGrids that are animating so that displays can skip looking for them.
+extern uint16_t displayio_tilegrid_animation_count;
+
+// Shows the frame and position for the given time.
+void displayio_tilegrid_animate(displayio_tilegrid_t *self, uint64_t now_ms);
+
 // Updating the screen is a three stage process.
 
 // The first stage is used to determine i
@@ -6,14 +6,18 @@
 #include "lib/utils/interrupt_char.h"
 #include "py/reload.h"
 #include "py/runtime.h"
+#if CIRCUITPY_DISPLAYIO_HARDWARE
 #include "shared-bindings/board/__init__.h"
+#endif
 #include "shared-bindings/displayio/Bitmap.h"
 #include "shared-bindings/displayio/Display.h"
 #include "shared-bindings/displayio/Group.h"
 #include "shared-bindings/displayio/Palette.h"
+#include "shared-bindings/displayio/TileGrid.h"
 #include "shared-module/displayio/area.h"
 #include "supervisor/shared/autoreload.h"
 #include "supervisor/shared/display.h"
+#include "supervisor/shared/tick.h"
 #include "supervisor/memory.h"
 
 primary_display_t displays[CIRCUITPY_DISPLAY_LIMIT];
@@ -21,6 +25,15 @@ primary_display_t displays[CIRCUITPY_DISPLAY_LIMIT];
 // Check for recursive calls to displayio_background.
 bool displayio_background_in_progress = false;
 
+// Moves animated TileGrids along before the display refreshes. Their changes are picked up by
+// the normal refresh.
+STATIC void _animate(displayio_display_core_t* core) {
+    if (displayio_tilegrid_animation_count == 0 || core->current_group == NULL) {
+        return;
+    }
+    displayio_group_animate(core->current_group, supervisor_ticks_ms64());
+}
+
 void displayio_background(void) {
     if (mp_hal_is_interrupted()) {
         return;
@@ -43,9 +56,13 @@ void displayio_background(void) {
             continue;
         }
         if (displays[i].display.base.type == &displayio_display_type) {
+            _animate(&displays[i].display.core);
             displayio_display_background(&displays[i].display);
+        #if CIRCUITPY_DISPLAYIO_HARDWARE
         } else if (displays[i].epaper_display.base.type == &displayio_epaperdisplay_type) {
+            _animate(&displays[i].epaper_display.core);
             displayio_epaperdisplay_background(&displays[i].epaper_display);
+        #endif
         }
     }
 
@@ -62,29 +79,41 @@ void common_hal_displayio_release_displays(void) {
             continue;
         } else if (display_type == &displayio_display_type) {
             release_display(&displays[i].display);
+        #if CIRCUITPY_DISPLAYIO_HARDWARE
         } else if (display_type == &displayio_epaperdisplay_type) {
             release_epaperdisplay(&displays[i].epaper_display);
+        #endif
         }
         displays[i].display.base.type = &mp_type_NoneType;
     }
     for (uint8_t i = 0; i < CIRCUITPY_DISPLAY_LIMIT; i++) {
-        mp_const_obj_t bus_type = displays[i].fourwire_bus.base.type;
+        mp_const_obj_t bus_type = displays[i].bus_base.type;
         if (bus_type == NULL || bus_type == &mp_type_NoneType) {
             continue;
+        #if CIRCUITPY_DISPLAYIO_HARDWARE
         } else if (bus_type == &displayio_fourwire_type) {
             common_hal_displayio_fourwire_deinit(&displays[i].fourwire_bus);
         } else if (bus_type == &displayio_i2cdisplay_type) {
             common_hal_displayio_i2cdisplay_deinit(&displays[i].i2cdisplay_bus);
         } else if (bus_type == &displayio_parallelbus_type) {
             common_hal_displayio_parallelbus_deinit(&displays[i].parallel_bus);
+        #endif
+        #if CIRCUITPY_DISPLAYIO_FRAMEBUFFERBUS
+        } else if (bus_type == &displayio_framebufferbus_type) {
+            common_hal_displayio_framebufferbus_deinit(&displays[i].framebuffer_bus);
+        #endif
         }
-        displays[i].fourwire_bus.base.type = &mp_type_NoneType;
+        displays[i].bus_base.type = &mp_type_NoneType;
     }
 
     supervisor_stop_terminal();
 }
 
 void reset_displays(void) {
+    // Animated TileGrids are on the heap and go away with it.
+    displayio_tilegrid_animation_count = 0;
+
+    #if CIRCUITPY_DISPLAYIO_HARDWARE
     // The SPI buses used by FourWires may be allocated on the heap so we need to move them inline.
     for (uint8_t i = 0; i < CIRCUITPY_DISPLAY_LIMIT; i++) {
         if (displays[i].fourwire_bus.base.type == &displayio_fourwire_type) {
@@ -138,15 +167,18 @@ void reset_displays(void) {
             continue;
         }
     }
+    #endif
 
     for (uint8_t i = 0; i < CIRCUITPY_DISPLAY_LIMIT; i++) {
         // Reset the displayed group. Only the first will get the terminal but
         // that's ok.
         if (displays[i].display.base.type == &displayio_display_type) {
             reset_display(&displays[i].display);
+        #if CIRCUITPY_DISPLAYIO_HARDWARE
         } else if (displays[i].epaper_display.base.type == &displayio_epaperdisplay_type) {
             displayio_epaperdisplay_obj_t* display = &displays[i].epaper_display;
             common_hal_displayio_epaperdisplay_show(display, NULL);
+        #endif
         }
     }
 }
@@ -161,8 +193,10 @@ void displayio_gc_collect(void) {
         // but this is more precise, and is the only field that needs marking.
         if (displays[i].display.base.type == &displayio_display_type) {
             displayio_display_collect_ptrs(&displays[i].display);
+        #if CIRCUITPY_DISPLAYIO_HARDWARE
         } else if (displays[i].epaper_display.base.type == &displayio_epaperdisplay_type) {
             displayio_epaperdisplay_collect_ptrs(&displays[i].epaper_display);
+        #endif
         }
     }
 }
@@ -272,6 +306,85 @@ bool displayio_area_equal(const displayio_area_t* a, const displayio_area_t* b)
            a->y2 == b->y2;
 }
 
+// Returns how much more it costs to refresh the union of a and b than to refresh both separately.
+// Negative values mean the union is cheaper. Pixels covered by both areas are refreshed twice when
+// they are separate.
+STATIC int32_t _merge_cost(const displayio_area_t* a, const displayio_area_t* b, uint32_t overhead) {
+    displayio_area_t u;
+    displayio_area_union(a, b, &u);
+    return (int32_t) displayio_area_size(&u) - (int32_t) (displayio_area_size(a) + displayio_area_size(b) + overhead);
+}
+
+// Finds the pair of merged areas that is cheapest to combine and returns its cost.
+STATIC int32_t _cheapest_pair(const displayio_area_t* merged, uint16_t count, uint32_t overhead,
+                              uint16_t* best_i, uint16_t* best_j) {
+    int32_t best_cost = INT32_MAX;
+    for (uint16_t i = 0; i < count; i++) {
+        for (uint16_t j = i + 1; j < count; j++) {
+            int32_t cost = _merge_cost(&merged[i], &merged[j], overhead);
+            if (cost < best_cost) {
+                *best_i = i;
+                *best_j = j;
+                best_cost = cost;
+            }
+        }
+    }
+    return best_cost;
+}
+
+// Merges area j into area i and fills its slot with the last area.
+STATIC uint16_t _merge_pair(displayio_area_t* merged, uint16_t count, uint16_t i, uint16_t j) {
+    displayio_area_expand(&merged[i], &merged[j]);
+    count--;
+    if (j != count) {
+        displayio_area_copy(&merged[count], &merged[j]);
+    }
+    return count;
+}
+
+uint16_t displayio_area_coalesce(const displayio_area_t* areas, displayio_area_t* merged,
+                                 uint16_t max_merged, uint32_t overhead) {
+    uint16_t count = 0;
+    uint16_t best_i = 0;
+    uint16_t best_j = 0;
+    for (const displayio_area_t* area = areas; area != NULL; area = area->next) {
+        if (displayio_area_size(area) == 0) {
+            continue;
+        }
+        if (count == max_merged) {
+            // Out of room. Either grow the merged area that's cheapest to add this one to or
+            // combine two merged areas to make room, whichever wastes less.
+            uint16_t best = 0;
+            int32_t best_cost = _merge_cost(&merged[0], area, overhead);
+            for (uint16_t i = 1; i < count; i++) {
+                int32_t cost = _merge_cost(&merged[i], area, overhead);
+                if (cost < best_cost) {
+                    best = i;
+                    best_cost = cost;
+                }
+            }
+            if (count < 2 || best_cost <= _cheapest_pair(merged, count, overhead, &best_i, &best_j)) {
+                displayio_area_expand(&merged[best], area);
+                continue;
+            }
+            count = _merge_pair(merged, count, best_i, best_j);
+        }
+        displayio_area_copy(area, &merged[count]);
+        count++;
+    }
+
+    // Keep merging the cheapest pair until no merge saves anything. Area lists are short so the
+    // quadratic search is fine.
+    while (count > 1 && _cheapest_pair(merged, count, overhead, &best_i, &best_j) <= 0) {
+        count = _merge_pair(merged, count, best_i, best_j);
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        merged[i].next = i + 1 < count ? &merged[i + 1] : NULL;
+    }
+    return count;
+}
+
 // Original and whole must be in the same coordinate space.
 void displayio_area_transform_within(bool mirror_x, bool mirror_y, bool transpose_xy,
                                      const displayio_area_t* original,
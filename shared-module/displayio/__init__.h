@@ -28,21 +28,34 @@
 #define MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO___INIT___H
 
 #include "shared-bindings/displayio/Display.h"
+#include "shared-bindings/displayio/Group.h"
+#if CIRCUITPY_DISPLAYIO_HARDWARE
 #include "shared-bindings/displayio/EPaperDisplay.h"
 #include "shared-bindings/displayio/FourWire.h"
-#include "shared-bindings/displayio/Group.h"
 #include "shared-bindings/displayio/I2CDisplay.h"
 #include "shared-bindings/displayio/ParallelBus.h"
+#endif
+#if CIRCUITPY_DISPLAYIO_FRAMEBUFFERBUS
+#include "shared-bindings/displayio/FramebufferBus.h"
+#endif
 
 typedef struct {
     union {
+        mp_obj_base_t bus_base; // Type of whichever bus is in use.
+        #if CIRCUITPY_DISPLAYIO_HARDWARE
         displayio_fourwire_obj_t fourwire_bus;
         displayio_i2cdisplay_obj_t i2cdisplay_bus;
         displayio_parallelbus_obj_t parallel_bus;
+        #endif
+        #if CIRCUITPY_DISPLAYIO_FRAMEBUFFERBUS
+        displayio_framebufferbus_obj_t framebuffer_bus;
+        #endif
     };
     union {
         displayio_display_obj_t display;
+        #if CIRCUITPY_DISPLAYIO_HARDWARE
         displayio_epaperdisplay_obj_t epaper_display;
+        #endif
     };
 } primary_display_t;
 
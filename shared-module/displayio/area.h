@@ -65,6 +65,11 @@ uint16_t displayio_area_width(const displayio_area_t* area);
 uint16_t displayio_area_height(const displayio_area_t* area);
 uint32_t displayio_area_size(const displayio_area_t* area);
 bool displayio_area_equal(const displayio_area_t* a, const displayio_area_t* b);
+// Copies the areas in the linked list into the merged array, combining areas when refreshing their
+// union costs less than refreshing them separately. overhead is the fixed cost of refreshing one
+// area, in pixels. Returns the number of merged areas. They are linked together in order.
+uint16_t displayio_area_coalesce(const displayio_area_t* areas, displayio_area_t* merged,
+                                 uint16_t max_merged, uint32_t overhead);
 void displayio_area_transform_within(bool mirror_x, bool mirror_y, bool transpose_xy,
                                      const displayio_area_t* original,
                                      const displayio_area_t* whole,
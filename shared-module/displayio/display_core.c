@@ -28,10 +28,6 @@
 
 #include "py/gc.h"
 #include "py/runtime.h"
-#include "shared-bindings/displayio/FourWire.h"
-#include "shared-bindings/displayio/I2CDisplay.h"
-#include "shared-bindings/displayio/ParallelBus.h"
-#include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/time/__init__.h"
 #include "shared-module/displayio/__init__.h"
 #include "supervisor/shared/display.h"
@@ -42,9 +38,14 @@
 
 #include "tick.h"
 
+// Displays live outside the heap, in displays[].
+STATIC gc_root_t displays_gc_root;
+
 void displayio_display_core_construct(displayio_display_core_t* self,
         mp_obj_t bus, uint16_t width, uint16_t height, uint16_t ram_width, uint16_t ram_height, int16_t colstart, int16_t rowstart, uint16_t rotation,
         uint16_t color_depth, bool grayscale, bool pixels_in_byte_share_row, uint8_t bytes_per_cell, bool reverse_pixels_in_byte) {
+    gc_root_add_collect(&displays_gc_root, displayio_gc_collect);
+
     self->colorspace.depth = color_depth;
     self->colorspace.grayscale = grayscale;
     self->colorspace.pixels_in_byte_share_row = pixels_in_byte_share_row;
@@ -55,8 +56,11 @@ void displayio_display_core_construct(displayio_display_core_t* self,
     self->colstart = colstart;
     self->rowstart = rowstart;
     self->last_refresh = 0;
+    self->buffers = NULL;
 
-    if (MP_OBJ_IS_TYPE(bus, &displayio_parallelbus_type)) {
+    if (false) {
+    #if CIRCUITPY_DISPLAYIO_HARDWARE
+    } else if (MP_OBJ_IS_TYPE(bus, &displayio_parallelbus_type)) {
         self->bus_reset = common_hal_displayio_parallelbus_reset;
         self->bus_free = common_hal_displayio_parallelbus_bus_free;
         self->begin_transaction = common_hal_displayio_parallelbus_begin_transaction;
@@ -74,6 +78,15 @@ void displayio_display_core_construct(displayio_display_core_t* self,
         self->begin_transaction = common_hal_displayio_i2cdisplay_begin_transaction;
         self->send = common_hal_displayio_i2cdisplay_send;
         self->end_transaction = common_hal_displayio_i2cdisplay_end_transaction;
+    #endif
+    #if CIRCUITPY_DISPLAYIO_FRAMEBUFFERBUS
+    } else if (MP_OBJ_IS_TYPE(bus, &displayio_framebufferbus_type)) {
+        self->bus_reset = common_hal_displayio_framebufferbus_reset;
+        self->bus_free = common_hal_displayio_framebufferbus_bus_free;
+        self->begin_transaction = common_hal_displayio_framebufferbus_begin_transaction;
+        self->send = common_hal_displayio_framebufferbus_send;
+        self->end_transaction = common_hal_displayio_framebufferbus_end_transaction;
+    #endif
     } else {
         mp_raise_ValueError(translate("Unsupported display bus type"));
     }
@@ -292,6 +305,9 @@ void displayio_display_core_set_region_to_update(displayio_display_core_t* self,
 
 void displayio_display_core_start_refresh(displayio_display_core_t* self) {
     self->last_refresh = supervisor_ticks_ms64();
+    if (self->current_group != NULL) {
+        displayio_group_build_index(self->current_group);
+    }
 }
 
 void displayio_display_core_finish_refresh(displayio_display_core_t* self) {
@@ -306,6 +322,10 @@ void release_display_core(displayio_display_core_t* self) {
     if (self->current_group != NULL) {
         self->current_group->in_group = false;
     }
+    if (self->buffers != NULL) {
+        free_memory(self->buffers);
+        self->buffers = NULL;
+    }
 }
 
 void displayio_display_core_collect_ptrs(displayio_display_core_t* self) {
@@ -316,6 +336,35 @@ bool displayio_display_core_fill_area(displayio_display_core_t *self, displayio_
     return displayio_group_fill_area(self->current_group, &self->colorspace, area, mask, buffer);
 }
 
+void displayio_display_core_allocate_buffers(displayio_display_core_t* self) {
+    if (self->buffers != NULL) {
+        return;
+    }
+    // This will fail while the VM is running. supervisor_move_memory() tries again once the heap
+    // has been freed.
+    self->buffers = allocate_memory(2 * CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE * sizeof(uint32_t), false, true);
+}
+
+// Fills in buffers with up to two pixel buffers of CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE uint32_ts
+// and returns how many there are.
+uint8_t displayio_display_core_get_buffers(displayio_display_core_t* self, uint32_t** buffers) {
+    if (self->buffers == NULL) {
+        return 0;
+    }
+    buffers[0] = self->buffers->ptr;
+    buffers[1] = self->buffers->ptr + CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE;
+    return 2;
+}
+
+// merged must have room for DISPLAYIO_MAX_REFRESH_AREAS areas.
+const displayio_area_t* displayio_display_core_coalesce_areas(displayio_display_core_t* self, const displayio_area_t* areas, displayio_area_t* merged) {
+    uint32_t overhead = DISPLAYIO_AREA_OVERHEAD_BYTES * 8 / self->colorspace.depth;
+    if (displayio_area_coalesce(areas, merged, DISPLAYIO_MAX_REFRESH_AREAS, overhead) == 0) {
+        return NULL;
+    }
+    return merged;
+}
+
 bool displayio_display_core_clip_area(displayio_display_core_t *self, const displayio_area_t* area, displayio_area_t* clipped) {
     bool overlaps = displayio_area_compute_overlap(&self->area, area, clipped);
     if (!overlaps) {
@@ -31,9 +31,16 @@
 #include "shared-bindings/displayio/Group.h"
 
 #include "shared-module/displayio/area.h"
+#include "supervisor/memory.h"
 
 #define NO_COMMAND 0x100
 
+// Refresh areas past this many are merged into the others.
+#define DISPLAYIO_MAX_REFRESH_AREAS (16)
+// Rough cost of starting to refresh another area, such as setting the region to update. Weighed
+// against the pixels that merging areas would refresh needlessly.
+#define DISPLAYIO_AREA_OVERHEAD_BYTES (16)
+
 typedef struct {
     mp_obj_t bus;
     displayio_group_t *current_group;
@@ -53,6 +60,9 @@ typedef struct {
     _displayio_colorspace_t colorspace;
     int16_t colstart;
     int16_t rowstart;
+    // Two pixel buffers outside the heap so one can be filled while the other is sent. NULL when
+    // they couldn't be allocated and refresh falls back to a single buffer on the stack.
+    supervisor_allocation* buffers;
     bool full_refresh; // New group means we need to refresh the whole display.
 } displayio_display_core_t;
 
@@ -85,6 +95,11 @@ void displayio_display_core_collect_ptrs(displayio_display_core_t* self);
 
 bool displayio_display_core_fill_area(displayio_display_core_t *self, displayio_area_t* area, uint32_t* mask, uint32_t *buffer);
 
+void displayio_display_core_allocate_buffers(displayio_display_core_t* self);
+uint8_t displayio_display_core_get_buffers(displayio_display_core_t* self, uint32_t** buffers);
+
+const displayio_area_t* displayio_display_core_coalesce_areas(displayio_display_core_t* self, const displayio_area_t* areas, displayio_area_t* merged);
+
 bool displayio_display_core_clip_area(displayio_display_core_t *self, const displayio_area_t* area, displayio_area_t* clipped);
 
 #endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_DISPLAY_CORE_H
@@ -0,0 +1,291 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-module/displayio/vector.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+// Coverage is out of 256.
+STATIC void _plot(const displayio_vector_pen_t* pen, int16_t x, int16_t y, uint16_t coverage) {
+    if (y < 0 || y >= pen->height) {
+        return;
+    }
+    if (pen->ramp <= 1) {
+        if (coverage >= 128) {
+            pen->span(pen->target, x, x + 1, y, pen->value);
+        }
+        return;
+    }
+    uint32_t level = (256 - coverage) * pen->ramp / 256;
+    if (level >= pen->ramp) {
+        return;
+    }
+    pen->span(pen->target, x, x + 1, y, pen->value + level);
+}
+
+STATIC void _span(const displayio_vector_pen_t* pen, int16_t x1, int16_t x2, int16_t y) {
+    if (y < 0 || y >= pen->height || x1 >= x2) {
+        return;
+    }
+    pen->span(pen->target, x1, x2, y, pen->value);
+}
+
+STATIC uint32_t _isqrt(uint32_t n) {
+    uint32_t root = 0;
+    uint32_t bit = 1u << 30;
+    while (bit > n) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+void displayio_vector_line(const displayio_vector_pen_t* pen, int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    int32_t dx = abs(x1 - x0);
+    int32_t dy = abs(y1 - y0);
+    if (pen->ramp <= 1) {
+        // Bresenham's line.
+        int16_t sx = x0 < x1 ? 1 : -1;
+        int16_t sy = y0 < y1 ? 1 : -1;
+        int32_t error = dx - dy;
+        while (true) {
+            _plot(pen, x0, y0, 256);
+            if (x0 == x1 && y0 == y1) {
+                break;
+            }
+            int32_t error2 = 2 * error;
+            if (error2 > -dy) {
+                error -= dy;
+                x0 += sx;
+            }
+            if (error2 < dx) {
+                error += dx;
+                y0 += sy;
+            }
+        }
+        return;
+    }
+    // Xiaolin Wu's line splits each step's coverage between the two nearest pixels.
+    bool steep = dy > dx;
+    int16_t temp;
+    if (steep) {
+        temp = x0; x0 = y0; y0 = temp;
+        temp = x1; x1 = y1; y1 = temp;
+        dx = dy;
+    }
+    if (x0 > x1) {
+        temp = x0; x0 = x1; x1 = temp;
+        temp = y0; y0 = y1; y1 = temp;
+    }
+    int32_t gradient = dx == 0 ? 0 : (((int32_t) (y1 - y0)) << 16) / dx;
+    int32_t intery = ((int32_t) y0) << 16;
+    for (int32_t x = x0; x <= x1; x++, intery += gradient) {
+        int16_t y = intery >> 16;
+        uint16_t fraction = (intery >> 8) & 0xff;
+        if (steep) {
+            _plot(pen, y, x, 256 - fraction);
+            _plot(pen, y + 1, x, fraction);
+        } else {
+            _plot(pen, x, y, 256 - fraction);
+            _plot(pen, x, y + 1, fraction);
+        }
+    }
+}
+
+typedef struct {
+    mp_float_t start_x;
+    mp_float_t start_y;
+    mp_float_t end_x;
+    mp_float_t end_y;
+    bool wide; // More than half a circle.
+} sector_t;
+
+STATIC bool _in_sector(const sector_t* sector, int16_t x, int16_t y) {
+    if (sector == NULL) {
+        return true;
+    }
+    // Positive cross products are clockwise on screen because y increases downwards.
+    mp_float_t from_start = sector->start_x * y - sector->start_y * x;
+    mp_float_t to_end = x * sector->end_y - y * sector->end_x;
+    if (!sector->wide) {
+        return from_start >= 0 && to_end >= 0;
+    }
+    return from_start >= 0 || to_end >= 0;
+}
+
+STATIC void _circle_point(const displayio_vector_pen_t* pen, const sector_t* sector, int16_t cx, int16_t cy, int16_t x, int16_t y) {
+    if (_in_sector(sector, x, y)) {
+        _plot(pen, cx + x, cy + y, 256);
+    }
+}
+
+// Midpoint circle that only draws the points in the sector when one is given.
+STATIC void _circle(const displayio_vector_pen_t* pen, int16_t cx, int16_t cy, uint16_t radius, const sector_t* sector) {
+    int16_t x = radius;
+    int16_t y = 0;
+    int32_t error = 1 - radius;
+    while (x >= y) {
+        _circle_point(pen, sector, cx, cy, x, y);
+        _circle_point(pen, sector, cx, cy, y, x);
+        _circle_point(pen, sector, cx, cy, -y, x);
+        _circle_point(pen, sector, cx, cy, -x, y);
+        _circle_point(pen, sector, cx, cy, -x, -y);
+        _circle_point(pen, sector, cx, cy, -y, -x);
+        _circle_point(pen, sector, cx, cy, y, -x);
+        _circle_point(pen, sector, cx, cy, x, -y);
+        y++;
+        if (error < 0) {
+            error += 2 * y + 1;
+        } else {
+            x--;
+            error += 2 * (y - x) + 1;
+        }
+    }
+}
+
+void displayio_vector_circle(const displayio_vector_pen_t* pen, int16_t x, int16_t y, uint16_t radius) {
+    _circle(pen, x, y, radius, NULL);
+}
+
+void displayio_vector_arc(const displayio_vector_pen_t* pen, int16_t x, int16_t y, uint16_t radius,
+        mp_float_t start_angle, mp_float_t end_angle) {
+    mp_float_t sweep = MICROPY_FLOAT_C_FUN(fmod)(end_angle - start_angle, 360);
+    if (sweep < 0) {
+        sweep += 360;
+    }
+    if (sweep == 0 && end_angle != start_angle) {
+        _circle(pen, x, y, radius, NULL);
+        return;
+    }
+    const mp_float_t radians_per_degree = MICROPY_FLOAT_CONST(0.017453292519943295);
+    sector_t sector;
+    sector.start_x = MICROPY_FLOAT_C_FUN(cos)(start_angle * radians_per_degree);
+    sector.start_y = MICROPY_FLOAT_C_FUN(sin)(start_angle * radians_per_degree);
+    sector.end_x = MICROPY_FLOAT_C_FUN(cos)(end_angle * radians_per_degree);
+    sector.end_y = MICROPY_FLOAT_C_FUN(sin)(end_angle * radians_per_degree);
+    sector.wide = sweep > 180;
+    _circle(pen, x, y, radius, &sector);
+}
+
+void displayio_vector_fill_circle(const displayio_vector_pen_t* pen, int16_t x, int16_t y, uint16_t radius) {
+    int32_t r = radius;
+    for (int32_t dy = -r; dy <= r; dy++) {
+        int16_t row = y + dy;
+        if (row < 0 || row >= pen->height) {
+            continue;
+        }
+        uint32_t squared = r * r - dy * dy;
+        if (pen->ramp <= 1) {
+            // Rounds the radius up by half a pixel so the outline matches the midpoint circle.
+            int16_t half = _isqrt(squared + r);
+            _span(pen, x - half, x + half + 1, row);
+            continue;
+        }
+        // Distance in 1/256ths of a pixel from the center to the edge of a circle half a pixel
+        // larger, less half a pixel, so its fraction is the coverage of the pixel next to the fully
+        // covered ones. The radius is doubled to keep the half.
+        uint32_t doubled = (2 * r + 1) * (2 * r + 1) - 4 * dy * dy;
+        int32_t edge = radius < 255 ? _isqrt(doubled << 14) : _isqrt(doubled) << 7;
+        edge -= 128;
+        if (edge < 0) {
+            _plot(pen, x, row, (edge + 128) * 2);
+            continue;
+        }
+        int16_t full = edge >> 8;
+        uint16_t fraction = edge & 0xff;
+        _span(pen, x - full, x + full + 1, row);
+        _plot(pen, x - full - 1, row, fraction);
+        _plot(pen, x + full + 1, row, fraction);
+    }
+}
+
+void displayio_vector_polygon(const displayio_vector_pen_t* pen, const int16_t* points, uint16_t point_count) {
+    for (uint16_t i = 0; i < point_count; i++) {
+        uint16_t next = (i + 1) % point_count;
+        displayio_vector_line(pen, points[2 * i], points[2 * i + 1], points[2 * next], points[2 * next + 1]);
+    }
+}
+
+void displayio_vector_fill_polygon(const displayio_vector_pen_t* pen, const int16_t* points, uint16_t point_count) {
+    if (point_count < 3) {
+        return;
+    }
+    int16_t y1 = points[1];
+    int16_t y2 = points[1];
+    for (uint16_t i = 1; i < point_count; i++) {
+        int16_t y = points[2 * i + 1];
+        if (y < y1) {
+            y1 = y;
+        }
+        if (y > y2) {
+            y2 = y;
+        }
+    }
+    if (y1 < 0) {
+        y1 = 0;
+    }
+    if (y2 > pen->height) {
+        y2 = pen->height;
+    }
+    // Each row is filled between pairs of the points where it crosses the edges.
+    mp_float_t crossings[point_count];
+    for (int16_t y = y1; y < y2; y++) {
+        mp_float_t center = y + MICROPY_FLOAT_CONST(0.5);
+        uint16_t crossing_count = 0;
+        for (uint16_t i = 0; i < point_count; i++) {
+            uint16_t next = (i + 1) % point_count;
+            mp_float_t ax = points[2 * i];
+            mp_float_t ay = points[2 * i + 1];
+            mp_float_t bx = points[2 * next];
+            mp_float_t by = points[2 * next + 1];
+            if ((ay <= center) == (by <= center)) {
+                continue;
+            }
+            mp_float_t crossing = ax + (center - ay) * (bx - ax) / (by - ay);
+            uint16_t j = crossing_count++;
+            while (j > 0 && crossings[j - 1] > crossing) {
+                crossings[j] = crossings[j - 1];
+                j--;
+            }
+            crossings[j] = crossing;
+        }
+        for (uint16_t i = 0; i + 1 < crossing_count; i += 2) {
+            int16_t x1 = MICROPY_FLOAT_C_FUN(floor)(crossings[i] + MICROPY_FLOAT_CONST(0.5));
+            int16_t x2 = MICROPY_FLOAT_C_FUN(floor)(crossings[i + 1] + MICROPY_FLOAT_CONST(0.5));
+            _span(pen, x1, x2, y);
+        }
+    }
+}
@@ -0,0 +1,57 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_VECTOR_H
+#define MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_VECTOR_H
+
+#include <stdint.h>
+
+#include "py/obj.h"
+
+// Receives the runs of pixels a primitive covers on row y. x2 is exclusive.
+typedef void (*displayio_vector_span_t)(void* target, int16_t x1, int16_t x2, int16_t y, uint32_t value);
+
+typedef struct {
+    displayio_vector_span_t span;
+    void* target;
+    uint32_t value;
+    uint16_t height; // Rows outside of 0 to height are skipped.
+    // Number of values starting at value that fade from full coverage towards the background.
+    // Edges are anti-aliased with them when it is more than one.
+    uint8_t ramp;
+} displayio_vector_pen_t;
+
+void displayio_vector_line(const displayio_vector_pen_t* pen, int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+void displayio_vector_circle(const displayio_vector_pen_t* pen, int16_t x, int16_t y, uint16_t radius);
+// Angles are in degrees clockwise from the positive x axis.
+void displayio_vector_arc(const displayio_vector_pen_t* pen, int16_t x, int16_t y, uint16_t radius,
+    mp_float_t start_angle, mp_float_t end_angle);
+void displayio_vector_fill_circle(const displayio_vector_pen_t* pen, int16_t x, int16_t y, uint16_t radius);
+// points holds x, y pairs. Filling uses the even-odd rule.
+void displayio_vector_polygon(const displayio_vector_pen_t* pen, const int16_t* points, uint16_t point_count);
+void displayio_vector_fill_polygon(const displayio_vector_pen_t* pen, const int16_t* points, uint16_t point_count);
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_VECTOR_H
@@ -0,0 +1,149 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/fixedpoint/__init__.h"
+
+#include "py/mpconfig.h"
+
+// Only 16 x 16 bit multiplies are needed for Q15, which Cortex-M0 does in one instruction. Q31
+// products and all sums of products are kept in 64 bits.
+
+static inline int32_t saturate16(int32_t value) {
+    #if (defined (__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1)) //Cortex-M4 w/FPU
+    return __SSAT(value, 16);
+    #else
+    if (value > INT16_MAX) {
+        return INT16_MAX;
+    } else if (value < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return value;
+    #endif
+}
+
+static inline int32_t saturate32(int64_t value) {
+    if (value > INT32_MAX) {
+        return INT32_MAX;
+    } else if (value < INT32_MIN) {
+        return INT32_MIN;
+    }
+    return value;
+}
+
+static inline int16_t mul_q15(int16_t a, int16_t b) {
+    return saturate16(((int32_t) a * b + (1 << 14)) >> 15);
+}
+
+static inline int32_t mul_q31(int32_t a, int32_t b) {
+    return saturate32(((int64_t) a * b + (1 << 30)) >> 31);
+}
+
+int16_t shared_modules_fixedpoint_add_q15(int16_t a, int16_t b) {
+    return saturate16((int32_t) a + b);
+}
+
+int16_t shared_modules_fixedpoint_sub_q15(int16_t a, int16_t b) {
+    return saturate16((int32_t) a - b);
+}
+
+int16_t shared_modules_fixedpoint_mul_q15(int16_t a, int16_t b) {
+    return mul_q15(a, b);
+}
+
+void shared_modules_fixedpoint_add_q15_array(int16_t *dest, const int16_t *a, const int16_t *b, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        dest[i] = saturate16((int32_t) a[i] + b[i]);
+    }
+}
+
+void shared_modules_fixedpoint_add_q31_array(int32_t *dest, const int32_t *a, const int32_t *b, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        dest[i] = saturate32((int64_t) a[i] + b[i]);
+    }
+}
+
+void shared_modules_fixedpoint_mul_q15_array(int16_t *dest, const int16_t *a, const int16_t *b, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        dest[i] = mul_q15(a[i], b[i]);
+    }
+}
+
+void shared_modules_fixedpoint_mul_q31_array(int32_t *dest, const int32_t *a, const int32_t *b, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        dest[i] = mul_q31(a[i], b[i]);
+    }
+}
+
+void shared_modules_fixedpoint_scale_q15_array(int16_t *dest, const int16_t *src, int16_t gain, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        dest[i] = mul_q15(src[i], gain);
+    }
+}
+
+void shared_modules_fixedpoint_scale_q31_array(int32_t *dest, const int32_t *src, int16_t gain, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        dest[i] = saturate32(((int64_t) src[i] * gain + (1 << 14)) >> 15);
+    }
+}
+
+int16_t shared_modules_fixedpoint_dot_q15(const int16_t *a, const int16_t *b, size_t len) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < len; i++) {
+        sum += (int32_t) a[i] * b[i];
+    }
+    return saturate16((sum + (1 << 14)) >> 15);
+}
+
+// Q31 products are summed as 16.48 values, like CMSIS-DSP does, so that the sum can't overflow.
+int32_t shared_modules_fixedpoint_dot_q31(const int32_t *a, const int32_t *b, size_t len) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < len; i++) {
+        sum += ((int64_t) a[i] * b[i]) >> 14;
+    }
+    return saturate32((sum + (1 << 16)) >> 17);
+}
+
+void shared_modules_fixedpoint_fir_q15(int16_t *dest, size_t dest_len, const int16_t *src, const int16_t *taps, size_t n_taps) {
+    for (size_t i = 0; i < dest_len; i++) {
+        const int16_t *newest = src + i + n_taps - 1;
+        int64_t sum = 0;
+        for (size_t k = 0; k < n_taps; k++) {
+            sum += (int32_t) taps[k] * newest[-k];
+        }
+        dest[i] = saturate16((sum + (1 << 14)) >> 15);
+    }
+}
+
+void shared_modules_fixedpoint_fir_q31(int32_t *dest, size_t dest_len, const int32_t *src, const int32_t *taps, size_t n_taps) {
+    for (size_t i = 0; i < dest_len; i++) {
+        const int32_t *newest = src + i + n_taps - 1;
+        int64_t sum = 0;
+        for (size_t k = 0; k < n_taps; k++) {
+            sum += ((int64_t) taps[k] * newest[-k]) >> 14;
+        }
+        dest[i] = saturate32((sum + (1 << 16)) >> 17);
+    }
+}
@@ -0,0 +1,181 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/fontio/OnDiskFont.h"
+
+#include <string.h>
+
+#include "py/mperrno.h"
+#include "py/objnamedtuple.h"
+#include "py/runtime.h"
+#include "shared-bindings/displayio/Bitmap.h"
+#include "shared-bindings/fontio/Glyph.h"
+
+#define HEADER_SIZE (12)
+#define GLYPH_ENTRY_SIZE (16)
+#define NO_CODEPOINT (0xffffffff)
+
+static uint16_t read_short(const uint8_t* data) {
+    return data[0] | data[1] << 8;
+}
+
+static uint32_t read_word(const uint8_t* data) {
+    return read_short(data) | read_short(data + 2) << 16;
+}
+
+STATIC bool _read(fontio_ondiskfont_t *self, uint32_t offset, uint8_t* data, uint16_t length) {
+    if (f_lseek(&self->file->fp, offset) != FR_OK) {
+        return false;
+    }
+    UINT bytes_read;
+    return f_read(&self->file->fp, data, length, &bytes_read) == FR_OK && bytes_read == length;
+}
+
+void common_hal_fontio_ondiskfont_construct(fontio_ondiskfont_t *self, pyb_file_obj_t* file, uint16_t cache_size) {
+    self->file = file;
+    uint8_t header[HEADER_SIZE];
+    if (!_read(self, 0, header, HEADER_SIZE)) {
+        mp_raise_OSError(MP_EIO);
+    }
+    if (memcmp(header, "CPF", 3) != 0 || header[3] != 1) {
+        mp_raise_ValueError(translate("Invalid file"));
+    }
+    self->bits_per_pixel = header[4];
+    if (self->bits_per_pixel == 0 || self->bits_per_pixel > 8 || (self->bits_per_pixel & (self->bits_per_pixel - 1)) != 0) {
+        mp_raise_ValueError(translate("Invalid bits per value"));
+    }
+    self->width = header[5];
+    self->height = header[6];
+    self->glyph_count = read_short(header + 8);
+
+    // Allocate the whole cache up front so loading glyphs doesn't grow it.
+    self->cache_size = cache_size;
+    self->cache = m_new(fontio_ondiskfont_cache_entry_t, cache_size);
+    for (uint16_t i = 0; i < cache_size; i++) {
+        self->cache[i].glyph = MP_OBJ_NULL;
+        self->cache[i].codepoint = NO_CODEPOINT;
+        self->cache[i].last_used = 0;
+    }
+    self->uses = 0;
+}
+
+mp_obj_t common_hal_fontio_ondiskfont_get_bounding_box(fontio_ondiskfont_t *self) {
+    mp_obj_t *items = m_new(mp_obj_t, 2);
+    items[0] = MP_OBJ_NEW_SMALL_INT(self->width);
+    items[1] = MP_OBJ_NEW_SMALL_INT(self->height);
+    return mp_obj_new_tuple(2, items);
+}
+
+// Binary searches the glyph table, which is sorted by codepoint. Fills in entry and returns true
+// when the codepoint is found.
+STATIC bool _find_glyph_entry(fontio_ondiskfont_t *self, mp_uint_t codepoint, uint8_t* entry) {
+    int32_t low = 0;
+    int32_t high = self->glyph_count - 1;
+    while (low <= high) {
+        int32_t middle = (low + high) / 2;
+        if (!_read(self, HEADER_SIZE + middle * GLYPH_ENTRY_SIZE, entry, GLYPH_ENTRY_SIZE)) {
+            return false;
+        }
+        uint32_t middle_codepoint = read_word(entry);
+        if (middle_codepoint == codepoint) {
+            return true;
+        } else if (middle_codepoint < codepoint) {
+            low = middle + 1;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return false;
+}
+
+STATIC mp_obj_t _load_glyph(fontio_ondiskfont_t *self, mp_uint_t codepoint) {
+    uint8_t entry[GLYPH_ENTRY_SIZE];
+    if (!_find_glyph_entry(self, codepoint, entry)) {
+        return mp_const_none;
+    }
+    uint32_t data_offset = read_word(entry + 4);
+    uint8_t width = entry[8];
+    uint8_t height = entry[9];
+
+    displayio_bitmap_t *bitmap = m_new_obj(displayio_bitmap_t);
+    bitmap->base.type = &displayio_bitmap_type;
+    common_hal_displayio_bitmap_construct(bitmap, width, height, self->bits_per_pixel);
+
+    // Rows are packed with the first pixel in the most significant bits and start on a byte.
+    uint16_t row_bytes = (width * self->bits_per_pixel + 7) / 8;
+    uint8_t row[row_bytes];
+    uint8_t mask = (1 << self->bits_per_pixel) - 1;
+    for (uint16_t y = 0; y < height; y++) {
+        if (!_read(self, data_offset + y * row_bytes, row, row_bytes)) {
+            mp_raise_OSError(MP_EIO);
+        }
+        for (uint16_t x = 0; x < width; x++) {
+            uint16_t bit = x * self->bits_per_pixel;
+            uint8_t shift = 8 - self->bits_per_pixel - bit % 8;
+            common_hal_displayio_bitmap_set_pixel(bitmap, x, y, (row[bit / 8] >> shift) & mask);
+        }
+    }
+    // The glyph is shared by everything that looks it up.
+    bitmap->read_only = true;
+
+    mp_obj_t field_values[8] = {
+        MP_OBJ_FROM_PTR(bitmap),
+        MP_OBJ_NEW_SMALL_INT(0),
+        MP_OBJ_NEW_SMALL_INT(width),
+        MP_OBJ_NEW_SMALL_INT(height),
+        MP_OBJ_NEW_SMALL_INT((int8_t) entry[10]),
+        MP_OBJ_NEW_SMALL_INT((int8_t) entry[11]),
+        MP_OBJ_NEW_SMALL_INT((int8_t) entry[12]),
+        MP_OBJ_NEW_SMALL_INT((int8_t) entry[13])
+    };
+    return namedtuple_make_new((const mp_obj_type_t*) &fontio_glyph_type, 8, field_values, NULL);
+}
+
+mp_obj_t common_hal_fontio_ondiskfont_get_glyph(fontio_ondiskfont_t *self, mp_uint_t codepoint) {
+    self->uses++;
+    fontio_ondiskfont_cache_entry_t* oldest = NULL;
+    for (uint16_t i = 0; i < self->cache_size; i++) {
+        fontio_ondiskfont_cache_entry_t* entry = &self->cache[i];
+        if (entry->glyph != MP_OBJ_NULL && entry->codepoint == codepoint) {
+            entry->last_used = self->uses;
+            return entry->glyph;
+        }
+        // Unused entries have never been used so they are picked first.
+        if (oldest == NULL || entry->last_used < oldest->last_used) {
+            oldest = entry;
+        }
+    }
+
+    mp_obj_t glyph = _load_glyph(self, codepoint);
+    if (glyph == mp_const_none || oldest == NULL) {
+        return glyph;
+    }
+    // Replace the least recently used glyph. Objects still using it keep their own reference.
+    oldest->glyph = glyph;
+    oldest->codepoint = codepoint;
+    oldest->last_used = self->uses;
+    return glyph;
+}
@@ -0,0 +1,56 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_FONTIO_ONDISKFONT_H
+#define MICROPY_INCLUDED_SHARED_MODULE_FONTIO_ONDISKFONT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "py/obj.h"
+
+#include "extmod/vfs_fat.h"
+
+// A loaded glyph. Unused entries have a glyph of MP_OBJ_NULL.
+typedef struct {
+    mp_obj_t glyph;
+    uint32_t codepoint;
+    uint32_t last_used;
+} fontio_ondiskfont_cache_entry_t;
+
+typedef struct {
+    mp_obj_base_t base;
+    pyb_file_obj_t* file;
+    fontio_ondiskfont_cache_entry_t* cache;
+    uint32_t uses; // Incremented on every lookup to order cache entries by their last use.
+    uint16_t glyph_count;
+    uint16_t cache_size;
+    uint8_t width;
+    uint8_t height;
+    uint8_t bits_per_pixel;
+} fontio_ondiskfont_t;
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_FONTIO_ONDISKFONT_H
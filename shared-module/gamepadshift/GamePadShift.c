@@ -31,7 +31,8 @@
 void common_hal_gamepadshift_gamepadshift_init(gamepadshift_obj_t *gamepadshift,
                                                 digitalio_digitalinout_obj_t *clock_pin,
                                                 digitalio_digitalinout_obj_t *data_pin,
-                                                digitalio_digitalinout_obj_t *latch_pin) {
+                                                digitalio_digitalinout_obj_t *latch_pin,
+                                                uint8_t buttons) {
     common_hal_digitalio_digitalinout_switch_to_input(data_pin, PULL_NONE);
     gamepadshift->data_pin = data_pin;
     common_hal_digitalio_digitalinout_switch_to_output(clock_pin, 0,
@@ -40,6 +41,7 @@ void common_hal_gamepadshift_gamepadshift_init(gamepadshift_obj_t *gamepadshift,
     common_hal_digitalio_digitalinout_switch_to_output(latch_pin, 1,
                                                        DRIVE_MODE_PUSH_PULL);
     gamepadshift->latch_pin = latch_pin;
+    gamepadshift->buttons = buttons;
 
     gamepadshift->last = 0;
 }
@@ -36,8 +36,11 @@ typedef struct {
     digitalio_digitalinout_obj_t* data_pin;
     digitalio_digitalinout_obj_t* clock_pin;
     digitalio_digitalinout_obj_t* latch_pin;
-    volatile uint8_t pressed;
-    volatile uint8_t last;
+    // Number of inputs read per scan. More than 8 means several shift
+    // registers chained together.
+    uint8_t buttons;
+    volatile uint32_t pressed;
+    volatile uint32_t last;
 } gamepadshift_obj_t;
 
 #endif  // MICROPY_INCLUDED_GAMEPADSHIFT_GAMEPADSHIFT_H
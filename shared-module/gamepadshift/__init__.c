@@ -26,20 +26,15 @@
 
 #include "shared-module/gamepadshift/__init__.h"
 
+#include "py/mpconfig.h"
 #include "py/mpstate.h"
 #include "shared-bindings/gamepadshift/GamePadShift.h"
 
-void gamepadshift_tick(void) {
-    void* singleton = MP_STATE_VM(gamepad_singleton);
-    if (singleton == NULL || !MP_OBJ_IS_TYPE(MP_OBJ_FROM_PTR(singleton), &gamepadshift_type)) {
-        return;
-    }
-
-    gamepadshift_obj_t *self = MP_OBJ_TO_PTR(singleton);
-    uint8_t current = 0;
-    uint8_t bit = 1;
+MP_WEAK uint32_t gamepadshift_shift_in(gamepadshift_obj_t *self) {
+    uint32_t current = 0;
+    uint32_t bit = 1;
     common_hal_digitalio_digitalinout_set_value(self->latch_pin, 1);
-    for (int i = 0; i < 8; ++i) {
+    for (int i = 0; i < self->buttons; ++i) {
         common_hal_digitalio_digitalinout_set_value(self->clock_pin, 0);
         if (common_hal_digitalio_digitalinout_get_value(self->data_pin)) {
             current |= bit;
@@ -48,6 +43,19 @@ void gamepadshift_tick(void) {
         bit <<= 1;
     }
     common_hal_digitalio_digitalinout_set_value(self->latch_pin, 0);
+    return current;
+}
+
+void gamepadshift_tick(void) {
+    void* singleton = MP_STATE_VM(gamepad_singleton);
+    if (singleton == NULL || !MP_OBJ_IS_TYPE(MP_OBJ_FROM_PTR(singleton), &gamepadshift_type)) {
+        return;
+    }
+
+    gamepadshift_obj_t *self = MP_OBJ_TO_PTR(singleton);
+    uint32_t current = gamepadshift_shift_in(self);
+    // A button counts as pressed once it reads down on two scans in a row,
+    // which also debounces it.
     self->pressed |= self->last & current;
     self->last = current;
 }
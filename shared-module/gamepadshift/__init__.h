@@ -27,7 +27,15 @@
 #ifndef MICROPY_INCLUDED_GAMEPADSHIFT___INIT___H
 #define MICROPY_INCLUDED_GAMEPADSHIFT___INIT___H
 
+#include <stdint.h>
+
+#include "shared-module/gamepadshift/GamePadShift.h"
+
 void gamepadshift_tick(void);
+// Clocks self->buttons bits out of the shift registers, first bit in bit 0.
+// Ports can replace the portable version with one that drives the pins
+// through their registers directly, since this runs from the tick interrupt.
+uint32_t gamepadshift_shift_in(gamepadshift_obj_t *self);
 void gamepadshift_reset(void);
 
 #endif  // MICROPY_INCLUDED_GAMEPADSHIFT___INIT___H
@@ -30,6 +30,7 @@
 #include "py/runtime.h"
 #include "py/mphal.h"
 #include "py/mperrno.h"
+#include "py/stream.h"
 
 #include "supervisor/shared/tick.h"
 
@@ -54,6 +55,16 @@ void network_module_deinit(void) {
 }
 
 void network_module_background(void) {
+    for (mp_uint_t i = 0; i < MP_STATE_PORT(mod_network_nic_list).len; i++) {
+        mp_obj_t nic = MP_STATE_PORT(mod_network_nic_list).items[i];
+        mod_network_nic_type_t *nic_type = (mod_network_nic_type_t*)mp_obj_get_type(nic);
+        if (nic_type->poll_events != NULL) {
+            nic_type->poll_events(nic);
+        } else {
+            mp_stream_signal_ready();
+        }
+    }
+
     static uint32_t next_tick = 0;
     uint32_t this_tick = supervisor_ticks_ms32();
     if (this_tick < next_tick) return;
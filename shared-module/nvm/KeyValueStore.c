@@ -0,0 +1,351 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/nvm/KeyValueStore.h"
+
+#include <string.h>
+
+#include "py/mperrno.h"
+#include "py/runtime.h"
+#include "supervisor/shared/translate.h"
+
+// The nvm is split into two banks, or used as one when it is a single erase block. Each bank
+// starts with a header and then holds a log of records that each set or delete one key. Records
+// are only appended so a bank is erased once per bank full of updates. When the log is full the
+// latest records are copied to the other bank, which is only marked as committed afterwards, and
+// the log continues there. Everything is written in whole units of KVS_ALIGN bytes, the most that
+// any port can only write once between erases.
+#define KVS_ALIGN (16)
+#define KVS_MAGIC (0x5356564b)
+// The magic and sequence number, then the commit word in a unit of its own.
+#define KVS_HEADER_SIZE (2 * KVS_ALIGN)
+// value_len of a record that deletes its key.
+#define KVS_DELETED (0xfffe)
+
+typedef struct {
+    // CRC-32 of the rest of the record.
+    uint32_t crc;
+    uint16_t value_len;
+    uint8_t key_len;
+    uint8_t reserved;
+} kvs_record_t;
+
+typedef union {
+    kvs_record_t record;
+    uint8_t bytes[KVS_ALIGN];
+} kvs_unit_t;
+
+STATIC uint32_t crc32(uint32_t crc, const uint8_t *data, size_t len) {
+    crc = ~crc;
+    while (len--) {
+        crc ^= *data++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ (0xedb88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+STATIC uint32_t record_data_len(const kvs_record_t *record) {
+    return record->key_len + (record->value_len == KVS_DELETED ? 0 : record->value_len);
+}
+
+STATIC uint32_t record_size(const kvs_record_t *record) {
+    return (sizeof(kvs_record_t) + record_data_len(record) + KVS_ALIGN - 1) & ~(KVS_ALIGN - 1);
+}
+
+STATIC void read_record(nvm_keyvaluestore_obj_t *self, uint32_t offset, kvs_record_t *record) {
+    common_hal_nvm_bytearray_get_bytes(self->nvm, offset, sizeof(kvs_record_t), (uint8_t *) record);
+}
+
+STATIC uint32_t record_crc(nvm_keyvaluestore_obj_t *self, uint32_t offset, const kvs_record_t *record) {
+    uint32_t crc = crc32(0, (const uint8_t *) record + sizeof(record->crc),
+                         sizeof(kvs_record_t) - sizeof(record->crc));
+    uint32_t start = offset + sizeof(kvs_record_t);
+    uint32_t len = record_data_len(record);
+    uint8_t chunk[32];
+    while (len > 0) {
+        uint32_t chunk_len = MIN(len, sizeof(chunk));
+        common_hal_nvm_bytearray_get_bytes(self->nvm, start, chunk_len, chunk);
+        crc = crc32(crc, chunk, chunk_len);
+        start += chunk_len;
+        len -= chunk_len;
+    }
+    return crc;
+}
+
+STATIC bool value_equal(nvm_keyvaluestore_obj_t *self, uint32_t offset, const uint8_t *value, size_t len) {
+    kvs_record_t record;
+    read_record(self, offset, &record);
+    if (record.value_len != len) {
+        return false;
+    }
+    uint32_t start = offset + sizeof(kvs_record_t) + record.key_len;
+    uint8_t chunk[32];
+    while (len > 0) {
+        uint32_t chunk_len = MIN(len, sizeof(chunk));
+        common_hal_nvm_bytearray_get_bytes(self->nvm, start, chunk_len, chunk);
+        if (memcmp(chunk, value, chunk_len) != 0) {
+            return false;
+        }
+        start += chunk_len;
+        value += chunk_len;
+        len -= chunk_len;
+    }
+    return true;
+}
+
+STATIC bool read_header(nvm_keyvaluestore_obj_t *self, uint32_t bank, uint32_t *sequence) {
+    uint32_t header[2];
+    uint32_t commit;
+    common_hal_nvm_bytearray_get_bytes(self->nvm, bank, sizeof(header), (uint8_t *) header);
+    common_hal_nvm_bytearray_get_bytes(self->nvm, bank + KVS_ALIGN, sizeof(commit), (uint8_t *) &commit);
+    *sequence = header[1];
+    return header[0] == KVS_MAGIC && commit == KVS_MAGIC;
+}
+
+// Erases the bank and writes its header, but doesn't commit it.
+STATIC bool start_bank(nvm_keyvaluestore_obj_t *self, uint32_t bank, uint32_t sequence) {
+    uint32_t erase_size = common_hal_nvm_bytearray_get_erase_size(self->nvm);
+    for (uint32_t i = 0; i < self->bank_size; i += erase_size) {
+        if (!common_hal_nvm_bytearray_erase(self->nvm, bank + i)) {
+            return false;
+        }
+    }
+    uint32_t header[KVS_ALIGN / sizeof(uint32_t)];
+    memset(header, 0xff, sizeof(header));
+    header[0] = KVS_MAGIC;
+    header[1] = sequence;
+    return common_hal_nvm_bytearray_program(self->nvm, bank, (uint8_t *) header, sizeof(header));
+}
+
+STATIC bool commit_bank(nvm_keyvaluestore_obj_t *self, uint32_t bank) {
+    uint32_t commit[KVS_ALIGN / sizeof(uint32_t)];
+    memset(commit, 0xff, sizeof(commit));
+    commit[0] = KVS_MAGIC;
+    return common_hal_nvm_bytearray_program(self->nvm, bank + KVS_ALIGN, (uint8_t *) commit, sizeof(commit));
+}
+
+STATIC void raise_write_failed(void) {
+    mp_raise_RuntimeError(translate("Unable to write to nvm."));
+}
+
+// Finds the latest committed bank and indexes its log, or starts a new store when there is none.
+STATIC void load(nvm_keyvaluestore_obj_t *self) {
+    self->index = mp_obj_new_dict(0);
+    bool found = false;
+    for (uint32_t bank = 0; bank < self->bank_count * self->bank_size; bank += self->bank_size) {
+        uint32_t sequence;
+        if (read_header(self, bank, &sequence) &&
+            (!found || (int32_t) (sequence - self->sequence) > 0)) {
+            found = true;
+            self->bank = bank;
+            self->sequence = sequence;
+        }
+    }
+    self->end = KVS_HEADER_SIZE;
+    if (!found) {
+        self->bank = 0;
+        self->sequence = 0;
+        if (!start_bank(self, 0, 0) || !commit_bank(self, 0)) {
+            raise_write_failed();
+        }
+        return;
+    }
+
+    mp_map_t *map = mp_obj_dict_get_map(self->index);
+    while (self->end + KVS_ALIGN <= self->bank_size) {
+        uint32_t offset = self->bank + self->end;
+        kvs_unit_t unit;
+        common_hal_nvm_bytearray_get_bytes(self->nvm, offset, KVS_ALIGN, unit.bytes);
+        bool erased = true;
+        for (size_t i = 0; i < KVS_ALIGN; i++) {
+            erased = erased && unit.bytes[i] == 0xff;
+        }
+        if (erased) {
+            break;
+        }
+        kvs_record_t *record = &unit.record;
+        uint32_t size = record_size(record);
+        if (record->key_len > NVM_KEYVALUESTORE_MAX_KEY_LEN || self->end + size > self->bank_size) {
+            // A write that didn't finish. Its length can't be trusted so skip a unit at a time.
+            self->end += KVS_ALIGN;
+            continue;
+        }
+        if (record_crc(self, offset, record) == record->crc) {
+            char key[NVM_KEYVALUESTORE_MAX_KEY_LEN];
+            common_hal_nvm_bytearray_get_bytes(self->nvm, offset + sizeof(kvs_record_t),
+                                               record->key_len, (uint8_t *) key);
+            mp_obj_t key_obj = mp_obj_new_str(key, record->key_len);
+            if (record->value_len == KVS_DELETED) {
+                mp_map_lookup(map, key_obj, MP_MAP_LOOKUP_REMOVE_IF_FOUND);
+            } else {
+                mp_map_lookup(map, key_obj, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value =
+                    MP_OBJ_NEW_SMALL_INT(offset);
+            }
+        }
+        self->end += size;
+    }
+}
+
+// Copies the latest records to a new log.
+STATIC void compact(nvm_keyvaluestore_obj_t *self) {
+    mp_map_t *map = mp_obj_dict_get_map(self->index);
+    uint32_t live = 0;
+    for (size_t i = 0; i < map->alloc; i++) {
+        if (MP_MAP_SLOT_IS_FILLED(map, i)) {
+            kvs_record_t record;
+            read_record(self, MP_OBJ_SMALL_INT_VALUE(map->table[i].value), &record);
+            live += record_size(&record);
+        }
+    }
+    // Gather the records first, because with one bank their old copies are erased.
+    uint32_t bank = self->bank_count == 1 ? self->bank : self->bank_size - self->bank;
+    uint8_t *buffer = m_new(uint8_t, live);
+    uint32_t end = 0;
+    for (size_t i = 0; i < map->alloc; i++) {
+        if (MP_MAP_SLOT_IS_FILLED(map, i)) {
+            uint32_t offset = MP_OBJ_SMALL_INT_VALUE(map->table[i].value);
+            kvs_record_t record;
+            read_record(self, offset, &record);
+            uint32_t size = record_size(&record);
+            common_hal_nvm_bytearray_get_bytes(self->nvm, offset, size, buffer + end);
+            map->table[i].value = MP_OBJ_NEW_SMALL_INT(bank + KVS_HEADER_SIZE + end);
+            end += size;
+        }
+    }
+    bool ok = start_bank(self, bank, self->sequence + 1) &&
+              (live == 0 || common_hal_nvm_bytearray_program(self->nvm, bank + KVS_HEADER_SIZE, buffer, live)) &&
+              commit_bank(self, bank);
+    m_del(uint8_t, buffer, live);
+    if (!ok) {
+        // Go back to whatever was committed.
+        load(self);
+        raise_write_failed();
+    }
+    self->bank = bank;
+    self->sequence++;
+    self->end = KVS_HEADER_SIZE + live;
+}
+
+// Appends a record and returns its offset. value is NULL to delete the key.
+STATIC uint32_t append(nvm_keyvaluestore_obj_t *self, const char *key, size_t key_len,
+                       const uint8_t *value, size_t value_len) {
+    if (value != NULL && value_len >= KVS_DELETED) {
+        mp_raise_OSError(MP_ENOSPC);
+    }
+    kvs_record_t record = {
+        .value_len = value == NULL ? KVS_DELETED : value_len,
+        .key_len = key_len,
+        .reserved = 0xff,
+    };
+    uint32_t size = record_size(&record);
+    if (size > self->bank_size - KVS_HEADER_SIZE) {
+        mp_raise_OSError(MP_ENOSPC);
+    }
+    if (self->end + size > self->bank_size) {
+        compact(self);
+        if (self->end + size > self->bank_size) {
+            mp_raise_OSError(MP_ENOSPC);
+        }
+    }
+    uint8_t *buffer = m_new(uint8_t, size);
+    memset(buffer, 0xff, size);
+    memcpy(buffer + sizeof(kvs_record_t), key, key_len);
+    if (value != NULL) {
+        memcpy(buffer + sizeof(kvs_record_t) + key_len, value, value_len);
+    }
+    memcpy(buffer, &record, sizeof(kvs_record_t));
+    record.crc = crc32(0, buffer + sizeof(record.crc),
+                       sizeof(kvs_record_t) - sizeof(record.crc) + record_data_len(&record));
+    memcpy(buffer, &record.crc, sizeof(record.crc));
+    uint32_t offset = self->bank + self->end;
+    bool ok = common_hal_nvm_bytearray_program(self->nvm, offset, buffer, size);
+    m_del(uint8_t, buffer, size);
+    // A failed write may still have used the space.
+    self->end += size;
+    if (!ok) {
+        raise_write_failed();
+    }
+    return offset;
+}
+
+void common_hal_nvm_keyvaluestore_construct(nvm_keyvaluestore_obj_t *self, nvm_bytearray_obj_t *nvm) {
+    self->nvm = nvm;
+    uint32_t erase_size = common_hal_nvm_bytearray_get_erase_size(nvm);
+    uint32_t len = common_hal_nvm_bytearray_get_length(nvm);
+    self->bank_count = len >= 2 * erase_size ? 2 : 1;
+    self->bank_size = len / self->bank_count / erase_size * erase_size;
+    if (self->bank_size == 0) {
+        mp_raise_OSError(MP_ENOSPC);
+    }
+    load(self);
+}
+
+size_t common_hal_nvm_keyvaluestore_get_length(nvm_keyvaluestore_obj_t *self) {
+    return mp_obj_dict_get_map(self->index)->used;
+}
+
+mp_obj_t common_hal_nvm_keyvaluestore_get(nvm_keyvaluestore_obj_t *self, mp_obj_t key) {
+    mp_map_elem_t *elem = mp_map_lookup(mp_obj_dict_get_map(self->index), key, MP_MAP_LOOKUP);
+    if (elem == NULL) {
+        return MP_OBJ_NULL;
+    }
+    uint32_t offset = MP_OBJ_SMALL_INT_VALUE(elem->value);
+    kvs_record_t record;
+    read_record(self, offset, &record);
+    vstr_t vstr;
+    vstr_init_len(&vstr, record.value_len);
+    common_hal_nvm_bytearray_get_bytes(self->nvm, offset + sizeof(kvs_record_t) + record.key_len,
+                                       record.value_len, (uint8_t *) vstr.buf);
+    return mp_obj_new_str_from_vstr(&mp_type_bytes, &vstr);
+}
+
+void common_hal_nvm_keyvaluestore_set(nvm_keyvaluestore_obj_t *self, mp_obj_t key,
+        const uint8_t *value, size_t len) {
+    mp_map_t *map = mp_obj_dict_get_map(self->index);
+    mp_map_elem_t *elem = mp_map_lookup(map, key, MP_MAP_LOOKUP);
+    // Writing the value it already has would only wear the nvm.
+    if (elem != NULL && value_equal(self, MP_OBJ_SMALL_INT_VALUE(elem->value), value, len)) {
+        return;
+    }
+    size_t key_len;
+    const char *key_data = mp_obj_str_get_data(key, &key_len);
+    uint32_t offset = append(self, key_data, key_len, value, len);
+    // Compacting may have changed the map.
+    mp_map_lookup(map, key, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = MP_OBJ_NEW_SMALL_INT(offset);
+}
+
+bool common_hal_nvm_keyvaluestore_delete(nvm_keyvaluestore_obj_t *self, mp_obj_t key) {
+    // Removed first so that compacting to make room drops the old value.
+    if (mp_map_lookup(mp_obj_dict_get_map(self->index), key, MP_MAP_LOOKUP_REMOVE_IF_FOUND) == NULL) {
+        return false;
+    }
+    size_t key_len;
+    const char *key_data = mp_obj_str_get_data(key, &key_len);
+    append(self, key_data, key_len, NULL, 0);
+    return true;
+}
@@ -0,0 +1,50 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_NVM_KEYVALUESTORE_H
+#define MICROPY_INCLUDED_SHARED_MODULE_NVM_KEYVALUESTORE_H
+
+#include <stdint.h>
+
+#include "py/obj.h"
+#include "shared-bindings/nvm/ByteArray.h"
+
+#define NVM_KEYVALUESTORE_MAX_KEY_LEN (64)
+
+typedef struct {
+    mp_obj_base_t base;
+    nvm_bytearray_obj_t *nvm;
+    // Maps each key to the offset of its latest record in the nvm.
+    mp_obj_t index;
+    uint32_t bank_size;
+    // Offset of the bank in use, and of the end of its log.
+    uint32_t bank;
+    uint32_t end;
+    uint32_t sequence;
+    uint8_t bank_count;
+} nvm_keyvaluestore_obj_t;
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_NVM_KEYVALUESTORE_H
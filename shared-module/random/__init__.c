@@ -30,60 +30,92 @@
 
 #include "py/runtime.h"
 #include "shared-bindings/os/__init__.h"
+#include "shared-bindings/random/__init__.h"
 #include "shared-bindings/time/__init__.h"
 
-// Yasmarang random number generator
-// by Ilya Levin
-// http://www.literatecode.com/yasmarang
+// xoshiro128** by David Blackman and Sebastiano Vigna
+// http://prng.di.unimi.it/xoshiro128starstar.c
 // Public Domain
+//
+// It only needs 32 bit arithmetic, which suits every Cortex-M.
 
-STATIC uint32_t yasmarang_pad = 0xeda4baba, yasmarang_n = 69, yasmarang_d = 233;
-STATIC uint8_t yasmarang_dat = 0;
+STATIC uint32_t xoshiro_state[4];
+STATIC bool xoshiro_seeded = false;
 
-STATIC uint32_t yasmarang(void)
-{
-    if (yasmarang_pad == 0xeda4baba) {
-        if (!common_hal_os_urandom((uint8_t *)&yasmarang_pad, sizeof(uint32_t))) {
-            yasmarang_pad = common_hal_time_monotonic() & 0xffffffff;
+static inline uint32_t rotl(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+// splitmix32 spreads a single seed word over the whole state.
+STATIC uint32_t splitmix32(uint32_t* z) {
+    uint32_t r = (*z += 0x9e3779b9);
+    r = (r ^ (r >> 16)) * 0x85ebca6b;
+    r = (r ^ (r >> 13)) * 0xc2b2ae35;
+    return r ^ (r >> 16);
+}
+
+STATIC uint32_t xoshiro128(void) {
+    if (!xoshiro_seeded) {
+        if (common_hal_os_urandom((uint8_t *)xoshiro_state, sizeof(xoshiro_state)) &&
+            (xoshiro_state[0] | xoshiro_state[1] | xoshiro_state[2] | xoshiro_state[3]) != 0) {
+            xoshiro_seeded = true;
+        } else {
+            shared_modules_random_seed(common_hal_time_monotonic() & 0xffffffff);
         }
     }
-   yasmarang_pad += yasmarang_dat + yasmarang_d * yasmarang_n;
-   yasmarang_pad = (yasmarang_pad<<3) + (yasmarang_pad>>29);
-   yasmarang_n = yasmarang_pad | 2;
-   yasmarang_d ^= (yasmarang_pad<<31) + (yasmarang_pad>>1);
-   yasmarang_dat ^= (char) yasmarang_pad ^ (yasmarang_d>>8) ^ 1;
-
-   return (yasmarang_pad^(yasmarang_d<<5)^(yasmarang_pad>>18)^(yasmarang_dat<<1));
-}  /* yasmarang */
+    uint32_t* s = xoshiro_state;
+    const uint32_t result = rotl(s[1] * 5, 7) * 9;
+    const uint32_t t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 11);
+    return result;
+}
 
-// End of Yasmarang
+// End of xoshiro128**
 
 // returns an unsigned integer below the given argument
 // n must not be zero
-STATIC uint32_t yasmarang_randbelow(uint32_t n) {
+STATIC uint32_t xoshiro128_randbelow(uint32_t n) {
     uint32_t mask = 1;
     while ((n & mask) < n) {
         mask = (mask << 1) | 1;
     }
     uint32_t r;
     do {
-        r = yasmarang() & mask;
+        r = xoshiro128() & mask;
     } while (r >= n);
     return r;
 }
 
 void shared_modules_random_seed(mp_uint_t seed) {
-    yasmarang_pad = seed;
-    yasmarang_n = 69;
-    yasmarang_d = 233;
-    yasmarang_dat = 0;
+    uint32_t z = seed;
+    for (size_t i = 0; i < MP_ARRAY_SIZE(xoshiro_state); i++) {
+        xoshiro_state[i] = splitmix32(&z);
+    }
+    xoshiro_seeded = true;
 }
 
 mp_uint_t shared_modules_random_getrandbits(uint8_t n) {
-    uint32_t mask = ~0;
+    // The high bits are the strongest.
     // Beware of C undefined behavior when shifting by >= than bit size
-    mask >>= (32 - n);
-    return yasmarang() & mask;
+    return xoshiro128() >> (32 - n);
+}
+
+void shared_modules_random_fill(uint8_t* buf, size_t len) {
+    while (len >= sizeof(uint32_t)) {
+        uint32_t r = xoshiro128();
+        memcpy(buf, &r, sizeof(r));
+        buf += sizeof(r);
+        len -= sizeof(r);
+    }
+    if (len > 0) {
+        uint32_t r = xoshiro128();
+        memcpy(buf, &r, len);
+    }
 }
 
 mp_int_t shared_modules_random_randrange(mp_int_t start, mp_int_t stop, mp_int_t step) {
@@ -93,11 +125,11 @@ mp_int_t shared_modules_random_randrange(mp_int_t start, mp_int_t stop, mp_int_t
     } else {
         n = (stop - start + step + 1) / step;
     }
-    return start + step * yasmarang_randbelow(n);
+    return start + step * xoshiro128_randbelow(n);
 }
 
-// returns a number in the range [0..1) using Yasmarang to fill in the fraction bits
-STATIC mp_float_t yasmarang_float(void) {
+// returns a number in the range [0..1) using xoshiro128** to fill in the fraction bits
+STATIC mp_float_t xoshiro128_float(void) {
     #if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_DOUBLE
     typedef uint64_t mp_float_int_t;
     #elif MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_FLOAT
@@ -114,17 +146,17 @@ STATIC mp_float_t yasmarang_float(void) {
     u.p.sgn = 0;
     u.p.exp = (1 << (MP_FLOAT_EXP_BITS - 1)) - 1;
     if (MP_FLOAT_FRAC_BITS <= 32) {
-        u.p.frc = yasmarang();
+        u.p.frc = xoshiro128();
     } else {
-        u.p.frc = ((uint64_t)yasmarang() << 32) | (uint64_t)yasmarang();
+        u.p.frc = ((uint64_t)xoshiro128() << 32) | (uint64_t)xoshiro128();
     }
     return u.f - 1;
 }
 
 mp_float_t shared_modules_random_random(void) {
-    return yasmarang_float();
+    return xoshiro128_float();
 }
 
 mp_float_t shared_modules_random_uniform(mp_float_t a, mp_float_t b) {
-    return a + (b - a) * yasmarang_float();
+    return a + (b - a) * xoshiro128_float();
 }
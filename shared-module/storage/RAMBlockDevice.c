@@ -0,0 +1,83 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "shared-bindings/storage/RAMBlockDevice.h"
+
+void common_hal_storage_ramblockdevice_construct(storage_ramblockdevice_obj_t *self, uint32_t block_count) {
+    self->blocks = m_new0(uint8_t*, block_count);
+    self->block_count = block_count;
+}
+
+uint32_t common_hal_storage_ramblockdevice_get_block_count(storage_ramblockdevice_obj_t *self) {
+    return self->block_count;
+}
+
+void common_hal_storage_ramblockdevice_readblocks(storage_ramblockdevice_obj_t *self, uint32_t block, uint8_t *buf, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        uint8_t *data = self->blocks[block + i];
+        if (data == NULL) {
+            memset(buf, 0, STORAGE_RAMBLOCKDEVICE_BLOCK_SIZE);
+        } else {
+            memcpy(buf, data, STORAGE_RAMBLOCKDEVICE_BLOCK_SIZE);
+        }
+        buf += STORAGE_RAMBLOCKDEVICE_BLOCK_SIZE;
+    }
+}
+
+STATIC bool is_zero(const uint8_t *buf) {
+    for (size_t i = 0; i < STORAGE_RAMBLOCKDEVICE_BLOCK_SIZE; i++) {
+        if (buf[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool common_hal_storage_ramblockdevice_writeblocks(storage_ramblockdevice_obj_t *self, uint32_t block, const uint8_t *buf, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        uint8_t **data = &self->blocks[block + i];
+        if (is_zero(buf)) {
+            // Formatting writes mostly zeros, so don't keep memory for them.
+            if (*data != NULL) {
+                m_del(uint8_t, *data, STORAGE_RAMBLOCKDEVICE_BLOCK_SIZE);
+                *data = NULL;
+            }
+        } else {
+            if (*data == NULL) {
+                *data = m_new_ll_maybe(uint8_t, STORAGE_RAMBLOCKDEVICE_BLOCK_SIZE);
+                if (*data == NULL) {
+                    return false;
+                }
+            }
+            memcpy(*data, buf, STORAGE_RAMBLOCKDEVICE_BLOCK_SIZE);
+        }
+        buf += STORAGE_RAMBLOCKDEVICE_BLOCK_SIZE;
+    }
+    return true;
+}
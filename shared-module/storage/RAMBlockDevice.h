@@ -0,0 +1,44 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_STORAGE_RAMBLOCKDEVICE_H
+#define MICROPY_INCLUDED_SHARED_MODULE_STORAGE_RAMBLOCKDEVICE_H
+
+#include <stdint.h>
+
+#include "py/obj.h"
+
+#define STORAGE_RAMBLOCKDEVICE_BLOCK_SIZE (512)
+
+typedef struct {
+    mp_obj_base_t base;
+    // Blocks are allocated when they're first written with anything but zeros. NULL ones read
+    // as zeros.
+    uint8_t **blocks;
+    uint32_t block_count;
+} storage_ramblockdevice_obj_t;
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_STORAGE_RAMBLOCKDEVICE_H
@@ -165,3 +165,7 @@ void common_hal_storage_erase_filesystem(void) {
     common_hal_mcu_reset();
     // We won't actually get here, since we're resetting.
 }
+
+void common_hal_storage_get_flush_statistics(uint32_t *flushes, uint32_t *flushes_saved) {
+    filesystem_get_flush_statistics(flushes, flushes_saved);
+}
@@ -0,0 +1,147 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "py/binary.h"
+#include "shared-bindings/struct/Struct.h"
+#include "shared-module/struct/__init__.h"
+#include "supervisor/shared/translate.h"
+
+// Walks the format once, recording where each value goes. ops may be NULL to
+// just count them.
+STATIC size_t struct_struct_compile(const char *fmt, struct_struct_op_t *ops, mp_uint_t *size_out, bool *padded_out) {
+    char fmt_type = get_fmt_type(&fmt);
+    mp_uint_t size = 0;
+    mp_uint_t used = 0;
+    size_t n_ops = 0;
+    for (; *fmt; fmt++) {
+        struct_validate_format(*fmt);
+
+        mp_uint_t cnt = 1;
+        if (unichar_isdigit(*fmt)) {
+            cnt = get_fmt_num(&fmt);
+        }
+
+        if (*fmt == 's') {
+            if (ops != NULL) {
+                ops[n_ops] = (struct_struct_op_t) { size, cnt, fmt_type, 's' };
+            }
+            n_ops++;
+            size += cnt;
+            used += cnt;
+            continue;
+        }
+
+        mp_uint_t align;
+        size_t sz = mp_binary_get_size(fmt_type, *fmt, &align);
+        // The offsets are aligned here, so a native value with the standard
+        // size can use the explicit byte order and skip realigning the pointer.
+        char struct_type = fmt_type;
+        if (fmt_type == '@' && *fmt != 'x' && mp_binary_get_size('<', *fmt, NULL) == sz) {
+            struct_type = MP_ENDIANNESS_LITTLE ? '<' : '>';
+        }
+        while (cnt--) {
+            size = (size + align - 1) & ~(align - 1);
+            // Pad bytes don't have a value.
+            if (*fmt != 'x') {
+                if (ops != NULL) {
+                    ops[n_ops] = (struct_struct_op_t) { size, sz, struct_type, *fmt };
+                }
+                n_ops++;
+                used += sz;
+            }
+            size += sz;
+        }
+    }
+    *size_out = size;
+    *padded_out = used != size;
+    return n_ops;
+}
+
+size_t shared_modules_struct_struct_count(mp_obj_t fmt_in) {
+    mp_uint_t size;
+    bool padded;
+    return struct_struct_compile(mp_obj_str_get_str(fmt_in), NULL, &size, &padded);
+}
+
+void shared_modules_struct_struct_construct(struct_struct_obj_t *self, mp_obj_t fmt_in) {
+    self->format = fmt_in;
+    self->n_ops = struct_struct_compile(mp_obj_str_get_str(fmt_in), self->ops, &self->size, &self->padded);
+}
+
+void shared_modules_struct_struct_pack_into(const struct_struct_obj_t *self, byte *p, byte *end_p, size_t n_args, const mp_obj_t *args) {
+    if (p + self->size > end_p) {
+        mp_raise_RuntimeError(translate("buffer too small"));
+    }
+    if (n_args > self->n_ops) {
+        mp_raise_RuntimeError(translate("too many arguments provided with the given format"));
+    }
+    if (n_args < self->n_ops) {
+        mp_raise_TypeError(translate("argument num/types mismatch"));
+    }
+
+    if (self->padded) {
+        memset(p, 0, self->size);
+    }
+    for (size_t i = 0; i < self->n_ops; i++) {
+        const struct_struct_op_t *op = &self->ops[i];
+        byte *item_p = p + op->offset;
+        if (op->type == 's') {
+            mp_buffer_info_t bufinfo;
+            mp_get_buffer_raise(args[i], &bufinfo, MP_BUFFER_READ);
+            mp_uint_t to_copy = MIN(op->len, bufinfo.len);
+            memcpy(item_p, bufinfo.buf, to_copy);
+            memset(item_p + to_copy, 0, op->len - to_copy);
+        } else {
+            mp_binary_set_val(op->struct_type, op->type, args[i], &item_p);
+        }
+    }
+}
+
+void shared_modules_struct_struct_unpack_into(const struct_struct_obj_t *self, const byte *p, const byte *end_p, bool exact_size, mp_obj_t *items) {
+    if (exact_size) {
+        if (p + self->size != end_p) {
+            mp_raise_RuntimeError(translate("buffer size must match format"));
+        }
+    } else {
+        if (p + self->size > end_p) {
+            mp_raise_RuntimeError(translate("buffer too small"));
+        }
+    }
+
+    for (size_t i = 0; i < self->n_ops; i++) {
+        const struct_struct_op_t *op = &self->ops[i];
+        byte *item_p = (byte *)p + op->offset;
+        if (op->type == 's') {
+            items[i] = mp_obj_new_bytes(item_p, op->len);
+        } else {
+            items[i] = mp_binary_get_val(op->struct_type, op->type, &item_p);
+        }
+    }
+}
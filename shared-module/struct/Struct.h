@@ -0,0 +1,50 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_STRUCT_STRUCT_H
+#define MICROPY_INCLUDED_SHARED_MODULE_STRUCT_STRUCT_H
+
+#include "py/obj.h"
+
+// One value in the packed data. Pad bytes have no op.
+typedef struct {
+    mp_uint_t offset;  // from the start of the packed data, already aligned
+    mp_uint_t len;     // size in bytes
+    char struct_type;  // byte order passed to mp_binary_get_val/set_val
+    char type;         // format code
+} struct_struct_op_t;
+
+typedef struct {
+    mp_obj_base_t base;
+    mp_obj_t format;
+    mp_uint_t size;
+    size_t n_ops;
+    bool padded;       // some bytes aren't covered by an op
+    struct_struct_op_t ops[];
+} struct_struct_obj_t;
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_STRUCT_STRUCT_H
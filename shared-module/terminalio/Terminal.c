@@ -26,6 +26,8 @@
 
 #include "shared-module/terminalio/Terminal.h"
 
+#include <string.h>
+
 #include "shared-module/fontio/BuiltinFont.h"
 #include "shared-bindings/displayio/TileGrid.h"
 
@@ -49,61 +51,72 @@ size_t common_hal_terminalio_terminal_write(terminalio_terminal_obj_t *self, con
     const byte* i = data;
     uint16_t start_y = self->cursor_y;
     while (i < data + len) {
-        unichar c = utf8_get_char(i);
-        i = utf8_next_char(i);
-        // Always handle ASCII.
-        if (c < 128) {
-            if (c >= 0x20 && c <= 0x7e) {
-                uint8_t tile_index = fontio_builtinfont_get_glyph_index(self->font, c);
-                common_hal_displayio_tilegrid_set_tile(self->tilegrid, self->cursor_x, self->cursor_y, tile_index);
-                self->cursor_x++;
-            } else if (c == '\r') {
-                self->cursor_x = 0;
-            } else if (c == '\n') {
-                self->cursor_y++;
-            // Commands below are used by MicroPython in the REPL
-            } else if (c == '\b') {
-                if (self->cursor_x > 0) {
-                    self->cursor_x--;
-                }
-            } else if (c == 0x1b) {
-                if (i[0] == '[') {
-                    if (i[1] == 'K') {
-                        // Clear the rest of the line.
-                        for (uint16_t j = self->cursor_x; j < self->tilegrid->width_in_tiles; j++) {
-                            common_hal_displayio_tilegrid_set_tile(self->tilegrid, j, self->cursor_y, 0);
-                        }
-                        i += 2;
-                    } else {
-                        // Handle commands of the form \x1b[####D
-                        uint16_t n = 0;
-                        uint8_t j = 1;
-                        for (; j < 6; j++) {
-                            if ('0' <= i[j] && i[j] <= '9') {
-                                n = n * 10 + (i[j] - '0');
-                            } else {
-                                c = i[j];
-                                break;
+        if (*i >= 0x20 && *i <= 0x7e) {
+            // Write a run of printable ASCII up to the end of the row at once.
+            uint16_t room = self->tilegrid->width_in_tiles - self->cursor_x;
+            uint8_t tiles[room];
+            uint16_t run = 0;
+            while (run < room && i < data + len && *i >= 0x20 && *i <= 0x7e) {
+                tiles[run] = fontio_builtinfont_get_glyph_index(self->font, *i);
+                run++;
+                i++;
+            }
+            displayio_tilegrid_set_tile_span(self->tilegrid, self->cursor_x, self->cursor_y, tiles, run);
+            self->cursor_x += run;
+        } else {
+            unichar c = utf8_get_char(i);
+            i = utf8_next_char(i);
+            // Always handle ASCII.
+            if (c < 128) {
+                if (c == '\r') {
+                    self->cursor_x = 0;
+                } else if (c == '\n') {
+                    self->cursor_y++;
+                // Commands below are used by MicroPython in the REPL
+                } else if (c == '\b') {
+                    if (self->cursor_x > 0) {
+                        self->cursor_x--;
+                    }
+                } else if (c == 0x1b) {
+                    if (i[0] == '[') {
+                        if (i[1] == 'K') {
+                            // Clear the rest of the line.
+                            uint16_t count = self->tilegrid->width_in_tiles - self->cursor_x;
+                            uint8_t blank[count];
+                            memset(blank, 0, count);
+                            displayio_tilegrid_set_tile_span(self->tilegrid, self->cursor_x, self->cursor_y, blank, count);
+                            i += 2;
+                        } else {
+                            // Handle commands of the form \x1b[####D
+                            uint16_t n = 0;
+                            uint8_t j = 1;
+                            for (; j < 6; j++) {
+                                if ('0' <= i[j] && i[j] <= '9') {
+                                    n = n * 10 + (i[j] - '0');
+                                } else {
+                                    c = i[j];
+                                    break;
+                                }
                             }
-                        }
-                        if (c == 'D') {
-                            if (n > self->cursor_x) {
-                                self->cursor_x = 0;
-                            } else {
-                                self->cursor_x -= n;
+                            if (c == 'D') {
+                                if (n > self->cursor_x) {
+                                    self->cursor_x = 0;
+                                } else {
+                                    self->cursor_x -= n;
+                                }
                             }
+                            i += j + 1;
+                            continue;
                         }
-                        i += j + 1;
-                        continue;
                     }
                 }
-            }
-        } else {
-            uint8_t tile_index = fontio_builtinfont_get_glyph_index(self->font, c);
-            if (tile_index != 0xff) {
-                common_hal_displayio_tilegrid_set_tile(self->tilegrid, self->cursor_x, self->cursor_y, tile_index);
-                self->cursor_x++;
+            } else {
+                uint8_t tile_index = fontio_builtinfont_get_glyph_index(self->font, c);
+                if (tile_index != 0xff) {
+                    common_hal_displayio_tilegrid_set_tile(self->tilegrid, self->cursor_x, self->cursor_y, tile_index);
+                    self->cursor_x++;
 
+                }
             }
         }
         if (self->cursor_x >= self->tilegrid->width_in_tiles) {
@@ -115,10 +128,10 @@ size_t common_hal_terminalio_terminal_write(terminalio_terminal_obj_t *self, con
         }
         if (self->cursor_y != start_y) {
             // clear the new row
-            for (uint16_t j = 0; j < self->tilegrid->width_in_tiles; j++) {
-                common_hal_displayio_tilegrid_set_tile(self->tilegrid, j, self->cursor_y, 0);
-                start_y = self->cursor_y;
-            }
+            uint8_t blank[self->tilegrid->width_in_tiles];
+            memset(blank, 0, self->tilegrid->width_in_tiles);
+            displayio_tilegrid_set_tile_span(self->tilegrid, 0, self->cursor_y, blank, self->tilegrid->width_in_tiles);
+            start_y = self->cursor_y;
             common_hal_displayio_tilegrid_set_top_left(self->tilegrid, 0, (start_y + self->tilegrid->height_in_tiles + 1) % self->tilegrid->height_in_tiles);
         }
     }
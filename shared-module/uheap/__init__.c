@@ -25,14 +25,17 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 
 #include "py/bc.h"
 #include "py/binary.h"
+#include "py/builtin.h"
 #include "py/gc.h"
 #include "py/obj.h"
 #include "py/objarray.h"
 #include "py/objfun.h"
 #include "py/objint.h"
+#include "py/objmodule.h"
 #include "py/objstr.h"
 #include "py/objtype.h"
 #include "py/runtime.h"
@@ -228,6 +231,20 @@ static uint32_t type_size(uint8_t indent_level, mp_obj_type_t *type) {
 static uint32_t instance_size(uint8_t indent_level, mp_obj_instance_t *instance) {
     uint32_t total_size = gc_nbytes(instance);
 
+    #if MICROPY_PY_SLOTS
+    if (mp_obj_type_has_slots(instance->base.type)) {
+        const mp_obj_slots_type_t *type = (const mp_obj_slots_type_t*)instance->base.type;
+        mp_obj_slots_instance_t *o = (mp_obj_slots_instance_t*)instance;
+        for (size_t i = 0; i < type->n_slots; i++) {
+            if (o->slots[i] != MP_OBJ_NULL) {
+                indent(indent_level);
+                mp_printf(&mp_plat_print, "slot: %q\n", type->slots[i]);
+                total_size += object_size(indent_level + 1, o->slots[i]);
+            }
+        }
+        return total_size;
+    }
+    #endif
     total_size += map_size(indent_level, &instance->members);
 
     return total_size;
@@ -290,3 +307,253 @@ uint32_t shared_module_uheap_info(mp_obj_t obj) {
     }
     return object_size(0, obj);
 }
+
+// Allocation profiler. Allocations are counted per bytecode instruction in a
+// table probed linearly from a hash of the instruction. The table is
+// MP_STATE_VM(uheap_alloc_profile) so that the collector sees the functions
+// in it. Entry 0 counts allocations made outside of Python code and those
+// that don't fit in the table.
+typedef struct {
+    const mp_obj_fun_bc_t *fun;
+    size_t offset;
+    uint32_t count;
+    uint32_t bytes;
+} alloc_profile_entry_t;
+
+static size_t alloc_profile_entry_count;
+static bool alloc_profile_active;
+
+void shared_module_uheap_profiler_start(size_t entry_count) {
+    alloc_profile_active = false;
+    alloc_profile_entry_t *entries = MP_STATE_VM(uheap_alloc_profile);
+    // One more for the entry that catches everything else.
+    entry_count++;
+    if (entries == NULL || alloc_profile_entry_count != entry_count) {
+        MP_STATE_VM(uheap_alloc_profile) = NULL;
+        m_free(entries);
+        entries = m_new(alloc_profile_entry_t, entry_count);
+        MP_STATE_VM(uheap_alloc_profile) = entries;
+        alloc_profile_entry_count = entry_count;
+    }
+    memset(entries, 0, entry_count * sizeof(alloc_profile_entry_t));
+    alloc_profile_active = true;
+}
+
+void shared_module_uheap_profiler_stop(void) {
+    alloc_profile_active = false;
+}
+
+void gc_alloc_profile_record(size_t n_bytes) {
+    if (!alloc_profile_active) {
+        return;
+    }
+    alloc_profile_entry_t *entries = MP_STATE_VM(uheap_alloc_profile);
+    alloc_profile_entry_t *entry = &entries[0];
+    mp_code_state_t *code_state = MP_STATE_THREAD(current_code_state);
+    if (code_state != NULL && code_state->ip >= code_state->fun_bc->bytecode) {
+        const mp_obj_fun_bc_t *fun = code_state->fun_bc;
+        size_t offset = code_state->ip - fun->bytecode;
+        size_t slots = alloc_profile_entry_count - 1;
+        size_t slot = ((uintptr_t)fun / sizeof(mp_uint_t) + offset) % slots;
+        for (size_t i = 0; i < slots; i++) {
+            alloc_profile_entry_t *candidate = &entries[1 + slot];
+            if (candidate->fun == NULL) {
+                candidate->fun = fun;
+                candidate->offset = offset;
+            }
+            if (candidate->fun == fun && candidate->offset == offset) {
+                entry = candidate;
+                break;
+            }
+            slot = (slot + 1) % slots;
+        }
+    }
+    entry->count++;
+    entry->bytes += n_bytes;
+}
+
+mp_obj_t shared_module_uheap_profiler_results(void) {
+    mp_obj_t results = mp_obj_new_dict(0);
+    alloc_profile_entry_t *entries = MP_STATE_VM(uheap_alloc_profile);
+    if (entries == NULL) {
+        return results;
+    }
+    // Don't count the allocations made for the results.
+    bool was_active = alloc_profile_active;
+    alloc_profile_active = false;
+    for (size_t i = 0; i < alloc_profile_entry_count; i++) {
+        alloc_profile_entry_t *entry = &entries[i];
+        if (entry->count == 0) {
+            continue;
+        }
+        mp_obj_t key = mp_const_none;
+        if (entry->fun != NULL) {
+            qstr block_name, source_file;
+            size_t line = mp_bytecode_get_source_line(entry->fun->bytecode, entry->fun->const_table,
+                entry->fun->bytecode + entry->offset, &block_name, &source_file);
+            mp_obj_t items[3] = {
+                MP_OBJ_NEW_QSTR(source_file),
+                MP_OBJ_NEW_QSTR(block_name),
+                MP_OBJ_NEW_SMALL_INT(line),
+            };
+            key = mp_obj_new_tuple(3, items);
+        }
+        // Several instructions of a line add up to one entry.
+        mp_map_elem_t *elem = mp_map_lookup(mp_obj_dict_get_map(results), key, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
+        mp_uint_t count = entry->count;
+        mp_uint_t bytes = entry->bytes;
+        if (elem->value != MP_OBJ_NULL) {
+            mp_obj_t *totals;
+            mp_obj_get_array_fixed_n(elem->value, 2, &totals);
+            count += mp_obj_get_int(totals[0]);
+            bytes += mp_obj_get_int(totals[1]);
+        }
+        mp_obj_t totals[2] = {
+            mp_obj_new_int_from_uint(count),
+            mp_obj_new_int_from_uint(bytes),
+        };
+        elem->value = mp_obj_new_tuple(2, totals);
+    }
+    alloc_profile_active = was_active;
+    return results;
+}
+
+void shared_module_uheap_profiler_reset(void) {
+    alloc_profile_active = false;
+    MP_STATE_VM(uheap_alloc_profile) = NULL;
+    alloc_profile_entry_count = 0;
+}
+
+// Heap census. The types that can be told apart are gathered from the builtins, every module
+// and __main__ first. Blocks whose first word is one of them are counted as instances of it
+// while walking the heap; everything else goes in other.
+typedef struct {
+    const mp_obj_type_t *type;
+    size_t count;
+    size_t bytes;
+} census_entry_t;
+
+typedef struct {
+    census_entry_t *entries;
+    size_t len;
+    size_t alloc;
+    census_entry_t other;
+} census_t;
+
+static void census_add_type(census_t *census, const mp_obj_type_t *type) {
+    if (census->len == census->alloc) {
+        census->entries = m_renew(census_entry_t, census->entries, census->alloc, census->alloc * 2);
+        census->alloc *= 2;
+    }
+    census_entry_t *entry = &census->entries[census->len++];
+    entry->type = type;
+    entry->count = 0;
+    entry->bytes = 0;
+}
+
+static void census_add_types(census_t *census, const mp_map_t *map) {
+    for (size_t i = 0; i < map->alloc; i++) {
+        if (MP_MAP_SLOT_IS_FILLED(map, i) && MP_OBJ_IS_TYPE(map->table[i].value, &mp_type_type)) {
+            census_add_type(census, MP_OBJ_TO_PTR(map->table[i].value));
+        }
+    }
+}
+
+static void census_add_module_types(census_t *census, const mp_map_t *modules) {
+    for (size_t i = 0; i < modules->alloc; i++) {
+        if (MP_MAP_SLOT_IS_FILLED(modules, i) && MP_OBJ_IS_TYPE(modules->table[i].value, &mp_type_module)) {
+            census_add_types(census, &mp_obj_module_get_globals(modules->table[i].value)->map);
+        }
+    }
+}
+
+static void census_allocation(void *ptr, size_t n_bytes, void *arg) {
+    census_t *census = arg;
+    const mp_obj_type_t *type = *(const mp_obj_type_t **)ptr;
+    census_entry_t *entry = &census->other;
+    // Binary search by address so that the first word is never dereferenced.
+    size_t lo = 0;
+    size_t hi = census->len;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (census->entries[mid].type < type) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < census->len && census->entries[lo].type == type) {
+        entry = &census->entries[lo];
+    }
+    entry->count++;
+    entry->bytes += n_bytes;
+}
+
+static mp_obj_t census_totals(const census_entry_t *entry) {
+    mp_obj_t totals[2] = {
+        mp_obj_new_int_from_uint(entry->count),
+        mp_obj_new_int_from_uint(entry->bytes),
+    };
+    return mp_obj_new_tuple(2, totals);
+}
+
+mp_obj_t shared_module_uheap_census(void) {
+    gc_collect();
+
+    census_t census;
+    census.alloc = 64;
+    census.len = 0;
+    census.entries = m_new(census_entry_t, census.alloc);
+    census_add_types(&census, &mp_module_builtins_globals.map);
+    census_add_module_types(&census, &mp_builtin_module_map);
+    census_add_module_types(&census, &MP_STATE_VM(mp_loaded_modules_dict).map);
+    census_add_types(&census, &MP_STATE_VM(dict_main).map);
+    census_add_type(&census, &mp_type_fun_bc);
+    census_add_type(&census, &mp_type_gen_instance);
+    census_add_type(&census, &mp_type_module);
+
+    // Sort by address and drop the types found more than once.
+    for (size_t i = 1; i < census.len; i++) {
+        census_entry_t entry = census.entries[i];
+        size_t j = i;
+        while (j > 0 && census.entries[j - 1].type > entry.type) {
+            census.entries[j] = census.entries[j - 1];
+            j--;
+        }
+        census.entries[j] = entry;
+    }
+    size_t unique = 0;
+    for (size_t i = 0; i < census.len; i++) {
+        if (unique == 0 || census.entries[unique - 1].type != census.entries[i].type) {
+            census.entries[unique++] = census.entries[i];
+        }
+    }
+    census.len = unique;
+    census.other.type = NULL;
+    census.other.count = 0;
+    census.other.bytes = 0;
+
+    size_t free_runs[16] = {0};
+    gc_census(census_allocation, &census, free_runs, MP_ARRAY_SIZE(free_runs));
+
+    mp_obj_t types = mp_obj_new_dict(0);
+    for (size_t i = 0; i < census.len; i++) {
+        if (census.entries[i].count > 0) {
+            mp_obj_dict_store(types, MP_OBJ_FROM_PTR(census.entries[i].type), census_totals(&census.entries[i]));
+        }
+    }
+    if (census.other.count > 0) {
+        mp_obj_dict_store(types, mp_const_none, census_totals(&census.other));
+    }
+    m_del(census_entry_t, census.entries, census.alloc);
+
+    mp_obj_t runs = mp_obj_new_dict(0);
+    for (size_t i = 0; i < MP_ARRAY_SIZE(free_runs); i++) {
+        if (free_runs[i] > 0) {
+            mp_obj_dict_store(runs, MP_OBJ_NEW_SMALL_INT((1 << i) * MICROPY_BYTES_PER_GC_BLOCK),
+                MP_OBJ_NEW_SMALL_INT(free_runs[i]));
+        }
+    }
+    mp_obj_t result[2] = { types, runs };
+    return mp_obj_new_tuple(2, result);
+}
@@ -0,0 +1,167 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/usb_audio/Microphone.h"
+#include "shared-module/usb_audio/__init__.h"
+
+#include "py/mpstate.h"
+#include "py/runtime.h"
+#include "supervisor/shared/background_task.h"
+#include "supervisor/shared/translate.h"
+
+#if CIRCUITPY_AUDIOBUSIO
+#include "shared-bindings/audiobusio/PDMIn.h"
+#endif
+#if CIRCUITPY_AUDIOBUSIO_I2SIN
+#include "shared-bindings/audiobusio/I2SIn.h"
+#endif
+
+usb_audio_microphone_obj_t usb_audio_microphone_obj = {
+    .base = { .type = &usb_audio_microphone_type },
+};
+
+static background_task_t microphone_task;
+
+// Frames moved from the source at a time.
+#define CHUNK_FRAMES 64
+
+// Reads up to frames frames from the source as signed 16 bit stereo. Returns how many it read.
+static uint32_t read_source(mp_obj_t source, int16_t* out, uint32_t frames) {
+    #if CIRCUITPY_AUDIOBUSIO_I2SIN
+    if (MP_OBJ_IS_TYPE(source, &audiobusio_i2sin_type)) {
+        audiobusio_i2sin_obj_t* i2sin = MP_OBJ_TO_PTR(source);
+        if (common_hal_audiobusio_i2sin_get_bit_depth(i2sin) == 16) {
+            return common_hal_audiobusio_i2sin_readinto(i2sin, (uint8_t*) out,
+                frames * USB_AUDIO_FRAME_SIZE) / USB_AUDIO_FRAME_SIZE;
+        }
+        // 24 and 32 bit samples are in 32 bit slots. Keep the top 16 bits.
+        int32_t wide[CHUNK_FRAMES * 2];
+        uint32_t count = common_hal_audiobusio_i2sin_readinto(i2sin, (uint8_t*) wide,
+            frames * 2 * sizeof(int32_t)) / sizeof(int32_t);
+        for (uint32_t i = 0; i < count; i++) {
+            out[i] = wide[i] >> 16;
+        }
+        return count / 2;
+    }
+    #endif
+    #if CIRCUITPY_AUDIOBUSIO
+    if (MP_OBJ_IS_TYPE(source, &audiobusio_pdmin_type)) {
+        // PDMIn records unsigned mono samples. They are read into the second half of out and
+        // spread to both channels from the front, which never overtakes the samples left to read.
+        audiobusio_pdmin_obj_t* pdmin = MP_OBJ_TO_PTR(source);
+        uint16_t* mono = (uint16_t*) out + frames;
+        uint32_t count = common_hal_audiobusio_pdmin_readinto(pdmin, mono, frames);
+        bool eight_bit = common_hal_audiobusio_pdmin_get_bit_depth(pdmin) == 8;
+        for (uint32_t i = 0; i < count; i++) {
+            int16_t sample;
+            if (eight_bit) {
+                sample = (int16_t) ((((uint8_t*) mono)[i] ^ 0x80) << 8);
+            } else {
+                sample = (int16_t) (mono[i] ^ 0x8000);
+            }
+            out[2 * i] = sample;
+            out[2 * i + 1] = sample;
+        }
+        return count;
+    }
+    #endif
+    return 0;
+}
+
+// Moves what the source has recorded into the microphone ring.
+static void microphone_background(void) {
+    mp_obj_t source = MP_STATE_VM(usb_audio_microphone_source);
+    if (source == MP_OBJ_NULL || !usb_audio_microphone_obj.streaming) {
+        return;
+    }
+    int16_t frames[CHUNK_FRAMES * 2];
+    while (true) {
+        uint32_t room = ringbuf_num_empty(&usb_audio_microphone_ring) / USB_AUDIO_FRAME_SIZE;
+        if (room == 0) {
+            // The host isn't keeping up. The source drops its oldest samples once it's full.
+            usb_audio_microphone_obj.overruns++;
+            return;
+        }
+        uint32_t count = read_source(source, frames, MIN(room, CHUNK_FRAMES));
+        if (count == 0) {
+            return;
+        }
+        ringbuf_try_put_n(&usb_audio_microphone_ring, (uint8_t*) frames, count * USB_AUDIO_FRAME_SIZE);
+    }
+}
+
+// Sample rates within 2% are close enough. The host adapts to the source's clock anyway.
+static void check_sample_rate(uint32_t sample_rate) {
+    uint32_t difference = sample_rate > USB_AUDIO_MICROPHONE_SAMPLE_RATE ?
+        sample_rate - USB_AUDIO_MICROPHONE_SAMPLE_RATE :
+        USB_AUDIO_MICROPHONE_SAMPLE_RATE - sample_rate;
+    if (difference > USB_AUDIO_MICROPHONE_SAMPLE_RATE / 50) {
+        mp_raise_ValueError_varg(translate("sample_rate must be %d"), USB_AUDIO_MICROPHONE_SAMPLE_RATE);
+    }
+}
+
+void common_hal_usb_audio_microphone_set_source(usb_audio_microphone_obj_t* self, mp_obj_t source) {
+    if (source == MP_OBJ_NULL) {
+        MP_STATE_VM(usb_audio_microphone_source) = MP_OBJ_NULL;
+        background_task_remove(&microphone_task);
+        return;
+    }
+    bool supported = false;
+    #if CIRCUITPY_AUDIOBUSIO_I2SIN
+    if (MP_OBJ_IS_TYPE(source, &audiobusio_i2sin_type)) {
+        check_sample_rate(common_hal_audiobusio_i2sin_get_sample_rate(MP_OBJ_TO_PTR(source)));
+        supported = true;
+    }
+    #endif
+    #if CIRCUITPY_AUDIOBUSIO
+    if (MP_OBJ_IS_TYPE(source, &audiobusio_pdmin_type)) {
+        check_sample_rate(common_hal_audiobusio_pdmin_get_sample_rate(MP_OBJ_TO_PTR(source)));
+        supported = true;
+    }
+    #endif
+    if (!supported) {
+        mp_raise_TypeError(translate("source must be a recording audiobusio object"));
+    }
+    MP_STATE_VM(usb_audio_microphone_source) = source;
+    background_task_add(&microphone_task, microphone_background, BACKGROUND_TASK_PRIORITY_AUDIO, 1);
+}
+
+mp_obj_t common_hal_usb_audio_microphone_get_source(usb_audio_microphone_obj_t* self) {
+    mp_obj_t source = MP_STATE_VM(usb_audio_microphone_source);
+    return source == MP_OBJ_NULL ? mp_const_none : source;
+}
+
+uint32_t common_hal_usb_audio_microphone_get_sample_rate(usb_audio_microphone_obj_t* self) {
+    return USB_AUDIO_MICROPHONE_SAMPLE_RATE;
+}
+
+bool common_hal_usb_audio_microphone_get_streaming(usb_audio_microphone_obj_t* self) {
+    return self->streaming;
+}
+
+uint32_t common_hal_usb_audio_microphone_get_overruns(usb_audio_microphone_obj_t* self) {
+    return self->overruns;
+}
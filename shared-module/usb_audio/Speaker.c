@@ -0,0 +1,120 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/usb_audio/Speaker.h"
+
+#include <string.h>
+
+usb_audio_speaker_obj_t usb_audio_speaker_obj = {
+    .base = { .type = &usb_audio_speaker_type },
+};
+
+uint32_t common_hal_usb_audio_speaker_get_sample_rate(usb_audio_speaker_obj_t* self) {
+    return USB_AUDIO_SAMPLE_RATE;
+}
+
+uint8_t common_hal_usb_audio_speaker_get_bits_per_sample(usb_audio_speaker_obj_t* self) {
+    return 16;
+}
+
+uint8_t common_hal_usb_audio_speaker_get_channel_count(usb_audio_speaker_obj_t* self) {
+    return 2;
+}
+
+bool common_hal_usb_audio_speaker_get_streaming(usb_audio_speaker_obj_t* self) {
+    return self->streaming;
+}
+
+uint32_t common_hal_usb_audio_speaker_get_underruns(usb_audio_speaker_obj_t* self) {
+    return self->underruns;
+}
+
+uint32_t common_hal_usb_audio_speaker_get_overruns(usb_audio_speaker_obj_t* self) {
+    return self->overruns;
+}
+
+void usb_audio_speaker_reset_buffer(usb_audio_speaker_obj_t* self, bool single_channel,
+                                    uint8_t channel) {
+    if (single_channel && channel == 1) {
+        return;
+    }
+    self->primed = false;
+}
+
+// Moves the next block from the ring into the block that isn't playing.
+static uint8_t* load_block(usb_audio_speaker_obj_t* self) {
+    uint8_t* block = self->blocks[self->next_block];
+    self->next_block = !self->next_block;
+    ringbuf_t* ring = &usb_audio_speaker_ring;
+    if (!self->primed && ringbuf_count(ring) >= USB_AUDIO_SPEAKER_RING_FRAMES / 2 * USB_AUDIO_FRAME_SIZE) {
+        self->primed = true;
+    }
+    uint32_t length = 0;
+    if (self->primed) {
+        length = ringbuf_get_n(ring, block, USB_AUDIO_SPEAKER_BLOCK_SIZE);
+        if (length < USB_AUDIO_SPEAKER_BLOCK_SIZE) {
+            // Wait for the ring to fill again rather than playing each packet as it arrives.
+            self->primed = false;
+            if (self->streaming) {
+                self->underruns++;
+            }
+        }
+    }
+    memset(block + length, 0, USB_AUDIO_SPEAKER_BLOCK_SIZE - length);
+    return block;
+}
+
+audioio_get_buffer_result_t usb_audio_speaker_get_buffer(usb_audio_speaker_obj_t* self,
+                                                         bool single_channel, uint8_t channel,
+                                                         uint8_t** buffer, uint32_t* buffer_length) {
+    // Two single channel players take the same block. The first channel moves on to the next.
+    uint8_t* block;
+    if (!single_channel || channel == 0) {
+        block = load_block(self);
+    } else {
+        block = self->blocks[!self->next_block];
+    }
+    if (single_channel) {
+        block += (channel % 2) * sizeof(int16_t);
+    }
+    *buffer = block;
+    *buffer_length = USB_AUDIO_SPEAKER_BLOCK_SIZE;
+    // The stream never ends. Silence plays while the host isn't sending.
+    return GET_BUFFER_MORE_DATA;
+}
+
+void usb_audio_speaker_get_buffer_structure(usb_audio_speaker_obj_t* self, bool single_channel,
+                                            bool* single_buffer, bool* samples_signed,
+                                            uint32_t* max_buffer_length, uint8_t* spacing) {
+    *single_buffer = false;
+    *samples_signed = true;
+    *max_buffer_length = USB_AUDIO_SPEAKER_BLOCK_SIZE;
+    if (single_channel) {
+        *spacing = 2;
+    } else {
+        *spacing = 1;
+    }
+}
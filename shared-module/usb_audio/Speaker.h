@@ -0,0 +1,61 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SHARED_MODULE_USB_AUDIO_SPEAKER_H
+#define SHARED_MODULE_USB_AUDIO_SPEAKER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "py/obj.h"
+#include "shared-module/audiocore/__init__.h"
+#include "shared-module/usb_audio/__init__.h"
+
+typedef struct {
+    mp_obj_base_t base;
+    // The blocks handed to the player, alternately.
+    uint8_t blocks[2][USB_AUDIO_SPEAKER_BLOCK_SIZE];
+    uint8_t next_block;
+    // False until the ring is half full, so playback starts with some slack.
+    bool primed;
+    bool streaming;
+    uint32_t underruns;
+    uint32_t overruns;
+} usb_audio_speaker_obj_t;
+
+extern usb_audio_speaker_obj_t usb_audio_speaker_obj;
+
+// These are not available from Python because they may be called in an interrupt.
+void usb_audio_speaker_reset_buffer(usb_audio_speaker_obj_t* self, bool single_channel,
+                                    uint8_t channel);
+audioio_get_buffer_result_t usb_audio_speaker_get_buffer(usb_audio_speaker_obj_t* self,
+                                                         bool single_channel, uint8_t channel,
+                                                         uint8_t** buffer, uint32_t* buffer_length);
+void usb_audio_speaker_get_buffer_structure(usb_audio_speaker_obj_t* self, bool single_channel,
+                                            bool* single_buffer, bool* samples_signed,
+                                            uint32_t* max_buffer_length, uint8_t* spacing);
+
+#endif /* SHARED_MODULE_USB_AUDIO_SPEAKER_H */
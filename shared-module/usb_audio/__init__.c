@@ -0,0 +1,106 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-module/usb_audio/__init__.h"
+
+#include "py/mpstate.h"
+#include "shared-bindings/usb_audio/Microphone.h"
+#include "shared-bindings/usb_audio/Speaker.h"
+
+// One slot of each ring is always empty, so a ring's capacity is a whole number of frames.
+static uint8_t speaker_ring_buffer[USB_AUDIO_SPEAKER_RING_FRAMES * USB_AUDIO_FRAME_SIZE + 1];
+ringbuf_t usb_audio_speaker_ring = {speaker_ring_buffer, sizeof(speaker_ring_buffer)};
+
+static uint8_t microphone_ring_buffer[USB_AUDIO_MICROPHONE_RING_FRAMES * USB_AUDIO_FRAME_SIZE + 1];
+ringbuf_t usb_audio_microphone_ring = {microphone_ring_buffer, sizeof(microphone_ring_buffer)};
+
+// Speaker ring fill in frames, low pass filtered, times 256. The player takes whole blocks so
+// the fill alone jumps by a block at a time.
+static int32_t speaker_fill_q8;
+
+// 10.14 fixed point.
+#define NOMINAL_FEEDBACK ((uint32_t) (((uint64_t) USB_AUDIO_SAMPLE_RATE << 14) / 1000))
+// A fill this many frames off target changes the rate by one sample per millisecond.
+#define FEEDBACK_GAIN_FRAMES 32
+// Host and device clocks are within a fraction of a percent so this is plenty.
+#define MAX_FEEDBACK_ADJUST (1 << 13)
+
+void usb_audio_speaker_set_streaming(bool streaming) {
+    usb_audio_speaker_obj.streaming = streaming;
+}
+
+void usb_audio_speaker_received(const uint8_t* data, uint32_t length) {
+    // The ring's free space is whole frames, so putting whole packets keeps frames whole.
+    if (length > ringbuf_num_empty(&usb_audio_speaker_ring)) {
+        usb_audio_speaker_obj.overruns++;
+    } else {
+        ringbuf_try_put_n(&usb_audio_speaker_ring, data, length);
+    }
+    int32_t fill = ringbuf_count(&usb_audio_speaker_ring) / USB_AUDIO_FRAME_SIZE;
+    speaker_fill_q8 += ((fill << 8) - speaker_fill_q8) / 32;
+}
+
+uint32_t usb_audio_speaker_feedback(void) {
+    int32_t target_q8 = (USB_AUDIO_SPEAKER_RING_FRAMES / 2) << 8;
+    int32_t error_q8 = target_q8 - speaker_fill_q8;
+    // Frames times 256 to 10.14 samples per frame.
+    int32_t adjust = error_q8 * (1 << 6) / FEEDBACK_GAIN_FRAMES;
+    if (adjust > MAX_FEEDBACK_ADJUST) {
+        adjust = MAX_FEEDBACK_ADJUST;
+    } else if (adjust < -MAX_FEEDBACK_ADJUST) {
+        adjust = -MAX_FEEDBACK_ADJUST;
+    }
+    return NOMINAL_FEEDBACK + adjust;
+}
+
+void usb_audio_microphone_set_streaming(bool streaming) {
+    if (streaming) {
+        // Drop what was recorded for the last stream.
+        ringbuf_consume(&usb_audio_microphone_ring, ringbuf_count(&usb_audio_microphone_ring));
+    }
+    usb_audio_microphone_obj.streaming = streaming;
+}
+
+uint32_t usb_audio_microphone_packet(uint8_t* packet, uint32_t max_length) {
+    // Send the nominal rate, with an extra frame when the ring is filling up, because the source
+    // has its own clock.
+    uint32_t frames = USB_AUDIO_MICROPHONE_SAMPLE_RATE / 1000;
+    usb_audio_microphone_obj.frame_remainder += USB_AUDIO_MICROPHONE_SAMPLE_RATE % 1000;
+    if (usb_audio_microphone_obj.frame_remainder >= 1000) {
+        usb_audio_microphone_obj.frame_remainder -= 1000;
+        frames++;
+    }
+    uint32_t available = ringbuf_count(&usb_audio_microphone_ring) / USB_AUDIO_FRAME_SIZE;
+    if (available > frames + USB_AUDIO_MICROPHONE_RING_FRAMES / 2) {
+        frames++;
+    }
+    frames = MIN(frames, MIN(available, max_length / USB_AUDIO_FRAME_SIZE));
+    return ringbuf_get_n(&usb_audio_microphone_ring, packet, frames * USB_AUDIO_FRAME_SIZE);
+}
+
+void usb_audio_reset(void) {
+    common_hal_usb_audio_microphone_set_source(&usb_audio_microphone_obj, MP_OBJ_NULL);
+}
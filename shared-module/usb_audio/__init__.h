@@ -0,0 +1,76 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SHARED_MODULE_USB_AUDIO___INIT___H
+#define SHARED_MODULE_USB_AUDIO___INIT___H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "genhdr/autogen_usb_descriptor.h"
+#include "py/ringbuf.h"
+
+// Samples are signed 16 bit stereo in both directions.
+#define USB_AUDIO_FRAME_SIZE 4
+
+// Milliseconds of audio each ring holds. Latency is about half of it plus a block.
+#ifndef USB_AUDIO_BUFFER_MS
+#define USB_AUDIO_BUFFER_MS 16
+#endif
+
+#define USB_AUDIO_SPEAKER_FRAMES_PER_MS ((USB_AUDIO_SAMPLE_RATE + 999) / 1000)
+#define USB_AUDIO_MICROPHONE_FRAMES_PER_MS ((USB_AUDIO_MICROPHONE_SAMPLE_RATE + 999) / 1000)
+
+#define USB_AUDIO_SPEAKER_RING_FRAMES (USB_AUDIO_SPEAKER_FRAMES_PER_MS * USB_AUDIO_BUFFER_MS)
+#define USB_AUDIO_MICROPHONE_RING_FRAMES (USB_AUDIO_MICROPHONE_FRAMES_PER_MS * USB_AUDIO_BUFFER_MS)
+
+// The speaker hands a quarter of its ring at a time to the audio pipeline.
+#define USB_AUDIO_SPEAKER_BLOCK_SIZE \
+    (USB_AUDIO_SPEAKER_FRAMES_PER_MS * USB_AUDIO_BUFFER_MS / 4 * USB_AUDIO_FRAME_SIZE)
+
+// Audio received from the host, waiting for usb_audio.speaker to be played. The USB driver
+// puts and the audio pipeline gets.
+extern ringbuf_t usb_audio_speaker_ring;
+// Audio recorded from the microphone source, waiting to be sent to the host. The microphone's
+// background task puts and the USB driver gets.
+extern ringbuf_t usb_audio_microphone_ring;
+
+// Called by the USB driver. These may run in an interrupt.
+
+// The host selected the alternate setting that streams, or the one that doesn't.
+void usb_audio_speaker_set_streaming(bool streaming);
+void usb_audio_microphone_set_streaming(bool streaming);
+// A speaker packet arrived.
+void usb_audio_speaker_received(const uint8_t* data, uint32_t length);
+// Samples per frame, in 10.14 fixed point, that keep the speaker ring half full.
+uint32_t usb_audio_speaker_feedback(void);
+// Fills the next microphone packet and returns its length.
+uint32_t usb_audio_microphone_packet(uint8_t* packet, uint32_t max_length);
+
+// Forgets the microphone source, which is on the heap.
+void usb_audio_reset(void);
+
+#endif /* SHARED_MODULE_USB_AUDIO___INIT___H */
@@ -0,0 +1,113 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/usb_cdc/Serial.h"
+
+#include "lib/utils/interrupt_char.h"
+#include "py/mphal.h"
+#include "supervisor/shared/tick.h"
+#include "supervisor/usb.h"
+#include "tusb.h"
+
+size_t common_hal_usb_cdc_serial_read(usb_cdc_serial_obj_t *self, uint8_t *data, size_t len, int *errcode) {
+    uint32_t timeout_ms = (uint32_t) (self->timeout * 1000);
+    uint64_t start_ticks = supervisor_ticks_ms64();
+    size_t count = 0;
+    // Wait up to the timeout for each new chunk, the same as busio.UART does between characters.
+    while (count < len) {
+        usb_lock();
+        uint32_t n = tud_cdc_n_read(self->itf, data + count, len - count);
+        usb_unlock();
+        if (n > 0) {
+            count += n;
+            start_ticks = supervisor_ticks_ms64();
+            continue;
+        }
+        if (supervisor_ticks_ms64() - start_ticks >= timeout_ms) {
+            break;
+        }
+        RUN_BACKGROUND_TASKS;
+        // Allow user to break out of a timeout with a KeyboardInterrupt.
+        if (mp_hal_is_interrupted()) {
+            break;
+        }
+    }
+    return count;
+}
+
+size_t common_hal_usb_cdc_serial_write(usb_cdc_serial_obj_t *self, const uint8_t *data, size_t len, int *errcode) {
+    size_t count = 0;
+    while (count < len) {
+        usb_lock();
+        uint32_t n = tud_cdc_n_write(self->itf, data + count, len - count);
+        if (n == 0) {
+            // The FIFO is full so send what's in it now rather than at the next USB task.
+            tud_cdc_n_write_flush(self->itf);
+        }
+        usb_unlock();
+        count += n;
+        if (n > 0) {
+            continue;
+        }
+        // Nothing drains the FIFO without a host, so don't wait for one.
+        if (!tud_cdc_n_connected(self->itf)) {
+            break;
+        }
+        RUN_BACKGROUND_TASKS;
+        if (mp_hal_is_interrupted()) {
+            break;
+        }
+    }
+    usb_lock();
+    tud_cdc_n_write_flush(self->itf);
+    usb_unlock();
+    return count;
+}
+
+uint32_t common_hal_usb_cdc_serial_get_in_waiting(usb_cdc_serial_obj_t *self) {
+    usb_lock();
+    uint32_t available = tud_cdc_n_available(self->itf);
+    usb_unlock();
+    return available;
+}
+
+void common_hal_usb_cdc_serial_reset_input_buffer(usb_cdc_serial_obj_t *self) {
+    usb_lock();
+    tud_cdc_n_read_flush(self->itf);
+    usb_unlock();
+}
+
+bool common_hal_usb_cdc_serial_get_connected(usb_cdc_serial_obj_t *self) {
+    return tud_cdc_n_connected(self->itf);
+}
+
+mp_float_t common_hal_usb_cdc_serial_get_timeout(usb_cdc_serial_obj_t *self) {
+    return self->timeout;
+}
+
+void common_hal_usb_cdc_serial_set_timeout(usb_cdc_serial_obj_t *self, mp_float_t timeout) {
+    self->timeout = timeout;
+}
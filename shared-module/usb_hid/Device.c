@@ -31,6 +31,7 @@
 #include "shared-module/usb_hid/Device.h"
 #include "supervisor/shared/translate.h"
 #include "supervisor/shared/tick.h"
+#include "supervisor/usb.h"
 #include "tusb.h"
 
 uint8_t common_hal_usb_hid_device_get_usage_page(usb_hid_device_obj_t *self) {
@@ -41,25 +42,51 @@ uint8_t common_hal_usb_hid_device_get_usage(usb_hid_device_obj_t *self) {
     return self->usage;
 }
 
-void common_hal_usb_hid_device_send_report(usb_hid_device_obj_t *self, uint8_t* report, uint8_t len) {
+bool common_hal_usb_hid_device_send_report(usb_hid_device_obj_t *self, uint8_t* report, uint8_t len, bool block) {
     if (len != self->report_length) {
         mp_raise_ValueError_varg(translate("Buffer incorrect size. Should be %d bytes."), self->report_length);
     }
 
-    // Wait until interface is ready, timeout = 2 seconds
+    // Wait until there is room in the queue, timeout = 2 seconds
     uint64_t end_ticks = supervisor_ticks_ms64() + 2000;
-    while ( (supervisor_ticks_ms64() < end_ticks) && !tud_hid_ready() ) {
+    while ( block && (supervisor_ticks_ms64() < end_ticks) && ringbuf_num_empty(&self->report_queue) < len ) {
         RUN_BACKGROUND_TASKS;
     }
 
-    if ( !tud_hid_ready() ) {
+    if ( ringbuf_num_empty(&self->report_queue) < len ) {
+        if (!block) {
+            return false;
+        }
         mp_raise_msg(&mp_type_OSError,  translate("USB Busy"));
     }
 
-    memcpy(self->report_buffer, report, len);
+    ringbuf_try_put_n(&self->report_queue, report, len);
+
+    // Send it straight away if the interface is ready.
+    usb_lock();
+    usb_hid_background();
+    usb_unlock();
+    return true;
+}
 
-    if ( !tud_hid_report(self->report_id, self->report_buffer, len) ) {
-        mp_raise_msg(&mp_type_OSError, translate("USB Error"));
+// Sends the next queued report when the interface is ready. Only one report can be in flight, so
+// devices take turns.
+void usb_hid_background(void) {
+    static uint8_t next_device;
+    if (!tud_hid_ready()) {
+        return;
+    }
+    for (uint8_t i = 0; i < USB_HID_NUM_DEVICES; i++) {
+        uint8_t index = (next_device + i) % USB_HID_NUM_DEVICES;
+        usb_hid_device_obj_t *device = &usb_hid_devices[index];
+        if (ringbuf_count(&device->report_queue) < device->report_length) {
+            continue;
+        }
+        ringbuf_get_n(&device->report_queue, device->report_buffer, device->report_length);
+        // If the host has gone away the report is lost, as it would be once sent.
+        tud_hid_report(device->report_id, device->report_buffer, device->report_length);
+        next_device = (index + 1) % USB_HID_NUM_DEVICES;
+        return;
     }
 }
 
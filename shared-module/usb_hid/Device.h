@@ -31,6 +31,10 @@
 #include <stdbool.h>
 
 #include "py/obj.h"
+#include "py/ringbuf.h"
+
+// The number of reports each device can hold while waiting for the host to poll.
+#define USB_HID_REPORT_QUEUE_LENGTH (8)
 
 #ifdef __cplusplus
  extern "C" {
@@ -38,7 +42,9 @@
 
 typedef struct  {
     mp_obj_base_t base;
+    // The last report sent, for Get_Report requests.
     uint8_t* report_buffer;
+    ringbuf_t report_queue;
     uint8_t report_id;
     uint8_t report_length;
     uint8_t usage_page;
@@ -48,6 +54,8 @@ typedef struct  {
 
 extern usb_hid_device_obj_t usb_hid_devices[];
 
+void usb_hid_background(void);
+
 #ifdef __cplusplus
  }
 #endif
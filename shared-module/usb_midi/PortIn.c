@@ -26,12 +26,29 @@
 
 #include "shared-module/usb_midi/PortIn.h"
 #include "supervisor/shared/translate.h"
+#include "supervisor/usb.h"
 #include "tusb.h"
 
 size_t common_hal_usb_midi_portin_read(usb_midi_portin_obj_t *self, uint8_t *data, size_t len, int *errcode) {
-    return tud_midi_read(data, len);
+    usb_lock();
+    size_t count = tud_midi_read(data, len);
+    usb_unlock();
+    return count;
+}
+
+size_t common_hal_usb_midi_portin_read_packets(usb_midi_portin_obj_t *self, uint8_t *data, size_t len) {
+    size_t i = 0;
+    usb_lock();
+    while (i + 4 <= len && tud_midi_receive(data + i)) {
+        i += 4;
+    }
+    usb_unlock();
+    return i;
 }
 
 uint32_t common_hal_usb_midi_portin_bytes_available(usb_midi_portin_obj_t *self) {
-    return tud_midi_available();
+    usb_lock();
+    uint32_t available = tud_midi_available();
+    usb_unlock();
+    return available;
 }
@@ -26,10 +26,140 @@
 
 #include "shared-module/usb_midi/PortOut.h"
 #include "supervisor/shared/translate.h"
+#include "supervisor/usb.h"
 #include "tusb.h"
 
+// USB-MIDI Code Index Numbers, the low nibble of the first byte of each event packet.
+#define CIN_SYSCOM_2BYTE (0x2)
+#define CIN_SYSCOM_3BYTE (0x3)
+#define CIN_SYSEX_START (0x4)
+#define CIN_SYSEX_END_1BYTE (0x5)
+#define CIN_SYSEX_END_2BYTE (0x6)
+#define CIN_SYSEX_END_3BYTE (0x7)
+#define CIN_1BYTE (0xf)
+
+void usb_midi_portout_reset(usb_midi_portout_obj_t *self) {
+    self->message_length = 0;
+    self->message_needed = 0;
+    self->running_status = 0;
+    self->in_sysex = false;
+}
+
+STATIC bool send_packet(uint8_t cin, const uint8_t *message, uint8_t length) {
+    uint8_t packet[4] = { cin, 0, 0, 0 };
+    for (uint8_t i = 0; i < length; i++) {
+        packet[i + 1] = message[i];
+    }
+    return tud_midi_send(packet);
+}
+
+// Adds one byte to the message being built and sends a packet when one is complete. Returns false,
+// without changing any state, when the packet can't be queued.
+STATIC bool encode_byte(usb_midi_portout_obj_t *self, uint8_t b) {
+    if (b >= 0xf8) {
+        // Real-time messages can appear anywhere, even inside other messages.
+        return send_packet(CIN_1BYTE, &b, 1);
+    }
+    if (b == 0xf7) {
+        if (!self->in_sysex) {
+            return true;
+        }
+        self->message[self->message_length] = b;
+        if (!send_packet(CIN_SYSEX_END_1BYTE + self->message_length, self->message, self->message_length + 1)) {
+            return false;
+        }
+        self->in_sysex = false;
+        self->message_length = 0;
+        return true;
+    }
+    if (self->in_sysex && b < 0x80) {
+        if (self->message_length == 2) {
+            self->message[2] = b;
+            if (!send_packet(CIN_SYSEX_START, self->message, 3)) {
+                return false;
+            }
+            self->message_length = 0;
+        } else {
+            self->message[self->message_length++] = b;
+        }
+        return true;
+    }
+    if (b >= 0x80) {
+        // A new status byte ends any unfinished message, including sysex.
+        self->in_sysex = false;
+        self->message_length = 0;
+        self->message_needed = 0;
+        if (b == 0xf0) {
+            self->running_status = 0;
+            self->in_sysex = true;
+            self->message[self->message_length++] = b;
+            return true;
+        }
+        if (b < 0xf0) {
+            self->running_status = b;
+            self->message[self->message_length++] = b;
+            self->message_needed = (b & 0xe0) == 0xc0 ? 1 : 2;
+            return true;
+        }
+        // System common messages cancel running status.
+        self->running_status = 0;
+        if (b == 0xf1 || b == 0xf3) {
+            self->message[self->message_length++] = b;
+            self->message_needed = 1;
+        } else if (b == 0xf2) {
+            self->message[self->message_length++] = b;
+            self->message_needed = 2;
+        } else if (b == 0xf6) {
+            return send_packet(CIN_SYSEX_END_1BYTE, &b, 1);
+        }
+        return true;
+    }
+    // A data byte.
+    uint8_t status = self->message_length > 0 ? self->message[0] : self->running_status;
+    if (status == 0) {
+        return true;
+    }
+    uint8_t length = self->message_length;
+    uint8_t needed = self->message_needed;
+    if (length == 0) {
+        self->message[length++] = status;
+        needed = (status & 0xe0) == 0xc0 ? 1 : 2;
+    }
+    self->message[length++] = b;
+    needed--;
+    if (needed == 0) {
+        uint8_t cin = status >> 4;
+        if (status >= 0xf0) {
+            cin = length == 2 ? CIN_SYSCOM_2BYTE : CIN_SYSCOM_3BYTE;
+        }
+        if (!send_packet(cin, self->message, length)) {
+            return false;
+        }
+        length = 0;
+    }
+    self->message_length = length;
+    self->message_needed = needed;
+    return true;
+}
+
 size_t common_hal_usb_midi_portout_write(usb_midi_portout_obj_t *self, const uint8_t *data, size_t len, int *errcode) {
-    return tud_midi_write(0, data, len);
+    size_t i = 0;
+    usb_lock();
+    while (i < len && encode_byte(self, data[i])) {
+        i++;
+    }
+    usb_unlock();
+    return i;
+}
+
+size_t common_hal_usb_midi_portout_write_packets(usb_midi_portout_obj_t *self, const uint8_t *data, size_t len) {
+    size_t i = 0;
+    usb_lock();
+    while (i + 4 <= len && tud_midi_send(data + i)) {
+        i += 4;
+    }
+    usb_unlock();
+    return i;
 }
 
 bool common_hal_usb_midi_portout_ready_to_tx(usb_midi_portout_obj_t *self) {
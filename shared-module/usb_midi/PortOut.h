@@ -34,6 +34,16 @@
 
 typedef struct  {
     mp_obj_base_t base;
+    // State for turning the byte stream into USB-MIDI event packets.
+    uint8_t message[3];
+    uint8_t message_length;
+    // Bytes needed to complete the current message, 0 when waiting for a status byte.
+    uint8_t message_needed;
+    // The last channel status byte, reused by data bytes without one. 0 if none.
+    uint8_t running_status;
+    bool in_sysex;
 } usb_midi_portout_obj_t;
 
+void usb_midi_portout_reset(usb_midi_portout_obj_t *self);
+
 #endif /* SHARED_MODULE_USB_MIDI_PORTOUT_H */
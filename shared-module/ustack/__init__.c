@@ -30,15 +30,11 @@
 #include "py/stackctrl.h"
 
 #include "shared-bindings/ustack/__init__.h"
+#include "supervisor/shared/stack.h"
 
 #if MICROPY_MAX_STACK_USAGE
 uint32_t shared_module_ustack_max_stack_usage(void) {
-    // Start at stack limit and move up.
-    // Untouched stack was filled with a sentinel value.
-    // Stop at first non-sentinel byte.
-    char* p = MP_STATE_THREAD(stack_bottom);
-    while (*p++ == MP_MAX_STACK_USAGE_SENTINEL_BYTE) { }
-    return MP_STATE_THREAD(stack_top) - p;
+    return stack_get_max_usage();
 }
 #endif
 
@@ -63,11 +63,13 @@ STATIC void wiz_cris_exit(void) {
 }
 
 STATIC void wiz_cs_select(void) {
+    wiznet5k_obj.selected = true;
     common_hal_digitalio_digitalinout_set_value(&wiznet5k_obj.cs, 0);
 }
 
 STATIC void wiz_cs_deselect(void) {
     common_hal_digitalio_digitalinout_set_value(&wiznet5k_obj.cs, 1);
+    wiznet5k_obj.selected = false;
 }
 
 STATIC void wiz_spi_read(uint8_t *buf, uint32_t len) {
@@ -78,6 +80,41 @@ STATIC void wiz_spi_write(const uint8_t *buf, uint32_t len) {
     (void)common_hal_busio_spi_write(wiznet5k_obj.spi, buf, len);
 }
 
+STATIC void wiz_spi_read_burst(const uint8_t *hdr, uint32_t hdr_len, uint8_t *buf, uint32_t len) {
+    const busio_spi_segment_t segments[] = {
+        { .out = hdr, .in = NULL, .len = hdr_len },
+        { .out = NULL, .in = buf, .len = len },
+    };
+    (void)common_hal_busio_spi_transaction(wiznet5k_obj.spi, segments, 2, 0);
+}
+
+STATIC void wiz_spi_write_burst(const uint8_t *hdr, uint32_t hdr_len, const uint8_t *buf, uint32_t len) {
+    const busio_spi_segment_t segments[] = {
+        { .out = hdr, .in = NULL, .len = hdr_len },
+        { .out = buf, .in = NULL, .len = len },
+    };
+    (void)common_hal_busio_spi_transaction(wiznet5k_obj.spi, segments, 2, 0);
+}
+
+// Waits for a socket event after the chip found socket sn busy, or sets *_errno and returns false
+// when the socket doesn't block or its timeout has passed since start.
+STATIC bool wait_for_socket(uint8_t sn, uint32_t events, mp_uint_t start, int *_errno) {
+    if (sn >= _WIZCHIP_SOCK_NUM_) {
+        *_errno = MP_EBADF;
+        return false;
+    }
+    mp_uint_t timeout = wiznet5k_obj.socket_timeout_ms[sn];
+    if (timeout == 0) {
+        *_errno = MP_EAGAIN;
+        return false;
+    }
+    if (!mp_stream_wait_ready(events, start, timeout)) {
+        *_errno = MP_ETIMEDOUT;
+        return false;
+    }
+    return true;
+}
+
 int wiznet5k_gethostbyname(mp_obj_t nic, const char *name, mp_uint_t len, uint8_t *out_ip) {
     uint8_t dns_ip[MOD_NETWORK_IPADDR_BUF_SIZE] = {8, 8, 8, 8};
     uint8_t *buf = m_new(uint8_t, MAX_DNS_BUF_SIZE);
@@ -123,6 +160,7 @@ int wiznet5k_socket_socket(mod_network_socket_obj_t *socket, int *_errno) {
             *_errno = MP_EMFILE;
             return -1;
         }
+        wiznet5k_obj.socket_timeout_ms[socket->u_param.fileno] = -1;
     }
 
     // WIZNET does not have a concept of pure "open socket".  You need to know
@@ -139,7 +177,14 @@ void wiznet5k_socket_close(mod_network_socket_obj_t *socket) {
     uint8_t sn = (uint8_t)socket->u_param.fileno;
     if (sn < _WIZCHIP_SOCK_NUM_) {
         wiznet5k_obj.socket_used &= ~(1 << sn);
+        wiznet5k_obj.socket_listening &= ~(1 << sn);
+        wiznet5k_obj.rx_staged[sn].start = 0;
+        wiznet5k_obj.rx_staged[sn].len = 0;
+        wiznet5k_obj.socket_ir[sn] = 0;
         WIZCHIP_EXPORT(close)(sn);
+        // The DHCP socket expects the chip to block.
+        uint8_t io_mode = SOCK_IO_BLOCK;
+        WIZCHIP_EXPORT(ctlsocket)(sn, CS_SET_IOMODE, &io_mode);
     }
 }
 
@@ -152,6 +197,10 @@ int wiznet5k_socket_bind(mod_network_socket_obj_t *socket, byte *ip, mp_uint_t p
         return -1;
     }
 
+    // Blocking and timeouts are handled here so background tasks keep running while waiting.
+    uint8_t io_mode = SOCK_IO_NONBLOCK;
+    WIZCHIP_EXPORT(ctlsocket)(socket->u_param.fileno, CS_SET_IOMODE, &io_mode);
+
     // indicate that this socket has been opened
     socket->u_param.domain = 1;
 
@@ -166,13 +215,17 @@ int wiznet5k_socket_listen(mod_network_socket_obj_t *socket, mp_int_t backlog, i
         *_errno = -ret;
         return -1;
     }
+    wiznet5k_obj.socket_listening |= 1 << socket->u_param.fileno;
     return 0;
 }
 
 int wiznet5k_socket_accept(mod_network_socket_obj_t *socket, mod_network_socket_obj_t *socket2, byte *ip, mp_uint_t *port, int *_errno) {
+    mp_uint_t start = mp_hal_ticks_ms();
     for (;;) {
+        uint32_t events = mp_stream_ready_events();
         int sr = getSn_SR((uint8_t)socket->u_param.fileno);
         if (sr == SOCK_ESTABLISHED) {
+            wiznet5k_obj.socket_listening &= ~(1 << socket->u_param.fileno);
             socket2->u_param = socket->u_param;
             getSn_DIPR((uint8_t)socket2->u_param.fileno, ip);
             *port = getSn_PORT(socket2->u_param.fileno);
@@ -180,6 +233,8 @@ int wiznet5k_socket_accept(mod_network_socket_obj_t *socket, mod_network_socket_
             // WIZnet turns the listening socket into the client socket, so we
             // need to re-bind and re-listen on another socket for the server.
             // TODO handle errors, especially no-more-sockets error
+            mp_uint_t timeout = wiznet5k_obj.socket_timeout_ms[socket2->u_param.fileno];
+            wiznet5k_obj.socket_timeout_ms[socket2->u_param.fileno] = -1;
             socket->u_param.domain = MOD_NETWORK_AF_INET;
             socket->u_param.fileno = -1;
             int _errno2;
@@ -189,6 +244,8 @@ int wiznet5k_socket_accept(mod_network_socket_obj_t *socket, mod_network_socket_
                 //printf("(bad rebind %d)\n", _errno2);
             } else if (wiznet5k_socket_listen(socket, 0, &_errno2) != 0) {
                 //printf("(bad relisten %d)\n", _errno2);
+            } else {
+                wiznet5k_obj.socket_timeout_ms[socket->u_param.fileno] = timeout;
             }
 
             return 0;
@@ -198,7 +255,9 @@ int wiznet5k_socket_accept(mod_network_socket_obj_t *socket, mod_network_socket_
             *_errno = MP_ENOTCONN; // ??
             return -1;
         }
-        mp_hal_delay_ms(1);
+        if (!wait_for_socket(socket->u_param.fileno, events, start, _errno)) {
+            return -1;
+        }
     }
 }
 
@@ -213,8 +272,9 @@ int wiznet5k_socket_connect(mod_network_socket_obj_t *socket, byte *ip, mp_uint_
     }
 
     // now connect
+    uint8_t sn = socket->u_param.fileno;
     MP_THREAD_GIL_EXIT();
-    mp_int_t ret = WIZCHIP_EXPORT(connect)(socket->u_param.fileno, ip, port);
+    mp_int_t ret = WIZCHIP_EXPORT(connect)(sn, ip, port);
     MP_THREAD_GIL_ENTER();
 
     if (ret < 0) {
@@ -223,34 +283,115 @@ int wiznet5k_socket_connect(mod_network_socket_obj_t *socket, byte *ip, mp_uint_
         return -1;
     }
 
+    // The chip connects in the background.
+    wiznet5k_obj.socket_ir[sn] = 0;
+    mp_uint_t start = mp_hal_ticks_ms();
+    for (;;) {
+        uint32_t events = mp_stream_ready_events();
+        uint8_t sr = getSn_SR(sn);
+        if (sr == SOCK_ESTABLISHED) {
+            break;
+        }
+        if (sr == SOCK_CLOSED || (getSn_IR(sn) & Sn_IR_TIMEOUT) != 0) {
+            *_errno = sr == SOCK_CLOSED ? MP_ECONNREFUSED : MP_ETIMEDOUT;
+            wiznet5k_socket_close(socket);
+            return -1;
+        }
+        if (!wait_for_socket(sn, events, start, _errno)) {
+            if (*_errno == MP_EAGAIN) {
+                *_errno = MP_EINPROGRESS;
+            }
+            return -1;
+        }
+    }
+
     // success
     return 0;
 }
 
 mp_uint_t wiznet5k_socket_send(mod_network_socket_obj_t *socket, const byte *buf, mp_uint_t len, int *_errno) {
-    MP_THREAD_GIL_EXIT();
-    mp_int_t ret = WIZCHIP_EXPORT(send)(socket->u_param.fileno, (byte*)buf, len);
-    MP_THREAD_GIL_ENTER();
+    uint8_t sn = (uint8_t)socket->u_param.fileno;
+    if (len > 0xffff) {
+        len = 0xffff;
+    }
+    mp_uint_t start = mp_hal_ticks_ms();
+    for (;;) {
+        uint32_t events = mp_stream_ready_events();
+        MP_THREAD_GIL_EXIT();
+        mp_int_t ret = WIZCHIP_EXPORT(send)(sn, (byte*)buf, len);
+        MP_THREAD_GIL_ENTER();
 
-    // TODO convert Wiz errno's to POSIX ones
-    if (ret < 0) {
-        wiznet5k_socket_close(socket);
-        *_errno = -ret;
-        return -1;
+        // TODO convert Wiz errno's to POSIX ones
+        if (ret < 0) {
+            wiznet5k_socket_close(socket);
+            *_errno = -ret;
+            return -1;
+        }
+        // send clears SENDOK, so the next one is new.
+        wiznet5k_obj.socket_ir[sn] = 0;
+        if (ret != SOCK_BUSY) {
+            return ret;
+        }
+        if (!wait_for_socket(sn, events, start, _errno)) {
+            return -1;
+        }
     }
-    return ret;
 }
 
 mp_uint_t wiznet5k_socket_recv(mod_network_socket_obj_t *socket, byte *buf, mp_uint_t len, int *_errno) {
-    MP_THREAD_GIL_EXIT();
-    mp_int_t ret = WIZCHIP_EXPORT(recv)(socket->u_param.fileno, buf, len);
-    MP_THREAD_GIL_ENTER();
+    uint8_t sn = (uint8_t)socket->u_param.fileno;
+    wiznet5k_rx_staged_t *staged = sn < _WIZCHIP_SOCK_NUM_ ? &wiznet5k_obj.rx_staged[sn] : NULL;
+    if (staged != NULL && staged->len > 0) {
+        if (len > staged->len) {
+            len = staged->len;
+        }
+        memcpy(buf, staged->buf + staged->start, len);
+        staged->start += len;
+        staged->len -= len;
+        return len;
+    }
 
-    // TODO convert Wiz errno's to POSIX ones
-    if (ret < 0) {
-        wiznet5k_socket_close(socket);
-        *_errno = -ret;
-        return -1;
+    // Small reads, such as readline's, take what the chip has into the staging buffer so the
+    // next ones don't each cost a round of register accesses.
+    bool stage = staged != NULL && len != 0 && len < WIZNET5K_RX_STAGING_SIZE;
+    if (len > 0xffff) {
+        len = 0xffff;
+    }
+    mp_uint_t start = mp_hal_ticks_ms();
+    mp_int_t ret;
+    for (;;) {
+        uint32_t events = mp_stream_ready_events();
+        MP_THREAD_GIL_EXIT();
+        if (stage) {
+            ret = WIZCHIP_EXPORT(recv)(sn, staged->buf, WIZNET5K_RX_STAGING_SIZE);
+        } else {
+            ret = WIZCHIP_EXPORT(recv)(sn, buf, len);
+        }
+        MP_THREAD_GIL_ENTER();
+
+        // TODO convert Wiz errno's to POSIX ones
+        if (ret < 0) {
+            wiznet5k_socket_close(socket);
+            *_errno = -ret;
+            return -1;
+        }
+        // The chip closes the socket once the peer has shut it down and all its data has been
+        // read, and then recv returns 0 too.
+        if (ret != SOCK_BUSY || getSn_SR(sn) == SOCK_CLOSED) {
+            break;
+        }
+        if (!wait_for_socket(sn, events, start, _errno)) {
+            return -1;
+        }
+    }
+    if (stage && ret > 0) {
+        if (len > (mp_uint_t)ret) {
+            len = ret;
+        }
+        memcpy(buf, staged->buf, len);
+        staged->start = len;
+        staged->len = ret - len;
+        return len;
     }
     return ret;
 }
@@ -263,30 +404,58 @@ mp_uint_t wiznet5k_socket_sendto(mod_network_socket_obj_t *socket, const byte *b
         }
     }
 
-    MP_THREAD_GIL_EXIT();
-    mp_int_t ret = WIZCHIP_EXPORT(sendto)(socket->u_param.fileno, (byte*)buf, len, ip, port);
-    MP_THREAD_GIL_ENTER();
+    uint8_t sn = (uint8_t)socket->u_param.fileno;
+    if (len > 0xffff) {
+        len = 0xffff;
+    }
+    mp_uint_t start = mp_hal_ticks_ms();
+    for (;;) {
+        uint32_t events = mp_stream_ready_events();
+        MP_THREAD_GIL_EXIT();
+        mp_int_t ret = WIZCHIP_EXPORT(sendto)(sn, (byte*)buf, len, ip, port);
+        MP_THREAD_GIL_ENTER();
 
-    if (ret < 0) {
-        wiznet5k_socket_close(socket);
-        *_errno = -ret;
-        return -1;
+        if (ret < 0) {
+            wiznet5k_socket_close(socket);
+            *_errno = -ret;
+            return -1;
+        }
+        // sendto clears SENDOK, so the next one is new.
+        wiznet5k_obj.socket_ir[sn] = 0;
+        if (ret != SOCK_BUSY) {
+            return ret;
+        }
+        if (!wait_for_socket(sn, events, start, _errno)) {
+            return -1;
+        }
     }
-    return ret;
 }
 
 mp_uint_t wiznet5k_socket_recvfrom(mod_network_socket_obj_t *socket, byte *buf, mp_uint_t len, byte *ip, mp_uint_t *port, int *_errno) {
-    uint16_t port2;
-    MP_THREAD_GIL_EXIT();
-    mp_int_t ret = WIZCHIP_EXPORT(recvfrom)(socket->u_param.fileno, buf, len, ip, &port2);
-    MP_THREAD_GIL_ENTER();
-    *port = port2;
-    if (ret < 0) {
-        wiznet5k_socket_close(socket);
-        *_errno = -ret;
-        return -1;
+    uint8_t sn = (uint8_t)socket->u_param.fileno;
+    if (len > 0xffff) {
+        len = 0xffff;
+    }
+    mp_uint_t start = mp_hal_ticks_ms();
+    for (;;) {
+        uint32_t events = mp_stream_ready_events();
+        uint16_t port2;
+        MP_THREAD_GIL_EXIT();
+        mp_int_t ret = WIZCHIP_EXPORT(recvfrom)(sn, buf, len, ip, &port2);
+        MP_THREAD_GIL_ENTER();
+        *port = port2;
+        if (ret < 0) {
+            wiznet5k_socket_close(socket);
+            *_errno = -ret;
+            return -1;
+        }
+        if (ret != SOCK_BUSY) {
+            return ret;
+        }
+        if (!wait_for_socket(sn, events, start, _errno)) {
+            return -1;
+        }
     }
-    return ret;
 }
 
 int wiznet5k_socket_setsockopt(mod_network_socket_obj_t *socket, mp_uint_t level, mp_uint_t opt, const void *optval, mp_uint_t optlen, int *_errno) {
@@ -296,26 +465,39 @@ int wiznet5k_socket_setsockopt(mod_network_socket_obj_t *socket, mp_uint_t level
 }
 
 int wiznet5k_socket_settimeout(mod_network_socket_obj_t *socket, mp_uint_t timeout_ms, int *_errno) {
-    // TODO
-    *_errno = MP_EINVAL;
-    return -1;
-
-    /*
-    if (timeout_ms == 0) {
-        // set non-blocking mode
-        uint8_t arg = SOCK_IO_NONBLOCK;
-        WIZCHIP_EXPORT(ctlsocket)(socket->u_param.fileno, CS_SET_IOMODE, &arg);
+    uint8_t sn = (uint8_t)socket->u_param.fileno;
+    if (sn >= _WIZCHIP_SOCK_NUM_) {
+        *_errno = MP_EBADF;
+        return -1;
     }
-    */
+    wiznet5k_obj.socket_timeout_ms[sn] = timeout_ms;
+    return 0;
 }
 
 int wiznet5k_socket_ioctl(mod_network_socket_obj_t *socket, mp_uint_t request, mp_uint_t arg, int *_errno) {
     if (request == MP_STREAM_POLL) {
         int ret = 0;
-        if (arg & MP_STREAM_POLL_RD && getSn_RX_RSR(socket->u_param.fileno) != 0) {
-            ret |= MP_STREAM_POLL_RD;
+        uint8_t sn = (uint8_t)socket->u_param.fileno;
+        if (sn >= _WIZCHIP_SOCK_NUM_) {
+            *_errno = MP_EBADF;
+            return -1;
         }
-        if (arg & MP_STREAM_POLL_WR && getSn_TX_FSR(socket->u_param.fileno) != 0) {
+        uint8_t sr = getSn_SR(sn);
+        if (arg & MP_STREAM_POLL_RD) {
+            bool readable;
+            if (wiznet5k_obj.socket_listening & (1 << sn)) {
+                // a connection is waiting to be accepted
+                readable = sr != SOCK_LISTEN;
+            } else {
+                // closed sockets are readable so the reader sees the end or the error
+                readable = wiznet5k_obj.rx_staged[sn].len != 0 || getSn_RX_RSR(sn) != 0 ||
+                    sr == SOCK_CLOSE_WAIT || sr == SOCK_CLOSED;
+            }
+            if (readable) {
+                ret |= MP_STREAM_POLL_RD;
+            }
+        }
+        if (arg & MP_STREAM_POLL_WR && sr != SOCK_SYNSENT && getSn_TX_FSR(sn) != 0) {
             ret |= MP_STREAM_POLL_WR;
         }
         return ret;
@@ -325,6 +507,45 @@ int wiznet5k_socket_ioctl(mod_network_socket_obj_t *socket, mp_uint_t request, m
     }
 }
 
+void wiznet5k_poll_events(mp_obj_t nic) {
+    (void)nic;
+    uint8_t used = wiznet5k_obj.socket_used;
+    if (used == 0) {
+        return;
+    }
+    #if _WIZCHIP_ == 5500
+    // Keep out of a frame being sent, to the chip or to another device on the bus.
+    if (wiznet5k_obj.selected || !common_hal_busio_spi_try_lock(wiznet5k_obj.spi)) {
+        mp_stream_signal_ready();
+        return;
+    }
+    uint8_t sir = getSIR() & used;
+    bool events = false;
+    for (uint8_t sn = 0; sn < _WIZCHIP_SOCK_NUM_; sn++) {
+        if ((sir & (1 << sn)) == 0) {
+            wiznet5k_obj.socket_ir[sn] = 0;
+            continue;
+        }
+        uint8_t ir = getSn_IR(sn);
+        // socket.c waits for SENDOK and TIMEOUT and clears them itself.
+        uint8_t clear = ir & (Sn_IR_CON | Sn_IR_DISCON | Sn_IR_RECV);
+        if (clear != 0) {
+            setSn_IR(sn, clear);
+        }
+        ir &= ~clear;
+        events = events || clear != 0 || (ir & ~wiznet5k_obj.socket_ir[sn]) != 0;
+        wiznet5k_obj.socket_ir[sn] = ir;
+    }
+    common_hal_busio_spi_unlock(wiznet5k_obj.spi);
+    if (events) {
+        mp_stream_signal_ready();
+    }
+    #else
+    // The W5200 driver doesn't read SIR.
+    mp_stream_signal_ready();
+    #endif
+}
+
 void wiznet5k_socket_timer_tick(mod_network_socket_obj_t *socket) {
     if (wiznet5k_obj.dhcp_socket >= 0) {
         DHCP_time_handler();
@@ -386,7 +607,11 @@ mp_obj_t wiznet5k_create(mp_obj_t spi_in, mp_obj_t cs_in, mp_obj_t rst_in) {
     wiznet5k_obj.cris_state = 0;
     wiznet5k_obj.spi = MP_OBJ_TO_PTR(spi_in);
     wiznet5k_obj.socket_used = 0;
+    wiznet5k_obj.socket_listening = 0;
     wiznet5k_obj.dhcp_socket = -1;
+    memset(wiznet5k_obj.rx_staged, 0, sizeof(wiznet5k_obj.rx_staged));
+    memset(wiznet5k_obj.socket_ir, 0, sizeof(wiznet5k_obj.socket_ir));
+    wiznet5k_obj.selected = false;
 
     /*!< SPI configuration */
     // XXX probably should check if the provided SPI is already configured, and
@@ -408,10 +633,13 @@ mp_obj_t wiznet5k_create(mp_obj_t spi_in, mp_obj_t cs_in, mp_obj_t rst_in) {
     reg_wizchip_cris_cbfunc(wiz_cris_enter, wiz_cris_exit);
     reg_wizchip_cs_cbfunc(wiz_cs_select, wiz_cs_deselect);
     reg_wizchip_spi_cbfunc(wiz_spi_read, wiz_spi_write);
+    reg_wizchip_spiburst_cbfunc(wiz_spi_read_burst, wiz_spi_write_burst);
 
     // 2k buffer for each socket
     uint8_t sn_size[16] = {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
     ctlwizchip(CW_INIT_WIZCHIP, sn_size);
+    // wiznet5k_poll_events reads socket events from SIR.
+    wizchip_setinterruptmask(IK_SOCK_ALL);
 
     wiz_NetInfo netinfo = {
         .dhcp = NETINFO_DHCP,
@@ -32,6 +32,15 @@
 #include "internet/dns/dns.h"
 #include "internet/dhcp/dhcp.h"
 
+// Bytes a socket has taken from the chip but not yet returned.
+#define WIZNET5K_RX_STAGING_SIZE (128)
+
+typedef struct _wiznet5k_rx_staged_t {
+    uint8_t buf[WIZNET5K_RX_STAGING_SIZE];
+    uint16_t start;
+    uint16_t len;
+} wiznet5k_rx_staged_t;
+
 typedef struct _wiznet5k_obj_t {
     mp_obj_base_t base;
     mp_uint_t cris_state;
@@ -39,7 +48,12 @@ typedef struct _wiznet5k_obj_t {
     digitalio_digitalinout_obj_t cs;
     digitalio_digitalinout_obj_t rst;
     uint8_t socket_used;
+    uint8_t socket_listening;
     int8_t dhcp_socket; // -1 for DHCP not in use
+    wiznet5k_rx_staged_t rx_staged[_WIZCHIP_SOCK_NUM_];
+    mp_uint_t socket_timeout_ms[_WIZCHIP_SOCK_NUM_]; // -1 blocks
+    uint8_t socket_ir[_WIZCHIP_SOCK_NUM_]; // Sn_IR bits left set when last polled
+    bool selected; // in the middle of a frame
 } wiznet5k_obj_t;
 
 int wiznet5k_gethostbyname(mp_obj_t nic, const char *name, mp_uint_t len, uint8_t *out_ip);
@@ -56,6 +70,7 @@ mp_uint_t wiznet5k_socket_recvfrom(mod_network_socket_obj_t *socket, byte *buf,
 int wiznet5k_socket_setsockopt(mod_network_socket_obj_t *socket, mp_uint_t level, mp_uint_t opt, const void *optval, mp_uint_t optlen, int *_errno);
 int wiznet5k_socket_settimeout(mod_network_socket_obj_t *socket, mp_uint_t timeout_ms, int *_errno);
 int wiznet5k_socket_ioctl(mod_network_socket_obj_t *socket, mp_uint_t request, mp_uint_t arg, int *_errno);
+void wiznet5k_poll_events(mp_obj_t nic);
 void wiznet5k_socket_timer_tick(mod_network_socket_obj_t *socket);
 void wiznet5k_socket_deinit(mod_network_socket_obj_t *socket);
 mp_obj_t wiznet5k_socket_disconnect(mp_obj_t self_in);
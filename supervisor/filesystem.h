@@ -28,6 +28,7 @@
 #define MICROPY_INCLUDED_SUPERVISOR_FILESYSTEM_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "extmod/vfs_fat.h"
 
@@ -35,6 +36,9 @@ extern volatile bool filesystem_flush_requested;
 
 void filesystem_background(void);
 void filesystem_tick(void);
+// Called after blocks are written, to flush them once writes stop.
+void filesystem_written(void);
+void filesystem_get_flush_statistics(uint32_t *flushes, uint32_t *flushes_saved);
 void filesystem_init(bool create_allowed, bool force_create);
 void filesystem_flush(void);
 bool filesystem_present(void);
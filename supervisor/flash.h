@@ -50,4 +50,9 @@ void supervisor_flash_init_vfs(struct _fs_user_mount_t *vfs);
 void supervisor_flash_flush(void);
 void supervisor_flash_release_cache(void);
 
+// Returns the address a filesystem block can be read at directly, or NULL
+// when the flash isn't memory mapped. Consecutive blocks must be mapped at
+// consecutive addresses.
+const uint8_t *supervisor_flash_get_mapped_block(uint32_t block);
+
 #endif  // MICROPY_INCLUDED_SUPERVISOR_FLASH_H
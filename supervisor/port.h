@@ -27,6 +27,8 @@
 #ifndef MICROPY_INCLUDED_SUPERVISOR_PORT_H
 #define MICROPY_INCLUDED_SUPERVISOR_PORT_H
 
+#include <stdbool.h>
+
 #include "py/mpconfig.h"
 
 #include "supervisor/shared/safe_mode.h"
@@ -60,8 +62,31 @@ uint32_t *port_stack_get_limit(void);
 // Get stack top address
 uint32_t *port_stack_get_top(void);
 
+// True when the stack has its own memory between the limit and top above. Otherwise it is
+// allocated from the top of the heap's memory. Defaults to false.
+bool port_has_fixed_stack(void);
+
+// Get the bounds of the memory the VM heap and supervisor allocations come from. Default to the
+// stack limit and top, for ports that share one region between them.
+uint32_t *port_heap_get_bottom(void);
+uint32_t *port_heap_get_top(void);
+
 // Save and retrieve a word from memory that is preserved over reset. Used for safe mode.
 void port_set_saved_word(uint32_t);
 uint32_t port_get_saved_word(void);
 
+// Free running count of CPU cycles, for timing short runs of code. Only the
+// difference between two counts means anything.
+uint32_t port_get_cycle_count(void);
+
+// Read the tick count and the nanoseconds since it last advanced together, from the timer that
+// drives supervisor_tick. The default has no part of a tick.
+void port_get_ticks_ns(uint64_t *ms, uint32_t *ns);
+
+// Sleep the CPU until an interrupt is pending. This is called with interrupts
+// disabled, when the port supports that, and a pending interrupt must still
+// wake it up. The tick interrupt bounds the sleep to a millisecond. Ports that
+// can't sleep return straight away.
+void port_sleep_until_interrupt(void);
+
 #endif  // MICROPY_INCLUDED_SUPERVISOR_PORT_H
@@ -46,4 +46,11 @@ char serial_read(void);
 bool serial_bytes_available(void);
 bool serial_connected(void);
 
+// When blocking, serial_write waits for room if the host isn't reading fast
+// enough. Otherwise the output that doesn't fit is dropped and counted.
+// Serial implementations without an output buffer always block.
+void serial_set_write_blocking(bool blocking);
+bool serial_get_write_blocking(void);
+uint32_t serial_get_bytes_dropped(void);
+
 #endif  // MICROPY_INCLUDED_SUPERVISOR_SERIAL_H
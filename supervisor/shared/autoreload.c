@@ -26,12 +26,14 @@
 
 #include "autoreload.h"
 
+#include "extmod/vfs_fat.h"
 #include "py/mphal.h"
 #include "py/reload.h"
 
 static volatile uint32_t autoreload_delay_ms = 0;
 static bool autoreload_enabled = false;
 static bool autoreload_suspended = false;
+static bool autoreload_incremental = false;
 
 volatile bool reload_requested = false;
 
@@ -41,7 +43,14 @@ inline void autoreload_tick() {
     }
     if (autoreload_delay_ms == 1 && autoreload_enabled &&
         !autoreload_suspended && !reload_requested) {
-        mp_raise_reload_exception();
+        #if MICROPY_RELOAD_MODULES
+        if (autoreload_incremental) {
+            mp_raise_reload_modules_exception();
+        } else
+        #endif
+        {
+            mp_raise_reload_exception();
+        }
         reload_requested = true;
     }
     autoreload_delay_ms--;
@@ -56,6 +65,13 @@ void autoreload_disable() {
     autoreload_enabled = false;
 }
 
+void autoreload_set_incremental(bool incremental) {
+    autoreload_incremental = incremental;
+    #if MICROPY_RELOAD_MODULES
+    mp_reload_modules_enable(incremental);
+    #endif
+}
+
 void autoreload_suspend() {
     autoreload_suspended = true;
 }
@@ -69,6 +85,8 @@ inline bool autoreload_is_enabled() {
 }
 
 void autoreload_start() {
+    // The host changed the filesystem, which may not restart the VM.
+    fat_vfs_import_stat_cache_clear();
     autoreload_delay_ms = CIRCUITPY_AUTORELOAD_DELAY_MS;
 }
 
@@ -39,6 +39,10 @@ void autoreload_enable(void);
 void autoreload_disable(void);
 bool autoreload_is_enabled(void);
 
+// Reload only the imported modules whose files changed, and those that import them, when the
+// running code is otherwise unchanged. See mp_reload_changed_modules.
+void autoreload_set_incremental(bool incremental);
+
 // Temporarily turn it off. Used during the REPL.
 void autoreload_suspend(void);
 void autoreload_resume(void);
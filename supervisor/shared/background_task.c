@@ -0,0 +1,115 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <stddef.h>
+
+#include "supervisor/shared/background_task.h"
+#include "supervisor/shared/tick.h"
+
+#if CIRCUITPY_BACKGROUND_TRACE
+#include "supervisor/port.h"
+#include "supervisor/shared/background_trace.h"
+#endif
+
+// Registered tasks, most urgent first.
+static background_task_t *tasks;
+static volatile bool tasks_pending;
+static uint32_t pass;
+
+void background_task_add(background_task_t *task, void (*fun)(void), uint8_t priority, uint32_t period_ms) {
+    background_task_t **prev = &tasks;
+    for (background_task_t *t = tasks; t != NULL; t = t->next) {
+        if (t == task) {
+            return;
+        }
+    }
+    while (*prev != NULL && (*prev)->priority <= priority) {
+        prev = &(*prev)->next;
+    }
+    task->fun = fun;
+    task->priority = priority;
+    task->period_ms = period_ms;
+    task->deadline_ms = supervisor_ticks_ms32();
+    task->pass = pass;
+    task->pending = false;
+    task->next = *prev;
+    *prev = task;
+}
+
+void background_task_remove(background_task_t *task) {
+    for (background_task_t **prev = &tasks; *prev != NULL; prev = &(*prev)->next) {
+        if (*prev == task) {
+            *prev = task->next;
+            task->next = NULL;
+            return;
+        }
+    }
+}
+
+void background_task_set_pending(background_task_t *task) {
+    task->pending = true;
+    tasks_pending = true;
+}
+
+bool background_tasks_pending(void) {
+    return tasks_pending;
+}
+
+static bool background_task_due(background_task_t *task, uint32_t now) {
+    if (task->pass == pass) {
+        return false;
+    }
+    return task->pending ||
+           (task->period_ms != 0 && (int32_t)(now - task->deadline_ms) >= 0);
+}
+
+void background_tasks_run(void) {
+    uint32_t now = supervisor_ticks_ms32();
+    tasks_pending = false;
+    pass++;
+    background_task_t *task = tasks;
+    while (task != NULL) {
+        if (!background_task_due(task, now)) {
+            task = task->next;
+            continue;
+        }
+        task->pass = pass;
+        task->pending = false;
+        if (task->period_ms != 0) {
+            task->deadline_ms = now + task->period_ms;
+        }
+        #if CIRCUITPY_BACKGROUND_TRACE
+        uint32_t start = port_get_cycle_count();
+        task->fun();
+        background_trace_record((uintptr_t) task->fun, start);
+        #else
+        task->fun();
+        #endif
+        // Start over in case the task made work for a more urgent one.
+        task = tasks;
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef MICROPY_INCLUDED_SUPERVISOR_SHARED_BACKGROUND_TASK_H
+#define MICROPY_INCLUDED_SUPERVISOR_SHARED_BACKGROUND_TASK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Tasks run in this order when several have work. Audio refills come first so
+// they aren't kept waiting behind slower work such as a display refresh.
+enum {
+    BACKGROUND_TASK_PRIORITY_AUDIO,
+    BACKGROUND_TASK_PRIORITY_AUDIO_DECODE,
+    BACKGROUND_TASK_PRIORITY_USB,
+    BACKGROUND_TASK_PRIORITY_BLUETOOTH,
+    BACKGROUND_TASK_PRIORITY_NETWORK,
+    BACKGROUND_TASK_PRIORITY_DISPLAY,
+    BACKGROUND_TASK_PRIORITY_FILESYSTEM,
+};
+
+typedef struct _background_task_t {
+    void (*fun)(void);
+    struct _background_task_t *next;
+    uint32_t period_ms;
+    uint32_t deadline_ms;
+    uint32_t pass;
+    uint8_t priority;
+    volatile bool pending;
+} background_task_t;
+
+/** @brief Register a task with the background task dispatcher
+ *
+ * The task runs when it is marked pending, and every period_ms milliseconds
+ * if period_ms isn't 0. Adding a task that is already registered does nothing.
+ * The task struct must stay valid until it's removed.
+ */
+void background_task_add(background_task_t *task, void (*fun)(void), uint8_t priority, uint32_t period_ms);
+void background_task_remove(background_task_t *task);
+/** @brief Mark a task as having work to do
+ *
+ * This is safe to call from an interrupt. The task runs the next time
+ * background tasks are run, without waiting for the next tick.
+ */
+void background_task_set_pending(background_task_t *task);
+/** @brief Check whether a task has been marked pending since background tasks last ran */
+bool background_tasks_pending(void);
+/** @brief Run the tasks that are pending or due, most urgent first
+ *
+ * Each task runs at most once per call. After a task runs, the tasks ahead of
+ * it are checked again, so work it made for a more urgent task is done next.
+ */
+void background_tasks_run(void);
+
+#endif  // MICROPY_INCLUDED_SUPERVISOR_SHARED_BACKGROUND_TASK_H
@@ -0,0 +1,143 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "supervisor/shared/background_trace.h"
+
+#include <string.h>
+
+#include "py/mpconfig.h"
+#include "py/objtuple.h"
+#include "py/runtime.h"
+#include "shared-bindings/microcontroller/__init__.h"
+#include "supervisor/port.h"
+#include "supervisor/serial.h"
+#include "supervisor/shared/tick.h"
+#include "supervisor/shared/translate.h"
+
+typedef struct {
+    uintptr_t id;
+    uint32_t start;
+    uint32_t cycles;
+} background_trace_entry_t;
+
+// Both tables live outside the heap so that they carry on across reloads.
+static background_trace_entry_t trace[CIRCUITPY_BACKGROUND_TRACE_ENTRIES];
+static uint32_t trace_count;
+// start is unused here.
+static background_trace_entry_t worst[CIRCUITPY_BACKGROUND_TRACE_WORST_ENTRIES];
+
+static const qstr interrupt_names[BACKGROUND_TRACE_INTERRUPT_COUNT] = {
+    [BACKGROUND_TRACE_TICK] = MP_QSTR_tick,
+    [BACKGROUND_TRACE_EIC] = MP_QSTR_eic,
+    [BACKGROUND_TRACE_TIMER] = MP_QSTR_timer,
+    [BACKGROUND_TRACE_BLE] = MP_QSTR_ble,
+};
+
+// Ports without a cycle counter time in milliseconds.
+MP_WEAK uint32_t port_get_cycle_count(void) {
+    return supervisor_ticks_ms32();
+}
+
+void background_trace_record(uintptr_t id, uint32_t start) {
+    uint32_t cycles = port_get_cycle_count() - start;
+    common_hal_mcu_disable_interrupts();
+    background_trace_entry_t *entry = &trace[trace_count % CIRCUITPY_BACKGROUND_TRACE_ENTRIES];
+    trace_count++;
+    entry->id = id;
+    entry->start = start;
+    entry->cycles = cycles;
+    for (size_t i = 0; i < CIRCUITPY_BACKGROUND_TRACE_WORST_ENTRIES; i++) {
+        if (worst[i].id == 0) {
+            worst[i].id = id;
+        }
+        if (worst[i].id == id) {
+            if (cycles > worst[i].cycles) {
+                worst[i].cycles = cycles;
+            }
+            break;
+        }
+    }
+    common_hal_mcu_enable_interrupts();
+}
+
+void background_trace_reset(void) {
+    common_hal_mcu_disable_interrupts();
+    trace_count = 0;
+    memset(worst, 0, sizeof(worst));
+    common_hal_mcu_enable_interrupts();
+}
+
+STATIC mp_obj_t trace_id(uintptr_t id) {
+    if (id < BACKGROUND_TRACE_INTERRUPT_COUNT) {
+        return MP_OBJ_NEW_QSTR(interrupt_names[id]);
+    }
+    return mp_obj_new_int_from_uint(id);
+}
+
+mp_obj_t background_trace_records(void) {
+    // Take a copy first because interrupts keep adding to the ring.
+    background_trace_entry_t *entries = m_new(background_trace_entry_t, CIRCUITPY_BACKGROUND_TRACE_ENTRIES);
+    common_hal_mcu_disable_interrupts();
+    uint32_t count = trace_count;
+    memcpy(entries, trace, sizeof(trace));
+    common_hal_mcu_enable_interrupts();
+
+    size_t len = MIN(count, CIRCUITPY_BACKGROUND_TRACE_ENTRIES);
+    mp_obj_tuple_t *result = MP_OBJ_TO_PTR(mp_obj_new_tuple(len, NULL));
+    for (size_t i = 0; i < len; i++) {
+        background_trace_entry_t *entry = &entries[(count - len + i) % CIRCUITPY_BACKGROUND_TRACE_ENTRIES];
+        mp_obj_t items[3] = {
+            trace_id(entry->id),
+            mp_obj_new_int_from_uint(entry->start),
+            mp_obj_new_int_from_uint(entry->cycles),
+        };
+        result->items[i] = mp_obj_new_tuple(3, items);
+    }
+    m_del(background_trace_entry_t, entries, CIRCUITPY_BACKGROUND_TRACE_ENTRIES);
+    return MP_OBJ_FROM_PTR(result);
+}
+
+mp_obj_t background_trace_worst(void) {
+    mp_obj_t result = mp_obj_new_dict(0);
+    for (size_t i = 0; i < CIRCUITPY_BACKGROUND_TRACE_WORST_ENTRIES && worst[i].id != 0; i++) {
+        mp_obj_dict_store(result, trace_id(worst[i].id), mp_obj_new_int_from_uint(worst[i].cycles));
+    }
+    return result;
+}
+
+void background_trace_print_worst(void) {
+    if (worst[0].id == 0) {
+        return;
+    }
+    serial_write_compressed(translate("Longest background task and interrupt runs, in cycles:\n"));
+    for (size_t i = 0; i < CIRCUITPY_BACKGROUND_TRACE_WORST_ENTRIES && worst[i].id != 0; i++) {
+        if (worst[i].id < BACKGROUND_TRACE_INTERRUPT_COUNT) {
+            mp_printf(&mp_plat_print, "  %q: %u\n", interrupt_names[worst[i].id], (uint)worst[i].cycles);
+        } else {
+            mp_printf(&mp_plat_print, "  0x%08x: %u\n", (uint)worst[i].id, (uint)worst[i].cycles);
+        }
+    }
+}
@@ -0,0 +1,58 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SUPERVISOR_SHARED_BACKGROUND_TRACE_H
+#define MICROPY_INCLUDED_SUPERVISOR_SHARED_BACKGROUND_TRACE_H
+
+#include <stdint.h>
+
+#include "py/obj.h"
+
+// Records how long each background task run and interrupt took, in cycles of
+// port_get_cycle_count(), into a ring of the most recent runs. The longest run
+// of each task and interrupt is kept separately. Background tasks are
+// identified by the address of their function, interrupts by one of these.
+enum {
+    BACKGROUND_TRACE_TICK = 1,
+    BACKGROUND_TRACE_EIC,
+    BACKGROUND_TRACE_TIMER,
+    BACKGROUND_TRACE_BLE,
+    BACKGROUND_TRACE_INTERRUPT_COUNT,
+};
+
+// Record a run of id that started at cycle count start. Safe to call from an
+// interrupt.
+void background_trace_record(uintptr_t id, uint32_t start);
+void background_trace_reset(void);
+
+// Returns a tuple of (id, start, cycles) tuples, oldest first.
+mp_obj_t background_trace_records(void);
+// Returns a dict mapping each id to its longest run in cycles.
+mp_obj_t background_trace_worst(void);
+// Print the longest runs, for the safe mode message.
+void background_trace_print_worst(void);
+
+#endif  // MICROPY_INCLUDED_SUPERVISOR_SHARED_BACKGROUND_TRACE_H
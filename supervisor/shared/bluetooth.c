@@ -38,6 +38,7 @@
 #include "common-hal/_bleio/__init__.h"
 
 #include "supervisor/shared/autoreload.h"
+#include "supervisor/shared/background_task.h"
 
 #include "py/mpstate.h"
 
@@ -62,6 +63,7 @@ mp_obj_list_t service_list;
 mp_obj_t service_list_items[1];
 mp_obj_list_t characteristic_list;
 mp_obj_t characteristic_list_items[4];
+static background_task_t bluetooth_task;
 
 void supervisor_bluetooth_start_advertising(void) {
     bool is_connected = common_hal_bleio_adapter_get_connected(&common_hal_bleio_adapter_obj);
@@ -162,6 +164,9 @@ void supervisor_start_bluetooth(void) {
 
     supervisor_bluetooth_start_advertising();
     vm_used_ble = false;
+
+    // Only runs when the BLE event hook asks for it.
+    background_task_add(&bluetooth_task, supervisor_bluetooth_background, BACKGROUND_TASK_PRIORITY_BLUETOOTH, 0);
 }
 
 FIL active_file;
@@ -169,6 +174,12 @@ volatile bool new_filename;
 volatile bool run_ble_background;
 bool was_connected;
 
+// Called from the BLE event hook, so it must be quick.
+static void request_ble_background(void) {
+    run_ble_background = true;
+    background_task_set_pending(&bluetooth_task);
+}
+
 void update_file_length(void) {
     int32_t file_length = -1;
     mp_buffer_info_t bufinfo;
@@ -303,10 +314,10 @@ bool supervisor_bluetooth_hook(ble_evt_t *ble_evt) {
         case BLE_GAP_EVT_CONNECTED:
             // We run our background task even if it wasn't us connected to because we may want to
             // advertise if the user code stopped advertising.
-            run_ble_background = true;
+            request_ble_background();
             break;
         case BLE_GAP_EVT_DISCONNECTED:
-            run_ble_background = true;
+            request_ble_background();
             break;
         case BLE_GATTS_EVT_WRITE: {
             // A client wrote to a characteristic.
@@ -322,12 +333,12 @@ bool supervisor_bluetooth_hook(ble_evt_t *ble_evt) {
                 current_offset += evt_write->len;
                 current_length = ((uint16_t*) current_command)[0];
                 if (current_offset == current_length) {
-                    run_ble_background = true;
+                    request_ble_background();
                     done = true;
                 }
             } else if (evt_write->handle == supervisor_ble_filename_characteristic.handle) {
                 new_filename = true;
-                run_ble_background = true;
+                request_ble_background();
                 done = true;
             } else {
                 return done;
@@ -0,0 +1,75 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "supervisor/shared/boot_timing.h"
+
+#include "py/mpconfig.h"
+#include "py/objtuple.h"
+#include "py/runtime.h"
+#include "shared-bindings/microcontroller/__init__.h"
+#include "supervisor/shared/tick.h"
+
+// Microseconds since the port started its tick, which it does early in
+// port_init(). Time spent before that, in the bootloader and clock setup, isn't
+// counted.
+static uint32_t phase_us[BOOT_PHASE_COUNT];
+static volatile uint32_t phases_reached;
+
+static const qstr phase_names[BOOT_PHASE_COUNT] = {
+    [BOOT_PHASE_PORT_INIT] = MP_QSTR_port_init,
+    [BOOT_PHASE_FLASH_INIT] = MP_QSTR_flash_init,
+    [BOOT_PHASE_FILESYSTEM_MOUNT] = MP_QSTR_filesystem_mount,
+    [BOOT_PHASE_USB_ENUMERATED] = MP_QSTR_usb_enumerated,
+    [BOOT_PHASE_BOOT_PY] = MP_QSTR_boot_py,
+    [BOOT_PHASE_CODE_PY] = MP_QSTR_code_py,
+    [BOOT_PHASE_FIRST_FRAME] = MP_QSTR_first_frame,
+};
+
+void boot_timing_mark(boot_phase_t phase) {
+    uint32_t bit = 1 << phase;
+    if ((phases_reached & bit) != 0) {
+        return;
+    }
+    phase_us[phase] = supervisor_ticks_ns64() / 1000;
+    common_hal_mcu_disable_interrupts();
+    phases_reached |= bit;
+    common_hal_mcu_enable_interrupts();
+}
+
+mp_obj_t boot_timing_phases(void) {
+    mp_obj_tuple_t *result = MP_OBJ_TO_PTR(mp_obj_new_tuple(BOOT_PHASE_COUNT, NULL));
+    for (size_t i = 0; i < BOOT_PHASE_COUNT; i++) {
+        mp_obj_t items[2] = {
+            MP_OBJ_NEW_QSTR(phase_names[i]),
+            mp_const_none,
+        };
+        if ((phases_reached & (1 << i)) != 0) {
+            items[1] = mp_obj_new_int_from_uint(phase_us[i]);
+        }
+        result->items[i] = mp_obj_new_tuple(2, items);
+    }
+    return MP_OBJ_FROM_PTR(result);
+}
@@ -0,0 +1,53 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SUPERVISOR_SHARED_BOOT_TIMING_H
+#define MICROPY_INCLUDED_SUPERVISOR_SHARED_BOOT_TIMING_H
+
+#include "py/obj.h"
+
+// Milestones of a cold start, in the order they are usually reached. Each is
+// timestamped the first time it's reached after reset and never again, so
+// reloads don't overwrite them.
+typedef enum {
+    BOOT_PHASE_PORT_INIT,
+    BOOT_PHASE_FLASH_INIT,
+    BOOT_PHASE_FILESYSTEM_MOUNT,
+    BOOT_PHASE_USB_ENUMERATED,
+    BOOT_PHASE_BOOT_PY,
+    BOOT_PHASE_CODE_PY,
+    BOOT_PHASE_FIRST_FRAME,
+    BOOT_PHASE_COUNT,
+} boot_phase_t;
+
+// Safe to call from an interrupt.
+void boot_timing_mark(boot_phase_t phase);
+
+// Returns a tuple of (name, microseconds) tuples in phase order, with None for
+// the phases not reached yet.
+mp_obj_t boot_timing_phases(void);
+
+#endif  // MICROPY_INCLUDED_SUPERVISOR_SHARED_BOOT_TIMING_H
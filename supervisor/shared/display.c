@@ -34,6 +34,10 @@
 #include "shared-bindings/displayio/TileGrid.h"
 #include "supervisor/memory.h"
 
+#if CIRCUITPY_DISPLAYIO
+#include "shared-module/displayio/__init__.h"
+#endif
+
 extern size_t blinka_bitmap_data[];
 extern displayio_bitmap_t blinka_bitmap;
 extern displayio_group_t circuitpython_splash;
@@ -59,7 +63,7 @@ void supervisor_start_terminal(uint16_t width_px, uint16_t height_px) {
     uint16_t total_tiles = width_in_tiles * height_in_tiles;
 
     // First try to allocate outside the heap. This will fail when the VM is running.
-    tilegrid_tiles = allocate_memory(align32_size(total_tiles), false);
+    tilegrid_tiles = allocate_memory(align32_size(total_tiles), false, true);
     uint8_t* tiles;
     if (tilegrid_tiles == NULL) {
         tiles = m_malloc(total_tiles, true);
@@ -97,15 +101,28 @@ void supervisor_stop_terminal(void) {
 
 void supervisor_display_move_memory(void) {
     #if CIRCUITPY_DISPLAYIO
+    if (tilegrid_tiles != NULL) {
+        // supervisor_move_memory may have moved them.
+        supervisor_terminal_text_grid.tiles = (uint8_t*) tilegrid_tiles->ptr;
+    }
+
+    // Displays created by the VM couldn't get their refresh buffers outside of the heap.
+    for (uint8_t i = 0; i < CIRCUITPY_DISPLAY_LIMIT; i++) {
+        if (displays[i].display.base.type == &displayio_display_type) {
+            displayio_display_core_allocate_buffers(&displays[i].display.core);
+        }
+    }
+
     displayio_tilegrid_t* grid = &supervisor_terminal_text_grid;
     if (MP_STATE_VM(terminal_tilegrid_tiles) == NULL || grid->tiles != MP_STATE_VM(terminal_tilegrid_tiles)) {
         return;
     }
     uint16_t total_tiles = grid->width_in_tiles * grid->height_in_tiles;
 
-    tilegrid_tiles = allocate_memory(align32_size(total_tiles), false);
+    tilegrid_tiles = allocate_memory(align32_size(total_tiles), false, true);
     if (tilegrid_tiles != NULL) {
-        memcpy(tilegrid_tiles->ptr, grid->tiles, total_tiles);
+        // The tiles were in the old heap, which the new allocation may overlap.
+        memmove(tilegrid_tiles->ptr, grid->tiles, total_tiles);
         grid->tiles = (uint8_t*) tilegrid_tiles->ptr;
     } else {
         grid->tiles = NULL;
@@ -198,9 +215,12 @@ _displayio_color_t blinka_colors[7] = {
     },
 };
 
+uint32_t blinka_cached_colors[7];
+
 displayio_palette_t blinka_palette = {
     .base = {.type = &displayio_palette_type },
     .colors = blinka_colors,
+    .cached_colors = blinka_cached_colors,
     .color_count = 7,
     .needs_refresh = false
 };
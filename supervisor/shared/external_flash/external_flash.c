@@ -34,15 +34,21 @@
 #include "extmod/vfs_fat.h"
 #include "py/misc.h"
 #include "py/obj.h"
+#include "py/gc.h"
 #include "py/runtime.h"
 #include "lib/oofatfs/ff.h"
 #include "shared-bindings/microcontroller/__init__.h"
+#include "supervisor/flash.h"
 #include "supervisor/memory.h"
 #include "supervisor/shared/rgb_led_status.h"
 
 #define NO_SECTOR_LOADED 0xFFFFFFFF
 
-// The currently cached sector in the cache, ram or flash based.
+#define PAGES_PER_BLOCK (FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE)
+#define PAGES_PER_SECTOR (SPI_FLASH_ERASE_SIZE / SPI_FLASH_PAGE_SIZE)
+
+// The sector cached in the scratch sector at the end of the flash. Only used
+// when there is no ram cache.
 static uint32_t current_sector;
 
 const external_flash_device possible_devices[EXTERNAL_FLASH_DEVICE_COUNT] = {EXTERNAL_FLASH_DEVICES};
@@ -55,6 +61,29 @@ static uint32_t dirty_mask;
 
 static supervisor_allocation* supervisor_cache = NULL;
 
+// Whether the flash can be read directly as memory. If so, we wait for writes
+// and erases to finish before returning so that it always reads correctly.
+static bool flash_mapped;
+
+// Sectors cached in ram, up to CIRCUITPY_FLASH_CACHE_SECTORS of them. The
+// pages of slot i start at MP_STATE_VM(flash_ram_cache)[i * PAGES_PER_SECTOR].
+static uint8_t cache_slot_count;
+static uint32_t cache_sector[CIRCUITPY_FLASH_CACHE_SECTORS];
+// One bit per page that differs from what's on the flash.
+static uint32_t cache_dirty[CIRCUITPY_FLASH_CACHE_SECTORS];
+// When each slot was last written to, so we write back the oldest first.
+static uint32_t cache_last_use[CIRCUITPY_FLASH_CACHE_SECTORS];
+static uint32_t cache_use_count;
+
+#if CIRCUITPY_FLASH_READ_AHEAD_BLOCKS > 0
+// Blocks read ahead of a sequential reader, such as a host copying files off
+// the drive a block at a time. Any write drops them.
+static uint8_t read_ahead[CIRCUITPY_FLASH_READ_AHEAD_BLOCKS * FILESYSTEM_BLOCK_SIZE];
+static uint32_t read_ahead_start;
+static uint32_t read_ahead_count;
+static uint32_t next_sequential_block;
+#endif
+
 // Wait until both the write enable and write in progress bits have cleared.
 static bool wait_for_flash_ready(void) {
     uint8_t read_status_response[1] = {0x00};
@@ -135,7 +164,7 @@ static bool page_erased(uint32_t sector_address) {
     uint8_t full_buffer[FILESYSTEM_BLOCK_SIZE];
     if (read_flash(sector_address, full_buffer, FILESYSTEM_BLOCK_SIZE)) {
         for (uint16_t i = 0; i < FILESYSTEM_BLOCK_SIZE; i++) {
-            if (short_buffer[i] != 0xff) {
+            if (full_buffer[i] != 0xff) {
                 return false;
             }
         }
@@ -252,8 +281,10 @@ void supervisor_flash_init(void) {
 
     wait_for_flash_ready();
 
+    flash_mapped = spi_flash_get_mapped_address(0) != NULL;
     current_sector = NO_SECTOR_LOADED;
     dirty_mask = 0;
+    cache_slot_count = 0;
     MP_STATE_VM(flash_ram_cache) = NULL;
 }
 
@@ -301,154 +332,271 @@ static bool flush_scratch_flash(void) {
     return true;
 }
 
-// Attempts to allocate a new set of page buffers for caching a full sector in
-// ram. Each page is allocated separately so that the GC doesn't need to provide
-// one huge block. We can free it as we write if we want to also.
-static bool allocate_ram_cache(void) {
-    uint8_t blocks_per_sector = SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE;
-    uint8_t pages_per_block = FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE;
-
-    uint32_t table_size = blocks_per_sector * pages_per_block * sizeof(uint32_t);
-    // Attempt to allocate outside the heap first.
-    supervisor_cache = allocate_memory(table_size + SPI_FLASH_ERASE_SIZE, false);
-    if (supervisor_cache != NULL) {
-        MP_STATE_VM(flash_ram_cache) = (uint8_t **) supervisor_cache->ptr;
-        uint8_t* page_start = (uint8_t *) supervisor_cache->ptr + table_size;
+static void use_cache_slots(uint8_t count) {
+    cache_slot_count = count;
+    for (uint8_t i = 0; i < count; i++) {
+        cache_sector[i] = NO_SECTOR_LOADED;
+        cache_dirty[i] = 0;
+        cache_last_use[i] = 0;
+    }
+    cache_use_count = 0;
+}
 
-        for (uint8_t i = 0; i < blocks_per_sector; i++) {
-            for (uint8_t j = 0; j < pages_per_block; j++) {
-                uint32_t offset = i * pages_per_block + j;
-                MP_STATE_VM(flash_ram_cache)[offset] = page_start + offset * SPI_FLASH_PAGE_SIZE;
+// Attempts to allocate page buffers for caching as many sectors as we can
+// spare, up to CIRCUITPY_FLASH_CACHE_SECTORS.
+static bool allocate_ram_cache(void) {
+    // Attempt to allocate outside the heap first, backing off until it fits.
+    // The page table points into the allocation so it can't move.
+    for (uint8_t count = CIRCUITPY_FLASH_CACHE_SECTORS; count > 0; count--) {
+        uint32_t table_size = count * PAGES_PER_SECTOR * sizeof(uint8_t*);
+        supervisor_cache = allocate_memory(table_size + count * SPI_FLASH_ERASE_SIZE, false, false);
+        if (supervisor_cache != NULL) {
+            MP_STATE_VM(flash_ram_cache) = (uint8_t **) supervisor_cache->ptr;
+            uint8_t* page_start = (uint8_t *) supervisor_cache->ptr + table_size;
+            for (uint32_t i = 0; i < count * PAGES_PER_SECTOR; i++) {
+                MP_STATE_VM(flash_ram_cache)[i] = page_start + i * SPI_FLASH_PAGE_SIZE;
             }
+            use_cache_slots(count);
+            return true;
         }
-        return true;
     }
 
     if (MP_STATE_MEM(gc_pool_start) == 0) {
         return false;
     }
 
-    MP_STATE_VM(flash_ram_cache) = m_malloc_maybe(blocks_per_sector * pages_per_block * sizeof(uint32_t), false);
-    if (MP_STATE_VM(flash_ram_cache) == NULL) {
+    // Don't take more than a quarter of the free heap, but always try for one
+    // sector.
+    gc_info_t info;
+    gc_info(&info);
+    uint32_t count = info.free / 4 / SPI_FLASH_ERASE_SIZE;
+    if (count < 1) {
+        count = 1;
+    } else if (count > CIRCUITPY_FLASH_CACHE_SECTORS) {
+        count = CIRCUITPY_FLASH_CACHE_SECTORS;
+    }
+    uint8_t** table = m_malloc_maybe(count * PAGES_PER_SECTOR * sizeof(uint8_t*), false);
+    if (table == NULL) {
         return false;
     }
-    // Declare i and j outside the loops in case we fail to allocate everything
-    // we need. In that case we'll give it back.
-    uint8_t i = 0;
-    uint8_t j = 0;
-    bool success = true;
-    for (i = 0; i < blocks_per_sector; i++) {
-        for (j = 0; j < pages_per_block; j++) {
+    MP_STATE_VM(flash_ram_cache) = table;
+    // Each page is allocated separately so that the GC doesn't need to provide
+    // one huge block. If we run out part way through a sector we give it back
+    // and make do with the sectors we have.
+    uint8_t sectors = 0;
+    for (; sectors < count; sectors++) {
+        uint8_t i = 0;
+        for (; i < PAGES_PER_SECTOR; i++) {
             uint8_t *page_cache = m_malloc_maybe(SPI_FLASH_PAGE_SIZE, false);
             if (page_cache == NULL) {
-                success = false;
                 break;
             }
-            MP_STATE_VM(flash_ram_cache)[i * pages_per_block + j] = page_cache;
+            table[sectors * PAGES_PER_SECTOR + i] = page_cache;
         }
-        if (!success) {
+        if (i < PAGES_PER_SECTOR) {
+            for (; i > 0; i--) {
+                m_free(table[sectors * PAGES_PER_SECTOR + i - 1]);
+            }
             break;
         }
     }
-    // We couldn't allocate enough so give back what we got.
-    if (!success) {
-        // We add 1 so that we delete 0 when i is 1. Going to zero (i >= 0)
-        // would never stop because i is unsigned.
-        i++;
-        for (; i > 0; i--) {
-            for (; j > 0; j--) {
-                m_free(MP_STATE_VM(flash_ram_cache)[(i - 1) * pages_per_block + (j - 1)]);
-            }
-            j = pages_per_block;
-        }
-        m_free(MP_STATE_VM(flash_ram_cache));
+    if (sectors == 0) {
+        m_free(table);
         MP_STATE_VM(flash_ram_cache) = NULL;
+        return false;
     }
-    return success;
+    use_cache_slots(sectors);
+    return true;
 }
 
 static void release_ram_cache(void) {
     if (supervisor_cache != NULL) {
         free_memory(supervisor_cache);
         supervisor_cache = NULL;
-    } else if (MP_STATE_MEM(gc_pool_start)) {
+    } else if (MP_STATE_VM(flash_ram_cache) != NULL && MP_STATE_MEM(gc_pool_start)) {
+        for (uint32_t i = 0; i < cache_slot_count * PAGES_PER_SECTOR; i++) {
+            m_free(MP_STATE_VM(flash_ram_cache)[i]);
+        }
         m_free(MP_STATE_VM(flash_ram_cache));
     }
     MP_STATE_VM(flash_ram_cache) = NULL;
+    cache_slot_count = 0;
 }
 
-// Flush the cached sector from ram onto the flash. We'll free the cache unless
-// keep_cache is true.
-static bool flush_ram_cache(bool keep_cache) {
-    if (current_sector == NO_SECTOR_LOADED) {
-        if (!keep_cache) {
-            release_ram_cache();
+static int8_t find_cache_slot(uint32_t sector) {
+    for (uint8_t i = 0; i < cache_slot_count; i++) {
+        if (cache_sector[i] == sector) {
+            return i;
         }
+    }
+    return -1;
+}
+
+// Whether a write to the block at address is waiting in a cache rather than
+// on the flash.
+static bool block_write_cached(uint32_t address) {
+    uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
+    uint8_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE);
+    int8_t slot = find_cache_slot(this_sector);
+    if (slot >= 0) {
+        uint32_t block_pages = ((1 << PAGES_PER_BLOCK) - 1) << (block_index * PAGES_PER_BLOCK);
+        return (cache_dirty[slot] & block_pages) != 0;
+    }
+    return current_sector == this_sector && (dirty_mask & (1 << block_index)) != 0;
+}
+
+static bool cache_is_dirty(void) {
+    if (current_sector != NO_SECTOR_LOADED) {
         return true;
     }
-    // First, copy out any blocks that we haven't touched from the sector
-    // we've cached. If we don't do this we'll erase the data during the sector
-    // erase below.
-    bool copy_to_ram_ok = true;
-    uint8_t pages_per_block = FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE;
-    for (uint8_t i = 0; i < SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE; i++) {
-        if ((dirty_mask & (1 << i)) == 0) {
-            for (uint8_t j = 0; j < pages_per_block; j++) {
-                copy_to_ram_ok = read_flash(
-                    current_sector + (i * pages_per_block + j) * SPI_FLASH_PAGE_SIZE,
-                    MP_STATE_VM(flash_ram_cache)[i * pages_per_block + j],
-                    SPI_FLASH_PAGE_SIZE);
-                if (!copy_to_ram_ok) {
-                    break;
-                }
+    for (uint8_t i = 0; i < cache_slot_count; i++) {
+        if (cache_dirty[i] != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void show_write_activity(bool active) {
+    #ifdef MICROPY_HW_LED_MSC
+        port_pin_set_output_level(MICROPY_HW_LED_MSC, active);
+    #endif
+    if (active) {
+        temp_status_color(ACTIVE_WRITE);
+    } else {
+        clear_temp_status();
+    }
+}
+
+// Write one cached sector from ram back onto the flash. The sector stays in
+// the cache, now clean.
+static bool flush_ram_slot(uint8_t slot) {
+    if (cache_dirty[slot] == 0) {
+        return true;
+    }
+    uint32_t sector = cache_sector[slot];
+    uint8_t** pages = MP_STATE_VM(flash_ram_cache) + slot * PAGES_PER_SECTOR;
+    // First, copy out any pages that we haven't changed from the sector. If
+    // we don't do this we'll erase the data during the sector erase below.
+    for (uint8_t i = 0; i < PAGES_PER_SECTOR; i++) {
+        if ((cache_dirty[slot] & (1 << i)) == 0 &&
+            !read_flash(sector + i * SPI_FLASH_PAGE_SIZE, pages[i], SPI_FLASH_PAGE_SIZE)) {
+            return false;
+        }
+    }
+    // Second, erase the sector.
+    erase_sector(sector);
+    // Lastly, write all the data back.
+    for (uint8_t i = 0; i < PAGES_PER_SECTOR; i++) {
+        write_flash(sector + i * SPI_FLASH_PAGE_SIZE, pages[i], SPI_FLASH_PAGE_SIZE);
+    }
+    cache_dirty[slot] = 0;
+    return true;
+}
+
+// Flush every dirty sector in ram onto the flash, lowest address first.
+static bool flush_ram_cache(void) {
+    bool ok = true;
+    uint32_t flushed = 0;
+    while (true) {
+        int8_t next = -1;
+        for (uint8_t i = 0; i < cache_slot_count; i++) {
+            if (cache_dirty[i] != 0 && (flushed & (1 << i)) == 0 &&
+                (next < 0 || cache_sector[i] < cache_sector[next])) {
+                next = i;
             }
         }
-        if (!copy_to_ram_ok) {
+        if (next < 0) {
             break;
         }
+        flushed |= 1 << next;
+        ok = flush_ram_slot(next) && ok;
     }
+    return ok;
+}
 
-    if (!copy_to_ram_ok) {
-        return false;
+// Pick a slot for sector, writing back the least recently written sector if
+// they are all in use.
+static int8_t take_cache_slot(uint32_t sector) {
+    uint8_t slot = 0;
+    for (uint8_t i = 0; i < cache_slot_count; i++) {
+        if (cache_sector[i] == NO_SECTOR_LOADED) {
+            slot = i;
+            break;
+        }
+        if (cache_last_use[i] < cache_last_use[slot]) {
+            slot = i;
+        }
     }
-    // Second, erase the current sector.
-    erase_sector(current_sector);
-    // Lastly, write all the data in ram that we've cached.
-    for (uint8_t i = 0; i < SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE; i++) {
-        for (uint8_t j = 0; j < pages_per_block; j++) {
-            write_flash(current_sector + (i * pages_per_block + j) * SPI_FLASH_PAGE_SIZE,
-                        MP_STATE_VM(flash_ram_cache)[i * pages_per_block + j],
-                        SPI_FLASH_PAGE_SIZE);
-            if (!keep_cache && supervisor_cache == NULL && MP_STATE_MEM(gc_pool_start)) {
-                m_free(MP_STATE_VM(flash_ram_cache)[i * pages_per_block + j]);
-            }
+    if (cache_dirty[slot] != 0) {
+        show_write_activity(true);
+        bool ok = flush_ram_slot(slot);
+        show_write_activity(false);
+        if (!ok) {
+            return -1;
         }
     }
-    // We're done with the cache for now so give it back.
-    if (!keep_cache) {
-        release_ram_cache();
+    cache_sector[slot] = sector;
+    cache_dirty[slot] = 0;
+    return slot;
+}
+
+// Copy a block into the ram cache. Only pages that differ from the flash are
+// marked dirty so rewriting the same data, which FAT does often, doesn't cost
+// an erase.
+static bool write_ram_cache(const uint8_t *data, uint32_t sector, uint8_t block_index) {
+    uint8_t first_page = block_index * PAGES_PER_BLOCK;
+    uint32_t changed = 0;
+    uint8_t buffer[SPI_FLASH_PAGE_SIZE];
+    for (uint8_t i = 0; i < PAGES_PER_BLOCK; i++) {
+        if (!read_flash(sector + (first_page + i) * SPI_FLASH_PAGE_SIZE, buffer, SPI_FLASH_PAGE_SIZE)) {
+            return false;
+        }
+        if (memcmp(buffer, data + i * SPI_FLASH_PAGE_SIZE, SPI_FLASH_PAGE_SIZE) != 0) {
+            changed |= 1 << (first_page + i);
+        }
+    }
+    int8_t slot = find_cache_slot(sector);
+    if (slot < 0) {
+        if (changed == 0) {
+            return true;
+        }
+        slot = take_cache_slot(sector);
+        if (slot < 0) {
+            return false;
+        }
     }
+    for (uint8_t i = 0; i < PAGES_PER_BLOCK; i++) {
+        memcpy(MP_STATE_VM(flash_ram_cache)[slot * PAGES_PER_SECTOR + first_page + i],
+               data + i * SPI_FLASH_PAGE_SIZE,
+               SPI_FLASH_PAGE_SIZE);
+    }
+    uint32_t block_pages = ((1 << PAGES_PER_BLOCK) - 1) << first_page;
+    cache_dirty[slot] = (cache_dirty[slot] & ~block_pages) | changed;
+    cache_last_use[slot] = ++cache_use_count;
     return true;
 }
 
 // Delegates to the correct flash flush method depending on the existing cache.
-// TODO Don't blink the status indicator if we don't actually do any writing (hard to tell right now).
 static void spi_flash_flush_keep_cache(bool keep_cache) {
-    #ifdef MICROPY_HW_LED_MSC
-        port_pin_set_output_level(MICROPY_HW_LED_MSC, true);
-    #endif
-    temp_status_color(ACTIVE_WRITE);
-    // If we've cached to the flash itself flush from there.
-    if (MP_STATE_VM(flash_ram_cache) == NULL) {
-        flush_scratch_flash();
-    } else {
-        flush_ram_cache(keep_cache);
+    if (cache_is_dirty()) {
+        show_write_activity(true);
+        // If we've cached to the flash itself flush from there.
+        if (cache_slot_count == 0) {
+            flush_scratch_flash();
+        } else {
+            flush_ram_cache();
+        }
+        current_sector = NO_SECTOR_LOADED;
+        if (flash_mapped) {
+            wait_for_flash_ready();
+        }
+        show_write_activity(false);
+    }
+    // We're done with the cache for now so give it back.
+    if (!keep_cache) {
+        release_ram_cache();
     }
-    current_sector = NO_SECTOR_LOADED;
-    clear_temp_status();
-    #ifdef MICROPY_HW_LED_MSC
-        port_pin_set_output_level(MICROPY_HW_LED_MSC, false);
-    #endif
 }
 
 void supervisor_flash_flush(void) {
@@ -479,20 +627,27 @@ bool external_flash_read_block(uint8_t *dest, uint32_t block) {
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
     uint8_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE);
     uint8_t mask = 1 << (block_index);
-    // We're reading from the currently cached sector.
-    if (current_sector == this_sector && (mask & dirty_mask) > 0) {
-        if (MP_STATE_VM(flash_ram_cache) != NULL) {
-            uint8_t pages_per_block = FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE;
-            for (int i = 0; i < pages_per_block; i++) {
+    // We're reading from a sector cached in ram. Pages that haven't changed
+    // come from the flash.
+    int8_t slot = find_cache_slot(this_sector);
+    if (slot >= 0) {
+        for (uint8_t i = 0; i < PAGES_PER_BLOCK; i++) {
+            uint8_t page = block_index * PAGES_PER_BLOCK + i;
+            if ((cache_dirty[slot] & (1 << page)) != 0) {
                 memcpy(dest + i * SPI_FLASH_PAGE_SIZE,
-                       MP_STATE_VM(flash_ram_cache)[block_index * pages_per_block + i],
+                       MP_STATE_VM(flash_ram_cache)[slot * PAGES_PER_SECTOR + page],
                        SPI_FLASH_PAGE_SIZE);
+            } else if (!read_flash(this_sector + page * SPI_FLASH_PAGE_SIZE,
+                                   dest + i * SPI_FLASH_PAGE_SIZE, SPI_FLASH_PAGE_SIZE)) {
+                return false;
             }
-            return true;
-        } else {
-            uint32_t scratch_address = flash_device->total_size - SPI_FLASH_ERASE_SIZE + block_index * FILESYSTEM_BLOCK_SIZE;
-            return read_flash(scratch_address, dest, FILESYSTEM_BLOCK_SIZE);
         }
+        return true;
+    }
+    // We're reading from the sector cached in the scratch sector.
+    if (current_sector == this_sector && (mask & dirty_mask) > 0) {
+        uint32_t scratch_address = flash_device->total_size - SPI_FLASH_ERASE_SIZE + block_index * FILESYSTEM_BLOCK_SIZE;
+        return read_flash(scratch_address, dest, FILESYSTEM_BLOCK_SIZE);
     }
     return read_flash(address, dest, FILESYSTEM_BLOCK_SIZE);
 }
@@ -504,60 +659,126 @@ bool external_flash_write_block(const uint8_t *data, uint32_t block) {
         // bad block number
         return false;
     }
+    #if CIRCUITPY_FLASH_READ_AHEAD_BLOCKS > 0
+    read_ahead_count = 0;
+    #endif
     // Wait for any previous writes to finish.
     wait_for_flash_ready();
     // Mask out the lower bits that designate the address within the sector.
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
     uint8_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE);
     uint8_t mask = 1 << (block_index);
-    // Flush the cache if we're moving onto a sector or we're writing the
-    // same block again.
-    if (current_sector != this_sector || (mask & dirty_mask) > 0) {
-        // Check to see if we'd write to an erased page. In that case we
-        // can write directly.
-        if (page_erased(address)) {
-            return write_flash(address, data, FILESYSTEM_BLOCK_SIZE);
-        }
+    // A block with nothing waiting in a cache can be written directly if it's
+    // erased on the flash.
+    bool waiting = block_write_cached(address);
+    if (!waiting && page_erased(address)) {
+        return write_flash(address, data, FILESYSTEM_BLOCK_SIZE);
+    }
+    // Without a ram cache, flush the scratch sector if we're moving onto a
+    // new sector or we're writing the same block again.
+    if (cache_slot_count == 0 && (current_sector != this_sector || waiting)) {
         if (current_sector != NO_SECTOR_LOADED) {
             supervisor_flash_flush();
         }
-        if (MP_STATE_VM(flash_ram_cache) == NULL && !allocate_ram_cache()) {
+        if (!allocate_ram_cache()) {
             erase_sector(flash_device->total_size - SPI_FLASH_ERASE_SIZE);
             wait_for_flash_ready();
+            current_sector = this_sector;
+            dirty_mask = 0;
         }
-        current_sector = this_sector;
-        dirty_mask = 0;
+    }
+    if (cache_slot_count > 0) {
+        return write_ram_cache(data, this_sector, block_index);
     }
     dirty_mask |= mask;
-    // Copy the block to the appropriate cache.
-    if (MP_STATE_VM(flash_ram_cache) != NULL) {
-        uint8_t pages_per_block = FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE;
-        for (int i = 0; i < pages_per_block; i++) {
-            memcpy(MP_STATE_VM(flash_ram_cache)[block_index * pages_per_block + i],
-                   data + i * SPI_FLASH_PAGE_SIZE,
-                   SPI_FLASH_PAGE_SIZE);
+    uint32_t scratch_address = flash_device->total_size - SPI_FLASH_ERASE_SIZE + block_index * FILESYSTEM_BLOCK_SIZE;
+    return write_flash(scratch_address, data, FILESYSTEM_BLOCK_SIZE);
+}
+
+// Read blocks with as few flash reads as possible. Runs of blocks without
+// cached writes are read in one burst.
+static bool read_blocks(uint8_t *dest, uint32_t block_num, uint32_t num_blocks) {
+    if (block_num + num_blocks > supervisor_flash_get_block_count()) {
+        return false;
+    }
+    while (num_blocks > 0) {
+        uint32_t address = block_num * FILESYSTEM_BLOCK_SIZE;
+        uint32_t run = 1;
+        if (block_write_cached(address)) {
+            if (!external_flash_read_block(dest, block_num)) {
+                return false;
+            }
+        } else {
+            while (run < num_blocks && !block_write_cached(address + run * FILESYSTEM_BLOCK_SIZE)) {
+                run++;
+            }
+            if (!read_flash(address, dest, run * FILESYSTEM_BLOCK_SIZE)) {
+                return false;
+            }
         }
-        return true;
-    } else {
-        uint32_t scratch_address = flash_device->total_size - SPI_FLASH_ERASE_SIZE + block_index * FILESYSTEM_BLOCK_SIZE;
-        return write_flash(scratch_address, data, FILESYSTEM_BLOCK_SIZE);
+        dest += run * FILESYSTEM_BLOCK_SIZE;
+        block_num += run;
+        num_blocks -= run;
     }
+    return true;
 }
 
 mp_uint_t supervisor_flash_read_blocks(uint8_t *dest, uint32_t block_num, uint32_t num_blocks) {
-    for (size_t i = 0; i < num_blocks; i++) {
-        if (!external_flash_read_block(dest + i * FILESYSTEM_BLOCK_SIZE, block_num + i)) {
-            return 1; // error
+    #if CIRCUITPY_FLASH_READ_AHEAD_BLOCKS > 0
+    while (num_blocks > 0 && block_num >= read_ahead_start &&
+           block_num < read_ahead_start + read_ahead_count) {
+        memcpy(dest, read_ahead + (block_num - read_ahead_start) * FILESYSTEM_BLOCK_SIZE,
+               FILESYSTEM_BLOCK_SIZE);
+        dest += FILESYSTEM_BLOCK_SIZE;
+        block_num++;
+        num_blocks--;
+    }
+    bool sequential = block_num == next_sequential_block;
+    next_sequential_block = block_num + num_blocks;
+    if (num_blocks == 0) {
+        return 0; // success
+    }
+    // A second read in a row that follows on from the last one fetches
+    // more than was asked for in one burst.
+    if (sequential && num_blocks < CIRCUITPY_FLASH_READ_AHEAD_BLOCKS) {
+        uint32_t count = supervisor_flash_get_block_count() - block_num;
+        if (count > CIRCUITPY_FLASH_READ_AHEAD_BLOCKS) {
+            count = CIRCUITPY_FLASH_READ_AHEAD_BLOCKS;
+        }
+        read_ahead_count = 0;
+        if (count >= num_blocks && read_blocks(read_ahead, block_num, count)) {
+            read_ahead_start = block_num;
+            read_ahead_count = count;
+            memcpy(dest, read_ahead, num_blocks * FILESYSTEM_BLOCK_SIZE);
+            return 0; // success
         }
     }
+    #endif
+    if (!read_blocks(dest, block_num, num_blocks)) {
+        return 1; // error
+    }
     return 0; // success
 }
 
 mp_uint_t supervisor_flash_write_blocks(const uint8_t *src, uint32_t block_num, uint32_t num_blocks) {
+    mp_uint_t result = 0; // success
     for (size_t i = 0; i < num_blocks; i++) {
         if (!external_flash_write_block(src + i * FILESYSTEM_BLOCK_SIZE, block_num + i)) {
-            return 1; // error
+            result = 1; // error
+            break;
         }
     }
-    return 0; // success
+    if (flash_mapped) {
+        wait_for_flash_ready();
+    }
+    return result;
+}
+
+// Blocks are only mapped once everything written to them is on the flash.
+const uint8_t *supervisor_flash_get_mapped_block(uint32_t block) {
+    int32_t address = convert_block_to_flash_addr(block);
+    if (address == -1 || !flash_mapped || block_write_cached(address)) {
+        return NULL;
+    }
+    return spi_flash_get_mapped_address(address);
 }
@@ -41,6 +41,21 @@
 #define SPI_FLASH_SYSTICK_MASK    (0x1ff) // 512ms
 #define SPI_FLASH_IDLE_TICK(tick) (((tick) & SPI_FLASH_SYSTICK_MASK) == 2)
 
+// Most erase sectors cached in ram at once. Fewer are used when memory is
+// short. At most 32.
+#ifndef CIRCUITPY_FLASH_CACHE_SECTORS
+#define CIRCUITPY_FLASH_CACHE_SECTORS (4)
+#endif
+
+// Blocks read ahead of sequential reads, in one burst. 0 turns it off.
+#ifndef CIRCUITPY_FLASH_READ_AHEAD_BLOCKS
+#if CIRCUITPY_FULL_BUILD
+#define CIRCUITPY_FLASH_READ_AHEAD_BLOCKS (8)
+#else
+#define CIRCUITPY_FLASH_READ_AHEAD_BLOCKS (0)
+#endif
+#endif
+
 #ifndef SPI_FLASH_MAX_BAUDRATE
 #define SPI_FLASH_MAX_BAUDRATE 8000000
 #endif
@@ -131,6 +131,11 @@ bool spi_flash_read_data(uint32_t address, uint8_t* data, uint32_t data_length)
     return status;
 }
 
+// Plain SPI flash can't be memory mapped.
+const uint8_t* spi_flash_get_mapped_address(uint32_t address) {
+    return NULL;
+}
+
 void spi_flash_init(void) {
     cs_pin.base.type = &digitalio_digitalinout_type;
     common_hal_digitalio_digitalinout_construct(&cs_pin, SPI_FLASH_CS_PIN);
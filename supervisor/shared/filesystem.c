@@ -33,35 +33,77 @@
 #include "py/mpstate.h"
 
 #include "supervisor/flash.h"
+#include "supervisor/shared/background_task.h"
+#if CIRCUITPY_BOOT_TIMING
+#include "supervisor/shared/boot_timing.h"
+#endif
+#include "supervisor/usb.h"
 
 static mp_vfs_mount_t _mp_vfs;
 static fs_user_mount_t _internal_vfs;
 
-static volatile uint32_t filesystem_flush_interval_ms = CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS;
+// Writes are flushed once they stop arriving for CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS
+// or once the oldest of them is CIRCUITPY_FILESYSTEM_FLUSH_MAX_AGE_MS old. A steady
+// trickle of writes, like a data logger, then doesn't rewrite the same partly
+// filled sector every interval. Running out of room in the flash cache writes
+// sectors back on its own.
+static volatile bool filesystem_dirty = false;
+static volatile uint32_t filesystem_idle_ms;
+static volatile uint32_t filesystem_dirty_ms;
 volatile bool filesystem_flush_requested = false;
+static background_task_t filesystem_task;
+
+// Flushes done, and flushes a fixed interval timer would have done on top of them.
+static uint32_t filesystem_flushes;
+static uint32_t filesystem_flushes_saved;
+
+static void filesystem_flushed(void) {
+    if (filesystem_dirty) {
+        uint32_t intervals = filesystem_dirty_ms / CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS;
+        if (intervals > 1) {
+            filesystem_flushes_saved += intervals - 1;
+        }
+        filesystem_flushes++;
+    }
+    filesystem_dirty = false;
+    filesystem_idle_ms = 0;
+    filesystem_dirty_ms = 0;
+}
 
 void filesystem_background(void) {
     if (filesystem_flush_requested) {
-        filesystem_flush_interval_ms = CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS;
+        filesystem_flushed();
         // Flush but keep caches
+        usb_lock();
         supervisor_flash_flush();
+        usb_unlock();
         filesystem_flush_requested = false;
     }
 }
 
+void filesystem_written(void) {
+    filesystem_idle_ms = 0;
+    filesystem_dirty = true;
+}
+
 inline void filesystem_tick(void) {
-    if (filesystem_flush_interval_ms == 0) {
-        // 0 means not turned on.
+    if (!filesystem_dirty || filesystem_flush_requested) {
         return;
     }
-    if (filesystem_flush_interval_ms == 1) {
+    filesystem_idle_ms++;
+    filesystem_dirty_ms++;
+    if (filesystem_idle_ms >= CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS ||
+        filesystem_dirty_ms >= CIRCUITPY_FILESYSTEM_FLUSH_MAX_AGE_MS) {
         filesystem_flush_requested = true;
-        filesystem_flush_interval_ms = CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS;
-    } else {
-        filesystem_flush_interval_ms--;
+        background_task_set_pending(&filesystem_task);
     }
 }
 
+void filesystem_get_flush_statistics(uint32_t *flushes, uint32_t *flushes_saved) {
+    *flushes = filesystem_flushes;
+    *flushes_saved = filesystem_flushes_saved;
+}
+
 
 static void make_empty_file(FATFS *fatfs, const char *path) {
     FIL fp;
@@ -88,6 +130,8 @@ void filesystem_init(bool create_allowed, bool force_create) {
     // init the vfs object
     fs_user_mount_t *vfs_fat = &_internal_vfs;
     vfs_fat->flags = 0;
+    // Flushes are only requested from filesystem_tick().
+    background_task_add(&filesystem_task, filesystem_background, BACKGROUND_TASK_PRIORITY_FILESYSTEM, 0);
     supervisor_flash_init_vfs(vfs_fat);
 
     // try to mount the flash
@@ -128,6 +172,9 @@ void filesystem_init(bool create_allowed, bool force_create) {
     vfs->obj = MP_OBJ_FROM_PTR(vfs_fat);
     vfs->next = NULL;
     MP_STATE_VM(vfs_mount_table) = vfs;
+    #if CIRCUITPY_BOOT_TIMING
+    boot_timing_mark(BOOT_PHASE_FILESYSTEM_MOUNT);
+    #endif
 
     // The current directory is used as the boot up directory.
     // It is set to the internal flash filesystem by default.
@@ -135,11 +182,12 @@ void filesystem_init(bool create_allowed, bool force_create) {
 }
 
 void filesystem_flush(void) {
-    // Reset interval before next flush.
-    filesystem_flush_interval_ms = CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS;
+    filesystem_flushed();
+    usb_lock();
     supervisor_flash_flush();
     // Don't keep caches because this is called when starting or stopping the VM.
     supervisor_flash_release_cache();
+    usb_unlock();
 }
 
 void filesystem_set_internal_writable_by_usb(bool writable) {
@@ -28,6 +28,12 @@
 #include "extmod/vfs_fat.h"
 #include "py/runtime.h"
 #include "lib/oofatfs/ff.h"
+#include "py/persistentcode.h"
+#include "supervisor/filesystem.h"
+#include "supervisor/shared/autoreload.h"
+#if CIRCUITPY_BOOT_TIMING
+#include "supervisor/shared/boot_timing.h"
+#endif
 
 #define VFS_INDEX 0
 
@@ -87,9 +93,6 @@ static void build_partition(uint8_t *buf, int boot, int type, uint32_t start_blo
 
 mp_uint_t flash_read_blocks(uint8_t *dest, uint32_t block_num, uint32_t num_blocks) {
     if (block_num == 0) {
-        if (block_num > 1) {
-            return 1; // error
-        }
         // fake the MBR so we can decide on our own partition table
 
         for (int i = 0; i < 446; i++) {
@@ -104,8 +107,11 @@ mp_uint_t flash_read_blocks(uint8_t *dest, uint32_t block_num, uint32_t num_bloc
         dest[510] = 0x55;
         dest[511] = 0xaa;
 
-        return 0; // ok
-
+        if (num_blocks == 1) {
+            return 0; // ok
+        }
+        // The rest of a burst that starts with the MBR.
+        return supervisor_flash_read_blocks(dest + FILESYSTEM_BLOCK_SIZE, 0, num_blocks - 1);
     }
     return supervisor_flash_read_blocks(dest, block_num - PART1_START_BLOCK, num_blocks);
 }
@@ -118,6 +124,7 @@ mp_uint_t flash_write_blocks(const uint8_t *src, uint32_t block_num, uint32_t nu
         // can't write MBR, but pretend we did
         return 0;
     } else {
+        filesystem_written();
         return supervisor_flash_write_blocks(src, block_num - PART1_START_BLOCK, num_blocks);
     }
 }
@@ -141,7 +148,12 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_3(supervisor_flash_obj_writeblocks_obj, superviso
 STATIC mp_obj_t supervisor_flash_obj_ioctl(mp_obj_t self, mp_obj_t cmd_in, mp_obj_t arg_in) {
     mp_int_t cmd = mp_obj_get_int(cmd_in);
     switch (cmd) {
-        case BP_IOCTL_INIT: supervisor_flash_init(); return MP_OBJ_NEW_SMALL_INT(0);
+        case BP_IOCTL_INIT:
+            supervisor_flash_init();
+            #if CIRCUITPY_BOOT_TIMING
+            boot_timing_mark(BOOT_PHASE_FLASH_INIT);
+            #endif
+            return MP_OBJ_NEW_SMALL_INT(0);
         case BP_IOCTL_DEINIT: supervisor_flash_flush(); return MP_OBJ_NEW_SMALL_INT(0); // TODO properly
         case BP_IOCTL_SYNC: supervisor_flash_flush(); return MP_OBJ_NEW_SMALL_INT(0);
         case BP_IOCTL_SEC_COUNT: return MP_OBJ_NEW_SMALL_INT(flash_get_block_count());
@@ -180,3 +192,46 @@ void supervisor_flash_init_vfs(fs_user_mount_t *vfs) {
     vfs->u.ioctl[0] = (mp_obj_t)&supervisor_flash_obj_ioctl_obj;
     vfs->u.ioctl[1] = (mp_obj_t)&supervisor_flash_obj;
 }
+
+MP_WEAK const uint8_t *supervisor_flash_get_mapped_block(uint32_t block) {
+    return NULL;
+}
+
+#if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+const byte *mp_persistent_code_map_file(const char *filename, size_t *len) {
+    // Editing the file over USB must restart the VM before the bytecode it
+    // is running from changes underneath it.
+    if (!autoreload_is_enabled()) {
+        return NULL;
+    }
+    const char *path;
+    mp_vfs_mount_t *vm = mp_vfs_lookup_path(filename, &path);
+    if (vm == MP_VFS_NONE || vm == MP_VFS_ROOT) {
+        return NULL;
+    }
+    fs_user_mount_t *vfs = MP_OBJ_TO_PTR(vm->obj);
+    if (vfs->base.type != &mp_fat_vfs_type || vfs->readblocks[2] != (mp_obj_t)flash_read_blocks) {
+        return NULL;
+    }
+    supervisor_flash_flush();
+
+    FIL fp;
+    if (f_open(&vfs->fatfs, &fp, path, FA_READ) != FR_OK) {
+        return NULL;
+    }
+    // Room for exactly one fragment, so building the link map only
+    // succeeds when the file's clusters are contiguous.
+    DWORD clmt[4];
+    clmt[0] = MP_ARRAY_SIZE(clmt);
+    fp.cltbl = clmt;
+    const byte *buf = NULL;
+    if (f_size(&fp) > 0 && f_lseek(&fp, CREATE_LINKMAP) == FR_OK) {
+        FATFS *fatfs = &vfs->fatfs;
+        DWORD sector = fatfs->database + (clmt[2] - 2) * fatfs->csize;
+        buf = supervisor_flash_get_mapped_block(sector - PART1_START_BLOCK);
+        *len = f_size(&fp);
+    }
+    f_close(&fp);
+    return buf;
+}
+#endif
@@ -0,0 +1,248 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "supervisor/shared/heap_image.h"
+
+#include "extmod/vfs.h"
+#include "extmod/vfs_fat.h"
+#include "genhdr/mpversion.h"
+#include "lib/oofatfs/ff.h"
+#include "py/frozenmod.h"
+#include "py/gc.h"
+#include "py/mperrno.h"
+#include "py/objmodule.h"
+#include "py/runtime.h"
+#include "supervisor/filesystem.h"
+
+#define HEAP_IMAGE_MAGIC (0x50414548) // "HEAP"
+#define HEAP_IMAGE_PATH_MAX (255)
+
+// An image is only good for the firmware that saved it, because the heap
+// points at its code and constant objects.
+typedef struct {
+    uint32_t magic;
+    uintptr_t firmware;
+    char version[sizeof(MICROPY_GIT_HASH " " MICROPY_BUILD_DATE)];
+    uint16_t source_count;
+} heap_image_header_t;
+
+// A module file imported before the image was saved. path_len bytes of path
+// follow it.
+typedef struct {
+    uint32_t size;
+    uint16_t date;
+    uint16_t time;
+    uint16_t path_len;
+} heap_image_source_t;
+
+// The roots that are restored. Everything else, such as the port's root
+// pointers and __main__, starts afresh.
+typedef struct {
+    qstr_pool_t *last_pool;
+    byte *qstr_last_chunk;
+    size_t qstr_last_alloc;
+    size_t qstr_last_used;
+    mp_obj_dict_t loaded_modules;
+} heap_image_roots_t;
+
+STATIC heap_image_roots_t loaded_roots;
+STATIC bool heap_image_loaded;
+
+STATIC fs_user_mount_t *heap_image_vfs(void) {
+    if (!filesystem_present() || MP_STATE_VM(vfs_mount_table) == NULL) {
+        return NULL;
+    }
+    return MP_STATE_VM(vfs_mount_table)->obj;
+}
+
+STATIC void heap_image_header(heap_image_header_t *header, uint16_t source_count) {
+    // zero the padding too, headers are compared with memcmp
+    memset(header, 0, sizeof(*header));
+    header->magic = HEAP_IMAGE_MAGIC;
+    header->firmware = (uintptr_t)heap_image_load;
+    memcpy(header->version, MICROPY_GIT_HASH " " MICROPY_BUILD_DATE, sizeof(header->version));
+    header->source_count = source_count;
+}
+
+STATIC bool heap_image_write(void *buf, size_t len, void *arg) {
+    UINT n;
+    return f_write(arg, buf, len, &n) == FR_OK && n == len;
+}
+
+STATIC bool heap_image_read(void *buf, size_t len, void *arg) {
+    UINT n;
+    return f_read(arg, buf, len, &n) == FR_OK && n == len;
+}
+
+// Returns the file a loaded module came from, or NULL if it has none or is
+// frozen into the firmware.
+STATIC const char *heap_image_module_path(mp_obj_t module, size_t *len) {
+    if (!MP_OBJ_IS_TYPE(module, &mp_type_module)) {
+        return NULL;
+    }
+    mp_map_elem_t *elem = mp_map_lookup(&mp_obj_module_get_globals(module)->map, MP_OBJ_NEW_QSTR(MP_QSTR___file__), MP_MAP_LOOKUP);
+    if (elem == NULL || !MP_OBJ_IS_STR(elem->value)) {
+        return NULL;
+    }
+    const char *path = mp_obj_str_get_data(elem->value, len);
+    if (strncmp(path, MP_FROZEN_FAKE_DIR_SLASH, MP_FROZEN_FAKE_DIR_SLASH_LENGTH) == 0) {
+        return NULL;
+    }
+    return path;
+}
+
+// Fails for a module that isn't on the filesystem the image is saved to.
+STATIC FRESULT heap_image_stat(FATFS *fs, const char *path, size_t len, heap_image_source_t *source) {
+    if (len > HEAP_IMAGE_PATH_MAX) {
+        return FR_INVALID_NAME;
+    }
+    FILINFO info;
+    FRESULT res = f_stat(fs, path, &info);
+    if (res != FR_OK) {
+        return res;
+    }
+    source->size = info.fsize;
+    source->date = info.fdate;
+    source->time = info.ftime;
+    source->path_len = len;
+    return res;
+}
+
+bool heap_image_load(void) {
+    fs_user_mount_t *vfs = heap_image_vfs();
+    FIL fp;
+    if (vfs == NULL || f_open(&vfs->fatfs, &fp, CIRCUITPY_HEAP_IMAGE_FILE, FA_READ) != FR_OK) {
+        return false;
+    }
+    heap_image_header_t header;
+    heap_image_header_t expected;
+    bool ok = heap_image_read(&header, sizeof(header), &fp);
+    heap_image_header(&expected, ok ? header.source_count : 0);
+    ok = ok && memcmp(&header, &expected, sizeof(header)) == 0;
+    for (size_t i = 0; ok && i < header.source_count; i++) {
+        heap_image_source_t source;
+        char path[HEAP_IMAGE_PATH_MAX + 1];
+        ok = heap_image_read(&source, sizeof(source), &fp) &&
+            source.path_len <= HEAP_IMAGE_PATH_MAX &&
+            heap_image_read(path, source.path_len, &fp);
+        if (ok) {
+            path[source.path_len] = '\0';
+            FILINFO info;
+            ok = f_stat(&vfs->fatfs, path, &info) == FR_OK &&
+                info.fsize == source.size && info.fdate == source.date && info.ftime == source.time;
+        }
+    }
+    ok = ok && heap_image_read(&loaded_roots, sizeof(loaded_roots), &fp) &&
+        gc_image_load(heap_image_read, &fp);
+    f_close(&fp);
+    if (ok) {
+        // Until heap_image_finish_load nothing refers to the loaded objects,
+        // so they'd all be freed by a collection.
+        MP_STATE_MEM(gc_auto_collect_enabled) = false;
+        heap_image_loaded = true;
+    }
+    return ok;
+}
+
+void heap_image_finish_load(void) {
+    MP_STATE_VM(last_pool) = loaded_roots.last_pool;
+    MP_STATE_VM(qstr_last_chunk) = loaded_roots.qstr_last_chunk;
+    MP_STATE_VM(qstr_last_alloc) = loaded_roots.qstr_last_alloc;
+    MP_STATE_VM(qstr_last_used) = loaded_roots.qstr_last_used;
+    MP_STATE_VM(mp_loaded_modules_dict) = loaded_roots.loaded_modules;
+    MP_STATE_MEM(gc_auto_collect_enabled) = true;
+}
+
+bool heap_image_save(void) {
+    if (heap_image_loaded) {
+        // the image this VM came from is still good
+        return false;
+    }
+    fs_user_mount_t *vfs = heap_image_vfs();
+    if (vfs == NULL || !filesystem_is_writable_by_python(vfs)) {
+        mp_raise_OSError(MP_EROFS);
+    }
+
+    // Check every module file before anything is written.
+    mp_map_t *modules = &MP_STATE_VM(mp_loaded_modules_dict).map;
+    size_t source_count = 0;
+    for (size_t i = 0; i < modules->alloc; i++) {
+        size_t len;
+        const char *path;
+        if (MP_MAP_SLOT_IS_FILLED(modules, i) && (path = heap_image_module_path(modules->table[i].value, &len)) != NULL) {
+            heap_image_source_t source;
+            FRESULT res = heap_image_stat(&vfs->fatfs, path, len, &source);
+            if (res != FR_OK) {
+                mp_raise_OSError(fresult_to_errno_table[res]);
+            }
+            source_count++;
+        }
+    }
+
+    // Leave out whatever garbage there is.
+    gc_collect();
+
+    FIL fp;
+    FRESULT res = f_open(&vfs->fatfs, &fp, CIRCUITPY_HEAP_IMAGE_FILE, FA_WRITE | FA_CREATE_ALWAYS);
+    if (res != FR_OK) {
+        mp_raise_OSError(fresult_to_errno_table[res]);
+    }
+    heap_image_header_t header;
+    heap_image_header(&header, source_count);
+    bool ok = heap_image_write(&header, sizeof(header), &fp);
+    for (size_t i = 0; ok && i < modules->alloc; i++) {
+        size_t len;
+        const char *path;
+        if (MP_MAP_SLOT_IS_FILLED(modules, i) && (path = heap_image_module_path(modules->table[i].value, &len)) != NULL) {
+            heap_image_source_t source;
+            ok = heap_image_stat(&vfs->fatfs, path, len, &source) == FR_OK &&
+                heap_image_write(&source, sizeof(source), &fp) &&
+                heap_image_write((void *)path, len, &fp);
+        }
+    }
+    heap_image_roots_t roots = {
+        .last_pool = MP_STATE_VM(last_pool),
+        .qstr_last_chunk = MP_STATE_VM(qstr_last_chunk),
+        .qstr_last_alloc = MP_STATE_VM(qstr_last_alloc),
+        .qstr_last_used = MP_STATE_VM(qstr_last_used),
+        .loaded_modules = MP_STATE_VM(mp_loaded_modules_dict),
+    };
+    ok = ok && heap_image_write(&roots, sizeof(roots), &fp) &&
+        gc_image_save(heap_image_write, &fp);
+    ok = f_close(&fp) == FR_OK && ok;
+    if (!ok) {
+        f_unlink(&vfs->fatfs, CIRCUITPY_HEAP_IMAGE_FILE);
+        mp_raise_OSError(MP_EIO);
+    }
+    filesystem_flush();
+    return true;
+}
+
+void heap_image_reset(void) {
+    heap_image_loaded = false;
+}
@@ -0,0 +1,50 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SUPERVISOR_HEAP_IMAGE_H
+#define MICROPY_INCLUDED_SUPERVISOR_HEAP_IMAGE_H
+
+#include <stdbool.h>
+
+// Heap images let code.py skip its imports on later runs. An image holds the
+// allocated part of the heap, the interned strings and sys.modules. It is only
+// loaded into the same firmware with the heap at the same address, and only
+// while every module file it imported is unchanged.
+
+// Called between gc_init and mp_init. Returns true if the heap now holds an
+// image, in which case heap_image_finish_load must be called after mp_init.
+bool heap_image_load(void);
+void heap_image_finish_load(void);
+
+// Writes an image of the running VM unless this VM was loaded from one.
+// Returns true if an image was written. Raises OSError if the filesystem
+// isn't writable, or if an imported module isn't on it.
+bool heap_image_save(void);
+
+// Forget whether the VM came from an image before the heap goes away.
+void heap_image_reset(void);
+
+#endif  // MICROPY_INCLUDED_SUPERVISOR_HEAP_IMAGE_H
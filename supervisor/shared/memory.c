@@ -28,75 +28,95 @@
 #include "supervisor/port.h"
 
 #include <stddef.h>
+#include <string.h>
 
+#include "py/mpconfig.h"
 #include "supervisor/shared/display.h"
 
-#define CIRCUITPY_SUPERVISOR_ALLOC_COUNT 8
+// One slot for each allocation the supervisor may make at once.
+enum {
+    CIRCUITPY_SUPERVISOR_ALLOC_COUNT =
+    // stack + heap
+    2
+    #if !INTERNAL_FLASH_FILESYSTEM
+    // flash cache
+    + 1
+    #endif
+    #if CIRCUITPY_USB_MIDI
+    + 1
+    #endif
+    #if CIRCUITPY_DISPLAYIO
+    // terminal tiles + a refresh buffer for each display
+    + 1 + CIRCUITPY_DISPLAY_LIMIT
+    #endif
+};
 
+#define FLAG_HIGH (0x1)
+#define FLAG_MOVABLE (0x2)
+
+// Allocations are handed out as pointers into this table. They stay valid when
+// supervisor_move_memory moves the memory they describe.
 static supervisor_allocation allocations[CIRCUITPY_SUPERVISOR_ALLOC_COUNT];
+static uint8_t allocation_flags[CIRCUITPY_SUPERVISOR_ALLOC_COUNT];
 // We use uint32_t* to ensure word (4 byte) alignment.
 uint32_t* low_address;
 uint32_t* high_address;
 
+MP_WEAK uint32_t *port_heap_get_bottom(void) {
+    return port_stack_get_limit();
+}
+
+MP_WEAK uint32_t *port_heap_get_top(void) {
+    return port_stack_get_top();
+}
+
 void memory_init(void) {
-    low_address = port_stack_get_limit();
-    high_address = port_stack_get_top();
+    low_address = port_heap_get_bottom();
+    high_address = port_heap_get_top();
 }
 
-void free_memory(supervisor_allocation* allocation) {
-    int32_t index = 0;
-    bool found = false;
-    for (index = 0; index < CIRCUITPY_SUPERVISOR_ALLOC_COUNT; index++) {
-        found = allocation == &allocations[index];
-        if (found) {
-            break;
+// Move the bounds in past any free space left by allocations freed before their neighbours.
+static void update_bounds(void) {
+    low_address = port_heap_get_bottom();
+    high_address = port_heap_get_top();
+    for (size_t index = 0; index < CIRCUITPY_SUPERVISOR_ALLOC_COUNT; index++) {
+        supervisor_allocation* allocation = &allocations[index];
+        if (allocation->ptr == NULL) {
+            continue;
+        }
+        if ((allocation_flags[index] & FLAG_HIGH) != 0) {
+            if (allocation->ptr < high_address) {
+                high_address = allocation->ptr;
+            }
+        } else if (allocation->ptr + allocation->length / 4 > low_address) {
+            low_address = allocation->ptr + allocation->length / 4;
         }
     }
-    if (!found) {
+}
+
+void free_memory(supervisor_allocation* allocation) {
+    if (allocation < allocations || allocation >= allocations + CIRCUITPY_SUPERVISOR_ALLOC_COUNT) {
         // Bad!
         // TODO(tannewt): Add a way to escape into safe mode on error.
-    }
-    if (allocation->ptr == high_address) {
-        high_address += allocation->length / 4;
-        for (index++; index < CIRCUITPY_SUPERVISOR_ALLOC_COUNT; index++) {
-            if (allocations[index].ptr != NULL) {
-                break;
-            }
-            high_address += allocations[index].length / 4;
-        }
-    } else if (allocation->ptr + allocation->length / 4 == low_address) {
-        low_address = allocation->ptr;
-        for (index--; index >= 0; index--) {
-            if (allocations[index].ptr != NULL) {
-                break;
-            }
-            low_address -= allocations[index].length / 4;
-        }
-    } else {
-        // Freed memory isn't in the middle so skip updating bounds. The memory will be added to the
-        // middle when the memory to the inside is freed.
+        return;
     }
     allocation->ptr = NULL;
+    update_bounds();
 }
 
 supervisor_allocation* allocate_remaining_memory(void) {
     if (low_address == high_address) {
         return NULL;
     }
-    return allocate_memory((high_address - low_address) * 4, false);
+    return allocate_memory((high_address - low_address) * 4, false, false);
 }
 
-supervisor_allocation* allocate_memory(uint32_t length, bool high) {
+supervisor_allocation* allocate_memory(uint32_t length, bool high, bool movable) {
     if ((high_address - low_address) * 4 < (int32_t) length || length % 4 != 0) {
         return NULL;
     }
-    uint8_t index = 0;
-    int8_t direction = 1;
-    if (high) {
-        index = CIRCUITPY_SUPERVISOR_ALLOC_COUNT - 1;
-        direction = -1;
-    }
-    for (; index < CIRCUITPY_SUPERVISOR_ALLOC_COUNT; index += direction) {
+    size_t index;
+    for (index = 0; index < CIRCUITPY_SUPERVISOR_ALLOC_COUNT; index++) {
         if (allocations[index].ptr == NULL) {
             break;
         }
@@ -113,9 +133,39 @@ supervisor_allocation* allocate_memory(uint32_t length, bool high) {
         low_address += length / 4;
     }
     alloc->length = length;
+    allocation_flags[index] = (high ? FLAG_HIGH : 0) | (movable ? FLAG_MOVABLE : 0);
     return alloc;
 }
 
+// Slide the movable low allocations down over the holes below them. The high end is left alone
+// because the C stack grows down from its top whatever its allocation says.
+static void compact_low_memory(void) {
+    uint32_t* cursor = port_heap_get_bottom();
+    while (true) {
+        // The next allocation up from the cursor.
+        supervisor_allocation* next = NULL;
+        size_t next_index = 0;
+        for (size_t index = 0; index < CIRCUITPY_SUPERVISOR_ALLOC_COUNT; index++) {
+            supervisor_allocation* allocation = &allocations[index];
+            if (allocation->ptr != NULL && (allocation_flags[index] & FLAG_HIGH) == 0 &&
+                allocation->ptr >= cursor && (next == NULL || allocation->ptr < next->ptr)) {
+                next = allocation;
+                next_index = index;
+            }
+        }
+        if (next == NULL) {
+            break;
+        }
+        if ((allocation_flags[next_index] & FLAG_MOVABLE) != 0 && next->ptr > cursor) {
+            memmove(cursor, next->ptr, next->length);
+            next->ptr = cursor;
+        }
+        cursor = next->ptr + next->length / 4;
+    }
+    update_bounds();
+}
+
 void supervisor_move_memory(void) {
+    compact_low_memory();
     supervisor_display_move_memory();
 }
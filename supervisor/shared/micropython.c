@@ -31,6 +31,7 @@
 #include "py/mpconfig.h"
 
 #include "supervisor/shared/status_leds.h"
+#include "supervisor/shared/tick.h"
 
 int mp_hal_stdin_rx_chr(void) {
     for (;;) {
@@ -41,6 +42,7 @@ int mp_hal_stdin_rx_chr(void) {
             toggle_rx_led();
             return serial_read();
         }
+        supervisor_idle();
     }
 }
 
@@ -56,3 +58,15 @@ void mp_hal_stdout_tx_strn(const char *str, size_t len) {
 
     serial_write_substring(str, len);
 }
+
+// Serial implementations without an output buffer always block.
+MP_WEAK void serial_set_write_blocking(bool blocking) {
+}
+
+MP_WEAK bool serial_get_write_blocking(void) {
+    return true;
+}
+
+MP_WEAK uint32_t serial_get_bytes_dropped(void) {
+    return 0;
+}
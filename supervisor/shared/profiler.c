@@ -0,0 +1,131 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "supervisor/shared/profiler.h"
+
+#include "py/bc.h"
+#include "py/gc.h"
+#include "py/mpstate.h"
+#include "py/objfun.h"
+#include "py/objtuple.h"
+#include "py/runtime.h"
+
+typedef struct {
+    const mp_obj_fun_bc_t *fun;
+    size_t offset;
+} profiler_sample_t;
+
+// The ring itself is MP_STATE_VM(profiler_samples) so that the collector
+// sees the functions in it.
+static size_t profiler_sample_count;
+static volatile size_t profiler_samples_taken;
+static size_t profiler_interval_ms;
+static volatile size_t profiler_countdown;
+static volatile bool profiler_active;
+
+void supervisor_profiler_start(size_t interval_ms, size_t sample_count) {
+    profiler_active = false;
+    profiler_sample_t *samples = MP_STATE_VM(profiler_samples);
+    if (samples == NULL || profiler_sample_count != sample_count) {
+        MP_STATE_VM(profiler_samples) = NULL;
+        m_free(samples);
+        MP_STATE_VM(profiler_samples) = m_new0(profiler_sample_t, sample_count);
+        profiler_sample_count = sample_count;
+    }
+    profiler_samples_taken = 0;
+    profiler_interval_ms = interval_ms;
+    profiler_countdown = interval_ms;
+    profiler_active = true;
+}
+
+void supervisor_profiler_stop(void) {
+    profiler_active = false;
+}
+
+bool supervisor_profiler_running(void) {
+    return profiler_active;
+}
+
+void supervisor_profiler_tick(void) {
+    if (!profiler_active || --profiler_countdown > 0) {
+        return;
+    }
+    profiler_countdown = profiler_interval_ms;
+    mp_code_state_t *code_state = MP_STATE_THREAD(current_code_state);
+    // Don't store into the ring while it is being marked, the function could
+    // be missed and freed.
+    if (code_state == NULL || gc_is_locked()) {
+        return;
+    }
+    const mp_obj_fun_bc_t *fun = code_state->fun_bc;
+    if (code_state->ip < fun->bytecode) {
+        return;
+    }
+    profiler_sample_t *samples = MP_STATE_VM(profiler_samples);
+    profiler_sample_t *sample = &samples[profiler_samples_taken % profiler_sample_count];
+    sample->fun = fun;
+    sample->offset = code_state->ip - fun->bytecode;
+    profiler_samples_taken++;
+}
+
+mp_obj_t supervisor_profiler_histogram(void) {
+    mp_obj_t histogram = mp_obj_new_dict(0);
+    profiler_sample_t *samples = MP_STATE_VM(profiler_samples);
+    if (samples == NULL) {
+        return histogram;
+    }
+    // Pause sampling so the ring doesn't change underneath us.
+    bool was_active = profiler_active;
+    profiler_active = false;
+    size_t count = MIN(profiler_samples_taken, profiler_sample_count);
+    for (size_t i = 0; i < count; i++) {
+        const mp_obj_fun_bc_t *fun = samples[i].fun;
+        qstr block_name, source_file;
+        size_t line = mp_bytecode_get_source_line(fun->bytecode, fun->const_table,
+            fun->bytecode + samples[i].offset, &block_name, &source_file);
+        mp_obj_t items[3] = {
+            MP_OBJ_NEW_QSTR(source_file),
+            MP_OBJ_NEW_QSTR(block_name),
+            MP_OBJ_NEW_SMALL_INT(line),
+        };
+        mp_obj_t key = mp_obj_new_tuple(3, items);
+        mp_map_elem_t *elem = mp_map_lookup(mp_obj_dict_get_map(histogram), key, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
+        if (elem->value == MP_OBJ_NULL) {
+            elem->value = MP_OBJ_NEW_SMALL_INT(1);
+        } else {
+            elem->value = MP_OBJ_NEW_SMALL_INT(MP_OBJ_SMALL_INT_VALUE(elem->value) + 1);
+        }
+    }
+    profiler_active = was_active;
+    return histogram;
+}
+
+void supervisor_profiler_reset(void) {
+    profiler_active = false;
+    MP_STATE_VM(profiler_samples) = NULL;
+    profiler_sample_count = 0;
+    profiler_samples_taken = 0;
+}
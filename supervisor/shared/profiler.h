@@ -0,0 +1,54 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SUPERVISOR_PROFILER_H
+#define MICROPY_INCLUDED_SUPERVISOR_PROFILER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "py/obj.h"
+
+// Sampling profiler for bytecode. Every interval_ms ticks, the function and
+// instruction being executed are recorded into a ring of samples. The ring
+// holds references to the sampled functions so they stay valid until the
+// histogram is made.
+
+void supervisor_profiler_start(size_t interval_ms, size_t sample_count);
+void supervisor_profiler_stop(void);
+bool supervisor_profiler_running(void);
+
+// Returns a dict mapping (filename, function name, line) to sample counts
+// for the samples currently in the ring.
+mp_obj_t supervisor_profiler_histogram(void);
+
+// Called from supervisor_tick, possibly in an interrupt context.
+void supervisor_profiler_tick(void);
+
+// Forget the ring before the heap goes away.
+void supervisor_profiler_reset(void);
+
+#endif  // MICROPY_INCLUDED_SUPERVISOR_PROFILER_H
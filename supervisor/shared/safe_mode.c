@@ -28,30 +28,48 @@
 
 #include "mphalport.h"
 
+#include "py/misc.h"
+#include "py/mpprint.h"
+
 #include "shared-bindings/digitalio/DigitalInOut.h"
 
 #include "supervisor/serial.h"
 #include "supervisor/shared/rgb_led_colors.h"
 #include "supervisor/shared/rgb_led_status.h"
+#include "supervisor/shared/stack.h"
 #include "supervisor/shared/translate.h"
 #include "supervisor/shared/tick.h"
 
 #define SAFE_MODE_DATA_GUARD 0xad0000af
 #define SAFE_MODE_DATA_GUARD_MASK 0xff0000ff
+// The reason is in the byte above the guard's low byte. The byte above it holds
+// the C stack high water mark at the time of a crash, in these units.
+#define SAFE_MODE_STACK_UNIT 256
 
 static safe_mode_t current_safe_mode;
+#if MICROPY_MAX_STACK_USAGE
+static uint32_t crash_stack_usage;
+#endif
 
 safe_mode_t wait_for_safe_mode_reset(void) {
     uint32_t reset_state = port_get_saved_word();
     safe_mode_t safe_mode = NO_SAFE_MODE;
     if ((reset_state & SAFE_MODE_DATA_GUARD_MASK) == SAFE_MODE_DATA_GUARD) {
-        safe_mode = (reset_state & ~SAFE_MODE_DATA_GUARD_MASK) >> 8;
+        safe_mode = (reset_state >> 8) & 0xff;
+        #if MICROPY_MAX_STACK_USAGE
+        crash_stack_usage = ((reset_state >> 16) & 0xff) * SAFE_MODE_STACK_UNIT;
+        #endif
     }
     if (safe_mode != NO_SAFE_MODE) {
         port_set_saved_word(SAFE_MODE_DATA_GUARD);
         current_safe_mode = safe_mode;
         return safe_mode;
     }
+    #if CIRCUITPY_FAST_BOOT
+    // No reset window, so only crashes lead to safe mode.
+    port_set_saved_word(SAFE_MODE_DATA_GUARD);
+    return NO_SAFE_MODE;
+    #endif
     port_set_saved_word(SAFE_MODE_DATA_GUARD | (MANUAL_SAFE_MODE << 8));
     // Wait for a while to allow for reset.
     temp_status_color(SAFE_MODE);
@@ -90,7 +108,12 @@ void __attribute__((noinline,)) reset_into_safe_mode(safe_mode_t reason) {
         }
     }
 
-    safe_mode_on_next_reset(reason);
+    uint32_t saved_word = SAFE_MODE_DATA_GUARD | (reason << 8);
+    #if MICROPY_MAX_STACK_USAGE
+    uint32_t stack_units = (stack_get_max_usage() + SAFE_MODE_STACK_UNIT - 1) / SAFE_MODE_STACK_UNIT;
+    saved_word |= MIN(stack_units, 0xff) << 16;
+    #endif
+    port_set_saved_word(saved_word);
     reset_cpu();
 }
 
@@ -163,3 +186,14 @@ void print_safe_mode_message(safe_mode_t reason) {
         }
         serial_write_compressed(FILE_AN_ISSUE);
 }
+
+#if MICROPY_MAX_STACK_USAGE
+void print_safe_mode_stack_usage(void) {
+    if (crash_stack_usage == 0) {
+        return;
+    }
+    serial_write_compressed(translate("Stack used before the crash, in bytes: "));
+    // Rounded up to the unit it was saved in.
+    mp_printf(&mp_plat_print, "%u\n", (uint)crash_stack_usage);
+}
+#endif
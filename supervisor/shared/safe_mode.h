@@ -48,5 +48,7 @@ void safe_mode_on_next_reset(safe_mode_t reason);
 void reset_into_safe_mode(safe_mode_t reason);
 
 void print_safe_mode_message(safe_mode_t reason);
+// Prints how much C stack was used before the crash that led to safe mode.
+void print_safe_mode_stack_usage(void);
 
 #endif  // MICROPY_INCLUDED_SUPERVISOR_SAFE_MODE_H
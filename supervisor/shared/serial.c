@@ -27,6 +27,7 @@
 #include <string.h>
 
 #include "py/mpconfig.h"
+#include "py/ringbuf.h"
 
 #include "supervisor/shared/display.h"
 #include "shared-bindings/terminalio/Terminal.h"
@@ -35,6 +36,16 @@
 
 #include "tusb.h"
 
+#if CIRCUITPY_SERIAL_TX_BUFFER_SIZE > 0
+// Output waits here until the USB background task moves it into TinyUSB's
+// much smaller FIFO, so a burst of prints doesn't wait for the host.
+static uint8_t serial_tx_buffer[CIRCUITPY_SERIAL_TX_BUFFER_SIZE];
+static ringbuf_t serial_tx = {serial_tx_buffer, sizeof(serial_tx_buffer)};
+#endif
+
+static bool serial_write_blocking = true;
+static uint32_t serial_bytes_dropped;
+
 void serial_init(void) {
     usb_init();
 }
@@ -44,11 +55,55 @@ bool serial_connected(void) {
 }
 
 char serial_read(void) {
-    return (char) tud_cdc_read_char();
+    usb_lock();
+    char c = (char) tud_cdc_read_char();
+    usb_unlock();
+    return c;
 }
 
 bool serial_bytes_available(void) {
-    return tud_cdc_available() > 0;
+    usb_lock();
+    bool available = tud_cdc_available() > 0;
+    usb_unlock();
+    return available;
+}
+
+#if CIRCUITPY_SERIAL_TX_BUFFER_SIZE > 0
+// Copy as much of text as fits into the buffer and return how much that was.
+STATIC uint32_t serial_tx_put(const char* text, uint32_t length) {
+    return ringbuf_try_put_n(&serial_tx, (const uint8_t*) text, MIN(length, serial_tx.size));
+}
+#endif
+
+void usb_serial_background(void) {
+    #if CIRCUITPY_SERIAL_TX_BUFFER_SIZE > 0
+    if (!tud_cdc_connected()) {
+        // Nobody is listening, the same as output written while disconnected.
+        ringbuf_clear(&serial_tx);
+        return;
+    }
+    uint8_t *data;
+    uint16_t span;
+    while ((span = ringbuf_get_span(&serial_tx, &data)) > 0) {
+        uint32_t n = tud_cdc_write(data, span);
+        if (n == 0) {
+            break;
+        }
+        ringbuf_consume(&serial_tx, n);
+    }
+    #endif
+}
+
+void serial_set_write_blocking(bool blocking) {
+    serial_write_blocking = blocking;
+}
+
+bool serial_get_write_blocking(void) {
+    return serial_write_blocking;
+}
+
+uint32_t serial_get_bytes_dropped(void) {
+    return serial_bytes_dropped;
 }
 
 void serial_write_substring(const char* text, uint32_t length) {
@@ -57,11 +112,31 @@ void serial_write_substring(const char* text, uint32_t length) {
     common_hal_terminalio_terminal_write(&supervisor_terminal, (const uint8_t*) text, length, &errcode);
 #endif
 
+    if (!tud_cdc_connected()) {
+        return;
+    }
     uint32_t count = 0;
-    while (count < length && tud_cdc_connected()) {
+    while (count < length) {
+        #if CIRCUITPY_SERIAL_TX_BUFFER_SIZE > 0
+        count += serial_tx_put(text + count, length - count);
+        #else
+        usb_lock();
         count += tud_cdc_write(text + count, length - count);
+        usb_unlock();
+        #endif
+        if (count == length) {
+            break;
+        }
+        if (!serial_write_blocking) {
+            serial_bytes_dropped += length - count;
+            break;
+        }
         usb_background();
+        if (!tud_cdc_connected()) {
+            break;
+        }
     }
+    usb_background_schedule();
 }
 
 void serial_write(const char* text) {
@@ -26,8 +26,11 @@
 
 #include "stack.h"
 
+#include <string.h>
+
 #include "py/mpconfig.h"
 #include "py/runtime.h"
+#include "py/stackctrl.h"
 #include "supervisor/cpu.h"
 #include "supervisor/port.h"
 #include "supervisor/shared/safe_mode.h"
@@ -40,15 +43,30 @@ supervisor_allocation* stack_alloc = NULL;
 
 #define EXCEPTION_STACK_SIZE 1024
 
+MP_WEAK bool port_has_fixed_stack(void) {
+    return false;
+}
+
+// Describes the stack of ports that don't allocate it.
+static supervisor_allocation fixed_stack;
+
 void allocate_stack(void) {
+    if (port_has_fixed_stack()) {
+        fixed_stack.ptr = port_stack_get_limit();
+        fixed_stack.length = (port_stack_get_top() - port_stack_get_limit()) * sizeof(uint32_t);
+        stack_alloc = &fixed_stack;
+        current_stack_size = fixed_stack.length;
+        *stack_alloc->ptr = STACK_CANARY_VALUE;
+        return;
+    }
     mp_uint_t regs[10];
     mp_uint_t sp = cpu_get_regs_and_sp(regs);
 
     mp_uint_t c_size = (uint32_t) port_stack_get_top() - sp;
 
-    stack_alloc = allocate_memory(c_size + next_stack_size + EXCEPTION_STACK_SIZE, true);
+    stack_alloc = allocate_memory(c_size + next_stack_size + EXCEPTION_STACK_SIZE, true, false);
     if (stack_alloc == NULL) {
-        stack_alloc = allocate_memory(c_size + CIRCUITPY_DEFAULT_STACK_SIZE + EXCEPTION_STACK_SIZE, true);
+        stack_alloc = allocate_memory(c_size + CIRCUITPY_DEFAULT_STACK_SIZE + EXCEPTION_STACK_SIZE, true, false);
         current_stack_size = CIRCUITPY_DEFAULT_STACK_SIZE;
     } else {
         current_stack_size = next_stack_size;
@@ -71,7 +89,8 @@ void stack_init(void) {
 }
 
 void stack_resize(void) {
-    if (next_stack_size == current_stack_size) {
+    // A fixed stack can't change size.
+    if (next_stack_size == current_stack_size || port_has_fixed_stack()) {
         *stack_alloc->ptr = STACK_CANARY_VALUE;
         return;
     }
@@ -87,3 +106,40 @@ void set_next_stack_size(uint32_t size) {
 uint32_t get_current_stack_size(void) {
     return current_stack_size;
 }
+
+#if MICROPY_MAX_STACK_USAGE
+void stack_paint(void) {
+    // Leave the canary at the bottom alone.
+    mp_stack_set_bottom(stack_alloc->ptr + 1);
+    mp_stack_fill_with_sentinel();
+    #if MICROPY_ENABLE_PYSTACK
+    memset(MP_STATE_THREAD(pystack_start), MP_MAX_STACK_USAGE_SENTINEL_BYTE,
+        MP_STATE_THREAD(pystack_end) - MP_STATE_THREAD(pystack_start));
+    #endif
+}
+
+uint32_t stack_get_max_usage(void) {
+    // The C stack grows down, so the deepest use is the lowest byte that isn't paint.
+    char* p = MP_STATE_THREAD(stack_bottom);
+    char* top = MP_STATE_THREAD(stack_top);
+    if (p == NULL) {
+        return 0;
+    }
+    while (p < top && *p == MP_MAX_STACK_USAGE_SENTINEL_BYTE) {
+        p++;
+    }
+    return top - p;
+}
+
+#if MICROPY_ENABLE_PYSTACK
+uint32_t pystack_get_max_usage(void) {
+    // The Python stack grows up.
+    uint8_t* start = MP_STATE_THREAD(pystack_start);
+    uint8_t* p = MP_STATE_THREAD(pystack_end);
+    while (p > start && *(p - 1) == MP_MAX_STACK_USAGE_SENTINEL_BYTE) {
+        p--;
+    }
+    return p - start;
+}
+#endif
+#endif
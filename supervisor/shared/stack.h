@@ -43,6 +43,18 @@ bool stack_ok(void);
 // exception when the stack has likely overwritten a portion of the heap.
 void assert_heap_ok(void);
 
+#if MICROPY_MAX_STACK_USAGE
+// Paints the unused stack, and the Python stack, so that the high water marks
+// below count from now. Called as the VM starts.
+void stack_paint(void);
+// Bytes of C stack used since the last paint, below the caller of stack_paint.
+uint32_t stack_get_max_usage(void);
+#if MICROPY_ENABLE_PYSTACK
+// Bytes of Python stack used since the last paint.
+uint32_t pystack_get_max_usage(void);
+#endif
+#endif
+
 #define STACK_CANARY_VALUE 0x017829ef
 
 #endif  // MICROPY_INCLUDED_SUPERVISOR_STACK_H
@@ -25,12 +25,29 @@
  */
 
 #include "supervisor/shared/tick.h"
+
+#include "py/gc.h"
 #include "supervisor/filesystem.h"
 #include "supervisor/shared/autoreload.h"
+#include "supervisor/shared/background_task.h"
+#include "supervisor/port.h"
+#include "supervisor/usb.h"
 
 static volatile uint64_t ticks_ms;
 static volatile uint32_t background_ticks_ms32;
 
+#if CIRCUITPY_CYCLE_COUNTER
+// The low 32 bits match the port's counter the last time it was read.
+static volatile uint64_t cycle_count;
+
+// Adds the cycles since the last read. The port's counter wraps every few
+// seconds so this runs every tick as well. Call with interrupts disabled.
+static void update_cycle_count(void) {
+    uint32_t low = port_get_cycle_count();
+    cycle_count += (uint32_t) (low - (uint32_t) cycle_count);
+}
+#endif
+
 #if CIRCUITPY_GAMEPAD
 #include "shared-module/gamepad/__init__.h"
 #endif
@@ -39,12 +56,29 @@ static volatile uint32_t background_ticks_ms32;
 #include "shared-module/gamepadshift/__init__.h"
 #endif
 
+#if CIRCUITPY_PROFILER
+#include "supervisor/shared/profiler.h"
+#endif
+
 #include "shared-bindings/microcontroller/__init__.h"
 
+#if CIRCUITPY_BACKGROUND_TRACE
+#include "supervisor/shared/background_trace.h"
+#endif
+
 void supervisor_tick(void) {
 
     ticks_ms ++;
 
+#if CIRCUITPY_BACKGROUND_TRACE
+    // Started after the increment so that ports counting cycles from the tick
+    // see the new millisecond.
+    uint32_t trace_start = port_get_cycle_count();
+#endif
+
+#if CIRCUITPY_CYCLE_COUNTER
+    update_cycle_count();
+#endif
 #if CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS > 0
     filesystem_tick();
 #endif
@@ -61,6 +95,16 @@ void supervisor_tick(void) {
         #endif
     }
 #endif
+#if CIRCUITPY_PROFILER
+    supervisor_profiler_tick();
+#endif
+#if CIRCUITPY_USB_IRQ_TASK
+    // TinyUSB queues its events from the USB interrupt. Check for them every tick.
+    usb_irq_task_trigger();
+#endif
+#if CIRCUITPY_BACKGROUND_TRACE
+    background_trace_record(BACKGROUND_TRACE_TICK, trace_start);
+#endif
 }
 
 uint64_t supervisor_ticks_ms64() {
@@ -75,17 +119,68 @@ uint32_t supervisor_ticks_ms32() {
     return ticks_ms;
 }
 
+#if CIRCUITPY_CYCLE_COUNTER
+uint64_t supervisor_ticks_cycles64(void) {
+    uint64_t result;
+    common_hal_mcu_disable_interrupts();
+    update_cycle_count();
+    result = cycle_count;
+    common_hal_mcu_enable_interrupts();
+    return result;
+}
+#endif
+
+MP_WEAK void port_get_ticks_ns(uint64_t *ms, uint32_t *ns) {
+    *ms = supervisor_ticks_ms64();
+    *ns = 0;
+}
+
+uint64_t supervisor_ticks_ns64(void) {
+    uint64_t ms;
+    uint32_t ns;
+    port_get_ticks_ns(&ms, &ns);
+    return ms * 1000000 + ns;
+}
+
 extern void run_background_tasks(void);
 
 void supervisor_run_background_tasks_if_tick() {
+    #if CIRCUITPY_USB_IRQ_TASK
+    // Drivers that wait for hardware run background tasks, but not from the USB interrupt.
+    if (usb_in_irq_task()) {
+        return;
+    }
+    #endif
     uint32_t now32 = ticks_ms;
 
-    if (now32 == background_ticks_ms32) {
+    // Tasks with work signalled from an interrupt don't wait for the next tick.
+    if (now32 == background_ticks_ms32 && !background_tasks_pending()) {
         return;
     }
     background_ticks_ms32 = now32;
 
     run_background_tasks();
+
+    #if MICROPY_GC_LAZY_SWEEP
+    // Carry on with the sweep left by an automatic collection. This can run
+    // inside a driver's busy wait, so finalisers are left for gc_alloc or the
+    // next collection.
+    gc_sweep_step(0, false);
+    #endif
+}
+
+// Ports that can't sleep keep polling.
+MP_WEAK void port_sleep_until_interrupt(void) {
+}
+
+void supervisor_idle(void) {
+    // Background tasks with work to do, or due on a tick they haven't run on
+    // yet, must not wait for the next interrupt.
+    common_hal_mcu_disable_interrupts();
+    if (!background_tasks_pending() && (uint32_t) ticks_ms == background_ticks_ms32) {
+        port_sleep_until_interrupt();
+    }
+    common_hal_mcu_enable_interrupts();
 }
 
 void supervisor_fake_tick() {
@@ -57,11 +57,30 @@ extern uint32_t supervisor_ticks_ms32(void);
  * then it may be possible to use supervisor_ticks_ms64 instead.
  */
 extern uint64_t supervisor_ticks_ms64(void);
+/** @brief Get the number of CPU cycles since startup
+ *
+ * Extends the port's 32-bit cycle counter to 64 bits, so it must briefly
+ * disable interrupts. Only available with CIRCUITPY_CYCLE_COUNTER.
+ */
+extern uint64_t supervisor_ticks_cycles64(void);
+/** @brief Get the time since startup in nanoseconds
+ *
+ * Adds the time since the last tick, when the port can read it, so the
+ * resolution is finer than a millisecond. It never goes backwards.
+ */
+extern uint64_t supervisor_ticks_ns64(void);
 /** @brief Run background ticks, but only about every millisecond.
  *
  * Normally, this is not called directly.  Instead use the RUN_BACKGROUND_TASKS
  * macro.
  */
 extern void supervisor_run_background_if_tick(void);
+/** @brief Sleep until the next interrupt unless background tasks have work
+ *
+ * Loops that wait for time to pass or for input call this after running
+ * background tasks. The tick interrupt wakes the CPU at the latest on the
+ * next millisecond, and USB, UART and pin interrupts wake it earlier.
+ */
+extern void supervisor_idle(void);
 
 #endif
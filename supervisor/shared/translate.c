@@ -30,6 +30,25 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "py/mpconfig.h"
+
+// Codes of up to 8 bits are decoded with one lookup instead of a bit at a time. The table takes
+// 512 bytes of flash.
+#ifndef CIRCUITPY_TRANSLATE_DECODE_TABLE
+#define CIRCUITPY_TRANSLATE_DECODE_TABLE (CIRCUITPY_FULL_BUILD)
+#endif
+
+// Recently used messages are kept decompressed so exceptions raised over and over, such as in
+// retry loops, don't decode their message every time. Each entry takes 72 bytes of RAM. Threads
+// without the GIL would race on the cache so it's left out for them.
+#ifndef CIRCUITPY_TRANSLATE_CACHE_ENTRIES
+#if CIRCUITPY_FULL_BUILD && !(MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL)
+#define CIRCUITPY_TRANSLATE_CACHE_ENTRIES (4)
+#else
+#define CIRCUITPY_TRANSLATE_CACHE_ENTRIES (0)
+#endif
+#endif
+
 #ifndef NO_QSTR
 #include "genhdr/compression.generated.h"
 #endif
@@ -51,47 +70,112 @@ STATIC int put_utf8(char *buf, int u) {
         *buf   = 0b10000000 | (u & 0b00111111);
         return 2;
     } else { // u <= 0xffff)
-        *buf++ = 0b11000000 | (u >> 12);
-        *buf   = 0b10000000 | ((u >> 6) & 0b00111111);
+        *buf++ = 0b11100000 | (u >> 12);
+        *buf++ = 0b10000000 | ((u >> 6) & 0b00111111);
         *buf   = 0b10000000 | (u & 0b00111111);
         return 3;
     }
 }
 
+#if CIRCUITPY_TRANSLATE_CACHE_ENTRIES > 0
+// Longer messages aren't cached.
+#define CACHE_ENTRY_LENGTH (64)
+
+typedef struct {
+    const compressed_string_t* compressed;
+    uint32_t last_used;
+    char decompressed[CACHE_ENTRY_LENGTH];
+} cache_entry_t;
+
+STATIC cache_entry_t cache[CIRCUITPY_TRANSLATE_CACHE_ENTRIES];
+STATIC uint32_t cache_clock;
+
+STATIC bool cache_get(const compressed_string_t* compressed, char* decompressed) {
+    for (uint8_t i = 0; i < CIRCUITPY_TRANSLATE_CACHE_ENTRIES; i++) {
+        if (cache[i].compressed == compressed) {
+            cache[i].last_used = ++cache_clock;
+            memcpy(decompressed, cache[i].decompressed, compressed->length);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Replaces the least recently used entry.
+STATIC void cache_put(const compressed_string_t* compressed, const char* decompressed) {
+    if (compressed->length > CACHE_ENTRY_LENGTH) {
+        return;
+    }
+    cache_entry_t* entry = &cache[0];
+    for (uint8_t i = 1; i < CIRCUITPY_TRANSLATE_CACHE_ENTRIES; i++) {
+        if (cache[i].last_used < entry->last_used) {
+            entry = &cache[i];
+        }
+    }
+    entry->compressed = compressed;
+    entry->last_used = ++cache_clock;
+    memcpy(entry->decompressed, decompressed, compressed->length);
+}
+#endif
+
 char* decompress(const compressed_string_t* compressed, char* decompressed) {
-    uint8_t this_byte = 0;
-    uint8_t this_bit = 7;
-    uint8_t b = compressed->data[this_byte];
+    #if CIRCUITPY_TRANSLATE_CACHE_ENTRIES > 0
+    if (cache_get(compressed, decompressed)) {
+        return decompressed;
+    }
+    #endif
+    const uint8_t* data = compressed->data;
+    // The unread bits, most significant first. Bytes are added as they are needed so at most one
+    // byte past the end is read, and its bits are never used.
+    uint32_t window = 0;
+    uint8_t window_bits = 0;
     // Stop one early because the last byte is always NULL.
     for (uint16_t i = 0; i < compressed->length - 1;) {
-        uint32_t bits = 0;
-        uint8_t bit_length = 0;
-        uint32_t max_code = lengths[0];
-        uint32_t searched_length = lengths[0];
-        while (true) {
-            bits <<= 1;
-            if ((0x80 & b) != 0) {
-                bits |= 1;
-            }
-            b <<= 1;
-            bit_length += 1;
-            if (this_bit == 0) {
-                this_bit = 7;
-                this_byte += 1;
-                b = compressed->data[this_byte]; // This may read past the end but its never used.
-            } else {
-                this_bit -= 1;
-            }
-            if (max_code > 0 && bits < max_code) {
-                break;
+        if (window_bits < 8) {
+            window |= (uint32_t) *data++ << (24 - window_bits);
+            window_bits += 8;
+        }
+        uint16_t value_index;
+        #if CIRCUITPY_TRANSLATE_DECODE_TABLE
+        uint16_t entry = decode_table[window >> 24];
+        if (entry != 0) {
+            uint8_t code_length = entry >> 12;
+            window <<= code_length;
+            window_bits -= code_length;
+            value_index = entry & 0xfff;
+        } else
+        #endif
+        {
+            // Codes of each length follow those of the length before so they're found by
+            // counting codes as the bits come in.
+            uint32_t bits = 0;
+            uint8_t bit_length = 0;
+            uint32_t max_code = lengths[0];
+            uint32_t searched_length = lengths[0];
+            while (true) {
+                if (window_bits == 0) {
+                    window = (uint32_t) *data++ << 24;
+                    window_bits = 8;
+                }
+                bits = (bits << 1) | (window >> 31);
+                window <<= 1;
+                window_bits -= 1;
+                bit_length += 1;
+                if (max_code > 0 && bits < max_code) {
+                    break;
+                }
+                max_code = (max_code << 1) + lengths[bit_length];
+                searched_length += lengths[bit_length];
             }
-            max_code = (max_code << 1) + lengths[bit_length];
-            searched_length += lengths[bit_length];
+            value_index = searched_length + bits - max_code;
         }
-        i += put_utf8(decompressed + i, values[searched_length + bits - max_code]);
+        i += put_utf8(decompressed + i, values[value_index]);
     }
 
     decompressed[compressed->length-1] = '\0';
+    #if CIRCUITPY_TRANSLATE_CACHE_ENTRIES > 0
+    cache_put(compressed, decompressed);
+    #endif
     return decompressed;
 }
 
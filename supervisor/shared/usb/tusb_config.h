@@ -72,7 +72,12 @@
 #define CFG_TUD_DESC_AUTO           0
 
 //------------- CLASS -------------//
+// The second CDC is usb_cdc.data.
+#if CIRCUITPY_USB_CDC
+#define CFG_TUD_CDC                 2
+#else
 #define CFG_TUD_CDC                 1
+#endif
 #define CFG_TUD_MSC                 1
 #define CFG_TUD_HID                 1
 #define CFG_TUD_MIDI                1
@@ -89,6 +94,13 @@
  */
 #define CFG_TUD_CDC_FLUSH_ON_SOF    0
 
+#if CIRCUITPY_USB_CDC
+// Room for several full speed bulk packets so usb_cdc.data keeps the endpoints busy between USB
+// tasks. The console gets the same size because the FIFOs are sized for all CDCs at once.
+#define CFG_TUD_CDC_RX_BUFSIZE      256
+#define CFG_TUD_CDC_TX_BUFSIZE      256
+#endif
+
 
 /*------------- MSC -------------*/
 // Number of supported Logical Unit Number (At least 1)
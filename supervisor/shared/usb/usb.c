@@ -27,14 +27,27 @@
 #include "tick.h"
 #include "py/objstr.h"
 #include "shared-bindings/microcontroller/Processor.h"
+#include "shared-module/usb_hid/Device.h"
 #include "shared-module/usb_midi/__init__.h"
 #include "supervisor/port.h"
 #include "supervisor/usb.h"
+#include "supervisor/shared/background_task.h"
+#if CIRCUITPY_BOOT_TIMING
+#include "supervisor/shared/boot_timing.h"
+#endif
 #include "lib/utils/interrupt_char.h"
 #include "lib/mp-readline/readline.h"
 
 #include "tusb.h"
 
+static background_task_t usb_task;
+
+#if CIRCUITPY_USB_IRQ_TASK
+static volatile uint8_t usb_lock_depth;
+static volatile bool usb_irq_task_deferred;
+static volatile bool usb_irq_task_running;
+#endif
+
 // Serial number as hex characters. This writes directly to the USB
 // descriptor.
 extern uint16_t usb_serial_number[1 + COMMON_HAL_MCU_PROCESSOR_UID_LENGTH * 2];
@@ -72,21 +85,85 @@ void usb_init(void) {
 #if CIRCUITPY_USB_MIDI
     usb_midi_init();
 #endif
+
+    // TinyUSB queues its events from the USB interrupt, so poll it every tick.
+    background_task_add(&usb_task, usb_background, BACKGROUND_TASK_PRIORITY_USB, 1);
+}
+
+// The parts of the USB work that are safe to do from an interrupt.
+static void usb_task_process(void) {
+    tud_task();
+    #if CIRCUITPY_USB_HID
+    usb_hid_background();
+    #endif
+    usb_serial_background();
+    tud_cdc_write_flush();
+    #if CIRCUITPY_USB_CDC
+    tud_cdc_n_write_flush(1);
+    #endif
 }
 
 void usb_background(void) {
     if (usb_enabled()) {
-        tud_task();
-        tud_cdc_write_flush();
+        usb_lock();
+        usb_task_process();
+        // Writing to the filesystem is slow, so it's left to the VM.
+        usb_msc_background();
+        usb_unlock();
     }
 }
 
+void usb_background_schedule(void) {
+    background_task_set_pending(&usb_task);
+    #if CIRCUITPY_USB_IRQ_TASK
+    usb_irq_task_trigger();
+    #endif
+}
+
+#if CIRCUITPY_USB_IRQ_TASK
+// If the interrupt comes in between the read and the write of the depth, it leaves the depth as it
+// found it, so no critical section is needed.
+void usb_lock(void) {
+    usb_lock_depth++;
+}
+
+void usb_unlock(void) {
+    usb_lock_depth--;
+    if (usb_lock_depth == 0 && usb_irq_task_deferred) {
+        usb_irq_task_deferred = false;
+        usb_irq_task_trigger();
+    }
+}
+
+bool usb_in_irq_task(void) {
+    return usb_irq_task_running;
+}
+
+void usb_irq_task(void) {
+    if (usb_lock_depth > 0) {
+        usb_irq_task_deferred = true;
+        return;
+    }
+    if (!usb_enabled()) {
+        return;
+    }
+    usb_irq_task_running = true;
+    usb_lock_depth++;
+    usb_task_process();
+    usb_lock_depth--;
+    usb_irq_task_running = false;
+}
+#endif
+
 //--------------------------------------------------------------------+
 // tinyusb callbacks
 //--------------------------------------------------------------------+
 
 // Invoked when device is mounted
 void tud_mount_cb(void) {
+    #if CIRCUITPY_BOOT_TIMING
+    boot_timing_mark(BOOT_PHASE_USB_ENUMERATED);
+    #endif
     usb_msc_mount();
 }
 
@@ -108,7 +185,10 @@ void tud_resume_cb(void) {
 // Invoked when cdc when line state changed e.g connected/disconnected
 // Use to reset to DFU when disconnect with 1200 bps
 void tud_cdc_line_state_cb(uint8_t itf, bool dtr, bool rts) {
-    (void) itf; // interface ID, not used
+    // Only the console resets to the bootloader. usb_cdc.data is left to user code.
+    if (itf != 0) {
+        return;
+    }
 
     // DTR = false is counted as disconnected
     if ( !dtr )
@@ -132,7 +212,11 @@ void tud_cdc_line_state_cb(uint8_t itf, bool dtr, bool rts) {
  */
 void tud_cdc_rx_wanted_cb(uint8_t itf, char wanted_char)
 {
-    (void) itf; // not used
+    // Ctrl-C is only special on the console. The wanted char is never set for usb_cdc.data, but
+    // check anyway.
+    if (itf != 0) {
+        return;
+    }
 
     // Workaround for using lib/utils/interrupt_char.c
     // Compare mp_interrupt_char with wanted_char and ignore if not matched
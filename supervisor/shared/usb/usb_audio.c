@@ -0,0 +1,207 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// A USB Audio Class 1.0 function: a stereo speaker the host plays to and a stereo microphone
+// the host records from. TinyUSB has no audio class driver so this is an application driver.
+// It only moves packets; shared-module/usb_audio buffers them and paces the host.
+
+#include <string.h>
+
+#include "genhdr/autogen_usb_descriptor.h"
+#include "shared-module/usb_audio/__init__.h"
+
+#include "tusb.h"
+#include "device/usbd_pvt.h"
+
+#define AUDIO_REQUEST_SET_CUR 0x01
+#define AUDIO_REQUEST_GET_CUR 0x81
+#define AUDIO_EP_CONTROL_SAMPLING_FREQ 0x01
+
+CFG_TUSB_MEM_SECTION CFG_TUSB_MEM_ALIGN static uint8_t speaker_packet[USB_AUDIO_SPEAKER_MAX_PACKET_SIZE];
+CFG_TUSB_MEM_SECTION CFG_TUSB_MEM_ALIGN static uint8_t microphone_packet[USB_AUDIO_MICROPHONE_MAX_PACKET_SIZE];
+CFG_TUSB_MEM_SECTION CFG_TUSB_MEM_ALIGN static uint8_t feedback_packet[3];
+CFG_TUSB_MEM_SECTION CFG_TUSB_MEM_ALIGN static uint8_t sampling_freq[3];
+
+static bool speaker_streaming;
+static bool microphone_streaming;
+
+static bool queue_speaker(uint8_t rhport) {
+    return usbd_edpt_xfer(rhport, USB_AUDIO_SPEAKER_EP, speaker_packet, sizeof(speaker_packet));
+}
+
+static bool queue_feedback(uint8_t rhport) {
+    uint32_t feedback = usb_audio_speaker_feedback();
+    feedback_packet[0] = feedback & 0xff;
+    feedback_packet[1] = (feedback >> 8) & 0xff;
+    feedback_packet[2] = (feedback >> 16) & 0xff;
+    return usbd_edpt_xfer(rhport, USB_AUDIO_FEEDBACK_EP, feedback_packet, sizeof(feedback_packet));
+}
+
+static bool queue_microphone(uint8_t rhport) {
+    uint16_t length = usb_audio_microphone_packet(microphone_packet, sizeof(microphone_packet));
+    return usbd_edpt_xfer(rhport, USB_AUDIO_MICROPHONE_EP, microphone_packet, length);
+}
+
+static void audio_init(void) {
+    speaker_streaming = false;
+    microphone_streaming = false;
+}
+
+static void audio_reset(uint8_t rhport) {
+    (void) rhport;
+    audio_init();
+    usb_audio_speaker_set_streaming(false);
+    usb_audio_microphone_set_streaming(false);
+}
+
+static uint16_t audio_open(uint8_t rhport, tusb_desc_interface_t const* itf_desc, uint16_t max_len) {
+    if (itf_desc->bInterfaceNumber != USB_AUDIO_CONTROL_INTERFACE ||
+        max_len < USB_AUDIO_DESCRIPTOR_LENGTH) {
+        return 0;
+    }
+    // Claim all three interfaces and open the endpoints of the streaming alternates now. The
+    // host can only use them after selecting those alternates.
+    uint8_t const* p_desc = (uint8_t const*) itf_desc;
+    uint8_t const* end = p_desc + USB_AUDIO_DESCRIPTOR_LENGTH;
+    while (p_desc < end) {
+        if (tu_desc_type(p_desc) == TUSB_DESC_ENDPOINT &&
+            !usbd_edpt_open(rhport, (tusb_desc_endpoint_t const*) p_desc)) {
+            return 0;
+        }
+        p_desc = tu_desc_next(p_desc);
+    }
+    return USB_AUDIO_DESCRIPTOR_LENGTH;
+}
+
+static bool set_interface(uint8_t rhport, uint8_t interface, uint8_t alternate) {
+    bool streaming = alternate == 1;
+    if (interface == USB_AUDIO_SPEAKER_INTERFACE) {
+        usb_audio_speaker_set_streaming(streaming);
+        if (streaming && !speaker_streaming) {
+            speaker_streaming = true;
+            return queue_speaker(rhport) && queue_feedback(rhport);
+        }
+        // Transfers already queued finish on their own and aren't queued again.
+        speaker_streaming = streaming;
+        return true;
+    }
+    if (interface == USB_AUDIO_MICROPHONE_INTERFACE) {
+        usb_audio_microphone_set_streaming(streaming);
+        if (streaming && !microphone_streaming) {
+            microphone_streaming = true;
+            return queue_microphone(rhport);
+        }
+        microphone_streaming = streaming;
+        return true;
+    }
+    return alternate == 0;
+}
+
+static bool audio_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const* request) {
+    if (request->bmRequestType_bit.type == TUSB_REQ_TYPE_STANDARD &&
+        request->bmRequestType_bit.recipient == TUSB_REQ_RCPT_INTERFACE) {
+        if (stage != CONTROL_STAGE_SETUP) {
+            return true;
+        }
+        uint8_t interface = tu_u16_low(request->wIndex);
+        if (request->bRequest == TUSB_REQ_SET_INTERFACE) {
+            if (request->wValue > 1 || !set_interface(rhport, interface, request->wValue)) {
+                return false;
+            }
+            tud_control_status(rhport, request);
+            return true;
+        }
+        if (request->bRequest == TUSB_REQ_GET_INTERFACE) {
+            static uint8_t alternate;
+            alternate = (interface == USB_AUDIO_SPEAKER_INTERFACE && speaker_streaming) ||
+                        (interface == USB_AUDIO_MICROPHONE_INTERFACE && microphone_streaming);
+            return tud_control_xfer(rhport, request, &alternate, 1);
+        }
+        return false;
+    }
+
+    // The only other request is for the sampling frequency, which is fixed.
+    if (request->bmRequestType_bit.type != TUSB_REQ_TYPE_CLASS ||
+        request->bmRequestType_bit.recipient != TUSB_REQ_RCPT_ENDPOINT ||
+        tu_u16_high(request->wValue) != AUDIO_EP_CONTROL_SAMPLING_FREQ ||
+        request->wLength != sizeof(sampling_freq)) {
+        return false;
+    }
+    uint8_t endpoint = tu_u16_low(request->wIndex);
+    uint32_t sample_rate = endpoint == USB_AUDIO_MICROPHONE_EP ? USB_AUDIO_MICROPHONE_SAMPLE_RATE :
+                                                                 USB_AUDIO_SAMPLE_RATE;
+    if (request->bRequest == AUDIO_REQUEST_GET_CUR) {
+        if (stage == CONTROL_STAGE_SETUP) {
+            sampling_freq[0] = sample_rate & 0xff;
+            sampling_freq[1] = (sample_rate >> 8) & 0xff;
+            sampling_freq[2] = (sample_rate >> 16) & 0xff;
+            return tud_control_xfer(rhport, request, sampling_freq, sizeof(sampling_freq));
+        }
+        return true;
+    }
+    if (request->bRequest == AUDIO_REQUEST_SET_CUR) {
+        if (stage == CONTROL_STAGE_SETUP) {
+            return tud_control_xfer(rhport, request, sampling_freq, sizeof(sampling_freq));
+        }
+        if (stage == CONTROL_STAGE_DATA) {
+            // Only the advertised rate is accepted.
+            uint32_t requested = sampling_freq[0] | (sampling_freq[1] << 8) | (sampling_freq[2] << 16);
+            return requested == sample_rate;
+        }
+        return true;
+    }
+    return false;
+}
+
+static bool audio_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes) {
+    if (ep_addr == USB_AUDIO_SPEAKER_EP) {
+        if (result == XFER_RESULT_SUCCESS) {
+            usb_audio_speaker_received(speaker_packet, xferred_bytes);
+        }
+        return !speaker_streaming || queue_speaker(rhport);
+    }
+    if (ep_addr == USB_AUDIO_FEEDBACK_EP) {
+        return !speaker_streaming || queue_feedback(rhport);
+    }
+    if (ep_addr == USB_AUDIO_MICROPHONE_EP) {
+        return !microphone_streaming || queue_microphone(rhport);
+    }
+    return false;
+}
+
+static const usbd_class_driver_t audio_driver = {
+    .init = audio_init,
+    .reset = audio_reset,
+    .open = audio_open,
+    .control_xfer_cb = audio_control_xfer_cb,
+    .xfer_cb = audio_xfer_cb,
+    .sof = NULL,
+};
+
+usbd_class_driver_t const* usbd_app_driver_get_cb(uint8_t* driver_count) {
+    *driver_count = 1;
+    return &audio_driver;
+}
@@ -36,11 +36,29 @@
 
 #include "supervisor/filesystem.h"
 #include "supervisor/shared/autoreload.h"
+#include "supervisor/usb.h"
 
 #define MSC_FLASH_BLOCK_SIZE    512
 
+// Blocks written by the host are staged here and acknowledged right away.
+// usb_msc_background() then writes them to the filesystem one at a time.
+#ifndef CIRCUITPY_USB_MSC_STAGED_BLOCKS
+#if CIRCUITPY_FULL_BUILD
+#define CIRCUITPY_USB_MSC_STAGED_BLOCKS (8)
+#else
+#define CIRCUITPY_USB_MSC_STAGED_BLOCKS (2)
+#endif
+#endif
+
 static bool ejected[1];
 
+// A ring of staged blocks, oldest first. Each lba is staged at most once.
+static uint8_t staged_data[CIRCUITPY_USB_MSC_STAGED_BLOCKS][MSC_FLASH_BLOCK_SIZE];
+static uint32_t staged_lba[CIRCUITPY_USB_MSC_STAGED_BLOCKS];
+static uint8_t staged_lun[CIRCUITPY_USB_MSC_STAGED_BLOCKS];
+static uint8_t staged_first;
+static uint8_t staged_count;
+
 void usb_msc_mount(void) {
     // Reset the ejection tracking every time we're plugged into USB. This allows for us to battery
     // power the device, eject, unplug and plug it back in to get the drive.
@@ -70,6 +88,39 @@ static fs_user_mount_t* get_vfs(int lun) {
     return current_mount->obj;
 }
 
+static int staged_index(uint8_t lun, uint32_t lba) {
+    for (uint8_t i = 0; i < staged_count; i++) {
+        uint8_t index = (staged_first + i) % CIRCUITPY_USB_MSC_STAGED_BLOCKS;
+        if (staged_lba[index] == lba && staged_lun[index] == lun) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+// Write the oldest staged block to the filesystem.
+static void write_staged_block(void) {
+    fs_user_mount_t * vfs = get_vfs(staged_lun[staged_first]);
+    if (vfs != NULL) {
+        disk_write(vfs, staged_data[staged_first], staged_lba[staged_first], 1);
+    }
+    staged_first = (staged_first + 1) % CIRCUITPY_USB_MSC_STAGED_BLOCKS;
+    staged_count--;
+}
+
+static void write_staged_blocks(void) {
+    while (staged_count > 0) {
+        write_staged_block();
+    }
+}
+
+void usb_msc_background(void) {
+    // One block at a time keeps the VM responsive during big copies.
+    if (staged_count > 0) {
+        write_staged_block();
+    }
+}
+
 // Callback invoked when received an SCSI command not in built-in list below
 // - READ_CAPACITY10, READ_FORMAT_CAPACITY, INQUIRY, TEST_UNIT_READY, START_STOP_UNIT, MODE_SENSE6, REQUEST_SENSE
 // - READ10 and WRITE10 have their own callbacks
@@ -136,6 +187,14 @@ int32_t tud_msc_read10_cb (uint8_t lun, uint32_t lba, uint32_t offset, void* buf
 
     fs_user_mount_t * vfs = get_vfs(lun);
     disk_read(vfs, buffer, lba, block_count);
+    // Blocks that haven't been written yet come from the staging area.
+    for (uint8_t i = 0; i < staged_count; i++) {
+        uint8_t index = (staged_first + i) % CIRCUITPY_USB_MSC_STAGED_BLOCKS;
+        if (staged_lun[index] == lun && staged_lba[index] >= lba && staged_lba[index] < lba + block_count) {
+            memcpy((uint8_t*) buffer + (staged_lba[index] - lba) * MSC_FLASH_BLOCK_SIZE,
+                   staged_data[index], MSC_FLASH_BLOCK_SIZE);
+        }
+    }
 
     return block_count * MSC_FLASH_BLOCK_SIZE;
 }
@@ -149,7 +208,24 @@ int32_t tud_msc_write10_cb (uint8_t lun, uint32_t lba, uint32_t offset, uint8_t*
     const uint32_t block_count = bufsize / MSC_FLASH_BLOCK_SIZE;
 
     fs_user_mount_t * vfs = get_vfs(lun);
-    disk_write(vfs, buffer, lba, block_count);
+    // Stage the blocks so the host can send more while they're written. A
+    // block that's already staged is replaced. When the staging area is full
+    // the oldest block is written now, which holds off the host until there's
+    // room. (Returning 0 to report busy makes TinyUSB retry straight away
+    // within the same tud_task(), so it can't be used to wait.)
+    for (uint32_t i = 0; i < block_count; i++) {
+        int index = staged_index(lun, lba + i);
+        if (index < 0) {
+            if (staged_count == CIRCUITPY_USB_MSC_STAGED_BLOCKS) {
+                write_staged_block();
+            }
+            index = (staged_first + staged_count) % CIRCUITPY_USB_MSC_STAGED_BLOCKS;
+            staged_lba[index] = lba + i;
+            staged_lun[index] = lun;
+            staged_count++;
+        }
+        memcpy(staged_data[index], buffer + i * MSC_FLASH_BLOCK_SIZE, MSC_FLASH_BLOCK_SIZE);
+    }
     // Since by getting here we assume the mount is read-only to
     // MicroPython let's update the cached FatFs sector if it's the one
     // we just wrote.
@@ -164,6 +240,15 @@ int32_t tud_msc_write10_cb (uint8_t lun, uint32_t lba, uint32_t offset, uint8_t*
                    buffer + MSC_FLASH_BLOCK_SIZE * (vfs->fatfs.winsect - lba),
                    MSC_FLASH_BLOCK_SIZE);
         }
+        #if _FS_WINCACHE
+        // Sectors FatFs keeps beyond its window are simply forgotten.
+        for (size_t i = 0; i < _FS_WINCACHE; i++) {
+            if (vfs->fatfs.wcsect[i] - lba < block_count) {
+                vfs->fatfs.wcsect[i] = 0xFFFFFFFF;
+                vfs->fatfs.wcused[i] = 0;
+            }
+        }
+        #endif
     }
 
     return block_count * MSC_FLASH_BLOCK_SIZE;
@@ -220,6 +305,7 @@ bool tud_msc_start_stop_cb(uint8_t lun, uint8_t power_condition, bool start, boo
     if (load_eject) {
         if (!start) {
             // Eject but first flush.
+            write_staged_blocks();
             if (disk_ioctl(current_mount, CTRL_SYNC, NULL) != RES_OK) {
                 return false;
             } else {
@@ -232,6 +318,7 @@ bool tud_msc_start_stop_cb(uint8_t lun, uint8_t power_condition, bool start, boo
     } else {
         if (!start) {
             // Stop the unit but don't eject.
+            write_staged_blocks();
             if (disk_ioctl(current_mount, CTRL_SYNC, NULL) != RES_OK) {
                 return false;
             }
@@ -0,0 +1,63 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "supervisor/memory.h"
+
+#include <stdlib.h>
+
+// Allocations come from the C heap, which is separate from the VM heap already, so they never
+// need to move.
+
+void memory_init(void) {
+}
+
+supervisor_allocation* allocate_memory(uint32_t length, bool high_address, bool movable) {
+    (void) high_address;
+    (void) movable;
+    supervisor_allocation* allocation = malloc(sizeof(supervisor_allocation));
+    if (allocation == NULL) {
+        return NULL;
+    }
+    allocation->ptr = malloc(length);
+    if (allocation->ptr == NULL) {
+        free(allocation);
+        return NULL;
+    }
+    allocation->length = length;
+    return allocation;
+}
+
+supervisor_allocation* allocate_remaining_memory(void) {
+    return NULL;
+}
+
+void free_memory(supervisor_allocation* allocation) {
+    free(allocation->ptr);
+    free(allocation);
+}
+
+void supervisor_move_memory(void) {
+}
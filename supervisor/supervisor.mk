@@ -2,6 +2,7 @@ SRC_SUPERVISOR = \
 	main.c \
 	supervisor/port.c \
 	supervisor/shared/autoreload.c \
+	supervisor/shared/background_task.c \
 	supervisor/shared/display.c \
 	supervisor/shared/filesystem.c \
 	supervisor/shared/flash.c \
@@ -36,6 +37,22 @@ ifeq ($(CIRCUITPY_BLEIO),1)
 	SRC_SUPERVISOR += supervisor/shared/bluetooth.c
 endif
 
+ifeq ($(CIRCUITPY_PROFILER),1)
+	SRC_SUPERVISOR += supervisor/shared/profiler.c
+endif
+
+ifeq ($(CIRCUITPY_BACKGROUND_TRACE),1)
+	SRC_SUPERVISOR += supervisor/shared/background_trace.c
+endif
+
+ifeq ($(CIRCUITPY_HEAP_IMAGE),1)
+	SRC_SUPERVISOR += supervisor/shared/heap_image.c
+endif
+
+ifeq ($(CIRCUITPY_BOOT_TIMING),1)
+	SRC_SUPERVISOR += supervisor/shared/boot_timing.c
+endif
+
 # Choose which flash filesystem impl to use.
 # (Right now INTERNAL_FLASH_FILESYSTEM and (Q)SPI_FLASH_FILESYSTEM are mutually exclusive.
 # But that might not be true in the future.)
@@ -92,6 +109,25 @@ else
 		shared-module/usb_midi/PortOut.c \
 		$(BUILD)/autogen_usb_descriptor.c
 
+	ifeq ($(CIRCUITPY_USB_CDC),1)
+		SRC_SUPERVISOR += \
+			shared-bindings/usb_cdc/__init__.c \
+			shared-bindings/usb_cdc/Serial.c \
+			shared-module/usb_cdc/__init__.c \
+			shared-module/usb_cdc/Serial.c
+	endif
+
+	ifeq ($(CIRCUITPY_USB_AUDIO),1)
+		SRC_SUPERVISOR += \
+			supervisor/shared/usb/usb_audio.c \
+			shared-bindings/usb_audio/__init__.c \
+			shared-bindings/usb_audio/Microphone.c \
+			shared-bindings/usb_audio/Speaker.c \
+			shared-module/usb_audio/__init__.c \
+			shared-module/usb_audio/Microphone.c \
+			shared-module/usb_audio/Speaker.c
+	endif
+
 	CFLAGS += -DUSB_AVAILABLE
 endif
 
@@ -123,6 +159,18 @@ ifndef USB_CDC_EP_NUM_DATA_IN
 USB_CDC_EP_NUM_DATA_IN = 0
 endif
 
+ifndef USB_CDC2_EP_NUM_NOTIFICATION
+USB_CDC2_EP_NUM_NOTIFICATION = 0
+endif
+
+ifndef USB_CDC2_EP_NUM_DATA_OUT
+USB_CDC2_EP_NUM_DATA_OUT = 0
+endif
+
+ifndef USB_CDC2_EP_NUM_DATA_IN
+USB_CDC2_EP_NUM_DATA_IN = 0
+endif
+
 ifndef USB_MSC_EP_NUM_OUT
 USB_MSC_EP_NUM_OUT = 0
 endif
@@ -147,6 +195,23 @@ ifndef USB_MIDI_EP_NUM_IN
 USB_MIDI_EP_NUM_IN = 0
 endif
 
+ifndef USB_AUDIO_SAMPLE_RATE
+USB_AUDIO_SAMPLE_RATE = 48000
+endif
+
+# 0 sends the microphone at USB_AUDIO_SAMPLE_RATE too.
+ifndef USB_AUDIO_MICROPHONE_SAMPLE_RATE
+USB_AUDIO_MICROPHONE_SAMPLE_RATE = 0
+endif
+
+ifndef USB_AUDIO_EP_NUM_OUT
+USB_AUDIO_EP_NUM_OUT = 0
+endif
+
+ifndef USB_AUDIO_EP_NUM_IN
+USB_AUDIO_EP_NUM_IN = 0
+endif
+
 USB_DESCRIPTOR_ARGS = \
 	--manufacturer $(USB_MANUFACTURER)\
 	--product $(USB_PRODUCT)\
@@ -160,6 +225,9 @@ USB_DESCRIPTOR_ARGS = \
 	--cdc_ep_num_notification $(USB_CDC_EP_NUM_NOTIFICATION)\
 	--cdc_ep_num_data_out $(USB_CDC_EP_NUM_DATA_OUT)\
 	--cdc_ep_num_data_in $(USB_CDC_EP_NUM_DATA_IN)\
+	--cdc2_ep_num_notification $(USB_CDC2_EP_NUM_NOTIFICATION)\
+	--cdc2_ep_num_data_out $(USB_CDC2_EP_NUM_DATA_OUT)\
+	--cdc2_ep_num_data_in $(USB_CDC2_EP_NUM_DATA_IN)\
 	--msc_ep_num_out $(USB_MSC_EP_NUM_OUT)\
 	--msc_ep_num_in $(USB_MSC_EP_NUM_IN)\
 	--hid_ep_num_out $(USB_HID_EP_NUM_OUT)\
@@ -173,6 +241,20 @@ ifeq ($(USB_RENUMBER_ENDPOINTS), 0)
 USB_DESCRIPTOR_ARGS += --no-renumber_endpoints
 endif
 
+# usb_cdc.data is the second CDC interface.
+ifeq ($(CIRCUITPY_USB_CDC),1)
+USB_DESCRIPTOR_ARGS += --cdc2
+endif
+
+ifeq ($(CIRCUITPY_USB_AUDIO),1)
+USB_DESCRIPTOR_ARGS += \
+	--uac\
+	--uac_sample_rate $(USB_AUDIO_SAMPLE_RATE)\
+	--uac_microphone_sample_rate $(USB_AUDIO_MICROPHONE_SAMPLE_RATE)\
+	--uac_ep_num_out $(USB_AUDIO_EP_NUM_OUT)\
+	--uac_ep_num_in $(USB_AUDIO_EP_NUM_IN)
+endif
+
 SUPERVISOR_O = $(addprefix $(BUILD)/, $(SRC_SUPERVISOR:.c=.o)) $(BUILD)/autogen_display_resources.o
 
 $(BUILD)/supervisor/shared/translate.o: $(HEADER_BUILD)/qstrdefs.generated.h
@@ -45,4 +45,33 @@ void usb_init(void);
 void usb_msc_mount(void);
 void usb_msc_umount(void);
 
+// Write blocks the host has sent to the filesystem.
+void usb_msc_background(void);
+
+// Move buffered serial output into the CDC FIFO.
+void usb_serial_background(void);
+
+// Run usb_background soon, without waiting for the next tick.
+void usb_background_schedule(void);
+
+#if CIRCUITPY_USB_IRQ_TASK
+// TinyUSB's task also runs from the port's lowest priority interrupt, so USB keeps working while
+// the VM is busy in long native operations. Code outside that interrupt must hold the USB lock
+// while it calls TinyUSB or reads and writes a filesystem that MSC exposes. The interrupt waits
+// until the lock is released. The lock nests.
+void usb_lock(void);
+void usb_unlock(void);
+// True while usb_irq_task() is running.
+bool usb_in_irq_task(void);
+// Called by the port from its lowest priority interrupt.
+void usb_irq_task(void);
+// Implemented by the port to make that interrupt pending.
+void usb_irq_task_trigger(void);
+#else
+static inline void usb_lock(void) {
+}
+static inline void usb_unlock(void) {
+}
+#endif
+
 #endif // MICROPY_INCLUDED_SUPERVISOR_USB_H
@@ -0,0 +1,61 @@
+# test elementwise operations and reductions over integer arrays
+
+try:
+    import array
+    array.add
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+a = array.array("h", [1, -2, 30000, -30000, 5, 7, 9])
+b = array.array("h", [10, 20, 10000, -10000, -5, 0, 1])
+
+# results saturate to the range of the output
+print(array.add(a, b))
+print(array.sub(a, b))
+print(array.mul(a, b))
+print(array.add(a, 3), array.sub(a, 1 << 40), array.mul(a, -2))
+print(array.clamp(a, -10, 10))
+
+u = array.array("B", [0, 100, 200, 250, 3])
+print(array.add(u, u), array.sub(u, 150), array.mul(u, 300))
+
+# output of another typecode, and in place
+w = array.array("i", [0] * len(u))
+print(array.mul(u, u, w))
+array.add(a, 1, a)
+print(a)
+
+# bytes and memoryviews
+print(array.add(b"\x01\x02\xff", 1))
+m = memoryview(a)[2:5]
+print(array.sum(m), array.min(m), array.max(m))
+array.sub(m, 1, m)
+print(a)
+
+# reductions
+print(array.sum(a), array.min(a), array.max(a), array.dot(a, b))
+print(array.sum(array.array("I", [0xffffffff] * 4)))
+print(array.sum(array.array("b")))
+
+# moving average, truncated towards zero
+c = array.array("h", [1, 2, 3, 4, 5, 6, -7, -8])
+print(array.moving_average(c, 1), array.moving_average(c, 3), array.moving_average(c, 8))
+array.moving_average(c, 2, memoryview(c)[:7])
+print(c)
+
+# errors
+for f, args in (
+    (array.add, (a, u)),
+    (array.add, (a, a, array.array("h", [0]))),
+    (array.dot, (a, 1)),
+    (array.min, (array.array("h"),)),
+    (array.moving_average, (a, 0)),
+    (array.moving_average, (a, 8)),
+    (array.add, (array.array("q", [1]), 1)),
+    (array.add, (a, 1, b"1234567")),
+):
+    try:
+        f(*args)
+    except (ValueError, TypeError) as e:
+        print(type(e).__name__)
@@ -0,0 +1,54 @@
+# test sequences the compiler may fuse into superinstructions
+
+def pair(a, b):
+    return a + b, a < b
+
+print(pair(1, 2))
+print(pair("a", "b"))
+
+class A:
+    x = 1
+    def f(self):
+        return self.x + 1
+
+def attr(o):
+    return o.x, o.f()
+
+print(attr(A()))
+
+def small(x):
+    return x + 1, x - 3, x < 4, x > -2, x == 7, x != 7
+
+print(small(7))
+print(small(-5))
+print(small(1.5))
+print(small(0x3fffffff))
+print(small(-0x40000000))
+
+def inplace(x):
+    x += 15
+    x -= 16
+    return x
+
+print(inplace(10))
+print(inplace(-2**40))
+
+def unbound_pair():
+    if False:
+        a = b = 1
+    return a + b
+
+try:
+    unbound_pair()
+except NameError:
+    print('NameError')
+
+def unbound_attr():
+    if False:
+        o = 1
+    return o.x
+
+try:
+    unbound_attr()
+except NameError:
+    print('NameError')
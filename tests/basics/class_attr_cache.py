@@ -0,0 +1,54 @@
+# class attribute lookups must see changes to classes made after earlier lookups
+
+class A:
+    def f(self):
+        return "A.f"
+
+class B(A):
+    pass
+
+b = B()
+for i in range(3):
+    print(b.f())
+
+# shadow the inherited method in the subclass
+B.f = lambda self: "B.f"
+print(b.f())
+
+# remove it again
+del B.f
+print(b.f())
+
+# change the base class
+A.f = lambda self: "new A.f"
+print(b.f())
+
+# an attribute found missing, then added
+try:
+    b.g
+except AttributeError:
+    print("AttributeError")
+A.g = 1
+print(b.g)
+
+# instance members still take precedence
+b.g = 2
+print(b.g)
+del b.g
+print(b.g)
+
+# special methods
+class C:
+    def __len__(self):
+        return 1
+c = C()
+print(len(c))
+C.__len__ = lambda self: 2
+print(len(c))
+
+# a new class with the same name and methods as a collected one
+for i in range(3):
+    class D:
+        def f(self, i=i):
+            return i
+    print(D().f())
@@ -0,0 +1,97 @@
+# test classes with __slots__
+
+class A:
+    __slots__ = ('x', 'y')
+    z = 3
+
+    def __init__(self, x):
+        self.x = x
+
+    def sum(self):
+        return self.x + self.y
+
+a = A(1)
+print(a.x, a.z)
+
+# a slot that hasn't been set, and a name that isn't a slot
+try:
+    a.y
+except AttributeError:
+    print('AttributeError')
+try:
+    a.w = 2
+except AttributeError:
+    print('AttributeError')
+
+a.y = 2
+print(a.sum())
+a.x += 10
+print(a.x, a.sum())
+
+# delete a slot, then delete it again
+del a.y
+try:
+    a.y
+except AttributeError:
+    print('AttributeError')
+try:
+    del a.y
+except AttributeError:
+    print('AttributeError')
+
+# each instance has its own slots
+b = A(5)
+print(a.x, b.x)
+
+# __slots__ as a single name
+class B:
+    __slots__ = 'v'
+b = B()
+b.v = [1]
+print(b.v)
+
+# subclass with more slots
+class C(A):
+    __slots__ = ['w']
+c = C(7)
+c.y = 1
+c.w = 8
+print(c.x, c.y, c.w, c.sum(), c.z)
+try:
+    c.u = 1
+except AttributeError:
+    print('AttributeError')
+
+# subclass without __slots__ can have any attribute
+class D(A):
+    pass
+d = D(1)
+d.y = 2
+d.u = 3
+print(d.sum(), d.u)
+
+# a property in a class with __slots__
+class E:
+    __slots__ = ('_v',)
+    def __init__(self):
+        self._v = 0
+    @property
+    def v(self):
+        return self._v
+    @v.setter
+    def v(self, value):
+        self._v = value * 2
+e = E()
+e.v = 4
+print(e.v, e._v)
+
+# the same attribute load and store on instances of different layouts
+class F:
+    __slots__ = ('y', 'x')
+def get_set(o):
+    o.x = o.x + 1
+    return o.x
+f = F()
+f.x = 10
+for o in (a, f, c, d, f, a):
+    print(get_set(o))
@@ -0,0 +1,63 @@
+# comprehensions that use variables of the enclosing function
+
+def f(a, n):
+    k = 2
+    return [x * k + n for x in a]
+print(f([1, 2, 3], 10))
+
+def f(a):
+    k = 3
+    return sorted({x: x * k for x in a}.items()), sorted({x + k for x in a})
+print(f([1, 2]))
+
+# nested comprehensions
+def f(a, b):
+    k = 10
+    return [[x * k + y for y in b] for x in a]
+print(f([1, 2], [3, 4]))
+
+# also closed over by a lambda, so it must stay shared
+def f(a):
+    k = 1
+    g = lambda: k
+    l = [x + k for x in a]
+    k = 5
+    return l, g()
+print(f([1, 2]))
+
+# one variable shared with a lambda, one not
+def f(a):
+    k = 2
+    j = 3
+    g = lambda: j
+    l = [x * k * j for x in a]
+    j = 4
+    return l, g()
+print(f([1, 2]))
+
+# a comprehension inside a lambda
+def f(a):
+    k = 4
+    return (lambda: [x * k for x in a])()
+print(f([1, 2]))
+
+# the value can change between uses
+def f(a):
+    l = []
+    for k in range(3):
+        l.append([x + k for x in a])
+    return l
+print(f([10, 20]))
+
+# a variable that may be unbound is only an error if the comprehension reads it
+def f(a):
+    if a:
+        k = 2
+    return [x * k for x in a], sorted({x: k for x in a}.items()), sorted({x + k for x in a})
+print(f([]))
+print(f([1, 2]))
+def f(a):
+    if a:
+        k = 2
+    return [[y * k for y in x] for x in a]
+print(f([]))
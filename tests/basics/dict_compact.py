@@ -0,0 +1,41 @@
+# test small dicts as they grow past the compact size and get non-qstr keys
+
+d = {}
+for i in range(20):
+    d["k%d" % i] = i
+    if i % 3 == 0:
+        del d["k%d" % (i // 2)]
+print(sorted(d.items()))
+
+d = {"a": 1, "b": 2}
+d[3] = "three"
+d[(4,)] = "four"
+print(d["a"], d[3], d[(4,)], len(d))
+
+# setdefault must not see the value of a removed entry
+d = {"a": 1, "b": 2}
+del d["b"]
+print(d.setdefault("c"), sorted(d.items(), key=str))
+
+# popitem removes what it returns
+d = {"x": 1, "y": 2, "z": 3}
+k, v = d.popitem()
+print(k in d, len(d), d[k] if k in d else v)
+
+# clear and copy give working dicts
+d = {"p": 1}
+d.clear()
+for i in range(10):
+    d[str(i)] = i
+e = d.copy()
+e["q"] = 2
+print(len(d), len(e), sum(d.values()))
+
+# instance attributes
+class A:
+    pass
+a = A()
+for i in range(12):
+    setattr(a, "a%d" % i, i)
+delattr(a, "a0")
+print(sorted(a.__dict__.items()))
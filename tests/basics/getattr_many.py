@@ -0,0 +1,21 @@
+# intern enough attribute names to fill several qstr pools and look them all up again
+
+class C:
+    pass
+
+c = C()
+names = ["attr%d" % i for i in range(300)]
+for i, name in enumerate(names):
+    setattr(c, name, i)
+print(all(getattr(c, name) == i for i, name in enumerate(names)))
+
+# names that differ only in length or a late character
+for name in ("a", "aa", "aaa", "ab", "ba", "abc" * 10, "abc" * 10 + "d"):
+    setattr(c, name, len(name))
+print([getattr(c, n) for n in ("a", "aa", "aaa", "ab", "ba", "abc" * 10, "abc" * 10 + "d")])
+
+# names that are already ROM qstrs
+for name in ("append", "__init__", "from_bytes"):
+    setattr(c, name, name)
+print(c.append, c.__init__, c.from_bytes)
+print(hasattr(c, "attr300"), hasattr(c, "attr299"))
@@ -0,0 +1,35 @@
+# test multiplying and squaring integers long enough for Karatsuba's method,
+# and 3 arg pow with them
+
+# pseudo-random but repeatable values
+x = 1
+def rnd(bits):
+    global x
+    r = 0
+    while bits > 0:
+        x = (x * 1103515245 + 12345) & 0x7fffffff
+        r = (r << 16) | (x >> 8 & 0xffff)
+        bits -= 16
+    return r
+
+def check(v):
+    return (v % 1000000007, (v >> 1000) % 999983)
+
+# balanced, unbalanced and signed operands, around and well past the threshold
+for a_bits in (100, 1000, 1100, 2100, 5000):
+    for b_bits in (1000, 1024, 2048, 5000):
+        a = rnd(a_bits)
+        b = rnd(b_bits)
+        print(a_bits, b_bits, check(a * b), check(-a * b) == check(-(a * b)))
+        print(check(a * a), a * a == a ** 2, (a * b) // b == a)
+
+# operands whose digits are all ones
+for n in (1000, 1024, 1025, 4096):
+    m = (1 << n) - 1
+    print(n, check(m * m), check(m * (m >> 7)), m * m == (1 << (2 * n)) - (1 << (n + 1)) + 1)
+
+# sliding window exponentiation
+m = rnd(1024) | 1
+for e in (1, 2, 3, 255, 256, 65537, rnd(100), rnd(1024)):
+    b = rnd(1000)
+    print(pow(b, e, m) % 1000000007, pow(-b, e, m) % 1000000007, pow(b, e, -m) % 1000000007)
@@ -0,0 +1,25 @@
+# test binary ops on two small ints, including results that overflow
+
+a = 0x3fffffff
+b = -0x40000000
+one = 1
+print(a + one, b - one, a - b, b - a)
+print(a | one, a & 0x55, a ^ b, b & -one)
+print(one << 29, one << 30, one << 62, -one << 30, a << one)
+print(a >> one, b >> one, b >> 100, a >> 100)
+print(a < b, a > b, a <= a, b >= a, a == a, a != b)
+
+a += one
+print(a)
+a -= one
+a <<= 2
+print(a)
+
+try:
+    one << -one
+except ValueError:
+    print('ValueError')
+try:
+    one >> -one
+except ValueError:
+    print('ValueError')
@@ -0,0 +1,55 @@
+# test that list.sort and sorted are stable and cope with runs
+
+# pseudo-random but repeatable data
+def data(n, m):
+    x = 1
+    l = []
+    for i in range(n):
+        x = (x * 1103515245 + 12345) & 0x7fffffff
+        l.append((x % m, i))
+    return l
+
+# equal keys keep their original order, including with reverse
+for n in (10, 100, 1000):
+    l = data(n, 7)
+    s = sorted(l, key=lambda p: p[0])
+    print(all(s[i][0] < s[i + 1][0] or (s[i][0] == s[i + 1][0] and s[i][1] < s[i + 1][1]) for i in range(n - 1)))
+    s = sorted(l, key=lambda p: p[0], reverse=True)
+    print(all(s[i][0] > s[i + 1][0] or (s[i][0] == s[i + 1][0] and s[i][1] < s[i + 1][1]) for i in range(n - 1)))
+
+# runs, both ascending and descending, and data made of a few of them
+n = 500
+for l in (list(range(n)), list(range(n, 0, -1)), [i % 50 for i in range(n)], [-(i % 50) for i in range(n)],
+          list(range(n // 2)) + list(range(n // 2, 0, -1))):
+    print(sorted(l) == sorted(l, key=lambda x: x), sorted(l)[:3], sorted(l, reverse=True)[:3])
+
+# the key function is called once for each item
+calls = [0]
+def key(x):
+    calls[0] += 1
+    return -x
+l = [p[0] for p in data(300, 1000)]
+l.sort(key=key)
+print(calls[0], l[:3])
+
+# an exception from a comparison leaves the list holding all of its items
+class E(Exception):
+    pass
+class A:
+    left = 0
+    def __init__(self, x):
+        self.x = x
+    def __lt__(self, other):
+        A.left -= 1
+        if A.left == 0:
+            raise E
+        return self.x < other.x
+l = [A(p[0]) for p in data(200, 10)]
+ids = sorted(id(a) for a in l)
+for left in (1, 100):
+    A.left = left
+    try:
+        l.sort()
+    except E:
+        print('E')
+    print(sorted(id(a) for a in l) == ids)
@@ -0,0 +1,34 @@
+# test memoryview.cast
+
+try:
+    memoryview(b"").cast
+except:
+    print("SKIP")
+    raise SystemExit
+
+import array
+
+b = bytearray(range(8))
+m = memoryview(b)
+h = m.cast("H")
+print(len(h), list(h) == list(array.array("H", b)))
+
+# the view shares memory with the buffer
+h[0] = 0xffff
+print(b[:2])
+print(list(m[4:].cast("I")) == list(array.array("I", b[4:])))
+print(list(h.cast("B")) == list(b))
+
+# read-only buffers stay read-only
+r = memoryview(b"abcd").cast("h")
+try:
+    r[0] = 1
+except TypeError:
+    print("TypeError")
+
+# views must be a whole number of items, starting at a multiple of the item size
+for v, fmt in ((m[:3], "H"), (m[1:5], "I"), (m, "x"), (m, "hh")):
+    try:
+        v.cast(fmt)
+    except ValueError:
+        print("ValueError")
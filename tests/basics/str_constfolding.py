@@ -0,0 +1,26 @@
+# tests constant folding of strings, bytes, tuples and comparisons
+
+# concatenation and repetition
+print("ab" + "cd", "a" + "", "" + "")
+print("xy" * 3, "xy" * 0, "xy" * -2, "a" + "b" * 2 + "c")
+print(b"ab" + b"c", b"z" * 4)
+print(len("abcdefgh" * 100), len("a" * 1000 + "b"))
+
+# comparisons, including chained ones
+print(1 < 2, 2 < 1, 1 == 1, 1 != 1, 2 >= 2, 3 <= 2)
+print(1 < 2 < 3, 1 < 3 < 2, 3 > 2 > 1 > 0, 1 == 1 != 2)
+print("a" < "b", "a" == "a", b"b" > b"a", "ab" != "a" + "b")
+print(1 == "1", "a" in "abc", "a" not in "b")
+
+# tuples of constants
+print((1, 2), (1,), ("a", None, True, False, (3, (4,))), (1, 2) + (3,))
+print((1, 2) == (1, 2), (1, 2)[1], len((0, 1, 2, 3)))
+
+# conditions that fold away
+if 1 > 2:
+    print("not printed")
+elif "a" + "b" == "ab":
+    print("elif")
+else:
+    print("not printed")
+print(1 if 2 > 1 else 2, 1 if None else 2)
@@ -0,0 +1,26 @@
+# searching haystacks long enough to use a skip table
+
+s = "abcabd" * 20 + "abcabcabe" + "xyz" * 10
+for needle in ("abcabe", "abd", "zxyz", "eabcabd", "abcabd" * 3, "q", "abcabf", s[50:150], s):
+    print(s.find(needle), s.rfind(needle), s.count(needle), len(s.split(needle)))
+print(s.find("abd", 10, 40), s.rfind("abd", 10, 40))
+print(s.find("abd", 200), s.rfind("abd", 0, 5))
+
+# needles longer than the table's largest skip
+n = "".join(chr(48 + i % 40) for i in range(300))
+h = "-" * 500 + n + "-" * 100 + n + "+"
+print(h.find(n), h.rfind(n), h.count(n), h.find(n + "+"), h.rfind("-" + n))
+
+# periodic needles that need careful shifting
+h = "a" * 100 + "b" + "a" * 100
+print(h.find("aab"), h.rfind("baa"), h.count("aa"), h.find("aaaab"), h.rfind("baaaa"))
+
+print(s.split("abd", 3)[-1][:12])
+print(s.rsplit("abd", 3)[0][-12:])
+print(s.rsplit("abd"))
+print(s.replace("abcab", "-")[:40])
+
+b = bytes(range(256)) * 2
+print(b.find(b"\xfe\xff\x00"), b.rfind(b"\xfe\xff\x00"), b.count(b"\x10\x11"), b.find(b"\x00\x00"))
+print(b.index(b"\x80\x81"), b.rindex(b"\x80\x81"))
+print(b.split(b"\x80\x81\x82")[1][:3])
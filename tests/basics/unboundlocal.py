@@ -9,6 +9,10 @@ def f2():
         print(i)
     print(i)
 
+def f3():
+    print([i + x for i in range(1)])
+    x = 1
+
 def check(f):
     try:
         f()
@@ -17,3 +21,11 @@ def check(f):
 
 check(f1)
 check(f2)
+check(f3)
+
+def f4(a):
+    if not a:
+        k = 1
+    return [x * k for x in a]
+
+check(lambda: f4([1]))
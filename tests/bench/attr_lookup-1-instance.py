@@ -0,0 +1,15 @@
+import bench
+
+class Foo:
+
+    def __init__(self):
+        self.a = 1
+
+def test(num):
+    o = Foo()
+    for i in iter(range(num // 4)):
+        o.a
+        o.a
+        o.a
+
+bench.run(test)
@@ -0,0 +1,13 @@
+import bench
+
+class Foo:
+    a = 1
+
+def test(num):
+    o = Foo()
+    for i in iter(range(num // 4)):
+        o.a
+        o.a
+        o.a
+
+bench.run(test)
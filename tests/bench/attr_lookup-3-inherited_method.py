@@ -0,0 +1,20 @@
+import bench
+
+class A:
+    def f(self):
+        pass
+
+class B(A):
+    pass
+
+class C(B):
+    pass
+
+def test(num):
+    o = C()
+    for i in iter(range(num // 4)):
+        o.f
+        o.f
+        o.f
+
+bench.run(test)
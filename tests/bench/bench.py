@@ -1,10 +1,15 @@
-import time
+try:
+    import time
+except ImportError:
+    import utime as time
 
+# CircuitPython's time.time() only counts whole seconds
+clock = getattr(time, 'monotonic', time.time)
 
 ITERS = 20000000
 
 def run(f):
-    t = time.time()
+    t = clock()
     f(ITERS)
-    t = time.time() - t
+    t = clock() - t
     print(t)
@@ -0,0 +1,10 @@
+import bench
+
+def test(num):
+    d = {1: 1, 2: 2, 3: 3, 4: 4, 5: 5, 6: 6, 7: 7, 8: 8}
+    for i in iter(range(num // 4)):
+        d[1]
+        d[5]
+        d[8]
+
+bench.run(test)
@@ -0,0 +1,10 @@
+import bench
+
+def test(num):
+    d = {'a': 1, 'b': 2, 'c': 3, 'd': 4, 'e': 5, 'f': 6, 'g': 7, 'h': 8}
+    for i in iter(range(num // 4)):
+        'x' in d
+        'y' in d
+        'z' in d
+
+bench.run(test)
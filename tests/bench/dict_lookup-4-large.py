@@ -0,0 +1,12 @@
+import bench
+
+def test(num):
+    d = {}
+    for i in range(200):
+        d['k' + str(i)] = i
+    for i in iter(range(num // 4)):
+        d['k0']
+        d['k100']
+        d['k199']
+
+bench.run(test)
@@ -0,0 +1,11 @@
+import bench
+import gc
+
+def test(num):
+    gc.collect()
+    for i in iter(range(num // 20)):
+        bytearray(16)
+        bytearray(48)
+        [i, i]
+
+bench.run(test)
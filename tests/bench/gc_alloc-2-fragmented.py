@@ -0,0 +1,17 @@
+import bench
+import gc
+
+def test(num):
+    # leave a free block between each of the blocks that are kept
+    keep = []
+    for i in range(8000):
+        b = bytearray(16)
+        if i % 2:
+            keep.append(b)
+    gc.collect()
+    for i in iter(range(num // 20)):
+        bytearray(16)
+        bytearray(48)
+        [i, i]
+
+bench.run(test)
@@ -0,0 +1,94 @@
+# Central side of the BLE benchmarks. See README.
+
+adapter = _bleio.adapter
+prefix = bytes((17, 0x07)) + SERVICE_UUID.uuid128
+prefixes = bytes((len(prefix),)) + prefix
+address = None
+for entry in adapter.start_scan(prefixes=prefixes, timeout=10, minimum_rssi=-100):
+    address = entry.address
+    break
+adapter.stop_scan()
+if address is None:
+    raise RuntimeError("peripheral not found")
+
+connection = adapter.connect(address, timeout=10)
+if INTERVAL:
+    connection.connection_interval = INTERVAL
+if PHY:
+    connection.phy = PHY
+if DATA_LENGTH:
+    connection.data_length = DATA_LENGTH
+
+chars = []
+for service in connection.discover_remote_services((SERVICE_UUID,)):
+    chars.extend(service.characteristics)
+# Let the link settings settle.
+time.sleep(1)
+report("connection_interval", connection.connection_interval)
+report("phy", connection.phy)
+report("data_length", connection.data_length)
+
+def characteristic_for(uuid):
+    for c in chars:
+        if c.uuid == uuid:
+            return c
+    raise RuntimeError("characteristic not found")
+
+def throughput():
+    packets = _bleio.PacketBuffer(characteristic_for(PACKET_UUID), buffer_size=8 * MAX_LENGTH)
+    counter = SeqCounter()
+    buf = bytearray(MAX_LENGTH)
+    nbytes = 0
+    start = end = last = ticks_ms()
+    # Stop once the last packet arrives or nothing has come for two seconds.
+    while counter.next < COUNT and ticks_ms() - last < 2000:
+        n = packets.readinto(buf)
+        if n == 0:
+            continue
+        last = ticks_ms()
+        if counter.received == 0:
+            start = last
+        end = last
+        nbytes += n
+        counter.add(struct.unpack_from(HEADER, buf)[0])
+    counter.report()
+    report_rate(nbytes, start, end)
+
+def latency():
+    packets = _bleio.PacketBuffer(characteristic_for(PACKET_UUID), buffer_size=8 * MAX_LENGTH)
+    buf = bytearray(MAX_LENGTH)
+    last = ticks_ms()
+    while ticks_ms() - last < 2000:
+        n = packets.readinto(buf)
+        if n >= HEADER_SIZE:
+            last = ticks_ms()
+            packets.write(buf[:HEADER_SIZE])
+            if struct.unpack_from(HEADER, buf)[0] == COUNT - 1:
+                break
+
+def charbuffer():
+    stream_char = characteristic_for(STREAM_UUID)
+    size = max(HEADER_SIZE, payload_size(MAX_LENGTH))
+    stream_char.value = bytes((size,))
+    for seq in range(COUNT):
+        stream_char.value = packet(seq, size)
+
+def characteristic():
+    value_char = characteristic_for(VALUE_UUID)
+    size = max(HEADER_SIZE, payload_size(MAX_LENGTH))
+    samples = []
+    start = ticks_ms()
+    for seq in range(COUNT):
+        buf = packet(seq, size)
+        t = ticks_ms()
+        value_char.value = buf
+        samples.append(ticks_ms() - t)
+    end = ticks_ms()
+    report_rate(COUNT * size, start, end)
+    report_percentiles("write_ms", samples)
+
+globals()[MODE]()
+# Let the last packets drain before disconnecting.
+time.sleep(1)
+connection.disconnect()
+print("done")
@@ -0,0 +1,69 @@
+# Shared by peripheral.py and central.py. run-ble-bench puts CONFIG before this.
+
+import struct
+import time
+
+import _bleio
+
+config = globals().get("CONFIG", {})
+MODE = config.get("mode", "throughput")
+COUNT = config.get("count", 1000)
+PAYLOAD = config.get("payload", 0)
+INTERVAL = config.get("interval", 0)
+PHY = config.get("phy", 0)
+DATA_LENGTH = config.get("data_length", 0)
+
+SERVICE_UUID = _bleio.UUID("7c0f0001-3a6b-4c7e-9b1a-5e1f0c2d4b8a")
+PACKET_UUID = _bleio.UUID("7c0f0002-3a6b-4c7e-9b1a-5e1f0c2d4b8a")
+STREAM_UUID = _bleio.UUID("7c0f0003-3a6b-4c7e-9b1a-5e1f0c2d4b8a")
+VALUE_UUID = _bleio.UUID("7c0f0004-3a6b-4c7e-9b1a-5e1f0c2d4b8a")
+
+MAX_LENGTH = 244
+# Sequence number and send time.
+HEADER = "<II"
+HEADER_SIZE = struct.calcsize(HEADER)
+
+def ticks_ms():
+    return (time.monotonic_ns() // 1000000) & 0xffffffff
+
+def packet(seq, size):
+    buf = bytearray(size)
+    struct.pack_into(HEADER, buf, 0, seq, ticks_ms())
+    return buf
+
+def payload_size(packet_size):
+    if PAYLOAD:
+        return min(PAYLOAD, packet_size)
+    return packet_size
+
+def report(name, value):
+    print("RESULT", MODE, name, value)
+
+def report_rate(nbytes, start, end):
+    report("bytes", nbytes)
+    if end > start:
+        report("bytes_per_s", nbytes * 1000 // (end - start))
+
+def report_percentiles(name, samples):
+    if not samples:
+        return
+    samples.sort()
+    for p in (50, 90, 99):
+        report("%s_p%d" % (name, p), samples[min(len(samples) - 1, len(samples) * p // 100)])
+    report(name + "_max", samples[-1])
+
+class SeqCounter:
+    def __init__(self):
+        self.next = 0
+        self.dropped = 0
+        self.received = 0
+
+    def add(self, seq):
+        if seq > self.next:
+            self.dropped += seq - self.next
+        self.next = seq + 1
+        self.received += 1
+
+    def report(self):
+        report("packets", self.received)
+        report("dropped", self.dropped + max(0, COUNT - self.next))
@@ -0,0 +1,92 @@
+# Peripheral side of the BLE benchmarks. See README.
+
+adapter = _bleio.adapter
+service = _bleio.Service(SERVICE_UUID)
+packet_char = _bleio.Characteristic.add_to_service(
+    service, PACKET_UUID,
+    properties=_bleio.Characteristic.NOTIFY | _bleio.Characteristic.WRITE_NO_RESPONSE,
+    max_length=MAX_LENGTH)
+stream_char = _bleio.Characteristic.add_to_service(
+    service, STREAM_UUID, properties=_bleio.Characteristic.WRITE_NO_RESPONSE,
+    max_length=MAX_LENGTH)
+value_char = _bleio.Characteristic.add_to_service(
+    service, VALUE_UUID, properties=_bleio.Characteristic.WRITE | _bleio.Characteristic.READ,
+    max_length=MAX_LENGTH)
+packets = _bleio.PacketBuffer(packet_char, buffer_size=4 * MAX_LENGTH)
+stream = _bleio.CharacteristicBuffer(stream_char, buffer_size=8 * MAX_LENGTH)
+
+advertisement = bytes((2, 0x01, 0x06, 17, 0x07)) + SERVICE_UUID.uuid128
+adapter.start_advertising(advertisement)
+while not adapter.connected:
+    pass
+print("connected")
+
+def wait_for_subscriber():
+    while adapter.connected and packets.packet_size == 0:
+        pass
+
+def throughput():
+    wait_for_subscriber()
+    size = payload_size(packets.packet_size)
+    for seq in range(COUNT):
+        if not adapter.connected:
+            break
+        packets.write(packet(seq, size))
+
+def latency():
+    wait_for_subscriber()
+    size = payload_size(packets.packet_size)
+    echo = bytearray(MAX_LENGTH)
+    samples = []
+    for seq in range(COUNT):
+        if not adapter.connected:
+            break
+        packets.write(packet(seq, size))
+        start = ticks_ms()
+        # Give up on this packet after a second.
+        while adapter.connected and ticks_ms() - start < 1000:
+            if packets.readinto(echo) >= HEADER_SIZE:
+                echo_seq, sent = struct.unpack_from(HEADER, echo)
+                if echo_seq == seq:
+                    samples.append(ticks_ms() - sent)
+                    break
+    report("packets", len(samples))
+    report("dropped", COUNT - len(samples))
+    report_percentiles("rtt_ms", samples)
+
+def charbuffer():
+    counter = SeqCounter()
+    buf = bytearray(8 * MAX_LENGTH)
+    # The central sends the payload size first.
+    size = 0
+    data = b""
+    nbytes = 0
+    start = end = None
+    while adapter.connected:
+        n = stream.readinto(buf)
+        if n == 0:
+            continue
+        now = ticks_ms()
+        if start is None:
+            start = now
+        end = now
+        nbytes += n
+        data += buf[:n]
+        if size == 0:
+            size = data[0]
+            data = data[1:]
+        while size and len(data) >= size:
+            counter.add(struct.unpack_from(HEADER, data)[0])
+            data = data[size:]
+    counter.report()
+    if start is not None:
+        report_rate(nbytes, start, end)
+
+def characteristic():
+    while adapter.connected:
+        pass
+
+globals()[MODE]()
+while adapter.connected:
+    pass
+print("done")
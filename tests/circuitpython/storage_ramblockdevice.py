@@ -0,0 +1,58 @@
+import skip_if
+try:
+    import storage
+    storage.RAMBlockDevice
+except (ImportError, AttributeError):
+    skip_if.skip()
+
+import gc
+import os
+
+# BP_IOCTL_SEC_COUNT and BP_IOCTL_SEC_SIZE
+dev = storage.RAMBlockDevice(64)
+assert(dev.ioctl(4, 0) == 64)
+assert(dev.ioctl(5, 0) == 512)
+
+# blocks read as zeros until written
+buf = bytearray(1024)
+dev.readblocks(0, buf)
+assert(buf == bytearray(1024))
+data = bytearray(range(256)) * 4
+dev.writeblocks(3, data)
+dev.readblocks(3, buf)
+assert(buf == data)
+
+# writing zeros gives the blocks' memory back
+zeros = bytearray(1024)
+gc.collect()
+before = gc.mem_free()
+dev.writeblocks(3, zeros)
+gc.collect()
+assert(gc.mem_free() >= before + 1024)
+dev.readblocks(3, buf)
+assert(buf == zeros)
+
+# only whole blocks inside the device
+for block, length in ((63, 1024), (64, 512), (0, 100)):
+    try:
+        dev.writeblocks(block, bytearray(length))
+        assert(False)
+    except OSError:
+        pass
+try:
+    storage.RAMBlockDevice(0)
+    assert(False)
+except ValueError:
+    pass
+
+# a FAT filesystem on it keeps its files across remounts
+storage.VfsFat.mkfs(dev)
+storage.mount(storage.VfsFat(dev), "/ramtest")
+with open("/ramtest/scratch.txt", "w") as f:
+    f.write("hello ram")
+storage.umount("/ramtest")
+storage.mount(storage.VfsFat(dev), "/ramtest")
+assert("scratch.txt" in os.listdir("/ramtest"))
+with open("/ramtest/scratch.txt") as f:
+    assert(f.read() == "hello ram")
+storage.umount("/ramtest")
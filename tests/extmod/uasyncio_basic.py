@@ -0,0 +1,126 @@
+# test the uasyncio event loop: sleeping, tasks, cancellation and events
+try:
+    import uasyncio as asyncio
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+# tasks run in the order they are due, and in the order created when due together
+async def sleeper(name, ms, log):
+    await asyncio.sleep_ms(ms)
+    log.append(name)
+    return name
+
+async def main():
+    log = []
+    tasks = [asyncio.create_task(sleeper(n, ms, log)) for n, ms in (('a', 30), ('b', 10), ('c', 20), ('d', 10))]
+    await asyncio.sleep(0)
+    print(log, [t.done() for t in tasks])
+    print(await tasks[0], log)
+    results = []
+    for t in tasks:
+        results.append(await t)
+    print(results, [t.done() for t in tasks])
+    return 'main'
+print(asyncio.run(main()))
+
+# a bare yield and sleep(0) let other tasks run
+async def ticker(name, n):
+    for i in range(n):
+        print(name, i)
+        await asyncio.sleep(0)
+
+async def main():
+    t = asyncio.create_task(ticker('x', 3))
+    await ticker('y', 3)
+    await t
+asyncio.run(main())
+
+# exceptions reach whoever awaits the task, and run() raises the main task's
+async def fail():
+    await asyncio.sleep_ms(1)
+    raise ValueError('fail')
+
+async def main():
+    t = asyncio.create_task(fail())
+    try:
+        await t
+    except ValueError as e:
+        print('caught', e)
+    raise KeyError('main')
+try:
+    asyncio.run(main())
+except KeyError as e:
+    print('run raised', e)
+
+# cancellation
+async def forever(ev):
+    try:
+        await ev.wait()
+    except asyncio.CancelledError:
+        print('cancelled')
+        return 'cleaned up'
+
+async def main():
+    ev = asyncio.Event()
+    t = asyncio.create_task(forever(ev))
+    await asyncio.sleep_ms(5)
+    print(t.cancel(), t.cancel() if t.done() else 'pending')
+    print(await t, t.done(), t.cancel())
+    t = asyncio.create_task(asyncio.sleep_ms(1000))
+    await asyncio.sleep(0)
+    t.cancel()
+    try:
+        await t
+    except asyncio.CancelledError:
+        print('sleep cancelled')
+asyncio.run(main())
+
+# events wake every waiter, and waiting on a set event doesn't block
+async def waiter(name, ev):
+    await ev.wait()
+    print(name, 'woken', ev.is_set())
+
+async def main():
+    ev = asyncio.Event()
+    tasks = [asyncio.create_task(waiter(n, ev)) for n in ('p', 'q')]
+    await asyncio.sleep_ms(5)
+    print('set')
+    ev.set()
+    for t in tasks:
+        await t
+    await ev.wait()
+    ev.clear()
+    print(ev.is_set())
+asyncio.run(main())
+
+# a ThreadSafeFlag wakes its single waiter, and stays set until waited on
+async def flag_waiter(flag):
+    for i in range(2):
+        await flag.wait()
+        print('flag', i)
+
+async def main():
+    flag = asyncio.ThreadSafeFlag()
+    flag.set()
+    t = asyncio.create_task(flag_waiter(flag))
+    await asyncio.sleep_ms(5)
+    flag.set()
+    await t
+asyncio.run(main())
+
+# errors
+async def main():
+    try:
+        await asyncio.current_task()
+    except RuntimeError:
+        print('RuntimeError')
+    try:
+        asyncio.current_task().cancel()
+    except RuntimeError:
+        print('RuntimeError')
+asyncio.run(main())
+try:
+    asyncio.current_task()
+except RuntimeError:
+    print('RuntimeError')
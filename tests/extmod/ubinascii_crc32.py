@@ -22,6 +22,12 @@ print(hex(binascii.crc32(b' over the lazy dog', binascii.crc32(b'The quick brown
 print(hex(binascii.crc32(b'\x00' * 16, binascii.crc32(b'\x00' * 16))))
 print(hex(binascii.crc32(b'\xff' * 16, binascii.crc32(b'\xff' * 16))))
 print(hex(binascii.crc32(bytes(range(16, 32)), binascii.crc32(bytes(range(16))))))
+# lengths and alignments that exercise every step of a table-driven loop
+data = bytes(range(256)) * 3
+print(hex(binascii.crc32(data)))
+for i in range(8):
+    print(hex(binascii.crc32(memoryview(data)[i:i * 5 + 3])))
+
 try:
     binascii.crc32('')
 except TypeError:
@@ -0,0 +1,50 @@
+try:
+    try:
+        import ubinascii as binascii
+    except ImportError:
+        import binascii
+    binascii.hexlify_into
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+buf = bytearray(16)
+print(binascii.hexlify_into(buf, b'\x01\xab\xff'), buf[:6])
+print(binascii.hexlify_into(buf, b'\x01\xab\xff', ':'), buf[:8])
+print(binascii.hexlify_into(buf, b''))
+
+buf = bytearray(4)
+print(binascii.unhexlify_into(buf, b'01abFF'), buf[:3])
+print(binascii.unhexlify_into(memoryview(buf)[1:], b'cafe'), buf)
+
+buf = bytearray(9)
+print(binascii.b2a_base64_into(buf, b'foo'), buf[:5])
+print(binascii.b2a_base64_into(buf, b'fooba'), buf)
+
+buf = bytearray(6)
+print(binascii.a2b_base64_into(buf, b'Zm9vYmFy'), buf)
+print(binascii.a2b_base64_into(buf, b'Zm9v\nYg=='), buf[:4])
+# a buffer exactly the size of the decoded data is enough
+print(binascii.a2b_base64_into(memoryview(buf)[:2], b'aGk='), buf)
+
+# the result has to fit
+for f, data in ((binascii.hexlify_into, b'abc'), (binascii.unhexlify_into, b'00112233'),
+                (binascii.b2a_base64_into, b'abc'), (binascii.a2b_base64_into, b'Zm9vYmFy')):
+    try:
+        f(bytearray(3), data)
+    except ValueError as e:
+        print(e)
+
+# errors in the data are the same as for the allocating functions
+for f, data in ((binascii.unhexlify_into, b'123'), (binascii.unhexlify_into, b'0g'),
+                (binascii.a2b_base64_into, b'Zm9vY')):
+    try:
+        f(bytearray(8), data)
+    except ValueError as e:
+        print(e)
+
+# the output has to be writable
+try:
+    binascii.hexlify_into(b'1234', b'ab')
+except TypeError:
+    print('TypeError')
@@ -35,3 +35,10 @@ try:
     S.x = 1 
 except TypeError:
     print('TypeError')
+
+# a bitfield is not an aggregate type
+S = uctypes.struct(uctypes.addressof(data), {'x':(uctypes.PTR | uctypes.ARRAY | 0, {})})
+try:
+    S.x
+except TypeError:
+    print('TypeError')
@@ -0,0 +1,39 @@
+# views of aggregate fields are made once and see later changes to memory
+try:
+    import uctypes
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+desc = {
+    "sub": (0, {
+        "b0": uctypes.UINT8 | 0,
+        "b1": uctypes.UINT8 | 1,
+    }),
+    "arr": (uctypes.ARRAY | 0, uctypes.UINT8 | 2),
+    "arr2": (uctypes.ARRAY | 0, 2, {"b": uctypes.UINT8 | 0, "c": uctypes.UINT8 | 1}),
+}
+
+data = bytearray(b"0123")
+S = uctypes.struct(uctypes.addressof(data), desc, uctypes.LITTLE_ENDIAN)
+
+print(S.sub is S.sub, S.arr is S.arr, S.arr2 is S.arr2)
+
+sub = S.sub
+data[0] = ord("a")
+print(sub.b0, S.sub.b0)
+S.sub.b1 = ord("b")
+print(data)
+
+S.arr[1] = ord("c")
+print(data, S.arr[0])
+
+print(S.arr2[0].b, S.arr2[0].c, S.arr2[1].b, S.arr2[1].c)
+S.arr2[1].c = ord("d")
+print(data)
+
+# aggregates still can't be assigned to once a view of them exists
+try:
+    S.sub = 1
+except TypeError:
+    print("TypeError")
@@ -0,0 +1,46 @@
+# test ujson.iterparse
+
+try:
+    from uio import StringIO
+    import ujson as json
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+if not hasattr(json, "iterparse"):
+    print("SKIP")
+    raise SystemExit
+
+def events(s, *args):
+    for ev in json.iterparse(StringIO(s), *args):
+        print(ev)
+
+# the outer list is streamed, its items are built
+events('[1, "a", [2, 3], {"b": null}]')
+
+# the outer dict is streamed
+events('{"x": 1, "y": [true, false], "z": {}}')
+
+# deeper streaming
+events('{"x": [1, {"y": 2}]}', 2)
+events('[[1], [[2]]]', 0)
+events('[[1], [[2]]]', 10)
+
+# top-level values, and several documents one after another
+events('1 "two" null')
+events('{"a": 1}\n{"a": 2}\n')
+events('')
+
+# inputs longer than the read buffer
+n = 0
+for ev, val in json.iterparse(StringIO("[" + ", ".join(str(i) for i in range(500)) + "]")):
+    if ev == "value":
+        n += val
+print(n)
+
+# errors
+for s in ('[1, 2', '1]', '{[1]: 2}', '[nul]'):
+    try:
+        events(s)
+    except ValueError:
+        print("ValueError")
@@ -0,0 +1,46 @@
+# test patterns starting with literal characters, and the module-level
+# functions reusing compiled patterns
+
+try:
+    import ure as re
+except ImportError:
+    try:
+        import re
+    except ImportError:
+        print("SKIP")
+        raise SystemExit
+
+def show(m):
+    print(m and m.group(0))
+
+# all literal
+r = re.compile("OK")
+show(r.match("OK\r\n"))
+show(r.match("\r\nOK"))
+show(r.search("\r\nOK\r\n"))
+show(r.search("\r\nO\r\nK"))
+show(r.search("O"))
+show(r.search(""))
+
+# literal prefix, then the rest of the pattern
+r = re.compile("\\$GP[A-Z]+,(\\d+)")
+show(r.match("$GPGGA,123519,4807.038,N"))
+show(r.match("$GPGGA,x"))
+show(r.search("xx$GP$GPRMC,1$GPGGA,22"))
+print(r.search("noise $GPGSV,3,1").group(1))
+show(r.search("$GP"))
+
+# the prefix can be repeated or followed by optional parts
+show(re.search("ab+", "aabbbc"))
+show(re.search("ab*c", "abac"))
+show(re.search("abc|d", "xxd"))
+show(re.match("x(y)z", "xyz"))
+show(re.search("aab", "aaaab"))
+
+print(re.compile("; ").split("a; b;c; d"))
+
+# more patterns than are kept compiled, used again in turn
+pats = ["a%d" % i for i in range(12)]
+for k in range(2):
+    print([re.search(p, "a3a7a11") is not None for p in pats])
+print(re.match("a1", "a10").group(0), re.match(b"a1", b"a1").group(0))
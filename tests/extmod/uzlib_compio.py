@@ -0,0 +1,51 @@
+try:
+    import uzlib as zlib
+    import uio as io
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+if not hasattr(zlib, "CompIO"):
+    print("SKIP")
+    raise SystemExit
+
+def compress(data, *args, chunk=100):
+    buf = io.BytesIO()
+    c = zlib.CompIO(buf, *args)
+    for i in range(0, len(data), chunk):
+        c.write(data[i:i + chunk])
+    c.close()
+    return buf.getvalue()
+
+# known output
+print(compress(b""))
+print(compress(b"hello world " * 3))
+
+# round trips, through both ways of decompressing
+data = b"".join(b"%d,temp,%d\n" % (i, i * 7 % 23) for i in range(1000))
+for args in ((), (9, 4), (12, 10), (15, 16)):
+    z = compress(data, *args)
+    print(len(z) < len(data) // 2, zlib.decompress(z) == data)
+    print(zlib.DecompIO(io.BytesIO(z)).read() == data)
+
+# input that doesn't compress, written in one go
+x = 1
+data = bytearray()
+for i in range(3000):
+    x = (x * 1103515245 + 12345) & 0x7fffffff
+    data.append(x >> 16 & 0xff)
+print(zlib.decompress(compress(data, chunk=3000)) == data)
+
+# writing after close
+buf = io.BytesIO()
+c = zlib.CompIO(buf)
+c.close()
+try:
+    c.write(b"x")
+except OSError:
+    print("OSError")
+
+try:
+    zlib.CompIO(buf, 8)
+except ValueError:
+    print("ValueError")
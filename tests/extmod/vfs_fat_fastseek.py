@@ -0,0 +1,108 @@
+# test seeking in fragmented files, and directory and FAT updates seen through
+# FatFs's sector cache
+try:
+    import uos
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+try:
+    uos.VfsFat
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+
+class RAMFS:
+
+    SEC_SIZE = 512
+
+    def __init__(self, blocks):
+        self.data = bytearray(blocks * self.SEC_SIZE)
+
+    def readblocks(self, n, buf):
+        buf[:] = self.data[n * self.SEC_SIZE:n * self.SEC_SIZE + len(buf)]
+        return 0
+
+    def writeblocks(self, n, buf):
+        self.data[n * self.SEC_SIZE:n * self.SEC_SIZE + len(buf)] = buf
+        return 0
+
+    def ioctl(self, op, arg):
+        if op == 4:  # BP_IOCTL_SEC_COUNT
+            return len(self.data) // self.SEC_SIZE
+        if op == 5:  # BP_IOCTL_SEC_SIZE
+            return self.SEC_SIZE
+
+
+try:
+    bdev = RAMFS(300)
+except MemoryError:
+    print("SKIP")
+    raise SystemExit
+
+uos.VfsFat.mkfs(bdev)
+vfs = uos.VfsFat(bdev)
+uos.mount(vfs, '/ramdisk')
+uos.chdir('/ramdisk')
+
+def chunk(name, i):
+    return bytes((name + i * 7 + j) & 0xff for j in range(300))
+
+# write two files a chunk at a time so that their clusters interleave
+with open('a', 'wb') as fa, open('b', 'wb') as fb:
+    for i in range(40):
+        fa.write(chunk(1, i))
+        fa.flush()
+        fb.write(chunk(2, i))
+        fb.flush()
+
+# seek forwards and backwards through the fragments
+data = b''.join(chunk(1, i) for i in range(40))
+with open('a', 'rb') as f:
+    ok = True
+    for pos in (11000, 0, 5000, 4999, 11999, 512, 7000, 1, 6000, 300):
+        f.seek(pos)
+        if f.read(100) != data[pos:pos + 100]:
+            ok = False
+            print('bad read at', pos)
+    print(ok, f.seek(0, 2), f.read())
+
+# files in one cluster and empty files
+with open('c', 'w') as f:
+    f.write('hello')
+with open('d', 'w') as f:
+    pass
+with open('c') as f:
+    f.seek(3)
+    print(f.read())
+with open('d') as f:
+    print(f.seek(10), f.read())
+
+# directory and FAT changes are seen afterwards
+for n in range(3):
+    uos.mkdir('dir%d' % n)
+    for i in range(20):
+        with open('dir%d/file%d' % (n, i), 'w') as f:
+            f.write('%d %d' % (n, i))
+print([len(uos.listdir('dir%d' % n)) for n in range(3)])
+for i in range(0, 20, 2):
+    uos.remove('dir1/file%d' % i)
+uos.rename('dir0/file5', 'dir2/moved')
+print(sorted(uos.listdir('dir1')))
+print(len(uos.listdir('dir0')), len(uos.listdir('dir2')))
+with open('dir2/moved') as f:
+    print(f.read())
+uos.remove('b')
+print(sorted(uos.listdir()))
+print(uos.statvfs('/ramdisk')[3] > 0)
+
+# remount and check the file again
+uos.umount('/ramdisk')
+vfs = uos.VfsFat(bdev)
+uos.mount(vfs, '/ramdisk')
+with open('/ramdisk/a', 'rb') as f:
+    f.seek(9000)
+    print(f.read(300) == data[9000:9300])
+print(sorted(uos.listdir('/ramdisk/dir1')))
+uos.umount('/ramdisk')
@@ -0,0 +1,93 @@
+# test that imports from a FAT filesystem see changes made to it
+
+import sys
+
+try:
+    import uos
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+try:
+    uos.VfsFat
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+
+class RAMFS:
+
+    SEC_SIZE = 512
+
+    def __init__(self, blocks):
+        self.data = bytearray(blocks * self.SEC_SIZE)
+
+    def readblocks(self, n, buf):
+        for i in range(len(buf)):
+            buf[i] = self.data[n * self.SEC_SIZE + i]
+        return 0
+
+    def writeblocks(self, n, buf):
+        for i in range(len(buf)):
+            self.data[n * self.SEC_SIZE + i] = buf[i]
+        return 0
+
+    def ioctl(self, op, arg):
+        if op == 4:  # BP_IOCTL_SEC_COUNT
+            return len(self.data) // self.SEC_SIZE
+        if op == 5:  # BP_IOCTL_SEC_SIZE
+            return self.SEC_SIZE
+
+
+try:
+    bdev = RAMFS(50)
+except MemoryError:
+    print("SKIP")
+    raise SystemExit
+
+uos.VfsFat.mkfs(bdev)
+vfs = uos.VfsFat(bdev)
+uos.mount(vfs, "/ramdisk")
+sys.path.insert(0, "/ramdisk")
+sys.path.insert(0, "/ramdisk/lib")
+
+def try_import(name):
+    try:
+        __import__(name)
+        print(name, "imported")
+    except ImportError:
+        print(name, "not found")
+    sys.modules.pop(name, None)
+
+def write(path, data):
+    with open(path, "w") as f:
+        f.write(data)
+
+# misses are cached, so the filesystem must invalidate them
+try_import("mod_a")
+write("/ramdisk/mod_a.py", "print('mod_a body')\n")
+try_import("mod_a")
+try_import("MOD_A")
+
+# a directory that doesn't exist yet
+try_import("mod_b")
+uos.mkdir("/ramdisk/lib")
+write("/ramdisk/lib/mod_b.py", "print('mod_b body')\n")
+try_import("mod_b")
+
+uos.rename("/ramdisk/mod_a.py", "/ramdisk/mod_c.py")
+try_import("mod_a")
+try_import("mod_c")
+
+uos.remove("/ramdisk/lib/mod_b.py")
+try_import("mod_b")
+
+# packages
+uos.mkdir("/ramdisk/pkg")
+write("/ramdisk/pkg/__init__.py", "print('pkg body')\n")
+try_import("pkg")
+
+uos.umount("/ramdisk")
+try_import("mod_c")
+sys.path.pop(0)
+sys.path.pop(0)
@@ -0,0 +1,59 @@
+# test the read-only VfsRom filesystem
+
+import sys
+
+try:
+    import uos
+    uos.VfsRom
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+# made by tools/mkromfs.py from hello.txt, data/a.bin and lib/romfs_mod.py
+IMAGE = (b'ROMF\x01\x00\x05\x00\xe4\x00\x00\x00\x00\x00\x00\x00\xcdF\xc1)\x88\x00\x00\x00\xb4\x00\x00\x00\x18\x00\x00\x00\x18\x00\x00\x00\t\x00\x01\x00\x02=2,\x91\x00\x00\x00\xcc\x00\x00\x00\x10\x00\x00\x00\x10\x00\x00\x00\n\x00\x01\x00\xac\xbfL2\x9b\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x03\x00\x02\x00*~\xe6\xb5\x9e\x00\x00\x00\xdc\x00\x00\x00\x07\x00\x00\x00\x07\x00\x00\x00\x10\x00\x01\x00\xa5\xe2r\xd8\xae\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x04\x00\x02\x00hello.txtdata/a.binliblib/romfs_mod.pydata\x00\x00hello world\nsecond line\n\x00\x01\x02\x03\x04\x05\x06\x07\x08\t\n\x0b\x0c\r\x0e\x0fx = 42\n\x00')
+
+try:
+    uos.VfsRom(b'ROMF')
+except OSError as e:
+    print('bad image', e.args[0] == 19)
+
+vfs = uos.VfsRom(IMAGE)
+uos.mount(vfs, '/rom')
+
+print(sorted(uos.listdir('/rom')))
+print(sorted(uos.ilistdir('/rom/data')))
+print(uos.stat('/rom/hello.txt')[0] == 0x8000, uos.stat('/rom/hello.txt')[6])
+print(uos.stat('/rom/lib')[0] == 0x4000)
+
+with open('/rom/hello.txt') as f:
+    print(f.readline())
+    print(f.tell())
+    print(f.read())
+    f.seek(6)
+    print(f.read(5))
+
+with open('/rom/data/a.bin', 'rb') as f:
+    m = memoryview(f)
+    print(len(m), m[3], bytes(m[-2:]))
+    f.seek(-4, 2)
+    print(f.read())
+
+uos.chdir('/rom/lib')
+print(uos.getcwd())
+print(open('../hello.txt').read(5))
+uos.chdir('/')
+
+for op in (lambda: open('/rom/new.txt', 'w'), lambda: uos.mkdir('/rom/d'),
+           lambda: uos.remove('/rom/hello.txt'), lambda: open('/rom/missing'),
+           lambda: open('/rom/lib')):
+    try:
+        op()
+    except OSError as e:
+        print('OSError', e.args[0])
+
+sys.path.append('/rom/lib')
+import romfs_mod
+print(romfs_mod.x)
+sys.path.pop()
+
+uos.umount('/rom')
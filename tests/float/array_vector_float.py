@@ -0,0 +1,27 @@
+# test elementwise operations and reductions over float arrays
+
+try:
+    import array
+    array.add
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+a = array.array("f", [1.5, -2, 4, 0.25])
+b = array.array("f", [0.5, 2, -1, 4])
+print(array.add(a, b), array.sub(a, 0.5), array.mul(a, b))
+print(array.scale(a, 2), array.clamp(a, -1, 2))
+print(array.sum(a), array.min(a), array.max(a), array.dot(a, b))
+print(array.moving_average(a, 2))
+array.scale(a, 0.5, a)
+print(a)
+
+# integers are scaled with rounding and saturation
+h = array.array("h", [100, -100, 3, 20000])
+print(array.scale(h, 0.5), array.scale(h, 2.0), array.scale(h, -1.5))
+
+# floats and integers don't mix
+try:
+    array.add(a, h)
+except ValueError:
+    print("ValueError")
@@ -0,0 +1,14 @@
+# tests constant folding of float expressions
+
+print(1.5 + 2, 2 * 0.25, 1 - 0.5, 7 / 2.0, 1.0 / 3)
+print(7.5 // 2, 7.5 % 2, -7.5 // 2, -7.5 % 2, 2 ** 0.5)
+print(-1.5, +2.5, -(-3.0), -0.0)
+print(1.5 < 2, 2.0 == 2, 0.1 + 0.2 == 0.3, 1 < 1.5 <= 2.5)
+print(1e308 * 10, -1e308 * 10)
+
+# these are left to raise at runtime
+for f in (lambda: 1.0 / 0, lambda: 1 // 0.0, lambda: 2.0 % 0, lambda: 1.0 << 2):
+    try:
+        f()
+    except (ZeroDivisionError, TypeError) as e:
+        print(type(e).__name__)
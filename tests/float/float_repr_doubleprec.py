@@ -0,0 +1,22 @@
+# test that repr of a float gives the shortest string that reads back as it,
+# requiring double-precision
+
+for x in (0.1, 0.2 + 0.1, 1 / 3, 2 / 3, 1.2, 2.675, 1000.18, 1e15, 1e16, 123456789012345680.0, 1e22, 1e23,
+          0.0001, 0.00001, 1.5e-5, 9007199254740993.0, 5e-324, 2.2250738585072014e-308, 1.7976931348623157e308):
+    print(repr(x), str(-x))
+
+# complex parts are formatted the same way
+print(0.1 + 0.2j, 1 / 3 - 2j / 3)
+
+# pseudo-random but repeatable values round trip through repr and parsing
+x = 1
+for i in range(2000):
+    x = (x * 1103515245 + 12345) & 0x7fffffff
+    f = x / 0x7fffffff * 10 ** (i % 40 - 20)
+    if float(repr(f)) != f:
+        print('FAIL', repr(f))
+    if i % 97 == 0:
+        print(f)
+
+# halfway between two floats rounds to even
+print(float('9007199254740993'), float('9007199254740995'), float('2.4703282292062328e-324'))
@@ -0,0 +1,54 @@
+# test BufferedReader, and writev on files
+
+try:
+    import uio as io
+except ImportError:
+    import io
+
+try:
+    io.BufferedReader
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+# a stream that returns at most 3 bytes for each read, to show the buffering
+class Slow(io.IOBase):
+    def __init__(self, data):
+        self.data = data
+        self.reads = 0
+
+    def readinto(self, buf):
+        self.reads += 1
+        n = min(3, len(buf), len(self.data))
+        buf[:n] = self.data[:n]
+        self.data = self.data[n:]
+        return n
+
+s = Slow(b"line one\nline two\n\nlast")
+r = io.BufferedReader(s, 8)
+print(r.readline())
+print(r.read(2), r.read(3))
+print(r.readline())
+print(r.readline())
+print(r.readline())
+print(r.readline())
+print(s.reads)
+
+# reading into a buffer
+r = io.BufferedReader(Slow(b"0123456789\nabc\nabcdefghijklmnop\n"), 4)
+buf = bytearray(8)
+for i in range(6):
+    n = r.readline_into(buf)
+    print(n, buf[:n])
+print(r.readinto(buf), r.readinto(buf))
+
+# a line limit, and a read larger than the buffer
+r = io.BufferedReader(io.BytesIO(b"abcdefgh\n" * 20), 16)
+print(r.readline(4), r.readline(-1))
+print(len(r.read(100)), r.read())
+
+# read from a file in one go, with the default buffer size
+f = open("io/data/file2", "rb")
+r = io.BufferedReader(f)
+print(r.readline(), r.readline())
+f.close()
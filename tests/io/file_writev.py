@@ -0,0 +1,38 @@
+# test writing several buffers at once to a file
+
+try:
+    import uos as os
+except ImportError:
+    import os
+
+if not hasattr(os, "unlink"):
+    print("SKIP")
+    raise SystemExit
+
+f = open("testfile", "wb")
+if not hasattr(f, "writev"):
+    print("SKIP")
+    raise SystemExit
+
+print(f.writev([b"head", bytearray(b"er:"), memoryview(b"payload")[1:4], b""]))
+print(f.writev(()))
+# more buffers than are written in one go
+print(f.writev([b"%d," % i for i in range(20)]))
+try:
+    f.writev([b"x", "str"])
+except ValueError:
+    print("ValueError")
+f.close()
+
+f = open("testfile", "rb")
+print(f.read())
+f.close()
+
+f = open("testfile", "w")
+print(f.writev(["text", "\n"]))
+f.close()
+f = open("testfile")
+print(f.read())
+f.close()
+
+os.unlink("testfile")
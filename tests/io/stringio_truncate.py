@@ -0,0 +1,33 @@
+try:
+    import uio as io
+except ImportError:
+    import io
+
+# build several strings in one StringIO, reusing its buffer
+s = io.StringIO()
+for i in range(3):
+    s.seek(0)
+    s.truncate()
+    for j in range(i + 2):
+        s.write("%d,%d\n" % (i, j))
+    print(repr(s.getvalue()))
+
+s = io.StringIO("hello world")
+s.seek(5)
+print(s.truncate(), repr(s.getvalue()))
+print(s.truncate(2), s.seek(0, 1), repr(s.getvalue()))
+# truncating never extends
+print(s.truncate(10), repr(s.getvalue()))
+s.write("!")
+print(repr(s.getvalue()))
+
+b = io.BytesIO(b"abcdef")
+print(b.truncate(3), b.getvalue())
+b.seek(0, 2)
+b.write(b"xyz")
+print(b.getvalue())
+
+try:
+    io.StringIO().truncate(-1)
+except ValueError:
+    print("ValueError")
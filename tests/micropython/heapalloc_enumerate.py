@@ -0,0 +1,33 @@
+# test that a for loop unpacking enumerate() doesn't allocate a tuple per item
+
+import micropython
+
+def f(e):
+    micropython.heap_lock()
+    for i, x in e:
+        print(i, x)
+    micropython.heap_unlock()
+
+f(enumerate((10, 20, 30)))
+f(enumerate(b"ab", 5))
+f(enumerate(()))
+
+# break, continue and else work as usual
+for i, x in enumerate(range(6)):
+    if i == 1:
+        continue
+    if x == 4:
+        break
+    print(i, x)
+else:
+    print("else")
+for i, x in enumerate([1]):
+    pass
+else:
+    print("else", i, x)
+
+# the pair is still a tuple when it isn't unpacked straight away
+for p in enumerate("xy"):
+    print(p)
+for (i, x), y in zip(enumerate("xy"), "zw"):
+    print(i, x, y)
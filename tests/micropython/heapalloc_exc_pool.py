@@ -0,0 +1,93 @@
+# test that exceptions raised by the runtime and caught without "as" are
+# reused, and that ones which may still be referenced are not
+
+import micropython, gc
+
+try:
+    micropython.heap_lock
+except AttributeError:
+    print('SKIP')
+    raise SystemExit
+
+d = {}
+
+def lookup(n):
+    for i in range(n):
+        try:
+            d[i]
+        except KeyError:
+            pass
+
+# the first exceptions go in the pool, later ones reuse them
+lookup(4)
+gc.collect()
+m = gc.mem_alloc()
+lookup(100)
+print(gc.mem_alloc() - m)
+
+# with the heap locked the exception and its traceback still work
+def lookup_locked():
+    micropython.heap_lock()
+    try:
+        d[1]
+    except KeyError:
+        pass
+    try:
+        try:
+            d[2]
+        except KeyError:
+            raise
+    except KeyError as e:
+        ok = e.args == (2,)
+    micropython.heap_unlock()
+    return ok
+
+lookup_locked()
+print(lookup_locked())
+
+# exceptions that are kept somewhere are never reused
+try:
+    import sys
+    sys.exc_info
+except (ImportError, AttributeError):
+    sys = None
+
+saved = []
+
+def keep(n):
+    try:
+        d[n]
+    except KeyError as e:
+        saved.append(e)
+    if sys:
+        try:
+            d[n + 1]
+        except KeyError:
+            saved.append(sys.exc_info()[1])
+    try:
+        try:
+            d[n + 2]
+        except KeyError:
+            try:
+                raise
+            except KeyError:
+                pass
+            raise
+    except KeyError as e:
+        saved.append(e)
+
+class Ctx:
+    def __enter__(self):
+        pass
+    def __exit__(self, a, b, c):
+        saved.append(b)
+        return True
+
+for n in range(0, 40, 10):
+    keep(n)
+    with Ctx():
+        d[n + 5]
+    lookup(4)
+# the ones from sys.exc_info(), if it exists, end in 1
+print([e.args[0] for e in saved if e.args[0] is None or e.args[0] % 10 != 1])
+print(len([e for e in saved if e.args[0] is not None and e.args[0] % 10 == 1]) in (0, 4))
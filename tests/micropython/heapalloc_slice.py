@@ -0,0 +1,26 @@
+# test that slicing a built-in type to load from or store into it doesn't
+# allocate a slice object
+
+import micropython
+
+b = bytearray(8)
+l = [0] * 4
+m = memoryview(b)
+micropython.heap_lock()
+b[1:3] = b"xy"
+m[4:6] = b"zw"
+l[1:3] = (1, 2)
+micropython.heap_unlock()
+print(b, l)
+
+# a __getitem__ still gets a slice it can keep
+class A:
+    def __getitem__(self, k):
+        self.k = k
+        return 0
+
+a = A()
+a[1:2]
+print(a.k.start, a.k.stop, a.k.step)
+a[1:5:2]
+print(a.k.start, a.k.stop, a.k.step)
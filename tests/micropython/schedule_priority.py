@@ -0,0 +1,68 @@
+# test priority levels, coalescing and statistics of micropython.schedule()
+
+import micropython
+
+try:
+    micropython.schedule_stats
+    micropython.schedule(lambda x: x, None, 1)
+except (AttributeError, ValueError):
+    print('SKIP')
+    raise SystemExit
+
+# wait for the callback above, and clear the statistics
+for i in range(2):
+    pass
+micropython.schedule_stats(0)
+micropython.schedule_stats(1)
+
+# callbacks scheduled from within a callback run once it has finished; higher
+# levels first, then in the order they were scheduled
+def callback(arg):
+    print(arg)
+
+def outer(arg):
+    micropython.schedule(callback, 'low 1')
+    micropython.schedule(callback, 'low 2', 0)
+    micropython.schedule(callback, 'high 1', 1)
+    micropython.schedule(callback, 'high 2', 1)
+    print('outer')
+
+micropython.schedule(outer, None)
+for i in range(10):
+    pass
+
+# a callback already pending with the same argument is coalesced
+def outer(arg):
+    for i in range(3):
+        micropython.schedule(callback, 'once', 0, True)
+    micropython.schedule(callback, 'twice', 0)
+    micropython.schedule(callback, 'twice', 0)
+    print('outer')
+
+micropython.schedule(outer, None)
+for i in range(10):
+    pass
+
+# a full level raises, while the other level still has room
+def outer(arg):
+    try:
+        for i in range(100):
+            micropython.schedule(callback, None, 0)
+    except RuntimeError:
+        print('RuntimeError')
+    micropython.schedule(callback, 'high', 1)
+
+micropython.schedule(outer, None)
+for i in range(10):
+    pass
+
+# scheduled, coalesced, dropped and the maximum depth, then reset
+s0 = micropython.schedule_stats(0)
+s1 = micropython.schedule_stats(1)
+print(s0[0] > 0, s0[1:3], s1[:4], s0[4] >= 0)
+print(micropython.schedule_stats(1))
+
+try:
+    micropython.schedule(callback, None, 2)
+except ValueError:
+    print('ValueError')
@@ -0,0 +1,63 @@
+# test the unboxed float type in viper code
+
+try:
+    exec("@micropython.viper\ndef f(x:float): pass")
+except (NameError, ViperTypeError):
+    print("SKIP")
+    raise SystemExit
+
+# arithmetic, with float constants
+@micropython.viper
+def arith(x:float, y:float) -> float:
+    return x * y + 1.5 - y / 4.0
+print(arith(2.0, 3.0), arith(-1.5, 2.0))
+
+# in-place operators and casts from int
+@micropython.viper
+def poly(x:float) -> float:
+    acc = 0.0
+    i = 0
+    while i < 4:
+        acc *= x
+        acc += float(i)
+        i += 1
+    return acc
+print(poly(2.0), poly(-0.5))
+
+# comparisons, none of which hold for nan except !=
+@micropython.viper
+def comp(a:float, b:float) -> int:
+    r = 0
+    if a < b: r |= 1
+    if a > b: r |= 2
+    if a == b: r |= 4
+    if a <= b: r |= 8
+    if a >= b: r |= 16
+    if a != b: r |= 32
+    return r
+print(comp(1.0, 2.0), comp(2.0, 1.0), comp(1.0, 1.0), comp(float("nan"), 1.0))
+
+# unary operators, and division by zero gives inf
+@micropython.viper
+def unary(x:float):
+    y = -x
+    print(y, +y, x / 0.0)
+unary(2.5)
+unary(-4.0)
+
+# casts to and from int and uint, which truncate towards zero
+@micropython.viper
+def to_int(x:float) -> int:
+    return int(x) + int(-x) * 10
+print(to_int(3.7), to_int(-2.2))
+
+@micropython.viper
+def from_uint(x:uint) -> float:
+    return float(x) - 1.0
+print(from_uint(3))
+
+# int and float don't mix implicitly
+try:
+    exec("@micropython.viper\ndef f(x:float, y:int) -> float: return x + y\nf(1.0, 2)")
+except ViperTypeError as e:
+    print(repr(e))
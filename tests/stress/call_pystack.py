@@ -0,0 +1,46 @@
+# Calls that build a temporary args array must not leave it behind on the
+# pystack of a stackless build, or a long enough loop runs out.
+
+def f(a, b, c, d):
+    return a + b + c + d
+
+def g(*args, **kwargs):
+    return len(args) + len(kwargs)
+
+def closure(a, b, c):
+    def h(x, y, z, w):
+        return a + b + c + x + y + z + w
+    return h
+
+class A:
+    def m(self, a, b):
+        return a + b
+
+N = 10000
+
+h = closure(1, 2, 3)
+n = 0
+for i in range(N):
+    n += h(i, 1, 2, 3)
+print(n)
+
+n = 0
+for i in range(N):
+    n += h(*(i, 1), **{"z": 2, "w": 3})
+print(n)
+
+n = 0
+for i in range(N):
+    n += f(*(i, 1, 2, 3))
+print(n)
+
+n = 0
+for i in range(N):
+    n += g(1, *(2, 3), x=4, **{"y": 5})
+print(n)
+
+a = A()
+n = 0
+for i in range(N):
+    n += a.m(*(i, 1))
+print(n)
@@ -0,0 +1,25 @@
+# allocate into a fragmented heap and check no live data is overwritten
+
+import gc
+
+def fill(n, i):
+    return bytearray((i + j) & 0xff for j in range(n))
+
+def check(bufs):
+    for i, b in enumerate(bufs):
+        if b is not None and b != fill(len(b), i):
+            return False
+    return True
+
+sizes = [20, 70, 150, 33, 300, 17, 90]
+bufs = [fill(sizes[i % len(sizes)], i) for i in range(120)]
+
+for round in range(4):
+    # free every other buffer so the heap is full of holes of mixed sizes
+    for i in range(round & 1, len(bufs), 2):
+        bufs[i] = None
+    gc.collect()
+    for i in range(len(bufs)):
+        if bufs[i] is None:
+            bufs[i] = fill(sizes[(i + round) % len(sizes)], i)
+    print(round, check(bufs))
@@ -0,0 +1,51 @@
+# keep allocating while automatic collections run, so that new objects are
+# made in parts of the heap that a deferred sweep hasn't reached yet
+
+import gc
+
+try:
+    gc.threshold
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+def make(n, i):
+    return [bytearray(range((i + j) & 0xff, ((i + j) & 0xff) + 1)) * (8 + j % 24) for j in range(n)]
+
+def ok(lst, i):
+    for j, b in enumerate(lst):
+        v = (i + j) & 0xff
+        if b != bytearray([v]) * (8 + j % 24):
+            return False
+    return True
+
+gc.threshold(2000)
+live = {}
+good = True
+for i in range(200):
+    live[i % 37] = (i, make(5 + i % 11, i))
+    if i % 5 == 0:
+        live.pop((i * 7) % 37, None)
+    grown = bytearray(3)
+    for _ in range(10):
+        grown.extend(b"0123456789abcdef")
+    for k, (n, lst) in live.items():
+        if not ok(lst, n):
+            good = False
+gc.threshold(-1)
+gc.collect()
+print(good, len(live) > 0)
+
+# a sweep step that ends partway through a dead object mustn't leave its
+# tails to be claimed by whatever is allocated, and then grown, at its head
+x = 1
+good = True
+for i in range(40):
+    lst = []
+    for j in range(3000):
+        x = (x * 1103515245 + 12345) & 0x7fffffff
+        lst.append(x % 100000)
+    copy = list(lst)
+    if copy != lst or None in lst:
+        good = False
+print(good)
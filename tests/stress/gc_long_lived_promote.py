@@ -0,0 +1,43 @@
+# values held by globals and classes survive being moved by collections, and
+# keep their identity whether they are moved or not
+
+import gc
+
+s = "abc" * 20
+b = b"xy" * 10
+f = 1.5
+t = (s, f, b, (s + "q", [1]))
+l = [s, t]
+alias = l
+keep = [t]
+alone = "z" * 40
+alone_t = ("y" * 40, 2.5)
+
+class C:
+    name = "n" * 30
+    pair = (s, b)
+
+def fun():
+    return s, t
+
+def get_alone():
+    return alone
+
+funs = [fun]
+C.late = "m" * 30
+
+for i in range(12):
+    gc.collect()
+    s[:1] + "x" * 50
+
+print(s == "abc" * 20, b == b"xy" * 10, f)
+print(t[0] == s, t[1], t[2] == b, t[3][0][-2:], t[3][1])
+print(l is alias, l[1] == t)
+print(C.name == "n" * 30, C.pair == (s, b), C.late == "m" * 30)
+print(fun() == (s, t), fun in funs)
+print(keep[0] is t, l[0] is s, l[1] is t, t[0] is s, t[2] is b, C.pair[0] is s)
+print(fun()[0] is s, fun()[1] is t, get_alone() is alone, alone == "z" * 40)
+x = alone_t
+for i in range(12):
+    gc.collect()
+print(x is alone_t, alone_t == ("y" * 40, 2.5))
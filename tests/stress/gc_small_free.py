@@ -0,0 +1,52 @@
+# allocate and free mixed small objects so that allocations are served from
+# the gc's lists of 1 and 2 block holes, and check nothing live is overwritten
+
+import gc
+
+try:
+    gc.mem_free
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+def make(i):
+    # boxed floats, small tuples and short bytes take one or two blocks
+    k = i % 5
+    if k == 0:
+        return i + 0.5
+    if k == 1:
+        return (i,)
+    if k == 2:
+        return (i, i + 1, i + 2, i + 3)
+    if k == 3:
+        return bytes((i + j) & 0xff for j in range(8))
+    return [i, -i]
+
+def check(objs):
+    for i, o in enumerate(objs):
+        if o is not None and o != make(i):
+            return False
+    return True
+
+gc.collect()
+free_start = gc.mem_free()
+
+# run in a function so that once it returns no stale stack slot keeps the objects alive
+def run():
+    objs = [make(i) for i in range(300)]
+    for round in range(6):
+        # free a different mix each round so holes of both sizes come and go
+        for i in range(round % 3, len(objs), 3):
+            objs[i] = None
+        gc.collect()
+        for i in range(len(objs)):
+            if objs[i] is None:
+                objs[i] = make(i)
+        # short lived garbage also lands in, and is freed from, the small holes
+        for i in range(200):
+            t = (i, i + 0.25)
+        print(round, check(objs))
+
+run()
+gc.collect()
+print(gc.mem_free() >= free_start - 1024)
@@ -0,0 +1,27 @@
+# test indexing, slicing and searching long strings, ASCII and not
+
+def check(s):
+    chars = list(s)
+    n = len(chars)
+    print(len(s), n)
+    print(all(s[i] == chars[i] for i in range(n)))
+    print(all(s[-i] == chars[-i] for i in range(1, n + 1)))
+    print(all(s[i:i + 7] == ''.join(chars[i:i + 7]) for i in range(-n - 3, n + 3, 5)))
+    print(s[n - 1:], s[-n - 10:2], s[n:], s[n + 10:])
+    for i in (n, -n - 1, n + 100):
+        try:
+            s[i]
+        except IndexError:
+            print('IndexError', i - n)
+    for c in ('x', 'é', '€', '😀', '!'):
+        print(c, s.find(c), s.rfind(c), s.find(c, n // 2), s.find(c, -5))
+
+check('abcdefghij' * 30)
+check('aé€😀' * 50)
+check('é' * 33)
+check('x' * 200 + '€' + 'y' * 200 + '!')
+
+# alternate between more strings than are cached
+strs = ['%d:' % k + 'é€' * (40 + k) for k in range(5)]
+for i in range(3):
+    print(' '.join(s[50 + i] + s[-1 - i] for s in strs), [len(s) for s in strs])
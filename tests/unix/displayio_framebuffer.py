@@ -0,0 +1,46 @@
+# test rendering displayio layers into the unix port's FramebufferBus
+
+try:
+    import uio
+    import displayio
+    displayio.FramebufferBus
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+# the bus emulates the column, row and write memory commands
+bus = displayio.FramebufferBus(4, 2)
+print(len(bus.buffer))
+bus.send(0x2a, b"\x00\x01\x00\x02")
+bus.send(0x2b, b"\x00\x01\x00\x01")
+bus.send(0x2c, b"\x12\x34\x56\x78")
+print(bytes(bus.buffer))
+bus.reset()
+print(bytes(bus.buffer))
+
+display = displayio.Display(bus, b"", width=4, height=2, auto_refresh=False)
+bitmap = displayio.Bitmap(4, 2, 2)
+bitmap[1, 0] = 1
+bitmap[3, 1] = 1
+palette = displayio.Palette(2)
+palette[0] = 0x000000
+palette[1] = 0xff0000
+group = displayio.Group()
+group.append(displayio.TileGrid(bitmap, pixel_shader=palette))
+display.show(group)
+print(display.refresh())
+print(bytes(bus.buffer))
+
+s = uio.BytesIO()
+bus.save(s)
+print(s.getvalue())
+
+# packed pixels are saved as a gray map
+displayio.release_displays()
+bus = displayio.FramebufferBus(9, 1, color_depth=1)
+print(len(bus.buffer))
+bus.send(0x2c, b"\x81\x80")
+s = uio.BytesIO()
+bus.save(s)
+print(s.getvalue())
+displayio.release_displays()
@@ -0,0 +1,52 @@
+# test reading files opened with the unix port's 'm' (mapped) mode
+
+# builds with MICROPY_VFS_POSIX open files through the VFS, which ignores 'm'
+try:
+    f = open("io/data/file1", "rbm")
+    m = memoryview(f)
+except (ValueError, TypeError):
+    print("SKIP")
+    raise SystemExit
+
+print(len(m), bytes(m[:5]))
+try:
+    m[0] = 0
+except TypeError:
+    print("TypeError")
+
+print(f.read(5))
+buf = bytearray(4)
+print(f.readinto(buf), buf)
+print(f.seek(-3, 2), f.read())
+print(f.read(), f.readinto(buf))
+print(f.seek(1000), f.read())
+print(f.seek(2), f.tell(), f.readline())
+try:
+    f.write(b"x")
+except OSError:
+    print("OSError")
+f.close()
+
+# text mode is read from the mapping too, but isn't a buffer
+f = open("io/data/file1", "rm")
+print(f.readline())
+try:
+    memoryview(f)
+except TypeError:
+    print("TypeError")
+f.close()
+
+# empty files map to an empty buffer
+f = open("testfile", "w")
+f.close()
+f = open("testfile", "rbm")
+print(len(memoryview(f)), f.read())
+f.close()
+
+try:
+    open("testfile", "r+bm")
+except ValueError:
+    print("ValueError")
+
+import uos
+uos.unlink("testfile")
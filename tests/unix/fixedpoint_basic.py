@@ -0,0 +1,74 @@
+# test the Q15 and Q31 arithmetic of the fixedpoint module
+
+try:
+    import fixedpoint
+    from array import array
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+# conversions round to nearest and clamp to the range of the format
+for x in (0.0, 0.5, -0.5, 0.25, 1 / 3, -1.0, 1.0, 2.0, -2.0):
+    print(fixedpoint.from_float(x), fixedpoint.from_float(x, q31=True))
+print(fixedpoint.to_float(16384), fixedpoint.to_float(-32768), fixedpoint.to_float(1 << 30, q31=True))
+
+# scalars saturate instead of wrapping around
+half = fixedpoint.from_float(0.5)
+print(fixedpoint.add(half, half), fixedpoint.add(-half, -half - 1))
+print(fixedpoint.sub(-half, half), fixedpoint.sub(half, -half))
+print(fixedpoint.mul(half, half), fixedpoint.mul(-32768, -32768), fixedpoint.mul(-32768, 32767))
+print(fixedpoint.mul(3, 16384), fixedpoint.mul(-3, 16384))
+try:
+    fixedpoint.add(32768, 0)
+except ValueError:
+    print("ValueError")
+
+# Q15 arrays
+a = array("h", [16384, -16384, 32767, -32768, 100])
+b = array("h", [16384, -16384, 32767, -32768, -50])
+d = array("h", [0] * 5)
+fixedpoint.add_array(d, a, b)
+print(list(d))
+fixedpoint.mul_array(d, a, b)
+print(list(d))
+fixedpoint.scale_array(d, a, -16384)
+print(list(d))
+print(fixedpoint.dot(a, b))
+print(fixedpoint.dot(array("h", [1000, -2000, 3000]), array("h", [4000, 5000, -6000])))
+
+# dest may be one of the inputs
+fixedpoint.add_array(a, a, a)
+print(list(a))
+
+# Q31 arrays
+a = array("i", [1 << 30, -(1 << 30), 2147483647, -2147483648])
+b = array("i", [1 << 30, -(1 << 30), 2147483647, -2147483648])
+d = array("i", [0] * 4)
+fixedpoint.add_array(d, a, b)
+print(list(d))
+fixedpoint.mul_array(d, a, b)
+print(list(d))
+fixedpoint.scale_array(d, a, 16384)
+print(list(d))
+print(fixedpoint.dot(array("i", [1 << 30, 1 << 29]), array("i", [1 << 30, -(1 << 30)])))
+
+# FIR filter: each output is the sum of the taps times the newest inputs
+taps = array("h", [16384, 8192, 8192])
+src = array("h", [0, 0, 1000, 2000, -3000, 4000])
+d = array("h", [0] * 4)
+fixedpoint.fir(d, src, taps)
+print(list(d))
+taps = array("i", [1 << 30, 1 << 29])
+src = array("i", [0, 1 << 20, -(1 << 21), 1 << 22])
+d = array("i", [0] * 3)
+fixedpoint.fir(d, src, taps)
+print(list(d))
+
+# mismatched arrays are rejected
+for args in ((array("h", [0]), array("h", [0, 0]), array("h", [0])),
+             (array("h", [0]), array("i", [0]), array("h", [0])),
+             (array("b", [0]), array("b", [0]), array("b", [0]))):
+    try:
+        fixedpoint.add_array(*args)
+    except ValueError:
+        print("ValueError")
@@ -0,0 +1,62 @@
+# test drawing into a displayio.Bitmap with framebuf
+
+try:
+    import framebuf
+    import displayio
+    framebuf.BITMAP
+    displayio.FramebufferBus
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+
+def draw(fbuf, col):
+    fbuf.fill(0)
+    fbuf.text("Hi!", 2, 1, col)
+    fbuf.line(0, 10, 36, 0, col)
+    fbuf.fill_rect(30, 3, 5, 6, col)
+    fbuf.rect(1, 1, 20, 9, col)
+    fbuf.pixel(36, 10, col)
+    fbuf.scroll(1, 0)
+
+
+# the same drawing lands in every bitmap layout
+w, h = 37, 11
+ref = framebuf.FrameBuffer(bytearray(w * h), w, h, framebuf.GS8)
+draw(ref, 1)
+for bits in (1, 2, 4, 8, 16):
+    bitmap = displayio.Bitmap(w, h, 1 << bits)
+    fbuf = framebuf.FrameBuffer(bitmap, w, h, framebuf.BITMAP)
+    col = (1 << bits) - 1
+    draw(fbuf, col)
+    same = True
+    for y in range(h):
+        for x in range(w):
+            same = same and (bitmap[x, y] == col) == (ref.pixel(x, y) == 1)
+    print(bits, same, fbuf.pixel(31, 4) == col)
+
+# only a Bitmap can use the BITMAP format, and a Bitmap only that
+for args in ((bytearray(8), 8, 8, framebuf.BITMAP), (displayio.Bitmap(8, 8, 2), 8, 8, framebuf.GS8)):
+    try:
+        framebuf.FrameBuffer(*args)
+    except ValueError:
+        print("ValueError")
+
+# drawing refreshes the display where it drew
+bus = displayio.FramebufferBus(8, 2)
+display = displayio.Display(bus, b"", width=8, height=2)
+bitmap = displayio.Bitmap(8, 2, 2)
+palette = displayio.Palette(2)
+palette[0] = 0x000000
+palette[1] = 0xffffff
+group = displayio.Group()
+group.append(displayio.TileGrid(bitmap, pixel_shader=palette))
+display.show(group)
+display.refresh()
+fbuf = framebuf.FrameBuffer(bitmap, 8, 2, framebuf.BITMAP)
+fbuf.hline(1, 0, 2, 1)
+fbuf.pixel(6, 1, 1)
+fbuf.line(4, 1, 5, 1, 1)
+display.refresh()
+print(bytes(bus.buffer))
+displayio.release_displays()
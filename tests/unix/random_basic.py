@@ -0,0 +1,45 @@
+# test CircuitPython's xoshiro128** random module
+
+try:
+    import random
+    random.randbytes
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+# the same seed gives the same sequence, pinned to the reference xoshiro128**
+random.seed(42)
+a = [random.getrandbits(32) for _ in range(3)]
+print(a)
+random.seed(42)
+print([random.getrandbits(32) for _ in range(3)] == a)
+random.seed(43)
+print([random.getrandbits(32) for _ in range(3)] == a)
+
+# bytes come out of the same stream, four at a time
+random.seed(42)
+print(random.randbytes(5))
+
+# more than 32 bits are built from several words and stay below 2**k
+random.seed(1)
+for k in (1, 31, 32, 33, 40, 63, 64, 65, 100, 128):
+    ok = True
+    for _ in range(50):
+        r = random.getrandbits(k)
+        if not 0 <= r < 2 ** k:
+            ok = False
+    print(k, ok)
+
+# randbytes returns exactly n bytes
+for n in (0, 1, 3, 4, 5, 8, 33):
+    b = random.randbytes(n)
+    print(n, type(b) is bytes, len(b) == n)
+
+try:
+    random.getrandbits(0)
+except ValueError:
+    print("ValueError")
+try:
+    random.randbytes(-1)
+except ValueError:
+    print("ValueError")
@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+#
+# This file is part of the MicroPython project, http://micropython.org/
+#
+# The MIT License (MIT)
+#
+# Copyright (c) 2020 Scott Shawcroft for Adafruit Industries
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+# Summarises the output of micropython.opcode_stats() from a build with
+# MICROPY_VM_OPCODE_STATS enabled. Capture the serial output into a file and
+# run:
+#
+#   python3 tools/analyze_opcode_stats.py capture.txt
+#
+# If the capture holds several dumps, the last one is summarised. Opcode
+# names are read from py/bc0.h and py/runtime0.h so they always match
+# the tree the script is run from.
+
+import argparse
+import os
+import re
+import sys
+
+TOP_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def read_enum(path, prefix, end):
+    names = []
+    with open(path) as f:
+        for line in f:
+            m = re.match(r"\s*" + prefix + r"(\w+)", line)
+            if not m:
+                continue
+            if m.group(1) == end:
+                break
+            names.append(m.group(1))
+    return names
+
+
+def opcode_names(top_dir):
+    unary = read_enum(os.path.join(top_dir, "py", "runtime0.h"), "MP_UNARY_OP_", "NUM_BYTECODE")
+    binary = read_enum(os.path.join(top_dir, "py", "runtime0.h"), "MP_BINARY_OP_", "NUM_BYTECODE")
+    names = {}
+    with open(os.path.join(top_dir, "py", "bc0.h")) as f:
+        for line in f:
+            m = re.match(r"#define MP_BC_(\w+)\s+\((0x[0-9a-f]+)\)", line)
+            if not m:
+                continue
+            name, base = m.group(1), int(m.group(2), 16)
+            if name == "LOAD_CONST_SMALL_INT_MULTI":
+                for i in range(64):
+                    names[base + i] = "LOAD_CONST_SMALL_INT {}".format(i - 16)
+            elif name in ("LOAD_FAST_MULTI", "STORE_FAST_MULTI"):
+                for i in range(16):
+                    names[base + i] = "{} {}".format(name[:-len("_MULTI")], i)
+            elif name == "UNARY_OP_MULTI":
+                for i, op in enumerate(unary):
+                    names[base + i] = "UNARY_OP " + op
+            elif name == "BINARY_OP_MULTI":
+                for i, op in enumerate(binary):
+                    names[base + i] = "BINARY_OP " + op
+            else:
+                names[base] = name
+    return names
+
+
+def read_stats(f):
+    ops = {}
+    pairs = {}
+    overflow = 0
+    for line in f:
+        fields = line.split()
+        if not fields:
+            continue
+        if fields[0] == "opcode_stats":
+            # only the last dump in a capture is summarised
+            ops = {}
+            pairs = {}
+            overflow = 0
+        elif fields[0] == "op" and len(fields) == 3:
+            op = int(fields[1], 16)
+            ops[op] = ops.get(op, 0) + int(fields[2])
+        elif fields[0] == "pair" and len(fields) == 4:
+            pair = (int(fields[1], 16), int(fields[2], 16))
+            pairs[pair] = pairs.get(pair, 0) + int(fields[3])
+        elif fields[0] == "pair_overflow" and len(fields) == 2:
+            overflow += int(fields[1])
+    return ops, pairs, overflow
+
+
+def name_of(names, op):
+    return names.get(op, "0x{:02x}".format(op))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Summarise micropython.opcode_stats() output")
+    parser.add_argument("file", nargs="?", help="captured output (default stdin)")
+    parser.add_argument("-n", "--top", type=int, default=20, help="number of pairs to show")
+    parser.add_argument("--top-dir", default=TOP_DIR, help="tree to read opcode names from")
+    args = parser.parse_args()
+
+    names = opcode_names(args.top_dir)
+    if args.file:
+        with open(args.file) as f:
+            ops, pairs, overflow = read_stats(f)
+    else:
+        ops, pairs, overflow = read_stats(sys.stdin)
+
+    total = sum(ops.values())
+    if total == 0:
+        print("no opcode_stats found")
+        return
+
+    print("{} opcodes executed".format(total))
+    print()
+    print("{:>12} {:>6}  {}".format("count", "%", "opcode"))
+    for op, count in sorted(ops.items(), key=lambda item: -item[1]):
+        print("{:>12} {:>6.2f}  {}".format(count, 100 * count / total, name_of(names, op)))
+
+    pair_total = sum(pairs.values()) + overflow
+    print()
+    print("{} opcode pairs executed, {} not counted".format(pair_total, overflow))
+    print()
+    print("{:>12} {:>6}  {}".format("count", "%", "pair"))
+    top = sorted(pairs.items(), key=lambda item: -item[1])[: args.top]
+    for (first, second), count in top:
+        print(
+            "{:>12} {:>6.2f}  {} -> {}".format(
+                count, 100 * count / pair_total, name_of(names, first), name_of(names, second)
+            )
+        )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,261 @@
+#!/usr/bin/env python3
+#
+# Break a firmware's flash and RAM use down by component, from the linker map.
+#
+# Usage:
+#
+# ./build_memory_report.py build-metro_m0_express/firmware.elf.map \
+#     --frozen build-metro_m0_express/frozen_mpy.c \
+#     --defines build-metro_m0_express/memory_report_defines.h \
+#     --ld build-metro_m0_express/samd21g18a.ld
+#
+# or "make BOARD=... memory-report" in a port that has the target.
+#
+# Each object file is put in a component by where its source lives: py, extmod,
+# supervisor, shared-bindings/<module>, shared-module/<module>,
+# common-hal/<module>, lib/<library>, or the first directory of anything else in
+# the port. Objects pulled from archives go under the archive's name. Input
+# sections are counted as .text, .rodata, .data or .bss by their name, whichever
+# output section the linker script put them in. .text, .rodata and .data take
+# flash, .data and .bss take RAM.
+#
+# With --frozen, frozen_mpy.c is split up by top-level package using the sizes
+# mpy-tool estimates for each module. With --defines, the output of
+# "cc -dM -E" on py/mpconfig.h, the memory the supervisor allocates outside the
+# linker's view is estimated too. --display WIDTHxHEIGHTxDEPTH adds the
+# framebuffer and terminal for a display of that size.
+#
+# Rows are sorted by name and carry no addresses so that the reports from two
+# builds can be diffed.
+
+import argparse
+import collections
+import os
+import re
+
+KINDS = ("text", "rodata", "data", "bss")
+
+# An input section: its name, then its address, size and file, possibly on the
+# next line when the name is long.
+SECTION_PATTERN = re.compile(r"^ (\.\S+|COMMON)(?:\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(\S.*))?$")
+CONTINUATION_PATTERN = re.compile(r"^\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(\S.*)$")
+ARCHIVE_PATTERN = re.compile(r"^(.*\.a)\((.*)\)$")
+
+# Defaults for the values the supervisor's own headers define, when --defines
+# doesn't have them.
+EXCEPTION_STACK_SIZE = 1024
+SPI_FLASH_ERASE_SIZE = 4096
+SPI_FLASH_PAGE_SIZE = 256
+CIRCUITPY_FLASH_CACHE_SECTORS = 4
+TERMINAL_TILE_SIZE = (6, 12)
+
+
+def section_kind(name):
+    if name == "COMMON" or name.startswith((".bss", ".dtcm_bss")):
+        return "bss"
+    if name.startswith((".data", ".ramfunc", ".dtcm_data", ".itcm")):
+        return "data"
+    if name.startswith(".rodata"):
+        return "rodata"
+    if name.startswith((".text", ".vectors")):
+        return "text"
+    # Debug info, exception tables and the like aren't counted.
+    return None
+
+
+def component(path):
+    archive = ARCHIVE_PATTERN.match(path)
+    if archive:
+        return os.path.basename(archive.group(1))
+    parts = os.path.normpath(path).split(os.sep)
+    # Everything the port builds is under a directory named build or build-<board>.
+    # Anything else, like the C runtime's startup code, goes by its own name.
+    for i, part in enumerate(parts):
+        if part == "build" or part.startswith("build-"):
+            parts = parts[i + 1:]
+            break
+    else:
+        parts = parts[-1:]
+    if parts[0] == "frozen_mpy.o":
+        return "frozen"
+    if len(parts) == 1:
+        return os.path.splitext(parts[0])[0]
+    if parts[0] in ("shared-bindings", "shared-module", "common-hal", "lib") and len(parts) > 2:
+        return parts[0] + "/" + parts[1]
+    return parts[0]
+
+
+def parse_map(filename):
+    sizes = collections.defaultdict(lambda: dict.fromkeys(KINDS, 0))
+    in_memory_map = False
+    pending = None
+    with open(filename, "r") as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if not in_memory_map:
+                in_memory_map = line.startswith("Linker script and memory map")
+                continue
+            if pending is not None:
+                continuation = CONTINUATION_PATTERN.match(line)
+                name, pending = pending, None
+                if continuation:
+                    add_section(sizes, name, *continuation.groups())
+                    continue
+            match = SECTION_PATTERN.match(line)
+            if not match:
+                continue
+            name, address, size, path = match.groups()
+            if size is None:
+                pending = name
+            else:
+                add_section(sizes, name, address, size, path)
+    return sizes
+
+
+def add_section(sizes, name, address, size, path):
+    kind = section_kind(name)
+    size = int(size, 16)
+    if kind is None or size == 0:
+        return
+    sizes[component(path.strip())][kind] += size
+
+
+def parse_frozen(filename):
+    # mpy-tool lists the modules in mp_frozen_mpy_names, then their raw code in
+    # the same order in mp_frozen_mpy_content, each followed by its total size.
+    names = []
+    totals = []
+    section = None
+    with open(filename, "r") as f:
+        for line in f:
+            if line.startswith("const char mp_frozen_mpy_names[]"):
+                section = "names"
+            elif line.startswith("const mp_raw_code_t *const mp_frozen_mpy_content[]"):
+                section = "content"
+            elif line.startswith("}"):
+                section = None
+            elif section == "names" and line.startswith('"') and line.strip() != '"\\0"};':
+                names.append(line.strip()[1:-3])
+            elif section == "content" and line.strip().startswith("// Total size:"):
+                totals.append(int(line.split(":")[1]))
+    packages = collections.Counter()
+    for name, total in zip(names, totals):
+        packages[name.split("/")[0].rsplit(".", 1)[0]] += total
+    return packages
+
+
+def parse_defines(filename):
+    defines = {}
+    with open(filename, "r") as f:
+        for line in f:
+            parts = line.split(None, 2)
+            if len(parts) == 3 and parts[0] == "#define":
+                defines[parts[1]] = parts[2].strip()
+    return defines
+
+
+def define_int(defines, name, default=0):
+    value = defines.get(name)
+    if value is None:
+        return default
+    try:
+        # Good enough for the (1024) and (4 * 1024) style of values.
+        return int(eval(re.sub(r"\b(\d+)[uUlL]+\b", r"\1", value), {}))
+    except Exception:
+        return default
+
+
+def ram_region_size(filename):
+    # Same approach as build_memory_info.py.
+    with open(filename, "r") as f:
+        for line in f:
+            line = line.strip()
+            if line.startswith("RAM"):
+                space = line.split("=")[-1].split("/*")[0]
+                space = re.sub(r"([0-9]+)K", r"(\1*1024)", space)
+                space = re.sub(r"([0-9]+)M", r"(\1*1024*1024)", space)
+                return int(eval(space))
+    return None
+
+
+def supervisor_estimates(defines, display):
+    estimates = []
+    stack = define_int(defines, "CIRCUITPY_DEFAULT_STACK_SIZE")
+    if stack:
+        estimates.append(("C stack", stack + define_int(defines, "EXCEPTION_STACK_SIZE", EXCEPTION_STACK_SIZE)))
+    if (not define_int(defines, "INTERNAL_FLASH_FILESYSTEM") and
+        (define_int(defines, "SPI_FLASH_FILESYSTEM") or define_int(defines, "QSPI_FLASH_FILESYSTEM"))):
+        sectors = define_int(defines, "CIRCUITPY_FLASH_CACHE_SECTORS", CIRCUITPY_FLASH_CACHE_SECTORS)
+        erase_size = define_int(defines, "SPI_FLASH_ERASE_SIZE", SPI_FLASH_ERASE_SIZE)
+        table = (erase_size // SPI_FLASH_PAGE_SIZE) * 4
+        estimates.append(("flash cache", sectors * (table + erase_size)))
+    if define_int(defines, "CIRCUITPY_DISPLAYIO"):
+        displays = define_int(defines, "CIRCUITPY_DISPLAY_LIMIT", 1)
+        area = define_int(defines, "CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE", 128)
+        estimates.append(("display refresh buffers", displays * 2 * area * 4))
+    if display is not None:
+        width, height, depth = display
+        tile_width, tile_height = TERMINAL_TILE_SIZE
+        tiles = (width // tile_width) * -(-height // tile_height)
+        estimates.append(("terminal tiles", (tiles + 3) & ~3))
+        estimates.append(("framebuffer", ((width * depth + 7) // 8 * height + 3) & ~3))
+    return estimates
+
+
+def display_size(value):
+    try:
+        width, height, depth = (int(x) for x in value.lower().split("x"))
+    except ValueError:
+        raise argparse.ArgumentTypeError("expected WIDTHxHEIGHTxDEPTH, like 320x240x16")
+    return width, height, depth
+
+
+def print_row(name, values):
+    print("{:<40}".format(name) + "".join("{:>9}".format(v) for v in values))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Break flash and RAM use down by component.")
+    parser.add_argument("map", help="linker map file")
+    parser.add_argument("--frozen", help="frozen_mpy.c, to break down frozen modules")
+    parser.add_argument("--defines", help="preprocessor defines, to estimate supervisor allocations")
+    parser.add_argument("--ld", help="linker script, to show what's left for the heap")
+    parser.add_argument("--display", type=display_size,
+                        help="WIDTHxHEIGHTxDEPTH of a display to estimate its buffers")
+    args = parser.parse_args()
+
+    sizes = parse_map(args.map)
+    totals = dict.fromkeys(KINDS, 0)
+    print_row("component", KINDS + ("flash", "ram"))
+    for name in sorted(sizes):
+        s = sizes[name]
+        for kind in KINDS:
+            totals[kind] += s[kind]
+        print_row(name, [s[k] for k in KINDS] + [s["text"] + s["rodata"] + s["data"], s["data"] + s["bss"]])
+    flash = totals["text"] + totals["rodata"] + totals["data"]
+    ram = totals["data"] + totals["bss"]
+    print_row("total", [totals[k] for k in KINDS] + [flash, ram])
+
+    if args.frozen and os.path.exists(args.frozen):
+        print()
+        print_row("frozen package (mpy-tool estimate)", ("flash",))
+        for name, size in sorted(parse_frozen(args.frozen).items()):
+            print_row(name, (size,))
+
+    if args.defines or args.display:
+        defines = parse_defines(args.defines) if args.defines else {}
+        estimates = supervisor_estimates(defines, args.display)
+        print()
+        print_row("supervisor allocation (estimate)", ("ram",))
+        for name, size in estimates:
+            print_row(name, (size,))
+        allocated = sum(size for _, size in estimates)
+        print_row("total", (allocated,))
+        if args.ld:
+            region = ram_region_size(args.ld)
+            if region is not None:
+                print_row("left for the heap", (region - ram - allocated,))
+
+
+if __name__ == "__main__":
+    main()
@@ -114,9 +114,12 @@ _displayio_color_t terminal_colors[2] = {
     },
 };
 
+uint32_t terminal_cached_colors[2];
+
 displayio_palette_t supervisor_terminal_color = {
     .base = {.type = &displayio_palette_type },
     .colors = terminal_colors,
+    .cached_colors = terminal_cached_colors,
     .color_count = 2,
     .needs_refresh = false
 };
@@ -0,0 +1,149 @@
+#! /usr/bin/env python3
+#
+# Generate py/formatfloattables.h, the power of 5 multipliers used by the
+# shortest round-trip float formatting and exact float parsing in
+# py/formatfloat.c (Ryu algorithm).
+#
+# Usage: tools/gen_formatfloat_tables.py > py/formatfloattables.h
+
+from fractions import Fraction
+
+POW5_INV_BITCOUNT = 125
+POW5_BITCOUNT = 125
+# powers of 5 that fit in a uint64_t, used to build the compact tables
+POW5_STEP = 26
+
+def pow5bits(e):
+    return ((e * 1217359) >> 19) + 1
+
+def log10pow2(e):
+    return (e * 78913) >> 18
+
+def log10pow5(e):
+    return (e * 732923) >> 20
+
+# most significant digits converted exactly by mp_float_from_decimal
+MAX_DIGITS = 17
+
+# (size of the 1/5**i table, size of the 5**i table) for each float type,
+# covering both formatting and parsing
+def table_sizes(mantissa_bits, exponent_bits):
+    bias = (1 << (exponent_bits - 1)) - 1
+    # formatting: the scaling of the exponents of finite floats
+    e2_max = (1 << exponent_bits) - 2 - bias - mantissa_bits - 2
+    e2_min = 1 - bias - mantissa_bits - 2
+    inv_size = log10pow2(e2_max) - (e2_max > 3) + 1
+    pow_size = -e2_min - (log10pow5(-e2_min) - (-e2_min > 1)) + 1
+    # parsing: decimals with at most MAX_DIGITS digits between 10**dec_zero
+    # (which rounds to 0) and 10**(dec_inf - 1) (which rounds to infinity)
+    min_sub = Fraction(1, 1 << (bias + mantissa_bits - 1))
+    max_float = Fraction((1 << (mantissa_bits + 1)) - 1, 1) * Fraction(2) ** (bias - mantissa_bits)
+    dec_zero = 0
+    while Fraction(10) ** dec_zero >= min_sub / 2:
+        dec_zero -= 1
+    dec_inf = 1
+    while Fraction(10) ** (dec_inf - 1) <= max_float:
+        dec_inf += 1
+    inv_size = max(inv_size, -(dec_zero + 1 - MAX_DIGITS) + 1)
+    pow_size = max(pow_size, dec_inf - 1)
+    return inv_size, pow_size, dec_zero, dec_inf
+
+def pow5_entry(i):
+    p = 5 ** i
+    assert p.bit_length() == pow5bits(i)
+    shift = p.bit_length() - POW5_BITCOUNT
+    return p >> shift if shift >= 0 else p << -shift
+
+def pow5_inv_entry(i):
+    p = 5 ** i
+    return (1 << (p.bit_length() - 1 + POW5_INV_BITCOUNT)) // p + 1
+
+# these mirror the compact table lookups in py/formatfloat.c, without the
+# correction terms
+def pow5_computed(i):
+    base = i // POW5_STEP * POW5_STEP
+    delta = pow5bits(i) - pow5bits(base)
+    return (5 ** (i - base) * pow5_entry(base)) >> delta
+
+def pow5_inv_computed(i):
+    base = (i + POW5_STEP - 1) // POW5_STEP * POW5_STEP
+    delta = pow5bits(base) - pow5bits(i)
+    return ((5 ** (base - i) * (pow5_inv_entry(base) - 1)) >> delta) + 1
+
+def corrections(n, entry, computed):
+    c = []
+    for i in range(n):
+        d = entry(i) - computed(i)
+        assert 0 <= d <= 3 and entry(i) < 1 << 128
+        c.append(d)
+    # pack 2 bits per entry, 16 entries per uint32_t
+    return [sum(d << (2 * j) for j, d in enumerate(c[k:k + 16])) for k in range(0, n, 16)]
+
+def split(v):
+    return '{0x%016x, 0x%016x},' % (v & (1 << 64) - 1, v >> 64)
+
+# entries past float_len are only needed for double precision
+def emit(decl, values, fmt, float_len, per_line=1):
+    def lines(vals):
+        for k in range(0, len(vals), per_line):
+            print('    ' + ' '.join(fmt(v) for v in vals[k:k + per_line]))
+    print('static const %s = {' % decl)
+    lines(values[:float_len])
+    if float_len < len(values):
+        print('    #if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_DOUBLE')
+        lines(values[float_len:])
+        print('    #endif')
+    print('};')
+
+def main():
+    f_inv, f_pow, f_zero, f_inf = table_sizes(23, 8)
+    d_inv, d_pow, d_zero, d_inf = table_sizes(52, 11)
+    # number of compact table entries needed to cover n entries
+    inv_bases = lambda n: (n + POW5_STEP - 2) // POW5_STEP + 1
+    pow_bases = lambda n: (n - 1) // POW5_STEP + 1
+
+    print('// This file was generated by tools/gen_formatfloat_tables.py')
+    print('// Multipliers for shortest round-trip float formatting and exact parsing in')
+    print('// formatfloat.c.')
+    print('// Entry i of pow5_split is 5**i, and of pow5_inv_split is 1/5**i, scaled')
+    print('// to %d bits and stored as {low, high} 64-bit halves.' % POW5_BITCOUNT)
+    print()
+    print('// A decimal with n digits and exponent e, n + e <= DEC_EXP_ZERO, rounds to zero,')
+    print('// and with n + e >= DEC_EXP_INF rounds to infinity.')
+    print('#define DEC_MAX_DIGITS (%d)' % MAX_DIGITS)
+    print('#if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_FLOAT')
+    print('#define DEC_EXP_ZERO (%d)' % f_zero)
+    print('#define DEC_EXP_INF (%d)' % f_inf)
+    print('#else')
+    print('#define DEC_EXP_ZERO (%d)' % d_zero)
+    print('#define DEC_EXP_INF (%d)' % d_inf)
+    print('#endif')
+    print()
+    print('#if MICROPY_FLOAT_FORMAT_SHORTEST_FULL_TABLES')
+    print()
+    emit('uint64_t pow5_inv_split[][2]', [pow5_inv_entry(i) for i in range(d_inv)], split, f_inv)
+    print()
+    emit('uint64_t pow5_split[][2]', [pow5_entry(i) for i in range(d_pow)], split, f_pow)
+    print()
+    print('#else')
+    print()
+    print('// Entry i is rebuilt from entry %d * k nearby, a small power of 5 and a' % POW5_STEP)
+    print('// 2-bit correction from the offsets tables.')
+    emit('uint64_t pow5_inv_split2[][2]', [pow5_inv_entry(i * POW5_STEP) for i in range(inv_bases(d_inv))],
+        split, inv_bases(f_inv))
+    print()
+    emit('uint64_t pow5_split2[][2]', [pow5_entry(i * POW5_STEP) for i in range(pow_bases(d_pow))],
+        split, pow_bases(f_pow))
+    print()
+    emit('uint32_t pow5_inv_offsets[]', corrections(d_inv, pow5_inv_entry, pow5_inv_computed),
+        lambda v: '0x%08x,' % v, (f_inv + 15) // 16, 4)
+    print()
+    emit('uint32_t pow5_offsets[]', corrections(d_pow, pow5_entry, pow5_computed),
+        lambda v: '0x%08x,' % v, (f_pow + 15) // 16, 4)
+    print()
+    emit('uint64_t pow5_small[]', [5 ** i for i in range(POW5_STEP)], lambda v: '%du,' % v, POW5_STEP, 4)
+    print()
+    print('#endif')
+
+if __name__ == '__main__':
+    main()
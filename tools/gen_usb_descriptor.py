@@ -1,6 +1,7 @@
 import argparse
 
 import os
+import struct
 import sys
 
 sys.path.append("../../tools/usb_descriptor")
@@ -46,6 +47,24 @@ parser.add_argument('--cdc_ep_num_data_out', type=int, default=0,
                     help='endpoint number of CDC DATA OUT')
 parser.add_argument('--cdc_ep_num_data_in', type=int, default=0,
                     help='endpoint number of CDC DATA IN')
+parser.add_argument('--cdc2', action='store_true',
+                    help='add a second CDC interface for binary data (usb_cdc.data)')
+parser.add_argument('--cdc2_ep_num_notification', type=int, default=0,
+                    help='endpoint number of CDC2 NOTIFICATION')
+parser.add_argument('--cdc2_ep_num_data_out', type=int, default=0,
+                    help='endpoint number of CDC2 DATA OUT')
+parser.add_argument('--cdc2_ep_num_data_in', type=int, default=0,
+                    help='endpoint number of CDC2 DATA IN')
+parser.add_argument('--uac', action='store_true',
+                    help='add a USB Audio Class 1 speaker and microphone (usb_audio)')
+parser.add_argument('--uac_sample_rate', type=int, default=48000,
+                    help='sample rate of the UAC speaker')
+parser.add_argument('--uac_microphone_sample_rate', type=int, default=0,
+                    help='sample rate of the UAC microphone, the speaker rate when 0')
+parser.add_argument('--uac_ep_num_out', type=int, default=0,
+                    help='endpoint number of UAC speaker OUT and its feedback IN')
+parser.add_argument('--uac_ep_num_in', type=int, default=0,
+                    help='endpoint number of UAC microphone IN')
 parser.add_argument('--msc_ep_num_out', type=int, default=0,
                     help='endpoint number of MSC OUT')
 parser.add_argument('--msc_ep_num_in', type=int, default=0,
@@ -71,6 +90,10 @@ unknown_hid_devices = list(frozenset(args.hid_devices) - ALL_HID_DEVICES_SET)
 if unknown_hid_devices:
     raise ValueError("Unknown HID devices(s)", unknown_hid_devices)
 
+# TinyUSB numbers CDC interfaces in descriptor order, so the console must come first.
+if args.cdc2 and 'CDC' not in args.devices:
+    raise ValueError("CDC2 needs CDC")
+
 if not args.renumber_endpoints:
     if 'CDC' in args.devices:
         if args.cdc_ep_num_notification == 0:
@@ -80,6 +103,20 @@ if not args.renumber_endpoints:
         elif args.cdc_ep_num_data_in == 0:
             raise ValueError("CDC data IN endpoint number must not be 0")
 
+    if args.cdc2:
+        if args.cdc2_ep_num_notification == 0:
+            raise ValueError("CDC2 notification endpoint number must not be 0")
+        elif args.cdc2_ep_num_data_out == 0:
+            raise ValueError("CDC2 data OUT endpoint number must not be 0")
+        elif args.cdc2_ep_num_data_in == 0:
+            raise ValueError("CDC2 data IN endpoint number must not be 0")
+
+    if args.uac:
+        if args.uac_ep_num_out == 0:
+            raise ValueError("UAC endpoint OUT number must not be 0")
+        elif args.uac_ep_num_in == 0:
+            raise ValueError("UAC endpoint IN number must not be 0")
+
     if 'MSC' in args.devices:
         if args.msc_ep_num_out == 0:
             raise ValueError("MSC endpoint OUT number must not be 0")
@@ -140,55 +177,82 @@ device = standard.DeviceDescriptor(
 # Interface numbers are interface-set local and endpoints are interface local
 # until util.join_interfaces renumbers them.
 
-cdc_union = cdc.Union(
-    description="CDC comm",
-    bMasterInterface=0x00,       # Adjust this after interfaces are renumbered.
-    bSlaveInterface_list=[0x01]) # Adjust this after interfaces are renumbered.
-
-cdc_call_management = cdc.CallManagement(
-    description="CDC comm",
-    bmCapabilities=0x01,
-    bDataInterface=0x01)         # Adjust this after interfaces are renumbered.
-
-cdc_comm_interface = standard.InterfaceDescriptor(
-    description="CDC comm",
-    bInterfaceClass=cdc.CDC_CLASS_COMM,  # Communications Device Class
-    bInterfaceSubClass=cdc.CDC_SUBCLASS_ACM,  # Abstract control model
-    bInterfaceProtocol=cdc.CDC_PROTOCOL_NONE,
-    iInterface=StringIndex.index("{} CDC control".format(args.interface_name)),
-    subdescriptors=[
-        cdc.Header(
-            description="CDC comm",
-            bcdCDC=0x0110),
-        cdc_call_management,
-        cdc.AbstractControlManagement(
-            description="CDC comm",
-            bmCapabilities=0x02),
-        cdc_union,
-        standard.EndpointDescriptor(
-            description="CDC comm in",
-            bEndpointAddress=args.cdc_ep_num_notification | standard.EndpointDescriptor.DIRECTION_IN,
-            bmAttributes=standard.EndpointDescriptor.TYPE_INTERRUPT,
-            wMaxPacketSize=0x0040,
-            bInterval=0x10)
-    ])
-
-cdc_data_interface = standard.InterfaceDescriptor(
-    description="CDC data",
-    bInterfaceClass=cdc.CDC_CLASS_DATA,
-    iInterface=StringIndex.index("{} CDC data".format(args.interface_name)),
-    subdescriptors=[
-        standard.EndpointDescriptor(
-            description="CDC data out",
-            bEndpointAddress=args.cdc_ep_num_data_out | standard.EndpointDescriptor.DIRECTION_OUT,
-            bmAttributes=standard.EndpointDescriptor.TYPE_BULK),
-        standard.EndpointDescriptor(
-            description="CDC data in",
-            bEndpointAddress=args.cdc_ep_num_data_in | standard.EndpointDescriptor.DIRECTION_IN,
-            bmAttributes=standard.EndpointDescriptor.TYPE_BULK),
-    ])
-
-cdc_interfaces = [cdc_comm_interface, cdc_data_interface]
+class CDCFunction:
+    """The descriptors for one CDC ACM serial port."""
+    def __init__(self, name, ep_num_notification, ep_num_data_out, ep_num_data_in):
+        self.name = name
+        self.union = cdc.Union(
+            description="{} comm".format(name),
+            bMasterInterface=0x00,       # Adjust this after interfaces are renumbered.
+            bSlaveInterface_list=[0x01]) # Adjust this after interfaces are renumbered.
+
+        self.call_management = cdc.CallManagement(
+            description="{} comm".format(name),
+            bmCapabilities=0x01,
+            bDataInterface=0x01)         # Adjust this after interfaces are renumbered.
+
+        self.comm_interface = standard.InterfaceDescriptor(
+            description="{} comm".format(name),
+            bInterfaceClass=cdc.CDC_CLASS_COMM,  # Communications Device Class
+            bInterfaceSubClass=cdc.CDC_SUBCLASS_ACM,  # Abstract control model
+            bInterfaceProtocol=cdc.CDC_PROTOCOL_NONE,
+            iInterface=StringIndex.index("{} {} control".format(args.interface_name, name)),
+            subdescriptors=[
+                cdc.Header(
+                    description="{} comm".format(name),
+                    bcdCDC=0x0110),
+                self.call_management,
+                cdc.AbstractControlManagement(
+                    description="{} comm".format(name),
+                    bmCapabilities=0x02),
+                self.union,
+                standard.EndpointDescriptor(
+                    description="{} comm in".format(name),
+                    bEndpointAddress=ep_num_notification | standard.EndpointDescriptor.DIRECTION_IN,
+                    bmAttributes=standard.EndpointDescriptor.TYPE_INTERRUPT,
+                    wMaxPacketSize=0x0040,
+                    bInterval=0x10)
+            ])
+
+        self.data_interface = standard.InterfaceDescriptor(
+            description="{} data".format(name),
+            bInterfaceClass=cdc.CDC_CLASS_DATA,
+            iInterface=StringIndex.index("{} {} data".format(args.interface_name, name)),
+            subdescriptors=[
+                standard.EndpointDescriptor(
+                    description="{} data out".format(name),
+                    bEndpointAddress=ep_num_data_out | standard.EndpointDescriptor.DIRECTION_OUT,
+                    bmAttributes=standard.EndpointDescriptor.TYPE_BULK),
+                standard.EndpointDescriptor(
+                    description="{} data in".format(name),
+                    bEndpointAddress=ep_num_data_in | standard.EndpointDescriptor.DIRECTION_IN,
+                    bmAttributes=standard.EndpointDescriptor.TYPE_BULK),
+            ])
+
+        self.interfaces = [self.comm_interface, self.data_interface]
+
+    def fix_cross_references(self):
+        """Call after util.join_interfaces() has renumbered the interfaces."""
+        self.union.bMasterInterface = self.comm_interface.bInterfaceNumber
+        self.union.bSlaveInterface_list = [self.data_interface.bInterfaceNumber]
+
+        self.call_management.bDataInterface = self.data_interface.bInterfaceNumber
+
+        self.iad = standard.InterfaceAssociationDescriptor(
+            description="{} IAD".format(self.name),
+            bFirstInterface=self.comm_interface.bInterfaceNumber,
+            bInterfaceCount=len(self.interfaces),
+            bFunctionClass=cdc.CDC_CLASS_COMM,  # Communications Device Class
+            bFunctionSubClass=cdc.CDC_SUBCLASS_ACM,  # Abstract control model
+            bFunctionProtocol=cdc.CDC_PROTOCOL_NONE)
+
+cdc_functions = [CDCFunction("CDC", args.cdc_ep_num_notification, args.cdc_ep_num_data_out,
+                             args.cdc_ep_num_data_in)]
+
+# usb_cdc.data. Binary data doesn't share the console's FIFO and Ctrl-C isn't special.
+if args.cdc2:
+    cdc_functions.append(CDCFunction("CDC2", args.cdc2_ep_num_notification,
+                                     args.cdc2_ep_num_data_out, args.cdc2_ep_num_data_in))
 
 msc_interfaces = [
     standard.InterfaceDescriptor(
@@ -349,7 +413,8 @@ audio_interfaces = [audio_control_interface] + cs_ac_interface.audio_streaming_i
 interfaces_to_join = []
 
 if 'CDC' in args.devices:
-    interfaces_to_join.append(cdc_interfaces)
+    for function in cdc_functions:
+        interfaces_to_join.append(function.interfaces)
 
 if 'MSC' in args.devices:
     interfaces_to_join.append(msc_interfaces)
@@ -366,19 +431,9 @@ if 'AUDIO' in args.devices:
 interfaces = util.join_interfaces(interfaces_to_join, renumber_endpoints=args.renumber_endpoints)
 
 # Now adjust the CDC interface cross-references.
-
-cdc_union.bMasterInterface = cdc_comm_interface.bInterfaceNumber
-cdc_union.bSlaveInterface_list = [cdc_data_interface.bInterfaceNumber]
-
-cdc_call_management.bDataInterface = cdc_data_interface.bInterfaceNumber
-
-cdc_iad = standard.InterfaceAssociationDescriptor(
-    description="CDC IAD",
-    bFirstInterface=cdc_comm_interface.bInterfaceNumber,
-    bInterfaceCount=len(cdc_interfaces),
-    bFunctionClass=cdc.CDC_CLASS_COMM,  # Communications Device Class
-    bFunctionSubClass=cdc.CDC_SUBCLASS_ACM,  # Abstract control model
-    bFunctionProtocol=cdc.CDC_PROTOCOL_NONE)
+if 'CDC' in args.devices:
+    for function in cdc_functions:
+        function.fix_cross_references()
 
 descriptor_list = []
 
@@ -389,8 +444,9 @@ if 'CDC' in args.devices:
     # first. However, it still fetches the descriptor anyway. We could reorder the interfaces but
     # the Windows 7 Adafruit_usbser.inf file thinks CDC is at Interface 0, so we'll leave it
     # there for backwards compatibility.
-    descriptor_list.append(cdc_iad)
-    descriptor_list.extend(cdc_interfaces)
+    for function in cdc_functions:
+        descriptor_list.append(function.iad)
+        descriptor_list.extend(function.interfaces)
 
 if 'MSC' in args.devices:
     descriptor_list.extend(msc_interfaces)
@@ -403,13 +459,157 @@ if 'AUDIO' in args.devices:
     # correct ordering.
     descriptor_list.append(audio_control_interface)
 
+# USB Audio Class 1 speaker and microphone for usb_audio. adafruit_usb_descriptor has no classes
+# for audio streaming so these descriptors are packed here. The speaker is asynchronous: an
+# explicit feedback endpoint tells the host how many samples to send per frame. The microphone
+# is asynchronous too and sends what has been recorded.
+
+class RawDescriptor:
+    """Descriptors given as bytes. parts is a list of (bytes, note), one per descriptor."""
+    def __init__(self, description, parts):
+        self.description = description
+        self.parts = parts
+
+    def __bytes__(self):
+        return b"".join(part for part, note in self.parts)
+
+    def notes(self):
+        return [note for part, note in self.parts]
+
+INTERFACE_DESCRIPTOR_TYPE = 0x04
+ENDPOINT_DESCRIPTOR_TYPE = 0x05
+INTERFACE_ASSOCIATION_DESCRIPTOR_TYPE = 0x0b
+AUDIO_SUBCLASS_STREAMING = 0x02
+CS_INTERFACE = 0x24
+CS_ENDPOINT = 0x25
+AC_HEADER = 0x01
+AC_INPUT_TERMINAL = 0x02
+AC_OUTPUT_TERMINAL = 0x03
+AS_GENERAL = 0x01
+AS_FORMAT_TYPE = 0x02
+FORMAT_TYPE_I = 0x01
+FORMAT_PCM = 0x0001
+TERMINAL_USB_STREAMING = 0x0101
+TERMINAL_MICROPHONE = 0x0201
+TERMINAL_SPEAKER = 0x0301
+ISO_ASYNC = 0x05
+ISO_FEEDBACK = 0x11
+UAC_CHANNELS = 2
+UAC_SUBFRAME_SIZE = 2
+# The host polls for feedback every 2**UAC_FEEDBACK_REFRESH frames.
+UAC_FEEDBACK_REFRESH = 3
+
+def used_endpoint_numbers(descriptors):
+    numbers = set()
+    for descriptor in descriptors:
+        b = bytes(descriptor)
+        i = 0
+        while i < len(b):
+            if b[i + 1] == ENDPOINT_DESCRIPTOR_TYPE:
+                numbers.add(b[i + 2] & 0x0f)
+            i += b[i]
+    return numbers
+
+def uac_interface(number, alternate, endpoints, subclass, name):
+    return (struct.pack("<BBBBBBBBB", 9, INTERFACE_DESCRIPTOR_TYPE, number, alternate, endpoints,
+                        audio.AUDIO_CLASS_DEVICE, subclass, 0x00,
+                        StringIndex.index("{} {}".format(args.interface_name, name))),
+            "Interface {} alternate {}".format(number, alternate))
+
+def uac_streaming_descriptors(terminal, sample_rate):
+    return [
+        (struct.pack("<BBBBBH", 7, CS_INTERFACE, AS_GENERAL, terminal, 1, FORMAT_PCM),
+         "AS general, terminal {}".format(terminal)),
+        (struct.pack("<BBBBBBBB", 11, CS_INTERFACE, AS_FORMAT_TYPE, FORMAT_TYPE_I, UAC_CHANNELS,
+                     UAC_SUBFRAME_SIZE, UAC_SUBFRAME_SIZE * 8, 1) +
+         struct.pack("<I", sample_rate)[:3],
+         "Format type I, {} Hz".format(sample_rate)),
+    ]
+
+def uac_endpoint(address, attributes, max_packet_size, refresh, synch_address):
+    return (struct.pack("<BBBBHBBB", 9, ENDPOINT_DESCRIPTOR_TYPE, address, attributes,
+                        max_packet_size, 1, refresh, synch_address),
+            "Endpoint 0x{:02x}".format(address))
+
+def uac_max_packet_size(sample_rate):
+    # One extra frame for the frames that carry an extra sample when the rates drift.
+    return ((sample_rate + 999) // 1000 + 1) * UAC_CHANNELS * UAC_SUBFRAME_SIZE
+
+uac_descriptors = []
+if args.uac:
+    microphone_sample_rate = args.uac_microphone_sample_rate or args.uac_sample_rate
+    uac_control_number = len(interfaces)
+    uac_speaker_number = uac_control_number + 1
+    uac_microphone_number = uac_control_number + 2
+
+    uac_ep_num_out = args.uac_ep_num_out
+    uac_ep_num_in = args.uac_ep_num_in
+    next_endpoint_number = max(used_endpoint_numbers(descriptor_list), default=0) + 1
+    if uac_ep_num_out == 0:
+        uac_ep_num_out = next_endpoint_number
+        next_endpoint_number += 1
+    if uac_ep_num_in == 0:
+        uac_ep_num_in = next_endpoint_number
+    uac_speaker_ep = uac_ep_num_out | standard.EndpointDescriptor.DIRECTION_OUT
+    uac_feedback_ep = uac_ep_num_out | standard.EndpointDescriptor.DIRECTION_IN
+    uac_microphone_ep = uac_ep_num_in | standard.EndpointDescriptor.DIRECTION_IN
+
+    terminals = [
+        (struct.pack("<BBBBHBBHBB", 12, CS_INTERFACE, AC_INPUT_TERMINAL, 1,
+                     TERMINAL_USB_STREAMING, 0, UAC_CHANNELS, 0x0003, 0, 0),
+         "Input terminal 1, USB streaming"),
+        (struct.pack("<BBBBHBBB", 9, CS_INTERFACE, AC_OUTPUT_TERMINAL, 2, TERMINAL_SPEAKER, 0, 1, 0),
+         "Output terminal 2, speaker"),
+        (struct.pack("<BBBBHBBHBB", 12, CS_INTERFACE, AC_INPUT_TERMINAL, 3, TERMINAL_MICROPHONE, 0,
+                     UAC_CHANNELS, 0x0003, 0, 0),
+         "Input terminal 3, microphone"),
+        (struct.pack("<BBBBHBBB", 9, CS_INTERFACE, AC_OUTPUT_TERMINAL, 4,
+                     TERMINAL_USB_STREAMING, 0, 3, 0),
+         "Output terminal 4, USB streaming"),
+    ]
+    header_length = 10
+    total_length = header_length + sum(len(part) for part, note in terminals)
+    header = (struct.pack("<BBBHHBBB", header_length, CS_INTERFACE, AC_HEADER, 0x0100, total_length,
+                          2, uac_speaker_number, uac_microphone_number),
+              "AC header")
+
+    uac_descriptors = [
+        RawDescriptor("UAC control", [
+            uac_interface(uac_control_number, 0, 0, audio.AUDIO_SUBCLASS_CONTROL, "Audio control"),
+            header,
+        ] + terminals),
+        RawDescriptor("UAC speaker", [
+            uac_interface(uac_speaker_number, 0, 0, AUDIO_SUBCLASS_STREAMING, "Speaker"),
+            uac_interface(uac_speaker_number, 1, 2, AUDIO_SUBCLASS_STREAMING, "Speaker"),
+        ] + uac_streaming_descriptors(1, args.uac_sample_rate) + [
+            uac_endpoint(uac_speaker_ep, ISO_ASYNC, uac_max_packet_size(args.uac_sample_rate), 0,
+                         uac_feedback_ep),
+            (struct.pack("<BBBBBH", 7, CS_ENDPOINT, AS_GENERAL, 0, 0, 0), "AS endpoint"),
+            uac_endpoint(uac_feedback_ep, ISO_FEEDBACK, 3, UAC_FEEDBACK_REFRESH, 0),
+        ]),
+        RawDescriptor("UAC microphone", [
+            uac_interface(uac_microphone_number, 0, 0, AUDIO_SUBCLASS_STREAMING, "Microphone"),
+            uac_interface(uac_microphone_number, 1, 1, AUDIO_SUBCLASS_STREAMING, "Microphone"),
+        ] + uac_streaming_descriptors(4, microphone_sample_rate) + [
+            uac_endpoint(uac_microphone_ep, ISO_ASYNC, uac_max_packet_size(microphone_sample_rate),
+                         0, 0),
+            (struct.pack("<BBBBBH", 7, CS_ENDPOINT, AS_GENERAL, 0, 0, 0), "AS endpoint"),
+        ]),
+    ]
+    # The IAD tells TinyUSB that the streaming interfaces belong to the same driver.
+    descriptor_list.append(RawDescriptor("UAC IAD", [
+        (struct.pack("<BBBBBBBB", 8, INTERFACE_ASSOCIATION_DESCRIPTOR_TYPE, uac_control_number,
+                     len(uac_descriptors), audio.AUDIO_CLASS_DEVICE, 0x00, 0x00, 0),
+         "Interface association")]))
+    descriptor_list.extend(uac_descriptors)
+
 # Finally, build the composite descriptor.
 
 configuration = standard.ConfigurationDescriptor(
     description="Composite configuration",
     wTotalLength=(standard.ConfigurationDescriptor.bLength +
                   sum([len(bytes(x)) for x in descriptor_list])),
-    bNumInterfaces=len(interfaces))
+    bNumInterfaces=len(interfaces) + len(uac_descriptors))
 descriptor_list.insert(0, configuration)
 
 string_descriptors = [standard.StringDescriptor(string) for string in StringIndex.strings_in_order()]
@@ -575,10 +775,11 @@ c_file.write("""\
 
 """)
 
-# Write out USB HID report buffer definitions.
+# Write out USB HID report buffer and queue definitions. The queue leaves one byte empty.
 for name in args.hid_devices:
     c_file.write("""\
 static uint8_t {name}_report_buffer[{report_length}];
+static uint8_t {name}_report_queue[USB_HID_REPORT_QUEUE_LENGTH * {report_length} + 1];
 """.format(name=name.lower(), report_length=hid_report_descriptors.HID_DEVICE_DATA[name].report_length))
 
 # Write out table of device objects.
@@ -591,6 +792,7 @@ for name in args.hid_devices:
     {{
         .base          = {{ .type = &usb_hid_device_type }},
         .report_buffer = {name}_report_buffer,
+        .report_queue  = {{ {name}_report_queue, sizeof({name}_report_queue) }},
         .report_id     = {report_id},
         .report_length = {report_length},
         .usage_page    = {usage_page:#04x},
@@ -622,6 +824,34 @@ c_file.write("""\
 };
 """)
 
+if args.uac:
+    h_file.write("""\
+// usb_audio
+#define USB_AUDIO_SAMPLE_RATE {sample_rate}
+#define USB_AUDIO_MICROPHONE_SAMPLE_RATE {microphone_sample_rate}
+#define USB_AUDIO_CONTROL_INTERFACE {control}
+#define USB_AUDIO_SPEAKER_INTERFACE {speaker}
+#define USB_AUDIO_MICROPHONE_INTERFACE {microphone}
+#define USB_AUDIO_SPEAKER_EP 0x{speaker_ep:02x}
+#define USB_AUDIO_FEEDBACK_EP 0x{feedback_ep:02x}
+#define USB_AUDIO_MICROPHONE_EP 0x{microphone_ep:02x}
+#define USB_AUDIO_SPEAKER_MAX_PACKET_SIZE {speaker_packet}
+#define USB_AUDIO_MICROPHONE_MAX_PACKET_SIZE {microphone_packet}
+// All the descriptors of the function, starting with the control interface.
+#define USB_AUDIO_DESCRIPTOR_LENGTH {length}
+
+""".format(sample_rate=args.uac_sample_rate,
+           microphone_sample_rate=microphone_sample_rate,
+           control=uac_control_number,
+           speaker=uac_speaker_number,
+           microphone=uac_microphone_number,
+           speaker_ep=uac_speaker_ep,
+           feedback_ep=uac_feedback_ep,
+           microphone_ep=uac_microphone_ep,
+           speaker_packet=uac_max_packet_size(args.uac_sample_rate),
+           microphone_packet=uac_max_packet_size(microphone_sample_rate),
+           length=sum(len(bytes(d)) for d in uac_descriptors)))
+
 h_file.write("""\
 #endif // MICROPY_INCLUDED_AUTOGEN_USB_DESCRIPTOR_H
 """)
@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+#
+# Build a read-only filesystem image for VfsRom (see extmod/vfs_rom.h).
+#
+# Usage:
+#
+# ./mkromfs.py assets -o assets.bin
+# ./mkromfs.py --compress --module assets -o assets.py
+#
+# With --module the image is written as a Python module defining IMAGE, a bytes
+# object. Freezing that module puts the image in flash, where VfsRom reads it in
+# place:
+#
+# storage.mount(storage.VfsRom(assets.IMAGE), "/assets")
+#
+# With --compress each file is stored as a zlib stream when that makes it
+# smaller. Reading a compressed file needs a window of 2**window_bits bytes of
+# RAM while it's open, and it can't be used as a memoryview.
+
+import argparse
+import os
+import struct
+import zlib
+
+MAGIC = b"ROMF"
+VERSION = 1
+HEADER = "<4sHHII"
+ENTRY = "<IIIIIHBB"
+
+KIND_FILE = 1
+KIND_DIR = 2
+
+COMPRESSION_NONE = 0
+COMPRESSION_ZLIB = 1
+
+
+def fnv1a(data):
+    h = 2166136261
+    for b in data:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def align(n):
+    return (n + 3) & ~3
+
+
+def collect(root):
+    # (path within the image, path on disk or None for a directory)
+    items = []
+    for dirpath, dirnames, filenames in os.walk(root):
+        dirnames.sort()
+        rel = os.path.relpath(dirpath, root)
+        prefix = "" if rel == "." else rel.replace(os.sep, "/") + "/"
+        for d in dirnames:
+            items.append((prefix + d, None))
+        for f in sorted(filenames):
+            items.append((prefix + f, os.path.join(dirpath, f)))
+    return items
+
+
+def build(root, compress, window_bits):
+    entries = []
+    for path, disk_path in collect(root):
+        name = path.encode("utf-8")
+        if disk_path is None:
+            entries.append([fnv1a(name), name, KIND_DIR, COMPRESSION_NONE, 0, b""])
+            continue
+        with open(disk_path, "rb") as f:
+            data = f.read()
+        size = len(data)
+        compression = COMPRESSION_NONE
+        if compress:
+            c = zlib.compressobj(9, zlib.DEFLATED, window_bits)
+            packed = c.compress(data) + c.flush()
+            if len(packed) < size:
+                data = packed
+                compression = COMPRESSION_ZLIB
+        entries.append([fnv1a(name), name, KIND_FILE, compression, size, data])
+    if len(entries) > 0xffff:
+        raise SystemExit("too many files and directories for one image")
+    entries.sort(key=lambda e: (e[0], e[1]))
+
+    names_offset = struct.calcsize(HEADER) + len(entries) * struct.calcsize(ENTRY)
+    names = b"".join(e[1] for e in entries)
+    data_offset = align(names_offset + len(names))
+
+    table = b""
+    blobs = b""
+    name_offset = names_offset
+    for h, name, kind, compression, size, data in entries:
+        offset = data_offset + len(blobs) if kind == KIND_FILE else 0
+        table += struct.pack(ENTRY, h, name_offset, offset, size, len(data), len(name), kind,
+                             compression)
+        name_offset += len(name)
+        blobs += data + bytes(align(len(data)) - len(data))
+
+    image_size = data_offset + len(blobs)
+    header = struct.pack(HEADER, MAGIC, VERSION, len(entries), image_size, 0)
+    image = header + table + names
+    image += bytes(data_offset - len(image)) + blobs
+    assert len(image) == image_size
+    return image
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build a VfsRom filesystem image.")
+    parser.add_argument("directory", help="directory whose contents go in the image")
+    parser.add_argument("-o", "--output", required=True, help="file to write")
+    parser.add_argument("--compress", action="store_true",
+                        help="store files compressed when it makes them smaller")
+    parser.add_argument("--window-bits", type=int, default=10, choices=range(9, 16),
+                        help="log2 of the decompression window (default 10)")
+    parser.add_argument("--module", action="store_true",
+                        help="write a Python module defining IMAGE instead of a binary")
+    args = parser.parse_args()
+
+    image = build(args.directory, args.compress, args.window_bits)
+    if args.module:
+        with open(args.output, "w") as f:
+            f.write("# Generated by tools/mkromfs.py from {}\n".format(args.directory))
+            f.write("IMAGE = {!r}\n".format(image))
+    else:
+        with open(args.output, "wb") as f:
+            f.write(image)
+
+
+if __name__ == "__main__":
+    main()
@@ -58,6 +58,7 @@ class FreezeError(Exception):
 
 class Config:
     MPY_VERSION = 3
+    MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS = False
     MICROPY_LONGINT_IMPL_NONE = 0
     MICROPY_LONGINT_IMPL_LONGLONG = 1
     MICROPY_LONGINT_IMPL_MPZ = 2
@@ -77,6 +78,15 @@ MP_BC_LOAD_NAME = 0x1c
 MP_BC_LOAD_GLOBAL = 0x1d
 MP_BC_LOAD_ATTR = 0x1e
 MP_BC_STORE_ATTR = 0x26
+# superinstructions, always with an extra byte:
+MP_BC_LOAD_FAST_ATTR = 0x48
+MP_BC_LOAD_FAST_METHOD = 0x49
+MP_BC_LOAD_FAST_PAIR = 0x4a
+MP_BC_BINARY_OP_SMALL_INT = 0x4b
+# used to find functions that can be prebuilt in ROM:
+MP_BC_LOAD_BUILD_CLASS = 0x20
+MP_BC_MAKE_FUNCTION = 0x60
+MP_SCOPE_FLAG_GENERATOR = 0x04
 
 # load opcode names
 opcode_names = {}
@@ -118,7 +128,7 @@ def make_opcode_format():
     OC4(U, O, B, O), # 0x3c-0x3f
     OC4(O, B, B, O), # 0x40-0x43
     OC4(B, B, O, B), # 0x44-0x47
-    OC4(U, U, U, U), # 0x48-0x4b
+    OC4(Q, Q, B, B), # 0x48-0x4b
     OC4(U, U, U, U), # 0x4c-0x4f
     OC4(V, V, U, V), # 0x50-0x53
     OC4(B, U, V, V), # 0x54-0x57
@@ -178,10 +188,14 @@ def mp_opcode_format(bytecode, ip, opcode_format=make_opcode_format()):
     ip_start = ip
     f = (opcode_format[opcode >> 2] >> (2 * (opcode & 3))) & 3
     if f == MP_OPCODE_QSTR:
+        if opcode == MP_BC_LOAD_FAST_ATTR or opcode == MP_BC_LOAD_FAST_METHOD:
+            ip += 1
         ip += 3
     else:
         extra_byte = (
-            opcode == MP_BC_RAISE_VARARGS
+            opcode == MP_BC_LOAD_FAST_PAIR
+            or opcode == MP_BC_BINARY_OP_SMALL_INT
+            or opcode == MP_BC_RAISE_VARARGS
             or opcode == MP_BC_MAKE_CLOSURE
             or opcode == MP_BC_MAKE_CLOSURE_DEFARGS
             or config.MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE and (
@@ -244,10 +258,34 @@ class RawCode:
         self.simple_name = self._unpack_qstr(self.ip2)
         self.source_file = self._unpack_qstr(self.ip2 + 2)
 
+        # index of the module globals, if the function object is prebuilt in ROM
+        self.rom_globals = None
+
     def _unpack_qstr(self, ip):
         qst = self.bytecode[ip] | self.bytecode[ip + 1] << 8
         return global_qstrs[qst]
 
+    def mark_rom_funs(self, globals_index):
+        # This code runs once per import, with the module's globals, so the functions that it
+        # makes without default args or closed over variables are the same every time and can
+        # be prebuilt.  Class bodies run once too, so the same goes for methods.
+        self.rom_globals = globals_index
+        first_raw_code = len(self.qstrs) + len(self.objs)
+        ip = self.ip
+        after_build_class = False
+        while ip < len(self.bytecode):
+            f, sz = mp_opcode_format(self.bytecode, ip)
+            opcode = self.bytecode[ip]
+            if opcode == MP_BC_MAKE_FUNCTION:
+                _, i = decode_uint(self.bytecode, ip + 1)
+                rc = self.raw_codes[i - first_raw_code]
+                if after_build_class:
+                    rc.mark_rom_funs(globals_index)
+                elif not rc.prelude[2] & MP_SCOPE_FLAG_GENERATOR:
+                    rc.rom_globals = globals_index
+            after_build_class = opcode == MP_BC_LOAD_BUILD_CLASS
+            ip += sz
+
     def dump(self):
         # dump children first
         for rc in self.raw_codes:
@@ -392,6 +430,14 @@ class RawCode:
                 print('    MP_ROM_PTR(&raw_code_%s),' % rc.escaped_name)
             print('};')
 
+        # generate prebuilt function object
+        if self.rom_globals is not None:
+            print('#if MICROPY_MODULE_FROZEN_ROM_FUN')
+            print('STATIC const mp_obj_fun_bc_t fun_obj_%s = {{&mp_type_fun_bc}, &mp_frozen_mpy_globals[%u], bytecode_data_%s, %s};'
+                % (self.escaped_name, self.rom_globals, self.escaped_name,
+                '(mp_uint_t*)const_table_data_%s' % self.escaped_name if const_table_len else 'NULL'))
+            print('#endif')
+
         # generate module
         if self.simple_name.str != '<module>':
             print('STATIC ', end='')
@@ -410,6 +456,10 @@ class RawCode:
         print('        .n_obj = %u,' % len(self.objs))
         print('        .n_raw_code = %u,' % len(self.raw_codes))
         print('        #endif')
+        if self.rom_globals is not None:
+            print('        #if MICROPY_MODULE_FROZEN_ROM_FUN')
+            print('        .rom_fun = &fun_obj_%s,' % self.escaped_name)
+            print('        #endif')
         print('    },')
         print('};')
         sizes["raw_code_overhead"] += 16
@@ -489,6 +539,9 @@ def read_mpy(filename):
         feature_flags = header[2]
         config.MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE = (feature_flags & 1) != 0
         config.MICROPY_PY_BUILTINS_STR_UNICODE = (feature_flags & 2) != 0
+        config.MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS = config.MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS or (feature_flags & 4) != 0
+        # feature_flags & 8 (qstrs saved as constant table slots) is ignored:
+        # freezing links the qstrs into the bytecode like a copying loader
         config.mp_small_int_bits = header[3]
         return read_raw_code(f)
 
@@ -510,6 +563,7 @@ def freeze_mpy(base_qstrs, raw_codes):
     print('#include "py/mpconfig.h"')
     print('#include "py/objint.h"')
     print('#include "py/objstr.h"')
+    print('#include "py/objfun.h"')
     print('#include "py/emitglue.h"')
     print()
 
@@ -518,6 +572,12 @@ def freeze_mpy(base_qstrs, raw_codes):
     print('#endif')
     print()
 
+    if config.MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS:
+        print('#if !MICROPY_OPT_BYTECODE_SUPERINSTRUCTIONS')
+        print('#error "frozen bytecode uses superinstructions"')
+        print('#endif')
+        print()
+
     print('#if MICROPY_LONGINT_IMPL != %u' % config.MICROPY_LONGINT_IMPL)
     print('#error "incompatible MICROPY_LONGINT_IMPL"')
     print('#endif')
@@ -562,6 +622,8 @@ def freeze_mpy(base_qstrs, raw_codes):
     print('    MP_QSTRnumber_of, // previous pool size')
     print('    %u, // allocated entries' % len(new))
     print('    %u, // used entries' % len(new))
+    print('    NULL, // no hash index, searched linearly')
+    print('    0, // hash index mask')
     print('    {')
     qstr_size = {"metadata": 0, "data": 0}
     for _, _, qstr in new:
@@ -572,7 +634,14 @@ def freeze_mpy(base_qstrs, raw_codes):
     print('    },')
     print('};')
 
+    print()
+    print('#if MICROPY_MODULE_FROZEN_ROM_FUN')
+    print('extern mp_obj_dict_t mp_frozen_mpy_globals[];')
+    print('#endif')
+
     sizes = {}
+    for i, rc in enumerate(raw_codes):
+        rc.mark_rom_funs(i)
     for rc in raw_codes:
         sizes[rc.source_file.str] = rc.freeze(rc.source_file.str.replace('/', '_')[:-3] + '_')
 
@@ -585,6 +654,13 @@ def freeze_mpy(base_qstrs, raw_codes):
         qstr_size["filenames"] += len(module_name) + 1
     print('"\\0"};')
 
+    print('#if MICROPY_MODULE_FROZEN_ROM_FUN')
+    print('// the globals of each module, which its prebuilt functions refer to')
+    print('mp_obj_dict_t mp_frozen_mpy_globals[%u];' % len(raw_codes))
+    print('const size_t mp_frozen_mpy_globals_len = %u;' % len(raw_codes))
+    print('#endif')
+    print()
+
     print('const mp_raw_code_t *const mp_frozen_mpy_content[] = {')
     for rc in raw_codes:
         print('    &raw_code_%s,' % rc.escaped_name)
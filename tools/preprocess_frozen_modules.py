@@ -1,10 +1,12 @@
 #!/usr/bin/env python3
 import argparse
+import ast
 import os
 import os.path
 from pathlib import Path
 import semver
 import subprocess
+import sys
 
 # Compatible with Python 3.4 due to travis using trusty as default.
 
@@ -57,17 +59,234 @@ def copy_and_process(in_dir, out_dir):
                             line = line.replace("0.0.0-auto.0", module_version)
                         output.write(line)
 
+# Bundle mode: mpy-cross compiles each file on its own, so a const() defined
+# in one frozen module is an ordinary global lookup in every module that uses
+# it.  Across the whole set of frozen modules:
+# - "from mod import NAME" gets "; NAME = const(value)" appended to its line,
+#   so mpy-cross replaces the later uses of NAME with the value
+# - "mod.NAME" after "import mod" is replaced with the value
+# Names that are bound more than once in a file, or assigned as an attribute
+# anywhere, are left alone.  Line numbers don't change.
+# Requires Python 3.8 for the source positions in the ast.
+
+CONST_BINARY_OPS = {
+    ast.Add: lambda a, b: a + b,
+    ast.Sub: lambda a, b: a - b,
+    ast.Mult: lambda a, b: a * b,
+    ast.FloorDiv: lambda a, b: a // b,
+    ast.Mod: lambda a, b: a % b,
+    ast.LShift: lambda a, b: a << b,
+    ast.RShift: lambda a, b: a >> b,
+    ast.BitOr: lambda a, b: a | b,
+    ast.BitXor: lambda a, b: a ^ b,
+    ast.BitAnd: lambda a, b: a & b,
+}
+
+CONST_UNARY_OPS = {
+    ast.USub: lambda a: -a,
+    ast.UAdd: lambda a: a,
+    ast.Invert: lambda a: ~a,
+}
+
+# Evaluate the integer expression given to const(), or return None.
+def eval_const(node, consts):
+    try:
+        if isinstance(node, ast.Constant) and type(node.value) is int:
+            return node.value
+        if isinstance(node, ast.Name):
+            return consts.get(node.id)
+        if isinstance(node, ast.BinOp) and type(node.op) in CONST_BINARY_OPS:
+            a = eval_const(node.left, consts)
+            b = eval_const(node.right, consts)
+            if a is not None and b is not None:
+                return CONST_BINARY_OPS[type(node.op)](a, b)
+        if isinstance(node, ast.UnaryOp) and type(node.op) in CONST_UNARY_OPS:
+            a = eval_const(node.operand, consts)
+            if a is not None:
+                return CONST_UNARY_OPS[type(node.op)](a)
+    except (ZeroDivisionError, ValueError):
+        pass
+    return None
+
+def const_literal(value):
+    return str(value) if value >= 0 else "(%d)" % value
+
+class BundleModule:
+    def __init__(self, path, name, is_package):
+        self.path = path
+        self.name = name
+        self.package = name if is_package else name.rpartition(".")[0]
+        with path.open("r") as f:
+            self.source = f.read()
+        self.tree = ast.parse(self.source, str(path))
+        # number of times each name is bound anywhere in the file
+        self.bindings = {}
+        for node in ast.walk(self.tree):
+            names = []
+            if isinstance(node, ast.Name) and not isinstance(node.ctx, ast.Load):
+                names = [node.id]
+            elif isinstance(node, (ast.FunctionDef, ast.AsyncFunctionDef, ast.ClassDef)):
+                names = [node.name]
+            elif isinstance(node, ast.arg):
+                names = [node.arg]
+            elif isinstance(node, ast.alias):
+                names = [(node.asname or node.name).partition(".")[0]]
+            elif isinstance(node, (ast.Global, ast.Nonlocal)):
+                names = node.names
+            elif isinstance(node, ast.ExceptHandler) and node.name:
+                names = [node.name]
+            for n in names:
+                self.bindings[n] = self.bindings.get(n, 0) + 1
+        self.consts = {}
+        self.edits = []
+
+    def bound_once(self, name):
+        return self.bindings.get(name, 0) == 1
+
+    def resolve(self, node):
+        # absolute name of the module in "from ... import"
+        if not node.level:
+            return node.module
+        parts = self.package.split(".") if self.package else []
+        if node.level - 1 > len(parts):
+            return None
+        base = ".".join(parts[:len(parts) - (node.level - 1)])
+        if node.module:
+            return base + "." + node.module if base else node.module
+        return base
+
+    # Find the values of this module's const() names, including ones imported
+    # from other modules.  Returns whether anything new was found.
+    def find_consts(self, modules, stored_attrs):
+        found = False
+        for stmt in self.tree.body:
+            if (isinstance(stmt, ast.Assign) and len(stmt.targets) == 1
+                    and isinstance(stmt.targets[0], ast.Name)
+                    and isinstance(stmt.value, ast.Call)
+                    and isinstance(stmt.value.func, ast.Name) and stmt.value.func.id == "const"
+                    and len(stmt.value.args) == 1):
+                name = stmt.targets[0].id
+                value = eval_const(stmt.value.args[0], self.consts)
+                # private names aren't stored in the module by mpy-cross
+                if (value is not None and not name.startswith("_") and self.bound_once(name)
+                        and name not in stored_attrs):
+                    found |= name not in self.consts
+                    self.consts[name] = value
+            elif isinstance(stmt, ast.ImportFrom):
+                other = modules.get(self.resolve(stmt))
+                if other is None:
+                    continue
+                for alias in stmt.names:
+                    name = alias.asname or alias.name
+                    if (alias.name in other.consts and self.bound_once(name)
+                            and name not in self.consts):
+                        self.consts[name] = other.consts[alias.name]
+                        found = True
+        return found
+
+    def rewrite(self, modules):
+        imported = {}
+        module_aliases = {}
+        for stmt in self.tree.body:
+            if isinstance(stmt, ast.ImportFrom):
+                base = self.resolve(stmt)
+                other = modules.get(base)
+                names = []
+                for alias in stmt.names:
+                    name = alias.asname or alias.name
+                    if other is not None and alias.name in other.consts and name in self.consts:
+                        names.append(name)
+                    elif base and base + "." + alias.name in modules and self.bound_once(name):
+                        module_aliases[name] = modules[base + "." + alias.name]
+                if names:
+                    text = "".join("; %s = const(%s)" % (n, self.consts[n]) for n in names)
+                    self.edits.append((stmt.end_lineno, stmt.end_col_offset, stmt.end_col_offset, text))
+            elif isinstance(stmt, ast.Import):
+                for alias in stmt.names:
+                    if not self.bound_once((alias.asname or alias.name).partition(".")[0]):
+                        continue
+                    if alias.asname:
+                        if alias.name in modules:
+                            module_aliases[alias.asname] = modules[alias.name]
+                    else:
+                        # "import a.b" makes both a and a.b reachable
+                        parts = alias.name.split(".")
+                        for i in range(1, len(parts) + 1):
+                            if ".".join(parts[:i]) in modules:
+                                module_aliases[".".join(parts[:i])] = modules[".".join(parts[:i])]
+        # a replaced "mod.NAME.attr" needs parentheses around the number
+        attr_bases = set(id(node.value) for node in ast.walk(self.tree) if isinstance(node, ast.Attribute))
+        for node in ast.walk(self.tree):
+            if not (isinstance(node, ast.Attribute) and isinstance(node.ctx, ast.Load)
+                    and node.lineno == node.end_lineno):
+                continue
+            chain = []
+            value = node.value
+            while isinstance(value, ast.Attribute):
+                chain.insert(0, value.attr)
+                value = value.value
+            if not isinstance(value, ast.Name):
+                continue
+            other = module_aliases.get(".".join([value.id] + chain))
+            if other is not None and node.attr in other.consts:
+                value = other.consts[node.attr]
+                text = "(%d)" % value if id(node) in attr_bases else const_literal(value)
+                self.edits.append((node.lineno, node.col_offset, node.end_col_offset, text))
+        if not self.edits:
+            return
+        # ast columns are utf-8 byte offsets
+        lines = [l.encode("utf-8") for l in self.source.splitlines(True)]
+        for lineno, start, end, text in sorted(self.edits, reverse=True):
+            line = lines[lineno - 1]
+            lines[lineno - 1] = line[:start] + text.encode("utf-8") + line[end:]
+        with self.path.open("wb") as f:
+            f.write(b"".join(lines))
+
+def bundle(out_dir):
+    modules = {}
+    for path in sorted(Path(out_dir).rglob("*.py")):
+        parts = list(path.relative_to(out_dir).with_suffix("").parts)
+        is_package = parts[-1] == "__init__"
+        if is_package:
+            parts.pop()
+        if not parts:
+            continue
+        try:
+            module = BundleModule(path, ".".join(parts), is_package)
+        except SyntaxError:
+            # leave it for mpy-cross to report
+            continue
+        modules[module.name] = module
+    # attributes assigned anywhere can't be treated as constant
+    stored_attrs = set()
+    for module in modules.values():
+        for node in ast.walk(module.tree):
+            if isinstance(node, ast.Attribute) and not isinstance(node.ctx, ast.Load):
+                stored_attrs.add(node.attr)
+    # consts can be imported from module to module, so repeat until nothing changes
+    while any([m.find_consts(modules, stored_attrs) for m in modules.values()]):
+        pass
+    for module in modules.values():
+        module.rewrite(modules)
+
 if __name__ == '__main__':
     argparser = argparse.ArgumentParser(description="""\
     Copy and pre-process .py files into output directory, before freezing.
     1. Remove top-level repo directory.
     2. Update __version__ info.
     3. Remove examples.
-    4. Remove non-library setup.py and conf.py""")
+    4. Remove non-library setup.py and conf.py
+    5. With --bundle, propagate const() values between the modules""")
     argparser.add_argument("in_dirs", metavar="input-dir", nargs="+",
                            help="top-level code dirs (may be git repo dirs)")
     argparser.add_argument("-o", "--out_dir", help="output directory")
+    argparser.add_argument("--bundle", action="store_true",
+                           help="propagate const() values imported from other modules")
     args = argparser.parse_args()
 
     for in_dir in args.in_dirs:
         copy_and_process(in_dir, args.out_dir)
+    if args.bundle:
+        if sys.version_info < (3, 8):
+            argparser.error("--bundle requires Python 3.8 or later")
+        bundle(args.out_dir)